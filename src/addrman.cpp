@@ -19,6 +19,7 @@
 #include <util/check.h>
 #include <util/time.h>
 
+#include <algorithm>
 #include <cmath>
 #include <optional>
 
@@ -104,6 +105,47 @@ double AddrInfo::GetChance(NodeSeconds now) const
     return fChance;
 }
 
+// SYSCOIN
+AddrInfo& AddrInfoArena::operator[](int id)
+{
+    assert(id >= 0);
+    if (count(id)) return m_slots[id].second;
+    if (size_t(id) >= m_slots.size()) {
+        for (int free_id = m_slots.size(); free_id < id; ++free_id) {
+            m_free.push_back(free_id);
+        }
+        m_slots.resize(id + 1, value_type{-1, AddrInfo{}});
+    } else {
+        m_free.erase(std::find(m_free.begin(), m_free.end(), id));
+    }
+    m_slots[id].first = id;
+    ++m_size;
+    return m_slots[id].second;
+}
+
+int AddrInfoArena::Insert(AddrInfo&& info)
+{
+    int id;
+    if (m_free.empty()) {
+        id = m_slots.size();
+        m_slots.emplace_back(id, std::move(info));
+    } else {
+        id = m_free.back();
+        m_free.pop_back();
+        m_slots[id] = value_type{id, std::move(info)};
+    }
+    ++m_size;
+    return id;
+}
+
+void AddrInfoArena::erase(int id)
+{
+    if (!count(id)) return;
+    m_slots[id] = value_type{-1, AddrInfo{}};
+    m_free.push_back(id);
+    --m_size;
+}
+
 AddrManImpl::AddrManImpl(const NetGroupManager& netgroupman, bool deterministic, int32_t consistency_check_ratio)
     : insecure_rand{deterministic}
     , nKey{deterministic ? uint256{1} : insecure_rand.rand256()}
@@ -413,16 +455,17 @@ AddrInfo* AddrManImpl::Find(const CService& addr, int* pnId)
 AddrInfo* AddrManImpl::Create(const CAddress& addr, const CNetAddr& addrSource, int* pnId)
 {
     AssertLockHeld(cs);
-    int nId = nIdCount++;
-    mapInfo[nId] = AddrInfo(addr, addrSource);
+    // SYSCOIN
+    const int nId{mapInfo.Insert(AddrInfo(addr, addrSource))};
+    AddrInfo& info{mapInfo.at(nId)};
     mapAddr[addr] = nId;
-    mapInfo[nId].nRandomPos = vRandom.size();
+    info.nRandomPos = vRandom.size();
     vRandom.push_back(nId);
     nNew++;
     m_network_counts[addr.GetNetwork()].n_new++;
     if (pnId)
         *pnId = nId;
-    return &mapInfo[nId];
+    return &info;
 }
 
 void AddrManImpl::SwapRandom(unsigned int nRndPos1, unsigned int nRndPos2) const
@@ -814,6 +857,8 @@ std::vector<CAddress> AddrManImpl::GetAddr_(size_t max_addresses, size_t max_pct
     // gather a list of random nodes, skipping those of low quality
     const auto now{Now<NodeSeconds>()};
     std::vector<CAddress> addresses;
+    // SYSCOIN the entries are looked up by index in mapInfo, filling the result is the only allocation
+    addresses.reserve(nNodes);
     for (unsigned int n = 0; n < vRandom.size(); n++) {
         if (addresses.size() >= nNodes)
             break;
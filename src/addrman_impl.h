@@ -18,6 +18,7 @@
 #include <cstdint>
 #include <optional>
 #include <set>
+#include <stdexcept>
 #include <unordered_map>
 #include <unordered_set>
 #include <utility>
@@ -98,6 +99,86 @@ public:
     double GetChance(NodeSeconds now = Now<NodeSeconds>()) const;
 };
 
+// SYSCOIN
+/**
+ * AddrInfo entries stored contiguously and addressed by their nId. Ids of removed entries are
+ * handed out again, so the storage stays dense and an nId is an index instead of a hash lookup.
+ * Iteration (in nId order) and find/at/count/erase follow std::unordered_map<int, AddrInfo>, but
+ * unlike there, adding an entry may move the others, so don't keep references across Insert.
+ */
+class AddrInfoArena
+{
+public:
+    //! first is the nId, -1 for a free slot
+    using value_type = std::pair<int, AddrInfo>;
+
+    template <typename Slot, typename SlotIt>
+    class Iterator
+    {
+    public:
+        Iterator(SlotIt it, SlotIt end) : m_it{it}, m_end{end} { SkipFree(); }
+        Slot& operator*() const { return *m_it; }
+        Slot* operator->() const { return &*m_it; }
+        Iterator& operator++() { ++m_it; SkipFree(); return *this; }
+        Iterator operator++(int) { Iterator ret{*this}; ++*this; return ret; }
+        bool operator==(const Iterator& other) const { return m_it == other.m_it; }
+        bool operator!=(const Iterator& other) const { return m_it != other.m_it; }
+
+    private:
+        void SkipFree() { while (m_it != m_end && m_it->first == -1) ++m_it; }
+        SlotIt m_it;
+        SlotIt m_end;
+    };
+    using iterator = Iterator<value_type, std::vector<value_type>::iterator>;
+    using const_iterator = Iterator<const value_type, std::vector<value_type>::const_iterator>;
+
+    iterator begin() { return {m_slots.begin(), m_slots.end()}; }
+    iterator end() { return {m_slots.end(), m_slots.end()}; }
+    const_iterator begin() const { return {m_slots.begin(), m_slots.end()}; }
+    const_iterator end() const { return {m_slots.end(), m_slots.end()}; }
+    const_iterator cbegin() const { return begin(); }
+    const_iterator cend() const { return end(); }
+
+    iterator find(int id)
+    {
+        if (!count(id)) return end();
+        return {m_slots.begin() + id, m_slots.end()};
+    }
+    const_iterator find(int id) const
+    {
+        if (!count(id)) return end();
+        return {m_slots.begin() + id, m_slots.end()};
+    }
+    size_t count(int id) const { return id >= 0 && size_t(id) < m_slots.size() && m_slots[id].first != -1; }
+    size_t size() const { return m_size; }
+    bool empty() const { return m_size == 0; }
+
+    AddrInfo& at(int id)
+    {
+        if (!count(id)) throw std::out_of_range("AddrInfoArena::at");
+        return m_slots[id].second;
+    }
+    const AddrInfo& at(int id) const
+    {
+        if (!count(id)) throw std::out_of_range("AddrInfoArena::at");
+        return m_slots[id].second;
+    }
+
+    /** Entry id, a default one is created if there is none (like std::unordered_map) */
+    AddrInfo& operator[](int id);
+
+    /** Store info under a free id and return the id */
+    int Insert(AddrInfo&& info);
+
+    void erase(int id);
+
+private:
+    std::vector<value_type> m_slots;
+    //! ids of free slots, reused last freed first
+    std::vector<int> m_free;
+    size_t m_size{0};
+};
+
 class AddrManImpl
 {
 public:
@@ -179,11 +260,11 @@ private:
     //! @note Don't increment this. Increment `lowest_compatible` in `Serialize()` instead.
     static constexpr uint8_t INCOMPATIBILITY_BASE = 32;
 
-    //! last used nId
+    //! next nId while deserializing, new entries take a free id of mapInfo
     int nIdCount GUARDED_BY(cs){0};
 
     //! table with information about all nIds
-    std::unordered_map<int, AddrInfo> mapInfo GUARDED_BY(cs);
+    AddrInfoArena mapInfo GUARDED_BY(cs);
 
     //! find an nId based on its network address and port.
     std::unordered_map<CService, int, CServiceHash> mapAddr GUARDED_BY(cs);
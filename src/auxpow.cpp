@@ -9,6 +9,7 @@
 
 #include <consensus/consensus.h>
 #include <consensus/merkle.h>
+#include <crypto/sha256.h>
 #include <hash.h>
 #include <primitives/block.h>
 #include <script/script.h>
@@ -38,6 +39,18 @@ DecodeLE32 (const unsigned char* bytes)
 
 bool CAuxPow::check (const uint256& hashAuxBlock, int nChainId,
                 const Consensus::Params& params) const
+{
+    MerkleRoots roots;
+    if (vChainMerkleBranch.size() <= 30)
+      {
+        roots.chainRoot = CheckMerkleBranch (hashAuxBlock, vChainMerkleBranch, nChainIndex);
+        roots.parentRoot = CheckMerkleBranch (coinbaseTx->GetHash (), vMerkleBranch, 0);
+      }
+    return check (hashAuxBlock, nChainId, params, roots);
+}
+
+bool CAuxPow::check (const uint256& hashAuxBlock, int nChainId,
+                const Consensus::Params& params, const MerkleRoots& roots) const
 {
     if (params.fStrictChainId) {
         const int32_t nChainIDParent = parentBlock.GetChainId();
@@ -55,13 +68,12 @@ bool CAuxPow::check (const uint256& hashAuxBlock, int nChainId,
         return error("Aux POW chain merkle branch too long");
 
     // Check that the chain merkle root is in the coinbase
-    const uint256 nRootHash = CheckMerkleBranch (hashAuxBlock, vChainMerkleBranch, nChainIndex);
+    const uint256& nRootHash = roots.chainRoot;
     valtype vchRootHash(nRootHash.begin(), nRootHash.end());
     std::reverse(vchRootHash.begin(), vchRootHash.end()); // correct endian
 
     // Check that we are in the parent block merkle tree
-    if (CheckMerkleBranch(coinbaseTx->GetHash(), vMerkleBranch, 0)
-          != parentBlock.hashMerkleRoot)
+    if (roots.parentRoot != parentBlock.hashMerkleRoot)
         return error("Aux POW merkle root incorrect");
 
     // Check that there is at least one input.
@@ -157,6 +169,95 @@ CAuxPow::CheckMerkleBranch (uint256 hash,
   return hash;
 }
 
+void
+CAuxPow::CheckMerkleBranches (std::vector<uint256>& hashes,
+                              const std::vector<const std::vector<uint256>*>& branches,
+                              std::vector<int> indices)
+{
+  assert (hashes.size () == branches.size () && hashes.size () == indices.size ());
+
+  std::vector<size_t> active;
+  for (size_t i = 0; i < hashes.size (); ++i)
+    {
+      if (indices[i] == -1)
+        hashes[i] = uint256 ();
+      else if (!branches[i]->empty ())
+        active.push_back (i);
+    }
+
+  /* Both halves of every pair are laid out in one buffer, so that a level
+     of all branches takes a single SHA256D64 call.  */
+  std::vector<unsigned char> buffer;
+  std::vector<uint256> digests;
+  for (size_t level = 0; !active.empty (); ++level)
+    {
+      buffer.resize (64 * active.size ());
+      for (size_t j = 0; j < active.size (); ++j)
+        {
+          const size_t i = active[j];
+          const uint256& sibling = (*branches[i])[level];
+          const bool fRight = indices[i] & 1;
+          std::copy (fRight ? sibling.begin () : hashes[i].begin (),
+                     fRight ? sibling.end () : hashes[i].end (),
+                     buffer.begin () + 64 * j);
+          std::copy (fRight ? hashes[i].begin () : sibling.begin (),
+                     fRight ? hashes[i].end () : sibling.end (),
+                     buffer.begin () + 64 * j + 32);
+          indices[i] >>= 1;
+        }
+      /* The digests come out packed, 32 bytes apart.  */
+      digests.resize (active.size ());
+      SHA256D64 (digests.data ()->begin (), buffer.data (), active.size ());
+
+      std::vector<size_t> next;
+      for (size_t j = 0; j < active.size (); ++j)
+        {
+          const size_t i = active[j];
+          hashes[i] = digests[j];
+          if (branches[i]->size () > level + 1)
+            next.push_back (i);
+        }
+      active = std::move (next);
+    }
+}
+
+std::vector<CAuxPow::MerkleRoots>
+CAuxPow::computeMerkleRoots (
+    const std::vector<std::pair<const CAuxPow*, uint256>>& auxpows)
+{
+  std::vector<uint256> hashes;
+  std::vector<const std::vector<uint256>*> branches;
+  std::vector<int> indices;
+  std::vector<size_t> lanes;
+  hashes.reserve (2 * auxpows.size ());
+  branches.reserve (2 * auxpows.size ());
+  indices.reserve (2 * auxpows.size ());
+  for (size_t i = 0; i < auxpows.size (); ++i)
+    {
+      const CAuxPow& auxpow = *auxpows[i].first;
+      /* check() rejects an overlong chain branch before looking at the
+         roots, there is no point in hashing it.  */
+      if (auxpow.vChainMerkleBranch.size () > 30)
+        continue;
+      lanes.push_back (i);
+      hashes.push_back (auxpows[i].second);
+      branches.push_back (&auxpow.vChainMerkleBranch);
+      indices.push_back (auxpow.nChainIndex);
+      hashes.push_back (auxpow.coinbaseTx->GetHash ());
+      branches.push_back (&auxpow.vMerkleBranch);
+      indices.push_back (0);
+    }
+  CheckMerkleBranches (hashes, branches, std::move (indices));
+
+  std::vector<MerkleRoots> roots(auxpows.size ());
+  for (size_t j = 0; j < lanes.size (); ++j)
+    {
+      roots[lanes[j]].chainRoot = hashes[2 * j];
+      roots[lanes[j]].parentRoot = hashes[2 * j + 1];
+    }
+  return roots;
+}
+
 std::unique_ptr<CAuxPow>
 CAuxPow::createAuxPow (const CPureBlockHeader& header)
 {
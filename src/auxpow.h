@@ -63,6 +63,15 @@ private:
                                     const std::vector<uint256>& vMerkleBranch,
                                     int nIndex);
 
+  /**
+   * Walk several merkle branches side by side, replacing each of hashes
+   * by the root CheckMerkleBranch would return for it.  Every level of all
+   * the branches is hashed with one SHA256D64 call.
+   */
+  static void CheckMerkleBranches (std::vector<uint256>& hashes,
+                                   const std::vector<const std::vector<uint256>*>& branches,
+                                   std::vector<int> indices);
+
   friend UniValue AuxpowToJSON(const CAuxPow& auxpow, Chainstate& chainstate);
   friend class auxpow_tests::CAuxPowForTest;
 
@@ -110,6 +119,33 @@ public:
   bool check (const uint256& hashAuxBlock, int nChainId,
               const Consensus::Params& params) const;
 
+  /**
+   * Roots of the merkle branches of an auxpow:  the chain merkle root that
+   * the parent coinbase commits to and the parent block's merkle root.
+   */
+  struct MerkleRoots
+  {
+    uint256 chainRoot;
+    uint256 parentRoot;
+  };
+
+  /**
+   * Check the auxpow like check() does, with the roots of its merkle
+   * branches already computed by computeMerkleRoots.
+   */
+  bool check (const uint256& hashAuxBlock, int nChainId,
+              const Consensus::Params& params, const MerkleRoots& roots) const;
+
+  /**
+   * Compute the merkle roots of several auxpows at once.  Their branches are
+   * walked side by side, so that headers sync hashes them with the multi-way
+   * SHA-256 transforms rather than one pair at a time.
+   * @param auxpows The auxpows and the hashes of their merge-mined blocks.
+   * @return The roots, in the order of auxpows.
+   */
+  static std::vector<MerkleRoots> computeMerkleRoots (
+      const std::vector<std::pair<const CAuxPow*, uint256>>& auxpows);
+
   /**
    * Returns the parent block hash.  This is used to validate the PoW.
    */
@@ -23,16 +23,30 @@ public:
                    const std::string& m_source_file, int m_source_line);
     virtual ~CBatchedLogger();
 
+    // SYSCOIN
+    bool Accepts() const { return m_accept; }
+
     template<typename... Args>
     void Batch(const std::string& fmt, const Args&... args)
     {
         if (!m_accept) {
             return;
         }
-        m_msg += "    " + strprintf(fmt, args...) + "\n";
+        m_msg += "    ";
+        m_msg += strprintf(fmt, args...);
+        m_msg += '\n';
     }
 
+    // SYSCOIN the batch goes out as one message, with -logasync one entry of the writer queue
     void Flush();
 };
 
+// SYSCOIN like LogPrint, the arguments are only evaluated when the batch is going to be logged
+#define LogBatch(logger, ...)            \
+    do {                                 \
+        if ((logger).Accepts()) {        \
+            (logger).Batch(__VA_ARGS__); \
+        }                                \
+    } while (0)
+
 #endif // SYSCOIN_BATCHEDLOGGER_H
@@ -10,10 +10,12 @@
 #include <test/util/mining.h>
 #include <test/util/script.h>
 #include <test/util/setup_common.h>
+#include <test/util/txmempool.h>
 #include <txmempool.h>
+#include <util/time.h>
 #include <validation.h>
 
-
+#include <chrono>
 #include <vector>
 
 static void AssembleBlock(benchmark::Bench& bench)
@@ -60,5 +62,76 @@ static void BlockAssemblerAddPackageTxns(benchmark::Bench& bench)
     });
 }
 
+// SYSCOIN
+static void BlockAssemblerSyscoinTxs(benchmark::Bench& bench)
+{
+    FastRandomContext det_rand{true};
+    auto testing_setup{MakeNoLogFileContext<TestChain100Setup>()};
+    testing_setup->PopulateMempool(det_rand, /*num_transactions=*/1000, /*submit=*/true);
+    CTxMemPool& mempool{*testing_setup->m_node.mempool};
+    TestMemPoolEntryHelper entry;
+    {
+        LOCK2(::cs_main, mempool.cs);
+        // PoDA txs, more than fit the blob limit of a block
+        for (int i = 0; i < 2 * MAX_DATA_BLOBS; ++i) {
+            CMutableTransaction tx;
+            tx.nVersion = SYSCOIN_TX_VERSION_NEVM_DATA_SHA3;
+            tx.vin.emplace_back(COutPoint(det_rand.rand256(), 0));
+            CNEVMData nevmData;
+            nevmData.vchVersionHash = det_rand.randbytes(32);
+            std::vector<unsigned char> vchData;
+            nevmData.SerializeData(vchData);
+            tx.vout.emplace_back(0, CScript() << OP_RETURN << vchData);
+            tx.vout[0].SetNEVMData(det_rand.randbytes(1 << 14));
+            mempool.addUnchecked(entry.Fee(10000 + i).FromTx(tx));
+        }
+        // asset allocation sends over a few assets each
+        for (int i = 0; i < 200; ++i) {
+            CMutableTransaction tx;
+            tx.nVersion = SYSCOIN_TX_VERSION_ALLOCATION_SEND;
+            tx.vin.emplace_back(COutPoint(det_rand.rand256(), 0));
+            CAssetAllocation allocation;
+            for (uint32_t n = 0; n < 4; ++n) {
+                const uint64_t nAsset{1 + det_rand.randrange(50)};
+                tx.vout.emplace_back(COIN, P2WSH_OP_TRUE, CAssetCoinInfo(nAsset, COIN));
+                allocation.voutAssets.emplace_back(nAsset, std::vector<CAssetOutValue>{CAssetOutValue(n, COIN)});
+            }
+            std::vector<unsigned char> data;
+            allocation.SerializeData(data);
+            tx.vout.emplace_back(0, CScript() << OP_RETURN << data);
+            mempool.addUnchecked(entry.Fee(5000 + i).FromTx(tx));
+        }
+    }
+    node::BlockAssembler::Options assembler_options;
+    assembler_options.test_block_validity = false;
+
+    bench.run([&] {
+        PrepareBlock(testing_setup->m_node, P2WSH_OP_TRUE, assembler_options);
+    });
+}
+
+static void BlockAssemblerCachedTemplate(benchmark::Bench& bench)
+{
+    FastRandomContext det_rand{true};
+    auto testing_setup{MakeNoLogFileContext<TestChain100Setup>()};
+    testing_setup->PopulateMempool(det_rand, /*num_transactions=*/1000, /*submit=*/true);
+    node::NodeContext& node{testing_setup->m_node};
+    node::BlockTemplateCache cache{*node.chainman, *node.mempool};
+    cache.Start();
+    const uint256 hashTip{WITH_LOCK(::cs_main, return node.chainman->ActiveTip()->GetBlockHash())};
+    const unsigned int nTransactionsUpdated{node.mempool->GetTransactionsUpdated()};
+    // the first request starts the background builds
+    while (!cache.GetBlockTemplate(hashTip, nTransactionsUpdated, P2WSH_OP_TRUE)) {
+        UninterruptibleSleep(std::chrono::milliseconds{10});
+    }
+
+    bench.run([&] {
+        assert(cache.GetBlockTemplate(hashTip, nTransactionsUpdated, P2WSH_OP_TRUE));
+    });
+    cache.Stop();
+}
+
 BENCHMARK(AssembleBlock, benchmark::PriorityLevel::HIGH);
 BENCHMARK(BlockAssemblerAddPackageTxns, benchmark::PriorityLevel::LOW);
+BENCHMARK(BlockAssemblerSyscoinTxs, benchmark::PriorityLevel::LOW);
+BENCHMARK(BlockAssemblerCachedTemplate, benchmark::PriorityLevel::LOW);
@@ -3,11 +3,13 @@
 // file COPYING or http://www.opensource.org/licenses/mit-license.php.
 
 #include <bench/bench.h>
+#include <bls/bls_batchverifier.h>
 #include <bls/bls_worker.h>
 #include <random.h>
 #include <util/time.h>
 
 #include <iostream>
+#include <set>
 
 static void BuildTestVectors(size_t count, size_t invalidCount,
                              std::vector<CBLSPublicKey>& pubKeys, std::vector<CBLSSecretKey>& secKeys, std::vector<CBLSSignature>& sigs,
@@ -118,6 +120,26 @@ static void BLS_Verify_Normal(benchmark::Bench& bench)
 }
 
 
+static void BLS_Verify_PreparedPublicKey(benchmark::Bench& bench)
+{
+    std::vector<CBLSPublicKey> pubKeys;
+    std::vector<CBLSSecretKey> secKeys;
+    std::vector<CBLSSignature> sigs;
+    std::vector<uint256> msgHashes;
+    std::vector<bool> invalid;
+    BuildTestVectors(1000, 10, pubKeys, secKeys, sigs, msgHashes, invalid);
+    std::vector<CBLSPreparedPublicKey> preparedPubKeys(pubKeys.begin(), pubKeys.end());
+
+    // Benchmark.
+    size_t i = 0;
+    bench.minEpochIterations(20).run([&] {
+        bool valid = sigs[i].VerifyInsecure(preparedPubKeys[i], msgHashes[i]);
+        assert(valid != invalid[i]);
+        i = (i + 1) % pubKeys.size();
+    });
+}
+
+
 static void BLS_Verify_LargeBlock(size_t txCount, benchmark::Bench& bench, uint32_t epoch_iters)
 {
     std::vector<CBLSPublicKey> pubKeys;
@@ -357,11 +379,95 @@ static void BLS_Verify_BatchedParallel(benchmark::Bench& bench)
     blsWorker.Stop();
 }
 
+static void BLS_Verify_BatchVerifierInvalidSources(benchmark::Bench& bench)
+{
+    // sig shares of 4 signing sessions of a 100 member quorum relayed by 40 peers, 3 of the shares are invalid
+    const size_t sessionCount{4}, memberCount{100}, sourceCount{40}, invalidCount{3};
+    std::vector<CBLSSecretKey> secKeys(memberCount);
+    for (auto& sk : secKeys) {
+        sk.MakeNewKey();
+    }
+    std::vector<uint256> signHashes(sessionCount);
+    for (auto& signHash : signHashes) {
+        signHash = GetRandHash();
+    }
+    struct Share {
+        size_t sourceId;
+        std::pair<uint256, size_t> msgId;
+        CBLSSignature sig;
+        CBLSPublicKey pubKey;
+    };
+    std::vector<Share> shares;
+    std::set<size_t> expectedBadSources;
+    FastRandomContext rng;
+    for (size_t i = 0; i < sessionCount; i++) {
+        for (size_t j = 0; j < memberCount; j++) {
+            Share share{rng.randrange(sourceCount), {signHashes[i], j}, secKeys[j].Sign(signHashes[i], false), secKeys[j].GetPublicKey()};
+            if (shares.size() < invalidCount) {
+                share.sig = secKeys[j].Sign(GetRandHash(), false);
+                expectedBadSources.emplace(share.sourceId);
+            }
+            shares.emplace_back(share);
+        }
+    }
+
+    // Benchmark.
+    bench.minEpochIterations(10).run([&] {
+        CBLSBatchVerifier<size_t, std::pair<uint256, size_t>> batchVerifier(false, true);
+        for (const auto& share : shares) {
+            batchVerifier.PushMessage(share.sourceId, share.msgId, share.msgId.first, share.sig, share.pubKey);
+        }
+        batchVerifier.Verify();
+        assert(batchVerifier.badSources == expectedBadSources);
+        assert(batchVerifier.badMessages.size() == invalidCount);
+    });
+}
+
+static void BLS_Recover(benchmark::Bench& bench, bool cachedCoefficients)
+{
+    // a chainlock quorum recovering from its threshold of shares
+    const size_t threshold{100};
+    std::vector<CBLSSecretKey> polySks(threshold);
+    for (auto& sk : polySks) {
+        sk.MakeNewKey();
+    }
+    const uint256 hash = GetRandHash();
+    std::vector<CBLSId> ids;
+    std::vector<CBLSSignature> sigShares;
+    for (size_t i = 0; i < threshold; i++) {
+        ids.emplace_back(GetRandHash());
+        CBLSSecretKey skShare;
+        skShare.SecretKeyShare(polySks, ids.back());
+        sigShares.emplace_back(skShare.Sign(hash, false));
+    }
+    const CBLSSignature expected = polySks[0].Sign(hash, false);
+    BLSLagrangeCoefficients coefficients;
+    CBLSSignature::BuildLagrangeCoefficients(ids, coefficients);
+
+    // Benchmark.
+    bench.minEpochIterations(10).run([&] {
+        CBLSSignature sig;
+        const bool ok = cachedCoefficients ? sig.Recover(sigShares, coefficients) : sig.Recover(sigShares, ids);
+        assert(ok && sig == expected);
+    });
+}
+
+static void BLS_Recover_Threshold100(benchmark::Bench& bench)
+{
+    BLS_Recover(bench, false);
+}
+
+static void BLS_Recover_Threshold100CachedCoefficients(benchmark::Bench& bench)
+{
+    BLS_Recover(bench, true);
+}
+
 BENCHMARK(BLS_PubKeyAggregate_Normal, benchmark::PriorityLevel::HIGH)
 BENCHMARK(BLS_SecKeyAggregate_Normal, benchmark::PriorityLevel::HIGH)
 BENCHMARK(BLS_SignatureAggregate_Normal, benchmark::PriorityLevel::HIGH)
 BENCHMARK(BLS_Sign_Normal, benchmark::PriorityLevel::HIGH)
 BENCHMARK(BLS_Verify_Normal, benchmark::PriorityLevel::HIGH)
+BENCHMARK(BLS_Verify_PreparedPublicKey, benchmark::PriorityLevel::HIGH)
 BENCHMARK(BLS_Verify_LargeBlock100, benchmark::PriorityLevel::HIGH)
 BENCHMARK(BLS_Verify_LargeBlock1000, benchmark::PriorityLevel::HIGH)
 BENCHMARK(BLS_Verify_LargeBlockSelfAggregated100, benchmark::PriorityLevel::HIGH)
@@ -371,3 +477,6 @@ BENCHMARK(BLS_Verify_LargeAggregatedBlock1000, benchmark::PriorityLevel::HIGH)
 BENCHMARK(BLS_Verify_LargeAggregatedBlock1000PreVerified, benchmark::PriorityLevel::HIGH)
 BENCHMARK(BLS_Verify_Batched, benchmark::PriorityLevel::HIGH)
 BENCHMARK(BLS_Verify_BatchedParallel, benchmark::PriorityLevel::HIGH)
+BENCHMARK(BLS_Verify_BatchVerifierInvalidSources, benchmark::PriorityLevel::HIGH)
+BENCHMARK(BLS_Recover_Threshold100, benchmark::PriorityLevel::HIGH)
+BENCHMARK(BLS_Recover_Threshold100CachedCoefficients, benchmark::PriorityLevel::HIGH)
@@ -105,6 +105,33 @@ public:
             memberIdx = (memberIdx + 1) % members.size();
         });
     }
+
+    // SYSCOIN how a DKG session verifies the received contributions, all members at once on the worker pool
+    void Bench_AsyncVerifyContributionShares(benchmark::Bench& bench, int invalidCount, uint32_t epoch_iters)
+    {
+        ReceiveVvecs();
+        bench.minEpochIterations(epoch_iters).run([&] {
+            std::vector<std::vector<CBLSSecretKey>> skShares(members.size());
+            std::vector<std::set<size_t>> invalidIndexes(members.size());
+            std::vector<std::future<std::vector<bool>>> futures;
+            for (const size_t memberIdx : boost::irange(members.size())) {
+                ReceiveShares(memberIdx);
+                skShares[memberIdx] = receivedSkShares;
+                for ([[maybe_unused]] const auto _ : boost::irange(invalidCount)) {
+                    int shareIdx = GetRandInternal(skShares[memberIdx].size());
+                    skShares[memberIdx][shareIdx].MakeNewKey();
+                    invalidIndexes[memberIdx].emplace(shareIdx);
+                }
+                futures.emplace_back(blsWorker.AsyncVerifyContributionShares(members[memberIdx].id, receivedVvecs, skShares[memberIdx], true, true));
+            }
+            for (const size_t memberIdx : boost::irange(members.size())) {
+                const auto result = futures[memberIdx].get();
+                for (const size_t i : boost::irange(receivedVvecs.size())) {
+                    assert(result[i] == !invalidIndexes[memberIdx].count(i));
+                }
+            }
+        });
+    }
 };
 
 static void BLSDKG_GenerateContributions(benchmark::Bench& bench, uint32_t epoch_iters, int quorumSize)
@@ -166,6 +193,15 @@ static void BLSDKG_InitDKG(benchmark::Bench& bench, uint32_t epoch_iters, int qu
     } \
     BENCHMARK(BLSDKG_VerifyContributionShares_##name##_##quorumSize, benchmark::PriorityLevel::HIGH)
 
+#define BENCH_AsyncVerifyContributionShares(name, quorumSize, invalidCount, epoch_iters) \
+    static void BLSDKG_AsyncVerifyContributionShares_##name##_##quorumSize(benchmark::Bench& bench) \
+    { \
+      std::unique_ptr<DKG> ptr = std::make_unique<DKG>(quorumSize); \
+      ptr->Bench_AsyncVerifyContributionShares(bench, invalidCount, epoch_iters); \
+      ptr.reset(); \
+    } \
+    BENCHMARK(BLSDKG_AsyncVerifyContributionShares_##name##_##quorumSize, benchmark::PriorityLevel::HIGH)
+
 BENCH_GenerateContributions(simple, 50, 50);
 BENCH_GenerateContributions(simple, 100, 5);
 
@@ -183,3 +219,6 @@ BENCH_VerifyContributionShares(simple, 400, 5, false, 1)
 BENCH_VerifyContributionShares(aggregated, 10, 5, true, 100)
 BENCH_VerifyContributionShares(aggregated, 100, 5, true, 10)
 BENCH_VerifyContributionShares(aggregated, 400, 5, true, 1)
+
+BENCH_AsyncVerifyContributionShares(aggregated, 50, 2, 1)
+BENCH_AsyncVerifyContributionShares(aggregated, 400, 5, 1)
@@ -0,0 +1,185 @@
+// Copyright (c) 2024 The Syscoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <bench/bench.h>
+#include <bls/bls.h>
+#include <bls/bls_batchverifier.h>
+#include <random.h>
+
+#include <set>
+
+// SYSCOIN Workloads of an LLMQ signing session replayed at the BLS layer, the way CSigSharesManager groups them:
+// the shares of a session arrive from several peers, are batch verified per sign hash against the public key
+// shares, and the lowest threshold members recover the signature, which is checked against the quorum key.
+
+namespace {
+
+//! Number of shares each simulated peer relays in one message
+constexpr size_t SHARES_PER_PEER{10};
+
+struct LLMQSession {
+    uint256 signHash;
+    std::vector<CBLSSignature> sigShares;
+};
+
+class LLMQQuorum
+{
+public:
+    const size_t size;
+    const size_t threshold;
+    std::vector<CBLSId> ids;
+    std::vector<CBLSPublicKey> pubKeyShares;
+    CBLSPublicKey quorumPublicKey;
+    CBLSPreparedPublicKey preparedPublicKey;
+    //! Coefficients of the lowest threshold members, as they sit in the quorum's cache between sessions
+    BLSLagrangeCoefficients coefficients;
+
+    LLMQQuorum(size_t _size, size_t _threshold) : size(_size), threshold(_threshold)
+    {
+        std::vector<CBLSSecretKey> poly(threshold);
+        for (auto& sk : poly) {
+            sk.MakeNewKey();
+        }
+        quorumPublicKey = poly[0].GetPublicKey();
+        preparedPublicKey = CBLSPreparedPublicKey(quorumPublicKey);
+        for (size_t i = 0; i < size; i++) {
+            ids.emplace_back(GetRandHash());
+            skShares.emplace_back();
+            skShares.back().SecretKeyShare(poly, ids.back());
+            pubKeyShares.emplace_back(skShares.back().GetPublicKey());
+        }
+        CBLSSignature::BuildLagrangeCoefficients(Span(ids).first(threshold), coefficients);
+    }
+
+    LLMQSession MakeSession() const
+    {
+        LLMQSession session;
+        session.signHash = GetRandHash();
+        for (const auto& sk : skShares) {
+            session.sigShares.emplace_back(sk.Sign(session.signHash, false));
+        }
+        return session;
+    }
+
+    //! Batch verify the shares of a session like one round of the sigshares worker, returning the bad peers
+    std::set<size_t> VerifyShares(const LLMQSession& session) const
+    {
+        CBLSBatchVerifier<size_t, size_t> batchVerifier(false, true);
+        for (size_t i = 0; i < size; i++) {
+            batchVerifier.PushMessage(i / SHARES_PER_PEER, i, session.signHash, session.sigShares[i], pubKeyShares[i]);
+        }
+        batchVerifier.Verify();
+        return batchVerifier.badSources;
+    }
+
+    //! Recover from the lowest threshold members and check the result against the quorum key
+    bool Recover(const LLMQSession& session) const
+    {
+        std::vector<CBLSSignature> sigShares(session.sigShares.begin(), session.sigShares.begin() + threshold);
+        CBLSSignature recoveredSig;
+        return recoveredSig.Recover(sigShares, coefficients) &&
+               recoveredSig.VerifyInsecure(preparedPublicKey, session.signHash);
+    }
+
+private:
+    std::vector<CBLSSecretKey> skShares;
+};
+
+} // namespace
+
+static void BLS_LLMQ_SigShareSession(benchmark::Bench& bench, size_t size, size_t threshold)
+{
+    const LLMQQuorum quorum(size, threshold);
+    std::vector<LLMQSession> sessions;
+    for (int i = 0; i < 4; i++) {
+        sessions.emplace_back(quorum.MakeSession());
+    }
+
+    // Benchmark.
+    size_t i = 0;
+    bench.minEpochIterations(1).run([&] {
+        const auto& session = sessions[i];
+        const bool ok = quorum.VerifyShares(session).empty() && quorum.Recover(session);
+        assert(ok);
+        i = (i + 1) % sessions.size();
+    });
+}
+
+static void BLS_LLMQ_ChainLockRecovery(benchmark::Bench& bench, size_t size, size_t threshold)
+{
+    const LLMQQuorum quorum(size, threshold);
+    std::vector<LLMQSession> sessions;
+    for (int i = 0; i < 4; i++) {
+        sessions.emplace_back(quorum.MakeSession());
+    }
+
+    // Benchmark.
+    size_t i = 0;
+    bench.minEpochIterations(5).run([&] {
+        const bool ok = quorum.Recover(sessions[i]);
+        assert(ok);
+        i = (i + 1) % sessions.size();
+    });
+}
+
+static void BLS_LLMQ_BatchVerifierBadShares(benchmark::Bench& bench, size_t size, size_t badPercent)
+{
+    const LLMQQuorum quorum(size, size * 3 / 5);
+    LLMQSession session = quorum.MakeSession();
+
+    // shares signed over another hash by random members, each bad one taints the peer relaying it
+    FastRandomContext rng(/*fDeterministic=*/true);
+    std::set<size_t> badPeers;
+    CBLSSecretKey badKey;
+    badKey.MakeNewKey();
+    const CBLSSignature badSig = badKey.Sign(GetRandHash(), false);
+    for (size_t n = 0; n < size * badPercent / 100; n++) {
+        const size_t i = rng.randrange(size);
+        session.sigShares[i] = badSig;
+        badPeers.emplace(i / SHARES_PER_PEER);
+    }
+
+    // Benchmark.
+    bench.minEpochIterations(1).run([&] {
+        const bool ok = quorum.VerifyShares(session) == badPeers;
+        assert(ok);
+    });
+}
+
+static void BLS_LLMQ_SigShareSession_400(benchmark::Bench& bench)
+{
+    BLS_LLMQ_SigShareSession(bench, 400, 240);
+}
+
+static void BLS_LLMQ_SigShareSession_50(benchmark::Bench& bench)
+{
+    BLS_LLMQ_SigShareSession(bench, 50, 30);
+}
+
+static void BLS_LLMQ_ChainLockRecovery_400(benchmark::Bench& bench)
+{
+    BLS_LLMQ_ChainLockRecovery(bench, 400, 240);
+}
+
+static void BLS_LLMQ_BatchVerifier_400_NoBadShares(benchmark::Bench& bench)
+{
+    BLS_LLMQ_BatchVerifierBadShares(bench, 400, 0);
+}
+
+static void BLS_LLMQ_BatchVerifier_400_1PctBadShares(benchmark::Bench& bench)
+{
+    BLS_LLMQ_BatchVerifierBadShares(bench, 400, 1);
+}
+
+static void BLS_LLMQ_BatchVerifier_400_10PctBadShares(benchmark::Bench& bench)
+{
+    BLS_LLMQ_BatchVerifierBadShares(bench, 400, 10);
+}
+
+BENCHMARK(BLS_LLMQ_SigShareSession_400, benchmark::PriorityLevel::HIGH)
+BENCHMARK(BLS_LLMQ_SigShareSession_50, benchmark::PriorityLevel::HIGH)
+BENCHMARK(BLS_LLMQ_ChainLockRecovery_400, benchmark::PriorityLevel::HIGH)
+BENCHMARK(BLS_LLMQ_BatchVerifier_400_NoBadShares, benchmark::PriorityLevel::HIGH)
+BENCHMARK(BLS_LLMQ_BatchVerifier_400_1PctBadShares, benchmark::PriorityLevel::HIGH)
+BENCHMARK(BLS_LLMQ_BatchVerifier_400_10PctBadShares, benchmark::PriorityLevel::HIGH)
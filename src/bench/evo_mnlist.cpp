@@ -0,0 +1,78 @@
+// Copyright (c) 2024 The Syscoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <bench/bench.h>
+#include <bls/bls.h>
+#include <compat/compat.h>
+#include <evo/deterministicmns.h>
+#include <random.h>
+
+#include <vector>
+
+static constexpr size_t MN_LIST_SIZE{3000};
+
+static CDeterministicMNList BuildMNList(std::vector<CService>& services, std::vector<CBLSPublicKey>& operatorKeys)
+{
+    CDeterministicMNList mnList(GetRandHash(), 1, 0);
+    for (size_t i = 0; i < MN_LIST_SIZE; ++i) {
+        CBLSSecretKey sk;
+        sk.MakeNewKey();
+        auto state = std::make_shared<CDeterministicMNState>();
+        const uint256 ownerHash{GetRandHash()};
+        state->keyIDOwner = CKeyID(uint160(Span{ownerHash}.first(20)));
+        state->pubKeyOperator.Set(sk.GetPublicKey(), /*specificLegacyScheme=*/false);
+        in_addr ipv4;
+        ipv4.s_addr = htonl(0x0a000000 + i);
+        state->addr = CService(CNetAddr(ipv4), 8369);
+        auto dmn = std::make_shared<CDeterministicMN>(i);
+        dmn->proTxHash = GetRandHash();
+        dmn->collateralOutpoint = COutPoint(GetRandHash(), 0);
+        dmn->pdmnState = state;
+        mnList.AddMN(dmn);
+        services.push_back(state->addr);
+        operatorKeys.push_back(sk.GetPublicKey());
+    }
+    return mnList;
+}
+
+static void MNListGetByService(benchmark::Bench& bench)
+{
+    std::vector<CService> services;
+    std::vector<CBLSPublicKey> operatorKeys;
+    const CDeterministicMNList mnList{BuildMNList(services, operatorKeys)};
+    size_t i{0};
+    bench.run([&] {
+        const auto dmn = mnList.GetMNByService(services[i++ % services.size()]);
+        assert(dmn);
+    });
+}
+
+// the lookup through the hashed unique properties GetMNByService used before
+static void MNListGetByServiceUniqueProperty(benchmark::Bench& bench)
+{
+    std::vector<CService> services;
+    std::vector<CBLSPublicKey> operatorKeys;
+    const CDeterministicMNList mnList{BuildMNList(services, operatorKeys)};
+    size_t i{0};
+    bench.run([&] {
+        const auto dmn = mnList.GetUniquePropertyMN(services[i++ % services.size()]);
+        assert(dmn);
+    });
+}
+
+static void MNListGetByOperatorKey(benchmark::Bench& bench)
+{
+    std::vector<CService> services;
+    std::vector<CBLSPublicKey> operatorKeys;
+    const CDeterministicMNList mnList{BuildMNList(services, operatorKeys)};
+    size_t i{0};
+    bench.run([&] {
+        const auto dmn = mnList.GetMNByOperatorKey(operatorKeys[i++ % operatorKeys.size()]);
+        assert(dmn);
+    });
+}
+
+BENCHMARK(MNListGetByService, benchmark::PriorityLevel::HIGH);
+BENCHMARK(MNListGetByServiceUniqueProperty, benchmark::PriorityLevel::HIGH);
+BENCHMARK(MNListGetByOperatorKey, benchmark::PriorityLevel::HIGH);
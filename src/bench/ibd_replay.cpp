@@ -0,0 +1,288 @@
+// Copyright (c) 2024 The Syscoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <bench/bench.h>
+#include <chainparams.h>
+#include <consensus/amount.h>
+#include <consensus/consensus.h>
+#include <consensus/validation.h>
+#include <hash.h>
+#include <nevm/sha3.h>
+#include <pow.h>
+#include <primitives/block.h>
+#include <random.h>
+#include <streams.h>
+#include <test/util/mining.h>
+#include <test/util/script.h>
+#include <test/util/setup_common.h>
+#include <tinyformat.h>
+#include <util/time.h>
+#include <validation.h>
+#include <validationinterface.h>
+#include <version.h>
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+/**
+ * Replays a recorded range of Syscoin blocks through ProcessNewBlock() into a
+ * fresh node, the way they arrive during IBD. The range is mined on regtest
+ * with NEVM active from block 1, so every block carries an NEVM commitment that
+ * goes to a mock of the Geth responder, and the recorded blocks hold PoDA blobs
+ * next to plain spends. The cumulative stage timers of ConnectBlock() and
+ * ConnectTip() are reported per block, to compare releases stage by stage.
+ */
+
+//! blocks of the recorded range, each spends the fan-out of a matured coinbase confirmed before it
+static constexpr int REPLAY_BLOCKS{40};
+static constexpr int TXS_PER_BLOCK{40};
+static constexpr int BLOBS_PER_BLOCK{6};
+static constexpr size_t BLOB_SIZE{1 << 16};
+static constexpr size_t NEVM_BLOCK_DATA_SIZE{1 << 12};
+static constexpr CAmount REPLAY_FEE{COIN / 100};
+
+namespace {
+/** Answers the NEVM signals in place of Geth and the ZMQ notifier, accepting every block after an optional delay */
+class MockNEVMResponder final : public CValidationInterface
+{
+public:
+    explicit MockNEVMResponder(std::chrono::microseconds latency) : m_latency{latency} {}
+
+    std::atomic<uint64_t> m_connects{0};
+    std::atomic<uint64_t> m_disconnects{0};
+
+protected:
+    void NotifyGetNEVMBlock(CNEVMBlock& evmBlock, std::string& state) override
+    {
+        const uint64_t n{m_fetched++};
+        evmBlock.nBlockHash = (HashWriter{} << std::string{"nevm-block"} << n).GetHash();
+        evmBlock.nTxRoot = (HashWriter{} << std::string{"nevm-txroot"} << n).GetHash();
+        evmBlock.nReceiptRoot = (HashWriter{} << std::string{"nevm-receiptroot"} << n).GetHash();
+        evmBlock.vchNEVMBlockData.assign(NEVM_BLOCK_DATA_SIZE, static_cast<uint8_t>(n));
+    }
+    void NotifyNEVMBlockConnect(const CNEVMHeader& evmBlock, const CBlock& block, std::string& state, const uint256& nBlockHash, NEVMDataVec& NEVMDataVecOut, const uint32_t& nHeight, bool bSkipValidation, const CDeterministicMNListNEVMAddressDiff& diff) override
+    {
+        if (m_latency > 0us) UninterruptibleSleep(m_latency);
+        ++m_connects;
+    }
+    void NotifyNEVMBlockDisconnect(std::string& state, const uint256& nBlockHash, const CDeterministicMNListNEVMAddressDiff& diff) override
+    {
+        ++m_disconnects;
+    }
+    void NotifyGetNEVMBlockInfo(uint64_t& nHeight, std::string& state) override
+    {
+        nHeight = m_fetched;
+    }
+    void NotifyNEVMComms(const std::string& commMessage, bool& bResponse) override
+    {
+        bResponse = true;
+    }
+
+private:
+    const std::chrono::microseconds m_latency;
+    uint64_t m_fetched{0};
+};
+
+/** Keeps the node talking to the mock responder over the NEVM signals for its lifetime */
+class NEVMConnectionScope
+{
+public:
+    explicit NEVMConnectionScope(MockNEVMResponder& responder) : m_responder{responder}, m_prev{fNEVMConnection}
+    {
+        fNEVMConnection = true;
+        RegisterValidationInterface(&m_responder);
+    }
+    ~NEVMConnectionScope()
+    {
+        UnregisterValidationInterface(&m_responder);
+        fNEVMConnection = m_prev;
+    }
+
+private:
+    MockNEVMResponder& m_responder;
+    const bool m_prev;
+};
+
+struct RecordedOutput {
+    COutPoint outpoint;
+    CAmount nValue;
+};
+
+const std::vector<const char*> REPLAY_ARGS{"-nevmstartheight=1"};
+
+CMutableTransaction SpendOpTrue(const RecordedOutput& in)
+{
+    CMutableTransaction tx;
+    tx.vin.emplace_back(in.outpoint);
+    tx.vin.back().scriptWitness.stack.push_back(WITNESS_STACK_ELEM_OP_TRUE);
+    return tx;
+}
+
+void Submit(ChainstateManager& chainman, const CMutableTransaction& tx)
+{
+    LOCK(::cs_main);
+    const MempoolAcceptResult res = chainman.ProcessTransaction(MakeTransactionRef(tx));
+    assert(res.m_result_type == MempoolAcceptResult::ResultType::VALID);
+}
+
+/** Split a matured coinbase into the outputs the spends of the next block use */
+RecordedOutput SubmitFanout(ChainstateManager& chainman, const RecordedOutput& matured)
+{
+    CMutableTransaction fanout{SpendOpTrue(matured)};
+    const CAmount nSplit{(matured.nValue - REPLAY_FEE) / (TXS_PER_BLOCK + BLOBS_PER_BLOCK)};
+    for (int n = 0; n < TXS_PER_BLOCK + BLOBS_PER_BLOCK; ++n) {
+        fanout.vout.emplace_back(nSplit, P2WSH_OP_TRUE);
+    }
+    Submit(chainman, fanout);
+    return {COutPoint(fanout.GetHash(), 0), nSplit};
+}
+
+/** Mine the mempool into the next block and keep its network serialization, which carries the blobs */
+RecordedOutput MineAndRecord(const node::NodeContext& node, std::vector<CDataStream>& recorded)
+{
+    auto block = PrepareBlock(node, P2WSH_OP_TRUE);
+    while (!CheckProofOfWork(block->GetHash(), block->nBits, Params().GetConsensus())) {
+        ++block->nNonce;
+        assert(block->nNonce);
+    }
+    CDataStream ss(SER_NETWORK, PROTOCOL_VERSION);
+    ss << *block;
+    recorded.push_back(std::move(ss));
+    bool new_block{false};
+    assert(Assert(node.chainman)->ProcessNewBlock(block, true, true, &new_block));
+    assert(new_block);
+    return {COutPoint(block->vtx[0]->GetHash(), 0), block->vtx[0]->vout[0].nValue};
+}
+
+/**
+ * Record the chain: the COINBASE_MATURITY + 1 blocks of the prefix only pay their
+ * coinbase, the last one also confirms the first fan-out. Each of the REPLAY_BLOCKS
+ * blocks after it spends the fan-out confirmed before it into plain spends and PoDA
+ * blobs, and confirms the fan-out of the next matured coinbase. The fan-outs are
+ * confirmed first as their spends would exceed the descendant limit of the mempool.
+ */
+std::vector<CDataStream> RecordBlocks()
+{
+    std::vector<CDataStream> recorded;
+    MockNEVMResponder responder{0us};
+    const auto source{MakeNoLogFileContext<TestingSetup>(ChainType::REGTEST, REPLAY_ARGS)};
+    NEVMConnectionScope scope{responder};
+    const node::NodeContext& node{source->m_node};
+    ChainstateManager& chainman{*Assert(node.chainman)};
+    FastRandomContext det_rand{true};
+
+    std::vector<RecordedOutput> coinbases;
+    for (int i = 0; i < COINBASE_MATURITY; ++i) {
+        coinbases.push_back(MineAndRecord(node, recorded));
+    }
+    RecordedOutput fanout{SubmitFanout(chainman, coinbases.at(0))};
+    coinbases.push_back(MineAndRecord(node, recorded));
+    for (int i = 0; i < REPLAY_BLOCKS; ++i) {
+        const CAmount nSplit{fanout.nValue};
+        for (int n = 0; n < TXS_PER_BLOCK; ++n) {
+            CMutableTransaction tx{SpendOpTrue({COutPoint(fanout.outpoint.hash, n), nSplit})};
+            tx.vout.emplace_back((nSplit - REPLAY_FEE) / 2, P2WSH_OP_TRUE);
+            tx.vout.emplace_back((nSplit - REPLAY_FEE) / 2, P2WSH_OP_TRUE);
+            Submit(chainman, tx);
+        }
+        for (int n = TXS_PER_BLOCK; n < TXS_PER_BLOCK + BLOBS_PER_BLOCK; ++n) {
+            CMutableTransaction tx{SpendOpTrue({COutPoint(fanout.outpoint.hash, n), nSplit})};
+            tx.nVersion = SYSCOIN_TX_VERSION_NEVM_DATA_SHA3;
+            std::vector<uint8_t> blob{det_rand.randbytes(BLOB_SIZE)};
+            CNEVMData nevmData;
+            nevmData.vchVersionHash = dev::sha3(blob).asBytes();
+            std::vector<unsigned char> vchData;
+            nevmData.SerializeData(vchData);
+            tx.vout.emplace_back(0, CScript() << OP_RETURN << vchData);
+            tx.vout.back().SetNEVMData(std::move(blob));
+            tx.vout.emplace_back(nSplit - REPLAY_FEE, P2WSH_OP_TRUE);
+            Submit(chainman, tx);
+        }
+        fanout = SubmitFanout(chainman, coinbases.at(i + 1));
+        coinbases.push_back(MineAndRecord(node, recorded));
+        assert(Assert(node.mempool)->size() == 0);
+    }
+    SyncWithValidationInterfaceQueue();
+    return recorded;
+}
+
+void ProcessRecorded(ChainstateManager& chainman, const std::vector<CDataStream>& recorded, size_t begin, size_t end)
+{
+    for (size_t i = begin; i < end; ++i) {
+        CDataStream ss{recorded[i]};
+        auto block = std::make_shared<CBlock>();
+        ss >> *block;
+        bool new_block{false};
+        assert(chainman.ProcessNewBlock(block, true, true, &new_block));
+        assert(new_block);
+    }
+}
+
+void Accumulate(BlockConnectTimings& sum, const BlockConnectTimings& before, const BlockConnectTimings& after)
+{
+    sum.blocks += after.blocks - before.blocks;
+    sum.check += after.check - before.check;
+    sum.forks += after.forks - before.forks;
+    sum.special += after.special - before.special;
+    sum.nevm += after.nevm - before.nevm;
+    sum.connect += after.connect - before.connect;
+    sum.verify += after.verify - before.verify;
+    sum.undo += after.undo - before.undo;
+    sum.index += after.index - before.index;
+    sum.connect_total += after.connect_total - before.connect_total;
+    sum.flush += after.flush - before.flush;
+    sum.chainstate += after.chainstate - before.chainstate;
+    sum.post_connect += after.post_connect - before.post_connect;
+    sum.total += after.total - before.total;
+}
+
+void PrintTimings(const std::string& name, const BlockConnectTimings& sum)
+{
+    if (sum.blocks == 0) return;
+    const auto per_block = [&](SteadyClock::duration d) { return Ticks<MillisecondsDouble>(d) / sum.blocks; };
+    tfm::format(std::cout, "%s, per block over %d replayed blocks (ms):\n", name, sum.blocks);
+    tfm::format(std::cout, "  ConnectBlock: checks %.3f, forks %.3f, special txs %.3f, PoDA+NEVM %.3f, connect %.3f, verify %.3f, undo %.3f, index %.3f\n",
+                per_block(sum.check), per_block(sum.forks), per_block(sum.special), per_block(sum.nevm),
+                per_block(sum.connect), per_block(sum.verify), per_block(sum.undo), per_block(sum.index));
+    tfm::format(std::cout, "  ConnectTip: connect %.3f, flush %.3f, chainstate %.3f, postprocess %.3f, total %.3f\n",
+                per_block(sum.connect_total), per_block(sum.flush), per_block(sum.chainstate),
+                per_block(sum.post_connect), per_block(sum.total));
+}
+} // namespace
+
+static void IBDReplay(benchmark::Bench& bench, std::chrono::microseconds nevm_latency)
+{
+    const std::vector<CDataStream> recorded{RecordBlocks()};
+    const size_t nPrefix{static_cast<size_t>(COINBASE_MATURITY) + 1};
+    BlockConnectTimings sum;
+
+    // the headline covers the setup of the node and all blocks, the stage timings only the recorded range
+    bench.unit("block").batch(recorded.size()).epochs(3).epochIterations(1).run([&] {
+        MockNEVMResponder responder{nevm_latency};
+        const auto replay{MakeNoLogFileContext<TestingSetup>(ChainType::REGTEST, REPLAY_ARGS)};
+        NEVMConnectionScope scope{responder};
+        ChainstateManager& chainman{*Assert(replay->m_node.chainman)};
+        // the blocks that only mature the coinbases are replayed too, but kept out of the stage timings
+        ProcessRecorded(chainman, recorded, 0, nPrefix);
+        const BlockConnectTimings before{WITH_LOCK(::cs_main, return GetBlockConnectTimings())};
+        ProcessRecorded(chainman, recorded, nPrefix, recorded.size());
+        const BlockConnectTimings after{WITH_LOCK(::cs_main, return GetBlockConnectTimings())};
+        Accumulate(sum, before, after);
+        assert(WITH_LOCK(::cs_main, return chainman.ActiveHeight()) == static_cast<int>(recorded.size()));
+        assert(responder.m_connects == recorded.size());
+        SyncWithValidationInterfaceQueue();
+    });
+    if (bench.output() != nullptr) {
+        PrintTimings(bench.name(), sum);
+    }
+}
+
+static void IBDReplayPoDA(benchmark::Bench& bench) { IBDReplay(bench, /*nevm_latency=*/0us); }
+// a Geth round trip per block, which the PoDA and NEVM stage overlaps with connecting the inputs
+static void IBDReplayPoDANEVMLatency(benchmark::Bench& bench) { IBDReplay(bench, /*nevm_latency=*/2ms); }
+
+BENCHMARK(IBDReplayPoDA, benchmark::PriorityLevel::LOW);
+BENCHMARK(IBDReplayPoDANEVMLatency, benchmark::PriorityLevel::LOW);
@@ -0,0 +1,59 @@
+// Copyright (c) 2024 The Syscoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <bench/bench.h>
+#include <random.h>
+#include <saltedhasher.h>
+#include <uint256.h>
+#include <unordered_lru_cache.h>
+
+#include <vector>
+
+// Sized like the recovered sigs caches of CRecoveredSigsDb
+static constexpr size_t CACHE_SIZE{30000};
+
+static void LRUCacheInsert(benchmark::Bench& bench)
+{
+    unordered_lru_cache<uint256, bool, StaticSaltedHasher, CACHE_SIZE> cache;
+    FastRandomContext rng{/*fDeterministic=*/true};
+    bench.run([&] {
+        cache.insert(rng.rand256(), true);
+    });
+}
+
+static void LRUCacheGet(benchmark::Bench& bench)
+{
+    unordered_lru_cache<uint256, bool, StaticSaltedHasher, CACHE_SIZE> cache;
+    std::vector<uint256> keys(CACHE_SIZE);
+    FastRandomContext rng{/*fDeterministic=*/true};
+    for (auto& key : keys) {
+        key = rng.rand256();
+        cache.insert(key, true);
+    }
+    size_t i{0};
+    bench.run([&] {
+        const bool* value = cache.get(keys[i++ % keys.size()]);
+        ankerl::nanobench::doNotOptimizeAway(value);
+    });
+}
+
+static void LRUCacheMixed(benchmark::Bench& bench)
+{
+    // a hot cache turning over: every lookup of a recent key is followed by a new key
+    unordered_lru_cache<uint256, bool, StaticSaltedHasher, CACHE_SIZE> cache;
+    std::vector<uint256> keys(CACHE_SIZE);
+    FastRandomContext rng{/*fDeterministic=*/true};
+    size_t i{0};
+    bench.run([&] {
+        bool value;
+        ankerl::nanobench::doNotOptimizeAway(cache.get(keys[rng.randrange(keys.size())], value));
+        const uint256 key{rng.rand256()};
+        cache.insert(key, true);
+        keys[i++ % keys.size()] = key;
+    });
+}
+
+BENCHMARK(LRUCacheInsert, benchmark::PriorityLevel::HIGH);
+BENCHMARK(LRUCacheGet, benchmark::PriorityLevel::HIGH);
+BENCHMARK(LRUCacheMixed, benchmark::PriorityLevel::HIGH);
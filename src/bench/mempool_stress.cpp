@@ -103,6 +103,67 @@ static void ComplexMemPool(benchmark::Bench& bench)
     });
 }
 
+// SYSCOIN
+/** Chains of asset allocation sends like ZDAG payments create, each link also has a leaf child spending its change */
+static std::vector<CTransactionRef> CreateAssetAllocationChains(int chains, int depth)
+{
+    std::vector<CTransactionRef> ordered_txs;
+    for (int chain = 0; chain < chains; ++chain) {
+        CMutableTransaction root;
+        root.vin.resize(1);
+        root.vin[0].scriptSig = CScript() << CScriptNum(chain);
+        root.vout.resize(2);
+        for (auto& out : root.vout) {
+            out.scriptPubKey = CScript() << CScriptNum(chain) << OP_EQUAL;
+            out.nValue = 10 * COIN;
+        }
+        ordered_txs.emplace_back(MakeTransactionRef(root));
+        for (int link = 0; link < depth; ++link) {
+            const uint256 parent{ordered_txs.back()->GetHash()};
+            CMutableTransaction tx;
+            tx.nVersion = SYSCOIN_TX_VERSION_ALLOCATION_SEND;
+            tx.vin.emplace_back(COutPoint(parent, 0));
+            tx.vout.resize(2);
+            for (auto& out : tx.vout) {
+                out.scriptPubKey = CScript() << CScriptNum(link) << OP_EQUAL;
+                out.nValue = COIN;
+                out.assetInfo = CAssetCoinInfo(chain + 1, 100 - link);
+            }
+            CMutableTransaction leaf;
+            leaf.nVersion = SYSCOIN_TX_VERSION_ALLOCATION_SEND;
+            leaf.vin.emplace_back(COutPoint(parent, 1));
+            leaf.vout.emplace_back(COIN, CScript() << OP_TRUE, CAssetCoinInfo(chain + 1, 1));
+            ordered_txs.emplace_back(MakeTransactionRef(leaf));
+            ordered_txs.emplace_back(MakeTransactionRef(tx));
+        }
+    }
+    return ordered_txs;
+}
+
+/** Ancestor and descendant walks over the allocation chains, then each chain is removed from its root like a conflict would */
+static void MempoolAssetAllocationChains(benchmark::Bench& bench)
+{
+    const std::vector<CTransactionRef> ordered_txs{CreateAssetAllocationChains(/*chains=*/20, /*depth=*/100)};
+    const auto testing_setup = MakeNoLogFileContext<const TestingSetup>(ChainType::MAIN);
+    CTxMemPool& pool = *testing_setup.get()->m_node.mempool;
+    LOCK2(cs_main, pool.cs);
+    bench.run([&]() NO_THREAD_SAFETY_ANALYSIS {
+        for (const auto& tx : ordered_txs) {
+            AddTx(tx, pool);
+        }
+        for (const auto& tx : ordered_txs) {
+            const auto it{*pool.GetIter(tx->GetHash())};
+            auto ancestors{pool.CalculateMemPoolAncestors(*it, CTxMemPool::Limits::NoLimits(), /*fSearchForParents=*/false)};
+            CTxMemPool::setEntries descendants;
+            pool.CalculateDescendants(it, descendants);
+            ankerl::nanobench::doNotOptimizeAway(ancestors);
+        }
+        for (const auto& tx : ordered_txs) {
+            if (tx->nVersion != SYSCOIN_TX_VERSION_ALLOCATION_SEND) pool.removeRecursive(*tx, MemPoolRemovalReason::CONFLICT);
+        }
+    });
+}
+
 static void MempoolCheck(benchmark::Bench& bench)
 {
     FastRandomContext det_rand{true};
@@ -120,3 +181,5 @@ static void MempoolCheck(benchmark::Bench& bench)
 
 BENCHMARK(ComplexMemPool, benchmark::PriorityLevel::HIGH);
 BENCHMARK(MempoolCheck, benchmark::PriorityLevel::HIGH);
+// SYSCOIN
+BENCHMARK(MempoolAssetAllocationChains, benchmark::PriorityLevel::HIGH);
@@ -0,0 +1,61 @@
+// Copyright (c) 2024 The Syscoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <bench/bench.h>
+#include <nevm/nevm.h>
+#include <util/strencodings.h>
+
+#include <cassert>
+#include <vector>
+
+// a receipt proof from test/data/nevmspv_valid.json
+static const char* PROOF_ROOT =
+    "a075c0b0870c8017ddd67d0ae4fa1ac1ea74ea36d0d6bbbfe777295dd046011c37";
+static const char* PROOF_PARENT_NODES =
+    "f904b3f90131a0327f84fcd358ee2aeda7fbf0e6908789942ff05aae12c594e5ac2cdc357e708aa04265515199acbb3bd50b8f0c510f5b61badb9171"
+    "98063ce6b4fb4781fd6d38eca022b25a3bcb4124633f5a2531a82c5cf5cd344637c4458e95973a83ece8368b7ca0ed39626817927117baf09881ad4e"
+    "2795aae1b0b306b3a5cd2f5a76412dfbe43ea0af7ab8f1a613411f443ec4bb5aa6b7db8e0b890a7f46fe3d0c31dad89fa4e78ba06b20a6fee0621de0"
+    "a659b94b4c958dd93856d7ed0b38e4e969da6a91b94cdf2aa050730b56342cb4497a98de0439b1e14fb481be375f380ac032f9813caa1d7c5ba016cf"
+    "adf82671b4b1c7ce6e372e7ca5e6d51f08c1a24c67b721cc413dbc214e77a0cbdd0f5d4d60cae16f62f5c8353c21d47fe4e06b3d6340fa7fd2401070"
+    "4ca5268080808080808080f871a03bb912febb652feb2a57eaf73224e4805327b6d8ac1c0a71e0b5616a7fb30944a0bd1994da90e44abd68e5d02057"
+    "ec43014942346cc7a1f9d926c1fcde3c1d48dda036b517af861c6ea84233576b639bcf39ae3dee66c5510f3b82ded29b1df1af848080808080808080"
+    "808080808080e4821010a0473be7ae92ef7a9e1190d2e5e5911f34dc7fdeda3789367c62b4aa8beb1bc8f6f901d1a036677d3845ce452fb05f3becdf"
+    "710e27f1a1b1d3c7a92f00b04b97cd67a85b76a03f869e64aec1935fd03ad958fbb7c32ec33e382d8ca1cb3ab53e35dc8edd6298a0cd6abbc4229bb3"
+    "980872b5cf5523535cf1f23f7ca0adb172d1dba9a787da977da0405f3db426655a703325f5e7602d94c8fcf203599f56c80d582c1580334e73e1a063"
+    "d621ecadf059ac2a66b29cfc98065b6f9d2c0c91a57de116a4adebc6d70bb6a0489b126f4dd0b4f5fee83a388870c34eacaa19b901f8bf7e3e88c6f8"
+    "f01bddc5a07825830bb1d1be9ed9678d91f75c1cf3b4e27484475102eb8aa5af87375dfeeba09fe59dd942ef7716ecfd87bea738807c9ab59a71b927"
+    "71fcfea259819e412e6fa02ac4f50fedfe8bd3d9be4512d8ecbfdd1e88637a977476d60209b149f59df972a045e65c95e40d3e6bdd5aa307bb0f34e7"
+    "c34f7c1487a2921e1ea2b40967c8dfdaa0e5db693d27888c6063fdd1a77fda01e4bab6bef25c01c856e16ac363a2a0a789a02d97b0515b00ff34015c"
+    "49179c52bba077720a2d3668fa1b1756da1e001ab41ba0f234eb44563801832cd7ab37c730d9069246837f12afd23a0deeaddd75406d2aa07592293e"
+    "55a2265fdbf7ae4d5d3ffeb6dec8253fa9e6eb381544c4208ae9a925808080f9011020b9010cf901098083ccb472b901000000000000000000000000"
+    "000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000"
+    "000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000"
+    "000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000"
+    "000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000"
+    "0000000000c0";
+static const char* PROOF_VALUE =
+    "f901098083ccb472b9010000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000"
+    "000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000"
+    "000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000"
+    "000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000"
+    "000000000000000000000000000000000000000000000000000000c0";
+static const char* PROOF_PATH = "820100";
+
+static void NEVMVerifyProof(benchmark::Bench& bench)
+{
+    const std::vector<unsigned char> vchRoot = ParseHex(PROOF_ROOT);
+    const std::vector<unsigned char> vchParentNodes = ParseHex(PROOF_PARENT_NODES);
+    const std::vector<unsigned char> vchValue = ParseHex(PROOF_VALUE);
+    const std::vector<unsigned char> vchPath = ParseHex(PROOF_PATH);
+    const dev::RLP rlpRoot(&vchRoot);
+    const dev::RLP rlpParentNodes(&vchParentNodes);
+    const dev::RLP rlpValue(&vchValue);
+    const dev::bytesConstRef pathRef(vchPath.data(), vchPath.size());
+    bench.batch(vchParentNodes.size()).unit("byte").run([&] {
+        const bool valid = VerifyProof(pathRef, rlpValue.data(), rlpParentNodes, rlpRoot.payload());
+        assert(valid);
+    });
+}
+
+BENCHMARK(NEVMVerifyProof, benchmark::PriorityLevel::HIGH);
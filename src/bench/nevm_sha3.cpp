@@ -0,0 +1,62 @@
+// Copyright (c) 2024 The Syscoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <bench/bench.h>
+#include <nevm/sha3.h>
+#include <primitives/transaction.h>
+#include <tinyformat.h>
+
+#include <vector>
+
+/* Number of bytes to hash per iteration for the single stream benchmarks */
+static const uint64_t BUFFER_SIZE = 1000*1000;
+/* Number of blobs hashed per iteration, matches blobs per CBlobCheck with the 4 way backend */
+static const size_t BLOB_COUNT = 4;
+
+static void KECCAK256_1M(benchmark::Bench& bench)
+{
+    std::vector<uint8_t> in(BUFFER_SIZE,0);
+    bench.batch(in.size()).unit("byte").run([&] {
+        dev::sha3(in);
+    });
+}
+
+static void KECCAK256_532b(benchmark::Bench& bench)
+{
+    // a full branch node of a Merkle Patricia trie proof, 16 hashes plus RLP overhead
+    std::vector<uint8_t> in(532,0);
+    bench.batch(in.size()).unit("byte").run([&] {
+        dev::sha3(in);
+    });
+}
+
+static void KeccakBlobs(benchmark::Bench& bench, const char* name, bool use_avx2)
+{
+    bench.name(strprintf("%s using the '%s' Keccak implementation", name, dev::KeccakAutoDetect(use_avx2)));
+    std::vector<std::vector<uint8_t>> blobs(BLOB_COUNT, std::vector<uint8_t>(MAX_NEVM_DATA_BLOB, 0));
+    std::vector<dev::bytesConstRef> inputs;
+    for (const auto& blob : blobs) {
+        inputs.emplace_back(&blob);
+    }
+    std::vector<dev::h256> hashes(BLOB_COUNT);
+    bench.batch(BLOB_COUNT * MAX_NEVM_DATA_BLOB).unit("byte").run([&] {
+        dev::sha3Batch(inputs.data(), hashes.data(), inputs.size());
+    });
+    dev::KeccakAutoDetect();
+}
+
+static void KECCAK256_BLOBS_STANDARD(benchmark::Bench& bench)
+{
+    KeccakBlobs(bench, __func__, false);
+}
+
+static void KECCAK256_BLOBS_AVX2(benchmark::Bench& bench)
+{
+    KeccakBlobs(bench, __func__, true);
+}
+
+BENCHMARK(KECCAK256_1M, benchmark::PriorityLevel::HIGH);
+BENCHMARK(KECCAK256_532b, benchmark::PriorityLevel::HIGH);
+BENCHMARK(KECCAK256_BLOBS_STANDARD, benchmark::PriorityLevel::HIGH);
+BENCHMARK(KECCAK256_BLOBS_AVX2, benchmark::PriorityLevel::HIGH);
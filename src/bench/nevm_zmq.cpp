@@ -0,0 +1,81 @@
+// Copyright (c) 2024 The Syscoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <bench/bench.h>
+#include <evo/deterministicmns.h>
+#include <primitives/block.h>
+#include <primitives/transaction.h>
+#include <uint256.h>
+#include <zmq/zmqabstractnotifier.h>
+#include <zmq/zmqnevmresponder.h>
+#include <zmq/zmqnotificationinterface.h>
+#include <zmq/zmqpublishnotifier.h>
+
+#include <zmq.h>
+
+#include <cassert>
+#include <chrono>
+#include <string>
+
+using namespace std::chrono_literals;
+
+// a typical round trip to a Geth node on the same host and the time it takes for a small block
+static constexpr std::chrono::microseconds NEVM_LATENCY{1ms};
+static constexpr std::chrono::microseconds NEVM_BLOCK_TIME{50us};
+
+// Block connects sent to a mock Geth node, which shows what pipelining and batching save on the round trips.
+static void NEVMConnect(benchmark::Bench& bench, int window, int batch)
+{
+    nNEVMPipelineWindow = window;
+    nNEVMBatchSize = batch;
+    CZMQNEVMResponder::Options options;
+    options.latency = NEVM_LATENCY;
+    options.block_time = NEVM_BLOCK_TIME;
+    CZMQNEVMResponder responder{options};
+    const bool started{responder.Start("tcp://127.0.0.1:*")};
+    assert(started);
+    void* context = zmq_ctx_new();
+    assert(context);
+    {
+        CZMQPublishNEVMBlockConnectNotifier notifier;
+        notifier.SetType("pubnevmconnect");
+        notifier.SetAddress(responder.Endpoint());
+        notifier.SetAddressSub(responder.Endpoint());
+        const bool initialized{notifier.Initialize(context, context)};
+        assert(initialized);
+
+        CNEVMHeader evmBlock;
+        evmBlock.nBlockHash = uint256::ONEV;
+        evmBlock.nTxRoot = uint256::ONEV;
+        evmBlock.nReceiptRoot = uint256::ONEV;
+        CBlock block;
+        block.vchNEVMBlockData.assign(4096, 0x5a);
+        NEVMDataVec NEVMDataVecOut;
+        const CDeterministicMNListNEVMAddressDiff diff;
+        // only assumed-valid blocks are pipelined or batched, for the others Geth has to answer first
+        const bool bSkipValidation{window > 1 || batch > 1};
+        uint32_t nHeight{0};
+        bench.run([&] {
+            std::string state;
+            const bool ok = notifier.NotifyNEVMBlockConnect(evmBlock, block, state, uint256::ONEV, NEVMDataVecOut, ++nHeight, bSkipValidation, diff);
+            assert(ok);
+        });
+        // waits for the acks still in flight
+        notifier.Shutdown();
+    }
+    zmq_ctx_term(context);
+    assert(responder.GetStats().rejected == 0);
+    nNEVMPipelineWindow = CZMQAbstractNotifier::DEFAULT_NEVM_PIPELINE_WINDOW;
+    nNEVMBatchSize = CZMQAbstractNotifier::DEFAULT_NEVM_BATCH_SIZE;
+}
+
+static void NEVMConnectLockstep(benchmark::Bench& bench) { NEVMConnect(bench, 1, 1); }
+static void NEVMConnectPipelined(benchmark::Bench& bench) { NEVMConnect(bench, 32, 1); }
+static void NEVMConnectBatched(benchmark::Bench& bench) { NEVMConnect(bench, 1, 32); }
+static void NEVMConnectPipelinedBatched(benchmark::Bench& bench) { NEVMConnect(bench, 4, 16); }
+
+BENCHMARK(NEVMConnectLockstep, benchmark::PriorityLevel::LOW);
+BENCHMARK(NEVMConnectPipelined, benchmark::PriorityLevel::LOW);
+BENCHMARK(NEVMConnectBatched, benchmark::PriorityLevel::LOW);
+BENCHMARK(NEVMConnectPipelinedBatched, benchmark::PriorityLevel::LOW);
@@ -0,0 +1,70 @@
+// Copyright (c) 2024 The Syscoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <bench/bench.h>
+#include <random.h>
+#include <saltedhasher.h>
+#include <uint256.h>
+
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+// Sized like the sig share and recovered sig tables of the LLMQ managers
+static constexpr size_t MAP_SIZE{30000};
+
+static std::vector<uint256> MakeKeys()
+{
+    std::vector<uint256> keys(MAP_SIZE);
+    FastRandomContext rng{/*fDeterministic=*/true};
+    for (auto& key : keys) {
+        key = rng.rand256();
+    }
+    return keys;
+}
+
+static void Uint256Equal(benchmark::Bench& bench)
+{
+    const std::vector<uint256> keys{MakeKeys()};
+    size_t i{0};
+    bench.run([&] {
+        // equal in all but the last word, the case a hash table lookup has to confirm
+        uint256 other{keys[i % keys.size()]};
+        other.data()[31] ^= uint8_t(i & 1);
+        const bool equal{keys[i++ % keys.size()] == other};
+        ankerl::nanobench::doNotOptimizeAway(equal);
+    });
+}
+
+static void Uint256SaltedMapFind(benchmark::Bench& bench)
+{
+    const std::vector<uint256> keys{MakeKeys()};
+    std::unordered_map<uint256, int, StaticSaltedHasher> map;
+    for (const auto& key : keys) {
+        map.emplace(key, 0);
+    }
+    size_t i{0};
+    bench.run([&] {
+        const auto it{map.find(keys[i++ % keys.size()])};
+        ankerl::nanobench::doNotOptimizeAway(it);
+    });
+}
+
+static void Uint256OrderedMapFind(benchmark::Bench& bench)
+{
+    const std::vector<uint256> keys{MakeKeys()};
+    std::map<uint256, int> map;
+    for (const auto& key : keys) {
+        map.emplace(key, 0);
+    }
+    size_t i{0};
+    bench.run([&] {
+        const auto it{map.find(keys[i++ % keys.size()])};
+        ankerl::nanobench::doNotOptimizeAway(it);
+    });
+}
+
+BENCHMARK(Uint256Equal, benchmark::PriorityLevel::HIGH);
+BENCHMARK(Uint256SaltedMapFind, benchmark::PriorityLevel::HIGH);
+BENCHMARK(Uint256OrderedMapFind, benchmark::PriorityLevel::HIGH);
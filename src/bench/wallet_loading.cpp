@@ -26,7 +26,28 @@ static void AddTx(CWallet& wallet)
     wallet.AddToWallet(MakeTransactionRef(mtx), TxStateInactive{});
 }
 
-static void WalletLoading(benchmark::Bench& bench, bool legacy_wallet)
+// SYSCOIN
+/** Add an allocation send of several assets, which carries its allocation payload in an OP_RETURN output */
+static void AddAssetTx(CWallet& wallet, int nTx)
+{
+    constexpr int ASSETS_PER_TX{8};
+    CMutableTransaction mtx;
+    mtx.nVersion = SYSCOIN_TX_VERSION_ALLOCATION_SEND;
+    mtx.vin.emplace_back();
+    CAssetAllocation allocation;
+    for (int i = 0; i < ASSETS_PER_TX; ++i) {
+        const uint64_t nAsset = 1 + (nTx * ASSETS_PER_TX + i) % 100;
+        mtx.vout.emplace_back(COIN, GetScriptForDestination(*Assert(wallet.GetNewDestination(OutputType::BECH32, ""))), CAssetCoinInfo(nAsset, COIN));
+        allocation.voutAssets.emplace_back(nAsset, std::vector<CAssetOutValue>{CAssetOutValue(i, COIN)});
+    }
+    std::vector<unsigned char> data;
+    allocation.SerializeData(data);
+    mtx.vout.emplace_back(0, CScript() << OP_RETURN << data);
+
+    wallet.AddToWallet(MakeTransactionRef(mtx), TxStateInactive{});
+}
+
+static void WalletLoading(benchmark::Bench& bench, bool legacy_wallet, bool asset_txs = false)
 {
     const auto test_setup = MakeNoLogFileContext<TestingSetup>();
 
@@ -45,7 +66,11 @@ static void WalletLoading(benchmark::Bench& bench, bool legacy_wallet)
 
     // Generate a bunch of transactions and addresses to put into the wallet
     for (int i = 0; i < 1000; ++i) {
-        AddTx(*wallet);
+        if (asset_txs) {
+            AddAssetTx(*wallet, i);
+        } else {
+            AddTx(*wallet);
+        }
     }
 
     database = DuplicateMockDatabase(wallet->GetDatabase());
@@ -70,5 +95,8 @@ BENCHMARK(WalletLoadingLegacy, benchmark::PriorityLevel::HIGH);
 #ifdef USE_SQLITE
 static void WalletLoadingDescriptors(benchmark::Bench& bench) { WalletLoading(bench, /*legacy_wallet=*/false); }
 BENCHMARK(WalletLoadingDescriptors, benchmark::PriorityLevel::HIGH);
+// SYSCOIN
+static void WalletLoadingDescriptorsAssets(benchmark::Bench& bench) { WalletLoading(bench, /*legacy_wallet=*/false, /*asset_txs=*/true); }
+BENCHMARK(WalletLoadingDescriptorsAssets, benchmark::PriorityLevel::HIGH);
 #endif
 } // namespace wallet
@@ -21,4 +21,17 @@ static void Xor(benchmark::Bench& bench)
     });
 }
 
+// SYSCOIN the 8 byte key of the databases, over a value the size of a PoDA blob
+static void XorDBValue(benchmark::Bench& bench)
+{
+    FastRandomContext frc{/*fDeterministic=*/true};
+    auto data{frc.randbytes<std::byte>(1 << 20)};
+    auto key{frc.randbytes<std::byte>(8)};
+
+    bench.batch(data.size()).unit("byte").run([&] {
+        util::Xor(data, key, /*key_offset=*/3);
+    });
+}
+
 BENCHMARK(Xor, benchmark::PriorityLevel::HIGH);
+BENCHMARK(XorDBValue, benchmark::PriorityLevel::HIGH);
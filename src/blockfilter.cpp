@@ -6,6 +6,7 @@
 #include <set>
 
 #include <blockfilter.h>
+#include <crypto/common.h>
 #include <crypto/siphash.h>
 #include <hash.h>
 #include <primitives/block.h>
@@ -21,7 +22,12 @@ static constexpr int GCS_SER_VERSION = 0;
 
 static const std::map<BlockFilterType, std::string> g_filter_types = {
     {BlockFilterType::BASIC_FILTER, "basic"},
+    // SYSCOIN
+    {BlockFilterType::EXTENDED_FILTER, "extended"},
 };
+// SYSCOIN prefixes keeping asset and version hash elements apart from scripts
+static constexpr uint8_t EXTENDED_FILTER_ASSET_PREFIX{'a'};
+static constexpr uint8_t EXTENDED_FILTER_VERSIONHASH_PREFIX{'v'};
 
 uint64_t GCSFilter::HashToRange(const Element& element) const
 {
@@ -207,6 +213,48 @@ static GCSFilter::ElementSet BasicFilterElements(const CBlock& block,
     return elements;
 }
 
+// SYSCOIN
+GCSFilter::Element ExtendedFilterAssetElement(uint64_t nAsset)
+{
+    GCSFilter::Element element(1 + sizeof(nAsset));
+    element[0] = EXTENDED_FILTER_ASSET_PREFIX;
+    WriteLE64(element.data() + 1, nAsset);
+    return element;
+}
+
+GCSFilter::Element ExtendedFilterVersionHashElement(const std::vector<uint8_t>& vchVersionHash)
+{
+    GCSFilter::Element element;
+    element.reserve(1 + vchVersionHash.size());
+    element.push_back(EXTENDED_FILTER_VERSIONHASH_PREFIX);
+    element.insert(element.end(), vchVersionHash.begin(), vchVersionHash.end());
+    return element;
+}
+
+static GCSFilter::ElementSet ExtendedFilterElements(const CBlock& block,
+                                                    const CBlockUndo& block_undo)
+{
+    GCSFilter::ElementSet elements = BasicFilterElements(block, block_undo);
+
+    for (const CTransactionRef& tx : block.vtx) {
+        for (const CTxOut& txout : tx->vout) {
+            if (!txout.assetInfo.IsNull()) elements.emplace(ExtendedFilterAssetElement(txout.assetInfo.nAsset));
+        }
+        if (tx->IsNEVMData()) {
+            const CNEVMData nevmData(*tx);
+            if (!nevmData.IsNull()) elements.emplace(ExtendedFilterVersionHashElement(nevmData.vchVersionHash));
+        }
+    }
+
+    for (const CTxUndo& tx_undo : block_undo.vtxundo) {
+        for (const Coin& prevout : tx_undo.vprevout) {
+            if (!prevout.out.assetInfo.IsNull()) elements.emplace(ExtendedFilterAssetElement(prevout.out.assetInfo.nAsset));
+        }
+    }
+
+    return elements;
+}
+
 BlockFilter::BlockFilter(BlockFilterType filter_type, const uint256& block_hash,
                          std::vector<unsigned char> filter, bool skip_decode_check)
     : m_filter_type(filter_type), m_block_hash(block_hash)
@@ -225,13 +273,18 @@ BlockFilter::BlockFilter(BlockFilterType filter_type, const CBlock& block, const
     if (!BuildParams(params)) {
         throw std::invalid_argument("unknown filter_type");
     }
-    m_filter = GCSFilter(params, BasicFilterElements(block, block_undo));
+    // SYSCOIN
+    m_filter = GCSFilter(params, m_filter_type == BlockFilterType::EXTENDED_FILTER ?
+                                     ExtendedFilterElements(block, block_undo) :
+                                     BasicFilterElements(block, block_undo));
 }
 
 bool BlockFilter::BuildParams(GCSFilter::Params& params) const
 {
     switch (m_filter_type) {
     case BlockFilterType::BASIC_FILTER:
+    // SYSCOIN
+    case BlockFilterType::EXTENDED_FILTER:
         params.m_siphash_k0 = m_block_hash.GetUint64(0);
         params.m_siphash_k1 = m_block_hash.GetUint64(1);
         params.m_P = BASIC_FILTER_P;
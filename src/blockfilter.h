@@ -92,9 +92,17 @@ constexpr uint32_t BASIC_FILTER_M = 784931;
 enum class BlockFilterType : uint8_t
 {
     BASIC_FILTER = 0,
+    // SYSCOIN basic filter plus asset guids and PoDA version hashes
+    EXTENDED_FILTER = 1,
     INVALID = 255,
 };
 
+// SYSCOIN
+/** Element of an extended filter for an asset moved or spent in the block */
+GCSFilter::Element ExtendedFilterAssetElement(uint64_t nAsset);
+/** Element of an extended filter for a PoDA blob committed in the block */
+GCSFilter::Element ExtendedFilterVersionHashElement(const std::vector<uint8_t>& vchVersionHash);
+
 /** Get the human-readable name for a filter type. Returns empty string for unknown types. */
 const std::string& BlockFilterTypeName(BlockFilterType filter_type);
 
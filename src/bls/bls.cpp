@@ -7,11 +7,20 @@
 #include <random.h>
 
 #ifndef BUILD_SYSCOIN_INTERNAL
+#include <crypto/sha256.h>
+#include <cuckoocache.h>
+#include <logging.h>
+#include <saltedhasher.h>
 #include <support/allocators/mt_pooled_secure.h>
+#include <unordered_lru_cache.h>
+#include <util/hasher.h>
 #endif
 
+#include <algorithm>
 #include <cassert>
 #include <cstring>
+#include <optional>
+#include <shared_mutex>
 
 namespace bls {
     std::atomic<bool> bls_legacy_scheme = std::atomic<bool>(true);
@@ -25,6 +34,88 @@ static const std::unique_ptr<bls::CoreMPL>& Scheme(const bool fLegacy)
     return fLegacy ? pSchemeLegacy : pScheme;
 }
 
+#ifndef BUILD_SYSCOIN_INTERNAL
+namespace {
+/**
+ * SYSCOIN valid BLS signatures, like CSignatureCache is for script signatures. Entries are
+ * SHA256(nonce || 'B' or 'L' || 31 zero bytes || message hash || public key || signature), with the key
+ * and the signature serialized in the basic scheme and the padding telling the scheme they were verified in
+ */
+class CBLSSignatureCache
+{
+private:
+    CSHA256 m_salted_hasher_basic;
+    CSHA256 m_salted_hasher_legacy;
+    CuckooCache::cache<uint256, SignatureCacheHasher> setValid;
+    std::shared_mutex cs_sigcache;
+    std::atomic<bool> m_enabled{false};
+
+public:
+    CBLSSignatureCache()
+    {
+        uint256 nonce = GetRandHash();
+        static constexpr unsigned char PADDING_BASIC[32] = {'B'};
+        static constexpr unsigned char PADDING_LEGACY[32] = {'L'};
+        m_salted_hasher_basic.Write(nonce.begin(), 32);
+        m_salted_hasher_basic.Write(PADDING_BASIC, 32);
+        m_salted_hasher_legacy.Write(nonce.begin(), 32);
+        m_salted_hasher_legacy.Write(PADDING_LEGACY, 32);
+    }
+
+    bool Enabled() const { return m_enabled.load(std::memory_order_relaxed); }
+
+    uint256 ComputeEntry(const bool fLegacy, const uint256& hash, Span<const uint8_t> pubKey, const CBLSSignature& sig) const
+    {
+        const auto sigBytes{sig.ToBytes(false)};
+        uint256 entry;
+        CSHA256 hasher = fLegacy ? m_salted_hasher_legacy : m_salted_hasher_basic;
+        hasher.Write(hash.begin(), 32).Write(pubKey.data(), pubKey.size()).Write(sigBytes.data(), sigBytes.size()).Finalize(entry.begin());
+        return entry;
+    }
+
+    bool Get(const uint256& entry)
+    {
+        std::shared_lock<std::shared_mutex> lock(cs_sigcache);
+        return setValid.contains(entry, false);
+    }
+
+    void Set(const uint256& entry)
+    {
+        std::unique_lock<std::shared_mutex> lock(cs_sigcache);
+        setValid.insert(entry);
+    }
+
+    std::optional<std::pair<uint32_t, size_t>> setup_bytes(size_t n)
+    {
+        auto ret = setValid.setup_bytes(n);
+        m_enabled = ret.has_value();
+        return ret;
+    }
+};
+
+static CBLSSignatureCache g_sig_cache;
+} // namespace
+
+bool InitBLSSignatureCache(size_t max_size_bytes)
+{
+    auto setup_results = g_sig_cache.setup_bytes(max_size_bytes);
+    if (!setup_results) return false;
+
+    const auto [num_elems, approx_size_bytes] = *setup_results;
+    LogPrintf("Using %zu MiB out of %zu MiB requested for BLS signature cache, able to store %zu elements\n",
+              approx_size_bytes >> 20, max_size_bytes >> 20, num_elems);
+    return true;
+}
+
+bool IsBLSSignatureCached(const CBLSSignature& sig, const CBLSPublicKey& pubKey, const uint256& hash, const bool specificLegacyScheme)
+{
+    if (!g_sig_cache.Enabled() || !sig.IsValid() || !pubKey.IsValid()) {
+        return false;
+    }
+    return g_sig_cache.Get(g_sig_cache.ComputeEntry(specificLegacyScheme, hash, pubKey.ToBytes(false), sig));
+}
+#endif
+
 CBLSId::CBLSId(const uint256& nHash) : CBLSWrapper<CBLSIdImplicit, BLS_CURVE_ID_SIZE, CBLSId>()
 {
     impl = nHash;
@@ -294,11 +385,31 @@ bool CBLSSignature::VerifyInsecure(const CBLSPublicKey& pubKey, const uint256& h
         return false;
     }
 
+#ifndef BUILD_SYSCOIN_INTERNAL
+    // SYSCOIN answer signatures that come back from the cache
+    uint256 entry;
+    if (g_sig_cache.Enabled()) {
+        entry = g_sig_cache.ComputeEntry(specificLegacyScheme, hash, pubKey.ToBytes(false), *this);
+        if (g_sig_cache.Get(entry)) {
+            return true;
+        }
+    }
+#endif
+
     try {
-        return Scheme(specificLegacyScheme)->Verify(pubKey.impl, bls::Bytes(hash.begin(), hash.size()), impl);
+        if (!Scheme(specificLegacyScheme)->Verify(pubKey.impl, bls::Bytes(hash.begin(), hash.size()), impl)) {
+            return false;
+        }
     } catch (...) {
         return false;
     }
+
+#ifndef BUILD_SYSCOIN_INTERNAL
+    if (!entry.IsNull()) {
+        g_sig_cache.Set(entry);
+    }
+#endif
+    return true;
 }
 
 bool CBLSSignature::VerifyInsecure(const CBLSPublicKey& pubKey, const uint256& hash) const
@@ -333,6 +444,121 @@ bool CBLSSignature::VerifyInsecureAggregated(Span<CBLSPublicKey> pubKeys, Span<u
     }
 }
 
+CBLSPreparedPublicKey::CBLSPreparedPublicKey(const CBLSPublicKey& pubKey)
+{
+    if (!pubKey.IsValid()) {
+        return;
+    }
+    try {
+        if (!pubKey.impl.IsValid()) {
+            return;
+        }
+        g1_t native;
+        pubKey.impl.ToNative(native);
+        g1_norm(native, native);
+        point = bls::G1Element::FromNative(native);
+        bytes = pubKey.ToBytes(false);
+        fValid = true;
+    } catch (...) {
+    }
+}
+
+namespace {
+//! The message hashed to G2 the way the scheme signs it
+bls::G2Element HashToG2(const uint256& hash, bool fLegacy)
+{
+    const bls::Bytes message(hash.begin(), hash.size());
+    if (fLegacy) {
+        return bls::G2Element::FromMessage(message, nullptr, 0, true);
+    }
+    const auto& dst = bls::BasicSchemeMPL::CIPHERSUITE_ID;
+    return bls::G2Element::FromMessage(message, reinterpret_cast<const uint8_t*>(dst.data()), dst.size());
+}
+
+//! Whether e(-g1, sig) * prod e(pubKeys[i], H(hashes[i])) is one, like CoreMPL::Verify for already checked keys
+bool VerifyPrepared(const bls::G2Element& sig, Span<const bls::G1Element> pubKeys, Span<const bls::G2Element> hashedPoints)
+{
+    static const bls::G1Element negatedGenerator = bls::G1Element::Generator().Negate();
+    const size_t n = pubKeys.size() + 1;
+    std::vector<g1_st> g1s(n);
+    std::vector<g2_st> g2s(n);
+    negatedGenerator.ToNative(&g1s[0]);
+    sig.ToNative(&g2s[0]);
+    for (size_t i = 1; i < n; i++) {
+        pubKeys[i - 1].ToNative(&g1s[i]);
+        hashedPoints[i - 1].ToNative(&g2s[i]);
+    }
+
+    gt_t result, product;
+    gt_set_unity(product);
+    for (size_t i = 0; i < n; i += 250) {
+        const size_t count = std::min(n - i, size_t{250});
+        pc_map_sim(result, reinterpret_cast<g1_t*>(g1s.data() + i), reinterpret_cast<g2_t*>(g2s.data() + i), count);
+        gt_mul(product, product, result);
+    }
+    if (!gt_is_unity(product) || core_get()->code != RLC_OK) {
+        core_get()->code = RLC_OK;
+        return false;
+    }
+    return true;
+}
+} // namespace
+
+bool CBLSSignature::VerifyInsecure(const CBLSPreparedPublicKey& pubKey, const uint256& hash) const
+{
+    const CBLSPreparedPublicKey* pubKeys[]{&pubKey};
+#ifndef BUILD_SYSCOIN_INTERNAL
+    // SYSCOIN the aggregated verification reads the scheme on its own, a result is only cached when it did not change
+    const bool fLegacy = bls::bls_legacy_scheme.load();
+    uint256 entry;
+    if (g_sig_cache.Enabled() && IsValid() && pubKey.IsValid()) {
+        entry = g_sig_cache.ComputeEntry(fLegacy, hash, pubKey.bytes, *this);
+        if (g_sig_cache.Get(entry)) {
+            return true;
+        }
+    }
+    if (!VerifyInsecureAggregated(pubKeys, Span<uint256>(const_cast<uint256*>(&hash), 1))) {
+        return false;
+    }
+    if (!entry.IsNull() && fLegacy == bls::bls_legacy_scheme.load()) {
+        g_sig_cache.Set(entry);
+    }
+    return true;
+#else
+    return VerifyInsecureAggregated(pubKeys, Span<uint256>(const_cast<uint256*>(&hash), 1));
+#endif
+}
+
+bool CBLSSignature::VerifyInsecureAggregated(Span<const CBLSPreparedPublicKey*> pubKeys, Span<uint256> hashes) const
+{
+    if (!IsValid()) {
+        return false;
+    }
+    assert(!pubKeys.empty() && !hashes.empty() && pubKeys.size() == hashes.size());
+
+    const bool fLegacy = bls::bls_legacy_scheme.load();
+    try {
+        // the basic scheme checks the signature is in the subgroup, the legacy scheme never did
+        if (!fLegacy && !impl.IsValid()) {
+            return false;
+        }
+        std::vector<bls::G1Element> points;
+        std::vector<bls::G2Element> hashedPoints;
+        points.reserve(pubKeys.size());
+        hashedPoints.reserve(hashes.size());
+        for (size_t i = 0; i < pubKeys.size(); i++) {
+            if (!pubKeys[i]->IsValid()) {
+                return false;
+            }
+            points.emplace_back(pubKeys[i]->point);
+            hashedPoints.emplace_back(HashToG2(hashes[i], fLegacy));
+        }
+        return VerifyPrepared(impl, points, hashedPoints);
+    } catch (...) {
+        return false;
+    }
+}
+
 bool CBLSSignature::VerifySecureAggregated(Span<CBLSPublicKey> pks, const uint256& hash) const
 {
     if (pks.empty()) {
@@ -385,6 +611,303 @@ bool CBLSSignature::Recover(Span<CBLSSignature> sigs, Span<CBLSId> ids)
     return true;
 }
 
+namespace {
+/** Relic big number freed when going out of scope */
+struct CBLSBigNum {
+    bn_t n;
+    CBLSBigNum() { bn_null(n); bn_new(n); }
+    ~CBLSBigNum() { bn_free(n); }
+    CBLSBigNum(const CBLSBigNum&) = delete;
+    CBLSBigNum& operator=(const CBLSBigNum&) = delete;
+};
+
+/** Reduce r into [0, order) */
+void ModOrder(bn_t r, const bn_t order)
+{
+    bn_mod(r, r, order);
+    if (bn_sign(r) == RLC_NEG) {
+        bn_add(r, r, order);
+    }
+}
+
+/** Bits [pos, pos + count) of a big endian scalar */
+unsigned int ScalarWindow(const std::array<uint8_t, BLS_CURVE_SECKEY_SIZE>& scalar, size_t pos, size_t count)
+{
+    unsigned int ret{0};
+    for (size_t i = 0; i < count && pos + i < scalar.size() * 8; i++) {
+        const size_t bit = pos + i;
+        ret |= ((scalar[scalar.size() - 1 - bit / 8] >> (bit % 8)) & 1) << i;
+    }
+    return ret;
+}
+
+/**
+ * Sum of points[i] * scalars[i] using Pippenger's bucket method. Per window of c bits every point is added once to
+ * the bucket of its digit, so n points need about 256 / c * (n + 2^(c+1)) additions instead of n full scalar
+ * multiplications. Scalars known to be below 2^scalarBits skip the windows above it
+ */
+template <typename Point>
+Point MultiScalarMul(const std::vector<Point>& points, const BLSLagrangeCoefficients& scalars, size_t scalarBits = BLS_CURVE_SECKEY_SIZE * 8)
+{
+    assert(points.size() == scalars.size());
+    const size_t n = points.size();
+    if (n < 16) {
+        // relic's endomorphism accelerated multiplications are faster for a handful of points
+        Point ret;
+        CBLSBigNum k;
+        for (size_t i = 0; i < n; i++) {
+            bn_read_bin(k.n, scalars[i].data(), scalars[i].size());
+            ret += points[i] * k.n;
+        }
+        return ret;
+    }
+
+    size_t c{2};
+    while ((size_t{4} << c) <= n) {
+        c++;
+    }
+    const size_t windows = (scalarBits + c - 1) / c;
+    std::vector<Point> buckets((size_t{1} << c) - 1);
+
+    Point acc;
+    for (size_t w = windows; w-- > 0;) {
+        if (w + 1 != windows) {
+            for (size_t i = 0; i < c; i++) {
+                acc = acc + acc;
+            }
+        }
+        std::fill(buckets.begin(), buckets.end(), Point());
+        for (size_t i = 0; i < n; i++) {
+            if (const unsigned int digit = ScalarWindow(scalars[i], w * c, c)) {
+                buckets[digit - 1] += points[i];
+            }
+        }
+        // sum of (j + 1) * buckets[j] through running sums
+        Point running, windowSum;
+        for (size_t j = buckets.size(); j-- > 0;) {
+            running += buckets[j];
+            windowSum += running;
+        }
+        acc += windowSum;
+    }
+    return acc;
+}
+} // namespace
+
+CBLSPublicKey CBLSPublicKey::AggregateSecure(Span<CBLSPublicKey> pks)
+{
+    CBLSPublicKey ret;
+    if (pks.empty()) {
+        return ret;
+    }
+
+    const bool fLegacy = bls::bls_legacy_scheme.load();
+    try {
+        // the coefficients of CoreMPL::VerifySecure, t_i = H(i || H(sorted keys)) mod order for the i-th sorted key
+        std::vector<std::pair<std::array<uint8_t, BLS_CURVE_PUBKEY_SIZE>, const bls::G1Element*>> sorted;
+        sorted.reserve(pks.size());
+        for (const auto& pk : pks) {
+            if (!pk.IsValid() || !pk.impl.IsValid()) {
+                return ret;
+            }
+            sorted.emplace_back(pk.impl.SerializeToArray(fLegacy), &pk.impl);
+        }
+        std::sort(sorted.begin(), sorted.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+
+        std::vector<uint8_t> buffer;
+        buffer.reserve(sorted.size() * BLS_CURVE_PUBKEY_SIZE);
+        for (const auto& [bytes, point] : sorted) {
+            buffer.insert(buffer.end(), bytes.begin(), bytes.end());
+        }
+        uint8_t indexAndHash[4 + 32];
+        bls::Util::Hash256(indexAndHash + 4, buffer.data(), buffer.size());
+
+        CBLSBigNum order, t;
+        g2_get_ord(order.n);
+        BLSLagrangeCoefficients coefficients(sorted.size());
+        std::vector<bls::G1Element> points;
+        points.reserve(sorted.size());
+        for (size_t i = 0; i < sorted.size(); i++) {
+            uint8_t hash[32];
+            bls::Util::IntToFourBytes(indexAndHash, i);
+            bls::Util::Hash256(hash, indexAndHash, sizeof(indexAndHash));
+            bn_read_bin(t.n, hash, sizeof(hash));
+            bn_mod_basic(t.n, t.n, order.n);
+            bn_write_bin(coefficients[i].data(), coefficients[i].size(), t.n);
+            points.emplace_back(*sorted[i].second);
+        }
+        ret.impl = MultiScalarMul(points, coefficients);
+        bls::BLS::CheckRelicErrors();
+        ret.fValid = true;
+    } catch (...) {
+        ret.fValid = false;
+    }
+
+    ret.cachedHash.SetNull();
+    return ret;
+}
+
+bool CBLSSignature::VerifyBatchRandomized(Span<CBLSSignature> sigs, Span<CBLSPublicKey> pubKeys, Span<uint256> hashes)
+{
+    assert(!sigs.empty() && sigs.size() == pubKeys.size() && sigs.size() == hashes.size());
+    //! a batch holding an invalid signature passes with a chance of 2^-RANDOM_SCALAR_BITS
+    static constexpr size_t RANDOM_SCALAR_BITS{128};
+
+    const bool fLegacy = bls::bls_legacy_scheme.load();
+    try {
+        const size_t n = sigs.size();
+        FastRandomContext rng;
+        BLSLagrangeCoefficients scalars(n);
+        std::vector<bls::G2Element> sigPoints;
+        sigPoints.reserve(n);
+        for (size_t i = 0; i < n; i++) {
+            if (!sigs[i].IsValid() || !pubKeys[i].IsValid()) {
+                return false;
+            }
+            // the basic scheme checks signatures and keys are in their subgroups, the legacy scheme never did
+            if (!fLegacy && (!sigs[i].impl.IsValid() || !pubKeys[i].impl.IsValid())) {
+                return false;
+            }
+            scalars[i].fill(0);
+            rng.fillrand(MakeWritableByteSpan(scalars[i]).last(RANDOM_SCALAR_BITS / 8));
+            sigPoints.emplace_back(sigs[i].impl);
+        }
+        const bls::G2Element aggSig = MultiScalarMul(sigPoints, scalars, RANDOM_SCALAR_BITS);
+
+        std::vector<bls::G1Element> points;
+        std::vector<bls::G2Element> hashedPoints;
+        for (size_t begin = 0; begin < n;) {
+            size_t end = begin + 1;
+            while (end < n && hashes[end] == hashes[begin]) {
+                end++;
+            }
+            std::vector<bls::G1Element> keys;
+            keys.reserve(end - begin);
+            for (size_t i = begin; i < end; i++) {
+                keys.emplace_back(pubKeys[i].impl);
+            }
+            const BLSLagrangeCoefficients keyScalars(scalars.begin() + begin, scalars.begin() + end);
+            points.emplace_back(MultiScalarMul(keys, keyScalars, RANDOM_SCALAR_BITS));
+            hashedPoints.emplace_back(HashToG2(hashes[begin], fLegacy));
+            begin = end;
+        }
+        bls::BLS::CheckRelicErrors();
+        return VerifyPrepared(aggSig, points, hashedPoints);
+    } catch (...) {
+        return false;
+    }
+}
+
+bool CBLSSignature::BuildLagrangeCoefficients(Span<CBLSId> ids, BLSLagrangeCoefficients& coefficientsRet)
+{
+    coefficientsRet.clear();
+    const size_t k = ids.size();
+    if (k < 2) {
+        return false;
+    }
+    for (const auto& id : ids) {
+        if (!id.IsValid()) {
+            return false;
+        }
+    }
+
+    try {
+        CBLSBigNum order, a, v;
+        gt_get_ord(order.n);
+        auto x = std::make_unique<CBLSBigNum[]>(k);
+        auto b = std::make_unique<CBLSBigNum[]>(k);
+        for (size_t i = 0; i < k; i++) {
+            // ids are read the same way bls::Threshold does
+            bn_read_bin(x[i].n, ids[i].impl.begin(), BLS_CURVE_ID_SIZE);
+            ModOrder(x[i].n, order.n);
+        }
+
+        // delta_i = prod x_j / (x_i * prod_{j != i} (x_j - x_i))
+        bn_copy(a.n, x[0].n);
+        for (size_t i = 1; i < k; i++) {
+            bn_mul(a.n, a.n, x[i].n);
+            ModOrder(a.n, order.n);
+        }
+        if (bn_is_zero(a.n)) {
+            return false;
+        }
+        for (size_t i = 0; i < k; i++) {
+            bn_copy(b[i].n, x[i].n);
+            for (size_t j = 0; j < k; j++) {
+                if (j == i) continue;
+                bn_sub(v.n, x[j].n, x[i].n);
+                ModOrder(v.n, order.n);
+                if (bn_is_zero(v.n)) {
+                    // duplicate id
+                    return false;
+                }
+                bn_mul(b[i].n, b[i].n, v.n);
+                ModOrder(b[i].n, order.n);
+            }
+        }
+
+        // invert all denominators with a single inversion: prefix[i] = b_0 * ... * b_i
+        auto prefix = std::make_unique<CBLSBigNum[]>(k);
+        bn_copy(prefix[0].n, b[0].n);
+        for (size_t i = 1; i < k; i++) {
+            bn_mul(prefix[i].n, prefix[i - 1].n, b[i].n);
+            ModOrder(prefix[i].n, order.n);
+        }
+        CBLSBigNum inv;
+        bn_mod_inv(inv.n, prefix[k - 1].n, order.n);
+
+        coefficientsRet.resize(k);
+        for (size_t i = k; i-- > 0;) {
+            // inv is 1 / (b_0 * ... * b_i) here
+            if (i > 0) {
+                bn_mul(v.n, inv.n, prefix[i - 1].n);
+                ModOrder(v.n, order.n);
+                bn_mul(inv.n, inv.n, b[i].n);
+                ModOrder(inv.n, order.n);
+            } else {
+                bn_copy(v.n, inv.n);
+            }
+            bn_mul(v.n, v.n, a.n);
+            ModOrder(v.n, order.n);
+            bn_write_bin(coefficientsRet[i].data(), coefficientsRet[i].size(), v.n);
+        }
+        bls::BLS::CheckRelicErrors();
+    } catch (...) {
+        coefficientsRet.clear();
+        return false;
+    }
+    return true;
+}
+
+bool CBLSSignature::Recover(Span<CBLSSignature> sigs, const BLSLagrangeCoefficients& coefficients)
+{
+    fValid = false;
+    cachedHash.SetNull();
+
+    if (sigs.empty() || sigs.size() != coefficients.size()) {
+        return false;
+    }
+
+    std::vector<bls::G2Element> points;
+    points.reserve(sigs.size());
+    for (const auto& sig : sigs) {
+        if (!sig.IsValid()) {
+            return false;
+        }
+        points.emplace_back(sig.impl);
+    }
+
+    try {
+        impl = MultiScalarMul(points, coefficients);
+        bls::BLS::CheckRelicErrors();
+    } catch (...) {
+        return false;
+    }
+
+    fValid = true;
+    return true;
+}
+
 #ifndef BUILD_SYSCOIN_INTERNAL
 
 static std::once_flag init_flag;
@@ -425,6 +948,52 @@ static void secure_free(void* p)
 }
 #endif
 
+#ifndef BUILD_SYSCOIN_INTERNAL
+// SYSCOIN the serialized key with the scheme it was serialized in appended, the two schemes encode a point differently
+using PubKeyCacheKey = std::array<uint8_t, CBLSPublicKey::SerSize + 1>;
+
+static std::mutex g_pubkey_cache_mutex;
+static unordered_lru_cache<PubKeyCacheKey, CBLSPublicKey, StaticSaltedHasher, BLS_PUBKEY_CACHE_SIZE> g_pubkey_cache;
+static std::atomic<uint64_t> g_pubkey_cache_hits{0};
+static std::atomic<uint64_t> g_pubkey_cache_misses{0};
+
+bool DecodePublicKeyCached(CBLSPublicKey& pk, const std::array<uint8_t, CBLSPublicKey::SerSize>& bytes, const bool specificLegacyScheme)
+{
+    PubKeyCacheKey key;
+    std::copy(bytes.begin(), bytes.end(), key.begin());
+    key.back() = specificLegacyScheme;
+    {
+        std::unique_lock<std::mutex> l(g_pubkey_cache_mutex);
+        if (const CBLSPublicKey* cached = g_pubkey_cache.get(key)) {
+            pk = *cached;
+            g_pubkey_cache_hits.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+    g_pubkey_cache_misses.fetch_add(1, std::memory_order_relaxed);
+    // decode outside the lock, two threads missing on the same key both decode it
+    pk.SetBytes(bytes, specificLegacyScheme);
+    // the encoding has to round trip, like CheckMalleable checks it
+    if (!pk.IsValid() || pk.ToBytes(specificLegacyScheme) != bytes) {
+        return false;
+    }
+    std::unique_lock<std::mutex> l(g_pubkey_cache_mutex);
+    g_pubkey_cache.insert(key, pk);
+    return true;
+}
+
+BLSPublicKeyCacheStats GetBLSPublicKeyCacheStats()
+{
+    BLSPublicKeyCacheStats stats;
+    stats.hits = g_pubkey_cache_hits.load(std::memory_order_relaxed);
+    stats.misses = g_pubkey_cache_misses.load(std::memory_order_relaxed);
+    std::unique_lock<std::mutex> l(g_pubkey_cache_mutex);
+    stats.entries = g_pubkey_cache.size();
+    stats.usage = g_pubkey_cache.DynamicMemoryUsage();
+    return stats;
+}
+#endif
+
 bool BLSInit()
 {
 #ifndef BUILD_SYSCOIN_INTERNAL
@@ -25,6 +25,7 @@
 #include <array>
 #include <mutex>
 #include <unistd.h>
+#include <vector>
 
 #include <atomic>
 
@@ -38,6 +39,10 @@ constexpr int BLS_CURVE_SECKEY_SIZE{32};
 constexpr int BLS_CURVE_PUBKEY_SIZE{48};
 constexpr int BLS_CURVE_SIG_SIZE{96};
 
+// SYSCOIN Lagrange coefficients at 0 for recovering a threshold signature from the shares of a fixed set of
+// members, one 32 byte big endian scalar per member id
+using BLSLagrangeCoefficients = std::vector<std::array<uint8_t, BLS_CURVE_SECKEY_SIZE>>;
+
 class CBLSSignature;
 class CBLSPublicKey;
 
@@ -47,6 +52,7 @@ class CBLSWrapper
     friend class CBLSSecretKey;
     friend class CBLSPublicKey;
     friend class CBLSSignature;
+    friend class CBLSPreparedPublicKey;
 
 protected:
     ImplType impl;
@@ -308,6 +314,9 @@ public:
 
     void AggregateInsecure(const CBLSPublicKey& o);
     static CBLSPublicKey AggregateInsecure(Span<CBLSPublicKey> pks);
+    // SYSCOIN the key CBLSSignature::VerifySecureAggregated checks a signature of pks against, combined with a
+    // single multi-scalar multiplication of the decoded keys
+    static CBLSPublicKey AggregateSecure(Span<CBLSPublicKey> pks);
 
     bool PublicKeyShare(Span<CBLSPublicKey> mpk, const CBLSId& id);
     bool DHKeyExchange(const CBLSSecretKey& sk, const CBLSPublicKey& pk);
@@ -333,6 +342,27 @@ public:
     }
 };
 
+/**
+ * SYSCOIN A public key that is verified against for a long time, like a quorum public key. Its subgroup check costs
+ * about as much as a G1 multiplication, so it is done once here instead of on every verification, and the point is
+ * kept normalized the way the pairing consumes it.
+ */
+class CBLSPreparedPublicKey
+{
+    friend class CBLSSignature;
+
+    bls::G1Element point;
+    // SYSCOIN the key as serialized in the basic scheme, which identifies it in the signature cache
+    std::array<uint8_t, BLS_CURVE_PUBKEY_SIZE> bytes{};
+    bool fValid{false};
+
+public:
+    CBLSPreparedPublicKey() = default;
+    explicit CBLSPreparedPublicKey(const CBLSPublicKey& pubKey);
+
+    [[nodiscard]] bool IsValid() const { return fValid; }
+};
+
 class CBLSSignature : public CBLSWrapper<bls::G2Element, BLS_CURVE_SIG_SIZE, CBLSSignature>
 {
     friend class CBLSSecretKey;
@@ -358,10 +388,21 @@ public:
     [[nodiscard]] bool VerifyInsecure(const CBLSPublicKey& pubKey, const uint256& hash, const bool specificLegacyScheme) const;
     [[nodiscard]] bool VerifyInsecure(const CBLSPublicKey& pubKey, const uint256& hash) const;
     [[nodiscard]] bool VerifyInsecureAggregated(Span<CBLSPublicKey> pubKeys, Span<uint256> hashes) const;
+    // SYSCOIN same as above against keys that were checked before
+    [[nodiscard]] bool VerifyInsecure(const CBLSPreparedPublicKey& pubKey, const uint256& hash) const;
+    [[nodiscard]] bool VerifyInsecureAggregated(Span<const CBLSPreparedPublicKey*> pubKeys, Span<uint256> hashes) const;
 
     [[nodiscard]] bool VerifySecureAggregated(Span<CBLSPublicKey> pks, const uint256& hash) const;
+    // SYSCOIN whether every sigs[i] is a signature of hashes[i] by pubKeys[i], checked with one pairing product over
+    // a random linear combination. Unlike insecure aggregation invalid signatures can't cancel each other out, so
+    // the keys may be picked by an attacker. Consecutive entries with the same hash share a pairing
+    [[nodiscard]] static bool VerifyBatchRandomized(Span<CBLSSignature> sigs, Span<CBLSPublicKey> pubKeys, Span<uint256> hashes);
 
     bool Recover(Span<CBLSSignature> sigs, Span<CBLSId> ids);
+    // SYSCOIN same as above with the coefficients of the ids of sigs built before, the shares are then combined
+    // with a single multi-scalar multiplication
+    bool Recover(Span<CBLSSignature> sigs, const BLSLagrangeCoefficients& coefficients);
+    static bool BuildLagrangeCoefficients(Span<CBLSId> ids, BLSLagrangeCoefficients& coefficientsRet);
 };
 
 class CBLSSignatureVersionWrapper {
@@ -384,6 +425,36 @@ public:
 };
 
 #ifndef BUILD_SYSCOIN_INTERNAL
+// SYSCOIN
+//! decoded public keys kept by DecodePublicKeyCached, enough for the operator keys of all masternodes
+static constexpr size_t BLS_PUBKEY_CACHE_SIZE{16384};
+
+struct BLSPublicKeyCacheStats {
+    uint64_t hits{0};
+    uint64_t misses{0};
+    size_t entries{0};
+    size_t usage{0};
+};
+
+/**
+ * Decode a serialized public key through a process wide cache of the keys decoded before. Each
+ * deterministic masternode list and state copy holds lazy operator keys of its own, so without
+ * it the same key is decompressed and subgroup checked again for every copy that is used.
+ * Invalid keys are not cached.
+ */
+bool DecodePublicKeyCached(CBLSPublicKey& pk, const std::array<uint8_t, CBLSPublicKey::SerSize>& bytes, bool specificLegacyScheme);
+BLSPublicKeyCacheStats GetBLSPublicKeyCacheStats();
+
+/**
+ * Size the cache of valid signatures, keyed by a salted hash of the scheme, public key, message hash
+ * and signature. The same recovered signature, chainlock, vote or mnauth tends to be verified again
+ * when it comes back through relay or is revalidated, VerifyInsecure answers those from the cache.
+ * Until this is called nothing is cached.
+ */
+[[nodiscard]] bool InitBLSSignatureCache(size_t max_size_bytes);
+//! Whether sig was found valid for pubKey and hash in the given scheme before
+bool IsBLSSignatureCached(const CBLSSignature& sig, const CBLSPublicKey& pubKey, const uint256& hash, bool specificLegacyScheme);
+
 template<typename BLSObject>
 class CBLSLazyWrapper
 {
@@ -476,6 +547,18 @@ public:
         Unserialize(s, bufLegacyScheme);
     }
 
+    // SYSCOIN encode the object into the buffer now, so that copies which are all serialized later, like an own sig
+    // share sent to many peers, copy the bytes instead of each encoding the point again
+    void CacheBytes() const
+    {
+        std::unique_lock<std::mutex> l(mutex);
+        if (objInitialized && !bufValid) {
+            vecBytes = obj.ToBytes(bufLegacyScheme);
+            bufValid = true;
+            hash.SetNull();
+        }
+    }
+
     void Set(const BLSObject& _obj, const bool specificLegacyScheme)
     {
         std::unique_lock<std::mutex> l(mutex);
@@ -493,14 +576,22 @@ public:
             return invalidObj;
         }
         if (!objInitialized) {
-            obj.SetBytes(vecBytes, bufLegacyScheme);
-            if (!obj.IsValid()) {
-                bufValid = false;
-                return invalidObj;
-            }
-            if (!obj.CheckMalleable(vecBytes, bufLegacyScheme)) {
-                bufValid = false;
-                return invalidObj;
+            // SYSCOIN public keys are shared by many copies, they are decoded once for all of them
+            if constexpr (std::is_same_v<BLSObject, CBLSPublicKey>) {
+                if (!DecodePublicKeyCached(obj, vecBytes, bufLegacyScheme)) {
+                    bufValid = false;
+                    return invalidObj;
+                }
+            } else {
+                obj.SetBytes(vecBytes, bufLegacyScheme);
+                if (!obj.IsValid()) {
+                    bufValid = false;
+                    return invalidObj;
+                }
+                if (!obj.CheckMalleable(vecBytes, bufLegacyScheme)) {
+                    bufValid = false;
+                    return invalidObj;
+                }
             }
             objInitialized = true;
         }
@@ -589,6 +680,7 @@ public:
 #endif
 
 using BLSVerificationVectorPtr = std::shared_ptr<std::vector<CBLSPublicKey>>;
+using BLSLagrangeCoefficientsPtr = std::shared_ptr<const BLSLagrangeCoefficients>;
 
 bool BLSInit();
 
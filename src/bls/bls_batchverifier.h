@@ -7,7 +7,9 @@
 
 #include <bls/bls.h>
 
-#include <map>
+#include <algorithm>
+#include <numeric>
+#include <set>
 #include <vector>
 
 template<typename SourceId, typename MessageId>
@@ -15,22 +17,27 @@ class CBLSBatchVerifier
 {
 private:
     struct Message {
+        SourceId sourceId;
         MessageId msgId;
         uint256 msgHash;
         CBLSSignature sig;
         CBLSPublicKey pubKey;
     };
 
-    using MessageMap = std::map<MessageId, Message>;
-    using MessageMapIterator = typename MessageMap::iterator;
-    using MessagesBySourceMap = std::map<SourceId, std::vector<MessageMapIterator>>;
-
     bool secureVerification;
     bool perMessageFallback;
     size_t subBatchSize;
 
-    MessageMap messages;
-    MessagesBySourceMap messagesBySource;
+    // SYSCOIN all pushed messages in push order. Grouping by message id, source and message hash is done on flat
+    // index vectors which are kept between batches so that repeated verification does not allocate again
+    std::vector<Message> messages;
+    // index of the message that is verified for each pushed one, the first one pushed with the same message id
+    std::vector<size_t> canonical;
+    // indexes of the messages ordered by source, sourceStarts[i] is the first one of source i
+    std::vector<size_t> bySource;
+    std::vector<size_t> sourceStarts;
+    // messages of the sources currently checked, ordered by message hash
+    std::vector<size_t> toVerify;
 
 public:
     std::set<SourceId> badSources;
@@ -48,8 +55,7 @@ public:
     {
         assert(sig.IsValid() && pubKey.IsValid());
 
-        auto it = messages.emplace(msgId, Message{msgId, msgHash, sig, pubKey}).first;
-        messagesBySource[sourceId].emplace_back(it);
+        messages.emplace_back(Message{sourceId, msgId, msgHash, sig, pubKey});
 
         if (subBatchSize != 0 && messages.size() >= subBatchSize) {
             Verify();
@@ -60,181 +66,185 @@ public:
     void ClearMessages()
     {
         messages.clear();
-        messagesBySource.clear();
     }
 
+    size_t GetMessageCount() const { return messages.size(); }
+
     size_t GetUniqueSourceCount() const
     {
-        return messagesBySource.size();
+        std::vector<SourceId> sources;
+        sources.reserve(messages.size());
+        for (const auto& msg : messages) {
+            sources.emplace_back(msg.sourceId);
+        }
+        std::sort(sources.begin(), sources.end());
+        return std::unique(sources.begin(), sources.end()) - sources.begin();
     }
 
     void Verify()
     {
-        std::map<uint256, std::vector<MessageMapIterator>> byMessageHash;
-
-        for (auto it = messages.begin(); it != messages.end(); ++it) {
-            byMessageHash[it->second.msgHash].emplace_back(it);
+        if (messages.empty()) {
+            return;
         }
+        BuildIndexes();
 
-        if (VerifyBatch(byMessageHash)) {
+        const size_t sourceCount = sourceStarts.size() - 1;
+        if (VerifySources(0, sourceCount)) {
             // full batch is valid
             return;
         }
+        // bisect the sources: when one half verifies the other one holds the invalid messages, so each bad
+        // source is found with O(log n) aggregated checks instead of re-verifying every source on its own
+        FindBadSources(0, sourceCount);
+    }
 
-        // revert to per-source verification
-        for (const auto& p : messagesBySource) {
-            bool batchValid = false;
+private:
+    void BuildIndexes()
+    {
+        bySource.resize(messages.size());
+        std::iota(bySource.begin(), bySource.end(), 0);
+        std::stable_sort(bySource.begin(), bySource.end(), [this](size_t a, size_t b) {
+            return messages[a].msgId < messages[b].msgId;
+        });
+        canonical.resize(messages.size());
+        for (size_t i = 0; i < bySource.size(); i++) {
+            const bool sameAsPrev = i > 0 && !(messages[bySource[i - 1]].msgId < messages[bySource[i]].msgId);
+            canonical[bySource[i]] = sameAsPrev ? canonical[bySource[i - 1]] : bySource[i];
+        }
 
-            // no need to verify it again if there was just one source
-            if (messagesBySource.size() != 1) {
-                byMessageHash.clear();
-                for (auto it = p.second.begin(); it != p.second.end(); ++it) {
-                    byMessageHash[(*it)->second.msgHash].emplace_back(*it);
-                }
-                batchValid = VerifyBatch(byMessageHash);
-            }
-            if (!batchValid) {
-                badSources.emplace(p.first);
-
-                if (perMessageFallback) {
-                    // revert to per-message verification
-                    if (p.second.size() == 1) {
-                        // no need to re-verify a single message
-                        badMessages.emplace(p.second[0]->second.msgId);
-                    } else {
-                        for (const auto& msgIt : p.second) {
-                            if (badMessages.count(msgIt->first)) {
-                                // same message might be invalid from different source, so no need to re-verify it
-                                continue;
-                            }
-
-                            const auto& msg = msgIt->second;
-                            if (!msg.sig.VerifyInsecure(msg.pubKey, msg.msgHash)) {
-                                badMessages.emplace(msg.msgId);
-                            }
-                        }
-                    }
-                }
+        std::iota(bySource.begin(), bySource.end(), 0);
+        std::stable_sort(bySource.begin(), bySource.end(), [this](size_t a, size_t b) {
+            return messages[a].sourceId < messages[b].sourceId;
+        });
+        sourceStarts.clear();
+        for (size_t i = 0; i < bySource.size(); i++) {
+            if (i == 0 || messages[bySource[i - 1]].sourceId < messages[bySource[i]].sourceId) {
+                sourceStarts.emplace_back(i);
             }
         }
+        sourceStarts.emplace_back(bySource.size());
     }
 
-private:
-    // All Verify methods take ownership of the passed byMessageHash map and thus might modify the map. This is to avoid
-    // unnecessary copies
-
-    bool VerifyBatch(std::map<uint256, std::vector<MessageMapIterator>>& byMessageHash)
+    // Finds the bad ones among sources [first, last), whose aggregated messages are known to be invalid
+    void FindBadSources(size_t first, size_t last)
     {
-        if (secureVerification) {
-            return VerifyBatchSecure(byMessageHash);
-        } else {
-            return VerifyBatchInsecure(byMessageHash);
+        if (last - first == 1) {
+            HandleBadSource(first);
+            return;
+        }
+        const size_t mid = first + (last - first) / 2;
+        if (VerifySources(first, mid)) {
+            // so the other half must be the invalid one
+            FindBadSources(mid, last);
+            return;
+        }
+        FindBadSources(first, mid);
+        if (!VerifySources(mid, last)) {
+            FindBadSources(mid, last);
         }
     }
 
-    bool VerifyBatchInsecure(const std::map<uint256, std::vector<MessageMapIterator>>& byMessageHash)
+    void HandleBadSource(size_t source)
     {
-        CBLSSignature aggSig;
-        std::vector<uint256> msgHashes;
-        std::vector<CBLSPublicKey> pubKeys;
-        std::set<MessageId> dups;
-
-        msgHashes.reserve(messages.size());
-        pubKeys.reserve(messages.size());
-
-        for (const auto& p : byMessageHash) {
-            const auto& msgHash = p.first;
-
-            CBLSPublicKey aggPubKey;
-
-            for (const auto& msgIt : p.second) {
-                const auto& msg = msgIt->second;
-
-                if (!dups.emplace(msg.msgId).second) {
-                    continue;
-                }
-
-                if (!aggSig.IsValid()) {
-                    aggSig = msg.sig;
-                } else {
-                    aggSig.AggregateInsecure(msg.sig);
-                }
-
-                if (!aggPubKey.IsValid()) {
-                    aggPubKey = msg.pubKey;
-                } else {
-                    aggPubKey.AggregateInsecure(msg.pubKey);
-                }
-            }
+        const size_t begin = sourceStarts[source];
+        const size_t end = sourceStarts[source + 1];
+        badSources.emplace(messages[bySource[begin]].sourceId);
+        if (!perMessageFallback) {
+            return;
+        }
 
-            if (!aggPubKey.IsValid()) {
-                // only duplicates for this msgHash
+        // revert to per-message verification
+        if (end - begin == 1) {
+            // no need to re-verify a single message
+            badMessages.emplace(messages[bySource[begin]].msgId);
+            return;
+        }
+        for (size_t i = begin; i < end; i++) {
+            const auto& msg = messages[canonical[bySource[i]]];
+            if (badMessages.count(msg.msgId)) {
+                // same message might be invalid from different source, so no need to re-verify it
                 continue;
             }
-
-            msgHashes.emplace_back(msgHash);
-            pubKeys.emplace_back(aggPubKey);
-        }
-
-        if (msgHashes.empty()) {
-            return true;
+            if (!msg.sig.VerifyInsecure(msg.pubKey, msg.msgHash)) {
+                badMessages.emplace(msg.msgId);
+            }
         }
-
-        return aggSig.VerifyInsecureAggregated(pubKeys, msgHashes);
     }
 
-    bool VerifyBatchSecure(std::map<uint256, std::vector<MessageMapIterator>>& byMessageHash)
+    // Verifies the messages of sources [first, last) in one batch, each message id only once
+    bool VerifySources(size_t first, size_t last)
     {
-        // Loop until the byMessageHash map is empty, which means that all messages were verified
-        // The secure form of verification will only aggregate one message for the same message hash, even if multiple
-        // exist (signed with different keys). This avoids the rogue public key attack.
-        // This is slower than the insecure form as it requires more pairings
-        while (!byMessageHash.empty()) {
-            if (!VerifyBatchSecureStep(byMessageHash)) {
-                return false;
+        toVerify.clear();
+        for (size_t i = sourceStarts[first]; i < sourceStarts[last]; i++) {
+            toVerify.emplace_back(canonical[bySource[i]]);
+        }
+        std::sort(toVerify.begin(), toVerify.end(), [this](size_t a, size_t b) {
+            if (messages[a].msgHash != messages[b].msgHash) {
+                return messages[a].msgHash < messages[b].msgHash;
             }
+            return a < b;
+        });
+        toVerify.erase(std::unique(toVerify.begin(), toVerify.end()), toVerify.end());
+
+        if (secureVerification) {
+            return VerifyBatchSecure();
+        } else {
+            return VerifyBatchInsecure();
         }
-        return true;
     }
 
-    bool VerifyBatchSecureStep(std::map<uint256, std::vector<MessageMapIterator>>& byMessageHash)
+    bool VerifyBatchInsecure() const
     {
         CBLSSignature aggSig;
         std::vector<uint256> msgHashes;
         std::vector<CBLSPublicKey> pubKeys;
-        std::set<MessageId> dups;
-
-        msgHashes.reserve(messages.size());
-        pubKeys.reserve(messages.size());
-
-        for (auto it = byMessageHash.begin(); it != byMessageHash.end(); ) {
-            const auto& msgHash = it->first;
-            auto& messageIts = it->second;
-            const auto& msg = messageIts.back()->second;
-
-            if (dups.emplace(msg.msgId).second) {
-                msgHashes.emplace_back(msgHash);
-                pubKeys.emplace_back(msg.pubKey);
 
-                if (!aggSig.IsValid()) {
-                    aggSig = msg.sig;
-                } else {
-                    aggSig.AggregateInsecure(msg.sig);
-                }
+        for (size_t i = 0; i < toVerify.size(); i++) {
+            const auto& msg = messages[toVerify[i]];
+            if (!aggSig.IsValid()) {
+                aggSig = msg.sig;
+            } else {
+                aggSig.AggregateInsecure(msg.sig);
             }
 
-            messageIts.pop_back();
-            if (messageIts.empty()) {
-                it = byMessageHash.erase(it);
+            if (i == 0 || messages[toVerify[i - 1]].msgHash != msg.msgHash) {
+                msgHashes.emplace_back(msg.msgHash);
+                pubKeys.emplace_back(msg.pubKey);
             } else {
-                ++it;
+                pubKeys.back().AggregateInsecure(msg.pubKey);
             }
         }
 
-        assert(!msgHashes.empty());
+        if (msgHashes.empty()) {
+            return true;
+        }
 
         return aggSig.VerifyInsecureAggregated(pubKeys, msgHashes);
     }
+
+    // SYSCOIN the secure form of verification checks a random linear combination of the signatures, so neither a
+    // rogue public key nor signatures that cancel each other out pass as valid. Messages with the same hash still
+    // share a pairing, this is only slower than the insecure form by a scalar multiplication per message
+    bool VerifyBatchSecure() const
+    {
+        std::vector<CBLSSignature> sigs;
+        std::vector<CBLSPublicKey> pubKeys;
+        std::vector<uint256> msgHashes;
+        sigs.reserve(toVerify.size());
+        pubKeys.reserve(toVerify.size());
+        msgHashes.reserve(toVerify.size());
+        for (const size_t i : toVerify) {
+            sigs.emplace_back(messages[i].sig);
+            pubKeys.emplace_back(messages[i].pubKey);
+            msgHashes.emplace_back(messages[i].msgHash);
+        }
+
+        if (msgHashes.empty()) {
+            return true;
+        }
+
+        return CBLSSignature::VerifyBatchRandomized(sigs, pubKeys, msgHashes);
+    }
 };
 
 #endif // SYSCOIN_BLS_BLS_BATCHVERIFIER_H
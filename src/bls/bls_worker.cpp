@@ -3,6 +3,7 @@
 // file COPYING or http://www.opensource.org/licenses/mit-license.php.
 
 #include <bls/bls_worker.h>
+#include <ctpl_stl.h>
 #include <hash.h>
 #include <serialize.h>
 
@@ -59,16 +60,20 @@ CBLSWorker::~CBLSWorker()
 
 void CBLSWorker::Start()
 {
-    int workerCount = std::thread::hardware_concurrency() / 2;
-    workerCount = std::max(std::min(1, workerCount), 4);
-    workerPool.resize(workerCount);
-    //RenameThreadPool(workerPool, "bls-work");
+    workerPool.Start();
+    sigVerifyPool.Start();
+    m_running = true;
 }
 
 void CBLSWorker::Stop()
 {
-    workerPool.clear_queue();
-    workerPool.stop(true);
+    m_running = false;
+    workerPool.Stop();
+    sigVerifyPool.Stop();
+    // SYSCOIN batches dropped by the pool never finish, signatures queued later must not wait for them
+    std::unique_lock<std::mutex> l(sigVerifyMutex);
+    sigVerifyBatchesInProgress = 0;
+    sigVerifyQueue.clear();
 }
 
 bool CBLSWorker::GenerateContributions(int quorumThreshold, Span<CBLSId> ids, BLSVerificationVectorPtr& vvecRet, std::vector<CBLSSecretKey>& skSharesRet)
@@ -128,7 +133,7 @@ struct Aggregator : public std::enable_shared_from_this<Aggregator<T>> {
     std::shared_ptr<std::vector<const T*> > inputVec;
 
     bool parallel;
-    ctpl::thread_pool& workerPool;
+    ExecutorTaskGroup& workerPool;
 
     std::mutex m;
     // items in the queue are all intermediate aggregation results of finished batches.
@@ -145,7 +150,7 @@ struct Aggregator : public std::enable_shared_from_this<Aggregator<T>> {
     // TP can either be a pointer or a reference
     template <typename TP>
     Aggregator(Span<TP> _inputSpan, bool _parallel,
-               ctpl::thread_pool& _workerPool,
+               ExecutorTaskGroup& _workerPool,
                DoneCallback _doneCallback) :
             inputVec(std::make_shared<std::vector<const T*>>(_inputSpan.size())),
             parallel(_parallel),
@@ -337,7 +342,7 @@ struct VectorAggregator : public std::enable_shared_from_this<VectorAggregator<T
 
     VectorVectorType vecs;
     bool parallel;
-    ctpl::thread_pool& workerPool;
+    ExecutorTaskGroup& workerPool;
 
     std::atomic<size_t> doneCount{0};
 
@@ -345,7 +350,7 @@ struct VectorAggregator : public std::enable_shared_from_this<VectorAggregator<T
     size_t vecSize;
 
     VectorAggregator(VectorVectorType _vecs,
-                     bool _parallel, ctpl::thread_pool& _workerPool,
+                     bool _parallel, ExecutorTaskGroup& _workerPool,
                      DoneCallback _doneCallback) :
             doneCallback(std::move(_doneCallback)),
             vecs(_vecs),
@@ -408,7 +413,7 @@ struct ContributionVerifier : public std::enable_shared_from_this<ContributionVe
     bool parallel;
     bool aggregated;
 
-    ctpl::thread_pool& workerPool;
+    ExecutorTaskGroup& workerPool;
 
     size_t batchCount{1};
     size_t verifyCount;
@@ -419,7 +424,7 @@ struct ContributionVerifier : public std::enable_shared_from_this<ContributionVe
 
     ContributionVerifier(CBLSId _forId, Span<BLSVerificationVectorPtr> _vvecs,
                          Span<CBLSSecretKey> _skShares, size_t _batchSize,
-                         bool _parallel, bool _aggregated, ctpl::thread_pool& _workerPool,
+                         bool _parallel, bool _aggregated, ExecutorTaskGroup& _workerPool,
                          std::function<void(const std::vector<bool>&)> _doneCallback) :
         forId(std::move(_forId)),
         vvecs(_vvecs),
@@ -613,7 +618,7 @@ BLSVerificationVectorPtr CBLSWorker::BuildQuorumVerificationVector(Span<BLSVerif
 }
 
 template <typename T>
-void AsyncAggregateHelper(ctpl::thread_pool& workerPool, Span<T> vec, bool parallel,
+void AsyncAggregateHelper(ExecutorTaskGroup& workerPool, Span<T> vec, bool parallel,
                           std::function<void(const T&)> doneCallback)
 {
     if (vec.empty()) {
@@ -773,8 +778,21 @@ void CBLSWorker::AsyncVerifySig(const CBLSSignature& sig, const CBLSPublicKey& p
         doneCallback(false);
         return;
     }
+    // SYSCOIN signatures verified before are not queued again
+    if (IsBLSSignatureCached(sig, pubKey, msgHash, bls::bls_legacy_scheme.load())) {
+        doneCallback(true);
+        return;
+    }
 
     std::unique_lock<std::mutex> l(sigVerifyMutex);
+    // SYSCOIN a stopped pool drops what is pushed to it, the signature is verified on the calling thread then
+    if (!m_running) {
+        l.unlock();
+        if (!cancelCond()) {
+            doneCallback(sig.VerifyInsecure(pubKey, msgHash));
+        }
+        return;
+    }
 
     bool foundDuplicate = ranges::any_of(sigVerifyQueue, [&msgHash](const auto& job){
         return job.msgHash == msgHash;
@@ -805,6 +823,17 @@ bool CBLSWorker::IsAsyncVerifyInProgress()
     return sigVerifyBatchesInProgress != 0;
 }
 
+std::future<void> CBLSWorker::AsyncRun(std::function<void()> f)
+{
+    if (!m_running) {
+        std::promise<void> p;
+        f();
+        p.set_value();
+        return p.get_future();
+    }
+    return workerPool.push([f = std::move(f)](int threadId) { f(); });
+}
+
 // sigVerifyMutex must be held while calling
 void CBLSWorker::PushSigVerifyBatch()
 {
@@ -874,5 +903,5 @@ void CBLSWorker::PushSigVerifyBatch()
     sigVerifyQueue.reserve(SIG_VERIFY_BATCH_SIZE);
 
     sigVerifyBatchesInProgress++;
-    workerPool.push(f, batch);
+    sigVerifyPool.push(f, batch);
 }
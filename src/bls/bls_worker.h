@@ -7,8 +7,12 @@
 
 #include <bls/bls.h>
 
-#include <ctpl_stl.h>
+#include <saltedhasher.h>
+#include <unordered_lru_cache.h>
+#include <util/executor.h>
 
+#include <array>
+#include <atomic>
 #include <future>
 #include <mutex>
 #include <utility>
@@ -25,7 +29,11 @@ public:
     using CancelCond = std::function<bool()>;
 
 private:
-    ctpl::thread_pool workerPool;
+    // SYSCOIN on the shared executor, signature verification gates chainlocks and so block acceptance
+    ExecutorTaskGroup workerPool{Executor::Lane::LLMQ};
+    ExecutorTaskGroup sigVerifyPool{Executor::Lane::VALIDATION};
+    // SYSCOIN work pushed before Start() or after Stop() would never complete
+    std::atomic<bool> m_running{false};
 
     static const int SIG_VERIFY_BATCH_SIZE = 8;
     struct SigVerifyJob {
@@ -54,6 +62,7 @@ public:
 
     void Start();
     void Stop();
+    bool IsRunning() const { return m_running; }
 
     bool GenerateContributions(int threshold, Span<CBLSId> ids, BLSVerificationVectorPtr& vvecRet, std::vector<CBLSSecretKey>& skSharesRet);
 
@@ -121,6 +130,9 @@ public:
     std::future<bool> AsyncVerifySig(const CBLSSignature& sig, const CBLSPublicKey& pubKey, const uint256& msgHash, CancelCond cancelCond = [] { return false; });
     bool IsAsyncVerifyInProgress();
 
+    // SYSCOIN run f on the worker pool, or on the calling thread while the pool is not running
+    std::future<void> AsyncRun(std::function<void()> f);
+
 private:
     void PushSigVerifyBatch();
 };
@@ -129,15 +141,35 @@ private:
 // Cache keys are provided externally as computing hashes on BLS vectors is too expensive
 // If multiple threads try to build the same thing at the same time, only one will actually build it
 // and the other ones will wait for the result of the first caller
+// SYSCOIN entries of each kind a CBLSWorkerCache keeps are bounded to shards * shard size, more than the members of any quorum
+static constexpr size_t BLS_WORKER_CACHE_SHARDS{16};
+static constexpr size_t BLS_WORKER_CACHE_SHARD_SIZE{128};
+
 class CBLSWorkerCache
 {
 private:
     CBLSWorker& worker;
 
+    // SYSCOIN the caches are split in shards with a lock each, so the threads verifying the sig shares of a
+    // quorum do not all contend on one lock when looking up member key shares. A shard keeps its most recently
+    // used entries, the whole cache goes away with the quorum or DKG session owning it
+    template <typename T>
+    struct Shard {
+        std::mutex mutex;
+        unordered_lru_cache<uint256, std::shared_future<T>, StaticSaltedHasher, BLS_WORKER_CACHE_SHARD_SIZE> entries;
+    };
+    template <typename T>
+    using ShardedCache = std::array<Shard<T>, BLS_WORKER_CACHE_SHARDS>;
+
+    ShardedCache<BLSVerificationVectorPtr> vvecCache;
+    ShardedCache<CBLSSecretKey> secretKeyShareCache;
+    ShardedCache<CBLSPublicKey> publicKeyShareCache;
+
     std::mutex cacheCs;
-    std::map<uint256, std::shared_future<BLSVerificationVectorPtr> > vvecCache;
-    std::map<uint256, std::shared_future<CBLSSecretKey> > secretKeyShareCache;
-    std::map<uint256, std::shared_future<CBLSPublicKey> > publicKeyShareCache;
+    // SYSCOIN the same members tend to recover the signatures of consecutive sessions, so the Lagrange coefficients
+    // of the most recent member sets are kept
+    static constexpr size_t LAGRANGE_CACHE_SIZE{16};
+    unordered_lru_cache<uint256, BLSLagrangeCoefficientsPtr, StaticSaltedHasher, LAGRANGE_CACHE_SIZE> lagrangeCache;
 
 public:
     explicit CBLSWorkerCache(CBLSWorker& _worker) :
@@ -162,21 +194,74 @@ public:
         });
     }
 
+    // SYSCOIN cacheKey identifies the set of ids, nullptr if no coefficients exist for them (e.g. duplicate ids)
+    BLSLagrangeCoefficientsPtr BuildLagrangeCoefficients(const uint256& cacheKey, Span<CBLSId> ids)
+    {
+        BLSLagrangeCoefficientsPtr ret;
+        {
+            std::unique_lock<std::mutex> l(cacheCs);
+            if (lagrangeCache.get(cacheKey, ret)) {
+                return ret;
+            }
+        }
+        // building is done without the lock, two threads racing for the same set do the work twice at worst
+        BLSLagrangeCoefficients coefficients;
+        if (!CBLSSignature::BuildLagrangeCoefficients(ids, coefficients)) {
+            return nullptr;
+        }
+        ret = std::make_shared<const BLSLagrangeCoefficients>(std::move(coefficients));
+        std::unique_lock<std::mutex> l(cacheCs);
+        lagrangeCache.insert(cacheKey, ret);
+        return ret;
+    }
+
+    // SYSCOIN seed the cache with a share built earlier, e.g. one loaded from disk
+    void SetPubKeyShare(const uint256& cacheKey, const CBLSPublicKey& pubKeyShare)
+    {
+        Shard<CBLSPublicKey>& shard = GetShard(publicKeyShareCache, cacheKey);
+        std::unique_lock<std::mutex> l(shard.mutex);
+        if (shard.entries.exists(cacheKey)) {
+            return;
+        }
+        std::promise<CBLSPublicKey> p;
+        p.set_value(pubKeyShare);
+        shard.entries.insert(cacheKey, p.get_future().share());
+    }
+
+    // SYSCOIN number of public key shares cached
+    size_t PubKeyShareCount()
+    {
+        size_t count{0};
+        for (Shard<CBLSPublicKey>& shard : publicKeyShareCache) {
+            std::unique_lock<std::mutex> l(shard.mutex);
+            count += shard.entries.size();
+        }
+        return count;
+    }
+
 private:
+    template <typename T>
+    static Shard<T>& GetShard(ShardedCache<T>& cache, const uint256& cacheKey)
+    {
+        // the keys are hashes already
+        return cache[cacheKey.GetUint64(0) % BLS_WORKER_CACHE_SHARDS];
+    }
+
     template <typename T, typename Builder>
-    T GetOrBuild(const uint256& cacheKey, std::map<uint256, std::shared_future<T> >& cache, Builder&& builder)
+    T GetOrBuild(const uint256& cacheKey, ShardedCache<T>& cache, Builder&& builder)
     {
-        cacheCs.lock();
-        auto it = cache.find(cacheKey);
-        if (it != cache.end()) {
-            auto f = it->second;
-            cacheCs.unlock();
+        Shard<T>& shard = GetShard(cache, cacheKey);
+        std::unique_lock<std::mutex> l(shard.mutex);
+        if (const std::shared_future<T>* cached = shard.entries.get(cacheKey)) {
+            std::shared_future<T> f = *cached;
+            l.unlock();
             return f.get();
         }
 
+        // threads asking for the key while it is built wait on the future, evicting it does not affect them
         std::promise<T> p;
-        cache.emplace(cacheKey, p.get_future());
-        cacheCs.unlock();
+        shard.entries.insert(cacheKey, p.get_future().share());
+        l.unlock();
 
         T v = builder();
         p.set_value(v);
@@ -9,6 +9,7 @@
 #include <list>
 #include <cstddef>
 
+#include <memusage.h>
 #include <serialize.h>
 
 /**
@@ -99,6 +100,11 @@ public:
         return listItems.size();
     }
 
+    // SYSCOIN heap memory of the items and the index, not counting what the items point to
+    size_t DynamicMemoryUsage() const {
+        return memusage::DynamicUsage(listItems) + memusage::DynamicUsage(mapIndex);
+    }
+
     bool Insert(const K& key, const V& value)
     {
         if(mapIndex.find(key) != mapIndex.end()) {
@@ -84,6 +84,15 @@ public:
         return listItems.size();
     }
 
+    // SYSCOIN heap memory of the items and the index, not counting what the items point to
+    size_t DynamicMemoryUsage() const {
+        size_t usage = memusage::DynamicUsage(listItems) + memusage::DynamicUsage(mapIndex);
+        for (const auto& [key, itemMap] : mapIndex) {
+            usage += memusage::DynamicUsage(itemMap);
+        }
+        return usage;
+    }
+
     bool Insert(const K& key, const V& value)
     {
         map_it mit = mapIndex.find(key);
@@ -81,7 +81,12 @@ public:
     }
 
     size_t DynamicMemoryUsage() const {
-        return memusage::DynamicUsage(out.scriptPubKey);
+        // SYSCOIN the asset info is inline, only a PoDA payload adds heap memory besides the script
+        size_t usage = memusage::DynamicUsage(out.scriptPubKey);
+        if (out.vchNEVMData) {
+            usage += memusage::DynamicUsage(out.vchNEVMData) + memusage::DynamicUsage(*out.vchNEVMData);
+        }
+        return usage;
     }
 };
 
@@ -102,7 +107,8 @@ public:
  */
 struct CCoinsCacheEntry
 {
-    Coin coin; // The actual cached data.
+    // SYSCOIN let the flags use the tail padding of Coin, the asset info made every entry a word larger otherwise
+    [[no_unique_address]] Coin coin; // The actual cached data.
     unsigned char flags;
 
     enum Flags {
@@ -22,5 +22,20 @@ void static inline GetCPUID(uint32_t leaf, uint32_t subleaf, uint32_t& a, uint32
 #endif
 }
 
+// SYSCOIN
+/** Whether the CPU supports AVX2 and the OS has enabled the AVX registers. */
+bool static inline HaveAVX2()
+{
+    uint32_t a, b, c, d;
+    GetCPUID(1, 0, a, b, c, d);
+    // XSAVE and AVX
+    if (!((c >> 27) & 1) || !((c >> 28) & 1)) return false;
+    uint32_t xcr0, xcr0_hi;
+    __asm__("xgetbv" : "=a"(xcr0), "=d"(xcr0_hi) : "c"(0));
+    if ((xcr0 & 6) != 6) return false;
+    GetCPUID(7, 0, a, b, c, d);
+    return (b >> 5) & 1;
+}
+
 #endif // defined(__x86_64__) || defined(__amd64__) || defined(__i386__)
 #endif // SYSCOIN_COMPAT_CPUID_H
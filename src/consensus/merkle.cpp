@@ -83,3 +83,32 @@ uint256 BlockWitnessMerkleRoot(const CBlock& block, bool* mutated)
     return ComputeMerkleRoot(std::move(leaves), mutated);
 }
 
+// SYSCOIN
+std::vector<uint256> BlockCoinbaseMerkleBranch(const CBlock& block)
+{
+    std::vector<uint256> hashes;
+    hashes.resize(block.vtx.size());
+    for (size_t s = 0; s < block.vtx.size(); s++) {
+        hashes[s] = block.vtx[s]->GetHash();
+    }
+    std::vector<uint256> branch;
+    // same reduction as ComputeMerkleRoot, the coinbase always stays the left leaf of its pair
+    while (hashes.size() > 1) {
+        if (hashes.size() & 1) {
+            hashes.push_back(hashes.back());
+        }
+        branch.push_back(hashes[1]);
+        SHA256D64(hashes[0].begin(), hashes[0].begin(), hashes.size() / 2);
+        hashes.resize(hashes.size() / 2);
+    }
+    return branch;
+}
+
+uint256 ComputeMerkleRootFromCoinbase(const uint256& coinbase_hash, const std::vector<uint256>& branch)
+{
+    uint256 hash = coinbase_hash;
+    for (const uint256& sibling : branch) {
+        hash = Hash(hash, sibling);
+    }
+    return hash;
+}
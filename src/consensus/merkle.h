@@ -24,4 +24,18 @@ uint256 BlockMerkleRoot(const CBlock& block, bool* mutated = nullptr);
  */
 uint256 BlockWitnessMerkleRoot(const CBlock& block, bool* mutated = nullptr);
 
+// SYSCOIN
+/*
+ * Compute the merkle branch of the coinbase (the first transaction) of a block,
+ * that is the sibling hashes on the way from the coinbase to the root.
+ */
+std::vector<uint256> BlockCoinbaseMerkleBranch(const CBlock& block);
+
+/*
+ * Compute the merkle root of a block from the hash of its coinbase and the
+ * branch from BlockCoinbaseMerkleBranch, so a block that only changes its
+ * coinbase gets its new root in O(log n).
+ */
+uint256 ComputeMerkleRootFromCoinbase(const uint256& coinbase_hash, const std::vector<uint256>& branch);
+
 #endif // SYSCOIN_CONSENSUS_MERKLE_H
@@ -29,6 +29,20 @@ static inline size_t RecursiveDynamicUsage(const CTxOut& out) {
     return RecursiveDynamicUsage(out.scriptPubKey);
 }
 
+// SYSCOIN
+static inline size_t RecursiveDynamicUsage(const CAssetAllocation& allocation) {
+    size_t mem = memusage::DynamicUsage(allocation.voutAssets);
+    for (const CAssetOut& assetOut : allocation.voutAssets) {
+        mem += memusage::DynamicUsage(assetOut.values);
+    }
+    return mem;
+}
+
+static inline size_t RecursiveDynamicUsage(const CMintSyscoin& mint) {
+    return RecursiveDynamicUsage(static_cast<const CAssetAllocation&>(mint)) + memusage::DynamicUsage(mint.vchTxParentNodes) +
+        memusage::DynamicUsage(mint.vchTxPath) + memusage::DynamicUsage(mint.vchReceiptParentNodes);
+}
+
 static inline size_t RecursiveDynamicUsage(const CTransaction& tx) {
     size_t mem = memusage::DynamicUsage(tx.vin) + memusage::DynamicUsage(tx.vout);
     for (std::vector<CTxIn>::const_iterator it = tx.vin.begin(); it != tx.vin.end(); it++) {
@@ -37,6 +51,10 @@ static inline size_t RecursiveDynamicUsage(const CTransaction& tx) {
     for (std::vector<CTxOut>::const_iterator it = tx.vout.begin(); it != tx.vout.end(); it++) {
         mem += RecursiveDynamicUsage(*it);
     }
+    // SYSCOIN the decoded mint payload lives as long as the transaction
+    if (const auto& mint = tx.GetMintSyscoin()) {
+        mem += memusage::DynamicUsage(mint) + RecursiveDynamicUsage(*mint);
+    }
     return mem;
 }
 
@@ -46,8 +46,8 @@ bool AssetAllocationTxToJSON(const CTransaction &tx, UniValue &entry) {
 }
 
 bool AssetMintTxToJson(const CTransaction& tx, const uint256& txHash, UniValue &entry) {
-    CMintSyscoin mintSyscoin(tx);
-    if (!mintSyscoin.IsNull()) {
+    if (tx.GetMintSyscoin() && !tx.GetMintSyscoin()->IsNull()) {
+        const CMintSyscoin &mintSyscoin = *tx.GetMintSyscoin();
         AssetAllocationTxToJSON(tx, entry);
         UniValue oSPVProofObj(UniValue::VOBJ);
         oSPVProofObj.pushKV("txhash", mintSyscoin.nTxHash.GetHex());  
@@ -5,6 +5,12 @@
 // Based on the public domain implementation 'merged' by D. J. Bernstein
 // See https://cr.yp.to/chacha.html.
 
+// SYSCOIN
+#if defined(HAVE_CONFIG_H)
+#include <config/syscoin-config.h>
+#endif
+
+#include <compat/cpuid.h>
 #include <crypto/common.h>
 #include <crypto/chacha20.h>
 #include <support/cleanse.h>
@@ -13,6 +19,15 @@
 #include <algorithm>
 #include <string.h>
 
+// SYSCOIN
+#if defined(USE_ASM) && defined(HAVE_GETCPUID) && defined(ENABLE_AVX2) && !defined(BUILD_SYSCOIN_INTERNAL)
+#define CHACHA20_AVX2
+namespace chacha20_avx2
+{
+void Crypt_8way(const uint32_t* input, const unsigned char* in, unsigned char* out, size_t blocks8);
+}
+#endif
+
 constexpr static inline uint32_t rotl32(uint32_t v, int c) { return (v << c) | (v >> (32 - c)); }
 
 #define QUARTERROUND(a,b,c,d) \
@@ -23,6 +38,29 @@ constexpr static inline uint32_t rotl32(uint32_t v, int c) { return (v << c) | (
 
 #define REPEAT10(a) do { {a}; {a}; {a}; {a}; {a}; {a}; {a}; {a}; {a}; {a}; } while(0)
 
+#ifdef CHACHA20_AVX2
+static bool UseAVX2()
+{
+    static const bool use_avx2{HaveAVX2()};
+    return use_avx2;
+}
+#endif
+
+/** SYSCOIN process the leading multiple of 8 blocks with AVX2 if the CPU has it and the block counter does not
+ *  wrap in them, in is null for the keystream. Returns the number of blocks processed. */
+static inline size_t Crypt8Way(uint32_t* input, const unsigned char* in, unsigned char* out, size_t blocks) noexcept
+{
+#ifdef CHACHA20_AVX2
+    const size_t blocks8 = blocks / 8;
+    if (blocks8 && UseAVX2() && uint64_t{input[8]} + blocks8 * 8 <= uint64_t{0xffffffff}) {
+        chacha20_avx2::Crypt_8way(input, in, out, blocks8);
+        input[8] += blocks8 * 8;
+        return blocks8 * 8;
+    }
+#endif
+    return 0;
+}
+
 void ChaCha20Aligned::SetKey(Span<const std::byte> key) noexcept
 {
     assert(key.size() == KEYLEN);
@@ -67,6 +105,10 @@ inline void ChaCha20Aligned::Keystream(Span<std::byte> output) noexcept
     uint32_t x0, x1, x2, x3, x4, x5, x6, x7, x8, x9, x10, x11, x12, x13, x14, x15;
     uint32_t j4, j5, j6, j7, j8, j9, j10, j11, j12, j13, j14, j15;
 
+    // SYSCOIN
+    const size_t blocks_8way = Crypt8Way(input, nullptr, c, blocks);
+    blocks -= blocks_8way;
+    c += blocks_8way * BLOCKLEN;
     if (!blocks) return;
 
     j4 = input[0];
@@ -170,6 +212,11 @@ inline void ChaCha20Aligned::Crypt(Span<const std::byte> in_bytes, Span<std::byt
     uint32_t x0, x1, x2, x3, x4, x5, x6, x7, x8, x9, x10, x11, x12, x13, x14, x15;
     uint32_t j4, j5, j6, j7, j8, j9, j10, j11, j12, j13, j14, j15;
 
+    // SYSCOIN
+    const size_t blocks_8way = Crypt8Way(input, m, c, blocks);
+    blocks -= blocks_8way;
+    m += blocks_8way * BLOCKLEN;
+    c += blocks_8way * BLOCKLEN;
     if (!blocks) return;
 
     j4 = input[0];
@@ -2,11 +2,32 @@
 // Distributed under the MIT software license, see the accompanying
 // file COPYING or http://www.opensource.org/licenses/mit-license.php.
 
+// SYSCOIN
+#if defined(HAVE_CONFIG_H)
+#include <config/syscoin-config.h>
+#endif
+
+#include <compat/cpuid.h>
 #include <crypto/common.h>
 #include <crypto/poly1305.h>
 
 #include <string.h>
 
+// SYSCOIN
+#if defined(USE_ASM) && defined(HAVE_GETCPUID) && defined(ENABLE_AVX2) && !defined(BUILD_SYSCOIN_INTERNAL)
+#define POLY1305_AVX2
+namespace poly1305_avx2
+{
+void Blocks_4way(uint32_t* h, const uint32_t* r, const unsigned char* m, size_t blocks4);
+}
+
+static bool UseAVX2()
+{
+    static const bool use_avx2{HaveAVX2()};
+    return use_avx2;
+}
+#endif
+
 namespace poly1305_donna {
 
 // Based on the public domain implementation by Andrew Moon
@@ -45,6 +66,16 @@ static void poly1305_blocks(poly1305_context *st, const unsigned char *m, size_t
     uint64_t d0,d1,d2,d3,d4;
     uint32_t c;
 
+#ifdef POLY1305_AVX2
+    // SYSCOIN runs of full blocks are processed 4 at a time, short updates are not worth the setup
+    if (!st->final && bytes >= 16 * POLY1305_BLOCK_SIZE && UseAVX2()) {
+        const size_t blocks4 = bytes / (4 * POLY1305_BLOCK_SIZE);
+        poly1305_avx2::Blocks_4way(st->h, st->r, m, blocks4);
+        m += blocks4 * 4 * POLY1305_BLOCK_SIZE;
+        bytes -= blocks4 * 4 * POLY1305_BLOCK_SIZE;
+    }
+#endif
+
     r0 = st->r[0];
     r1 = st->r[1];
     r2 = st->r[2];
@@ -0,0 +1,125 @@
+// Copyright (c) 2024 The Syscoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifdef ENABLE_AVX2
+
+#include <crypto/common.h>
+
+#include <stddef.h>
+#include <stdint.h>
+#include <immintrin.h>
+
+namespace poly1305_avx2 {
+namespace {
+
+constexpr uint32_t LIMB_MASK{0x3ffffff};
+
+/** a * b mod 2^130 - 5 with the 26-bit limbs of poly1305-donna-32, partially reduced */
+void MulMod(uint32_t out[5], const uint32_t a[5], const uint32_t b[5])
+{
+    const uint64_t s1 = uint64_t{b[1]} * 5, s2 = uint64_t{b[2]} * 5, s3 = uint64_t{b[3]} * 5, s4 = uint64_t{b[4]} * 5;
+    uint64_t d0 = uint64_t{a[0]} * b[0] + a[1] * s4 + a[2] * s3 + a[3] * s2 + a[4] * s1;
+    uint64_t d1 = uint64_t{a[0]} * b[1] + uint64_t{a[1]} * b[0] + a[2] * s4 + a[3] * s3 + a[4] * s2;
+    uint64_t d2 = uint64_t{a[0]} * b[2] + uint64_t{a[1]} * b[1] + uint64_t{a[2]} * b[0] + a[3] * s4 + a[4] * s3;
+    uint64_t d3 = uint64_t{a[0]} * b[3] + uint64_t{a[1]} * b[2] + uint64_t{a[2]} * b[1] + uint64_t{a[3]} * b[0] + a[4] * s4;
+    uint64_t d4 = uint64_t{a[0]} * b[4] + uint64_t{a[1]} * b[3] + uint64_t{a[2]} * b[2] + uint64_t{a[3]} * b[1] + uint64_t{a[4]} * b[0];
+    uint64_t c;
+                 c = d0 >> 26; out[0] = d0 & LIMB_MASK;
+    d1 += c;     c = d1 >> 26; out[1] = d1 & LIMB_MASK;
+    d2 += c;     c = d2 >> 26; out[2] = d2 & LIMB_MASK;
+    d3 += c;     c = d3 >> 26; out[3] = d3 & LIMB_MASK;
+    d4 += c;     c = d4 >> 26; out[4] = d4 & LIMB_MASK;
+    d0 = out[0] + c * 5; c = d0 >> 26; out[0] = d0 & LIMB_MASK;
+    out[1] += c;
+}
+
+__m256i inline Add(__m256i x, __m256i y) { return _mm256_add_epi64(x, y); }
+/** Products of the low 32 bits of the 64-bit lanes */
+__m256i inline Mul(__m256i x, __m256i y) { return _mm256_mul_epu32(x, y); }
+
+/** h = h * r with 4 lanes of 5 limbs each, partially reduced; s is 5 * r */
+void inline MulMod(__m256i h[5], const __m256i r[5], const __m256i s[5])
+{
+    const __m256i mask = _mm256_set1_epi64x(LIMB_MASK);
+    __m256i d0 = Add(Add(Add(Mul(h[0], r[0]), Mul(h[1], s[4])), Add(Mul(h[2], s[3]), Mul(h[3], s[2]))), Mul(h[4], s[1]));
+    __m256i d1 = Add(Add(Add(Mul(h[0], r[1]), Mul(h[1], r[0])), Add(Mul(h[2], s[4]), Mul(h[3], s[3]))), Mul(h[4], s[2]));
+    __m256i d2 = Add(Add(Add(Mul(h[0], r[2]), Mul(h[1], r[1])), Add(Mul(h[2], r[0]), Mul(h[3], s[4]))), Mul(h[4], s[3]));
+    __m256i d3 = Add(Add(Add(Mul(h[0], r[3]), Mul(h[1], r[2])), Add(Mul(h[2], r[1]), Mul(h[3], r[0]))), Mul(h[4], s[4]));
+    __m256i d4 = Add(Add(Add(Mul(h[0], r[4]), Mul(h[1], r[3])), Add(Mul(h[2], r[2]), Mul(h[3], r[1]))), Mul(h[4], r[0]));
+    __m256i c;
+                      c = _mm256_srli_epi64(d0, 26); h[0] = _mm256_and_si256(d0, mask);
+    d1 = Add(d1, c);  c = _mm256_srli_epi64(d1, 26); h[1] = _mm256_and_si256(d1, mask);
+    d2 = Add(d2, c);  c = _mm256_srli_epi64(d2, 26); h[2] = _mm256_and_si256(d2, mask);
+    d3 = Add(d3, c);  c = _mm256_srli_epi64(d3, 26); h[3] = _mm256_and_si256(d3, mask);
+    d4 = Add(d4, c);  c = _mm256_srli_epi64(d4, 26); h[4] = _mm256_and_si256(d4, mask);
+    h[0] = Add(h[0], Add(c, _mm256_slli_epi64(c, 2)));
+    c = _mm256_srli_epi64(h[0], 26); h[0] = _mm256_and_si256(h[0], mask);
+    h[1] = Add(h[1], c);
+}
+
+/** Add the limbs of 4 full blocks. The lanes hold blocks 0, 2, 1 and 3, the order the unpacks leave them in. */
+void inline AddBlocks(__m256i h[5], const unsigned char* m)
+{
+    const __m256i mask = _mm256_set1_epi64x(LIMB_MASK);
+    const __m256i v01 = _mm256_loadu_si256((const __m256i*)m);
+    const __m256i v23 = _mm256_loadu_si256((const __m256i*)(m + 32));
+    const __m256i lo = _mm256_unpacklo_epi64(v01, v23);
+    const __m256i hi = _mm256_unpackhi_epi64(v01, v23);
+    h[0] = Add(h[0], _mm256_and_si256(lo, mask));
+    h[1] = Add(h[1], _mm256_and_si256(_mm256_srli_epi64(lo, 26), mask));
+    h[2] = Add(h[2], _mm256_and_si256(_mm256_or_si256(_mm256_srli_epi64(lo, 52), _mm256_slli_epi64(hi, 12)), mask));
+    h[3] = Add(h[3], _mm256_and_si256(_mm256_srli_epi64(hi, 14), mask));
+    // 1 << 128
+    h[4] = Add(h[4], _mm256_or_si256(_mm256_srli_epi64(hi, 40), _mm256_set1_epi64x(1 << 24)));
+}
+
+} // namespace
+
+/** Process blocks4 * 4 full blocks into the poly1305-donna-32 accumulator h with key r.
+ *  Lane j accumulates the blocks 4i + j multiplied by r^4 each round, and is multiplied by r^(4 - j) at the end. */
+void Blocks_4way(uint32_t* h, const uint32_t* r, const unsigned char* m, size_t blocks4)
+{
+    uint32_t r2[5], r3[5], r4[5];
+    MulMod(r2, r, r);
+    MulMod(r3, r2, r);
+    MulMod(r4, r2, r2);
+
+    __m256i acc[5], pr[5], ps[5];
+    for (int i = 0; i < 5; ++i) {
+        acc[i] = _mm256_setr_epi64x(h[i], 0, 0, 0);
+        pr[i] = _mm256_set1_epi64x(r4[i]);
+        ps[i] = _mm256_set1_epi64x(uint64_t{r4[i]} * 5);
+    }
+    AddBlocks(acc, m);
+    for (--blocks4, m += 64; blocks4; --blocks4, m += 64) {
+        MulMod(acc, pr, ps);
+        AddBlocks(acc, m);
+    }
+    // blocks 0, 2, 1 and 3 of the last round are multiplied by r^4, r^2, r^3 and r
+    for (int i = 0; i < 5; ++i) {
+        pr[i] = _mm256_setr_epi64x(r4[i], r2[i], r3[i], r[i]);
+        ps[i] = _mm256_setr_epi64x(uint64_t{r4[i]} * 5, uint64_t{r2[i]} * 5, uint64_t{r3[i]} * 5, uint64_t{r[i]} * 5);
+    }
+    MulMod(acc, pr, ps);
+
+    uint64_t t[5];
+    for (int i = 0; i < 5; ++i) {
+        alignas(32) uint64_t lanes[4];
+        _mm256_store_si256((__m256i*)lanes, acc[i]);
+        t[i] = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+    }
+    uint64_t c;
+                 c = t[0] >> 26; t[0] &= LIMB_MASK;
+    t[1] += c;   c = t[1] >> 26; t[1] &= LIMB_MASK;
+    t[2] += c;   c = t[2] >> 26; t[2] &= LIMB_MASK;
+    t[3] += c;   c = t[3] >> 26; t[3] &= LIMB_MASK;
+    t[4] += c;   c = t[4] >> 26; t[4] &= LIMB_MASK;
+    t[0] += c * 5; c = t[0] >> 26; t[0] &= LIMB_MASK;
+    t[1] += c;
+    for (int i = 0; i < 5; ++i) h[i] = t[i];
+}
+
+} // namespace poly1305_avx2
+
+#endif
@@ -34,6 +34,9 @@
 
 static auto CharCast(const std::byte* data) { return reinterpret_cast<const char*>(data); }
 
+// SYSCOIN bytes of deletes written at a time when erasing a database stored in a shared one
+static constexpr size_t DBWRAPPER_ERASE_BATCH_SIZE{16 << 20};
+
 bool DestroyDB(const std::string& path_str)
 {
     return leveldb::DestroyDB(path_str, {}).ok();
@@ -134,11 +137,24 @@ static void SetMaxOpenFiles(leveldb::Options *options) {
              options->max_open_files, default_open_files);
 }
 
-static leveldb::Options GetOptions(size_t nCacheSize)
+// SYSCOIN
+struct DBBlockCache {
+    leveldb::Cache* const cache;
+    explicit DBBlockCache(size_t cache_bytes) : cache{leveldb::NewLRUCache(cache_bytes)} {}
+    ~DBBlockCache() { delete cache; }
+};
+
+std::shared_ptr<DBBlockCache> MakeDBBlockCache(size_t cache_bytes)
+{
+    return std::make_shared<DBBlockCache>(cache_bytes);
+}
+
+static leveldb::Options GetOptions(const DBParams& params)
 {
     leveldb::Options options;
-    options.block_cache = leveldb::NewLRUCache(nCacheSize / 2);
-    options.write_buffer_size = nCacheSize / 4; // up to two write buffers may be held in memory simultaneously
+    // SYSCOIN
+    options.block_cache = params.block_cache ? params.block_cache->cache : leveldb::NewLRUCache(params.cache_bytes / 2);
+    options.write_buffer_size = params.cache_bytes / 4; // up to two write buffers may be held in memory simultaneously
     options.filter_policy = leveldb::NewBloomFilterPolicy(10);
     options.compression = leveldb::kNoCompression;
     options.info_log = new CSyscoinLevelDBLogger();
@@ -169,7 +185,9 @@ void CDBBatch::Clear()
 
 void CDBBatch::WriteImpl(Span<const std::byte> key, DataStream& ssValue)
 {
-    leveldb::Slice slKey(CharCast(key.data()), key.size());
+    // SYSCOIN
+    const std::string prefixed{parent.m_shared ? parent.PrefixedKey(key) : std::string{}};
+    leveldb::Slice slKey{parent.m_shared ? leveldb::Slice{prefixed} : leveldb::Slice{CharCast(key.data()), key.size()}};
     ssValue.Xor(dbwrapper_private::GetObfuscateKey(parent));
     leveldb::Slice slValue(CharCast(ssValue.data()), ssValue.size());
     m_impl_batch->batch.Put(slKey, slValue);
@@ -185,7 +203,9 @@ void CDBBatch::WriteImpl(Span<const std::byte> key, DataStream& ssValue)
 
 void CDBBatch::EraseImpl(Span<const std::byte> key)
 {
-    leveldb::Slice slKey(CharCast(key.data()), key.size());
+    // SYSCOIN
+    const std::string prefixed{parent.m_shared ? parent.PrefixedKey(key) : std::string{}};
+    leveldb::Slice slKey{parent.m_shared ? leveldb::Slice{prefixed} : leveldb::Slice{CharCast(key.data()), key.size()}};
     m_impl_batch->batch.Delete(slKey);
     // LevelDB serializes erases as:
     // - byte: header
@@ -216,17 +236,37 @@ struct LevelDBContext {
 
     //! the database itself
     leveldb::DB* pdb;
+
+    // SYSCOIN
+    //! block cache shared with other databases, if any
+    std::shared_ptr<DBBlockCache> shared_block_cache;
 };
 
 CDBWrapper::CDBWrapper(const DBParams& params)
-    : m_db_context{std::make_unique<LevelDBContext>()}, m_name{fs::PathToString(params.path.stem())}, m_path{params.path}, m_is_memory{params.memory_only}
+    : m_db_context{params.shared_db ? nullptr : std::make_unique<LevelDBContext>()}, m_name{fs::PathToString(params.path.stem())}, m_path{params.path}, m_is_memory{params.memory_only},
+      m_shared{params.shared_db}
 {
+    // SYSCOIN
+    if (m_shared) {
+        assert(!m_shared->m_shared);
+        DataStream ssPrefix{};
+        ssPrefix << fs::PathToString(params.path.filename());
+        m_prefix.assign(CharCast(ssPrefix.data()), ssPrefix.size());
+        obfuscate_key = m_shared->obfuscate_key;
+        if (params.wipe_data) {
+            LogPrintf("Wiping %s in LevelDB %s\n", m_name, m_shared->m_name);
+            ErasePrefix();
+        }
+        LogPrintf("Using %s in LevelDB %s\n", m_name, m_shared->m_name);
+        return;
+    }
     DBContext().penv = nullptr;
     DBContext().readoptions.verify_checksums = true;
     DBContext().iteroptions.verify_checksums = true;
     DBContext().iteroptions.fill_cache = false;
     DBContext().syncoptions.sync = true;
-    DBContext().options = GetOptions(params.cache_bytes);
+    DBContext().options = GetOptions(params);
+    DBContext().shared_block_cache = params.block_cache;
     DBContext().options.create_if_missing = true;
     if (params.memory_only) {
         DBContext().penv = leveldb::NewMemEnv(leveldb::Env::Default());
@@ -276,13 +316,16 @@ CDBWrapper::CDBWrapper(const DBParams& params)
 
 CDBWrapper::~CDBWrapper()
 {
+    // SYSCOIN
+    if (m_shared) return;
     delete DBContext().pdb;
     DBContext().pdb = nullptr;
     delete DBContext().options.filter_policy;
     DBContext().options.filter_policy = nullptr;
     delete DBContext().options.info_log;
     DBContext().options.info_log = nullptr;
-    delete DBContext().options.block_cache;
+    // SYSCOIN a shared block cache is freed with its last user
+    if (!DBContext().shared_block_cache) delete DBContext().options.block_cache;
     DBContext().options.block_cache = nullptr;
     delete DBContext().penv;
     DBContext().options.env = nullptr;
@@ -290,6 +333,14 @@ CDBWrapper::~CDBWrapper()
 
 bool CDBWrapper::WriteBatch(CDBBatch& batch, bool fSync)
 {
+    // SYSCOIN
+    if (m_shared) {
+        if (fSync && m_shared->m_defer_sync) {
+            m_shared->m_sync_pending = true;
+            fSync = false;
+        }
+        return m_shared->WriteBatch(batch, fSync);
+    }
     const bool log_memory = LogAcceptCategory(BCLog::LEVELDB, BCLog::Level::Debug);
     double mem_before = 0;
     if (log_memory) {
@@ -305,8 +356,43 @@ bool CDBWrapper::WriteBatch(CDBBatch& batch, bool fSync)
     return true;
 }
 
+// SYSCOIN
+bool CDBWrapper::FlushDeferredSync()
+{
+    m_defer_sync = false;
+    if (!m_sync_pending.exchange(false)) return true;
+    // syncing an empty batch makes everything logged before it durable
+    CDBBatch batch(*this);
+    return WriteBatch(batch, /*fSync=*/true);
+}
+
+std::string CDBWrapper::PrefixedKey(Span<const std::byte> key) const
+{
+    std::string ret{m_prefix};
+    ret.append(CharCast(key.data()), key.size());
+    return ret;
+}
+
+void CDBWrapper::ErasePrefix()
+{
+    auto& shared_context{m_shared->DBContext()};
+    std::unique_ptr<leveldb::Iterator> it{shared_context.pdb->NewIterator(shared_context.iteroptions)};
+    leveldb::WriteBatch batch;
+    for (it->Seek(m_prefix); it->Valid() && it->key().starts_with(m_prefix); it->Next()) {
+        batch.Delete(it->key());
+        if (batch.ApproximateSize() > DBWRAPPER_ERASE_BATCH_SIZE) {
+            HandleError(shared_context.pdb->Write(shared_context.writeoptions, &batch));
+            batch.Clear();
+        }
+    }
+    HandleError(it->status());
+    HandleError(shared_context.pdb->Write(shared_context.syncoptions, &batch));
+}
+
 size_t CDBWrapper::DynamicMemoryUsage() const
 {
+    // SYSCOIN
+    if (m_shared) return m_shared->DynamicMemoryUsage();
     std::string memory;
     std::optional<size_t> parsed;
     if (!DBContext().pdb->GetProperty("leveldb.approximate-memory-usage", &memory) || !(parsed = ToIntegral<size_t>(memory))) {
@@ -337,20 +423,31 @@ std::vector<unsigned char> CDBWrapper::CreateObfuscateKey() const
 
 std::optional<std::string> CDBWrapper::ReadImpl(Span<const std::byte> key) const
 {
-    leveldb::Slice slKey(CharCast(key.data()), key.size());
+    // SYSCOIN
     std::string strValue;
-    leveldb::Status status = DBContext().pdb->Get(DBContext().readoptions, slKey, &strValue);
+    if (!ReadImpl(key, strValue)) return std::nullopt;
+    return strValue;
+}
+
+// SYSCOIN
+bool CDBWrapper::ReadImpl(Span<const std::byte> key, std::string& value) const
+{
+    if (m_shared) return m_shared->ReadImpl(MakeByteSpan(PrefixedKey(key)), value);
+    leveldb::Slice slKey(CharCast(key.data()), key.size());
+    leveldb::Status status = DBContext().pdb->Get(DBContext().readoptions, slKey, &value);
     if (!status.ok()) {
         if (status.IsNotFound())
-            return std::nullopt;
+            return false;
         LogPrintf("LevelDB read failure: %s\n", status.ToString());
         HandleError(status);
     }
-    return strValue;
+    return true;
 }
 
 bool CDBWrapper::ExistsImpl(Span<const std::byte> key) const
 {
+    // SYSCOIN
+    if (m_shared) return m_shared->ExistsImpl(MakeByteSpan(PrefixedKey(key)));
     leveldb::Slice slKey(CharCast(key.data()), key.size());
 
     std::string strValue;
@@ -364,8 +461,56 @@ bool CDBWrapper::ExistsImpl(Span<const std::byte> key) const
     return true;
 }
 
+std::vector<std::optional<std::string>> CDBWrapper::ReadManyImpl(std::vector<std::string> keys) const
+{
+    // SYSCOIN
+    if (m_shared) {
+        for (auto& key : keys) {
+            key.insert(0, m_prefix);
+        }
+        return m_shared->ReadManyImpl(std::move(keys));
+    }
+    std::vector<std::optional<std::string>> values(keys.size());
+    if (keys.empty()) {
+        return values;
+    }
+    std::vector<size_t> order(keys.size());
+    for (size_t i = 0; i < order.size(); i++) {
+        order[i] = i;
+    }
+    std::sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+        return leveldb::Slice(keys[a]).compare(leveldb::Slice(keys[b])) < 0;
+    });
+    // an iterator reads from an implicit snapshot, so all values come from the same state of the database
+    std::unique_ptr<leveldb::Iterator> it{DBContext().pdb->NewIterator(DBContext().readoptions)};
+    bool fSeeked{false};
+    for (const size_t i : order) {
+        const leveldb::Slice target{keys[i]};
+        if (fSeeked && !it->Valid()) {
+            // nothing at or after an earlier, smaller key
+            break;
+        }
+        // the iterator is at the first entry not below the previous key, which is also the first entry not
+        // below this one unless it is smaller. Nearby keys are reached by stepping, the others by seeking
+        for (size_t steps = 0; fSeeked && it->Valid() && it->key().compare(target) < 0 && steps < DBWRAPPER_READ_MANY_MAX_NEXT; steps++) {
+            it->Next();
+        }
+        if (!fSeeked || (it->Valid() && it->key().compare(target) < 0)) {
+            it->Seek(target);
+            fSeeked = true;
+        }
+        if (it->Valid() && it->key() == target) {
+            values[i] = it->value().ToString();
+        }
+    }
+    HandleError(it->status());
+    return values;
+}
+
 size_t CDBWrapper::EstimateSizeImpl(Span<const std::byte> key1, Span<const std::byte> key2) const
 {
+    // SYSCOIN
+    if (m_shared) return m_shared->EstimateSizeImpl(MakeByteSpan(PrefixedKey(key1)), MakeByteSpan(PrefixedKey(key2)));
     leveldb::Slice slKey1(CharCast(key1.data()), key1.size());
     leveldb::Slice slKey2(CharCast(key2.data()), key2.size());
     uint64_t size = 0;
@@ -383,6 +528,11 @@ bool CDBWrapper::IsEmpty()
 
 void CDBWrapper::ResetDB()
 {
+    // SYSCOIN
+    if (m_shared) {
+        ErasePrefix();
+        return;
+    }
     const std::string path = fs::PathToString(m_path);
 
     /* 1. Close the old handle – releases LOCK */
@@ -419,18 +569,30 @@ CDBIterator::CDBIterator(const CDBWrapper& _parent, std::unique_ptr<IteratorImpl
 
 CDBIterator* CDBWrapper::NewIterator()
 {
+    // SYSCOIN
+    if (m_shared) {
+        return new CDBIterator{*this, std::make_unique<CDBIterator::IteratorImpl>(m_shared->DBContext().pdb->NewIterator(m_shared->DBContext().iteroptions))};
+    }
     return new CDBIterator{*this, std::make_unique<CDBIterator::IteratorImpl>(DBContext().pdb->NewIterator(DBContext().iteroptions))};
 }
 
 void CDBIterator::SeekImpl(Span<const std::byte> key)
 {
+    // SYSCOIN
+    if (parent.m_shared) {
+        m_impl_iter->iter->Seek(parent.PrefixedKey(key));
+        return;
+    }
     leveldb::Slice slKey(CharCast(key.data()), key.size());
     m_impl_iter->iter->Seek(slKey);
 }
 
 Span<const std::byte> CDBIterator::GetKeyImpl() const
 {
-    return MakeByteSpan(m_impl_iter->iter->key());
+    // SYSCOIN
+    leveldb::Slice key{m_impl_iter->iter->key()};
+    key.remove_prefix(parent.m_prefix.size());
+    return MakeByteSpan(key);
 }
 
 Span<const std::byte> CDBIterator::GetValueImpl() const
@@ -439,8 +601,16 @@ Span<const std::byte> CDBIterator::GetValueImpl() const
 }
 
 CDBIterator::~CDBIterator() = default;
-bool CDBIterator::Valid() const { return m_impl_iter->iter->Valid(); }
-void CDBIterator::SeekToFirst() { m_impl_iter->iter->SeekToFirst(); }
+// SYSCOIN the iterator of a shared database ends with its prefix
+bool CDBIterator::Valid() const { return m_impl_iter->iter->Valid() && m_impl_iter->iter->key().starts_with(parent.m_prefix); }
+void CDBIterator::SeekToFirst()
+{
+    if (parent.m_shared) {
+        m_impl_iter->iter->Seek(parent.m_prefix);
+    } else {
+        m_impl_iter->iter->SeekToFirst();
+    }
+}
 void CDBIterator::Next() { m_impl_iter->iter->Next(); }
 
 namespace dbwrapper_private {
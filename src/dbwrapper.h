@@ -13,6 +13,7 @@
 #include <util/check.h>
 #include <util/fs.h>
 
+#include <atomic>
 #include <cstddef>
 #include <exception>
 #include <memory>
@@ -23,6 +24,8 @@
 
 static const size_t DBWRAPPER_PREALLOC_KEY_SIZE = 64;
 static const size_t DBWRAPPER_PREALLOC_VALUE_SIZE = 1024;
+// SYSCOIN keys ReadMany() steps over with Next() before seeking to the next key it looks for
+static const size_t DBWRAPPER_READ_MANY_MAX_NEXT = 8;
 
 //! User-controlled performance and debug options.
 struct DBOptions {
@@ -30,6 +33,13 @@ struct DBOptions {
     bool force_compact = false;
 };
 
+class CDBWrapper;
+// SYSCOIN
+struct DBBlockCache;
+
+//! LevelDB block cache that several databases can share, so the busiest of them gets the most of it.
+std::shared_ptr<DBBlockCache> MakeDBBlockCache(size_t cache_bytes);
+
 //! Application-specific storage settings.
 struct DBParams {
     //! Location in the filesystem where leveldb data will be stored.
@@ -45,6 +55,12 @@ struct DBParams {
     bool obfuscate = false;
     //! Passed-through options.
     DBOptions options{};
+    // SYSCOIN
+    //! If set, keep the data under a key prefix derived from the path in this
+    //! database instead of opening a LevelDB instance of its own.
+    CDBWrapper* shared_db{nullptr};
+    //! If set, cache blocks in this shared cache instead of one of cache_bytes / 2.
+    std::shared_ptr<DBBlockCache> block_cache{};
 };
 
 class dbwrapper_error : public std::runtime_error
@@ -53,8 +69,6 @@ public:
     explicit dbwrapper_error(const std::string& msg) : std::runtime_error(msg) {}
 };
 
-class CDBWrapper;
-
 /** These should be considered an implementation detail of the specific database.
  */
 namespace dbwrapper_private {
@@ -182,6 +196,9 @@ struct LevelDBContext;
 class CDBWrapper
 {
     friend const std::vector<unsigned char>& dbwrapper_private::GetObfuscateKey(const CDBWrapper &w);
+    // SYSCOIN
+    friend class CDBBatch;
+    friend class CDBIterator;
 private:
     //! holds all leveldb-specific fields of this class
     std::unique_ptr<LevelDBContext> m_db_context;
@@ -206,11 +223,40 @@ private:
     //! whether or not the database resides in memory
     bool m_is_memory;
 
+    // SYSCOIN
+    //! database holding the data of this one when it was opened with DBParams::shared_db
+    CDBWrapper* const m_shared;
+    //! prefix of all keys of this database in m_shared
+    std::string m_prefix;
+    //! while set, synced writes through the databases sharing this one are only synced by FlushDeferredSync()
+    std::atomic<bool> m_defer_sync{false};
+    std::atomic<bool> m_sync_pending{false};
+    std::string PrefixedKey(Span<const std::byte> key) const;
+    void ErasePrefix();
+
     std::optional<std::string> ReadImpl(Span<const std::byte> key) const;
+    // SYSCOIN
+    bool ReadImpl(Span<const std::byte> key, std::string& value) const;
     bool ExistsImpl(Span<const std::byte> key) const;
+    std::vector<std::optional<std::string>> ReadManyImpl(std::vector<std::string> keys) const;
     size_t EstimateSizeImpl(Span<const std::byte> key1, Span<const std::byte> key2) const;
     auto& DBContext() const LIFETIMEBOUND { return *Assert(m_db_context); }
 
+    template <typename K>
+    static std::vector<std::string> SerializeKeys(const std::vector<K>& keys)
+    {
+        std::vector<std::string> ret;
+        ret.reserve(keys.size());
+        DataStream ssKey{};
+        ssKey.reserve(DBWRAPPER_PREALLOC_KEY_SIZE);
+        for (const K& key : keys) {
+            ssKey << key;
+            ret.emplace_back(reinterpret_cast<const char*>(ssKey.data()), ssKey.size());
+            ssKey.clear();
+        }
+        return ret;
+    }
+
 public:
     CDBWrapper(const DBParams& params);
     ~CDBWrapper();
@@ -237,6 +283,71 @@ public:
         return true;
     }
 
+    // SYSCOIN
+    /**
+     * Like Read(), with the raw value read into buffer and deserialized from there. A buffer kept by the
+     * caller across reads saves the allocation and the copy of large values (PoDA blobs, masternode lists).
+     */
+    template <typename K, typename V>
+    bool Read(const K& key, V& value, std::string& buffer) const
+    {
+        DataStream ssKey{};
+        ssKey.reserve(DBWRAPPER_PREALLOC_KEY_SIZE);
+        ssKey << key;
+        if (!ReadImpl(ssKey, buffer)) {
+            return false;
+        }
+        try {
+            const Span<std::byte> raw{MakeWritableByteSpan(buffer)};
+            util::Xor(raw, MakeByteSpan(obfuscate_key));
+            SpanReader{0, 0, MakeUCharSpan(raw)} >> value;
+        } catch (const std::exception&) {
+            return false;
+        }
+        return true;
+    }
+
+    /**
+     * Read the values of many keys from one consistent state of the database. The keys are looked up in sorted
+     * order through a single iterator, so keys close to each other share the work of finding their table block.
+     * values gets an entry per key, empty for keys that are missing or fail to deserialize. Returns the number read.
+     */
+    template <typename K, typename V>
+    size_t ReadMany(const std::vector<K>& keys, std::vector<std::optional<V>>& values) const
+    {
+        const std::vector<std::optional<std::string>> strValues{ReadManyImpl(SerializeKeys(keys))};
+        values.clear();
+        values.resize(keys.size());
+        size_t found = 0;
+        for (size_t i = 0; i < strValues.size(); i++) {
+            if (!strValues[i]) {
+                continue;
+            }
+            try {
+                DataStream ssValue{MakeByteSpan(*strValues[i])};
+                ssValue.Xor(obfuscate_key);
+                V value;
+                ssValue >> value;
+                values[i] = std::move(value);
+                found++;
+            } catch (const std::exception&) {
+            }
+        }
+        return found;
+    }
+
+    /** Like Exists() for many keys at once, with the lookups of ReadMany() */
+    template <typename K>
+    std::vector<bool> ExistsMany(const std::vector<K>& keys) const
+    {
+        const std::vector<std::optional<std::string>> strValues{ReadManyImpl(SerializeKeys(keys))};
+        std::vector<bool> ret(strValues.size());
+        for (size_t i = 0; i < strValues.size(); i++) {
+            ret[i] = strValues[i].has_value();
+        }
+        return ret;
+    }
+
     template <typename K, typename V>
     bool Write(const K& key, const V& value, bool fSync = false)
     {
@@ -295,6 +406,15 @@ public:
     // SYSCOIN
     std::string GetName() const { return m_name; }
     void ResetDB();
+
+    /**
+     * Collect the fsyncs of the databases sharing this one into a single one: from here on their
+     * synced writes are applied without waiting for the disk until FlushDeferredSync() syncs the log
+     * once. LevelDB replays its log in order, so after a crash the shared state is a prefix of the
+     * writes made, never a mix.
+     */
+    void DeferSync() { m_defer_sync = true; }
+    bool FlushDeferredSync();
 };
 
 #endif // SYSCOIN_DBWRAPPER_H
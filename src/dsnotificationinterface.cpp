@@ -10,6 +10,7 @@
 
 #include <evo/deterministicmns.h>
 #include <evo/mnauth.h>
+#include <masternode/masternodemeta.h>
 
 #include <llmq/quorums.h>
 #include <llmq/quorums_dkgsessionmgr.h>
@@ -58,6 +59,10 @@ void CDSNotificationInterface::NotifyMasternodeListChanged(bool undo, const CDet
     if(ShutdownRequested())
         return;
     CMNAuth::NotifyMasternodeListChanged(undo, oldMNList, diff, connman);
+    // SYSCOIN
+    if (!undo && mmetaman) {
+        mmetaman->RemoveMasternodes(oldMNList, diff);
+    }
     if(governance && governance->IsValid()) {
         governance->CheckAndRemove();
     }
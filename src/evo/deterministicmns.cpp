@@ -8,19 +8,31 @@
 #include <base58.h>
 #include <chainparams.h>
 #include <core_io.h>
+#include <core_memusage.h>
+#include <crypto/siphash.h>
 #include <script/script.h>
+#include <streams.h>
 #include <node/interface_ui.h>
 #include <validation.h>
 #include <validationinterface.h>
 
+#include <llmq/quorums.h>
 #include <llmq/quorums_commitment.h>
+#include <llmq/quorums_signing.h>
 #include <llmq/quorums_utils.h>
 #include <univalue.h>
 #include <shutdown.h>
 #include <common/args.h>
 #include <logging.h>
 #include <interfaces/chain.h>
-#include <util/fs.h> 
+#include <util/fs.h>
+#include <util/time.h>
+#include <util/trace.h>
+#include <version.h>
+
+#include <limits>
+#include <optional>
+
 bool fMasternodeMode = false;
 int64_t DEFAULT_MAX_RECOVERED_SIGS_AGE = 60 * 60 * 24 * 7; // keep them for a week
 
@@ -113,12 +125,11 @@ CDeterministicMNCPtr CDeterministicMNList::GetValidMN(const uint256& proTxHash)
 
 CDeterministicMNCPtr CDeterministicMNList::GetMNByOperatorKey(const CBLSPublicKey& pubKey) const
 {
-    const auto it = ranges::find_if(mnMap,
-                              [&pubKey](const auto& p){return p.second->pdmnState->pubKeyOperator.Get() == pubKey;});
-    if (it == mnMap.end()) {
+    if (!pubKey.IsValid()) {
         return nullptr;
     }
-    return it->second;
+    const auto proTxHash = mnOperatorKeyMap.find(GetOperatorKeyIndexKey(pubKey));
+    return proTxHash ? GetMN(*proTxHash) : nullptr;
 }
 
 CDeterministicMNCPtr CDeterministicMNList::GetMNByCollateral(const COutPoint& collateralOutpoint) const
@@ -137,7 +148,115 @@ CDeterministicMNCPtr CDeterministicMNList::GetValidMNByCollateral(const COutPoin
 
 CDeterministicMNCPtr CDeterministicMNList::GetMNByService(const CService& service) const
 {
-    return GetUniquePropertyMN(service);
+    const auto proTxHash = mnServiceMap.find(service.GetKey());
+    return proTxHash ? GetMN(*proTxHash) : nullptr;
+}
+
+namespace {
+/** Heap memory of the immer map nodes below node not in seen yet, plus valueUsage of the values they hold */
+template <typename Node, immer::detail::hamts::bits_t B, typename F>
+size_t ImmerNodeUsage(const Node* node, immer::detail::hamts::count_t depth, std::unordered_set<const void*>& seen, const F& valueUsage)
+{
+    if (!seen.insert(node).second) return 0;
+    size_t usage{0};
+    if (depth >= immer::detail::hamts::max_depth<B>) {
+        usage += memusage::MallocUsage(dmn_memory::AllocationSize(Node::sizeof_collision_n(node->collision_count())));
+        for (size_t i = 0; i < node->collision_count(); ++i) {
+            usage += valueUsage(node->collisions()[i]);
+        }
+        return usage;
+    }
+    usage += memusage::MallocUsage(dmn_memory::AllocationSize(Node::sizeof_inner_n(node->children_count())));
+    // the values of an inner node are a separate allocation, shared between nodes of different versions
+    if (node->data_count() > 0 && seen.insert(node->impl.d.data.inner.values).second) {
+        usage += memusage::MallocUsage(dmn_memory::AllocationSize(Node::sizeof_values_n(node->data_count())));
+        for (size_t i = 0; i < node->data_count(); ++i) {
+            usage += valueUsage(node->values()[i]);
+        }
+    }
+    for (size_t i = 0; i < node->children_count(); ++i) {
+        usage += ImmerNodeUsage<Node, B>(node->children()[i], depth + 1, seen, valueUsage);
+    }
+    return usage;
+}
+
+template <typename Map, typename F>
+size_t ImmerMapUsage(const Map& map, std::unordered_set<const void*>& seen, const F& valueUsage)
+{
+    using Champ = std::decay_t<decltype(map.impl())>;
+    return ImmerNodeUsage<typename Champ::node_t, Champ::bits>(map.impl().root, 0, seen, valueUsage);
+}
+
+template <typename Map>
+size_t ImmerMapUsage(const Map& map, std::unordered_set<const void*>& seen)
+{
+    return ImmerMapUsage(map, seen, [](const auto&) { return size_t{0}; });
+}
+} // namespace
+
+size_t CDeterministicMNList::DynamicMemoryUsage(std::unordered_set<const void*>& seen) const
+{
+    auto mnUsage = [&seen](const std::pair<uint256, CDeterministicMNCPtr>& entry) {
+        size_t usage{0};
+        const auto& dmn = entry.second;
+        if (dmn && seen.insert(dmn.get()).second) {
+            usage += memusage::DynamicUsage(dmn);
+            const auto& state = dmn->pdmnState;
+            if (state && seen.insert(state.get()).second) {
+                usage += memusage::DynamicUsage(state) + RecursiveDynamicUsage(state->scriptPayout) +
+                         RecursiveDynamicUsage(state->scriptOperatorPayout) + memusage::DynamicUsage(state->vchNEVMAddress);
+            }
+        }
+        return usage;
+    };
+    auto binaryKeyUsage = [](const std::pair<std::vector<unsigned char>, uint256>& entry) {
+        return memusage::DynamicUsage(entry.first);
+    };
+    size_t usage = ImmerMapUsage(mnMap, seen, mnUsage) + ImmerMapUsage(mnInternalIdMap, seen) +
+                   ImmerMapUsage(mnUniquePropertyMap, seen) + ImmerMapUsage(mnServiceMap, seen, binaryKeyUsage) +
+                   ImmerMapUsage(mnOperatorKeyMap, seen, binaryKeyUsage);
+    // the payee order only holds pointers, approximated by its size as its tree is not walked
+    if (seen.insert(mnPayeeOrder.identity().first).second) {
+        usage += memusage::MallocUsage(mnPayeeOrder.size() * sizeof(CDeterministicMNCPtr));
+    }
+    return usage;
+}
+
+size_t CDeterministicMNList::BinaryKeyHasher::operator()(const std::vector<unsigned char>& key) const
+{
+    return CSipHasher(0, 0).Write(key).Finalize();
+}
+
+std::vector<unsigned char> CDeterministicMNList::GetOperatorKeyIndexKey(const CBLSPublicKey& pubKey)
+{
+    // one encoding for keys of both schemes, so lookups don't depend on the version of the state
+    return pubKey.ToByteVector(/*specificLegacyScheme=*/false);
+}
+
+void CDeterministicMNList::UpdateSecondaryIndexes(const uint256& proTxHash, const CDeterministicMNState* oldState, const CDeterministicMNState* newState)
+{
+    auto update = [&](MnBinaryKeyMap& map, const std::optional<std::vector<unsigned char>>& oldKey, const std::optional<std::vector<unsigned char>>& newKey) {
+        if (oldKey == newKey) return;
+        if (oldKey) {
+            const auto p = map.find(*oldKey);
+            if (p && *p == proTxHash) map = std::move(map).erase(*oldKey);
+        }
+        if (newKey) map = std::move(map).set(*newKey, proTxHash);
+    };
+    auto serviceKey = [](const CDeterministicMNState* state) -> std::optional<std::vector<unsigned char>> {
+        if (!state || state->addr == CService()) return std::nullopt;
+        return state->addr.GetKey();
+    };
+    auto operatorKey = [](const CDeterministicMNState* state) -> std::optional<std::vector<unsigned char>> {
+        if (!state || !state->pubKeyOperator.Get().IsValid()) return std::nullopt;
+        return GetOperatorKeyIndexKey(state->pubKeyOperator.Get());
+    };
+    if (!oldState || !newState || oldState->addr != newState->addr) {
+        update(mnServiceMap, serviceKey(oldState), serviceKey(newState));
+    }
+    if (!oldState || !newState || oldState->pubKeyOperator != newState->pubKeyOperator) {
+        update(mnOperatorKeyMap, operatorKey(oldState), operatorKey(newState));
+    }
 }
 
 CDeterministicMNCPtr CDeterministicMNList::GetMNByInternalId(uint64_t internalId) const
@@ -177,18 +296,10 @@ static bool CompareByLastPaid(const CDeterministicMN* _a, const CDeterministicMN
 
 CDeterministicMNCPtr CDeterministicMNList::GetMNPayee() const
 {
-    if (mnMap.size() == 0) {
+    if (mnPayeeOrder.empty()) {
         return nullptr;
     }
-
-    CDeterministicMNCPtr best;
-    ForEachMNShared(true, [&](const CDeterministicMNCPtr& dmn) {
-        if (!best || CompareByLastPaid(dmn.get(), best.get())) {
-            best = dmn;
-        }
-    });
-
-    return best;
+    return mnPayeeOrder.front();
 }
 
 std::vector<CDeterministicMNCPtr> CDeterministicMNList::GetProjectedMNPayees(int nCount) const
@@ -196,24 +307,40 @@ std::vector<CDeterministicMNCPtr> CDeterministicMNList::GetProjectedMNPayees(int
     if (nCount < 0 ) {
         return {};
     }
-    const size_t validCount = GetValidMNsCount();
-    if ((size_t)nCount > validCount) {
-        nCount = validCount;
-    }
+    nCount = std::min<size_t>(nCount, mnPayeeOrder.size());
 
     std::vector<CDeterministicMNCPtr> result;
     result.reserve(nCount);
+    for (auto it = mnPayeeOrder.begin(); (int)result.size() < nCount; ++it) {
+        result.emplace_back(*it);
+    }
 
-    ForEachMNShared(true, [&](const CDeterministicMNCPtr& dmn) {
-        result.emplace_back(dmn);
-    });
-    std::sort(result.begin(), result.end(), [&](const CDeterministicMNCPtr& a, const CDeterministicMNCPtr& b) {
+    return result;
+}
+
+void CDeterministicMNList::AddToPayeeOrder(const CDeterministicMNCPtr& dmn)
+{
+    if (!IsMNValid(*dmn)) {
+        return;
+    }
+    auto it = std::lower_bound(mnPayeeOrder.begin(), mnPayeeOrder.end(), dmn, [](const CDeterministicMNCPtr& a, const CDeterministicMNCPtr& b) {
         return CompareByLastPaid(a.get(), b.get());
     });
+    mnPayeeOrder = mnPayeeOrder.insert(it - mnPayeeOrder.begin(), dmn);
+}
 
-    result.resize(nCount);
-
-    return result;
+void CDeterministicMNList::RemoveFromPayeeOrder(const CDeterministicMN& dmn)
+{
+    if (!IsMNValid(dmn)) {
+        return;
+    }
+    auto it = std::lower_bound(mnPayeeOrder.begin(), mnPayeeOrder.end(), &dmn, [](const CDeterministicMNCPtr& a, const CDeterministicMN* b) {
+        return CompareByLastPaid(a.get(), b);
+    });
+    // the ordering ends with the proTxHash, so the entry found is the one of this masternode
+    if (it != mnPayeeOrder.end() && (*it)->proTxHash == dmn.proTxHash) {
+        mnPayeeOrder = mnPayeeOrder.erase(it - mnPayeeOrder.begin());
+    }
 }
 
 std::vector<CDeterministicMNCPtr> CDeterministicMNList::CalculateQuorum(size_t maxSize, const uint256& modifier) const
@@ -445,6 +572,9 @@ CDeterministicMNList CDeterministicMNList::ApplyDiff(const CBlockIndex* pindex,
     }
     for (const auto& p : diff.updatedMNs) {
         auto dmn = result.GetMNByInternalId(p.first);
+        if (!dmn) {
+            throw(std::runtime_error(strprintf("%s: can't find an updated masternode, id=%d", __func__, p.first)));
+        }
         result.UpdateMN(*dmn, p.second);
     }
 
@@ -491,8 +621,11 @@ void CDeterministicMNList::AddMN(const CDeterministicMNCPtr& dmn, bool fBumpTota
         throw(std::runtime_error(strprintf("%s: Can't add a masternode %s with a duplicate vchNEVMAddress=%s", __func__,
                 dmn->proTxHash.ToString(), dmn->pdmnState->pubKeyOperator.ToString())));
     }
-    mnMap = mnMap.set(dmn->proTxHash, dmn);
-    mnInternalIdMap = mnInternalIdMap.set(dmn->GetInternalId(), dmn->proTxHash);
+    mnMap = std::move(mnMap).set(dmn->proTxHash, dmn);
+    mnInternalIdMap = std::move(mnInternalIdMap).set(dmn->GetInternalId(), dmn->proTxHash);
+    // SYSCOIN
+    AddToPayeeOrder(dmn);
+    UpdateSecondaryIndexes(dmn->proTxHash, nullptr, dmn->pdmnState.get());
     if (fBumpTotalCount) {
         // nTotalRegisteredCount acts more like a checkpoint, not as a limit,
         nTotalRegisteredCount = std::max(dmn->GetInternalId() + 1, (uint64_t)nTotalRegisteredCount);
@@ -529,7 +662,14 @@ void CDeterministicMNList::UpdateMN(const CDeterministicMN& oldDmn, const std::s
         throw(std::runtime_error(strprintf("%s: Can't update a masternode %s with a duplicate old vchNEVMAddress=%s vs new vchNEVMAddress=%s", __func__,
                 oldDmn.proTxHash.ToString(), HexStr(oldState->vchNEVMAddress), HexStr(pdmnState->vchNEVMAddress))));
     }
-    mnMap = mnMap.set(oldDmn.proTxHash, dmn);
+    // SYSCOIN the stored entry is the one ordered, oldDmn may come from another list
+    if (auto storedDmn = mnMap.find(oldDmn.proTxHash)) {
+        RemoveFromPayeeOrder(**storedDmn);
+    }
+    // the entry is replaced in place when this list owns its node, oldDmn may be gone afterwards
+    mnMap = std::move(mnMap).set(dmn->proTxHash, dmn);
+    AddToPayeeOrder(dmn);
+    UpdateSecondaryIndexes(dmn->proTxHash, oldState.get(), pdmnState.get());
 }
 
 void CDeterministicMNList::UpdateMN(const uint256& proTxHash, const std::shared_ptr<const CDeterministicMNState>& pdmnState)
@@ -585,8 +725,11 @@ void CDeterministicMNList::RemoveMN(const uint256& proTxHash)
         throw(std::runtime_error(strprintf("%s: Can't delete a masternode %s with a vchNEVMAddress=%s", __func__,
                 proTxHash.ToString(), HexStr(dmn->pdmnState->vchNEVMAddress))));
     }
-    mnMap = mnMap.erase(proTxHash);
-    mnInternalIdMap = mnInternalIdMap.erase(dmn->GetInternalId());
+    mnMap = std::move(mnMap).erase(proTxHash);
+    mnInternalIdMap = std::move(mnInternalIdMap).erase(dmn->GetInternalId());
+    // SYSCOIN
+    RemoveFromPayeeOrder(*dmn);
+    UpdateSecondaryIndexes(proTxHash, dmn->pdmnState.get(), nullptr);
 }
 
 std::string CDeterministicMNListNEVMAddressDiff::ToString() const {
@@ -612,6 +755,29 @@ std::string CDeterministicMNListNEVMAddressDiff::ToString() const {
     );
 }
 
+// SYSCOIN
+namespace {
+// SYSCOIN no list to build the requested one on is left, the database lost it
+struct missing_list_error : public std::runtime_error {
+    using std::runtime_error::runtime_error;
+};
+} // namespace
+
+static DBParams MakeDiffsDBParams(const DBParams& db_params, const std::string& suffix)
+{
+    DBParams diff_params{db_params};
+    diff_params.path = fs::PathFromString(fs::PathToString(db_params.path) + suffix);
+    return diff_params;
+}
+
+CDeterministicMNManager::CDeterministicMNManager(const DBParams& db_params, bool fDeltaSnapshots)
+    : m_delta_snapshots(fDeltaSnapshots),
+      m_evoDb(std::make_unique<CEvoDB<uint256, CDeterministicMNList, StaticSaltedHasher>>(db_params, DISK_SNAPSHOTS)),
+      m_evoDbDiffs(std::make_unique<CEvoDB<uint256, CDeterministicMNListDiff, StaticSaltedHasher>>(MakeDiffsDBParams(db_params, "_diffs"), LIST_CACHE_SIZE)),
+      m_evoDbSnapshotDeltas(std::make_unique<CEvoDB<uint256, CDeterministicMNListSnapshotDelta, StaticSaltedHasher>>(MakeDiffsDBParams(db_params, "_snapdeltas"), DISK_SNAPSHOTS))
+{
+}
+
 bool CDeterministicMNManager::ProcessBlock(const CBlock& block, const CBlockIndex* pindex, BlockValidationState& _state, const CCoinsViewCache& view, const llmq::CFinalCommitmentTxPayload &qcTx, CDeterministicMNListNEVMAddressDiff &diffNEVM, bool fJustCheck, bool ibd)
 {
     const auto& consensusParams = Params().GetConsensus();
@@ -627,7 +793,11 @@ bool CDeterministicMNManager::ProcessBlock(const CBlock& block, const CBlockInde
     int nHeight = pindex->nHeight;
     try {
 
-        if (!BuildNewListFromBlock(block, pindex->pprev, _state, view, newList, oldList, qcTx)) {
+        const auto time_start{SteadyClock::now()};
+        const bool fBuilt = BuildNewListFromBlock(block, pindex->pprev, _state, view, newList, oldList, qcTx);
+        TRACE6(evo, mnlist_built, pindex->phashBlock->data(), nHeight, fBuilt, fJustCheck, newList.GetAllMNsCount(),
+            Ticks<std::chrono::microseconds>(SteadyClock::now() - time_start));
+        if (!fBuilt) {
             // pass the state returned by the function above
             return false;
         }
@@ -643,16 +813,34 @@ bool CDeterministicMNManager::ProcessBlock(const CBlock& block, const CBlockInde
 
         if(!ibd || (fNEVMConnection && fNexusActive && newList.m_changed_nevm_address)) {
             oldList.BuildDiff(newList, diff, diffNEVM);
+        } else {
+            // the diff is still needed to persist the list, the NEVM address changes are not
+            CDeterministicMNListNEVMAddressDiff unusedDiffNEVM;
+            oldList.BuildDiff(newList, diff, unusedDiffNEVM);
         }
         if(!ibd) {
+            // SYSCOIN listeners first catch up with the blocks connected during IBD
+            NotifyHeldBackListChanges(oldList);
             if (diff.HasChanges()) {
                 GetMainSignals().NotifyMasternodeListChanged(false, oldList, diff);
             }
             // always update interface for payment detail changes
             uiInterface.NotifyMasternodeListChanged(newList);
+        } else {
+            // SYSCOIN the changes are signalled once per batch of blocks by UpdatedBlockTip
+            LOCK(cs);
+            if (!pindexIBDNotified) pindexIBDNotified = pindex->pprev;
         }
-        m_evoDb->WriteCache(pindex->GetBlockHash(), std::move(newList));
-       
+        if (!WriteList(pindex, newList, std::move(diff))) {
+            return _state.Error("failed-dmn-flush");
+        }
+        LOCK(cs);
+        mnListsCache[pindex->GetBlockHash()] = std::move(newList);
+
+    } catch (const missing_list_error& e) {
+        // the database lost lists, that is no reason to reject the block
+        LogPrintf("CDeterministicMNManager::%s -- %s\n", __func__, e.what());
+        return _state.Error("failed-dmn-list");
     } catch (const std::exception& e) {
         LogPrint(BCLog::MNLIST, "CDeterministicMNManager::%s -- internal error: %s\n", __func__, e.what());
         return _state.Invalid(BlockValidationResult::BLOCK_CONSENSUS, "failed-dmn-block");
@@ -661,18 +849,77 @@ bool CDeterministicMNManager::ProcessBlock(const CBlock& block, const CBlockInde
     return true;
 }
 
+bool CDeterministicMNManager::WriteList(const CBlockIndex* pindex, const CDeterministicMNList& list, CDeterministicMNListDiff&& diff)
+{
+    // SYSCOIN the caches are flushed before they are full, their LRU drops entries whether or not they are on disk
+    if (!DoMaintenance(/*bForceFlush=*/false)) {
+        return false;
+    }
+    // only every DISK_SNAPSHOT_PERIOD blocks the full list is written, the diff otherwise
+    if ((pindex->nHeight % DISK_SNAPSHOT_PERIOD) == 0) {
+        if (!WriteSnapshotDelta(pindex, list)) {
+            m_evoDb->WriteCache(pindex->GetBlockHash(), list);
+        }
+    } else {
+        diff.nHeight = pindex->nHeight;
+        m_evoDbDiffs->WriteCache(pindex->GetBlockHash(), std::move(diff));
+    }
+    return true;
+}
+
+bool CDeterministicMNManager::WriteSnapshotDelta(const CBlockIndex* pindex, const CDeterministicMNList& list)
+{
+    if (!m_delta_snapshots || pindex->nHeight < DISK_SNAPSHOT_PERIOD) {
+        return false;
+    }
+    // a full list wipe only keeps what is in the caches, so the delta is only written if the snapshot it
+    // builds on goes to disk in the same flush. A flush empties the caches, so every flush starts with a
+    // full list. Chains are cut at MAX_SNAPSHOT_DELTAS so reading a snapshot replays only a few deltas
+    const CBlockIndex* pindexBase = pindex->GetAncestor(pindex->nHeight - DISK_SNAPSHOT_PERIOD);
+    int nChainLength{0};
+    for (const CBlockIndex* pindexChain = pindexBase; !m_evoDb->IsCached(pindexChain->GetBlockHash());
+         pindexChain = pindexChain->GetAncestor(pindexChain->nHeight - DISK_SNAPSHOT_PERIOD)) {
+        if (!m_evoDbSnapshotDeltas->IsCached(pindexChain->GetBlockHash()) || ++nChainLength >= MAX_SNAPSHOT_DELTAS) {
+            return false;
+        }
+    }
+    const CDeterministicMNList baseList = GetListForBlockInternal(pindexBase);
+    CDeterministicMNListSnapshotDelta delta;
+    CDeterministicMNListNEVMAddressDiff unusedDiffNEVM;
+    baseList.BuildDiff(list, delta.diff, unusedDiffNEVM);
+    delta.nTotalRegisteredCount = list.GetTotalRegisteredCount();
+    m_evoDbSnapshotDeltas->WriteCache(pindex->GetBlockHash(), std::move(delta));
+    return true;
+}
+
+void CDeterministicMNManager::NotifyHeldBackListChanges(const CDeterministicMNList& list)
+{
+    const CBlockIndex* pindexNotified = WITH_LOCK(cs, return std::exchange(pindexIBDNotified, nullptr));
+    if (!pindexNotified || pindexNotified->GetBlockHash() == list.GetBlockHash()) {
+        return;
+    }
+    // one diff over all the blocks, listeners only need to know what changed in between
+    const CDeterministicMNList notifiedList = GetListForBlockInternal(pindexNotified);
+    CDeterministicMNListDiff diff;
+    CDeterministicMNListNEVMAddressDiff unusedDiffNEVM;
+    notifiedList.BuildDiff(list, diff, unusedDiffNEVM);
+    if (diff.HasChanges()) {
+        GetMainSignals().NotifyMasternodeListChanged(false, notifiedList, diff);
+    }
+    uiInterface.NotifyMasternodeListChanged(list);
+}
 
 bool CDeterministicMNManager::UndoBlock(const CBlockIndex* pindex, CDeterministicMNListNEVMAddressDiff &inversedDiffNEVMAddress)
 {
     uint256 blockHash = pindex->GetBlockHash();
 
-    CDeterministicMNList curList;
-    CDeterministicMNList prevList;
-    bool readCache = m_evoDb->ReadCache(blockHash, curList);
-    if(readCache) {
-        prevList = GetListForBlockInternal(pindex->pprev);
+    if(HasListForBlock(blockHash)) {
+        const CDeterministicMNList curList = GetListForBlockInternal(pindex);
+        const CDeterministicMNList prevList = GetListForBlockInternal(pindex->pprev);
         CDeterministicMNListDiff inversedDiff;
         curList.BuildDiff(prevList, inversedDiff, inversedDiffNEVMAddress);
+        // SYSCOIN listeners have to know the list that is undone
+        NotifyHeldBackListChanges(curList);
         if(inversedDiff.HasChanges()) {
             GetMainSignals().NotifyMasternodeListChanged(true, prevList, inversedDiff);
         }
@@ -956,7 +1203,8 @@ bool CDeterministicMNManager::BuildNewListFromBlock(const CBlock& block, const C
 void CDeterministicMNManager::HandleQuorumCommitment(const llmq::CFinalCommitment& qc, const CBlockIndex* pQuorumBaseBlockIndex, CDeterministicMNList& mnList)
 {
     // The commitment has already been validated at this point, so it's safe to use members of it
-    auto members = llmq::CLLMQUtils::GetAllQuorumMembers(pQuorumBaseBlockIndex);
+    const auto quorumMembers = llmq::CLLMQUtils::GetAllQuorumMembers(pQuorumBaseBlockIndex);
+    const auto& members = *quorumMembers;
 
     for (size_t i = 0; i < members.size(); i++) {
         if (!mnList.HasMN(members[i]->proTxHash)) {
@@ -987,34 +1235,166 @@ const CDeterministicMNList CDeterministicMNManager::GetListForBlockInternal(cons
     if (!fDIP0003Active) {
         return snapshot;
     }
-    if (!m_evoDb->ReadCache(pindex->GetBlockHash(), snapshot)) {
-        snapshot = CDeterministicMNList(pindex->GetBlockHash(), pindex->nHeight, 0);
-        m_evoDb->WriteCache(pindex->GetBlockHash(), snapshot);
-        LogPrint(BCLog::MNLIST, "CDeterministicMNManager::%s -- initial snapshot. blockHash=%s nHeight=%d\n", __func__,
-                    snapshot.GetBlockHash().ToString(), snapshot.GetHeight());
-        return snapshot;
+    // walk back to the nearest list we have in full, collecting the diffs on the way. Full lists are only
+    // persisted at DISK_SNAPSHOT_PERIOD heights so no more than one snapshot is loaded and the replay is
+    // bounded by the period. cs is only taken for the caches, not while reading from disk.
+    std::vector<std::pair<const CBlockIndex*, CDeterministicMNListDiff>> listDiffs;
+    bool fCached{false};
+    for (const CBlockIndex* pindexWalk = pindex; ; pindexWalk = pindexWalk->pprev) {
+        const uint256& blockHash = pindexWalk->GetBlockHash();
+        if (WITH_LOCK(cs, return GetCachedList(blockHash, snapshot))) {
+            fCached = true;
+            break;
+        }
+        // the empty list before DIP3 activation is where all lists start from
+        if (pindexWalk->nHeight < consensusParams.DIP0003Height) {
+            snapshot = CDeterministicMNList(blockHash, pindexWalk->nHeight, 0);
+            break;
+        }
+        const bool fSnapshotHeight = (pindexWalk->nHeight % DISK_SNAPSHOT_PERIOD) == 0;
+        if (fSnapshotHeight && m_evoDb->ReadCache(blockHash, snapshot)) {
+            break;
+        }
+        // SYSCOIN the snapshot it builds on is at most MAX_SNAPSHOT_DELTAS - 1 deltas away from a full list
+        CDeterministicMNListSnapshotDelta delta;
+        if (fSnapshotHeight && pindexWalk->nHeight >= DISK_SNAPSHOT_PERIOD && m_evoDbSnapshotDeltas->ReadCache(blockHash, delta)) {
+            snapshot = GetListForBlockInternal(pindexWalk->GetAncestor(pindexWalk->nHeight - DISK_SNAPSHOT_PERIOD)).ApplyDiff(pindexWalk, delta.diff);
+            snapshot.SetTotalRegisteredCount(delta.nTotalRegisteredCount);
+            break;
+        }
+        CDeterministicMNListDiff diff;
+        if (pindexWalk->pprev && m_evoDbDiffs->ReadCache(blockHash, diff)) {
+            diff.nHeight = pindexWalk->nHeight;
+            listDiffs.emplace_back(pindexWalk, std::move(diff));
+            continue;
+        }
+        // older versions persisted the full list of every block
+        if (!fSnapshotHeight && m_evoDb->ReadCache(blockHash, snapshot)) {
+            break;
+        }
+        throw missing_list_error(strprintf("%s: no masternode list to build the list of block %s on, missing at height %d", __func__,
+                    pindex->GetBlockHash().ToString(), pindexWalk->nHeight));
+    }
+    std::vector<CDeterministicMNList> listsToCache;
+    if (!fCached) {
+        listsToCache.push_back(snapshot);
+    }
+    for (auto it = listDiffs.rbegin(); it != listDiffs.rend(); ++it) {
+        snapshot = snapshot.ApplyDiff(it->first, it->second);
+        listsToCache.push_back(snapshot);
+    }
+    if (!listsToCache.empty()) {
+        LOCK(cs);
+        for (size_t i = 0; i < listsToCache.size(); ++i) {
+            // of historical lists only the loaded snapshot and the requested one are worth keeping
+            CacheList(listsToCache[i], /*fKeepHistory=*/(i == 0 && !fCached) || i + 1 == listsToCache.size());
+        }
     }
     assert(snapshot.GetHeight() != -1);
     return snapshot;
 }
+
+bool CDeterministicMNManager::GetCachedList(const uint256& blockHash, CDeterministicMNList& list)
+{
+    AssertLockHeld(cs);
+    auto it = mnListsCache.find(blockHash);
+    if (it != mnListsCache.end()) {
+        list = it->second;
+        return true;
+    }
+    return mnListsHistoryCache.get(blockHash, list);
+}
+
+void CDeterministicMNManager::CacheList(const CDeterministicMNList& list, bool fKeepHistory)
+{
+    AssertLockHeld(cs);
+    if (tipIndex && list.GetHeight() < tipIndex->nHeight - LIST_CACHE_SIZE) {
+        if (fKeepHistory) mnListsHistoryCache.insert(list.GetBlockHash(), list);
+    } else {
+        mnListsCache.emplace(list.GetBlockHash(), list);
+    }
+}
+
+bool CDeterministicMNManager::HasListForBlock(const uint256& blockHash)
+{
+    LOCK(cs);
+    return mnListsCache.count(blockHash) > 0 || mnListsHistoryCache.exists(blockHash) || m_evoDb->ExistsCache(blockHash) || m_evoDbDiffs->ExistsCache(blockHash) || m_evoDbSnapshotDeltas->ExistsCache(blockHash);
+}
+
 const CDeterministicMNList CDeterministicMNManager::GetListForBlock(const CBlockIndex* pindex) {
     return GetListForBlockInternal(pindex);
 };
 const CDeterministicMNList CDeterministicMNManager::GetListAtChainTip()
 {
-    const CBlockIndex* pindex;
-    {
-        LOCK(cs);
-        pindex = tipIndex;
+    return *GetListAtChainTipPtr();
+}
+
+std::shared_ptr<const CDeterministicMNList> CDeterministicMNManager::GetListAtChainTipPtr()
+{
+    LOCK(cs_tip_list);
+    if (!tipList) {
+        static const auto emptyList = std::make_shared<const CDeterministicMNList>();
+        return emptyList;
     }
-    if (!pindex) {
-        return CDeterministicMNList();
+    return tipList;
+}
+
+std::shared_ptr<const std::vector<unsigned char>> CDeterministicMNManager::GetListDiff(const CBlockIndex* pindexFrom, const CBlockIndex* pindexTo) {
+    fDiffRequested = true;
+    const auto key = std::make_pair(pindexFrom->GetBlockHash(), pindexTo->GetBlockHash());
+    {
+        LOCK(cs_diff_cache);
+        std::shared_ptr<const std::vector<unsigned char>> cached;
+        if (mnListDiffCache.get(key, cached)) {
+            return cached;
+        }
     }
-    return GetListForBlockInternal(pindex);
+    const CDeterministicMNList fromList = GetListForBlockInternal(pindexFrom);
+    const CDeterministicMNList toList = GetListForBlockInternal(pindexTo);
+    CDeterministicMNListDiff diff;
+    CDeterministicMNListNEVMAddressDiff unusedDiffNEVM;
+    fromList.BuildDiff(toList, diff, unusedDiffNEVM);
+    CDataStream ss(SER_NETWORK, PROTOCOL_VERSION);
+    ss << diff;
+    const auto bytes = MakeUCharSpan(ss);
+    auto ret = std::make_shared<const std::vector<unsigned char>>(bytes.begin(), bytes.end());
+    LOCK(cs_diff_cache);
+    mnListDiffCache.insert(key, ret);
+    return ret;
 }
 
 void CDeterministicMNManager::UpdatedBlockTip(const CBlockIndex* pindex) {
-    WITH_LOCK(cs, tipIndex = pindex;);
+    // SYSCOIN publish the list of the new tip before trimming, readers only copy the pointer
+    auto newTipList = pindex ? std::make_shared<const CDeterministicMNList>(GetListForBlockInternal(pindex)) : nullptr;
+    if (newTipList) NotifyHeldBackListChanges(*newTipList);
+    WITH_LOCK(cs_tip_list, tipList = std::move(newTipList));
+    // clients that synced to one of the previous tips ask for the diff to this one next
+    if (pindex && fDiffRequested) {
+        for (int i = 1; i <= DIFF_PRECOMPUTE_TIPS && i <= pindex->nHeight; ++i) {
+            GetListDiff(pindex->GetAncestor(pindex->nHeight - i), pindex);
+        }
+    }
+    if (pindex && pindex->nHeight % DISK_SNAPSHOT_PERIOD == 0 && LogAcceptCategory(BCLog::MNLIST, BCLog::Level::Debug)) {
+        EvoDBStats stats;
+        GetMemoryUsage(stats);
+        LogPrint(BCLog::MNLIST, "CDeterministicMNManager::%s -- memory usage: lists=%zu (%zu lists), snapshot cache=%zu, diff cache=%zu, quorum vvec cache=%zu, quorum sk cache=%zu, recovered sigs cache=%zu\n", __func__,
+                 stats.listsCacheUsage, stats.listsCacheEntries, stats.snapshotCacheUsage, stats.diffCacheUsage,
+                 llmq::quorumManager ? llmq::quorumManager->GetVvecCacheUsage() : 0,
+                 llmq::quorumManager ? llmq::quorumManager->GetSkCacheUsage() : 0,
+                 llmq::quorumSigningManager ? llmq::quorumSigningManager->GetRecoveredSigsCacheUsage() : 0);
+    }
+    LOCK(cs);
+    tipIndex = pindex;
+    if (!pindex || mnListsCache.size() <= LIST_CACHE_SIZE) return;
+    // older lists are rebuilt from disk if ever needed again
+    const int nMinHeight = pindex->nHeight - LIST_CACHE_SIZE;
+    for (auto it = mnListsCache.begin(); it != mnListsCache.end(); ) {
+        if (it->second.GetHeight() < nMinHeight) {
+            it = mnListsCache.erase(it);
+        } else {
+            ++it;
+        }
+    }
 }
 
 bool CDeterministicMNManager::IsProTxWithCollateral(const CTransactionRef& tx, uint32_t n)
@@ -1045,22 +1425,93 @@ bool CDeterministicMNManager::IsDIP3Enforced(int nHeight)
 }
 
 bool CDeterministicMNManager::DoMaintenance(bool bForceFlush) {
-    LOCK(m_evoDb->cs);
-    if (m_evoDb->IsCacheFull()) {
+    // the diffs are only usable together with the snapshot they start from, so both are wiped and flushed at once
+    bool fCacheFull = m_evoDb->IsCacheFull() || m_evoDbDiffs->IsCacheFull() || m_evoDbSnapshotDeltas->IsCacheFull();
+    if (!bForceFlush && !fCacheFull) return true;
+    if (fCacheFull) {
+        // SYSCOIN a wipe only keeps what is cached, diffs from before the oldest cached full list would have nothing
+        // left to apply to. Cached deltas always build on a cached full list
+        int nOldestSnapshot{std::numeric_limits<int>::max()};
+        m_evoDb->ForEachCache([&](const CDeterministicMNList& list) { nOldestSnapshot = std::min(nOldestSnapshot, list.GetHeight()); });
+        if (nOldestSnapshot == std::numeric_limits<int>::max()) {
+            // nothing to start over from, keep what is on disk
+            fCacheFull = false;
+        } else {
+            m_evoDbDiffs->DropCacheIf([&](const CDeterministicMNListDiff& diff) { return diff.nHeight < nOldestSnapshot; });
+        }
+    }
+    if (!bForceFlush) {
+        // SYSCOIN hand full caches to the background writers so block processing does not wait for disk
+        if (fCacheFull) LogPrint(BCLog::SYS, "CDeterministicMNManager::DoMaintenance wiping and recreating the database in the background.\n");
+        const bool fSnapshots = m_evoDb->FlushCacheToDiskAsync(/*fWipe=*/fCacheFull);
+        const bool fDiffs = m_evoDbDiffs->FlushCacheToDiskAsync(/*fWipe=*/fCacheFull);
+        const bool fDeltas = m_evoDbSnapshotDeltas->FlushCacheToDiskAsync(/*fWipe=*/fCacheFull);
+        return fSnapshots && fDiffs && fDeltas;
+    }
+    m_evoDb->WaitForFlush();
+    m_evoDbDiffs->WaitForFlush();
+    m_evoDbSnapshotDeltas->WaitForFlush();
+    LOCK2(m_evoDb->cs, m_evoDbDiffs->cs);
+    LOCK(m_evoDbSnapshotDeltas->cs);
+    if (fCacheFull) {
         m_evoDb->ResetDB();
-        bForceFlush = true;
+        m_evoDbDiffs->ResetDB();
+        m_evoDbSnapshotDeltas->ResetDB();
         LogPrint(BCLog::SYS, "CDeterministicMNManager::DoMaintenance Database successfully wiped and recreated.\n");
     }
-    if(bForceFlush) {
-        if(!m_evoDb->FlushCacheToDisk()) {
-            return false;
-        }
-    }
-    return true;
+    return m_evoDb->FlushCacheToDisk() && m_evoDbDiffs->FlushCacheToDisk() && m_evoDbSnapshotDeltas->FlushCacheToDisk();
 }
 bool CDeterministicMNManager::FlushCacheToDisk(bool bForceFlush) {
     return DoMaintenance(bForceFlush);
 }
+CDeterministicMNCPtr CDeterministicMNManager::InternMN(CDeterministicMNCPtr&& dmn)
+{
+    const uint256 hash = ::SerializeHash(*dmn);
+    LOCK(cs_interned);
+    auto& entry = mapInternedMNs[hash];
+    if (CDeterministicMNCPtr interned = entry.lock()) {
+        return interned;
+    }
+    entry = dmn;
+    if (mapInternedMNs.size() >= nInternedSweepSize) {
+        for (auto it = mapInternedMNs.begin(); it != mapInternedMNs.end(); ) {
+            if (it->second.expired()) {
+                it = mapInternedMNs.erase(it);
+            } else {
+                ++it;
+            }
+        }
+        nInternedSweepSize = std::max(INTERNED_MNS_MIN_SWEEP_SIZE, mapInternedMNs.size() * 2);
+    }
+    return std::move(dmn);
+}
+
+CDeterministicMNCPtr InternDeterministicMN(CDeterministicMNCPtr&& dmn)
+{
+    if (!deterministicMNManager) return std::move(dmn);
+    return deterministicMNManager->InternMN(std::move(dmn));
+}
+
+void CDeterministicMNManager::GetMemoryUsage(EvoDBStats& stats)
+{
+    std::unordered_set<const void*> seen;
+    const auto tipListPtr = GetListAtChainTipPtr();
+    stats.listsCacheUsage = tipListPtr->DynamicMemoryUsage(seen);
+    {
+        LOCK(cs);
+        stats.listsCacheEntries = mnListsCache.size() + mnListsHistoryCache.size();
+        for (const auto& [hash, list] : mnListsCache) {
+            stats.listsCacheUsage += list.DynamicMemoryUsage(seen);
+        }
+        mnListsHistoryCache.for_each([&](const uint256&, const CDeterministicMNList& list) {
+            stats.listsCacheUsage += list.DynamicMemoryUsage(seen);
+        });
+        stats.listsCacheUsage += memusage::DynamicUsage(mnListsCache) + mnListsHistoryCache.DynamicMemoryUsage();
+    }
+    stats.snapshotCacheUsage = m_evoDb->GetCacheUsage() + m_evoDbSnapshotDeltas->GetCacheUsage();
+    stats.diffCacheUsage = m_evoDbDiffs->GetCacheUsage();
+}
+
 bool CDeterministicMNManager::GetEvoDBStats(EvoDBStats& stats)
 {
     if (!m_evoDb) {
@@ -1072,15 +1523,26 @@ bool CDeterministicMNManager::GetEvoDBStats(EvoDBStats& stats)
     try {
         // Get DB path from parameters used to initialize CEvoDB
         stats.dbPath = fs::PathToString(m_evoDb->GetDBParams().path);
-        stats.cacheEntries = m_evoDb->GetReadWriteCacheSize();
-        stats.eraseCacheEntries = m_evoDb->GetEraseCacheSize();
-        stats.approxPersistedEntries = m_evoDb->CountPersistedEntries(); 
+        // SYSCOIN entries of the snapshot and the diff databases together
+        stats.cacheEntries = m_evoDb->GetReadWriteCacheSize() + m_evoDbDiffs->GetReadWriteCacheSize() + m_evoDbSnapshotDeltas->GetReadWriteCacheSize();
+        stats.eraseCacheEntries = m_evoDb->GetEraseCacheSize() + m_evoDbDiffs->GetEraseCacheSize() + m_evoDbSnapshotDeltas->GetEraseCacheSize();
+        const int64_t snapshotEntries = m_evoDb->CountPersistedEntries();
+        const int64_t diffEntries = m_evoDbDiffs->CountPersistedEntries();
+        const int64_t deltaEntries = m_evoDbSnapshotDeltas->CountPersistedEntries();
+        stats.approxPersistedEntries = (snapshotEntries < 0 || diffEntries < 0 || deltaEntries < 0) ? -1 : snapshotEntries + diffEntries + deltaEntries;
+        GetMemoryUsage(stats);
 
         // Calculate disk size by iterating directory
         stats.estimatedDiskSizeBytes = 0; // Initialize size
         if (!stats.dbPath.empty() && fs::is_directory(stats.dbPath)) {
             try { // Add inner try-catch for filesystem iteration errors
-                for (const auto& dir_entry : fs::recursive_directory_iterator(stats.dbPath)) {
+                std::vector<fs::directory_entry> dir_entries{fs::recursive_directory_iterator(stats.dbPath), fs::recursive_directory_iterator()};
+                for (const fs::path& diffsPath : {m_evoDbDiffs->GetDBParams().path, m_evoDbSnapshotDeltas->GetDBParams().path}) {
+                    if (fs::is_directory(diffsPath)) {
+                        dir_entries.insert(dir_entries.end(), fs::recursive_directory_iterator(diffsPath), fs::recursive_directory_iterator());
+                    }
+                }
+                for (const auto& dir_entry : dir_entries) {
                     if (fs::is_regular_file(dir_entry.path())) {
                         std::error_code ec;
                         uint64_t fileSize = fs::file_size(dir_entry.path(), ec);
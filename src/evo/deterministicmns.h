@@ -14,8 +14,12 @@
 #include <saltedhasher.h>
 #include <scheduler.h>
 #include <sync.h>
+#include <unordered_lru_cache.h>
 
+#include <immer/flex_vector.hpp>
+#include <immer/heap/heap_policy.hpp>
 #include <immer/map.hpp>
+#include <immer/memory_policy.hpp>
 
 #include <atomic>
 #include <limits>
@@ -71,10 +75,34 @@ public:
     void ToJson(interfaces::Chain& chain, UniValue& obj) const;
 };
 using CDeterministicMNCPtr = std::shared_ptr<const CDeterministicMN>;
+// SYSCOIN returns the equal masternode object already loaded by the manager if there is one, dmn otherwise
+CDeterministicMNCPtr InternDeterministicMN(CDeterministicMNCPtr&& dmn);
 
 class CDeterministicMNListDiff;
 class CDeterministicMNListNEVMAddressDiff;
 
+// SYSCOIN the map nodes of immer's default memory policy come straight from the global allocator, its
+// free lists only serve fixed size objects. The masternode maps pool their nodes in a few size classes
+// instead, each a thread local free list backed by a global lock free one. Refcounts stay atomic as
+// lists are handed to other threads through the list cache.
+namespace dmn_memory {
+template <std::size_t Size>
+using PoolHeap = immer::with_free_list_node<immer::thread_local_free_list_heap<Size, immer::default_free_list_size,
+    immer::free_list_heap<Size, immer::default_free_list_size, immer::debug_size_heap<immer::cpp_heap>>>>;
+using Heap = immer::split_heap<64, PoolHeap<64>, immer::split_heap<128, PoolHeap<128>,
+    immer::split_heap<256, PoolHeap<256>, immer::split_heap<512, PoolHeap<512>, immer::debug_size_heap<immer::cpp_heap>>>>>;
+using MemoryPolicy = immer::memory_policy<immer::heap_policy<Heap>, immer::refcount_policy, immer::spinlock_policy>;
+
+/** Bytes Heap takes for an allocation of size bytes, without the overhead of the global allocator */
+constexpr size_t AllocationSize(size_t size)
+{
+    for (const size_t pool_size : {64, 128, 256, 512}) {
+        if (size <= pool_size) return pool_size + sizeof(immer::free_list_node);
+    }
+    return size;
+}
+} // namespace dmn_memory
+
 
 class CDeterministicMNList
 {
@@ -83,11 +111,20 @@ private:
     {
         size_t operator()(const uint256& hash) const { return ReadLE64(hash.begin()); }
     };
+    // SYSCOIN
+    struct BinaryKeyHasher
+    {
+        size_t operator()(const std::vector<unsigned char>& key) const;
+    };
 
 public:
-    using MnMap = immer::map<uint256, CDeterministicMNCPtr, ImmerHasher>;
-    using MnInternalIdMap = immer::map<uint64_t, uint256>;
-    using MnUniquePropertyMap = immer::map<uint256, std::pair<uint256, uint32_t>, ImmerHasher>;
+    using MnMap = immer::map<uint256, CDeterministicMNCPtr, ImmerHasher, std::equal_to<uint256>, dmn_memory::MemoryPolicy>;
+    using MnInternalIdMap = immer::map<uint64_t, uint256, std::hash<uint64_t>, std::equal_to<uint64_t>, dmn_memory::MemoryPolicy>;
+    using MnUniquePropertyMap = immer::map<uint256, std::pair<uint256, uint32_t>, ImmerHasher, std::equal_to<uint256>, dmn_memory::MemoryPolicy>;
+    // SYSCOIN valid masternodes in the order they get paid
+    using MnPayeeOrder = immer::flex_vector<CDeterministicMNCPtr>;
+    // SYSCOIN binary service address or operator key to proTxHash
+    using MnBinaryKeyMap = immer::map<std::vector<unsigned char>, uint256, BinaryKeyHasher, std::equal_to<std::vector<unsigned char>>, dmn_memory::MemoryPolicy>;
     bool m_changed_nevm_address{false};
 private:
     uint256 blockHash;
@@ -99,6 +136,12 @@ private:
     // map of unique properties like address and keys
     // we keep track of this as checking for duplicates would otherwise be painfully slow
     MnUniquePropertyMap mnUniquePropertyMap;
+    // SYSCOIN kept in sync with mnMap so the payee and its projections don't need a pass over all masternodes
+    MnPayeeOrder mnPayeeOrder;
+    // SYSCOIN secondary indexes for the hot lookups by service and operator key, which then
+    // neither serialize nor hash the property as mnUniquePropertyMap does
+    MnBinaryKeyMap mnServiceMap;
+    MnBinaryKeyMap mnOperatorKeyMap;
 
 public:
     CDeterministicMNList() = default;
@@ -128,24 +171,36 @@ public:
         mnMap = MnMap();
         mnUniquePropertyMap = MnUniquePropertyMap();
         mnInternalIdMap = MnInternalIdMap();
+        mnPayeeOrder = MnPayeeOrder();
+        mnServiceMap = MnBinaryKeyMap();
+        mnOperatorKeyMap = MnBinaryKeyMap();
         s >> blockHash;
         s >> nHeight;
         s >> nTotalRegisteredCount;
 
         size_t cnt = ReadCompactSize(s);
         for (size_t i = 0; i < cnt; i++) {
-            AddMN(std::make_shared<CDeterministicMN>(deserialize, s), false);
+            // SYSCOIN adjacent lists mostly hold the same masternodes, share them instead of keeping a copy per list
+            AddMN(InternDeterministicMN(std::make_shared<const CDeterministicMN>(deserialize, s)), false);
         }
     }
     void clear() {
         mnMap = MnMap();
         mnUniquePropertyMap = MnUniquePropertyMap();
         mnInternalIdMap = MnInternalIdMap();
+        mnPayeeOrder = MnPayeeOrder();
+        mnServiceMap = MnBinaryKeyMap();
+        mnOperatorKeyMap = MnBinaryKeyMap();
         blockHash.SetNull();
         nHeight = -1;
         nTotalRegisteredCount = 0;
         m_changed_nevm_address = false;
     }
+    /**
+     * Heap memory used by the list. Nodes and masternodes already in seen are shared with lists
+     * counted before and skipped, so passing one set over many lists counts shared memory once.
+     */
+    size_t DynamicMemoryUsage(std::unordered_set<const void*>& seen) const;
     [[nodiscard]] size_t GetAllMNsCount() const
     {
         return mnMap.size();
@@ -213,6 +268,10 @@ public:
     {
         return nTotalRegisteredCount;
     }
+    void SetTotalRegisteredCount(uint32_t _totalRegisteredCount)
+    {
+        nTotalRegisteredCount = _totalRegisteredCount;
+    }
 
     [[nodiscard]] bool IsMNValid(const uint256& proTxHash) const;
     [[nodiscard]] bool IsMNPoSeBanned(const uint256& proTxHash) const;
@@ -315,6 +374,13 @@ public:
     }
 
 private:
+    // SYSCOIN
+    void AddToPayeeOrder(const CDeterministicMNCPtr& dmn);
+    void RemoveFromPayeeOrder(const CDeterministicMN& dmn);
+    static std::vector<unsigned char> GetOperatorKeyIndexKey(const CBLSPublicKey& pubKey);
+    /** Move the service and operator key index entries of a masternode from oldState to newState, either may be null */
+    void UpdateSecondaryIndexes(const uint256& proTxHash, const CDeterministicMNState* oldState, const CDeterministicMNState* newState);
+
     template <typename T>
     [[nodiscard]] uint256 GetUniquePropertyHash(const T& v) const
     {
@@ -338,7 +404,7 @@ private:
         if (oldEntry != nullptr) {
             newEntry.second = oldEntry->second + 1;
         }
-        mnUniquePropertyMap = mnUniquePropertyMap.set(hash, newEntry);
+        mnUniquePropertyMap = std::move(mnUniquePropertyMap).set(hash, newEntry);
         return true;
     }
     template <typename T>
@@ -355,9 +421,9 @@ private:
             return false;
         }
         if (p->second == 1) {
-            mnUniquePropertyMap = mnUniquePropertyMap.erase(oldHash);
+            mnUniquePropertyMap = std::move(mnUniquePropertyMap).erase(oldHash);
         } else {
-            mnUniquePropertyMap = mnUniquePropertyMap.set(oldHash, std::make_pair(dmn.proTxHash, p->second - 1));
+            mnUniquePropertyMap = std::move(mnUniquePropertyMap).set(oldHash, std::make_pair(dmn.proTxHash, p->second - 1));
         }
         return true;
     }
@@ -390,6 +456,13 @@ private:
     }
 };
 
+// SYSCOIN estimate for the snapshot write cache, which counts each snapshot on its own
+inline size_t EvoDBHeapUsage(const CDeterministicMNList& list)
+{
+    std::unordered_set<const void*> seen;
+    return list.DynamicMemoryUsage(seen);
+}
+
 
 class CDeterministicMNListNEVMAddressDiff
 {
@@ -456,6 +529,10 @@ public:
         size_t tmp;
         uint64_t tmp2;
         s >> addedMNs;
+        // SYSCOIN
+        for (auto& dmn : addedMNs) {
+            dmn = InternDeterministicMN(std::move(dmn));
+        }
         tmp = ReadCompactSize(s);
         for (size_t i = 0; i < tmp; i++) {
             CDeterministicMNStateDiff diff;
@@ -478,11 +555,38 @@ public:
         return !addedMNs.empty() || !updatedMNs.empty() || !removedMns.empty();
     }
 };
+// SYSCOIN a disk snapshot persisted as the field-wise diff to the snapshot DISK_SNAPSHOT_PERIOD blocks before it.
+// Masternodes registered and removed in between don't show up in the diff, so the registration count is kept too
+class CDeterministicMNListSnapshotDelta
+{
+public:
+    uint32_t nTotalRegisteredCount{0};
+    CDeterministicMNListDiff diff;
+
+    SERIALIZE_METHODS(CDeterministicMNListSnapshotDelta, obj) {
+        READWRITE(obj.nTotalRegisteredCount, obj.diff);
+    }
+};
+
+static constexpr bool DEFAULT_EVODB_DELTA_SNAPSHOTS{false};
+
 class CDeterministicMNManager
 {
+public:
     static constexpr int DISK_SNAPSHOT_PERIOD = 576; // once per day
+    // SYSCOIN a full snapshot is written after this many deltas in a row, reading one replays the chain
+    static constexpr int MAX_SNAPSHOT_DELTAS = 2;
+private:
     static constexpr int DISK_SNAPSHOTS = 3; // keep cache for 3 disk snapshots to have 2 full days covered
     static constexpr int LIST_CACHE_SIZE = DISK_SNAPSHOT_PERIOD * DISK_SNAPSHOTS;
+    // expired entries of the interned masternodes are swept once their count doubled, but not below this
+    static constexpr size_t INTERNED_MNS_MIN_SWEEP_SIZE = 1024;
+    // rebuilt lists of blocks below the LIST_CACHE_SIZE window that are kept
+    static constexpr size_t HISTORY_CACHE_SIZE = 64;
+    // SYSCOIN serialized diffs between the lists of two blocks that are kept
+    static constexpr size_t DIFF_CACHE_SIZE = 256;
+    // once diffs are asked for, the diffs from this many previous tips to a new tip are built ahead
+    static constexpr int DIFF_PRECOMPUTE_TIPS = 8;
 
 private:
     Mutex cs;
@@ -490,6 +594,31 @@ private:
     std::atomic<int> to_cleanup {0};
 
     const CBlockIndex* tipIndex GUARDED_BY(cs) {nullptr};
+    // SYSCOIN block of the list masternode list listeners last saw, while the changes of blocks connected
+    // during IBD are held back to be signalled once per batch of blocks
+    const CBlockIndex* pindexIBDNotified GUARDED_BY(cs) {nullptr};
+    // SYSCOIN list of tipIndex, only held for the pointer copy so readers never wait for cs
+    Mutex cs_tip_list;
+    std::shared_ptr<const CDeterministicMNList> tipList GUARDED_BY(cs_tip_list);
+    // SYSCOIN full lists of recent blocks, memory only. Lists share their masternodes through immer
+    // so keeping many of them is cheap compared to writing each of them to disk
+    std::unordered_map<uint256, CDeterministicMNList, StaticSaltedHasher> mnListsCache GUARDED_BY(cs);
+    // lists older than the cache above which were rebuilt for historical queries
+    unordered_lru_cache<uint256, CDeterministicMNList, StaticSaltedHasher, HISTORY_CACHE_SIZE> mnListsHistoryCache GUARDED_BY(cs);
+    // masternodes loaded from disk by the hash of their serialization, lists are loaded while holding cs
+    Mutex cs_interned;
+    std::unordered_map<uint256, std::weak_ptr<const CDeterministicMN>, StaticSaltedHasher> mapInternedMNs GUARDED_BY(cs_interned);
+    size_t nInternedSweepSize GUARDED_BY(cs_interned){INTERNED_MNS_MIN_SWEEP_SIZE};
+    // SYSCOIN light clients ask for diffs from the same base blocks again and again
+    Mutex cs_diff_cache;
+    unordered_lru_cache<std::pair<uint256, uint256>, std::shared_ptr<const std::vector<unsigned char>>, StaticSaltedHasher, DIFF_CACHE_SIZE> mnListDiffCache GUARDED_BY(cs_diff_cache);
+    std::atomic<bool> fDiffRequested{false};
+    // SYSCOIN write disk snapshots as deltas to the previous one where possible, see -evodbdeltasnapshots
+    const bool m_delta_snapshots;
+
+    bool WriteSnapshotDelta(const CBlockIndex* pindex, const CDeterministicMNList& list) EXCLUSIVE_LOCKS_REQUIRED(!cs);
+    // SYSCOIN signal the changes held back during IBD as a single diff to list
+    void NotifyHeldBackListChanges(const CDeterministicMNList& list) EXCLUSIVE_LOCKS_REQUIRED(!cs);
 public:
     struct EvoDBStats {
         int64_t approxPersistedEntries{0};
@@ -497,11 +626,21 @@ public:
         size_t cacheEntries{0};
         size_t eraseCacheEntries{0};
         std::string dbPath;
+        // SYSCOIN memory of the in-memory lists, shared nodes and masternodes counted once
+        size_t listsCacheEntries{0};
+        size_t listsCacheUsage{0};
+        // estimated memory of the write caches of the snapshot and diff databases
+        size_t snapshotCacheUsage{0};
+        size_t diffCacheUsage{0};
     };
+    // full lists, persisted once every DISK_SNAPSHOT_PERIOD blocks
     std::unique_ptr<CEvoDB<uint256, CDeterministicMNList, StaticSaltedHasher>> m_evoDb;
-    explicit CDeterministicMNManager(const DBParams& db_params)
-        : m_evoDb(std::make_unique<CEvoDB<uint256, CDeterministicMNList, StaticSaltedHasher>>(db_params, LIST_CACHE_SIZE)) {}
-       
+    // diffs to the list of the previous block for all other blocks
+    std::unique_ptr<CEvoDB<uint256, CDeterministicMNListDiff, StaticSaltedHasher>> m_evoDbDiffs;
+    // full lists written as deltas to the previous full list instead, read whether or not new ones are written
+    std::unique_ptr<CEvoDB<uint256, CDeterministicMNListSnapshotDelta, StaticSaltedHasher>> m_evoDbSnapshotDeltas;
+    explicit CDeterministicMNManager(const DBParams& db_params, bool fDeltaSnapshots = DEFAULT_EVODB_DELTA_SNAPSHOTS);
+
     ~CDeterministicMNManager() = default;
 
     bool ProcessBlock(const CBlock& block, const CBlockIndex* pindex, BlockValidationState& state,
@@ -509,6 +648,9 @@ public:
     bool UndoBlock(const CBlockIndex* pindex, CDeterministicMNListNEVMAddressDiff &inversedDiffNEVMAddress) EXCLUSIVE_LOCKS_REQUIRED(!cs, cs_main);
 
     // the returned list will not contain the correct block hash (we can't know it yet as the coinbase TX is not updated yet)
+    // SYSCOIN persist the list of pindex, in full every DISK_SNAPSHOT_PERIOD blocks and as the diff to the previous list otherwise.
+    // Returns false if the caches could not be flushed
+    bool WriteList(const CBlockIndex* pindex, const CDeterministicMNList& list, CDeterministicMNListDiff&& diff) EXCLUSIVE_LOCKS_REQUIRED(!cs);
     bool BuildNewListFromBlock(const CBlock& block, const CBlockIndex* pindexPrev, BlockValidationState& state, const CCoinsViewCache& view,
                                 CDeterministicMNList& mnListRet, CDeterministicMNList& mnOldListRet, const llmq::CFinalCommitmentTxPayload &qcTx) EXCLUSIVE_LOCKS_REQUIRED(!cs);
     void HandleQuorumCommitment(const llmq::CFinalCommitment& qc, const CBlockIndex* pQuorumBaseBlockIndex, CDeterministicMNList& mnList);
@@ -516,17 +658,27 @@ public:
 
     const CDeterministicMNList GetListForBlock(const CBlockIndex* pindex) EXCLUSIVE_LOCKS_REQUIRED(!cs);
     void GetListForBlock(const CBlockIndex* pindex, CDeterministicMNList& list);
-    const CDeterministicMNList GetListAtChainTip() EXCLUSIVE_LOCKS_REQUIRED(!cs);
+    const CDeterministicMNList GetListAtChainTip() EXCLUSIVE_LOCKS_REQUIRED(!cs_tip_list);
+    // SYSCOIN the published tip list, without copying it
+    std::shared_ptr<const CDeterministicMNList> GetListAtChainTipPtr() EXCLUSIVE_LOCKS_REQUIRED(!cs_tip_list);
 
     // Test if given TX is a ProRegTx which also contains the collateral at index n
     static bool IsProTxWithCollateral(const CTransactionRef& tx, uint32_t n);
     bool IsDIP3Enforced(int nHeight = -1) EXCLUSIVE_LOCKS_REQUIRED(!cs);
     bool FlushCacheToDisk(bool bForceFlush) EXCLUSIVE_LOCKS_REQUIRED(!cs);
     bool DoMaintenance(bool bForceFlush) EXCLUSIVE_LOCKS_REQUIRED(!cs);
-    void UpdatedBlockTip(const CBlockIndex* pindex) EXCLUSIVE_LOCKS_REQUIRED(!cs);
-    bool GetEvoDBStats(EvoDBStats& stats) EXCLUSIVE_LOCKS_REQUIRED(!cs);
+    void UpdatedBlockTip(const CBlockIndex* pindex) EXCLUSIVE_LOCKS_REQUIRED(!cs, !cs_tip_list, !cs_diff_cache);
+    // SYSCOIN the CDeterministicMNListDiff from the list of pindexFrom to the list of pindexTo, serialized for the network
+    std::shared_ptr<const std::vector<unsigned char>> GetListDiff(const CBlockIndex* pindexFrom, const CBlockIndex* pindexTo) EXCLUSIVE_LOCKS_REQUIRED(!cs, !cs_diff_cache);
+    bool GetEvoDBStats(EvoDBStats& stats) EXCLUSIVE_LOCKS_REQUIRED(!cs, !cs_tip_list);
+    // SYSCOIN fill the memory usage part of stats
+    void GetMemoryUsage(EvoDBStats& stats) EXCLUSIVE_LOCKS_REQUIRED(!cs, !cs_tip_list);
+    CDeterministicMNCPtr InternMN(CDeterministicMNCPtr&& dmn) EXCLUSIVE_LOCKS_REQUIRED(!cs_interned);
 private:
     const CDeterministicMNList GetListForBlockInternal(const CBlockIndex* pindex) EXCLUSIVE_LOCKS_REQUIRED(!cs);
+    bool HasListForBlock(const uint256& blockHash) EXCLUSIVE_LOCKS_REQUIRED(!cs);
+    bool GetCachedList(const uint256& blockHash, CDeterministicMNList& list) EXCLUSIVE_LOCKS_REQUIRED(cs);
+    void CacheList(const CDeterministicMNList& list, bool fKeepHistory) EXCLUSIVE_LOCKS_REQUIRED(cs);
 };
 extern int64_t DEFAULT_MAX_RECOVERED_SIGS_AGE; // keep them for a week
 extern std::unique_ptr<CDeterministicMNManager> deterministicMNManager;
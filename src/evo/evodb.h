@@ -8,56 +8,220 @@
 #include <dbwrapper.h>
 #include <sync.h>
 #include <uint256.h>
+#include <util/thread.h>
+#include <condition_variable>
+#include <thread>
 #include <unordered_map>
 #include <unordered_set>
 #include <list>
 #include <utility>
 #include <logging.h>
+#include <memusage.h>
 
+/** Heap memory owned by a cached value beyond its own size, overloaded for values that own more than that */
+template <typename V>
+size_t EvoDBHeapUsage(const V&) { return 0; }
+template <typename X>
+size_t EvoDBHeapUsage(const std::vector<X>& value) { return memusage::DynamicUsage(value); }
+
+/**
+ * A database with a write-back cache in front of it. The cache is bounded by an entry count
+ * and/or a memory budget per instance, and evicts the least recently used entry first.
+ */
 template <typename K, typename V, typename Hasher = std::hash<K>>
 class CEvoDB : public CDBWrapper {
     std::unordered_map<K, typename std::list<std::pair<K, V>>::iterator, Hasher> mapCache;
+    // least recently used entry first
     std::list<std::pair<K, V>> fifoList;
     std::unordered_set<K, Hasher> setEraseCache;
     size_t maxCacheSize{0};
+    size_t maxCacheBytes{0};
+    size_t nCacheUsage{0};
     DBParams m_db_params;
-    bool bFlushOnNextRead{false};
+    // SYSCOIN cache handed to the background writer by FlushCacheToDiskAsync. Reads keep consulting it
+    // (under cs) until it is on disk, it is only replaced while the writer is idle
+    std::unordered_map<K, V, Hasher> mapInFlight;
+    std::unordered_set<K, Hasher> setInFlightErase;
+    bool fInFlightWipe{false};
+    // SYSCOIN raw value of the last read from disk (under cs), kept so masternode lists are read without reallocating
+    std::string m_read_buffer;
+    Mutex m_writer_mutex;
+    std::condition_variable m_writer_cv;
+    // busy from the hand-off until the buffer is retired, pending once the buffer is filled
+    bool m_writer_busy GUARDED_BY(m_writer_mutex){false};
+    bool m_writer_pending GUARDED_BY(m_writer_mutex){false};
+    bool m_writer_stop GUARDED_BY(m_writer_mutex){false};
+    bool m_writer_failed GUARDED_BY(m_writer_mutex){false};
+    std::thread m_writer_thread;
+
+    static size_t EntryUsage(const V& value)
+    {
+        // the list and map nodes of the entry plus what the value owns
+        return memusage::MallocUsage(sizeof(std::pair<K, V>) + 2 * sizeof(void*)) +
+               memusage::MallocUsage(sizeof(std::pair<const K, typename std::list<std::pair<K, V>>::iterator>) + sizeof(void*)) +
+               EvoDBHeapUsage(value);
+    }
+
+    void EraseEntry(typename decltype(mapCache)::iterator it)
+    {
+        nCacheUsage -= EntryUsage(it->second->second);
+        fifoList.erase(it->second);
+        mapCache.erase(it);
+    }
+
+    template <typename T>
+    void InsertEntry(const K& key, T&& value)
+    {
+        auto it = mapCache.find(key);
+        if (it != mapCache.end()) EraseEntry(it);
+        fifoList.emplace_back(key, std::forward<T>(value));
+        mapCache[key] = --fifoList.end();
+        nCacheUsage += EntryUsage(fifoList.back().second);
+        setEraseCache.erase(key);
+
+        // always keep the entry just written
+        while (mapCache.size() > 1 && ((maxCacheSize > 0 && mapCache.size() > maxCacheSize) || (maxCacheBytes > 0 && nCacheUsage > maxCacheBytes))) {
+            EraseEntry(mapCache.find(fifoList.front().first));
+        }
+    }
+
+    bool WriteInFlight(std::size_t CHUNK_ITEMS = 256)
+    {
+        if (fInFlightWipe) {
+            LOCK(cs);
+            ResetDB();
+        }
+        // leveldb allows reads concurrent to the batch writes, cs is only needed to retire the buffer
+        CDBBatch batch(*this);
+        std::size_t items = 0;
+        auto flush = [&]() {
+            if (batch.SizeEstimate() == 0) return true;
+            if (!WriteBatch(batch, /*sync=*/true)) return false;
+            batch.Clear();
+            items = 0;
+            return true;
+        };
+        for (const auto& [key, value] : mapInFlight) {
+            batch.Write(key, value);
+            if (++items == CHUNK_ITEMS && !flush()) return false;
+        }
+        for (const auto& key : setInFlightErase) {
+            batch.Erase(key);
+            if (++items == CHUNK_ITEMS && !flush()) return false;
+        }
+        if (!flush()) return false;
+        LogPrint(BCLog::SYS, "Flushed %zu items to cache (%s) in the background%s\n",
+                mapInFlight.size() + setInFlightErase.size(), GetName().c_str(), fInFlightWipe ? " after wiping it" : "");
+        LOCK(cs);
+        mapInFlight.clear();
+        setInFlightErase.clear();
+        fInFlightWipe = false;
+        return true;
+    }
+
+    void ThreadWriter() EXCLUSIVE_LOCKS_REQUIRED(!m_writer_mutex)
+    {
+        while (true) {
+            {
+                WAIT_LOCK(m_writer_mutex, lock);
+                m_writer_cv.wait(lock, [this]() EXCLUSIVE_LOCKS_REQUIRED(m_writer_mutex) { return m_writer_stop || m_writer_pending; });
+                if (!m_writer_pending) return;
+            }
+            const bool fResult = WriteInFlight();
+            {
+                LOCK(m_writer_mutex);
+                m_writer_busy = false;
+                m_writer_pending = false;
+                if (!fResult) m_writer_failed = true;
+            }
+            m_writer_cv.notify_all();
+        }
+    }
+
 public:
     mutable RecursiveMutex cs;
     using CDBWrapper::CDBWrapper;
-    explicit CEvoDB(const DBParams &db_params, size_t maxCacheSizeIn) : CDBWrapper(db_params), maxCacheSize(maxCacheSizeIn), m_db_params(db_params) {
+    explicit CEvoDB(const DBParams &db_params, size_t maxCacheSizeIn, size_t maxCacheBytesIn = 0) : CDBWrapper(db_params), maxCacheSize(maxCacheSizeIn), maxCacheBytes(maxCacheBytesIn), m_db_params(db_params) {
     }
     ~CEvoDB() {
+        {
+            LOCK(m_writer_mutex);
+            m_writer_stop = true;
+        }
+        m_writer_cv.notify_all();
+        if (m_writer_thread.joinable()) m_writer_thread.join();
         FlushCacheToDisk();
     }
+    /** Block until a background flush handed off by FlushCacheToDiskAsync is on disk. Must not be called with cs held */
+    void WaitForFlush() EXCLUSIVE_LOCKS_REQUIRED(!m_writer_mutex) {
+        WAIT_LOCK(m_writer_mutex, lock);
+        m_writer_cv.wait(lock, [this]() EXCLUSIVE_LOCKS_REQUIRED(m_writer_mutex) { return !m_writer_busy; });
+    }
+    /**
+     * Hand the cache to the background writer and start over with an empty one, wiping the
+     * database first if fWipe. Waits for the previous background flush if it is still running,
+     * so must not be called with cs held. Returns false if a previous background flush failed.
+     */
+    bool FlushCacheToDiskAsync(bool fWipe = false) EXCLUSIVE_LOCKS_REQUIRED(!m_writer_mutex) {
+        {
+            WAIT_LOCK(m_writer_mutex, lock);
+            m_writer_cv.wait(lock, [this]() EXCLUSIVE_LOCKS_REQUIRED(m_writer_mutex) { return !m_writer_busy; });
+            m_writer_busy = true;
+        }
+        {
+            LOCK(cs);
+            if (mapCache.empty() && setEraseCache.empty() && !fWipe) {
+                LOCK(m_writer_mutex);
+                m_writer_busy = false;
+                m_writer_cv.notify_all();
+                return !m_writer_failed;
+            }
+            for (auto& [key, value] : fifoList) {
+                mapInFlight.emplace(key, std::move(value));
+            }
+            fifoList.clear();
+            mapCache.clear();
+            nCacheUsage = 0;
+            setInFlightErase = std::move(setEraseCache);
+            setEraseCache.clear();
+            fInFlightWipe = fWipe;
+        }
+        LOCK(m_writer_mutex);
+        if (!m_writer_thread.joinable()) {
+            m_writer_thread = std::thread(&util::TraceThread, "evodbflush", [this] { ThreadWriter(); });
+        }
+        m_writer_pending = true;
+        m_writer_cv.notify_all();
+        return !m_writer_failed;
+    }
     bool IsCacheFull() const {
         LOCK(cs);
-        return maxCacheSize > 0 && (mapCache.size()+setEraseCache.size()) >= maxCacheSize;
+        return (maxCacheSize > 0 && (mapCache.size()+setEraseCache.size()) >= maxCacheSize) ||
+               (maxCacheBytes > 0 && nCacheUsage >= maxCacheBytes);
     }
     DBParams GetDBParams() const {
         return m_db_params;
     }
     bool ReadCache(const K& key, V& value) {
         LOCK(cs);
-        if(bFlushOnNextRead) {
-            bFlushOnNextRead = false;
-            LogPrint(BCLog::SYS, "Evodb::ReadCache flushing cache before read\n");
-            FlushCacheToDisk();
-        }
+        // SYSCOIN newest first: the cache, then the buffer being written in the background, then disk
         auto it = mapCache.find(key);
         if (it != mapCache.end()) {
+            fifoList.splice(fifoList.end(), fifoList, it->second);
             value = it->second->second;
             return true;
         }
-        return Read(key, value);
+        if (setEraseCache.count(key)) return false;
+        auto itInFlight = mapInFlight.find(key);
+        if (itInFlight != mapInFlight.end()) {
+            value = itInFlight->second;
+            return true;
+        }
+        if (fInFlightWipe || setInFlightErase.count(key)) return false;
+        return Read(key, value, m_read_buffer);
     }
     std::unordered_map<K, V, Hasher> GetMapCacheCopy() {
         LOCK(cs);
-        if(bFlushOnNextRead) {
-            bFlushOnNextRead = false;
-            LogPrint(BCLog::SYS, "Evodb::ReadCache flushing cache before read\n");
-            FlushCacheToDisk();
-        }
         std::unordered_map<K, V, Hasher> cacheCopy;
         for (const auto& [key, it] : mapCache) {
             cacheCopy[key] = it->second;
@@ -70,6 +234,26 @@ public:
         return setEraseCache;
     }
 
+    /** Call f with every cached value */
+    template <typename F>
+    void ForEachCache(F&& f) const {
+        LOCK(cs);
+        for (const auto& entry : fifoList) {
+            f(entry.second);
+        }
+    }
+
+    /** Drop the cached values pred holds for, without writing them or erasing them from disk */
+    template <typename Pred>
+    void DropCacheIf(Pred&& pred) {
+        LOCK(cs);
+        for (auto it = fifoList.begin(); it != fifoList.end();) {
+            const auto next = std::next(it);
+            if (pred(it->second)) EraseEntry(mapCache.find(it->first));
+            it = next;
+        }
+    }
+
     void RestoreCaches(const std::unordered_map<K, V, Hasher>& mapCacheCopy, const std::unordered_set<K, Hasher>& eraseCacheCopy) {
         LOCK(cs);
         for (const auto& [key, value] : mapCacheCopy) {
@@ -80,63 +264,40 @@ public:
 
     void WriteCache(const K& key, V&& value) {
         LOCK(cs);
-        auto it = mapCache.find(key);
-        if (it != mapCache.end()) {
-            fifoList.erase(it->second);
-            mapCache.erase(it);
-        }
-        fifoList.emplace_back(key, std::move(value));
-        mapCache[key] = --fifoList.end();
-        setEraseCache.erase(key);
-
-        if (maxCacheSize > 0 && mapCache.size() > maxCacheSize) {
-            auto oldest = fifoList.front();
-            fifoList.pop_front();
-            mapCache.erase(oldest.first);
-        }
+        InsertEntry(key, std::move(value));
     }
 
     void WriteCache(const K& key, const V& value) {
         LOCK(cs);
-        auto it = mapCache.find(key);
-        if (it != mapCache.end()) {
-            fifoList.erase(it->second);
-            mapCache.erase(it);
-        }
-        fifoList.emplace_back(key, value);
-        mapCache[key] = --fifoList.end();
-        setEraseCache.erase(key);
+        InsertEntry(key, value);
+    }
 
-        if (maxCacheSize > 0 && mapCache.size() > maxCacheSize) {
-            auto oldest = fifoList.front();
-            fifoList.pop_front();
-            mapCache.erase(oldest.first);
-        }
+    /** Whether the key was written since the cache was last handed to disk, so it goes to disk in the same flush */
+    bool IsCached(const K& key) const {
+        LOCK(cs);
+        return mapCache.count(key) > 0;
     }
 
     bool ExistsCache(const K& key) {
         LOCK(cs);
-        if(bFlushOnNextRead) {
-            bFlushOnNextRead = false;
-            LogPrint(BCLog::SYS, "Evodb::ReadCache flushing cache before read\n");
-            FlushCacheToDisk();
-        }
-        return (mapCache.find(key) != mapCache.end() || Exists(key));
+        if (mapCache.find(key) != mapCache.end()) return true;
+        if (setEraseCache.count(key)) return false;
+        if (mapInFlight.find(key) != mapInFlight.end()) return true;
+        if (fInFlightWipe || setInFlightErase.count(key)) return false;
+        return Exists(key);
     }
 
     void EraseCache(const K& key) {
         LOCK(cs);
-        bFlushOnNextRead = true;
         auto it = mapCache.find(key);
-        if (it != mapCache.end()) {
-            fifoList.erase(it->second);
-            mapCache.erase(it);
-        }
+        if (it != mapCache.end()) EraseEntry(it);
         setEraseCache.insert(key);
     }
 
+    /** Write the cache synchronously, after a running background flush so writes stay ordered */
     bool FlushCacheToDisk(std::size_t CHUNK_ITEMS = 256)
     {
+        WaitForFlush();
         LOCK(cs);
         if (mapCache.empty() && setEraseCache.empty()) return true;
 
@@ -158,8 +319,7 @@ public:
             if (items == CHUNK_ITEMS || fifoList.size() == 1) {
                 if (!flush()) return false;
             }
-            mapCache.erase(fifoList.front().first);
-            fifoList.pop_front();
+            EraseEntry(mapCache.find(fifoList.front().first));
         }
 
         items = 0;
@@ -211,6 +371,10 @@ public:
         LOCK(cs);
         return mapCache.size();
     }
+    size_t GetCacheUsage() const {
+        LOCK(cs);
+        return nCacheUsage;
+    }
     size_t GetEraseCacheSize() {
         LOCK(cs);
         return setEraseCache.size();
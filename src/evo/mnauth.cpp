@@ -4,7 +4,9 @@
 
 #include <evo/mnauth.h>
 
+#include <bls/bls_worker.h>
 #include <evo/deterministicmns.h>
+#include <llmq/quorums_init.h>
 #include <llmq/quorums_utils.h>
 #include <masternode/activemasternode.h>
 #include <masternode/masternodemeta.h>
@@ -91,7 +93,8 @@ void CMNAuth::ProcessMessage(CNode* pnode, const std::string& strCommand, CDataS
         LogPrint(BCLog::NET_NETCONN, "CMNAuth::ProcessMessage -- invalid mnauth for protx=%s with sig=%s\n", mnauth.proRegTxHash.ToString(), mnauth.sig.ToString());
         return;
     }
-    auto mnList = deterministicMNManager->GetListAtChainTip();
+    const auto mnListPtr = deterministicMNManager->GetListAtChainTipPtr();
+    const auto& mnList = *mnListPtr;
     const auto dmn = mnList.GetMN(mnauth.proRegTxHash);
     if (!dmn) {
         // in case node was unlucky and not up to date, just let it be connected as a regular node, which gives it
@@ -116,10 +119,37 @@ void CMNAuth::ProcessMessage(CNode* pnode, const std::string& strCommand, CDataS
         signHash = ::SerializeHash(std::make_tuple(pubKey, pnode->GetSentMNAuthChallenge(), !pnode->IsInboundConn(), pnode->nVersion.load()));
     }
     LogPrint(BCLog::NET_NETCONN, "CMNAuth::%s -- constructed signHash for nVersion %d, peer=%d\n", __func__, pnode->nVersion, pnode->GetId());
-    if (!mnauth.sig.VerifyInsecure(dmn->pdmnState->pubKeyOperator.Get(), signHash, false)) {
-        // Same as above, MN seems to not know its fate yet, so give it a chance to update. If this is a
-        // malicious node (DoSing us), it'll get banned soon.
-        if(peer)
+
+    // SYSCOIN check the signature on the BLS worker, many quorum connections are opened at once after a rotation.
+    // Everything else this peer sent stays queued until the handshake is finished, the reference keeps the node alive.
+    pnode->m_mnauth_pending = true;
+    pnode->AddRef();
+    auto verify = [pnode, mnauth, dmn, signHash, &connman, &peerman]() {
+        const bool fValid = mnauth.sig.VerifyInsecure(dmn->pdmnState->pubKeyOperator.Get(), signHash, false);
+        if (!pnode->fDisconnect) {
+            FinishMNAUTH(pnode, mnauth, dmn, fValid, connman, peerman);
+        }
+        pnode->m_mnauth_pending = false;
+        pnode->Release();
+        connman.WakeMessageHandler();
+    };
+    if (llmq::blsWorker) {
+        llmq::blsWorker->AsyncRun(std::move(verify));
+    } else {
+        verify();
+    }
+}
+
+void CMNAuth::FinishMNAUTH(CNode* pnode, const CMNAuth& mnauth, const CDeterministicMNCPtr& dmn, bool fValid, CConnman& connman, PeerManager& peerman)
+{
+    // two connections of the same masternode finishing at once must not both pass the duplicate check below
+    static Mutex cs_finish;
+    LOCK(cs_finish);
+
+    if (!fValid) {
+        // Same as for a missing masternode, MN seems to not know its fate yet, so give it a chance to update.
+        // If this is a malicious node (DoSing us), it'll get banned soon.
+        if (PeerRef peer = peerman.GetPeerRef(pnode->GetId()))
             peerman.Misbehaving(*peer, 10, "mnauth signature verification failed");
         return;
     }
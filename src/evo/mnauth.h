@@ -8,9 +8,12 @@
 #include <bls/bls.h>
 #include <serialize.h>
 
+#include <memory>
+
 class CConnman;
 class CDataStream;
 class CDeterministicMN;
+using CDeterministicMNCPtr = std::shared_ptr<const CDeterministicMN>;
 class CDeterministicMNList;
 class CDeterministicMNListDiff;
 class CNode;
@@ -51,6 +54,10 @@ public:
     static void PushMNAUTH(CNode* pnode, CConnman& connman, const int nHeight);
     static void ProcessMessage(CNode* pnode, const std::string& strCommand, CDataStream& vRecv, ChainstateManager &chainman, CConnman& connman, PeerManager& peerman);
     static void NotifyMasternodeListChanged(bool undo, const CDeterministicMNList& oldMNList, const CDeterministicMNListDiff& diff, CConnman& connman);
+
+private:
+    /** Second half of ProcessMessage, run once the BLS worker checked the signature */
+    static void FinishMNAUTH(CNode* pnode, const CMNAuth& mnauth, const CDeterministicMNCPtr& dmn, bool fValid, CConnman& connman, PeerManager& peerman);
 };
 
 
@@ -295,9 +295,16 @@ public:
 };
 
 
+// SYSCOIN a BLS payload signature left for the caller to verify, possibly batched with others
+struct CProTxBLSSigCheck {
+    CBLSSignature sig;
+    CBLSPublicKey pubKey;
+    uint256 msgHash;
+};
+
 bool CheckProRegTx(const CTransaction& tx, const CBlockIndex* pindexPrev, TxValidationState& state, CCoinsViewCache& view, bool fJustCheck, bool check_sigs) EXCLUSIVE_LOCKS_REQUIRED(::cs_main);
-bool CheckProUpServTx(const CTransaction& tx, const CBlockIndex* pindexPrev, TxValidationState& state, bool fJustCheck, bool check_sigs) EXCLUSIVE_LOCKS_REQUIRED(::cs_main);
+bool CheckProUpServTx(const CTransaction& tx, const CBlockIndex* pindexPrev, TxValidationState& state, bool fJustCheck, bool check_sigs, std::vector<CProTxBLSSigCheck>* pendingSigChecks = nullptr) EXCLUSIVE_LOCKS_REQUIRED(::cs_main);
 bool CheckProUpRegTx(const CTransaction& tx, const CBlockIndex* pindexPrev, TxValidationState& state, CCoinsViewCache& view, bool fJustCheck, bool check_sigs) EXCLUSIVE_LOCKS_REQUIRED(::cs_main);
-bool CheckProUpRevTx(const CTransaction& tx, const CBlockIndex* pindexPrev, TxValidationState& state, bool fJustCheck, bool check_sigs) EXCLUSIVE_LOCKS_REQUIRED(::cs_main);
+bool CheckProUpRevTx(const CTransaction& tx, const CBlockIndex* pindexPrev, TxValidationState& state, bool fJustCheck, bool check_sigs, std::vector<CProTxBLSSigCheck>* pendingSigChecks = nullptr) EXCLUSIVE_LOCKS_REQUIRED(::cs_main);
 
 #endif // SYSCOIN_EVO_PROVIDERTX_H
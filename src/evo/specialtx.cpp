@@ -10,14 +10,17 @@
 #include <validation.h>
 
 #include <evo/deterministicmns.h>
+#include <evo/providertx.h>
 #include <evo/specialtx.h>
 #include <util/time.h>
 #include <llmq/quorums_commitment.h>
 #include <llmq/quorums_blockprocessor.h>
+#include <llmq/quorums_init.h>
+#include <bls/bls_worker.h>
 #include <logging.h>
 #include <governance/governance.h>
 class CCoinsViewCache;
-bool CheckSpecialTx(node::BlockManager &blockman, const CTransaction& tx, const CBlockIndex* pindexPrev, TxValidationState& state, CCoinsViewCache& view, bool fJustCheck, bool check_sigs)
+bool CheckSpecialTx(node::BlockManager &blockman, const CTransaction& tx, const CBlockIndex* pindexPrev, TxValidationState& state, CCoinsViewCache& view, bool fJustCheck, bool check_sigs, std::vector<CProTxBLSSigCheck>* pendingSigChecks)
 {
 
     try {
@@ -25,11 +28,11 @@ bool CheckSpecialTx(node::BlockManager &blockman, const CTransaction& tx, const
         case SYSCOIN_TX_VERSION_MN_REGISTER:
             return CheckProRegTx(tx, pindexPrev, state, view, fJustCheck, check_sigs);
         case SYSCOIN_TX_VERSION_MN_UPDATE_SERVICE:
-            return CheckProUpServTx(tx, pindexPrev, state, fJustCheck, check_sigs);
+            return CheckProUpServTx(tx, pindexPrev, state, fJustCheck, check_sigs, pendingSigChecks);
         case SYSCOIN_TX_VERSION_MN_UPDATE_REGISTRAR:
             return CheckProUpRegTx(tx, pindexPrev, state, view, fJustCheck, check_sigs);
         case SYSCOIN_TX_VERSION_MN_UPDATE_REVOKE:
-            return CheckProUpRevTx(tx, pindexPrev, state, fJustCheck, check_sigs);
+            return CheckProUpRevTx(tx, pindexPrev, state, fJustCheck, check_sigs, pendingSigChecks);
         default:
             return true;
         }
@@ -50,12 +53,36 @@ bool ProcessSpecialTxsInBlock(ChainstateManager &chainman, const CBlock& block,
 
         auto nTime1 = SystemClock::now();
         llmq::CFinalCommitmentTxPayload qcTx;
+        // SYSCOIN BLS payload signatures don't depend on the list state, they are collected and verified
+        // in batches on the BLS worker threads after the checks that do
+        std::vector<CProTxBLSSigCheck> pendingSigChecks;
+        const bool fDeferSigChecks = check_sigs && llmq::blsWorker && llmq::blsWorker->IsRunning();
         for (const auto& ptr_tx : block.vtx) {
             TxValidationState txstate;
-            if (!CheckSpecialTx(chainman.m_blockman, *ptr_tx, pindex->pprev, txstate, view, false, check_sigs)) {
+            if (!CheckSpecialTx(chainman.m_blockman, *ptr_tx, pindex->pprev, txstate, view, false, check_sigs, fDeferSigChecks ? &pendingSigChecks : nullptr)) {
                 return state.Invalid(BlockValidationResult::BLOCK_CONSENSUS, txstate.GetRejectReason());
             }
         }
+        if (!pendingSigChecks.empty()) {
+            std::vector<std::future<bool>> sigFutures;
+            sigFutures.reserve(pendingSigChecks.size());
+            for (const auto& sigCheck : pendingSigChecks) {
+                sigFutures.emplace_back(llmq::blsWorker->AsyncVerifySig(sigCheck.sig, sigCheck.pubKey, sigCheck.msgHash));
+            }
+            bool fSigsValid{true};
+            for (size_t i = 0; i < sigFutures.size(); ++i) {
+                try {
+                    fSigsValid &= sigFutures[i].get();
+                } catch (const std::future_error&) {
+                    // the worker was stopped before it got to the signature, that says nothing about the block
+                    const auto& sigCheck = pendingSigChecks[i];
+                    fSigsValid &= sigCheck.sig.VerifyInsecure(sigCheck.pubKey, sigCheck.msgHash);
+                }
+            }
+            if (!fSigsValid) {
+                return state.Invalid(BlockValidationResult::BLOCK_CONSENSUS, "bad-protx-bls-sig");
+            }
+        }
 
         auto nTime2 = SystemClock::now(); nTimeLoop += nTime2 - nTime1;
         LogPrint(BCLog::BENCHMARK, "        - Loop: %.2fms [%.2fs]\n",  Ticks<MillisecondsDouble>(nTime2 - nTime1), Ticks<SecondsDouble>(nTimeLoop));
@@ -16,10 +16,11 @@ class BlockValidationState;
 class CCoinsViewCache;
 class ChainstateManager;
 class CDeterministicMNListNEVMAddressDiff;
+struct CProTxBLSSigCheck;
 namespace node {
 class BlockManager;
 }
-bool CheckSpecialTx(node::BlockManager &blockman, const CTransaction& tx, const CBlockIndex* pindexPrev, TxValidationState& state, CCoinsViewCache& view, bool fJustCheck, bool check_sigs) EXCLUSIVE_LOCKS_REQUIRED(::cs_main);
+bool CheckSpecialTx(node::BlockManager &blockman, const CTransaction& tx, const CBlockIndex* pindexPrev, TxValidationState& state, CCoinsViewCache& view, bool fJustCheck, bool check_sigs, std::vector<CProTxBLSSigCheck>* pendingSigChecks = nullptr) EXCLUSIVE_LOCKS_REQUIRED(::cs_main);
 bool ProcessSpecialTxsInBlock(ChainstateManager &chainman, const CBlock& block, const CBlockIndex* pindex, BlockValidationState& state, CDeterministicMNListNEVMAddressDiff &diff, CCoinsViewCache& view, bool fJustCheck, bool check_sigs, bool ibd) EXCLUSIVE_LOCKS_REQUIRED(::cs_main);
 bool UndoSpecialTxsInBlock(const CBlock& block, const CBlockIndex* pindex, CDeterministicMNListNEVMAddressDiff& diffNEVM, bool bReverify, bool bReplay) EXCLUSIVE_LOCKS_REQUIRED(::cs_main);
 
@@ -7,14 +7,72 @@
 
 #include <clientversion.h>
 #include <chainparams.h>
+#include <crypto/common.h>
 #include <util/fs.h>
+#include <util/fs_helpers.h>
 #include <hash.h>
 #include <streams.h>
 #include <common/args.h>
 #include <logging.h>
+
+#include <type_traits>
+#include <utility>
+// SYSCOIN
+/** Byte following the header of a record framed file. Legacy files continue with the compact size of a string or
+ *  map there, which never starts with 0xff for a cache. */
+static constexpr uint8_t FLATDB_RECORDS_MARKER{0xff};
+/** Records larger than this are taken for a damaged size frame */
+static constexpr uint32_t MAX_FLATDB_RECORD_SIZE{64 * 1024 * 1024};
+
+/** Checksum of a record, the first four bytes of its double SHA256 like the one of a P2P message */
+template<typename T>
+uint32_t FlatDBChecksum(const T& data)
+{
+    return ReadLE32(Hash(data).begin());
+}
+
+/** Writes records of a flat database file, each framed by its size and followed by its checksum */
+class CFlatDBRecordWriter
+{
+private:
+    CAutoFile& m_file;
+    size_t m_records{0};
+
+public:
+    explicit CFlatDBRecordWriter(CAutoFile& file) : m_file{file} {}
+
+    template<typename... Args>
+    void Write(const Args&... args)
+    {
+        CDataStream ssRecord(SER_DISK, CLIENT_VERSION);
+        (ssRecord << ... << args);
+        if (ssRecord.empty() || ssRecord.size() > MAX_FLATDB_RECORD_SIZE) {
+            throw std::ios_base::failure(strprintf("Invalid record size %u", ssRecord.size()));
+        }
+        m_file << uint32_t(ssRecord.size());
+        m_file.write(MakeByteSpan(ssRecord));
+        m_file << FlatDBChecksum(ssRecord);
+        ++m_records;
+    }
+
+    size_t GetRecords() const { return m_records; }
+};
+
+/** Whether T is stored as records (SerializeRecords/UnserializeRecord), otherwise it is only read from legacy files */
+template<typename T, typename = void>
+struct FlatDBHasRecords : std::false_type {};
+template<typename T>
+struct FlatDBHasRecords<T, std::void_t<decltype(std::declval<T&>().UnserializeRecord(std::declval<CDataStream&>()))>> : std::true_type {};
+
 /**
 *   Generic Dumping and Loading
 *   ---------------------------
+*
+*   Files start with a header (magic message, network magic number and FLATDB_RECORDS_MARKER) followed by the
+*   records T writes through CFlatDBRecordWriter in SerializeRecords and ends with an empty record. Records are
+*   read and checked one at a time and passed to T::UnserializeRecord, so loading only holds one record in memory
+*   and a damaged record, or a damaged tail, only loses those records. The first record is expected to carry the
+*   version of T, if it has one, and must be intact. Files of older versions, checksummed as a whole, are still read.
 */
 
 template<typename T>
@@ -42,46 +100,178 @@ private:
 
         int64_t nStart = TicksSinceEpoch<std::chrono::milliseconds>(SystemClock::now());
 
-        // serialize, checksum data up to that point, then append checksum
-        CDataStream ssObj(SER_DISK, CLIENT_VERSION);
-        ssObj << strMagicMessage; // specific magic message for this type of object
-        ssObj << Params().MessageStart(); // network specific magic number
-        ssObj << objToSave;
-        uint256 hash = Hash(ssObj);
-        ssObj << hash;
-
-        // open output file, and associate with CAutoFile
-        FILE *file = fopen(pathDB.u8string().c_str(), "wb");
+        // SYSCOIN records are streamed to a temporary file that replaces the database once complete
+        const fs::path pathTmp = pathDB + ".new";
+        FILE *file = fsbridge::fopen(pathTmp, "wb");
         CAutoFile fileout(file, CLIENT_VERSION);
         if (fileout.IsNull())
-            return error("%s: Failed to open file %s", __func__, pathDB.u8string());
+            return error("%s: Failed to open file %s", __func__, fs::PathToString(pathTmp));
 
-        // Write and commit header, data
+        size_t nRecords{0};
         try {
-            fileout << ssObj;
+            fileout << strMagicMessage; // specific magic message for this type of object
+            fileout << Params().MessageStart(); // network specific magic number
+            fileout << FLATDB_RECORDS_MARKER;
+            CFlatDBRecordWriter writer(fileout);
+            objToSave.SerializeRecords(writer);
+            fileout << uint32_t{0};
+            nRecords = writer.GetRecords();
         }
         catch (std::exception &e) {
+            fileout.fclose();
+            fs::remove(pathTmp);
             return error("%s: Serialize or I/O error - %s", __func__, e.what());
         }
+        if (!FileCommit(fileout.Get())) {
+            fileout.fclose();
+            fs::remove(pathTmp);
+            return error("%s: Failed to flush file %s", __func__, fs::PathToString(pathTmp));
+        }
         fileout.fclose();
+        if (!RenameOver(pathTmp, pathDB)) {
+            fs::remove(pathTmp);
+            return error("%s: Rename-into-place failed", __func__);
+        }
 
-        LogPrintf("Written info to %s  %dms\n", strFilename, TicksSinceEpoch<std::chrono::milliseconds>(SystemClock::now()) - nStart);
+        LogPrintf("Written %u records to %s  %dms\n", nRecords, strFilename, TicksSinceEpoch<std::chrono::milliseconds>(SystemClock::now()) - nStart);
         LogPrintf("     %s\n", objToSave.ToString());
 
         return true;
     }
 
+    /** Read and verify the header, fRecords tells whether the file is record framed or a legacy one */
+    ReadResult ReadHeader(CAutoFile& filein, bool& fRecords)
+    {
+        MessageStartChars pchMsgTmp;
+        std::string strMagicMessageTmp;
+        uint8_t nMarker;
+        try {
+            // de-serialize file header (file specific magic message) and ..
+            filein >> strMagicMessageTmp;
+
+            // ... verify the message matches predefined one
+            if (strMagicMessage != strMagicMessageTmp)
+            {
+                error("%s: Invalid magic message", __func__);
+                return IncorrectMagicMessage;
+            }
+
+            // de-serialize file header (network specific magic number) and ..
+            filein >> pchMsgTmp;
+
+            // ... verify the network matches ours
+            if (pchMsgTmp != Params().MessageStart())
+            {
+                error("%s: Invalid network magic number", __func__);
+                return IncorrectMagicNumber;
+            }
+
+            filein >> nMarker;
+        }
+        catch (std::exception &e) {
+            error("%s: Deserialize or I/O error - %s", __func__, e.what());
+            return HashReadError;
+        }
+        fRecords = nMarker == FLATDB_RECORDS_MARKER;
+        return Ok;
+    }
+
     ReadResult CoreRead(T& objToLoad)
     {
         //LOCK(objToLoad.cs);
 
         int64_t nStart = TicksSinceEpoch<std::chrono::milliseconds>(SystemClock::now());
         // open input file, and associate with CAutoFile
-        FILE *file = fopen(pathDB.u8string().c_str(), "rb");
+        FILE *file = fsbridge::fopen(pathDB, "rb");
         CAutoFile filein(file, CLIENT_VERSION);
         if (filein.IsNull())
         {
-            error("%s: Failed to open file %s", __func__, pathDB.u8string());
+            error("%s: Failed to open file %s", __func__, fs::PathToString(pathDB));
+            return FileError;
+        }
+
+        bool fRecords{false};
+        if (const ReadResult result{ReadHeader(filein, fRecords)}; result != Ok) {
+            return result;
+        }
+        if (!fRecords) {
+            filein.fclose();
+            return CoreReadLegacy(objToLoad);
+        }
+        if constexpr (!FlatDBHasRecords<T>::value) {
+            error("%s: %s is only read from files of older versions", __func__, strFilename);
+            return IncorrectFormat;
+        } else {
+            objToLoad.Clear();
+            size_t nRecords{0};
+            size_t nDamaged{0};
+            bool fComplete{false};
+            std::vector<unsigned char> vchRecord;
+            try {
+                while (true) {
+                    uint32_t nSize;
+                    uint32_t nChecksum;
+                    filein >> nSize;
+                    if (nSize == 0) {
+                        fComplete = true;
+                        break;
+                    }
+                    // the records after a damaged size cannot be found
+                    if (nSize > MAX_FLATDB_RECORD_SIZE) break;
+                    vchRecord.resize(nSize);
+                    filein.read(MakeWritableByteSpan(vchRecord));
+                    filein >> nChecksum;
+                    bool fValid{FlatDBChecksum(vchRecord) == nChecksum};
+                    if (fValid) {
+                        CDataStream ssRecord(vchRecord, SER_DISK, CLIENT_VERSION);
+                        try {
+                            if (!objToLoad.UnserializeRecord(ssRecord)) {
+                                objToLoad.Clear();
+                                error("%s: Unknown version of the records", __func__);
+                                return IncorrectFormat;
+                            }
+                        }
+                        catch (const std::exception&) {
+                            fValid = false;
+                        }
+                    }
+                    if (!fValid && nRecords + nDamaged == 0) {
+                        // without the version record none of the others can be trusted
+                        objToLoad.Clear();
+                        error("%s: Checksum mismatch, first record corrupted", __func__);
+                        return IncorrectHash;
+                    }
+                    if (fValid) {
+                        ++nRecords;
+                    } else {
+                        ++nDamaged;
+                    }
+                }
+            }
+            catch (const std::exception&) {
+                // a truncated file keeps the records read so far
+            }
+            if (nDamaged > 0 || !fComplete) {
+                LogPrintf("%s: %u damaged records skipped%s\n", strFilename, nDamaged, fComplete ? "" : ", file is truncated");
+            }
+
+            LogPrintf("Loaded %u records from %s  %dms\n", nRecords, strFilename, TicksSinceEpoch<std::chrono::milliseconds>(SystemClock::now()) - nStart);
+            LogPrintf("     %s\n", objToLoad.ToString());
+
+            return Ok;
+        }
+    }
+
+    /** Read a file written by an older version, a single object followed by the hash of the whole file */
+    ReadResult CoreReadLegacy(T& objToLoad)
+    {
+        int64_t nStart = TicksSinceEpoch<std::chrono::milliseconds>(SystemClock::now());
+        // open input file, and associate with CAutoFile
+        FILE *file = fsbridge::fopen(pathDB, "rb");
+        CAutoFile filein(file, CLIENT_VERSION);
+        if (filein.IsNull())
+        {
+            error("%s: Failed to open file %s", __func__, fs::PathToString(pathDB));
             return FileError;
         }
 
@@ -116,30 +306,11 @@ private:
             return IncorrectHash;
         }
 
-
-        MessageStartChars pchMsgTmp;
-        std::string strMagicMessageTmp;
         try {
-            // de-serialize file header (file specific magic message) and ..
-            ssObj >> strMagicMessageTmp;
-
-            // ... verify the message matches predefined one
-            if (strMagicMessage != strMagicMessageTmp)
-            {
-                error("%s: Invalid magic message", __func__);
-                return IncorrectMagicMessage;
-            }
-
-
-            // de-serialize file header (network specific magic number) and ..
-            ssObj >> pchMsgTmp;
-
-            // ... verify the network matches ours
-            if (pchMsgTmp != Params().MessageStart())
-            {
-                error("%s: Invalid network magic number", __func__);
-                return IncorrectMagicNumber;
-            }
+            // the header was verified by ReadHeader already
+            std::string strMagicMessageTmp;
+            MessageStartChars pchMsgTmp;
+            ssObj >> strMagicMessageTmp >> pchMsgTmp;
 
             // de-serialize data into T object
             ssObj >> objToLoad;
@@ -158,7 +329,11 @@ private:
 
     bool Read(T& objToLoad)
     {
-        ReadResult readResult = CoreRead(objToLoad);
+        return CheckReadResult(CoreRead(objToLoad));
+    }
+
+    bool CheckReadResult(ReadResult readResult)
+    {
         if (readResult == FileError)
             LogPrintf("Missing file %s, will try to recreate\n", strFilename);
         else if (readResult != Ok)
@@ -194,8 +369,14 @@ public:
     bool Store(T& objToSave)
     {
         LogPrintf("Verifying %s format...\n", strFilename);
-        T tmpObjToLoad;
-        if (!Read(tmpObjToLoad)) return false;
+        // SYSCOIN only the header, a file of another type or network is not overwritten
+        FILE *file = fsbridge::fopen(pathDB, "rb");
+        CAutoFile filein(file, CLIENT_VERSION);
+        if (!filein.IsNull()) {
+            bool fRecords;
+            if (!CheckReadResult(ReadHeader(filein, fRecords))) return false;
+        }
+        filein.fclose();
 
         int64_t nStart = TicksSinceEpoch<std::chrono::milliseconds>(SystemClock::now());
 
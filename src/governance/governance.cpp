@@ -4,6 +4,8 @@
 
 #include <governance/governance.h>
 
+#include <bls/bls_batchverifier.h>
+#include <bls/bls_worker.h>
 #include <common/bloom.h>
 #include <chain.h>
 #include <chainparams.h>
@@ -13,10 +15,12 @@
 #include <flatdatabase.h>
 #include <governance/governanceclasses.h>
 #include <governance/governancecommon.h>
+#include <governance/governancedb.h>
 #include <governance/governancevalidators.h>
-#include <masternode/masternodemeta.h>
+#include <llmq/quorums_init.h>
 #include <masternode/activemasternode.h>
 #include <masternode/masternodesync.h>
+#include <memusage.h>
 #include <net_processing.h>
 #include <netfulfilledman.h>
 #include <netmessagemaker.h>
@@ -24,11 +28,24 @@
 #include <shutdown.h>
 #include <spork.h>
 #include <util/time.h>
+#include <util/trace.h>
 #include <validation.h>
 #include <timedata.h>
 std::unique_ptr<CGovernanceManager> governance;
 int nSubmittedFinalBudget;
 
+namespace {
+/** Meta record of the governance db, see GovernanceStore::SerializeMeta */
+struct GovernanceMeta {
+    GovernanceStore& store;
+
+    template <typename Stream>
+    void Serialize(Stream& s) const { store.SerializeMeta(s); }
+    template <typename Stream>
+    void Unserialize(Stream& s) { store.UnserializeMeta(s); }
+};
+} // namespace
+
 const std::string GovernanceStore::SERIALIZATION_VERSION_STRING = "CGovernanceManager-Version-16";
 const int CGovernanceManager::MAX_TIME_FUTURE_DEVIATION = 60 * 60;
 const int CGovernanceManager::RELIABLE_PROPAGATION_TIME = 60;
@@ -47,7 +64,7 @@ GovernanceStore::GovernanceStore() :
 
 CGovernanceManager::CGovernanceManager(ChainstateManager& _chainman) :
     chainman(_chainman),
-    m_db{std::make_unique<db_type>("governance.dat", "magicGovernanceCache")},
+    m_db{std::make_unique<CGovernanceDB>(DBParams{.path = chainman.m_options.datadir / "governance", .cache_bytes = static_cast<size_t>(1 << 20), .wipe_data = chainman.m_options.reindex})},
     nTimeLastDiff(0),
     nCachedBlockHeight(0),
     setRequestedObjects(),
@@ -61,20 +78,131 @@ CGovernanceManager::CGovernanceManager(ChainstateManager& _chainman) :
 CGovernanceManager::~CGovernanceManager()
 {
     if (!is_valid) return;
-    m_db->Store(*this);
+    FlushToDb(/*fSync=*/true);
 }
 
 bool CGovernanceManager::LoadCache(bool load_cache)
 {
     assert(m_db != nullptr);
-    is_valid = load_cache ? m_db->Load(*this) : m_db->Store(*this);
-    if (is_valid && load_cache) {
+    if (!load_cache) {
+        m_db->Wipe();
+        is_valid = true;
+        return is_valid;
+    }
+    is_valid = m_db->HasMeta() ? LoadFromDb() : MigrateFlatFile();
+    if (is_valid) {
         CheckAndRemove();
         InitOnLoad();
     }
     return is_valid;
 }
 
+bool CGovernanceManager::LoadFromDb()
+{
+    Clear();
+
+    LOCK(cs);
+    const int64_t nStart = TicksSinceEpoch<std::chrono::milliseconds>(SystemClock::now());
+    GovernanceMeta meta{*this};
+    if (!m_db->ReadMeta(meta)) {
+        LogPrintf("CGovernanceManager::%s -- governance db has an unknown format, starting over\n", __func__);
+        Clear();
+        m_db->Wipe();
+        return true;
+    }
+
+    m_db->ForEachObject([&](CGovernanceObject&& govobj) EXCLUSIVE_LOCKS_REQUIRED(cs) {
+        const uint256 nHash = govobj.GetHash();
+        mapStoredObjectStates.emplace(nHash, std::make_pair(govobj.GetDeletionTime(), govobj.IsSetExpired()));
+        mapObjects.try_emplace(nHash, govobj);
+    });
+
+    // votes are not assignable, so they are sorted as a list
+    std::map<uint256, std::list<CGovernanceVote>> mapVotes;
+    m_db->ForEachVote([&](const CGovernanceVote& vote) {
+        mapVotes[vote.GetParentHash()].emplace_back(vote);
+    });
+
+    // replay the votes of each object in the order they were cast. Votes replaced by a newer one and votes of
+    // objects that are gone are dropped by the replay and their records compacted away here
+    size_t nVotes{0};
+    size_t nStaleVotes{0};
+    for (auto& [nParentHash, votes] : mapVotes) {
+        votes.sort([](const CGovernanceVote& a, const CGovernanceVote& b) {
+            return std::make_pair(a.GetTimestamp(), a.GetOutcome()) < std::make_pair(b.GetTimestamp(), b.GetOutcome());
+        });
+        auto it = mapObjects.find(nParentHash);
+        if (it != mapObjects.end()) {
+            for (const auto& vote : votes) {
+                it->second.LoadVote(vote);
+            }
+        }
+        for (const auto& vote : votes) {
+            if (it != mapObjects.end() && it->second.GetVoteFile().HasVote(vote.GetHash())) {
+                nVotes++;
+            } else {
+                m_db->EraseVote(nParentHash, vote.GetHash());
+                nStaleVotes++;
+            }
+        }
+    }
+
+    LogPrintf("Loaded %d governance objects and %d votes from the governance db, dropped %d stale votes  %dms\n",
+              mapObjects.size(), nVotes, nStaleVotes, TicksSinceEpoch<std::chrono::milliseconds>(SystemClock::now()) - nStart);
+    return true;
+}
+
+bool CGovernanceManager::MigrateFlatFile()
+{
+    // the governance.dat of older versions is moved over to the db once and left in place
+    if (fs::exists(gArgs.GetDataDirNet() / "governance.dat")) {
+        db_type flatdb("governance.dat", "magicGovernanceCache");
+        if (!flatdb.Load(*this)) {
+            return false;
+        }
+    }
+
+    LOCK(cs);
+    for (const auto& [_, govobj] : mapObjects) {
+        StoreObject(govobj);
+        for (const auto& vote : govobj.GetVoteFile().GetVotes()) {
+            m_db->WriteVote(vote);
+        }
+    }
+    FlushToDb(/*fSync=*/true);
+    return true;
+}
+
+void CGovernanceManager::StoreObject(const CGovernanceObject& govobj)
+{
+    AssertLockHeld(cs);
+    m_db->WriteObject(govobj);
+    mapStoredObjectStates[govobj.GetHash()] = std::make_pair(govobj.GetDeletionTime(), govobj.IsSetExpired());
+}
+
+void CGovernanceManager::EraseStoredObject(const uint256& nHash)
+{
+    AssertLockHeld(cs);
+    m_db->EraseObject(nHash);
+    mapStoredObjectStates.erase(nHash);
+}
+
+void CGovernanceManager::FlushToDb(bool fSync)
+{
+    LOCK(cs);
+    // objects and votes are written as they are accepted, only the objects marked for deletion or expired since
+    // and the meta record are left to write
+    for (const auto& [nHash, govobj] : mapObjects) {
+        const auto it = mapStoredObjectStates.find(nHash);
+        if (it == mapStoredObjectStates.end() || it->second != std::make_pair(govobj.GetDeletionTime(), govobj.IsSetExpired())) {
+            StoreObject(govobj);
+        }
+    }
+    if (!m_db->WriteMeta(GovernanceMeta{*this}, fSync)) {
+        LogPrintf("CGovernanceManager::%s -- failed to write the governance db\n", __func__);
+    }
+}
+
 // Accessors for thread-safe access to maps
 bool CGovernanceManager::HaveObjectForHash(const uint256& nHash) const
 {
@@ -109,19 +237,56 @@ int CGovernanceManager::GetVoteCount() const
     return (int)cmapVoteToObject.GetSize();
 }
 
+size_t CGovernanceManager::DynamicMemoryUsage() const
+{
+    LOCK(cs);
+    size_t usage = memusage::DynamicUsage(mapObjects) + memusage::DynamicUsage(mapPostponedObjects) +
+                   memusage::DynamicUsage(mapErasedGovernanceObjects) + memusage::DynamicUsage(mapLastMasternodeObject) +
+                   memusage::DynamicUsage(mapStoredObjectStates) + memusage::DynamicUsage(mapVoteRefsByObject) +
+                   memusage::DynamicUsage(mapObjectsByVoter) + memusage::DynamicUsage(mapProposalEndEpochs) +
+                   memusage::DynamicUsage(mapTrigger) + cmapVoteToObject.DynamicMemoryUsage() +
+                   cmapInvalidVotes.DynamicMemoryUsage() + cmmapOrphanVotes.DynamicMemoryUsage();
+    for (const auto& [hash, govobj] : mapObjects) {
+        usage += govobj.DynamicMemoryUsage();
+    }
+    for (const auto& [hash, govobj] : mapPostponedObjects) {
+        usage += govobj.DynamicMemoryUsage();
+    }
+    for (const auto& [hash, voteHashes] : mapVoteRefsByObject) {
+        usage += memusage::DynamicUsage(voteHashes);
+    }
+    for (const auto& [outpoint, objectHashes] : mapObjectsByVoter) {
+        usage += memusage::DynamicUsage(objectHashes);
+    }
+    return usage;
+}
+
 bool CGovernanceManager::SerializeVoteForHash(const uint256& nHash, CDataStream& ss) const
 {
     LOCK(cs);
 
     CGovernanceObject* pGovobj = nullptr;
-    return cmapVoteToObject.Get(nHash, pGovobj) && pGovobj->GetVoteFile().SerializeVoteToStream(nHash, ss);
+    if (!cmapVoteToObject.Get(nHash, pGovobj)) {
+        return false;
+    }
+    if (pGovobj->GetVoteFile().SerializeVoteToStream(nHash, ss)) {
+        return true;
+    }
+    // SYSCOIN the signature was dropped from memory, the stored vote still has it
+    CGovernanceVote vote;
+    if (!pGovobj->GetVoteFile().HasVote(nHash) || !m_db->ReadVote(pGovobj->GetHash(), nHash, vote)) {
+        return false;
+    }
+    ss << vote;
+    return true;
 }
 
 void CGovernanceManager::ProcessMessage(CNode* pfrom, const std::string& strCommand, CDataStream& vRecv, CConnman& connman, PeerManager& peerman)
 {
     if (!IsValid()) return;
     if (!masternodeSync.IsBlockchainSynced()) return;
-    const auto tip_mn_list = deterministicMNManager->GetListAtChainTip();
+    const auto tip_mn_list_ptr = deterministicMNManager->GetListAtChainTipPtr();
+    const auto& tip_mn_list = *tip_mn_list_ptr;
     // ANOTHER USER IS ASKING US TO HELP THEM SYNC GOVERNANCE OBJECT DATA
     if (strCommand == NetMsgType::MNGOVERNANCESYNC) {
         // Ignore such requests until we are fully synced.
@@ -260,26 +425,124 @@ void CGovernanceManager::ProcessMessage(CNode* pfrom, const std::string& strComm
             return;
         }
 
-        CGovernanceException exception;
-        if (ProcessVote(pfrom, vote, exception, connman)) {
-            LogPrint(BCLog::GOBJECT, "MNGOVERNANCEOBJECTVOTE -- %s new\n", strHash);
-            masternodeSync.BumpAssetLastTime("MNGOVERNANCEOBJECTVOTE");
-            vote.Relay(peerman, tip_mn_list);
-        } else {
-            LogPrint(BCLog::GOBJECT, "MNGOVERNANCEOBJECTVOTE -- Rejected vote, error = %s\n", exception.what());
-            if ((exception.GetNodePenalty() != 0) && masternodeSync.IsSynced()) {
-                {
-                    LOCK(cs_main);
-                    peerman.ForgetTxHash(pfrom->GetId(), nHash);
+        // SYSCOIN votes for known objects have their signatures checked in batches on the BLS worker, so the
+        // message handler thread doesn't stall behind them. The rest, e.g. orphan votes, are processed right away.
+        if (llmq::blsWorker && llmq::blsWorker->IsRunning() && WITH_LOCK(cs, return mapObjects.count(vote.GetParentHash()) > 0)) {
+            bool fQueued{false};
+            bool fSchedule{false};
+            {
+                LOCK(cs_pendingVotes);
+                if (vecPendingVotes.size() < MAX_PENDING_VOTES) {
+                    vecPendingVotes.push_back(PendingVote{pfrom->GetId(), vote});
+                    fQueued = true;
+                    fSchedule = !std::exchange(fPendingVotesScheduled, true);
                 }
-                if(peer)
-                    peerman.Misbehaving(*peer, exception.GetNodePenalty(), "rejected vote");
             }
-            return;
+            if (fSchedule) {
+                llmq::blsWorker->AsyncRun([this, &connman, &peerman] { ProcessPendingVotes(connman, peerman); });
+            }
+            if (fQueued) return;
+        }
+        ProcessVoteMessage(pfrom->GetId(), pfrom, vote, /*fSignatureChecked=*/false, connman, peerman);
+    }
+}
+
+void CGovernanceManager::ProcessVoteMessage(NodeId nodeid, CNode* pfrom, const CGovernanceVote& vote, bool fSignatureChecked, CConnman& connman, PeerManager& peerman)
+{
+    const uint256 nHash = vote.GetHash();
+    const std::string strHash = nHash.ToString();
+
+    CGovernanceException exception;
+    if (ProcessVote(pfrom, vote, exception, connman, fSignatureChecked)) {
+        LogPrint(BCLog::GOBJECT, "MNGOVERNANCEOBJECTVOTE -- %s new\n", strHash);
+        masternodeSync.BumpAssetLastTime("MNGOVERNANCEOBJECTVOTE");
+        vote.Relay(peerman, *deterministicMNManager->GetListAtChainTipPtr());
+    } else {
+        LogPrint(BCLog::GOBJECT, "MNGOVERNANCEOBJECTVOTE -- Rejected vote, error = %s\n", exception.what());
+        if ((exception.GetNodePenalty() != 0) && masternodeSync.IsSynced()) {
+            {
+                LOCK(cs_main);
+                peerman.ForgetTxHash(nodeid, nHash);
+            }
+            PeerRef peer = peerman.GetPeerRef(nodeid);
+            if(peer)
+                peerman.Misbehaving(*peer, exception.GetNodePenalty(), "rejected vote");
         }
+        return;
+    }
+    {
+        LOCK(cs_main);
+        peerman.ForgetTxHash(nodeid, nHash);
+    }
+}
+
+void CGovernanceManager::ProcessPendingVotes(CConnman& connman, PeerManager& peerman)
+{
+    while (true) {
+        std::vector<PendingVote> vecVotes;
         {
-            LOCK(cs_main);
-            peerman.ForgetTxHash(pfrom->GetId(), nHash);
+            LOCK(cs_pendingVotes);
+            if (vecPendingVotes.empty()) {
+                fPendingVotesScheduled = false;
+                return;
+            }
+            vecVotes.swap(vecPendingVotes);
+        }
+        if (ShutdownRequested()) {
+            continue;
+        }
+
+        const auto tip_mn_list_ptr = deterministicMNManager->GetListAtChainTipPtr();
+        const auto& tip_mn_list = *tip_mn_list_ptr;
+
+        // funding votes on proposals are signed with the voting key, everything else with the operator key
+        std::vector<bool> vecVotingKey(vecVotes.size());
+        {
+            LOCK(cs);
+            for (size_t i = 0; i < vecVotes.size(); i++) {
+                const auto& vote = vecVotes[i].vote;
+                auto it = mapObjects.find(vote.GetParentHash());
+                vecVotingKey[i] = it != mapObjects.end() && it->second.GetObjectType() == GOVERNANCE_OBJECT_PROPOSAL &&
+                                  vote.GetSignal() == VOTE_SIGNAL_FUNDING;
+            }
+        }
+
+        // first pass: verify the signatures without holding cs, the operator key ones in a single batch
+        std::vector<bool> vecSignatureChecked(vecVotes.size());
+        CBLSBatchVerifier<NodeId, uint256> batchVerifier(false, true);
+        for (size_t i = 0; i < vecVotes.size(); i++) {
+            const auto& [nodeid, vote] = vecVotes[i];
+            auto dmn = tip_mn_list.GetMNByCollateral(vote.GetMasternodeOutpoint());
+            if (!dmn) {
+                // rejected by the second pass
+                continue;
+            }
+            if (vecVotingKey[i]) {
+                vecSignatureChecked[i] = vote.CheckSignature(dmn->pdmnState->keyIDVoting);
+                continue;
+            }
+            CBLSSignature sig;
+            sig.SetBytes(vote.GetSignature(), false);
+            const CBLSPublicKey pubKey = dmn->pdmnState->pubKeyOperator.Get();
+            if (!sig.IsValid() || !pubKey.IsValid()) {
+                continue;
+            }
+            batchVerifier.PushMessage(nodeid, vote.GetHash(), vote.GetSignatureHash(), sig, pubKey);
+            vecSignatureChecked[i] = true;
+        }
+        batchVerifier.Verify();
+        LogPrint(BCLog::GOBJECT, "CGovernanceManager::%s -- verified %d votes, %d in batch, %d bad\n", __func__,
+            vecVotes.size(), batchVerifier.GetMessageCount(), batchVerifier.badMessages.size());
+
+        // the signatures were checked against this list, a new tip may have changed the keys
+        const bool fSameList = deterministicMNManager->GetListAtChainTipPtr()->GetBlockHash() == tip_mn_list.GetBlockHash();
+
+        // second pass: apply the votes, those that failed are checked again one by one so they are rejected and
+        // penalized exactly like before
+        for (size_t i = 0; i < vecVotes.size(); i++) {
+            const auto& [nodeid, vote] = vecVotes[i];
+            const bool fSignatureChecked = fSameList && vecSignatureChecked[i] && !batchVerifier.badMessages.count(vote.GetHash());
+            ProcessVoteMessage(nodeid, /*pfrom=*/nullptr, vote, fSignatureChecked, connman, peerman);
         }
     }
 }
@@ -291,7 +554,8 @@ void CGovernanceManager::CheckOrphanVotes(CGovernanceObject& govobj, PeerManager
     std::vector<vote_time_pair_t> vecVotePairs;
     cmmapOrphanVotes.GetAll(nHash, vecVotePairs);
     ScopedLockBool guard(cs, fRateChecksEnabled, false);
-    const auto tip_mn_list = deterministicMNManager->GetListAtChainTip();
+    const auto tip_mn_list_ptr = deterministicMNManager->GetListAtChainTipPtr();
+    const auto& tip_mn_list = *tip_mn_list_ptr;
     int64_t nNow = TicksSinceEpoch<std::chrono::seconds>(GetAdjustedTime());
     for (const auto& pairVote : vecVotePairs) {
         bool fRemove = false;
@@ -299,9 +563,15 @@ void CGovernanceManager::CheckOrphanVotes(CGovernanceObject& govobj, PeerManager
         CGovernanceException e;
         if (pairVote.second < nNow) {
             fRemove = true;
-        } else if (govobj.ProcessVote(tip_mn_list, vote, e)) {
-            vote.Relay(peerman, tip_mn_list);
-            fRemove = true;
+        } else {
+            const auto nSupersededHash = govobj.GetCurrentVoteHash(vote.GetMasternodeOutpoint(), vote.GetSignal());
+            if (govobj.ProcessVote(tip_mn_list, vote, e)) {
+                m_db->WriteVote(vote, nSupersededHash);
+                // SYSCOIN reference it like any other accepted vote, so it can be served once relayed
+                AddVoteRefs(govobj, vote.GetHash(), vote.GetMasternodeOutpoint());
+                vote.Relay(peerman, tip_mn_list);
+                fRemove = true;
+            }
         }
         if (fRemove) {
             cmmapOrphanVotes.Erase(nHash, pairVote);
@@ -313,7 +583,9 @@ void CGovernanceManager::AddGovernanceObject(CGovernanceObject& govobj, PeerMana
     uint256 nHash = govobj.GetHash();
     std::string strHash = nHash.ToString();
     
-    const auto tip_mn_list = deterministicMNManager->GetListAtChainTip();
+    const auto tip_mn_list_ptr = deterministicMNManager->GetListAtChainTipPtr();
+    
+    const auto& tip_mn_list = *tip_mn_list_ptr;
 
     // Update cached variables for this object and add it to our managed data
     govobj.UpdateSentinelVariables(tip_mn_list); // This sets local vars in object
@@ -338,6 +610,7 @@ void CGovernanceManager::AddGovernanceObject(CGovernanceObject& govobj, PeerMana
     }
 
     CGovernanceObject& govObjRef = objpair.first->second;
+    StoreObject(govObjRef);
 
     // Should we add this object to any other managers?
     LogPrint(BCLog::GOBJECT, "CGovernanceManager::AddGovernanceObject -- Before trigger block, GetDataAsPlainString = %s, nObjectType = %d\n",
@@ -372,7 +645,8 @@ void CGovernanceManager::CheckAndRemove()
     LogPrint(BCLog::GOBJECT, "CGovernanceManager::UpdateCachesAndClean\n");
 
     int nHeight = WITH_LOCK(chainman.GetMutex(), return chainman.ActiveHeight());
-    const auto tip_mn_list = deterministicMNManager->GetListAtChainTip();
+    const auto tip_mn_list_ptr = deterministicMNManager->GetListAtChainTipPtr();
+    const auto& tip_mn_list = *tip_mn_list_ptr;
     LOCK2(cs_main, cs);
 
 
@@ -409,20 +683,8 @@ void CGovernanceManager::CheckAndRemove()
         if ((pObj->IsSetCachedDelete() || pObj->IsSetExpired()) &&
             (nTimeSinceDeletion >= GOVERNANCE_DELETION_DELAY)) {
             LogPrint(BCLog::GOBJECT, "CGovernanceManager::UpdateCachesAndClean -- erase obj %s\n", (*it).first.ToString());
-            mmetaman->RemoveGovernanceObject(pObj->GetHash());
-
             // Remove vote references
-            const object_ref_cm_t::list_t& listItems = cmapVoteToObject.GetItemList();
-            auto lit = listItems.begin();
-            while (lit != listItems.end()) {
-                if (lit->value == pObj) {
-                    uint256 nKey = lit->key;
-                    ++lit;
-                    cmapVoteToObject.Erase(nKey);
-                } else {
-                    ++lit;
-                }
-            }
+            RemoveObjectRefs(nHash);
 
             int64_t nTimeExpired{0};
 
@@ -435,11 +697,19 @@ void CGovernanceManager::CheckAndRemove()
             }
 
             mapErasedGovernanceObjects.insert(std::make_pair(nHash, nTimeExpired));
+            EraseStoredObject(nHash);
             mapObjects.erase(it++);
         } else {
-            if (pObj->GetObjectType() == GOVERNANCE_OBJECT_PROPOSAL) {
-                CProposalValidator validator(pObj->GetDataAsHexString());
-                if (!validator.Validate()) {
+            if (pObj->GetObjectType() == GOVERNANCE_OBJECT_PROPOSAL && !pObj->IsSetCachedDelete()) {
+                // SYSCOIN the data of an object never changes, once it validated only its end_epoch needs checking
+                auto itEnd = mapProposalEndEpochs.find(nHash);
+                if (itEnd == mapProposalEndEpochs.end()) {
+                    CProposalValidator validator(pObj->GetDataAsHexString());
+                    if (validator.Validate(/*fCheckExpiration=*/false)) {
+                        itEnd = mapProposalEndEpochs.emplace(nHash, validator.GetEndEpoch()).first;
+                    }
+                }
+                if (itEnd == mapProposalEndEpochs.end() || itEnd->second <= TicksSinceEpoch<std::chrono::seconds>(GetAdjustedTime())) {
                     LogPrint(BCLog::GOBJECT, "CGovernanceManager::UpdateCachesAndClean -- set for deletion expired obj %s\n", strHash);
                     pObj->PrepareDeletion(nNow);
                 }
@@ -496,6 +766,8 @@ void CGovernanceManager::DeleteGovernanceObject(const uint256& nHash)
     LOCK(cs);
 
     if (mapObjects.count(nHash)) {
+        RemoveObjectRefs(nHash);
+        EraseStoredObject(nHash);
         mapObjects.erase(nHash);
     }
 }
@@ -510,7 +782,9 @@ std::vector<CGovernanceVote> CGovernanceManager::GetCurrentVotes(const uint256&
     if (it == mapObjects.end()) return vecResult;
     const CGovernanceObject& govobj = it->second;
 
-    const auto tip_mn_list = deterministicMNManager->GetListAtChainTip();
+    const auto tip_mn_list_ptr = deterministicMNManager->GetListAtChainTipPtr();
+
+    const auto& tip_mn_list = *tip_mn_list_ptr;
     std::map<COutPoint, CDeterministicMNCPtr> mapMasternodes;
     if (mnCollateralOutpointFilter.IsNull()) {
         tip_mn_list.ForEachMNShared(false, [&](const CDeterministicMNCPtr& dmn) {
@@ -570,16 +844,23 @@ std::optional<const CSuperblock> CGovernanceManager::CreateSuperblockCandidate(c
     if (HasAlreadyVotedFundingTrigger()) return std::nullopt;
     // A proposal is considered passing if (YES votes) >= (Total Weight of Masternodes / 10),
     // count total valid (ENABLED) masternodes to determine passing threshold.
-    const auto tip_mn_list = deterministicMNManager->GetListAtChainTip();
+    const auto tip_mn_list_ptr = deterministicMNManager->GetListAtChainTipPtr();
+    const auto& tip_mn_list = *tip_mn_list_ptr;
     const int nWeightedMnCount = tip_mn_list.GetValidMNsCount();
     const int nAbsVoteReq = std::max(Params().GetConsensus().nGovernanceMinQuorum, nWeightedMnCount / 10);
 
-    // Use std::vector of std::shared_ptr<const CGovernanceObject> because CGovernanceObject doesn't support move operations (needed for sorting the vector later)
-    std::vector<std::shared_ptr<const CGovernanceObject>> approvedProposals;
+    // SYSCOIN rank on the vote tallies the objects keep, copying only what the payments are built from
+    // instead of whole objects with their votes
+    struct RankedProposal {
+        int nAbsYesCount;
+        uint256 hash;
+        UniValue jproposal;
+    };
+    std::vector<RankedProposal> approvedProposals;
 
     {
         LOCK(cs);
-        for (const auto& [unused, object] : mapObjects) {
+        for (const auto& [hash, object] : mapObjects) {
             // Skip all non-proposals objects
             if (object.GetObjectType() != GOVERNANCE_OBJECT_PROPOSAL) continue;
 
@@ -587,14 +868,12 @@ std::optional<const CSuperblock> CGovernanceManager::CreateSuperblockCandidate(c
             // Skip non-passing proposals
             if (absYesCount < nAbsVoteReq) continue;
 
-            approvedProposals.emplace_back(std::make_shared<const CGovernanceObject>(object));
+            approvedProposals.push_back({absYesCount, hash, object.GetJSONObject()});
         }
     } // cs
     // Sort approved proposals by absolute Yes votes descending
-    std::sort(approvedProposals.begin(), approvedProposals.end(), [](std::shared_ptr<const CGovernanceObject> a, std::shared_ptr<const CGovernanceObject> b) {
-        const auto a_yes = a->GetAbsoluteYesCount(VOTE_SIGNAL_FUNDING);
-        const auto b_yes = b->GetAbsoluteYesCount(VOTE_SIGNAL_FUNDING);
-        return a_yes == b_yes ? UintToArith256(a->GetHash()) > UintToArith256(b->GetHash()) : a_yes > b_yes;
+    std::sort(approvedProposals.begin(), approvedProposals.end(), [](const RankedProposal& a, const RankedProposal& b) {
+        return a.nAbsYesCount == b.nAbsYesCount ? UintToArith256(a.hash) > UintToArith256(b.hash) : a.nAbsYesCount > b.nAbsYesCount;
     });
 
     if (approvedProposals.empty()) {
@@ -615,7 +894,7 @@ std::optional<const CSuperblock> CGovernanceManager::CreateSuperblockCandidate(c
     CAmount budgetAllocated{};
     for (const auto& proposal : approvedProposals) {
         // Extract payment address and amount from proposal
-        UniValue jproposal = proposal->GetJSONObject();
+        const UniValue& jproposal = proposal.jproposal;
 
         CTxDestination dest = DecodeDestination(jproposal["payment_address"].getValStr());
         if (!IsValidDestination(dest)) continue;
@@ -630,7 +909,7 @@ std::optional<const CSuperblock> CGovernanceManager::CreateSuperblockCandidate(c
         }
 
         // Construct CGovernancePayment object and make sure it is valid
-        CGovernancePayment payment(dest, nAmount, proposal->GetHash());
+        CGovernancePayment payment(dest, nAmount, proposal.hash);
         if (!payment.IsValid()) continue;
 
         // Skip proposals that are too expensive
@@ -685,7 +964,8 @@ std::optional<const CGovernanceObject> CGovernanceManager::CreateGovernanceTrigg
         return std::make_optional<CGovernanceObject>(*identical_sb);
     }
     // Nobody submitted a trigger we'd like to see, so let's do it but only if we are the payee
-    const auto mnList = deterministicMNManager->GetListAtChainTip();
+    const auto mnListPtr = deterministicMNManager->GetListAtChainTipPtr();
+    const auto& mnList = *mnListPtr;
     const auto mn_payees = mnList.GetProjectedMNPayees();
 
     if (mn_payees.empty()) {
@@ -797,6 +1077,16 @@ void CGovernanceManager::DoMaintenance(CConnman& connman)
 
     // CHECK AND REMOVE - REPROCESS GOVERNANCE OBJECTS
     CheckAndRemove();
+
+    // SYSCOIN forget the served vote sets of objects that are gone
+    {
+        LOCK(cs);
+        for (auto& [_, sync] : mapPeerVoteSyncs) {
+            std::erase_if(sync.mapServedDigests, [&](const auto& entry) { return !mapObjects.count(entry.first); });
+        }
+    }
+
+    FlushToDb(/*fSync=*/false);
 }
 
 bool CGovernanceManager::ConfirmInventoryRequest(const GenTxid& gtxid)
@@ -858,13 +1148,11 @@ void CGovernanceManager::SyncSingleObjVotes(CNode* pnode, const uint256& nProp,
     // do not provide any data until our node is synced
     if (!masternodeSync.IsSynced()) return;
 
-    int nVoteCount = 0;
-
     // SYNC GOVERNANCE OBJECTS WITH OTHER CLIENT
 
     LogPrint(BCLog::GOBJECT, "CGovernanceManager::%s -- syncing single object to peer=%d, nProp = %s\n", __func__, nProp.ToString(), pnode->GetId());
     {
-        LOCK2(cs_main, cs);
+        LOCK(cs);
 
         // single valid object and its valid votes
         auto it = mapObjects.find(nProp);
@@ -883,29 +1171,113 @@ void CGovernanceManager::SyncSingleObjVotes(CNode* pnode, const uint256& nProp,
             return;
         }
 
+        // SYSCOIN the request is queued and served in bounded steps, so a peer can't make us check every vote at once
         const auto& fileVotes = govobj.GetVoteFile();
-        const auto tip_mn_list = deterministicMNManager->GetListAtChainTip();
+        auto& sync = mapPeerVoteSyncs[pnode->GetId()];
+        auto itServed = sync.mapServedDigests.find(nProp);
+        if (itServed != sync.mapServedDigests.end() && itServed->second == fileVotes.GetDigest()) {
+            // all of these votes were announced to the peer already
+            LogPrint(BCLog::GOBJECT, "CGovernanceManager::%s -- votes of govobj %s unchanged since last sync, peer=%d\n", __func__,
+                strHash, pnode->GetId());
+            CNetMsgMaker msgMaker(pnode->GetCommonVersion());
+            connman.PushMessage(pnode, msgMaker.Make(NetMsgType::SYNCSTATUSCOUNT, MASTERNODE_SYNC_GOVOBJ_VOTE, 0));
+            return;
+        }
+        if (sync.queue.size() >= MAX_VOTE_SYNC_QUEUE ||
+            std::any_of(sync.queue.begin(), sync.queue.end(), [&](const VoteSyncCursor& cursor) { return cursor.nProp == nProp; })) {
+            LogPrint(BCLog::GOBJECT, "CGovernanceManager::%s -- dropping vote sync request for govobj %s, %d pending, peer=%d\n", __func__,
+                strHash, sync.queue.size(), pnode->GetId());
+            return;
+        }
+        sync.queue.push_back(VoteSyncCursor{nProp, fileVotes.GetDigest(), filter, fileVotes.GetVoteHashes()});
+
+        if (!ContinueVoteSync(pnode, sync, connman, peerman)) {
+            mapPeerVoteSyncs.erase(pnode->GetId());
+        }
+    }
+}
 
-        auto votes = fileVotes.GetVotes();
-        for (const auto &vote : votes) {
-            const uint256 nVoteHash = vote.GetHash();
+bool CGovernanceManager::ContinueVoteSync(CNode* pnode, PeerVoteSync& sync, CConnman& connman, PeerManager& peerman)
+{
+    AssertLockHeld(cs);
 
-            bool onlyVotingKeyAllowed = govobj.GetObjectType() == GOVERNANCE_OBJECT_PROPOSAL && vote.GetSignal() == VOTE_SIGNAL_FUNDING;
+    const auto tip_mn_list_ptr = deterministicMNManager->GetListAtChainTipPtr();
+    const auto& tip_mn_list = *tip_mn_list_ptr;
+    PeerRef peer = peerman.GetPeerRef(pnode->GetId());
 
-            if (filter.contains(nVoteHash) || !vote.IsValid(tip_mn_list, onlyVotingKeyAllowed)) {
+    size_t nBudget = MAX_VOTE_SYNC_STEP;
+    while (!sync.queue.empty() && nBudget > 0) {
+        auto& cursor = sync.queue.front();
+        const CGovernanceObject* pGovobj = FindConstGovernanceObject(cursor.nProp);
+        for (; pGovobj && cursor.nNext < cursor.vecVoteHashes.size() && nBudget > 0; ++cursor.nNext, --nBudget) {
+            const uint256& nVoteHash = cursor.vecVoteHashes[cursor.nNext];
+            if (cursor.filter.contains(nVoteHash)) {
                 continue;
             }
-            PeerRef peer = peerman.GetPeerRef(pnode->GetId());
-            if(peer) {
+            auto vote = pGovobj->GetVoteFile().GetVote(nVoteHash);
+            if (!vote) {
+                // replaced or removed since the request came in
+                continue;
+            }
+            // SYSCOIN read back a dropped signature before checking it
+            if (vote->GetSignature().empty() && !m_db->ReadVote(cursor.nProp, nVoteHash, *vote)) {
+                continue;
+            }
+
+            bool onlyVotingKeyAllowed = pGovobj->GetObjectType() == GOVERNANCE_OBJECT_PROPOSAL && vote->GetSignal() == VOTE_SIGNAL_FUNDING;
+
+            if (!vote->IsValid(tip_mn_list, onlyVotingKeyAllowed)) {
+                continue;
+            }
+            if (peer) {
                 peerman.PushTxInventoryOther(*peer, CInv(MSG_GOVERNANCE_OBJECT_VOTE, nVoteHash));
             }
-            ++nVoteCount;
+            ++cursor.nVoteCount;
         }
+        if (pGovobj && cursor.nNext < cursor.vecVoteHashes.size()) {
+            // out of budget, resume on the next step
+            break;
+        }
+
+        if (pGovobj) {
+            sync.mapServedDigests[cursor.nProp] = cursor.nDigest;
+        }
+        CNetMsgMaker msgMaker(pnode->GetCommonVersion());
+        connman.PushMessage(pnode, msgMaker.Make(NetMsgType::SYNCSTATUSCOUNT, MASTERNODE_SYNC_GOVOBJ_VOTE, cursor.nVoteCount));
+        LogPrint(BCLog::GOBJECT, "CGovernanceManager::%s -- sent %d votes of govobj %s to peer=%d\n", __func__, cursor.nVoteCount,
+            cursor.nProp.ToString(), pnode->GetId());
+        sync.queue.pop_front();
     }
+    return !sync.queue.empty() || !sync.mapServedDigests.empty();
+}
 
-    CNetMsgMaker msgMaker(pnode->GetCommonVersion());
-    connman.PushMessage(pnode, msgMaker.Make(NetMsgType::SYNCSTATUSCOUNT, MASTERNODE_SYNC_GOVOBJ_VOTE, nVoteCount));
-    LogPrint(BCLog::GOBJECT, "CGovernanceManager::%s -- sent %d votes to peer=%d\n", __func__, nVoteCount, pnode->GetId());
+void CGovernanceManager::ProcessVoteSyncs(CConnman& connman, PeerManager& peerman)
+{
+    if (!masternodeSync.IsSynced()) return;
+
+    std::vector<NodeId> vecPeers;
+    {
+        LOCK(cs);
+        for (const auto& [nodeid, _] : mapPeerVoteSyncs) {
+            vecPeers.emplace_back(nodeid);
+        }
+    }
+
+    // peers without pending requests are only checked for having disconnected
+    for (const NodeId nodeid : vecPeers) {
+        const bool fConnected = connman.ForNode(nodeid, [&](CNode* pnode) {
+            LOCK(cs);
+            auto it = mapPeerVoteSyncs.find(nodeid);
+            if (it != mapPeerVoteSyncs.end() && !ContinueVoteSync(pnode, it->second, connman, peerman)) {
+                mapPeerVoteSyncs.erase(it);
+            }
+            return true;
+        });
+        if (!fConnected) {
+            LOCK(cs);
+            mapPeerVoteSyncs.erase(nodeid);
+        }
+    }
 }
 
 void CGovernanceManager::SyncObjects(CNode* pnode, CConnman& connman, PeerManager& peerman) const
@@ -1059,7 +1431,7 @@ bool CGovernanceManager::ProcessVoteAndRelay(const CGovernanceVote& vote, const
     return fOK;
 }
 
-bool CGovernanceManager::ProcessVote(CNode* pfrom, const CGovernanceVote& vote, CGovernanceException& exception, CConnman& connman)
+bool CGovernanceManager::ProcessVote(CNode* pfrom, const CGovernanceVote& vote, CGovernanceException& exception, CConnman& connman, bool fSignatureChecked)
 {
     ENTER_CRITICAL_SECTION(cs);
     const uint256 nHashVote = vote.GetHash();
@@ -1108,7 +1480,15 @@ bool CGovernanceManager::ProcessVote(CNode* pfrom, const CGovernanceVote& vote,
         return false;
     }
 
-    bool fOk = govobj.ProcessVote(deterministicMNManager->GetListAtChainTip(), vote, exception) && cmapVoteToObject.Insert(nHashVote, &govobj);
+    const auto time_start{SteadyClock::now()};
+    const auto nSupersededHash = govobj.GetCurrentVoteHash(vote.GetMasternodeOutpoint(), vote.GetSignal());
+    const bool fAccepted = govobj.ProcessVote(deterministicMNManager->GetListAtChainTip(), vote, exception, fSignatureChecked);
+    if (fAccepted) {
+        m_db->WriteVote(vote, nSupersededHash);
+    }
+    bool fOk = fAccepted && AddVoteRefs(govobj, nHashVote, vote.GetMasternodeOutpoint());
+    TRACE5(governance, vote_processed, nHashVote.data(), nHashGovobj.data(), fOk, fSignatureChecked,
+        Ticks<std::chrono::microseconds>(SteadyClock::now() - time_start));
     LEAVE_CRITICAL_SECTION(cs);
     return fOk;
 }
@@ -1118,7 +1498,8 @@ void CGovernanceManager::CheckPostponedObjects(PeerManager& peerman)
     if (!masternodeSync.IsSynced()) return;
 
     LOCK2(cs_main, cs);
-    const auto mnList = deterministicMNManager->GetListAtChainTip();
+    const auto mnListPtr = deterministicMNManager->GetListAtChainTipPtr();
+    const auto& mnList = *mnListPtr;
     // Check postponed proposals
     for (auto it = mapPostponedObjects.begin(); it != mapPostponedObjects.end();) {
         const uint256& nHash = it->first;
@@ -1198,16 +1579,20 @@ void CGovernanceManager::RequestGovernanceObject(CNode* pfrom, const uint256& nH
 
         if (pObj) {
             filter = CBloomFilter(Params().GetConsensus().nGovernanceFilterElements, GOVERNANCE_FILTER_FP_RATE, GetRand(999999), BLOOM_UPDATE_ALL);
-            std::vector<CGovernanceVote> vecVotes = pObj->GetVoteFile().GetVotes();
-            nVoteCount = vecVotes.size();
-            for (const auto& vote : vecVotes) {
-                filter.insert(vote.GetHash());
+            std::vector<uint256> vecVoteHashes = pObj->GetVoteFile().GetVoteHashes();
+            nVoteCount = vecVoteHashes.size();
+            for (const auto& nVoteHash : vecVoteHashes) {
+                filter.insert(nVoteHash);
             }
         }
     }
 
     LogPrint(BCLog::GOBJECT, "CGovernanceManager::RequestGovernanceObject -- nHash %s nVoteCount %d peer=%d\n", nHash.ToString(), nVoteCount, pfrom->GetId());
     connman.PushMessage(pfrom, msgMaker.Make(NetMsgType::MNGOVERNANCESYNC, nHash, filter));
+    // SYSCOIN the peer answers with a SYNCSTATUSCOUNT, which lets the sync move on without waiting for a timeout
+    if (fUseFilter) {
+        masternodeSync.AddPendingRequest(pfrom->GetId());
+    }
 }
 
 int CGovernanceManager::RequestGovernanceObjectVotes(CNode* pnode, CConnman& connman, const PeerManager& peerman) const
@@ -1237,7 +1622,7 @@ int CGovernanceManager::RequestGovernanceObjectVotes(const std::vector<CNode*>&
     int nMaxObjRequestsPerNode = 1;
     size_t nProjectedVotes = 2000;
     if (Params().GetChainType() != ChainType::MAIN) {
-        nMaxObjRequestsPerNode = std::max(1, int(nProjectedVotes / std::max(1, (int)deterministicMNManager->GetListAtChainTip().GetValidMNsCount())));
+        nMaxObjRequestsPerNode = std::max(1, int(nProjectedVotes / std::max(1, (int)deterministicMNManager->GetListAtChainTipPtr()->GetValidMNsCount())));
     }
 
     {
@@ -1347,13 +1732,42 @@ void CGovernanceManager::RebuildIndexes()
     LOCK(cs);
 
     cmapVoteToObject.Clear();
+    mapVoteRefsByObject.clear();
+    mapObjectsByVoter.clear();
     for (auto& objPair : mapObjects) {
         CGovernanceObject& govobj = objPair.second;
-        std::vector<CGovernanceVote> vecVotes = govobj.GetVoteFile().GetVotes();
-        for (const auto& vecVote : vecVotes) {
-            cmapVoteToObject.Insert(vecVote.GetHash(), &govobj);
+        for (const auto& vote : govobj.GetVoteFile().GetVotes()) {
+            AddVoteRefs(govobj, vote.GetHash(), vote.GetMasternodeOutpoint());
+        }
+    }
+}
+
+bool CGovernanceManager::AddVoteRefs(CGovernanceObject& govobj, const uint256& nVoteHash, const COutPoint& masternodeOutpoint)
+{
+    AssertLockHeld(cs);
+
+    if (!cmapVoteToObject.Insert(nVoteHash, &govobj)) {
+        return false;
+    }
+    mapVoteRefsByObject[govobj.GetHash()].emplace_back(nVoteHash);
+    mapObjectsByVoter[masternodeOutpoint].emplace(govobj.GetHash());
+    return true;
+}
+
+void CGovernanceManager::RemoveObjectRefs(const uint256& nHash)
+{
+    AssertLockHeld(cs);
+
+    // superseded votes stay referenced until their object goes, entries evicted from the cache are skipped by Erase
+    auto it = mapVoteRefsByObject.find(nHash);
+    if (it != mapVoteRefsByObject.end()) {
+        for (const auto& nVoteHash : it->second) {
+            cmapVoteToObject.Erase(nVoteHash);
         }
+        mapVoteRefsByObject.erase(it);
     }
+    mapProposalEndEpochs.erase(nHash);
+    // mapObjectsByVoter is cleaned up lazily, whoever walks it skips objects that are gone
 }
 
 void CGovernanceManager::AddCachedTriggers()
@@ -1540,7 +1954,9 @@ void CGovernanceManager::RemoveInvalidVotes()
 
     LOCK(cs);
 
-    const auto tip_mn_list = deterministicMNManager->GetListAtChainTip();
+    const auto tip_mn_list_ptr = deterministicMNManager->GetListAtChainTipPtr();
+
+    const auto& tip_mn_list = *tip_mn_list_ptr;
     CDeterministicMNListDiff diff;
     CDeterministicMNListNEVMAddressDiff diffRetNEVMAddress;
 
@@ -1561,18 +1977,41 @@ void CGovernanceManager::RemoveInvalidVotes()
     }
 
     for (const auto& outpoint : changedKeyMNs) {
-        for (auto& p : mapObjects) {
-            auto removed = p.second.RemoveInvalidVotes(tip_mn_list, outpoint);
+        // SYSCOIN only the objects this masternode voted on can hold votes to remove
+        auto itVoter = mapObjectsByVoter.find(outpoint);
+        if (itVoter == mapObjectsByVoter.end()) {
+            continue;
+        }
+        for (auto itObj = itVoter->second.begin(); itObj != itVoter->second.end();) {
+            auto itFound = mapObjects.find(*itObj);
+            if (itFound == mapObjects.end()) {
+                itObj = itVoter->second.erase(itObj);
+                continue;
+            }
+            ++itObj;
+            auto& p = *itFound;
+            // SYSCOIN votes kept without their signature are checked against the stored copy
+            const auto fnLoadSignature = [&](CGovernanceVote& vote) {
+                CGovernanceVote stored;
+                if (!m_db->ReadVote(p.first, vote.GetHash(), stored)) return false;
+                vote.SetSignature(stored.GetSignature());
+                return true;
+            };
+            auto removed = p.second.RemoveInvalidVotes(tip_mn_list, outpoint, fnLoadSignature);
             if (removed.empty()) {
                 continue;
             }
             for (auto& voteHash : removed) {
+                m_db->EraseVote(p.first, voteHash);
                 cmapVoteToObject.Erase(voteHash);
                 cmapInvalidVotes.Erase(voteHash);
                 cmmapOrphanVotes.Erase(voteHash);
                 setRequestedVotes.erase(voteHash);
             }
         }
+        if (!tip_mn_list.HasMNByCollateral(outpoint)) {
+            mapObjectsByVoter.erase(itVoter);
+        }
     }
 
     // store current MN list for the next run so that we can determine which keys changed
@@ -9,16 +9,20 @@
 
 #include <cachemap.h>
 #include <cachemultimap.h>
+#include <common/bloom.h>
+#include <net.h>
 #include <net_types.h>
 #include <util/check.h>
 #include <evo/evodb.h>
+
+#include <deque>
 #include <optional>
 
-class CBloomFilter;
 class CBlockIndex;
 class CConnman;
 template<typename T>
 class CFlatDB;
+class CGovernanceDB;
 class CInv;
 
 class CGovernanceManager;
@@ -32,6 +36,12 @@ extern std::unique_ptr<CGovernanceManager> governance;
 
 static constexpr int RATE_BUFFER_SIZE = 5;
 static constexpr bool DEFAULT_GOVERNANCE_ENABLE{true};
+// SYSCOIN votes looked at for one peer per sync step, the rest of a request is resumed on the next step
+static constexpr size_t MAX_VOTE_SYNC_STEP{500};
+// SYSCOIN vote sync requests a peer may have pending, further ones are dropped
+static constexpr size_t MAX_VOTE_SYNC_QUEUE{16};
+// SYSCOIN received votes waiting for the batched signature check, once full votes are checked right away
+static constexpr size_t MAX_PENDING_VOTES{10000};
 
 class CDeterministicMNList;
 using CDeterministicMNListPtr = std::shared_ptr<CDeterministicMNList>;
@@ -213,6 +223,36 @@ public:
             >> *lastMNListForVotingKeys;
     }
 
+    // SYSCOIN everything but the objects and their votes, which the governance db stores as records of their own
+    template<typename Stream>
+    void SerializeMeta(Stream &s) const
+    {
+        LOCK(cs);
+        s   << SERIALIZATION_VERSION_STRING
+            << mapErasedGovernanceObjects
+            << cmapInvalidVotes
+            << cmmapOrphanVotes
+            << mapLastMasternodeObject
+            << *lastMNListForVotingKeys;
+    }
+
+    template<typename Stream>
+    void UnserializeMeta(Stream &s)
+    {
+        LOCK(cs);
+        std::string strVersion;
+        s >> strVersion;
+        if (strVersion != SERIALIZATION_VERSION_STRING) {
+            throw std::ios_base::failure("unknown governance db version " + strVersion);
+        }
+
+        s   >> mapErasedGovernanceObjects
+            >> cmapInvalidVotes
+            >> cmmapOrphanVotes
+            >> mapLastMasternodeObject
+            >> *lastMNListForVotingKeys;
+    }
+
     void Clear();
 
     std::string ToString() const;
@@ -254,8 +294,42 @@ private:
 
 private:
     ChainstateManager& chainman;
-    const std::unique_ptr<db_type> m_db;
+    const std::unique_ptr<CGovernanceDB> m_db;
     bool is_valid{false};
+    // SYSCOIN deletion time and expiry of the objects as last written to m_db
+    std::map<uint256, std::pair<int64_t, bool>> mapStoredObjectStates GUARDED_BY(cs);
+
+    // SYSCOIN a vote sync request of a peer, served MAX_VOTE_SYNC_STEP votes at a time
+    struct VoteSyncCursor {
+        uint256 nProp;
+        uint256 nDigest;
+        CBloomFilter filter;
+        std::vector<uint256> vecVoteHashes;
+        size_t nNext{0};
+        int nVoteCount{0};
+    };
+    struct PeerVoteSync {
+        std::deque<VoteSyncCursor> queue;
+        // vote set digest of each object whose votes were fully sent to the peer
+        std::map<uint256, uint256> mapServedDigests;
+    };
+    std::map<NodeId, PeerVoteSync> mapPeerVoteSyncs GUARDED_BY(cs);
+
+    // SYSCOIN vote hashes each object has in cmapVoteToObject, so the references go without a scan of all votes
+    std::map<uint256, std::vector<uint256>> mapVoteRefsByObject GUARDED_BY(cs);
+    // SYSCOIN objects each masternode voted on, so its key changes and removal only revisit those
+    std::map<COutPoint, std::set<uint256>> mapObjectsByVoter GUARDED_BY(cs);
+    // SYSCOIN end_epoch of the proposals whose data passed validation, they only need checking again once it passed
+    std::map<uint256, int64_t> mapProposalEndEpochs GUARDED_BY(cs);
+
+    // SYSCOIN received votes, their signatures are checked in batches on the BLS worker before they are processed
+    struct PendingVote {
+        NodeId nodeid;
+        CGovernanceVote vote;
+    };
+    Mutex cs_pendingVotes;
+    std::vector<PendingVote> vecPendingVotes GUARDED_BY(cs_pendingVotes);
+    bool fPendingVotesScheduled GUARDED_BY(cs_pendingVotes){false};
 
 
     int64_t nTimeLastDiff;
@@ -288,6 +362,8 @@ public:
 
     void SyncSingleObjVotes(CNode* pnode, const uint256& nProp, const CBloomFilter& filter, CConnman& connman, PeerManager& peerman);
     void SyncObjects(CNode* pnode, CConnman& connman, PeerManager &peerman) const;
+    /** Continue the pending vote sync requests of all peers, one step each */
+    void ProcessVoteSyncs(CConnman& connman, PeerManager& peerman);
 
     void ProcessMessage(CNode* pfrom, const std::string& strCommand, CDataStream& vRecv, CConnman& connman, PeerManager& peerman);
 
@@ -323,6 +399,9 @@ public:
 
     int GetVoteCount() const;
 
+    // SYSCOIN heap memory held by the objects, votes and indexes of the manager
+    size_t DynamicMemoryUsage() const;
+
     bool SerializeObjectForHash(const uint256& nHash, CDataStream& ss) const;
 
     bool SerializeVoteForHash(const uint256& nHash, CDataStream& ss) const;
@@ -373,12 +452,25 @@ private:
 
     void RequestGovernanceObject(CNode* pfrom, const uint256& nHash, CConnman& connman, bool fUseFilter = false) const;
 
+    /** Announce up to MAX_VOTE_SYNC_STEP votes of the pending requests of a peer, false once none are left */
+    bool ContinueVoteSync(CNode* pnode, PeerVoteSync& sync, CConnman& connman, PeerManager& peerman) EXCLUSIVE_LOCKS_REQUIRED(cs);
+
     void AddInvalidVote(const CGovernanceVote& vote)
     {
         cmapInvalidVotes.Insert(vote.GetHash(), vote);
     }
 
-    bool ProcessVote(CNode* pfrom, const CGovernanceVote& vote, CGovernanceException& exception, CConnman& connman);
+    bool ProcessVote(CNode* pfrom, const CGovernanceVote& vote, CGovernanceException& exception, CConnman& connman, bool fSignatureChecked = false);
+
+    /** Index an accepted vote, false if it was already referenced */
+    bool AddVoteRefs(CGovernanceObject& govobj, const uint256& nVoteHash, const COutPoint& masternodeOutpoint) EXCLUSIVE_LOCKS_REQUIRED(cs);
+    /** Drop the index entries of an object which is about to be erased */
+    void RemoveObjectRefs(const uint256& nHash) EXCLUSIVE_LOCKS_REQUIRED(cs);
+
+    /** Process a vote received from a peer, relaying or penalizing like MNGOVERNANCEOBJECTVOTE does. pfrom may be nullptr */
+    void ProcessVoteMessage(NodeId nodeid, CNode* pfrom, const CGovernanceVote& vote, bool fSignatureChecked, CConnman& connman, PeerManager& peerman);
+    /** Check the signatures of the pending votes in one batch, then process the votes */
+    void ProcessPendingVotes(CConnman& connman, PeerManager& peerman) EXCLUSIVE_LOCKS_REQUIRED(!cs_pendingVotes);
 
     /// Called to indicate a requested object has been received
     bool AcceptObjectMessage(const uint256& nHash);
@@ -400,6 +492,13 @@ private:
 
     void RemoveInvalidVotes();
 
+    // SYSCOIN governance db
+    bool LoadFromDb();
+    bool MigrateFlatFile();
+    void StoreObject(const CGovernanceObject& govobj) EXCLUSIVE_LOCKS_REQUIRED(cs);
+    void EraseStoredObject(const uint256& nHash) EXCLUSIVE_LOCKS_REQUIRED(cs);
+    void FlushToDb(bool fSync);
+
 };
 
 bool AreSuperblocksEnabled();
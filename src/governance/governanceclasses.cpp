@@ -223,7 +223,8 @@ bool CSuperblockManager::IsSuperblockTriggered(int nBlockHeight)
     }
 
     LOCK(governance->cs);
-    const auto tip_mn_list = deterministicMNManager->GetListAtChainTip();
+    const auto tip_mn_list_ptr = deterministicMNManager->GetListAtChainTipPtr();
+    const auto& tip_mn_list = *tip_mn_list_ptr;
     // GET ALL ACTIVE TRIGGERS
     std::vector<CSuperblock_sptr> vecTriggers = governance->GetActiveTriggers();
 
@@ -0,0 +1,123 @@
+// Copyright (c) 2024 The Syscoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <governance/governancedb.h>
+
+#include <governance/governanceobject.h>
+#include <governance/governancevote.h>
+#include <logging.h>
+
+#include <memory>
+#include <utility>
+
+namespace {
+/** Object record without the votes, see CGovernanceObject::SerializeWithoutVotes */
+template <typename T>
+struct ObjectRecord {
+    T& obj;
+
+    template <typename Stream>
+    void Serialize(Stream& s) const { obj.SerializeWithoutVotes(s); }
+    template <typename Stream>
+    void Unserialize(Stream& s) { obj.UnserializeWithoutVotes(s); }
+};
+} // namespace
+
+CGovernanceDB::CGovernanceDB(const DBParams& db_params) :
+    db(db_params)
+{
+}
+
+void CGovernanceDB::WriteObject(const CGovernanceObject& govobj)
+{
+    db.Write(std::make_pair(DB_OBJECT, govobj.GetHash()), ObjectRecord<const CGovernanceObject>{govobj});
+}
+
+void CGovernanceDB::EraseObject(const uint256& nHash)
+{
+    CDBBatch batch(db);
+    batch.Erase(std::make_pair(DB_OBJECT, nHash));
+
+    std::unique_ptr<CDBIterator> pcursor(db.NewIterator());
+    pcursor->Seek(std::make_pair(DB_VOTE, std::make_pair(nHash, uint256())));
+    std::pair<uint8_t, std::pair<uint256, uint256>> key;
+    while (pcursor->Valid() && pcursor->GetKey(key) && key.first == DB_VOTE && key.second.first == nHash) {
+        batch.Erase(key);
+        pcursor->Next();
+    }
+    db.WriteBatch(batch);
+}
+
+void CGovernanceDB::WriteVote(const CGovernanceVote& vote, const std::optional<uint256>& nSupersededHash)
+{
+    CDBBatch batch(db);
+    if (nSupersededHash && *nSupersededHash != vote.GetHash()) {
+        batch.Erase(std::make_pair(DB_VOTE, std::make_pair(vote.GetParentHash(), *nSupersededHash)));
+    }
+    batch.Write(std::make_pair(DB_VOTE, std::make_pair(vote.GetParentHash(), vote.GetHash())), vote);
+    db.WriteBatch(batch);
+}
+
+void CGovernanceDB::EraseVote(const uint256& nParentHash, const uint256& nVoteHash)
+{
+    db.Erase(std::make_pair(DB_VOTE, std::make_pair(nParentHash, nVoteHash)));
+}
+
+bool CGovernanceDB::ReadVote(const uint256& nParentHash, const uint256& nVoteHash, CGovernanceVote& vote) const
+{
+    return db.Read(std::make_pair(DB_VOTE, std::make_pair(nParentHash, nVoteHash)), vote) && vote.GetHash() == nVoteHash;
+}
+
+void CGovernanceDB::ForEachObject(const std::function<void(CGovernanceObject&&)>& fn)
+{
+    std::unique_ptr<CDBIterator> pcursor(db.NewIterator());
+    pcursor->Seek(std::make_pair(DB_OBJECT, uint256()));
+    std::pair<uint8_t, uint256> key;
+    while (pcursor->Valid() && pcursor->GetKey(key) && key.first == DB_OBJECT) {
+        CGovernanceObject govobj;
+        ObjectRecord<CGovernanceObject> record{govobj};
+        if (pcursor->GetValue(record) && govobj.GetHash() == key.second) {
+            fn(std::move(govobj));
+        } else {
+            LogPrintf("CGovernanceDB::%s -- skipping unreadable governance object %s\n", __func__, key.second.ToString());
+        }
+        pcursor->Next();
+    }
+}
+
+void CGovernanceDB::ForEachVote(const std::function<void(const CGovernanceVote&)>& fn)
+{
+    std::unique_ptr<CDBIterator> pcursor(db.NewIterator());
+    pcursor->Seek(std::make_pair(DB_VOTE, std::make_pair(uint256(), uint256())));
+    std::pair<uint8_t, std::pair<uint256, uint256>> key;
+    while (pcursor->Valid() && pcursor->GetKey(key) && key.first == DB_VOTE) {
+        CGovernanceVote vote;
+        if (pcursor->GetValue(vote) && vote.GetHash() == key.second.second) {
+            fn(vote);
+        } else {
+            LogPrintf("CGovernanceDB::%s -- skipping unreadable governance vote %s\n", __func__, key.second.second.ToString());
+        }
+        pcursor->Next();
+    }
+}
+
+void CGovernanceDB::Wipe()
+{
+    CDBBatch batch(db);
+    batch.Erase(DB_META);
+    std::unique_ptr<CDBIterator> pcursor(db.NewIterator());
+    pcursor->Seek(std::make_pair(DB_OBJECT, uint256()));
+    std::pair<uint8_t, uint256> objectKey;
+    while (pcursor->Valid() && pcursor->GetKey(objectKey) && objectKey.first == DB_OBJECT) {
+        batch.Erase(objectKey);
+        pcursor->Next();
+    }
+    pcursor->Seek(std::make_pair(DB_VOTE, std::make_pair(uint256(), uint256())));
+    std::pair<uint8_t, std::pair<uint256, uint256>> voteKey;
+    while (pcursor->Valid() && pcursor->GetKey(voteKey) && voteKey.first == DB_VOTE) {
+        batch.Erase(voteKey);
+        pcursor->Next();
+    }
+    db.WriteBatch(batch, /*fSync=*/true);
+}
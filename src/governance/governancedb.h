@@ -0,0 +1,59 @@
+// Copyright (c) 2024 The Syscoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef SYSCOIN_GOVERNANCE_GOVERNANCEDB_H
+#define SYSCOIN_GOVERNANCE_GOVERNANCEDB_H
+
+#include <dbwrapper.h>
+#include <uint256.h>
+
+#include <functional>
+#include <optional>
+
+class CGovernanceObject;
+class CGovernanceVote;
+
+/**
+ * Governance objects and votes, one record each, written as they are accepted.
+ * Objects are stored without their votes, the votes of an object are keyed by its
+ * hash so deleting the object drops them with a single range scan. Everything else
+ * the governance manager keeps (erased objects, orphan and invalid votes, rate
+ * buffers) is small and stored as one meta record on flush.
+ */
+class CGovernanceDB
+{
+private:
+    CDBWrapper db;
+
+public:
+    explicit CGovernanceDB(const DBParams& db_params);
+
+    void WriteObject(const CGovernanceObject& govobj);
+    /** Erase the object together with all of its votes */
+    void EraseObject(const uint256& nHash);
+    /** Store an accepted vote, replacing the older vote of the same masternode and signal if there was one */
+    void WriteVote(const CGovernanceVote& vote, const std::optional<uint256>& nSupersededHash = std::nullopt);
+    void EraseVote(const uint256& nParentHash, const uint256& nVoteHash);
+    bool ReadVote(const uint256& nParentHash, const uint256& nVoteHash, CGovernanceVote& vote) const;
+
+    template <typename T>
+    bool WriteMeta(const T& meta, bool fSync) { return db.Write(DB_META, meta, fSync); }
+    template <typename T>
+    bool ReadMeta(T& meta) const { return db.Read(DB_META, meta); }
+    bool HasMeta() const { return db.Exists(DB_META); }
+
+    /** Pass every stored object or vote to fn, the votes come ordered by their parent object */
+    void ForEachObject(const std::function<void(CGovernanceObject&&)>& fn);
+    void ForEachVote(const std::function<void(const CGovernanceVote&)>& fn);
+
+    /** Drop all records, e.g. when the caches are rebuilt on reindex */
+    void Wipe();
+
+private:
+    static constexpr uint8_t DB_META{'m'};
+    static constexpr uint8_t DB_OBJECT{'o'};
+    static constexpr uint8_t DB_VOTE{'v'};
+};
+
+#endif // SYSCOIN_GOVERNANCE_GOVERNANCEDB_H
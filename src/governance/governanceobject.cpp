@@ -6,13 +6,14 @@
 
 #include <bls/bls.h>
 #include <chainparams.h>
+#include <common/args.h>
 #include <core_io.h>
 #include <evo/deterministicmns.h>
 #include <governance/governance.h>
 #include <governance/governancevalidators.h>
-#include <masternode/masternodemeta.h>
 #include <masternode/activemasternode.h>
 #include <masternode/masternodesync.h>
+#include <memusage.h>
 #include <messagesigner.h>
 #include <net_processing.h>
 #include <timedata.h>
@@ -24,6 +25,13 @@
 
 #include <string>
 
+// SYSCOIN the governance db keeps the signatures of all accepted votes
+static bool KeepVoteSignatures()
+{
+    static const bool fKeep = !gArgs.GetBoolArg("-governancedropvotesigs", DEFAULT_GOVERNANCE_DROP_VOTE_SIGS);
+    return fKeep;
+}
+
 CGovernanceObject::CGovernanceObject() :
     cs(),
     m_obj{},
@@ -64,6 +72,16 @@ CGovernanceObject::CGovernanceObject(const uint256& nHashParentIn, int nRevision
     LoadData();
 }
 
+size_t CGovernanceObject::DynamicMemoryUsage() const
+{
+    LOCK(cs);
+    size_t usage = memusage::DynamicUsage(m_obj.vchData) + memusage::DynamicUsage(mapCurrentMNVotes) + fileVotes.DynamicMemoryUsage();
+    for (const auto& [outpoint, voteRecord] : mapCurrentMNVotes) {
+        usage += memusage::DynamicUsage(voteRecord.mapInstances);
+    }
+    return usage;
+}
+
 CGovernanceObject::CGovernanceObject(const CGovernanceObject& other) :
     cs(),
     m_obj{other.m_obj},
@@ -78,12 +96,13 @@ CGovernanceObject::CGovernanceObject(const CGovernanceObject& other) :
     fExpired(other.fExpired),
     fUnparsable(other.fUnparsable),
     mapCurrentMNVotes(other.mapCurrentMNVotes),
+    m_vote_tally(WITH_LOCK(other.cs, return other.m_vote_tally)),
     fileVotes(other.fileVotes)
 {
 }
 
 bool CGovernanceObject::ProcessVote(const CDeterministicMNList& tip_mn_list,
-                                    const CGovernanceVote& vote, CGovernanceException& exception)
+                                    const CGovernanceVote& vote, CGovernanceException& exception, bool fSignatureChecked)
 {
     LOCK(cs);
 
@@ -169,7 +188,7 @@ bool CGovernanceObject::ProcessVote(const CDeterministicMNList& tip_mn_list,
     bool onlyVotingKeyAllowed = GetObjectType() == GOVERNANCE_OBJECT_PROPOSAL && vote.GetSignal() == VOTE_SIGNAL_FUNDING;
 
     // Finally check that the vote is actually valid (done last because of cost of signature verification)
-    if (!vote.IsValid(tip_mn_list, onlyVotingKeyAllowed)) {
+    if (!vote.IsValid(tip_mn_list, onlyVotingKeyAllowed, /*fCheckSignature=*/!fSignatureChecked)) {
         std::ostringstream ostr;
         ostr << "CGovernanceObject::ProcessVote -- Invalid vote"
              << ", MN outpoint = " << vote.GetMasternodeOutpoint().ToStringShort()
@@ -181,18 +200,11 @@ bool CGovernanceObject::ProcessVote(const CDeterministicMNList& tip_mn_list,
         return false;
     }
 
-    if (!mmetaman->AddGovernanceVote(dmn->proTxHash, vote.GetParentHash())) {
-        std::ostringstream ostr;
-        ostr << "CGovernanceObject::ProcessVote -- Unable to add governance vote"
-             << ", MN outpoint = " << vote.GetMasternodeOutpoint().ToStringShort()
-             << ", governance object hash = " << GetHash().ToString();
-        LogPrint(BCLog::GOBJECT, "%s\n", ostr.str());
-        exception = CGovernanceException(ostr.str(), GOVERNANCE_EXCEPTION_PERMANENT_ERROR);
-        return false;
-    }
 
+    TallyVote(int(eSignal), voteInstanceRef.eOutcome, -1);
+    TallyVote(int(eSignal), vote.GetOutcome(), 1);
     voteInstanceRef = vote_instance_t(vote.GetOutcome(), nVoteTimeUpdate, vote.GetTimestamp());
-    fileVotes.AddVote(vote);
+    fileVotes.AddVote(vote, KeepVoteSignatures());
     fDirtyCache = true;
     // SEND NOTIFICATION TO SCRIPT/ZMQ
     GetMainSignals().NotifyGovernanceVote(vote.GetHash());
@@ -207,6 +219,9 @@ void CGovernanceObject::ClearMasternodeVotes(const CDeterministicMNList& tip_mn_
     while (it != mapCurrentMNVotes.end()) {
         if (!tip_mn_list.HasMNByCollateral(it->first)) {
             fileVotes.RemoveVotesFromMasternode(it->first);
+            for (const auto& [nSignal, voteInstance] : it->second.mapInstances) {
+                TallyVote(nSignal, voteInstance.eOutcome, -1);
+            }
             mapCurrentMNVotes.erase(it++);
             fDirtyCache = true;
         } else {
@@ -215,7 +230,8 @@ void CGovernanceObject::ClearMasternodeVotes(const CDeterministicMNList& tip_mn_
     }
 }
 
-std::set<uint256> CGovernanceObject::RemoveInvalidVotes(const CDeterministicMNList& tip_mn_list, const COutPoint& mnOutpoint)
+std::set<uint256> CGovernanceObject::RemoveInvalidVotes(const CDeterministicMNList& tip_mn_list, const COutPoint& mnOutpoint,
+                                                        const CGovernanceObjectVoteFile::signature_loader_t& fnLoadSignature)
 {
     LOCK(cs);
 
@@ -225,7 +241,7 @@ std::set<uint256> CGovernanceObject::RemoveInvalidVotes(const CDeterministicMNLi
         return {};
     }
 
-    auto removedVotes = fileVotes.RemoveInvalidVotes(tip_mn_list, mnOutpoint, GetObjectType() == GOVERNANCE_OBJECT_PROPOSAL);
+    auto removedVotes = fileVotes.RemoveInvalidVotes(tip_mn_list, mnOutpoint, GetObjectType() == GOVERNANCE_OBJECT_PROPOSAL, fnLoadSignature);
     if (removedVotes.empty()) {
         return {};
     }
@@ -235,6 +251,7 @@ std::set<uint256> CGovernanceObject::RemoveInvalidVotes(const CDeterministicMNLi
         CGovernanceVote tmpVote(mnOutpoint, nParentHash, (vote_signal_enum_t)jt->first, jt->second.eOutcome);
         tmpVote.SetTime(jt->second.nCreationTime);
         if (removedVotes.count(tmpVote.GetHash())) {
+            TallyVote(jt->first, jt->second.eOutcome, -1);
             jt = it->second.mapInstances.erase(jt);
         } else {
             ++jt;
@@ -254,6 +271,41 @@ std::set<uint256> CGovernanceObject::RemoveInvalidVotes(const CDeterministicMNLi
     return removedVotes;
 }
 
+bool CGovernanceObject::LoadVote(const CGovernanceVote& vote)
+{
+    LOCK(cs);
+
+    // the db holds no votes that failed validation, only ones a newer vote may have replaced since
+    vote_instance_t& voteInstanceRef = mapCurrentMNVotes[vote.GetMasternodeOutpoint()].mapInstances[int(vote.GetSignal())];
+    if (vote.GetTimestamp() < voteInstanceRef.nCreationTime) {
+        return false;
+    }
+    TallyVote(int(vote.GetSignal()), voteInstanceRef.eOutcome, -1);
+    TallyVote(int(vote.GetSignal()), vote.GetOutcome(), 1);
+    // the time the vote arrived is not stored, its creation time is close enough for the rate check
+    voteInstanceRef = vote_instance_t(vote.GetOutcome(), vote.GetTimestamp(), vote.GetTimestamp());
+    fileVotes.AddVote(vote, KeepVoteSignatures());
+    fDirtyCache = true;
+    return true;
+}
+
+std::optional<uint256> CGovernanceObject::GetCurrentVoteHash(const COutPoint& mnOutpoint, vote_signal_enum_t eSignal) const
+{
+    LOCK(cs);
+
+    const auto it = mapCurrentMNVotes.find(mnOutpoint);
+    if (it == mapCurrentMNVotes.end()) {
+        return std::nullopt;
+    }
+    const auto jt = it->second.mapInstances.find(int(eSignal));
+    if (jt == it->second.mapInstances.end() || jt->second.nCreationTime == 0) {
+        return std::nullopt;
+    }
+    CGovernanceVote tmpVote(mnOutpoint, GetHash(), eSignal, jt->second.eOutcome);
+    tmpVote.SetTime(jt->second.nCreationTime);
+    return tmpVote.GetHash();
+}
+
 uint256 CGovernanceObject::GetHash() const
 {
     return m_obj.GetHash();
@@ -563,19 +615,33 @@ bool CGovernanceObject::IsCollateralValid(ChainstateManager &chainman, std::stri
     return true;
 }
 
-int CGovernanceObject::CountMatchingVotes(vote_signal_enum_t eVoteSignalIn, vote_outcome_enum_t eVoteOutcomeIn) const
+// SYSCOIN the counts are kept up to date as votes come and go, instead of walking the votes of every masternode
+void CGovernanceObject::TallyVote(int nSignal, vote_outcome_enum_t eOutcome, int nDelta)
 {
-    LOCK(cs);
+    AssertLockHeld(cs);
+    if (nSignal <= VOTE_SIGNAL_NONE || nSignal > MAX_SUPPORTED_VOTE_SIGNAL) return;
+    if (eOutcome <= VOTE_OUTCOME_NONE || eOutcome > VOTE_OUTCOME_ABSTAIN) return;
+    m_vote_tally[nSignal][eOutcome] += nDelta;
+}
 
-    int nCount = 0;
-    for (const auto& votepair : mapCurrentMNVotes) {
-        const vote_rec_t& recVote = votepair.second;
-        auto it2 = recVote.mapInstances.find(eVoteSignalIn);
-        if (it2 != recVote.mapInstances.end() && it2->second.eOutcome == eVoteOutcomeIn) {
-            ++nCount;
+void CGovernanceObject::RebuildVoteTally()
+{
+    LOCK(cs);
+    m_vote_tally = {};
+    for (const auto& [outpoint, voteRecord] : mapCurrentMNVotes) {
+        for (const auto& [nSignal, voteInstance] : voteRecord.mapInstances) {
+            TallyVote(nSignal, voteInstance.eOutcome, 1);
         }
     }
-    return nCount;
+}
+
+int CGovernanceObject::CountMatchingVotes(vote_signal_enum_t eVoteSignalIn, vote_outcome_enum_t eVoteOutcomeIn) const
+{
+    LOCK(cs);
+
+    if (eVoteSignalIn <= VOTE_SIGNAL_NONE || eVoteSignalIn > MAX_SUPPORTED_VOTE_SIGNAL) return 0;
+    if (eVoteOutcomeIn <= VOTE_OUTCOME_NONE || eVoteOutcomeIn > VOTE_OUTCOME_ABSTAIN) return 0;
+    return m_vote_tally[eVoteSignalIn][eVoteOutcomeIn];
 }
 
 /**
@@ -14,6 +14,9 @@
 #include <univalue.h>
 #include <kernel/cs_main.h>
 
+#include <array>
+#include <optional>
+
 class CActiveMasternodeManager;
 class CBLSPublicKey;
 class CDeterministicMNList;
@@ -137,8 +140,14 @@ private:
 
     vote_m_t mapCurrentMNVotes;
 
+    /// SYSCOIN count of the current votes per signal and outcome, kept in step with mapCurrentMNVotes
+    std::array<std::array<int, VOTE_OUTCOME_ABSTAIN + 1>, MAX_SUPPORTED_VOTE_SIGNAL + 1> m_vote_tally{};
+
     CGovernanceObjectVoteFile fileVotes;
 
+    void TallyVote(int nSignal, vote_outcome_enum_t eOutcome, int nDelta) EXCLUSIVE_LOCKS_REQUIRED(cs);
+    void RebuildVoteTally();
+
 public:
     CGovernanceObject();
 
@@ -218,6 +227,9 @@ public:
         return fileVotes;
     }
 
+    // SYSCOIN heap memory held by the object data and its votes
+    size_t DynamicMemoryUsage() const;
+
     // Signature related functions
 
     void SetMasternodeOutpoint(const COutPoint& outpoint);
@@ -282,11 +294,25 @@ public:
         if (s.GetType() & SER_DISK) {
             // Only include these for the disk file format
             READWRITE(obj.nDeletionTime, obj.fExpired, obj.mapCurrentMNVotes, obj.fileVotes);
+            SER_READ(obj, obj.RebuildVoteTally());
         }
 
         // AFTER DESERIALIZATION OCCURS, CACHED VARIABLES MUST BE CALCULATED MANUALLY
     }
 
+    // SYSCOIN record of the governance db, which stores the votes separately and rebuilds the vote records from them
+    template <typename Stream>
+    void SerializeWithoutVotes(Stream& s) const
+    {
+        s << m_obj << nDeletionTime << fExpired;
+    }
+
+    template <typename Stream>
+    void UnserializeWithoutVotes(Stream& s)
+    {
+        s >> m_obj >> nDeletionTime >> fExpired;
+    }
+
     UniValue ToJson() const;
 
     // FUNCTIONS FOR DEALING WITH DATA STRING
@@ -294,7 +320,13 @@ public:
     void GetData(UniValue& objResult) const;
 
     bool ProcessVote(const CDeterministicMNList& tip_mn_list,
-                     const CGovernanceVote& vote, CGovernanceException& exception);
+                     const CGovernanceVote& vote, CGovernanceException& exception, bool fSignatureChecked = false);
+
+    /// Add a vote read back from the governance db, false if a newer vote of the masternode for the signal is known
+    bool LoadVote(const CGovernanceVote& vote);
+
+    /// Hash of the vote the masternode currently has for the signal
+    std::optional<uint256> GetCurrentVoteHash(const COutPoint& mnOutpoint, vote_signal_enum_t eSignal) const;
 
     /// Called when MN's which have voted on this object have been removed
     void ClearMasternodeVotes(const CDeterministicMNList& tip_mn_list);
@@ -303,7 +335,8 @@ public:
     // This is the case for DIP3 MNs that changed voting or operator keys and
     // also for MNs that were removed from the list completely.
     // Returns deleted vote hashes.
-    std::set<uint256> RemoveInvalidVotes(const CDeterministicMNList& tip_mn_list, const COutPoint& mnOutpoint);
+    std::set<uint256> RemoveInvalidVotes(const CDeterministicMNList& tip_mn_list, const COutPoint& mnOutpoint,
+                                         const CGovernanceObjectVoteFile::signature_loader_t& fnLoadSignature = nullptr);
 };
 
 
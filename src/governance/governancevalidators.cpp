@@ -69,6 +69,15 @@ bool CProposalValidator::Validate(bool fCheckExpiration)
     return true;
 }
 
+int64_t CProposalValidator::GetEndEpoch()
+{
+    int64_t nEndEpoch = 0;
+    if (!GetDataValue("end_epoch", nEndEpoch)) {
+        return 0;
+    }
+    return nEndEpoch;
+}
+
 bool CProposalValidator::ValidateType()
 {
     int64_t nType;
@@ -27,6 +27,9 @@ public:
         return strErrorMessages;
     }
 
+    /** The end_epoch field, 0 if there is none */
+    int64_t GetEndEpoch();
+
 private:
     void ParseStrHexData(const std::string& strHexData);
     void ParseJSONData(const std::string& strJSONData);
@@ -98,12 +98,14 @@ public:
     }
 
     void SetSignature(const std::vector<unsigned char>& vchSigIn) { vchSig = vchSigIn; }
+    const std::vector<unsigned char>& GetSignature() const { return vchSig; }
 
     bool Sign(const CKey& key, const CKeyID& keyID);
     bool CheckSignature(const CKeyID& keyID) const;
     bool Sign();
     bool CheckSignature(const CBLSPublicKey& pubKey) const;
-    bool IsValid(const CDeterministicMNList& tip_mn_list, bool useVotingKey) const;
+    /** fCheckSignature can only be unset by callers which verified the signature against the same masternode list */
+    bool IsValid(const CDeterministicMNList& tip_mn_list, bool useVotingKey, bool fCheckSignature = true) const;
     void Relay(PeerManager& peerman, const CDeterministicMNList& tip_mn_list) const;
 
     const COutPoint& GetMasternodeOutpoint() const { return masternodeOutpoint; }
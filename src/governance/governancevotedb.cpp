@@ -4,30 +4,15 @@
 
 #include <governance/governancevotedb.h>
 
-CGovernanceObjectVoteFile::CGovernanceObjectVoteFile() :
-    nMemoryVotes(0),
-    listVotes(),
-    mapVoteIndex()
-{
-}
-
-CGovernanceObjectVoteFile::CGovernanceObjectVoteFile(const CGovernanceObjectVoteFile& other) :
-    nMemoryVotes(other.nMemoryVotes),
-    listVotes(other.listVotes),
-    mapVoteIndex()
-{
-    RebuildIndex();
-}
+#include <memusage.h>
 
-void CGovernanceObjectVoteFile::AddVote(const CGovernanceVote& vote)
+void CGovernanceObjectVoteFile::AddVote(const CGovernanceVote& vote, bool fKeepSignature)
 {
     const uint256 nHash = vote.GetHash();
     // make sure to never add/update already known votes
     if (HasVote(nHash))
         return;
-    listVotes.push_front(vote);
-    mapVoteIndex.emplace(nHash, listVotes.begin());
-    ++nMemoryVotes;
+    Append(vote, fKeepSignature);
     RemoveOldVotes(vote);
 }
 
@@ -39,89 +24,140 @@ bool CGovernanceObjectVoteFile::HasVote(const uint256& nHash) const
 bool CGovernanceObjectVoteFile::SerializeVoteToStream(const uint256& nHash, CDataStream& ss) const
 {
     auto it = mapVoteIndex.find(nHash);
-    if (it == mapVoteIndex.end()) {
+    if (it == mapVoteIndex.end() || vecVotes[it->second].vchSig.empty()) {
         return false;
     }
-    ss << *(it->second);
+    ss << ToVote(vecVotes[it->second]);
     return true;
 }
 
+std::optional<CGovernanceVote> CGovernanceObjectVoteFile::GetVote(const uint256& nHash) const
+{
+    auto it = mapVoteIndex.find(nHash);
+    if (it == mapVoteIndex.end()) {
+        return std::nullopt;
+    }
+    return ToVote(vecVotes[it->second]);
+}
+
 std::vector<CGovernanceVote> CGovernanceObjectVoteFile::GetVotes() const
 {
     std::vector<CGovernanceVote> vecResult;
-    vecResult.reserve(listVotes.size());
-    std::copy(std::begin(listVotes), std::end(listVotes), std::back_inserter(vecResult));
+    vecResult.reserve(vecVotes.size());
+    for (const auto& entry : vecVotes) {
+        vecResult.emplace_back(ToVote(entry));
+    }
+    return vecResult;
+}
+
+std::vector<uint256> CGovernanceObjectVoteFile::GetVoteHashes() const
+{
+    std::vector<uint256> vecResult;
+    vecResult.reserve(vecVotes.size());
+    for (const auto& entry : vecVotes) {
+        vecResult.emplace_back(entry.hash);
+    }
     return vecResult;
 }
 
 void CGovernanceObjectVoteFile::RemoveVotesFromMasternode(const COutPoint& outpointMasternode)
 {
-    auto it = listVotes.begin();
-    while (it != listVotes.end()) {
-        if (it->GetMasternodeOutpoint() == outpointMasternode) {
-            --nMemoryVotes;
-            mapVoteIndex.erase(it->GetHash());
-            listVotes.erase(it++);
+    for (uint32_t i = 0; i < vecVotes.size();) {
+        if (vecVotes[i].masternodeOutpoint == outpointMasternode) {
+            Erase(i);
         } else {
-            ++it;
+            ++i;
         }
     }
 }
 
-std::set<uint256> CGovernanceObjectVoteFile::RemoveInvalidVotes(const CDeterministicMNList& tip_mn_list, const COutPoint& outpointMasternode, bool fProposal)
+std::set<uint256> CGovernanceObjectVoteFile::RemoveInvalidVotes(const CDeterministicMNList& tip_mn_list, const COutPoint& outpointMasternode, bool fProposal,
+                                                                const signature_loader_t& fnLoadSignature)
 {
     std::set<uint256> removedVotes;
 
-    auto it = listVotes.begin();
-    while (it != listVotes.end()) {
-        if (it->GetMasternodeOutpoint() == outpointMasternode) {
-            bool useVotingKey = fProposal && (it->GetSignal() == VOTE_SIGNAL_FUNDING);
-            if (!it->IsValid(tip_mn_list, useVotingKey)) {
-                removedVotes.emplace(it->GetHash());
-                --nMemoryVotes;
-                mapVoteIndex.erase(it->GetHash());
-                listVotes.erase(it++);
+    for (uint32_t i = 0; i < vecVotes.size();) {
+        const vote_entry_t& entry = vecVotes[i];
+        if (entry.masternodeOutpoint == outpointMasternode) {
+            CGovernanceVote vote = ToVote(entry);
+            bool useVotingKey = fProposal && (vote.GetSignal() == VOTE_SIGNAL_FUNDING);
+            // a vote whose signature was dropped and can't be read back can't be checked either
+            const bool fHaveSignature = !entry.vchSig.empty() || (fnLoadSignature && fnLoadSignature(vote));
+            if (!fHaveSignature || !vote.IsValid(tip_mn_list, useVotingKey)) {
+                removedVotes.emplace(entry.hash);
+                Erase(i);
                 continue;
             }
         }
-        ++it;
+        ++i;
     }
 
     return removedVotes;
 }
 
+CGovernanceVote CGovernanceObjectVoteFile::ToVote(const vote_entry_t& entry) const
+{
+    CGovernanceVote vote(entry.masternodeOutpoint, nParentHash, vote_signal_enum_t(entry.nVoteSignal), vote_outcome_enum_t(entry.nVoteOutcome));
+    vote.SetTime(entry.nTime);
+    vote.SetSignature(entry.vchSig);
+    return vote;
+}
+
+void CGovernanceObjectVoteFile::Append(const CGovernanceVote& vote, bool fKeepSignature)
+{
+    nParentHash = vote.GetParentHash();
+    mapVoteIndex.emplace(vote.GetHash(), vecVotes.size());
+    UpdateDigest(vote.GetHash());
+    vecVotes.push_back(vote_entry_t{
+        vote.GetHash(),
+        vote.GetMasternodeOutpoint(),
+        vote.GetTimestamp(),
+        uint8_t(vote.GetSignal()),
+        uint8_t(vote.GetOutcome()),
+        fKeepSignature ? vote.GetSignature() : std::vector<unsigned char>{},
+    });
+}
+
+void CGovernanceObjectVoteFile::Erase(uint32_t nIndex)
+{
+    mapVoteIndex.erase(vecVotes[nIndex].hash);
+    UpdateDigest(vecVotes[nIndex].hash);
+    if (nIndex + 1 != vecVotes.size()) {
+        vecVotes[nIndex] = std::move(vecVotes.back());
+        mapVoteIndex[vecVotes[nIndex].hash] = nIndex;
+    }
+    vecVotes.pop_back();
+}
+
 void CGovernanceObjectVoteFile::RemoveOldVotes(const CGovernanceVote& vote)
 {
-    auto it = listVotes.begin();
-    while (it != listVotes.end()) {
-        if (it->GetMasternodeOutpoint() == vote.GetMasternodeOutpoint() // same masternode
-            && it->GetParentHash() == vote.GetParentHash() // same governance object (e.g. same proposal)
-            && it->GetSignal() == vote.GetSignal() // same signal (e.g. "funding", "delete", etc.)
-            && it->GetTimestamp() < vote.GetTimestamp()) // older than new vote
+    for (uint32_t i = 0; i < vecVotes.size();) {
+        const vote_entry_t& entry = vecVotes[i];
+        // all votes of the file are for the same governance object (e.g. same proposal)
+        if (entry.masternodeOutpoint == vote.GetMasternodeOutpoint() // same masternode
+            && entry.nVoteSignal == uint8_t(vote.GetSignal()) // same signal (e.g. "funding", "delete", etc.)
+            && entry.nTime < vote.GetTimestamp()) // older than new vote
         {
-            --nMemoryVotes;
-            mapVoteIndex.erase(it->GetHash());
-            listVotes.erase(it++);
+            Erase(i);
         } else {
-            ++it;
+            ++i;
         }
     }
 }
 
-void CGovernanceObjectVoteFile::RebuildIndex()
+void CGovernanceObjectVoteFile::UpdateDigest(const uint256& nHash)
 {
-    mapVoteIndex.clear();
-    nMemoryVotes = 0;
-    auto it = listVotes.begin();
-    while (it != listVotes.end()) {
-        const CGovernanceVote& vote = *it;
-        const uint256 nHash = vote.GetHash();
-        if (mapVoteIndex.find(nHash) == mapVoteIndex.end()) {
-            mapVoteIndex[nHash] = it;
-            ++nMemoryVotes;
-            ++it;
-        } else {
-            listVotes.erase(it++);
-        }
+    // adding and removing are the same operation
+    for (size_t i = 0; i < nHash.size(); i++) {
+        *(nDigest.begin() + i) ^= *(nHash.begin() + i);
+    }
+}
+
+size_t CGovernanceObjectVoteFile::DynamicMemoryUsage() const
+{
+    size_t usage = memusage::DynamicUsage(vecVotes) + memusage::DynamicUsage(mapVoteIndex);
+    for (const auto& entry : vecVotes) {
+        usage += memusage::DynamicUsage(entry.vchSig);
     }
+    return usage;
 }
@@ -6,16 +6,22 @@
 #define SYSCOIN_GOVERNANCE_GOVERNANCEVOTEDB_H
 
 #include <governance/governancevote.h>
+#include <saltedhasher.h>
 #include <serialize.h>
 #include <streams.h>
 #include <uint256.h>
 
-#include <list>
-#include <map>
+#include <functional>
+#include <optional>
+#include <set>
+#include <unordered_map>
 #include <vector>
 
 class CDeterministicMNList;
 
+/** Whether signatures of accepted votes are dropped from memory, relay reads them back from the governance db */
+static constexpr bool DEFAULT_GOVERNANCE_DROP_VOTE_SIGS{false};
+
 /**
  * Represents the collection of votes associated with a given CGovernanceObject
  * Recently received votes are held in memory until a maximum size is reached after
@@ -27,58 +33,106 @@ class CDeterministicMNList;
 class CGovernanceObjectVoteFile
 {
 public: // Types
-    using vote_l_t = std::list<CGovernanceVote>;
+    /** A vote without the parent hash, which all votes of a file share */
+    struct vote_entry_t {
+        uint256 hash;
+        COutPoint masternodeOutpoint;
+        int64_t nTime;
+        uint8_t nVoteSignal;
+        uint8_t nVoteOutcome;
+        /// empty once dropped from memory
+        std::vector<unsigned char> vchSig;
+    };
+
+    using vote_v_t = std::vector<vote_entry_t>;
 
-    using vote_m_t = std::map<uint256, vote_l_t::iterator>;
+    using vote_m_t = std::unordered_map<uint256, uint32_t, StaticSaltedHasher>;
+
+    /// Read the signature of a vote back from disk, false if it is not there
+    using signature_loader_t = std::function<bool(CGovernanceVote&)>;
 
 private:
-    int nMemoryVotes;
+    uint256 nParentHash;
 
-    vote_l_t listVotes;
+    // SYSCOIN flat storage, vote_m_t maps each vote hash to its position
+    vote_v_t vecVotes;
 
     vote_m_t mapVoteIndex;
 
-public:
-    CGovernanceObjectVoteFile();
-
-    CGovernanceObjectVoteFile(const CGovernanceObjectVoteFile& other);
+    /// XOR of all vote hashes, equal for equal vote sets whatever the order they came in
+    uint256 nDigest;
 
+public:
     /**
-     * Add a vote to the file
+     * Add a vote to the file, its signature is only kept if fKeepSignature is set
      */
-    void AddVote(const CGovernanceVote& vote);
+    void AddVote(const CGovernanceVote& vote, bool fKeepSignature = true);
 
     /**
      * Return true if the vote with this hash is currently cached in memory
      */
     bool HasVote(const uint256& nHash) const;
 
+    /** A vote cached in memory, without its signature if that was dropped */
+    std::optional<CGovernanceVote> GetVote(const uint256& nHash) const;
+
     /**
-     * Retrieve a vote cached in memory
+     * Retrieve a vote cached in memory, false if it is unknown or its signature was dropped
      */
     bool SerializeVoteToStream(const uint256& nHash, CDataStream& ss) const;
 
     int GetVoteCount() const
     {
-        return nMemoryVotes;
+        return vecVotes.size();
     }
 
+    // SYSCOIN heap memory held by the votes of the file
+    size_t DynamicMemoryUsage() const;
+
+    /** Digest of the current vote set, changes whenever a vote is added or removed */
+    const uint256& GetDigest() const { return nDigest; }
+
+    /** All votes, those with a dropped signature come without one */
     std::vector<CGovernanceVote> GetVotes() const;
+    std::vector<uint256> GetVoteHashes() const;
 
     void RemoveVotesFromMasternode(const COutPoint& outpointMasternode);
-    std::set<uint256> RemoveInvalidVotes(const CDeterministicMNList& tip_mn_list, const COutPoint& outpointMasternode, bool fProposal);
+    std::set<uint256> RemoveInvalidVotes(const CDeterministicMNList& tip_mn_list, const COutPoint& outpointMasternode, bool fProposal,
+                                         const signature_loader_t& fnLoadSignature = nullptr);
+
+    template <typename Stream>
+    void Serialize(Stream& s) const
+    {
+        // same format as the list of votes this used to be
+        s << int(vecVotes.size()) << GetVotes();
+    }
 
-    SERIALIZE_METHODS(CGovernanceObjectVoteFile, obj)
+    template <typename Stream>
+    void Unserialize(Stream& s)
     {
-        READWRITE(obj.nMemoryVotes, obj.listVotes);
-        SER_READ(obj, obj.RebuildIndex());
+        int nMemoryVotes;
+        std::vector<CGovernanceVote> votes;
+        s >> nMemoryVotes >> votes;
+        vecVotes.clear();
+        mapVoteIndex.clear();
+        nDigest.SetNull();
+        for (const auto& vote : votes) {
+            if (!HasVote(vote.GetHash())) {
+                Append(vote, /*fKeepSignature=*/true);
+            }
+        }
     }
 
 private:
+    CGovernanceVote ToVote(const vote_entry_t& entry) const;
+    void Append(const CGovernanceVote& vote, bool fKeepSignature);
+    /// Swap the vote with the last one and pop it, the order of the votes carries no meaning
+    void Erase(uint32_t nIndex);
+
     // Drop older votes for the same gobject from the same masternode
     void RemoveOldVotes(const CGovernanceVote& vote);
 
-    void RebuildIndex();
+    void UpdateDigest(const uint256& nHash);
 };
 
 #endif // SYSCOIN_GOVERNANCE_GOVERNANCEVOTEDB_H
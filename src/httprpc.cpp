@@ -8,6 +8,7 @@
 #include <crypto/hmac_sha256.h>
 #include <httpserver.h>
 #include <logging.h>
+#include <rpc/jsonstream.h>
 #include <rpc/protocol.h>
 #include <rpc/server.h>
 #include <util/strencodings.h>
@@ -18,6 +19,7 @@
 #include <iterator>
 #include <map>
 #include <memory>
+#include <optional>
 #include <set>
 #include <string>
 #include <vector>
@@ -71,6 +73,38 @@ static std::vector<std::vector<std::string>> g_rpcauth;
 /* RPC Auth Whitelist */
 static std::map<std::string, std::set<std::string>> g_rpc_whitelist;
 static bool g_rpc_whitelist_default = false;
+// SYSCOIN
+/* Priority class of the methods that do not run at normal priority. Mining and
+ * chainlock calls are time critical, the calls that return large results run low
+ * so they cannot take every worker. */
+static std::map<std::string, HTTPPriority, std::less<>> g_rpc_method_priority;
+static const std::map<std::string, HTTPPriority> DEFAULT_RPC_METHOD_PRIORITY{
+    {"getblocktemplate", HTTPPriority::HIGH},
+    {"submitblock", HTTPPriority::HIGH},
+    {"submitheader", HTTPPriority::HIGH},
+    {"getauxblock", HTTPPriority::HIGH},
+    {"createauxblock", HTTPPriority::HIGH},
+    {"submitauxblock", HTTPPriority::HIGH},
+    {"getmininginfo", HTTPPriority::HIGH},
+    {"getbestblockhash", HTTPPriority::HIGH},
+    {"getbestchainlock", HTTPPriority::HIGH},
+    {"getchainlocks", HTTPPriority::HIGH},
+    {"submitchainlock", HTTPPriority::HIGH},
+    {"verifychainlock", HTTPPriority::HIGH},
+    {"getblock", HTTPPriority::LOW},
+    {"getrawmempool", HTTPPriority::LOW},
+    {"gobject_list", HTTPPriority::LOW},
+    {"gobject_diff", HTTPPriority::LOW},
+    {"masternodelist", HTTPPriority::LOW},
+    {"masternode_list", HTTPPriority::LOW},
+    {"protx_list", HTTPPriority::LOW},
+    {"listnevmblobdata", HTTPPriority::LOW},
+    {"scantxoutset", HTTPPriority::LOW},
+    {"gettxoutsetinfo", HTTPPriority::LOW},
+    {"getblockstats", HTTPPriority::LOW},
+    {"getaddresshistory", HTTPPriority::LOW},
+    {"getaddressutxos", HTTPPriority::LOW},
+};
 
 static void JSONErrorReply(HTTPRequest* req, const UniValue& objError, const UniValue& id)
 {
@@ -144,6 +178,83 @@ static bool RPCAuthorized(const std::string& strAuth, std::string& strAuthUserna
     return multiUserAuthorized(strUserPass);
 }
 
+std::vector<std::string_view> FindRPCMethods(std::string_view body)
+{
+    std::vector<std::string_view> methods;
+    // the next string token, if any, escapes left as they are
+    const auto next_string = [&](size_t& pos) -> std::optional<std::string_view> {
+        while (pos < body.size() && body[pos] != '"') ++pos;
+        if (pos >= body.size()) return std::nullopt;
+        const size_t begin{++pos};
+        while (pos < body.size() && body[pos] != '"') {
+            pos += body[pos] == '\\' ? 2 : 1;
+        }
+        if (pos >= body.size()) return std::nullopt;
+        return body.substr(begin, pos++ - begin);
+    };
+    size_t pos{0};
+    while (const auto token = next_string(pos)) {
+        if (*token != "method") continue;
+        size_t value{pos};
+        while (value < body.size() && (body[value] == ' ' || body[value] == '\t' || body[value] == '\r' || body[value] == '\n')) ++value;
+        if (value >= body.size() || body[value] != ':') continue;
+        ++value;
+        while (value < body.size() && (body[value] == ' ' || body[value] == '\t' || body[value] == '\r' || body[value] == '\n')) ++value;
+        if (value >= body.size() || body[value] != '"') continue;
+        pos = value;
+        if (const auto method = next_string(pos)) methods.push_back(*method);
+    }
+    return methods;
+}
+
+/** Priority class of a set of calls, that of the lowest priority one */
+template <typename Methods>
+static HTTPPriority RPCMethodsPriority(const Methods& methods)
+{
+    std::optional<HTTPPriority> lowest;
+    for (const std::string_view method : methods) {
+        const auto it = g_rpc_method_priority.find(method);
+        const HTTPPriority priority{it != g_rpc_method_priority.end() ? it->second : HTTPPriority::NORMAL};
+        lowest = lowest ? std::max(*lowest, priority) : priority;
+    }
+    return lowest.value_or(HTTPPriority::NORMAL);
+}
+
+/** Priority class of a request and its user when authorized. Runs on the HTTP
+ * event thread, so it only scans the body. */
+static HTTPRequestClass ClassifyJSONRPC(HTTPRequest& req)
+{
+    HTTPRequestClass cls;
+    auto [has_auth, auth] = req.GetHeader("authorization");
+    std::string user;
+    if (has_auth && RPCAuthorized(auth, user)) cls.user = std::move(user);
+    cls.priority = RPCMethodsPriority(FindRPCMethods(req.PeekBody()));
+    return cls;
+}
+
+static bool InitRPCMethodPriority()
+{
+    g_rpc_method_priority.clear();
+    g_rpc_method_priority.insert(DEFAULT_RPC_METHOD_PRIORITY.begin(), DEFAULT_RPC_METHOD_PRIORITY.end());
+    for (const std::string& method_priority : gArgs.GetArgs("-rpcmethodpriority")) {
+        const auto pos{method_priority.rfind(':')};
+        const std::string priority{pos == std::string::npos ? "" : ToLower(method_priority.substr(pos + 1))};
+        HTTPPriority cls;
+        if (priority == "high") {
+            cls = HTTPPriority::HIGH;
+        } else if (priority == "normal") {
+            cls = HTTPPriority::NORMAL;
+        } else if (priority == "low") {
+            cls = HTTPPriority::LOW;
+        } else {
+            LogPrintf("Invalid -rpcmethodpriority argument %s, expected <method>:<high|normal|low>\n", method_priority);
+            return false;
+        }
+        g_rpc_method_priority.insert_or_assign(method_priority.substr(0, pos), cls);
+    }
+    return true;
+}
+
 static bool HTTPReq_JSONRPC(const std::any& context, HTTPRequest* req)
 {
     // JSONRPC handles only POST
@@ -199,10 +310,46 @@ static bool HTTPReq_JSONRPC(const std::any& context, HTTPRequest* req)
                 req->WriteReply(HTTP_FORBIDDEN);
                 return false;
             }
-            UniValue result = tableRPC.execute(jreq);
+            // SYSCOIN the reply is written while the result is produced, once it outgrows
+            // the stream buffer it is sent as a chunked reply
+            bool fChunked{false};
+            JSONStreamWriter stream{[&](Span<const char> chunk) {
+                if (!fChunked) {
+                    req->WriteHeader("Content-Type", "application/json");
+                    req->StartChunkedReply(HTTP_OK);
+                    fChunked = true;
+                }
+                req->WriteReplyChunk(MakeUCharSpan(chunk));
+            }};
+            try {
+                stream.BeginObject();
+                stream.Key("result");
+                jreq.stream = &stream;
+                UniValue result = tableRPC.execute(jreq);
+                jreq.stream = nullptr;
+                // handlers that do not stream return their result
+                if (stream.AwaitingValue()) stream.Value(result);
+                stream.Key("error");
+                stream.Value(NullUniValue);
+                stream.Key("id");
+                stream.Value(jreq.id);
+                stream.EndObject();
+            } catch (...) {
+                jreq.stream = nullptr;
+                if (!fChunked) throw;
+                // the status line is gone already, all that is left is to cut the reply short
+                LogPrintf("RPC %s failed after part of its reply was sent\n", jreq.strMethod);
+                req->EndChunkedReply();
+                return false;
+            }
 
             // Send reply
-            strReply = JSONRPCReply(result, NullUniValue, jreq.id);
+            strReply = stream.TakeBuffer() + "\n";
+            if (fChunked) {
+                req->WriteReplyChunk(MakeUCharSpan(strReply));
+                req->EndChunkedReply();
+                return true;
+            }
 
         // array of requests
         } else if (valRequest.isArray()) {
@@ -222,7 +369,18 @@ static bool HTTPReq_JSONRPC(const std::any& context, HTTPRequest* req)
                     }
                 }
             }
-            strReply = JSONRPCExecBatch(jreq, valRequest.get_array());
+            // SYSCOIN batch elements are spread over idle workers, queued like the batch
+            HTTPRequestClass cls;
+            cls.user = jreq.authUser;
+            std::vector<std::string> methods;
+            for (unsigned int reqIdx = 0; reqIdx < valRequest.size(); reqIdx++) {
+                const UniValue& method = valRequest[reqIdx].isObject() ? valRequest[reqIdx].find_value("method") : NullUniValue;
+                if (method.isStr()) methods.push_back(method.get_str());
+            }
+            cls.priority = RPCMethodsPriority(methods);
+            const auto spawn = [&cls](std::function<void()> work) { return QueueHTTPWork(std::move(work), cls); };
+            const size_t max_helpers = std::max<int64_t>(gArgs.GetIntArg("-rpcthreads", DEFAULT_HTTP_THREADS) - 1, 0);
+            strReply = JSONRPCExecBatch(jreq, valRequest.get_array(), spawn, max_helpers);
         }
         else
             throw JSONRPCError(RPC_PARSE_ERROR, "Top-level object parse error");
@@ -297,11 +455,14 @@ bool StartHTTPRPC(const std::any& context)
     LogPrint(BCLog::RPC, "Starting HTTP RPC server\n");
     if (!InitRPCAuthentication())
         return false;
+    // SYSCOIN
+    if (!InitRPCMethodPriority())
+        return false;
 
     auto handle_rpc = [context](HTTPRequest* req, const std::string&) { return HTTPReq_JSONRPC(context, req); };
-    RegisterHTTPHandler("/", true, handle_rpc);
+    RegisterHTTPHandler("/", true, handle_rpc, ClassifyJSONRPC);
     if (g_wallet_init_interface.HasWalletSupport()) {
-        RegisterHTTPHandler("/wallet/", false, handle_rpc);
+        RegisterHTTPHandler("/wallet/", false, handle_rpc, ClassifyJSONRPC);
     }
     struct event_base* eventBase = EventBase();
     assert(eventBase);
@@ -6,6 +6,8 @@
 #define SYSCOIN_HTTPRPC_H
 
 #include <any>
+#include <string_view>
+#include <vector>
 
 /** Start HTTP RPC subsystem.
  * Precondition; HTTP and RPC has been started.
@@ -19,6 +21,13 @@ void InterruptHTTPRPC();
  */
 void StopHTTPRPC();
 
+// SYSCOIN
+/** Names of the methods called by a JSON-RPC request or batch body, found by a
+ * scan for "method" keys rather than a full parse. Used to queue requests by
+ * priority before they are parsed.
+ */
+std::vector<std::string_view> FindRPCMethods(std::string_view body);
+
 /** Start HTTP REST subsystem.
  * Precondition; HTTP and RPC has been started.
  */
@@ -22,10 +22,12 @@
 #include <util/threadnames.h>
 #include <util/translation.h>
 
+#include <array>
 #include <condition_variable>
 #include <cstdio>
 #include <cstdlib>
 #include <deque>
+#include <map>
 #include <memory>
 #include <optional>
 #include <string>
@@ -67,19 +69,90 @@ private:
     HTTPRequestHandler func;
 };
 
+// SYSCOIN
+/** Work other than a request, run on an HTTP worker thread */
+class HTTPWorkFunction final : public HTTPClosure
+{
+public:
+    explicit HTTPWorkFunction(std::function<void()> func) : m_func(std::move(func)) {}
+    void operator()() override { m_func(); }
+
+private:
+    const std::function<void()> m_func;
+};
+
 /** Simple work queue for distributing work over multiple threads.
  * Work items are simply callable objects.
+ * SYSCOIN Items are queued per priority class and run oldest first within a
+ * class. Workers can be reserved for high priority items or for the items of one
+ * user, those users get queues of their own. Low priority items are kept off one
+ * of the general workers so they cannot hold up everything else.
  */
 template <typename WorkItem>
 class WorkQueue
 {
+public:
+    /** The items a worker runs */
+    struct WorkerRole {
+        //! only high priority items
+        bool priority_only{false};
+        //! only the items of this user, if set
+        std::optional<std::string> user;
+    };
+
 private:
+    struct Entry {
+        std::unique_ptr<WorkItem> item;
+        uint64_t seq;
+    };
+    static constexpr size_t NUM_PRIORITIES{3};
+    using Queues = std::array<std::deque<Entry>, NUM_PRIORITIES>;
+
     Mutex cs;
     std::condition_variable cond GUARDED_BY(cs);
-    std::deque<std::unique_ptr<WorkItem>> queue GUARDED_BY(cs);
+    Queues queue GUARDED_BY(cs);
+    //! queues of the users with reserved workers
+    std::map<std::string, Queues> user_queues GUARDED_BY(cs);
+    uint64_t m_seq GUARDED_BY(cs){0};
+    size_t m_general_workers GUARDED_BY(cs){0};
+    //! low priority items being run by general workers
+    size_t m_running_low GUARDED_BY(cs){0};
     bool running GUARDED_BY(cs){true};
     const size_t maxDepth;
 
+    /** Queue of priority p holding the oldest item a worker of role may run, if any */
+    std::deque<Entry>* Oldest(const WorkerRole& role, size_t p) EXCLUSIVE_LOCKS_REQUIRED(cs)
+    {
+        std::deque<Entry>* best{nullptr};
+        const auto consider = [&](std::deque<Entry>& q) {
+            if (!q.empty() && (!best || q.front().seq < best->front().seq)) best = &q;
+        };
+        if (role.user) {
+            const auto it = user_queues.find(*role.user);
+            if (it != user_queues.end()) consider(it->second[p]);
+            return best;
+        }
+        consider(queue[p]);
+        for (auto& [user, queues] : user_queues) consider(queues[p]);
+        return best;
+    }
+
+    std::unique_ptr<WorkItem> Pick(const WorkerRole& role, bool& low) EXCLUSIVE_LOCKS_REQUIRED(cs)
+    {
+        for (size_t p = 0; p < NUM_PRIORITIES; ++p) {
+            if (role.priority_only && p != size_t(HTTPPriority::HIGH)) break;
+            std::deque<Entry>* q = Oldest(role, p);
+            if (!q) continue;
+            low = p == size_t(HTTPPriority::LOW) && !role.user;
+            if (low && m_general_workers > 1 && m_running_low + 1 >= m_general_workers) break;
+            std::unique_ptr<WorkItem> item{std::move(q->front().item)};
+            q->pop_front();
+            if (low) ++m_running_low;
+            return item;
+        }
+        return nullptr;
+    }
+
 public:
     explicit WorkQueue(size_t _maxDepth) : maxDepth(_maxDepth)
     {
@@ -87,32 +160,48 @@ public:
     /** Precondition: worker threads have all stopped (they have been joined).
      */
     ~WorkQueue() = default;
+    /** Give user a queue of its own, call before workers of its role start */
+    void ReserveUser(const std::string& user) EXCLUSIVE_LOCKS_REQUIRED(!cs)
+    {
+        LOCK(cs);
+        user_queues.try_emplace(user);
+    }
     /** Enqueue a work item */
-    bool Enqueue(WorkItem* item) EXCLUSIVE_LOCKS_REQUIRED(!cs)
+    bool Enqueue(WorkItem* item, const HTTPRequestClass& cls) EXCLUSIVE_LOCKS_REQUIRED(!cs)
     {
         LOCK(cs);
-        if (!running || queue.size() >= maxDepth) {
+        const auto it = user_queues.find(cls.user);
+        std::deque<Entry>& q = (it != user_queues.end() ? it->second : queue)[size_t(cls.priority)];
+        if (!running || q.size() >= maxDepth) {
             return false;
         }
-        queue.emplace_back(std::unique_ptr<WorkItem>(item));
-        cond.notify_one();
+        q.push_back(Entry{std::unique_ptr<WorkItem>(item), m_seq++});
+        // workers differ in what they take, so all of them get to look
+        cond.notify_all();
         return true;
     }
     /** Thread function */
-    void Run() EXCLUSIVE_LOCKS_REQUIRED(!cs)
+    void Run(const WorkerRole& role) EXCLUSIVE_LOCKS_REQUIRED(!cs)
     {
+        const bool general{!role.priority_only && !role.user};
+        if (general) WITH_LOCK(cs, ++m_general_workers);
         while (true) {
             std::unique_ptr<WorkItem> i;
+            bool low{false};
             {
                 WAIT_LOCK(cs, lock);
-                while (running && queue.empty())
+                while (!(i = Pick(role, low))) {
+                    // items left to other workers are run by them before they exit
+                    if (!running) return;
                     cond.wait(lock);
-                if (!running && queue.empty())
-                    break;
-                i = std::move(queue.front());
-                queue.pop_front();
+                }
             }
             (*i)();
+            if (low) {
+                LOCK(cs);
+                --m_running_low;
+                cond.notify_all();
+            }
         }
     }
     /** Interrupt and exit loops */
@@ -126,13 +215,15 @@ public:
 
 struct HTTPPathHandler
 {
-    HTTPPathHandler(std::string _prefix, bool _exactMatch, HTTPRequestHandler _handler):
-        prefix(_prefix), exactMatch(_exactMatch), handler(_handler)
+    // SYSCOIN
+    HTTPPathHandler(std::string _prefix, bool _exactMatch, HTTPRequestHandler _handler, HTTPRequestClassifier _classifier):
+        prefix(_prefix), exactMatch(_exactMatch), handler(_handler), classifier(_classifier)
     {
     }
     std::string prefix;
     bool exactMatch;
     HTTPRequestHandler handler;
+    HTTPRequestClassifier classifier;
 };
 
 /** HTTP module state */
@@ -148,6 +239,9 @@ static std::unique_ptr<WorkQueue<HTTPClosure>> g_work_queue{nullptr};
 //! Handlers for (sub)paths
 static GlobalMutex g_httppathhandlers_mutex;
 static std::vector<HTTPPathHandler> pathHandlers GUARDED_BY(g_httppathhandlers_mutex);
+// SYSCOIN
+//! users and the number of workers reserved for them, from -rpcuserthreads
+static std::vector<std::pair<std::string, int>> g_http_user_threads;
 //! Bound listening sockets
 static std::vector<evhttp_bound_socket *> boundSockets;
 
@@ -326,9 +420,11 @@ static void http_request_cb(struct evhttp_request* req, void* arg)
 
     // Dispatch to worker thread
     if (i != iend) {
+        // SYSCOIN
+        const HTTPRequestClass cls{i->classifier ? i->classifier(*hreq) : HTTPRequestClass{}};
         std::unique_ptr<HTTPWorkItem> item(new HTTPWorkItem(std::move(hreq), path, i->handler));
         assert(g_work_queue);
-        if (g_work_queue->Enqueue(item.get())) {
+        if (g_work_queue->Enqueue(item.get(), cls)) {
             item.release(); /* if true, queue took ownership */
         } else {
             LogPrintf("WARNING: request rejected because http work queue depth exceeded, it can be increased with the -rpcworkqueue= setting\n");
@@ -399,10 +495,10 @@ static bool HTTPBindAddresses(struct evhttp* http)
 }
 
 /** Simple wrapper to set thread name and run work queue */
-static void HTTPWorkQueueRun(WorkQueue<HTTPClosure>* queue, int worker_num)
+static void HTTPWorkQueueRun(WorkQueue<HTTPClosure>* queue, int worker_num, WorkQueue<HTTPClosure>::WorkerRole role)
 {
     util::ThreadRename(strprintf("httpworker.%i", worker_num));
-    queue->Run();
+    queue->Run(role);
 }
 
 /** libevent event log callback */
@@ -467,6 +563,19 @@ bool InitHTTPServer()
     LogPrintfCategory(BCLog::HTTP, "creating work queue of depth %d\n", workQueueDepth);
 
     g_work_queue = std::make_unique<WorkQueue<HTTPClosure>>(workQueueDepth);
+    // SYSCOIN
+    g_http_user_threads.clear();
+    for (const std::string& user_threads : gArgs.GetArgs("-rpcuserthreads")) {
+        const auto pos{user_threads.rfind(':')};
+        const auto n_threads{pos == std::string::npos ? std::nullopt : ToIntegral<int>(user_threads.substr(pos + 1))};
+        if (pos == 0 || !n_threads || *n_threads < 1) {
+            LogPrintf("Invalid -rpcuserthreads argument %s, expected <user>:<n>\n", user_threads);
+            return false;
+        }
+        const std::string user{user_threads.substr(0, pos)};
+        g_work_queue->ReserveUser(user);
+        g_http_user_threads.emplace_back(user, *n_threads);
+    }
     // transfer ownership to eventBase/HTTP via .release()
     eventBase = base_ctr.release();
     eventHTTP = http_ctr.release();
@@ -492,8 +601,20 @@ void StartHTTPServer()
     g_thread_http = std::thread(ThreadHTTP, eventBase);
 
     for (int i = 0; i < rpcThreads; i++) {
-        g_thread_http_workers.emplace_back(HTTPWorkQueueRun, g_work_queue.get(), i);
+        g_thread_http_workers.emplace_back(HTTPWorkQueueRun, g_work_queue.get(), i, WorkQueue<HTTPClosure>::WorkerRole{});
+    }
+    // SYSCOIN workers kept for high priority requests and for users with reserved threads
+    int worker_num{rpcThreads};
+    const int priority_threads = std::max((long)gArgs.GetIntArg("-rpcprioritythreads", DEFAULT_HTTP_PRIORITY_THREADS), 0L);
+    for (int i = 0; i < priority_threads; i++) {
+        g_thread_http_workers.emplace_back(HTTPWorkQueueRun, g_work_queue.get(), worker_num++, WorkQueue<HTTPClosure>::WorkerRole{.priority_only = true, .user = std::nullopt});
     }
+    for (const auto& [user, n_threads] : g_http_user_threads) {
+        for (int i = 0; i < n_threads; i++) {
+            g_thread_http_workers.emplace_back(HTTPWorkQueueRun, g_work_queue.get(), worker_num++, WorkQueue<HTTPClosure>::WorkerRole{.priority_only = false, .user = user});
+        }
+    }
+    LogPrintfCategory(BCLog::HTTP, "started %d high priority and %d reserved user worker threads\n", priority_threads, worker_num - rpcThreads - priority_threads);
 }
 
 void InterruptHTTPServer()
@@ -586,6 +707,10 @@ HTTPRequest::HTTPRequest(struct evhttp_request* _req, bool _replySent) : req(_re
 
 HTTPRequest::~HTTPRequest()
 {
+    // SYSCOIN a chunked reply that was started is always completed, libevent frees the request then
+    if (m_chunked && !replySent) {
+        EndChunkedReply();
+    }
     if (!replySent) {
         // Keep track of whether reply was sent to avoid request leaks
         LogPrintf("%s: Unhandled request\n", __func__);
@@ -625,6 +750,20 @@ std::string HTTPRequest::ReadBody()
     return rv;
 }
 
+// SYSCOIN
+std::string_view HTTPRequest::PeekBody()
+{
+    struct evbuffer* buf = evhttp_request_get_input_buffer(req);
+    if (!buf)
+        return {};
+    const size_t size = evbuffer_get_length(buf);
+    // linearizes the buffer without draining it, ReadBody still gets the whole body
+    const char* data = (const char*)evbuffer_pullup(buf, size);
+    if (!data)
+        return {};
+    return {data, size};
+}
+
 void HTTPRequest::WriteHeader(const std::string& hdr, const std::string& value)
 {
     struct evkeyvalq* headers = evhttp_request_get_output_headers(req);
@@ -638,6 +777,12 @@ void HTTPRequest::WriteHeader(const std::string& hdr, const std::string& value)
  * this cannot be done from worker threads.
  */
 void HTTPRequest::WriteReply(int nStatus, const std::string& strReply)
+{
+    // SYSCOIN
+    WriteReply(nStatus, MakeUCharSpan(strReply));
+}
+
+void HTTPRequest::WriteReply(int nStatus, Span<const uint8_t> reply)
 {
     assert(!replySent && req);
     if (ShutdownRequested()) {
@@ -646,7 +791,7 @@ void HTTPRequest::WriteReply(int nStatus, const std::string& strReply)
     // Send event to main http thread to send reply message
     struct evbuffer* evb = evhttp_request_get_output_buffer(req);
     assert(evb);
-    evbuffer_add(evb, strReply.data(), strReply.size());
+    evbuffer_add(evb, reply.data(), reply.size());
     auto req_copy = req;
     HTTPEvent* ev = new HTTPEvent(eventBase, true, [req_copy, nStatus]{
         evhttp_send_reply(req_copy, nStatus, nullptr, nullptr);
@@ -667,6 +812,62 @@ void HTTPRequest::WriteReply(int nStatus, const std::string& strReply)
     req = nullptr; // transferred back to main thread
 }
 
+// SYSCOIN
+void HTTPRequest::StartChunkedReply(int nStatus)
+{
+    assert(!replySent && !m_chunked && req);
+    if (ShutdownRequested()) {
+        WriteHeader("Connection", "close");
+    }
+    auto req_copy = req;
+    HTTPEvent* ev = new HTTPEvent(eventBase, true, [req_copy, nStatus]{
+        evhttp_send_reply_start(req_copy, nStatus, nullptr);
+    });
+    ev->trigger(nullptr);
+    m_chunked = true;
+}
+
+void HTTPRequest::WriteReplyChunk(Span<const uint8_t> chunk)
+{
+    assert(m_chunked && !replySent && req);
+    if (chunk.empty()) return;
+    // the chunk is copied here, the event may run after the caller reused its buffer
+    struct evbuffer* evb = evbuffer_new();
+    assert(evb);
+    evbuffer_add(evb, chunk.data(), chunk.size());
+    auto req_copy = req;
+    HTTPEvent* ev = new HTTPEvent(eventBase, true, [req_copy, evb]{
+        // events are run in the order they were triggered, so chunks keep their order.
+        // If the client went away libevent detached the request and drops the chunk.
+        evhttp_send_reply_chunk(req_copy, evb);
+        evbuffer_free(evb);
+    });
+    ev->trigger(nullptr);
+}
+
+void HTTPRequest::EndChunkedReply()
+{
+    assert(m_chunked && !replySent && req);
+    auto req_copy = req;
+    HTTPEvent* ev = new HTTPEvent(eventBase, true, [req_copy]{
+        // Re-enable reading from the socket, as in WriteReply. This is done before
+        // the end of the reply, which may free the request and its connection.
+        if (event_get_version_number() >= 0x02010600 && event_get_version_number() < 0x02010900) {
+            evhttp_connection* conn = evhttp_request_get_connection(req_copy);
+            if (conn) {
+                bufferevent* bev = evhttp_connection_get_bufferevent(conn);
+                if (bev) {
+                    bufferevent_enable(bev, EV_READ | EV_WRITE);
+                }
+            }
+        }
+        evhttp_send_reply_end(req_copy);
+    });
+    ev->trigger(nullptr);
+    replySent = true;
+    req = nullptr; // transferred back to main thread
+}
+
 CService HTTPRequest::GetPeer() const
 {
     evhttp_connection* con = evhttp_request_get_connection(req);
@@ -742,11 +943,21 @@ std::optional<std::string> GetQueryParameterFromUri(const char* uri, const std::
     return result;
 }
 
-void RegisterHTTPHandler(const std::string &prefix, bool exactMatch, const HTTPRequestHandler &handler)
+void RegisterHTTPHandler(const std::string &prefix, bool exactMatch, const HTTPRequestHandler &handler, const HTTPRequestClassifier& classifier)
 {
     LogPrint(BCLog::HTTP, "Registering HTTP handler for %s (exactmatch %d)\n", prefix, exactMatch);
     LOCK(g_httppathhandlers_mutex);
-    pathHandlers.emplace_back(prefix, exactMatch, handler);
+    pathHandlers.emplace_back(prefix, exactMatch, handler, classifier);
+}
+
+// SYSCOIN
+bool QueueHTTPWork(std::function<void()> work, const HTTPRequestClass& cls)
+{
+    if (!g_work_queue) return false;
+    auto item = std::make_unique<HTTPWorkFunction>(std::move(work));
+    if (!g_work_queue->Enqueue(item.get(), cls)) return false;
+    item.release(); // the queue owns it now
+    return true;
 }
 
 void UnregisterHTTPHandler(const std::string &prefix, bool exactMatch)
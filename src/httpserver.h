@@ -5,13 +5,18 @@
 #ifndef SYSCOIN_HTTPSERVER_H
 #define SYSCOIN_HTTPSERVER_H
 
+#include <span.h>
+
 #include <functional>
 #include <optional>
 #include <string>
+#include <string_view>
 
 static const int DEFAULT_HTTP_THREADS=4;
 static const int DEFAULT_HTTP_WORKQUEUE=16;
 static const int DEFAULT_HTTP_SERVER_TIMEOUT=30;
+// SYSCOIN
+static const int DEFAULT_HTTP_PRIORITY_THREADS=1;
 
 struct evhttp_request;
 struct event_base;
@@ -37,13 +42,37 @@ void UpdateHTTPServerLogging(bool enable);
 
 /** Handler for requests to a certain HTTP path */
 typedef std::function<bool(HTTPRequest* req, const std::string &)> HTTPRequestHandler;
+
+// SYSCOIN
+/** Scheduling class of a request in the HTTP work queue */
+enum class HTTPPriority {
+    HIGH,   //!< also run by the -rpcprioritythreads workers
+    NORMAL,
+    LOW,    //!< never occupies every general worker
+};
+
+/** Where a request is queued, decided on the event thread before it is handled */
+struct HTTPRequestClass {
+    HTTPPriority priority{HTTPPriority::NORMAL};
+    //! the user the request claims to come from, for -rpcuserthreads. The handler checks the credentials.
+    std::string user;
+};
+
+/** Classifier of the requests to a certain HTTP path, runs on the event thread so it must be cheap */
+typedef std::function<HTTPRequestClass(HTTPRequest& req)> HTTPRequestClassifier;
+
 /** Register handler for prefix.
  * If multiple handlers match a prefix, the first-registered one will
- * be invoked.
+ * be invoked. Requests are queued as NORMAL unless a classifier is given.
  */
-void RegisterHTTPHandler(const std::string &prefix, bool exactMatch, const HTTPRequestHandler &handler);
+void RegisterHTTPHandler(const std::string &prefix, bool exactMatch, const HTTPRequestHandler &handler, const HTTPRequestClassifier& classifier = {});
 /** Unregister handler for prefix */
 void UnregisterHTTPHandler(const std::string &prefix, bool exactMatch);
+// SYSCOIN
+/** Run work on an HTTP worker thread, queued like a request of class cls.
+ * Returns false when the server is stopping or the queue is full.
+ */
+bool QueueHTTPWork(std::function<void()> work, const HTTPRequestClass& cls);
 
 /** Return evhttp event base. This can be used by submodules to
  * queue timers or custom events.
@@ -58,6 +87,8 @@ class HTTPRequest
 private:
     struct evhttp_request* req;
     bool replySent;
+    // SYSCOIN
+    bool m_chunked{false};
 
 public:
     explicit HTTPRequest(struct evhttp_request* req, bool replySent = false);
@@ -108,6 +139,12 @@ public:
      */
     std::string ReadBody();
 
+    // SYSCOIN
+    /**
+     * Request body without consuming it, valid until the body is read.
+     */
+    std::string_view PeekBody();
+
     /**
      * Write output header.
      *
@@ -124,6 +161,18 @@ public:
      * main thread, do not call any other HTTPRequest methods after calling this.
      */
     void WriteReply(int nStatus, const std::string& strReply = "");
+    // SYSCOIN
+    /** Write an HTTP reply with a binary body, copied once into the output buffer. */
+    void WriteReply(int nStatus, Span<const uint8_t> reply);
+
+    /**
+     * Start a chunked HTTP reply with status nStatus, for bodies written while they
+     * are produced. Write headers before, then the body with WriteReplyChunk, and
+     * complete it with EndChunkedReply.
+     */
+    void StartChunkedReply(int nStatus);
+    void WriteReplyChunk(Span<const uint8_t> chunk);
+    void EndChunkedReply();
 };
 
 /** Get the query parameter value from request uri for a specified key, or std::nullopt if the key
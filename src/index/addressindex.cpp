@@ -0,0 +1,367 @@
+// Copyright (c) 2024 The Syscoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <index/addressindex.h>
+
+#include <common/args.h>
+#include <hash.h>
+#include <logging.h>
+#include <node/blockstorage.h>
+#include <serialize.h>
+#include <undo.h>
+#include <validation.h>
+
+static constexpr uint8_t DB_ADDRESS_HISTORY{'h'};
+static constexpr uint8_t DB_ADDRESS_UNSPENT{'u'};
+static constexpr uint8_t DB_ADDRESS_BALANCE{'b'};
+
+std::unique_ptr<AddressIndex> g_address_index;
+
+namespace {
+
+uint160 ScriptHash(const CScript& scriptPubKey)
+{
+    return Hash160(scriptPubKey);
+}
+
+// big endian so keys of one script and asset are contiguous and sorted by height
+template <typename Stream>
+void WriteKeyPrefix(Stream& s, uint8_t prefix, const uint160& hash, uint64_t nAsset)
+{
+    ser_writedata8(s, prefix);
+    s << hash;
+    ser_writedata32be(s, nAsset >> 32);
+    ser_writedata32be(s, nAsset & 0xffffffff);
+}
+
+template <typename Stream>
+void ReadKeyPrefix(Stream& s, uint8_t prefix, uint160& hash, uint64_t& nAsset)
+{
+    if (ser_readdata8(s) != prefix) {
+        throw std::ios_base::failure("Invalid format for addressindex DB key");
+    }
+    s >> hash;
+    nAsset = uint64_t{ser_readdata32be(s)} << 32;
+    nAsset |= ser_readdata32be(s);
+}
+
+struct DBHistoryKey {
+    uint160 hash;
+    uint64_t nAsset{0};
+    int nHeight{0};
+    uint256 txid;
+    uint32_t nIndex{0};
+    bool fSpending{false};
+
+    DBHistoryKey() = default;
+    //! the first key of the script and asset at nHeight
+    DBHistoryKey(const uint160& hashIn, uint64_t nAssetIn, int nHeightIn) :
+        hash(hashIn), nAsset(nAssetIn), nHeight(nHeightIn) {}
+    DBHistoryKey(const uint160& hashIn, uint64_t nAssetIn, int nHeightIn, const uint256& txidIn, uint32_t nIndexIn, bool fSpendingIn) :
+        hash(hashIn), nAsset(nAssetIn), nHeight(nHeightIn), txid(txidIn), nIndex(nIndexIn), fSpending(fSpendingIn) {}
+
+    template <typename Stream>
+    void Serialize(Stream& s) const
+    {
+        WriteKeyPrefix(s, DB_ADDRESS_HISTORY, hash, nAsset);
+        ser_writedata32be(s, nHeight);
+        s << txid;
+        ser_writedata32be(s, nIndex);
+        ser_writedata8(s, fSpending);
+    }
+
+    template <typename Stream>
+    void Unserialize(Stream& s)
+    {
+        ReadKeyPrefix(s, DB_ADDRESS_HISTORY, hash, nAsset);
+        nHeight = ser_readdata32be(s);
+        s >> txid;
+        nIndex = ser_readdata32be(s);
+        fSpending = ser_readdata8(s) != 0;
+    }
+};
+
+struct DBUnspentKey {
+    uint160 hash;
+    uint64_t nAsset{0};
+    int nHeight{0};
+    COutPoint outpoint{uint256(), 0};
+
+    DBUnspentKey() = default;
+    //! the first key of the script and asset at nHeight
+    DBUnspentKey(const uint160& hashIn, uint64_t nAssetIn, int nHeightIn) :
+        hash(hashIn), nAsset(nAssetIn), nHeight(nHeightIn) {}
+    DBUnspentKey(const uint160& hashIn, uint64_t nAssetIn, int nHeightIn, const COutPoint& outpointIn) :
+        hash(hashIn), nAsset(nAssetIn), nHeight(nHeightIn), outpoint(outpointIn) {}
+
+    template <typename Stream>
+    void Serialize(Stream& s) const
+    {
+        WriteKeyPrefix(s, DB_ADDRESS_UNSPENT, hash, nAsset);
+        ser_writedata32be(s, nHeight);
+        s << outpoint;
+    }
+
+    template <typename Stream>
+    void Unserialize(Stream& s)
+    {
+        ReadKeyPrefix(s, DB_ADDRESS_UNSPENT, hash, nAsset);
+        nHeight = ser_readdata32be(s);
+        s >> outpoint;
+    }
+};
+
+struct DBUnspentValue {
+    CAmount nValue{0};
+    CAmount nAssetValue{0};
+
+    SERIALIZE_METHODS(DBUnspentValue, obj) { READWRITE(obj.nValue, obj.nAssetValue); }
+};
+
+struct DBBalanceKey {
+    uint160 hash;
+    uint64_t nAsset{0};
+
+    DBBalanceKey() = default;
+    DBBalanceKey(const uint160& hashIn, uint64_t nAssetIn) : hash(hashIn), nAsset(nAssetIn) {}
+
+    template <typename Stream>
+    void Serialize(Stream& s) const { WriteKeyPrefix(s, DB_ADDRESS_BALANCE, hash, nAsset); }
+
+    template <typename Stream>
+    void Unserialize(Stream& s) { ReadKeyPrefix(s, DB_ADDRESS_BALANCE, hash, nAsset); }
+};
+
+struct DBBalanceValue {
+    CAmount nBalance{0};
+    CAmount nReceived{0};
+
+    SERIALIZE_METHODS(DBBalanceValue, obj) { READWRITE(obj.nBalance, obj.nReceived); }
+};
+
+/**
+ * Call fn with the cursor on every key of the script within the asset and heights of
+ * query, after skipping query.nSkip of them, until fn returns false. Without an asset
+ * the heights are applied to each asset of the script in turn.
+ */
+template <typename Key, typename Fn>
+void ForEachKeyInRange(CDBWrapper& db, const uint160& hash, const AddressIndexQuery& query, Fn&& fn)
+{
+    std::unique_ptr<CDBIterator> pcursor(db.NewIterator());
+    pcursor->Seek(Key{hash, query.nAsset.value_or(0), query.nStartHeight});
+    size_t nSkip{query.nSkip};
+    Key key;
+    while (pcursor->Valid() && pcursor->GetKey(key) && key.hash == hash) {
+        if (query.nAsset && key.nAsset != *query.nAsset) break;
+        if (key.nHeight < query.nStartHeight) {
+            pcursor->Seek(Key{hash, key.nAsset, query.nStartHeight});
+            continue;
+        }
+        if (key.nHeight > query.nEndHeight) {
+            if (query.nAsset || key.nAsset == std::numeric_limits<uint64_t>::max()) break;
+            pcursor->Seek(Key{hash, key.nAsset + 1, query.nStartHeight});
+            continue;
+        }
+        if (nSkip > 0) {
+            --nSkip;
+        } else if (!fn(key, *pcursor)) {
+            break;
+        }
+        pcursor->Next();
+    }
+}
+
+} // namespace
+
+/** Access to the address index database (indexes/addressindex/) */
+class AddressIndex::DB : public BaseIndex::DB
+{
+public:
+    explicit DB(size_t n_cache_size, bool f_memory = false, bool f_wipe = false);
+};
+
+AddressIndex::DB::DB(size_t n_cache_size, bool f_memory, bool f_wipe) :
+    BaseIndex::DB(gArgs.GetDataDirNet() / "indexes" / "addressindex", n_cache_size, f_memory, f_wipe)
+{}
+
+AddressIndex::AddressIndex(std::unique_ptr<interfaces::Chain> chain, size_t n_cache_size, bool f_memory, bool f_wipe)
+    : BaseIndex(std::move(chain), "addressindex"), m_db(std::make_unique<AddressIndex::DB>(n_cache_size, f_memory, f_wipe))
+{}
+
+AddressIndex::~AddressIndex() = default;
+
+void AddressIndex::ApplyBlock(CDBBatch& batch, const CBlock& block, const CBlockUndo& block_undo, int nHeight, bool fDisconnect, BalanceDeltas& deltas) const
+{
+    auto record = [&](const uint160& hash, uint64_t nAsset, const uint256& txid, uint32_t nIndex, bool fSpending, CAmount nAmount) {
+        const DBHistoryKey key{hash, nAsset, nHeight, txid, nIndex, fSpending};
+        AddressIndexBalance& delta{deltas[{hash, nAsset}]};
+        if (fDisconnect) {
+            batch.Erase(key);
+            nAmount = -nAmount;
+        } else {
+            batch.Write(key, nAmount);
+        }
+        delta.nBalance += nAmount;
+        if (!fSpending) delta.nReceived += nAmount;
+    };
+    // on disconnect transactions are undone last to first so an output created
+    // and spent within the block ends up erased either way
+    for (size_t k = 0; k < block.vtx.size(); ++k) {
+        const size_t i = fDisconnect ? block.vtx.size() - 1 - k : k;
+        const auto& tx{block.vtx[i]};
+        const uint256& txid{tx->GetHash()};
+        auto spend = [&] {
+            // the coinbase tx has no undo data since no former output is spent
+            if (tx->IsCoinBase()) return;
+            const CTxUndo& tx_undo{block_undo.vtxundo.at(i - 1)};
+            for (uint32_t j = 0; j < tx_undo.vprevout.size(); ++j) {
+                const Coin& coin{tx_undo.vprevout[j]};
+                const CTxOut& out{coin.out};
+                const uint160 hash{ScriptHash(out.scriptPubKey)};
+                record(hash, 0, txid, j, /*fSpending=*/true, -out.nValue);
+                if (!out.assetInfo.IsNull()) {
+                    record(hash, out.assetInfo.nAsset, txid, j, /*fSpending=*/true, -out.assetInfo.nValue);
+                }
+                const DBUnspentKey key{hash, out.assetInfo.IsNull() ? 0 : out.assetInfo.nAsset, int(coin.nHeight), tx->vin[j].prevout};
+                if (fDisconnect) {
+                    batch.Write(key, DBUnspentValue{out.nValue, out.assetInfo.IsNull() ? 0 : out.assetInfo.nValue});
+                } else {
+                    batch.Erase(key);
+                }
+            }
+        };
+        if (!fDisconnect) spend();
+        for (uint32_t j = 0; j < tx->vout.size(); ++j) {
+            const CTxOut& out{tx->vout[j]};
+            if (out.scriptPubKey.IsUnspendable()) continue;
+            const uint160 hash{ScriptHash(out.scriptPubKey)};
+            record(hash, 0, txid, j, /*fSpending=*/false, out.nValue);
+            if (!out.assetInfo.IsNull()) {
+                record(hash, out.assetInfo.nAsset, txid, j, /*fSpending=*/false, out.assetInfo.nValue);
+            }
+            const DBUnspentKey key{hash, out.assetInfo.IsNull() ? 0 : out.assetInfo.nAsset, nHeight, COutPoint(txid, j)};
+            if (fDisconnect) {
+                batch.Erase(key);
+            } else {
+                batch.Write(key, DBUnspentValue{out.nValue, out.assetInfo.IsNull() ? 0 : out.assetInfo.nValue});
+            }
+        }
+        if (fDisconnect) spend();
+    }
+}
+
+void AddressIndex::WriteBalances(CDBBatch& batch, const BalanceDeltas& deltas) const
+{
+    for (const auto& [script_asset, delta] : deltas) {
+        const DBBalanceKey key{script_asset.first, script_asset.second};
+        DBBalanceValue balance;
+        if (!m_db->Read(key, balance)) balance = {};
+        balance.nBalance += delta.nBalance;
+        balance.nReceived += delta.nReceived;
+        if (balance.nBalance == 0 && balance.nReceived == 0) {
+            batch.Erase(key);
+        } else {
+            batch.Write(key, balance);
+        }
+    }
+}
+
+bool AddressIndex::CustomAppend(const interfaces::BlockInfo& block)
+{
+    // Exclude genesis block transaction because outputs are not spendable.
+    if (block.height == 0) return true;
+
+    assert(block.data);
+    // pindex variable gives indexing code access to node internals. It
+    // will be removed in upcoming commit
+    const CBlockIndex* pindex = WITH_LOCK(cs_main, return m_chainstate->m_blockman.LookupBlockIndex(block.hash));
+    CBlockUndo block_undo;
+    if (!m_chainstate->m_blockman.UndoReadFromDisk(block_undo, *pindex)) {
+        return error("%s: Failed to read undo data of block %s", __func__, block.hash.ToString());
+    }
+    CDBBatch batch(*m_db);
+    BalanceDeltas deltas;
+    ApplyBlock(batch, *block.data, block_undo, block.height, /*fDisconnect=*/false, deltas);
+    WriteBalances(batch, deltas);
+    return m_db->WriteBatch(batch);
+}
+
+bool AddressIndex::CustomRewind(const interfaces::BlockKey& current_tip, const interfaces::BlockKey& new_tip)
+{
+    LOCK(cs_main);
+    const CBlockIndex* iter_tip{m_chainstate->m_blockman.LookupBlockIndex(current_tip.hash)};
+    const CBlockIndex* new_tip_index{m_chainstate->m_blockman.LookupBlockIndex(new_tip.hash)};
+
+    CDBBatch batch(*m_db);
+    // the balances are only read back from disk once all blocks are undone
+    BalanceDeltas deltas;
+    do {
+        CBlock block;
+        CBlockUndo block_undo;
+        if (!m_chainstate->m_blockman.ReadBlockFromDisk(block, *iter_tip, /*fFillNEVMData=*/false)) {
+            return error("%s: Failed to read block %s from disk",
+                         __func__, iter_tip->GetBlockHash().ToString());
+        }
+        if (!m_chainstate->m_blockman.UndoReadFromDisk(block_undo, *iter_tip)) {
+            return error("%s: Failed to read undo data of block %s",
+                         __func__, iter_tip->GetBlockHash().ToString());
+        }
+        ApplyBlock(batch, block, block_undo, iter_tip->nHeight, /*fDisconnect=*/true, deltas);
+        iter_tip = iter_tip->GetAncestor(iter_tip->nHeight - 1);
+    } while (new_tip_index != iter_tip);
+    WriteBalances(batch, deltas);
+
+    return m_db->WriteBatch(batch);
+}
+
+BaseIndex::DB& AddressIndex::GetDB() const { return *m_db; }
+
+std::vector<AddressIndexBalance> AddressIndex::GetBalances(const CScript& scriptPubKey) const
+{
+    std::vector<AddressIndexBalance> vBalances;
+    const uint160 hash{ScriptHash(scriptPubKey)};
+    std::unique_ptr<CDBIterator> pcursor(m_db->NewIterator());
+    pcursor->Seek(DBBalanceKey{hash, 0});
+    DBBalanceKey key;
+    while (pcursor->Valid() && pcursor->GetKey(key) && key.hash == hash) {
+        DBBalanceValue balance;
+        if (!pcursor->GetValue(balance)) {
+            LogPrintf("%s: Failed to read balance of asset %llu\n", __func__, key.nAsset);
+            break;
+        }
+        vBalances.push_back({key.nAsset, balance.nBalance, balance.nReceived});
+        pcursor->Next();
+    }
+    return vBalances;
+}
+
+std::vector<AddressIndexDelta> AddressIndex::GetHistory(const CScript& scriptPubKey, const AddressIndexQuery& query) const
+{
+    std::vector<AddressIndexDelta> vDeltas;
+    ForEachKeyInRange<DBHistoryKey>(*m_db, ScriptHash(scriptPubKey), query, [&](const DBHistoryKey& key, CDBIterator& cursor) {
+        CAmount nAmount;
+        if (!cursor.GetValue(nAmount)) {
+            LogPrintf("%s: Failed to read history of asset %llu at height %d\n", __func__, key.nAsset, key.nHeight);
+            return false;
+        }
+        vDeltas.push_back({key.nAsset, key.nHeight, key.txid, key.nIndex, key.fSpending, nAmount});
+        return query.nCount == 0 || vDeltas.size() < query.nCount;
+    });
+    return vDeltas;
+}
+
+std::vector<AddressIndexUnspent> AddressIndex::GetUnspent(const CScript& scriptPubKey, const AddressIndexQuery& query) const
+{
+    std::vector<AddressIndexUnspent> vUnspent;
+    ForEachKeyInRange<DBUnspentKey>(*m_db, ScriptHash(scriptPubKey), query, [&](const DBUnspentKey& key, CDBIterator& cursor) {
+        DBUnspentValue value;
+        if (!cursor.GetValue(value)) {
+            LogPrintf("%s: Failed to read unspent output of asset %llu at height %d\n", __func__, key.nAsset, key.nHeight);
+            return false;
+        }
+        vUnspent.push_back({key.outpoint, key.nHeight, value.nValue, key.nAsset, value.nAssetValue});
+        return query.nCount == 0 || vUnspent.size() < query.nCount;
+    });
+    return vUnspent;
+}
@@ -0,0 +1,119 @@
+// Copyright (c) 2024 The Syscoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef SYSCOIN_INDEX_ADDRESSINDEX_H
+#define SYSCOIN_INDEX_ADDRESSINDEX_H
+
+#include <consensus/amount.h>
+#include <index/base.h>
+#include <primitives/transaction.h>
+#include <script/script.h>
+#include <uint256.h>
+
+#include <limits>
+#include <map>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
+class CBlockUndo;
+class CDBBatch;
+
+static constexpr bool DEFAULT_ADDRESSINDEX{false};
+
+/** Balance of one asset held by a script, nAsset 0 is plain SYS */
+struct AddressIndexBalance {
+    uint64_t nAsset{0};
+    CAmount nBalance{0};
+    CAmount nReceived{0};
+};
+
+/** A credit (output) or debit (spent input) of a script as recorded by the address index */
+struct AddressIndexDelta {
+    uint64_t nAsset{0};
+    int nHeight{0};
+    uint256 txid;
+    //! output number of a credit, input number of a debit
+    uint32_t nIndex{0};
+    bool fSpending{false};
+    //! negative for a debit
+    CAmount nAmount{0};
+};
+
+/** An unspent output of a script as recorded by the address index */
+struct AddressIndexUnspent {
+    COutPoint outpoint;
+    int nHeight{0};
+    CAmount nValue{0};
+    //! the asset carried by the output, 0 for plain SYS
+    uint64_t nAsset{0};
+    CAmount nAssetValue{0};
+};
+
+/** Range and page of an address index lookup */
+struct AddressIndexQuery {
+    //! only this asset, 0 for SYS, all assets if unset
+    std::optional<uint64_t> nAsset;
+    int nStartHeight{0};
+    int nEndHeight{std::numeric_limits<int>::max()};
+    size_t nSkip{0};
+    //! 0 for no limit
+    size_t nCount{0};
+};
+
+/**
+ * AddressIndex records, by hash of the scriptPubKey and asset, every credit and
+ * debit of a script ordered by height, its unspent outputs and its running
+ * balance. SYS amounts are recorded under nAsset 0 for every output, asset outputs
+ * are recorded under their asset guid as well. Like AssetIndex it is applied from
+ * the block and its undo data on connect and rewound the same way on reorgs, so
+ * explorers and bridges can follow addresses without re-reading every block.
+ */
+class AddressIndex final : public BaseIndex
+{
+protected:
+    class DB;
+
+private:
+    const std::unique_ptr<DB> m_db;
+
+    bool AllowPrune() const override { return false; }
+
+    //! balance changes by script hash and asset, summed up so each balance is read and written once
+    using BalanceDeltas = std::map<std::pair<uint160, uint64_t>, AddressIndexBalance>;
+
+    /** Add the index changes of a connected block at nHeight, or take them back if fDisconnect */
+    void ApplyBlock(CDBBatch& batch, const CBlock& block, const CBlockUndo& block_undo, int nHeight, bool fDisconnect, BalanceDeltas& deltas) const;
+    void WriteBalances(CDBBatch& batch, const BalanceDeltas& deltas) const;
+
+protected:
+    bool CustomAppend(const interfaces::BlockInfo& block) override;
+
+    bool CustomRewind(const interfaces::BlockKey& current_tip, const interfaces::BlockKey& new_tip) override;
+
+    BaseIndex::DB& GetDB() const override;
+
+public:
+    /// Constructs the index, which becomes available to be queried.
+    explicit AddressIndex(std::unique_ptr<interfaces::Chain> chain, size_t n_cache_size, bool f_memory = false, bool f_wipe = false);
+
+    // Destructor is declared because this class contains a unique_ptr to an incomplete type.
+    virtual ~AddressIndex() override;
+
+    /// Balances of a script, ordered by asset, SYS first. Assets it never held are left out.
+    std::vector<AddressIndexBalance> GetBalances(const CScript& scriptPubKey) const;
+
+    /// Credits and debits of a script within the heights of query, ordered by asset,
+    /// then height. Skips query.nSkip of them and returns up to query.nCount.
+    std::vector<AddressIndexDelta> GetHistory(const CScript& scriptPubKey, const AddressIndexQuery& query) const;
+
+    /// Unspent outputs of a script within the heights of query, ordered by asset, then height.
+    std::vector<AddressIndexUnspent> GetUnspent(const CScript& scriptPubKey, const AddressIndexQuery& query) const;
+};
+
+/// The global address index, used by the address RPCs. May be null.
+extern std::unique_ptr<AddressIndex> g_address_index;
+
+#endif // SYSCOIN_INDEX_ADDRESSINDEX_H
@@ -0,0 +1,171 @@
+// Copyright (c) 2024 The Syscoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <index/assetindex.h>
+
+#include <common/args.h>
+#include <logging.h>
+#include <node/blockstorage.h>
+#include <serialize.h>
+#include <undo.h>
+#include <validation.h>
+
+static constexpr uint8_t DB_ASSET_OUTPUT{'a'};
+
+std::unique_ptr<AssetIndex> g_asset_index;
+
+namespace {
+
+/** Keys sort by asset, then scriptPubKey, then outpoint so both lookups are a range scan */
+struct DBAssetOutputKey {
+    uint64_t nAsset;
+    CScript scriptPubKey;
+    COutPoint outpoint;
+
+    DBAssetOutputKey() = default;
+    DBAssetOutputKey(uint64_t nAssetIn, const CScript& scriptPubKeyIn, const COutPoint& outpointIn) :
+        nAsset(nAssetIn), scriptPubKey(scriptPubKeyIn), outpoint(outpointIn) {}
+
+    template <typename Stream>
+    void Serialize(Stream& s) const
+    {
+        ser_writedata8(s, DB_ASSET_OUTPUT);
+        // big endian so keys of one asset are contiguous
+        ser_writedata32be(s, nAsset >> 32);
+        ser_writedata32be(s, nAsset & 0xffffffff);
+        s << scriptPubKey << outpoint;
+    }
+
+    template <typename Stream>
+    void Unserialize(Stream& s)
+    {
+        const uint8_t prefix{ser_readdata8(s)};
+        if (prefix != DB_ASSET_OUTPUT) {
+            throw std::ios_base::failure("Invalid format for assetindex DB output key");
+        }
+        nAsset = uint64_t{ser_readdata32be(s)} << 32;
+        nAsset |= ser_readdata32be(s);
+        s >> scriptPubKey >> outpoint;
+    }
+};
+
+} // namespace
+
+/** Access to the asset index database (indexes/assetoutputindex/) */
+class AssetIndex::DB : public BaseIndex::DB
+{
+public:
+    explicit DB(size_t n_cache_size, bool f_memory = false, bool f_wipe = false);
+};
+
+AssetIndex::DB::DB(size_t n_cache_size, bool f_memory, bool f_wipe) :
+    BaseIndex::DB(gArgs.GetDataDirNet() / "indexes" / "assetoutputindex", n_cache_size, f_memory, f_wipe)
+{}
+
+AssetIndex::AssetIndex(std::unique_ptr<interfaces::Chain> chain, size_t n_cache_size, bool f_memory, bool f_wipe)
+    : BaseIndex(std::move(chain), "assetoutputindex"), m_db(std::make_unique<AssetIndex::DB>(n_cache_size, f_memory, f_wipe))
+{}
+
+AssetIndex::~AssetIndex() = default;
+
+void AssetIndex::ApplyBlock(CDBBatch& batch, const CBlock& block, const CBlockUndo& block_undo, bool fDisconnect) const
+{
+    // on disconnect transactions are undone last to first so an output created
+    // and spent within the block ends up erased either way
+    for (size_t k = 0; k < block.vtx.size(); ++k) {
+        const size_t i = fDisconnect ? block.vtx.size() - 1 - k : k;
+        const auto& tx{block.vtx[i]};
+        auto spend = [&] {
+            // the coinbase tx has no undo data since no former output is spent
+            if (tx->IsCoinBase()) return;
+            const CTxUndo& tx_undo{block_undo.vtxundo.at(i - 1)};
+            for (size_t j = 0; j < tx_undo.vprevout.size(); ++j) {
+                const CTxOut& out{tx_undo.vprevout[j].out};
+                if (out.assetInfo.IsNull()) continue;
+                const DBAssetOutputKey key{out.assetInfo.nAsset, out.scriptPubKey, tx->vin[j].prevout};
+                if (fDisconnect) {
+                    batch.Write(key, out.assetInfo.nValue);
+                } else {
+                    batch.Erase(key);
+                }
+            }
+        };
+        if (!fDisconnect) spend();
+        for (uint32_t j = 0; j < tx->vout.size(); ++j) {
+            const CTxOut& out{tx->vout[j]};
+            if (out.assetInfo.IsNull() || out.scriptPubKey.IsUnspendable()) continue;
+            const DBAssetOutputKey key{out.assetInfo.nAsset, out.scriptPubKey, COutPoint(tx->GetHash(), j)};
+            if (fDisconnect) {
+                batch.Erase(key);
+            } else {
+                batch.Write(key, out.assetInfo.nValue);
+            }
+        }
+        if (fDisconnect) spend();
+    }
+}
+
+bool AssetIndex::CustomAppend(const interfaces::BlockInfo& block)
+{
+    // Exclude genesis block transaction because outputs are not spendable.
+    if (block.height == 0) return true;
+
+    assert(block.data);
+    // pindex variable gives indexing code access to node internals. It
+    // will be removed in upcoming commit
+    const CBlockIndex* pindex = WITH_LOCK(cs_main, return m_chainstate->m_blockman.LookupBlockIndex(block.hash));
+    CBlockUndo block_undo;
+    if (!m_chainstate->m_blockman.UndoReadFromDisk(block_undo, *pindex)) {
+        return error("%s: Failed to read undo data of block %s", __func__, block.hash.ToString());
+    }
+    CDBBatch batch(*m_db);
+    ApplyBlock(batch, *block.data, block_undo, /*fDisconnect=*/false);
+    return m_db->WriteBatch(batch);
+}
+
+bool AssetIndex::CustomRewind(const interfaces::BlockKey& current_tip, const interfaces::BlockKey& new_tip)
+{
+    LOCK(cs_main);
+    const CBlockIndex* iter_tip{m_chainstate->m_blockman.LookupBlockIndex(current_tip.hash)};
+    const CBlockIndex* new_tip_index{m_chainstate->m_blockman.LookupBlockIndex(new_tip.hash)};
+
+    CDBBatch batch(*m_db);
+    do {
+        CBlock block;
+        CBlockUndo block_undo;
+        if (!m_chainstate->m_blockman.ReadBlockFromDisk(block, *iter_tip, /*fFillNEVMData=*/false)) {
+            return error("%s: Failed to read block %s from disk",
+                         __func__, iter_tip->GetBlockHash().ToString());
+        }
+        if (!m_chainstate->m_blockman.UndoReadFromDisk(block_undo, *iter_tip)) {
+            return error("%s: Failed to read undo data of block %s",
+                         __func__, iter_tip->GetBlockHash().ToString());
+        }
+        ApplyBlock(batch, block, block_undo, /*fDisconnect=*/true);
+        iter_tip = iter_tip->GetAncestor(iter_tip->nHeight - 1);
+    } while (new_tip_index != iter_tip);
+
+    return m_db->WriteBatch(batch);
+}
+
+BaseIndex::DB& AssetIndex::GetDB() const { return *m_db; }
+
+void AssetIndex::FindAssetOutputs(uint64_t nAsset, const CScript* scriptPubKey, size_t nLimit, std::vector<AssetIndexOutput>& vOutputs) const
+{
+    std::unique_ptr<CDBIterator> pcursor(m_db->NewIterator());
+    // an empty script and a null txid sort before every key of the range
+    pcursor->Seek(DBAssetOutputKey{nAsset, scriptPubKey ? *scriptPubKey : CScript(), COutPoint(uint256(), 0)});
+    DBAssetOutputKey key;
+    while (pcursor->Valid() && pcursor->GetKey(key) && key.nAsset == nAsset) {
+        if (scriptPubKey && key.scriptPubKey != *scriptPubKey) break;
+        CAmount nAssetValue;
+        if (!pcursor->GetValue(nAssetValue)) {
+            LogPrintf("%s: Failed to read value of an asset output of %llu\n", __func__, nAsset);
+            break;
+        }
+        vOutputs.push_back({key.outpoint, key.scriptPubKey, nAssetValue});
+        if (nLimit > 0 && vOutputs.size() >= nLimit) break;
+        pcursor->Next();
+    }
+}
@@ -0,0 +1,72 @@
+// Copyright (c) 2024 The Syscoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef SYSCOIN_INDEX_ASSETINDEX_H
+#define SYSCOIN_INDEX_ASSETINDEX_H
+
+#include <consensus/amount.h>
+#include <index/base.h>
+#include <primitives/transaction.h>
+#include <script/script.h>
+
+#include <vector>
+
+class CBlockUndo;
+class CDBBatch;
+
+static constexpr bool DEFAULT_ASSETOUTPUTINDEX{false};
+
+/** An unspent output of an asset as recorded by the asset index */
+struct AssetIndexOutput {
+    COutPoint outpoint;
+    CScript scriptPubKey;
+    CAmount nAssetValue;
+};
+
+/**
+ * AssetIndex tracks the unspent asset outputs of the chain by asset guid and
+ * scriptPubKey, so the allocations of an asset, or of an asset held by one
+ * script, can be listed without walking the UTXO set. It is updated from the
+ * block and its undo data on connect and rewound the same way on reorgs.
+ */
+class AssetIndex final : public BaseIndex
+{
+protected:
+    class DB;
+
+private:
+    const std::unique_ptr<DB> m_db;
+
+    bool AllowPrune() const override { return false; }
+
+    /** Add the index changes of a connected block, or take them back if fDisconnect */
+    void ApplyBlock(CDBBatch& batch, const CBlock& block, const CBlockUndo& block_undo, bool fDisconnect) const;
+
+protected:
+    bool CustomAppend(const interfaces::BlockInfo& block) override;
+
+    bool CustomRewind(const interfaces::BlockKey& current_tip, const interfaces::BlockKey& new_tip) override;
+
+    BaseIndex::DB& GetDB() const override;
+
+public:
+    /// Constructs the index, which becomes available to be queried.
+    explicit AssetIndex(std::unique_ptr<interfaces::Chain> chain, size_t n_cache_size, bool f_memory = false, bool f_wipe = false);
+
+    // Destructor is declared because this class contains a unique_ptr to an incomplete type.
+    virtual ~AssetIndex() override;
+
+    /// Look up unspent outputs of an asset.
+    ///
+    /// @param[in]   nAsset  The asset guid.
+    /// @param[in]   scriptPubKey  Only return outputs paying to this script, all scripts if null.
+    /// @param[in]   nLimit  Stop after this many outputs, 0 for no limit.
+    /// @param[out]  vOutputs  The outputs found, ordered by scriptPubKey.
+    void FindAssetOutputs(uint64_t nAsset, const CScript* scriptPubKey, size_t nLimit, std::vector<AssetIndexOutput>& vOutputs) const;
+};
+
+/// The global asset index, used by the getassetoutputs RPC. May be null.
+extern std::unique_ptr<AssetIndex> g_asset_index;
+
+#endif // SYSCOIN_INDEX_ASSETINDEX_H
@@ -4,6 +4,7 @@
 
 #include <chainparams.h>
 #include <common/args.h>
+#include <common/system.h>
 #include <index/base.h>
 #include <interfaces/chain.h>
 #include <kernel/chain.h>
@@ -20,13 +21,85 @@
 #include <validation.h> // For g_chainman
 #include <warnings.h>
 
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
 #include <string>
+#include <thread>
 #include <utility>
+#include <vector>
 
 constexpr uint8_t DB_BEST_BLOCK{'B'};
 
 constexpr auto SYNC_LOG_INTERVAL{30s};
 constexpr auto SYNC_LOCATOR_WRITE_INTERVAL{30s};
+// SYSCOIN
+//! worker threads reading and preparing blocks for one syncing index
+constexpr int MAX_SYNC_WORKERS{4};
+//! blocks read and prepared ahead of the one being appended
+constexpr size_t SYNC_READ_AHEAD{16};
+
+namespace {
+/** A block read and prepared ahead of being appended, block is null if it could not be read */
+struct SyncBlock {
+    std::unique_ptr<CBlock> block;
+    std::unique_ptr<PreparedIndexBlock> prepared;
+};
+
+/**
+ * Threads running the read and prepare stage of the initial sync. Results are
+ * taken from the futures in chain order, so the append stage stays sequential.
+ */
+class SyncWorkers
+{
+    Mutex m_mutex;
+    std::condition_variable m_cv;
+    std::deque<std::packaged_task<SyncBlock()>> m_jobs GUARDED_BY(m_mutex);
+    bool m_stop GUARDED_BY(m_mutex){false};
+    std::vector<std::thread> m_threads;
+
+    void Run() EXCLUSIVE_LOCKS_REQUIRED(!m_mutex)
+    {
+        while (true) {
+            std::packaged_task<SyncBlock()> job;
+            {
+                WAIT_LOCK(m_mutex, lock);
+                m_cv.wait(lock, [&]() EXCLUSIVE_LOCKS_REQUIRED(m_mutex) { return m_stop || !m_jobs.empty(); });
+                if (m_stop) return;
+                job = std::move(m_jobs.front());
+                m_jobs.pop_front();
+            }
+            job();
+        }
+    }
+
+public:
+    SyncWorkers(const std::string& name, int n_threads)
+    {
+        for (int i = 0; i < n_threads; ++i) {
+            m_threads.emplace_back(&util::TraceThread, strprintf("%s.%d", name, i), [this] { Run(); });
+        }
+    }
+
+    ~SyncWorkers()
+    {
+        WITH_LOCK(m_mutex, m_stop = true);
+        m_cv.notify_all();
+        for (auto& thread : m_threads) thread.join();
+    }
+
+    std::future<SyncBlock> Submit(std::function<SyncBlock()> fn) EXCLUSIVE_LOCKS_REQUIRED(!m_mutex)
+    {
+        std::packaged_task<SyncBlock()> job{std::move(fn)};
+        auto result{job.get_future()};
+        WITH_LOCK(m_mutex, m_jobs.push_back(std::move(job)));
+        m_cv.notify_one();
+        return result;
+    }
+};
+} // namespace
 
 template <typename... Args>
 void BaseIndex::FatalErrorf(const char* fmt, const Args&... args)
@@ -148,6 +221,23 @@ void BaseIndex::ThreadSync()
     if (!m_synced) {
         std::chrono::steady_clock::time_point last_log_time{0s};
         std::chrono::steady_clock::time_point last_locator_write_time{0s};
+        // SYSCOIN blocks are read and prepared in parallel ahead of the append, which stays in chain order
+        SyncWorkers workers{GetName(), std::clamp(GetNumCores() - 1, 1, MAX_SYNC_WORKERS)};
+        std::deque<std::pair<const CBlockIndex*, std::future<SyncBlock>>> read_ahead;
+        auto schedule = [&](const CBlockIndex* pindex_read) {
+            read_ahead.emplace_back(pindex_read, workers.Submit([this, pindex_read] {
+                SyncBlock result;
+                auto block{std::make_unique<CBlock>()};
+                // indexes never look at the PoDA blobs
+                if (!m_chainstate->m_blockman.ReadBlockFromDisk(*block, *pindex_read, /*fFillNEVMData=*/false)) {
+                    return result;
+                }
+                interfaces::BlockInfo block_info = kernel::MakeBlockInfo(pindex_read, block.get());
+                result.prepared = CustomPrepare(block_info);
+                result.block = std::move(block);
+                return result;
+            }));
+        };
         while (true) {
             if (m_interrupt) {
                 LogPrintf("%s: m_interrupt set; exiting ThreadSync\n", GetName());
@@ -176,6 +266,14 @@ void BaseIndex::ThreadSync()
                     return;
                 }
                 pindex = pindex_next;
+                // SYSCOIN blocks read ahead on a chain that is no longer the active one are dropped
+                if (!read_ahead.empty() && read_ahead.front().first != pindex) read_ahead.clear();
+                if (read_ahead.empty()) schedule(pindex);
+                while (read_ahead.size() < SYNC_READ_AHEAD) {
+                    const CBlockIndex* pindex_ahead = m_chainstate->m_chain.Next(read_ahead.back().first);
+                    if (!pindex_ahead) break;
+                    schedule(pindex_ahead);
+                }
             }
 
             auto current_time{std::chrono::steady_clock::now()};
@@ -192,16 +290,18 @@ void BaseIndex::ThreadSync()
                 Commit();
             }
 
-            CBlock block;
+            // SYSCOIN
+            SyncBlock sync_block{read_ahead.front().second.get()};
+            read_ahead.pop_front();
             interfaces::BlockInfo block_info = kernel::MakeBlockInfo(pindex);
-            if (!m_chainstate->m_blockman.ReadBlockFromDisk(block, *pindex)) {
+            if (!sync_block.block) {
                 FatalErrorf("%s: Failed to read block %s from disk",
                            __func__, pindex->GetBlockHash().ToString());
                 return;
             } else {
-                block_info.data = &block;
+                block_info.data = sync_block.block.get();
             }
-            if (!CustomAppend(block_info)) {
+            if (!CustomAppendPrepared(block_info, std::move(sync_block.prepared))) {
                 FatalErrorf("%s: Failed to write block %s to index database",
                            __func__, pindex->GetBlockHash().ToString());
                 return;
@@ -303,7 +403,8 @@ void BaseIndex::BlockConnected(ChainstateRole role, const std::shared_ptr<const
         }
     }
     interfaces::BlockInfo block_info = kernel::MakeBlockInfo(pindex, block.get());
-    if (CustomAppend(block_info)) {
+    // SYSCOIN
+    if (CustomAppendPrepared(block_info, CustomPrepare(block_info))) {
         // Setting the best block index is intentionally the last step of this
         // function, so BlockUntilSyncedToCurrentChain callers waiting for the
         // best block index to be updated can rely on the block being fully
@@ -10,6 +10,7 @@
 #include <util/threadinterrupt.h>
 #include <validationinterface.h>
 
+#include <memory>
 #include <string>
 
 class CBlock;
@@ -27,6 +28,12 @@ struct IndexSummary {
     uint256 best_block_hash;
 };
 
+// SYSCOIN
+/** Result of BaseIndex::CustomPrepare, each index derives its own */
+struct PreparedIndexBlock {
+    virtual ~PreparedIndexBlock() = default;
+};
+
 /**
  * Base class for indices of blockchain data. This implements
  * CValidationInterface and ensures blocks are indexed sequentially according
@@ -118,6 +125,16 @@ protected:
     /// Write update index entries for a newly connected block.
     [[nodiscard]] virtual bool CustomAppend(const interfaces::BlockInfo& block) { return true; }
 
+    // SYSCOIN
+    /// Work on a block that only depends on the block itself, like computing transaction
+    /// positions or a filter. During the initial sync it runs on worker threads for blocks
+    /// ahead of the one being appended, so it must be thread safe and must not touch the
+    /// index state. Returns nullptr when there is nothing to prepare.
+    [[nodiscard]] virtual std::unique_ptr<PreparedIndexBlock> CustomPrepare(const interfaces::BlockInfo& block) const { return nullptr; }
+
+    /// Append a block with the result of CustomPrepare for it, in chain order. Defaults to CustomAppend.
+    [[nodiscard]] virtual bool CustomAppendPrepared(const interfaces::BlockInfo& block, std::unique_ptr<PreparedIndexBlock> prepared) { return CustomAppend(block); }
+
     /// Virtual method called internally by Commit that can be overridden to atomically
     /// commit more index state.
     virtual bool CustomCommit(CDBBatch& batch) { return true; }
@@ -215,19 +215,43 @@ size_t BlockFilterIndex::WriteFilterToDisk(FlatFilePos& pos, const BlockFilter&
     return data_size;
 }
 
+namespace {
+// SYSCOIN
+struct PreparedBlockFilter final : PreparedIndexBlock {
+    explicit PreparedBlockFilter(BlockFilter&& filter_in) : filter(std::move(filter_in)) {}
+    BlockFilter filter;
+};
+} // namespace
+
 bool BlockFilterIndex::CustomAppend(const interfaces::BlockInfo& block)
+{
+    return CustomAppendPrepared(block, CustomPrepare(block));
+}
+
+std::unique_ptr<PreparedIndexBlock> BlockFilterIndex::CustomPrepare(const interfaces::BlockInfo& block) const
 {
     CBlockUndo block_undo;
-    uint256 prev_header;
 
     if (block.height > 0) {
         // pindex variable gives indexing code access to node internals. It
         // will be removed in upcoming commit
         const CBlockIndex* pindex = WITH_LOCK(cs_main, return m_chainstate->m_blockman.LookupBlockIndex(block.hash));
         if (!m_chainstate->m_blockman.UndoReadFromDisk(block_undo, *pindex)) {
-            return false;
+            return nullptr;
         }
+    }
+
+    return std::make_unique<PreparedBlockFilter>(BlockFilter(m_filter_type, *Assert(block.data), block_undo));
+}
+
+bool BlockFilterIndex::CustomAppendPrepared(const interfaces::BlockInfo& block, std::unique_ptr<PreparedIndexBlock> prepared)
+{
+    // the undo data could not be read
+    if (!prepared) return false;
+    const BlockFilter& filter = static_cast<const PreparedBlockFilter&>(*prepared).filter;
+    uint256 prev_header;
 
+    if (block.height > 0) {
         std::pair<uint256, DBVal> read_out;
         if (!m_db->Read(DBHeightKey(block.height - 1), read_out)) {
             return false;
@@ -242,8 +266,6 @@ bool BlockFilterIndex::CustomAppend(const interfaces::BlockInfo& block)
         prev_header = read_out.second.header;
     }
 
-    BlockFilter filter(m_filter_type, *Assert(block.data), block_undo);
-
     size_t bytes_written = WriteFilterToDisk(m_next_filter_pos, filter);
     if (bytes_written == 0) return false;
 
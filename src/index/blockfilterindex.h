@@ -51,6 +51,12 @@ protected:
 
     bool CustomAppend(const interfaces::BlockInfo& block) override;
 
+    // SYSCOIN the undo data is read and the filter built on the sync workers,
+    // the filter header chain is extended in block order
+    std::unique_ptr<PreparedIndexBlock> CustomPrepare(const interfaces::BlockInfo& block) const override;
+
+    bool CustomAppendPrepared(const interfaces::BlockInfo& block, std::unique_ptr<PreparedIndexBlock> prepared) override;
+
     bool CustomRewind(const interfaces::BlockKey& current_tip, const interfaces::BlockKey& new_tip) override;
 
     BaseIndex::DB& GetDB() const LIFETIMEBOUND override { return *m_db; }
@@ -0,0 +1,97 @@
+// Copyright (c) 2024 The Syscoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <index/blockstatsindex.h>
+
+#include <chain.h>
+#include <common/args.h>
+#include <logging.h>
+#include <node/blockstorage.h>
+#include <serialize.h>
+#include <undo.h>
+#include <validation.h>
+
+static constexpr uint8_t DB_BLOCK_STATS{'s'};
+
+std::unique_ptr<BlockStatsIndex> g_block_stats_index;
+
+namespace {
+
+struct DBHeightKey {
+    int height;
+
+    explicit DBHeightKey(int height_in) : height(height_in) {}
+
+    template <typename Stream>
+    void Serialize(Stream& s) const
+    {
+        ser_writedata8(s, DB_BLOCK_STATS);
+        ser_writedata32be(s, height);
+    }
+
+    template <typename Stream>
+    void Unserialize(Stream& s)
+    {
+        const uint8_t prefix{ser_readdata8(s)};
+        if (prefix != DB_BLOCK_STATS) {
+            throw std::ios_base::failure("Invalid format for blockstatsindex DB height key");
+        }
+        height = ser_readdata32be(s);
+    }
+};
+
+} // namespace
+
+/** Access to the block stats index database (indexes/blockstatsindex/) */
+class BlockStatsIndex::DB : public BaseIndex::DB
+{
+public:
+    explicit DB(size_t n_cache_size, bool f_memory = false, bool f_wipe = false);
+};
+
+BlockStatsIndex::DB::DB(size_t n_cache_size, bool f_memory, bool f_wipe) :
+    BaseIndex::DB(gArgs.GetDataDirNet() / "indexes" / "blockstatsindex", n_cache_size, f_memory, f_wipe)
+{}
+
+BlockStatsIndex::BlockStatsIndex(std::unique_ptr<interfaces::Chain> chain, size_t n_cache_size, bool f_memory, bool f_wipe)
+    : BaseIndex(std::move(chain), "blockstatsindex"), m_db(std::make_unique<BlockStatsIndex::DB>(n_cache_size, f_memory, f_wipe))
+{}
+
+BlockStatsIndex::~BlockStatsIndex() = default;
+
+bool BlockStatsIndex::CustomAppend(const interfaces::BlockInfo& block)
+{
+    assert(block.data);
+    // pindex variable gives indexing code access to node internals. It
+    // will be removed in upcoming commit
+    const CBlockIndex* pindex = WITH_LOCK(cs_main, return m_chainstate->m_blockman.LookupBlockIndex(block.hash));
+    // the genesis block has no undo data since no former output is spent
+    CBlockUndo block_undo;
+    if (block.height > 0 && !m_chainstate->m_blockman.UndoReadFromDisk(block_undo, *pindex)) {
+        return error("%s: Failed to read undo data of block %s", __func__, block.hash.ToString());
+    }
+    const node::BlockStats stats{node::ComputeBlockStats(*block.data, block_undo, *pindex)};
+    return m_db->Write(DBHeightKey(block.height), std::make_pair(block.hash, stats));
+}
+
+bool BlockStatsIndex::CustomRewind(const interfaces::BlockKey& current_tip, const interfaces::BlockKey& new_tip)
+{
+    // the stats of disconnected blocks are dropped, the new branch writes its own
+    CDBBatch batch(*m_db);
+    for (int height = new_tip.height + 1; height <= current_tip.height; ++height) {
+        batch.Erase(DBHeightKey(height));
+    }
+    return m_db->WriteBatch(batch);
+}
+
+BaseIndex::DB& BlockStatsIndex::GetDB() const { return *m_db; }
+
+std::optional<node::BlockStats> BlockStatsIndex::LookUpStats(const CBlockIndex& block_index) const
+{
+    std::pair<uint256, node::BlockStats> read_out;
+    if (!m_db->Read(DBHeightKey(block_index.nHeight), read_out) || read_out.first != block_index.GetBlockHash()) {
+        return std::nullopt;
+    }
+    return read_out.second;
+}
@@ -0,0 +1,53 @@
+// Copyright (c) 2024 The Syscoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef SYSCOIN_INDEX_BLOCKSTATSINDEX_H
+#define SYSCOIN_INDEX_BLOCKSTATSINDEX_H
+
+#include <index/base.h>
+#include <node/blockstats.h>
+
+#include <optional>
+
+static constexpr bool DEFAULT_BLOCKSTATSINDEX{false};
+
+/**
+ * BlockStatsIndex stores the statistics getblockstats reports for every block
+ * of the active chain, asset, burn and PoDA figures included, so they are
+ * read back by height instead of being recomputed from the block and its undo
+ * data. Entries are keyed by height and carry the block hash, entries above
+ * the new tip are erased on reorgs.
+ */
+class BlockStatsIndex final : public BaseIndex
+{
+protected:
+    class DB;
+
+private:
+    const std::unique_ptr<DB> m_db;
+
+    bool AllowPrune() const override { return false; }
+
+protected:
+    bool CustomAppend(const interfaces::BlockInfo& block) override;
+
+    bool CustomRewind(const interfaces::BlockKey& current_tip, const interfaces::BlockKey& new_tip) override;
+
+    BaseIndex::DB& GetDB() const override;
+
+public:
+    /// Constructs the index, which becomes available to be queried.
+    explicit BlockStatsIndex(std::unique_ptr<interfaces::Chain> chain, size_t n_cache_size, bool f_memory = false, bool f_wipe = false);
+
+    // Destructor is declared because this class contains a unique_ptr to an incomplete type.
+    virtual ~BlockStatsIndex() override;
+
+    /// Look up the statistics of a block, nullopt if the index has not reached it or it is not in the indexed chain.
+    std::optional<node::BlockStats> LookUpStats(const CBlockIndex& block_index) const;
+};
+
+/// The global block stats index, used by the getblockstats and getblockstatsrange RPCs. May be null.
+extern std::unique_ptr<BlockStatsIndex> g_block_stats_index;
+
+#endif // SYSCOIN_INDEX_BLOCKSTATSINDEX_H
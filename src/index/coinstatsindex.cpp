@@ -15,6 +15,8 @@
 #include <undo.h>
 #include <validation.h>
 
+#include <map>
+
 using kernel::ApplyCoinHash;
 using kernel::CCoinsStats;
 using kernel::GetBogoSize;
@@ -23,6 +25,10 @@ using kernel::RemoveCoinHash;
 static constexpr uint8_t DB_BLOCK_HASH{'s'};
 static constexpr uint8_t DB_BLOCK_HEIGHT{'t'};
 static constexpr uint8_t DB_MUHASH{'M'};
+// SYSCOIN
+static constexpr uint8_t DB_ASSET_STATS{'a'};
+//! present if asset totals are tracked since genesis
+static constexpr uint8_t DB_ASSET_STATS_COMPLETE{'A'};
 
 namespace {
 
@@ -99,6 +105,95 @@ struct DBHashKey {
     }
 };
 
+// SYSCOIN
+/** Totals of an asset are only written at heights where they change. The
+ * height is stored inverted so seeking to (asset, height) lands on the last
+ * change at or below height. */
+struct DBAssetStatsKey {
+    uint64_t nAsset;
+    int height;
+
+    DBAssetStatsKey() = default;
+    DBAssetStatsKey(uint64_t nAssetIn, int height_in) : nAsset(nAssetIn), height(height_in) {}
+
+    template <typename Stream>
+    void Serialize(Stream& s) const
+    {
+        ser_writedata8(s, DB_ASSET_STATS);
+        ser_writedata32be(s, nAsset >> 32);
+        ser_writedata32be(s, nAsset & 0xffffffff);
+        ser_writedata32be(s, ~static_cast<uint32_t>(height));
+    }
+
+    template <typename Stream>
+    void Unserialize(Stream& s)
+    {
+        const uint8_t prefix{ser_readdata8(s)};
+        if (prefix != DB_ASSET_STATS) {
+            throw std::ios_base::failure("Invalid format for coinstatsindex DB asset stats key");
+        }
+        nAsset = uint64_t{ser_readdata32be(s)} << 32;
+        nAsset |= ser_readdata32be(s);
+        height = static_cast<int>(~ser_readdata32be(s));
+    }
+};
+
+/** Change of the totals of every asset touched by a block */
+std::map<uint64_t, AssetStats> GetAssetStatsDelta(const CBlock& block, const CBlockUndo& block_undo)
+{
+    std::map<uint64_t, AssetStats> mapDelta;
+    for (size_t i = 0; i < block.vtx.size(); ++i) {
+        const auto& tx{block.vtx[i]};
+        if (!tx->HasAssets()) continue;
+        // asset amount spent and created by this transaction
+        std::map<uint64_t, std::pair<CAmount, CAmount>> mapInOut;
+        if (!tx->IsCoinBase()) {
+            for (const Coin& coin : block_undo.vtxundo.at(i - 1).vprevout) {
+                const CAssetCoinInfo& assetInfo{coin.out.assetInfo};
+                if (assetInfo.IsNull()) continue;
+                AssetStats& delta{mapDelta[assetInfo.nAsset]};
+                delta.supply -= assetInfo.nValue;
+                --delta.output_count;
+                mapInOut[assetInfo.nAsset].first += assetInfo.nValue;
+            }
+        }
+        for (const CTxOut& out : tx->vout) {
+            const CAssetCoinInfo& assetInfo{out.assetInfo};
+            if (assetInfo.IsNull()) continue;
+            AssetStats& delta{mapDelta[assetInfo.nAsset]};
+            mapInOut[assetInfo.nAsset].second += assetInfo.nValue;
+            if (!out.scriptPubKey.IsUnspendable()) {
+                delta.supply += assetInfo.nValue;
+                ++delta.output_count;
+            } else if (tx->nVersion == SYSCOIN_TX_VERSION_ALLOCATION_BURN_TO_NEVM) {
+                delta.burned_to_nevm += assetInfo.nValue;
+            } else if (tx->nVersion == SYSCOIN_TX_VERSION_ALLOCATION_BURN_TO_SYSCOIN) {
+                delta.burned_to_syscoin += assetInfo.nValue;
+            }
+        }
+        // consensus keeps asset in == out except for mints and SYS to SYSX burns
+        for (const auto& [nAsset, inOut] : mapInOut) {
+            if (inOut.second > inOut.first) {
+                mapDelta[nAsset].minted += inOut.second - inOut.first;
+            }
+        }
+    }
+    return mapDelta;
+}
+
+/** Totals of an asset at or below height, zero if it did not change until then */
+bool ReadAssetStats(CDBWrapper& db, uint64_t nAsset, int height, AssetStats& stats)
+{
+    std::unique_ptr<CDBIterator> db_it(db.NewIterator());
+    db_it->Seek(DBAssetStatsKey{nAsset, height});
+    DBAssetStatsKey key;
+    if (!db_it->Valid() || !db_it->GetKey(key) || key.nAsset != nAsset) {
+        stats = AssetStats{};
+        return true;
+    }
+    return db_it->GetValue(stats);
+}
+
 }; // namespace
 
 std::unique_ptr<CoinStatsIndex> g_coin_stats_index;
@@ -255,7 +350,26 @@ bool CoinStatsIndex::CustomAppend(const interfaces::BlockInfo& block)
 
     // Intentionally do not update DB_MUHASH here so it stays in sync with
     // DB_BEST_BLOCK, and the index is not corrupted if there is an unclean shutdown.
-    return m_db->Write(DBHeightKey(block.height), value);
+    CDBBatch batch(*m_db);
+    batch.Write(DBHeightKey(block.height), value);
+    // SYSCOIN
+    if (block.height > 0 && !AppendAssetStats(batch, *block.data, block_undo, block.height)) {
+        return false;
+    }
+    return m_db->WriteBatch(batch);
+}
+
+bool CoinStatsIndex::AppendAssetStats(CDBBatch& batch, const CBlock& block, const CBlockUndo& block_undo, int height) const
+{
+    for (const auto& [nAsset, delta] : GetAssetStatsDelta(block, block_undo)) {
+        AssetStats stats;
+        if (!ReadAssetStats(*m_db, nAsset, height - 1, stats)) {
+            return error("%s: Cannot read totals of asset %llu at height %d", __func__, nAsset, height - 1);
+        }
+        stats += delta;
+        batch.Write(DBAssetStatsKey{nAsset, height}, stats);
+    }
+    return true;
 }
 
 [[nodiscard]] static bool CopyHeightIndexToHashIndex(CDBIterator& db_it, CDBBatch& batch,
@@ -306,7 +420,7 @@ bool CoinStatsIndex::CustomRewind(const interfaces::BlockKey& current_tip, const
         do {
             CBlock block;
 
-            if (!m_chainstate->m_blockman.ReadBlockFromDisk(block, *iter_tip)) {
+            if (!m_chainstate->m_blockman.ReadBlockFromDisk(block, *iter_tip, /*fFillNEVMData=*/false)) {
                 return error("%s: Failed to read block %s from disk",
                              __func__, iter_tip->GetBlockHash().ToString());
             }
@@ -368,6 +482,23 @@ std::optional<CCoinsStats> CoinStatsIndex::LookUpStats(const CBlockIndex& block_
     return stats;
 }
 
+std::optional<AssetStats> CoinStatsIndex::LookUpAssetStats(uint64_t nAsset, const CBlockIndex& block_index) const
+{
+    if (!m_asset_stats_complete) {
+        return std::nullopt;
+    }
+    // asset totals are only kept for the chain the height index follows
+    std::pair<uint256, DBVal> read_out;
+    if (!m_db->Read(DBHeightKey(block_index.nHeight), read_out) || read_out.first != block_index.GetBlockHash()) {
+        return std::nullopt;
+    }
+    AssetStats stats;
+    if (!ReadAssetStats(*m_db, nAsset, block_index.nHeight, stats)) {
+        return std::nullopt;
+    }
+    return stats;
+}
+
 bool CoinStatsIndex::CustomInit(const std::optional<interfaces::BlockKey>& block)
 {
     if (!m_db->Read(DB_MUHASH, m_muhash)) {
@@ -406,6 +537,13 @@ bool CoinStatsIndex::CustomInit(const std::optional<interfaces::BlockKey>& block
         m_total_unspendables_bip30 = entry.total_unspendables_bip30;
         m_total_unspendables_scripts = entry.total_unspendables_scripts;
         m_total_unspendables_unclaimed_rewards = entry.total_unspendables_unclaimed_rewards;
+        // SYSCOIN
+        m_asset_stats_complete = m_db->Exists(DB_ASSET_STATS_COMPLETE);
+        if (!m_asset_stats_complete) {
+            LogPrintf("%s: index was built without asset totals, delete indexes/coinstats to rebuild it with them\n", GetName());
+        }
+    } else {
+        m_asset_stats_complete = m_db->Write(DB_ASSET_STATS_COMPLETE, true);
     }
 
     return true;
@@ -542,5 +680,13 @@ bool CoinStatsIndex::ReverseBlock(const CBlock& block, const CBlockIndex* pindex
     Assert(m_total_unspendables_scripts == read_out.second.total_unspendables_scripts);
     Assert(m_total_unspendables_unclaimed_rewards == read_out.second.total_unspendables_unclaimed_rewards);
 
+    // SYSCOIN
+    if (pindex->nHeight > 0) {
+        CDBBatch batch(*m_db);
+        for (const auto& delta : GetAssetStatsDelta(block, block_undo)) {
+            batch.Erase(DBAssetStatsKey{delta.first, pindex->nHeight});
+        }
+        return m_db->WriteBatch(batch);
+    }
     return true;
 }
@@ -5,10 +5,13 @@
 #ifndef SYSCOIN_INDEX_COINSTATSINDEX_H
 #define SYSCOIN_INDEX_COINSTATSINDEX_H
 
+#include <consensus/amount.h>
 #include <crypto/muhash.h>
 #include <index/base.h>
+#include <serialize.h>
 
 class CBlockIndex;
+class CBlockUndo;
 class CDBBatch;
 namespace kernel {
 struct CCoinsStats;
@@ -16,6 +19,36 @@ struct CCoinsStats;
 
 static constexpr bool DEFAULT_COINSTATSINDEX{false};
 
+// SYSCOIN
+/** Running totals of one asset in the UTXO set as of a block */
+struct AssetStats {
+    //! asset amount held by unspent outputs
+    CAmount supply{0};
+    //! asset amount created by mints and SYS to SYSX burns
+    CAmount minted{0};
+    //! asset amount burned to the NEVM
+    CAmount burned_to_nevm{0};
+    //! SYSX burned back to SYS
+    CAmount burned_to_syscoin{0};
+    //! number of unspent outputs holding the asset
+    int64_t output_count{0};
+
+    AssetStats& operator+=(const AssetStats& other)
+    {
+        supply += other.supply;
+        minted += other.minted;
+        burned_to_nevm += other.burned_to_nevm;
+        burned_to_syscoin += other.burned_to_syscoin;
+        output_count += other.output_count;
+        return *this;
+    }
+
+    SERIALIZE_METHODS(AssetStats, obj)
+    {
+        READWRITE(obj.supply, obj.minted, obj.burned_to_nevm, obj.burned_to_syscoin, obj.output_count);
+    }
+};
+
 /**
  * CoinStatsIndex maintains statistics on the UTXO set.
  */
@@ -40,6 +73,12 @@ private:
 
     [[nodiscard]] bool ReverseBlock(const CBlock& block, const CBlockIndex* pindex);
 
+    // SYSCOIN
+    //! whether asset totals were tracked since genesis, false for an index built by an older version
+    bool m_asset_stats_complete{false};
+    /** Add the asset totals of a connected block to batch */
+    [[nodiscard]] bool AppendAssetStats(CDBBatch& batch, const CBlock& block, const CBlockUndo& block_undo, int height) const;
+
     bool AllowPrune() const override { return true; }
 
 protected:
@@ -59,6 +98,10 @@ public:
 
     // Look up stats for a specific block using CBlockIndex
     std::optional<kernel::CCoinsStats> LookUpStats(const CBlockIndex& block_index) const;
+
+    // SYSCOIN
+    // Look up the totals of an asset as of a block of the active chain, zero if the asset was not used yet
+    std::optional<AssetStats> LookUpAssetStats(uint64_t nAsset, const CBlockIndex& block_index) const;
 };
 
 /// The global UTXO set hash object.
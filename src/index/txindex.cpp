@@ -15,6 +15,12 @@ constexpr uint8_t DB_TXINDEX{'t'};
 
 std::unique_ptr<TxIndex> g_txindex;
 
+namespace {
+// SYSCOIN
+struct TxIndexPositions final : PreparedIndexBlock {
+    std::vector<std::pair<uint256, CDiskTxPos>> vPos;
+};
+} // namespace
 
 /** Access to the txindex database (indexes/txindex/) */
 class TxIndex::DB : public BaseIndex::DB
@@ -54,20 +60,28 @@ TxIndex::TxIndex(std::unique_ptr<interfaces::Chain> chain, size_t n_cache_size,
 
 TxIndex::~TxIndex() = default;
 
-bool TxIndex::CustomAppend(const interfaces::BlockInfo& block)
+std::unique_ptr<PreparedIndexBlock> TxIndex::CustomPrepare(const interfaces::BlockInfo& block) const
 {
     // Exclude genesis block transaction because outputs are not spendable.
-    if (block.height == 0) return true;
+    if (block.height == 0) return nullptr;
 
     assert(block.data);
     CDiskTxPos pos({block.file_number, block.data_pos}, GetSizeOfCompactSize(block.data->vtx.size()));
-    std::vector<std::pair<uint256, CDiskTxPos>> vPos;
+    auto positions{std::make_unique<TxIndexPositions>()};
+    std::vector<std::pair<uint256, CDiskTxPos>>& vPos = positions->vPos;
     vPos.reserve(block.data->vtx.size());
     for (const auto& tx : block.data->vtx) {
         vPos.emplace_back(tx->GetHash(), pos);
         pos.nTxOffset += ::GetSerializeSize(*tx, CLIENT_VERSION);
     }
-    return m_db->WriteTxs(vPos);
+    return positions;
+}
+
+bool TxIndex::CustomAppendPrepared(const interfaces::BlockInfo& block, std::unique_ptr<PreparedIndexBlock> prepared)
+{
+    // the genesis block has nothing to index
+    if (!prepared) return true;
+    return m_db->WriteTxs(static_cast<const TxIndexPositions&>(*prepared).vPos);
 }
 
 BaseIndex::DB& TxIndex::GetDB() const { return *m_db; }
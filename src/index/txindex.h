@@ -25,7 +25,10 @@ private:
     bool AllowPrune() const override { return false; }
 
 protected:
-    bool CustomAppend(const interfaces::BlockInfo& block) override;
+    // SYSCOIN the transaction positions are computed on the sync workers
+    std::unique_ptr<PreparedIndexBlock> CustomPrepare(const interfaces::BlockInfo& block) const override;
+
+    bool CustomAppendPrepared(const interfaces::BlockInfo& block, std::unique_ptr<PreparedIndexBlock> prepared) override;
 
     BaseIndex::DB& GetDB() const override;
 
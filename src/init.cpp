@@ -16,6 +16,7 @@
 #include <addrman.h>
 #include <banman.h>
 #include <blockfilter.h>
+#include <bls/bls.h>
 #include <chain.h>
 #include <chainparams.h>
 #include <chainparamsbase.h>
@@ -27,7 +28,10 @@
 #include <hash.h>
 #include <httprpc.h>
 #include <httpserver.h>
+#include <index/addressindex.h>
+#include <index/assetindex.h>
 #include <index/blockfilterindex.h>
+#include <index/blockstatsindex.h>
 #include <index/coinstatsindex.h>
 #include <index/txindex.h>
 #include <init/common.h>
@@ -51,6 +55,7 @@
 #include <node/kernel_notifications.h>
 #include <node/mempool_args.h>
 #include <node/mempool_persist_args.h>
+#include <node/memoryprofile.h>
 #include <node/miner.h>
 #include <node/peerman_args.h>
 #include <node/validation_cache_args.h>
@@ -75,6 +80,7 @@
 #include <util/asmap.h>
 #include <util/chaintype.h>
 #include <util/check.h>
+#include <util/executor.h>
 #include <util/fs.h>
 #include <util/fs_helpers.h>
 #include <util/moneystr.h>
@@ -96,6 +102,7 @@
 #include <cstdio>
 #include <fstream>
 #include <functional>
+#include <future>
 #include <set>
 #include <string>
 #include <thread>
@@ -111,8 +118,10 @@
 
 #if ENABLE_ZMQ
 #include <zmq/zmqabstractnotifier.h>
+#include <zmq/zmqnevmresponder.h>
 #include <zmq/zmqnotificationinterface.h>
 #include <zmq/zmqrpc.h>
+#include <zmq/zmqsharedmemory.h>
 #endif
 // SYSCOIN
 #include <masternode/activemasternode.h>
@@ -126,6 +135,7 @@
 #include <spork.h>
 #include <netfulfilledman.h>
 #include <services/nevmconsensus.h>
+#include <services/nevmblobhasher.h>
 #include <services/assetconsensus.h>
 #include <key_io.h>
 #include <llmq/quorums.h>
@@ -135,7 +145,12 @@
 #include <netfulfilledman.h>
 #include <masternode/masternodemeta.h>
 #include <llmq/quorums_dkgsessionmgr.h>
+#include <metrics.h>
 static CDSNotificationInterface* pdsNotificationInterface = nullptr;
+#if ENABLE_ZMQ
+//! stands in for Geth with -zmqpubnevmmock
+static std::unique_ptr<CZMQNEVMResponder> g_nevm_mock_responder;
+#endif
 
 using kernel::DumpMempool;
 using kernel::LoadMempool;
@@ -154,6 +169,8 @@ using node::fReindex;
 using node::KernelNotifications;
 using node::LoadChainstate;
 using node::MempoolPath;
+// SYSCOIN
+using node::MempoolJournalPath;
 using node::NodeContext;
 using node::ShouldPersistMempool;
 using node::ImportBlocks;
@@ -251,6 +268,7 @@ void Interrupt(NodeContext& node)
     InterruptREST();
     InterruptTorControl();
     // SYSCOIN
+    InterruptMetricsServer();
     llmq::InterruptLLMQSystem();
     InterruptMapPort();
     if (node.connman)
@@ -262,6 +280,16 @@ void Interrupt(NodeContext& node)
     if (g_coin_stats_index) {
         g_coin_stats_index->Interrupt();
     }
+    // SYSCOIN
+    if (g_asset_index) {
+        g_asset_index->Interrupt();
+    }
+    if (g_address_index) {
+        g_address_index->Interrupt();
+    }
+    if (g_block_stats_index) {
+        g_block_stats_index->Interrupt();
+    }
 }
 
 void Shutdown(NodeContext& node)
@@ -283,6 +311,17 @@ void Shutdown(NodeContext& node)
     StopRPC();
     StopHTTPServer();
     // SYSCOIN
+    StopMetricsServer();
+    // the template builder uses the LLMQ system and the NEVM connection
+    if (node::g_block_template_cache) {
+        UnregisterValidationInterface(node::g_block_template_cache.get());
+        node::g_block_template_cache->Stop();
+        node::g_block_template_cache.reset();
+    }
+    if (node::g_block_template_validator) {
+        node::g_block_template_validator->Stop();
+        node::g_block_template_validator.reset();
+    }
     // Adding sleep after several steps to avoid occasional problems on windows
     llmq::StopLLMQSystem();
     UninterruptibleSleep(std::chrono::milliseconds{200});
@@ -295,6 +334,8 @@ void Shutdown(NodeContext& node)
     // Because these depend on each-other, we make sure that neither can be
     // using the other before destroying them.
     if (node.peerman) UnregisterValidationInterface(node.peerman.get());
+    // SYSCOIN
+    if (node.peerman) node.peerman->StopMessageWorkers();
     if (node.connman) node.connman->Stop();
 
     StopTorControl();
@@ -302,6 +343,8 @@ void Shutdown(NodeContext& node)
 
     // After everything has been shut down, but before things get flushed, stop the
     // CScheduler/checkqueue, scheduler and load block thread.
+    // SYSCOIN
+    if (node.maintenance_scheduler) node.maintenance_scheduler->stop();
     if (node.scheduler) node.scheduler->stop();
     if (node.chainman && node.chainman->m_thread_load.joinable()) node.chainman->m_thread_load.join();
     StopScriptCheckWorkerThreads();
@@ -316,7 +359,12 @@ void Shutdown(NodeContext& node)
     node.netgroupman.reset();
 
     if (node.mempool && node.mempool->GetLoadTried() && ShouldPersistMempool(*node.args)) {
-        DumpMempool(*node.mempool, MempoolPath(*node.args));
+        // SYSCOIN the dump starts the journal over as well
+        if (node.mempool_journal) {
+            node.mempool_journal->Compact();
+        } else {
+            DumpMempool(*node.mempool, MempoolPath(*node.args));
+        }
     }
 
     // Drop transactions we were still watching, and record fee estimations.
@@ -346,6 +394,19 @@ void Shutdown(NodeContext& node)
         g_coin_stats_index->Stop();
         g_coin_stats_index.reset();
     }
+    // SYSCOIN
+    if (g_asset_index) {
+        g_asset_index->Stop();
+        g_asset_index.reset();
+    }
+    if (g_address_index) {
+        g_address_index->Stop();
+        g_address_index.reset();
+    }
+    if (g_block_stats_index) {
+        g_block_stats_index->Stop();
+        g_block_stats_index.reset();
+    }
     ForEachBlockFilterIndex([](BlockFilterIndex& index) { index.Stop(); });
     DestroyAllBlockFilterIndexes();
     UninterruptibleSleep(std::chrono::milliseconds{100});
@@ -376,7 +437,9 @@ void Shutdown(NodeContext& node)
         pnevmdatadb.reset();
         pnevmdatablobdb.reset();
         llmq::DestroyLLMQSystem();
+        StopSharedExecutor();
         deterministicMNManager.reset();
+        psyscoinstatedb.reset();
         netfulfilledman.reset();
         sporkManager.reset();
         mmetaman.reset();
@@ -385,11 +448,23 @@ void Shutdown(NodeContext& node)
     for (const auto& client : node.chain_clients) {
         client->stop();
     }
+    // SYSCOIN
+    if (node::g_nevm_prefetcher) {
+        UnregisterValidationInterface(node::g_nevm_prefetcher.get());
+        node::g_nevm_prefetcher->Stop();
+        node::g_nevm_prefetcher.reset();
+    }
+    if (g_nevm_blob_hasher) {
+        g_nevm_blob_hasher->Stop();
+        g_nevm_blob_hasher.reset();
+    }
 #if ENABLE_ZMQ
     if (g_zmq_notification_interface) {
         UnregisterValidationInterface(g_zmq_notification_interface.get());
         g_zmq_notification_interface.reset();
     }
+    // SYSCOIN after the notifiers, they still talk to it while shutting down
+    g_nevm_mock_responder.reset();
 #endif
     // SYSCOIN
     if (pdsNotificationInterface) {
@@ -410,10 +485,14 @@ void Shutdown(NodeContext& node)
     UnregisterAllValidationInterfaces();
     GetMainSignals().UnregisterBackgroundSignalScheduler();
     node.kernel.reset();
+    // SYSCOIN
+    node.mempool_journal.reset();
     node.mempool.reset();
     node.fee_estimator.reset();
     node.chainman.reset();
     node.scheduler.reset();
+    // SYSCOIN
+    node.maintenance_scheduler.reset();
     activeMasternodeManager.reset();
     governance.reset();
     // SYSCOIN
@@ -427,6 +506,8 @@ void Shutdown(NodeContext& node)
     UninterruptibleSleep(std::chrono::milliseconds{200});
 
     LogPrintf("%s: done\n", __func__);
+    // SYSCOIN write out what is still queued for -logasync
+    LogInstance().StopAsyncWriter();
 }
 
 /**
@@ -504,26 +585,42 @@ void SetupServerArgs(ArgsManager& argsman)
 #if HAVE_SYSTEM
     argsman.AddArg("-alertnotify=<cmd>", "Execute command when an alert is raised (%s in cmd is replaced by message)", ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
 #endif
+    // SYSCOIN
+    argsman.AddArg("-addressindex", strprintf("Maintain an index of the history, unspent outputs and balances of every address and asset, used by the getaddress* rpc calls (default: %u)", DEFAULT_ADDRESSINDEX), ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
+    argsman.AddArg("-assetoutputindex", strprintf("Maintain an index of unspent asset outputs by asset and script, used by the getassetoutputs rpc call (default: %u)", DEFAULT_ASSETOUTPUTINDEX), ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
     argsman.AddArg("-assumevalid=<hex>", strprintf("If this block is in the chain assume that it and its ancestors are valid and potentially skip their script verification (0 to verify all, default: %s, testnet: %s, signet: %s)", defaultChainParams->GetConsensus().defaultAssumeValid.GetHex(), testnetChainParams->GetConsensus().defaultAssumeValid.GetHex(), signetChainParams->GetConsensus().defaultAssumeValid.GetHex()), ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
     argsman.AddArg("-blocksdir=<dir>", "Specify directory to hold blocks subdirectory for *.dat files (default: <datadir>)", ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
+    // SYSCOIN
+    argsman.AddArg("-blockmmap", strprintf("Read block files through cached memory mappings instead of file reads (default: %u)", node::DEFAULT_BLOCK_MMAP), ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
     argsman.AddArg("-fastprune", "Use smaller block files and lower minimum prune height for testing purposes", ArgsManager::ALLOW_ANY | ArgsManager::DEBUG_ONLY, OptionsCategory::DEBUG_TEST);
 #if HAVE_SYSTEM
     argsman.AddArg("-blocknotify=<cmd>", "Execute command when the best block changes (%s in cmd is replaced by block hash)", ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
 #endif
     argsman.AddArg("-blockreconstructionextratxn=<n>", strprintf("Extra transactions to keep in memory for compact block reconstructions (default: %u)", DEFAULT_BLOCK_RECONSTRUCTION_EXTRA_TXN), ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
+    // SYSCOIN
+    argsman.AddArg("-blockstatsindex", strprintf("Maintain an index of the statistics of every block, including asset, burn and PoDA figures, used by the getblockstats and getblockstatsrange rpc calls (default: %u)", DEFAULT_BLOCKSTATSINDEX), ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
     argsman.AddArg("-blocksonly", strprintf("Whether to reject transactions from network peers. Automatic broadcast and rebroadcast of any transactions from inbound peers is disabled, unless the peer has the 'forcerelay' permission. RPC transactions are not affected. (default: %u)", DEFAULT_BLOCKSONLY), ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
     argsman.AddArg("-coinstatsindex", strprintf("Maintain coinstats index used by the gettxoutsetinfo RPC (default: %u)", DEFAULT_COINSTATSINDEX), ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
     argsman.AddArg("-conf=<file>", strprintf("Specify path to read-only configuration file. Relative paths will be prefixed by datadir location (only useable from command line, not configuration file) (default: %s)", SYSCOIN_CONF_FILENAME), ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
     argsman.AddArg("-datadir=<dir>", "Specify data directory", ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
     argsman.AddArg("-dbbatchsize", strprintf("Maximum database write batch size in bytes (default: %u)", nDefaultDbBatchSize), ArgsManager::ALLOW_ANY | ArgsManager::DEBUG_ONLY, OptionsCategory::OPTIONS);
     argsman.AddArg("-dbcache=<n>", strprintf("Maximum database cache size <n> MiB (%d to %d, default: %d). In addition, unused mempool memory is shared for this cache (see -maxmempool).", nMinDbCache, nMaxDbCache, nDefaultDbCache), ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
+    // SYSCOIN
+    argsman.AddArg("-dbwritebehind", strprintf("Write flushed coins to the database from a background thread while validation continues (default: %u)", DEFAULT_DB_WRITE_BEHIND), ArgsManager::ALLOW_ANY | ArgsManager::DEBUG_ONLY, OptionsCategory::OPTIONS);
+    argsman.AddArg("-coinsprefetch", strprintf("Read the inputs of a received block from the coin database in parallel before it is connected (default: %u)", DEFAULT_COINS_PREFETCH), ArgsManager::ALLOW_ANY | ArgsManager::DEBUG_ONLY, OptionsCategory::OPTIONS);
     argsman.AddArg("-includeconf=<file>", "Specify additional configuration file, relative to the -datadir path (only useable from configuration file, not command line)", ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
     argsman.AddArg("-allowignoredconf", strprintf("For backwards compatibility, treat an unused %s file in the datadir as a warning, not an error.", SYSCOIN_CONF_FILENAME), ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
     argsman.AddArg("-loadblock=<file>", "Imports blocks from external file on startup", ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
     argsman.AddArg("-maxmempool=<n>", strprintf("Keep the transaction memory pool below <n> megabytes (default: %u)", DEFAULT_MAX_MEMPOOL_SIZE_MB), ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
+    // SYSCOIN
+    argsman.AddArg("-maxpodamempool=<n>", strprintf("Keep the PoDA blob data carried by mempool transactions below <n> megabytes, the transactions paying the least per blob byte are evicted first (default: %u)", DEFAULT_MAX_PODA_MEMPOOL_SIZE_MB), ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
     argsman.AddArg("-maxorphantx=<n>", strprintf("Keep at most <n> unconnectable transactions in memory (default: %u)", DEFAULT_MAX_ORPHAN_TRANSACTIONS), ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
     argsman.AddArg("-mempoolexpiry=<n>", strprintf("Do not keep transactions in the mempool longer than <n> hours (default: %u)", DEFAULT_MEMPOOL_EXPIRY_HOURS), ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
     argsman.AddArg("-minimumchainwork=<hex>", strprintf("Minimum work assumed to exist on a valid chain in hex (default: %s, testnet: %s, signet: %s)", defaultChainParams->GetConsensus().nMinimumChainWork.GetHex(), testnetChainParams->GetConsensus().nMinimumChainWork.GetHex(), signetChainParams->GetConsensus().nMinimumChainWork.GetHex()), ArgsManager::ALLOW_ANY | ArgsManager::DEBUG_ONLY, OptionsCategory::OPTIONS);
+    // SYSCOIN
+    argsman.AddArg("-nevmprehash", strprintf("Hash PoDA blobs of received transactions and blocks in the background before they are validated (default: %u)", DEFAULT_NEVM_PREHASH), ArgsManager::ALLOW_ANY | ArgsManager::DEBUG_ONLY, OptionsCategory::OPTIONS);
+    argsman.AddArg("-memoryprofile", strprintf("Measure the memory of the major subsystems every %d seconds, so getmemoryinfo \"subsystems\" reports the peaks between calls (default: %u)", count_seconds(MEMORY_PROFILE_INTERVAL), DEFAULT_MEMORY_PROFILE), ArgsManager::ALLOW_ANY | ArgsManager::DEBUG_ONLY, OptionsCategory::OPTIONS);
+    argsman.AddArg("-executorthreads=<n>", strprintf("Set the number of threads the BLS and LLMQ work share (0 = auto, up to %d, default: %d)", MAX_EXECUTOR_THREADS, DEFAULT_EXECUTOR_THREADS), ArgsManager::ALLOW_ANY | ArgsManager::DEBUG_ONLY, OptionsCategory::OPTIONS);
     argsman.AddArg("-par=<n>", strprintf("Set the number of script verification threads (0 = auto, up to %d, <0 = leave that many cores free, default: %d)",
         MAX_SCRIPTCHECK_THREADS, DEFAULT_SCRIPTCHECK_THREADS), ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
     argsman.AddArg("-persistmempool", strprintf("Whether to save the mempool on shutdown and load on restart (default: %u)", DEFAULT_PERSIST_MEMPOOL), ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
@@ -532,6 +629,9 @@ void SetupServerArgs(ArgsManager& argsman)
             "Warning: Reverting this setting requires re-downloading the entire blockchain. "
             "(default: 0 = disable pruning blocks, 1 = allow manual pruning via RPC, >=%u = automatically prune block files to stay under the specified target size in MiB)", MIN_DISK_SPACE_FOR_BLOCK_FILES / 1024 / 1024), ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
     argsman.AddArg("-reindex", "If enabled, wipe chain state and block index, and rebuild them from blk*.dat files on disk. Also wipe and rebuild other optional indexes that are active. If an assumeutxo snapshot was loaded, its chainstate will be wiped as well. The snapshot can then be reloaded via RPC.", ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
+    // SYSCOIN
+    argsman.AddArg("-evodbdeltasnapshots", strprintf("Write the daily masternode list snapshots as field-wise deltas to the previous snapshot where possible, which shrinks evodb_dmn. Existing snapshots stay readable either way (default: %u)", DEFAULT_EVODB_DELTA_SNAPSHOTS), ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
+    argsman.AddArg("-syscoinstatedb", strprintf("Keep the masternode, quorum and NEVM state databases in one LevelDB instance that is synced once per flush. Changing this requires -reindex-chainstate (default: %u)", DEFAULT_SYSCOIN_STATE_DB), ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
     argsman.AddArg("-reindex-chainstate", "If enabled, wipe chain state, and rebuild it from blk*.dat files on disk. If an assumeutxo snapshot was loaded, its chainstate will be wiped as well. The snapshot can then be reloaded via RPC.", ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
     argsman.AddArg("-settings=<file>", strprintf("Specify path to dynamic settings data file. Can be disabled with -nosettings. File is written at runtime and not meant to be edited by users (use %s instead for custom settings). Relative paths will be prefixed by datadir location. (default: %s)", SYSCOIN_CONF_FILENAME, SYSCOIN_SETTINGS_FILENAME), ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
     argsman.AddArg("-syncmempool", strprintf("Sync mempool from other nodes on start (default: %u)", DEFAULT_SYNC_MEMPOOL), ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
@@ -545,6 +645,7 @@ void SetupServerArgs(ArgsManager& argsman)
     argsman.AddArg("-sporkaddr=<hex>", strprintf("Override spork address. Only useful for regtest. Using this on mainnet or testnet will ban you."), ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
     argsman.AddArg("-mnconf=<file>", strprintf("Specify masternode configuration file (default: %s)", "masternode.conf"), ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
     argsman.AddArg("-mnconflock=<n>", strprintf("Lock masternodes from masternode configuration file (default: %u)", 1), ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
+    argsman.AddArg("-governancedropvotesigs", strprintf("Drop the signatures of accepted governance votes from memory, they are read back from disk for relay (default: %u)", DEFAULT_GOVERNANCE_DROP_VOTE_SIGS), ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
     argsman.AddArg("-maxrecsigsage=<n>", strprintf("Number of seconds to keep LLMQ recovery sigs (default: %u)", DEFAULT_MAX_RECOVERED_SIGS_AGE), ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
     argsman.AddArg("-masternodeblsprivkey=<n>", "Set the masternode private key", ArgsManager::ALLOW_ANY | ArgsManager::SENSITIVE, OptionsCategory::OPTIONS);
     argsman.AddArg("-minsporkkeys=<n>", "Overrides minimum spork signers to change spork value. Only useful for regtest. Using this on mainnet or testnet will ban you.", ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
@@ -552,10 +653,14 @@ void SetupServerArgs(ArgsManager& argsman)
     argsman.AddArg("-dip3params=<n:m>", "DIP3 params used for testing only", ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
     argsman.AddArg("-hrp=<prefix>", "Bech32 HRP override used for testing only", ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
     argsman.AddArg("-dip19params=<n:m>", "DIP19 params used for testing only", ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
+    argsman.AddArg("-blocktemplatefastcheck", strprintf("Only check the first block template on a tip before it is returned, check later ones built on that tip in the background and report the result in getblocktemplate (default: %u)", node::DEFAULT_BLOCK_TEMPLATE_FAST_CHECK), ArgsManager::ALLOW_ANY, OptionsCategory::BLOCK_CREATION);
+    argsman.AddArg("-blocktemplatecache", strprintf("Keep a block template built in the background once block templates are requested, so getblocktemplate and createauxblock return at once (default: %u)", node::DEFAULT_BLOCK_TEMPLATE_CACHE), ArgsManager::ALLOW_ANY, OptionsCategory::BLOCK_CREATION);
+    argsman.AddArg("-nevmprefetch", strprintf("Keep a NEVM block prefetched from Geth in the background once block templates are requested (default: %u)", node::DEFAULT_NEVM_PREFETCH), ArgsManager::ALLOW_ANY, OptionsCategory::BLOCK_CREATION);
     argsman.AddArg("-nevmstartheight=<n>", "NEVM Start height used for testing only", ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
     argsman.AddArg("-llmqtestparams=<n:m>", "LLMQ params used for testing only", ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
     argsman.AddArg("-mncollateral=<n>", strprintf("Masternode Collateral required, used for testing only (default: %u)", DEFAULT_MN_COLLATERAL_REQUIRED), ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
     argsman.AddArg("-sporkkey=<key>", strprintf("Private key for use with sporks"), ArgsManager::ALLOW_ANY | ArgsManager::SENSITIVE, OptionsCategory::OPTIONS);
+    argsman.AddArg("-quorummemberscache=<n>", strprintf("Number of quorums whose members are kept in memory (default: %u)", llmq::DEFAULT_QUORUM_MEMBERS_CACHE), ArgsManager::ALLOW_ANY | ArgsManager::DEBUG_ONLY, OptionsCategory::OPTIONS);
     argsman.AddArg("-watchquorums=<n>", strprintf("Watch and validate quorum communication (default: %u)", llmq::DEFAULT_WATCH_QUORUMS), ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
     argsman.AddArg("-pushversion=<n>", "Specify running with a protocol version. Only useful for regtest", ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
     argsman.AddArg("-blockfilterindex=<type>",
@@ -579,9 +684,13 @@ void SetupServerArgs(ArgsManager& argsman)
     argsman.AddArg("-listenonion", strprintf("Automatically create Tor onion service (default: %d)", DEFAULT_LISTEN_ONION), ArgsManager::ALLOW_ANY, OptionsCategory::CONNECTION);
     argsman.AddArg("-maxconnections=<n>", strprintf("Maintain at most <n> connections to peers (default: %u). This limit does not apply to connections manually added via -addnode or the addnode RPC, which have a separate limit of %u.", DEFAULT_MAX_PEER_CONNECTIONS, MAX_ADDNODE_CONNECTIONS), ArgsManager::ALLOW_ANY, OptionsCategory::CONNECTION);
     argsman.AddArg("-maxreceivebuffer=<n>", strprintf("Maximum per-connection receive buffer, <n>*1000 bytes (default: %u)", DEFAULT_MAXRECEIVEBUFFER), ArgsManager::ALLOW_ANY, OptionsCategory::CONNECTION);
+    // SYSCOIN
+    argsman.AddArg("-maxbulksendrate=<n>", strprintf("Maximum rate blocks, PoDA blob chunks and other bulk messages are sent to each peer at, <n>*1000 bytes per second. Chainlocks, LLMQ signature shares, headers and compact blocks always go out ahead of them. 0 = no limit (default: %u)", DEFAULT_MAX_BULK_SEND_RATE), ArgsManager::ALLOW_ANY, OptionsCategory::CONNECTION);
     argsman.AddArg("-maxsendbuffer=<n>", strprintf("Maximum per-connection memory usage for the send buffer, <n>*1000 bytes (default: %u)", DEFAULT_MAXSENDBUFFER), ArgsManager::ALLOW_ANY, OptionsCategory::CONNECTION);
     argsman.AddArg("-maxtimeadjustment", strprintf("Maximum allowed median peer time offset adjustment. Local perspective of time may be influenced by outbound peers forward or backward by this amount (default: %u seconds).", DEFAULT_MAX_TIME_ADJUSTMENT), ArgsManager::ALLOW_ANY, OptionsCategory::CONNECTION);
     argsman.AddArg("-maxuploadtarget=<n>", strprintf("Tries to keep outbound traffic under the given target per 24h. Limit does not apply to peers with 'download' permission or blocks created within past week. 0 = no limit (default: %s). Optional suffix units [k|K|m|M|g|G|t|T] (default: M). Lowercase is 1000 base while uppercase is 1024 base", DEFAULT_MAX_UPLOAD_TARGET), ArgsManager::ALLOW_ANY, OptionsCategory::CONNECTION);
+    // SYSCOIN
+    argsman.AddArg("-maxuploadtargetblobs=<n>", strprintf("Tries to keep the PoDA blobs served per 24h under the given target, counted as part of -maxuploadtarget. Once it or -maxuploadtarget is reached, blocks and blob chunks go out without the blobs peers can do without, blobs still needed to validate recent blocks are always sent. Blobs past the enforcement window are never sent. Limit does not apply to peers with 'download' permission. 0 = no limit (default: %s). Optional suffix units [k|K|m|M|g|G|t|T] (default: M). Lowercase is 1000 base while uppercase is 1024 base", DEFAULT_MAX_UPLOAD_TARGET_BLOBS), ArgsManager::ALLOW_ANY, OptionsCategory::CONNECTION);
     argsman.AddArg("-onion=<ip:port>", "Use separate SOCKS5 proxy to reach peers via Tor onion services, set -noonion to disable (default: -proxy)", ArgsManager::ALLOW_ANY, OptionsCategory::CONNECTION);
     argsman.AddArg("-i2psam=<ip:port>", "I2P SAM proxy to reach I2P peers and accept I2P connections (default: none)", ArgsManager::ALLOW_ANY, OptionsCategory::CONNECTION);
     argsman.AddArg("-i2pacceptincoming", strprintf("Whether to accept inbound I2P connections (default: %i). Ignored if -i2psam is not set. Listening for inbound I2P connections is done through the SAM proxy, not by binding to a local address and port.", DEFAULT_I2P_ACCEPT_INCOMING), ArgsManager::ALLOW_ANY, OptionsCategory::CONNECTION);
@@ -637,13 +746,35 @@ void SetupServerArgs(ArgsManager& argsman)
     argsman.AddArg("-zmqpubrawtxhwm=<n>", strprintf("Set publish raw transaction outbound message high water mark (default: %d)", CZMQAbstractNotifier::DEFAULT_ZMQ_SNDHWM), ArgsManager::ALLOW_ANY, OptionsCategory::ZMQ);
     // SYSCOIN
     argsman.AddArg("-zmqpubnevm=<address>", "Enable NEVM publishing/subscriber for Geth node in <address>", ArgsManager::ALLOW_ANY, OptionsCategory::ZMQ);
+    argsman.AddArg("-zmqpubnevmwindow=<n>", strprintf("Number of NEVM block connect messages sent to Geth before waiting for an acknowledgement while replaying assumed-valid blocks (1 to %d, default: %d)", CZMQAbstractNotifier::MAX_NEVM_PIPELINE_WINDOW, CZMQAbstractNotifier::DEFAULT_NEVM_PIPELINE_WINDOW), ArgsManager::ALLOW_ANY, OptionsCategory::ZMQ);
+    argsman.AddArg("-zmqpubnevmbatch=<n>", strprintf("Number of consecutive assumed-valid NEVM block connects sent to Geth as a single message (1 to %d, default: %d)", CZMQAbstractNotifier::MAX_NEVM_BATCH_SIZE, CZMQAbstractNotifier::DEFAULT_NEVM_BATCH_SIZE), ArgsManager::ALLOW_ANY, OptionsCategory::ZMQ);
+    argsman.AddArg("-zmqpubnevmdisconnectbatch", strprintf("Rewind Geth over all NEVM blocks disconnected by a reorg with a single nevmdisconnectbatch message instead of one nevmdisconnect per block (Geth must support it, default: %u)", CZMQAbstractNotifier::DEFAULT_NEVM_DISCONNECT_BATCH), ArgsManager::ALLOW_ANY, OptionsCategory::ZMQ);
+    argsman.AddArg("-zmqpubnevmshm=<path>", "Pass NEVM block data to a co-located Geth node through a shared memory ring buffer at <path> instead of inside ZMQ messages (Geth must map the same file)", ArgsManager::ALLOW_ANY, OptionsCategory::ZMQ);
+    argsman.AddArg("-zmqpubnevmshmsize=<n>", strprintf("Size of the NEVM shared memory ring buffer in MiB (minimum: %d, default: %d)", CZMQSharedRing::MIN_SIZE >> 20, CZMQSharedRing::DEFAULT_SIZE >> 20), ArgsManager::ALLOW_ANY, OptionsCategory::ZMQ);
+    argsman.AddArg("-zmqpubnevmmock", "Answer the NEVM requests sent to the -zmqpubnevm address from an in-process mock Geth node instead of a real one, to measure syscoind on its own (default: 0)", ArgsManager::ALLOW_ANY | ArgsManager::DEBUG_ONLY, OptionsCategory::ZMQ);
+    argsman.AddArg("-zmqpubnevmmocklatency=<n>", "Round trip time in microseconds added to every answer of the mock Geth node (default: 0)", ArgsManager::ALLOW_ANY | ArgsManager::DEBUG_ONLY, OptionsCategory::ZMQ);
+    argsman.AddArg("-zmqpubnevmmockjitter=<n>", "Up to this many microseconds are added to the latency of each request of the mock Geth node at random (default: 0)", ArgsManager::ALLOW_ANY | ArgsManager::DEBUG_ONLY, OptionsCategory::ZMQ);
+    argsman.AddArg("-zmqpubnevmmockblocktime=<n>", "Microseconds the mock Geth node spends connecting each block, blocks are connected one after another (default: 0)", ArgsManager::ALLOW_ANY | ArgsManager::DEBUG_ONLY, OptionsCategory::ZMQ);
+    argsman.AddArg("-zmqpubnevmmockreject=<n>", "Per mille of block connects the mock Geth node rejects (default: 0)", ArgsManager::ALLOW_ANY | ArgsManager::DEBUG_ONLY, OptionsCategory::ZMQ);
+    argsman.AddArg("-zmqpubnevmmockrejectat=<n>", "Number of the block connect request, counting from 1, the mock Geth node rejects (default: 0, none)", ArgsManager::ALLOW_ANY | ArgsManager::DEBUG_ONLY, OptionsCategory::ZMQ);
+    argsman.AddArg("-zmqpubnevmmockdrop=<n>", "Per mille of requests the mock Geth node leaves unanswered (default: 0)", ArgsManager::ALLOW_ANY | ArgsManager::DEBUG_ONLY, OptionsCategory::ZMQ);
     argsman.AddArg("-zmqpubhashgovernancevote=<address>", "Enable publish hash of governance votes transaction in <address>", ArgsManager::ALLOW_ANY, OptionsCategory::ZMQ);
     argsman.AddArg("-zmqpubhashgovernanceobject=<address>", "Enable publish hash of governance objects transaction in <address>", ArgsManager::ALLOW_ANY, OptionsCategory::ZMQ);
     argsman.AddArg("-zmqpubrawgovernancevote=<address>", "Enable publish raw governance votes transaction in <address>", ArgsManager::ALLOW_ANY, OptionsCategory::ZMQ);
     argsman.AddArg("-zmqpubrawgovernanceobject=<address>", "Enable publish raw governance objects transaction in <address>", ArgsManager::ALLOW_ANY, OptionsCategory::ZMQ);
+    argsman.AddArg("-zmqpubzdagstatus=<address>", "Enable publish ZDAG status changes of asset allocation transactions in <address>", ArgsManager::ALLOW_ANY, OptionsCategory::ZMQ);
+    argsman.AddArg("-zmqpubzdagstatushwm=<n>", strprintf("Set publish ZDAG status outbound message high water mark (default: %d)", CZMQAbstractNotifier::DEFAULT_ZMQ_SNDHWM), ArgsManager::ALLOW_ANY, OptionsCategory::ZMQ);
     argsman.AddArg("-zmqpubrawmempooltx=<address>", "Enable publish raw transaction in <address> when entering mempool only", ArgsManager::ALLOW_ANY, OptionsCategory::ZMQ);
     argsman.AddArg("-zmqpubrawmempooltxhwm=<n>", strprintf("Set publish raw mempool transaction outbound message high water mark (default: %d)", CZMQAbstractNotifier::DEFAULT_ZMQ_SNDHWM), ArgsManager::ALLOW_ANY, OptionsCategory::ZMQ);
     argsman.AddArg("-zmqpubsequencehwm=<n>", strprintf("Set publish hash sequence message high water mark (default: %d)", CZMQAbstractNotifier::DEFAULT_ZMQ_SNDHWM), ArgsManager::ALLOW_ANY, OptionsCategory::ZMQ);
+    argsman.AddArg("-zmqpubrawchainlocksig=<address>", "Enable publish raw chainlock signature of each new best chainlock in <address>", ArgsManager::ALLOW_ANY, OptionsCategory::ZMQ);
+    argsman.AddArg("-zmqpubrawchainlocksighwm=<n>", strprintf("Set publish raw chainlock signature outbound message high water mark (default: %d)", CZMQAbstractNotifier::DEFAULT_ZMQ_SNDHWM), ArgsManager::ALLOW_ANY, OptionsCategory::ZMQ);
+    argsman.AddArg("-zmqpubrawmnlistdiff=<address>", "Enable publish raw masternode list diff of each block that changes the list in <address>", ArgsManager::ALLOW_ANY, OptionsCategory::ZMQ);
+    argsman.AddArg("-zmqpubrawmnlistdiffhwm=<n>", strprintf("Set publish raw masternode list diff outbound message high water mark (default: %d)", CZMQAbstractNotifier::DEFAULT_ZMQ_SNDHWM), ArgsManager::ALLOW_ANY, OptionsCategory::ZMQ);
+    argsman.AddArg("-zmqpubrawnevmblob=<address>", "Enable publish raw PoDA blob in <address> when it is stored for the first time", ArgsManager::ALLOW_ANY, OptionsCategory::ZMQ);
+    argsman.AddArg("-zmqpubrawnevmblobhwm=<n>", strprintf("Set publish raw PoDA blob outbound message high water mark (default: %d)", CZMQAbstractNotifier::DEFAULT_ZMQ_SNDHWM), ArgsManager::ALLOW_ANY, OptionsCategory::ZMQ);
+    argsman.AddArg("-zmqpubbatch=<n>", strprintf("Publish up to <n> rawtx, rawmempooltx and sequence messages as one multipart message to subscribers of the batchrawtx, batchrawmempooltx and batchsequence topics. Subscribers of the plain topics still get every message on its own (1 to %d, default: %d, 1 disables batching)", CZMQAbstractNotifier::MAX_ZMQ_BATCH_SIZE, CZMQAbstractNotifier::DEFAULT_ZMQ_BATCH_SIZE), ArgsManager::ALLOW_ANY, OptionsCategory::ZMQ);
+    argsman.AddArg("-zmqpubbatchinterval=<n>", strprintf("Longest time in milliseconds a message is held back for a batch (default: %d)", CZMQAbstractNotifier::DEFAULT_ZMQ_BATCH_INTERVAL), ArgsManager::ALLOW_ANY, OptionsCategory::ZMQ);
 #else
     // SYSCOIN
     hidden_args.emplace_back("-zmqpubhashblock=<address>");
@@ -655,6 +786,8 @@ void SetupServerArgs(ArgsManager& argsman)
     hidden_args.emplace_back("-zmqpubrawgovernancevote=<address>");
     hidden_args.emplace_back("-zmqpubrawgovernanceobject=<address>");
     hidden_args.emplace_back("-zmqpubrawmempooltx=<address>");
+    hidden_args.emplace_back("-zmqpubzdagstatus=<address>");
+    hidden_args.emplace_back("-zmqpubzdagstatushwm=<n>");
     hidden_args.emplace_back("-zmqpubrawmempoolhwm=<n>");
     hidden_args.emplace_back("-zmqpubsequence=<n>");
     hidden_args.emplace_back("-zmqpubhashblockhwm=<n>");
@@ -663,6 +796,25 @@ void SetupServerArgs(ArgsManager& argsman)
     hidden_args.emplace_back("-zmqpubrawtxhwm=<n>");
     hidden_args.emplace_back("-zmqpubsequencehwm=<n>");
     hidden_args.emplace_back("-zmqpubnevm=<address>");
+    hidden_args.emplace_back("-zmqpubnevmwindow=<n>");
+    hidden_args.emplace_back("-zmqpubnevmbatch=<n>");
+    hidden_args.emplace_back("-zmqpubnevmshm=<path>");
+    hidden_args.emplace_back("-zmqpubnevmshmsize=<n>");
+    hidden_args.emplace_back("-zmqpubnevmmock");
+    hidden_args.emplace_back("-zmqpubnevmmocklatency=<n>");
+    hidden_args.emplace_back("-zmqpubnevmmockjitter=<n>");
+    hidden_args.emplace_back("-zmqpubnevmmockblocktime=<n>");
+    hidden_args.emplace_back("-zmqpubnevmmockreject=<n>");
+    hidden_args.emplace_back("-zmqpubnevmmockrejectat=<n>");
+    hidden_args.emplace_back("-zmqpubnevmmockdrop=<n>");
+    hidden_args.emplace_back("-zmqpubbatch=<n>");
+    hidden_args.emplace_back("-zmqpubrawchainlocksig=<address>");
+    hidden_args.emplace_back("-zmqpubrawchainlocksighwm=<n>");
+    hidden_args.emplace_back("-zmqpubrawmnlistdiff=<address>");
+    hidden_args.emplace_back("-zmqpubrawmnlistdiffhwm=<n>");
+    hidden_args.emplace_back("-zmqpubrawnevmblob=<address>");
+    hidden_args.emplace_back("-zmqpubrawnevmblobhwm=<n>");
+    hidden_args.emplace_back("-zmqpubbatchinterval=<n>");
 #endif
 
     argsman.AddArg("-checkblocks=<n>", strprintf("How many blocks to check at startup (default: %u, 0 = all)", DEFAULT_CHECKBLOCKS), ArgsManager::ALLOW_ANY | ArgsManager::DEBUG_ONLY, OptionsCategory::DEBUG_TEST);
@@ -681,7 +833,7 @@ void SetupServerArgs(ArgsManager& argsman)
     argsman.AddArg("-addrmantest", "Allows to test address relay on localhost", ArgsManager::ALLOW_ANY | ArgsManager::DEBUG_ONLY, OptionsCategory::DEBUG_TEST);
     argsman.AddArg("-capturemessages", "Capture all P2P messages to disk", ArgsManager::ALLOW_ANY | ArgsManager::DEBUG_ONLY, OptionsCategory::DEBUG_TEST);
     argsman.AddArg("-mocktime=<n>", "Replace actual time with " + UNIX_EPOCH_TIME + " (default: 0)", ArgsManager::ALLOW_ANY | ArgsManager::DEBUG_ONLY, OptionsCategory::DEBUG_TEST);
-    argsman.AddArg("-maxsigcachesize=<n>", strprintf("Limit sum of signature cache and script execution cache sizes to <n> MiB (default: %u)", DEFAULT_MAX_SIG_CACHE_BYTES >> 20), ArgsManager::ALLOW_ANY | ArgsManager::DEBUG_ONLY, OptionsCategory::DEBUG_TEST);
+    argsman.AddArg("-maxsigcachesize=<n>", strprintf("Limit sum of signature cache, script execution cache and BLS signature cache sizes to <n> MiB (default: %u)", DEFAULT_MAX_SIG_CACHE_BYTES >> 20), ArgsManager::ALLOW_ANY | ArgsManager::DEBUG_ONLY, OptionsCategory::DEBUG_TEST);
     argsman.AddArg("-maxtipage=<n>",
                    strprintf("Maximum tip age in seconds to consider node in initial block download (default: %u)",
                              Ticks<std::chrono::seconds>(DEFAULT_MAX_TIP_AGE)),
@@ -725,7 +877,13 @@ void SetupServerArgs(ArgsManager& argsman)
     argsman.AddArg("-rpcport=<port>", strprintf("Listen for JSON-RPC connections on <port> (default: %u, testnet: %u, signet: %u, regtest: %u)", defaultBaseParams->RPCPort(), testnetBaseParams->RPCPort(), signetBaseParams->RPCPort(), regtestBaseParams->RPCPort()), ArgsManager::ALLOW_ANY | ArgsManager::NETWORK_ONLY, OptionsCategory::RPC);
     argsman.AddArg("-rpcserialversion", strprintf("Sets the serialization of raw transaction or block hex returned in non-verbose mode, non-segwit(0) (DEPRECATED) or segwit(1) (default: %d)", DEFAULT_RPC_SERIALIZE_VERSION), ArgsManager::ALLOW_ANY, OptionsCategory::RPC);
     argsman.AddArg("-rpcservertimeout=<n>", strprintf("Timeout during HTTP requests (default: %d)", DEFAULT_HTTP_SERVER_TIMEOUT), ArgsManager::ALLOW_ANY | ArgsManager::DEBUG_ONLY, OptionsCategory::RPC);
+    // SYSCOIN
+    argsman.AddArg("-metricsbind=<addr>[:port]", strprintf("Serve counters of validation, the mempool, LLMQ, NEVM and the network in the Prometheus text format at http://<addr>:<port>/metrics. There is no authentication, do not expose it to untrusted networks. Use [host]:port notation for IPv6. This option can be specified multiple times (default: off, port: %u)", DEFAULT_METRICS_PORT), ArgsManager::ALLOW_ANY | ArgsManager::NETWORK_ONLY, OptionsCategory::RPC);
     argsman.AddArg("-rpcthreads=<n>", strprintf("Set the number of threads to service RPC calls (default: %d)", DEFAULT_HTTP_THREADS), ArgsManager::ALLOW_ANY, OptionsCategory::RPC);
+    // SYSCOIN
+    argsman.AddArg("-rpcprioritythreads=<n>", strprintf("Set the number of threads, on top of -rpcthreads, that only service high priority RPC calls such as mining and chainlock calls (default: %d)", DEFAULT_HTTP_PRIORITY_THREADS), ArgsManager::ALLOW_ANY, OptionsCategory::RPC);
+    argsman.AddArg("-rpcuserthreads=<user>:<n>", "Reserve <n> threads, on top of -rpcthreads, for the RPC calls of <user>. Calls of <user> are queued apart from those of other users. This option can be specified multiple times", ArgsManager::ALLOW_ANY, OptionsCategory::RPC);
+    argsman.AddArg("-rpcmethodpriority=<method>:<high|normal|low>", "Set the priority class of RPC <method>. High priority calls run first and also on the -rpcprioritythreads, low priority calls are kept off one of the -rpcthreads. This option can be specified multiple times", ArgsManager::ALLOW_ANY, OptionsCategory::RPC);
     argsman.AddArg("-rpcuser=<user>", "Username for JSON-RPC connections", ArgsManager::ALLOW_ANY | ArgsManager::SENSITIVE, OptionsCategory::RPC);
     argsman.AddArg("-rpcwhitelist=<whitelist>", "Set a whitelist to filter incoming RPC calls for a specific user. The field <whitelist> comes in the format: <USERNAME>:<rpc 1>,<rpc 2>,...,<rpc n>. If multiple whitelists are set for a given user, they are set-intersected. See -rpcwhitelistdefault documentation for information on default whitelist behavior.", ArgsManager::ALLOW_ANY, OptionsCategory::RPC);
     argsman.AddArg("-rpcwhitelistdefault", "Sets default behavior for rpc whitelisting. Unless rpcwhitelistdefault is set to 0, if any -rpcwhitelist is set, the rpc server acts as if all rpc users are subject to empty-unless-otherwise-specified whitelists. If rpcwhitelistdefault is set to 1 and no -rpcwhitelist is set, rpc server acts as if all rpc users are subject to empty whitelists.", ArgsManager::ALLOW_ANY, OptionsCategory::RPC);
@@ -1033,6 +1191,13 @@ bool AppInitParameterInteraction(const ArgsManager& args)
     if (args.GetIntArg("-prune", 0)) {
         if (args.GetBoolArg("-txindex", DEFAULT_TXINDEX))
             return InitError(_("Prune mode is incompatible with -txindex."));
+        // SYSCOIN
+        if (args.GetBoolArg("-assetoutputindex", DEFAULT_ASSETOUTPUTINDEX))
+            return InitError(_("Prune mode is incompatible with -assetoutputindex."));
+        if (args.GetBoolArg("-addressindex", DEFAULT_ADDRESSINDEX))
+            return InitError(_("Prune mode is incompatible with -addressindex."));
+        if (args.GetBoolArg("-blockstatsindex", DEFAULT_BLOCKSTATSINDEX))
+            return InitError(_("Prune mode is incompatible with -blockstatsindex."));
         if (args.GetBoolArg("-reindex-chainstate", false)) {
             return InitError(_("Prune mode is incompatible with -reindex-chainstate. Use full -reindex instead."));
         }
@@ -1225,8 +1390,22 @@ std::string GetDefaultPubNEVM() {
     std::string defaultPubNevm = (!fRegTest && !fSigNet)? "tcp://127.0.0.1:1111": "";
     return defaultPubNevm;
 }
+// SYSCOIN
+static void RecordStartupPhase(NodeContext& node, const std::string& name, std::chrono::milliseconds duration)
+{
+    LogPrintf("Startup phase %s: %dms\n", name, duration.count());
+    node.startup_timings.emplace_back(name, duration);
+}
+
+static std::chrono::milliseconds MillisecondsSince(SteadyClock::time_point start)
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(SteadyClock::now() - start);
+}
+
 bool AppInitMain(NodeContext& node, interfaces::BlockAndHeaderTipInfo* tip_info)
 {
+    // SYSCOIN
+    const auto init_start_time{SteadyClock::now()};
     const ArgsManager& args = *Assert(node.args);
     const CChainParams& chainparams = Params();
     // SYSCOIN
@@ -1237,6 +1416,11 @@ bool AppInitMain(NodeContext& node, interfaces::BlockAndHeaderTipInfo* tip_info)
     if (!opt_max_upload) {
         return InitError(strprintf(_("Unable to parse -maxuploadtarget: '%s'"), args.GetArg("-maxuploadtarget", "")));
     }
+    // SYSCOIN
+    auto opt_max_upload_blobs = ParseByteUnits(args.GetArg("-maxuploadtargetblobs", DEFAULT_MAX_UPLOAD_TARGET_BLOBS), ByteUnit::M);
+    if (!opt_max_upload_blobs) {
+        return InitError(strprintf(_("Unable to parse -maxuploadtargetblobs: '%s'"), args.GetArg("-maxuploadtargetblobs", "")));
+    }
 
     // ********************************************************* Step 4a: application initialization
     if (!CreatePidFile(args)) {
@@ -1262,7 +1446,8 @@ bool AppInitMain(NodeContext& node, interfaces::BlockAndHeaderTipInfo* tip_info)
     ValidationCacheSizes validation_cache_sizes{};
     ApplyArgsManOptions(args, validation_cache_sizes);
     if (!InitSignatureCache(validation_cache_sizes.signature_cache_bytes)
-        || !InitScriptExecutionCache(validation_cache_sizes.script_execution_cache_bytes))
+        || !InitScriptExecutionCache(validation_cache_sizes.script_execution_cache_bytes)
+        || !InitBLSSignatureCache(validation_cache_sizes.bls_signature_cache_bytes))
     {
         return InitError(strprintf(_("Unable to allocate memory for -maxsigcachesize: '%s' MiB"), args.GetIntArg("-maxsigcachesize", DEFAULT_MAX_SIG_CACHE_BYTES >> 20)));
     }
@@ -1285,7 +1470,10 @@ bool AppInitMain(NodeContext& node, interfaces::BlockAndHeaderTipInfo* tip_info)
         StartScriptCheckWorkerThreads(script_threads);
     }
 
-    // SYSCOIN
+    // SYSCOIN the BLS worker and the quorum manager run their work on the shared executor
+    StartSharedExecutor(args.GetIntArg("-executorthreads", DEFAULT_EXECUTOR_THREADS));
+    LogPrintf("Shared executor uses %d threads\n", GetSharedExecutor().ThreadCount());
+
     assert(activeMasternodeInfo.blsKeyOperator == nullptr);
     assert(activeMasternodeInfo.blsPubKeyOperator == nullptr);
     fMasternodeMode = false;
@@ -1314,11 +1502,16 @@ bool AppInitMain(NodeContext& node, interfaces::BlockAndHeaderTipInfo* tip_info)
 
     // Start the lightweight task scheduler thread
     node.scheduler->m_service_thread = std::thread(util::TraceThread, "scheduler", [&] { node.scheduler->serviceQueue(); });
+    // SYSCOIN the slow masternode and governance maintenance runs on a lane of its own, so it
+    // cannot hold up the validation interface callbacks and the other tasks of the scheduler
+    assert(!node.maintenance_scheduler);
+    node.maintenance_scheduler = std::make_unique<CScheduler>("maintenance");
+    node.maintenance_scheduler->m_service_thread = std::thread(util::TraceThread, "maintenance", [&] { node.maintenance_scheduler->serviceQueue(); });
 
     // Gather some entropy once per minute.
     node.scheduler->scheduleEvery([]{
         RandAddPeriodic();
-    }, std::chrono::minutes{1});
+    }, std::chrono::minutes{1}, "randaddperiodic");
 
     // Check disk space every 5 minutes to avoid db corruption.
     node.scheduler->scheduleEvery([&args]{
@@ -1327,7 +1520,7 @@ bool AppInitMain(NodeContext& node, interfaces::BlockAndHeaderTipInfo* tip_info)
             LogPrintf("Shutting down due to lack of disk space!\n");
             StartShutdown();
         }
-    }, std::chrono::minutes{5});
+    }, std::chrono::minutes{5}, "checkdiskspace");
 
     GetMainSignals().RegisterBackgroundSignalScheduler(*node.scheduler);
 
@@ -1360,6 +1553,14 @@ bool AppInitMain(NodeContext& node, interfaces::BlockAndHeaderTipInfo* tip_info)
         if (!AppInitServers(node))
             return InitError(_("Unable to start HTTP server. See debug log for details."));
     }
+    // SYSCOIN the metrics are served without -server and without the RPC work queue
+    if (!StartMetricsServer(args)) {
+        return InitError(_("Unable to start the metrics server. See debug log for details."));
+    }
+    // SYSCOIN the BLS key cache is below the node, its counters are read when the metrics are rendered
+    metrics::GlobalRegistry().AddCounterCallback("syscoin_bls_pubkey_cache_hits_total", "BLS public keys served decoded from the cache", [] { return int64_t(GetBLSPublicKeyCacheStats().hits); });
+    metrics::GlobalRegistry().AddCounterCallback("syscoin_bls_pubkey_cache_misses_total", "BLS public keys decoded because the cache did not have them", [] { return int64_t(GetBLSPublicKeyCacheStats().misses); });
+    metrics::GlobalRegistry().AddGaugeCallback("syscoin_bls_pubkey_cache_entries", "Decoded BLS public keys in the cache", [] { return int64_t(GetBLSPublicKeyCacheStats().entries); });
 
     // ********************************************************* Step 5: verify wallet database integrity
     for (const auto& client : node.chain_clients) {
@@ -1435,7 +1636,7 @@ bool AppInitMain(NodeContext& node, interfaces::BlockAndHeaderTipInfo* tip_info)
 
         // Flush estimates to disk periodically
         CBlockPolicyEstimator* fee_estimator = node.fee_estimator.get();
-        node.scheduler->scheduleEvery([fee_estimator] { fee_estimator->FlushFeeEstimates(); }, FEE_FLUSH_INTERVAL);
+        node.scheduler->scheduleEvery([fee_estimator] { fee_estimator->FlushFeeEstimates(); }, FEE_FLUSH_INTERVAL, "flushfeeestimates");
     }
 
     // Check port numbers
@@ -1600,6 +1801,25 @@ bool AppInitMain(NodeContext& node, interfaces::BlockAndHeaderTipInfo* tip_info)
     // SYSCOIN
     fNEVMSub = gArgs.GetArg("-zmqpubnevm", GetDefaultPubNEVM());
     fNEVMConnection = !fNEVMSub.empty();
+    nNEVMPipelineWindow = std::clamp<int>(args.GetIntArg("-zmqpubnevmwindow", CZMQAbstractNotifier::DEFAULT_NEVM_PIPELINE_WINDOW), 1, CZMQAbstractNotifier::MAX_NEVM_PIPELINE_WINDOW);
+    nNEVMBatchSize = std::clamp<int>(args.GetIntArg("-zmqpubnevmbatch", CZMQAbstractNotifier::DEFAULT_NEVM_BATCH_SIZE), 1, CZMQAbstractNotifier::MAX_NEVM_BATCH_SIZE);
+    fNEVMDisconnectBatch = args.GetBoolArg("-zmqpubnevmdisconnectbatch", CZMQAbstractNotifier::DEFAULT_NEVM_DISCONNECT_BATCH);
+    nZMQBatchSize = std::clamp<int>(args.GetIntArg("-zmqpubbatch", CZMQAbstractNotifier::DEFAULT_ZMQ_BATCH_SIZE), 1, CZMQAbstractNotifier::MAX_ZMQ_BATCH_SIZE);
+    nZMQBatchInterval = std::max<int>(args.GetIntArg("-zmqpubbatchinterval", CZMQAbstractNotifier::DEFAULT_ZMQ_BATCH_INTERVAL), 1);
+    if(fNEVMConnection && args.GetBoolArg("-zmqpubnevmmock", false)) {
+        CZMQNEVMResponder::Options mock_options;
+        mock_options.latency = std::chrono::microseconds{std::max<int64_t>(args.GetIntArg("-zmqpubnevmmocklatency", 0), 0)};
+        mock_options.jitter = std::chrono::microseconds{std::max<int64_t>(args.GetIntArg("-zmqpubnevmmockjitter", 0), 0)};
+        mock_options.block_time = std::chrono::microseconds{std::max<int64_t>(args.GetIntArg("-zmqpubnevmmockblocktime", 0), 0)};
+        mock_options.reject_permille = std::clamp<int>(args.GetIntArg("-zmqpubnevmmockreject", 0), 0, 1000);
+        mock_options.reject_request = std::max<int64_t>(args.GetIntArg("-zmqpubnevmmockrejectat", 0), 0);
+        mock_options.drop_permille = std::clamp<int>(args.GetIntArg("-zmqpubnevmmockdrop", 0), 0, 1000);
+        g_nevm_mock_responder = std::make_unique<CZMQNEVMResponder>(mock_options);
+        if(!g_nevm_mock_responder->Start(fNEVMSub)) {
+            return InitError(Untranslated("Could not start the mock Geth node on the -zmqpubnevm address"));
+        }
+        LogPrintf("Answering NEVM requests from a mock Geth node on %s\n", fNEVMSub);
+    }
     g_zmq_notification_interface = CZMQNotificationInterface::Create(
         [&chainman = node.chainman](CBlock& block, const CBlockIndex& index) {
             assert(chainman);
@@ -1610,9 +1830,19 @@ bool AppInitMain(NodeContext& node, interfaces::BlockAndHeaderTipInfo* tip_info)
         if(!g_zmq_notification_interface) {
             return InitError(Untranslated("Could not establish ZMQ interface connections, check your ZMQ settings and try again..."));
         }
+        if(args.IsArgSet("-zmqpubnevmshm")) {
+            const size_t nShmSize = std::max<int64_t>(args.GetIntArg("-zmqpubnevmshmsize", CZMQSharedRing::DEFAULT_SIZE >> 20), CZMQSharedRing::MIN_SIZE >> 20) << 20;
+            if(!g_nevm_shm.Open(args.GetPathArg("-zmqpubnevmshm"), nShmSize)) {
+                return InitError(Untranslated("Could not map the NEVM shared memory ring buffer set by -zmqpubnevmshm"));
+            }
+        }
     }
     if (g_zmq_notification_interface) {
         RegisterValidationInterface(g_zmq_notification_interface.get());
+        // SYSCOIN a partial batch is published once it has waited long enough, even if no message follows
+        if (nZMQBatchSize > 1) {
+            node.scheduler->scheduleEvery([] { g_zmq_notification_interface->FlushBatches(); }, std::chrono::milliseconds{nZMQBatchInterval}, "zmqflushbatches");
+        }
     }
 #endif
 
@@ -1676,6 +1906,10 @@ bool AppInitMain(NodeContext& node, interfaces::BlockAndHeaderTipInfo* tip_info)
     if (mempool_opts.max_size_bytes < 0 || mempool_opts.max_size_bytes < descendant_limit_bytes) {
         return InitError(strprintf(_("-maxmempool must be at least %d MB"), std::ceil(descendant_limit_bytes / 1'000'000.0)));
     }
+    // SYSCOIN
+    if (mempool_opts.max_poda_size_bytes < MAX_NEVM_DATA_BLOB) {
+        return InitError(strprintf(_("-maxpodamempool must be at least %d MB"), std::ceil(MAX_NEVM_DATA_BLOB / 1'000'000.0)));
+    }
     LogPrintf("* Using %.1f MiB for in-memory UTXO set (plus up to %.1f MiB of unused mempool space)\n", cache_sizes.coins * (1.0 / 1024 / 1024), mempool_opts.max_size_bytes * (1.0 / 1024 / 1024));
     for (bool fLoaded = false; !fLoaded && !ShutdownRequested();) {
         node.mempool = std::make_unique<CTxMemPool>(mempool_opts);
@@ -1719,6 +1953,8 @@ bool AppInitMain(NodeContext& node, interfaces::BlockAndHeaderTipInfo* tip_info)
         // SYSCOIN
         node::ChainstateLoadOptions options;
         options.fReindexGeth = fReindexGeth;
+        options.syscoin_state_db = args.GetBoolArg("-syscoinstatedb", DEFAULT_SYSCOIN_STATE_DB);
+        options.evodb_delta_snapshots = args.GetBoolArg("-evodbdeltasnapshots", DEFAULT_EVODB_DELTA_SNAPSHOTS);
         options.connman = Assert(node.connman.get());
         options.banman = Assert(node.banman.get());
         options.peerman = Assert(node.peerman.get());
@@ -1748,6 +1984,9 @@ bool AppInitMain(NodeContext& node, interfaces::BlockAndHeaderTipInfo* tip_info)
         };
         auto [status, error] = catch_exceptions([&]{ return LoadChainstate(chainman, cache_sizes, options); });
         if (status == node::ChainstateLoadStatus::SUCCESS) {
+            // SYSCOIN
+            RecordStartupPhase(node, "load_chainstate", MillisecondsSince(load_block_index_start_time));
+            const auto verify_start_time{SteadyClock::now()};
             uiInterface.InitMessage(_("Verifying blocks…").translated);
             if (chainman.m_blockman.m_have_pruned && options.check_blocks > MIN_BLOCKS_TO_KEEP) {
                 LogPrintfCategory(BCLog::PRUNE, "pruned datadir may not have more than %d blocks; only checking available blocks\n",
@@ -1763,6 +2002,7 @@ bool AppInitMain(NodeContext& node, interfaces::BlockAndHeaderTipInfo* tip_info)
             std::tie(status, error) = catch_exceptions([&]{ return VerifyLoadedChainstate(chainman, options);});
             if (status == node::ChainstateLoadStatus::SUCCESS) {
                 fLoaded = true;
+                RecordStartupPhase(node, "verify_chainstate", MillisecondsSince(verify_start_time));
                 LogPrintf(" block index %15dms\n", Ticks<std::chrono::milliseconds>(SteadyClock::now() - load_block_index_start_time));
             }
         }
@@ -1885,6 +2125,19 @@ bool AppInitMain(NodeContext& node, interfaces::BlockAndHeaderTipInfo* tip_info)
         g_coin_stats_index = std::make_unique<CoinStatsIndex>(interfaces::MakeChain(node), /*cache_size=*/0, false, fReindex);
         node.indexes.emplace_back(g_coin_stats_index.get());
     }
+    // SYSCOIN
+    if (args.GetBoolArg("-assetoutputindex", DEFAULT_ASSETOUTPUTINDEX)) {
+        g_asset_index = std::make_unique<AssetIndex>(interfaces::MakeChain(node), /*cache_size=*/0, false, fReindex);
+        node.indexes.emplace_back(g_asset_index.get());
+    }
+    if (args.GetBoolArg("-addressindex", DEFAULT_ADDRESSINDEX)) {
+        g_address_index = std::make_unique<AddressIndex>(interfaces::MakeChain(node), /*cache_size=*/0, false, fReindex);
+        node.indexes.emplace_back(g_address_index.get());
+    }
+    if (args.GetBoolArg("-blockstatsindex", DEFAULT_BLOCKSTATSINDEX)) {
+        g_block_stats_index = std::make_unique<BlockStatsIndex>(interfaces::MakeChain(node), /*cache_size=*/0, false, fReindex);
+        node.indexes.emplace_back(g_block_stats_index.get());
+    }
 
     // Init indexes
     for (auto index : node.indexes) if (!index->Init()) return false;
@@ -1972,6 +2225,11 @@ bool AppInitMain(NodeContext& node, interfaces::BlockAndHeaderTipInfo* tip_info)
         vImportFiles.push_back(fs::PathFromString(strFile));
     }
 
+    // SYSCOIN journal the mempool changes once the dump was loaded, and compact it from the scheduler thread
+    if (node.mempool && ShouldPersistMempool(args)) {
+        node.mempool_journal = std::make_unique<kernel::MempoolJournal>(*node.mempool, MempoolPath(args), MempoolJournalPath(args));
+        node.scheduler->scheduleEvery([&node] { node.mempool_journal->MaybeCompact(); }, std::chrono::minutes{1}, "mempooljournal");
+    }
     chainman.m_thread_load = std::thread(&util::TraceThread, "initload", [=, &chainman, &args, &node] {
         // SYSCOIN Import blocks
         ImportBlocks(chainman, vImportFiles, pdsNotificationInterface, deterministicMNManager, activeMasternodeManager, g_wallet_init_interface, node);
@@ -1988,8 +2246,13 @@ bool AppInitMain(NodeContext& node, interfaces::BlockAndHeaderTipInfo* tip_info)
         }
         // Load mempool from disk
         if (auto* pool{chainman.ActiveChainstate().GetMempool()}) {
-            LoadMempool(*pool, ShouldPersistMempool(args) ? MempoolPath(args) : fs::path{}, chainman.ActiveChainstate(), {});
+            // SYSCOIN
+            LoadMempool(*pool, ShouldPersistMempool(args) ? MempoolPath(args) : fs::path{}, chainman.ActiveChainstate(), {.journal_path = MempoolJournalPath(args)});
             pool->SetLoadTried(!chainman.m_interrupt);
+            if (node.mempool_journal && !chainman.m_interrupt) {
+                RegisterValidationInterface(node.mempool_journal.get());
+                node.mempool_journal->Start();
+            }
         }
     });
     // Wait for genesis block to be processed
@@ -2012,6 +2275,24 @@ bool AppInitMain(NodeContext& node, interfaces::BlockAndHeaderTipInfo* tip_info)
             return InitError(_("Unable to start ZMQ interface. See debug log for details."));
         }
     #endif
+    if(fNEVMConnection && args.GetBoolArg("-nevmprefetch", node::DEFAULT_NEVM_PREFETCH)) {
+        node::g_nevm_prefetcher = std::make_unique<node::NEVMBlockPrefetcher>(chainman);
+        RegisterValidationInterface(node::g_nevm_prefetcher.get());
+        node::g_nevm_prefetcher->Start();
+    }
+    if(args.GetBoolArg("-blocktemplatefastcheck", node::DEFAULT_BLOCK_TEMPLATE_FAST_CHECK)) {
+        node::g_block_template_validator = std::make_unique<node::BlockTemplateValidator>(chainman);
+        node::g_block_template_validator->Start();
+    }
+    if(args.GetBoolArg("-blocktemplatecache", node::DEFAULT_BLOCK_TEMPLATE_CACHE)) {
+        node::g_block_template_cache = std::make_unique<node::BlockTemplateCache>(chainman, *node.mempool);
+        RegisterValidationInterface(node::g_block_template_cache.get());
+        node::g_block_template_cache->Start();
+    }
+    if(args.GetBoolArg("-nevmprehash", DEFAULT_NEVM_PREHASH)) {
+        g_nevm_blob_hasher = std::make_unique<NEVMBlobHasher>();
+        g_nevm_blob_hasher->Start();
+    }
     // SYSCOIN ********************************************************* Step 11b: Load cache data
 
     // LOAD SERIALIZED DAT FILES INTO DATA CACHES FOR INTERNAL USE
@@ -2040,22 +2321,41 @@ bool AppInitMain(NodeContext& node, interfaces::BlockAndHeaderTipInfo* tip_info)
     }
     bool fLoadCacheFiles = !(fReindex || fReindexChainState);
     uiInterface.InitMessage(_("Loading caches...").translated);
-    if (!sporkManager->LoadCache()) {
+    const auto caches_start_time{SteadyClock::now()};
+    // the fulfilled requests and masternode meta caches depend on nothing else, so they load in the
+    // background while the sporks and then governance (which reads spork state) load here
+    auto load_timed = [](auto&& load) {
+        const auto start{SteadyClock::now()};
+        const bool ret{load()};
+        return std::make_pair(ret, MillisecondsSince(start));
+    };
+    auto netfulfilled_load{std::async(std::launch::async, [&] { return load_timed([&] { return netfulfilledman->LoadCache(fLoadCacheFiles); }); })};
+    auto mmeta_load{std::async(std::launch::async, [&] { return load_timed([&] { return mmetaman->LoadCache(fLoadCacheFiles); }); })};
+    const auto [spork_loaded, spork_time] = load_timed([&] { return sporkManager->LoadCache(); });
+    const auto [governance_loaded, governance_time] = load_timed([&] { return governance->LoadCache(fLoadCacheFiles); });
+    const auto [netfulfilled_loaded, netfulfilled_time] = netfulfilled_load.get();
+    const auto [mmeta_loaded, mmeta_time] = mmeta_load.get();
+    RecordStartupPhase(node, "load_sporks", spork_time);
+    RecordStartupPhase(node, "load_netfulfilled", netfulfilled_time);
+    RecordStartupPhase(node, "load_mnmeta", mmeta_time);
+    RecordStartupPhase(node, "load_governance", governance_time);
+    RecordStartupPhase(node, "load_caches", MillisecondsSince(caches_start_time));
+    if (!spork_loaded) {
         return InitError(Untranslated("Failed to load sporks cache\n"));
     }
-    if (!netfulfilledman->LoadCache(fLoadCacheFiles)) {
+    if (!netfulfilled_loaded) {
         if (fLoadCacheFiles) {
             return InitError(Untranslated("Failed to load fulfilled requests cache"));
         }
         return InitError(Untranslated("Failed to clear fulfilled requests cache"));
     }
-    if (!mmetaman->LoadCache(fLoadCacheFiles)) {
+    if (!mmeta_loaded) {
         if (fLoadCacheFiles) {
             return InitError(Untranslated("Failed to load masternode cache"));
         }
         return InitError(Untranslated("Failed to clear masternode cache"));
     }
-    if (!governance->LoadCache(fLoadCacheFiles)) {
+    if (!governance_loaded) {
         if (fLoadCacheFiles) {
             return InitError(Untranslated("Failed to load governance cache"));
         }
@@ -2065,14 +2365,20 @@ bool AppInitMain(NodeContext& node, interfaces::BlockAndHeaderTipInfo* tip_info)
         return false;
     }
 
-    node.scheduler->scheduleEvery([&] { netfulfilledman->DoMaintenance(); }, std::chrono::minutes{1});
-    node.scheduler->scheduleEvery([&] { masternodeSync.DoMaintenance(*node.connman, *node.peerman); }, std::chrono::seconds{1});
-    node.scheduler->scheduleEvery(std::bind(CMasternodeUtils::DoMaintenance, std::ref(*node.connman)), std::chrono::minutes{1});
-    node.scheduler->scheduleEvery([&] { governance->DoMaintenance(*node.connman); }, std::chrono::minutes{5});
+    node.maintenance_scheduler->scheduleEvery([&] { netfulfilledman->DoMaintenance(); }, std::chrono::minutes{1}, "netfulfilled");
+    node.scheduler->scheduleEvery([&] { masternodeSync.DoMaintenance(*node.connman, *node.peerman); }, std::chrono::seconds{1}, "masternodesync");
+    node.maintenance_scheduler->scheduleEvery(std::bind(CMasternodeUtils::DoMaintenance, std::ref(*node.connman)), std::chrono::minutes{1}, "masternodeutils");
+    node.maintenance_scheduler->scheduleEvery([&] { governance->DoMaintenance(*node.connman); }, std::chrono::minutes{5}, "governance");
+    node.maintenance_scheduler->scheduleEvery([&] { governance->ProcessVoteSyncs(*node.connman, *node.peerman); }, std::chrono::seconds{1}, "governancevotesync");
     if (activeMasternodeManager) {
-        node.scheduler->scheduleEvery([&] { llmq::quorumDKGSessionManager->CleanupOldContributions(*node.chainman); }, std::chrono::hours{1});
+        node.maintenance_scheduler->scheduleEvery([&] { llmq::quorumDKGSessionManager->CleanupOldContributions(*node.chainman); }, std::chrono::hours{1}, "dkgcleanup");
     }
+    if (args.GetBoolArg("-memoryprofile", DEFAULT_MEMORY_PROFILE)) {
+        node.maintenance_scheduler->scheduleEvery([&node] { node::SampleSubsystemMemory(node); }, MEMORY_PROFILE_INTERVAL, "memoryprofile");
+    }
+    const auto llmq_start_time{SteadyClock::now()};
     llmq::StartLLMQSystem();
+    RecordStartupPhase(node, "start_llmq", MillisecondsSince(llmq_start_time));
     // ********************************************************* Step 12: start node
 
     //// debug print
@@ -2108,8 +2414,12 @@ bool AppInitMain(NodeContext& node, interfaces::BlockAndHeaderTipInfo* tip_info)
     connOptions.m_msgproc = node.peerman.get();
     connOptions.nSendBufferMaxSize = 1000 * args.GetIntArg("-maxsendbuffer", DEFAULT_MAXSENDBUFFER);
     connOptions.nReceiveFloodSize = 1000 * args.GetIntArg("-maxreceivebuffer", DEFAULT_MAXRECEIVEBUFFER);
+    // SYSCOIN
+    connOptions.m_max_bulk_send_rate = 1000 * std::max<int64_t>(0, args.GetIntArg("-maxbulksendrate", DEFAULT_MAX_BULK_SEND_RATE));
     connOptions.m_added_nodes = args.GetArgs("-addnode");
     connOptions.nMaxOutboundLimit = *opt_max_upload;
+    // SYSCOIN
+    connOptions.nMaxOutboundBlobLimit = *opt_max_upload_blobs;
     connOptions.m_peer_connect_timeout = peer_connect_timeout;
 
     // Port to bind to if `-bind=addr` is provided without a `:port` suffix.
@@ -2250,6 +2560,8 @@ bool AppInitMain(NodeContext& node, interfaces::BlockAndHeaderTipInfo* tip_info)
     // hash=0x0. This will lead to erroroneous responses for things like
     // waitforblockheight.
     RPCNotifyBlockChange(WITH_LOCK(chainman.GetMutex(), return chainman.ActiveTip()));
+    // SYSCOIN
+    RecordStartupPhase(node, "total", MillisecondsSince(init_start_time));
     SetRPCWarmupFinished();
 
     uiInterface.InitMessage(_("Done loading").translated);
@@ -2261,7 +2573,7 @@ bool AppInitMain(NodeContext& node, interfaces::BlockAndHeaderTipInfo* tip_info)
     BanMan* banman = node.banman.get();
     node.scheduler->scheduleEvery([banman]{
         banman->DumpBanlist();
-    }, DUMP_BANS_INTERVAL);
+    }, DUMP_BANS_INTERVAL, "dumpbanlist");
 
     if (node.peerman) node.peerman->StartScheduledTasks(*node.scheduler);
 
@@ -41,6 +41,9 @@ void AddLoggingArgs(ArgsManager& argsman)
     argsman.AddArg("-logsourcelocations", strprintf("Prepend debug output with name of the originating source location (source file, line number and function name) (default: %u)", DEFAULT_LOGSOURCELOCATIONS), ArgsManager::ALLOW_ANY, OptionsCategory::DEBUG_TEST);
     argsman.AddArg("-logtimemicros", strprintf("Add microsecond precision to debug timestamps (default: %u)", DEFAULT_LOGTIMEMICROS), ArgsManager::ALLOW_ANY | ArgsManager::DEBUG_ONLY, OptionsCategory::DEBUG_TEST);
     argsman.AddArg("-printtoconsole", "Send trace/debug info to console (default: 1 when no -daemon. To disable logging to file, set -nodebuglogfile)", ArgsManager::ALLOW_ANY, OptionsCategory::DEBUG_TEST);
+    // SYSCOIN
+    argsman.AddArg("-logasync", strprintf("Write debug output from a background thread, so logging threads do not wait for the console and the debug log file (default: %u)", DEFAULT_LOGASYNC), ArgsManager::ALLOW_ANY, OptionsCategory::DEBUG_TEST);
+    argsman.AddArg("-logasyncbuffer=<n>", strprintf("With -logasync, MiB of debug output waiting to be written before further messages are dropped (default: %u)", DEFAULT_LOGASYNC_BUFFER), ArgsManager::ALLOW_ANY | ArgsManager::DEBUG_ONLY, OptionsCategory::DEBUG_TEST);
     argsman.AddArg("-shrinkdebugfile", "Shrink debug.log file on client startup (default: 1 when no -debug)", ArgsManager::ALLOW_ANY, OptionsCategory::DEBUG_TEST);
 }
 
@@ -102,6 +105,10 @@ util::Result<void> SetLoggingCategories(const ArgsManager& args)
             return util::Error{strprintf(_("Unsupported logging category %s=%s."), "-debugexclude", cat)};
         }
     }
+    // SYSCOIN
+    if (LogInstance().GetCategoryMask() & BCLog::COMPILED_OUT_CATEGORIES) {
+        LogPrintf("Debug logging of llmq-sigs and syscoin is compiled out of this build (--disable-verbose-logging)\n");
+    }
     return {};
 }
 
@@ -118,6 +125,10 @@ bool StartLogging(const ArgsManager& args)
             return InitError(strprintf(Untranslated("Could not open debug log file %s"),
                 fs::PathToString(LogInstance().m_file_path)));
     }
+    // SYSCOIN
+    if (args.GetBoolArg("-logasync", DEFAULT_LOGASYNC)) {
+        LogInstance().StartAsyncWriter(std::max<int64_t>(args.GetIntArg("-logasyncbuffer", DEFAULT_LOGASYNC_BUFFER), 1) << 20);
+    }
 
     if (!LogInstance().m_log_timestamps)
         LogPrintf("Startup time: %s\n", FormatISO8601DateTime(GetTime()));
@@ -24,6 +24,8 @@ struct BlockManagerOpts {
     bool fast_prune{false};
     const fs::path blocks_dir;
     Notifications& notifications;
+    // SYSCOIN read block files through cached memory mappings
+    bool mmap_block_files{false};
 };
 
 } // namespace kernel
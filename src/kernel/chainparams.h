@@ -59,6 +59,11 @@ struct AssumeutxoData {
     //! The hash of the base block for this snapshot. Used to refer to assumeutxo data
     //! prior to having a loaded blockindex.
     uint256 blockhash;
+
+    //! SYSCOIN The expected hash of the auxiliary state file (masternode lists, quorum commitments,
+    //! NEVM tx roots and minted transactions) written next to the snapshot. Null if the snapshot
+    //! is loaded without it.
+    uint256 hash_auxiliary;
 };
 
 /**
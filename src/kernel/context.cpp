@@ -12,6 +12,7 @@
 
 #include <string>
 #include <bls/bls.h>
+#include <nevm/sha3.h>
 
 namespace kernel {
 Context* g_context;
@@ -26,6 +27,8 @@ Context::Context()
     ECC_Start();
     // SYSCOIN
     BLSInit();
+    std::string keccak_algo = dev::KeccakAutoDetect();
+    LogPrintf("Using the '%s' Keccak implementation\n", keccak_algo);
 }
 
 Context::~Context()
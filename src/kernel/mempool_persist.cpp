@@ -7,8 +7,13 @@
 #include <clientversion.h>
 #include <consensus/amount.h>
 #include <logging.h>
+#include <primitives/block.h>
 #include <primitives/transaction.h>
+#include <random.h>
 #include <serialize.h>
+// SYSCOIN
+#include <services/nevmblobrelay.h>
+#include <services/nevmconsensus.h>
 #include <streams.h>
 #include <sync.h>
 #include <txmempool.h>
@@ -34,7 +39,108 @@ using fsbridge::FopenFn;
 
 namespace kernel {
 
-static const uint64_t MEMPOOL_DUMP_VERSION = 1;
+// SYSCOIN version 2 adds the journal session and the PoDA sidecar
+static const uint64_t MEMPOOL_DUMP_VERSION_NO_JOURNAL = 1;
+static const uint64_t MEMPOOL_DUMP_VERSION = 2;
+static const uint64_t MEMPOOL_JOURNAL_VERSION = 1;
+
+enum MempoolJournalRecord : uint8_t {
+    JOURNAL_ADD = 1,
+    JOURNAL_REMOVE = 2,
+    //! transactions of a connected block, removed without a sequence of their own
+    JOURNAL_BLOCK = 3,
+};
+
+namespace {
+struct MempoolDumpEntry {
+    CTransactionRef tx;
+    int64_t nTime;
+    int64_t nFeeDelta;
+};
+
+/** Dumped transactions in the order they are to be added back, with the journal applied on top */
+class MempoolDumpEntries
+{
+public:
+    void Add(MempoolDumpEntry&& entry)
+    {
+        if (!m_index.emplace(entry.tx->GetHash(), m_entries.size()).second) return;
+        m_entries.emplace_back(std::move(entry));
+    }
+    void Remove(const uint256& txid)
+    {
+        const auto it{m_index.find(txid)};
+        if (it == m_index.end()) return;
+        m_entries[it->second].tx = nullptr;
+        m_index.erase(it);
+    }
+    std::vector<MempoolDumpEntry>& Get() { return m_entries; }
+
+private:
+    std::vector<MempoolDumpEntry> m_entries;
+    std::map<uint256, size_t> m_index;
+};
+
+/** Apply the records of the journal of session that came after sequence, a torn last record ends the replay */
+int64_t ReplayMempoolJournal(const fs::path& journal_path, fsbridge::FopenFn mockable_fopen_function, uint64_t session, uint64_t sequence, MempoolDumpEntries& entries)
+{
+    CAutoFile file{mockable_fopen_function(journal_path, "rb"), CLIENT_VERSION};
+    if (file.IsNull()) return 0;
+    int64_t replayed{0};
+    try {
+        uint64_t version, journal_session;
+        file >> version >> journal_session;
+        if (version != MEMPOOL_JOURNAL_VERSION || journal_session != session) return 0;
+        while (true) {
+            uint8_t type;
+            file >> type;
+            if (type == JOURNAL_ADD) {
+                uint64_t nSequence;
+                CTransactionRef tx;
+                int64_t nTime;
+                file >> nSequence >> tx >> nTime;
+                if (nSequence >= sequence) entries.Add({std::move(tx), nTime, 0});
+            } else if (type == JOURNAL_REMOVE) {
+                uint64_t nSequence;
+                uint256 txid;
+                file >> nSequence >> txid;
+                if (nSequence >= sequence) entries.Remove(txid);
+            } else if (type == JOURNAL_BLOCK) {
+                std::vector<uint256> vTxids;
+                file >> vTxids;
+                for (const uint256& txid : vTxids) {
+                    entries.Remove(txid);
+                }
+            } else {
+                throw std::ios_base::failure("unknown journal record");
+            }
+            ++replayed;
+        }
+    } catch (const std::exception& e) {
+        // reading past the last record ends up here as well
+        LogPrint(BCLog::MEMPOOL, "Mempool journal replay stopped after %d records: %s\n", replayed, e.what());
+    }
+    return replayed;
+}
+
+/** Give a PoDA transaction loaded from disk its blob back, from the sidecar of the dump or else the blob database */
+CTransactionRef AttachDumpedNEVMData(const CTransactionRef& tx, const std::map<std::vector<uint8_t>, std::vector<uint8_t>>& mapSidecar)
+{
+    const auto vchVersionHash{MissingNEVMData(*tx)};
+    if (!vchVersionHash) return tx;
+    if (const auto it{mapSidecar.find(*vchVersionHash)}; it != mapSidecar.end()) {
+        return AttachNEVMData(tx, std::make_shared<const std::vector<uint8_t>>(it->second));
+    }
+    if (!pnevmdatadb || !pnevmdatablobdb) return tx;
+    // blobs already in the database passed their hash check, ATMP does not hash them again
+    MapPoDAPayloadMeta meta;
+    if (!pnevmdatadb->GetBlobMetaData(*vchVersionHash, meta)) return tx;
+    if (meta.vchNEVMData) return AttachNEVMData(tx, meta.vchNEVMData);
+    std::vector<uint8_t> vchData;
+    if (!pnevmdatablobdb->ReadBlob(*vchVersionHash, vchData)) return tx;
+    return AttachNEVMData(tx, std::make_shared<const std::vector<uint8_t>>(std::move(vchData)));
+}
+} // namespace
 
 bool LoadMempool(CTxMemPool& pool, const fs::path& load_path, Chainstate& active_chainstate, ImportMempoolOptions&& opts)
 {
@@ -54,12 +160,16 @@ bool LoadMempool(CTxMemPool& pool, const fs::path& load_path, Chainstate& active
     int64_t unbroadcast = 0;
     const auto now{NodeClock::now()};
 
+    int64_t journaled = 0;
+
     try {
         uint64_t version;
         file >> version;
-        if (version != MEMPOOL_DUMP_VERSION) {
+        if (version != MEMPOOL_DUMP_VERSION && version != MEMPOOL_DUMP_VERSION_NO_JOURNAL) {
             return false;
         }
+        // SYSCOIN read the whole dump first so the journal can be applied on top
+        MempoolDumpEntries entries;
         uint64_t num;
         file >> num;
         while (num) {
@@ -70,7 +180,25 @@ bool LoadMempool(CTxMemPool& pool, const fs::path& load_path, Chainstate& active
             file >> tx;
             file >> nTime;
             file >> nFeeDelta;
+            entries.Add({std::move(tx), nTime, nFeeDelta});
+        }
+        std::map<uint256, CAmount> mapDeltas;
+        file >> mapDeltas;
+
+        std::set<uint256> unbroadcast_txids;
+        file >> unbroadcast_txids;
+
+        std::map<std::vector<uint8_t>, std::vector<uint8_t>> mapSidecar;
+        if (version == MEMPOOL_DUMP_VERSION) {
+            uint64_t session, sequence;
+            file >> session >> sequence >> mapSidecar;
+            if (session != 0 && !opts.journal_path.empty()) {
+                journaled = ReplayMempoolJournal(opts.journal_path, opts.mockable_fopen_function, session, sequence, entries);
+            }
+        }
 
+        for (auto& [tx, nTime, nFeeDelta] : entries.Get()) {
+            if (!tx) continue;
             if (opts.use_current_time) {
                 nTime = TicksSinceEpoch<std::chrono::seconds>(now);
             }
@@ -80,6 +208,7 @@ bool LoadMempool(CTxMemPool& pool, const fs::path& load_path, Chainstate& active
                 pool.PrioritiseTransaction(tx->GetHash(), amountdelta);
             }
             if (nTime > TicksSinceEpoch<std::chrono::seconds>(now - pool.m_expiry)) {
+                tx = AttachDumpedNEVMData(tx, mapSidecar);
                 LOCK(cs_main);
                 const auto& accepted = AcceptToMemoryPool(active_chainstate, tx, nTime, /*bypass_limits=*/false, /*test_accept=*/false);
                 if (accepted.m_result_type == MempoolAcceptResult::ResultType::VALID) {
@@ -101,8 +230,6 @@ bool LoadMempool(CTxMemPool& pool, const fs::path& load_path, Chainstate& active
             if (active_chainstate.m_chainman.m_interrupt)
                 return false;
         }
-        std::map<uint256, CAmount> mapDeltas;
-        file >> mapDeltas;
 
         if (opts.apply_fee_delta_priority) {
             for (const auto& i : mapDeltas) {
@@ -110,8 +237,6 @@ bool LoadMempool(CTxMemPool& pool, const fs::path& load_path, Chainstate& active
             }
         }
 
-        std::set<uint256> unbroadcast_txids;
-        file >> unbroadcast_txids;
         if (opts.apply_unbroadcast_set) {
             unbroadcast = unbroadcast_txids.size();
             for (const auto& txid : unbroadcast_txids) {
@@ -125,17 +250,20 @@ bool LoadMempool(CTxMemPool& pool, const fs::path& load_path, Chainstate& active
         return false;
     }
 
-    LogPrintf("Imported mempool transactions from disk: %i succeeded, %i failed, %i expired, %i already there, %i waiting for initial broadcast\n", count, failed, expired, already_there, unbroadcast);
+    LogPrintf("Imported mempool transactions from disk: %i succeeded, %i failed, %i expired, %i already there, %i waiting for initial broadcast, %i journal records replayed\n", count, failed, expired, already_there, unbroadcast, journaled);
     return true;
 }
 
-bool DumpMempool(const CTxMemPool& pool, const fs::path& dump_path, FopenFn mockable_fopen_function, bool skip_file_commit)
+bool DumpMempool(const CTxMemPool& pool, const fs::path& dump_path, FopenFn mockable_fopen_function, bool skip_file_commit, uint64_t journal_session)
 {
     auto start = SteadyClock::now();
 
     std::map<uint256, CAmount> mapDeltas;
     std::vector<TxMempoolInfo> vinfo;
     std::set<uint256> unbroadcast_txids;
+    // SYSCOIN
+    uint64_t sequence;
+    std::map<std::vector<uint8_t>, std::vector<uint8_t>> mapSidecar;
 
     static Mutex dump_mutex;
     LOCK(dump_mutex);
@@ -147,6 +275,16 @@ bool DumpMempool(const CTxMemPool& pool, const fs::path& dump_path, FopenFn mock
         }
         vinfo = pool.infoAll();
         unbroadcast_txids = pool.GetUnbroadcastTxs();
+        sequence = pool.GetSequence();
+    }
+    // SYSCOIN transactions are written without their PoDA blob, blobs the database doesn't have (yet) go into the sidecar
+    for (const auto& i : vinfo) {
+        if (!i.tx->IsNEVMData()) continue;
+        const int nOut = GetSyscoinDataOutput(*i.tx);
+        if (nOut == -1 || !i.tx->vout[nOut].HasNEVMData()) continue;
+        const CNEVMData nevmData(i.tx->vout[nOut].scriptPubKey);
+        if (nevmData.IsNull() || (pnevmdatadb && pnevmdatadb->BlobExists(nevmData.vchVersionHash))) continue;
+        mapSidecar.try_emplace(nevmData.vchVersionHash, i.tx->vout[nOut].GetNEVMData());
     }
 
     auto mid = SteadyClock::now();
@@ -175,6 +313,11 @@ bool DumpMempool(const CTxMemPool& pool, const fs::path& dump_path, FopenFn mock
         LogPrintf("Writing %d unbroadcast transactions to disk.\n", unbroadcast_txids.size());
         file << unbroadcast_txids;
 
+        // SYSCOIN
+        file << journal_session;
+        file << sequence;
+        file << mapSidecar;
+
         if (!skip_file_commit && !FileCommit(file.Get()))
             throw std::runtime_error("FileCommit failed");
         file.fclose();
@@ -193,4 +336,108 @@ bool DumpMempool(const CTxMemPool& pool, const fs::path& dump_path, FopenFn mock
     return true;
 }
 
+// SYSCOIN
+MempoolJournal::MempoolJournal(const CTxMemPool& pool, fs::path dump_path, fs::path journal_path)
+    : m_pool{pool}, m_dump_path{std::move(dump_path)}, m_journal_path{std::move(journal_path)}
+{
+}
+
+MempoolJournal::~MempoolJournal() = default;
+
+bool MempoolJournal::Start()
+{
+    LOCK(m_mutex);
+    m_session = FastRandomContext().rand64() | 1;
+    return CompactLocked();
+}
+
+bool MempoolJournal::Compact()
+{
+    LOCK(m_mutex);
+    if (m_session == 0) return DumpMempool(m_pool, m_dump_path);
+    return CompactLocked();
+}
+
+void MempoolJournal::MaybeCompact()
+{
+    LOCK(m_mutex);
+    if (m_session != 0 && m_size > MEMPOOL_JOURNAL_COMPACT_SIZE) CompactLocked();
+}
+
+bool MempoolJournal::IsStarted() const
+{
+    LOCK(m_mutex);
+    return m_session != 0;
+}
+
+bool MempoolJournal::CompactLocked()
+{
+    AssertLockHeld(m_mutex);
+    // records appended until the journal is emptied are older than the dump and skipped by the replay
+    if (!DumpMempool(m_pool, m_dump_path, fsbridge::fopen, /*skip_file_commit=*/false, m_session)) return false;
+    m_file.reset();
+    m_size = 0;
+    m_file = std::make_unique<CAutoFile>(fsbridge::fopen(m_journal_path, "wb"), CLIENT_VERSION);
+    if (m_file->IsNull()) {
+        LogPrintf("Failed to open mempool journal %s, writing mempool changes only at shutdown\n", fs::PathToString(m_journal_path));
+        m_file.reset();
+        return false;
+    }
+    try {
+        *m_file << MEMPOOL_JOURNAL_VERSION << m_session;
+        if (std::fflush(m_file->Get()) != 0) throw std::runtime_error("fflush failed");
+    } catch (const std::exception& e) {
+        LogPrintf("Failed to write mempool journal: %s\n", e.what());
+        m_file.reset();
+        return false;
+    }
+    LogPrint(BCLog::MEMPOOL, "Compacted mempool journal into %s\n", fs::PathToString(m_dump_path));
+    return true;
+}
+
+void MempoolJournal::Append(const CDataStream& record)
+{
+    AssertLockHeld(m_mutex);
+    if (!m_file) return;
+    try {
+        m_file->write(MakeByteSpan(record));
+        if (std::fflush(m_file->Get()) != 0) throw std::runtime_error("fflush failed");
+        m_size += record.size();
+    } catch (const std::exception& e) {
+        // the dump written at shutdown still has the whole mempool
+        LogPrintf("Failed to append to mempool journal: %s\n", e.what());
+        m_file.reset();
+    }
+}
+
+void MempoolJournal::TransactionAddedToMempool(const CTransactionRef& tx, uint64_t mempool_sequence)
+{
+    LOCK(m_mutex);
+    CDataStream record(SER_DISK, CLIENT_VERSION);
+    record << uint8_t{JOURNAL_ADD} << mempool_sequence << tx << int64_t{TicksSinceEpoch<std::chrono::seconds>(NodeClock::now())};
+    Append(record);
+}
+
+void MempoolJournal::TransactionRemovedFromMempool(const CTransactionRef& tx, MemPoolRemovalReason reason, uint64_t mempool_sequence)
+{
+    LOCK(m_mutex);
+    CDataStream record(SER_DISK, CLIENT_VERSION);
+    record << uint8_t{JOURNAL_REMOVE} << mempool_sequence << tx->GetHash();
+    Append(record);
+}
+
+void MempoolJournal::BlockConnected(ChainstateRole role, const std::shared_ptr<const CBlock>& block, const CBlockIndex* pindex)
+{
+    if (role == ChainstateRole::BACKGROUND) return;
+    std::vector<uint256> vTxids;
+    vTxids.reserve(block->vtx.size());
+    for (const auto& tx : block->vtx) {
+        vTxids.emplace_back(tx->GetHash());
+    }
+    LOCK(m_mutex);
+    CDataStream record(SER_DISK, CLIENT_VERSION);
+    record << uint8_t{JOURNAL_BLOCK} << vTxids;
+    Append(record);
+}
+
 } // namespace kernel
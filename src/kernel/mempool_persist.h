@@ -5,29 +5,82 @@
 #ifndef SYSCOIN_KERNEL_MEMPOOL_PERSIST_H
 #define SYSCOIN_KERNEL_MEMPOOL_PERSIST_H
 
+#include <streams.h>
+#include <sync.h>
 #include <util/fs.h>
+// SYSCOIN
+#include <validationinterface.h>
+
+#include <cstdint>
+#include <memory>
 
 class Chainstate;
 class CTxMemPool;
 
 namespace kernel {
 
-/** Dump the mempool to a file. */
+/** Dump the mempool to a file. A non zero journal_session lets the journal of that session be replayed on top of the dump. */
 bool DumpMempool(const CTxMemPool& pool, const fs::path& dump_path,
                  fsbridge::FopenFn mockable_fopen_function = fsbridge::fopen,
-                 bool skip_file_commit = false);
+                 bool skip_file_commit = false,
+                 uint64_t journal_session = 0);
 
 struct ImportMempoolOptions {
     fsbridge::FopenFn mockable_fopen_function{fsbridge::fopen};
     bool use_current_time{false};
     bool apply_fee_delta_priority{true};
     bool apply_unbroadcast_set{true};
+    // SYSCOIN journal replayed on top of the dump, empty when importing a foreign dump
+    fs::path journal_path{};
 };
 /** Import the file and attempt to add its contents to the mempool. */
 bool LoadMempool(CTxMemPool& pool, const fs::path& load_path,
                  Chainstate& active_chainstate,
                  ImportMempoolOptions&& opts);
 
+// SYSCOIN
+/** The journal is compacted into a fresh dump once it grew past this size */
+static constexpr uint64_t MEMPOOL_JOURNAL_COMPACT_SIZE{32 * 1024 * 1024};
+
+/**
+ * Appends the changes to the mempool to a journal next to mempool.dat, so a node that did not shut
+ * down cleanly gets back the mempool it had and not the one of the last dump. Records carry the
+ * mempool sequence, LoadMempool() only replays those newer than the dump of the same session.
+ * Transactions are written without their PoDA blob, it is read back from the blob database.
+ * The callbacks and Compact() both run on the scheduler thread.
+ */
+class MempoolJournal final : public CValidationInterface
+{
+public:
+    MempoolJournal(const CTxMemPool& pool, fs::path dump_path, fs::path journal_path);
+    ~MempoolJournal();
+
+    /** Begin a new session with a fresh dump, called once the previous dump was loaded */
+    bool Start() EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+    /** Write a fresh dump and empty the journal */
+    bool Compact() EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+    /** Compact() if the journal grew past MEMPOOL_JOURNAL_COMPACT_SIZE */
+    void MaybeCompact() EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+    bool IsStarted() const EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+
+protected:
+    void TransactionAddedToMempool(const CTransactionRef& tx, uint64_t mempool_sequence) override EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+    void TransactionRemovedFromMempool(const CTransactionRef& tx, MemPoolRemovalReason reason, uint64_t mempool_sequence) override EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+    void BlockConnected(ChainstateRole role, const std::shared_ptr<const CBlock>& block, const CBlockIndex* pindex) override EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+
+private:
+    bool CompactLocked() EXCLUSIVE_LOCKS_REQUIRED(m_mutex);
+    void Append(const CDataStream& record) EXCLUSIVE_LOCKS_REQUIRED(m_mutex);
+
+    const CTxMemPool& m_pool;
+    const fs::path m_dump_path;
+    const fs::path m_journal_path;
+    mutable Mutex m_mutex;
+    uint64_t m_session GUARDED_BY(m_mutex){0};
+    std::unique_ptr<CAutoFile> m_file GUARDED_BY(m_mutex);
+    uint64_t m_size GUARDED_BY(m_mutex){0};
+};
+
 } // namespace kernel
 
 
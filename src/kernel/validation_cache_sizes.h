@@ -12,8 +12,10 @@
 
 namespace kernel {
 struct ValidationCacheSizes {
-    size_t signature_cache_bytes{DEFAULT_MAX_SIG_CACHE_BYTES / 2};
-    size_t script_execution_cache_bytes{DEFAULT_MAX_SIG_CACHE_BYTES / 2};
+    // SYSCOIN a quarter of the budget goes to the BLS signature cache, the rest is split as before
+    size_t signature_cache_bytes{DEFAULT_MAX_SIG_CACHE_BYTES / 8 * 3};
+    size_t script_execution_cache_bytes{DEFAULT_MAX_SIG_CACHE_BYTES / 8 * 3};
+    size_t bls_signature_cache_bytes{DEFAULT_MAX_SIG_CACHE_BYTES / 4};
 };
 }
 
@@ -40,13 +40,22 @@ static uint256 MakeQuorumKey(const CQuorum& q)
     return hw.GetHash();
 }
 
+// SYSCOIN key of the public key shares of a quorum in the vvec database
+static uint256 MakeQuorumPubKeySharesKey(const CQuorum& q)
+{
+    CHashWriter hw(SER_NETWORK, 0);
+    hw << std::string("pubkeyshares") << MakeQuorumKey(q);
+    return hw.GetHash();
+}
+
 CQuorum::CQuorum(CBLSWorker& _blsWorker) : blsCache(_blsWorker)
 {
 }
 
-void CQuorum::Init(CFinalCommitmentPtr _qc, const CBlockIndex* _pQuorumBaseBlockIndex, const uint256& _minedBlockHash, Span<CDeterministicMNCPtr> _members)
+void CQuorum::Init(CFinalCommitmentPtr _qc, const CBlockIndex* _pQuorumBaseBlockIndex, const uint256& _minedBlockHash, Span<const CDeterministicMNCPtr> _members)
 {
     qc = std::move(_qc);
+    preparedPublicKey = CBLSPreparedPublicKey(qc->quorumPublicKey);
     m_quorum_base_block_index = _pQuorumBaseBlockIndex;
     members = std::vector(_members.begin(), _members.end());
     minedBlockHash = _minedBlockHash;
@@ -88,6 +97,21 @@ CBLSPublicKey CQuorum::GetPubKeyShare(size_t memberIdx) const
     return blsCache.BuildPubKeyShare(m->proTxHash, quorumVvec, CBLSId(m->proTxHash));
 }
 
+BLSLagrangeCoefficientsPtr CQuorum::GetLagrangeCoefficients(Span<const uint16_t> memberIndexes) const
+{
+    CHashWriter hw(SER_GETHASH, 0);
+    std::vector<CBLSId> ids;
+    ids.reserve(memberIndexes.size());
+    for (const uint16_t idx : memberIndexes) {
+        if (idx >= members.size()) {
+            return nullptr;
+        }
+        hw << idx;
+        ids.emplace_back(members[idx]->proTxHash);
+    }
+    return blsCache.BuildLagrangeCoefficients(hw.GetHash(), ids);
+}
+
 bool CQuorum::HasVerificationVector() const {
     LOCK(cs_vvec_shShare);
     return HasVerificationVectorInternal();
@@ -141,12 +165,37 @@ bool CQuorum::ReadContributions(std::unique_ptr<CEvoDB<uint256, std::vector<CBLS
     return true;
 }
 
+void CQuorum::WritePubKeyShares(CEvoDB<uint256, std::vector<CBLSPublicKey>, StaticSaltedHasher>& evoDb_vvec, const std::vector<CBLSPublicKey>& pubKeyShares) const
+{
+    assert(pubKeyShares.size() == members.size());
+    evoDb_vvec.WriteCache(MakeQuorumPubKeySharesKey(*this), pubKeyShares);
+}
+
+bool CQuorum::ReadPubKeyShares(CEvoDB<uint256, std::vector<CBLSPublicKey>, StaticSaltedHasher>& evoDb_vvec) const
+{
+    std::vector<CBLSPublicKey> pubKeyShares;
+    if (!evoDb_vvec.ReadCache(MakeQuorumPubKeySharesKey(*this), pubKeyShares) || pubKeyShares.size() != members.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < members.size(); i++) {
+        if (pubKeyShares[i].IsValid() != bool(qc->validMembers[i])) {
+            return false;
+        }
+    }
+    for (size_t i = 0; i < members.size(); i++) {
+        if (qc->validMembers[i]) {
+            blsCache.SetPubKeyShare(members[i]->proTxHash, pubKeyShares[i]);
+        }
+    }
+    return true;
+}
+
 CQuorumManager::CQuorumManager(const DBParams& db_params_vvecs, const DBParams& db_params_sk, CBLSWorker& _blsWorker, CDKGSessionManager& _dkgManager, ChainstateManager& _chainman) :
     blsWorker(_blsWorker),
     dkgManager(_dkgManager),
     chainman(_chainman),
-    evoDb_vvec(std::make_unique<CEvoDB<uint256, std::vector<CBLSPublicKey>, StaticSaltedHasher>>(db_params_vvecs, QUORUM_CACHE_SIZE)),
-    evoDb_sk(std::make_unique<CEvoDB<uint256, CBLSSecretKey, StaticSaltedHasher>>(db_params_sk, QUORUM_CACHE_SIZE))
+    evoDb_vvec(std::make_unique<CEvoDB<uint256, std::vector<CBLSPublicKey>, StaticSaltedHasher>>(db_params_vvecs, /*maxCacheSizeIn=*/0, QUORUM_VVEC_CACHE_BYTES)),
+    evoDb_sk(std::make_unique<CEvoDB<uint256, CBLSSecretKey, StaticSaltedHasher>>(db_params_sk, /*maxCacheSizeIn=*/0, QUORUM_SK_CACHE_BYTES))
 {
     quorumThreadInterrupt.reset();
     vecQuorumsCache.reserve(QUORUM_CACHE_SIZE);
@@ -156,16 +205,13 @@ CQuorumManager::~CQuorumManager() { Stop(); }
 
 void CQuorumManager::Start()
 {
-    int workerCount = std::thread::hardware_concurrency() / 2;
-    workerCount = std::max(std::min(1, workerCount), 4);
-    workerPool.resize(workerCount);
+    workerPool.Start();
 }
 
 void CQuorumManager::Stop()
 {
     quorumThreadInterrupt();
-    workerPool.clear_queue();
-    workerPool.stop(true);
+    workerPool.Stop();
 }
 
 void CQuorumManager::UpdatedBlockTip(const CBlockIndex* pindexNew, bool fInitialDownload)
@@ -173,6 +219,9 @@ void CQuorumManager::UpdatedBlockTip(const CBlockIndex* pindexNew, bool fInitial
     if (!masternodeSync.IsBlockchainSynced()) {
         return;
     }
+    // SYSCOIN connection sets of quorums older than the ones connections are kept for are not asked for anymore
+    const Consensus::LLMQParams& llmqParams = Params().GetConsensus().llmqTypeChainLocks;
+    CLLMQUtils::RemoveQuorumConnectionsBelow(pindexNew->nHeight - (llmqParams.keepOldConnections + 1) * llmqParams.dkgInterval);
     EnsureQuorumConnections(pindexNew);
 }
 
@@ -223,7 +272,7 @@ CQuorumPtr CQuorumManager::BuildQuorumFromCommitment(const CBlockIndex* pQuorumB
     auto quorum = std::make_shared<CQuorum>(blsWorker);
     auto members = CLLMQUtils::GetAllQuorumMembers(pQuorumBaseBlockIndex);
 
-    quorum->Init(std::move(qc), pQuorumBaseBlockIndex, minedBlockHash, members);
+    quorum->Init(std::move(qc), pQuorumBaseBlockIndex, minedBlockHash, *members);
 
     bool hasValidVvec = false;
     if (WITH_LOCK(cs_db, return quorum->ReadContributions(evoDb_vvec, evoDb_sk))) {
@@ -310,9 +359,24 @@ std::vector<CQuorumCPtr> CQuorumManager::ScanQuorums(const CBlockIndex* pindexSt
     if (offset != 0) {
         pIndex = pIndex->GetAncestor(pIndex->nHeight - offset);
     }
+    // SYSCOIN read before scanning, a commitment mined meanwhile leaves the entry stale rather than wrong
+    const CBlockIndex* pindexScanStart = pIndex;
+    const uint64_t nGeneration = quorumBlockProcessor->GetMinedCommitmentsGeneration();
 
     // Iterate through blocks using dkgInterval to gather the required number of quorums
     while (vecResultQuorums.size() < nCountRequested && pIndex != nullptr) {
+        // SYSCOIN a scan cached from this block on is taken over instead of walking the chain below it again
+        if (const auto cached = GetCachedScan(pIndex, nGeneration)) {
+            const size_t nTake = std::min(nCountRequested - vecResultQuorums.size(), cached->vecQuorums.size());
+            vecResultQuorums.insert(vecResultQuorums.end(), cached->vecQuorums.begin(), cached->vecQuorums.begin() + nTake);
+            if (nTake == cached->vecQuorums.size()) {
+                pIndex = cached->pindexNext;
+            } else {
+                const CBlockIndex* pindexLast = cached->vecQuorums[nTake - 1]->m_quorum_base_block_index;
+                pIndex = pindexLast->GetAncestor(pindexLast->nHeight - nDKGInterval);
+            }
+            continue;
+        }
         CQuorumCPtr quorum = GetQuorum(pIndex);
         if (quorum != nullptr) {
             vecResultQuorums.emplace_back(quorum);
@@ -320,11 +384,27 @@ std::vector<CQuorumCPtr> CQuorumManager::ScanQuorums(const CBlockIndex* pindexSt
         // Move to the previous block at the interval of nDKGInterval
         pIndex = pIndex->GetAncestor(pIndex->nHeight - nDKGInterval);
     }
-    
+
+    {
+        LOCK(cs_scan);
+        std::shared_ptr<const ScanQuorumsResult> existing;
+        if (!scanQuorumsCache.get(pindexScanStart->GetBlockHash(), existing) || existing->nGeneration != nGeneration ||
+            existing->vecQuorums.size() < vecResultQuorums.size()) {
+            scanQuorumsCache.insert(pindexScanStart->GetBlockHash(), std::make_shared<const ScanQuorumsResult>(ScanQuorumsResult{nGeneration, vecResultQuorums, pIndex}));
+        }
+    }
     return vecResultQuorums;
 }
 
-
+std::shared_ptr<const CQuorumManager::ScanQuorumsResult> CQuorumManager::GetCachedScan(const CBlockIndex* pindex, uint64_t nGeneration) const
+{
+    LOCK(cs_scan);
+    std::shared_ptr<const ScanQuorumsResult> ret;
+    if (!scanQuorumsCache.get(pindex->GetBlockHash(), ret) || ret->nGeneration != nGeneration) {
+        return nullptr;
+    }
+    return ret;
+}
 
 CQuorumCPtr CQuorumManager::GetQuorum(const uint256& quorumHash)
 {
@@ -375,14 +455,21 @@ void CQuorumManager::StartCachePopulatorThread(const CQuorumCPtr pQuorum) const
 
     // when then later some other thread tries to get keys, it will be much faster
     workerPool.push([pQuorum, t, this](int threadId) {
+        // SYSCOIN shares recovered before a restart are loaded instead of recovered again
+        if (WITH_LOCK(cs_db, return pQuorum->ReadPubKeyShares(*evoDb_vvec))) {
+            LogPrint(BCLog::LLMQ, "CQuorumManager::StartCachePopulatorThread -- loaded from disk. time=%d\n", t.count());
+            return;
+        }
+        std::vector<CBLSPublicKey> pubKeyShares(pQuorum->members.size());
         for (size_t i = 0; i < pQuorum->members.size(); i++) {
             if (quorumThreadInterrupt) {
-                break;
+                return;
             }
             if (pQuorum->qc->validMembers[i]) {
-                pQuorum->GetPubKeyShare(i);
+                pubKeyShares[i] = pQuorum->GetPubKeyShare(i);
             }
         }
+        WITH_LOCK(cs_db, pQuorum->WritePubKeyShares(*evoDb_vvec, pubKeyShares));
         LogPrint(BCLog::LLMQ, "CQuorumManager::StartCachePopulatorThread -- done. time=%d\n", t.count());
     });
 }
@@ -468,7 +555,7 @@ VerifyRecSigStatus VerifyRecoveredSig(ChainstateManager& chainman,
     }
 
     uint256 signHash = BuildSignHash(quorum->qc->quorumHash, id, msgHash);
-    const bool ret = sig.VerifyInsecure(quorum->qc->quorumPublicKey, signHash);
+    const bool ret = sig.VerifyInsecure(quorum->preparedPublicKey, signHash);
     return ret ? VerifyRecSigStatus::Valid : VerifyRecSigStatus::Invalid;
 }
 } // namespace llmq
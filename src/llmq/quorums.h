@@ -5,6 +5,7 @@
 #ifndef SYSCOIN_LLMQ_QUORUMS_H
 #define SYSCOIN_LLMQ_QUORUMS_H
 
+#include <util/executor.h>
 #include <util/threadinterrupt.h>
 
 #include <validationinterface.h>
@@ -14,6 +15,7 @@
 #include <bls/bls.h>
 #include <bls/bls_worker.h>
 #include <evo/evodb.h>
+#include <unordered_lru_cache.h>
 class CNode;
 class CConnman;
 class CBlockIndex;
@@ -60,6 +62,8 @@ public:
     const CBlockIndex* m_quorum_base_block_index{nullptr};
     uint256 minedBlockHash;
     std::vector<CDeterministicMNCPtr> members;
+    // SYSCOIN qc->quorumPublicKey checked once, every recovered sig of the quorum is verified against it
+    CBLSPreparedPublicKey preparedPublicKey;
 
 private:
     // Recovery of public key shares is very slow, so we start a background thread that pre-populates a cache so that
@@ -74,7 +78,7 @@ private:
 public:
     CQuorum(CBLSWorker& _blsWorker);
     ~CQuorum() = default;
-    void Init(CFinalCommitmentPtr _qc, const CBlockIndex* _pQuorumBaseBlockIndex, const uint256& _minedBlockHash, Span<CDeterministicMNCPtr> _members);
+    void Init(CFinalCommitmentPtr _qc, const CBlockIndex* _pQuorumBaseBlockIndex, const uint256& _minedBlockHash, Span<const CDeterministicMNCPtr> _members);
 
     void SetVerificationVector(BLSVerificationVectorPtr vvec_in) EXCLUSIVE_LOCKS_REQUIRED(!cs_vvec_shShare) {
         LOCK(cs_vvec_shShare);
@@ -87,12 +91,18 @@ public:
     int GetMemberIndex(const uint256& proTxHash) const;
 
     CBLSPublicKey GetPubKeyShare(size_t memberIdx) const EXCLUSIVE_LOCKS_REQUIRED(!cs_vvec_shShare);
+    // SYSCOIN Lagrange coefficients for recovering a signature from the shares of these members, cached per member set
+    BLSLagrangeCoefficientsPtr GetLagrangeCoefficients(Span<const uint16_t> memberIndexes) const;
     CBLSSecretKey GetSkShare() const EXCLUSIVE_LOCKS_REQUIRED(!cs_vvec_shShare);
 
 private:
     bool HasVerificationVectorInternal() const EXCLUSIVE_LOCKS_REQUIRED(cs_vvec_shShare);
     void WriteContributions(std::unique_ptr<CEvoDB<uint256, std::vector<CBLSPublicKey>, StaticSaltedHasher>>& evoDb_vvec, std::unique_ptr<CEvoDB<uint256, CBLSSecretKey, StaticSaltedHasher>>& evoDb_sk) EXCLUSIVE_LOCKS_REQUIRED(!cs_vvec_shShare);
     bool ReadContributions(std::unique_ptr<CEvoDB<uint256, std::vector<CBLSPublicKey>, StaticSaltedHasher>>& evoDb_vvec, std::unique_ptr<CEvoDB<uint256, CBLSSecretKey, StaticSaltedHasher>>& evoDb_sk) EXCLUSIVE_LOCKS_REQUIRED(!cs_vvec_shShare);
+    // SYSCOIN the public key shares of all members are stored next to the vvec so they need not be recovered again
+    // after a restart. Invalid members have an invalid key in their slot
+    void WritePubKeyShares(CEvoDB<uint256, std::vector<CBLSPublicKey>, StaticSaltedHasher>& evoDb_vvec, const std::vector<CBLSPublicKey>& pubKeyShares) const;
+    bool ReadPubKeyShares(CEvoDB<uint256, std::vector<CBLSPublicKey>, StaticSaltedHasher>& evoDb_vvec) const;
 };
 
 /**
@@ -110,9 +120,26 @@ private:
     ChainstateManager& chainman;
     mutable Mutex cs_quorums;
     mutable std::vector<CQuorumCPtr> vecQuorumsCache GUARDED_BY(cs_quorums);
-    mutable ctpl::thread_pool workerPool;
+    // SYSCOIN on the shared executor
+    mutable ExecutorTaskGroup workerPool{Executor::Lane::BACKGROUND};
     mutable CThreadInterrupt quorumThreadInterrupt;
     static constexpr int QUORUM_CACHE_SIZE = 10;
+    // memory budgets of the contribution caches, verification vectors are a few KiB each and secret key shares tiny
+    static constexpr size_t QUORUM_VVEC_CACHE_BYTES = 8 << 20;
+    static constexpr size_t QUORUM_SK_CACHE_BYTES = 1 << 20;
+    // SYSCOIN ScanQuorums results by the dkg block a scan starts at. Which quorums a scan finds only depends on the
+    // mined commitments, so an entry is good while the commitment generation it was built at is current. Scans from
+    // a newer dkg block pick up the entry of the one before it instead of walking the chain again
+    struct ScanQuorumsResult {
+        uint64_t nGeneration;
+        std::vector<CQuorumCPtr> vecQuorums;
+        //! where the scan goes on when more quorums are asked for, null once the start of the chain was reached
+        const CBlockIndex* pindexNext;
+    };
+    static constexpr size_t SCAN_QUORUMS_CACHE_SIZE = 32;
+    mutable Mutex cs_scan;
+    mutable unordered_lru_cache<uint256, std::shared_ptr<const ScanQuorumsResult>, StaticSaltedHasher, SCAN_QUORUMS_CACHE_SIZE> scanQuorumsCache GUARDED_BY(cs_scan);
+    std::shared_ptr<const ScanQuorumsResult> GetCachedScan(const CBlockIndex* pindex, uint64_t nGeneration) const EXCLUSIVE_LOCKS_REQUIRED(!cs_scan);
 
 public:
     std::unique_ptr<CEvoDB<uint256, std::vector<CBLSPublicKey>, StaticSaltedHasher>> evoDb_vvec;
@@ -123,23 +150,26 @@ public:
     void Start();
     void Stop();
 
-    void UpdatedBlockTip(const CBlockIndex *pindexNew, bool fInitialDownload) EXCLUSIVE_LOCKS_REQUIRED(!cs_quorums, !cs_db);
+    void UpdatedBlockTip(const CBlockIndex *pindexNew, bool fInitialDownload) EXCLUSIVE_LOCKS_REQUIRED(!cs_quorums, !cs_db, !cs_scan);
 
 
     static bool HasQuorum(const uint256& quorumHash);
 
     // all these methods will lock cs_main for a short period of time
     CQuorumCPtr GetQuorum(const uint256& quorumHash) EXCLUSIVE_LOCKS_REQUIRED(!cs_quorums, !cs_db);
-    std::vector<CQuorumCPtr> ScanQuorums(size_t nCountRequested) EXCLUSIVE_LOCKS_REQUIRED(!cs_quorums, !cs_db);
+    std::vector<CQuorumCPtr> ScanQuorums(size_t nCountRequested) EXCLUSIVE_LOCKS_REQUIRED(!cs_quorums, !cs_db, !cs_scan);
 
     // this one is cs_main-free
-    std::vector<CQuorumCPtr> ScanQuorums(const CBlockIndex* pindexStart, size_t nCountRequested) EXCLUSIVE_LOCKS_REQUIRED(!cs_quorums, !cs_db);
+    std::vector<CQuorumCPtr> ScanQuorums(const CBlockIndex* pindexStart, size_t nCountRequested) EXCLUSIVE_LOCKS_REQUIRED(!cs_quorums, !cs_db, !cs_scan);
     bool FlushCacheToDisk(bool bForceFlush);
+    // SYSCOIN estimated memory of the verification vector and secret key share write caches
+    size_t GetVvecCacheUsage() const { return evoDb_vvec->GetCacheUsage(); }
+    size_t GetSkCacheUsage() const { return evoDb_sk->GetCacheUsage(); }
 private:
     bool DoMaintenance(bool bForceFlush);
     std::vector<CQuorumCPtr>::iterator FindQuorumByHash(const uint256& blockHash) EXCLUSIVE_LOCKS_REQUIRED(cs_quorums);
     // all private methods here are cs_main-free
-    void EnsureQuorumConnections(const CBlockIndex *pindexNew) EXCLUSIVE_LOCKS_REQUIRED(!cs_quorums, !cs_db);
+    void EnsureQuorumConnections(const CBlockIndex *pindexNew) EXCLUSIVE_LOCKS_REQUIRED(!cs_quorums, !cs_db, !cs_scan);
 
     CQuorumPtr BuildQuorumFromCommitment(const CBlockIndex* pQuorumBaseBlockIndex) EXCLUSIVE_LOCKS_REQUIRED(!cs_quorums, !cs_db);
     bool BuildQuorumContributions(const CFinalCommitmentPtr& fqc, const std::shared_ptr<CQuorum>& quorum) const EXCLUSIVE_LOCKS_REQUIRED(!cs_db, !cs_quorums);
@@ -221,7 +221,7 @@ bool CQuorumBlockProcessor::ProcessCommitment(int nHeight, const uint256& blockH
         return true;
     }
 
-    if (HasMinedCommitment(quorumHash)) {
+    if (HasMinedCommitmentBefore(quorumHash, nHeight)) {
         // should not happen as it's already handled in ProcessBlock
         return state.Invalid(BlockValidationResult::BLOCK_CONSENSUS, "bad-qc-dup");
     }
@@ -245,11 +245,15 @@ bool CQuorumBlockProcessor::ProcessCommitment(int nHeight, const uint256& blockH
 
     // Store commitment in DB
     m_commitment_evoDb.WriteCache(quorumHash, std::make_pair(qc, blockHash));
+    // SYSCOIN
+    MinedCommitmentsChanged();
 
     {
         LOCK(minableCommitmentsCs);
         minableCommitmentsByQuorum.erase(quorumHash);
         minableCommitments.erase(::SerializeHash(qc));
+        // SYSCOIN
+        InvalidateMinableCommitmentCache();
     }
 
     LogPrint(BCLog::LLMQ, "CQuorumBlockProcessor::%s -- processed commitment from block. quorumHash=%s, signers=%s, validMembers=%d, quorumPublicKey=%s\n", __func__,
@@ -278,6 +282,9 @@ bool CQuorumBlockProcessor::UndoBlock(const CBlock& block, const CBlockIndex* pi
     }
 
     m_commitment_evoDb.EraseCache(qcTx.commitment.quorumHash);
+    MinedCommitmentsChanged();
+    // SYSCOIN the quorum needs a commitment again
+    WITH_LOCK(minableCommitmentsCs, InvalidateMinableCommitmentCache());
 
     // if a reorg happened, we should allow to mine this commitment later
     AddMineableCommitment(qcTx.commitment);
@@ -327,7 +334,7 @@ bool CQuorumBlockProcessor::IsCommitmentRequired(int nHeight)
     bool isMiningPhase = !quorumHash.IsNull() && IsMiningPhase(nHeight);
 
     // did we already mine a non-null commitment for this session?
-    bool hasMinedCommitment = !quorumHash.IsNull() && HasMinedCommitment(quorumHash);
+    bool hasMinedCommitment = !quorumHash.IsNull() && HasMinedCommitmentBefore(quorumHash, nHeight);
     return isMiningPhase && !hasMinedCommitment;
 }
 
@@ -349,6 +356,17 @@ bool CQuorumBlockProcessor::HasMinedCommitment(const uint256& quorumHash)
     return m_commitment_evoDb.ExistsCache(quorumHash);
 }
 
+bool CQuorumBlockProcessor::HasMinedCommitmentBefore(const uint256& quorumHash, int nHeight)
+{
+    AssertLockHeld(cs_main);
+    uint256 minedBlockHash;
+    if (!GetMinedCommitment(quorumHash, minedBlockHash)) {
+        return false;
+    }
+    const CBlockIndex* pindexMined = chainman.m_blockman.LookupBlockIndex(minedBlockHash);
+    return !pindexMined || pindexMined->nHeight < nHeight;
+}
+
 CFinalCommitmentPtr CQuorumBlockProcessor::GetMinedCommitment(const uint256& quorumHash, uint256& retMinedBlockHash)
 {
     std::pair<CFinalCommitment, uint256> p;
@@ -376,6 +394,8 @@ std::optional<CInv> CQuorumBlockProcessor::AddMineableCommitment(const CFinalCom
         auto [itInserted, successfullyInserted] = minableCommitmentsByQuorum.try_emplace(k, commitmentHash);
         if (successfullyInserted) {
             minableCommitments.try_emplace(commitmentHash, fqc);
+            // SYSCOIN
+            InvalidateMinableCommitmentCache();
             return true;
         } else {
             auto& insertedQuorumHash = itInserted->second;
@@ -385,6 +405,8 @@ std::optional<CInv> CQuorumBlockProcessor::AddMineableCommitment(const CFinalCom
                 insertedQuorumHash = commitmentHash;
                 minableCommitments.erase(insertedQuorumHash);
                 minableCommitments.try_emplace(commitmentHash, fqc);
+                // SYSCOIN
+                InvalidateMinableCommitmentCache();
                 return true;
             }
         }
@@ -406,19 +428,48 @@ bool CQuorumBlockProcessor::GetMineableCommitmentByHash(const uint256& commitmen
     return true;
 }
 
+// SYSCOIN
+void CQuorumBlockProcessor::InvalidateMinableCommitmentCache()
+{
+    AssertLockHeld(minableCommitmentsCs);
+    minableCommitmentCache.reset();
+    ++minableCommitmentsGeneration;
+}
+
 // Will return false if no commitment should be mined
 // Will return true and a null commitment if no minable commitment is known and none was mined yet
 bool CQuorumBlockProcessor::GetMinableCommitment(int nHeight, CFinalCommitment& ret)
 {
     AssertLockHeld(cs_main);
+    // SYSCOIN templates at the same height ask for the same commitment over and over
+    const CBlockIndex* pindexTip = chainman.ActiveTip();
+    const uint256 hashTip = pindexTip ? pindexTip->GetBlockHash() : uint256();
+    uint64_t nGeneration;
+    {
+        LOCK(minableCommitmentsCs);
+        if (minableCommitmentCache && minableCommitmentCache->hashTip == hashTip && minableCommitmentCache->nHeight == nHeight) {
+            if (minableCommitmentCache->fRequired) {
+                ret = minableCommitmentCache->commitment;
+            }
+            return minableCommitmentCache->fRequired;
+        }
+        nGeneration = minableCommitmentsGeneration;
+    }
+    // only kept when no commitment arrived or got mined while it was looked up
+    const auto cache = [&](bool fRequired) EXCLUSIVE_LOCKS_REQUIRED(minableCommitmentsCs) {
+        if (nGeneration == minableCommitmentsGeneration) {
+            minableCommitmentCache = MinableCommitmentCache{hashTip, nHeight, fRequired, fRequired ? ret : CFinalCommitment()};
+        }
+        return fRequired;
+    };
     if (!IsCommitmentRequired(nHeight)) {
         // no commitment required
-        return false;
+        return WITH_LOCK(minableCommitmentsCs, return cache(false));
     }
     bool basic_bls_enabled = CLLMQUtils::IsV19Active(nHeight);
     uint256 quorumHash = GetQuorumBlockHash(chainman, nHeight);
     if (quorumHash.IsNull()) {
-        return false;
+        return WITH_LOCK(minableCommitmentsCs, return cache(false));
     }
     {
         LOCK(minableCommitmentsCs);
@@ -428,12 +479,11 @@ bool CQuorumBlockProcessor::GetMinableCommitment(int nHeight, CFinalCommitment&
             // null commitment required
             ret = CFinalCommitment(quorumHash);
             ret.nVersion = CFinalCommitment::GetVersion(basic_bls_enabled);
-            return true;
+            return cache(true);
         }
         ret = minableCommitments.at(it->second);
+        return cache(true);
     }
-
-    return true;
 }
 bool CQuorumBlockProcessor::FlushCacheToDisk() {
     return m_commitment_evoDb.FlushCacheToDisk();
@@ -11,6 +11,10 @@
 #include <saltedhasher.h>
 #include <kernel/cs_main.h>
 #include <threadsafety.h>
+#include <llmq/quorums_commitment.h>
+
+#include <atomic>
+#include <optional>
 class CNode;
 class CBlock;
 class PeerManager;
@@ -31,6 +35,21 @@ private:
     mutable Mutex minableCommitmentsCs;
     std::map<uint256, uint256> minableCommitmentsByQuorum GUARDED_BY(minableCommitmentsCs);
     std::map<uint256, CFinalCommitment> minableCommitments GUARDED_BY(minableCommitmentsCs);
+    // SYSCOIN GetMinableCommitment result for the block on top of hashTip, so every template at a height
+    // doesn't repeat the quorum and mined commitment lookups. There is a single LLMQ type, so one entry
+    // per tip is enough. Any change to the minable or mined commitments bumps the generation.
+    struct MinableCommitmentCache {
+        uint256 hashTip;
+        int nHeight{-1};
+        bool fRequired{false};
+        CFinalCommitment commitment;
+    };
+    std::optional<MinableCommitmentCache> minableCommitmentCache GUARDED_BY(minableCommitmentsCs);
+    uint64_t minableCommitmentsGeneration GUARDED_BY(minableCommitmentsCs){0};
+    void InvalidateMinableCommitmentCache() EXCLUSIVE_LOCKS_REQUIRED(minableCommitmentsCs);
+    // SYSCOIN bumped whenever a commitment is mined or undone, results derived from the mined commitments are
+    // cached as long as it does not move
+    std::atomic<uint64_t> minedCommitmentsGeneration{0};
 
 public:
     CEvoDB<uint256, std::pair<CFinalCommitment, uint256>, StaticSaltedHasher> m_commitment_evoDb;
@@ -39,14 +58,18 @@ public:
     void ProcessMessage(CNode* pfrom, const std::string& strCommand, CDataStream& vRecv) EXCLUSIVE_LOCKS_REQUIRED(!minableCommitmentsCs);
 
     bool ProcessBlock(const CBlock& block, const CBlockIndex* pindex, BlockValidationState& state, llmq::CFinalCommitmentTxPayload& qcTx, bool fJustCheck, bool fBLSChecks) EXCLUSIVE_LOCKS_REQUIRED(::cs_main, !minableCommitmentsCs);
-    bool UndoBlock(const CBlock& block, const CBlockIndex* pindex) EXCLUSIVE_LOCKS_REQUIRED(::cs_main);
+    bool UndoBlock(const CBlock& block, const CBlockIndex* pindex) EXCLUSIVE_LOCKS_REQUIRED(::cs_main, !minableCommitmentsCs);
 
-    std::optional<CInv> AddMineableCommitment(const CFinalCommitment& fqc);
+    std::optional<CInv> AddMineableCommitment(const CFinalCommitment& fqc) EXCLUSIVE_LOCKS_REQUIRED(!minableCommitmentsCs);
     bool HasMineableCommitment(const uint256& hash) const EXCLUSIVE_LOCKS_REQUIRED(!minableCommitmentsCs);
     bool GetMineableCommitmentByHash(const uint256& commitmentHash, CFinalCommitment& ret) EXCLUSIVE_LOCKS_REQUIRED(!minableCommitmentsCs);
     bool GetMinableCommitment(int nHeight, CFinalCommitment& ret) EXCLUSIVE_LOCKS_REQUIRED(::cs_main, !minableCommitmentsCs);
 
     bool HasMinedCommitment(const uint256& quorumHash);
+    // SYSCOIN
+    uint64_t GetMinedCommitmentsGeneration() const { return minedCommitmentsGeneration.load(); }
+    //! for commitments stored without going through ProcessBlock (snapshot import)
+    void MinedCommitmentsChanged() { ++minedCommitmentsGeneration; }
     CFinalCommitmentPtr GetMinedCommitment(const uint256& quorumHash, uint256& retMinedBlockHash);
     bool FlushCacheToDisk();
     static bool IsMiningPhase(int nHeight);
@@ -54,6 +77,9 @@ private:
     static bool GetCommitmentsFromBlock(const CBlock& block, const uint32_t& nHeight, llmq::CFinalCommitmentTxPayload &qcRet, BlockValidationState& state) EXCLUSIVE_LOCKS_REQUIRED(::cs_main);
     bool ProcessCommitment(int nHeight, const uint256& blockHash, const CFinalCommitment& qc, BlockValidationState& state, bool fJustCheck, bool fBLSChecks) EXCLUSIVE_LOCKS_REQUIRED(::cs_main, !minableCommitmentsCs);
     bool IsCommitmentRequired(int nHeight) EXCLUSIVE_LOCKS_REQUIRED(::cs_main);
+    // SYSCOIN commitments imported with a snapshot are stored before the background chainstate replays the block they
+    // were mined in, so only one mined below nHeight counts as already mined
+    bool HasMinedCommitmentBefore(const uint256& quorumHash, int nHeight) EXCLUSIVE_LOCKS_REQUIRED(::cs_main);
     static uint256 GetQuorumBlockHash(ChainstateManager& chainman, int nHeight) EXCLUSIVE_LOCKS_REQUIRED(::cs_main);
 };
 
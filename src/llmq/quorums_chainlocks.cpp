@@ -14,13 +14,18 @@
 #include <spork.h>
 #include <txmempool.h>
 #include <validation.h>
+#include <validationinterface.h>
 #include <scheduler.h>
 #include <util/thread.h>
+#include <util/trace.h>
 #include <services/nevmconsensus.h>
 #include <evo/deterministicmns.h>
 #include <logging.h>
+#include <metrics.h>
 #include <llmq/quorums_blockprocessor.h>
 #include <netmessagemaker.h>
+#include <bls/bls_batchverifier.h>
+#include <cxxtimer.hpp>
 namespace llmq
 {
 
@@ -28,6 +33,39 @@ static const std::string CLSIG_REQUESTID_PREFIX = "clsig";
 
 CChainLocksHandler* chainLocksHandler;
 
+void CTimedHashSet::Advance(int64_t nNowMs)
+{
+    const int64_t nSlice = nNowMs / nSliceMs;
+    if (nSlice <= nCurrentSlice) {
+        return;
+    }
+    // the buckets of all slices which went by are reused, the oldest of them held entries past the timeout
+    for (int64_t i = std::max(nCurrentSlice + 1, nSlice - (int64_t)BUCKETS); i <= nSlice; ++i) {
+        buckets[i % buckets.size()].clear();
+    }
+    nCurrentSlice = nSlice;
+}
+
+void CTimedHashSet::Insert(const uint256& hash, int64_t nNowMs)
+{
+    Advance(nNowMs);
+    buckets[std::max<int64_t>(nCurrentSlice, 0) % buckets.size()].emplace(hash);
+}
+
+bool CTimedHashSet::Contains(const uint256& hash) const
+{
+    return std::any_of(buckets.begin(), buckets.end(), [&](const auto& bucket) { return bucket.count(hash) != 0; });
+}
+
+size_t CTimedHashSet::size() const
+{
+    size_t nSize{0};
+    for (const auto& bucket : buckets) {
+        nSize += bucket.size();
+    }
+    return nSize;
+}
+
 bool CChainLockSig::IsNull() const
 {
     return nHeight == -1 && blockHash == uint256();
@@ -45,7 +83,7 @@ CChainLocksHandler::CChainLocksHandler(CConnman& _connman, PeerManager& _peerman
     peerman(_peerman),
     chainman(_chainman)
 {
-    scheduler = new CScheduler();
+    scheduler = new CScheduler("chainlocks");
     CScheduler::Function serviceLoop = std::bind(&CScheduler::serviceQueue, scheduler);
     scheduler_thread = new std::thread(&util::TraceThread, "cl-schdlr", serviceLoop);
 }
@@ -72,6 +110,7 @@ bool CChainLocksHandler::GetCLSIGFromPeers() {
 void CChainLocksHandler::Start()
 {
     quorumSigningManager->RegisterRecoveredSigsListener(this);
+    // SYSCOIN signing is driven by UpdatedBlockTip, this only retries tips it skipped and enforces late chainlocks
     scheduler->scheduleEvery([&]() {
         if(tryLockChainTipScheduled) {
             return;
@@ -92,7 +131,7 @@ void CChainLocksHandler::Start()
         if(bEnforce)
             TrySignChainTip();
         tryLockChainTipScheduled = false;
-    }, std::chrono::seconds{5});
+    }, std::chrono::seconds{5}, "trylockchaintip");
 }
 
 void CChainLocksHandler::Stop()
@@ -106,8 +145,11 @@ void CChainLocksHandler::Stop()
 
 bool CChainLocksHandler::AlreadyHave(const uint256& hash)
 {
+    if (WITH_LOCK(cs_pendingShares, return pendingShareHashes.count(hash) != 0)) {
+        return true;
+    }
     LOCK(cs);
-    return seenChainLocks.count(hash) != 0;
+    return seenChainLocks.Contains(hash);
 }
 
 bool CChainLocksHandler::GetChainLockByHash(const uint256& hash, llmq::CChainLockSig& ret)
@@ -124,17 +166,17 @@ bool CChainLocksHandler::GetChainLockByHash(const uint256& hash, llmq::CChainLoc
         return true;
     }
 
-    for (const auto& pair : bestChainLockCandidates) {
-        if (::SerializeHash(*pair.second) == hash) {
-            ret = *pair.second;
+    for (const auto& entry : chainLockHeights) {
+        if (entry.candidate && ::SerializeHash(*entry.candidate) == hash) {
+            ret = *entry.candidate;
             return true;
         }
     }
 
-    for (const auto& pair : bestChainLockShares) {
-        for (const auto& pair2 : pair.second) {
-            if (::SerializeHash(*pair2.second) == hash) {
-                ret = *pair2.second;
+    for (const auto& entry : chainLockHeights) {
+        for (const auto& pair : entry.shares) {
+            if (::SerializeHash(*pair.second) == hash) {
+                ret = *pair.second;
                 return true;
             }
         }
@@ -164,12 +206,37 @@ std::map<CQuorumCPtr, CChainLockSigCPtr> CChainLocksHandler::GetBestChainLockSha
 {
 
     LOCK(cs);
-    auto it = bestChainLockShares.find(bestChainLockWithKnownBlock.nHeight);
-    if (it == bestChainLockShares.end()) {
+    const auto* entry = FindHeightEntry(bestChainLockWithKnownBlock.nHeight);
+    if (entry == nullptr) {
         return {};
     }
 
-    return it->second;
+    return entry->shares;
+}
+
+CChainLocksHandler::ChainLockHeightEntry* CChainLocksHandler::FindHeightEntry(int nHeight)
+{
+    if (nHeight < 0) {
+        return nullptr;
+    }
+    auto& entry = chainLockHeights[(nHeight / SIGN_HEIGHT_OFFSET) % chainLockHeights.size()];
+    return entry.nHeight == nHeight ? &entry : nullptr;
+}
+
+CChainLocksHandler::ChainLockHeightEntry* CChainLocksHandler::GetOrAddHeightEntry(int nHeight)
+{
+    if (nHeight < 0) {
+        return nullptr;
+    }
+    auto& entry = chainLockHeights[(nHeight / SIGN_HEIGHT_OFFSET) % chainLockHeights.size()];
+    if (entry.nHeight > nHeight) {
+        return nullptr;
+    }
+    if (entry.nHeight < nHeight) {
+        entry = ChainLockHeightEntry();
+        entry.nHeight = nHeight;
+    }
+    return &entry;
 }
 
 bool CChainLocksHandler::TryUpdateBestChainLock(const CBlockIndex* pindex)
@@ -178,30 +245,32 @@ bool CChainLocksHandler::TryUpdateBestChainLock(const CBlockIndex* pindex)
         return false;
     }
 
-    auto it1 = bestChainLockCandidates.find(pindex->nHeight);
-    if (it1 != bestChainLockCandidates.end()) {
-        bestChainLockWithKnownBlock = *it1->second;
+    auto* entry = FindHeightEntry(pindex->nHeight);
+    if (entry == nullptr) {
+        return false;
+    }
+    if (entry->candidate) {
+        bestChainLockWithKnownBlock = *entry->candidate;
         bestChainLockBlockIndex = pindex;
+        UpdateChainLockedWindow();
         // only prune blob data upon chainlock so we cannot rollback on pruned blob transactions. If we rolled back on pruned blob data then upon new inclusion there could be situation
         // where new block would fall within 2-hour time window of enforcement and include the pruned blob tx
         if(!pnevmdatadb->PruneStandalone(bestChainLockBlockIndex->GetMedianTimePast())) {
             LogPrintf("CChainLocksHandler::%s -- CNEVMDataDB::Prune failed\n", __func__);
         }
         LogPrint(BCLog::CHAINLOCKS, "CChainLocksHandler::%s -- CLSIG from candidates (%s)\n", __func__, bestChainLockWithKnownBlock.ToString());
+        TRACE4(llmq, chainlock_formed, pindex->phashBlock->data(), pindex->nHeight,
+            std::count(bestChainLockWithKnownBlock.signers.begin(), bestChainLockWithKnownBlock.signers.end(), true), /*aggregated=*/false);
         return true;
     }
 
-    auto it2 = bestChainLockShares.find(pindex->nHeight);
-    if (it2 == bestChainLockShares.end()) {
-        return false;
-    }
     const auto& llmqParams = Params().GetConsensus().llmqTypeChainLocks;
     const size_t threshold = llmqParams.signingActiveQuorumCount / 2 + 1;
 
     std::vector<CBLSSignature> sigs;
     CChainLockSig clsigAgg;
 
-    for (const auto& pair : it2->second) {
+    for (const auto& pair : entry->shares) {
         if (pair.second->blockHash == pindex->GetBlockHash()) {
             assert(std::count(pair.second->signers.begin(), pair.second->signers.end(), true) <= 1);
             sigs.emplace_back(pair.second->sig);
@@ -216,13 +285,15 @@ bool CChainLocksHandler::TryUpdateBestChainLock(const CBlockIndex* pindex)
                 clsigAgg.sig = CBLSSignature::AggregateInsecure(sigs);
                 bestChainLockWithKnownBlock = clsigAgg;
                 bestChainLockBlockIndex = pindex;
-                bestChainLockCandidates[clsigAgg.nHeight] = std::make_shared<const CChainLockSig>(clsigAgg);
+                UpdateChainLockedWindow();
+                entry->candidate = std::make_shared<const CChainLockSig>(clsigAgg);
                 // only prune blob data upon chainlock so we cannot rollback on pruned blob transactions. If we rolled back on pruned blob data then upon new inclusion there could be situation
                 // where new block would fall within 2-hour time window of enforcement and include the pruned blob tx
                 if(!pnevmdatadb->PruneStandalone(bestChainLockBlockIndex->GetMedianTimePast())) {
                     LogPrintf("CChainLocksHandler::%s -- CNEVMDataDB::Prune failed\n", __func__);
                 }
                 LogPrint(BCLog::CHAINLOCKS, "CChainLocksHandler::%s -- CLSIG aggregated (%s)\n", __func__, bestChainLockWithKnownBlock.ToString());
+                TRACE4(llmq, chainlock_formed, pindex->phashBlock->data(), pindex->nHeight, sigs.size(), /*aggregated=*/true);
                 return true;
             }
         }
@@ -231,14 +302,78 @@ bool CChainLocksHandler::TryUpdateBestChainLock(const CBlockIndex* pindex)
 }
 
 
-bool CChainLocksHandler::VerifyChainLockShare(const CChainLockSig& clsig, const CBlockIndex* pindexScan, const uint256& idIn, std::pair<int, CQuorumCPtr>& ret, const uint256& hash)
+CChainLocksHandler::ChainLockQuorumsCPtr CChainLocksHandler::GetChainLockQuorums(const CBlockIndex* pindexScan)
 {
     {
         LOCK(cs);
-        if(sigChecked.find(hash) != sigChecked.end()) {
-            return true;
+        auto it = chainLockQuorums.find(pindexScan->GetBlockHash());
+        if (it != chainLockQuorums.end()) {
+            return it->second;
+        }
+    }
+    const auto& signingActiveQuorumCount = Params().GetConsensus().llmqTypeChainLocks.signingActiveQuorumCount;
+    auto quorums_scanned = llmq::quorumManager->ScanQuorums(pindexScan, signingActiveQuorumCount);
+    if (quorums_scanned.empty() || std::count(quorums_scanned.begin(), quorums_scanned.end(), nullptr) > 0) {
+        return nullptr;
+    }
+    auto ret = std::make_shared<ChainLockQuorums>();
+    ret->nHeight = pindexScan->nHeight;
+    for (const auto& quorum : quorums_scanned) {
+        ret->requestIds.emplace_back(::SerializeHash(std::make_tuple(CLSIG_REQUESTID_PREFIX, ret->nHeight, quorum->qc->quorumHash)));
+    }
+    ret->quorums = std::move(quorums_scanned);
+    // only a complete scan is kept, a partial one might still change once the missing quorums are known
+    if (ret->quorums.size() == (size_t)signingActiveQuorumCount) {
+        LOCK(cs);
+        chainLockQuorums.emplace(pindexScan->GetBlockHash(), ret);
+    }
+    return ret;
+}
+void CChainLocksHandler::UpdateChainLockedWindow()
+{
+    // SYSCOIN
+    static metrics::Gauge& chainlock_height{metrics::GetGauge("syscoin_chainlock_height", "Height of the best chainlock")};
+    chainlock_height.Set(bestChainLockBlockIndex ? bestChainLockBlockIndex->nHeight : 0);
+    if (bestChainLockBlockIndex == nullptr) {
+        chainLockedWindow.clear();
+        return;
+    }
+    // walk back from the new chainlock until reaching a block of the window, which the new one builds on then
+    std::vector<const CBlockIndex*> vecNew;
+    bool fConnected{false};
+    for (const CBlockIndex* pindex = bestChainLockBlockIndex; pindex != nullptr && (int)vecNew.size() < CHAINLOCKED_WINDOW_SIZE; pindex = pindex->pprev) {
+        if (!chainLockedWindow.empty()) {
+            const int nOffset = pindex->nHeight - chainLockedWindow.front()->nHeight;
+            if (nOffset < 0) {
+                break;
+            }
+            if (nOffset < (int)chainLockedWindow.size() && chainLockedWindow[nOffset] == pindex) {
+                chainLockedWindow.resize(nOffset + 1);
+                fConnected = true;
+                break;
+            }
         }
+        vecNew.emplace_back(pindex);
+    }
+    if (!fConnected) {
+        chainLockedWindow.clear();
     }
+    chainLockedWindow.insert(chainLockedWindow.end(), vecNew.rbegin(), vecNew.rend());
+    while (chainLockedWindow.size() > (size_t)CHAINLOCKED_WINDOW_SIZE) {
+        chainLockedWindow.pop_front();
+    }
+}
+
+const CBlockIndex* CChainLocksHandler::GetChainLockedAncestor(int nHeight) const
+{
+    if (!chainLockedWindow.empty() && nHeight >= chainLockedWindow.front()->nHeight) {
+        return chainLockedWindow[nHeight - chainLockedWindow.front()->nHeight];
+    }
+    return bestChainLockBlockIndex->GetAncestor(nHeight);
+}
+
+bool CChainLocksHandler::VerifyChainLockShare(const CChainLockSig& clsig, const CBlockIndex* pindexScan, const uint256& idIn, std::pair<int, CQuorumCPtr>& ret, const uint256& hash)
+{
     const auto& consensus = Params().GetConsensus();
     const auto& llmqParams = consensus.llmqTypeChainLocks;
     const auto& signingActiveQuorumCount = llmqParams.signingActiveQuorumCount;
@@ -253,13 +388,15 @@ bool CChainLocksHandler::VerifyChainLockShare(const CChainLockSig& clsig, const
         return false;
     }
     bool fHaveSigner{std::count(clsig.signers.begin(), clsig.signers.end(), true) > 0};
-    const auto quorums_scanned = llmq::quorumManager->ScanQuorums(pindexScan, signingActiveQuorumCount);
-    for (size_t i = 0; i < quorums_scanned.size(); ++i) {
-        const CQuorumCPtr& quorum = quorums_scanned[i];
-        if (quorum == nullptr) {
-            return false;
-        }
-        uint256 requestId = ::SerializeHash(std::make_tuple(CLSIG_REQUESTID_PREFIX, clsig.nHeight, quorum->qc->quorumHash));
+    const auto clQuorums = GetChainLockQuorums(pindexScan);
+    if (clQuorums == nullptr || clQuorums->nHeight != clsig.nHeight) {
+        return false;
+    }
+    // SYSCOIN a share already verified (e.g. in a batch) still needs its quorum, which the signer bit or the id picks
+    const bool fChecked = (fHaveSigner || !idIn.IsNull()) && WITH_LOCK(cs, return sigChecked.Contains(hash));
+    for (size_t i = 0; i < clQuorums->quorums.size(); ++i) {
+        const CQuorumCPtr& quorum = clQuorums->quorums[i];
+        const uint256& requestId = clQuorums->requestIds[i];
         if ((!idIn.IsNull() && idIn != requestId)) {
             continue;
         }
@@ -270,7 +407,7 @@ bool CChainLocksHandler::VerifyChainLockShare(const CChainLockSig& clsig, const
         LogPrint(BCLog::CHAINLOCKS, "CChainLocksHandler::%s -- CLSIG (%s) requestId=%s, signHash=%s\n",
                 __func__, clsig.ToString(), requestId.ToString(), signHash.ToString());
 
-        if (clsig.sig.VerifyInsecure(quorum->qc->quorumPublicKey, signHash)) {
+        if (fChecked || clsig.sig.VerifyInsecure(quorum->preparedPublicKey, signHash)) {
             if (idIn.IsNull() && !quorumSigningManager->HasRecoveredSigForId(requestId)) {
                 // We can reconstruct the CRecoveredSig from the clsig and pass it to the signing manager, which
                 // avoids unnecessary double-verification of the signature. We can do this here because we just
@@ -281,7 +418,7 @@ bool CChainLocksHandler::VerifyChainLockShare(const CChainLockSig& clsig, const
             ret = std::make_pair(i, quorum);
             {
                 LOCK(cs);
-                sigChecked.emplace(hash, TicksSinceEpoch<std::chrono::milliseconds>(SystemClock::now()));
+                sigChecked.Insert(hash, TicksSinceEpoch<std::chrono::milliseconds>(SystemClock::now()));
             }
             return true;
         }
@@ -296,7 +433,7 @@ bool CChainLocksHandler::VerifyAggregatedChainLock(const CChainLockSig& clsig, c
 {
     {
         LOCK(cs);
-        if(sigChecked.find(hash) != sigChecked.end()) {
+        if(sigChecked.Contains(hash)) {
             return true;
         }
     }
@@ -305,7 +442,7 @@ bool CChainLocksHandler::VerifyAggregatedChainLock(const CChainLockSig& clsig, c
     const auto& signingActiveQuorumCount = llmqParams.signingActiveQuorumCount;
 
     std::vector<uint256> hashes;
-    std::vector<CBLSPublicKey> quorumPublicKeys;
+    std::vector<const CBLSPreparedPublicKey*> quorumPublicKeys;
 
     if (clsig.signers.size() != (size_t)signingActiveQuorumCount) {
         return false;
@@ -315,21 +452,18 @@ bool CChainLocksHandler::VerifyAggregatedChainLock(const CChainLockSig& clsig, c
         // not enough signers
         return false;
     }
-    const auto quorums_scanned = llmq::quorumManager->ScanQuorums(pindexScan, signingActiveQuorumCount);
-    if(quorums_scanned.empty()) {
+    const auto clQuorums = GetChainLockQuorums(pindexScan);
+    if (clQuorums == nullptr || clQuorums->nHeight != clsig.nHeight) {
         return false;
     }
     
-    for (size_t i = 0; i < quorums_scanned.size(); ++i) {
-        const CQuorumCPtr& quorum = quorums_scanned[i];
-        if (quorum == nullptr) {
-            return false;
-        }
+    for (size_t i = 0; i < clQuorums->quorums.size(); ++i) {
+        const CQuorumCPtr& quorum = clQuorums->quorums[i];
         if (!clsig.signers[i]) {
             continue;
         }
-        quorumPublicKeys.emplace_back(quorum->qc->quorumPublicKey);
-        uint256 requestId = ::SerializeHash(std::make_tuple(CLSIG_REQUESTID_PREFIX, clsig.nHeight, quorum->qc->quorumHash));
+        quorumPublicKeys.emplace_back(&quorum->preparedPublicKey);
+        const uint256& requestId = clQuorums->requestIds[i];
         uint256 signHash = llmq::BuildSignHash(quorum->qc->quorumHash, requestId, clsig.blockHash);
         hashes.emplace_back(signHash);
         LogPrint(BCLog::CHAINLOCKS, "CChainLocksHandler::%s -- index %d CLSIG (%s) pindexScan=%s requestId=%s (clsig.nHeight %d, quorum->qc->quorumHash %s), signHash=%s (quorum->qc->quorumHash, requestId, clsig.blockHash)\n",
@@ -338,11 +472,103 @@ bool CChainLocksHandler::VerifyAggregatedChainLock(const CChainLockSig& clsig, c
     bool result = clsig.sig.VerifyInsecureAggregated(quorumPublicKeys, hashes);
     if(result) {
         LOCK(cs);
-        sigChecked.emplace(hash, TicksSinceEpoch<std::chrono::milliseconds>(SystemClock::now()));
+        sigChecked.Insert(hash, TicksSinceEpoch<std::chrono::milliseconds>(SystemClock::now()));
     }
     return result;
 }
 
+bool CChainLocksHandler::EnqueueChainLockShare(const NodeId from, const CChainLockSig& clsig, const uint256& hash)
+{
+    LOCK(cs_pendingShares);
+    if (pendingShares.size() >= MAX_PENDING_CLSIG_SHARES) {
+        return false;
+    }
+    pendingShares.emplace_back(PendingChainLockShare{from, clsig, hash});
+    pendingShareHashes.emplace(hash);
+    if (!pendingSharesScheduled) {
+        pendingSharesScheduled = true;
+        scheduler->scheduleFromNow([&]() {
+            ProcessPendingChainLockShares();
+        }, CLSIG_SHARE_BATCH_DELAY, "chainlockshares");
+    }
+    return true;
+}
+
+void CChainLocksHandler::ProcessPendingChainLockShares()
+{
+    std::vector<PendingChainLockShare> shares;
+    {
+        LOCK(cs_pendingShares);
+        shares.swap(pendingShares);
+        pendingSharesScheduled = false;
+    }
+
+    const auto& signingActiveQuorumCount = Params().GetConsensus().llmqTypeChainLocks.signingActiveQuorumCount;
+    int nActiveHeight = WITH_LOCK(cs_main, return chainman.ActiveHeight()) - SIGN_HEIGHT_OFFSET;
+    nActiveHeight -= nActiveHeight % SIGN_HEIGHT_OFFSET;
+
+    // The shares of all quorums for the current height go into one batch, which is checked with a single
+    // multi-pairing. Only the shares of a peer that relayed a bad one are verified one by one. Shares which
+    // ProcessNewChainLock would reject before looking at the signature are left out.
+    CBLSBatchVerifier<NodeId, size_t> batchVerifier(false, true);
+    std::vector<size_t> batched;
+    std::set<uint256> batchedHashes;
+    for (size_t i = 0; i < shares.size(); ++i) {
+        const auto& share = shares[i];
+        const auto& clsig = share.clsig;
+        if (clsig.nHeight != nActiveHeight || clsig.signers.size() != (size_t)signingActiveQuorumCount || !clsig.sig.IsValid() ||
+                !batchedHashes.emplace(share.hash).second) {
+            continue;
+        }
+        {
+            LOCK(cs);
+            if (seenChainLocks.Contains(share.hash) || sigChecked.Contains(share.hash)) {
+                continue;
+            }
+        }
+        const CBlockIndex* pindexScan = WITH_LOCK(cs_main, return chainman.m_blockman.LookupBlockIndex(clsig.blockHash));
+        if (pindexScan == nullptr || pindexScan->nHeight != clsig.nHeight) {
+            continue;
+        }
+        const auto clQuorums = GetChainLockQuorums(pindexScan);
+        const size_t nSigner = std::find(clsig.signers.begin(), clsig.signers.end(), true) - clsig.signers.begin();
+        if (clQuorums == nullptr || nSigner >= clQuorums->quorums.size()) {
+            continue;
+        }
+        const auto& quorum = clQuorums->quorums[nSigner];
+        const uint256 signHash = llmq::BuildSignHash(quorum->qc->quorumHash, clQuorums->requestIds[nSigner], clsig.blockHash);
+        batchVerifier.PushMessage(share.from, i, signHash, clsig.sig, quorum->qc->quorumPublicKey);
+        batched.emplace_back(i);
+    }
+
+    if (!batched.empty()) {
+        cxxtimer::Timer verifyTimer(true);
+        batchVerifier.Verify();
+        verifyTimer.stop();
+        LogPrint(BCLog::CHAINLOCKS, "CChainLocksHandler::%s -- verified %d CLSIG shares, %d bad, %dms\n", __func__,
+                batched.size(), batchVerifier.badMessages.size(), verifyTimer.count());
+
+        const int64_t nNow = TicksSinceEpoch<std::chrono::milliseconds>(SystemClock::now());
+        LOCK(cs);
+        for (const size_t i : batched) {
+            if (!batchVerifier.badMessages.count(i)) {
+                sigChecked.Insert(shares[i].hash, nNow);
+            }
+        }
+    }
+
+    // bad shares are not marked as checked and get rejected by ProcessNewChainLock as before
+    for (auto& share : shares) {
+        BlockValidationState state;
+        ProcessNewChainLock(share.from, share.clsig, state, share.hash);
+    }
+
+    LOCK(cs_pendingShares);
+    for (const auto& share : shares) {
+        pendingShareHashes.erase(share.hash);
+    }
+}
+
 void CChainLocksHandler::ProcessMessage(CNode* pfrom, const std::string& strCommand, CDataStream& vRecv)
 {
     if (!AreChainLocksEnabled()) {
@@ -352,8 +578,13 @@ void CChainLocksHandler::ProcessMessage(CNode* pfrom, const std::string& strComm
     if (strCommand == NetMsgType::CLSIG) {
         CChainLockSig clsig;
         vRecv >> clsig;
+        const uint256 hash = ::SerializeHash(clsig);
+        // SYSCOIN the shares of the quorums arrive in a burst, collect them to verify them together
+        if (std::count(clsig.signers.begin(), clsig.signers.end(), true) == 1 && EnqueueChainLockShare(pfrom->GetId(), clsig, hash)) {
+            return;
+        }
         BlockValidationState state;
-        ProcessNewChainLock(pfrom->GetId(), clsig, state, ::SerializeHash(clsig));
+        ProcessNewChainLock(pfrom->GetId(), clsig, state, hash);
     }
 }
 
@@ -370,7 +601,7 @@ bool CChainLocksHandler::ProcessNewChainLock(const NodeId from, llmq::CChainLock
     }
     {
         LOCK2(cs_main, cs);
-        if(seenChainLocks.find(hash) != seenChainLocks.end()) {
+        if(seenChainLocks.Contains(hash)) {
             if (from != -1) {
                 peerman.ForgetTxHash(from, hash);
             }
@@ -495,11 +726,8 @@ bool CChainLocksHandler::ProcessNewChainLock(const NodeId from, llmq::CChainLock
                 }
                 return state.Invalid(BlockValidationResult::BLOCK_CHAINLOCK, "clsig-invalid-signer-count");
             }
-            auto it = bestChainLockShares.find(clsig.nHeight);
-            if (it == bestChainLockShares.end()) {
-                bestChainLockShares[clsig.nHeight].emplace(ret.second, std::make_shared<const CChainLockSig>(clsig));
-            } else {
-                it->second.emplace(ret.second, std::make_shared<const CChainLockSig>(clsig));
+            if (auto* entry = GetOrAddHeightEntry(clsig.nHeight)) {
+                entry->shares.emplace(ret.second, std::make_shared<const CChainLockSig>(clsig));
             }
             mostRecentChainLockShare = clsig;
             if (TryUpdateBestChainLock(pindexScan)) {
@@ -543,7 +771,9 @@ bool CChainLocksHandler::ProcessNewChainLock(const NodeId from, llmq::CChainLock
         }
             {
                 LOCK(cs);
-                bestChainLockCandidates[clsig.nHeight] = std::make_shared<const CChainLockSig>(clsig);
+                if (auto* entry = GetOrAddHeightEntry(clsig.nHeight)) {
+                    entry->candidate = std::make_shared<const CChainLockSig>(clsig);
+                }
                 mostRecentChainLockShare = clsig;
                 TryUpdateBestChainLock(pindexScan);
             }
@@ -562,12 +792,14 @@ bool CChainLocksHandler::ProcessNewChainLock(const NodeId from, llmq::CChainLock
         if(enforced) {
             chainman.ActiveChainstate().EnforceBestChainLock(pindex);
         }
+        // SYSCOIN
+        GetMainSignals().NotifyChainLock(pindex, std::make_shared<const CChainLockSig>(WITH_LOCK(cs, return bestChainLockWithKnownBlock)));
         LogPrint(BCLog::CHAINLOCKS, "CChainLocksHandler::%s -- processed new CLSIG (%s), peer=%d\n",
             __func__, clsig.ToString(), from);
     }
     {
         LOCK(cs);
-        seenChainLocks.emplace(hash, TicksSinceEpoch<std::chrono::milliseconds>(SystemClock::now()));
+        seenChainLocks.Insert(hash, TicksSinceEpoch<std::chrono::milliseconds>(SystemClock::now()));
     }
     if (from != -1) {
         LOCK(cs_main);
@@ -580,8 +812,8 @@ void CChainLocksHandler::NotifyHeaderTip(const CBlockIndex* pindexNew)
 {
     LOCK(cs);
 
-    auto it = bestChainLockCandidates.find(pindexNew->nHeight);
-    if (it == bestChainLockCandidates.end()) {
+    const auto* entry = FindHeightEntry(pindexNew->nHeight);
+    if (entry == nullptr || !entry->candidate) {
         return;
     }
 
@@ -597,30 +829,49 @@ void CChainLocksHandler::UpdatedBlockTip(const CBlockIndex* pindexNew, bool fIni
 {
     if(fInitialDownload)
         return;
-    // don't call TrySignChainTip directly but instead let the scheduler call it. This way we ensure that cs_main is
-    // never locked and TrySignChainTip is not called twice in parallel. Also avoids recursive calls due to
-    // EnforceBestChainLock switching chains.
-    // atomic[If tryLockChainTipScheduled is false, do (set it to true] and schedule signing).
-    if (!tryLockChainTipScheduled) {
-        tryLockChainTipScheduled = true;
-        scheduler->scheduleFromNow([&]() {
-            CheckActiveState();
-            bool enforced = false;
-            const CBlockIndex* pindex;
-            {       
-                LOCK(cs);
-                pindex = bestChainLockBlockIndex;
-                enforced = isEnforced;
-            }
-            bool bEnforce = false;
-            if(enforced) {
-                bEnforce = chainman.ActiveChainstate().EnforceBestChainLock(pindex);
-            }
-            if(bEnforce)
-                TrySignChainTip();
-            tryLockChainTipScheduled = false;
-        }, std::chrono::seconds{0});
+    // atomic[If tryLockChainTipScheduled is false, do (set it to true] and sign or schedule signing).
+    // A signing attempt which is already running or the periodic one from Start will pick up this tip otherwise.
+    if (tryLockChainTipScheduled.exchange(true)) {
+        return;
+    }
+    CheckActiveState();
+    bool enforced = false;
+    const CBlockIndex* pindex;
+    {
+        LOCK(cs);
+        pindex = bestChainLockBlockIndex;
+        enforced = isEnforced;
+    }
+    if (!enforced) {
+        tryLockChainTipScheduled = false;
+        return;
     }
+    // SYSCOIN when the new tip builds on the best chainlock there is nothing to enforce, so sign right away from this
+    // callback instead of waiting for the scheduler. Otherwise EnforceBestChainLock may have to switch chains, which
+    // must not happen on the validation interface thread, so that still goes through the scheduler. This also avoids
+    // recursive calls due to EnforceBestChainLock switching chains.
+    if (pindex == nullptr || pindexNew->GetAncestor(pindex->nHeight) == pindex) {
+        TrySignChainTip();
+        tryLockChainTipScheduled = false;
+        return;
+    }
+    scheduler->scheduleFromNow([&]() {
+        CheckActiveState();
+        bool enforced = false;
+        const CBlockIndex* pindex;
+        {       
+            LOCK(cs);
+            pindex = bestChainLockBlockIndex;
+            enforced = isEnforced;
+        }
+        bool bEnforce = false;
+        if(enforced) {
+            bEnforce = chainman.ActiveChainstate().EnforceBestChainLock(pindex);
+        }
+        if(bEnforce)
+            TrySignChainTip();
+        tryLockChainTipScheduled = false;
+    }, std::chrono::seconds{0}, "trylockchaintip");
 }
 
 void CChainLocksHandler::CheckActiveState()
@@ -638,8 +889,8 @@ void CChainLocksHandler::CheckActiveState()
             // to disable spork19)
             mostRecentChainLockShare = bestChainLockWithKnownBlock = CChainLockSig();
             bestChainLockBlockIndex = nullptr;
-            bestChainLockCandidates.clear();
-            bestChainLockShares.clear();
+            chainLockedWindow.clear();
+            chainLockHeights.fill(ChainLockHeightEntry());
         }
     }
 }
@@ -759,9 +1010,8 @@ void CChainLocksHandler::TrySignChainTip()
     std::map<CQuorumCPtr, CChainLockSigCPtr> mapSharesAtTip;
     {
         LOCK(cs);
-        const auto it = bestChainLockShares.find(nHeight);
-        if (it != bestChainLockShares.end()) {
-            mapSharesAtTip = it->second;
+        if (const auto* entry = FindHeightEntry(nHeight)) {
+            mapSharesAtTip = entry->shares;
         }
     }
     bool fMemberOfSomeQuorum{false};
@@ -893,7 +1143,7 @@ bool CChainLocksHandler::InternalHasChainLock(int nHeight, const uint256& blockH
         return blockHash == bestChainLockBlockIndex->GetBlockHash();
     }
 
-    auto pAncestor = bestChainLockBlockIndex->GetAncestor(nHeight);
+    auto pAncestor = GetChainLockedAncestor(nHeight);
     return pAncestor && pAncestor->GetBlockHash() == blockHash;
 }
 
@@ -922,7 +1172,7 @@ bool CChainLocksHandler::InternalHasConflictingChainLock(int nHeight, const uint
         return blockHash != bestChainLockBlockIndex->GetBlockHash();
     }
 
-    auto pAncestor = bestChainLockBlockIndex->GetAncestor(nHeight);
+    auto pAncestor = GetChainLockedAncestor(nHeight);
     assert(pAncestor);
     return pAncestor->GetBlockHash() != blockHash;
 }
@@ -942,35 +1192,21 @@ void CChainLocksHandler::Cleanup()
 
     LOCK(cs);
 
-    for (auto it = seenChainLocks.begin(); it != seenChainLocks.end(); ) {
-        if (TicksSinceEpoch<std::chrono::milliseconds>(SystemClock::now()) - it->second >= CLEANUP_SEEN_TIMEOUT) {
-            it = seenChainLocks.erase(it);
+    const int64_t nNow = TicksSinceEpoch<std::chrono::milliseconds>(SystemClock::now());
+    seenChainLocks.Expire(nNow);
+    sigChecked.Expire(nNow);
+    for (auto it = chainLockQuorums.begin(); it != chainLockQuorums.end(); ) {
+        if (it->second->nHeight < bestChainLockWithKnownBlock.nHeight) {
+            it = chainLockQuorums.erase(it);
         } else {
             ++it;
         }
     }
-    for (auto it = sigChecked.begin(); it != sigChecked.end(); ) {
-        if (TicksSinceEpoch<std::chrono::milliseconds>(SystemClock::now()) - it->second >= CLEANUP_SEEN_TIMEOUT) {
-            it = sigChecked.erase(it);
-        } else {
-            ++it;
-        }
-    }
-    
 
     if (bestChainLockBlockIndex != nullptr) {
-        for (auto it = bestChainLockCandidates.begin(); it != bestChainLockCandidates.end(); ) {
-            if (it->first == bestChainLockBlockIndex->nHeight) {
-                it = bestChainLockCandidates.erase(++it, bestChainLockCandidates.end());
-            } else {
-                ++it;
-            }
-        }
-        for (auto it = bestChainLockShares.begin(); it != bestChainLockShares.end(); ) {
-            if (it->first == bestChainLockBlockIndex->nHeight) {
-                it = bestChainLockShares.erase(++it, bestChainLockShares.end());
-            } else {
-                ++it;
+        for (auto& entry : chainLockHeights) {
+            if (entry.nHeight < bestChainLockBlockIndex->nHeight) {
+                entry = ChainLockHeightEntry();
             }
         }
     }
@@ -6,7 +6,14 @@
 #define SYSCOIN_LLMQ_QUORUMS_CHAINLOCKS_H
 
 #include <llmq/quorums_signing.h>
+#include <saltedhasher.h>
+
+#include <array>
 #include <atomic>
+#include <deque>
+#include <set>
+#include <unordered_map>
+#include <unordered_set>
 
 
 class CBlockIndex;
@@ -58,17 +65,42 @@ public:
 
 typedef std::shared_ptr<const CChainLockSig> CChainLockSigCPtr;
 
-struct ReverseHeightComparator
+/**
+ * SYSCOIN Hashes remembered for at least a given time. They are kept in a ring of buckets which each cover a slice
+ * of that time, so expiring them drops whole buckets instead of checking the age of every entry.
+ */
+class CTimedHashSet
 {
-    bool operator()(const int h1, const int h2) const {
-        return h1 > h2;
-    }
+    static const size_t BUCKETS = 8;
+
+    const int64_t nSliceMs;
+    // one bucket more than the timeout spans, the oldest one is cleared when time moves into a new slice
+    std::array<std::unordered_set<uint256, StaticSaltedHasher>, BUCKETS + 1> buckets;
+    int64_t nCurrentSlice{-1};
+
+    void Advance(int64_t nNowMs);
+
+public:
+    explicit CTimedHashSet(int64_t nTimeoutMs) : nSliceMs(std::max<int64_t>(nTimeoutMs / BUCKETS, 1)) {}
+
+    void Insert(const uint256& hash, int64_t nNowMs);
+    bool Contains(const uint256& hash) const;
+    void Expire(int64_t nNowMs) { Advance(nNowMs); }
+    size_t size() const;
 };
 
 class CChainLocksHandler : public CRecoveredSigsListener
 {
     static const int64_t CLEANUP_INTERVAL = 1000 * 30;
     static const int64_t CLEANUP_SEEN_TIMEOUT = 24 * 60 * 60 * 1000;
+    // SYSCOIN time the CLSIG shares of a height are collected for before they are batch verified
+    static constexpr auto CLSIG_SHARE_BATCH_DELAY = std::chrono::milliseconds{10};
+    // shares beyond this are not queued but verified right away
+    static const size_t MAX_PENDING_CLSIG_SHARES = 1000;
+    // number of blocks up to the best chainlock kept in chainLockedWindow
+    static const int CHAINLOCKED_WINDOW_SIZE = 1024;
+    // number of chainlock heights shares and candidates are kept for
+    static const size_t CHAINLOCK_HEIGHT_RING_SIZE = 8;
 
 
 private:
@@ -82,13 +114,42 @@ private:
     CChainLockSig mostRecentChainLockShare GUARDED_BY(cs);
     CChainLockSig bestChainLockWithKnownBlock GUARDED_BY(cs);
     const CBlockIndex* bestChainLockBlockIndex {nullptr};
-    // Keep best chainlock shares and candidates, sorted by height (highest heght first).
-    std::map<int, std::map<CQuorumCPtr, CChainLockSigCPtr>, ReverseHeightComparator> bestChainLockShares GUARDED_BY(cs);
-    std::map<int, CChainLockSigCPtr, ReverseHeightComparator> bestChainLockCandidates GUARDED_BY(cs);
-
-    std::map<uint256, std::pair<int, uint256> > mapSignedRequestIds GUARDED_BY(cs);
-    std::map<uint256, int64_t> seenChainLocks GUARDED_BY(cs);
-    std::map<uint256, int64_t> sigChecked GUARDED_BY(cs);
+    // SYSCOIN the last blocks up to and including bestChainLockBlockIndex by height, so that checks against recent
+    // heights are a lookup instead of a walk through the skip list of GetAncestor
+    std::deque<const CBlockIndex*> chainLockedWindow GUARDED_BY(cs);
+    // SYSCOIN Keep best chainlock shares and candidates of the recent heights in a ring indexed by height, a slot
+    // is reused once a higher height maps to it
+    struct ChainLockHeightEntry {
+        int nHeight{-1};
+        std::map<CQuorumCPtr, CChainLockSigCPtr> shares;
+        CChainLockSigCPtr candidate;
+    };
+    std::array<ChainLockHeightEntry, CHAINLOCK_HEIGHT_RING_SIZE> chainLockHeights GUARDED_BY(cs);
+
+    std::unordered_map<uint256, std::pair<int, uint256>, StaticSaltedHasher> mapSignedRequestIds GUARDED_BY(cs);
+    CTimedHashSet seenChainLocks GUARDED_BY(cs) {CLEANUP_SEEN_TIMEOUT};
+    CTimedHashSet sigChecked GUARDED_BY(cs) {CLEANUP_SEEN_TIMEOUT};
+
+    // SYSCOIN quorums scanned from a CLSIG block together with the request id each of them signs at its height,
+    // computed once per block instead of for every share and aggregated CLSIG of that height
+    struct ChainLockQuorums {
+        int nHeight;
+        std::vector<CQuorumCPtr> quorums;
+        std::vector<uint256> requestIds;
+    };
+    using ChainLockQuorumsCPtr = std::shared_ptr<const ChainLockQuorums>;
+    std::map<uint256, ChainLockQuorumsCPtr> chainLockQuorums GUARDED_BY(cs);
+
+    // CLSIG shares received from peers, batch verified on the scheduler thread
+    struct PendingChainLockShare {
+        NodeId from;
+        CChainLockSig clsig;
+        uint256 hash;
+    };
+    Mutex cs_pendingShares;
+    std::vector<PendingChainLockShare> pendingShares GUARDED_BY(cs_pendingShares);
+    std::set<uint256> pendingShareHashes GUARDED_BY(cs_pendingShares);
+    bool pendingSharesScheduled GUARDED_BY(cs_pendingShares) {false};
 
     int64_t lastCleanupTime GUARDED_BY(cs) {0};
 
@@ -102,14 +163,14 @@ public:
     void Start() EXCLUSIVE_LOCKS_REQUIRED(!cs);
     void Stop();
 
-    bool AlreadyHave(const uint256& hash) EXCLUSIVE_LOCKS_REQUIRED(!cs);
+    bool AlreadyHave(const uint256& hash) EXCLUSIVE_LOCKS_REQUIRED(!cs, !cs_pendingShares);
     bool GetChainLockByHash(const uint256& hash, CChainLockSig& ret) EXCLUSIVE_LOCKS_REQUIRED(!cs);
     CChainLockSig GetMostRecentChainLock() EXCLUSIVE_LOCKS_REQUIRED(!cs);
     CChainLockSig GetBestChainLock() EXCLUSIVE_LOCKS_REQUIRED(!cs);
     const CBlockIndex* GetBestChainLockIndex() EXCLUSIVE_LOCKS_REQUIRED(!cs);
     std::map<CQuorumCPtr, CChainLockSigCPtr> GetBestChainLockShares() EXCLUSIVE_LOCKS_REQUIRED(!cs);
 
-    void ProcessMessage(CNode* pfrom, const std::string& strCommand, CDataStream& vRecv) EXCLUSIVE_LOCKS_REQUIRED(!cs);
+    void ProcessMessage(CNode* pfrom, const std::string& strCommand, CDataStream& vRecv) EXCLUSIVE_LOCKS_REQUIRED(!cs, !cs_pendingShares);
     bool ProcessNewChainLock(NodeId from, CChainLockSig& clsig, BlockValidationState& state, const uint256& hash, const uint256& idIn = uint256()) EXCLUSIVE_LOCKS_REQUIRED(!cs);
     void NotifyHeaderTip(const CBlockIndex* pindexNew) EXCLUSIVE_LOCKS_REQUIRED(!cs);
     void UpdatedBlockTip(const CBlockIndex* pindexNew, bool fInitialDownload);
@@ -120,13 +181,23 @@ public:
     bool HasChainLock(int nHeight, const uint256& blockHash) EXCLUSIVE_LOCKS_REQUIRED(!cs);
     bool HasConflictingChainLock(int nHeight, const uint256& blockHash) EXCLUSIVE_LOCKS_REQUIRED(!cs);
     bool VerifyAggregatedChainLock(const CChainLockSig& clsig, const CBlockIndex* pindexScan, const uint256& hash) EXCLUSIVE_LOCKS_REQUIRED(!cs);
+    // SYSCOIN the lane the chainlock tasks run on
+    const CScheduler& GetScheduler() const { return *scheduler; }
 private:
     // these require locks to be held already
     bool InternalHasChainLock(int nHeight, const uint256& blockHash) const EXCLUSIVE_LOCKS_REQUIRED(cs);
     bool InternalHasConflictingChainLock(int nHeight, const uint256& blockHash) const EXCLUSIVE_LOCKS_REQUIRED(cs);
 
     bool TryUpdateBestChainLock(const CBlockIndex* pindex) EXCLUSIVE_LOCKS_REQUIRED(cs);
+    ChainLockHeightEntry* FindHeightEntry(int nHeight) EXCLUSIVE_LOCKS_REQUIRED(cs);
+    // nullptr if the slot of nHeight already holds a higher height
+    ChainLockHeightEntry* GetOrAddHeightEntry(int nHeight) EXCLUSIVE_LOCKS_REQUIRED(cs);
+    void UpdateChainLockedWindow() EXCLUSIVE_LOCKS_REQUIRED(cs);
+    const CBlockIndex* GetChainLockedAncestor(int nHeight) const EXCLUSIVE_LOCKS_REQUIRED(cs);
     bool VerifyChainLockShare(const CChainLockSig& clsig, const CBlockIndex* pindexScan, const uint256& idIn, std::pair<int, CQuorumCPtr>& ret, const uint256& hash) EXCLUSIVE_LOCKS_REQUIRED(!cs);
+    ChainLockQuorumsCPtr GetChainLockQuorums(const CBlockIndex* pindexScan) EXCLUSIVE_LOCKS_REQUIRED(!cs);
+    bool EnqueueChainLockShare(NodeId from, const CChainLockSig& clsig, const uint256& hash) EXCLUSIVE_LOCKS_REQUIRED(!cs_pendingShares);
+    void ProcessPendingChainLockShares() EXCLUSIVE_LOCKS_REQUIRED(!cs, !cs_pendingShares);
     void Cleanup() EXCLUSIVE_LOCKS_REQUIRED(!cs);
 };
 
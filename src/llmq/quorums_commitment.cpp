@@ -68,7 +68,8 @@ bool CFinalCommitment::Verify(const CBlockIndex* pQuorumBaseBlockIndex, bool che
         LogPrint(BCLog::LLMQ, "CFinalCommitment -- q[%s] invalid vvecSig\n", quorumHash.ToString());
         return false;
     }
-    auto members = CLLMQUtils::GetAllQuorumMembers(pQuorumBaseBlockIndex);
+    const auto quorumMembers = CLLMQUtils::GetAllQuorumMembers(pQuorumBaseBlockIndex);
+    const auto& members = *quorumMembers;
     if (LogAcceptCategory(BCLog::LLMQ, BCLog::Level::Debug)) {
         std::stringstream ss;
         std::stringstream ss2;
@@ -109,14 +110,21 @@ bool CFinalCommitment::Verify(const CBlockIndex* pQuorumBaseBlockIndex, bool che
             memberPubKeys.emplace_back(members[i]->pdmnState->pubKeyOperator.Get());
         }
 
-        if (!membersSig.VerifySecureAggregated(memberPubKeys, commitmentHash)) {
-            LogPrint(BCLog::LLMQ, "CFinalCommitment -- q[%s] invalid aggregated members signature\n", quorumHash.ToString());
-            return false;
-        }
+        // SYSCOIN both signatures are over the commitment hash, so they are checked in one randomized batch sharing
+        // the pairing with the hash. Only if that fails they are checked on their own to tell which one is invalid
+        std::vector<CBLSSignature> sigs{membersSig, quorumSig};
+        std::vector<CBLSPublicKey> pubKeys{CBLSPublicKey::AggregateSecure(memberPubKeys), quorumPublicKey};
+        std::vector<uint256> hashes(sigs.size(), commitmentHash);
+        if (!pubKeys[0].IsValid() || !CBLSSignature::VerifyBatchRandomized(sigs, pubKeys, hashes)) {
+            if (!membersSig.VerifySecureAggregated(memberPubKeys, commitmentHash)) {
+                LogPrint(BCLog::LLMQ, "CFinalCommitment -- q[%s] invalid aggregated members signature\n", quorumHash.ToString());
+                return false;
+            }
 
-        if (!quorumSig.VerifyInsecure(quorumPublicKey, commitmentHash)) {
-            LogPrint(BCLog::LLMQ, "CFinalCommitment -- q[%s] invalid quorum signature\n", quorumHash.ToString());
-            return false;
+            if (!quorumSig.VerifyInsecure(quorumPublicKey, commitmentHash)) {
+                LogPrint(BCLog::LLMQ, "CFinalCommitment -- q[%s] invalid quorum signature\n", quorumHash.ToString());
+                return false;
+            }
         }
     }
 
@@ -7,6 +7,7 @@
 #include <llmq/quorums_debug.h>
 #include <llmq/quorums_dkgsessionmgr.h>
 #include <llmq/quorums_utils.h>
+#include <bls/bls_batchverifier.h>
 #include <evo/deterministicmns.h>
 #include <evo/specialtx.h>
 #include <timedata.h>
@@ -17,6 +18,7 @@
 #include <univalue.h>
 #include <validation.h>
 #include <cxxtimer.hpp>
+#include <future>
 #include <memory>
 #include <net_processing.h>
 
@@ -89,7 +91,7 @@ bool CDKGSession::Init(const CBlockIndex* _pQuorumBaseBlockIndex, const std::vec
     CDKGLogger logger(*this, __func__, __LINE__);
     const auto& params = Params().GetConsensus().llmqTypeChainLocks;
     if (mns.size() < (size_t)params.minSize) {
-        logger.Batch("not enough members (%d < %d), aborting init", mns.size(), (size_t)params.minSize);
+        LogBatch(logger, "not enough members (%d < %d), aborting init", mns.size(), (size_t)params.minSize);
         return false;
     }
 
@@ -101,14 +103,14 @@ bool CDKGSession::Init(const CBlockIndex* _pQuorumBaseBlockIndex, const std::vec
             for (const auto& r : relayMembers) {
                 ss << r.ToString().substr(0, 4) << " | ";
             }
-            logger.Batch("forMember[%s] relayMembers[%s]", myProTxHash.ToString().substr(0, 4), ss.str());
+            LogBatch(logger, "forMember[%s] relayMembers[%s]", myProTxHash.ToString().substr(0, 4), ss.str());
         }
     }
 
     if (myProTxHash.IsNull()) {
-        logger.Batch("initialized as observer. mns=%d", mns.size());
+        LogBatch(logger, "initialized as observer. mns=%d", mns.size());
     } else {
-        logger.Batch("initialized as member. mns=%d", mns.size());
+        LogBatch(logger, "initialized as member. mns=%d", mns.size());
     }
 
     return true;
@@ -123,13 +125,13 @@ void CDKGSession::Contribute(CDKGPendingMessages& pendingMessages)
     }
     const auto& params = Params().GetConsensus().llmqTypeChainLocks;
     cxxtimer::Timer t1(true);
-    logger.Batch("generating contributions");
+    LogBatch(logger, "generating contributions");
     if (!blsWorker.GenerateContributions((size_t)params.threshold, memberIds, vvecContribution, skContributions)) {
         // this should never happen actually
-        logger.Batch("GenerateContributions failed");
+        LogBatch(logger, "GenerateContributions failed");
         return;
     }
-    logger.Batch("generated contributions. time=%d", t1.count());
+    LogBatch(logger, "generated contributions. time=%d", t1.count());
     logger.Flush();
 
     SendContributions(pendingMessages);
@@ -141,10 +143,10 @@ void CDKGSession::SendContributions(CDKGPendingMessages& pendingMessages)
 
     assert(AreWeMember());
 
-    logger.Batch("sending contributions");
+    LogBatch(logger, "sending contributions");
 
     if (ShouldSimulateError(DKGError::type::CONTRIBUTION_OMIT)) {
-        logger.Batch("omitting");
+        LogBatch(logger, "omitting");
         return;
     }
 
@@ -162,17 +164,17 @@ void CDKGSession::SendContributions(CDKGPendingMessages& pendingMessages)
         CBLSSecretKey skContrib = skContributions[i];
 
         if (i != myIdx && ShouldSimulateError(DKGError::type::CONTRIBUTION_LIE)) {
-            logger.Batch("lying for %s", m->dmn->proTxHash.ToString());
+            LogBatch(logger, "lying for %s", m->dmn->proTxHash.ToString());
             skContrib.MakeNewKey();
         }
 
         if (!qc.contributions->Encrypt(i, m->dmn->pdmnState->pubKeyOperator.Get(), skContrib, PROTOCOL_VERSION)) {
-            logger.Batch("failed to encrypt contribution for %s", m->dmn->proTxHash.ToString());
+            LogBatch(logger, "failed to encrypt contribution for %s", m->dmn->proTxHash.ToString());
             return;
         }
     }
 
-    logger.Batch("encrypted contributions. time=%d", t1.count());
+    LogBatch(logger, "encrypted contributions. time=%d", t1.count());
 
     qc.sig = WITH_LOCK(activeMasternodeInfoCs, return activeMasternodeInfo.blsKeyOperator->Sign(qc.GetSignHash(), m_use_legacy_bls));
 
@@ -194,31 +196,31 @@ bool CDKGSession::PreVerifyMessage(const CDKGContribution& qc, bool& retBan) con
     retBan = false;
 
     if (qc.quorumHash != m_quorum_base_block_index->GetBlockHash()) {
-        logger.Batch("contribution for wrong quorum, rejecting");
+        LogBatch(logger, "contribution for wrong quorum, rejecting");
         return false;
     }
 
     auto* member = GetMember(qc.proTxHash);
     if (member == nullptr) {
-        logger.Batch("contributor not a member of this quorum, rejecting contribution");
+        LogBatch(logger, "contributor not a member of this quorum, rejecting contribution");
         retBan = true;
         return false;
     }
 
     if (qc.contributions->blobs.size() != members.size()) {
-        logger.Batch("invalid contributions count");
+        LogBatch(logger, "invalid contributions count");
         retBan = true;
         return false;
     }
     const auto& params = Params().GetConsensus().llmqTypeChainLocks;
     if (qc.vvec->size() != size_t(params.threshold)) {
-        logger.Batch("invalid verification vector length");
+        LogBatch(logger, "invalid verification vector length");
         retBan = true;
         return false;
     }
 
     if (!blsWorker.VerifyVerificationVector(*qc.vvec)) {
-        logger.Batch("invalid verification vector");
+        LogBatch(logger, "invalid verification vector");
         retBan = true;
         return false;
     }
@@ -227,7 +229,7 @@ bool CDKGSession::PreVerifyMessage(const CDKGContribution& qc, bool& retBan) con
         // don't do any further processing if we got more than 1 valid contributions already
         // this is a DoS protection against members sending multiple contributions with valid signatures to us
         // we must bail out before any expensive BLS verification happens
-        logger.Batch("dropping contribution from %s as we already got %d contributions", member->dmn->proTxHash.ToString(), member->contributions.size());
+        LogBatch(logger, "dropping contribution from %s as we already got %d contributions", member->dmn->proTxHash.ToString(), member->contributions.size());
         return false;
     }
 
@@ -241,7 +243,7 @@ void CDKGSession::ReceiveMessage(const uint256& hash, const CDKGContribution& qc
     auto* member = GetMember(qc.proTxHash);
 
     cxxtimer::Timer t1(true);
-    logger.Batch("received contribution from %s", qc.proTxHash.ToString());
+    LogBatch(logger, "received contribution from %s", qc.proTxHash.ToString());
 
     // relay, no matter if further verification fails
     // This ensures the whole quorum sees the bad behavior
@@ -266,7 +268,7 @@ void CDKGSession::ReceiveMessage(const uint256& hash, const CDKGContribution& qc
         // don't do any further processing if we got more than 1 contribution. we already relayed it,
         // so others know about his bad behavior
         MarkBadMember(member->idx);
-        logger.Batch("%s did send multiple contributions", member->dmn->proTxHash.ToString());
+        LogBatch(logger, "%s did send multiple contributions", member->dmn->proTxHash.ToString());
         return;
     }
 
@@ -274,7 +276,7 @@ void CDKGSession::ReceiveMessage(const uint256& hash, const CDKGContribution& qc
 
     int receivedCount = ranges::count_if(members, [](const auto& m){return !m->contributions.empty();});
 
-    logger.Batch("received and relayed contribution. received=%d/%d, time=%d", receivedCount, members.size(), t1.count());
+    LogBatch(logger, "received and relayed contribution. received=%d/%d, time=%d", receivedCount, members.size(), t1.count());
 
     cxxtimer::Timer t2(true);
 
@@ -288,10 +290,10 @@ void CDKGSession::ReceiveMessage(const uint256& hash, const CDKGContribution& qc
     bool complain = false;
     CBLSSecretKey skContribution;
     if (!qc.contributions->Decrypt(*myIdx, WITH_LOCK(activeMasternodeInfoCs, return *activeMasternodeInfo.blsKeyOperator), skContribution, PROTOCOL_VERSION)) {
-        logger.Batch("contribution from %s could not be decrypted", member->dmn->proTxHash.ToString());
+        LogBatch(logger, "contribution from %s could not be decrypted", member->dmn->proTxHash.ToString());
         complain = true;
     } else if (member->idx != myIdx && ShouldSimulateError(DKGError::type::COMPLAIN_LIE)) {
-        logger.Batch("lying/complaining for %s", member->dmn->proTxHash.ToString());
+        LogBatch(logger, "lying/complaining for %s", member->dmn->proTxHash.ToString());
         complain = true;
     }
 
@@ -304,7 +306,7 @@ void CDKGSession::ReceiveMessage(const uint256& hash, const CDKGContribution& qc
         return;
     }
 
-    logger.Batch("decrypted our contribution share. time=%d", t2.count());
+    LogBatch(logger, "decrypted our contribution share. time=%d", t2.count());
 
     receivedSkContributions[member->idx] = skContribution;
     LOCK(cs_pending);
@@ -347,14 +349,14 @@ void CDKGSession::VerifyPendingContributions()
 
     auto result = blsWorker.VerifyContributionShares(myId, vvecs, skContributions);
     if (result.size() != memberIndexes.size()) {
-        logger.Batch("VerifyContributionShares returned result of size %d but size %d was expected, something is wrong", result.size(), memberIndexes.size());
+        LogBatch(logger, "VerifyContributionShares returned result of size %d but size %d was expected, something is wrong", result.size(), memberIndexes.size());
         return;
     }
 
     for (size_t i = 0; i < memberIndexes.size(); i++) {
         if (!result[i]) {
             const auto& m = members[memberIndexes[i]];
-            logger.Batch("invalid contribution from %s. will complain later", m->dmn->proTxHash.ToString());
+            LogBatch(logger, "invalid contribution from %s. will complain later", m->dmn->proTxHash.ToString());
             m->weComplain = true;
             quorumDKGDebugManager->UpdateLocalMemberStatus(m->idx, [&](CDKGDebugMemberStatus& status) {
                 status.statusBits.weComplain = true;
@@ -366,7 +368,7 @@ void CDKGSession::VerifyPendingContributions()
         }
     }
 
-    logger.Batch("verified %d pending contributions. time=%d", pendingContributionVerifications.size(), t1.count());
+    LogBatch(logger, "verified %d pending contributions. time=%d", pendingContributionVerifications.size(), t1.count());
     pendingContributionVerifications.clear();
 }
 
@@ -397,13 +399,13 @@ void CDKGSession::VerifyAndComplain(CDKGPendingMessages& pendingMessages)
             continue;
         }
         if (m->contributions.empty()) {
-            logger.Batch("%s did not send any contribution", m->dmn->proTxHash.ToString());
+            LogBatch(logger, "%s did not send any contribution", m->dmn->proTxHash.ToString());
             MarkBadMember(m->idx);
             continue;
         }
     }
 
-    logger.Batch("verified contributions. time=%d", t1.count());
+    LogBatch(logger, "verified contributions. time=%d", t1.count());
     logger.Flush();
 
     VerifyConnectionAndMinProtoVersions();
@@ -436,16 +438,16 @@ void CDKGSession::VerifyConnectionAndMinProtoVersions() const
         if (auto it = protoMap.find(m->dmn->proTxHash); it == protoMap.end()) {
             m->badConnection = fShouldAllMembersBeConnected;
             if (m->badConnection) {
-                logger.Batch("%s is not connected to us, badConnection=1", m->dmn->proTxHash.ToString());
+                LogBatch(logger, "%s is not connected to us, badConnection=1", m->dmn->proTxHash.ToString());
             }
         } else if (it->second < MIN_MASTERNODE_PROTO_VERSION) {
             m->badConnection = true;
-            logger.Batch("%s does not have min proto version %d (has %d)", m->dmn->proTxHash.ToString(), MIN_MASTERNODE_PROTO_VERSION, it->second);
+            LogBatch(logger, "%s does not have min proto version %d (has %d)", m->dmn->proTxHash.ToString(), MIN_MASTERNODE_PROTO_VERSION, it->second);
         }
 
         if (mmetaman->GetMetaInfo(m->dmn->proTxHash)->OutboundFailedTooManyTimes()) {
             m->badConnection = true;
-            logger.Batch("%s failed to connect to it too many times", m->dmn->proTxHash.ToString());
+            LogBatch(logger, "%s failed to connect to it too many times", m->dmn->proTxHash.ToString());
         }
     }
 }
@@ -476,7 +478,7 @@ void CDKGSession::SendComplaint(CDKGPendingMessages& pendingMessages)
         return;
     }
 
-    logger.Batch("sending complaint. badCount=%d, complaintCount=%d", badCount, complaintCount);
+    LogBatch(logger, "sending complaint. badCount=%d, complaintCount=%d", badCount, complaintCount);
 
     qc.sig = WITH_LOCK(activeMasternodeInfoCs, return activeMasternodeInfo.blsKeyOperator->Sign(qc.GetSignHash(), m_use_legacy_bls));
 
@@ -498,25 +500,25 @@ bool CDKGSession::PreVerifyMessage(const CDKGComplaint& qc, bool& retBan) const
     retBan = false;
 
     if (qc.quorumHash != m_quorum_base_block_index->GetBlockHash()) {
-        logger.Batch("complaint for wrong quorum, rejecting");
+        LogBatch(logger, "complaint for wrong quorum, rejecting");
         return false;
     }
 
     auto* member = GetMember(qc.proTxHash);
     if (member == nullptr) {
-        logger.Batch("complainer not a member of this quorum, rejecting complaint");
+        LogBatch(logger, "complainer not a member of this quorum, rejecting complaint");
         retBan = true;
         return false;
     }
     const auto& params = Params().GetConsensus().llmqTypeChainLocks;
     if (qc.badMembers.size() != (size_t)params.size) {
-        logger.Batch("invalid badMembers bitset size");
+        LogBatch(logger, "invalid badMembers bitset size");
         retBan = true;
         return false;
     }
 
     if (qc.complainForMembers.size() != (size_t)params.size) {
-        logger.Batch("invalid complainForMembers bitset size");
+        LogBatch(logger, "invalid complainForMembers bitset size");
         retBan = true;
         return false;
     }
@@ -525,7 +527,7 @@ bool CDKGSession::PreVerifyMessage(const CDKGComplaint& qc, bool& retBan) const
         // don't do any further processing if we got more than 1 valid complaints already
         // this is a DoS protection against members sending multiple complaints with valid signatures to us
         // we must bail out before any expensive BLS verification happens
-        logger.Batch("dropping complaint from %s as we already got %d complaints",
+        LogBatch(logger, "dropping complaint from %s as we already got %d complaints",
                       member->dmn->proTxHash.ToString(), member->complaints.size());
         return false;
     }
@@ -537,7 +539,7 @@ void CDKGSession::ReceiveMessage(const uint256& hash, const CDKGComplaint& qc)
 {
     CDKGLogger logger(*this, __func__, __LINE__);
 
-    logger.Batch("received complaint from %s", qc.proTxHash.ToString());
+    LogBatch(logger, "received complaint from %s", qc.proTxHash.ToString());
 
     auto* member = GetMember(qc.proTxHash);
 
@@ -561,7 +563,7 @@ void CDKGSession::ReceiveMessage(const uint256& hash, const CDKGComplaint& qc)
         // don't do any further processing if we got more than 1 complaint. we already relayed it,
         // so others know about his bad behavior
         MarkBadMember(member->idx);
-        logger.Batch("%s did send multiple complaints", member->dmn->proTxHash.ToString());
+        LogBatch(logger, "%s did send multiple complaints", member->dmn->proTxHash.ToString());
         return;
     }
 
@@ -569,10 +571,10 @@ void CDKGSession::ReceiveMessage(const uint256& hash, const CDKGComplaint& qc)
     for (size_t i = 0; i < members.size(); i++) {
         const auto& m = members[i];
         if (qc.badMembers[i]) {
-            logger.Batch("%s voted for %s to be bad", member->dmn->proTxHash.ToString(), m->dmn->proTxHash.ToString());
+            LogBatch(logger, "%s voted for %s to be bad", member->dmn->proTxHash.ToString(), m->dmn->proTxHash.ToString());
             m->badMemberVotes.emplace(qc.proTxHash);
             if (AreWeMember() && i == myIdx) {
-                logger.Batch("%s voted for us to be bad", member->dmn->proTxHash.ToString());
+                LogBatch(logger, "%s voted for us to be bad", member->dmn->proTxHash.ToString());
             }
         }
         if (qc.complainForMembers[i]) {
@@ -582,7 +584,7 @@ void CDKGSession::ReceiveMessage(const uint256& hash, const CDKGComplaint& qc)
                 return status.complaintsFromMembers.emplace(member->idx).second;
             });
             if (AreWeMember() && i == myIdx) {
-                logger.Batch("%s complained about us", member->dmn->proTxHash.ToString());
+                LogBatch(logger, "%s complained about us", member->dmn->proTxHash.ToString());
             }
         }
         if (!m->complaints.empty()) {
@@ -590,7 +592,7 @@ void CDKGSession::ReceiveMessage(const uint256& hash, const CDKGComplaint& qc)
         }
     }
 
-    logger.Batch("received and relayed complaint. received=%d", receivedCount);
+    LogBatch(logger, "received and relayed complaint. received=%d", receivedCount);
 }
 
 void CDKGSession::VerifyAndJustify(CDKGPendingMessages& pendingMessages)
@@ -601,6 +603,7 @@ void CDKGSession::VerifyAndJustify(CDKGPendingMessages& pendingMessages)
 
     CDKGLogger logger(*this, __func__, __LINE__);
 
+    cxxtimer::Timer t1(true);
     std::set<uint256> justifyFor;
     const auto& params = Params().GetConsensus().llmqTypeChainLocks;
     for (const auto& m : members) {
@@ -608,7 +611,7 @@ void CDKGSession::VerifyAndJustify(CDKGPendingMessages& pendingMessages)
             continue;
         }
         if (m->badMemberVotes.size() >= size_t(params.dkgBadVotesThreshold)) {
-            logger.Batch("%s marked as bad as %d other members voted for this", m->dmn->proTxHash.ToString(), m->badMemberVotes.size());
+            LogBatch(logger, "%s marked as bad as %d other members voted for this", m->dmn->proTxHash.ToString(), m->badMemberVotes.size());
             MarkBadMember(m->idx);
             continue;
         }
@@ -616,7 +619,7 @@ void CDKGSession::VerifyAndJustify(CDKGPendingMessages& pendingMessages)
             continue;
         }
         if (m->complaints.size() != 1) {
-            logger.Batch("%s sent multiple complaints", m->dmn->proTxHash.ToString());
+            LogBatch(logger, "%s sent multiple complaints", m->dmn->proTxHash.ToString());
             MarkBadMember(m->idx);
             continue;
         }
@@ -627,7 +630,9 @@ void CDKGSession::VerifyAndJustify(CDKGPendingMessages& pendingMessages)
             justifyFor.emplace(qc.proTxHash);
         }
     }
+    t1.stop();
 
+    LogBatch(logger, "verified complaints. justifyFor=%d, time=%d", justifyFor.size(), t1.count());
     logger.Flush();
     if (!justifyFor.empty()) {
         SendJustification(pendingMessages, justifyFor);
@@ -640,7 +645,7 @@ void CDKGSession::SendJustification(CDKGPendingMessages& pendingMessages, const
 
     assert(AreWeMember());
 
-    logger.Batch("sending justification for %d members", forMembers.size());
+    LogBatch(logger, "sending justification for %d members", forMembers.size());
 
     CDKGJustification qj;
     qj.quorumHash = m_quorum_base_block_index->GetBlockHash();
@@ -652,12 +657,12 @@ void CDKGSession::SendJustification(CDKGPendingMessages& pendingMessages, const
         if (forMembers.count(m->dmn->proTxHash) == 0) {
             continue;
         }
-        logger.Batch("justifying for %s", m->dmn->proTxHash.ToString());
+        LogBatch(logger, "justifying for %s", m->dmn->proTxHash.ToString());
 
         CBLSSecretKey skContribution = skContributions[i];
 
         if (i != myIdx && ShouldSimulateError(DKGError::type::JUSTIFY_LIE)) {
-            logger.Batch("lying for %s", m->dmn->proTxHash.ToString());
+            LogBatch(logger, "lying for %s", m->dmn->proTxHash.ToString());
             skContribution.MakeNewKey();
         }
 
@@ -665,7 +670,7 @@ void CDKGSession::SendJustification(CDKGPendingMessages& pendingMessages, const
     }
 
     if (ShouldSimulateError(DKGError::type::JUSTIFY_OMIT)) {
-        logger.Batch("omitting");
+        LogBatch(logger, "omitting");
         return;
     }
 
@@ -689,19 +694,19 @@ bool CDKGSession::PreVerifyMessage(const CDKGJustification& qj, bool& retBan) co
     retBan = false;
 
     if (qj.quorumHash != m_quorum_base_block_index->GetBlockHash()) {
-        logger.Batch("justification for wrong quorum, rejecting");
+        LogBatch(logger, "justification for wrong quorum, rejecting");
         return false;
     }
 
     auto* member = GetMember(qj.proTxHash);
     if (member == nullptr) {
-        logger.Batch("justifier not a member of this quorum, rejecting justification");
+        LogBatch(logger, "justifier not a member of this quorum, rejecting justification");
         retBan = true;
         return false;
     }
 
     if (qj.contributions.empty()) {
-        logger.Batch("justification with no contributions");
+        LogBatch(logger, "justification with no contributions");
         retBan = true;
         return false;
     }
@@ -709,20 +714,20 @@ bool CDKGSession::PreVerifyMessage(const CDKGJustification& qj, bool& retBan) co
     std::set<size_t> contributionsSet;
     for (const auto& p : qj.contributions) {
         if (p.index > members.size()) {
-            logger.Batch("invalid contribution index");
+            LogBatch(logger, "invalid contribution index");
             retBan = true;
             return false;
         }
 
         if (!contributionsSet.emplace(p.index).second) {
-            logger.Batch("duplicate contribution index");
+            LogBatch(logger, "duplicate contribution index");
             retBan = true;
             return false;
         }
 
         const auto& skShare = p.key;
         if (!skShare.IsValid()) {
-            logger.Batch("invalid contribution");
+            LogBatch(logger, "invalid contribution");
             retBan = true;
             return false;
         }
@@ -732,7 +737,7 @@ bool CDKGSession::PreVerifyMessage(const CDKGJustification& qj, bool& retBan) co
         // don't do any further processing if we got more than 1 valid justification already
         // this is a DoS protection against members sending multiple justifications with valid signatures to us
         // we must bail out before any expensive BLS verification happens
-        logger.Batch("dropping justification from %s as we already got %d justifications",
+        LogBatch(logger, "dropping justification from %s as we already got %d justifications",
                       member->dmn->proTxHash.ToString(), member->justifications.size());
         return false;
     }
@@ -744,7 +749,7 @@ void CDKGSession::ReceiveMessage(const uint256& hash, const CDKGJustification& q
 {
     CDKGLogger logger(*this, __func__, __LINE__);
 
-    logger.Batch("received justification from %s", qj.proTxHash.ToString());
+    LogBatch(logger, "received justification from %s", qj.proTxHash.ToString());
 
     auto* member = GetMember(qj.proTxHash);
 
@@ -768,7 +773,7 @@ void CDKGSession::ReceiveMessage(const uint256& hash, const CDKGJustification& q
     if (member->justifications.size() > 1) {
         // don't do any further processing if we got more than 1 justification. we already relayed it,
         // so others know about his bad behavior
-        logger.Batch("%s did send multiple justifications", member->dmn->proTxHash.ToString());
+        LogBatch(logger, "%s did send multiple justifications", member->dmn->proTxHash.ToString());
         MarkBadMember(member->idx);
         return;
     }
@@ -783,7 +788,7 @@ void CDKGSession::ReceiveMessage(const uint256& hash, const CDKGJustification& q
         const auto& member2 = members[p.index];
 
         if (member->complaintsFromOthers.count(member2->dmn->proTxHash) == 0) {
-            logger.Batch("got justification from %s for %s even though he didn't complain",
+            LogBatch(logger, "got justification from %s for %s even though he didn't complain",
                             member->dmn->proTxHash.ToString(), member2->dmn->proTxHash.ToString());
             MarkBadMember(member->idx);
         }
@@ -807,10 +812,10 @@ void CDKGSession::ReceiveMessage(const uint256& hash, const CDKGJustification& q
 
         bool result = (resultIt++)->get();
         if (!result) {
-            logger.Batch("  %s did send an invalid justification for %s", member->dmn->proTxHash.ToString(), member2->dmn->proTxHash.ToString());
+            LogBatch(logger, "  %s did send an invalid justification for %s", member->dmn->proTxHash.ToString(), member2->dmn->proTxHash.ToString());
             MarkBadMember(member->idx);
         } else {
-            logger.Batch("  %s justified for %s", member->dmn->proTxHash.ToString(), member2->dmn->proTxHash.ToString());
+            LogBatch(logger, "  %s justified for %s", member->dmn->proTxHash.ToString(), member2->dmn->proTxHash.ToString());
             if (AreWeMember() && member2->id == myId) {
                 receivedSkContributions[member->idx] = skContribution;
                 member->weComplain = false;
@@ -828,7 +833,7 @@ void CDKGSession::ReceiveMessage(const uint256& hash, const CDKGJustification& q
         return m->someoneComplain;
     });
 
-    logger.Batch("verified justification: received=%d/%d time=%d", receivedCount, expectedCount, t1.count());
+    LogBatch(logger, "verified justification: received=%d/%d time=%d", receivedCount, expectedCount, t1.count());
 }
 
 void CDKGSession::VerifyAndCommit(CDKGPendingMessages& pendingMessages)
@@ -856,18 +861,18 @@ void CDKGSession::VerifyAndCommit(CDKGPendingMessages& pendingMessages)
     }
 
     if (!badMembers.empty() || !openComplaintMembers.empty()) {
-        logger.Batch("verification result:");
+        LogBatch(logger, "verification result:");
     }
     if (!badMembers.empty()) {
-        logger.Batch("  members previously determined as bad:");
+        LogBatch(logger, "  members previously determined as bad:");
         for (const auto& idx : badMembers) {
-            logger.Batch("    %s", members[idx]->dmn->proTxHash.ToString());
+            LogBatch(logger, "    %s", members[idx]->dmn->proTxHash.ToString());
         }
     }
     if (!openComplaintMembers.empty()) {
-        logger.Batch("  members with open complaints and now marked as bad:");
+        LogBatch(logger, "  members with open complaints and now marked as bad:");
         for (const auto& idx : openComplaintMembers) {
-            logger.Batch("    %s", members[idx]->dmn->proTxHash.ToString());
+            LogBatch(logger, "    %s", members[idx]->dmn->proTxHash.ToString());
         }
     }
 
@@ -882,7 +887,7 @@ void CDKGSession::SendCommitment(CDKGPendingMessages& pendingMessages)
 
     assert(AreWeMember());
 
-    logger.Batch("sending commitment");
+    LogBatch(logger, "sending commitment");
 
     CDKGPrematureCommitment qc(Params().GetConsensus().llmqTypeChainLocks.size);
     qc.quorumHash = m_quorum_base_block_index->GetBlockHash();
@@ -896,12 +901,12 @@ void CDKGSession::SendCommitment(CDKGPendingMessages& pendingMessages)
     }
     const auto& params = Params().GetConsensus().llmqTypeChainLocks;
     if (qc.CountValidMembers() < params.minSize) {
-        logger.Batch("not enough valid members. not sending commitment");
+        LogBatch(logger, "not enough valid members. not sending commitment");
         return;
     }
 
     if (ShouldSimulateError(DKGError::type::COMMIT_OMIT)) {
-        logger.Batch("omitting");
+        LogBatch(logger, "omitting");
         return;
     }
 
@@ -912,13 +917,13 @@ void CDKGSession::SendCommitment(CDKGPendingMessages& pendingMessages)
     std::vector<BLSVerificationVectorPtr> vvecs;
     std::vector<CBLSSecretKey> skContributions;
     if (!dkgManager.GetVerifiedContributions(m_quorum_base_block_index, qc.validMembers, memberIndexes, vvecs, skContributions)) {
-        logger.Batch("failed to get valid contributions");
+        LogBatch(logger, "failed to get valid contributions");
         return;
     }
 
     BLSVerificationVectorPtr vvec = cache.BuildQuorumVerificationVector(::SerializeHash(memberIndexes), vvecs);
     if (vvec == nullptr) {
-        logger.Batch("failed to build quorum verification vector");
+        LogBatch(logger, "failed to build quorum verification vector");
         return;
     }
     t1.stop();
@@ -926,12 +931,12 @@ void CDKGSession::SendCommitment(CDKGPendingMessages& pendingMessages)
     cxxtimer::Timer t2(true);
     CBLSSecretKey skShare = cache.AggregateSecretKeys(::SerializeHash(memberIndexes), skContributions);
     if (!skShare.IsValid()) {
-        logger.Batch("failed to build own secret share");
+        LogBatch(logger, "failed to build own secret share");
         return;
     }
     t2.stop();
 
-    logger.Batch("pubKeyShare=%s", skShare.GetPublicKey().ToString());
+    LogBatch(logger, "pubKeyShare=%s", skShare.GetPublicKey().ToString());
 
     cxxtimer::Timer t3(true);
     qc.quorumPublicKey = (*vvec)[0];
@@ -940,7 +945,7 @@ void CDKGSession::SendCommitment(CDKGPendingMessages& pendingMessages)
     int lieType = -1;
     if (ShouldSimulateError(DKGError::type::COMMIT_LIE)) {
         lieType = GetRand(5);
-        logger.Batch("lying on commitment. lieType=%d", lieType);
+        LogBatch(logger, "lying on commitment. lieType=%d", lieType);
     }
 
     if (lieType == 0) {
@@ -973,7 +978,7 @@ void CDKGSession::SendCommitment(CDKGPendingMessages& pendingMessages)
     t3.stop();
     timerTotal.stop();
 
-    logger.Batch("built premature commitment. time1=%d, time2=%d, time3=%d, totalTime=%d",
+    LogBatch(logger, "built premature commitment. time1=%d, time2=%d, time3=%d, totalTime=%d",
                     t1.count(), t2.count(), t3.count(), timerTotal.count());
 
 
@@ -995,35 +1000,35 @@ bool CDKGSession::PreVerifyMessage(const CDKGPrematureCommitment& qc, bool& retB
     retBan = false;
 
     if (qc.quorumHash != m_quorum_base_block_index->GetBlockHash()) {
-        logger.Batch("commitment for wrong quorum, rejecting");
+        LogBatch(logger, "commitment for wrong quorum, rejecting");
         return false;
     }
 
     auto* member = GetMember(qc.proTxHash);
     if (member == nullptr) {
-        logger.Batch("committer not a member of this quorum, rejecting premature commitment");
+        LogBatch(logger, "committer not a member of this quorum, rejecting premature commitment");
         retBan = true;
         return false;
     }
     const auto& params = Params().GetConsensus().llmqTypeChainLocks;
     if (qc.validMembers.size() != (size_t)params.size) {
-        logger.Batch("invalid validMembers bitset size");
+        LogBatch(logger, "invalid validMembers bitset size");
         retBan = true;
         return false;
     }
 
     if (qc.CountValidMembers() < params.minSize) {
-        logger.Batch("invalid validMembers count. validMembersCount=%d", qc.CountValidMembers());
+        LogBatch(logger, "invalid validMembers count. validMembersCount=%d", qc.CountValidMembers());
         retBan = true;
         return false;
     }
     if (!qc.sig.IsValid()) {
-        logger.Batch("invalid membersSig");
+        LogBatch(logger, "invalid membersSig");
         retBan = true;
         return false;
     }
     if (!qc.quorumSig.IsValid()) {
-        logger.Batch("invalid quorumSig");
+        LogBatch(logger, "invalid quorumSig");
         retBan = true;
         return false;
     }
@@ -1032,7 +1037,7 @@ bool CDKGSession::PreVerifyMessage(const CDKGPrematureCommitment& qc, bool& retB
         // cppcheck-suppress useStlAlgorithm
         if (qc.validMembers[i]) {
             retBan = true;
-            logger.Batch("invalid validMembers bitset. bit %d should not be set", i);
+            LogBatch(logger, "invalid validMembers bitset. bit %d should not be set", i);
             return false;
         }
     }
@@ -1041,7 +1046,7 @@ bool CDKGSession::PreVerifyMessage(const CDKGPrematureCommitment& qc, bool& retB
         // don't do any further processing if we got more than 1 valid commitment already
         // this is a DoS protection against members sending multiple commitments with valid signatures to us
         // we must bail out before any expensive BLS verification happens
-        logger.Batch("dropping commitment from %s as we already got %d commitments",
+        LogBatch(logger, "dropping commitment from %s as we already got %d commitments",
                       member->dmn->proTxHash.ToString(), member->prematureCommitments.size());
         return false;
     }
@@ -1055,7 +1060,7 @@ void CDKGSession::ReceiveMessage(const uint256& hash, const CDKGPrematureCommitm
 
     cxxtimer::Timer t1(true);
 
-    logger.Batch("received premature commitment from %s. validMembers=%d", qc.proTxHash.ToString(), qc.CountValidMembers());
+    LogBatch(logger, "received premature commitment from %s. validMembers=%d", qc.proTxHash.ToString(), qc.CountValidMembers());
 
     auto* member = GetMember(qc.proTxHash);
 
@@ -1068,44 +1073,26 @@ void CDKGSession::ReceiveMessage(const uint256& hash, const CDKGPrematureCommitm
         member->prematureCommitments.emplace(hash);
     }
 
-    std::vector<uint16_t> memberIndexes;
-    std::vector<BLSVerificationVectorPtr> vvecs;
-    std::vector<CBLSSecretKey> skContributions;
-    BLSVerificationVectorPtr quorumVvec;
-    if (dkgManager.GetVerifiedContributions(m_quorum_base_block_index, qc.validMembers, memberIndexes, vvecs, skContributions)) {
-        quorumVvec = cache.BuildQuorumVerificationVector(::SerializeHash(memberIndexes), vvecs);
+    PrematureCommitmentCheck check;
+    if (auto it = prematureCommitmentChecks.find(hash); it != prematureCommitmentChecks.end()) {
+        check = std::move(it->second);
+        prematureCommitmentChecks.erase(it);
+    } else {
+        std::vector<uint16_t> memberIndexes;
+        const auto quorumVvec = BuildQuorumVvec(qc, memberIndexes);
+        check = CheckPrematureCommitment(qc, memberIndexes, quorumVvec);
     }
 
-    if (quorumVvec == nullptr) {
-        logger.Batch("failed to build quorum verification vector. skipping full verification");
+    if (!check.fHaveVvec) {
+        LogBatch(logger, "failed to build quorum verification vector. skipping full verification");
         // we might be the unlucky one who didn't receive all contributions, but we still have to relay
         // the premature commitment as others might be luckier
-    } else {
-        // we got all information that is needed to verify everything (even though we might not be a member of the quorum)
-        // if any of this verification fails, we won't relay this message. This ensures that invalid messages are lost
-        // in the network. Nodes relaying such invalid messages to us are not punished as they might have not known
-        // all contributions. We only handle up to 2 commitments per member, so a DoS shouldn't be possible
-
-        if ((*quorumVvec)[0] != qc.quorumPublicKey) {
-            logger.Batch("calculated quorum public key does not match");
-            return;
-        }
-        uint256 vvecHash = ::SerializeHash(*quorumVvec);
-        if (qc.quorumVvecHash != vvecHash) {
-            logger.Batch("calculated quorum vvec hash does not match");
-            return;
-        }
-
-        CBLSPublicKey pubKeyShare = cache.BuildPubKeyShare(::SerializeHash(std::make_pair(memberIndexes, member->id)), quorumVvec, member->id);
-        if (!pubKeyShare.IsValid()) {
-            logger.Batch("failed to calculate public key share");
-            return;
-        }
-
-        if (!qc.quorumSig.VerifyInsecure(pubKeyShare, qc.GetSignHash())) {
-            logger.Batch("failed to verify quorumSig");
-            return;
-        }
+    } else if (!check.fValid) {
+        // if any of the full verification fails, we won't relay this message. This ensures that invalid messages are
+        // lost in the network. Nodes relaying such invalid messages to us are not punished as they might have not
+        // known all contributions. We only handle up to 2 commitments per member, so a DoS shouldn't be possible
+        LogBatch(logger, "%s", check.strError);
+        return;
     }
 
     WITH_LOCK(invCs, validCommitments.emplace(hash));
@@ -1122,7 +1109,110 @@ void CDKGSession::ReceiveMessage(const uint256& hash, const CDKGPrematureCommitm
 
     t1.stop();
 
-    logger.Batch("verified premature commitment. received=%d/%d, time=%d", receivedCount, members.size(), t1.count());
+    LogBatch(logger, "verified premature commitment. received=%d/%d, time=%d", receivedCount, members.size(), t1.count());
+}
+
+BLSVerificationVectorPtr CDKGSession::BuildQuorumVvec(const CDKGPrematureCommitment& qc, std::vector<uint16_t>& memberIndexes)
+{
+    std::vector<BLSVerificationVectorPtr> vvecs;
+    std::vector<CBLSSecretKey> skContributions;
+    if (!dkgManager.GetVerifiedContributions(m_quorum_base_block_index, qc.validMembers, memberIndexes, vvecs, skContributions)) {
+        return nullptr;
+    }
+    return cache.BuildQuorumVerificationVector(::SerializeHash(memberIndexes), vvecs);
+}
+
+CDKGSession::PrematureCommitmentCheck CDKGSession::CheckPrematureCommitment(const CDKGPrematureCommitment& qc, const std::vector<uint16_t>& memberIndexes,
+                                                                            const BLSVerificationVectorPtr& quorumVvec, CBLSPublicKey* pubKeyShareRet)
+{
+    PrematureCommitmentCheck ret;
+
+    if (quorumVvec == nullptr) {
+        return ret;
+    }
+    // we got all information that is needed to verify everything (even though we might not be a member of the quorum)
+    ret.fHaveVvec = true;
+
+    if ((*quorumVvec)[0] != qc.quorumPublicKey) {
+        ret.strError = "calculated quorum public key does not match";
+        return ret;
+    }
+    uint256 vvecHash = ::SerializeHash(*quorumVvec);
+    if (qc.quorumVvecHash != vvecHash) {
+        ret.strError = "calculated quorum vvec hash does not match";
+        return ret;
+    }
+
+    const auto* member = GetMember(qc.proTxHash);
+    CBLSPublicKey pubKeyShare = cache.BuildPubKeyShare(::SerializeHash(std::make_pair(memberIndexes, member->id)), quorumVvec, member->id);
+    if (!pubKeyShare.IsValid()) {
+        ret.strError = "failed to calculate public key share";
+        return ret;
+    }
+    if (pubKeyShareRet != nullptr) {
+        // the caller verifies the quorumSig
+        *pubKeyShareRet = pubKeyShare;
+        ret.fValid = true;
+        return ret;
+    }
+
+    if (!qc.quorumSig.VerifyInsecure(pubKeyShare, qc.GetSignHash())) {
+        ret.strError = "failed to verify quorumSig";
+        return ret;
+    }
+    ret.fValid = true;
+    return ret;
+}
+
+void CDKGSession::VerifyPrematureCommitments(const std::vector<std::pair<uint256, const CDKGPrematureCommitment*>>& qcs)
+{
+    CDKGLogger logger(*this, __func__, __LINE__);
+
+    cxxtimer::Timer t1(true);
+    // quorum vvecs are built up front, building one already spreads over the BLS worker and must not run inside a
+    // task on it. Usually all commitments share the same one
+    std::vector<std::vector<uint16_t>> memberIndexes(qcs.size());
+    std::vector<BLSVerificationVectorPtr> quorumVvecs(qcs.size());
+    for (size_t i = 0; i < qcs.size(); i++) {
+        quorumVvecs[i] = BuildQuorumVvec(*qcs[i].second, memberIndexes[i]);
+    }
+    std::vector<PrematureCommitmentCheck> results(qcs.size());
+    std::vector<CBLSPublicKey> pubKeyShares(qcs.size());
+    std::vector<std::future<void>> futures;
+    futures.reserve(qcs.size());
+    for (size_t i = 0; i < qcs.size(); i++) {
+        // watch out to not bail out before these async calls finish (they rely on valid references)
+        futures.emplace_back(blsWorker.AsyncRun([this, &qcs, &memberIndexes, &quorumVvecs, &results, &pubKeyShares, i]() {
+            results[i] = CheckPrematureCommitment(*qcs[i].second, memberIndexes[i], quorumVvecs[i], &pubKeyShares[i]);
+        }));
+    }
+    for (auto& f : futures) {
+        f.get();
+    }
+
+    // the quorum sigs are then checked in one batch with each commitment as its own source, so invalid ones are
+    // found by bisecting. The public key shares can't be crafted, but two members could still send signatures that
+    // cancel each other out in an insecure aggregation, so the randomized secure form is used
+    CBLSBatchVerifier<uint256, uint256> batchVerifier(true, false);
+    for (size_t i = 0; i < qcs.size(); i++) {
+        if (results[i].fValid) {
+            const auto& qc = *qcs[i].second;
+            batchVerifier.PushMessage(qcs[i].first, qcs[i].first, qc.GetSignHash(), qc.quorumSig, pubKeyShares[i]);
+        }
+    }
+    batchVerifier.Verify();
+    for (size_t i = 0; i < qcs.size(); i++) {
+        if (batchVerifier.badSources.count(qcs[i].first)) {
+            results[i].fValid = false;
+            results[i].strError = "failed to verify quorumSig";
+        }
+    }
+    for (size_t i = 0; i < qcs.size(); i++) {
+        prematureCommitmentChecks.insert_or_assign(qcs[i].first, std::move(results[i]));
+    }
+    t1.stop();
+
+    LogBatch(logger, "verified %d premature commitments. time=%d", qcs.size(), t1.count());
 }
 
 std::vector<CFinalCommitment> CDKGSession::FinalizeCommitments()
@@ -1157,7 +1247,25 @@ std::vector<CFinalCommitment> CDKGSession::FinalizeCommitments()
         }
     }
 
-    std::vector<CFinalCommitment> finalCommitments;
+    cxxtimer::Timer timerTotal(true);
+
+    // SYSCOIN build all candidates first, the BLS work for them runs as parallel tasks on the BLS worker below
+    struct Finalization {
+        CFinalCommitment fqc;
+        uint256 commitmentHash;
+        std::vector<CBLSSignature> aggSigs;
+        std::vector<CBLSPublicKey> aggPks;
+        std::vector<CBLSId> signerIds;
+        std::vector<CBLSSignature> thresholdSigs;
+        bool fRecovered{false};
+        bool fVerified{false};
+        int64_t nAggregateTime{0};
+        int64_t nRecoverTime{0};
+        int64_t nVerifyTime{0};
+
+        explicit Finalization(const uint256& quorumHash) : fqc(quorumHash) {}
+    };
+    std::vector<Finalization> finalizations;
     for (const auto& p : commitmentsMap) {
         const auto& cvec = p.second;
         if (cvec.size() < size_t(params.minSize)) {
@@ -1165,12 +1273,10 @@ std::vector<CFinalCommitment> CDKGSession::FinalizeCommitments()
             continue;
         }
 
-        std::vector<CBLSId> signerIds;
-        std::vector<CBLSSignature> thresholdSigs;
-
         const auto& first = cvec[0];
 
-        CFinalCommitment fqc(first.quorumHash);
+        auto& f = finalizations.emplace_back(first.quorumHash);
+        auto& fqc = f.fqc;
         fqc.validMembers = first.validMembers;
         fqc.quorumPublicKey = first.quorumPublicKey;
         fqc.quorumVvecHash = first.quorumVvecHash;
@@ -1178,16 +1284,14 @@ std::vector<CFinalCommitment> CDKGSession::FinalizeCommitments()
         
         fqc.nVersion = CFinalCommitment::GetVersion(!m_use_legacy_bls);
 
-        uint256 commitmentHash = BuildCommitmentHash(fqc.quorumHash, fqc.validMembers, fqc.quorumPublicKey, fqc.quorumVvecHash);
+        f.commitmentHash = BuildCommitmentHash(fqc.quorumHash, fqc.validMembers, fqc.quorumPublicKey, fqc.quorumVvecHash);
 
-        std::vector<CBLSSignature> aggSigs;
-        std::vector<CBLSPublicKey> aggPks;
-        aggSigs.reserve(cvec.size());
-        aggPks.reserve(cvec.size());
+        f.aggSigs.reserve(cvec.size());
+        f.aggPks.reserve(cvec.size());
 
         for (const auto& qc : cvec) {
             if (qc.quorumPublicKey != first.quorumPublicKey || qc.quorumVvecHash != first.quorumVvecHash) {
-                logger.Batch("quorumPublicKey or quorumVvecHash does not match, skipping");
+                LogBatch(logger, "quorumPublicKey or quorumVvecHash does not match, skipping");
                 continue;
             }
 
@@ -1195,37 +1299,69 @@ std::vector<CFinalCommitment> CDKGSession::FinalizeCommitments()
             const auto& m = members[signerIndex];
 
             fqc.signers[signerIndex] = true;
-            aggSigs.emplace_back(qc.sig);
-            aggPks.emplace_back(m->dmn->pdmnState->pubKeyOperator.Get());
+            f.aggSigs.emplace_back(qc.sig);
+            f.aggPks.emplace_back(m->dmn->pdmnState->pubKeyOperator.Get());
 
-            signerIds.emplace_back(m->id);
-            thresholdSigs.emplace_back(qc.quorumSig);
+            f.signerIds.emplace_back(m->id);
+            f.thresholdSigs.emplace_back(qc.quorumSig);
         }
+    }
 
-        cxxtimer::Timer t1(true);
-        fqc.membersSig = CBLSSignature::AggregateSecure(aggSigs, aggPks, commitmentHash);
-        t1.stop();
-
-        cxxtimer::Timer t2(true);
-        if (!fqc.quorumSig.Recover(thresholdSigs, signerIds)) {
-            logger.Batch("failed to recover quorum sig");
+    // the members sig and the quorum sig of each candidate are independent of each other
+    // watch out to not bail out before these async calls finish (they rely on valid references)
+    std::vector<std::future<void>> futures;
+    futures.reserve(finalizations.size() * 2);
+    for (auto& f : finalizations) {
+        futures.emplace_back(blsWorker.AsyncRun([&f]() {
+            cxxtimer::Timer t1(true);
+            f.fqc.membersSig = CBLSSignature::AggregateSecure(f.aggSigs, f.aggPks, f.commitmentHash);
+            f.nAggregateTime = t1.count();
+        }));
+        futures.emplace_back(blsWorker.AsyncRun([&f]() {
+            cxxtimer::Timer t2(true);
+            f.fRecovered = f.fqc.quorumSig.Recover(f.thresholdSigs, f.signerIds);
+            f.nRecoverTime = t2.count();
+        }));
+    }
+    for (auto& future : futures) {
+        future.get();
+    }
+    futures.clear();
+    for (auto& f : finalizations) {
+        if (!f.fRecovered) {
             continue;
         }
-        t2.stop();
+        futures.emplace_back(blsWorker.AsyncRun([this, &f]() {
+            cxxtimer::Timer t3(true);
+            f.fVerified = f.fqc.Verify(m_quorum_base_block_index, true);
+            f.nVerifyTime = t3.count();
+        }));
+    }
+    for (auto& future : futures) {
+        future.get();
+    }
 
-        cxxtimer::Timer t3(true);
-        if (!fqc.Verify(m_quorum_base_block_index, true)) {
-            logger.Batch("failed to verify final commitment");
+    std::vector<CFinalCommitment> finalCommitments;
+    for (const auto& f : finalizations) {
+        const auto& fqc = f.fqc;
+        if (!f.fRecovered) {
+            LogBatch(logger, "failed to recover quorum sig");
+            continue;
+        }
+        if (!f.fVerified) {
+            LogBatch(logger, "failed to verify final commitment");
             continue;
         }
-        t3.stop();
 
         finalCommitments.emplace_back(fqc);
 
-        logger.Batch("final commitment: validMembers=%d, signers=%d, quorumPublicKey=%s, time1=%d, time2=%d, time3=%d",
+        LogBatch(logger, "final commitment: validMembers=%d, signers=%d, quorumPublicKey=%s, time1=%d, time2=%d, time3=%d",
                         fqc.CountValidMembers(), fqc.CountSigners(), fqc.quorumPublicKey.ToString(),
-                        t1.count(), t2.count(), t3.count());
+                        f.nAggregateTime, f.nRecoverTime, f.nVerifyTime);
     }
+    timerTotal.stop();
+
+    LogBatch(logger, "finalized %d of %d commitments. totalTime=%d", finalCommitments.size(), finalizations.size(), timerTotal.count());
 
     logger.Flush();
 
@@ -1241,6 +1377,11 @@ CDKGMember* CDKGSession::GetMember(const uint256& proTxHash) const
     return members[it->second].get();
 }
 
+uint256 CDKGSession::GetQuorumHash() const
+{
+    return m_quorum_base_block_index ? m_quorum_base_block_index->GetBlockHash() : uint256();
+}
+
 void CDKGSession::MarkBadMember(size_t idx)
 {
     auto* member = members.at(idx).get();
@@ -1262,7 +1403,7 @@ void CDKGSession::RelayOtherInvToParticipants(const CInv& inv, PeerManager& peer
     for (const auto& r : relayMembers) {
         ss << r.ToString().substr(0, 4) << " | ";
     }
-    logger.Batch("RelayInvToParticipants inv[%s] relayMembers[%d] GetNodeCount[%d] GetNetworkActive[%d] HasMasternodeQuorumNodes[%d] for quorumHash[%s] forMember[%s] relayMembers[%s]",
+    LogBatch(logger, "RelayInvToParticipants inv[%s] relayMembers[%d] GetNodeCount[%d] GetNetworkActive[%d] HasMasternodeQuorumNodes[%d] for quorumHash[%s] forMember[%s] relayMembers[%s]",
                  inv.ToString(),
                  relayMembers.size(),
                  dkgManager.connman.GetNodeCount(ConnectionDirection::Both),
@@ -1282,14 +1423,14 @@ void CDKGSession::RelayOtherInvToParticipants(const CInv& inv, PeerManager& peer
         }
 
         if (pnode->GetVerifiedProRegTxHash().IsNull()) {
-            logger.Batch("node[%d:%s] not mn",
+            LogBatch(logger, "node[%d:%s] not mn",
                          pnode->GetId(),
                          pnode->m_addr_name);
         } else if (relayMembers.count(pnode->GetVerifiedProRegTxHash()) == 0) {
             ss2 << pnode->GetVerifiedProRegTxHash().ToString().substr(0, 4) << " | ";
         }
     });
-    logger.Batch("forMember[%s] NOTrelayMembers[%s]",
+    LogBatch(logger, "forMember[%s] NOTrelayMembers[%s]",
                  myProTxHash.ToString().substr(0, 4),
                  ss2.str());
     logger.Flush();
@@ -304,6 +304,15 @@ private:
     // filled by ReceivePrematureCommitment and used by FinalizeCommitments
     std::set<uint256> validCommitments GUARDED_BY(invCs);
 
+    // SYSCOIN result of the BLS heavy part of verifying a premature commitment
+    struct PrematureCommitmentCheck {
+        bool fHaveVvec{false};
+        bool fValid{false};
+        std::string strError;
+    };
+    // filled by VerifyPrematureCommitments and consumed by ReceiveMessage, both only called from the phase thread
+    std::map<uint256, PrematureCommitmentCheck> prematureCommitmentChecks;
+
 public:
     CDKGSession(CBLSWorker& _blsWorker, CDKGSessionManager& _dkgManager) :
         blsWorker(_blsWorker), cache(_blsWorker), dkgManager(_dkgManager) {}
@@ -350,6 +359,9 @@ public:
     void SendCommitment(CDKGPendingMessages& pendingMessages);
     bool PreVerifyMessage(const CDKGPrematureCommitment& qc, bool& retBan) const;
     void ReceiveMessage(const uint256& hash, const CDKGPrematureCommitment& qc) EXCLUSIVE_LOCKS_REQUIRED(!invCs);
+    // builds the key shares of a batch of premature commitments in parallel and checks their quorum sigs in one batch
+    // before ReceiveMessage is called for them
+    void VerifyPrematureCommitments(const std::vector<std::pair<uint256, const CDKGPrematureCommitment*>>& qcs);
 
     // Phase 5: aggregate/finalize
     std::vector<CFinalCommitment> FinalizeCommitments() EXCLUSIVE_LOCKS_REQUIRED(!invCs);
@@ -361,9 +373,16 @@ public:
 
 public:
     [[nodiscard]] CDKGMember* GetMember(const uint256& proTxHash) const;
+    // SYSCOIN null before Init
+    [[nodiscard]] uint256 GetQuorumHash() const;
 
 private:
     [[nodiscard]] bool ShouldSimulateError(DKGError::type type) const;
+    // builds the quorum vvec on the BLS worker, so it must not be called from a task running on it
+    [[nodiscard]] BLSVerificationVectorPtr BuildQuorumVvec(const CDKGPrematureCommitment& qc, std::vector<uint16_t>& memberIndexes);
+    // with pubKeyShareRet the quorumSig is left to the caller, which gets the key share to verify it against
+    [[nodiscard]] PrematureCommitmentCheck CheckPrematureCommitment(const CDKGPrematureCommitment& qc, const std::vector<uint16_t>& memberIndexes,
+                                                                    const BLSVerificationVectorPtr& quorumVvec, CBLSPublicKey* pubKeyShareRet = nullptr);
 };
 
 void SetSimulatedDKGErrorRate(DKGError::type type, double rate);
@@ -17,6 +17,9 @@
 #include <validation.h>
 #include <shutdown.h>
 #include <util/thread.h>
+
+#include <type_traits>
+
 namespace llmq
 {
 
@@ -25,6 +28,12 @@ void CDKGPendingMessages::PushPendingMessage(CNode* pfrom, CDataStream& vRecv)
     NodeId from = -1;
     if(pfrom)
         from = pfrom->GetId();
+    // SYSCOIN no honest message gets near the size limit, drop before hashing or holding on to it
+    if (vRecv.size() > maxMessageSize) {
+        LogPrint(BCLog::LLMQ_DKG, "CDKGPendingMessages::%s -- message too large (%u bytes), peer=%d\n", __func__, vRecv.size(), from);
+        vRecv.clear();
+        return;
+    }
     // this will also consume the data, even if we bail out early
     auto pm = std::make_shared<CDataStream>(std::move(vRecv));
     CHashWriter hw(SER_GETHASH, 0);
@@ -40,19 +49,25 @@ void CDKGPendingMessages::PushPendingMessage(CNode* pfrom, CDataStream& vRecv)
         peerman.ReceivedResponse(from, hash);
     }
     LOCK2(cs_main, cs_messages);
+    // SYSCOIN duplicates are dropped before they count against the limits of the node
+    if (seenMessages.count(hash)) {
+        if(pfrom)
+            peerman.ForgetTxHash(from, hash);
+        LogPrint(BCLog::LLMQ_DKG, "CDKGPendingMessages::%s -- already seen %s, peer=%d\n", __func__, hash.ToString(), from);
+        return;
+    }
     if (messagesPerNode[from] >= maxMessagesPerNode) {
         // TODO ban?
         LogPrint(BCLog::LLMQ_DKG, "CDKGPendingMessages::%s -- too many messages, peer=%d\n", __func__, from);
         return;
     }
-    messagesPerNode[from]++;
-    
-    if (!seenMessages.emplace(hash).second) {
-        if(pfrom)
-            peerman.ForgetTxHash(from, hash);
-        LogPrint(BCLog::LLMQ_DKG, "CDKGPendingMessages::%s -- already seen %s, peer=%d\n", __func__, hash.ToString(), from);
+    if (bytesPerNode[from] + pm->size() > maxBytesPerNode) {
+        LogPrint(BCLog::LLMQ_DKG, "CDKGPendingMessages::%s -- too many bytes queued, peer=%d\n", __func__, from);
         return;
     }
+    messagesPerNode[from]++;
+    bytesPerNode[from] += pm->size();
+    seenMessages.emplace(hash);
     if(pfrom) {
         peerman.ForgetTxHash(from, hash);
     }
@@ -83,20 +98,53 @@ void CDKGPendingMessages::Clear()
     LOCK(cs_messages);
     pendingMessages.clear();
     messagesPerNode.clear();
+    bytesPerNode.clear();
     seenMessages.clear();
 }
 
 //////
 
+// SYSCOIN serialized size of the largest honest message of each phase, with room for the compact sizes. The
+// pending queues drop anything over twice that and let a node queue its message limit at this size
+size_t MaxDKGMessageSize(const Consensus::LLMQParams& params, QuorumPhase phase)
+{
+    const size_t nHeader{2 * 32};
+    const size_t nBitSet{9 + (size_t(params.size) + 7) / 8};
+    const size_t nSig{96};
+    switch (phase) {
+    case QuorumPhase_Contribute:
+        // vvec, then the ephemeral key, iv seed and one encrypted secret key share per member
+        return nHeader + 9 + size_t(params.threshold) * 48 + 48 + 32 + 9 + size_t(params.size) * (1 + 32) + nSig;
+    case QuorumPhase_Complain:
+        return nHeader + 2 * nBitSet + nSig;
+    case QuorumPhase_Justify:
+        return nHeader + 9 + size_t(params.size) * (4 + 32) + nSig;
+    case QuorumPhase_Commit:
+        // quorum public key, vvec hash, quorum sig share
+        return nHeader + nBitSet + 48 + 32 + 96 + nSig;
+    default:
+        return 0;
+    }
+}
+
+static CDKGPendingMessages MakePendingMessages(QuorumPhase phase, PeerManager& peerman)
+{
+    const auto& params = Params().GetConsensus().llmqTypeChainLocks;
+    // we allow size*2 messages as we need to make sure we see bad behavior (double messages)
+    const size_t nMaxMessages{(size_t)params.size * 2};
+    const size_t nMaxSize{MaxDKGMessageSize(params, phase)};
+    return CDKGPendingMessages(nMaxMessages, 2 * nMaxSize, nMaxMessages * nMaxSize, peerman);
+}
+
 CDKGSessionHandler::CDKGSessionHandler(CBLSWorker& _blsWorker, CDKGSessionManager& _dkgManager, PeerManager& _peerman, ChainstateManager& _chainman) :
     blsWorker(_blsWorker),
     dkgManager(_dkgManager),
     chainman(_chainman),
     curSession(std::make_unique<CDKGSession>(_blsWorker, _dkgManager)),
-    pendingContributions((size_t)Params().GetConsensus().llmqTypeChainLocks.size * 2, _peerman), // we allow size*2 messages as we need to make sure we see bad behavior (double messages)
-    pendingComplaints((size_t)Params().GetConsensus().llmqTypeChainLocks.size * 2, _peerman),
-    pendingJustifications((size_t)Params().GetConsensus().llmqTypeChainLocks.size* 2, _peerman),
-    pendingPrematureCommitments((size_t)Params().GetConsensus().llmqTypeChainLocks.size * 2, _peerman),
+    pendingContributions(MakePendingMessages(QuorumPhase_Contribute, _peerman)),
+    pendingComplaints(MakePendingMessages(QuorumPhase_Complain, _peerman)),
+    pendingJustifications(MakePendingMessages(QuorumPhase_Justify, _peerman)),
+    pendingPrematureCommitments(MakePendingMessages(QuorumPhase_Commit, _peerman)),
     peerman(_peerman)
 {
 }
@@ -161,7 +209,7 @@ bool CDKGSessionHandler::InitNewQuorum(const CBlockIndex* pQuorumBaseBlockIndex)
     }
     auto mns = CLLMQUtils::GetAllQuorumMembers(pQuorumBaseBlockIndex);
 
-    if (!curSession->Init(pQuorumBaseBlockIndex, mns, WITH_LOCK(activeMasternodeInfoCs, return activeMasternodeInfo.proTxHash))) {
+    if (!curSession->Init(pQuorumBaseBlockIndex, *mns, WITH_LOCK(activeMasternodeInfoCs, return activeMasternodeInfo.proTxHash))) {
         LogPrintf("CDKGSessionManager::%s -- quorum initialization failed\n", __func__);
         return false;
     }
@@ -404,7 +452,22 @@ std::set<NodeId> BatchVerifyMessageSigs(CDKGSession& session, const std::vector<
 template<typename Message>
 bool ProcessPendingMessageBatch(CDKGSession& session, CDKGPendingMessages& pendingMessages, size_t maxCount, PeerManager& peerman)
 {
-    const auto msgs = pendingMessages.PopAndDeserializeMessages<Message>(maxCount);
+    // SYSCOIN the cheap checks of PreVerifyMessage, done on the header before the rest is deserialized
+    const uint256 sessionQuorumHash{session.GetQuorumHash()};
+    const auto msgs = pendingMessages.PopAndDeserializeMessages<Message>(maxCount, [&](NodeId from, const CDKGPendingMessages::MessageHeader& header) {
+        if (header.quorumHash != sessionQuorumHash) {
+            LogPrint(BCLog::LLMQ_DKG, "%s -- skipping message for wrong quorum, peer=%d\n", __func__, from);
+            return true;
+        }
+        if (session.GetMember(header.proTxHash) == nullptr) {
+            LogPrint(BCLog::LLMQ_DKG, "%s -- banning node for message of a non member, peer=%d\n", __func__, from);
+            if (PeerRef peer = peerman.GetPeerRef(from)) {
+                peerman.Misbehaving(*peer, 100, "message of a non member");
+            }
+            return true;
+        }
+        return false;
+    });
     if (msgs.empty()) {
         return false;
     }
@@ -467,6 +530,19 @@ bool ProcessPendingMessageBatch(CDKGSession& session, CDKGPendingMessages& pendi
         }
     }
 
+    // SYSCOIN the quorum sig checks of premature commitments don't depend on each other, run them in parallel first
+    if constexpr (std::is_same_v<Message, CDKGPrematureCommitment>) {
+        std::vector<std::pair<uint256, const CDKGPrematureCommitment*>> toVerify;
+        for (size_t i = 0; i < preverifiedMessages.size(); i++) {
+            if (!badNodes.count(preverifiedMessages[i].first)) {
+                toVerify.emplace_back(hashes[i], preverifiedMessages[i].second.get());
+            }
+        }
+        if (toVerify.size() > 1) {
+            session.VerifyPrematureCommitments(toVerify);
+        }
+    }
+
     for (size_t i = 0; i < preverifiedMessages.size(); i++) {
         const NodeId &nodeId = preverifiedMessages[i].first;
         if (badNodes.count(nodeId)) {
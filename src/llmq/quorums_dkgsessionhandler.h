@@ -14,6 +14,9 @@ class CBlockIndex;
 class CConnman;
 class PeerManager;
 class ChainstateManager;
+namespace Consensus {
+struct LLMQParams;
+} // namespace Consensus
 namespace llmq
 {
 class CDKGContribution;
@@ -46,16 +49,27 @@ class CDKGPendingMessages
 public:
     using BinaryMessage = std::pair<NodeId, std::shared_ptr<CDataStream>>;
 
+    // SYSCOIN the fields every DKG message starts with, read without deserializing the rest
+    struct MessageHeader {
+        uint256 quorumHash;
+        uint256 proTxHash;
+    };
+
 private:
     mutable Mutex cs_messages;
     size_t maxMessagesPerNode GUARDED_BY(cs_messages);
+    // SYSCOIN messages above maxMessageSize are dropped, and a node may queue maxBytesPerNode at most
+    const size_t maxMessageSize;
+    const size_t maxBytesPerNode;
     std::list<BinaryMessage> pendingMessages GUARDED_BY(cs_messages);
     std::map<NodeId, size_t> messagesPerNode GUARDED_BY(cs_messages);
+    std::map<NodeId, size_t> bytesPerNode GUARDED_BY(cs_messages);
     std::set<uint256> seenMessages GUARDED_BY(cs_messages);
 
 public:
     PeerManager& peerman;
-    explicit CDKGPendingMessages(size_t _maxMessagesPerNode, PeerManager& _peerman): maxMessagesPerNode(_maxMessagesPerNode), peerman(_peerman) {};
+    explicit CDKGPendingMessages(size_t _maxMessagesPerNode, size_t _maxMessageSize, size_t _maxBytesPerNode, PeerManager& _peerman) :
+        maxMessagesPerNode(_maxMessagesPerNode), maxMessageSize(_maxMessageSize), maxBytesPerNode(_maxBytesPerNode), peerman(_peerman) {};
 
     void PushPendingMessage(CNode* from, CDataStream& vRecv) EXCLUSIVE_LOCKS_REQUIRED(!cs_messages);
     std::list<BinaryMessage> PopPendingMessages(size_t maxCount) EXCLUSIVE_LOCKS_REQUIRED(!cs_messages);
@@ -71,8 +85,10 @@ public:
     }
 
     // Might return nullptr messages, which indicates that deserialization failed for some reason
-    template<typename Message>
-    std::vector<std::pair<NodeId, std::shared_ptr<Message>>> PopAndDeserializeMessages(size_t maxCount) EXCLUSIVE_LOCKS_REQUIRED(!cs_messages)
+    // SYSCOIN fnSkip sees the header of each message first, messages it returns true for are dropped without
+    // deserializing their bulk (verification vectors, encrypted shares)
+    template<typename Message, typename SkipFn>
+    std::vector<std::pair<NodeId, std::shared_ptr<Message>>> PopAndDeserializeMessages(size_t maxCount, SkipFn&& fnSkip) EXCLUSIVE_LOCKS_REQUIRED(!cs_messages)
     {
         auto binaryMessages = PopPendingMessages(maxCount);
         if (binaryMessages.empty()) {
@@ -84,6 +100,11 @@ public:
         for (const auto& bm : binaryMessages) {
             auto msg = std::make_shared<Message>();
             try {
+                MessageHeader header;
+                SpanReader{SER_NETWORK, PROTOCOL_VERSION, MakeUCharSpan(*bm.second)} >> header.quorumHash >> header.proTxHash;
+                if (fnSkip(bm.first, header)) {
+                    continue;
+                }
                 *bm.second >> *msg;
             } catch (...) {
                 msg = nullptr;
@@ -95,6 +116,9 @@ public:
     }
 };
 
+// SYSCOIN
+size_t MaxDKGMessageSize(const Consensus::LLMQParams& params, QuorumPhase phase);
+
 /**
  * Handles multiple sequential sessions of one specific LLMQ type. There is one instance of this class per LLMQ type.
  *
@@ -65,6 +65,11 @@ void CDKGSessionManager::UpdatedBlockTip(const CBlockIndex* pindexNew, bool fIni
         return;
     if (!deterministicMNManager || !deterministicMNManager->IsDIP3Enforced(pindexNew->nHeight))
         return;
+    // SYSCOIN calculate the members of a new quorum as its base block connects, before the DKG, connection and
+    // commitment code all ask for them
+    if (pindexNew->nHeight % Params().GetConsensus().llmqTypeChainLocks.dkgInterval == 0) {
+        CLLMQUtils::GetAllQuorumMembers(pindexNew);
+    }
     if (!IsQuorumDKGEnabled())
         return;
 
@@ -203,7 +208,8 @@ void CDKGSessionManager::WriteVerifiedSkContribution(const uint256& hashQuorum,
 
 bool CDKGSessionManager::GetVerifiedContributions(const CBlockIndex* pQuorumBaseBlockIndex, const std::vector<bool>& validMembers, std::vector<uint16_t>& memberIndexesRet, std::vector<BLSVerificationVectorPtr>& vvecsRet, std::vector<CBLSSecretKey>& skContributionsRet) const
 {
-    auto members = CLLMQUtils::GetAllQuorumMembers(pQuorumBaseBlockIndex);
+    const auto quorumMembers = CLLMQUtils::GetAllQuorumMembers(pQuorumBaseBlockIndex);
+    const auto& members = *quorumMembers;
 
     memberIndexesRet.clear();
     vvecsRet.clear();
@@ -29,8 +29,8 @@ void InitLLMQSystem(const DBParams& quorumCommitmentDB, const DBParams& quorumVe
     quorumBlockProcessor = new CQuorumBlockProcessor(quorumCommitmentDB, peerman, chainman);
     quorumDKGSessionManager = new CDKGSessionManager(*blsWorker, connman, peerman, chainman, unitTests, fWipe);
     quorumManager = new CQuorumManager(quorumVectorDB, quorumSkDB, *blsWorker, *quorumDKGSessionManager, chainman);
-    quorumSigSharesManager = new CSigSharesManager(connman, peerman);
-    quorumSigningManager = new CSigningManager(unitTests, peerman, chainman, fWipe);
+    quorumSigSharesManager = new CSigSharesManager(connman, peerman, *blsWorker);
+    quorumSigningManager = new CSigningManager(unitTests, peerman, chainman, *blsWorker, fWipe);
     chainLocksHandler = new CChainLocksHandler(connman, peerman, chainman);
 }
 
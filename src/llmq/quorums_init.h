@@ -5,17 +5,24 @@
 #ifndef SYSCOIN_LLMQ_QUORUMS_INIT_H
 #define SYSCOIN_LLMQ_QUORUMS_INIT_H
 
+#include <cstdint>
+
 class CDBWrapper;
 class CConnman;
 class BanMan;
 class PeerManager;
 class ChainstateManager;
+class CBLSWorker;
 struct DBParams;
 namespace llmq
 {
+// SYSCOIN shared BLS worker, also used to verify ProTx payload signatures of blocks
+extern CBLSWorker* blsWorker;
 
 // If true, we will connect to all new quorums and watch their communication
 static const bool DEFAULT_WATCH_QUORUMS = false;
+// SYSCOIN number of quorums whose members are kept in memory
+static const int64_t DEFAULT_QUORUM_MEMBERS_CACHE = 64;
 
 // Init/destroy LLMQ globals
 void InitLLMQSystem(const DBParams& quorumCommitmentDB, const DBParams& quorumVectorDB, const DBParams& quorumSkDB, bool unitTests, CConnman& connman, BanMan& banman, PeerManager& peerman, ChainstateManager& chainman, bool fWipe = false);
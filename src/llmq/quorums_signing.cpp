@@ -26,6 +26,7 @@
 #include <common/args.h>
 #include <evo/deterministicmns.h>
 #include <logging.h>
+#include <metrics.h>
 #include <util/thread.h>
 
 namespace llmq
@@ -47,16 +48,77 @@ UniValue CRecoveredSig::ToJson() const
 CRecoveredSigsDb::CRecoveredSigsDb(bool fMemory, bool fWipe) :
         db(std::make_unique<CDBWrapper>(DBParams{fMemory ? "" : (gArgs.GetDataDirNet() / "llmq/recsigdb"), 8 << 20, fMemory, fWipe}))
 {
+    RebuildNegativeFilter();
 }
 
-CRecoveredSigsDb::~CRecoveredSigsDb() = default;
+CRecoveredSigsDb::~CRecoveredSigsDb()
+{
+    FlushPendingWrites();
+}
+
+bool CRecoveredSigsDb::NotInDb(const uint256& key) const
+{
+    return fNegativeFilterValid && !negativeFilter.contains(key);
+}
+
+void CRecoveredSigsDb::AddToNegativeFilter(const uint256& key)
+{
+    negativeFilter.insert(key);
+    if (++nNegativeFilterElements > NEGATIVE_FILTER_ELEMENTS) {
+        // the oldest elements may have been forgotten, so a miss is no longer proof of absence
+        fNegativeFilterValid = false;
+    }
+}
+
+void CRecoveredSigsDb::RebuildNegativeFilter()
+{
+    // the keys below hold every id, hash and signHash, which is all the filter is asked about
+    std::vector<uint256> keys;
+    std::unique_ptr<CDBIterator> pcursor(db->NewIterator());
+    for (const char* prefix : {"rs_r", "rs_h", "rs_s"}) {
+        pcursor->Seek(std::make_tuple(std::string(prefix), uint256()));
+        while (pcursor->Valid()) {
+            std::tuple<std::string, uint256> k;
+            if (!pcursor->GetKey(k) || std::get<0>(k) != prefix) {
+                break;
+            }
+            keys.emplace_back(std::get<1>(k));
+            pcursor->Next();
+        }
+    }
+    pcursor.reset();
+
+    LOCK(cs_cache);
+    negativeFilter.reset();
+    nNegativeFilterElements = 0;
+    fNegativeFilterValid = true;
+    for (const auto& key : keys) {
+        AddToNegativeFilter(key);
+    }
+    LogPrint(BCLog::LLMQ, "CRecoveredSigsDb::%s -- %d keys, valid=%d\n", __func__, keys.size(), fNegativeFilterValid);
+}
 
 bool CRecoveredSigsDb::HasRecoveredSig(const uint256& id, const uint256& msgHash) const
 {
+    if (WITH_LOCK(cs_cache, return NotInDb(id))) {
+        return false;
+    }
+    {
+        LOCK(cs_pendingWrites);
+        if (auto it = pendingWritesById.find(id); it != pendingWritesById.end()) {
+            return it->second.recSig.getMsgHash() == msgHash;
+        }
+    }
     auto k = std::make_tuple(std::string("rs_r"), id, msgHash);
     return db->Exists(k);
 }
 
+size_t CRecoveredSigsDb::GetCacheUsage() const
+{
+    LOCK(cs_cache);
+    return hasSigForIdCache.DynamicMemoryUsage() + hasSigForSessionCache.DynamicMemoryUsage() + hasSigForHashCache.DynamicMemoryUsage();
+}
+
 bool CRecoveredSigsDb::HasRecoveredSigForId(const uint256& id) const
 {
     auto cacheKey = id;
@@ -66,8 +128,13 @@ bool CRecoveredSigsDb::HasRecoveredSigForId(const uint256& id) const
         if (hasSigForIdCache.get(cacheKey, ret)) {
             return ret;
         }
+        if (NotInDb(cacheKey)) {
+            return false;
+        }
+    }
+    if (WITH_LOCK(cs_pendingWrites, return pendingWritesById.count(id) > 0)) {
+        return true;
     }
-
 
     auto k = std::make_tuple(std::string("rs_r"), id);
     ret = db->Exists(k);
@@ -85,6 +152,12 @@ bool CRecoveredSigsDb::HasRecoveredSigForSession(const uint256& signHash) const
         if (hasSigForSessionCache.get(signHash, ret)) {
             return ret;
         }
+        if (NotInDb(signHash)) {
+            return false;
+        }
+    }
+    if (WITH_LOCK(cs_pendingWrites, return pendingSignHashes.count(signHash) > 0)) {
+        return true;
     }
 
     auto k = std::make_tuple(std::string("rs_s"), signHash);
@@ -103,6 +176,12 @@ bool CRecoveredSigsDb::HasRecoveredSigForHash(const uint256& hash) const
         if (hasSigForHashCache.get(hash, ret)) {
             return ret;
         }
+        if (NotInDb(hash)) {
+            return false;
+        }
+    }
+    if (WITH_LOCK(cs_pendingWrites, return pendingIdsByHash.count(hash) > 0)) {
+        return true;
     }
 
     auto k = std::make_tuple(std::string("rs_h"), hash);
@@ -113,8 +192,54 @@ bool CRecoveredSigsDb::HasRecoveredSigForHash(const uint256& hash) const
     return ret;
 }
 
+void CRecoveredSigsDb::PrefetchHasRecoveredSigForHashes(const std::vector<uint256>& hashes) const
+{
+    std::vector<uint256> missing;
+    {
+        LOCK(cs_cache);
+        for (const auto& hash : hashes) {
+            if (!hasSigForHashCache.exists(hash) && !NotInDb(hash)) {
+                missing.emplace_back(hash);
+            }
+        }
+    }
+    if (missing.empty()) {
+        return;
+    }
+    {
+        LOCK(cs_pendingWrites);
+        missing.erase(std::remove_if(missing.begin(), missing.end(), [&](const uint256& hash) {
+            return pendingIdsByHash.count(hash) > 0;
+        }), missing.end());
+    }
+    std::vector<std::tuple<std::string, uint256>> keys;
+    keys.reserve(missing.size());
+    for (const auto& hash : missing) {
+        keys.emplace_back(std::string("rs_h"), hash);
+    }
+    const std::vector<bool> exists = db->ExistsMany(keys);
+
+    LOCK(cs_cache);
+    for (size_t i = 0; i < missing.size(); i++) {
+        // a sig written meanwhile already put its entry in
+        if (!hasSigForHashCache.exists(missing[i])) {
+            hasSigForHashCache.insert(missing[i], exists[i]);
+        }
+    }
+}
+
 bool CRecoveredSigsDb::ReadRecoveredSig(const uint256& id, CRecoveredSig& ret) const
 {
+    {
+        LOCK(cs_pendingWrites);
+        if (auto it = pendingWritesById.find(id); it != pendingWritesById.end()) {
+            // the sig is not assignable, so go through its serialization like a db read does
+            DataStream ss{};
+            ss << it->second.recSig;
+            ss >> ret;
+            return true;
+        }
+    }
     auto k = std::make_tuple(std::string("rs_r"), id);
     return db->Read(k, ret);
 
@@ -124,7 +249,13 @@ bool CRecoveredSigsDb::GetRecoveredSigByHash(const uint256& hash, CRecoveredSig&
 {
     auto k1 = std::make_tuple(std::string("rs_h"), hash);
     uint256 k2;
-    if (!db->Read(k1, k2)) {
+    {
+        LOCK(cs_pendingWrites);
+        if (auto it = pendingIdsByHash.find(hash); it != pendingIdsByHash.end()) {
+            k2 = it->second;
+        }
+    }
+    if (k2.IsNull() && !db->Read(k1, k2)) {
         return false;
     }
 
@@ -138,39 +269,74 @@ bool CRecoveredSigsDb::GetRecoveredSigById(const uint256& id, CRecoveredSig& ret
 
 void CRecoveredSigsDb::WriteRecoveredSig(const llmq::CRecoveredSig& recSig)
 {
-    CDBBatch batch(*db);
-
     uint32_t curTime = GetTime<std::chrono::seconds>().count();
-
-    // we put these close to each other to leverage leveldb's key compaction
-    // this way, the second key can be used for fast HasRecoveredSig checks while the first key stores the recSig
-    auto k1 = std::make_tuple(std::string("rs_r"), recSig.getId());
-    auto k2 = std::make_tuple(std::string("rs_r"), recSig.getId(), recSig.getMsgHash());
-    batch.Write(k1, recSig);
-    // this key is also used to store the current time, so that we can easily get to the "rs_t" key when we have the id
-    batch.Write(k2, curTime);
-
-    // store by object hash
-    auto k3 = std::make_tuple(std::string("rs_h"), recSig.GetHash());
-    batch.Write(k3, recSig.getId());
-
-    // store by signHash
     auto signHash = recSig.buildSignHash();
-    auto k4 = std::make_tuple(std::string("rs_s"), signHash);
-    batch.Write(k4, (uint8_t)1);
-
-    // store by current time. Allows fast cleanup of old recSigs
-    auto k5 = std::make_tuple(std::string("rs_t"), (uint32_t)htobe32_internal(curTime), recSig.getId());
-    batch.Write(k5, (uint8_t)1);
-
-    db->WriteBatch(batch);
 
+    // the filter must know the sig before any reader can miss it in the pending writes
     {
         LOCK(cs_cache);
         hasSigForIdCache.insert(recSig.getId(), true);
         hasSigForSessionCache.insert(signHash, true);
         hasSigForHashCache.insert(recSig.GetHash(), true);
+        AddToNegativeFilter(recSig.getId());
+        AddToNegativeFilter(signHash);
+        AddToNegativeFilter(recSig.GetHash());
+    }
+
+    LOCK(cs_pendingWrites);
+    pendingWritesById.erase(recSig.getId());
+    pendingWritesById.emplace(std::piecewise_construct, std::forward_as_tuple(recSig.getId()), std::forward_as_tuple(PendingRecoveredSig{recSig, curTime}));
+    pendingIdsByHash.emplace(recSig.GetHash(), recSig.getId());
+    pendingSignHashes.emplace(signHash);
+    if (pendingWritesById.size() >= MAX_PENDING_WRITES) {
+        WritePendingWrites();
+    }
+}
+
+void CRecoveredSigsDb::FlushPendingWrites()
+{
+    LOCK(cs_pendingWrites);
+    WritePendingWrites();
+}
+
+void CRecoveredSigsDb::WritePendingWrites()
+{
+    if (pendingWritesById.empty()) {
+        return;
+    }
+
+    CDBBatch batch(*db);
+    for (const auto& [id, pending] : pendingWritesById) {
+        const auto& recSig = pending.recSig;
+
+        // we put these close to each other to leverage leveldb's key compaction
+        // this way, the second key can be used for fast HasRecoveredSig checks while the first key stores the recSig
+        auto k1 = std::make_tuple(std::string("rs_r"), recSig.getId());
+        auto k2 = std::make_tuple(std::string("rs_r"), recSig.getId(), recSig.getMsgHash());
+        batch.Write(k1, recSig);
+        // this key is also used to store the current time, so that we can easily get to the "rs_t" key when we have the id
+        batch.Write(k2, pending.writeTime);
+
+        // store by object hash
+        auto k3 = std::make_tuple(std::string("rs_h"), recSig.GetHash());
+        batch.Write(k3, recSig.getId());
+
+        // store by signHash
+        auto signHash = recSig.buildSignHash();
+        auto k4 = std::make_tuple(std::string("rs_s"), signHash);
+        batch.Write(k4, (uint8_t)1);
+
+        // store by current time. Allows fast cleanup of old recSigs. SYSCOIN the value holds the other keys of the sig,
+        // so cleanup deletes them without reading the sig back
+        auto k5 = std::make_tuple(std::string("rs_t"), (uint32_t)htobe32_internal(pending.writeTime), recSig.getId());
+        batch.Write(k5, std::make_tuple(recSig.getMsgHash(), recSig.GetHash(), signHash));
     }
+    db->WriteBatch(batch);
+
+    LogPrint(BCLog::LLMQ, "CRecoveredSigsDb::%s -- wrote %d recovered sigs\n", __func__, pendingWritesById.size());
+    pendingWritesById.clear();
+    pendingIdsByHash.clear();
+    pendingSignHashes.clear();
 }
 
 void CRecoveredSigsDb::RemoveRecoveredSig(CDBBatch& batch, const uint256& id, bool deleteHashKey, bool deleteTimeKey)
@@ -213,6 +379,8 @@ void CRecoveredSigsDb::RemoveRecoveredSig(CDBBatch& batch, const uint256& id, bo
 // This will leave the byHash key in-place so that HasRecoveredSigForHash still returns true
 void CRecoveredSigsDb::TruncateRecoveredSig(const uint256& id)
 {
+    // SYSCOIN the erases must come after the write of a pending sig
+    FlushPendingWrites();
     CDBBatch batch(*db);
     RemoveRecoveredSig(batch, id, false, false);
     db->WriteBatch(batch);
@@ -220,14 +388,20 @@ void CRecoveredSigsDb::TruncateRecoveredSig(const uint256& id)
 
 void CRecoveredSigsDb::CleanupOldRecoveredSigs(int64_t maxAge)
 {
+    FlushPendingWrites();
+
     std::unique_ptr<CDBIterator> pcursor(db->NewIterator());
 
     auto start = std::make_tuple(std::string("rs_t"), (uint32_t)0, uint256());
     uint32_t endTime = (uint32_t)(GetTime<std::chrono::seconds>().count() - maxAge);
     pcursor->Seek(start);
 
+    // SYSCOIN the time keys written since the value names the other keys of the sig are deleted in the same pass over
+    // the range without reading the sigs. Only older ones need the sig looked up
+    CDBBatch batch(*db);
     std::vector<uint256> toDelete;
-    std::vector<decltype(start)> toDelete2;
+    std::vector<std::tuple<uint256, uint256, uint256>> deletedKeys;
+    size_t cnt = 0;
 
     while (pcursor->Valid()) {
         decltype(start) k;
@@ -239,18 +413,34 @@ void CRecoveredSigsDb::CleanupOldRecoveredSigs(int64_t maxAge)
             break;
         }
 
-        toDelete.emplace_back(std::get<2>(k));
-        toDelete2.emplace_back(k);
+        const uint256& id = std::get<2>(k);
+        std::tuple<uint256, uint256, uint256> keys;
+        if (pcursor->GetValue(keys)) {
+            const auto& [msgHash, hash, signHash] = keys;
+            batch.Erase(std::make_tuple(std::string("rs_r"), id));
+            batch.Erase(std::make_tuple(std::string("rs_r"), id, msgHash));
+            batch.Erase(std::make_tuple(std::string("rs_h"), hash));
+            batch.Erase(std::make_tuple(std::string("rs_s"), signHash));
+            deletedKeys.emplace_back(id, hash, signHash);
+        } else {
+            toDelete.emplace_back(id);
+        }
+        batch.Erase(k);
+        cnt++;
+
+        if (batch.SizeEstimate() >= (1 << 24)) {
+            db->WriteBatch(batch);
+            batch.Clear();
+        }
 
         pcursor->Next();
     }
     pcursor.reset();
 
-    if (toDelete.empty()) {
+    if (cnt == 0) {
         return;
     }
 
-    CDBBatch batch(*db);
     for (const auto& e : toDelete) {
         RemoveRecoveredSig(batch, e, true, false);
 
@@ -260,13 +450,23 @@ void CRecoveredSigsDb::CleanupOldRecoveredSigs(int64_t maxAge)
         }
     }
 
-    for (const auto& e : toDelete2) {
-        batch.Erase(e);
-    }
-
     db->WriteBatch(batch);
 
-    LogPrint(BCLog::LLMQ, "CRecoveredSigsDb::%d -- deleted %d entries\n", __func__, toDelete.size());
+    bool fRebuildFilter;
+    {
+        LOCK(cs_cache);
+        for (const auto& [id, hash, signHash] : deletedKeys) {
+            hasSigForIdCache.erase(id);
+            hasSigForHashCache.erase(hash);
+            hasSigForSessionCache.erase(signHash);
+        }
+        fRebuildFilter = !fNegativeFilterValid;
+    }
+    if (fRebuildFilter) {
+        RebuildNegativeFilter();
+    }
+
+    LogPrint(BCLog::LLMQ, "CRecoveredSigsDb::%d -- deleted %d entries\n", __func__, cnt);
 }
 
 bool CRecoveredSigsDb::HasVotedOnId(const uint256& id) const
@@ -335,10 +535,22 @@ void CRecoveredSigsDb::CleanupOldVotes(int64_t maxAge)
 
 //////////////////
 
-CSigningManager::CSigningManager(bool fMemory, PeerManager& _peerman, ChainstateManager& _chainman, bool fWipe) :
+// SYSCOIN
+struct CSigningManager::RecoveredSigsBatch {
+    std::unordered_map<NodeId, std::list<std::shared_ptr<const CRecoveredSig>>> recSigsByNode;
+    std::unordered_map<uint256, CQuorumCPtr, StaticSaltedHasher> quorums;
+    // It's ok to perform insecure batched verification here as we verify against the quorum public keys, which are not
+    // craftable by individual entities, making the rogue public key attack impossible
+    CBLSBatchVerifier<NodeId, uint256> batchVerifier{false, false};
+    size_t verifyCount{0};
+    int64_t verifyTime{0};
+};
+
+CSigningManager::CSigningManager(bool fMemory, PeerManager& _peerman, ChainstateManager& _chainman, CBLSWorker& _blsWorker, bool fWipe) :
     db(fMemory, fWipe),
     peerman(_peerman),
-    chainman(_chainman)
+    chainman(_chainman),
+    blsWorker(_blsWorker)
 {
 }
 
@@ -346,7 +558,7 @@ bool CSigningManager::AlreadyHave(const uint256& hash) const
 {
     {
         LOCK(cs_pending);
-        if (pendingReconstructedRecoveredSigs.count(hash)) {
+        if (pendingReconstructedRecoveredSigs.count(hash) || pendingRecoveredSigHashes.count(hash)) {
             return true;
         }
     }
@@ -366,6 +578,12 @@ bool CSigningManager::GetRecoveredSigForGetData(const uint256& hash, CRecoveredS
     return true;
 }
 
+CSigningManager::RecoveredSigsStats CSigningManager::GetRecoveredSigsStats() const
+{
+    LOCK(cs_stats);
+    return stats;
+}
+
 void CSigningManager::ProcessMessage(CNode* pfrom, const std::string& strCommand, CDataStream& vRecv)
 {
     if (strCommand == NetMsgType::QSIGREC) {
@@ -440,8 +658,18 @@ void CSigningManager::ProcessMessageRecoveredSig(CNode* pfrom, const std::shared
                 recoveredSig->buildSignHash().ToString(), recoveredSig->getId().ToString(), recoveredSig->getMsgHash().ToString(), pfrom->GetId());
         return;
     }
-    
-    pendingRecoveredSigs[pfrom->GetId()].emplace_back(recoveredSig);
+    if (!pendingRecoveredSigHashes.emplace(hash).second) {
+        // SYSCOIN the same sig from another peer is already waiting or being verified
+        LogPrint(BCLog::LLMQ, "CSigningManager::%s -- already pending sig, signHash=%s, id=%s, msgHash=%s, node=%d\n", __func__,
+                recoveredSig->buildSignHash().ToString(), recoveredSig->getId().ToString(), recoveredSig->getMsgHash().ToString(), pfrom->GetId());
+        return;
+    }
+
+    auto& pending = pendingRecoveredSigs[pfrom->GetId()];
+    if (pending.empty()) {
+        pendingRecoveredSigsSinceMs[pfrom->GetId()] = GetTime<std::chrono::milliseconds>().count();
+    }
+    pending.emplace_back(recoveredSig);
 }
 
 void CSigningManager::CollectPendingRecoveredSigsToVerify(
@@ -449,6 +677,9 @@ void CSigningManager::CollectPendingRecoveredSigsToVerify(
         std::unordered_map<NodeId, std::list<std::shared_ptr<const CRecoveredSig>>>& retSigShares,
         std::unordered_map<uint256, CQuorumCPtr, StaticSaltedHasher>& retQuorums)
 {
+    // SYSCOIN one queue wait sample per node, taken from its oldest pending sig
+    std::unordered_set<NodeId> queueWaitNodes;
+    std::vector<int64_t> queueWaitsMs;
     {
         LOCK(cs_pending);
         if (pendingRecoveredSigs.empty()) {
@@ -457,28 +688,52 @@ void CSigningManager::CollectPendingRecoveredSigsToVerify(
 
         // TODO: refactor it to remove duplicated code with `CSigSharesManager::CollectPendingSigSharesToVerify`
         std::unordered_set<std::pair<NodeId, uint256>, StaticSaltedHasher> uniqueSignHashes;
+        const int64_t nowMs = GetTime<std::chrono::milliseconds>().count();
+        // SYSCOIN the already-have checks below hit the db in one batch instead of a read per sig
+        std::vector<uint256> prefetchHashes;
+        for (const auto& [_, ns] : pendingRecoveredSigs) {
+            size_t n = 0;
+            for (auto it = ns.begin(); it != ns.end() && n < maxUniqueSessions; ++it, ++n) {
+                prefetchHashes.emplace_back((*it)->GetHash());
+            }
+        }
+        db.PrefetchHasRecoveredSigForHashes(prefetchHashes);
         IterateNodesRandom(pendingRecoveredSigs, [&]() {
             return uniqueSignHashes.size() < maxUniqueSessions;
         }, [&](NodeId nodeId, std::list<std::shared_ptr<const CRecoveredSig>>& ns) {
             if (ns.empty()) {
                 return false;
             }
+            if (queueWaitNodes.emplace(nodeId).second) {
+                queueWaitsMs.emplace_back(std::max<int64_t>(nowMs - pendingRecoveredSigsSinceMs[nodeId], 0));
+                // the sigs left behind wait for the next collection from here on
+                pendingRecoveredSigsSinceMs[nodeId] = nowMs;
+            }
             auto& recSig = *ns.begin();
 
             bool alreadyHave = db.HasRecoveredSigForHash(recSig->GetHash());
             if (!alreadyHave) {
                 uniqueSignHashes.emplace(nodeId, recSig->buildSignHash());
                 retSigShares[nodeId].emplace_back(recSig);
+            } else {
+                pendingRecoveredSigHashes.erase(recSig->GetHash());
             }
             ns.erase(ns.begin());
             return !ns.empty();
         }, rnd);
+    }
 
-        if (retSigShares.empty()) {
-            return;
+    if (!queueWaitsMs.empty()) {
+        LOCK(cs_stats);
+        for (const int64_t waitMs : queueWaitsMs) {
+            stats.queueWaitMs.Add(waitMs);
         }
     }
+    if (retSigShares.empty()) {
+        return;
+    }
 
+    std::vector<uint256> dropped;
     for (auto& p : retSigShares) {
         NodeId nodeId = p.first;
         auto& v = p.second;
@@ -492,12 +747,14 @@ void CSigningManager::CollectPendingRecoveredSigsToVerify(
                 if (!quorum) {
                     LogPrint(BCLog::LLMQ, "CSigningManager::%s -- quorum %s not found, node=%d\n", __func__,
                               recSig->getQuorumHash().ToString(), nodeId);
+                    dropped.emplace_back(recSig->GetHash());
                     it = v.erase(it);
                     continue;
                 }
                 if (!IsQuorumActive(quorum->qc->quorumHash)) {
                     LogPrint(BCLog::LLMQ, "CSigningManager::%s -- quorum %s not active anymore, node=%d\n", __func__,
                               recSig->getQuorumHash().ToString(), nodeId);
+                    dropped.emplace_back(recSig->GetHash());
                     it = v.erase(it);
                     continue;
                 }
@@ -508,6 +765,13 @@ void CSigningManager::CollectPendingRecoveredSigsToVerify(
             ++it;
         }
     }
+
+    if (!dropped.empty()) {
+        LOCK(cs_pending);
+        for (const auto& hash : dropped) {
+            pendingRecoveredSigHashes.erase(hash);
+        }
+    }
 }
 
 void CSigningManager::ProcessPendingReconstructedRecoveredSigs()
@@ -522,47 +786,59 @@ void CSigningManager::ProcessPendingReconstructedRecoveredSigs()
 
 bool CSigningManager::ProcessPendingRecoveredSigs()
 {
-    std::unordered_map<NodeId, std::list<std::shared_ptr<const CRecoveredSig>>> recSigsByNode;
-    std::unordered_map<uint256, CQuorumCPtr, StaticSaltedHasher> quorums;
-
     ProcessPendingReconstructedRecoveredSigs();
 
     const size_t nMaxBatchSize{32};
-    CollectPendingRecoveredSigsToVerify(nMaxBatchSize, recSigsByNode, quorums);
-    if (recSigsByNode.empty()) {
-        return false;
-    }
-
-    // It's ok to perform insecure batched verification here as we verify against the quorum public keys, which are not
-    // craftable by individual entities, making the rogue public key attack impossible
-    CBLSBatchVerifier<NodeId, uint256> batchVerifier(false, false);
+    auto batch = std::make_shared<RecoveredSigsBatch>();
+    CollectPendingRecoveredSigsToVerify(nMaxBatchSize, batch->recSigsByNode, batch->quorums);
+    const bool fFullBatch = batch->recSigsByNode.size() >= nMaxBatchSize;
 
-    size_t verifyCount = 0;
-    for (const auto& p : recSigsByNode) {
+    for (const auto& p : batch->recSigsByNode) {
         NodeId nodeId = p.first;
         const auto& v = p.second;
 
         for (const auto& recSig : v) {
             // we didn't verify the lazy signature until now
             if (!recSig->sig.Get().IsValid()) {
-                batchVerifier.badSources.emplace(nodeId);
+                batch->batchVerifier.badSources.emplace(nodeId);
                 break;
             }
 
-            const auto& quorum = quorums.at(recSig->getQuorumHash());
-            batchVerifier.PushMessage(nodeId, recSig->GetHash(), recSig->buildSignHash(), recSig->sig.Get(), quorum->qc->quorumPublicKey);
-            verifyCount++;
+            const auto& quorum = batch->quorums.at(recSig->getQuorumHash());
+            batch->batchVerifier.PushMessage(nodeId, recSig->GetHash(), recSig->buildSignHash(), recSig->sig.Get(), quorum->qc->quorumPublicKey);
+            batch->verifyCount++;
         }
     }
 
-    cxxtimer::Timer verifyTimer(true);
-    batchVerifier.Verify();
-    verifyTimer.stop();
+    // SYSCOIN verify this batch on the BLS worker pool while the previous one is processed and its listeners run here
+    auto prevBatch = std::move(inFlightBatch);
+    auto prevVerify = std::move(inFlightVerify);
+    inFlightBatch = nullptr;
+    if (!batch->recSigsByNode.empty()) {
+        inFlightVerify = blsWorker.AsyncRun([batch] {
+            cxxtimer::Timer verifyTimer(true);
+            batch->batchVerifier.Verify();
+            verifyTimer.stop();
+            batch->verifyTime = verifyTimer.count();
+        });
+        inFlightBatch = std::move(batch);
+    }
+    if (prevBatch) {
+        prevVerify.wait();
+        ProcessVerifiedRecoveredSigs(*prevBatch);
+    }
 
-    LogPrint(BCLog::LLMQ, "CSigningManager::%s -- verified recovered sig(s). count=%d, vt=%d, nodes=%d\n", __func__, verifyCount, verifyTimer.count(), recSigsByNode.size());
+    return fFullBatch || inFlightBatch != nullptr;
+}
+
+void CSigningManager::ProcessVerifiedRecoveredSigs(const RecoveredSigsBatch& batch)
+{
+    const auto& batchVerifier = batch.batchVerifier;
+    LogPrint(BCLog::LLMQ, "CSigningManager::%s -- verified recovered sig(s). count=%d, vt=%d, nodes=%d\n", __func__, batch.verifyCount, batch.verifyTime, batch.recSigsByNode.size());
+    WITH_LOCK(cs_stats, stats.batchSize.Add(batch.verifyCount));
 
     std::unordered_set<uint256, StaticSaltedHasher> processed;
-    for (const auto& p : recSigsByNode) {
+    for (const auto& p : batch.recSigsByNode) {
         NodeId nodeId = p.first;
         const auto& v = p.second;
         PeerRef peer = peerman.GetPeerRef(nodeId);
@@ -583,7 +859,13 @@ bool CSigningManager::ProcessPendingRecoveredSigs()
         }
     }
 
-    return recSigsByNode.size() >= nMaxBatchSize;
+    // processed sigs are in the db now, so later copies are caught by HasRecoveredSigForHash
+    LOCK(cs_pending);
+    for (const auto& p : batch.recSigsByNode) {
+        for (const auto& recSig : p.second) {
+            pendingRecoveredSigHashes.erase(recSig->GetHash());
+        }
+    }
 }
 
 // signature must be verified already
@@ -662,6 +944,9 @@ void CSigningManager::ProcessRecoveredSig(NodeId nodeId, const std::shared_ptr<c
 
     db.WriteRecoveredSig(*recoveredSig);
     WITH_LOCK(cs_pending, pendingReconstructedRecoveredSigs.erase(recoveredSig->GetHash()));
+    // SYSCOIN
+    static metrics::Counter& recovered_sigs{metrics::GetCounter("syscoin_llmq_recovered_sigs_total", "Recovered signatures accepted")};
+    recovered_sigs.Inc();
     if (fMasternodeMode) {
         peerman.RelayRecoveredSig(recoveredSig->GetHash());
     }
@@ -857,6 +1142,9 @@ void CSigningManager::WorkThreadMain()
 
         Cleanup();
 
+        // SYSCOIN commit the recovered sigs of this round in one batch
+        db.FlushPendingWrites();
+
         // TODO Wakeup when pending signing is needed?
         if (!fMoreWork && !workInterrupt.sleep_for(std::chrono::milliseconds(100))) {
             return;
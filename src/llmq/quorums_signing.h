@@ -6,6 +6,8 @@
 #define SYSCOIN_LLMQ_QUORUMS_SIGNING_H
 
 #include <bls/bls.h>
+#include <common/bloom.h>
+#include <llmq/quorums_stats.h>
 #include <protocol.h>
 #include <random.h>
 #include <saltedhasher.h>
@@ -13,9 +15,12 @@
 #include <util/threadinterrupt.h>
 #include <unordered_lru_cache.h>
 
+#include <future>
 #include <unordered_map>
+#include <unordered_set>
 
 
+class CBLSWorker;
 class CDataStream;
 class CDBBatch;
 class CDBWrapper;
@@ -105,27 +110,54 @@ public:
 class CRecoveredSigsDb
 {
 private:
+    //! SYSCOIN ids, hashes and signHashes the negative filter remembers, three per recovered sig
+    static constexpr unsigned int NEGATIVE_FILTER_ELEMENTS{300000};
+    //! SYSCOIN written sigs that force a flush before the worker thread gets to it
+    static constexpr size_t MAX_PENDING_WRITES{1000};
+
     std::unique_ptr<CDBWrapper> db{nullptr};
 
     mutable Mutex cs_cache;
     mutable unordered_lru_cache<uint256, bool, StaticSaltedHasher, 30000> hasSigForIdCache GUARDED_BY(cs_cache);
     mutable unordered_lru_cache<uint256, bool, StaticSaltedHasher, 30000> hasSigForSessionCache GUARDED_BY(cs_cache);
     mutable unordered_lru_cache<uint256, bool, StaticSaltedHasher, 30000> hasSigForHashCache GUARDED_BY(cs_cache);
+    // SYSCOIN every id, hash and signHash in the db, so most lookups of unknown sigs never reach leveldb. Only valid
+    // while no more elements were added than it is guaranteed to remember, otherwise it is rebuilt on the next cleanup
+    CRollingBloomFilter negativeFilter GUARDED_BY(cs_cache){NEGATIVE_FILTER_ELEMENTS, 0.001};
+    unsigned int nNegativeFilterElements GUARDED_BY(cs_cache){0};
+    bool fNegativeFilterValid GUARDED_BY(cs_cache){false};
+
+    // SYSCOIN sigs written since the last flush, visible to readers until they are in the db
+    struct PendingRecoveredSig {
+        CRecoveredSig recSig;
+        uint32_t writeTime;
+    };
+    mutable Mutex cs_pendingWrites;
+    std::unordered_map<uint256, PendingRecoveredSig, StaticSaltedHasher> pendingWritesById GUARDED_BY(cs_pendingWrites);
+    std::unordered_map<uint256, uint256, StaticSaltedHasher> pendingIdsByHash GUARDED_BY(cs_pendingWrites);
+    std::unordered_set<uint256, StaticSaltedHasher> pendingSignHashes GUARDED_BY(cs_pendingWrites);
 
 public:
     explicit CRecoveredSigsDb(bool fMemory, bool fWipe);
     ~CRecoveredSigsDb();
 
-    bool HasRecoveredSig(const uint256& id, const uint256& msgHash) const;
-    bool HasRecoveredSigForId(const uint256& id) const EXCLUSIVE_LOCKS_REQUIRED(!cs_cache);
-    bool HasRecoveredSigForSession(const uint256& signHash) const EXCLUSIVE_LOCKS_REQUIRED(!cs_cache);
-    bool HasRecoveredSigForHash(const uint256& hash) const EXCLUSIVE_LOCKS_REQUIRED(!cs_cache);
-    bool GetRecoveredSigByHash(const uint256& hash, CRecoveredSig& ret) const;
-    bool GetRecoveredSigById(const uint256& id, CRecoveredSig& ret) const;
-    void WriteRecoveredSig(const CRecoveredSig& recSig) EXCLUSIVE_LOCKS_REQUIRED(!cs_cache);
-    void TruncateRecoveredSig(const uint256& id) EXCLUSIVE_LOCKS_REQUIRED(!cs_cache);
-
-    void CleanupOldRecoveredSigs(int64_t maxAge) EXCLUSIVE_LOCKS_REQUIRED(!cs_cache);
+    bool HasRecoveredSig(const uint256& id, const uint256& msgHash) const EXCLUSIVE_LOCKS_REQUIRED(!cs_cache, !cs_pendingWrites);
+    bool HasRecoveredSigForId(const uint256& id) const EXCLUSIVE_LOCKS_REQUIRED(!cs_cache, !cs_pendingWrites);
+    bool HasRecoveredSigForSession(const uint256& signHash) const EXCLUSIVE_LOCKS_REQUIRED(!cs_cache, !cs_pendingWrites);
+    bool HasRecoveredSigForHash(const uint256& hash) const EXCLUSIVE_LOCKS_REQUIRED(!cs_cache, !cs_pendingWrites);
+    // SYSCOIN look up the hashes HasRecoveredSigForHash() can't answer from memory in one pass over the db
+    void PrefetchHasRecoveredSigForHashes(const std::vector<uint256>& hashes) const EXCLUSIVE_LOCKS_REQUIRED(!cs_cache, !cs_pendingWrites);
+    bool GetRecoveredSigByHash(const uint256& hash, CRecoveredSig& ret) const EXCLUSIVE_LOCKS_REQUIRED(!cs_pendingWrites);
+    bool GetRecoveredSigById(const uint256& id, CRecoveredSig& ret) const EXCLUSIVE_LOCKS_REQUIRED(!cs_pendingWrites);
+    // SYSCOIN queued for the next FlushPendingWrites(), readers see the sig right away
+    void WriteRecoveredSig(const CRecoveredSig& recSig) EXCLUSIVE_LOCKS_REQUIRED(!cs_cache, !cs_pendingWrites);
+    void TruncateRecoveredSig(const uint256& id) EXCLUSIVE_LOCKS_REQUIRED(!cs_cache, !cs_pendingWrites);
+    // SYSCOIN commit the written sigs in one batch
+    void FlushPendingWrites() EXCLUSIVE_LOCKS_REQUIRED(!cs_pendingWrites);
+
+    void CleanupOldRecoveredSigs(int64_t maxAge) EXCLUSIVE_LOCKS_REQUIRED(!cs_cache, !cs_pendingWrites);
+    // SYSCOIN memory of the has-sig caches
+    size_t GetCacheUsage() const EXCLUSIVE_LOCKS_REQUIRED(!cs_cache);
 
     // votes are removed when the recovered sig is written to the db
     bool HasVotedOnId(const uint256& id) const;
@@ -135,8 +167,13 @@ public:
     void CleanupOldVotes(int64_t maxAge);
 
 private:
-    bool ReadRecoveredSig(const uint256& id, CRecoveredSig& ret) const;
-    void RemoveRecoveredSig(CDBBatch& batch, const uint256& id, bool deleteHashKey, bool deleteTimeKey) EXCLUSIVE_LOCKS_REQUIRED(!cs_cache);
+    bool ReadRecoveredSig(const uint256& id, CRecoveredSig& ret) const EXCLUSIVE_LOCKS_REQUIRED(!cs_pendingWrites);
+    void RemoveRecoveredSig(CDBBatch& batch, const uint256& id, bool deleteHashKey, bool deleteTimeKey) EXCLUSIVE_LOCKS_REQUIRED(!cs_cache, !cs_pendingWrites);
+    void WritePendingWrites() EXCLUSIVE_LOCKS_REQUIRED(cs_pendingWrites);
+    //! SYSCOIN whether the filter rules out that key is in the db
+    bool NotInDb(const uint256& key) const EXCLUSIVE_LOCKS_REQUIRED(cs_cache);
+    void AddToNegativeFilter(const uint256& key) EXCLUSIVE_LOCKS_REQUIRED(cs_cache);
+    void RebuildNegativeFilter() EXCLUSIVE_LOCKS_REQUIRED(!cs_cache);
 };
 
 class CRecoveredSigsListener
@@ -154,25 +191,51 @@ private:
     CRecoveredSigsDb db;
     PeerManager& peerman;
     ChainstateManager& chainman;
+    CBLSWorker& blsWorker;
 
     mutable Mutex cs_pending;
     // Incoming and not verified yet
     std::unordered_map<NodeId, std::list<std::shared_ptr<const CRecoveredSig>>> pendingRecoveredSigs GUARDED_BY(cs_pending);
+    // SYSCOIN hashes of the incoming sigs until they are processed, so copies from other peers are dropped on arrival
+    std::unordered_set<uint256, StaticSaltedHasher> pendingRecoveredSigHashes GUARDED_BY(cs_pending);
     std::unordered_map<uint256, std::shared_ptr<const CRecoveredSig>, StaticSaltedHasher> pendingReconstructedRecoveredSigs GUARDED_BY(cs_pending);
+    // SYSCOIN when the oldest sig in pendingRecoveredSigs of a node was queued, in milliseconds
+    std::unordered_map<NodeId, int64_t> pendingRecoveredSigsSinceMs GUARDED_BY(cs_pending);
 
     FastRandomContext rnd GUARDED_BY(cs_pending);
 
     int64_t lastCleanupTime{0};
 
+    // SYSCOIN the batch verifying on the BLS worker pool while the worker thread processes the one before it
+    struct RecoveredSigsBatch;
+    std::shared_ptr<RecoveredSigsBatch> inFlightBatch;
+    std::future<void> inFlightVerify;
+
     mutable Mutex cs_listeners;
     std::vector<CRecoveredSigsListener*> recoveredSigsListeners GUARDED_BY(cs_listeners);
 
 public:
-    CSigningManager(bool fMemory, PeerManager& _peerman, ChainstateManager& _chainman, bool fWipe);
+    /** Verification of incoming recovered sigs since startup */
+    struct RecoveredSigsStats {
+        // how long the oldest pending sig of a node waited to be collected for verification, in milliseconds
+        CLatencyHistogram queueWaitMs;
+        // sigs per verification batch
+        CLatencyHistogram batchSize;
+    };
+
+private:
+    mutable Mutex cs_stats;
+    RecoveredSigsStats stats GUARDED_BY(cs_stats);
+
+public:
+    CSigningManager(bool fMemory, PeerManager& _peerman, ChainstateManager& _chainman, CBLSWorker& _blsWorker, bool fWipe);
 
 
     bool AlreadyHave(const uint256& hash) const EXCLUSIVE_LOCKS_REQUIRED(!cs_pending);
     bool GetRecoveredSigForGetData(const uint256& hash, CRecoveredSig& ret) const;
+    // SYSCOIN
+    size_t GetRecoveredSigsCacheUsage() const { return db.GetCacheUsage(); }
+    RecoveredSigsStats GetRecoveredSigsStats() const EXCLUSIVE_LOCKS_REQUIRED(!cs_stats);
 
     void ProcessMessage(CNode* pnode, const std::string& strCommand, CDataStream& vRecv) EXCLUSIVE_LOCKS_REQUIRED(!cs_pending);
 
@@ -191,9 +254,10 @@ private:
 
     void CollectPendingRecoveredSigsToVerify(size_t maxUniqueSessions,
             std::unordered_map<NodeId, std::list<std::shared_ptr<const CRecoveredSig>>>& retSigShares,
-            std::unordered_map<uint256, CQuorumCPtr, StaticSaltedHasher>& retQuorums) EXCLUSIVE_LOCKS_REQUIRED(!cs_pending);
+            std::unordered_map<uint256, CQuorumCPtr, StaticSaltedHasher>& retQuorums) EXCLUSIVE_LOCKS_REQUIRED(!cs_pending, !cs_stats);
     void ProcessPendingReconstructedRecoveredSigs() EXCLUSIVE_LOCKS_REQUIRED(!cs_pending, !cs_listeners);
-    bool ProcessPendingRecoveredSigs() EXCLUSIVE_LOCKS_REQUIRED(!cs_pending, !cs_listeners); // called from the worker thread of CSigSharesManager
+    bool ProcessPendingRecoveredSigs() EXCLUSIVE_LOCKS_REQUIRED(!cs_pending, !cs_listeners, !cs_stats); // called from the worker thread of CSigSharesManager
+    void ProcessVerifiedRecoveredSigs(const RecoveredSigsBatch& batch) EXCLUSIVE_LOCKS_REQUIRED(!cs_pending, !cs_listeners, !cs_stats);
 public:
     // TODO - should not be public!
     void ProcessRecoveredSig(NodeId nodeId, const std::shared_ptr<const CRecoveredSig>& recoveredSig) EXCLUSIVE_LOCKS_REQUIRED(!cs_pending, !cs_listeners);
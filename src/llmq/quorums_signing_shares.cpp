@@ -10,6 +10,7 @@
 #include <evo/deterministicmns.h>
 #include <masternode/activemasternode.h>
 #include <bls/bls_batchverifier.h>
+#include <bls/bls_worker.h>
 #include <init.h>
 #include <net_processing.h>
 #include <netmessagemaker.h>
@@ -17,16 +18,45 @@
 #include <timedata.h>
 #include <cxxtimer.hpp>
 #include <util/thread.h>
+#include <util/trace.h>
 #include <logging.h>
+
+#include <algorithm>
+#include <future>
+#include <set>
+
 namespace llmq
 {
 
 CSigSharesManager* quorumSigSharesManager = nullptr;
 
-void CSigShare::UpdateKey()
+// SYSCOIN expired sessions are swept once their count doubled, but not below this
+static constexpr size_t SIG_SHARE_SESSIONS_MIN_SWEEP_SIZE{1024};
+static Mutex cs_sigShareSessions;
+static std::unordered_map<uint256, std::weak_ptr<const CSigShareSession>, StaticSaltedHasher> mapSigShareSessions GUARDED_BY(cs_sigShareSessions);
+static size_t nSigShareSessionsSweepSize GUARDED_BY(cs_sigShareSessions){SIG_SHARE_SESSIONS_MIN_SWEEP_SIZE};
+
+CSigShareSessionCPtr InternSigShareSession(const uint256& quorumHash, const uint256& id, const uint256& msgHash)
 {
-    key.first = this->buildSignHash();
-    key.second = quorumMember;
+    const uint256 signHash = BuildSignHash(quorumHash, id, msgHash);
+    LOCK(cs_sigShareSessions);
+    auto& entry = mapSigShareSessions[signHash];
+    if (CSigShareSessionCPtr session = entry.lock()) {
+        return session;
+    }
+    auto session = std::make_shared<const CSigShareSession>(CSigShareSession{quorumHash, id, msgHash, signHash});
+    entry = session;
+    if (mapSigShareSessions.size() >= nSigShareSessionsSweepSize) {
+        for (auto it = mapSigShareSessions.begin(); it != mapSigShareSessions.end(); ) {
+            if (it->second.expired()) {
+                it = mapSigShareSessions.erase(it);
+            } else {
+                ++it;
+            }
+        }
+        nSigShareSessionsSweepSize = std::max(SIG_SHARE_SESSIONS_MIN_SWEEP_SIZE, mapSigShareSessions.size() * 2);
+    }
+    return session;
 }
 
 std::string CSigSesAnn::ToString() const
@@ -95,14 +125,11 @@ std::string CBatchedSigShares::ToInvString() const
     return inv.ToString();
 }
 
-static void InitSession(CSigSharesNodeState::Session& s, const uint256& signHash, CSigBase from)
+static void InitSession(CSigSharesNodeState::Session& s, CSigShareSessionCPtr shareSession)
 {
     const auto& params = Params().GetConsensus().llmqTypeChainLocks;
 
-    s.quorumHash = from.getQuorumHash();
-    s.id = from.getId();
-    s.msgHash = from.getMsgHash();
-    s.signHash = signHash;
+    s.shareSession = std::move(shareSession);
     s.announced.Init((size_t)params.size);
     s.requested.Init((size_t)params.size);
     s.knows.Init((size_t)params.size);
@@ -112,17 +139,17 @@ CSigSharesNodeState::Session& CSigSharesNodeState::GetOrCreateSessionFromShare(c
 {
     auto& s = sessions[sigShare.GetSignHash()];
     if (s.announced.inv.empty()) {
-        InitSession(s, sigShare.GetSignHash(), sigShare);
+        InitSession(s, sigShare.GetSession());
     }
     return s;
 }
 
 CSigSharesNodeState::Session& CSigSharesNodeState::GetOrCreateSessionFromAnn(const llmq::CSigSesAnn& ann)
 {
-    auto signHash = ann.buildSignHash();
-    auto& s = sessions[signHash];
+    auto shareSession = InternSigShareSession(ann.getQuorumHash(), ann.getId(), ann.getMsgHash());
+    auto& s = sessions[shareSession->signHash];
     if (s.announced.inv.empty()) {
-        InitSession(s, signHash, ann);
+        InitSession(s, std::move(shareSession));
     }
     return s;
 }
@@ -151,10 +178,7 @@ bool CSigSharesNodeState::GetSessionInfoByRecvId(uint32_t sessionId, SessionInfo
     if (s == nullptr) {
         return false;
     }
-    retInfo.quorumHash = s->quorumHash;
-    retInfo.id = s->id;
-    retInfo.msgHash = s->msgHash;
-    retInfo.signHash = s->signHash;
+    retInfo.shareSession = s->shareSession;
     retInfo.quorum = s->quorum;
 
     return true;
@@ -170,6 +194,21 @@ void CSigSharesNodeState::RemoveSession(const uint256& signHash)
     pendingIncomingSigShares.EraseAllForSignHash(signHash);
 }
 
+// SYSCOIN the bits of an inventory are packed, memusage would count a byte for each
+static size_t InvMemoryUsage(const CSigSharesInv& inv)
+{
+    return inv.inv.capacity() == 0 ? 0 : memusage::MallocUsage((inv.inv.capacity() + 7) / 8);
+}
+
+size_t CSigSharesNodeState::DynamicMemoryUsage() const
+{
+    size_t usage = memusage::DynamicUsage(sessions) + memusage::DynamicUsage(sessionByRecvId);
+    for (const auto& [signHash, session] : sessions) {
+        usage += InvMemoryUsage(session.announced) + InvMemoryUsage(session.requested) + InvMemoryUsage(session.knows);
+    }
+    return usage + pendingIncomingSigShares.DynamicMemoryUsage() + requestedSigShares.DynamicMemoryUsage();
+}
+
 //////////////////////
 
 void CSigSharesManager::StartWorkerThread()
@@ -207,6 +246,12 @@ void CSigSharesManager::UnregisterAsRecoveredSigsListener()
 void CSigSharesManager::InterruptWorkerThread()
 {
     workInterrupt();
+    {
+        // the work thread waits on its own condition variable, taking the lock makes sure it either sees
+        // the interrupt before waiting or gets the notification
+        LOCK(cs_workWakeup);
+    }
+    workWakeupCv.notify_all();
 }
 
 void CSigSharesManager::ProcessMessage(const CNode* pfrom, const std::string& strCommand, CDataStream& vRecv)
@@ -341,17 +386,17 @@ bool CSigSharesManager::ProcessMessageSigSharesInv(const CNode* pfrom, const CSi
     }
 
     // TODO for PoSe, we should consider propagating shares even if we already have a recovered sig
-    if (quorumSigningManager->HasRecoveredSigForSession(sessionInfo.signHash)) {
+    if (quorumSigningManager->HasRecoveredSigForSession(sessionInfo.shareSession->signHash)) {
         return true;
     }
 
     LogPrint(BCLog::LLMQ_SIGS, "CSigSharesManager::%s -- signHash=%s, inv={%s}, node=%d\n", __func__,
-            sessionInfo.signHash.ToString(), inv.ToString(), pfrom->GetId());
+            sessionInfo.shareSession->signHash.ToString(), inv.ToString(), pfrom->GetId());
 
     if (!sessionInfo.quorum->HasVerificationVector()) {
         // TODO we should allow to ask other nodes for the quorum vvec if we missed it in the DKG
         LogPrint(BCLog::LLMQ_SIGS, "CSigSharesManager::%s -- we don't have the quorum vvec for %s, not requesting sig shares. node=%d\n", __func__,
-                  sessionInfo.quorumHash.ToString(), pfrom->GetId());
+                  sessionInfo.shareSession->quorumHash.ToString(), pfrom->GetId());
         return true;
     }
 
@@ -378,12 +423,12 @@ bool CSigSharesManager::ProcessMessageGetSigShares(const CNode* pfrom, const CSi
     }
 
     // TODO for PoSe, we should consider propagating shares even if we already have a recovered sig
-    if (quorumSigningManager->HasRecoveredSigForSession(sessionInfo.signHash)) {
+    if (quorumSigningManager->HasRecoveredSigForSession(sessionInfo.shareSession->signHash)) {
         return true;
     }
 
     LogPrint(BCLog::LLMQ_SIGS, "CSigSharesManager::%s -- signHash=%s, inv={%s}, node=%d\n", __func__,
-            sessionInfo.signHash.ToString(), inv.ToString(), pfrom->GetId());
+            sessionInfo.shareSession->signHash.ToString(), inv.ToString(), pfrom->GetId());
 
     LOCK(cs);
     auto& nodeState = nodeStates[pfrom->GetId()];
@@ -428,6 +473,7 @@ bool CSigSharesManager::ProcessMessageBatchedSigShares(const CNode* pfrom, const
 
             // TODO for PoSe, we should consider propagating shares even if we already have a recovered sig
             if (quorumSigningManager->HasRecoveredSigForId(sigShare.getId())) {
+                lateSigShares++;
                 continue;
             }
 
@@ -436,17 +482,23 @@ bool CSigSharesManager::ProcessMessageBatchedSigShares(const CNode* pfrom, const
     }
 
     LogPrint(BCLog::LLMQ_SIGS, "CSigSharesManager::%s -- signHash=%s, shares=%d, new=%d, inv={%s}, node=%d\n", __func__,
-             sessionInfo.signHash.ToString(), batchedSigShares.sigShares.size(), sigSharesToProcess.size(), batchedSigShares.ToInvString(), pfrom->GetId());
+             sessionInfo.shareSession->signHash.ToString(), batchedSigShares.sigShares.size(), sigSharesToProcess.size(), batchedSigShares.ToInvString(), pfrom->GetId());
 
     if (sigSharesToProcess.empty()) {
         return true;
     }
 
-    LOCK(cs);
-    auto& nodeState = nodeStates[pfrom->GetId()];
-    for (const auto& s : sigSharesToProcess) {
-        nodeState.pendingIncomingSigShares.Add(s.GetKey(), s);
+    {
+        LOCK(cs);
+        auto& nodeState = nodeStates[pfrom->GetId()];
+        if (nodeState.pendingIncomingSigShares.Empty()) {
+            nodeState.pendingIncomingSinceMs = GetTime<std::chrono::milliseconds>().count();
+        }
+        for (const auto& s : sigSharesToProcess) {
+            nodeState.pendingIncomingSigShares.Add(s.GetKey(), s);
+        }
     }
+    NotifyWork(sigSharesToProcess.size());
     return true;
 }
 
@@ -490,12 +542,17 @@ void CSigSharesManager::ProcessMessageSigShare(NodeId fromId, const CSigShare& s
         }
 
         if (quorumSigningManager->HasRecoveredSigForId(sigShare.getId())) {
+            lateSigShares++;
             return;
         }
 
         auto& nodeState = nodeStates[fromId];
+        if (nodeState.pendingIncomingSigShares.Empty()) {
+            nodeState.pendingIncomingSinceMs = GetTime<std::chrono::milliseconds>().count();
+        }
         nodeState.pendingIncomingSigShares.Add(sigShare.GetKey(), sigShare);
     }
+    NotifyWork(1);
 
     LogPrint(BCLog::LLMQ_SIGS, "CSigSharesManager::%s -- signHash=%s, id=%s, msgHash=%s, member=%d, node=%d\n", __func__,
              sigShare.GetSignHash().ToString(), sigShare.getId().ToString(), sigShare.getMsgHash().ToString(), sigShare.getQuorumMember(), fromId);
@@ -516,7 +573,7 @@ bool CSigSharesManager::PreVerifyBatchedSigShares(const CSigSharesNodeState::Ses
     if (!session.quorum->HasVerificationVector()) {
         // TODO we should allow to ask other nodes for the quorum vvec if we missed it in the DKG
         LogPrint(BCLog::LLMQ_SIGS, "CSigSharesManager::%s -- we don't have the quorum vvec for %s, no verification possible.\n", __func__,
-                  session.quorumHash.ToString());
+                  session.shareSession->quorumHash.ToString());
         return false;
     }
 
@@ -547,6 +604,9 @@ bool CSigSharesManager::CollectPendingSigSharesToVerify(
         std::unordered_map<NodeId, std::vector<CSigShare>>& retSigShares,
         std::unordered_map<uint256, CQuorumCPtr, StaticSaltedHasher>& retQuorums)
 {
+    // SYSCOIN one queue wait sample per node, taken from its oldest pending share
+    std::unordered_set<NodeId> queueWaitNodes;
+    std::vector<int64_t> queueWaitsMs;
     {
         LOCK(cs);
         if (nodeStates.empty()) {
@@ -559,6 +619,7 @@ bool CSigSharesManager::CollectPendingSigSharesToVerify(
         // invalid, making batch verification fail and revert to per-share verification, which in turn would slow down
         // the whole verification process
         std::unordered_set<std::pair<NodeId, uint256>, StaticSaltedHasher> uniqueSignHashes;
+        const int64_t nowMs = GetTime<std::chrono::milliseconds>().count();
         IterateNodesRandom(
             nodeStates,
             [&]() {
@@ -570,6 +631,9 @@ bool CSigSharesManager::CollectPendingSigSharesToVerify(
                 if (ns.pendingIncomingSigShares.Empty()) {
                     return false;
                 }
+                if (queueWaitNodes.emplace(nodeId).second) {
+                    queueWaitsMs.emplace_back(std::max<int64_t>(nowMs - ns.pendingIncomingSinceMs, 0));
+                }
                 const auto& sigShare = *ns.pendingIncomingSigShares.GetFirst();
 
                 AssertLockHeld(cs);
@@ -582,11 +646,22 @@ bool CSigSharesManager::CollectPendingSigSharesToVerify(
             },
             rnd);
 
-        if (retSigShares.empty()) {
-            return false;
+        // the shares left behind wait for the next collection from here on
+        for (const NodeId nodeId : queueWaitNodes) {
+            nodeStates.at(nodeId).pendingIncomingSinceMs = nowMs;
         }
     }
 
+    if (!queueWaitsMs.empty()) {
+        LOCK(cs_workStats);
+        for (const int64_t waitMs : queueWaitsMs) {
+            workStats.queueWaitMs.Add(waitMs);
+        }
+    }
+    if (retSigShares.empty()) {
+        return false;
+    }
+
     // For the convenience of the caller, also build a map of quorumHash -> quorum
 
     for (const auto& [_, vecSigShares] : retSigShares) {
@@ -617,14 +692,19 @@ bool CSigSharesManager::ProcessPendingSigShares()
     std::unordered_map<uint256, CQuorumCPtr, StaticSaltedHasher> quorums;
 
     const size_t nMaxBatchSize{32};
+    cxxtimer::Timer collectTimer(true);
     bool collect_status = CollectPendingSigSharesToVerify(nMaxBatchSize, sigSharesByNodes, quorums);
+    collectTimer.stop();
     if (!collect_status || sigSharesByNodes.empty()) {
         return false;
     }
 
+    // SYSCOIN one batch per sign hash, so the sessions of different quorums and requests verify in parallel on the
+    // BLS worker pool and an invalid share only makes its own batch fall back to per source verification.
     // It's ok to perform insecure batched verification here as we verify against the quorum public key shares,
     // which are not craftable by individual entities, making the rogue public key attack impossible
-    CBLSBatchVerifier<NodeId, SigShareKey> batchVerifier(false, true);
+    using BatchVerifier = CBLSBatchVerifier<NodeId, SigShareKey>;
+    std::unordered_map<uint256, BatchVerifier, StaticSaltedHasher> batchVerifiers;
 
     cxxtimer::Timer prepareTimer(true);
     size_t verifyCount = 0;
@@ -652,6 +732,7 @@ bool CSigSharesManager::ProcessPendingSigShares()
                 assert(false);
             }
 
+            auto& batchVerifier = batchVerifiers.try_emplace(sigShare.GetSignHash(), false, true).first->second;
             batchVerifier.PushMessage(nodeId, sigShare.GetKey(), sigShare.GetSignHash(), sigShare.sigShare.Get(), pubKeyShare);
             verifyCount++;
         }
@@ -659,13 +740,33 @@ bool CSigSharesManager::ProcessPendingSigShares()
     prepareTimer.stop();
 
     cxxtimer::Timer verifyTimer(true);
-    batchVerifier.Verify();
+    std::vector<std::future<void>> futures;
+    if (!batchVerifiers.empty()) {
+        futures.reserve(batchVerifiers.size() - 1);
+        auto it = batchVerifiers.begin();
+        for (; std::next(it) != batchVerifiers.end(); ++it) {
+            auto& batchVerifier = it->second;
+            futures.emplace_back(blsWorker.AsyncRun([&batchVerifier] { batchVerifier.Verify(); }));
+        }
+        // verify the last batch here instead of waiting idle for the pool
+        it->second.Verify();
+    }
+    for (auto& f : futures) {
+        f.get();
+    }
+    std::set<NodeId> badSources;
+    for (const auto& [_, batchVerifier] : batchVerifiers) {
+        badSources.insert(batchVerifier.badSources.begin(), batchVerifier.badSources.end());
+    }
     verifyTimer.stop();
 
-    LogPrint(BCLog::LLMQ_SIGS, "CSigSharesManager::%s -- verified sig shares. count=%d, pt=%d, vt=%d, nodes=%d\n", __func__, verifyCount, prepareTimer.count(), verifyTimer.count(), sigSharesByNodes.size());
+    LogPrint(BCLog::LLMQ_SIGS, "CSigSharesManager::%s -- verified sig shares. count=%d, batches=%d, pt=%d, vt=%d, nodes=%d\n", __func__, verifyCount, batchVerifiers.size(), prepareTimer.count(), verifyTimer.count(), sigSharesByNodes.size());
+    TRACE5(llmq, sigshares_verified, verifyCount, batchVerifiers.size(), sigSharesByNodes.size(), badSources.size(),
+        verifyTimer.count<std::chrono::microseconds>());
 
+    cxxtimer::Timer processTimer(true);
     for (const auto& [nodeId, v] : sigSharesByNodes) {
-        if (batchVerifier.badSources.count(nodeId) != 0) {
+        if (badSources.count(nodeId) != 0) {
             LogPrint(BCLog::LLMQ_SIGS, "CSigSharesManager::%s -- invalid sig shares from other node, banning peer=%d\n",
                      __func__, nodeId);
             // this will also cause re-requesting of the shares that were sent by this node
@@ -675,6 +776,20 @@ bool CSigSharesManager::ProcessPendingSigShares()
 
         ProcessPendingSigShares(v, quorums);
     }
+    processTimer.stop();
+
+    {
+        LOCK(cs_workStats);
+        workStats.collect.Add(collectTimer.count<std::chrono::microseconds>());
+        workStats.prepare.Add(prepareTimer.count<std::chrono::microseconds>());
+        workStats.verify.Add(verifyTimer.count<std::chrono::microseconds>());
+        workStats.process.Add(processTimer.count<std::chrono::microseconds>());
+        workStats.verifiedSigShares += verifyCount;
+        workStats.verifyBatches += batchVerifiers.size();
+        for (const auto& [_, batchVerifier] : batchVerifiers) {
+            workStats.verifyBatchSize.Add(batchVerifier.GetMessageCount());
+        }
+    }
 
     return sigSharesByNodes.size() >= nMaxBatchSize;
 }
@@ -721,6 +836,7 @@ void CSigSharesManager::ProcessSigShare(const CSigShare& sigShare, const CQuorum
 
         // Update the time we've seen the last sigShare
         timeSeenForSessions[sigShare.GetSignHash()] = GetTime<std::chrono::seconds>().count();
+        firstSeenForSessions.try_emplace(sigShare.GetSignHash(), GetTime<std::chrono::milliseconds>().count());
 
 
         // don't announce and wait for other nodes to request this share and directly send it to them
@@ -751,7 +867,7 @@ void CSigSharesManager::TryRecoverSig(const CQuorumCPtr& quorum, const uint256&
     }
     const auto& params = Params().GetConsensus().llmqTypeChainLocks;
     std::vector<CBLSSignature> sigSharesForRecovery;
-    std::vector<CBLSId> idsForRecovery;
+    std::vector<uint16_t> membersForRecovery;
     {
         LOCK(cs);
 
@@ -761,24 +877,34 @@ void CSigSharesManager::TryRecoverSig(const CQuorumCPtr& quorum, const uint256&
             return;
         }
 
-        sigSharesForRecovery.reserve((size_t) params.threshold);
-        idsForRecovery.reserve((size_t) params.threshold);
-        for (auto it = sigSharesForSignHash->begin(); it != sigSharesForSignHash->end() && sigSharesForRecovery.size() < (size_t)params.threshold; ++it) {
-            auto& sigShare = it->second;
-            sigSharesForRecovery.emplace_back(sigShare.sigShare.Get());
-            idsForRecovery.emplace_back(quorum->members[sigShare.getQuorumMember()]->proTxHash);
-        }
-
         // check if we can recover the final signature
-        if (sigSharesForRecovery.size() < (size_t)params.threshold) {
+        if (sigSharesForSignHash->size() < (size_t)params.threshold) {
             return;
         }
+
+        // SYSCOIN always use the lowest members that have a share, so consecutive sessions mostly recover with the
+        // same member set and its Lagrange coefficients come from the quorum's cache
+        std::vector<const CSigShare*> sorted;
+        sorted.reserve(sigSharesForSignHash->size());
+        for (const auto& [_, sigShare] : *sigSharesForSignHash) {
+            sorted.emplace_back(&sigShare);
+        }
+        std::partial_sort(sorted.begin(), sorted.begin() + params.threshold, sorted.end(), [](const CSigShare* a, const CSigShare* b) {
+            return a->getQuorumMember() < b->getQuorumMember();
+        });
+        sigSharesForRecovery.reserve((size_t) params.threshold);
+        membersForRecovery.reserve((size_t) params.threshold);
+        for (size_t i = 0; i < (size_t)params.threshold; i++) {
+            sigSharesForRecovery.emplace_back(sorted[i]->sigShare.Get());
+            membersForRecovery.emplace_back(sorted[i]->getQuorumMember());
+        }
     }
 
     // now recover it
     cxxtimer::Timer t(true);
     CBLSSignature recoveredSig;
-    if (!recoveredSig.Recover(sigSharesForRecovery, idsForRecovery)) {
+    const auto coefficients = quorum->GetLagrangeCoefficients(membersForRecovery);
+    if (!coefficients || !recoveredSig.Recover(sigSharesForRecovery, *coefficients)) {
         LogPrint(BCLog::LLMQ_SIGS, "CSigSharesManager::%s -- failed to recover signature. id=%s, msgHash=%s, time=%d\n", __func__,
                   id.ToString(), msgHash.ToString(), t.count());
         return;
@@ -794,7 +920,7 @@ void CSigSharesManager::TryRecoverSig(const CQuorumCPtr& quorum, const uint256&
     // verification because this is unbatched and thus slow verification that happens here.
     if (((recoveredSigsCounter++) % 100) == 0) {
         auto signHash = rs->buildSignHash();
-        bool valid = recoveredSig.VerifyInsecure(quorum->qc->quorumPublicKey, signHash);
+        bool valid = recoveredSig.VerifyInsecure(quorum->preparedPublicKey, signHash);
         if (!valid) {
             // this should really not happen as we have verified all signature shares before
             LogPrintf("CSigSharesManager::%s -- own recovered signature is invalid. id=%s, msgHash=%s\n", __func__,
@@ -1092,7 +1218,7 @@ bool CSigSharesManager::SendMessages()
 
             sigSessionAnnouncements[nodeId].emplace_back(
                 CSigSesAnn(/*sessionId=*/session->sendSessionId,
-                           /*quorumHash=*/session->quorumHash, /*id=*/session->id, /*msgHash=*/session->msgHash)
+                           /*quorumHash=*/session->shareSession->quorumHash, /*id=*/session->shareSession->id, /*msgHash=*/session->shareSession->msgHash)
             );
         }
         return session->sendSessionId;
@@ -1169,7 +1295,7 @@ bool CSigSharesManager::SendMessages()
         if (const auto jt = sigShareBatchesToSend.find(pnode->GetId()); jt != sigShareBatchesToSend.end()) {
             size_t totalSigsCount = 0;
             std::vector<CBatchedSigShares> msgs;
-            for (const auto& [signHash, inv] : jt->second) {
+            for (auto& [signHash, inv] : jt->second) {
                 assert(!inv.sigShares.empty());
                 LogPrint(BCLog::LLMQ_SIGS, "CSigSharesManager::SendMessages -- QBSIGSHARES signHash=%s, inv={%s}, node=%d\n",
                          signHash.ToString(), inv.ToInvString(), pnode->GetId());
@@ -1180,7 +1306,8 @@ bool CSigSharesManager::SendMessages()
                     didSend = true;
                 }
                 totalSigsCount += inv.sigShares.size();
-                msgs.emplace_back(inv);
+                // the batches of a node are only sent once, so they move into the message instead of copying the shares
+                msgs.emplace_back(std::move(inv));
 
             }
             if (!msgs.empty()) {
@@ -1240,9 +1367,7 @@ bool CSigSharesManager::GetSessionInfoByRecvId(NodeId nodeId, uint32_t sessionId
 CSigShare CSigSharesManager::RebuildSigShare(const CSigSharesNodeState::SessionInfo& session, const std::pair<uint16_t, CBLSLazySignature>& in)
 {
     const auto& [member, sig] = in;
-    CSigShare sigShare(session.quorumHash, session.id, session.msgHash, member, sig);
-    sigShare.UpdateKey();
-    return sigShare;
+    return CSigShare(session.shareSession, member, sig);
 }
 
 void CSigSharesManager::Cleanup()
@@ -1395,6 +1520,7 @@ void CSigSharesManager::RemoveSigSharesForSession(const uint256& signHash)
     sigShares.EraseAllForSignHash(signHash);
     signedSessions.erase(signHash);
     timeSeenForSessions.erase(signHash);
+    firstSeenForSessions.erase(signHash);
 }
 
 void CSigSharesManager::RemoveBannedNodeStates()
@@ -1445,34 +1571,116 @@ void CSigSharesManager::BanNode(NodeId nodeId)
     nodeState.banned = true;
 }
 
+void CSigSharesManager::NotifyWork(size_t count)
+{
+    bool notify;
+    {
+        LOCK(cs_workWakeup);
+        // the first pending share wakes the thread so it can wait for the rest of the batch on the short timeout
+        notify = nPendingWakeupWork == 0 || nPendingWakeupWork + count >= WAKEUP_PENDING_SIG_SHARES;
+        nPendingWakeupWork += count;
+    }
+    if (notify) {
+        workWakeupCv.notify_one();
+    }
+}
+
+bool CSigSharesManager::WaitForWork(std::chrono::milliseconds timeout)
+{
+    WAIT_LOCK(cs_workWakeup, lock);
+    workWakeupCv.wait_for(lock, timeout, [this]() EXCLUSIVE_LOCKS_REQUIRED(cs_workWakeup) {
+        return nPendingWakeupWork > 0 || workInterrupt;
+    });
+    if (nPendingWakeupWork > 0 && nPendingWakeupWork < WAKEUP_PENDING_SIG_SHARES) {
+        // more shares of the same signing round are usually right behind, verify them in one batch
+        workWakeupCv.wait_for(lock, std::min(timeout, WAKEUP_BATCH_WAIT), [this]() EXCLUSIVE_LOCKS_REQUIRED(cs_workWakeup) {
+            return nPendingWakeupWork >= WAKEUP_PENDING_SIG_SHARES || workInterrupt;
+        });
+    }
+    // everything counted so far is picked up by the next round
+    nPendingWakeupWork = 0;
+    return !workInterrupt;
+}
+
 void CSigSharesManager::WorkThreadMain()
 {
-    int64_t lastSendTime = 0;
+    auto lastSendTime = SystemClock::now() - SEND_INTERVAL;
+    auto lastStatsLogTime = SystemClock::now();
 
     while (!workInterrupt) {
         RemoveBannedNodeStates();
 
         bool fMoreWork = ProcessPendingSigShares();
+
+        cxxtimer::Timer signTimer(true);
         SignPendingSigShares();
+        signTimer.stop();
+        WITH_LOCK(cs_workStats, workStats.sign.Add(signTimer.count<std::chrono::microseconds>()));
 
-        if (TicksSinceEpoch<std::chrono::milliseconds>(SystemClock::now()) - lastSendTime > 100) {
+        if (SystemClock::now() - lastSendTime >= SEND_INTERVAL) {
+            cxxtimer::Timer sendTimer(true);
             SendMessages();
-            lastSendTime = TicksSinceEpoch<std::chrono::milliseconds>(SystemClock::now());
+            sendTimer.stop();
+            WITH_LOCK(cs_workStats, workStats.send.Add(sendTimer.count<std::chrono::microseconds>()));
+            lastSendTime = SystemClock::now();
         }
 
         Cleanup();
 
-        // TODO Wakeup when pending signing is needed?
-        if (!fMoreWork && !workInterrupt.sleep_for(std::chrono::milliseconds(100))) {
+        if (SystemClock::now() - lastStatsLogTime >= STATS_LOG_INTERVAL) {
+            if (LogAcceptCategory(BCLog::LLMQ_SIGS, BCLog::Level::Debug)) {
+                LogWorkStats();
+            }
+            lastStatsLogTime = SystemClock::now();
+        }
+
+        if (fMoreWork) {
+            continue;
+        }
+        // sleep until new shares arrive or it is time to send again, whichever comes first
+        const auto untilSend = std::chrono::duration_cast<std::chrono::milliseconds>(lastSendTime + SEND_INTERVAL - SystemClock::now());
+        if (!WaitForWork(std::max(untilSend, std::chrono::milliseconds{1}))) {
             return;
         }
     }
 }
 
+CSigSharesManager::WorkStats CSigSharesManager::GetWorkStats() const
+{
+    LOCK(cs_workStats);
+    WorkStats ret = workStats;
+    ret.lateSigShares = lateSigShares;
+    return ret;
+}
+
+size_t CSigSharesManager::DynamicMemoryUsage()
+{
+    LOCK(cs);
+    size_t usage = sigShares.DynamicMemoryUsage() + memusage::DynamicUsage(signedSessions) +
+                   memusage::DynamicUsage(timeSeenForSessions) + memusage::DynamicUsage(firstSeenForSessions) +
+                   memusage::DynamicUsage(nodeStates) + sigSharesRequested.DynamicMemoryUsage() +
+                   sigSharesQueuedToAnnounce.DynamicMemoryUsage();
+    for (const auto& [nodeId, nodeState] : nodeStates) {
+        usage += nodeState.DynamicMemoryUsage();
+    }
+    return usage;
+}
+
+void CSigSharesManager::LogWorkStats() const
+{
+    const auto stats = GetWorkStats();
+    LogPrint(BCLog::LLMQ_SIGS, "CSigSharesManager::%s -- recovery_ms={%s}, queue_wait_ms={%s}, batch_size={%s}, late=%d\n", __func__,
+             stats.sessionRecoveryMs.ToString(), stats.queueWaitMs.ToString(), stats.verifyBatchSize.ToString(), stats.lateSigShares);
+    const auto recSigStats = quorumSigningManager->GetRecoveredSigsStats();
+    LogPrint(BCLog::LLMQ_SIGS, "CSigSharesManager::%s -- recsig_queue_wait_ms={%s}, recsig_batch_size={%s}\n", __func__,
+             recSigStats.queueWaitMs.ToString(), recSigStats.batchSize.ToString());
+}
+
 void CSigSharesManager::AsyncSign(const CQuorumCPtr& quorum, const uint256& id, const uint256& msgHash)
 {
-    LOCK(cs_pendingSigns);
-    pendingSigns.emplace_back(quorum, id, msgHash);
+    WITH_LOCK(cs_pendingSigns, pendingSigns.emplace_back(quorum, id, msgHash));
+    // our own share is needed by the other members right away
+    NotifyWork(WAKEUP_PENDING_SIG_SHARES);
 }
 
 void CSigSharesManager::SignPendingSigShares()
@@ -1521,7 +1729,7 @@ std::optional<CSigShare> CSigSharesManager::CreateSigShare(const CQuorumCPtr& qu
     }
 
     CSigShare sigShare(quorum->qc->quorumHash, id, msgHash, uint16_t(memberIdx), {});
-    uint256 signHash = sigShare.buildSignHash();
+    const uint256& signHash = sigShare.GetSignHash();
 
     sigShare.sigShare.Set(skShare.Sign(signHash, bls::bls_legacy_scheme.load()), bls::bls_legacy_scheme.load());
     if (!sigShare.sigShare.Get().IsValid()) {
@@ -1529,8 +1737,8 @@ std::optional<CSigShare> CSigSharesManager::CreateSigShare(const CQuorumCPtr& qu
                   signHash.ToString(), sigShare.getId().ToString(), sigShare.getMsgHash().ToString(), t.count());
         return std::nullopt;
     }
-
-    sigShare.UpdateKey();
+    // SYSCOIN every copy of our share relayed to the other members is serialized, encode it once for all of them
+    sigShare.sigShare.CacheBytes();
 
     LogPrint(BCLog::LLMQ_SIGS, "CSigSharesManager::%s -- created sigShare. signHash=%s, id=%s, msgHash=%s, quorum=%s, time=%s\n", __func__,
               signHash.ToString(), sigShare.getId().ToString(), sigShare.getMsgHash().ToString(), quorum->qc->quorumHash.ToString(), t.count());
@@ -1567,8 +1775,19 @@ void CSigSharesManager::ForceReAnnouncement(const CQuorumCPtr& quorum, const uin
 
 void CSigSharesManager::HandleNewRecoveredSig(const llmq::CRecoveredSig& recoveredSig)
 {
-    LOCK(cs);
-    RemoveSigSharesForSession(recoveredSig.buildSignHash());
+    std::optional<int64_t> recoveryMs;
+    {
+        LOCK(cs);
+        const uint256 signHash = recoveredSig.buildSignHash();
+        if (const auto it = firstSeenForSessions.find(signHash); it != firstSeenForSessions.end()) {
+            recoveryMs = std::max<int64_t>(GetTime<std::chrono::milliseconds>().count() - it->second, 0);
+        }
+        RemoveSigSharesForSession(signHash);
+    }
+    if (recoveryMs) {
+        LOCK(cs_workStats);
+        workStats.sessionRecoveryMs.Add(*recoveryMs);
+    }
 }
 
 } // namespace llmq
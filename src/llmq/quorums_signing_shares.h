@@ -6,11 +6,17 @@
 #define SYSCOIN_LLMQ_QUORUMS_SIGNING_SHARES_H
 
 #include <llmq/quorums_signing.h>
+#include <llmq/quorums_stats.h>
 
+#include <memusage.h>
 #include <serialize.h>
 #include <uint256.h>
 
+#include <algorithm>
 #include <atomic>
+#include <bit>
+#include <chrono>
+#include <condition_variable>
 #include <limits>
 #include <memory>
 #include <optional>
@@ -20,6 +26,8 @@
 #include <utility>
 #include <vector>
 
+class CBLSWorker;
+class CDeterministicMN;
 class CScheduler;
 class CConnman;
 class PeerMan;
@@ -35,22 +43,42 @@ using SigShareKey = std::pair<uint256, uint16_t>;
 
 constexpr uint32_t UNINITIALIZED_SESSION_ID{std::numeric_limits<uint32_t>::max()};
 
-class CSigShare : virtual public CSigBase
+/**
+ * SYSCOIN The values all shares of one signing session have in common. Every share references one interned
+ * instance per sign hash instead of carrying its own copy, so a share is just the session, the member and the
+ * signature
+ */
+struct CSigShareSession
+{
+    uint256 quorumHash;
+    uint256 id;
+    uint256 msgHash;
+    uint256 signHash;
+};
+using CSigShareSessionCPtr = std::shared_ptr<const CSigShareSession>;
+
+/** The shared session of quorumHash, id and msgHash, created when no share or node session references it anymore */
+CSigShareSessionCPtr InternSigShareSession(const uint256& quorumHash, const uint256& id, const uint256& msgHash);
+
+class CSigShare
 {
 protected:
+    CSigShareSessionCPtr session;
     uint16_t quorumMember{std::numeric_limits<uint16_t>::max()};
 public:
     CBLSLazySignature sigShare;
 
-    SigShareKey key;
-
     [[nodiscard]] auto getQuorumMember() const {
         return quorumMember;
     }
 
     CSigShare(const uint256& _quorumHash, const uint256& _id, const uint256& _msgHash,
               uint16_t _quorumMember, const CBLSLazySignature& _sigShare) :
-                    CSigBase(_quorumHash, _id, _msgHash),
+                    session(InternSigShareSession(_quorumHash, _id, _msgHash)),
+                    quorumMember(_quorumMember),
+                    sigShare(_sigShare) {};
+    CSigShare(CSigShareSessionCPtr _session, uint16_t _quorumMember, const CBLSLazySignature& _sigShare) :
+                    session(std::move(_session)),
                     quorumMember(_quorumMember),
                     sigShare(_sigShare) {};
 
@@ -59,21 +87,42 @@ public:
 
 
 public:
-    void UpdateKey();
-    const SigShareKey& GetKey() const
+    [[nodiscard]] const CSigShareSessionCPtr& GetSession() const
+    {
+        return session;
+    }
+    [[nodiscard]] const uint256& getQuorumHash() const
+    {
+        return session->quorumHash;
+    }
+    [[nodiscard]] const uint256& getId() const
+    {
+        return session->id;
+    }
+    [[nodiscard]] const uint256& getMsgHash() const
+    {
+        return session->msgHash;
+    }
+    SigShareKey GetKey() const
     {
-        return key;
+        return SigShareKey(session->signHash, quorumMember);
     }
     const uint256& GetSignHash() const
     {
-        assert(!key.first.IsNull());
-        return key.first;
+        return session->signHash;
     }
 
-    SERIALIZE_METHODS(CSigShare, obj)
+    template <typename Stream>
+    void Serialize(Stream& s) const
     {
-        READWRITE(obj.quorumHash, obj.quorumMember, obj.id, obj.msgHash, obj.sigShare);
-        SER_READ(obj, obj.UpdateKey());
+        s << session->quorumHash << quorumMember << session->id << session->msgHash << sigShare;
+    }
+    template <typename Stream>
+    void Unserialize(Stream& s)
+    {
+        uint256 quorumHash, id, msgHash;
+        s >> quorumHash >> quorumMember >> id >> msgHash >> sigShare;
+        session = InternSigShareSession(quorumHash, id, msgHash);
     }
 };
 
@@ -146,17 +195,147 @@ public:
     [[nodiscard]] std::string ToInvString() const;
 };
 
+/**
+ * SYSCOIN The values of one signing session keyed by quorum member index. Member indexes are small and dense, so
+ * presence is kept in a bitmap and the values in an array sorted by member index, with the position of a member
+ * being the number of lower members present. This needs no allocation per value and iterates in member order.
+ */
+template<typename T>
+class SigShareMemberMap
+{
+private:
+    static constexpr size_t BITS_PER_WORD{64};
+
+    std::vector<uint64_t> bitmap;
+    std::vector<std::pair<uint16_t, T>> values;
+
+    [[nodiscard]] bool TestBit(uint16_t quorumMember) const
+    {
+        const size_t word = quorumMember / BITS_PER_WORD;
+        return word < bitmap.size() && (bitmap[word] >> (quorumMember % BITS_PER_WORD)) & 1;
+    }
+
+    //! Position of quorumMember in values, whether it is present or not
+    [[nodiscard]] size_t Rank(uint16_t quorumMember) const
+    {
+        const size_t word = quorumMember / BITS_PER_WORD;
+        size_t rank = 0;
+        for (size_t i = 0; i < std::min(word, bitmap.size()); i++) {
+            rank += std::popcount(bitmap[i]);
+        }
+        if (word < bitmap.size()) {
+            rank += std::popcount(bitmap[word] & ((uint64_t{1} << (quorumMember % BITS_PER_WORD)) - 1));
+        }
+        return rank;
+    }
+
+public:
+    using const_iterator = typename std::vector<std::pair<uint16_t, T>>::const_iterator;
+
+    bool Add(uint16_t quorumMember, const T& v)
+    {
+        if (TestBit(quorumMember)) {
+            return false;
+        }
+        const size_t word = quorumMember / BITS_PER_WORD;
+        if (word >= bitmap.size()) {
+            bitmap.resize(word + 1, 0);
+        }
+        values.emplace(values.begin() + Rank(quorumMember), quorumMember, v);
+        bitmap[word] |= uint64_t{1} << (quorumMember % BITS_PER_WORD);
+        return true;
+    }
+
+    void Erase(uint16_t quorumMember)
+    {
+        if (!TestBit(quorumMember)) {
+            return;
+        }
+        values.erase(values.begin() + Rank(quorumMember));
+        bitmap[quorumMember / BITS_PER_WORD] &= ~(uint64_t{1} << (quorumMember % BITS_PER_WORD));
+    }
+
+    T* Get(uint16_t quorumMember)
+    {
+        if (!TestBit(quorumMember)) {
+            return nullptr;
+        }
+        return &values[Rank(quorumMember)].second;
+    }
+
+    //! Drop all values but keep the storage for the next session
+    void Clear()
+    {
+        std::fill(bitmap.begin(), bitmap.end(), 0);
+        values.clear();
+    }
+
+    template<typename F>
+    void EraseIf(const uint256& signHash, F&& f)
+    {
+        auto it = std::remove_if(values.begin(), values.end(), [&](std::pair<uint16_t, T>& p) {
+            if (!f(SigShareKey(signHash, p.first), p.second)) {
+                return false;
+            }
+            bitmap[p.first / BITS_PER_WORD] &= ~(uint64_t{1} << (p.first % BITS_PER_WORD));
+            return true;
+        });
+        values.erase(it, values.end());
+    }
+
+    template<typename F>
+    void ForEach(const uint256& signHash, F&& f)
+    {
+        for (auto& [quorumMember, v] : values) {
+            f(SigShareKey(signHash, quorumMember), v);
+        }
+    }
+
+    [[nodiscard]] size_t DynamicMemoryUsage() const { return memusage::DynamicUsage(bitmap) + memusage::DynamicUsage(values); }
+    [[nodiscard]] size_t count(uint16_t quorumMember) const { return TestBit(quorumMember) ? 1 : 0; }
+    [[nodiscard]] size_t size() const { return values.size(); }
+    [[nodiscard]] bool empty() const { return values.empty(); }
+    const_iterator begin() const { return values.begin(); }
+    const_iterator end() const { return values.end(); }
+};
+
 template<typename T>
 class SigShareMap
 {
 private:
-    std::unordered_map<uint256, std::unordered_map<uint16_t, T>, StaticSaltedHasher> internalMap;
+    //! SYSCOIN number of emptied sessions kept around to be reused without allocating
+    static constexpr size_t SESSION_POOL_SIZE{32};
+
+    std::unordered_map<uint256, SigShareMemberMap<T>, StaticSaltedHasher> internalMap;
+    std::vector<SigShareMemberMap<T>> sessionPool;
+
+    SigShareMemberMap<T>& GetOrAddSession(const uint256& signHash)
+    {
+        auto it = internalMap.find(signHash);
+        if (it != internalMap.end()) {
+            return it->second;
+        }
+        if (sessionPool.empty()) {
+            return internalMap[signHash];
+        }
+        auto& m = internalMap.emplace(signHash, std::move(sessionPool.back())).first->second;
+        sessionPool.pop_back();
+        return m;
+    }
+
+    void EraseSession(typename decltype(internalMap)::iterator it)
+    {
+        if (sessionPool.size() < SESSION_POOL_SIZE) {
+            it->second.Clear();
+            sessionPool.emplace_back(std::move(it->second));
+        }
+        internalMap.erase(it);
+    }
 
 public:
     bool Add(const SigShareKey& k, const T& v)
     {
-        auto& m = internalMap[k.first];
-        return m.emplace(k.second, v).second;
+        return GetOrAddSession(k.first).Add(k.second, v);
     }
 
     void Erase(const SigShareKey& k)
@@ -165,15 +344,16 @@ public:
         if (it == internalMap.end()) {
             return;
         }
-        it->second.erase(k.second);
+        it->second.Erase(k.second);
         if (it->second.empty()) {
-            internalMap.erase(it);
+            EraseSession(it);
         }
     }
 
     void Clear()
     {
         internalMap.clear();
+        sessionPool.clear();
     }
 
     [[nodiscard]] bool Has(const SigShareKey& k) const
@@ -191,21 +371,16 @@ public:
         if (it == internalMap.end()) {
             return nullptr;
         }
-
-        auto jt = it->second.find(k.second);
-        if (jt == it->second.end()) {
-            return nullptr;
-        }
-
-        return &jt->second;
+        return it->second.Get(k.second);
     }
 
     T& GetOrAdd(const SigShareKey& k)
     {
-        T* v = Get(k);
+        auto& m = GetOrAddSession(k.first);
+        T* v = m.Get(k.second);
         if (!v) {
-            Add(k, T());
-            v = Get(k);
+            m.Add(k.second, T());
+            v = m.Get(k.second);
         }
         return *v;
     }
@@ -241,7 +416,20 @@ public:
         return internalMap.empty();
     }
 
-    const std::unordered_map<uint16_t, T>* GetAllForSignHash(const uint256& signHash) const
+    //! SYSCOIN heap memory of the sessions, the values are expected to hold no heap memory of their own
+    [[nodiscard]] size_t DynamicMemoryUsage() const
+    {
+        size_t usage = memusage::DynamicUsage(internalMap) + memusage::DynamicUsage(sessionPool);
+        for (const auto& [signHash, m] : internalMap) {
+            usage += m.DynamicMemoryUsage();
+        }
+        for (const auto& m : sessionPool) {
+            usage += m.DynamicMemoryUsage();
+        }
+        return usage;
+    }
+
+    const SigShareMemberMap<T>* GetAllForSignHash(const uint256& signHash) const
     {
         auto it = internalMap.find(signHash);
         if (it == internalMap.end()) {
@@ -252,25 +440,21 @@ public:
 
     void EraseAllForSignHash(const uint256& signHash)
     {
-        internalMap.erase(signHash);
+        auto it = internalMap.find(signHash);
+        if (it != internalMap.end()) {
+            EraseSession(it);
+        }
     }
 
     template<typename F>
     void EraseIf(F&& f)
     {
         for (auto it = internalMap.begin(); it != internalMap.end(); ) {
-            SigShareKey k;
-            k.first = it->first;
-            for (auto jt = it->second.begin(); jt != it->second.end(); ) {
-                k.second = jt->first;
-                if (f(k, jt->second)) {
-                    jt = it->second.erase(jt);
-                } else {
-                    ++jt;
-                }
-            }
+            it->second.EraseIf(it->first, f);
             if (it->second.empty()) {
-                it = internalMap.erase(it);
+                auto next = std::next(it);
+                EraseSession(it);
+                it = next;
             } else {
                 ++it;
             }
@@ -281,12 +465,7 @@ public:
     void ForEach(F&& f)
     {
         for (auto& p : internalMap) {
-            SigShareKey k;
-            k.first = p.first;
-            for (auto& p2 : p.second) {
-                k.second = p2.first;
-                f(k, p2.second);
-            }
+            p.second.ForEach(p.first, f);
         }
     }
 };
@@ -297,10 +476,7 @@ public:
     // Used to avoid holding locks too long
     struct SessionInfo
     {
-        uint256 quorumHash;
-        uint256 id;
-        uint256 msgHash;
-        uint256 signHash;
+        CSigShareSessionCPtr shareSession;
 
         CQuorumCPtr quorum;
     };
@@ -309,10 +485,8 @@ public:
         uint32_t recvSessionId{UNINITIALIZED_SESSION_ID};
         uint32_t sendSessionId{UNINITIALIZED_SESSION_ID};
 
-        uint256 quorumHash;
-        uint256 id;
-        uint256 msgHash;
-        uint256 signHash;
+        // SYSCOIN the same instance the shares of the session reference
+        CSigShareSessionCPtr shareSession;
 
         CQuorumCPtr quorum;
 
@@ -327,6 +501,8 @@ public:
     uint32_t nextSendSessionId{1};
 
     SigShareMap<CSigShare> pendingIncomingSigShares;
+    // SYSCOIN when the oldest share in pendingIncomingSigShares was queued, in milliseconds
+    int64_t pendingIncomingSinceMs{0};
     SigShareMap<int64_t> requestedSigShares;
 
     bool banned{false};
@@ -338,6 +514,8 @@ public:
     bool GetSessionInfoByRecvId(uint32_t sessionId, SessionInfo& retInfo);
 
     void RemoveSession(const uint256& signHash);
+    // SYSCOIN
+    size_t DynamicMemoryUsage() const;
 };
 
 class CSignedSession
@@ -366,17 +544,30 @@ private:
     static constexpr int64_t EXP_SEND_FOR_RECOVERY_TIMEOUT{2000};
     static constexpr int64_t MAX_SEND_FOR_RECOVERY_TIMEOUT{10000};
     static constexpr size_t MAX_MSGS_SIG_SHARES{32};
+    // SYSCOIN pending sig shares that wake the work thread right away, fewer are given a moment to batch up
+    static constexpr size_t WAKEUP_PENDING_SIG_SHARES{16};
+    static constexpr std::chrono::milliseconds WAKEUP_BATCH_WAIT{10};
+    // SendMessages() runs at most this often
+    static constexpr std::chrono::milliseconds SEND_INTERVAL{100};
+    // the work stats are summarized in the debug log at most this often
+    static constexpr std::chrono::minutes STATS_LOG_INTERVAL{5};
 
     RecursiveMutex cs;
 
     std::thread workThread;
     CThreadInterrupt workInterrupt;
+    // SYSCOIN signalled when new sig shares are pending or signing was requested
+    Mutex cs_workWakeup;
+    std::condition_variable workWakeupCv;
+    size_t nPendingWakeupWork GUARDED_BY(cs_workWakeup){0};
 
     SigShareMap<CSigShare> sigShares GUARDED_BY(cs);
     std::unordered_map<uint256, CSignedSession, StaticSaltedHasher> signedSessions GUARDED_BY(cs);
 
     // stores time of last receivedSigShare. Used to detect timeouts
     std::unordered_map<uint256, int64_t, StaticSaltedHasher> timeSeenForSessions GUARDED_BY(cs);
+    // SYSCOIN time of the first verified sigShare, in milliseconds. Used for the recovery latency
+    std::unordered_map<uint256, int64_t, StaticSaltedHasher> firstSeenForSessions GUARDED_BY(cs);
 
     std::unordered_map<NodeId, CSigSharesNodeState> nodeStates GUARDED_BY(cs);
     SigShareMap<std::pair<NodeId, int64_t>> sigSharesRequested GUARDED_BY(cs);
@@ -399,11 +590,52 @@ private:
     std::atomic<uint32_t> recoveredSigsCounter{0};
     CConnman& connman;
     PeerManager& peerman;
+    CBLSWorker& blsWorker;
+
+public:
+    /** Time spent in one stage of the work thread since startup */
+    struct StageStats {
+        uint64_t runs{0};
+        uint64_t totalMicros{0};
+        uint64_t maxMicros{0};
+
+        void Add(uint64_t micros)
+        {
+            runs++;
+            totalMicros += micros;
+            maxMicros = std::max(maxMicros, micros);
+        }
+    };
+    struct WorkStats {
+        StageStats collect;
+        StageStats prepare;
+        StageStats verify;
+        StageStats process;
+        StageStats sign;
+        StageStats send;
+        uint64_t verifiedSigShares{0};
+        // batches verified on the BLS worker pool, one per sign hash
+        uint64_t verifyBatches{0};
+        // shares per verification batch
+        CLatencyHistogram verifyBatchSize;
+        // from the first verified share of a session to its recovered signature, in milliseconds
+        CLatencyHistogram sessionRecoveryMs;
+        // how long the oldest pending share of a node waited to be collected for verification, in milliseconds
+        CLatencyHistogram queueWaitMs;
+        // shares dropped on arrival because the signature was already recovered
+        uint64_t lateSigShares{0};
+    };
+
+private:
+    mutable Mutex cs_workStats;
+    WorkStats workStats GUARDED_BY(cs_workStats);
+    std::atomic<uint64_t> lateSigShares{0};
 
 public:
-    explicit CSigSharesManager(CConnman& _connman, PeerManager& _peerman) :
+    explicit CSigSharesManager(CConnman& _connman, PeerManager& _peerman, CBLSWorker& _blsWorker) :
         connman(_connman),
-        peerman(_peerman)
+        peerman(_peerman),
+        blsWorker(_blsWorker)
     {
         workInterrupt.reset();
     };
@@ -414,33 +646,37 @@ public:
     void StopWorkerThread();
     void RegisterAsRecoveredSigsListener();
     void UnregisterAsRecoveredSigsListener();
-    void InterruptWorkerThread();
+    void InterruptWorkerThread() EXCLUSIVE_LOCKS_REQUIRED(!cs_workWakeup);
 
-    void ProcessMessage(const CNode* pnode, const std::string& msg_type, CDataStream& vRecv);
+    void ProcessMessage(const CNode* pnode, const std::string& msg_type, CDataStream& vRecv) EXCLUSIVE_LOCKS_REQUIRED(!cs_workWakeup);
 
-    void AsyncSign(const CQuorumCPtr& quorum, const uint256& id, const uint256& msgHash) EXCLUSIVE_LOCKS_REQUIRED(!cs_pendingSigns);
+    void AsyncSign(const CQuorumCPtr& quorum, const uint256& id, const uint256& msgHash) EXCLUSIVE_LOCKS_REQUIRED(!cs_pendingSigns, !cs_workWakeup);
     std::optional<CSigShare> CreateSigShare(const CQuorumCPtr& quorum, const uint256& id, const uint256& msgHash) const;
     void ForceReAnnouncement(const CQuorumCPtr& quorum, const uint256& id, const uint256& msgHash);
 
-    void HandleNewRecoveredSig(const CRecoveredSig& recoveredSig) override;
+    void HandleNewRecoveredSig(const CRecoveredSig& recoveredSig) override EXCLUSIVE_LOCKS_REQUIRED(!cs_workStats);
 
     static CDeterministicMNCPtr SelectMemberForRecovery(const CQuorumCPtr& quorum, const uint256& id, int attempt);
 
+    WorkStats GetWorkStats() const EXCLUSIVE_LOCKS_REQUIRED(!cs_workStats);
+    //! SYSCOIN estimated heap memory of the shares, sessions and peer states
+    size_t DynamicMemoryUsage();
+
 private:
     // all of these return false when the currently processed message should be aborted (as each message actually contains multiple messages)
     bool ProcessMessageSigSesAnn(const CNode* pfrom, const CSigSesAnn& ann);
     bool ProcessMessageSigSharesInv(const CNode* pfrom, const CSigSharesInv& inv);
     bool ProcessMessageGetSigShares(const CNode* pfrom, const CSigSharesInv& inv);
-    bool ProcessMessageBatchedSigShares(const CNode* pfrom, const CBatchedSigShares& batchedSigShares);
-    void ProcessMessageSigShare(NodeId fromId, const CSigShare& sigShare);
+    bool ProcessMessageBatchedSigShares(const CNode* pfrom, const CBatchedSigShares& batchedSigShares) EXCLUSIVE_LOCKS_REQUIRED(!cs_workWakeup);
+    void ProcessMessageSigShare(NodeId fromId, const CSigShare& sigShare) EXCLUSIVE_LOCKS_REQUIRED(!cs_workWakeup);
 
     static bool VerifySigSharesInv(const CSigSharesInv& inv);
     static bool PreVerifyBatchedSigShares(const CSigSharesNodeState::SessionInfo& session, const CBatchedSigShares& batchedSigShares, bool& retBan);
 
     bool CollectPendingSigSharesToVerify(
         size_t maxUniqueSessions, std::unordered_map<NodeId, std::vector<CSigShare>>& retSigShares,
-        std::unordered_map<uint256, CQuorumCPtr, StaticSaltedHasher>& retQuorums);
-    bool ProcessPendingSigShares();
+        std::unordered_map<uint256, CQuorumCPtr, StaticSaltedHasher>& retQuorums) EXCLUSIVE_LOCKS_REQUIRED(!cs_workStats);
+    bool ProcessPendingSigShares() EXCLUSIVE_LOCKS_REQUIRED(!cs_workStats);
 
     void ProcessPendingSigShares(
         const std::vector<CSigShare>& sigSharesToProcess,
@@ -453,6 +689,7 @@ private:
     static CSigShare RebuildSigShare(const CSigSharesNodeState::SessionInfo& session, const std::pair<uint16_t, CBLSLazySignature>& in);
 
     void Cleanup();
+    void LogWorkStats() const EXCLUSIVE_LOCKS_REQUIRED(!cs_workStats);
     void RemoveSigSharesForSession(const uint256& signHash) EXCLUSIVE_LOCKS_REQUIRED(cs);
     void RemoveBannedNodeStates();
 
@@ -466,7 +703,11 @@ private:
         std::unordered_map<NodeId, std::unordered_map<uint256, CSigSharesInv, StaticSaltedHasher>>& sigSharesToAnnounce)
         EXCLUSIVE_LOCKS_REQUIRED(cs);
     void SignPendingSigShares() EXCLUSIVE_LOCKS_REQUIRED(!cs_pendingSigns);
-    void WorkThreadMain() EXCLUSIVE_LOCKS_REQUIRED(!cs_pendingSigns);
+    /** Count new work for the work thread and wake it once there is enough to verify */
+    void NotifyWork(size_t count) EXCLUSIVE_LOCKS_REQUIRED(!cs_workWakeup);
+    /** Wait up to timeout for new work, false if the thread got interrupted */
+    bool WaitForWork(std::chrono::milliseconds timeout) EXCLUSIVE_LOCKS_REQUIRED(!cs_workWakeup);
+    void WorkThreadMain() EXCLUSIVE_LOCKS_REQUIRED(!cs_pendingSigns, !cs_workStats, !cs_workWakeup);
 };
 
 extern CSigSharesManager* quorumSigSharesManager;
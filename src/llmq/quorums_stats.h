@@ -0,0 +1,67 @@
+// Copyright (c) 2024 The Syscoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef SYSCOIN_LLMQ_QUORUMS_STATS_H
+#define SYSCOIN_LLMQ_QUORUMS_STATS_H
+
+#include <tinyformat.h>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <string>
+
+namespace llmq
+{
+
+/**
+ * Distribution of a latency or size since startup, in power of two buckets. Bucket i counts the values
+ * below 2^i (and at least 2^(i-1)), the last one everything larger. Percentiles are reported as the upper
+ * bound of their bucket, which is precise enough to tell a slow quorum round from a fast one.
+ */
+class CLatencyHistogram
+{
+public:
+    static constexpr size_t BUCKETS{24};
+
+    uint64_t count{0};
+    uint64_t sum{0};
+    uint64_t max{0};
+    std::array<uint64_t, BUCKETS> buckets{};
+
+    void Add(uint64_t value)
+    {
+        count++;
+        sum += value;
+        max = std::max(max, value);
+        buckets[std::min<size_t>(std::bit_width(value), BUCKETS - 1)]++;
+    }
+
+    uint64_t Average() const { return count > 0 ? sum / count : 0; }
+
+    /** Upper bound of the bucket holding the given percentile (0-100), capped at the largest value seen */
+    uint64_t Percentile(unsigned int percent) const
+    {
+        if (count == 0) return 0;
+        const uint64_t rank = (count * percent + 99) / 100;
+        uint64_t seen = 0;
+        for (size_t i = 0; i < BUCKETS - 1; i++) {
+            seen += buckets[i];
+            if (seen >= rank && seen > 0) {
+                return std::min<uint64_t>((uint64_t{1} << i) - 1, max);
+            }
+        }
+        return max;
+    }
+
+    std::string ToString() const
+    {
+        return strprintf("n=%d avg=%d p50=%d p90=%d p99=%d max=%d", count, Average(), Percentile(50), Percentile(90), Percentile(99), max);
+    }
+};
+
+} // namespace llmq
+
+#endif // SYSCOIN_LLMQ_QUORUMS_STATS_H
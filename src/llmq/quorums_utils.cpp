@@ -20,6 +20,7 @@
 #include <common/args.h>
 #include <logging.h>
 #include <unordered_lru_cache.h>
+#include <map>
 namespace llmq
 {
 bool CLLMQUtils::IsV19Active(const int nHeight)
@@ -34,12 +35,15 @@ const CBlockIndex* CLLMQUtils::V19ActivationIndex(const CBlockIndex* pindex)
     }
     return pindex->GetAncestor(Params().GetConsensus().nV19StartBlock);
 }
-std::vector<CDeterministicMNCPtr> CLLMQUtils::GetAllQuorumMembers(const CBlockIndex* pQuorumBaseBlockIndex)
+QuorumMembersPtr CLLMQUtils::GetAllQuorumMembers(const CBlockIndex* pQuorumBaseBlockIndex)
 {
-    static RecursiveMutex cs_members;
-    static unordered_lru_cache<uint256, std::vector<CDeterministicMNCPtr>, StaticSaltedHasher, 10> mapQuorumMembers;
+    // SYSCOIN there is a single LLMQ type, so the base block hash identifies the quorum. The cache is sized for
+    // everything looking at quorums at the same time: connections, signing, the block processor and RPCs
+    static Mutex cs_members;
+    static unordered_lru_cache<uint256, QuorumMembersPtr, StaticSaltedHasher> mapQuorumMembers GUARDED_BY(cs_members){
+        (size_t)std::max<int64_t>(1, gArgs.GetIntArg("-quorummemberscache", DEFAULT_QUORUM_MEMBERS_CACHE))};
     const Consensus::LLMQParams& llmqParams = Params().GetConsensus().llmqTypeChainLocks;
-    std::vector<CDeterministicMNCPtr> quorumMembers;
+    QuorumMembersPtr quorumMembers;
     {
         LOCK(cs_members);
         if (mapQuorumMembers.get(pQuorumBaseBlockIndex->GetBlockHash(), quorumMembers)) {
@@ -49,7 +53,7 @@ std::vector<CDeterministicMNCPtr> CLLMQUtils::GetAllQuorumMembers(const CBlockIn
 
     auto allMns = deterministicMNManager->GetListForBlock(pQuorumBaseBlockIndex);
     auto modifier = pQuorumBaseBlockIndex->GetBlockHash();
-    quorumMembers = allMns.CalculateQuorum(llmqParams.size, modifier);
+    quorumMembers = std::make_shared<const std::vector<CDeterministicMNCPtr>>(allMns.CalculateQuorum(llmqParams.size, modifier));
     LOCK(cs_members);
     mapQuorumMembers.insert(pQuorumBaseBlockIndex->GetBlockHash(), quorumMembers);
     return quorumMembers;
@@ -99,35 +103,86 @@ uint256 CLLMQUtils::DeterministicOutboundConnection(const uint256& proTxHash1, c
     return proTxHash2;
 }
 
-std::unordered_set<uint256, StaticSaltedHasher> CLLMQUtils::GetQuorumConnections(const CBlockIndex* pQuorumBaseBlockIndex, const uint256& forMember, bool onlyOutbound)
-{
-    if (IsAllMembersConnectedEnabled()) {
-        auto mns = GetAllQuorumMembers(pQuorumBaseBlockIndex);
-        std::unordered_set<uint256, StaticSaltedHasher> result;
+namespace {
+using QuorumConnectionSet = std::unordered_set<uint256, StaticSaltedHasher>;
+// SYSCOIN connection sets of a quorum by member and whether only the outbound ones were asked for. They only depend
+// on the members, so they are built once instead of hashing all member pairs again on every connection tick
+struct QuorumConnectionSets {
+    int nHeight{0};
+    std::map<std::pair<uint256, bool>, QuorumConnectionSet> allMembers;
+    std::map<std::pair<uint256, bool>, QuorumConnectionSet> relayMembers;
+};
+Mutex cs_quorumConnections;
+std::unordered_map<uint256, QuorumConnectionSets, StaticSaltedHasher> mapQuorumConnections GUARDED_BY(cs_quorumConnections);
 
-        for (const auto& dmn : mns) {
-            if (dmn->proTxHash == forMember) {
-                continue;
-            }
-            // Determine which of the two MNs (forMember vs dmn) should initiate the outbound connection and which
-            // one should wait for the inbound connection. We do this in a deterministic way, so that even when we
-            // end up with both connecting to each other, we know which one to disconnect
-            uint256 deterministicOutbound = DeterministicOutboundConnection(forMember, dmn->proTxHash);
-            if (!onlyOutbound || deterministicOutbound == dmn->proTxHash) {
-                result.emplace(dmn->proTxHash);
+template <typename Builder>
+QuorumConnectionSet GetOrBuildQuorumConnections(const CBlockIndex* pQuorumBaseBlockIndex, bool fRelayMembers, const uint256& forMember, bool onlyOutbound,
+                                                Builder&& build) EXCLUSIVE_LOCKS_REQUIRED(!cs_quorumConnections)
+{
+    const auto key = std::make_pair(forMember, onlyOutbound);
+    {
+        LOCK(cs_quorumConnections);
+        if (auto it = mapQuorumConnections.find(pQuorumBaseBlockIndex->GetBlockHash()); it != mapQuorumConnections.end()) {
+            const auto& sets = fRelayMembers ? it->second.relayMembers : it->second.allMembers;
+            if (auto jt = sets.find(key); jt != sets.end()) {
+                return jt->second;
             }
         }
-        return result;
+    }
+    // built without the lock, two threads racing for the same set do the work twice at worst
+    auto result = build();
+    LOCK(cs_quorumConnections);
+    auto& quorumSets = mapQuorumConnections[pQuorumBaseBlockIndex->GetBlockHash()];
+    quorumSets.nHeight = pQuorumBaseBlockIndex->nHeight;
+    (fRelayMembers ? quorumSets.relayMembers : quorumSets.allMembers).emplace(key, result);
+    return result;
+}
+} // namespace
+
+std::unordered_set<uint256, StaticSaltedHasher> CLLMQUtils::GetQuorumConnections(const CBlockIndex* pQuorumBaseBlockIndex, const uint256& forMember, bool onlyOutbound)
+{
+    if (IsAllMembersConnectedEnabled()) {
+        return GetOrBuildQuorumConnections(pQuorumBaseBlockIndex, false, forMember, onlyOutbound, [&]() {
+            return BuildQuorumConnections(pQuorumBaseBlockIndex, forMember, onlyOutbound);
+        });
     } else {
         return GetQuorumRelayMembers(pQuorumBaseBlockIndex, forMember, onlyOutbound);
     }
 }
 
-std::unordered_set<uint256, StaticSaltedHasher> CLLMQUtils::GetQuorumRelayMembers(const CBlockIndex* pQuorumBaseBlockIndex, const uint256& forMember, bool onlyOutbound)
+std::unordered_set<uint256, StaticSaltedHasher> CLLMQUtils::BuildQuorumConnections(const CBlockIndex* pQuorumBaseBlockIndex, const uint256& forMember, bool onlyOutbound)
 {
     auto mns = GetAllQuorumMembers(pQuorumBaseBlockIndex);
     std::unordered_set<uint256, StaticSaltedHasher> result;
 
+    for (const auto& dmn : *mns) {
+        if (dmn->proTxHash == forMember) {
+            continue;
+        }
+        // Determine which of the two MNs (forMember vs dmn) should initiate the outbound connection and which
+        // one should wait for the inbound connection. We do this in a deterministic way, so that even when we
+        // end up with both connecting to each other, we know which one to disconnect
+        uint256 deterministicOutbound = DeterministicOutboundConnection(forMember, dmn->proTxHash);
+        if (!onlyOutbound || deterministicOutbound == dmn->proTxHash) {
+            result.emplace(dmn->proTxHash);
+        }
+    }
+    return result;
+}
+
+std::unordered_set<uint256, StaticSaltedHasher> CLLMQUtils::GetQuorumRelayMembers(const CBlockIndex* pQuorumBaseBlockIndex, const uint256& forMember, bool onlyOutbound)
+{
+    return GetOrBuildQuorumConnections(pQuorumBaseBlockIndex, true, forMember, onlyOutbound, [&]() {
+        return BuildQuorumRelayMembers(pQuorumBaseBlockIndex, forMember, onlyOutbound);
+    });
+}
+
+std::unordered_set<uint256, StaticSaltedHasher> CLLMQUtils::BuildQuorumRelayMembers(const CBlockIndex* pQuorumBaseBlockIndex, const uint256& forMember, bool onlyOutbound)
+{
+    const auto quorumMembers = GetAllQuorumMembers(pQuorumBaseBlockIndex);
+    const auto& mns = *quorumMembers;
+    std::unordered_set<uint256, StaticSaltedHasher> result;
+
     auto calcOutbound = [&](size_t i, const uint256& proTxHash) {
         // Relay to nodes at indexes (i+2^k)%n, where
         //   k: 0..max(1, floor(log2(n-1))-1)
@@ -178,6 +233,18 @@ std::unordered_set<uint256, StaticSaltedHasher> CLLMQUtils::GetQuorumRelayMember
 }
 
 
+void CLLMQUtils::RemoveQuorumConnectionsBelow(int nHeight)
+{
+    LOCK(cs_quorumConnections);
+    for (auto it = mapQuorumConnections.begin(); it != mapQuorumConnections.end();) {
+        if (it->second.nHeight < nHeight) {
+            it = mapQuorumConnections.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
 std::set<size_t> CLLMQUtils::CalcDeterministicWatchConnections(const CBlockIndex* pQuorumBaseBlockIndex, size_t memberCount, size_t connectionCount)
 {
     static uint256 qwatchConnectionSeed;
@@ -201,7 +268,8 @@ std::set<size_t> CLLMQUtils::CalcDeterministicWatchConnections(const CBlockIndex
 bool CLLMQUtils::EnsureQuorumConnections(const CBlockIndex *pQuorumBaseBlockIndex, const uint256& myProTxHash, CConnman& connman)
 {
     if (!fMasternodeMode && !CLLMQUtils::IsWatchQuorumsEnabled()) return false;
-    auto members = GetAllQuorumMembers(pQuorumBaseBlockIndex);
+    const auto quorumMembers = GetAllQuorumMembers(pQuorumBaseBlockIndex);
+    const auto& members = *quorumMembers;
     bool isMember = std::find_if(members.begin(), members.end(), [&](const auto& dmn) { return dmn->proTxHash == myProTxHash; }) != members.end();
 
     if (!isMember && !CLLMQUtils::IsWatchQuorumsEnabled()) {
@@ -226,7 +294,8 @@ bool CLLMQUtils::EnsureQuorumConnections(const CBlockIndex *pQuorumBaseBlockInde
     }
     if (!connections.empty()) {
         if (!connman.HasMasternodeQuorumNodes(pQuorumBaseBlockIndex->GetBlockHash()) && LogAcceptCategory(BCLog::LLMQ, BCLog::Level::Debug)) {
-            auto mnList = deterministicMNManager->GetListAtChainTip();
+            const auto mnListPtr = deterministicMNManager->GetListAtChainTipPtr();
+            const auto& mnList = *mnListPtr;
             std::string debugMsg = strprintf("CLLMQUtils::%s -- adding masternodes quorum connections for quorum %s:", __func__, pQuorumBaseBlockIndex->GetBlockHash().ToString());
             for (auto& c : connections) {
                 auto dmn = mnList.GetValidMN(c);
@@ -262,7 +331,7 @@ void CLLMQUtils::AddQuorumProbeConnections(const CBlockIndex* pQuorumBaseBlockIn
     auto curTime = GetTime<std::chrono::seconds>().count();
 
     std::set<uint256> probeConnections;
-    for (const auto& dmn : members) {
+    for (const auto& dmn : *members) {
         if (dmn->proTxHash == myProTxHash) {
             continue;
         }
@@ -276,7 +345,8 @@ void CLLMQUtils::AddQuorumProbeConnections(const CBlockIndex* pQuorumBaseBlockIn
 
     if (!probeConnections.empty()) {
         if (LogAcceptCategory(BCLog::LLMQ, BCLog::Level::Debug)) {
-            auto mnList = deterministicMNManager->GetListAtChainTip();
+            const auto mnListPtr = deterministicMNManager->GetListAtChainTipPtr();
+            const auto& mnList = *mnListPtr;
             std::string debugMsg = strprintf("%s -- adding masternodes probes for quorum %s:\n", __func__, pQuorumBaseBlockIndex->GetBlockHash().ToString());
             for (const auto& c : probeConnections) {
                 auto dmn = mnList.GetValidMN(c);
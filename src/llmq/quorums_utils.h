@@ -4,6 +4,7 @@
 
 #ifndef SYSCOIN_LLMQ_QUORUMS_UTILS_H
 #define SYSCOIN_LLMQ_QUORUMS_UTILS_H
+#include <memory>
 #include <set>
 #include <unordered_set>
 #include <vector>
@@ -13,6 +14,8 @@
 class CBlockIndex;
 class CDeterministicMN;
 using CDeterministicMNCPtr = std::shared_ptr<const CDeterministicMN>;
+// SYSCOIN members of a quorum in the order of its bitsets, shared with the cache instead of copied
+using QuorumMembersPtr = std::shared_ptr<const std::vector<CDeterministicMNCPtr>>;
 class CConnman;
 namespace llmq
 {
@@ -24,13 +27,15 @@ public:
     static bool IsV19Active(const int nHeight);
     static const CBlockIndex* V19ActivationIndex(const CBlockIndex* pindex);
     // includes members which failed DKG
-    static std::vector<CDeterministicMNCPtr> GetAllQuorumMembers(const CBlockIndex* pindexQuorum);
+    static QuorumMembersPtr GetAllQuorumMembers(const CBlockIndex* pindexQuorum);
 
     static bool IsAllMembersConnectedEnabled();
     static bool IsQuorumPoseEnabled();
     static uint256 DeterministicOutboundConnection(const uint256& proTxHash1, const uint256& proTxHash2);
     static std::unordered_set<uint256, StaticSaltedHasher> GetQuorumConnections(const CBlockIndex* pQuorumBaseBlockIndex, const uint256& forMember, bool onlyOutbound);
     static std::unordered_set<uint256, StaticSaltedHasher> GetQuorumRelayMembers(const CBlockIndex* pQuorumBaseBlockIndex, const uint256& forMember, bool onlyOutbound);
+    // SYSCOIN forget the connection sets cached for quorums based below nHeight
+    static void RemoveQuorumConnectionsBelow(int nHeight);
     static std::set<size_t> CalcDeterministicWatchConnections(const CBlockIndex *pQuorumBaseBlockIndex, size_t memberCount, size_t connectionCount);
 
     static bool EnsureQuorumConnections(const CBlockIndex* pQuorumBaseBlockIndex, const uint256& myProTxHash, CConnman& connman);
@@ -64,6 +69,9 @@ public:
         return vBits;
     }
 
+private:
+    static std::unordered_set<uint256, StaticSaltedHasher> BuildQuorumConnections(const CBlockIndex* pQuorumBaseBlockIndex, const uint256& forMember, bool onlyOutbound);
+    static std::unordered_set<uint256, StaticSaltedHasher> BuildQuorumRelayMembers(const CBlockIndex* pQuorumBaseBlockIndex, const uint256& forMember, bool onlyOutbound);
 };
 
 } // namespace llmq
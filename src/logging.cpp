@@ -87,6 +87,8 @@ bool BCLog::Logger::StartLogging()
 
 void BCLog::Logger::DisconnectTestLogger()
 {
+    // SYSCOIN
+    StopAsyncWriter();
     StdLockGuard scoped_lock(m_cs);
     m_buffering = true;
     if (m_fileout != nullptr) fclose(m_fileout);
@@ -433,9 +435,8 @@ namespace BCLog {
     }
 } // namespace BCLog
 
-void BCLog::Logger::LogPrintStr(const std::string& str, const std::string& logging_function, const std::string& source_file, int source_line, BCLog::LogFlags category, BCLog::Level level)
+std::string BCLog::Logger::PrefixLogStr(const std::string& str, const std::string& logging_function, const std::string& source_file, int source_line, BCLog::LogFlags category, BCLog::Level level)
 {
-    StdLockGuard scoped_lock(m_cs);
     std::string str_prefixed = LogEscapeMessage(str);
 
     if ((category != LogFlags::NONE || level != Level::None) && m_started_new_line) {
@@ -470,6 +471,26 @@ void BCLog::Logger::LogPrintStr(const std::string& str, const std::string& loggi
     str_prefixed = LogTimestampStr(str_prefixed);
 
     m_started_new_line = !str.empty() && str[str.size()-1] == '\n';
+    return str_prefixed;
+}
+
+void BCLog::Logger::LogPrintStr(const std::string& str, const std::string& logging_function, const std::string& source_file, int source_line, BCLog::LogFlags category, BCLog::Level level)
+{
+    // SYSCOIN the timestamp and thread name are those of the logging thread, only the writing is handed off
+    if (m_async.load(std::memory_order_acquire)) {
+        ++m_async_producers;
+        // checked again now that StopAsyncWriter() waits for us
+        if (m_async.load(std::memory_order_acquire)) {
+            if (!AsyncPush(PrefixLogStr(str, logging_function, source_file, source_line, category, level))) {
+                ++m_async_dropped;
+            }
+            --m_async_producers;
+            return;
+        }
+        --m_async_producers;
+    }
+    StdLockGuard scoped_lock(m_cs);
+    std::string str_prefixed = PrefixLogStr(str, logging_function, source_file, source_line, category, level);
 
     if (m_buffering) {
         // buffer if we haven't started logging yet
@@ -477,14 +498,24 @@ void BCLog::Logger::LogPrintStr(const std::string& str, const std::string& loggi
         return;
     }
 
+    WriteStr(str_prefixed);
+}
+
+void BCLog::Logger::WriteStr(const std::string& str_prefixed)
+{
+    for (const auto& cb : m_print_callbacks) {
+        cb(str_prefixed);
+    }
+    WriteOutputs(str_prefixed);
+}
+
+void BCLog::Logger::WriteOutputs(const std::string& str_prefixed)
+{
     if (m_print_to_console) {
         // print to console
         fwrite(str_prefixed.data(), 1, str_prefixed.size(), stdout);
         fflush(stdout);
     }
-    for (const auto& cb : m_print_callbacks) {
-        cb(str_prefixed);
-    }
     if (m_print_to_file) {
         assert(m_fileout != nullptr);
 
@@ -502,6 +533,123 @@ void BCLog::Logger::LogPrintStr(const std::string& str, const std::string& loggi
     }
 }
 
+// SYSCOIN
+bool BCLog::Logger::AsyncPush(std::string&& str)
+{
+    const size_t size{str.size()};
+    if (m_async_bytes.fetch_add(size, std::memory_order_relaxed) + size > m_async_max_bytes) {
+        m_async_bytes.fetch_sub(size, std::memory_order_relaxed);
+        return false;
+    }
+    uint64_t pos{m_async_head.load(std::memory_order_relaxed)};
+    AsyncSlot* slot;
+    while (true) {
+        slot = &m_async_ring[pos % ASYNC_RING_SLOTS];
+        const uint64_t seq{slot->seq.load(std::memory_order_acquire)};
+        if (seq == pos) {
+            if (m_async_head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+        } else if (seq < pos) {
+            // the writer has not taken the message of the previous round yet, the ring is full
+            m_async_bytes.fetch_sub(size, std::memory_order_relaxed);
+            return false;
+        } else {
+            pos = m_async_head.load(std::memory_order_relaxed);
+        }
+    }
+    slot->msg = std::move(str);
+    slot->seq.store(pos + 1, std::memory_order_release);
+    m_async_pushed.fetch_add(1, std::memory_order_release);
+    m_async_pushed.notify_one();
+    return true;
+}
+
+bool BCLog::Logger::AsyncPop(std::string& str)
+{
+    AsyncSlot& slot = m_async_ring[m_async_tail % ASYNC_RING_SLOTS];
+    if (slot.seq.load(std::memory_order_acquire) != m_async_tail + 1) {
+        return false;
+    }
+    str = std::move(slot.msg);
+    slot.msg = std::string{};
+    slot.seq.store(m_async_tail + ASYNC_RING_SLOTS, std::memory_order_release);
+    ++m_async_tail;
+    m_async_bytes.fetch_sub(str.size(), std::memory_order_relaxed);
+    return true;
+}
+
+void BCLog::Logger::ThreadAsyncWriter()
+{
+    util::ThreadRename("logger");
+    std::string str;
+    // what is queued goes out in as few writes as possible, the file is unbuffered
+    std::string batch;
+    while (true) {
+        const uint64_t pushed{m_async_pushed.load(std::memory_order_acquire)};
+        const bool stop{m_async_stop.load()};
+        {
+            StdLockGuard scoped_lock(m_cs);
+            const auto flush = [&]() EXCLUSIVE_LOCKS_REQUIRED(m_cs) {
+                if (batch.empty()) return;
+                WriteOutputs(batch);
+                batch.clear();
+            };
+            while (AsyncPop(str)) {
+                for (const auto& cb : m_print_callbacks) {
+                    cb(str);
+                }
+                batch += str;
+                if (batch.size() >= 64 * 1024) flush();
+            }
+            const uint64_t dropped{m_async_dropped.load()};
+            if (dropped != m_async_dropped_reported) {
+                std::string msg{strprintf("%d log messages dropped, the log writer could not keep up\n", dropped - m_async_dropped_reported)};
+                if (m_log_timestamps) msg = FormatISO8601DateTime(GetTime()) + " " + msg;
+                for (const auto& cb : m_print_callbacks) {
+                    cb(msg);
+                }
+                batch += msg;
+                m_async_dropped_reported = dropped;
+            }
+            flush();
+        }
+        if (stop) return;
+        m_async_pushed.wait(pushed, std::memory_order_acquire);
+    }
+}
+
+void BCLog::Logger::StartAsyncWriter(size_t max_bytes)
+{
+    {
+        StdLockGuard scoped_lock(m_cs);
+        assert(!m_buffering);
+        if (m_async) return;
+        if (!m_async_ring) {
+            m_async_ring = std::make_unique<AsyncSlot[]>(ASYNC_RING_SLOTS);
+        }
+        for (size_t i = 0; i < ASYNC_RING_SLOTS; ++i) {
+            m_async_ring[i].seq.store(m_async_tail + i);
+        }
+        m_async_head = m_async_tail;
+        m_async_max_bytes = max_bytes;
+        m_async_stop = false;
+    }
+    m_async_thread = std::thread(&BCLog::Logger::ThreadAsyncWriter, this);
+    m_async = true;
+}
+
+void BCLog::Logger::StopAsyncWriter()
+{
+    if (!m_async.exchange(false)) return;
+    // let the threads that already decided to queue finish, later ones write on their own
+    while (m_async_producers.load() > 0) {
+        std::this_thread::yield();
+    }
+    m_async_stop = true;
+    m_async_pushed.fetch_add(1, std::memory_order_release);
+    m_async_pushed.notify_one();
+    m_async_thread.join();
+}
+
 void BCLog::Logger::ShrinkDebugFile()
 {
     // Amount of debug.log to save at end when shrinking (must fit in memory)
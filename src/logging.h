@@ -6,6 +6,10 @@
 #ifndef SYSCOIN_LOGGING_H
 #define SYSCOIN_LOGGING_H
 
+#if defined(HAVE_CONFIG_H)
+#include <config/syscoin-config.h>
+#endif
+
 #include <threadsafety.h>
 #include <tinyformat.h>
 #include <util/fs.h>
@@ -15,8 +19,10 @@
 #include <cstdint>
 #include <functional>
 #include <list>
+#include <memory>
 #include <mutex>
 #include <string>
+#include <thread>
 #include <unordered_map>
 #include <vector>
 
@@ -25,6 +31,10 @@ static const bool DEFAULT_LOGIPS        = false;
 static const bool DEFAULT_LOGTIMESTAMPS = true;
 static const bool DEFAULT_LOGTHREADNAMES = false;
 static const bool DEFAULT_LOGSOURCELOCATIONS = false;
+// SYSCOIN
+static const bool DEFAULT_LOGASYNC = false;
+//! MiB of messages queued for the writer thread of -logasync before new ones are dropped
+static const int DEFAULT_LOGASYNC_BUFFER = 16;
 extern const char * const DEFAULT_DEBUGLOGFILE;
 
 extern bool fLogIPs;
@@ -96,6 +106,18 @@ namespace BCLog {
     };
     constexpr auto DEFAULT_LOG_LEVEL{Level::Debug};
 
+    // SYSCOIN categories logged on hot paths (llmq-sigs, syscoin), left out of builds configured with --disable-verbose-logging
+#ifdef DISABLE_VERBOSE_LOGGING
+    constexpr uint64_t COMPILED_OUT_CATEGORIES{LLMQ_SIGS | SYS};
+#else
+    constexpr uint64_t COMPILED_OUT_CATEGORIES{NONE};
+#endif
+    /** Whether messages below Warning level of a category are compiled out, warnings and errors never are */
+    constexpr bool IsCompiledOut(LogFlags category, Level level)
+    {
+        return level < Level::Warning && category != NONE && (category & ~COMPILED_OUT_CATEGORIES) == 0;
+    }
+
     class Logger
     {
     private:
@@ -127,6 +149,40 @@ namespace BCLog {
         /** Slots that connect to the print signal */
         std::list<std::function<void(const std::string&)>> m_print_callbacks GUARDED_BY(m_cs) {};
 
+        // SYSCOIN with the writer thread running the logging threads only format their
+        // messages and queue them in a bounded ring (a Vyukov MPSC queue): a slot whose
+        // seq equals the position of the producer is free, position + 1 means written.
+        struct AsyncSlot {
+            std::atomic<uint64_t> seq{0};
+            std::string msg;
+        };
+        static constexpr size_t ASYNC_RING_SLOTS{1 << 16};
+        std::unique_ptr<AsyncSlot[]> m_async_ring;
+        std::atomic<uint64_t> m_async_head{0};
+        uint64_t m_async_tail GUARDED_BY(m_cs){0};
+        //! size of the queued messages, bounded by m_async_max_bytes
+        std::atomic<size_t> m_async_bytes{0};
+        size_t m_async_max_bytes{0};
+        //! bumped for every queued message, the writer thread waits on it
+        std::atomic<uint64_t> m_async_pushed{0};
+        std::atomic<uint64_t> m_async_dropped{0};
+        uint64_t m_async_dropped_reported GUARDED_BY(m_cs){0};
+        std::atomic<bool> m_async{false};
+        //! threads between checking m_async and queueing their message
+        std::atomic<int> m_async_producers{0};
+        std::atomic<bool> m_async_stop{false};
+        std::thread m_async_thread;
+
+        /** Add the prefixes of the enabled log options to a message */
+        std::string PrefixLogStr(const std::string& str, const std::string& logging_function, const std::string& source_file, int source_line, BCLog::LogFlags category, BCLog::Level level);
+        /** Write a prefixed message to the callbacks, the console and the debug log file */
+        void WriteStr(const std::string& str) EXCLUSIVE_LOCKS_REQUIRED(m_cs);
+        /** Write prefixed messages to the console and the debug log file */
+        void WriteOutputs(const std::string& str) EXCLUSIVE_LOCKS_REQUIRED(m_cs);
+        bool AsyncPush(std::string&& str);
+        bool AsyncPop(std::string& str) EXCLUSIVE_LOCKS_REQUIRED(m_cs);
+        void ThreadAsyncWriter();
+
     public:
         bool m_print_to_console = false;
         bool m_print_to_file = false;
@@ -169,6 +225,18 @@ namespace BCLog {
         /** Only for testing */
         void DisconnectTestLogger();
 
+        // SYSCOIN
+        /**
+         * Write messages from a background thread from now on, the logging threads
+         * no longer wait for the outputs. When more than max_bytes are waiting to
+         * be written new messages are dropped and counted instead.
+         */
+        void StartAsyncWriter(size_t max_bytes);
+        /** Write the queued messages and go back to writing on the logging threads */
+        void StopAsyncWriter();
+        bool IsAsync() const { return m_async.load(); }
+        uint64_t DroppedMessages() const { return m_async_dropped.load(); }
+
         void ShrinkDebugFile();
 
         std::unordered_map<LogFlags, Level> CategoryLevels() const
@@ -221,6 +289,8 @@ BCLog::Logger& LogInstance();
 /** Return true if log accepts specified category, at the specified level. */
 static inline bool LogAcceptCategory(BCLog::LogFlags category, BCLog::Level level)
 {
+    // SYSCOIN a constant for the categories compiled out, the logging macros below then drop the call with its arguments
+    if (BCLog::IsCompiledOut(category, level)) return false;
     return LogInstance().WillLogCategoryLevel(category, level);
 }
 
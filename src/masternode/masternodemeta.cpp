@@ -4,12 +4,13 @@
 
 #include <masternode/masternodemeta.h>
 
+#include <evo/deterministicmns.h>
 #include <flatdatabase.h>
 #include <util/time.h>
 
 #include <sstream>
 std::unique_ptr<CMasternodeMetaMan> mmetaman;
-const std::string MasternodeMetaStore::SERIALIZATION_VERSION_STRING = "CMasternodeMetaMan-Version-3";
+const std::string MasternodeMetaStore::SERIALIZATION_VERSION_STRING = "CMasternodeMetaMan-Version-4";
 
 CMasternodeMetaMan::CMasternodeMetaMan() :
     m_db{std::make_unique<db_type>("mncache.dat", "magicMasternodeCache")}
@@ -44,22 +45,6 @@ UniValue CMasternodeMetaInfo::ToJson() const
     return ret;
 }
 
-void CMasternodeMetaInfo::AddGovernanceVote(const uint256& nGovernanceObjectHash)
-{
-    LOCK(cs);
-    // Insert a zero value, or not. Then increment the value regardless. This
-    // ensures the value is in the map.
-    const auto& pair = mapGovernanceObjectsVotedOn.emplace(nGovernanceObjectHash, 0);
-    pair.first->second++;
-}
-
-void CMasternodeMetaInfo::RemoveGovernanceObject(const uint256& nGovernanceObjectHash)
-{
-    LOCK(cs);
-    // Whether or not the govobj hash exists in the map first is irrelevant.
-    mapGovernanceObjectsVotedOn.erase(nGovernanceObjectHash);
-}
-
 CMasternodeMetaInfoPtr CMasternodeMetaMan::GetMetaInfo(const uint256& proTxHash, bool fCreate)
 {
     LOCK(cs);
@@ -74,18 +59,14 @@ CMasternodeMetaInfoPtr CMasternodeMetaMan::GetMetaInfo(const uint256& proTxHash,
     return it->second;
 }
 
-bool CMasternodeMetaMan::AddGovernanceVote(const uint256& proTxHash, const uint256& nGovernanceObjectHash)
-{
-    auto mm = GetMetaInfo(proTxHash);
-    mm->AddGovernanceVote(nGovernanceObjectHash);
-    return true;
-}
-
-void CMasternodeMetaMan::RemoveGovernanceObject(const uint256& nGovernanceObjectHash)
+void CMasternodeMetaMan::RemoveMasternodes(const CDeterministicMNList& oldMNList, const CDeterministicMNListDiff& diff)
 {
+    if (diff.removedMns.empty()) return;
     LOCK(cs);
-    for(const auto& p : metaInfos) {
-        p.second->RemoveGovernanceObject(nGovernanceObjectHash);
+    for (const auto& nInternalId : diff.removedMns) {
+        if (const auto dmn = oldMNList.GetMNByInternalId(nInternalId)) {
+            metaInfos.erase(dmn->proTxHash);
+        }
     }
 }
 
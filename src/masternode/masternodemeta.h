@@ -15,13 +15,15 @@
 #include <memory>
 
 class CConnman;
+class CDeterministicMNList;
+class CDeterministicMNListDiff;
 template<typename T>
 class CFlatDB;
 
 static constexpr int MASTERNODE_MAX_FAILED_OUTBOUND_ATTEMPTS{5};
 
 // Holds extra (non-deterministic) information about masternodes
-// This is mostly local information, e.g. about mixing and governance
+// This is mostly local information, e.g. about outbound connection attempts
 class CMasternodeMetaInfo
 {
     friend class CMasternodeMetaMan;
@@ -31,9 +33,6 @@ private:
 
     uint256 proTxHash GUARDED_BY(cs);
 
-    // KEEP TRACK OF GOVERNANCE ITEMS EACH MASTERNODE HAS VOTE UPON FOR RECALCULATION
-    std::map<uint256, int> mapGovernanceObjectsVotedOn GUARDED_BY(cs);
-
     std::atomic<int> outboundAttemptCount{0};
     std::atomic<int64_t> lastOutboundAttempt{0};
     std::atomic<int64_t> lastOutboundSuccess{0};
@@ -43,7 +42,6 @@ public:
     explicit CMasternodeMetaInfo(const uint256& _proTxHash) : proTxHash(_proTxHash) {}
     CMasternodeMetaInfo(const CMasternodeMetaInfo& ref) :
         proTxHash(ref.proTxHash),
-        mapGovernanceObjectsVotedOn(ref.mapGovernanceObjectsVotedOn),
         lastOutboundAttempt(ref.lastOutboundAttempt.load()),
         lastOutboundSuccess(ref.lastOutboundSuccess.load())
     {
@@ -54,7 +52,6 @@ public:
         LOCK(obj.cs);
         READWRITE(
                 obj.proTxHash,
-                obj.mapGovernanceObjectsVotedOn,
                 obj.outboundAttemptCount,
                 obj.lastOutboundAttempt,
                 obj.lastOutboundSuccess
@@ -69,11 +66,6 @@ public:
         LOCK(cs);
         return proTxHash;
     }
-    // KEEP TRACK OF EACH GOVERNANCE ITEM IN CASE THIS NODE GOES OFFLINE, SO WE CAN RECALCULATE THEIR STATUS
-    void AddGovernanceVote(const uint256& nGovernanceObjectHash);
-
-    void RemoveGovernanceObject(const uint256& nGovernanceObjectHash);
-
     bool OutboundFailedTooManyTimes() const { return outboundAttemptCount > MASTERNODE_MAX_FAILED_OUTBOUND_ATTEMPTS; }
     void SetLastOutboundAttempt(int64_t t) { lastOutboundAttempt = t; ++outboundAttemptCount; }
     int64_t GetLastOutboundAttempt() const { return lastOutboundAttempt; }
@@ -121,6 +113,38 @@ public:
         }
     }
 
+    // SYSCOIN records of the cache, one per masternode
+    static constexpr uint8_t RECORD_VERSION{0};
+    static constexpr uint8_t RECORD_META_INFO{1};
+
+    template<typename Writer>
+    void SerializeRecords(Writer& w) const
+    {
+        LOCK(cs);
+        w.Write(RECORD_VERSION, SERIALIZATION_VERSION_STRING);
+        for (const auto& [_, metaInfo] : metaInfos) {
+            w.Write(RECORD_META_INFO, *metaInfo);
+        }
+    }
+
+    template<typename Stream>
+    bool UnserializeRecord(Stream& s)
+    {
+        LOCK(cs);
+        uint8_t nType;
+        s >> nType;
+        if (nType == RECORD_VERSION) {
+            std::string strVersion;
+            s >> strVersion;
+            return strVersion == SERIALIZATION_VERSION_STRING;
+        } else if (nType == RECORD_META_INFO) {
+            CMasternodeMetaInfo mm;
+            s >> mm;
+            metaInfos.emplace(mm.GetProTxHash(), std::make_shared<CMasternodeMetaInfo>(std::move(mm)));
+        }
+        return true;
+    }
+
     void Clear()
     {
         LOCK(cs);
@@ -151,8 +175,8 @@ public:
 
     CMasternodeMetaInfoPtr GetMetaInfo(const uint256& proTxHash, bool fCreate = true);
 
-    bool AddGovernanceVote(const uint256& proTxHash, const uint256& nGovernanceObjectHash);
-    void RemoveGovernanceObject(const uint256& nGovernanceObjectHash);
+    // SYSCOIN forget masternodes that left the list, nothing else would ever drop them
+    void RemoveMasternodes(const CDeterministicMNList& oldMNList, const CDeterministicMNListDiff& diff);
 };
 
 extern std::unique_ptr<CMasternodeMetaMan> mmetaman;
@@ -13,9 +13,21 @@
 
 #include <evo/deterministicmns.h>
 #include <evo/specialtx.h>
+#include <saltedhasher.h>
+#include <unordered_lru_cache.h>
 #include <string>
 
 CMasternodePayments mnpayments;
+// SYSCOIN
+namespace {
+/**
+ * Payee of the block on top of a given block. The list of a block never changes, so getblocktemplate,
+ * TestBlockValidity and ConnectBlock of the same height share one lookup. A few entries cover competing tips.
+ */
+Mutex cs_payeeCache;
+unordered_lru_cache<uint256, CDeterministicMNCPtr, StaticSaltedHasher, 16> payeeCache GUARDED_BY(cs_payeeCache);
+} // namespace
+
 void CheckAndWriteBudget(const CAmount& nSuperblockPayment, const CAmount& nPaymentLimit, const CAmount& nGovernanceBudgetUp, const CBlockIndex* pindex) {
     CAmount nGovernanceBudgetDown = (nPaymentLimit * CSuperblock::SHIFT_DOWN) / CSuperblock::SHIFT;
     if (nGovernanceBudgetDown < CSuperblock::SUPERBLOCK_BUDGET_MIN) {
@@ -257,9 +269,13 @@ bool CMasternodePayments::GetBlockTxOuts(CChain& activeChain, int nBlockHeight,
         const CBlockIndex* pindex = activeChain[nBlockHeight - 1];
         if(!pindex)
             return false;
-        dmnPayee = deterministicMNManager->GetListForBlock(pindex).GetMNPayee();
-        if (!dmnPayee) {
-            return false;
+        const uint256 hashPrevBlock = pindex->GetBlockHash();
+        if (!WITH_LOCK(cs_payeeCache, return payeeCache.get(hashPrevBlock, dmnPayee))) {
+            dmnPayee = deterministicMNManager->GetListForBlock(pindex).GetMNPayee();
+            if (!dmnPayee) {
+                return false;
+            }
+            WITH_LOCK(cs_payeeCache, payeeCache.insert(hashPrevBlock, dmnPayee));
         }
     }
     nCollateralHeightRet = dmnPayee->pdmnState->nCollateralHeight;
@@ -14,8 +14,11 @@
 #include <util/translation.h>
 #include <timedata.h>
 #include <net.h>
+#include <net_processing.h>
 #include <node/mempool_persist_args.h>
 #include <common/args.h>
+
+#include <algorithm>
 using node::ShouldSyncMempool;
 class CMasternodeSync;
 CMasternodeSync masternodeSync;
@@ -40,6 +43,7 @@ void CMasternodeSync::Reset(bool fForce, bool fNotifyReset)
     nTimeLastBumped = GetTime();
     nTimeLastUpdateBlockTip = 0;
     fReachedBestHeader = false;
+    WITH_LOCK(cs_pendingRequests, mapPendingRequests.clear());
     if (fNotifyReset) {
         uiInterface.NotifyAdditionalDataSyncProgressChanged(-1);
     }
@@ -86,6 +90,7 @@ void CMasternodeSync::SwitchToNextAsset(CConnman& connman)
     }
     nTriedPeerCount = 0;
     nTimeAssetSyncStarted = GetTime();
+    WITH_LOCK(cs_pendingRequests, mapPendingRequests.clear());
     BumpAssetLastTime("CMasternodeSync::SwitchToNextAsset");
 }
 
@@ -99,7 +104,21 @@ bilingual_str CMasternodeSync::GetSyncStatus()
     }
 }
 
-void CMasternodeSync::ProcessMessage(CNode* pfrom, const std::string& strCommand, CDataStream& vRecv) const
+void CMasternodeSync::AddPendingRequest(NodeId nodeId)
+{
+    if (IsSynced()) return;
+    LOCK(cs_pendingRequests);
+    mapPendingRequests[nodeId]++;
+}
+
+int CMasternodeSync::GetPendingRequests(NodeId nodeId) const
+{
+    LOCK(cs_pendingRequests);
+    auto it = mapPendingRequests.find(nodeId);
+    return it == mapPendingRequests.end() ? 0 : it->second;
+}
+
+void CMasternodeSync::ProcessMessage(CNode* pfrom, const std::string& strCommand, CDataStream& vRecv)
 {
     if (strCommand == NetMsgType::SYNCSTATUSCOUNT) { //Sync status count
 
@@ -111,6 +130,16 @@ void CMasternodeSync::ProcessMessage(CNode* pfrom, const std::string& strCommand
         vRecv >> nItemID >> nCount;
 
         LogPrint(BCLog::MNSYNC, "SYNCSTATUSCOUNT -- got inventory count: nItemID=%d  nCount=%d  peer=%d\n", nItemID, nCount, pfrom->GetId());
+
+        // SYSCOIN the peer is done with one of our requests, queue the next one (or finish) right away
+        if (nItemID != MASTERNODE_SYNC_GOVOBJ && nItemID != MASTERNODE_SYNC_GOVOBJ_VOTE) return;
+        LOCK(cs_pendingRequests);
+        auto it = mapPendingRequests.find(pfrom->GetId());
+        if (it == mapPendingRequests.end()) return;
+        if (--it->second <= 0) {
+            mapPendingRequests.erase(it);
+        }
+        fTickNow = true;
     }
 }
 
@@ -131,12 +160,15 @@ void CMasternodeSync::ProcessTick(CConnman& connman, const PeerManager& peerman)
         return;
     }
 
-    if(GetTime() - nTimeLastProcess < MASTERNODE_SYNC_TICK_SECONDS) {
+    // SYSCOIN an answered sync request lets the next one go out without waiting for the tick
+    if(!fTickNow && GetTime() - nTimeLastProcess < MASTERNODE_SYNC_TICK_SECONDS) {
         // too early, nothing to do here
         return;
     }
 
+    fTickNow = false;
     nTimeLastProcess = GetTime();
+    int nGovernanceRequests = 0;
     const CConnman::NodesSnapshot snap{connman, /* filter = */ FullyConnectedOnly};
 
     // gradually request the rest of the votes after sync finished
@@ -288,7 +320,8 @@ void CMasternodeSync::ProcessTick(CConnman& connman, const PeerManager& peerman)
 
                 SendGovernanceSyncRequest(pnode, connman);
 
-                break; //this will cause each peer to get one request each six seconds for the various assets we need
+                // SYSCOIN ask a few peers at once, objects announced by several of them are only downloaded once
+                if (++nGovernanceRequests >= MASTERNODE_SYNC_GOVERNANCE_PEERS) break;
             }
         }
     }
@@ -299,38 +332,41 @@ void CMasternodeSync::ProcessTick(CConnman& connman, const PeerManager& peerman)
     }
 
     // request votes on per-obj basis from each node
+    // SYSCOIN keep up to MASTERNODE_SYNC_MAX_PENDING_REQUESTS requests in flight per node, each answer triggers
+    // the next tick, and finish as soon as every object was asked for and nothing is outstanding anymore
+    bool fAskedAll = true;
+    bool fOutstanding = false;
+    int nSyncPeers = 0;
+    {
+        LOCK(cs_pendingRequests);
+        std::erase_if(mapPendingRequests, [&snap](const auto& entry) {
+            const auto& nodes = snap.Nodes();
+            return std::none_of(nodes.begin(), nodes.end(), [&entry](const CNode* pnode) { return pnode->GetId() == entry.first; });
+        });
+    }
     for (auto& pnode : snap.Nodes()) {
         if(!netfulfilledman->HasFulfilledRequest(pnode->addr, "governance-sync")) {
             continue; // to early for this node
         }
+        nSyncPeers++;
+        if (GetPendingRequests(pnode->GetId()) >= MASTERNODE_SYNC_MAX_PENDING_REQUESTS) {
+            fAskedAll = false;
+            fOutstanding = true;
+            continue;
+        }
         int nObjsLeftToAsk = governance->RequestGovernanceObjectVotes(pnode, connman, peerman);
-        // check for data
-        if(nObjsLeftToAsk == 0) {
-            static int64_t nTimeNoObjectsLeft = 0;
-            static int nLastTick = 0;
-            static int nLastVotes = 0;
-            if(nTimeNoObjectsLeft == 0) {
-                // asked all objects for votes for the first time
-                nTimeNoObjectsLeft = GetTime();
-            }
-            // make sure the condition below is checked only once per tick
-            if(nLastTick == nTick) continue;
-            if(GetTime() - nTimeNoObjectsLeft > MASTERNODE_SYNC_TIMEOUT_SECONDS &&
-                governance->GetVoteCount() - nLastVotes < std::max(int(0.0001 * nLastVotes), MASTERNODE_SYNC_TICK_SECONDS)
-            ) {
-                // We already asked for all objects, waited for MASTERNODE_SYNC_TIMEOUT_SECONDS
-                // after that and less then 0.01% or MASTERNODE_SYNC_TICK_SECONDS
-                // (i.e. 1 per second) votes were received during the last tick.
-                // We can be pretty sure that we are done syncing.
-                LogPrintf("CMasternodeSync::ProcessTick -- nTick %d nCurrentAsset %d -- asked for all objects, nothing to do\n", nTick, MASTERNODE_SYNC_GOVERNANCE);
-                // reset nTimeNoObjectsLeft to be able to use the same condition on resync
-                nTimeNoObjectsLeft = 0;
-                SwitchToNextAsset(connman);
-                return;
-            }
-            nLastTick = nTick;
-            nLastVotes = governance->GetVoteCount();
+        if (nObjsLeftToAsk > 0) {
+            fAskedAll = false;
         }
+        if (GetPendingRequests(pnode->GetId()) > 0 || WITH_LOCK(cs_main, return peerman.GetRequestedCount(pnode->GetId())) > 0) {
+            fOutstanding = true;
+        }
+    }
+    // objects and votes announced in answer to a request are fetched only after its SYNCSTATUSCOUNT,
+    // so also wait for one tick without new data
+    if (nSyncPeers > 0 && fAskedAll && !fOutstanding && GetTime() - GetTimeLastBumped() >= MASTERNODE_SYNC_TICK_SECONDS) {
+        LogPrintf("CMasternodeSync::ProcessTick -- nTick %d nCurrentAsset %d -- asked for all objects, nothing to do\n", nTick, MASTERNODE_SYNC_GOVERNANCE);
+        SwitchToNextAsset(connman);
     }
 }
 
@@ -341,7 +377,7 @@ void CMasternodeSync::SendGovernanceSyncRequest(CNode* pnode, CConnman& connman)
     CBloomFilter filter;
 
     connman.PushMessage(pnode, msgMaker.Make(NetMsgType::MNGOVERNANCESYNC, uint256(), filter));
-    
+    AddPendingRequest(pnode->GetId());
 }
 
 void CMasternodeSync::NotifyHeaderTip(const CBlockIndex *pindexNew)
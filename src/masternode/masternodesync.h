@@ -7,6 +7,7 @@
 #include <util/translation.h>
 #include <sync.h>
 #include <atomic>
+#include <map>
 class CMasternodeSync;
 class PeerManager;
 class CBlockIndex;
@@ -14,6 +15,7 @@ class CConnman;
 class CNode;
 class CDataStream;
 class ChainstateManager;
+using NodeId = int64_t;
 static constexpr int MASTERNODE_SYNC_BLOCKCHAIN      = 1;
 static constexpr int MASTERNODE_SYNC_GOVERNANCE      = 4;
 static constexpr int MASTERNODE_SYNC_GOVOBJ          = 10;
@@ -23,6 +25,9 @@ static constexpr int MASTERNODE_SYNC_FINISHED        = 999;
 static constexpr int MASTERNODE_SYNC_TICK_SECONDS    = 6;
 static constexpr int MASTERNODE_SYNC_TIMEOUT_SECONDS = 30; // our blocks are 2.5 minutes so 30 seconds should be fine
 static constexpr int MASTERNODE_SYNC_RESET_SECONDS   = 900; // Reset fReachedBestHeader in CMasternodeSync::Reset if UpdateBlockTip hasn't been called for this seconds
+// SYSCOIN
+static constexpr int MASTERNODE_SYNC_GOVERNANCE_PEERS = 3; // Peers asked for the governance object list per tick
+static constexpr int MASTERNODE_SYNC_MAX_PENDING_REQUESTS = 2; // Unanswered vote sync requests per peer before we wait for it
 
 extern CMasternodeSync masternodeSync;
 
@@ -48,11 +53,22 @@ private:
     /// Last time UpdateBlockTip has been called
     std::atomic<int64_t> nTimeLastUpdateBlockTip {0};
 
+    // SYSCOIN
+    /// Governance sync requests each peer hasn't answered with SYNCSTATUSCOUNT yet
+    mutable Mutex cs_pendingRequests;
+    std::map<NodeId, int> mapPendingRequests GUARDED_BY(cs_pendingRequests);
+    /// Run the next tick without waiting for MASTERNODE_SYNC_TICK_SECONDS, set when a peer answered
+    std::atomic<bool> fTickNow {false};
+
+    int GetPendingRequests(NodeId nodeId) const EXCLUSIVE_LOCKS_REQUIRED(!cs_pendingRequests);
+
 public:
     CMasternodeSync();
 
 
-    static void SendGovernanceSyncRequest(CNode* pnode, CConnman& connman);
+    void SendGovernanceSyncRequest(CNode* pnode, CConnman& connman) EXCLUSIVE_LOCKS_REQUIRED(!cs_pendingRequests);
+    /// Remember a governance sync request sent to the peer while syncing, answered by a SYNCSTATUSCOUNT
+    void AddPendingRequest(NodeId nodeId) EXCLUSIVE_LOCKS_REQUIRED(!cs_pendingRequests);
 
     bool IsBlockchainSynced() const {return nCurrentAsset > MASTERNODE_SYNC_BLOCKCHAIN; }
     bool IsSynced() const { return nCurrentAsset == MASTERNODE_SYNC_FINISHED; }
@@ -68,15 +84,15 @@ public:
     std::string GetAssetName() const;
     bilingual_str GetSyncStatus();
 
-    void Reset(bool fForce = false, bool fNotifyReset = true);
-    void SwitchToNextAsset(CConnman& connman);
+    void Reset(bool fForce = false, bool fNotifyReset = true) EXCLUSIVE_LOCKS_REQUIRED(!cs_pendingRequests);
+    void SwitchToNextAsset(CConnman& connman) EXCLUSIVE_LOCKS_REQUIRED(!cs_pendingRequests);
 
-    void ProcessMessage(CNode* pfrom, const std::string& strCommand, CDataStream& vRecv) const;
-    void ProcessTick(CConnman& connman, const PeerManager& peerman);
+    void ProcessMessage(CNode* pfrom, const std::string& strCommand, CDataStream& vRecv) EXCLUSIVE_LOCKS_REQUIRED(!cs_pendingRequests);
+    void ProcessTick(CConnman& connman, const PeerManager& peerman) EXCLUSIVE_LOCKS_REQUIRED(!cs_pendingRequests);
     void NotifyHeaderTip(const CBlockIndex *pindexNew);
-    void UpdatedBlockTip(const CBlockIndex *pindexNew, ChainstateManager& chainman, bool fInitialDownload);
+    void UpdatedBlockTip(const CBlockIndex *pindexNew, ChainstateManager& chainman, bool fInitialDownload) EXCLUSIVE_LOCKS_REQUIRED(!cs_pendingRequests);
 
-    void DoMaintenance(CConnman &connman, const PeerManager& peerman);
+    void DoMaintenance(CConnman &connman, const PeerManager& peerman) EXCLUSIVE_LOCKS_REQUIRED(!cs_pendingRequests);
 };
 
 #endif // SYSCOIN_MASTERNODE_MASTERNODESYNC_H
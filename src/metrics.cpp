@@ -0,0 +1,226 @@
+// Copyright (c) 2024 The Syscoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <metrics.h>
+
+#include <common/args.h>
+#include <logging.h>
+#include <netbase.h>
+#include <rpc/protocol.h> // For HTTP status codes
+#include <tinyformat.h>
+#include <util/strencodings.h>
+#include <util/thread.h>
+
+#include <algorithm>
+#include <cassert>
+#include <thread>
+
+#include <event2/buffer.h>
+#include <event2/event.h>
+#include <event2/http.h>
+#include <event2/thread.h>
+
+#include <support/events.h>
+
+namespace metrics {
+
+void Metric::Render(std::string& out) const
+{
+    out += strprintf("# HELP %s %s\n# TYPE %s %s\n", m_name, m_help, m_name, Type());
+    RenderSamples(out);
+}
+
+void Counter::RenderSamples(std::string& out) const
+{
+    out += strprintf("%s %d\n", Name(), Value());
+}
+
+void Gauge::RenderSamples(std::string& out) const
+{
+    out += strprintf("%s %d\n", Name(), Value());
+}
+
+void CallbackMetric::RenderSamples(std::string& out) const
+{
+    out += strprintf("%s %d\n", Name(), m_value());
+}
+
+Histogram::Histogram(std::string name, std::string help, std::vector<double> bounds)
+    : Metric{std::move(name), std::move(help)},
+      m_bounds{std::move(bounds)},
+      m_buckets{std::make_unique<std::atomic<uint64_t>[]>(m_bounds.size() + 1)}
+{
+    assert(std::is_sorted(m_bounds.begin(), m_bounds.end()));
+}
+
+void Histogram::Observe(double value)
+{
+    const size_t bucket = std::lower_bound(m_bounds.begin(), m_bounds.end(), value) - m_bounds.begin();
+    m_buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+    m_sum.fetch_add(value, std::memory_order_relaxed);
+    m_count.fetch_add(1, std::memory_order_relaxed);
+}
+
+void Histogram::RenderSamples(std::string& out) const
+{
+    // the buckets are read one by one while others observe, so the +Inf bucket is their sum and not m_count
+    uint64_t cumulative{0};
+    for (size_t i = 0; i < m_bounds.size(); ++i) {
+        cumulative += m_buckets[i].load(std::memory_order_relaxed);
+        out += strprintf("%s_bucket{le=\"%g\"} %d\n", Name(), m_bounds[i], cumulative);
+    }
+    cumulative += m_buckets[m_bounds.size()].load(std::memory_order_relaxed);
+    out += strprintf("%s_bucket{le=\"+Inf\"} %d\n", Name(), cumulative);
+    out += strprintf("%s_sum %.9g\n", Name(), Sum());
+    out += strprintf("%s_count %d\n", Name(), cumulative);
+}
+
+const std::vector<double>& LatencyBuckets()
+{
+    static const std::vector<double> buckets{0.0005, 0.001, 0.0025, 0.005, 0.01, 0.025, 0.05, 0.1, 0.25, 0.5, 1, 2.5, 5, 10};
+    return buckets;
+}
+
+template <typename T, typename... Args>
+T& Registry::Get(const std::string& name, Args&&... args)
+{
+    LOCK(m_mutex);
+    auto it = m_metrics.find(name);
+    if (it == m_metrics.end()) {
+        it = m_metrics.emplace(name, std::make_unique<T>(name, std::forward<Args>(args)...)).first;
+    }
+    T* metric = dynamic_cast<T*>(it->second.get());
+    // one name, one kind of metric
+    assert(metric);
+    return *metric;
+}
+
+Counter& Registry::GetCounter(const std::string& name, const std::string& help)
+{
+    return Get<Counter>(name, help);
+}
+
+Gauge& Registry::GetGauge(const std::string& name, const std::string& help)
+{
+    return Get<Gauge>(name, help);
+}
+
+Histogram& Registry::GetHistogram(const std::string& name, const std::string& help, const std::vector<double>& bounds)
+{
+    return Get<Histogram>(name, help, bounds);
+}
+
+void Registry::AddCounterCallback(const std::string& name, const std::string& help, std::function<int64_t()> value)
+{
+    Get<CallbackMetric>(name, help, "counter", std::move(value));
+}
+
+void Registry::AddGaugeCallback(const std::string& name, const std::string& help, std::function<int64_t()> value)
+{
+    Get<CallbackMetric>(name, help, "gauge", std::move(value));
+}
+
+std::string Registry::Render() const
+{
+    std::string out;
+    LOCK(m_mutex);
+    for (const auto& [name, metric] : m_metrics) {
+        metric->Render(out);
+    }
+    return out;
+}
+
+Registry& GlobalRegistry()
+{
+    static Registry registry;
+    return registry;
+}
+
+} // namespace metrics
+
+static struct event_base* g_metrics_base{nullptr};
+static struct evhttp* g_metrics_http{nullptr};
+static std::thread g_metrics_thread;
+
+static void metrics_request_cb(struct evhttp_request* req, void*)
+{
+    if (evhttp_request_get_command(req) != EVHTTP_REQ_GET) {
+        evhttp_send_error(req, HTTP_BAD_METHOD, nullptr);
+        return;
+    }
+    const char* path = evhttp_uri_get_path(evhttp_request_get_evhttp_uri(req));
+    if (!path || std::string{path} != "/metrics") {
+        evhttp_send_error(req, HTTP_NOT_FOUND, nullptr);
+        return;
+    }
+    const std::string body{metrics::GlobalRegistry().Render()};
+    evhttp_add_header(evhttp_request_get_output_headers(req), "Content-Type", "text/plain; version=0.0.4");
+    evbuffer_add(evhttp_request_get_output_buffer(req), body.data(), body.size());
+    evhttp_send_reply(req, HTTP_OK, "OK", nullptr);
+}
+
+bool StartMetricsServer(const ArgsManager& args)
+{
+    assert(!g_metrics_base);
+    if (!args.IsArgSet("-metricsbind") || args.IsArgNegated("-metricsbind")) return true;
+#ifdef WIN32
+    evthread_use_windows_threads();
+#else
+    evthread_use_pthreads();
+#endif
+    raii_event_base base_ctr = obtain_event_base();
+    raii_evhttp http_ctr = obtain_evhttp(base_ctr.get());
+    if (!http_ctr) {
+        LogPrintf("metrics: couldn't create evhttp\n");
+        return false;
+    }
+    evhttp_set_allowed_methods(http_ctr.get(), EVHTTP_REQ_GET);
+    evhttp_set_gencb(http_ctr.get(), metrics_request_cb, nullptr);
+    bool bound{false};
+    for (const std::string& bind : args.GetArgs("-metricsbind")) {
+        uint16_t port{DEFAULT_METRICS_PORT};
+        std::string host;
+        if (!SplitHostPort(bind, port, host)) {
+            LogPrintf("metrics: invalid -metricsbind address %s\n", bind);
+            return false;
+        }
+        LogPrintf("Binding metrics on address %s port %i\n", host, port);
+        if (!evhttp_bind_socket_with_handle(http_ctr.get(), host.empty() ? nullptr : host.c_str(), port)) {
+            LogPrintf("Binding metrics on address %s port %i failed.\n", host, port);
+            continue;
+        }
+        const std::optional<CNetAddr> addr{LookupHost(host, false)};
+        if (host.empty() || (addr.has_value() && addr->IsBindAny())) {
+            LogPrintf("WARNING: the metrics are served to anyone who can reach address %s port %i\n", host, port);
+        }
+        bound = true;
+    }
+    if (!bound) return false;
+    g_metrics_base = base_ctr.release();
+    g_metrics_http = http_ctr.release();
+    g_metrics_thread = std::thread(&util::TraceThread, "metrics", [] {
+        event_base_dispatch(g_metrics_base);
+    });
+    return true;
+}
+
+void InterruptMetricsServer()
+{
+    if (g_metrics_base) {
+        event_base_once(g_metrics_base, -1, EV_TIMEOUT, [](evutil_socket_t, short, void*) {
+            event_base_loopbreak(g_metrics_base);
+        }, nullptr, nullptr);
+    }
+}
+
+void StopMetricsServer()
+{
+    if (g_metrics_base) {
+        if (g_metrics_thread.joinable()) g_metrics_thread.join();
+        evhttp_free(g_metrics_http);
+        g_metrics_http = nullptr;
+        event_base_free(g_metrics_base);
+        g_metrics_base = nullptr;
+    }
+}
@@ -0,0 +1,175 @@
+// Copyright (c) 2024 The Syscoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef SYSCOIN_METRICS_H
+#define SYSCOIN_METRICS_H
+
+#include <sync.h>
+#include <threadsafety.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+class ArgsManager;
+
+//! Port of -metricsbind when the address does not come with one
+static constexpr uint16_t DEFAULT_METRICS_PORT{9369};
+
+/**
+ * Counters, gauges and histograms updated inline by validation, the mempool,
+ * LLMQ, NEVM and net code, so dashboards can be built without scraping RPCs
+ * that take locks. Updating a metric is a relaxed atomic operation, the
+ * registry lock is only taken to register one and to render them all in the
+ * Prometheus text format served on -metricsbind.
+ *
+ * Hot paths look their metrics up once:
+ *
+ *     static metrics::Counter& blocks{metrics::GetCounter("syscoin_blocks_connected_total", "Blocks connected to the active chain")};
+ *     blocks.Inc();
+ */
+namespace metrics {
+
+class Metric
+{
+public:
+    Metric(std::string name, std::string help) : m_name{std::move(name)}, m_help{std::move(help)} {}
+    virtual ~Metric() = default;
+
+    const std::string& Name() const { return m_name; }
+    /** Append the HELP and TYPE lines and the samples in the Prometheus text format */
+    void Render(std::string& out) const;
+
+protected:
+    virtual const char* Type() const = 0;
+    virtual void RenderSamples(std::string& out) const = 0;
+
+private:
+    const std::string m_name;
+    const std::string m_help;
+};
+
+/** A value that only goes up, like bytes received */
+class Counter : public Metric
+{
+public:
+    using Metric::Metric;
+
+    void Inc(uint64_t n = 1) { m_value.fetch_add(n, std::memory_order_relaxed); }
+    uint64_t Value() const { return m_value.load(std::memory_order_relaxed); }
+
+protected:
+    const char* Type() const override { return "counter"; }
+    void RenderSamples(std::string& out) const override;
+
+private:
+    std::atomic<uint64_t> m_value{0};
+};
+
+/** A value that goes up and down, like the number of mempool transactions */
+class Gauge : public Metric
+{
+public:
+    using Metric::Metric;
+
+    void Set(int64_t value) { m_value.store(value, std::memory_order_relaxed); }
+    void Add(int64_t n) { m_value.fetch_add(n, std::memory_order_relaxed); }
+    int64_t Value() const { return m_value.load(std::memory_order_relaxed); }
+
+protected:
+    const char* Type() const override { return "gauge"; }
+    void RenderSamples(std::string& out) const override;
+
+private:
+    std::atomic<int64_t> m_value{0};
+};
+
+/** A counter or gauge read from a callback when rendered, for values kept by code below the node */
+class CallbackMetric : public Metric
+{
+public:
+    CallbackMetric(std::string name, std::string help, const char* type, std::function<int64_t()> value)
+        : Metric{std::move(name), std::move(help)}, m_type{type}, m_value{std::move(value)} {}
+
+protected:
+    const char* Type() const override { return m_type; }
+    void RenderSamples(std::string& out) const override;
+
+private:
+    const char* const m_type;
+    const std::function<int64_t()> m_value;
+};
+
+/**
+ * Distribution of observed values in buckets with fixed upper bounds, rendered
+ * cumulatively like Prometheus expects. Latencies are observed in seconds.
+ */
+class Histogram : public Metric
+{
+public:
+    Histogram(std::string name, std::string help, std::vector<double> bounds);
+
+    void Observe(double value);
+    void ObserveDuration(std::chrono::microseconds duration) { Observe(duration.count() * 1e-6); }
+    uint64_t Count() const { return m_count.load(std::memory_order_relaxed); }
+    double Sum() const { return m_sum.load(std::memory_order_relaxed); }
+
+protected:
+    const char* Type() const override { return "histogram"; }
+    void RenderSamples(std::string& out) const override;
+
+private:
+    const std::vector<double> m_bounds;
+    //! one per bound and one for the values above the last bound
+    const std::unique_ptr<std::atomic<uint64_t>[]> m_buckets;
+    std::atomic<uint64_t> m_count{0};
+    std::atomic<double> m_sum{0};
+};
+
+//! Bucket bounds in seconds for the latencies of block connects, signing rounds and Geth round trips
+const std::vector<double>& LatencyBuckets();
+
+class Registry
+{
+public:
+    /** Register a metric, or get the one registered under the name before */
+    Counter& GetCounter(const std::string& name, const std::string& help) EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+    Gauge& GetGauge(const std::string& name, const std::string& help) EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+    Histogram& GetHistogram(const std::string& name, const std::string& help, const std::vector<double>& bounds = LatencyBuckets()) EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+    /** Register a counter or gauge whose value is read from the callback, the first registration under a name is kept */
+    void AddCounterCallback(const std::string& name, const std::string& help, std::function<int64_t()> value) EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+    void AddGaugeCallback(const std::string& name, const std::string& help, std::function<int64_t()> value) EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+
+    /** All metrics in the Prometheus text exposition format, ordered by name */
+    std::string Render() const EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+
+private:
+    mutable Mutex m_mutex;
+    //! metrics are never removed, so references handed out stay valid
+    std::map<std::string, std::unique_ptr<Metric>> m_metrics GUARDED_BY(m_mutex);
+
+    template <typename T, typename... Args>
+    T& Get(const std::string& name, Args&&... args) EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+};
+
+/** The registry served on -metricsbind */
+Registry& GlobalRegistry();
+
+inline Counter& GetCounter(const std::string& name, const std::string& help) { return GlobalRegistry().GetCounter(name, help); }
+inline Gauge& GetGauge(const std::string& name, const std::string& help) { return GlobalRegistry().GetGauge(name, help); }
+inline Histogram& GetHistogram(const std::string& name, const std::string& help, const std::vector<double>& bounds = LatencyBuckets()) { return GlobalRegistry().GetHistogram(name, help, bounds); }
+
+} // namespace metrics
+
+/** Serve the metrics over HTTP on the -metricsbind addresses, on a thread of its own. */
+bool StartMetricsServer(const ArgsManager& args);
+void InterruptMetricsServer();
+void StopMetricsServer();
+
+#endif // SYSCOIN_METRICS_H
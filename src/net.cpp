@@ -50,6 +50,7 @@
 #include <cstdint>
 #include <functional>
 #include <optional>
+#include <set>
 #include <unordered_map>
 
 #include <math.h>
@@ -61,6 +62,7 @@
 #include <netmessagemaker.h>
 #include <timedata.h>
 #include <validation.h>
+#include <metrics.h>
 /** Maximum number of block-relay-only anchor connections */
 static constexpr size_t MAX_BLOCK_RELAY_ONLY_ANCHORS = 2;
 static_assert (MAX_BLOCK_RELAY_ONLY_ANCHORS <= static_cast<size_t>(MAX_BLOCK_RELAY_ONLY_CONNECTIONS), "MAX_BLOCK_RELAY_ONLY_ANCHORS must not exceed MAX_BLOCK_RELAY_ONLY_CONNECTIONS.");
@@ -115,6 +117,12 @@ const std::string NET_MESSAGE_TYPE_OTHER = "*other*";
 static const uint64_t RANDOMIZER_ID_NETGROUP = 0x6c0edd8036ef4036ULL; // SHA256("netgroup")[0:8]
 static const uint64_t RANDOMIZER_ID_LOCALHOSTNONCE = 0xd93e69e2bbfa5735ULL; // SHA256("localhostnonce")[0:8]
 static const uint64_t RANDOMIZER_ID_ADDRCACHE = 0x1cf2e4ddd306dda9ULL; // SHA256("addrcache")[0:8]
+// SYSCOIN
+static metrics::Gauge& PeersGauge()
+{
+    static metrics::Gauge& peers{metrics::GetGauge("syscoin_net_peers", "Connected peers")};
+    return peers;
+}
 //
 // Global state variables
 //
@@ -123,6 +131,50 @@ bool fListen = true;
 GlobalMutex g_maplocalhost_mutex;
 std::map<CNetAddr, LocalServiceInfo> mapLocalHost GUARDED_BY(g_maplocalhost_mutex);
 std::string strSubVersion;
+// SYSCOIN
+NetRecvBufferPool g_recv_buffer_pool;
+
+// SYSCOIN
+bool NetRecvBufferPool::Take(CDataStream& stream, size_t size)
+{
+    if (size < MIN_BUFFER_SIZE) return false;
+    LOCK(m_mutex);
+    // the smallest one that fits, so the buffer of a large block stays for the next large block
+    auto best{m_buffers.end()};
+    for (auto it = m_buffers.begin(); it != m_buffers.end(); ++it) {
+        if (it->GetType() != stream.GetType() || it->capacity() < size) continue;
+        if (best == m_buffers.end() || it->capacity() < best->capacity()) best = it;
+    }
+    if (best == m_buffers.end()) return false;
+    const int version{stream.GetVersion()};
+    m_pooled_bytes -= best->capacity();
+    stream = std::move(*best);
+    stream.SetVersion(version);
+    m_buffers.erase(best);
+    return true;
+}
+
+void NetRecvBufferPool::Give(CDataStream&& stream)
+{
+    const size_t capacity{stream.capacity()};
+    if (capacity < MIN_BUFFER_SIZE || capacity > MAX_POOLED_BYTES) return;
+    stream.clear();
+    LOCK(m_mutex);
+    // make room by dropping smaller buffers, a bigger one fits more messages
+    while (m_pooled_bytes + capacity > MAX_POOLED_BYTES) {
+        auto smallest{std::min_element(m_buffers.begin(), m_buffers.end(), [](const auto& a, const auto& b) { return a.capacity() < b.capacity(); })};
+        if (smallest == m_buffers.end() || smallest->capacity() >= capacity) return;
+        m_pooled_bytes -= smallest->capacity();
+        m_buffers.erase(smallest);
+    }
+    m_pooled_bytes += capacity;
+    m_buffers.emplace_back(std::move(stream));
+}
+
+size_t NetRecvBufferPool::Size() const
+{
+    return WITH_LOCK(m_mutex, return m_buffers.size());
+}
 
 size_t CSerializedNetMsg::GetMemoryUsage() const noexcept
 {
@@ -131,6 +183,45 @@ size_t CSerializedNetMsg::GetMemoryUsage() const noexcept
     // size; 15 bytes in modern libstdc++).
     return sizeof(*this) + memusage::DynamicUsage(data);
 }
+// SYSCOIN
+NetMsgClass GetNetMsgClass(const CSerializedNetMsg& msg)
+{
+    static const std::set<std::string> setPriority{
+        NetMsgType::CLSIG, NetMsgType::QSIGSHARE, NetMsgType::QBSIGSHARES, NetMsgType::QSIGSESANN,
+        NetMsgType::QSIGSHARESINV, NetMsgType::QGETSIGSHARES, NetMsgType::QSIGREC,
+        NetMsgType::HEADERS, NetMsgType::CMPCTBLOCK,
+    };
+    if (setPriority.count(msg.m_type)) return NetMsgClass::PRIORITY;
+    // pings queue behind everything queued before them, so a pong still tells the messages before it were sent
+    if (msg.m_type == NetMsgType::BLOCK || msg.m_type == NetMsgType::BLOBCHUNK || msg.m_type == NetMsgType::PING ||
+        msg.m_type == NetMsgType::PONG || msg.data.size() > BULK_NET_MSG_SIZE) {
+        return NetMsgClass::BULK;
+    }
+    return NetMsgClass::NORMAL;
+}
+
+std::deque<CSerializedNetMsg>* CNode::NextSendQueue(uint64_t bulk_rate, std::chrono::microseconds now)
+{
+    for (size_t i = 0; i < NUM_NET_MSG_CLASSES; i++) {
+        if (vSendMsg[i].empty()) continue;
+        if (i == size_t(NetMsgClass::BULK) && bulk_rate > 0) {
+            // refill at bulk_rate, at most one second worth is saved up
+            if (now > m_bulk_send_refill) {
+                const double refill{double(bulk_rate) * count_microseconds(now - m_bulk_send_refill) / 1e6};
+                m_bulk_send_allowance = std::min<double>(bulk_rate, m_bulk_send_allowance + refill);
+                m_bulk_send_refill = now;
+            }
+            if (m_bulk_send_allowance < 0) return nullptr;
+        }
+        return &vSendMsg[i];
+    }
+    return nullptr;
+}
+
+bool CNode::SendQueuesEmpty() const
+{
+    return std::all_of(vSendMsg.begin(), vSendMsg.end(), [](const auto& queue) { return queue.empty(); });
+}
 
 void CConnman::AddAddrFetch(const std::string& strDest)
 {
@@ -695,9 +786,31 @@ void CNode::CopyStats(CNodeStats& stats)
     }
     X(m_masternode_connection);
     X(m_conn_type);
+    {
+        LOCK(m_process_cost_mutex);
+        X(mapProcessCostPerMsgType);
+    }
+    stats.m_process_time = 0us;
+    for (const auto& [_, cost] : stats.mapProcessCostPerMsgType) {
+        stats.m_process_time += cost.time;
+    }
 }
 #undef X
 
+// SYSCOIN
+void CNode::AccountProcessCost(const std::string& msg_type, std::chrono::microseconds time, uint64_t count)
+{
+    LOCK(m_process_cost_mutex);
+    // like the received bytes, only known message types get their own entry
+    auto it = mapProcessCostPerMsgType.find(msg_type);
+    if (it == mapProcessCostPerMsgType.end()) {
+        it = mapProcessCostPerMsgType.find(NET_MESSAGE_TYPE_OTHER);
+    }
+    assert(it != mapProcessCostPerMsgType.end());
+    it->second.count += count;
+    it->second.time += time;
+}
+
 bool CNode::ReceiveMsgBytes(Span<const uint8_t> msg_bytes, bool& complete)
 {
     complete = false;
@@ -802,6 +915,8 @@ int V1Transport::readData(Span<const uint8_t> msg_bytes)
     unsigned int nRemaining = hdr.nMessageSize - nDataPos;
     unsigned int nCopy = std::min<unsigned int>(nRemaining, msg_bytes.size());
 
+    // SYSCOIN a large message goes into a pooled buffer that can hold all of it, if there is one
+    if (nDataPos == 0) g_recv_buffer_pool.Take(vRecv, hdr.nMessageSize);
     if (vRecv.size() < nDataPos + nCopy) {
         // Allocate up to 256 KiB ahead, but never more than the total message size.
         vRecv.resize(std::min(hdr.nMessageSize, nDataPos + nCopy + 256 * 1024));
@@ -1499,6 +1614,8 @@ CNetMessage V2Transport::GetReceivedMessage(std::chrono::microseconds time, bool
         msg.m_type = std::move(*msg_type);
         msg.m_time = time;
         msg.m_message_size = contents.size();
+        // SYSCOIN
+        g_recv_buffer_pool.Take(msg.m_recv, contents.size());
         msg.m_recv.resize(contents.size());
         std::copy(contents.begin(), contents.end(), UCharCast(msg.m_recv.data()));
     } else {
@@ -1631,24 +1748,30 @@ Transport::Info V2Transport::GetInfo() const noexcept
 
 std::pair<size_t, bool> CConnman::SocketSendData(CNode& node) const
 {
-    auto it = node.vSendMsg.begin();
+    // SYSCOIN
+    const auto now{GetTime<std::chrono::microseconds>()};
+    auto* queue = node.NextSendQueue(m_max_bulk_send_rate, now);
     size_t nSentSize = 0;
     bool data_left{false}; //!< second return value (whether unsent data remains)
     std::optional<bool> expected_more;
 
     while (true) {
-        if (it != node.vSendMsg.end()) {
+        if (queue) {
             // If possible, move one message from the send queue to the transport. This fails when
             // there is an existing message still being sent, or (for v2 transports) when the
             // handshake has not yet completed.
-            size_t memusage = it->GetMemoryUsage();
-            if (node.m_transport->SetMessageToSend(*it)) {
-                // Update memory usage of send buffer (as *it will be deleted).
+            CSerializedNetMsg& msg = queue->front();
+            size_t memusage = msg.GetMemoryUsage();
+            const size_t nMessageSize{msg.data.size()};
+            if (node.m_transport->SetMessageToSend(msg)) {
+                // Update memory usage of send buffer (as msg will be deleted).
                 node.m_send_memusage -= memusage;
-                ++it;
+                if (queue == &node.vSendMsg[size_t(NetMsgClass::BULK)]) node.m_bulk_send_allowance -= nMessageSize;
+                queue->pop_front();
+                queue = node.NextSendQueue(m_max_bulk_send_rate, now);
             }
         }
-        const auto& [data, more, msg_type] = node.m_transport->GetBytesToSend(it != node.vSendMsg.end());
+        const auto& [data, more, msg_type] = node.m_transport->GetBytesToSend(queue != nullptr);
         // We rely on the 'more' value returned by GetBytesToSend to correctly predict whether more
         // bytes are still to be sent, to correctly set the MSG_MORE flag. As a sanity check,
         // verify that the previously returned 'more' was correct.
@@ -1701,10 +1824,9 @@ std::pair<size_t, bool> CConnman::SocketSendData(CNode& node) const
 
     node.fPauseSend = node.m_send_memusage + node.m_transport->GetSendMemoryUsage() > nSendBufferMaxSize;
 
-    if (it == node.vSendMsg.end()) {
+    if (node.SendQueuesEmpty()) {
         assert(node.m_send_memusage == 0);
     }
-    node.vSendMsg.erase(node.vSendMsg.begin(), it);
     return {nSentSize, data_left};
 }
 
@@ -1932,6 +2054,8 @@ void CConnman::CreateNodeFromAcceptedSocket(std::unique_ptr<Sock>&& sock,
         LOCK(m_nodes_mutex);
         m_nodes.push_back(pnode);
     }
+    // SYSCOIN
+    PeersGauge().Add(1);
     // We received a new connection, harvest entropy from the time (and our peer count)
     RandAddEvent((uint32_t)id);
 }
@@ -2003,6 +2127,8 @@ void CConnman::DisconnectNodes()
             {
                 // remove from m_nodes
                 m_nodes.erase(remove(m_nodes.begin(), m_nodes.end(), pnode), m_nodes.end());
+                // SYSCOIN
+                PeersGauge().Add(-1);
 
                 // Add to reconnection list if appropriate. We don't reconnect right here, because
                 // the creation of a connection is a blocking operation (up to several seconds),
@@ -2122,6 +2248,8 @@ Sock::EventsPerSock CConnman::GenerateWaitSockets(Span<CNode* const> nodes)
         events_per_sock.emplace(hListenSocket.sock, Sock::Events{Sock::RECV});
     }
 
+    // SYSCOIN
+    const auto now{GetTime<std::chrono::microseconds>()};
     for (CNode* pnode : nodes) {
         bool select_recv = !pnode->fPauseRecv;
         bool select_send;
@@ -2129,8 +2257,10 @@ Sock::EventsPerSock CConnman::GenerateWaitSockets(Span<CNode* const> nodes)
             LOCK(pnode->cs_vSend);
             // Sending is possible if either there are bytes to send right now, or if there will be
             // once a potential message from vSendMsg is handed to the transport. GetBytesToSend
-            // determines both of these in a single call.
-            const auto& [to_send, more, _msg_type] = pnode->m_transport->GetBytesToSend(!pnode->vSendMsg.empty());
+            // determines both of these in a single call. SYSCOIN bulk messages held back by
+            // -maxbulksendrate don't count, the next loop checks again.
+            const bool have_next_message{pnode->NextSendQueue(m_max_bulk_send_rate, now) != nullptr};
+            const auto& [to_send, more, _msg_type] = pnode->m_transport->GetBytesToSend(have_next_message);
             select_send = !to_send.empty() || more;
         }
         if (!select_recv && !select_send) continue;
@@ -2162,7 +2292,18 @@ void CConnman::SocketHandler()
         // select(2)). If none are ready, wait for a short while and return
         // empty sets.
         events_per_sock = GenerateWaitSockets(snap.Nodes());
-        if (events_per_sock.empty() || !events_per_sock.begin()->first->WaitMany(timeout, events_per_sock)) {
+        bool waited{false};
+#ifdef USE_EPOLL
+        // SYSCOIN
+        if (m_sock_waiter && !events_per_sock.empty()) {
+            waited = m_sock_waiter->WaitMany(timeout, events_per_sock);
+            if (!waited) {
+                LogPrintf("Waiting on sockets with epoll failed (%s), using poll from now on\n", NetworkErrorString(WSAGetLastError()));
+                m_sock_waiter.reset();
+            }
+        }
+#endif
+        if (!waited && (events_per_sock.empty() || !events_per_sock.begin()->first->WaitMany(timeout, events_per_sock))) {
             interruptNet.sleep_for(timeout);
         }
 
@@ -2286,6 +2427,11 @@ void CConnman::ThreadSocketHandler()
 {
     AssertLockNotHeld(m_total_bytes_sent_mutex);
 
+#ifdef USE_EPOLL
+    // SYSCOIN
+    m_sock_waiter = std::make_unique<EpollSockWaiter>();
+    if (!m_sock_waiter->IsValid()) m_sock_waiter.reset();
+#endif
     while (!interruptNet)
     {
         DisconnectNodes();
@@ -2761,7 +2907,8 @@ void CConnman::ThreadOpenConnections(const std::vector<std::string> connect)
 
         addrman.ResolveCollisions();
         // SYSCOIN
-        auto mnList = deterministicMNManager->GetListAtChainTip();
+        const auto mnListPtr = deterministicMNManager->GetListAtChainTipPtr();
+        const auto& mnList = *mnListPtr;
 
         const auto current_time{NodeClock::now()};
         int nTries = 0;
@@ -2927,7 +3074,9 @@ void CConnman::ThreadOpenMasternodeConnections()
             }
         });
 
-        auto mnList = deterministicMNManager->GetListAtChainTip();
+        const auto mnListPtr = deterministicMNManager->GetListAtChainTipPtr();
+
+        const auto& mnList = *mnListPtr;
 
         if (interruptNet)
             return;
@@ -2942,37 +3091,36 @@ void CConnman::ThreadOpenMasternodeConnections()
         const auto getPendingQuorumNodes = [&]() EXCLUSIVE_LOCKS_REQUIRED(cs_vPendingMasternodes) {
             AssertLockHeld(cs_vPendingMasternodes);
             std::vector<CDeterministicMNCPtr> ret;
-            for (const auto& group : masternodeQuorumNodes) {
-                for (const auto& proRegTxHash : group.second) {
-                    auto dmn = mnList.GetMN(proRegTxHash);
-                    if (!dmn) {
-                        continue;
-                    }
-                    const auto& addr2 = dmn->pdmnState->addr;
-                    if (connectedNodes.count(addr2) && !connectedProRegTxHashes.count(proRegTxHash)) {
-                        // we probably connected to it before it became a masternode
-                        // or maybe we are still waiting for mnauth
-                        (void)ForNode(addr2, [&](CNode* pnode) {
-                            if (pnode->nTimeFirstMessageReceived.load() != 0s && GetTime<std::chrono::seconds>() - pnode->nTimeFirstMessageReceived.load() > 5s) {
-                                // clearly not expecting mnauth to take that long even if it wasn't the first message
-                                // we received (as it should normally), disconnect
-                                LogPrint(BCLog::NET_NETCONN, "CConnman::%s -- dropping non-mnauth connection to %s, service=%s\n", _func_, proRegTxHash.ToString(), addr2.ToStringAddrPort());
-                                pnode->fDisconnect = true;
-                                return true;
-                            }
-                            return false;
-                        });
-                        // either way - it's not ready, skip it for now
-                        continue;
-                    }
-                    if (!connectedNodes.count(addr2) && !IsMasternodeOrDisconnectRequested(addr2) && !connectedProRegTxHashes.count(proRegTxHash)) {
-                        int64_t lastAttempt = mmetaman->GetMetaInfo(dmn->proTxHash)->GetLastOutboundAttempt();
-                        // back off trying connecting to an address if we already tried recently
-                        if (nANow - lastAttempt < chainParams.LLMQConnectionRetryTimeout()) {
-                            continue;
+            // members shared by several quorums are looked at once, lingering members are kept but not reconnected
+            for (const auto& [proRegTxHash, _] : masternodeQuorumMemberRefs) {
+                auto dmn = mnList.GetMN(proRegTxHash);
+                if (!dmn) {
+                    continue;
+                }
+                const auto& addr2 = dmn->pdmnState->addr;
+                if (connectedNodes.count(addr2) && !connectedProRegTxHashes.count(proRegTxHash)) {
+                    // we probably connected to it before it became a masternode
+                    // or maybe we are still waiting for mnauth
+                    (void)ForNode(addr2, [&](CNode* pnode) {
+                        if (pnode->nTimeFirstMessageReceived.load() != 0s && GetTime<std::chrono::seconds>() - pnode->nTimeFirstMessageReceived.load() > 5s) {
+                            // clearly not expecting mnauth to take that long even if it wasn't the first message
+                            // we received (as it should normally), disconnect
+                            LogPrint(BCLog::NET_NETCONN, "CConnman::%s -- dropping non-mnauth connection to %s, service=%s\n", _func_, proRegTxHash.ToString(), addr2.ToStringAddrPort());
+                            pnode->fDisconnect = true;
+                            return true;
                         }
-                        ret.emplace_back(dmn);
+                        return false;
+                    });
+                    // either way - it's not ready, skip it for now
+                    continue;
+                }
+                if (!connectedNodes.count(addr2) && !IsMasternodeOrDisconnectRequested(addr2) && !connectedProRegTxHashes.count(proRegTxHash)) {
+                    int64_t lastAttempt = mmetaman->GetMetaInfo(dmn->proTxHash)->GetLastOutboundAttempt();
+                    // back off trying connecting to an address if we already tried recently
+                    if (nANow - lastAttempt < chainParams.LLMQConnectionRetryTimeout()) {
+                        continue;
                     }
+                    ret.emplace_back(dmn);
                 }
             }
             return ret;
@@ -3227,6 +3375,8 @@ void CConnman::OpenNetworkConnection(const CAddress& addrConnect, bool fCountFai
     {
         LOCK(m_nodes_mutex);
         m_nodes.push_back(pnode);
+        // SYSCOIN
+        PeersGauge().Add(1);
 
         // update connection count by network
         if (pnode->IsManualOrFullOutboundConn()) ++m_network_conn_counts[pnode->addr.GetNetwork()];
@@ -3633,7 +3783,7 @@ bool CConnman::Start(CScheduler& scheduler, const Options& connOptions)
     }
 
     // Dump network addresses
-    scheduler.scheduleEvery([this] { DumpAddresses(); }, DUMP_PEERS_INTERVAL);
+    scheduler.scheduleEvery([this] { DumpAddresses(); }, DUMP_PEERS_INTERVAL, "dumpaddresses");
 
     return true;
 }
@@ -3844,7 +3994,34 @@ void CConnman::SetMasternodeQuorumNodes(const uint256& quorumHash, const std::un
     LOCK(cs_vPendingMasternodes);
     auto it = masternodeQuorumNodes.emplace(quorumHash, proTxHashes);
     if (!it.second) {
+        // take the new references first so members staying in the quorum never drop to zero
+        AddQuorumMemberRefs(proTxHashes);
+        ReleaseQuorumMemberRefs(it.first->second);
         it.first->second = proTxHashes;
+        return;
+    }
+    AddQuorumMemberRefs(proTxHashes);
+}
+
+void CConnman::AddQuorumMemberRefs(const std::unordered_set<uint256, StaticSaltedHasher>& proTxHashes)
+{
+    AssertLockHeld(cs_vPendingMasternodes);
+    for (const auto& proTxHash : proTxHashes) {
+        if (masternodeQuorumMemberRefs[proTxHash]++ == 0 && masternodeLingeringMembers.erase(proTxHash)) {
+            LogPrint(BCLog::NET_NETCONN, "CConnman::%s -- reusing lingering connection to %s\n", __func__, proTxHash.ToString());
+        }
+    }
+}
+
+void CConnman::ReleaseQuorumMemberRefs(const std::unordered_set<uint256, StaticSaltedHasher>& proTxHashes)
+{
+    AssertLockHeld(cs_vPendingMasternodes);
+    const auto linger_until{GetTime<std::chrono::seconds>() + MASTERNODE_QUORUM_LINGER_TIME};
+    for (const auto& proTxHash : proTxHashes) {
+        auto it = masternodeQuorumMemberRefs.find(proTxHash);
+        if (it == masternodeQuorumMemberRefs.end() || --it->second > 0) continue;
+        masternodeQuorumMemberRefs.erase(it);
+        masternodeLingeringMembers[proTxHash] = linger_until;
     }
 }
 
@@ -3916,7 +4093,11 @@ void CConnman::GetMasternodeQuorumNodes(const uint256& quorumHash,std::unordered
 void CConnman::RemoveMasternodeQuorumNodes(const uint256& quorumHash)
 {
     LOCK(cs_vPendingMasternodes);
-    masternodeQuorumNodes.erase(quorumHash);
+    auto it = masternodeQuorumNodes.find(quorumHash);
+    if (it != masternodeQuorumNodes.end()) {
+        ReleaseQuorumMemberRefs(it->second);
+        masternodeQuorumNodes.erase(it);
+    }
     masternodeQuorumRelayMembers.erase(quorumHash);
 }
 
@@ -3926,7 +4107,8 @@ bool CConnman::IsMasternodeQuorumNode(const CNode* pnode)
     // We however only need to know this if the node did not authenticate itself as a MN yet
     uint256 assumedProTxHash;
     if (pnode->GetVerifiedProRegTxHash().IsNull() && !pnode->IsInboundConn()) {
-        auto mnList = deterministicMNManager->GetListAtChainTip();
+        const auto mnListPtr = deterministicMNManager->GetListAtChainTipPtr();
+        const auto& mnList = *mnListPtr;
         auto dmn = mnList.GetMNByService(pnode->addr);
         if (dmn == nullptr) {
             // This is definitely not a masternode
@@ -3935,21 +4117,44 @@ bool CConnman::IsMasternodeQuorumNode(const CNode* pnode)
         assumedProTxHash = dmn->proTxHash;
     }
 
+    if (!pnode->GetVerifiedProRegTxHash().IsNull()) {
+        return IsMasternodeQuorumMember(pnode->GetVerifiedProRegTxHash());
+    }
+    return !assumedProTxHash.IsNull() && IsMasternodeQuorumMember(assumedProTxHash);
+}
+
+bool CConnman::IsMasternodeQuorumMember(const uint256& proTxHash)
+{
     LOCK(cs_vPendingMasternodes);
-    for (const auto& p : masternodeQuorumNodes) {
-        if (!pnode->GetVerifiedProRegTxHash().IsNull()) {
-            if (p.second.count(pnode->GetVerifiedProRegTxHash())) {
-                return true;
-            }
-        } else if (!assumedProTxHash.IsNull()) {
-            if (p.second.count(assumedProTxHash)) {
-                return true;
-            }
-        }
+    if (masternodeQuorumMemberRefs.count(proTxHash)) {
+        return true;
+    }
+    auto it = masternodeLingeringMembers.find(proTxHash);
+    if (it == masternodeLingeringMembers.end()) {
+        return false;
+    }
+    if (it->second > GetTime<std::chrono::seconds>()) {
+        return true;
     }
+    // drained lazily, the connection is closed by the next masternode maintenance
+    masternodeLingeringMembers.erase(it);
     return false;
 }
 
+size_t CConnman::GetLingeringQuorumMemberCount()
+{
+    LOCK(cs_vPendingMasternodes);
+    const auto now{GetTime<std::chrono::seconds>()};
+    for (auto it = masternodeLingeringMembers.begin(); it != masternodeLingeringMembers.end(); ) {
+        if (it->second <= now) {
+            it = masternodeLingeringMembers.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    return masternodeLingeringMembers.size();
+}
+
 bool CConnman::IsMasternodeQuorumRelayMember(const uint256& protxHash)
 {
     if (protxHash.IsNull()) {
@@ -4074,6 +4279,9 @@ bool CConnman::DisconnectNode(NodeId id)
 void CConnman::RecordBytesRecv(uint64_t bytes)
 {
     nTotalBytesRecv += bytes;
+    // SYSCOIN
+    static metrics::Counter& bytes_recv{metrics::GetCounter("syscoin_net_bytes_received_total", "Bytes received from peers")};
+    bytes_recv.Inc(bytes);
 }
 
 void CConnman::RecordBytesSent(uint64_t bytes)
@@ -4082,6 +4290,17 @@ void CConnman::RecordBytesSent(uint64_t bytes)
     LOCK(m_total_bytes_sent_mutex);
 
     nTotalBytesSent += bytes;
+    // SYSCOIN
+    static metrics::Counter& bytes_sent{metrics::GetCounter("syscoin_net_bytes_sent_total", "Bytes sent to peers")};
+    bytes_sent.Inc(bytes);
+
+    MaybeResetOutboundCycle_();
+    nMaxOutboundTotalBytesSentInCycle += bytes;
+}
+
+void CConnman::MaybeResetOutboundCycle_()
+{
+    AssertLockHeld(m_total_bytes_sent_mutex);
 
     const auto now = GetTime<std::chrono::seconds>();
     if (nMaxOutboundCycleStartTime + MAX_UPLOAD_TIMEFRAME < now)
@@ -4089,9 +4308,67 @@ void CConnman::RecordBytesSent(uint64_t bytes)
         // timeframe expired, reset cycle
         nMaxOutboundCycleStartTime = now;
         nMaxOutboundTotalBytesSentInCycle = 0;
+        // SYSCOIN
+        nMaxOutboundBlobBytesSentInCycle = 0;
     }
+}
 
-    nMaxOutboundTotalBytesSentInCycle += bytes;
+// SYSCOIN
+void CConnman::RecordPayloadBytesSent(uint64_t nevm_block_bytes, uint64_t blob_bytes)
+{
+    AssertLockNotHeld(m_total_bytes_sent_mutex);
+    LOCK(m_total_bytes_sent_mutex);
+
+    nTotalNEVMBlockBytesSent += nevm_block_bytes;
+    nTotalBlobBytesSent += blob_bytes;
+    static metrics::Counter& nevm_block_bytes_sent{metrics::GetCounter("syscoin_net_nevm_block_bytes_sent_total", "NEVM block data bytes sent to peers")};
+    static metrics::Counter& blob_bytes_sent{metrics::GetCounter("syscoin_net_poda_blob_bytes_sent_total", "PoDA blob bytes sent to peers")};
+    nevm_block_bytes_sent.Inc(nevm_block_bytes);
+    blob_bytes_sent.Inc(blob_bytes);
+
+    MaybeResetOutboundCycle_();
+    nMaxOutboundBlobBytesSentInCycle += blob_bytes;
+}
+
+uint64_t CConnman::GetMaxOutboundBlobTarget() const
+{
+    AssertLockNotHeld(m_total_bytes_sent_mutex);
+    LOCK(m_total_bytes_sent_mutex);
+    return nMaxOutboundBlobLimit;
+}
+
+bool CConnman::OutboundBlobTargetReached() const
+{
+    AssertLockNotHeld(m_total_bytes_sent_mutex);
+    LOCK(m_total_bytes_sent_mutex);
+    if (nMaxOutboundBlobLimit != 0 && nMaxOutboundBlobBytesSentInCycle >= nMaxOutboundBlobLimit)
+        return true;
+
+    return nMaxOutboundLimit != 0 && nMaxOutboundTotalBytesSentInCycle >= nMaxOutboundLimit;
+}
+
+uint64_t CConnman::GetOutboundBlobTargetBytesLeft() const
+{
+    AssertLockNotHeld(m_total_bytes_sent_mutex);
+    LOCK(m_total_bytes_sent_mutex);
+    if (nMaxOutboundBlobLimit == 0)
+        return 0;
+
+    return (nMaxOutboundBlobBytesSentInCycle >= nMaxOutboundBlobLimit) ? 0 : nMaxOutboundBlobLimit - nMaxOutboundBlobBytesSentInCycle;
+}
+
+uint64_t CConnman::GetTotalNEVMBlockBytesSent() const
+{
+    AssertLockNotHeld(m_total_bytes_sent_mutex);
+    LOCK(m_total_bytes_sent_mutex);
+    return nTotalNEVMBlockBytesSent;
+}
+
+uint64_t CConnman::GetTotalBlobBytesSent() const
+{
+    AssertLockNotHeld(m_total_bytes_sent_mutex);
+    LOCK(m_total_bytes_sent_mutex);
+    return nTotalBlobBytesSent;
 }
 
 uint64_t CConnman::GetMaxOutboundTarget() const
@@ -4221,6 +4498,14 @@ CNode::CNode(NodeId idIn,
     for (const std::string &msg : getAllNetMessageTypes())
         mapRecvBytesPerMsgType[msg] = 0;
     mapRecvBytesPerMsgType[NET_MESSAGE_TYPE_OTHER] = 0;
+    // SYSCOIN
+    {
+        LOCK(m_process_cost_mutex);
+        for (const std::string& msg : getAllNetMessageTypes()) {
+            mapProcessCostPerMsgType[msg];
+        }
+        mapProcessCostPerMsgType[NET_MESSAGE_TYPE_OTHER];
+    }
 
     if (fLogIPs) {
         LogPrint(BCLog::NET, "Added connection to %s peer=%d\n", m_addr_name, id);
@@ -4290,13 +4575,15 @@ void CConnman::PushMessage(CNode* pnode, CSerializedNetMsg&& msg)
         // give it a message to send.
         const auto& [to_send, more, _msg_type] =
             pnode->m_transport->GetBytesToSend(/*have_next_message=*/true);
-        const bool queue_was_empty{to_send.empty() && pnode->vSendMsg.empty()};
+        // SYSCOIN bulk messages held back by -maxbulksendrate leave nothing to send right now either
+        const bool queue_was_empty{to_send.empty() && pnode->NextSendQueue(m_max_bulk_send_rate, GetTime<std::chrono::microseconds>()) == nullptr};
 
         // Update memory usage of send buffer.
         pnode->m_send_memusage += msg.GetMemoryUsage();
         if (pnode->m_send_memusage + pnode->m_transport->GetSendMemoryUsage() > nSendBufferMaxSize) pnode->fPauseSend = true;
-        // Move message to vSendMsg queue.
-        pnode->vSendMsg.push_back(std::move(msg));
+        // Move message to the vSendMsg queue of its class.
+        const NetMsgClass msg_class{GetNetMsgClass(msg)};
+        pnode->vSendMsg[size_t(msg_class)].push_back(std::move(msg));
 
         // If there was nothing to send before, and there is now (predicted by the "more" value
         // returned by the GetBytesToSend call above), attempt "optimistic write":
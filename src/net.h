@@ -31,6 +31,7 @@
 #include <util/sock.h>
 #include <util/threadinterrupt.h>
 
+#include <array>
 #include <atomic>
 #include <condition_variable>
 #include <cstdint>
@@ -62,6 +63,8 @@ static constexpr std::chrono::minutes TIMEOUT_INTERVAL{20};
 // SYSCOIN
 /** Time to wait since m_connected before disconnecting a probe node. */
 static const auto PROBE_WAIT_INTERVAL{5s};
+/** How long a verified quorum connection no quorum needs anymore is kept open, the next rotation mostly reuses the same members */
+static constexpr auto MASTERNODE_QUORUM_LINGER_TIME{15min};
 /** Run the feeler connection loop once every 2 minutes. **/
 static constexpr auto FEELER_INTERVAL = 2min;
 /** Run the extra block-relay-only connection loop once every 5 minutes. **/
@@ -109,6 +112,13 @@ static const size_t DEFAULT_MAXSENDBUFFER    = 25 * 1000;
 static const size_t DEFAULT_MAXRECEIVEBUFFER = 5 * DEFAULT_MAXSENDBUFFER;
 
 static constexpr bool DEFAULT_V2_TRANSPORT{false};
+// SYSCOIN
+/** The default for -maxbulksendrate, in kB per second and peer. 0 = Unlimited */
+static constexpr unsigned int DEFAULT_MAX_BULK_SEND_RATE{0};
+/** Messages of other types bigger than this are sent as bulk data, e.g. PoDA transactions carrying their blob */
+static constexpr size_t BULK_NET_MSG_SIZE{100 * 1000};
+/** The default for -maxuploadtargetblobs. 0 = Unlimited */
+static const std::string DEFAULT_MAX_UPLOAD_TARGET_BLOBS{"0M"};
 
 typedef int64_t NodeId;
 
@@ -150,6 +160,20 @@ struct CSerializedNetMsg {
     size_t GetMemoryUsage() const noexcept;
 };
 // SYSCOIN
+/**
+ * Send queue a message waits in. A peer's queues are handed to the transport in this order, so a
+ * chainlock or sig share never waits behind megabytes of blocks and PoDA blobs queued before it.
+ * Messages of one class keep their order.
+ */
+enum class NetMsgClass : uint8_t {
+    //! small consensus-critical messages: chainlocks, LLMQ sig shares, headers and compact blocks
+    PRIORITY,
+    NORMAL,
+    //! blocks, blob chunks and big messages, -maxbulksendrate applies to these
+    BULK,
+};
+static constexpr size_t NUM_NET_MSG_CLASSES{3};
+NetMsgClass GetNetMsgClass(const CSerializedNetMsg& msg);
 struct CAllNodes {
     bool operator() (const CNode* pNode) const {return pNode != nullptr;}
 };
@@ -212,6 +236,13 @@ extern std::map<CNetAddr, LocalServiceInfo> mapLocalHost GUARDED_BY(g_maplocalho
 
 extern const std::string NET_MESSAGE_TYPE_OTHER;
 using mapMsgTypeSize = std::map</* message type */ std::string, /* total bytes */ uint64_t>;
+// SYSCOIN
+/** Messages of one type processed from a peer and the time the message handler and its workers spent on them */
+struct MsgTypeCost {
+    uint64_t count{0};
+    std::chrono::microseconds time{0};
+};
+using mapMsgTypeCost = std::map</* message type */ std::string, MsgTypeCost>;
 
 class CNodeStats
 {
@@ -258,6 +289,9 @@ public:
     TransportProtocolType m_transport_type;
     /** BIP324 session id string in hex, if any. */
     std::string m_session_id;
+    // SYSCOIN
+    mapMsgTypeCost mapProcessCostPerMsgType;
+    std::chrono::microseconds m_process_time;
 };
 
 
@@ -289,6 +323,36 @@ public:
     }
 };
 
+// SYSCOIN
+/**
+ * Receive buffers of large messages (blocks with NEVM data, PoDA blob transactions), handed back
+ * once the message was processed and reused for the next large message from any peer. A buffer
+ * taken from the pool already holds the whole message as declared in its header, so it is neither
+ * grown while the message arrives nor does a fresh allocation of many megabytes fault in its pages
+ * and get wiped by zero_after_free_allocator when it is freed again. Only memory that was committed
+ * already is handed out this way, a header alone never makes the node allocate what it declares.
+ */
+class NetRecvBufferPool
+{
+public:
+    /** Smaller messages use a fresh buffer as before */
+    static constexpr size_t MIN_BUFFER_SIZE{1024 * 1024};
+    /** Bounds the memory kept around between large messages */
+    static constexpr size_t MAX_POOLED_BYTES{64 * 1024 * 1024};
+
+    /** Move a pooled buffer that holds size bytes into stream (keeping its type and version), false if there is none */
+    bool Take(CDataStream& stream, size_t size) EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+    /** Keep the memory of a processed message's stream for a later message, if it is large enough */
+    void Give(CDataStream&& stream) EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+    size_t Size() const EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+
+private:
+    mutable Mutex m_mutex;
+    std::vector<CDataStream> m_buffers GUARDED_BY(m_mutex);
+    size_t m_pooled_bytes GUARDED_BY(m_mutex){0};
+};
+extern NetRecvBufferPool g_recv_buffer_pool;
+
 /** The Transport converts one connection's sent messages to wire bytes, and received bytes back. */
 class Transport {
 public:
@@ -737,8 +801,12 @@ public:
     size_t m_send_memusage GUARDED_BY(cs_vSend){0};
     /** Total number of bytes sent on the wire to this peer. */
     uint64_t nSendBytes GUARDED_BY(cs_vSend){0};
-    /** Messages still to be fed to m_transport->SetMessageToSend. */
-    std::deque<CSerializedNetMsg> vSendMsg GUARDED_BY(cs_vSend);
+    /** Messages still to be fed to m_transport->SetMessageToSend, one queue per NetMsgClass. */
+    std::array<std::deque<CSerializedNetMsg>, NUM_NET_MSG_CLASSES> vSendMsg GUARDED_BY(cs_vSend);
+    // SYSCOIN
+    /** Bytes of bulk messages that may be handed to the transport before -maxbulksendrate holds them back. */
+    double m_bulk_send_allowance GUARDED_BY(cs_vSend){0};
+    std::chrono::microseconds m_bulk_send_refill GUARDED_BY(cs_vSend){0};
     Mutex cs_vSend;
     Mutex m_sock_mutex;
     Mutex cs_vRecv;
@@ -762,6 +830,10 @@ public:
     std::atomic<bool> m_masternode_probe_connection{false};
     // If 'true', we identified it as an intra-quorum relay connection
     std::atomic<bool> m_masternode_iqr_connection{false};
+    // SYSCOIN If 'true', the MNAUTH signature is being checked and no further messages are processed
+    std::atomic<bool> m_mnauth_pending{false};
+    // SYSCOIN If 'true', a message of this peer waits on a message worker and no further messages are processed
+    std::atomic<bool> m_worker_msg_pending{false};
     // Address of this peer
     const CAddress addr;
     // Bind address of our side of the connection
@@ -815,6 +887,16 @@ public:
         mapSendBytesPerMsgType[msg_type] += sent_bytes;
     }
 
+    // SYSCOIN
+    /**
+     * Queue the next message is taken from, the non-empty one of the highest class. Bulk messages
+     * are held back (nullptr) while they exceeded bulk_rate bytes per second, 0 means no limit.
+     */
+    std::deque<CSerializedNetMsg>* NextSendQueue(uint64_t bulk_rate, std::chrono::microseconds now)
+        EXCLUSIVE_LOCKS_REQUIRED(cs_vSend);
+    /** Whether nothing waits in any send queue */
+    bool SendQueuesEmpty() const EXCLUSIVE_LOCKS_REQUIRED(cs_vSend);
+
     bool IsOutboundOrBlockRelayConn() const {
         switch (m_conn_type) {
             case ConnectionType::OUTBOUND_FULL_RELAY:
@@ -1011,7 +1093,10 @@ public:
 
     void CloseSocketDisconnect() EXCLUSIVE_LOCKS_REQUIRED(!m_sock_mutex);
     // SYSCOIN
-    void CopyStats(CNodeStats& stats) EXCLUSIVE_LOCKS_REQUIRED(!m_subver_mutex, !m_addr_local_mutex, !cs_vSend, !cs_vRecv, !cs_mnauth);
+    void CopyStats(CNodeStats& stats) EXCLUSIVE_LOCKS_REQUIRED(!m_subver_mutex, !m_addr_local_mutex, !cs_vSend, !cs_vRecv, !cs_mnauth, !m_process_cost_mutex);
+    // SYSCOIN
+    /** Add the time spent processing count messages of msg_type, unknown types are accounted under NET_MESSAGE_TYPE_OTHER */
+    void AccountProcessCost(const std::string& msg_type, std::chrono::microseconds time, uint64_t count = 1) EXCLUSIVE_LOCKS_REQUIRED(!m_process_cost_mutex);
 
 
     // SYSCOIN
@@ -1081,6 +1166,9 @@ private:
 
     mapMsgTypeSize mapSendBytesPerMsgType GUARDED_BY(cs_vSend);
     mapMsgTypeSize mapRecvBytesPerMsgType GUARDED_BY(cs_vRecv);
+    // SYSCOIN
+    Mutex m_process_cost_mutex;
+    mapMsgTypeCost mapProcessCostPerMsgType GUARDED_BY(m_process_cost_mutex);
 
     /**
      * If an I2P session is created per connection (for outbound transient I2P
@@ -1154,6 +1242,9 @@ public:
         unsigned int nSendBufferMaxSize = 0;
         unsigned int nReceiveFloodSize = 0;
         uint64_t nMaxOutboundLimit = 0;
+        // SYSCOIN
+        uint64_t nMaxOutboundBlobLimit = 0;
+        uint64_t m_max_bulk_send_rate = 0;
         int64_t m_peer_connect_timeout = DEFAULT_PEER_CONNECT_TIMEOUT;
         std::vector<std::string> vSeedNodes;
         std::vector<NetWhitelistPermissions> vWhitelistedRange;
@@ -1186,10 +1277,14 @@ public:
         m_msgproc = connOptions.m_msgproc;
         nSendBufferMaxSize = connOptions.nSendBufferMaxSize;
         nReceiveFloodSize = connOptions.nReceiveFloodSize;
+        // SYSCOIN
+        m_max_bulk_send_rate = connOptions.m_max_bulk_send_rate;
         m_peer_connect_timeout = std::chrono::seconds{connOptions.m_peer_connect_timeout};
         {
             LOCK(m_total_bytes_sent_mutex);
             nMaxOutboundLimit = connOptions.nMaxOutboundLimit;
+            // SYSCOIN
+            nMaxOutboundBlobLimit = connOptions.nMaxOutboundBlobLimit;
         }
         vWhitelistedRange = connOptions.vWhitelistedRange;
         {
@@ -1392,6 +1487,10 @@ public:
     void GetMasternodeQuorumNodes(const uint256& quorumHash, std::unordered_set<NodeId> &result) const;
     void RemoveMasternodeQuorumNodes(const uint256& quorumHash);
     bool IsMasternodeQuorumNode(const CNode* pnode);
+    /** Whether a current quorum needs proTxHash, or it left the last one less than MASTERNODE_QUORUM_LINGER_TIME ago */
+    bool IsMasternodeQuorumMember(const uint256& proTxHash);
+    /** Number of masternodes kept connected although no current quorum needs them */
+    size_t GetLingeringQuorumMemberCount();
     bool IsMasternodeQuorumRelayMember(const uint256& protxHash);
     void AddPendingProbeConnections(const std::set<uint256>& proTxHashes);
     size_t GetMaxOutboundNodeCount();
@@ -1440,6 +1539,18 @@ public:
 
     std::chrono::seconds GetMaxOutboundTimeLeftInCycle() const EXCLUSIVE_LOCKS_REQUIRED(!m_total_bytes_sent_mutex);
 
+    // SYSCOIN
+    uint64_t GetMaxOutboundBlobTarget() const EXCLUSIVE_LOCKS_REQUIRED(!m_total_bytes_sent_mutex);
+    //! check if PoDA blobs peers can do without should no longer be served, either because
+    //! -maxuploadtargetblobs or -maxuploadtarget is reached in the current cycle
+    bool OutboundBlobTargetReached() const EXCLUSIVE_LOCKS_REQUIRED(!m_total_bytes_sent_mutex);
+    //! response the blob bytes left in the current max outbound cycle, 0 without a blob limit
+    uint64_t GetOutboundBlobTargetBytesLeft() const EXCLUSIVE_LOCKS_REQUIRED(!m_total_bytes_sent_mutex);
+    //! account the NEVM block data and PoDA blob bytes carried by messages pushed to peers
+    void RecordPayloadBytesSent(uint64_t nevm_block_bytes, uint64_t blob_bytes) EXCLUSIVE_LOCKS_REQUIRED(!m_total_bytes_sent_mutex);
+    uint64_t GetTotalNEVMBlockBytesSent() const EXCLUSIVE_LOCKS_REQUIRED(!m_total_bytes_sent_mutex);
+    uint64_t GetTotalBlobBytesSent() const EXCLUSIVE_LOCKS_REQUIRED(!m_total_bytes_sent_mutex);
+
     uint64_t GetTotalBytesRecv() const;
     uint64_t GetTotalBytesSent() const EXCLUSIVE_LOCKS_REQUIRED(!m_total_bytes_sent_mutex);
 
@@ -1512,6 +1623,8 @@ private:
     //! returns the time left in the current max outbound cycle
     //! in case of no limit, it will always return 0
     std::chrono::seconds GetMaxOutboundTimeLeftInCycle_() const EXCLUSIVE_LOCKS_REQUIRED(m_total_bytes_sent_mutex);
+    // SYSCOIN start a new max outbound cycle once the current one has expired
+    void MaybeResetOutboundCycle_() EXCLUSIVE_LOCKS_REQUIRED(m_total_bytes_sent_mutex);
 
     bool BindListenPort(const CService& bindAddr, bilingual_str& strError, NetPermissionFlags permissions);
     bool Bind(const CService& addr, unsigned int flags, NetPermissionFlags permissions);
@@ -1571,6 +1684,11 @@ private:
     void SocketHandlerListening(const Sock::EventsPerSock& events_per_sock);
 
     void ThreadSocketHandler() EXCLUSIVE_LOCKS_REQUIRED(!m_total_bytes_sent_mutex, !mutexMsgProc, !m_nodes_mutex, !m_reconnections_mutex);
+#ifdef USE_EPOLL
+    // SYSCOIN
+    /** Keeps the sockets of SocketHandler() registered between loops, only used by the socket handler thread */
+    std::unique_ptr<EpollSockWaiter> m_sock_waiter;
+#endif
     void ThreadDNSAddressSeed() EXCLUSIVE_LOCKS_REQUIRED(!m_addr_fetches_mutex, !m_nodes_mutex);
     // SYSCOIN
     void ThreadOpenMasternodeConnections() EXCLUSIVE_LOCKS_REQUIRED(!m_unused_i2p_sessions_mutex);
@@ -1644,6 +1762,11 @@ private:
     uint64_t nMaxOutboundTotalBytesSentInCycle GUARDED_BY(m_total_bytes_sent_mutex) {0};
     std::chrono::seconds nMaxOutboundCycleStartTime GUARDED_BY(m_total_bytes_sent_mutex) {0};
     uint64_t nMaxOutboundLimit GUARDED_BY(m_total_bytes_sent_mutex);
+    // SYSCOIN PoDA blob upload, part of the totals above and capped separately
+    uint64_t nMaxOutboundBlobBytesSentInCycle GUARDED_BY(m_total_bytes_sent_mutex) {0};
+    uint64_t nMaxOutboundBlobLimit GUARDED_BY(m_total_bytes_sent_mutex) {0};
+    uint64_t nTotalNEVMBlockBytesSent GUARDED_BY(m_total_bytes_sent_mutex) {0};
+    uint64_t nTotalBlobBytesSent GUARDED_BY(m_total_bytes_sent_mutex) {0};
 
     // P2P timeout in seconds
     std::chrono::seconds m_peer_connect_timeout;
@@ -1653,6 +1776,9 @@ private:
     std::vector<NetWhitelistPermissions> vWhitelistedRange;
 
     unsigned int nSendBufferMaxSize{0};
+    // SYSCOIN
+    /** Bytes per second of bulk messages handed to a peer's transport, 0 = no limit */
+    uint64_t m_max_bulk_send_rate{0};
     unsigned int nReceiveFloodSize{0};
 
     std::vector<ListenSocket> vhListenSocket;
@@ -1672,6 +1798,12 @@ private:
     std::map<uint256, std::unordered_set<uint256, StaticSaltedHasher>> masternodeQuorumNodes GUARDED_BY(cs_vPendingMasternodes);
     std::map<uint256, std::unordered_set<uint256, StaticSaltedHasher>> masternodeQuorumRelayMembers GUARDED_BY(cs_vPendingMasternodes);
     std::set<uint256> masternodePendingProbes GUARDED_BY(cs_vPendingMasternodes);
+    //! number of quorums in masternodeQuorumNodes each member is part of, overlapping quorums share the connection
+    std::unordered_map<uint256, size_t, StaticSaltedHasher> masternodeQuorumMemberRefs GUARDED_BY(cs_vPendingMasternodes);
+    //! members no quorum references anymore, with the time until which their connections are kept
+    std::unordered_map<uint256, std::chrono::seconds, StaticSaltedHasher> masternodeLingeringMembers GUARDED_BY(cs_vPendingMasternodes);
+    void AddQuorumMemberRefs(const std::unordered_set<uint256, StaticSaltedHasher>& proTxHashes) EXCLUSIVE_LOCKS_REQUIRED(cs_vPendingMasternodes);
+    void ReleaseQuorumMemberRefs(const std::unordered_set<uint256, StaticSaltedHasher>& proTxHashes) EXCLUSIVE_LOCKS_REQUIRED(cs_vPendingMasternodes);
     mutable RecursiveMutex cs_vPendingMasternodes;
     std::vector<CNode*> m_nodes GUARDED_BY(m_nodes_mutex);
     std::list<CNode*> m_nodes_disconnected;
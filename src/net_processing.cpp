@@ -23,6 +23,7 @@
 #include <netbase.h>
 #include <netmessagemaker.h>
 #include <node/blockstorage.h>
+#include <node/messageworker.h>
 #include <node/txreconciliation.h>
 #include <policy/fees.h>
 #include <policy/policy.h>
@@ -65,6 +66,9 @@
 #include <llmq/quorums_signing.h>
 #include <llmq/quorums_signing_shares.h>
 #include <llmq/quorums_chainlocks.h>
+#include <services/nevmblobhasher.h>
+#include <services/nevmblobrelay.h>
+#include <services/nevmconsensus.h>
 #include <optional>
 #include <typeinfo>
 #include <common/args.h>
@@ -114,6 +118,10 @@ static constexpr auto TXID_RELAY_DELAY{2s};
 static constexpr auto NONPREF_PEER_TX_DELAY{2s};
 /** How long to delay requesting transactions from overloaded peers (see MAX_PEER_TX_REQUEST_IN_FLIGHT). */
 static constexpr auto OVERLOADED_PEER_TX_DELAY{2s};
+// SYSCOIN
+/** Number of in-flight requests of large (PoDA blob) transactions from a peer from which further large
+ *  announcements of that peer are delayed by OVERLOADED_PEER_TX_DELAY, spreading them over the peers. */
+static constexpr int32_t MAX_PEER_LARGE_TX_REQUEST_IN_FLIGHT = 2;
 /** How long to wait before downloading a transaction from an additional peer */
 static constexpr auto GETDATA_TX_INTERVAL{60s};
 // SYSCOIN
@@ -288,6 +296,9 @@ struct CNodeState {
     const bool m_is_inbound;
 
     // SYSCOIN
+    //! Sizes of the blob transactions announced by the txsizehints message preceding an inv, used by that inv
+    std::map<uint256, uint32_t> m_tx_size_hints;
+
     CNodeState(bool is_inbound) : m_is_inbound(is_inbound) {}
 };
 
@@ -320,6 +331,8 @@ public:
 
     /** Implement PeerManager */
     void StartScheduledTasks(CScheduler& scheduler) override;
+    // SYSCOIN
+    void StopMessageWorkers() override;
     void CheckForStaleTipAndEvictPeers() override;
     std::optional<std::string> FetchBlock(NodeId peer_id, const CBlockIndex& block_index) override
         EXCLUSIVE_LOCKS_REQUIRED(!m_peer_mutex);
@@ -536,6 +549,11 @@ private:
     ChainstateManager& m_chainman;
     CTxMemPool& m_mempool;
     TxRequestTracker m_txrequest GUARDED_BY(::cs_main);
+    // SYSCOIN
+    /** Schedules getblobchunk requests, a chunk is tracked under its NEVMBlobChunkId */
+    TxRequestTracker m_blobrequest GUARDED_BY(::cs_main);
+    /** Compact blocks waiting for their PoDA blobs */
+    NEVMBlobAssembler m_blob_assembler GUARDED_BY(::cs_main);
     std::unique_ptr<TxReconciliationTracker> m_txreconciliation;
 
     /** The height of the best chain */
@@ -777,7 +795,24 @@ private:
 
     /** Process compact block txns  */
     void ProcessCompactBlockTxns(CNode& pfrom, Peer& peer, const BlockTransactions& block_transactions)
-        EXCLUSIVE_LOCKS_REQUIRED(g_msgproc_mutex, !m_most_recent_block_mutex);
+        EXCLUSIVE_LOCKS_REQUIRED(g_msgproc_mutex, !m_most_recent_block_mutex, !m_peer_mutex);
+
+    // SYSCOIN
+    /** Peers that negotiated blob relay with sendblobs */
+    std::vector<NodeId> GetNEVMBlobRelayPeers() const EXCLUSIVE_LOCKS_REQUIRED(!m_peer_mutex);
+    /** Fill the PoDA blobs a block was relayed without from the mempool and the blob store */
+    void FillNEVMDataLocally(CBlock& block);
+    /** Announce the chunks to every blob relay peer that has a block waiting for them, preferring a different peer per chunk */
+    void RequestNEVMBlobChunks(const std::vector<CNEVMBlobChunkRequest>& vRequests, NodeId from, const std::vector<NodeId>& blob_relay_peers,
+                               std::chrono::microseconds current_time) EXCLUSIVE_LOCKS_REQUIRED(::cs_main);
+    /** Download a block that was held for its blobs in full after all */
+    void FetchFullBlock(NodeId nodeid, const uint256& hash) EXCLUSIVE_LOCKS_REQUIRED(!m_peer_mutex);
+    /** Answer one chunk of a getblobchunk request */
+    void ProcessGetBlobChunk(CNode& pfrom, const CNEVMBlobChunkRequest& req);
+    /** Whether PoDA blobs confirmed at nMedianTime are sent to pfrom, optional ones only within the blob upload target */
+    bool ServeNEVMData(const CNode& pfrom, int64_t nMedianTime) const;
+    /** Account the NEVM block data and PoDA blobs of a block sent to a peer */
+    void RecordBlockPayloadSent(const CBlock& block);
 
     /**
      * When a peer sends us a valid block, instruct it to announce blocks to us
@@ -886,6 +921,18 @@ private:
 
     void AddAddressKnown(Peer& peer, const CAddress& addr) EXCLUSIVE_LOCKS_REQUIRED(g_msgproc_mutex);
     void PushAddress(Peer& peer, const CAddress& addr) EXCLUSIVE_LOCKS_REQUIRED(g_msgproc_mutex);
+
+    // SYSCOIN
+    /**
+     * Process the message with fn on worker instead of the message handler thread. The peer's later
+     * messages wait until it was processed, so the messages of one peer are still handled in order.
+     */
+    void ProcessMessageOnWorker(node::MessageWorker& worker, CNode& pfrom, const std::string& msg_type, CDataStream& vRecv,
+                                const std::atomic<bool>& interruptMsgProc, std::function<void(CNode&, const std::string&, CDataStream&)> fn);
+    /** Subsystems whose messages are processed on threads of their own, last so they are stopped before the rest is destroyed */
+    node::MessageWorker m_governance_worker{"govmsg"};
+    node::MessageWorker m_sigshares_worker{"sigsmsg"};
+    node::MessageWorker m_dkg_worker{"dkgmsg"};
 };
 
 const CNodeState* PeerManagerImpl::State(NodeId pnode) const EXCLUSIVE_LOCKS_REQUIRED(cs_main)
@@ -1385,7 +1432,13 @@ void PeerManagerImpl::AddTxAnnouncement(const CNode& node, const GenTxid& gtxid,
             m_txrequest.CountInFlight(nodeid) >= MAX_PEER_TX_REQUEST_IN_FLIGHT;
         if (overloaded) delay += OVERLOADED_PEER_TX_DELAY;
     }
-    m_txrequest.ReceivedInv(nodeid, gtxid, preferred, current_time + delay);
+    // SYSCOIN large downloads go to the peers with the fewest large requests in flight
+    const auto size_hint_it{state->m_tx_size_hints.find(gtxid.GetHash())};
+    const uint32_t size_hint{size_hint_it != state->m_tx_size_hints.end() ? size_hint_it->second : 0};
+    if (size_hint >= TX_SIZE_HINT_LARGE && m_txrequest.CountLargeInFlight(nodeid) >= MAX_PEER_LARGE_TX_REQUEST_IN_FLIGHT) {
+        delay += OVERLOADED_PEER_TX_DELAY;
+    }
+    m_txrequest.ReceivedInv(nodeid, gtxid, preferred, current_time + delay, size_hint);
 }
 
 void PeerManagerImpl::UpdateLastBlockAnnounceTime(NodeId node, int64_t time_in_seconds)
@@ -1431,7 +1484,7 @@ void PeerManagerImpl::ReattemptInitialBroadcast(CScheduler& scheduler)
     // Schedule next run for 10-15 minutes in the future.
     // We add randomness on every cycle to avoid the possibility of P2P fingerprinting.
     const std::chrono::milliseconds delta = 10min + GetRandMillis(5min);
-    scheduler.scheduleFromNow([&] { ReattemptInitialBroadcast(scheduler); }, delta);
+    scheduler.scheduleFromNow([&] { ReattemptInitialBroadcast(scheduler); }, delta, "reattemptbroadcast");
 }
 
 void PeerManagerImpl::FinalizeNode(const CNode& node)
@@ -1471,6 +1524,9 @@ void PeerManagerImpl::FinalizeNode(const CNode& node)
     }
     m_orphanage.EraseForPeer(nodeid);
     m_txrequest.DisconnectedPeer(nodeid);
+    // SYSCOIN
+    m_blobrequest.DisconnectedPeer(nodeid);
+    m_blob_assembler.ForgetPeer(nodeid);
     if (m_txreconciliation) m_txreconciliation->ForgetPeer(nodeid);
     m_num_preferred_download_peers -= state->fPreferredDownload;
     m_peers_downloading_from -= (!state->vBlocksInFlight.empty());
@@ -1488,6 +1544,9 @@ void PeerManagerImpl::FinalizeNode(const CNode& node)
         assert(m_outbound_peers_with_protect_from_disconnect == 0);
         assert(m_wtxid_relay_peers == 0);
         assert(m_txrequest.Size() == 0);
+        // SYSCOIN
+        assert(m_blobrequest.Size() == 0);
+        assert(m_blob_assembler.Size() == 0);
         assert(m_orphanage.Size() == 0);
     }
     } // cs_main
@@ -1793,11 +1852,50 @@ void PeerManagerImpl::StartScheduledTasks(CScheduler& scheduler)
     // combine them in one function and schedule at the quicker (peer-eviction)
     // timer.
     static_assert(EXTRA_PEER_CHECK_INTERVAL < STALE_CHECK_INTERVAL, "peer eviction timer should be less than stale tip check timer");
-    scheduler.scheduleEvery([this] { this->CheckForStaleTipAndEvictPeers(); }, std::chrono::seconds{EXTRA_PEER_CHECK_INTERVAL});
+    scheduler.scheduleEvery([this] { this->CheckForStaleTipAndEvictPeers(); }, std::chrono::seconds{EXTRA_PEER_CHECK_INTERVAL}, "staletipcheck");
 
     // schedule next run for 10-15 minutes in the future
     const std::chrono::milliseconds delta = 10min + GetRandMillis(5min);
-    scheduler.scheduleFromNow([&] { ReattemptInitialBroadcast(scheduler); }, delta);
+    scheduler.scheduleFromNow([&] { ReattemptInitialBroadcast(scheduler); }, delta, "reattemptbroadcast");
+
+    // SYSCOIN
+    m_governance_worker.Start();
+    m_sigshares_worker.Start();
+    m_dkg_worker.Start();
+}
+
+void PeerManagerImpl::StopMessageWorkers()
+{
+    m_governance_worker.Stop();
+    m_sigshares_worker.Stop();
+    m_dkg_worker.Stop();
+}
+
+void PeerManagerImpl::ProcessMessageOnWorker(node::MessageWorker& worker, CNode& pfrom, const std::string& msg_type, CDataStream& vRecv,
+                                             const std::atomic<bool>& interruptMsgProc, std::function<void(CNode&, const std::string&, CDataStream&)> fn)
+{
+    // the reference keeps the node alive until the worker is done, like for MNAUTH
+    pfrom.m_worker_msg_pending = true;
+    pfrom.AddRef();
+    auto task = [this, &pfrom, msg_type, vRecv, &interruptMsgProc, fn = std::move(fn)]() mutable {
+        if (!pfrom.fDisconnect && !interruptMsgProc) {
+            const auto process_start{SteadyClock::now()};
+            try {
+                fn(pfrom, msg_type, vRecv);
+            } catch (const std::exception& e) {
+                LogPrint(BCLog::NET, "%s(%s, %u bytes): Exception '%s' (%s) caught\n", __func__, SanitizeString(msg_type), vRecv.size(), e.what(), typeid(e).name());
+            } catch (...) {
+                LogPrint(BCLog::NET, "%s(%s, %u bytes): Unknown exception caught\n", __func__, SanitizeString(msg_type), vRecv.size());
+            }
+            // ProcessMessages counted the message already
+            pfrom.AccountProcessCost(msg_type, std::chrono::duration_cast<std::chrono::microseconds>(SteadyClock::now() - process_start), /*count=*/0);
+        }
+        pfrom.m_worker_msg_pending = false;
+        pfrom.Release();
+        m_connman.WakeMessageHandler();
+    };
+    // not started (tests) or shutting down, process it right here
+    if (!worker.Push(task)) task();
 }
 
 /**
@@ -2104,9 +2202,16 @@ void PeerManagerImpl::PushTxInventory(Peer& peer, const uint256& txid, const uin
 }
 void PeerManagerImpl::RelayInv(const CInv& inv)
 {
+    // SYSCOIN governance inventory is reconciled with txreconciliation peers instead of flooded to them
+    const bool fReconcilable{m_txreconciliation && IsReconcilableInv(inv)};
     LOCK(m_peer_mutex);
     for (const auto& [_, peer] : m_peer_map) {
-        if (!peer->GetTxRelay()) continue;
+        auto tx_relay = peer->GetTxRelay();
+        if (!tx_relay) continue;
+        if (fReconcilable) {
+            if (WITH_LOCK(tx_relay->m_tx_inventory_mutex, return tx_relay->m_tx_inventory_known_filter.contains(inv.hash))) continue;
+            if (m_txreconciliation->AddToReconSet(peer->m_id, inv)) continue;
+        }
         PushTxInventoryOther(*peer, inv);
     }
 }
@@ -2252,6 +2357,8 @@ void PeerManagerImpl::ProcessGetBlockData(CNode& pfrom, Peer& peer, const CInv&
     std::shared_ptr<const CBlock> pblock;
     // SYSCOIN
     bool bRecent = false;
+    // blocks past the PoDA enforcement window go out with the version hashes only
+    const bool fFillNEVMData{ServeNEVMData(pfrom, pindex->GetMedianTimePast())};
     if (a_recent_block && a_recent_block->GetHash() == pindex->GetBlockHash()) {
         pblock = a_recent_block;
         bRecent = true;
@@ -2259,14 +2366,14 @@ void PeerManagerImpl::ProcessGetBlockData(CNode& pfrom, Peer& peer, const CInv&
         // SYSCOIN
         // Send block from disk
         std::shared_ptr<CBlock> pblockRead = std::make_shared<CBlock>();
-        if (!m_chainman.m_blockman.ReadBlockFromDisk(*pblockRead, *pindex)) {
+        if (!m_chainman.m_blockman.ReadBlockFromDisk(*pblockRead, *pindex, fFillNEVMData)) {
             assert(!"cannot load block from disk");
         }
         pblock = pblockRead;
     } else {
         // Send block from disk
         std::shared_ptr<CBlock> pblockRead = std::make_shared<CBlock>();
-        if (!m_chainman.m_blockman.ReadBlockFromDisk(*pblockRead, *pindex)) {
+        if (!m_chainman.m_blockman.ReadBlockFromDisk(*pblockRead, *pindex, fFillNEVMData)) {
             assert(!"cannot load block from disk");
         }
         pblock = pblockRead;
@@ -2274,8 +2381,12 @@ void PeerManagerImpl::ProcessGetBlockData(CNode& pfrom, Peer& peer, const CInv&
     if (pblock) {
         if (inv.IsMsgBlk()) {
             m_connman.PushMessage(&pfrom, msgMaker.Make(SERIALIZE_TRANSACTION_NO_WITNESS, NetMsgType::BLOCK, *pblock));
+            // SYSCOIN
+            RecordBlockPayloadSent(*pblock);
         } else if (inv.IsMsgWitnessBlk()) {
             m_connman.PushMessage(&pfrom, msgMaker.Make(NetMsgType::BLOCK, *pblock));
+            // SYSCOIN
+            RecordBlockPayloadSent(*pblock);
         } else if (inv.IsMsgFilteredBlk()) {
             bool sendMerkleBlock = false;
             CMerkleBlock merkleBlock;
@@ -2316,6 +2427,8 @@ void PeerManagerImpl::ProcessGetBlockData(CNode& pfrom, Peer& peer, const CInv&
                 }
             } else {
                 m_connman.PushMessage(&pfrom, msgMaker.Make(NetMsgType::BLOCK, *pblock));
+                // SYSCOIN
+                RecordBlockPayloadSent(*pblock);
             }
         }
     }
@@ -2388,6 +2501,8 @@ void PeerManagerImpl::ProcessGetData(CNode& pfrom, Peer& peer, const std::atomic
                 // WTX and WITNESS_TX imply we serialize with witness
                 int nSendFlags = (inv.IsMsgTx() ? SERIALIZE_TRANSACTION_NO_WITNESS : 0);
                 m_connman.PushMessage(&pfrom, msgMaker.Make(nSendFlags, NetMsgType::TX, *tx));
+                // SYSCOIN
+                if (tx->IsNEVMData()) m_connman.RecordPayloadBytesSent(0, GetNEVMDataSize({tx}));
                 m_mempool.RemoveUnbroadcastTx(tx->GetHash());
             } else {
                 vNotFound.push_back(inv);
@@ -2550,10 +2665,16 @@ void PeerManagerImpl::SendBlockTransactions(CNode& pfrom, Peer& peer, const CBlo
             return;
         }
         resp.txn[i] = block.vtx[req.indexes[i]];
+        // SYSCOIN blob relay peers fetch the PoDA blobs with getblobchunk
+        if (peer.m_nevm_blob_relay) {
+            resp.txn[i] = StripNEVMData(resp.txn[i]);
+        }
     }
 
     const CNetMsgMaker msgMaker(pfrom.GetCommonVersion());
     m_connman.PushMessage(&pfrom, msgMaker.Make(NetMsgType::BLOCKTXN, resp));
+    // SYSCOIN
+    m_connman.RecordPayloadBytesSent(resp.vchNEVMBlockData.size(), GetNEVMDataSize(resp.txn));
 }
 
 bool PeerManagerImpl::CheckHeadersPoW(const std::vector<CBlockHeader>& headers, const Consensus::Params& consensusParams, Peer& peer)
@@ -3086,7 +3207,8 @@ void PeerManagerImpl::ProcessHeadersMessage(CNode& pfrom, Peer& peer,
 
     // Now process all the headers.
     BlockValidationState state;
-    if (!m_chainman.ProcessNewBlockHeaders(headers, /*min_pow_checked=*/true, state, &pindexLast)) {
+    // SYSCOIN the proof of work of every header was checked by CheckHeadersPoW when its message arrived
+    if (!m_chainman.ProcessNewBlockHeaders(headers, /*min_pow_checked=*/true, state, &pindexLast, /*pow_checked=*/true)) {
         if (state.IsInvalid()) {
             MaybePunishNodeForBlock(pfrom.GetId(), state, via_compact_block, "invalid header received");
             return;
@@ -3198,9 +3320,10 @@ bool PeerManagerImpl::PrepareBlockFilterRequest(CNode& node, Peer& peer,
                                                 const CBlockIndex*& stop_index,
                                                 BlockFilterIndex*& filter_index)
 {
-    // SYSCOIN rename BASIC_FILTER
+    // SYSCOIN rename BASIC_FILTER, the extended filter is served when its index runs
     const bool supported_filter_type =
-        (filter_type == BlockFilterType::BASIC_FILTER &&
+        ((filter_type == BlockFilterType::BASIC_FILTER ||
+          (filter_type == BlockFilterType::EXTENDED_FILTER && GetBlockFilterIndex(filter_type))) &&
          (peer.m_our_services & NODE_COMPACT_FILTERS));
     if (!supported_filter_type) {
         LogPrint(BCLog::NET, "peer %d requested unsupported block filter type: %d\n",
@@ -3377,11 +3500,122 @@ void PeerManagerImpl::ProcessBlock(CNode& node, const std::shared_ptr<const CBlo
     }
 }
 
+// SYSCOIN
+std::vector<NodeId> PeerManagerImpl::GetNEVMBlobRelayPeers() const
+{
+    std::vector<NodeId> ret;
+    LOCK(m_peer_mutex);
+    for (const auto& [nodeid, peer] : m_peer_map) {
+        if (peer->m_nevm_blob_relay) ret.emplace_back(nodeid);
+    }
+    return ret;
+}
+
+void PeerManagerImpl::FillNEVMDataLocally(CBlock& block)
+{
+    for (auto& tx : block.vtx) {
+        if (!MissingNEVMData(*tx)) continue;
+        const CTransactionRef mempool_tx{m_mempool.get(tx->GetHash())};
+        if (!mempool_tx) continue;
+        // only take the blob, the witness of the mempool transaction may differ
+        const int nOut{GetSyscoinDataOutput(*mempool_tx)};
+        if (nOut != -1 && mempool_tx->vout[nOut].HasNEVMData()) {
+            tx = AttachNEVMData(tx, mempool_tx->vout[nOut].vchNEVMData);
+        }
+    }
+    // blobs stored before, e.g. from a block that was reorged out
+    if (pnevmdatablobdb) FillNEVMData(block);
+}
+
+void PeerManagerImpl::RequestNEVMBlobChunks(const std::vector<CNEVMBlobChunkRequest>& vRequests, NodeId from, const std::vector<NodeId>& blob_relay_peers,
+                                            std::chrono::microseconds current_time)
+{
+    AssertLockHeld(::cs_main);
+    for (const auto& req : vRequests) {
+        std::vector<NodeId> candidates{from};
+        for (const uint256& hash : m_blob_assembler.BlocksWaitingFor(req.vchVersionHash)) {
+            const CBlockIndex* pindex = m_chainman.m_blockman.LookupBlockIndex(hash);
+            if (!pindex) continue;
+            for (const NodeId nodeid : blob_relay_peers) {
+                if (std::find(candidates.begin(), candidates.end(), nodeid) != candidates.end()) continue;
+                const CNodeState* state = State(nodeid);
+                if (state && state->pindexBestKnownBlock && state->pindexBestKnownBlock->GetAncestor(pindex->nHeight) == pindex) {
+                    candidates.emplace_back(nodeid);
+                }
+            }
+        }
+        // every candidate may be asked, the preferred one is rotated so the chunks of a blob download in parallel
+        const uint256 id{NEVMBlobChunkId(req)};
+        const NodeId preferred{candidates[req.nChunk % candidates.size()]};
+        for (const NodeId nodeid : candidates) {
+            m_blobrequest.ReceivedInv(nodeid, GenTxid::Txid(id), nodeid == preferred, current_time);
+        }
+    }
+}
+
+void PeerManagerImpl::FetchFullBlock(NodeId nodeid, const uint256& hash)
+{
+    PeerRef peer = GetPeerRef(nodeid);
+    if (!peer) return;
+    const std::vector<CInv> invs{CInv{MSG_BLOCK | GetFetchFlags(*peer), hash}};
+    m_connman.ForNode(nodeid, [this, &invs](CNode* node) {
+        const CNetMsgMaker msgMaker(node->GetCommonVersion());
+        this->m_connman.PushMessage(node, msgMaker.Make(NetMsgType::GETDATA, invs));
+        return true;
+    });
+}
+
+void PeerManagerImpl::ProcessGetBlobChunk(CNode& pfrom, const CNEVMBlobChunkRequest& req)
+{
+    CNEVMBlobChunk chunk{req.vchVersionHash, req.nChunk, 0, {}};
+    const uint64_t nOffset{uint64_t{req.nChunk} * NEVM_BLOB_CHUNK_SIZE};
+    auto fill = [&](Span<const uint8_t> data) {
+        if (nOffset >= data.size()) return;
+        chunk.nBlobSize = data.size();
+        const auto slice{data.subspan(nOffset, std::min<uint64_t>(NEVM_BLOB_CHUNK_SIZE, data.size() - nOffset))};
+        chunk.vchData.assign(slice.begin(), slice.end());
+    };
+    // blobs of mempool transactions and recent blocks are still in the cache, everything else is in the blob store
+    MapPoDAPayloadMeta meta;
+    const bool fMeta{pnevmdatadb && pnevmdatadb->GetBlobMetaData(req.vchVersionHash, meta)};
+    // blobs the peer can do without are answered like unknown ones once they are not served anymore
+    if (fMeta && !ServeNEVMData(pfrom, meta.nMedianTime)) {
+        LogPrint(BCLog::NET, "not serving PoDA blob chunk %u to peer=%d, blob upload target reached or blob expired\n", req.nChunk, pfrom.GetId());
+    } else if (fMeta && meta.vchNEVMData) {
+        fill(*meta.vchNEVMData);
+    } else if (pnevmdatablobdb) {
+        pnevmdatablobdb->ReadBlob(req.vchVersionHash, fill);
+    }
+    m_connman.PushMessage(&pfrom, CNetMsgMaker(pfrom.GetCommonVersion()).Make(NetMsgType::BLOBCHUNK, chunk));
+    m_connman.RecordPayloadBytesSent(0, chunk.vchData.size());
+}
+
+bool PeerManagerImpl::ServeNEVMData(const CNode& pfrom, int64_t nMedianTime) const
+{
+    switch (GetNEVMDataServe(nMedianTime, TicksSinceEpoch<std::chrono::seconds>(GetAdjustedTime()))) {
+    case NEVMDataServe::REQUIRED:
+        return true;
+    case NEVMDataServe::OPTIONAL:
+        // nodes with the download permission may exceed target
+        return pfrom.HasPermission(NetPermissionFlags::Download) || !m_connman.OutboundBlobTargetReached();
+    case NEVMDataServe::EXPIRED:
+        return false;
+    } // no default case, so the compiler can warn about missing cases
+    assert(false);
+}
+
+void PeerManagerImpl::RecordBlockPayloadSent(const CBlock& block)
+{
+    m_connman.RecordPayloadBytesSent(block.IsNEVM() ? block.vchNEVMBlockData.size() : 0, GetNEVMDataSize(block.vtx));
+}
+
 void PeerManagerImpl::ProcessCompactBlockTxns(CNode& pfrom, Peer& peer, const BlockTransactions& block_transactions)
 {
     std::shared_ptr<CBlock> pblock = std::make_shared<CBlock>();
     bool fBlockRead{false};
     const CNetMsgMaker msgMaker(pfrom.GetCommonVersion());
+    // SYSCOIN
+    const std::vector<NodeId> blob_relay_peers{peer.m_nevm_blob_relay ? GetNEVMBlobRelayPeers() : std::vector<NodeId>{}};
     {
         LOCK(cs_main);
 
@@ -3424,6 +3658,26 @@ void PeerManagerImpl::ProcessCompactBlockTxns(CNode& pfrom, Peer& peer, const Bl
                 return;
             }
         } else {
+            // SYSCOIN blob relay peers leave the PoDA blobs out of blocktxn, the block is held
+            // (and stays in flight) until the blobs arrived
+            if (peer.m_nevm_blob_relay) {
+                FillNEVMDataLocally(*pblock);
+                std::vector<CNEVMBlobChunkRequest> vRequests;
+                if (m_blob_assembler.AddBlock(pblock, pfrom.GetId(), GetTime<std::chrono::microseconds>(), vRequests)) {
+                    LogPrint(BCLog::NET, "Peer %d sent us block transactions without PoDA blobs for block %s, fetching %d blob chunks\n",
+                             pfrom.GetId(), block_transactions.blockhash.ToString(), vRequests.size());
+                    mapBlockSource.emplace(block_transactions.blockhash, std::make_pair(pfrom.GetId(), false));
+                    RequestNEVMBlobChunks(vRequests, pfrom.GetId(), blob_relay_peers, GetTime<std::chrono::microseconds>());
+                    return;
+                }
+                if (std::any_of(pblock->vtx.begin(), pblock->vtx.end(), [](const CTransactionRef& tx) { return MissingNEVMData(*tx).has_value(); })) {
+                    // too many blocks or blobs waiting already, download this one in full
+                    std::vector<CInv> invs;
+                    invs.emplace_back(MSG_BLOCK | GetFetchFlags(peer), block_transactions.blockhash);
+                    m_connman.PushMessage(&pfrom, msgMaker.Make(NetMsgType::GETDATA, invs));
+                    return;
+                }
+            }
             // Block is either okay, or possibly we received
             // READ_STATUS_CHECKBLOCK_FAILED.
             // Note that CheckBlock can only fail for one of a few reasons:
@@ -3591,6 +3845,8 @@ void PeerManagerImpl::ProcessMessage(CNode& pfrom, const std::string& msg_type,
             // BIP155 that doesn't announce at least that protocol version number.
             m_connman.PushMessage(&pfrom, msg_maker.Make(NetMsgType::SENDADDRV2));
         }
+        // SYSCOIN ask for blocktxn without PoDA blobs, nodes that don't know the message ignore it
+        m_connman.PushMessage(&pfrom, msg_maker.Make(NetMsgType::SENDBLOBS));
 
         pfrom.m_has_all_wanted_services = HasAllDesirableServiceFlags(nServices);
         peer->m_their_services = nServices;
@@ -3847,6 +4103,18 @@ void PeerManagerImpl::ProcessMessage(CNode& pfrom, const std::string& msg_type,
         return;
     }
 
+    // SYSCOIN blob relay is negotiated between VERSION and VERACK like addrv2, so blocktxn
+    // messages never switch format while a block is being reconstructed
+    if (msg_type == NetMsgType::SENDBLOBS) {
+        if (pfrom.fSuccessfullyConnected) {
+            LogPrint(BCLog::NET, "sendblobs received after verack from peer=%d; disconnecting\n", pfrom.GetId());
+            pfrom.fDisconnect = true;
+            return;
+        }
+        peer->m_nevm_blob_relay = true;
+        return;
+    }
+
     // Received from a peer demonstrating readiness to announce transactions via reconciliations.
     // This feature negotiation must happen between VERSION and VERACK to avoid relay problems
     // from switching announcement protocols after the connection is up.
@@ -4022,6 +4290,20 @@ void PeerManagerImpl::ProcessMessage(CNode& pfrom, const std::string& msg_type,
         peer->m_wants_recsigs = true;
         return;
     }
+    // SYSCOIN sizes of the blob transactions announced by the inv that follows
+    if (msg_type == NetMsgType::TXSIZEHINTS) {
+        std::vector<std::pair<uint256, uint32_t>> vHints;
+        vRecv >> vHints;
+        if (vHints.size() > MAX_INV_SZ) {
+            Misbehaving(*peer, 20, strprintf("txsizehints message size = %u", vHints.size()));
+            return;
+        }
+        LOCK(cs_main);
+        CNodeState& state{*Assert(State(pfrom.GetId()))};
+        state.m_tx_size_hints = std::map<uint256, uint32_t>(vHints.begin(), vHints.end());
+        return;
+    }
+
     if (msg_type == NetMsgType::INV) {
         std::vector<CInv> vInv;
         vRecv >> vInv;
@@ -4075,6 +4357,10 @@ void PeerManagerImpl::ProcessMessage(CNode& pfrom, const std::string& msg_type,
                 LogPrint(BCLog::NET, "got inv: %s  %s peer=%d\n", inv.ToString(), fAlreadyHave ? "have" : "new", pfrom.GetId());
 
                 AddKnownTx(*peer, inv.hash);
+                // SYSCOIN the peer has it already, there is nothing to reconcile
+                if (m_txreconciliation && IsReconcilableInv(inv)) {
+                    m_txreconciliation->TryRemovingFromReconSet(pfrom.GetId(), inv.hash);
+                }
                 if (!fAlreadyHave && !m_chainman.IsInitialBlockDownload()) {
                     AddTxAnnouncement(pfrom, gtxid, current_time);
                 // SYSCOIN
@@ -4091,6 +4377,8 @@ void PeerManagerImpl::ProcessMessage(CNode& pfrom, const std::string& msg_type,
                 LogPrint(BCLog::NET, "Unknown inv type \"%s\" received from peer=%d\n", inv.ToString(), pfrom.GetId());
             }
         }
+        // SYSCOIN the hints only apply to the inv they preceded
+        State(pfrom.GetId())->m_tx_size_hints.clear();
 
         if (best_block != nullptr) {
             // If we haven't started initial headers-sync with this peer, then
@@ -4385,18 +4673,28 @@ void PeerManagerImpl::ProcessMessage(CNode& pfrom, const std::string& msg_type,
         CTransactionRef ptx;
         vRecv >> ptx;
         const CTransaction& tx = *ptx;
-
         const uint256& txid = ptx->GetHash();
         const uint256& wtxid = ptx->GetWitnessHash();
 
         const uint256& hash = peer->m_wtxid_relay ? wtxid : txid;
         AddKnownTx(*peer, hash);
 
+        // SYSCOIN hash the PoDA blob before cs_main is taken, mempool acceptance then only does the
+        // contextual checks. Transactions already in the mempool are rejected without looking at the blob.
+        const bool fPoDAValid{m_mempool.exists(GenTxid::Txid(txid)) || PreValidateNEVMData(tx)};
+
         LOCK(cs_main);
 
         m_txrequest.ReceivedResponse(pfrom.GetId(), txid);
         if (tx.HasWitness()) m_txrequest.ReceivedResponse(pfrom.GetId(), wtxid);
 
+        // SYSCOIN the txid does not commit to the blob, so it isn't added to the rejects filter either,
+        // that would let anyone block a transaction by relaying it with a corrupted blob first
+        if (!fPoDAValid) {
+            LogPrint(BCLog::MEMPOOL, "PoDA blob of tx %s does not match its version hash, peer=%d\n", txid.ToString(), pfrom.GetId());
+            return;
+        }
+
         // We do the AlreadyHaveTx() check using wtxid, rather than txid - in the
         // absence of witness malleation, this is strictly better, because the
         // recent rejects filter may contain the wtxid but rarely contains
@@ -4507,7 +4805,7 @@ void PeerManagerImpl::ProcessMessage(CNode& pfrom, const std::string& msg_type,
                 m_txrequest.ForgetTxHash(tx.GetWitnessHash());
 
                 // DoS prevention: do not allow m_orphanage to grow unbounded (see CVE-2012-3789)
-                m_orphanage.LimitOrphans(m_opts.max_orphan_txs);
+                m_orphanage.LimitOrphans(m_opts.max_orphan_txs, m_opts.max_orphan_usage);
             } else {
                 LogPrint(BCLog::MEMPOOL, "not keeping orphan with rejected parents %s (wtxid=%s)\n",
                          tx.GetHash().ToString(),
@@ -4830,6 +5128,94 @@ void PeerManagerImpl::ProcessMessage(CNode& pfrom, const std::string& msg_type,
         return ProcessCompactBlockTxns(pfrom, *peer, resp);
     }
 
+    // SYSCOIN
+    if (msg_type == NetMsgType::GETBLOBCHUNK) {
+        std::vector<CNEVMBlobChunkRequest> vRequests;
+        vRecv >> vRequests;
+        if (vRequests.size() > MAX_NEVM_BLOB_CHUNK_REQUESTS) {
+            Misbehaving(*peer, 20, strprintf("getblobchunk message size = %u", vRequests.size()));
+            return;
+        }
+        for (const auto& req : vRequests) {
+            ProcessGetBlobChunk(pfrom, req);
+        }
+        return;
+    }
+
+    if (msg_type == NetMsgType::REQGOVRECON) {
+        if (!m_txreconciliation) return;
+        uint16_t peer_set_size;
+        vRecv >> peer_set_size;
+        if (const auto sketch = m_txreconciliation->HandleReconciliationRequest(pfrom.GetId(), peer_set_size)) {
+            m_connman.PushMessage(&pfrom, CNetMsgMaker(pfrom.GetCommonVersion()).Make(NetMsgType::GOVSKETCH, *sketch));
+        } else {
+            LogPrintLevel(BCLog::TXRECONCILIATION, BCLog::Level::Debug, "Ignore unexpected reqgovrecon from peer=%d\n", pfrom.GetId());
+        }
+        return;
+    }
+
+    if (msg_type == NetMsgType::GOVSKETCH) {
+        if (!m_txreconciliation) return;
+        std::vector<uint8_t> sketch;
+        vRecv >> sketch;
+        const auto result = m_txreconciliation->HandleSketch(pfrom.GetId(), sketch);
+        if (!result) {
+            LogPrintLevel(BCLog::TXRECONCILIATION, BCLog::Level::Debug, "Ignore unexpected govsketch from peer=%d\n", pfrom.GetId());
+            return;
+        }
+        for (const CInv& inv : result->vAnnounce) {
+            PushTxInventoryOther(*peer, inv);
+        }
+        m_connman.PushMessage(&pfrom, CNetMsgMaker(pfrom.GetCommonVersion()).Make(NetMsgType::GOVRECONDIFF, result->fSuccess, result->vAsk));
+        return;
+    }
+
+    if (msg_type == NetMsgType::GOVRECONDIFF) {
+        if (!m_txreconciliation) return;
+        bool success;
+        std::vector<uint32_t> vAsk;
+        vRecv >> success >> vAsk;
+        const auto vAnnounce = m_txreconciliation->HandleReconciliationDiff(pfrom.GetId(), success, vAsk);
+        if (!vAnnounce) {
+            LogPrintLevel(BCLog::TXRECONCILIATION, BCLog::Level::Debug, "Ignore unexpected govrecondiff from peer=%d\n", pfrom.GetId());
+            return;
+        }
+        for (const CInv& inv : *vAnnounce) {
+            PushTxInventoryOther(*peer, inv);
+        }
+        return;
+    }
+
+    if (msg_type == NetMsgType::BLOBCHUNK) {
+        CNEVMBlobChunk chunk;
+        vRecv >> chunk;
+        const std::vector<NodeId> blob_relay_peers{GetNEVMBlobRelayPeers()};
+        NEVMBlobAssembler::ChunkResult result;
+        {
+            LOCK(cs_main);
+            m_blobrequest.ReceivedResponse(pfrom.GetId(), NEVMBlobChunkId({chunk.vchVersionHash, chunk.nChunk}));
+            result = m_blob_assembler.ReceivedChunk(chunk);
+            if (!result.vRequests.empty()) {
+                RequestNEVMBlobChunks(result.vRequests, pfrom.GetId(), blob_relay_peers, GetTime<std::chrono::microseconds>());
+            }
+            for (const auto& [pblock, from] : result.vComplete) {
+                RemoveBlockRequest(pblock->GetHash(), from);
+            }
+        }
+        if (result.fInvalid) {
+            Misbehaving(*peer, 10, "invalid blobchunk");
+        }
+        for (const auto& [hash, from] : result.vFailed) {
+            LogPrint(BCLog::NET, "PoDA blob of block %s does not match its version hash, downloading the block in full from peer=%d\n", hash.ToString(), from);
+            FetchFullBlock(from, hash);
+        }
+        for (const auto& [pblock, from] : result.vComplete) {
+            LogPrint(BCLog::NET, "received the PoDA blobs of block %s from peer=%d\n", pblock->GetHash().ToString(), from);
+            ProcessBlock(pfrom, pblock, /*force_processing=*/true, /*min_pow_checked=*/true);
+        }
+        return;
+    }
+
     if (msg_type == NetMsgType::HEADERS)
     {
         // Ignore headers received while importing
@@ -4888,6 +5274,8 @@ void PeerManagerImpl::ProcessMessage(CNode& pfrom, const std::string& msg_type,
         std::shared_ptr<CBlock> pblock = std::make_shared<CBlock>();
         vRecv >> *pblock;
         LogPrint(BCLog::NET, "received block %s peer=%d\n", pblock->GetHash().ToString(), pfrom.GetId());
+        // SYSCOIN start hashing PoDA blobs while the block goes through CheckBlock and AcceptBlock
+        if (g_nevm_blob_hasher) g_nevm_blob_hasher->Submit(*pblock);
 
         bool forceProcessing = false;
         const uint256 hash(pblock->GetHash());
@@ -4898,6 +5286,8 @@ void PeerManagerImpl::ProcessMessage(CNode& pfrom, const std::string& msg_type,
             // need it even when it's not a candidate for a new best tip.
             forceProcessing = IsBlockRequested(hash);
             RemoveBlockRequest(hash, pfrom.GetId());
+            // SYSCOIN the full block makes waiting for its blobs unnecessary
+            m_blob_assembler.ForgetBlock(hash);
             // mapBlockSource is only used for punishing peers and setting
             // which peers send us compact blocks, so the race between here and
             // cs_main in ProcessNewBlock is fine.
@@ -5184,7 +5574,10 @@ void PeerManagerImpl::ProcessMessage(CNode& pfrom, const std::string& msg_type,
     } else if(msg_type == NetMsgType::MNGOVERNANCESYNC ||
         msg_type == NetMsgType::MNGOVERNANCEOBJECT ||
         msg_type == NetMsgType::MNGOVERNANCEOBJECTVOTE) {
-        governance->ProcessMessage(&pfrom, msg_type, vRecv, m_connman, *this);
+        // SYSCOIN a governance sync checks thousands of votes, it must not hold up chainlocks of other peers
+        ProcessMessageOnWorker(m_governance_worker, pfrom, msg_type, vRecv, interruptMsgProc, [this](CNode& node, const std::string& type, CDataStream& recv) {
+            governance->ProcessMessage(&node, type, recv, m_connman, *this);
+        });
         return;
     } else if(msg_type == NetMsgType::MNAUTH) {
         CMNAuth::ProcessMessage(&pfrom, msg_type, vRecv, m_chainman, m_connman, *this);
@@ -5203,14 +5596,18 @@ void PeerManagerImpl::ProcessMessage(CNode& pfrom, const std::string& msg_type,
             msg_type == NetMsgType::QJUSTIFICATION ||
             msg_type == NetMsgType::QPCOMMITMENT ||
             msg_type == NetMsgType::QWATCH) {
-        llmq::quorumDKGSessionManager->ProcessMessage(&pfrom, msg_type, vRecv);
+        ProcessMessageOnWorker(m_dkg_worker, pfrom, msg_type, vRecv, interruptMsgProc, [](CNode& node, const std::string& type, CDataStream& recv) {
+            llmq::quorumDKGSessionManager->ProcessMessage(&node, type, recv);
+        });
         return;
     } else if(msg_type == NetMsgType::QSIGSHARE ||
             msg_type == NetMsgType::QSIGSESANN ||
             msg_type == NetMsgType::QSIGSHARESINV ||
             msg_type == NetMsgType::QGETSIGSHARES ||
             msg_type == NetMsgType::QBSIGSHARES) {
-        llmq::quorumSigSharesManager->ProcessMessage(&pfrom, msg_type, vRecv);
+        ProcessMessageOnWorker(m_sigshares_worker, pfrom, msg_type, vRecv, interruptMsgProc, [](CNode& node, const std::string& type, CDataStream& recv) {
+            llmq::quorumSigSharesManager->ProcessMessage(&node, type, recv);
+        });
         return;
     }
 
@@ -5291,6 +5688,10 @@ bool PeerManagerImpl::ProcessMessages(CNode* pfrom, std::atomic<bool>& interrupt
     // Don't bother if send buffer is too full to respond anyway
     if (pfrom->fPauseSend) return false;
 
+    // SYSCOIN hold back everything after MNAUTH until its signature was checked, see CMNAuth::ProcessMessage,
+    // and after a message handed to a worker until it was processed, see ProcessMessageOnWorker
+    if (pfrom->m_mnauth_pending || pfrom->m_worker_msg_pending) return false;
+
     auto poll_result{pfrom->PollMessage()};
     if (!poll_result) {
         // No message to process
@@ -5315,8 +5716,14 @@ bool PeerManagerImpl::ProcessMessages(CNode* pfrom, std::atomic<bool>& interrupt
 
     msg.SetVersion(pfrom->GetCommonVersion());
 
+    // SYSCOIN time spent on the message, including the exception paths, see getnetmsgstats
+    const auto process_start{SteadyClock::now()};
+    const auto account_cost = [&]() {
+        pfrom->AccountProcessCost(msg.m_type, std::chrono::duration_cast<std::chrono::microseconds>(SteadyClock::now() - process_start));
+    };
     try {
         ProcessMessage(*pfrom, msg.m_type, msg.m_recv, msg.m_time, interruptMsgProc);
+        account_cost();
         if (interruptMsgProc) return false;
         {
             LOCK(peer->m_getdata_requests_mutex);
@@ -5329,10 +5736,14 @@ bool PeerManagerImpl::ProcessMessages(CNode* pfrom, std::atomic<bool>& interrupt
         //  unnecessary 100ms delay)
         if (m_orphanage.HaveTxToReconsider(peer->m_id)) fMoreWork = true;
     } catch (const std::exception& e) {
+        account_cost();
         LogPrint(BCLog::NET, "%s(%s, %u bytes): Exception '%s' (%s) caught\n", __func__, SanitizeString(msg.m_type), msg.m_message_size, e.what(), typeid(e).name());
     } catch (...) {
+        account_cost();
         LogPrint(BCLog::NET, "%s(%s, %u bytes): Unknown exception caught\n", __func__, SanitizeString(msg.m_type), msg.m_message_size);
     }
+    // SYSCOIN everything was deserialized out of the buffer, the next large message can have it
+    g_recv_buffer_pool.Give(std::move(msg.m_recv));
 
     return fMoreWork;
 }
@@ -5989,6 +6400,16 @@ bool PeerManagerImpl::SendMessages(CNode* pto)
         //
         std::vector<CInv> vInv;
         uint256 verifiedProRegTxHash = pto->GetVerifiedProRegTxHash();
+        // SYSCOIN the size hints of blob transactions go out right ahead of the inv announcing them
+        std::vector<std::pair<uint256, uint32_t>> vTxSizeHints;
+        const auto PushInv = [&]() {
+            if (!vTxSizeHints.empty()) {
+                m_connman.PushMessage(pto, msgMaker.Make(NetMsgType::TXSIZEHINTS, vTxSizeHints));
+                vTxSizeHints.clear();
+            }
+            m_connman.PushMessage(pto, msgMaker.Make(NetMsgType::INV, vInv));
+            vInv.clear();
+        };
         {
             LOCK(peer->m_block_inv_mutex);
             vInv.reserve(std::max<size_t>(peer->m_blocks_for_inv_relay.size(), INVENTORY_BROADCAST_TARGET));
@@ -6049,10 +6470,13 @@ bool PeerManagerImpl::SendMessages(CNode* pto)
                             if (!tx_relay->m_bloom_filter->IsRelevantAndUpdate(*txinfo.tx)) continue;
                         }
                         tx_relay->m_tx_inventory_known_filter.insert(hash);
+                        // SYSCOIN
+                        if (peer->m_nevm_blob_relay && txinfo.tx->IsNEVMData()) {
+                            vTxSizeHints.emplace_back(hash, ::GetSerializeSize(*txinfo.tx, PROTOCOL_VERSION, SER_NETWORK));
+                        }
                         vInv.push_back(inv);
                         if (vInv.size() == MAX_INV_SZ) {
-                            m_connman.PushMessage(pto, msgMaker.Make(NetMsgType::INV, vInv));
-                            vInv.clear();
+                            PushInv();
                         }
                     }
 
@@ -6066,8 +6490,7 @@ bool PeerManagerImpl::SendMessages(CNode* pto)
                         vInv.push_back(inv);
                         tx_relay->m_tx_inventory_known_filter.insert(inv.hash);
                         if (vInv.size() == MAX_INV_SZ) {
-                            m_connman.PushMessage(pto, msgMaker.Make(NetMsgType::INV, vInv));
-                            vInv.clear();
+                            PushInv();
                         }
                     }
                 }
@@ -6113,12 +6536,15 @@ bool PeerManagerImpl::SendMessages(CNode* pto)
                             continue;
                         }
                         if (tx_relay->m_bloom_filter && !tx_relay->m_bloom_filter->IsRelevantAndUpdate(*txinfo.tx)) continue;
+                        // SYSCOIN let blob relay peers schedule the download of a blob transaction
+                        if (peer->m_nevm_blob_relay && txinfo.tx->IsNEVMData()) {
+                            vTxSizeHints.emplace_back(hash, ::GetSerializeSize(*txinfo.tx, PROTOCOL_VERSION, SER_NETWORK));
+                        }
                         // Send
                         vInv.push_back(inv);
                         nRelayedTransactions++;
                         if (vInv.size() == MAX_INV_SZ) {
-                            m_connman.PushMessage(pto, msgMaker.Make(NetMsgType::INV, vInv));
-                            vInv.clear();
+                            PushInv();
                         }
                         tx_relay->m_tx_inventory_known_filter.insert(hash);
                     }
@@ -6137,8 +6563,7 @@ bool PeerManagerImpl::SendMessages(CNode* pto)
                         vInv.emplace_back(inv);
                         tx_relay->m_tx_inventory_known_filter.insert(inv.hash);
                         if (vInv.size() == MAX_INV_SZ) {
-                            m_connman.PushMessage(pto, msgMaker.Make(NetMsgType::INV, vInv));
-                            vInv.clear();
+                            PushInv();
                         }
                     }
 
@@ -6149,7 +6574,14 @@ bool PeerManagerImpl::SendMessages(CNode* pto)
         }
 
         if (!vInv.empty()) {
-            m_connman.PushMessage(pto, msgMaker.Make(NetMsgType::INV, vInv));
+            PushInv();
+        }
+
+        // SYSCOIN reconcile governance inventory with the peers we initiate reconciliations with
+        if (m_txreconciliation) {
+            if (const auto set_size = m_txreconciliation->InitiateReconciliation(pto->GetId(), current_time)) {
+                m_connman.PushMessage(pto, msgMaker.Make(NetMsgType::REQGOVRECON, *set_size));
+            }
         }
 
         // Detect whether we're stalling
@@ -6294,6 +6726,32 @@ bool PeerManagerImpl::SendMessages(CNode* pto)
             }
         }
 
+        // SYSCOIN
+        //
+        // Message: getblobchunk
+        //
+        for (const uint256& hash : m_blob_assembler.ExpireBlocks(pto->GetId(), current_time)) {
+            LogPrint(BCLog::NET, "timeout of PoDA blobs for block %s, downloading it in full from peer=%d\n", hash.ToString(), pto->GetId());
+            vGetData.emplace_back(MSG_BLOCK | GetFetchFlags(*peer), hash);
+        }
+        std::vector<std::pair<NodeId, GenTxid>> expired_chunks;
+        std::vector<CNEVMBlobChunkRequest> vBlobChunks;
+        for (const GenTxid& gtxid : m_blobrequest.GetRequestable(pto->GetId(), current_time, &expired_chunks)) {
+            if (auto req = m_blob_assembler.LookupChunk(gtxid.GetHash())) {
+                vBlobChunks.emplace_back(std::move(*req));
+                m_blobrequest.RequestedTx(pto->GetId(), gtxid.GetHash(), current_time + NEVM_BLOB_CHUNK_TIMEOUT);
+                if (vBlobChunks.size() >= MAX_NEVM_BLOB_CHUNK_REQUESTS) {
+                    m_connman.PushMessage(pto, msgMaker.Make(NetMsgType::GETBLOBCHUNK, vBlobChunks));
+                    vBlobChunks.clear();
+                }
+            } else {
+                // the blob completed or nothing waits for it anymore
+                m_blobrequest.ForgetTxHash(gtxid.GetHash());
+            }
+        }
+        if (!vBlobChunks.empty())
+            m_connman.PushMessage(pto, msgMaker.Make(NetMsgType::GETBLOBCHUNK, vBlobChunks));
+
         if (!vGetData.empty())
             m_connman.PushMessage(pto, msgMaker.Make(NetMsgType::GETDATA, vGetData));
     } // release cs_main
@@ -19,6 +19,9 @@ class ChainstateManager;
 static constexpr bool DEFAULT_TXRECONCILIATION_ENABLE{false};
 /** Default for -maxorphantx, maximum number of orphan transactions kept in memory */
 static const uint32_t DEFAULT_MAX_ORPHAN_TRANSACTIONS{100};
+// SYSCOIN
+/** Default maximum memory of the orphan transactions, PoDA blobs counted at full size */
+static const size_t DEFAULT_MAX_ORPHAN_USAGE{10 * MAX_NEVM_DATA_BLOB};
 /** Default number of non-mempool transactions to keep around for block reconstruction. Includes
     orphan, replaced, and rejected transactions. */
 static const uint32_t DEFAULT_BLOCK_RECONSTRUCTION_EXTRA_TXN{100};
@@ -253,6 +256,8 @@ struct Peer {
     // SYSCOIN
     /** This peer's a masternode connection */
     std::atomic<bool> m_masternode_connection{false};
+    /** Whether this peer gets blocktxn without PoDA blobs and fetches them with getblobchunk (sendblobs) */
+    std::atomic<bool> m_nevm_blob_relay{false};
     explicit Peer(NodeId id, ServiceFlags our_services)
         : m_id{id}
         , m_our_services{our_services}
@@ -277,6 +282,9 @@ public:
         bool reconcile_txs{DEFAULT_TXRECONCILIATION_ENABLE};
         //! Maximum number of orphan transactions kept in memory
         uint32_t max_orphan_txs{DEFAULT_MAX_ORPHAN_TRANSACTIONS};
+        // SYSCOIN
+        //! Maximum memory of the orphan transactions kept in memory
+        size_t max_orphan_usage{DEFAULT_MAX_ORPHAN_USAGE};
         //! Number of non-mempool transactions to keep around for block reconstruction. Includes
         //! orphan, replaced, and rejected transactions.
         uint32_t max_extra_txs{DEFAULT_BLOCK_RECONSTRUCTION_EXTRA_TXN};
@@ -304,6 +312,9 @@ public:
     /** Begin running background tasks, should only be called once */
     virtual void StartScheduledTasks(CScheduler& scheduler) = 0;
 
+    /** SYSCOIN Finish the messages handed to the message workers and stop them, before the nodes are deleted */
+    virtual void StopMessageWorkers() = 0;
+
     /** Get statistics from node state */
     virtual bool GetNodeStateStats(NodeId nodeid, CNodeStateStats& stats) const = 0;
 
@@ -28,30 +28,44 @@ CNetFulfilledRequestManager::~CNetFulfilledRequestManager()
     m_db->Store(*this);
 }
 
+void NetFulfilledRequestStore::AddToExpiryBucket(const CService& addr, int64_t nExpiry)
+{
+    mapExpiryBuckets[nExpiry / EXPIRY_BUCKET_SECONDS].insert(addr);
+}
+
 void CNetFulfilledRequestManager::AddFulfilledRequest(const CService& addr, const std::string& strRequest)
 {
     LOCK(cs_mapFulfilledRequests);
-    mapFulfilledRequests[addr][strRequest] = GetTime() + Params().FulfilledRequestExpireTime();
+    // SYSCOIN stay bounded, forgetting a request only means the peer may ask (or be asked) once more
+    if (mapFulfilledRequests.count(addr) == 0) {
+        while (mapFulfilledRequests.size() >= MAX_FULFILLED_ADDRESSES && !mapExpiryBuckets.empty()) {
+            for (const auto& addrOld : mapExpiryBuckets.begin()->second) {
+                mapFulfilledRequests.erase(addrOld);
+            }
+            mapExpiryBuckets.erase(mapExpiryBuckets.begin());
+        }
+    }
+    const int64_t nExpiry = GetTime() + Params().FulfilledRequestExpireTime();
+    mapFulfilledRequests[addr][strRequest] = nExpiry;
+    AddToExpiryBucket(addr, nExpiry);
 }
 
 bool CNetFulfilledRequestManager::HasFulfilledRequest(const CService& addr, const std::string& strRequest)
 {
     LOCK(cs_mapFulfilledRequests);
     fulfilledreqmap_t::iterator it = mapFulfilledRequests.find(addr);
-
-    return  it != mapFulfilledRequests.end() &&
-            it->second.find(strRequest) != it->second.end() &&
-            it->second[strRequest] > GetTime();
+    if (it == mapFulfilledRequests.end()) {
+        return false;
+    }
+    fulfilledreqmapentry_t::iterator it_entry = it->second.find(strRequest);
+    return it_entry != it->second.end() && it_entry->second > GetTime();
 }
 
 void CNetFulfilledRequestManager::RemoveAllFulfilledRequests(const CService& addr)
 {
     LOCK(cs_mapFulfilledRequests);
-    fulfilledreqmap_t::iterator it = mapFulfilledRequests.find(addr);
-
-    if (it != mapFulfilledRequests.end()) {
-        mapFulfilledRequests.erase(it++);
-    }
+    // a stale reference left in the expiry buckets is skipped when its bucket expires
+    mapFulfilledRequests.erase(addr);
 }
 
 void CNetFulfilledRequestManager::CheckAndRemove()
@@ -59,22 +73,25 @@ void CNetFulfilledRequestManager::CheckAndRemove()
     LOCK(cs_mapFulfilledRequests);
 
     int64_t now = GetTime();
-    fulfilledreqmap_t::iterator it = mapFulfilledRequests.begin();
-
-    while(it != mapFulfilledRequests.end()) {
-        fulfilledreqmapentry_t::iterator it_entry = it->second.begin();
-        while(it_entry != it->second.end()) {
-            if(now > it_entry->second) {
-                it->second.erase(it_entry++);
-            } else {
-                ++it_entry;
+    // SYSCOIN a bucket is done once everything in it is expired, requests renewed since then sit in a later one too
+    expirybuckets_t::iterator it_bucket = mapExpiryBuckets.begin();
+    while (it_bucket != mapExpiryBuckets.end() && it_bucket->first < now / EXPIRY_BUCKET_SECONDS) {
+        for (const auto& addr : it_bucket->second) {
+            fulfilledreqmap_t::iterator it = mapFulfilledRequests.find(addr);
+            if (it == mapFulfilledRequests.end()) continue;
+            fulfilledreqmapentry_t::iterator it_entry = it->second.begin();
+            while(it_entry != it->second.end()) {
+                if(now > it_entry->second) {
+                    it->second.erase(it_entry++);
+                } else {
+                    ++it_entry;
+                }
+            }
+            if(it->second.size() == 0) {
+                mapFulfilledRequests.erase(it);
             }
         }
-        if(it->second.size() == 0) {
-            mapFulfilledRequests.erase(it++);
-        } else {
-            ++it;
-        }
+        it_bucket = mapExpiryBuckets.erase(it_bucket);
     }
 }
 
@@ -82,6 +99,7 @@ void NetFulfilledRequestStore::Clear()
 {
     LOCK(cs_mapFulfilledRequests);
     mapFulfilledRequests.clear();
+    mapExpiryBuckets.clear();
 }
 
 std::string NetFulfilledRequestStore::ToString() const
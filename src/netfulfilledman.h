@@ -9,7 +9,9 @@
 #include <serialize.h>
 #include <sync.h>
 
+#include <map>
 #include <memory>
+#include <set>
 
 template<typename T>
 class CFlatDB;
@@ -20,17 +22,65 @@ class NetFulfilledRequestStore
 protected:
     typedef std::map<std::string, int64_t> fulfilledreqmapentry_t;
     typedef std::map<CService, fulfilledreqmapentry_t> fulfilledreqmap_t;
+    // SYSCOIN addresses having a request that expires within a given minute
+    typedef std::map<int64_t, std::set<CService>> expirybuckets_t;
+
+    static constexpr int64_t EXPIRY_BUCKET_SECONDS{60};
+    // Addresses tracked at most, the ones expiring first make room for new ones
+    static constexpr size_t MAX_FULFILLED_ADDRESSES{10000};
 
 protected:
     //keep track of what node has/was asked for and when
     fulfilledreqmap_t mapFulfilledRequests;
+    // lets expiry visit only the addresses with something to expire
+    expirybuckets_t mapExpiryBuckets;
     mutable RecursiveMutex cs_mapFulfilledRequests;
 
+    void AddToExpiryBucket(const CService& addr, int64_t nExpiry) EXCLUSIVE_LOCKS_REQUIRED(cs_mapFulfilledRequests);
+
 public:
-    SERIALIZE_METHODS(NetFulfilledRequestStore, obj)
+    template<typename Stream>
+    void Serialize(Stream& s) const
+    {
+        LOCK(cs_mapFulfilledRequests);
+        s << mapFulfilledRequests;
+    }
+
+    template<typename Stream>
+    void Unserialize(Stream& s)
+    {
+        LOCK(cs_mapFulfilledRequests);
+        s >> mapFulfilledRequests;
+        mapExpiryBuckets.clear();
+        for (const auto& [addr, entry] : mapFulfilledRequests) {
+            for (const auto& [strRequest, nExpiry] : entry) {
+                AddToExpiryBucket(addr, nExpiry);
+            }
+        }
+    }
+
+    // SYSCOIN records of the cache, one per address
+    template<typename Writer>
+    void SerializeRecords(Writer& w) const
+    {
+        LOCK(cs_mapFulfilledRequests);
+        for (const auto& [addr, entry] : mapFulfilledRequests) {
+            w.Write(addr, entry);
+        }
+    }
+
+    template<typename Stream>
+    bool UnserializeRecord(Stream& s)
     {
-        LOCK(obj.cs_mapFulfilledRequests);
-        READWRITE(obj.mapFulfilledRequests);
+        LOCK(cs_mapFulfilledRequests);
+        CService addr;
+        fulfilledreqmapentry_t entry;
+        s >> addr >> entry;
+        for (const auto& [strRequest, nExpiry] : entry) {
+            AddToExpiryBucket(addr, nExpiry);
+        }
+        mapFulfilledRequests[addr] = std::move(entry);
+        return true;
     }
 
     void Clear();
@@ -0,0 +1,99 @@
+// Copyright (c) 2024 The Syscoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef SYSCOIN_NEVM_KECCAKF_H
+#define SYSCOIN_NEVM_KECCAKF_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace dev
+{
+namespace keccak
+{
+
+/** Rate in bytes of Keccak-256 as used by the NEVM (capacity 512 bits) */
+static constexpr size_t KECCAK256_RATE{136};
+
+static constexpr uint64_t KECCAK_RC[24] = {
+    0x0000000000000001, 0x0000000000008082, 0x800000000000808a, 0x8000000080008000,
+    0x000000000000808b, 0x0000000080000001, 0x8000000080008081, 0x8000000000008009,
+    0x000000000000008a, 0x0000000000000088, 0x0000000080008009, 0x000000008000000a,
+    0x000000008000808b, 0x800000000000008b, 0x8000000000008089, 0x8000000000008003,
+    0x8000000000008002, 0x8000000000000080, 0x000000000000800a, 0x800000008000000a,
+    0x8000000080008081, 0x8000000000008080, 0x0000000080000001, 0x8000000080008008
+};
+
+/**
+ * Keccak-f[1600] written once over an abstract lane type so the scalar and the
+ * interleaved SIMD backends share the same round code. Ops must provide
+ * Xor(a, b), AndNot(a, b) = ~a & b, Rotl<n>(a) and Const(rc).
+ */
+template <typename Lane, typename Ops>
+inline void KeccakF1600(Lane (&st)[25])
+{
+    for (int round = 0; round < 24; ++round) {
+        Lane bc0, bc1, bc2, bc3, bc4, t;
+
+        // Theta
+        bc0 = Ops::Xor(Ops::Xor(Ops::Xor(st[0], st[5]), Ops::Xor(st[10], st[15])), st[20]);
+        bc1 = Ops::Xor(Ops::Xor(Ops::Xor(st[1], st[6]), Ops::Xor(st[11], st[16])), st[21]);
+        bc2 = Ops::Xor(Ops::Xor(Ops::Xor(st[2], st[7]), Ops::Xor(st[12], st[17])), st[22]);
+        bc3 = Ops::Xor(Ops::Xor(Ops::Xor(st[3], st[8]), Ops::Xor(st[13], st[18])), st[23]);
+        bc4 = Ops::Xor(Ops::Xor(Ops::Xor(st[4], st[9]), Ops::Xor(st[14], st[19])), st[24]);
+        t = Ops::Xor(bc4, Ops::template Rotl<1>(bc1));
+        st[0] = Ops::Xor(st[0], t); st[5] = Ops::Xor(st[5], t); st[10] = Ops::Xor(st[10], t); st[15] = Ops::Xor(st[15], t); st[20] = Ops::Xor(st[20], t);
+        t = Ops::Xor(bc0, Ops::template Rotl<1>(bc2));
+        st[1] = Ops::Xor(st[1], t); st[6] = Ops::Xor(st[6], t); st[11] = Ops::Xor(st[11], t); st[16] = Ops::Xor(st[16], t); st[21] = Ops::Xor(st[21], t);
+        t = Ops::Xor(bc1, Ops::template Rotl<1>(bc3));
+        st[2] = Ops::Xor(st[2], t); st[7] = Ops::Xor(st[7], t); st[12] = Ops::Xor(st[12], t); st[17] = Ops::Xor(st[17], t); st[22] = Ops::Xor(st[22], t);
+        t = Ops::Xor(bc2, Ops::template Rotl<1>(bc4));
+        st[3] = Ops::Xor(st[3], t); st[8] = Ops::Xor(st[8], t); st[13] = Ops::Xor(st[13], t); st[18] = Ops::Xor(st[18], t); st[23] = Ops::Xor(st[23], t);
+        t = Ops::Xor(bc3, Ops::template Rotl<1>(bc0));
+        st[4] = Ops::Xor(st[4], t); st[9] = Ops::Xor(st[9], t); st[14] = Ops::Xor(st[14], t); st[19] = Ops::Xor(st[19], t); st[24] = Ops::Xor(st[24], t);
+
+        // Rho Pi
+        t = st[1];
+        bc0 = st[10]; st[10] = Ops::template Rotl<1>(t); t = bc0;
+        bc0 = st[7]; st[7] = Ops::template Rotl<3>(t); t = bc0;
+        bc0 = st[11]; st[11] = Ops::template Rotl<6>(t); t = bc0;
+        bc0 = st[17]; st[17] = Ops::template Rotl<10>(t); t = bc0;
+        bc0 = st[18]; st[18] = Ops::template Rotl<15>(t); t = bc0;
+        bc0 = st[3]; st[3] = Ops::template Rotl<21>(t); t = bc0;
+        bc0 = st[5]; st[5] = Ops::template Rotl<28>(t); t = bc0;
+        bc0 = st[16]; st[16] = Ops::template Rotl<36>(t); t = bc0;
+        bc0 = st[8]; st[8] = Ops::template Rotl<45>(t); t = bc0;
+        bc0 = st[21]; st[21] = Ops::template Rotl<55>(t); t = bc0;
+        bc0 = st[24]; st[24] = Ops::template Rotl<2>(t); t = bc0;
+        bc0 = st[4]; st[4] = Ops::template Rotl<14>(t); t = bc0;
+        bc0 = st[15]; st[15] = Ops::template Rotl<27>(t); t = bc0;
+        bc0 = st[23]; st[23] = Ops::template Rotl<41>(t); t = bc0;
+        bc0 = st[19]; st[19] = Ops::template Rotl<56>(t); t = bc0;
+        bc0 = st[13]; st[13] = Ops::template Rotl<8>(t); t = bc0;
+        bc0 = st[12]; st[12] = Ops::template Rotl<25>(t); t = bc0;
+        bc0 = st[2]; st[2] = Ops::template Rotl<43>(t); t = bc0;
+        bc0 = st[20]; st[20] = Ops::template Rotl<62>(t); t = bc0;
+        bc0 = st[14]; st[14] = Ops::template Rotl<18>(t); t = bc0;
+        bc0 = st[22]; st[22] = Ops::template Rotl<39>(t); t = bc0;
+        bc0 = st[9]; st[9] = Ops::template Rotl<61>(t); t = bc0;
+        bc0 = st[6]; st[6] = Ops::template Rotl<20>(t); t = bc0;
+        st[1] = Ops::template Rotl<44>(t);
+
+        // Chi Iota
+        for (int y = 0; y < 25; y += 5) {
+            bc0 = st[y + 0]; bc1 = st[y + 1]; bc2 = st[y + 2]; bc3 = st[y + 3]; bc4 = st[y + 4];
+            st[y + 0] = Ops::Xor(bc0, Ops::AndNot(bc1, bc2));
+            st[y + 1] = Ops::Xor(bc1, Ops::AndNot(bc2, bc3));
+            st[y + 2] = Ops::Xor(bc2, Ops::AndNot(bc3, bc4));
+            st[y + 3] = Ops::Xor(bc3, Ops::AndNot(bc4, bc0));
+            st[y + 4] = Ops::Xor(bc4, Ops::AndNot(bc0, bc1));
+        }
+        st[0] = Ops::Xor(st[0], Ops::Const(KECCAK_RC[round]));
+    }
+}
+
+} // namespace keccak
+} // namespace dev
+
+#endif // SYSCOIN_NEVM_KECCAKF_H
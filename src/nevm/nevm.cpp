@@ -3,88 +3,81 @@
 // file COPYING or http://www.opensource.org/licenses/mit-license.php.
 #include <nevm/nevm.h>
 #include <nevm/sha3.h>
-#include <util/strencodings.h>
-int nibblesToTraverse(const std::string &encodedPartialPath, const std::string &path, int pathPtr) {
-  std::string partialPath;
-  // typecast as the character
-  uint8_t partialPathInt; 
-  char pathPtrInt[2] = {encodedPartialPath[0], '\0'};
-  if(!ParseUInt8(pathPtrInt, &partialPathInt))
+#include <cstring>
+namespace {
+/** Nibble i of a byte path, high nibble first */
+inline uint8_t PathNibble(dev::bytesConstRef path, size_t i) {
+  const uint8_t b = path[i / 2];
+  return (i % 2) ? (b & 0x0f) : (b >> 4);
+}
+inline bool RefEqual(dev::bytesConstRef a, dev::bytesConstRef b) {
+  return a.size() == b.size() && (a.empty() || memcmp(a.data(), b.data(), a.size()) == 0);
+}
+/** Number of path nibbles consumed by the hex prefix encoded partial path, -1 if it does not match */
+int nibblesToTraverse(dev::bytesConstRef encodedPartialPath, dev::bytesConstRef path, size_t pathPtr) {
+  if (encodedPartialPath.empty()) {
+    return -1;
+  }
+  const uint8_t flag = encodedPartialPath[0] >> 4;
+  if (flag > 9) {
     return -1;
-  if(partialPathInt == 0 || partialPathInt == 2){
-    partialPath = encodedPartialPath.substr(2);
-  }else{
-    partialPath = encodedPartialPath.substr(1);
   }
-  if(partialPath == path.substr(pathPtr, partialPath.size())){
-    return partialPath.size();
-  }else{
+  // even length paths are padded with a zero nibble after the flag
+  const size_t start = (flag == 0 || flag == 2) ? 2 : 1;
+  const size_t count = encodedPartialPath.size() * 2 - start;
+  const size_t pathNibbles = path.size() * 2;
+  if (pathPtr + count > pathNibbles) {
     return -1;
   }
+  for (size_t i = 0; i < count; i++) {
+    if (PathNibble(encodedPartialPath, start + i) != PathNibble(path, pathPtr + i)) {
+      return -1;
+    }
+  }
+  return count;
 }
-bool VerifyProof(dev::bytesConstRef path, const dev::RLP& value, const dev::RLP& parentNodes, const dev::RLP& root) {
-  
-  dev::RLP currentNode;
-  const int len = parentNodes.itemCount();
-  dev::RLP nodeKey = root;       
-  int pathPtr = 0;
-
-  const std::string pathString = dev::toHex(path);
-  int nibbles;
-  char pathPtrInt[2];
-  uint8_t pathInt;
-  for (int i = 0 ; i < len ; i++) {
-    currentNode = parentNodes[i];
-    if(!nodeKey.payload().contentsEqual(sha3(currentNode.data()).ref().toVector())){
-      return false;
-    } 
-
-    if(pathPtr > (int)pathString.size()){
+} // namespace
+bool VerifyProof(dev::bytesConstRef path, dev::bytesConstRef value, const dev::RLP& parentNodes, dev::bytesConstRef root) {
+  dev::bytesConstRef nodeKey = root;
+  size_t pathPtr = 0;
+  const size_t pathNibbles = path.size() * 2;
+  for (const auto& currentNode : parentNodes) {
+    const dev::h256 nodeHash = dev::sha3(currentNode.data());
+    if (!RefEqual(nodeKey, nodeHash.ref())) {
       return false;
     }
     switch(currentNode.itemCount()){
       case 17://branch node
-        if(pathPtr == (int)pathString.size()){
-          if(currentNode[16].payload().contentsEqual(value.data().toVector())){
-            return true;
-          }else{
-            return false;
-          }
-        }
-        pathPtrInt[0] = pathString[pathPtr];
-        pathPtrInt[1] = '\0';
-        if(!ParseUInt8FromHex(pathPtrInt, &pathInt)) {
-          return false;
+        if(pathPtr == pathNibbles){
+          return RefEqual(currentNode[16].payload(), value);
         }
-        nodeKey = currentNode[pathInt]; //must == sha3(rlp.encode(currentNode[path[pathptr]]))
+        nodeKey = currentNode[PathNibble(path, pathPtr)].payload(); //must == sha3(rlp.encode(currentNode[path[pathptr]]))
         pathPtr += 1;
         break;
-      case 2:
-        nibbles = nibblesToTraverse(toHex(currentNode[0].payload()), pathString, pathPtr);
+      case 2: {
+        const int nibbles = nibblesToTraverse(currentNode[0].payload(), path, pathPtr);
         if(nibbles <= -1) {
           return false;
         }
         pathPtr += nibbles;
-        if(pathPtr == (int)pathString.size()) { //leaf node
-          dev::bytes nodeVec(currentNode[1].toBytes());
+        if(pathPtr == pathNibbles) { //leaf node
+          dev::bytesConstRef nodeVal = currentNode[1].toBytesConstRef();
           // https://eips.ethereum.org/EIPS/eip-2718 first byte less than 0x7f is the transaction type and not part of RLP
-          if(nodeVec[0] < 0x7f) {
-            nodeVec = dev::bytes(nodeVec.begin()+1, nodeVec.end());
-          }
-          if(nodeVec == value.data().toBytes()){
-            return true;
-          } else {
-            return false;
+          if(!nodeVal.empty() && nodeVal[0] < 0x7f) {
+            nodeVal = nodeVal.cropped(1);
           }
+          return RefEqual(nodeVal, value);
         } else {//extension node
-          nodeKey = currentNode[1];
+          nodeKey = currentNode[1].payload();
         }
         break;
+      }
       default:
         return false;
     }
   }
-  
   return false;
 }
-
+bool VerifyProof(dev::bytesConstRef path, const dev::RLP& value, const dev::RLP& parentNodes, const dev::RLP& root) {
+  return VerifyProof(path, value.data(), parentNodes, root.payload());
+}
@@ -6,5 +6,7 @@
 #define SYSCOIN_NEVM_NEVM_H
 #include <nevm/commondata.h>
 #include <nevm/rlp.h>
-bool VerifyProof(dev::bytesConstRef path, const dev::RLP& value, const dev::RLP& parentNodes, const dev::RLP& root); 
+/** Verify a Merkle Patricia proof that path maps to value (its full RLP encoding). Walks parentNodes in place without copying them */
+bool VerifyProof(dev::bytesConstRef path, dev::bytesConstRef value, const dev::RLP& parentNodes, dev::bytesConstRef root);
+bool VerifyProof(dev::bytesConstRef path, const dev::RLP& value, const dev::RLP& parentNodes, const dev::RLP& root);
 #endif // SYSCOIN_NEVM_NEVM_H
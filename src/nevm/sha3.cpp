@@ -19,7 +19,14 @@
  * @date 2014
  */
 
+#if defined(HAVE_CONFIG_H)
+#include <config/syscoin-config.h>
+#endif
+
 #include <nevm/sha3.h>
+#include <nevm/keccakf.h>
+#include <compat/cpuid.h>
+#include <cassert>
 #include <cstdint>
 #include <cstdio>
 #include <cstdlib>
@@ -61,67 +68,19 @@ decsha3(512)
 
 /******** The Keccak-f[1600] permutation ********/
 
-/*** Constants. ***/
-static const uint8_t rho[24] = \
-  { 1,  3,   6, 10, 15, 21,
-	28, 36, 45, 55,  2, 14,
-	27, 41, 56,  8, 25, 43,
-	62, 18, 39, 61, 20, 44};
-static const uint8_t pi[24] = \
-  {10,  7, 11, 17, 18, 3,
-	5, 16,  8, 21, 24, 4,
-   15, 23, 19, 13, 12, 2,
-   20, 14, 22,  9, 6,  1};
-static const uint64_t RC[24] = \
-  {1ULL, 0x8082ULL, 0x800000000000808aULL, 0x8000000080008000ULL,
-   0x808bULL, 0x80000001ULL, 0x8000000080008081ULL, 0x8000000000008009ULL,
-   0x8aULL, 0x88ULL, 0x80008009ULL, 0x8000000aULL,
-   0x8000808bULL, 0x800000000000008bULL, 0x8000000000008089ULL, 0x8000000000008003ULL,
-   0x8000000000008002ULL, 0x8000000000000080ULL, 0x800aULL, 0x800000008000000aULL,
-   0x8000000080008081ULL, 0x8000000000008080ULL, 0x80000001ULL, 0x8000000080008008ULL};
-
-/*** Helper macros to unroll the permutation. ***/
-#define rol(x, s) (((x) << s) | ((x) >> (64 - s)))
-#define REPEAT6(e) e e e e e e
-#define REPEAT24(e) REPEAT6(e e e e)
-#define REPEAT5(e) e e e e e
-#define FOR5(v, s, e) \
-  v = 0;            \
-  REPEAT5(e; v += s;)
-
 /*** Keccak-f[1600] ***/
+struct Ops1 {
+  static inline uint64_t Xor(uint64_t a, uint64_t b) { return a ^ b; }
+  static inline uint64_t AndNot(uint64_t a, uint64_t b) { return ~a & b; }
+  template <int n>
+  static inline uint64_t Rotl(uint64_t a) { return (a << n) | (a >> (64 - n)); }
+  static inline uint64_t Const(uint64_t c) { return c; }
+};
+static inline void keccakf(uint64_t (&st)[25]) {
+  KeccakF1600<uint64_t, Ops1>(st);
+}
 static inline void keccakf(void* state) {
-  uint64_t* a = (uint64_t*)state;
-  uint64_t b[5] = {0};
-  uint64_t t = 0;
-  uint8_t x, y;
-
-  for (int i = 0; i < 24; i++) {
-	// Theta
-	FOR5(x, 1,
-		 b[x] = 0;
-		 FOR5(y, 5,
-			  b[x] ^= a[x + y]; ))
-	FOR5(x, 1,
-		 FOR5(y, 5,
-			  a[y + x] ^= b[(x + 4) % 5] ^ rol(b[(x + 1) % 5], 1); ))
-	// Rho and pi
-	t = a[1];
-	x = 0;
-	REPEAT24(b[0] = a[pi[x]];
-			 a[pi[x]] = rol(t, rho[x]);
-			 t = b[0];
-			 x++; )
-	// Chi
-	FOR5(y,
-	   5,
-	   FOR5(x, 1,
-			b[x] = a[y + x];)
-	   FOR5(x, 1,
-			a[y + x] = b[x] ^ ((~b[(x + 1) % 5]) & b[(x + 2) % 5]); ))
-	// Iota
-	a[0] ^= RC[i];
-  }
+  keccakf(*reinterpret_cast<uint64_t(*)[25]>(state));
 }
 
 /******** The FIPS202-defined functions. ********/
@@ -144,7 +103,20 @@ static inline void keccakf(void* state) {
 	FOR(i, 1, len, S);                                               \
   }
 
-mkapply_ds(xorin, dst[i] ^= src[i])  // xorin
+// xor whole lanes, byte order does not matter for xor
+static inline void xorin(uint8_t* dst, const uint8_t* src, size_t len) {
+  size_t i = 0;
+  for (; i + 8 <= len; i += 8) {
+	uint64_t d, t;
+	memcpy(&d, dst + i, 8);
+	memcpy(&t, src + i, 8);
+	d ^= t;
+	memcpy(dst + i, &d, 8);
+  }
+  for (; i < len; ++i) {
+	dst[i] ^= src[i];
+  }
+}
 mkapply_sd(setout, dst[i] = src[i])  // setout
 
 #define P keccakf
@@ -208,6 +180,133 @@ defsha3(256)
 defsha3(384)
 defsha3(512)
 
+/*** Keccak-256 on a lane state, shared by the single and multi buffer paths ***/
+static inline void absorb256(uint64_t (&st)[25], const uint8_t* in) {
+  for (size_t i = 0; i < KECCAK256_RATE / 8; ++i) {
+	uint64_t t;
+	memcpy(&t, in + 8 * i, 8);
+	st[i] ^= t;
+  }
+}
+static void finish256(uint64_t (&st)[25], const uint8_t* in, size_t inlen, uint8_t* out) {
+  while (inlen >= KECCAK256_RATE) {
+	absorb256(st, in);
+	keccakf(st);
+	in += KECCAK256_RATE;
+	inlen -= KECCAK256_RATE;
+  }
+  uint8_t last[KECCAK256_RATE] = {0};
+  if (inlen > 0) {
+	memcpy(last, in, inlen);
+  }
+  last[inlen] ^= 0x01;
+  last[KECCAK256_RATE - 1] ^= 0x80;
+  absorb256(st, last);
+  keccakf(st);
+  memcpy(out, st, 32);
+}
+
+}
+
+#if defined(ENABLE_AVX2) && !defined(BUILD_SYSCOIN_INTERNAL)
+namespace keccak_avx2
+{
+void Absorb_4way(uint64_t (&st)[4][25], const uint8_t* const (&in)[4], size_t nBlocks);
+}
+#endif
+
+namespace
+{
+typedef void (*Absorb4Type)(uint64_t (&)[4][25], const uint8_t* const (&)[4], size_t);
+Absorb4Type Absorb_4way = nullptr;
+
+#if defined(USE_ASM) && defined(HAVE_GETCPUID)
+bool AVXEnabled()
+{
+	uint32_t a, d;
+	__asm__("xgetbv" : "=a"(a), "=d"(d) : "c"(0));
+	return (a & 6) == 6;
+}
+#endif
+
+bool SelfTest()
+{
+	// inputs straddling the rate so the interleaved and scalar tails are both exercised
+	static const size_t lens[5] = {0, 135, 136, 1000, 4097};
+	std::vector<bytes> inputs;
+	std::vector<bytesConstRef> refs;
+	for (size_t len : lens) {
+		bytes b(len);
+		for (size_t i = 0; i < len; ++i) {
+			b[i] = (uint8_t)(i * 7 + len);
+		}
+		inputs.emplace_back(std::move(b));
+	}
+	for (const auto& b : inputs) {
+		refs.emplace_back(&b);
+	}
+	std::vector<h256> out(refs.size());
+	sha3Batch(refs.data(), out.data(), refs.size());
+	for (size_t i = 0; i < refs.size(); ++i) {
+		if (out[i] != sha3(refs[i])) {
+			return false;
+		}
+	}
+	return EmptySHA3 == h256("c5d2460186f7233c927e7db2dcc703c0e500b653ca82273b7bfad8045d85a470");
+}
+} // namespace
+
+std::string KeccakAutoDetect(bool use_avx2)
+{
+	std::string ret = "standard";
+	Absorb_4way = nullptr;
+#if defined(USE_ASM) && defined(HAVE_GETCPUID) && defined(ENABLE_AVX2) && !defined(BUILD_SYSCOIN_INTERNAL)
+	uint32_t eax, ebx, ecx, edx;
+	GetCPUID(1, 0, eax, ebx, ecx, edx);
+	const bool have_avx = (ecx >> 28) & 1;
+	const bool enabled_avx = have_avx && ((ecx >> 27) & 1) && AVXEnabled();
+	GetCPUID(7, 0, eax, ebx, ecx, edx);
+	const bool have_avx2 = (ebx >> 5) & 1;
+	if (use_avx2 && have_avx2 && enabled_avx) {
+		Absorb_4way = keccak_avx2::Absorb_4way;
+		ret += ",avx2(4way)";
+	}
+#endif
+	assert(SelfTest());
+	return ret;
+}
+
+size_t sha3BatchWidth()
+{
+	return Absorb_4way ? 4 : 1;
+}
+
+void sha3Batch(const bytesConstRef* _inputs, h256* o_outputs, size_t _count)
+{
+	size_t i = 0;
+	if (Absorb_4way) {
+		for (; i + 1 < _count; i += 4) {
+			const size_t n = std::min<size_t>(4, _count - i);
+			uint64_t st[4][25] = {};
+			const uint8_t* in[4];
+			size_t nBlocks = SIZE_MAX;
+			for (size_t j = 0; j < 4; ++j) {
+				// unused lanes repeat the first input and are discarded
+				const bytesConstRef& input = _inputs[i + (j < n ? j : 0)];
+				in[j] = input.data();
+				nBlocks = std::min(nBlocks, input.size() / keccak::KECCAK256_RATE);
+			}
+			Absorb_4way(st, in, nBlocks);
+			const size_t nAbsorbed = nBlocks * keccak::KECCAK256_RATE;
+			for (size_t j = 0; j < n; ++j) {
+				const bytesConstRef& input = _inputs[i + j];
+				keccak::finish256(st[j], input.data() + nAbsorbed, input.size() - nAbsorbed, o_outputs[i + j].data());
+			}
+		}
+	}
+	for (; i < _count; ++i) {
+		sha3(_inputs[i], o_outputs[i].ref());
+	}
 }
 
 bool sha3(bytesConstRef _input, bytesRef o_output)
@@ -215,8 +314,8 @@ bool sha3(bytesConstRef _input, bytesRef o_output)
 	// FIXME: What with unaligned memory?
 	if (o_output.size() != 32)
 		return false;
-	keccak::sha3_256(o_output.data(), 32, _input.data(), _input.size());
-//	keccak::keccak(ret.data(), 32, (uint64_t const*)_input.data(), _input.size());
+	uint64_t st[25] = {0};
+	keccak::finish256(st, _input.data(), _input.size(), o_output.data());
 	return true;
 }
 
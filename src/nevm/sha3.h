@@ -65,6 +65,17 @@ inline std::string sha3(std::string const& _input, bool _isNibbles) { return asS
 /// Calculate SHA3-256 MAC
 inline void sha3mac(bytesConstRef _secret, bytesConstRef _plain, bytesRef _output) { sha3(_secret.toBytes() + _plain.toBytes()).ref().populate(_output); }
 
+/// Calculate SHA3-256 hashes of _count inputs. Inputs are interleaved sha3BatchWidth() at a time
+/// when a SIMD backend is selected, otherwise this is equivalent to hashing them one by one.
+void sha3Batch(bytesConstRef const* _inputs, h256* o_outputs, size_t _count);
+
+/// Number of inputs sha3Batch hashes at once with the selected backend.
+size_t sha3BatchWidth();
+
+/// Select the fastest available Keccak backend for this CPU and self test it.
+/// @returns a description of the selected backend.
+std::string KeccakAutoDetect(bool use_avx2 = true);
+
 extern h256 EmptySHA3;
 
 extern h256 EmptyListSHA3;
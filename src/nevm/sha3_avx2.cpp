@@ -0,0 +1,63 @@
+// Copyright (c) 2024 The Syscoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifdef ENABLE_AVX2
+
+#include <nevm/keccakf.h>
+
+#include <cstring>
+#include <immintrin.h>
+
+namespace dev {
+namespace keccak_avx2 {
+namespace {
+
+/** One 64 bit lane of four independent Keccak states */
+struct Ops4 {
+    static inline __m256i Xor(__m256i a, __m256i b) { return _mm256_xor_si256(a, b); }
+    static inline __m256i AndNot(__m256i a, __m256i b) { return _mm256_andnot_si256(a, b); }
+    template <int n>
+    static inline __m256i Rotl(__m256i a) { return _mm256_or_si256(_mm256_slli_epi64(a, n), _mm256_srli_epi64(a, 64 - n)); }
+    static inline __m256i Const(uint64_t c) { return _mm256_set1_epi64x(static_cast<long long>(c)); }
+};
+
+inline uint64_t ReadLane(const uint8_t* p)
+{
+    uint64_t x;
+    memcpy(&x, p, sizeof(x));
+    return x;
+}
+
+} // namespace
+
+void Absorb_4way(uint64_t (&st)[4][25], const uint8_t* const (&in)[4], size_t nBlocks)
+{
+    __m256i s[25];
+    for (int i = 0; i < 25; ++i) {
+        s[i] = _mm256_set_epi64x(st[3][i], st[2][i], st[1][i], st[0][i]);
+    }
+    const uint8_t* p[4] = {in[0], in[1], in[2], in[3]};
+    for (size_t block = 0; block < nBlocks; ++block) {
+        for (size_t i = 0; i < keccak::KECCAK256_RATE / 8; ++i) {
+            s[i] = _mm256_xor_si256(s[i], _mm256_set_epi64x(ReadLane(p[3] + 8 * i), ReadLane(p[2] + 8 * i), ReadLane(p[1] + 8 * i), ReadLane(p[0] + 8 * i)));
+        }
+        keccak::KeccakF1600<__m256i, Ops4>(s);
+        for (auto& ptr : p) {
+            ptr += keccak::KECCAK256_RATE;
+        }
+    }
+    alignas(32) uint64_t lanes[4];
+    for (int i = 0; i < 25; ++i) {
+        _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), s[i]);
+        st[0][i] = lanes[0];
+        st[1][i] = lanes[1];
+        st[2][i] = lanes[2];
+        st[3][i] = lanes[3];
+    }
+}
+
+} // namespace keccak_avx2
+} // namespace dev
+
+#endif
@@ -32,6 +32,8 @@ util::Result<void> ApplyArgsManOptions(const ArgsManager& args, BlockManager::Op
     opts.prune_target = nPruneTarget;
 
     if (auto value{args.GetBoolArg("-fastprune")}) opts.fast_prune = *value;
+    // SYSCOIN
+    if (auto value{args.GetBoolArg("-blockmmap")}) opts.mmap_block_files = *value;
 
     return {};
 }
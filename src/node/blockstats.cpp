@@ -0,0 +1,209 @@
+// Copyright (c) 2024 The Syscoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <node/blockstats.h>
+
+#include <chain.h>
+#include <coins.h>
+#include <consensus/validation.h>
+#include <primitives/block.h>
+#include <services/nevmconsensus.h>
+#include <undo.h>
+#include <util/check.h>
+#include <validation.h>
+#include <version.h>
+
+#include <algorithm>
+
+namespace node {
+// outpoint (needed for the utxo index) + nHeight + fCoinBase
+static constexpr size_t PER_UTXO_OVERHEAD = sizeof(COutPoint) + sizeof(uint32_t) + sizeof(bool);
+
+template<typename T>
+static T CalculateTruncatedMedian(std::vector<T>& scores)
+{
+    size_t size = scores.size();
+    if (size == 0) {
+        return 0;
+    }
+
+    std::sort(scores.begin(), scores.end());
+    if (size % 2 == 0) {
+        return (scores[size / 2 - 1] + scores[size / 2]) / 2;
+    } else {
+        return scores[size / 2];
+    }
+}
+
+void CalculatePercentilesByWeight(CAmount result[NUM_GETBLOCKSTATS_PERCENTILES], std::vector<std::pair<CAmount, int64_t>>& scores, int64_t total_weight)
+{
+    if (scores.empty()) {
+        return;
+    }
+
+    std::sort(scores.begin(), scores.end());
+
+    // 10th, 25th, 50th, 75th, and 90th percentile weight units.
+    const double weights[NUM_GETBLOCKSTATS_PERCENTILES] = {
+        total_weight / 10.0, total_weight / 4.0, total_weight / 2.0, (total_weight * 3.0) / 4.0, (total_weight * 9.0) / 10.0
+    };
+
+    int64_t next_percentile_index = 0;
+    int64_t cumulative_weight = 0;
+    for (const auto& element : scores) {
+        cumulative_weight += element.second;
+        while (next_percentile_index < NUM_GETBLOCKSTATS_PERCENTILES && cumulative_weight >= weights[next_percentile_index]) {
+            result[next_percentile_index] = element.first;
+            ++next_percentile_index;
+        }
+    }
+
+    // Fill any remaining percentiles with the last value.
+    for (int64_t i = next_percentile_index; i < NUM_GETBLOCKSTATS_PERCENTILES; i++) {
+        result[i] = scores.back().first;
+    }
+}
+
+// SYSCOIN
+/** Add the asset, burn, PoDA and masternode transaction counts of a non-coinbase transaction */
+static void AddSyscoinTxStats(BlockStats& stats, const CTransaction& tx, const CTxUndo& tx_undo)
+{
+    if (IsMasternodeTx(tx.nVersion)) {
+        ++stats.mn_txs;
+        return;
+    }
+    if (tx.IsNEVMData()) {
+        const CNEVMData nevmData(tx);
+        if (nevmData.IsNull()) return;
+        ++stats.nevm_blobs;
+        MapPoDAPayloadMeta meta;
+        if (pnevmdatadb && pnevmdatadb->GetBlobMetaData(nevmData.vchVersionHash, meta)) {
+            stats.nevm_blob_size += meta.nSize;
+        }
+        return;
+    }
+    if (!IsSyscoinTx(tx.nVersion)) return;
+    ++stats.asset_txs;
+    CAmount nAssetIn{0};
+    for (const Coin& coin : tx_undo.vprevout) {
+        if (!coin.out.assetInfo.IsNull()) nAssetIn += coin.out.assetInfo.nValue;
+    }
+    CAmount nAssetOut{0};
+    for (const CTxOut& out : tx.vout) {
+        if (out.assetInfo.IsNull()) continue;
+        ++stats.asset_outs;
+        nAssetOut += out.assetInfo.nValue;
+    }
+    const int nOut{GetSyscoinDataOutput(tx)};
+    switch (tx.nVersion) {
+        case SYSCOIN_TX_VERSION_ALLOCATION_MINT:
+            // an input of the minted asset comes back as change
+            ++stats.mint_txs;
+            stats.mint_volume += nAssetOut - nAssetIn;
+            break;
+        case SYSCOIN_TX_VERSION_ALLOCATION_BURN_TO_NEVM:
+        case SYSCOIN_TX_VERSION_ALLOCATION_BURN_TO_SYSCOIN:
+            ++stats.asset_burn_txs;
+            if (nOut >= 0) stats.asset_burn_volume += tx.vout[nOut].assetInfo.nValue;
+            break;
+        case SYSCOIN_TX_VERSION_SYSCOIN_BURN_TO_ALLOCATION:
+            ++stats.sys_burn_txs;
+            if (nOut >= 0) stats.sys_burn_volume += tx.vout[nOut].nValue;
+            break;
+    }
+}
+
+BlockStats ComputeBlockStats(const CBlock& block, const CBlockUndo& block_undo, const CBlockIndex& block_index)
+{
+    BlockStats stats;
+    stats.txs = block.vtx.size();
+
+    CAmount minfee = MAX_MONEY;
+    CAmount minfeerate = MAX_MONEY;
+    int64_t mintxsize = MAX_BLOCK_SERIALIZED_SIZE;
+    std::vector<CAmount> fee_array;
+    std::vector<std::pair<CAmount, int64_t>> feerate_array;
+    std::vector<int64_t> txsize_array;
+
+    for (size_t i = 0; i < block.vtx.size(); ++i) {
+        const auto& tx = block.vtx.at(i);
+        stats.outs += tx->vout.size();
+
+        // SYSCOIN the SYS minted by a burn to SYS is left out
+        const CAmount tx_total_out = tx->GetValueOut();
+        for (const CTxOut& out : tx->vout) {
+            // SYSCOIN
+            size_t out_size = GetSerializeSize(out, PROTOCOL_VERSION, SER_SIZE, tx->nVersion) + PER_UTXO_OVERHEAD;
+            stats.utxo_size_inc += out_size;
+
+            // The Genesis block and the repeated BIP30 block coinbases don't change the UTXO
+            // set counts, so they have to be excluded from the statistics
+            if (block_index.nHeight == 0 || (IsBIP30Repeat(block_index) && tx->IsCoinBase())) continue;
+            // Skip unspendable outputs since they are not included in the UTXO set
+            if (out.scriptPubKey.IsUnspendable()) continue;
+
+            ++stats.utxos;
+            stats.utxo_size_inc_actual += out_size;
+        }
+
+        if (tx->IsCoinBase()) {
+            // SYSCOIN quorum commitments are carried by the coinbase
+            if (tx->nVersion == SYSCOIN_TX_VERSION_MN_QUORUM_COMMITMENT) ++stats.quorum_commitments;
+            continue;
+        }
+
+        stats.ins += tx->vin.size(); // Don't count coinbase's fake input
+        stats.total_out += tx_total_out; // Don't count coinbase reward
+
+        const int64_t tx_size = tx->GetTotalSize();
+        txsize_array.push_back(tx_size);
+        stats.maxtxsize = std::max(stats.maxtxsize, tx_size);
+        mintxsize = std::min(mintxsize, tx_size);
+        stats.total_size += tx_size;
+
+        const int64_t weight = GetTransactionWeight(*tx);
+        stats.total_weight += weight;
+
+        if (tx->HasWitness()) {
+            ++stats.swtxs;
+            stats.swtotal_size += tx_size;
+            stats.swtotal_weight += weight;
+        }
+
+        CAmount tx_total_in = 0;
+        const auto& txundo = block_undo.vtxundo.at(i - 1);
+        for (const Coin& coin: txundo.vprevout) {
+            const CTxOut& prevoutput = coin.out;
+
+            tx_total_in += prevoutput.nValue;
+            size_t prevout_size = GetSerializeSize(prevoutput, PROTOCOL_VERSION, SER_SIZE, tx->nVersion) + PER_UTXO_OVERHEAD;
+            stats.utxo_size_inc -= prevout_size;
+            stats.utxo_size_inc_actual -= prevout_size;
+        }
+
+        CAmount txfee = tx_total_in - tx_total_out;
+        CHECK_NONFATAL(MoneyRange(txfee));
+        fee_array.push_back(txfee);
+        stats.maxfee = std::max(stats.maxfee, txfee);
+        minfee = std::min(minfee, txfee);
+        stats.totalfee += txfee;
+
+        // New feerate uses satoshis per virtual byte instead of per serialized byte
+        CAmount feerate = weight ? (txfee * WITNESS_SCALE_FACTOR) / weight : 0;
+        feerate_array.emplace_back(feerate, weight);
+        stats.maxfeerate = std::max(stats.maxfeerate, feerate);
+        minfeerate = std::min(minfeerate, feerate);
+        // SYSCOIN
+        AddSyscoinTxStats(stats, *tx, txundo);
+    }
+
+    CalculatePercentilesByWeight(stats.feerate_percentiles.data(), feerate_array, stats.total_weight);
+    stats.medianfee = CalculateTruncatedMedian(fee_array);
+    stats.mediantxsize = CalculateTruncatedMedian(txsize_array);
+    stats.minfee = (minfee == MAX_MONEY) ? 0 : minfee;
+    stats.minfeerate = (minfeerate == MAX_MONEY) ? 0 : minfeerate;
+    stats.mintxsize = mintxsize == MAX_BLOCK_SERIALIZED_SIZE ? 0 : mintxsize;
+    return stats;
+}
+} // namespace node
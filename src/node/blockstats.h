@@ -0,0 +1,94 @@
+// Copyright (c) 2024 The Syscoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef SYSCOIN_NODE_BLOCKSTATS_H
+#define SYSCOIN_NODE_BLOCKSTATS_H
+
+#include <consensus/amount.h>
+#include <serialize.h>
+
+#include <array>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+class CBlock;
+class CBlockIndex;
+class CBlockUndo;
+
+namespace node {
+static constexpr int NUM_GETBLOCKSTATS_PERCENTILES = 5;
+
+/** Used by getblockstats to get feerates at different percentiles by weight  */
+void CalculatePercentilesByWeight(CAmount result[NUM_GETBLOCKSTATS_PERCENTILES], std::vector<std::pair<CAmount, int64_t>>& scores, int64_t total_weight);
+
+/**
+ * Statistics of one block that take its transactions and undo data to compute,
+ * as reported by getblockstats and stored by the block stats index. Values that
+ * only depend on the block index (time, subsidy, ...) are not part of it.
+ */
+struct BlockStats {
+    int64_t txs{0};
+    //! inputs and outputs, the coinbase input excluded
+    int64_t ins{0};
+    int64_t outs{0};
+    //! outputs added to the utxo set, unspendables and repeated coinbases excluded
+    int64_t utxos{0};
+    int64_t utxo_size_inc{0};
+    int64_t utxo_size_inc_actual{0};
+    CAmount total_out{0};
+    CAmount totalfee{0};
+    CAmount minfee{0};
+    CAmount maxfee{0};
+    CAmount medianfee{0};
+    CAmount minfeerate{0};
+    CAmount maxfeerate{0};
+    std::array<CAmount, NUM_GETBLOCKSTATS_PERCENTILES> feerate_percentiles{};
+    int64_t total_size{0};
+    int64_t mintxsize{0};
+    int64_t maxtxsize{0};
+    int64_t mediantxsize{0};
+    int64_t total_weight{0};
+    int64_t swtxs{0};
+    int64_t swtotal_size{0};
+    int64_t swtotal_weight{0};
+    // SYSCOIN
+    //! asset allocation transactions (sends and burns) and mints
+    int64_t asset_txs{0};
+    int64_t asset_outs{0};
+    int64_t mint_txs{0};
+    CAmount mint_volume{0};
+    //! burns of asset allocations to NEVM or to SYS
+    int64_t asset_burn_txs{0};
+    CAmount asset_burn_volume{0};
+    //! burns of SYS to SYSX allocations
+    int64_t sys_burn_txs{0};
+    CAmount sys_burn_volume{0};
+    //! PoDA blobs, the size counts the blobs still stored when the stats were computed
+    int64_t nevm_blobs{0};
+    int64_t nevm_blob_size{0};
+    int64_t mn_txs{0};
+    int64_t quorum_commitments{0};
+
+    SERIALIZE_METHODS(BlockStats, obj)
+    {
+        READWRITE(obj.txs, obj.ins, obj.outs, obj.utxos);
+        READWRITE(obj.utxo_size_inc, obj.utxo_size_inc_actual, obj.total_out, obj.totalfee);
+        READWRITE(obj.minfee, obj.maxfee, obj.medianfee, obj.minfeerate, obj.maxfeerate);
+        for (auto& feerate : obj.feerate_percentiles) {
+            READWRITE(feerate);
+        }
+        READWRITE(obj.total_size, obj.mintxsize, obj.maxtxsize, obj.mediantxsize, obj.total_weight);
+        READWRITE(obj.swtxs, obj.swtotal_size, obj.swtotal_weight);
+        READWRITE(obj.asset_txs, obj.asset_outs, obj.mint_txs, obj.mint_volume);
+        READWRITE(obj.asset_burn_txs, obj.asset_burn_volume, obj.sys_burn_txs, obj.sys_burn_volume);
+        READWRITE(obj.nevm_blobs, obj.nevm_blob_size, obj.mn_txs, obj.quorum_commitments);
+    }
+};
+
+/** Compute the statistics of a block from its transactions and undo data */
+BlockStats ComputeBlockStats(const CBlock& block, const CBlockUndo& block_undo, const CBlockIndex& block_index);
+} // namespace node
+
+#endif // SYSCOIN_NODE_BLOCKSTATS_H
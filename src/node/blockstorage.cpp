@@ -21,6 +21,7 @@
 #include <sync.h>
 #include <undo.h>
 #include <util/batchpriority.h>
+#include <util/executor.h>
 #include <util/fs.h>
 #include <util/signalinterrupt.h>
 #include <util/strencodings.h>
@@ -33,8 +34,16 @@
 #include <primitives/block.h>
 #include <node/context.h>
 #include <masternode/activemasternode.h>
+#include <deque>
+#include <future>
 #include <map>
 #include <unordered_map>
+#ifndef WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
 namespace kernel {
 static constexpr uint8_t DB_BLOCK_FILES{'f'};
@@ -42,6 +51,8 @@ static constexpr uint8_t DB_BLOCK_INDEX{'b'};
 static constexpr uint8_t DB_FLAG{'F'};
 static constexpr uint8_t DB_REINDEX_FLAG{'R'};
 static constexpr uint8_t DB_LAST_BLOCK{'l'};
+// SYSCOIN
+static constexpr uint8_t DB_AUXPOW_HEADER{'A'};
 // Keys used in previous version that might still be found in the DB:
 // BlockTreeDB::DB_TXINDEX_BLOCK{'T'};
 // BlockTreeDB::DB_TXINDEX{'t'}
@@ -99,6 +110,38 @@ bool BlockTreeDB::ReadFlag(const std::string& name, bool& fValue)
     return true;
 }
 
+namespace {
+/** Header with its auxpow, the coinbase of the parent block needs a versioned stream */
+template <typename T>
+struct AuxpowHeaderRecord {
+    T& header;
+
+    template <typename Stream>
+    void Serialize(Stream& s) const
+    {
+        OverrideStream<Stream> os(&s, SER_DISK, CLIENT_VERSION);
+        os << header;
+    }
+    template <typename Stream>
+    void Unserialize(Stream& s)
+    {
+        OverrideStream<Stream> os(&s, SER_DISK, CLIENT_VERSION);
+        os >> header;
+    }
+};
+} // namespace
+
+bool BlockTreeDB::WriteAuxpowHeader(const CBlockHeader& header)
+{
+    return Write(std::make_pair(DB_AUXPOW_HEADER, header.GetHash()), AuxpowHeaderRecord<const CBlockHeader>{header});
+}
+
+bool BlockTreeDB::ReadAuxpowHeader(const uint256& hash, CBlockHeader& header)
+{
+    AuxpowHeaderRecord<CBlockHeader> record{header};
+    return Read(std::make_pair(DB_AUXPOW_HEADER, hash), record) && header.GetHash() == hash;
+}
+
 bool BlockTreeDB::LoadBlockIndexGuts(const Consensus::Params& consensusParams, std::function<CBlockIndex*(const uint256&)> insertBlockIndex, const util::SignalInterrupt& interrupt)
 {
     AssertLockHeld(::cs_main);
@@ -828,6 +871,8 @@ void BlockManager::UnlinkPrunedFiles(const std::set<int>& setFilesToPrune) const
         FlatFilePos pos(*it, 0);
         const bool removed_blockfile{fs::remove(BlockFileSeq().FileName(pos), ec)};
         const bool removed_undofile{fs::remove(UndoFileSeq().FileName(pos), ec)};
+        // SYSCOIN readers still holding the mapping keep the unlinked file around until they are done
+        WITH_LOCK(cs_block_mappings, m_block_mappings.erase(*it));
         if (removed_blockfile || removed_undofile) {
             LogPrint(BCLog::BLOCKSTORAGE, "Prune: %s deleted blk/rev (%05u)\n", __func__, *it);
         }
@@ -1053,18 +1098,28 @@ bool BlockManager::ReadBlockOrHeader(T& block, const FlatFilePos& pos) const
 {
     block.SetNull();
 
-    // Open history file to read
-    CAutoFile filein{OpenBlockFile(pos, true)};
-    if (filein.IsNull()) {
-        return error("ReadBlockFromDisk: OpenBlockFile failed for %s", pos.ToString());
-    }
+    // SYSCOIN deserialize straight from the mapped block file
+    RawBlock raw;
+    if (m_opts.mmap_block_files && ReadMappedBlock(raw, pos)) {
+        try {
+            SpanReader{SER_DISK, CLIENT_VERSION, raw.data} >> block;
+        } catch (const std::exception& e) {
+            return error("%s: Deserialize or I/O error - %s at %s", __func__, e.what(), pos.ToString());
+        }
+    } else {
+        // Open history file to read
+        CAutoFile filein{OpenBlockFile(pos, true)};
+        if (filein.IsNull()) {
+            return error("ReadBlockFromDisk: OpenBlockFile failed for %s", pos.ToString());
+        }
 
-    // Read block
-    try {
-        filein >> block;
-    }
-    catch (const std::exception& e) {
-        return error("%s: Deserialize or I/O error - %s at %s", __func__, e.what(), pos.ToString());
+        // Read block
+        try {
+            filein >> block;
+        }
+        catch (const std::exception& e) {
+            return error("%s: Deserialize or I/O error - %s at %s", __func__, e.what(), pos.ToString());
+        }
     }
     const auto& consensus = GetConsensus();
     // Check the header
@@ -1091,22 +1146,22 @@ bool BlockManager::ReadBlockOrHeader(T& block, const CBlockIndex& pindex) const
     return true;
 }
 
-bool BlockManager::ReadBlockFromDisk(CBlock& block, const FlatFilePos& pos) const
+bool BlockManager::ReadBlockFromDisk(CBlock& block, const FlatFilePos& pos, bool fFillNEVMData) const
 {
     auto res = ReadBlockOrHeader(block, pos);
     // SYSCOIN
-    if(!FillNEVMData(block)) {
+    if(fFillNEVMData && !FillNEVMData(block)) {
         return error("ReadBlockFromDisk(): FillNEVMData() failed for %s",
         block.GetHash().GetHex());
     }
     return res;
 }
 
-bool BlockManager::ReadBlockFromDisk(CBlock& block, const CBlockIndex& index) const
+bool BlockManager::ReadBlockFromDisk(CBlock& block, const CBlockIndex& index, bool fFillNEVMData) const
 {
     auto res = ReadBlockOrHeader(block, index);
     // SYSCOIN
-    if(!FillNEVMData(block)) {
+    if(fFillNEVMData && !FillNEVMData(block)) {
         return error("ReadBlockFromDisk(): FillNEVMData() failed for %s",
         index.GetBlockHash().GetHex());
     }
@@ -1115,7 +1170,24 @@ bool BlockManager::ReadBlockFromDisk(CBlock& block, const CBlockIndex& index) co
 
 bool BlockManager::ReadBlockHeaderFromDisk(CBlockHeader& block, const CBlockIndex* pindex) const
 {
-    return ReadBlockOrHeader(block, *pindex);
+    // SYSCOIN serving headers of merge mined blocks would otherwise read (and check) one block file record each
+    const uint256 hash = pindex->GetBlockHash();
+    if (WITH_LOCK(cs_auxpow_headers, return m_auxpow_header_cache.get(hash, block))) {
+        return true;
+    }
+    if (!WITH_LOCK(::cs_main, return m_block_tree_db && m_block_tree_db->ReadAuxpowHeader(hash, block))) {
+        if (!ReadBlockOrHeader(block, *pindex)) {
+            return false;
+        }
+        // stored before the header store existed
+        if (block.IsAuxpow()) {
+            WITH_LOCK(::cs_main, if (m_block_tree_db) m_block_tree_db->WriteAuxpowHeader(block));
+        }
+    }
+    if (block.IsAuxpow()) {
+        WITH_LOCK(cs_auxpow_headers, m_auxpow_header_cache.insert(hash, block));
+    }
+    return true;
 }
 
 bool BlockManager::ReadRawBlockFromDisk(std::vector<uint8_t>& block, const FlatFilePos& pos) const
@@ -1153,6 +1225,96 @@ bool BlockManager::ReadRawBlockFromDisk(std::vector<uint8_t>& block, const FlatF
     return true;
 }
 
+bool BlockManager::ReadRawBlockFromDisk(RawBlock& block, const FlatFilePos& pos) const
+{
+    if (m_opts.mmap_block_files && ReadMappedBlock(block, pos)) {
+        return true;
+    }
+    block.mapping.reset();
+    if (!ReadRawBlockFromDisk(block.buffer, pos)) {
+        return false;
+    }
+    block.data = block.buffer;
+    return true;
+}
+
+BlockFileMapping::~BlockFileMapping()
+{
+#ifndef WIN32
+    munmap(const_cast<uint8_t*>(m_data), m_size);
+#endif
+}
+
+std::shared_ptr<const BlockFileMapping> BlockManager::MapBlockFile(int nFile, size_t nEnd) const
+{
+    LOCK(cs_block_mappings);
+    std::shared_ptr<const BlockFileMapping> mapping;
+    if (m_block_mappings.get(nFile, mapping) && mapping->Data().size() >= nEnd) {
+        return mapping;
+    }
+#ifndef WIN32
+    // the file being appended to grows, map it again to cover the new bytes. Readers of the old mapping keep it
+    const int fd = open(fs::PathToString(BlockFileSeq().FileName(FlatFilePos(nFile, 0))).c_str(), O_RDONLY);
+    if (fd == -1) {
+        return nullptr;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size < nEnd || st.st_size == 0) {
+        close(fd);
+        return nullptr;
+    }
+    void* addr = mmap(nullptr, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (addr == MAP_FAILED) {
+        return nullptr;
+    }
+    mapping = std::make_shared<const BlockFileMapping>(static_cast<const uint8_t*>(addr), (size_t)st.st_size);
+    m_block_mappings.insert(nFile, mapping);
+    return mapping;
+#else
+    return nullptr;
+#endif
+}
+
+bool BlockManager::ReadMappedBlock(RawBlock& block, const FlatFilePos& pos) const
+{
+    if (pos.IsNull() || pos.nPos < BLOCK_SERIALIZATION_HEADER_SIZE) {
+        return false;
+    }
+    auto mapping = MapBlockFile(pos.nFile, pos.nPos);
+    if (!mapping) {
+        return false;
+    }
+    // the magic and size written before the block, anything unexpected is left to the file read to report
+    MessageStartChars blk_start;
+    unsigned int blk_size;
+    SpanReader{SER_DISK, CLIENT_VERSION, mapping->Data().subspan(pos.nPos - BLOCK_SERIALIZATION_HEADER_SIZE, BLOCK_SERIALIZATION_HEADER_SIZE)} >> blk_start >> blk_size;
+    if (blk_start != GetParams().MessageStart() || blk_size > MAX_SIZE) {
+        return false;
+    }
+    const size_t end = (size_t)pos.nPos + blk_size;
+    if (mapping->Data().size() < end) {
+        mapping = MapBlockFile(pos.nFile, end);
+        if (!mapping) {
+            return false;
+        }
+    }
+#ifndef WIN32
+    // a read picking up where the last one of the file ended is part of a scan (an index sync, a rescan), the blocks
+    // that follow are asked for ahead of it
+    if (mapping->m_next_pos.exchange((uint32_t)end) == pos.nPos - BLOCK_SERIALIZATION_HEADER_SIZE && end < mapping->Data().size()) {
+        static const size_t page_size = sysconf(_SC_PAGESIZE);
+        const size_t ahead_begin = end / page_size * page_size;
+        const size_t ahead_end = std::min(end + BLOCK_FILE_READAHEAD, mapping->Data().size());
+        madvise(const_cast<uint8_t*>(mapping->Data().data()) + ahead_begin, ahead_end - ahead_begin, MADV_WILLNEED);
+    }
+#endif
+    block.data = mapping->Data().subspan(pos.nPos, blk_size);
+    block.mapping = std::move(mapping);
+    block.buffer.clear();
+    return true;
+}
+
 FlatFilePos BlockManager::SaveBlockToDisk(const CBlock& block, int nHeight, const FlatFilePos* dbp)
 {
     unsigned int nBlockSize = ::GetSerializeSize(block, CLIENT_VERSION, SER_DISK);
@@ -1176,9 +1338,74 @@ FlatFilePos BlockManager::SaveBlockToDisk(const CBlock& block, int nHeight, cons
             return FlatFilePos();
         }
     }
+    // SYSCOIN also done on reindex, which wipes the block tree db
+    if (block.IsAuxpow()) {
+        WITH_LOCK(::cs_main, if (m_block_tree_db) m_block_tree_db->WriteAuxpowHeader(block.GetBlockHeader()));
+    }
     return blockPos;
 }
 
+// SYSCOIN
+/**
+ * Read the blocks of block file nFile and do the checks that need no chain state on them, the proof of work
+ * (including the auxpow) and CheckBlock, whose result the block keeps. Blocks failing the proof of work are
+ * left out, the import reads those again and reports them the way it did before.
+ */
+static PrefetchedBlocks PrefetchBlockFile(const BlockManager& blockman, const CChainParams& params, int nFile, const util::SignalInterrupt& interrupt)
+{
+    PrefetchedBlocks blocks;
+    CAutoFile file{blockman.OpenBlockFile(FlatFilePos(nFile, 0), true)};
+    if (file.IsNull()) {
+        return blocks;
+    }
+    try {
+        BufferedFile blkdat{file, 2 * MAX_BLOCK_SERIALIZED_SIZE, MAX_BLOCK_SERIALIZED_SIZE + 8};
+        uint64_t nRewind = blkdat.GetPos();
+        while (!blkdat.eof() && !interrupt) {
+            blkdat.SetPos(nRewind);
+            nRewind++;
+            blkdat.SetLimit();
+            unsigned int nSize = 0;
+            try {
+                MessageStartChars buf;
+                blkdat.FindByte(std::byte(params.MessageStart()[0]));
+                nRewind = blkdat.GetPos() + 1;
+                blkdat >> buf;
+                if (buf != params.MessageStart()) {
+                    continue;
+                }
+                blkdat >> nSize;
+                if (nSize < 80 || nSize > MAX_BLOCK_SERIALIZED_SIZE) {
+                    continue;
+                }
+            } catch (const std::exception&) {
+                break;
+            }
+            try {
+                const uint64_t nBlockPos{blkdat.GetPos()};
+                blkdat.SetLimit(nBlockPos + nSize);
+                auto block = std::make_shared<CBlock>();
+                blkdat >> *block;
+                nRewind = nBlockPos + nSize;
+                if (!HasValidProofOfWork({*block}, params.GetConsensus())) {
+                    continue;
+                }
+                // blocks carrying PoDA blobs are checked by the import once the blobs are merged back in
+                if (std::none_of(block->vtx.begin(), block->vtx.end(), [](const CTransactionRef& tx) { return tx->IsNEVMData(); })) {
+                    BlockValidationState state;
+                    CheckBlock(*block, state, params.GetConsensus());
+                }
+                blocks.emplace(nBlockPos, std::move(block));
+            } catch (const std::exception&) {
+                // data that does not deserialize is skipped by the import as well
+            }
+        }
+    } catch (const std::runtime_error& e) {
+        LogPrint(BCLog::REINDEX, "%s: failed to read blk%05u.dat: %s\n", __func__, (unsigned int)nFile, e.what());
+    }
+    return blocks;
+}
+
 class ImportingNow
 {
     std::atomic<bool>& m_importing;
@@ -1209,6 +1436,19 @@ void ImportBlocks(ChainstateManager& chainman, std::vector<fs::path> vImportFile
             // Map of disk positions for blocks with unknown parent (only used for reindex);
             // parent hash -> child disk position, multiple children can have the same parent.
             std::multimap<uint256, FlatFilePos> blocks_with_unknown_parent;
+            // SYSCOIN the files following the one being imported are read and checked on the shared executor, at
+            // most REINDEX_PREFETCH_FILES of them are held at a time and the import takes them in file order
+            ExecutorTaskGroup prefetch_pool{Executor::Lane::BACKGROUND};
+            std::deque<std::future<PrefetchedBlocks>> prefetching;
+            int nPrefetchFile = 0;
+            const auto prefetch_ahead = [&]() {
+                while (prefetching.size() < REINDEX_PREFETCH_FILES && fs::exists(chainman.m_blockman.GetBlockPosFilename(FlatFilePos(nPrefetchFile, 0)))) {
+                    prefetching.push_back(prefetch_pool.push([&chainman](int, int n) {
+                        return PrefetchBlockFile(chainman.m_blockman, chainman.GetParams(), n, chainman.m_interrupt);
+                    }, nPrefetchFile));
+                    nPrefetchFile++;
+                }
+            };
             while (true) {
                 FlatFilePos pos(nFile, 0);
                 if (!fs::exists(chainman.m_blockman.GetBlockPosFilename(pos))) {
@@ -1218,8 +1458,19 @@ void ImportBlocks(ChainstateManager& chainman, std::vector<fs::path> vImportFile
                 if (file.IsNull()) {
                     break; // This error is logged in OpenBlockFile
                 }
+                prefetch_ahead();
+                PrefetchedBlocks prefetched;
+                if (!prefetching.empty()) {
+                    try {
+                        prefetched = prefetching.front().get();
+                    } catch (const std::future_error&) {
+                        // dropped, the blocks are read by the import
+                    }
+                    prefetching.pop_front();
+                }
+                prefetch_ahead();
                 LogPrintf("Reindexing block file blk%05u.dat...\n", (unsigned int)nFile);
-                chainman.LoadExternalBlockFile(file, &pos, &blocks_with_unknown_parent);
+                chainman.LoadExternalBlockFile(file, &pos, &blocks_with_unknown_parent, &prefetched);
                 if (chainman.m_interrupt) {
                     LogPrintf("Interrupt requested. Exit %s\n", __func__);
                     return;
@@ -13,7 +13,11 @@
 #include <kernel/chainparams.h>
 #include <kernel/cs_main.h>
 #include <kernel/messagestartchars.h>
+#include <primitives/block.h>
+#include <saltedhasher.h>
+#include <span.h>
 #include <sync.h>
+#include <unordered_lru_cache.h>
 #include <util/fs.h>
 #include <util/hasher.h>
 
@@ -64,6 +68,9 @@ public:
     void ReadReindexing(bool& fReindexing);
     bool WriteFlag(const std::string& name, bool fValue);
     bool ReadFlag(const std::string& name, bool& fValue);
+    // SYSCOIN merge mined headers together with their auxpow, see BlockManager::ReadBlockHeaderFromDisk
+    bool WriteAuxpowHeader(const CBlockHeader& header);
+    bool ReadAuxpowHeader(const uint256& hash, CBlockHeader& header);
     bool LoadBlockIndexGuts(const Consensus::Params& consensusParams, std::function<CBlockIndex*(const uint256&)> insertBlockIndex, const util::SignalInterrupt& interrupt)
         EXCLUSIVE_LOCKS_REQUIRED(::cs_main);
 };
@@ -74,6 +81,16 @@ namespace node {
 struct NodeContext;
 using kernel::BlockTreeDB;
 
+// SYSCOIN recently read merge mined headers, enough for a couple of full HEADERS responses
+static const size_t AUXPOW_HEADER_CACHE_SIZE = 4000;
+// SYSCOIN block files read through memory mappings instead of file reads
+static const bool DEFAULT_BLOCK_MMAP = false;
+// SYSCOIN block files read and checked ahead of the one -reindex imports
+static const size_t REINDEX_PREFETCH_FILES = 3;
+// SYSCOIN mapped block files kept around, the oldest mapping is dropped once its last reader is done
+static const size_t BLOCK_FILE_MAPPING_CACHE_SIZE = 8;
+// SYSCOIN how far past a block a sequential read asks the kernel to read ahead
+static const size_t BLOCK_FILE_READAHEAD = 4 << 20;
 /** The pre-allocation chunk size for blk?????.dat files (since 0.8) */
 static const unsigned int BLOCKFILE_CHUNK_SIZE = 0x1000000; // 16 MiB
 /** The pre-allocation chunk size for rev?????.dat files (since 0.8) */
@@ -86,6 +103,36 @@ static constexpr size_t BLOCK_SERIALIZATION_HEADER_SIZE = std::tuple_size_v<Mess
 
 extern std::atomic_bool fReindex;
 
+// SYSCOIN
+/** Read only mapping of a whole block file, unmapped once the last reader lets go of it */
+class BlockFileMapping
+{
+private:
+    const uint8_t* m_data;
+    size_t m_size;
+
+public:
+    //! where a read continuing the last one of this file would start, reads that do are part of a scan
+    mutable std::atomic<uint32_t> m_next_pos{0};
+
+    BlockFileMapping(const uint8_t* data, size_t size) : m_data{data}, m_size{size} {}
+    ~BlockFileMapping();
+    BlockFileMapping(const BlockFileMapping&) = delete;
+    BlockFileMapping& operator=(const BlockFileMapping&) = delete;
+
+    Span<const uint8_t> Data() const { return {m_data, m_size}; }
+};
+
+/** SYSCOIN blocks of a block file read ahead of the import, by their position in the file */
+using PrefetchedBlocks = std::unordered_map<uint32_t, std::shared_ptr<CBlock>>;
+
+/** Serialized block borrowed from a mapped block file, or read into a buffer of its own when it is not mapped */
+struct RawBlock {
+    std::shared_ptr<const BlockFileMapping> mapping;
+    std::vector<uint8_t> buffer;
+    Span<const uint8_t> data;
+};
+
 // Because validation code takes pointers to the map's CBlockIndex objects, if
 // we ever switch to another associative container, we need to either use a
 // container that has stable addressing (true of all std associative
@@ -294,6 +341,11 @@ public:
     std::multimap<CBlockIndex*, CBlockIndex*> m_blocks_unlinked;
 
     std::unique_ptr<BlockTreeDB> m_block_tree_db GUARDED_BY(::cs_main);
+    // SYSCOIN
+    mutable Mutex cs_auxpow_headers;
+    mutable unordered_lru_cache<uint256, CBlockHeader, StaticSaltedHasher, AUXPOW_HEADER_CACHE_SIZE> m_auxpow_header_cache GUARDED_BY(cs_auxpow_headers);
+    mutable Mutex cs_block_mappings;
+    mutable unordered_lru_cache<int, std::shared_ptr<const BlockFileMapping>, std::hash<int>, BLOCK_FILE_MAPPING_CACHE_SIZE> m_block_mappings GUARDED_BY(cs_block_mappings);
 
     bool WriteBlockIndexDB() EXCLUSIVE_LOCKS_REQUIRED(::cs_main);
     bool LoadBlockIndexDB(const std::optional<uint256>& snapshot_blockhash)
@@ -373,18 +425,27 @@ public:
     void UnlinkPrunedFiles(const std::set<int>& setFilesToPrune) const;
 
     /** Functions for disk access for blocks */
-    bool ReadBlockFromDisk(CBlock& block, const FlatFilePos& pos) const;
-    bool ReadBlockFromDisk(CBlock& block, const CBlockIndex& index) const;
+    /** fFillNEVMData merges the PoDA blobs back into the outputs, only needed to relay or return the full block */
+    bool ReadBlockFromDisk(CBlock& block, const FlatFilePos& pos, bool fFillNEVMData = true) const;
+    bool ReadBlockFromDisk(CBlock& block, const CBlockIndex& index, bool fFillNEVMData = true) const;
     bool ReadRawBlockFromDisk(std::vector<uint8_t>& block, const FlatFilePos& pos) const;
+    /** SYSCOIN borrows the block from the mapped block file with -blockmmap, reads it into block.buffer otherwise */
+    bool ReadRawBlockFromDisk(RawBlock& block, const FlatFilePos& pos) const EXCLUSIVE_LOCKS_REQUIRED(!cs_block_mappings);
 
     bool UndoReadFromDisk(CBlockUndo& blockundo, const CBlockIndex& index) const;
 
     void CleanupBlockRevFiles() const;
     template<typename T>
     bool ReadBlockOrHeader(T& block, const FlatFilePos& pos) const;
-    bool ReadBlockHeaderFromDisk(CBlockHeader& block, const CBlockIndex* pindex) const;
+    /** Header including the auxpow, from the cache or the header store before falling back to the block file */
+    bool ReadBlockHeaderFromDisk(CBlockHeader& block, const CBlockIndex* pindex) const EXCLUSIVE_LOCKS_REQUIRED(!cs_auxpow_headers);
     template<typename T>
     bool ReadBlockOrHeader(T& block, const CBlockIndex& pindex) const;
+
+private:
+    // SYSCOIN mapping of block file nFile covering at least its first nEnd bytes, nullptr if it can't be mapped
+    std::shared_ptr<const BlockFileMapping> MapBlockFile(int nFile, size_t nEnd) const EXCLUSIVE_LOCKS_REQUIRED(!cs_block_mappings);
+    bool ReadMappedBlock(RawBlock& block, const FlatFilePos& pos) const EXCLUSIVE_LOCKS_REQUIRED(!cs_block_mappings);
 };
 // SYSCOIN
 void ImportBlocks(ChainstateManager& chainman, std::vector<fs::path> vImportFiles, CDSNotificationInterface* pdsNotificationInterface, std::unique_ptr<CDeterministicMNManager> &deterministicMNManager, std::unique_ptr<CActiveMasternodeManager> &activeMasternodeManager, const WalletInitInterface &g_wallet_init_interface, NodeContext& node);
@@ -35,6 +35,10 @@ CacheSizes CalculateCacheSizes(const ArgsManager& args, size_t n_indexes)
     sizes.evo_qc_db = 1024 * 1024 * 64;
     sizes.evo_qvvecs_db = 1024 * 1024 * 64;
     sizes.evo_qsk_db = 1024 * 1024 * 32;
+    // half of what each Syscoin database would have cached on its own: the list snapshots and diffs, the
+    // quorum databases and the NEVM databases sized like the block tree
+    sizes.syscoin_block_cache = (sizes.evo_dmn_db * 3 + sizes.evo_qc_db + sizes.evo_qvvecs_db + sizes.evo_qsk_db +
+                                 sizes.block_tree_db * 2 + sizes.evo_poda_db) / 2;
     return sizes;
 }
 } // namespace node
@@ -23,6 +23,8 @@ struct CacheSizes {
     int64_t evo_qvvecs_db;
     int64_t evo_qsk_db;
     int64_t evo_poda_db;
+    //! block cache shared by the databases above, each gets the write buffer of its own size
+    int64_t syscoin_block_cache;
 };
 CacheSizes CalculateCacheSizes(const ArgsManager& args, size_t n_indexes = 0);
 } // namespace node
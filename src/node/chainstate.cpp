@@ -48,14 +48,35 @@ static ChainstateLoadResult CompleteChainstateInitialization(
     auto& pblocktree{chainman.m_blockman.m_block_tree_db};
     LogPrintf("Creating LLMQ databases...\n");
     llmq::DestroyLLMQSystem();
+    // the databases stored in the shared one have to be closed before it
+    deterministicMNManager.reset();
+    pnevmtxrootsdb.reset();
+    pnevmtxmintdb.reset();
+    pblockindexdb.reset();
+    pnevmdatadb.reset();
+    psyscoinstatedb.reset();
+    // SYSCOIN the Syscoin state databases share one block cache, PoDA blobs keep theirs apart
+    const auto block_cache{MakeDBBlockCache(cache_sizes.syscoin_block_cache)};
+    if (options.syscoin_state_db) {
+        psyscoinstatedb = std::make_unique<CDBWrapper>(DBParams{
+            .path = chainman.m_options.datadir / "syscoinstate",
+            .cache_bytes = static_cast<size_t>(cache_sizes.evo_dmn_db * 2 + cache_sizes.evo_qc_db + cache_sizes.evo_qvvecs_db +
+                                               cache_sizes.evo_qsk_db + cache_sizes.block_tree_db * 2 + cache_sizes.evo_poda_db),
+            .memory_only = options.block_tree_db_in_memory,
+            .wipe_data = options.fReindexGeth,
+            .options = chainman.m_options.block_tree_db,
+            .block_cache = block_cache});
+    }
     auto evoDmnDbParams = DBParams{
         .path = chainman.m_options.datadir / "evodb_dmn",
         .cache_bytes = static_cast<size_t>(cache_sizes.evo_dmn_db),
         .memory_only = options.block_tree_db_in_memory,
         .wipe_data = options.fReindexGeth,
-        .options = chainman.m_options.block_tree_db};
+        .options = chainman.m_options.block_tree_db,
+        .shared_db = psyscoinstatedb.get(),
+        .block_cache = block_cache};
     deterministicMNManager.reset();
-    deterministicMNManager.reset(new CDeterministicMNManager(evoDmnDbParams));
+    deterministicMNManager.reset(new CDeterministicMNManager(evoDmnDbParams, options.evodb_delta_snapshots));
     governance.reset();
     governance.reset(new CGovernanceManager(chainman));
     sporkManager.reset();
@@ -69,19 +90,25 @@ static ChainstateLoadResult CompleteChainstateInitialization(
         .cache_bytes = static_cast<size_t>(cache_sizes.evo_qc_db),
         .memory_only = options.block_tree_db_in_memory,
         .wipe_data = options.fReindexGeth,
-        .options = chainman.m_options.block_tree_db};
+        .options = chainman.m_options.block_tree_db,
+        .shared_db = psyscoinstatedb.get(),
+        .block_cache = block_cache};
     auto quorumVectorDB = DBParams{
         .path = chainman.m_options.datadir / "evodb_qvvecs",
         .cache_bytes = static_cast<size_t>(cache_sizes.evo_qvvecs_db),
         .memory_only = options.block_tree_db_in_memory,
         .wipe_data = options.fReindexGeth,
-        .options = chainman.m_options.block_tree_db};
+        .options = chainman.m_options.block_tree_db,
+        .shared_db = psyscoinstatedb.get(),
+        .block_cache = block_cache};
     auto quorumSkDB = DBParams{
         .path = chainman.m_options.datadir / "evodb_qsk",
         .cache_bytes = static_cast<size_t>(cache_sizes.evo_qsk_db),
         .memory_only = options.block_tree_db_in_memory,
         .wipe_data = options.fReindexGeth,
-        .options = chainman.m_options.block_tree_db};
+        .options = chainman.m_options.block_tree_db,
+        .shared_db = psyscoinstatedb.get(),
+        .block_cache = block_cache};
     llmq::InitLLMQSystem(quorumCommitmentDB, quorumVectorDB, quorumSkDB, options.block_tree_db_in_memory, *options.connman, *options.banman, *options.peerman, chainman, options.fReindexGeth);
     pnevmtxrootsdb.reset();
     pnevmtxrootsdb = std::make_unique<CNEVMTxRootsDB>(DBParams{
@@ -89,28 +116,36 @@ static ChainstateLoadResult CompleteChainstateInitialization(
         .cache_bytes = static_cast<size_t>(cache_sizes.block_tree_db),
         .memory_only = options.block_tree_db_in_memory,
         .wipe_data = options.fReindexGeth,
-        .options = chainman.m_options.block_tree_db});
+        .options = chainman.m_options.block_tree_db,
+        .shared_db = psyscoinstatedb.get(),
+        .block_cache = block_cache});
     pnevmtxmintdb.reset();
     pnevmtxmintdb = std::make_unique<CNEVMMintedTxDB>(DBParams{
         .path = chainman.m_options.datadir / "nevmminttx",
         .cache_bytes = static_cast<size_t>(cache_sizes.block_tree_db),
         .memory_only = options.block_tree_db_in_memory,
         .wipe_data = options.fReindexGeth,
-        .options = chainman.m_options.block_tree_db});
+        .options = chainman.m_options.block_tree_db,
+        .shared_db = psyscoinstatedb.get(),
+        .block_cache = block_cache});
     pblockindexdb.reset();
     pblockindexdb = std::make_unique<CBlockIndexDB>(DBParams{
         .path = chainman.m_options.datadir / "dbblockindex",
         .cache_bytes = static_cast<size_t>(cache_sizes.evo_dmn_db),
         .memory_only = options.block_tree_db_in_memory,
         .wipe_data = options.fReindexGeth,
-        .options = chainman.m_options.block_tree_db});
+        .options = chainman.m_options.block_tree_db,
+        .shared_db = psyscoinstatedb.get(),
+        .block_cache = block_cache});
     pnevmdatadb.reset();
     pnevmdatadb = std::make_unique<CNEVMDataDB>(DBParams{
         .path = chainman.m_options.datadir / "nevmdata",
         .cache_bytes = static_cast<size_t>(cache_sizes.block_tree_db),
         .memory_only = options.block_tree_db_in_memory,
         .wipe_data = options.fReindexGeth,
-        .options = chainman.m_options.coins_db});
+        .options = chainman.m_options.coins_db,
+        .shared_db = psyscoinstatedb.get(),
+        .block_cache = block_cache});
     pnevmdatablobdb.reset();  
     // PoDA blob data cannot be deleted from disk on reindex because chain on disk does not have PoDA information to recreate it
     pnevmdatablobdb = std::make_unique<CNEVMDataBlobDB>(DBParams{
@@ -118,7 +153,7 @@ static ChainstateLoadResult CompleteChainstateInitialization(
         .cache_bytes = static_cast<size_t>(cache_sizes.evo_poda_db),
         .memory_only = options.block_tree_db_in_memory,
         .wipe_data = false,
-        .options = chainman.m_options.coins_db});  
+        .options = chainman.m_options.coins_db}, chainman.m_options.datadir / "nevmblobs");  
     // new BlockTreeDB tries to delete the existing file, which
     // fails if it's still open from the previous loop. Close it first:
     pblocktree.reset();
@@ -236,6 +271,15 @@ static ChainstateLoadResult CompleteChainstateInitialization(
                                                              chainman.GetConsensus().SegwitHeight)};
         };
     }
+    // SYSCOIN the Syscoin state has to be rebuilt to move it in or out of the shared database
+    bool fSharedState{false};
+    pblocktree->ReadFlag("syscoinstatedb", fSharedState);
+    if (fSharedState != options.syscoin_state_db) {
+        if (!coinsViewEmpty && !options.fReindexGeth) {
+            return {ChainstateLoadStatus::FAILURE, _("You need to rebuild the database using -reindex-chainstate to change -syscoinstatedb.")};
+        }
+        pblocktree->WriteFlag("syscoinstatedb", options.syscoin_state_db);
+    }
     // if coinsview is empty we clear all SYS db's overriding anything we did before
     if(coinsViewEmpty && !options.fReindexGeth) {
         LogPrintf("coinsViewEmpty recreating LLMQ and NEVM databases\n");
@@ -245,9 +289,11 @@ static ChainstateLoadResult CompleteChainstateInitialization(
             .cache_bytes = static_cast<size_t>(cache_sizes.evo_dmn_db),
             .memory_only = options.block_tree_db_in_memory,
             .wipe_data = coinsViewEmpty,
-            .options = chainman.m_options.block_tree_db};
+            .options = chainman.m_options.block_tree_db,
+            .shared_db = psyscoinstatedb.get(),
+            .block_cache = block_cache};
         deterministicMNManager.reset();
-        deterministicMNManager.reset(new CDeterministicMNManager(evoDmnDbParams));
+        deterministicMNManager.reset(new CDeterministicMNManager(evoDmnDbParams, options.evodb_delta_snapshots));
         governance.reset();
         governance.reset(new CGovernanceManager(chainman));
         sporkManager.reset();
@@ -261,19 +307,25 @@ static ChainstateLoadResult CompleteChainstateInitialization(
         .cache_bytes = static_cast<size_t>(cache_sizes.evo_qc_db),
         .memory_only = options.block_tree_db_in_memory,
         .wipe_data = coinsViewEmpty,
-        .options = chainman.m_options.block_tree_db};
+        .options = chainman.m_options.block_tree_db,
+        .shared_db = psyscoinstatedb.get(),
+        .block_cache = block_cache};
         auto quorumVectorDB = DBParams{
             .path = chainman.m_options.datadir / "evodb_qvvecs",
             .cache_bytes = static_cast<size_t>(cache_sizes.evo_qvvecs_db),
             .memory_only = options.block_tree_db_in_memory,
             .wipe_data = coinsViewEmpty,
-            .options = chainman.m_options.block_tree_db};
+            .options = chainman.m_options.block_tree_db,
+            .shared_db = psyscoinstatedb.get(),
+            .block_cache = block_cache};
         auto quorumSkDB = DBParams{
             .path = chainman.m_options.datadir / "evodb_qsk",
             .cache_bytes = static_cast<size_t>(cache_sizes.evo_qsk_db),
             .memory_only = options.block_tree_db_in_memory,
             .wipe_data = coinsViewEmpty,
-            .options = chainman.m_options.block_tree_db};
+            .options = chainman.m_options.block_tree_db,
+            .shared_db = psyscoinstatedb.get(),
+            .block_cache = block_cache};
         llmq::InitLLMQSystem(quorumCommitmentDB, quorumVectorDB, quorumSkDB, options.block_tree_db_in_memory, *options.connman, *options.banman, *options.peerman, chainman, coinsViewEmpty);
         pnevmtxrootsdb.reset();
         pnevmtxrootsdb = std::make_unique<CNEVMTxRootsDB>(DBParams{
@@ -281,28 +333,36 @@ static ChainstateLoadResult CompleteChainstateInitialization(
             .cache_bytes = static_cast<size_t>(cache_sizes.block_tree_db),
             .memory_only = options.block_tree_db_in_memory,
             .wipe_data = coinsViewEmpty,
-            .options = chainman.m_options.block_tree_db});
+            .options = chainman.m_options.block_tree_db,
+            .shared_db = psyscoinstatedb.get(),
+            .block_cache = block_cache});
         pnevmtxmintdb.reset();
         pnevmtxmintdb = std::make_unique<CNEVMMintedTxDB>(DBParams{
             .path = chainman.m_options.datadir / "nevmminttx",
             .cache_bytes = static_cast<size_t>(cache_sizes.block_tree_db),
             .memory_only = options.block_tree_db_in_memory,
             .wipe_data = coinsViewEmpty,
-            .options = chainman.m_options.block_tree_db});
+            .options = chainman.m_options.block_tree_db,
+            .shared_db = psyscoinstatedb.get(),
+            .block_cache = block_cache});
         pblockindexdb.reset();
         pblockindexdb = std::make_unique<CBlockIndexDB>(DBParams{
             .path = chainman.m_options.datadir / "dbblockindex",
             .cache_bytes = static_cast<size_t>(cache_sizes.evo_dmn_db),
             .memory_only = options.block_tree_db_in_memory,
             .wipe_data = coinsViewEmpty,
-            .options = chainman.m_options.block_tree_db});
+            .options = chainman.m_options.block_tree_db,
+            .shared_db = psyscoinstatedb.get(),
+            .block_cache = block_cache});
         pnevmdatadb.reset();
         pnevmdatadb = std::make_unique<CNEVMDataDB>(DBParams{
             .path = chainman.m_options.datadir / "nevmdata",
             .cache_bytes = static_cast<size_t>(cache_sizes.evo_poda_db),
             .memory_only = options.block_tree_db_in_memory,
             .wipe_data = coinsViewEmpty,
-            .options = chainman.m_options.coins_db});
+            .options = chainman.m_options.coins_db,
+            .shared_db = psyscoinstatedb.get(),
+            .block_cache = block_cache});
         pnevmdatablobdb.reset();  
         // PoDA blob data cannot be deleted from disk on reindex because chain on disk does not have PoDA information to recreate it
         pnevmdatablobdb = std::make_unique<CNEVMDataBlobDB>(DBParams{
@@ -310,7 +370,7 @@ static ChainstateLoadResult CompleteChainstateInitialization(
             .cache_bytes = static_cast<size_t>(cache_sizes.evo_poda_db),
             .memory_only = options.block_tree_db_in_memory,
             .wipe_data = false,
-            .options = chainman.m_options.coins_db});  
+            .options = chainman.m_options.coins_db}, chainman.m_options.datadir / "nevmblobs");  
     }
 
     // Now that chainstates are loaded and we're able to flush to
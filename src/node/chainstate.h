@@ -43,6 +43,10 @@ struct ChainstateLoadOptions {
     BanMan* banman{nullptr};
     PeerManager* peerman{nullptr};
     bool fReindexGeth{false};
+    //! Keep the Syscoin state databases in one LevelDB instance, see -syscoinstatedb
+    bool syscoin_state_db{false};
+    //! Write masternode list snapshots as deltas to the previous one, see -evodbdeltasnapshots
+    bool evodb_delta_snapshots{false};
 };
 
 //! Chainstate load status. Simple applications can just check for the success
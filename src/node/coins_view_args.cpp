@@ -12,5 +12,8 @@ void ReadCoinsViewArgs(const ArgsManager& args, CoinsViewOptions& options)
 {
     if (auto value = args.GetIntArg("-dbbatchsize")) options.batch_write_bytes = *value;
     if (auto value = args.GetIntArg("-dbcrashratio")) options.simulate_crash_ratio = *value;
+    // SYSCOIN
+    options.write_behind = args.GetBoolArg("-dbwritebehind", DEFAULT_DB_WRITE_BEHIND);
+    options.prefetch = args.GetBoolArg("-coinsprefetch", DEFAULT_COINS_PREFETCH);
 }
 } // namespace node
@@ -9,9 +9,12 @@
 
 #include <atomic>
 #include <cassert>
+#include <chrono>
 #include <cstdlib>
 #include <functional>
 #include <memory>
+#include <string>
+#include <utility>
 #include <vector>
 
 class ArgsManager;
@@ -25,6 +28,10 @@ class CTxMemPool;
 class ChainstateManager;
 class NetGroupManager;
 class PeerManager;
+// SYSCOIN
+namespace kernel {
+class MempoolJournal;
+} // namespace kernel
 namespace interfaces {
 class Chain;
 class ChainClient;
@@ -53,6 +60,8 @@ struct NodeContext {
     std::unique_ptr<AddrMan> addrman;
     std::unique_ptr<CConnman> connman;
     std::unique_ptr<CTxMemPool> mempool;
+    // SYSCOIN
+    std::unique_ptr<kernel::MempoolJournal> mempool_journal;
     std::unique_ptr<const NetGroupManager> netgroupman;
     std::unique_ptr<CBlockPolicyEstimator> fee_estimator;
     std::unique_ptr<PeerManager> peerman;
@@ -70,6 +79,12 @@ struct NodeContext {
     std::function<void()> rpc_interruption_point = [] {};
     std::unique_ptr<KernelNotifications> notifications;
     std::atomic<int> exit_status{EXIT_SUCCESS};
+    // SYSCOIN
+    //! Time spent in each startup phase in the order they finished, filled in by AppInitMain
+    //! before the RPC warmup ends and reported by getstartupinfo.
+    std::vector<std::pair<std::string, std::chrono::milliseconds>> startup_timings;
+    //! Lane with a thread of its own for the masternode and governance maintenance
+    std::unique_ptr<CScheduler> maintenance_scheduler;
 
     //! Declare default constructor and destructor that are not inline, so code
     //! instantiating the NodeContext struct doesn't need to #include class
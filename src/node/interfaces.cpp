@@ -464,42 +464,47 @@ bool FillBlock(const CBlockIndex* index, const FoundBlock& block, UniqueLock<Rec
     if (block.m_next_block) FillBlock(active[index->nHeight] == index ? active[index->nHeight + 1] : nullptr, *block.m_next_block, lock, active, blockman);
     if (block.m_data) {
         REVERSE_LOCK(lock);
-        if (!blockman.ReadBlockFromDisk(*block.m_data, *index)) block.m_data->SetNull();
+        // SYSCOIN wallet rescans only match scripts, so leave the PoDA blobs in their store
+        if (!blockman.ReadBlockFromDisk(*block.m_data, *index, /*fFillNEVMData=*/false)) block.m_data->SetNull();
     }
     block.found = true;
     return true;
 }
 
+//! Wallets handle their notifications on a ValidationInterfaceQueue of their own, so a
+//! slow wallet does not hold back the other subscribers of the validation queue.
 class NotificationsProxy : public CValidationInterface
 {
 public:
     explicit NotificationsProxy(std::shared_ptr<Chain::Notifications> notifications)
-        : m_notifications(std::move(notifications)) {}
+        : m_notifications(std::move(notifications)), m_queue("walletcb") {}
     virtual ~NotificationsProxy() = default;
     void TransactionAddedToMempool(const CTransactionRef& tx, uint64_t mempool_sequence) override
     {
-        m_notifications->transactionAddedToMempool(tx);
+        m_queue.Push([this, tx] { m_notifications->transactionAddedToMempool(tx); });
     }
     void TransactionRemovedFromMempool(const CTransactionRef& tx, MemPoolRemovalReason reason, uint64_t mempool_sequence) override
     {
-        m_notifications->transactionRemovedFromMempool(tx, reason);
+        m_queue.Push([this, tx, reason] { m_notifications->transactionRemovedFromMempool(tx, reason); });
     }
     void BlockConnected(ChainstateRole role, const std::shared_ptr<const CBlock>& block, const CBlockIndex* index) override
     {
-        m_notifications->blockConnected(role, kernel::MakeBlockInfo(index, block.get()));
+        m_queue.Push([this, role, block, index] { m_notifications->blockConnected(role, kernel::MakeBlockInfo(index, block.get())); });
     }
     void BlockDisconnected(const std::shared_ptr<const CBlock>& block, const CBlockIndex* index) override
     {
-        m_notifications->blockDisconnected(kernel::MakeBlockInfo(index, block.get()));
+        m_queue.Push([this, block, index] { m_notifications->blockDisconnected(kernel::MakeBlockInfo(index, block.get())); });
     }
     void UpdatedBlockTip(const CBlockIndex* index, const CBlockIndex* fork_index, ChainstateManager& chainman, bool is_ibd) override
     {
-        m_notifications->updatedBlockTip();
+        m_queue.Push([this] { m_notifications->updatedBlockTip(); });
     }
     void ChainStateFlushed(ChainstateRole role, const CBlockLocator& locator) override {
-        m_notifications->chainStateFlushed(role, locator);
+        m_queue.Push([this, role, locator] { m_notifications->chainStateFlushed(role, locator); });
     }
     std::shared_ptr<Chain::Notifications> m_notifications;
+    //! declared last so it runs the pending notifications before m_notifications is released
+    ValidationInterfaceQueue m_queue;
 };
 
 class NotificationsHandlerImpl : public Handler
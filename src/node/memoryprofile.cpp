@@ -0,0 +1,68 @@
+// Copyright (c) 2024 The Syscoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <node/memoryprofile.h>
+
+#include <bls/bls.h>
+#include <evo/deterministicmns.h>
+#include <governance/governance.h>
+#include <kernel/cs_main.h>
+#include <llmq/quorums_signing_shares.h>
+#include <node/context.h>
+#include <services/nevmconsensus.h>
+#include <sync.h>
+#include <txmempool.h>
+#include <validation.h>
+
+#include <algorithm>
+#include <map>
+
+namespace node {
+namespace {
+GlobalMutex g_peaks_mutex;
+std::map<std::string, size_t> g_peaks GUARDED_BY(g_peaks_mutex);
+} // namespace
+
+std::vector<SubsystemMemory> SampleSubsystemMemory(const NodeContext& node)
+{
+    std::vector<SubsystemMemory> result;
+    const auto add = [&](std::string name, size_t usage, std::optional<size_t> limit = std::nullopt) {
+        result.push_back({std::move(name), usage, 0, limit});
+    };
+
+    if (node.chainman) {
+        LOCK(cs_main);
+        Chainstate& chainstate = node.chainman->ActiveChainstate();
+        if (chainstate.CanFlushToDisk()) {
+            add("coinsviewcache", chainstate.CoinsTip().DynamicMemoryUsage(), chainstate.m_coinstip_cache_size_bytes);
+        }
+    }
+    if (node.mempool) {
+        add("mempool", node.mempool->DynamicMemoryUsage(), node.mempool->m_max_size_bytes);
+    }
+    if (deterministicMNManager) {
+        CDeterministicMNManager::EvoDBStats stats;
+        deterministicMNManager->GetMemoryUsage(stats);
+        add("deterministicmns", stats.listsCacheUsage + stats.snapshotCacheUsage + stats.diffCacheUsage);
+    }
+    if (governance) {
+        add("governance", governance->DynamicMemoryUsage());
+    }
+    if (llmq::quorumSigSharesManager) {
+        add("sigshares", llmq::quorumSigSharesManager->DynamicMemoryUsage());
+    }
+    if (pnevmdatadb) {
+        add("nevmdata", pnevmdatadb->DynamicMemoryUsage());
+    }
+    add("blspubkeycache", GetBLSPublicKeyCacheStats().usage);
+
+    LOCK(g_peaks_mutex);
+    for (SubsystemMemory& subsystem : result) {
+        size_t& peak = g_peaks[subsystem.name];
+        peak = std::max(peak, subsystem.usage);
+        subsystem.peak = peak;
+    }
+    return result;
+}
+} // namespace node
@@ -0,0 +1,39 @@
+// Copyright (c) 2024 The Syscoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef SYSCOIN_NODE_MEMORYPROFILE_H
+#define SYSCOIN_NODE_MEMORYPROFILE_H
+
+#include <chrono>
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <vector>
+
+/** Measure the memory of the subsystems periodically, so their peaks are tracked between getmemoryinfo calls */
+static constexpr bool DEFAULT_MEMORY_PROFILE{false};
+static constexpr std::chrono::seconds MEMORY_PROFILE_INTERVAL{60};
+
+namespace node {
+struct NodeContext;
+
+struct SubsystemMemory {
+    std::string name;
+    //! estimated heap memory in use now
+    size_t usage{0};
+    //! highest usage measured since startup
+    size_t peak{0};
+    //! the configured bound of the usage, if there is one
+    std::optional<size_t> limit;
+};
+
+/**
+ * Measure the heap memory of the major subsystems. The figures are the memusage
+ * estimates of their containers, allocations are not tracked individually. Every
+ * call updates the peaks, subsystems that are not running are left out.
+ */
+std::vector<SubsystemMemory> SampleSubsystemMemory(const NodeContext& node);
+} // namespace node
+
+#endif // SYSCOIN_NODE_MEMORYPROFILE_H
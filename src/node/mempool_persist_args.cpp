@@ -24,5 +24,10 @@ fs::path MempoolPath(const ArgsManager& argsman)
 {
     return argsman.GetDataDirNet() / "mempool.dat";
 }
+// SYSCOIN
+fs::path MempoolJournalPath(const ArgsManager& argsman)
+{
+    return argsman.GetDataDirNet() / "mempool.journal";
+}
 
 } // namespace node
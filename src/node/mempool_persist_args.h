@@ -21,6 +21,8 @@ static constexpr bool DEFAULT_SYNC_MEMPOOL{false};
 bool ShouldPersistMempool(const ArgsManager& argsman);
 bool ShouldSyncMempool(const ArgsManager& argsman);
 fs::path MempoolPath(const ArgsManager& argsman);
+// SYSCOIN
+fs::path MempoolJournalPath(const ArgsManager& argsman);
 
 } // namespace node
 
@@ -0,0 +1,59 @@
+// Copyright (c) 2024 The Syscoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <node/messageworker.h>
+
+#include <util/thread.h>
+
+namespace node {
+void MessageWorker::Start()
+{
+    LOCK(m_mutex);
+    if (m_running) return;
+    m_running = true;
+    m_thread = std::thread(&util::TraceThread, m_name, [this] { ThreadMain(); });
+}
+
+void MessageWorker::Stop()
+{
+    {
+        LOCK(m_mutex);
+        m_running = false;
+    }
+    m_cv.notify_all();
+    if (m_thread.joinable()) m_thread.join();
+}
+
+bool MessageWorker::Push(std::function<void()> task)
+{
+    {
+        LOCK(m_mutex);
+        if (!m_running) return false;
+        m_tasks.emplace_back(std::move(task));
+    }
+    m_cv.notify_one();
+    return true;
+}
+
+size_t MessageWorker::Size() const
+{
+    return WITH_LOCK(m_mutex, return m_tasks.size());
+}
+
+void MessageWorker::ThreadMain()
+{
+    while (true) {
+        std::function<void()> task;
+        {
+            WAIT_LOCK(m_mutex, lock);
+            m_cv.wait(lock, [&]() EXCLUSIVE_LOCKS_REQUIRED(m_mutex) { return !m_tasks.empty() || !m_running; });
+            // queued tasks still run when stopping, they hold references that must be released
+            if (m_tasks.empty()) return;
+            task = std::move(m_tasks.front());
+            m_tasks.pop_front();
+        }
+        task();
+    }
+}
+} // namespace node
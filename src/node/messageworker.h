@@ -0,0 +1,47 @@
+// Copyright (c) 2024 The Syscoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef SYSCOIN_NODE_MESSAGEWORKER_H
+#define SYSCOIN_NODE_MESSAGEWORKER_H
+
+#include <sync.h>
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <string>
+#include <thread>
+
+namespace node {
+/**
+ * Thread of its own for the p2p messages of one subsystem (governance, LLMQ sig shares, DKG), so a
+ * slow message of one subsystem doesn't hold up the message handler thread for everything else.
+ * Tasks run one at a time in the order they were pushed.
+ */
+class MessageWorker
+{
+public:
+    explicit MessageWorker(std::string name) : m_name{std::move(name)} {}
+    ~MessageWorker() { Stop(); }
+
+    void Start() EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+    /** Run the tasks still queued and join the thread, tasks pushed later are refused */
+    void Stop() EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+    /** Queue task, returns false if the worker is not running and the caller has to run it itself */
+    bool Push(std::function<void()> task) EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+    size_t Size() const EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+
+private:
+    void ThreadMain() EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+
+    const std::string m_name;
+    mutable Mutex m_mutex;
+    std::condition_variable m_cv;
+    std::deque<std::function<void()>> m_tasks GUARDED_BY(m_mutex);
+    bool m_running GUARDED_BY(m_mutex){false};
+    std::thread m_thread;
+};
+} // namespace node
+
+#endif // SYSCOIN_NODE_MESSAGEWORKER_H
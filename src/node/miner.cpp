@@ -22,6 +22,7 @@
 #include <primitives/transaction.h>
 #include <timedata.h>
 #include <util/moneystr.h>
+#include <util/thread.h>
 #include <validation.h>
 
 #include <algorithm>
@@ -114,6 +115,16 @@ void BlockAssembler::resetBlock()
     nNumNEVMDataTxs = 0;
 }
 
+// SYSCOIN templates are also built on the template cache thread
+static GlobalMutex g_last_block_timings_mutex;
+static std::optional<BlockTemplateTimings> g_last_block_timings GUARDED_BY(g_last_block_timings_mutex);
+
+std::optional<BlockTemplateTimings> BlockAssembler::GetLastBlockTimings()
+{
+    LOCK(g_last_block_timings_mutex);
+    return g_last_block_timings;
+}
+
 std::unique_ptr<CBlockTemplate> BlockAssembler::CreateNewBlock(const CScript& scriptPubKeyIn)
 {
     const auto time_start{SteadyClock::now()};
@@ -190,6 +201,8 @@ std::unique_ptr<CBlockTemplate> BlockAssembler::CreateNewBlock(const CScript& sc
     CDataStream ds(SER_NETWORK, PROTOCOL_VERSION);
     CDataStream dsNEVM(SER_NETWORK, PROTOCOL_VERSION);
     BlockValidationState state;
+    BlockTemplateTimings timings;
+    timings.packages = std::chrono::duration_cast<std::chrono::microseconds>(time_1 - time_start);
     if(fDIP0003Active_context) {
         // Update coinbase transaction with additional info about masternode and governance payments,
         // get some info back to pass to getblocktemplate
@@ -197,25 +210,33 @@ std::unique_ptr<CBlockTemplate> BlockAssembler::CreateNewBlock(const CScript& sc
         // create commitment payload if quorum commitment is needed
         llmq::CFinalCommitment commitment;
         // this quorum period start
+        const auto time_commitments{SteadyClock::now()};
         if (llmq::quorumBlockProcessor->GetMinableCommitment(nHeight, qcTx.commitment)) {
             qcTx.nHeight = nHeight;
             coinbaseTx.nVersion = SYSCOIN_TX_VERSION_MN_QUORUM_COMMITMENT;
             ds << qcTx;
         }
+        const auto time_payments{SteadyClock::now()};
+        timings.commitments = std::chrono::duration_cast<std::chrono::microseconds>(time_payments - time_commitments);
         // Update coinbase transaction with additional info about masternode and governance payments,
         // get some info back to pass to getblocktemplate
         FillBlockPayments(m_chainstate.m_chain, coinbaseTx, nHeight, blockReward, nFees, pblocktemplate->voutMasternodePayments, pblocktemplate->voutSuperblockPayments);
+        timings.payments = std::chrono::duration_cast<std::chrono::microseconds>(SteadyClock::now() - time_payments);
     }
     if(NEVMActive_context && fNEVMConnection) {
+        const auto time_nevm{SteadyClock::now()};
         CNEVMBlock nevmBlock;
-        std::string stateStr;
-        GetMainSignals().NotifyGetNEVMBlock(nevmBlock, stateStr);
-        if(!stateStr.empty()) {
-            throw std::runtime_error(strprintf("Could not fetch NEVM block %s", stateStr));
+        if(!g_nevm_prefetcher || !g_nevm_prefetcher->GetNEVMBlock(pindexPrev->GetBlockHash(), nevmBlock)) {
+            std::string stateStr;
+            GetMainSignals().NotifyGetNEVMBlock(nevmBlock, stateStr);
+            if(!stateStr.empty()) {
+                throw std::runtime_error(strprintf("Could not fetch NEVM block %s", stateStr));
+            }
         }
         // block data stored in block which is a mutable field that is only sent over network
         pblock->vchNEVMBlockData = std::move(nevmBlock.vchNEVMBlockData);
         dsNEVM << NEVM_MAGIC_BYTES << CNEVMHeader(std::move(nevmBlock));
+        timings.nevm = std::chrono::duration_cast<std::chrono::microseconds>(SteadyClock::now() - time_nevm);
     }
     pblock->vtx[0] = MakeTransactionRef(coinbaseTx);
     // SYSCOIN
@@ -240,16 +261,31 @@ std::unique_ptr<CBlockTemplate> BlockAssembler::CreateNewBlock(const CScript& sc
     pblocktemplate->vTxSigOpsCost[0] = WITNESS_SCALE_FACTOR * GetLegacySigOpCount(*pblock->vtx[0]);
 
     // SYSCOIN BlockValidationState state;
-    if (m_options.test_block_validity && !TestBlockValidity(state, chainparams, m_chainstate, *pblock, pindexPrev,
-                                                  GetAdjustedTime, /*fCheckPOW=*/false, /*fCheckMerkleRoot=*/false)) {
-        throw std::runtime_error(strprintf("%s: TestBlockValidity failed: %s", __func__, state.ToString()));
+    const auto time_validity{SteadyClock::now()};
+    // in fast mode only the first template on a tip is checked here, later ones are checked in the background
+    const bool fDeferValidity{m_options.test_block_validity && g_block_template_validator && g_block_template_validator->IsTipChecked(pindexPrev->GetBlockHash())};
+    if (fDeferValidity) {
+        pblocktemplate->nDeferredCheck = g_block_template_validator->Queue(*pblock);
+    } else if (m_options.test_block_validity) {
+        if (!TestBlockValidity(state, chainparams, m_chainstate, *pblock, pindexPrev,
+                               GetAdjustedTime, /*fCheckPOW=*/false, /*fCheckMerkleRoot=*/false)) {
+            throw std::runtime_error(strprintf("%s: TestBlockValidity failed: %s", __func__, state.ToString()));
+        }
+        if (g_block_template_validator) g_block_template_validator->SetTipChecked(pindexPrev->GetBlockHash());
     }
     const auto time_2{SteadyClock::now()};
-
-    LogPrint(BCLog::BENCHMARK, "CreateNewBlock() packages: %.2fms (%d packages, %d updated descendants), validity: %.2fms (total %.2fms)\n",
-             Ticks<MillisecondsDouble>(time_1 - time_start), nPackagesSelected, nDescendantsUpdated,
-             Ticks<MillisecondsDouble>(time_2 - time_1),
-             Ticks<MillisecondsDouble>(time_2 - time_start));
+    // SYSCOIN
+    timings.validity = std::chrono::duration_cast<std::chrono::microseconds>(time_2 - time_validity);
+    timings.total = std::chrono::duration_cast<std::chrono::microseconds>(time_2 - time_start);
+    WITH_LOCK(g_last_block_timings_mutex, g_last_block_timings = timings);
+
+    LogPrint(BCLog::BENCHMARK, "CreateNewBlock() packages: %.2fms (%d packages, %d updated descendants), commitments: %.2fms, payments: %.2fms, nevm: %.2fms, validity: %.2fms (total %.2fms)\n",
+             Ticks<MillisecondsDouble>(timings.packages), nPackagesSelected, nDescendantsUpdated,
+             Ticks<MillisecondsDouble>(timings.commitments),
+             Ticks<MillisecondsDouble>(timings.payments),
+             Ticks<MillisecondsDouble>(timings.nevm),
+             Ticks<MillisecondsDouble>(timings.validity),
+             Ticks<MillisecondsDouble>(timings.total));
 
     return std::move(pblocktemplate);
 }
@@ -547,4 +583,338 @@ void IncrementExtraNonce(CBlock* pblock, const CBlockIndex* pindexPrev, unsigned
     pblock->vtx[0] = MakeTransactionRef(std::move(txCoinbase));
     pblock->hashMerkleRoot = BlockMerkleRoot(*pblock);
 }
+// SYSCOIN
+std::unique_ptr<NEVMBlockPrefetcher> g_nevm_prefetcher;
+
+NEVMBlockPrefetcher::~NEVMBlockPrefetcher()
+{
+    Stop();
+}
+
+void NEVMBlockPrefetcher::Start()
+{
+    assert(!m_thread.joinable());
+    m_thread = std::thread(&util::TraceThread, "nevmfetch", [this] { ThreadFetch(); });
+}
+
+void NEVMBlockPrefetcher::Stop()
+{
+    {
+        LOCK(m_mutex);
+        m_stop = true;
+    }
+    m_cv.notify_all();
+    if (m_thread.joinable()) m_thread.join();
+}
+
+bool NEVMBlockPrefetcher::GetNEVMBlock(const uint256& hashTip, CNEVMBlock& nevmBlock)
+{
+    bool found{false};
+    {
+        LOCK(m_mutex);
+        if (m_has_block && m_block_tip == hashTip && std::chrono::steady_clock::now() - m_block_time <= NEVM_PREFETCH_MAX_AGE) {
+            nevmBlock.nBlockHash = m_block.nBlockHash;
+            nevmBlock.nTxRoot = m_block.nTxRoot;
+            nevmBlock.nReceiptRoot = m_block.nReceiptRoot;
+            nevmBlock.vchNEVMBlockData = m_block.vchNEVMBlockData;
+            found = true;
+        }
+        m_active = true;
+        m_refresh = m_refresh || !found;
+    }
+    if (!found) m_cv.notify_one();
+    return found;
+}
+
+void NEVMBlockPrefetcher::UpdatedBlockTip(const CBlockIndex *pindexNew, const CBlockIndex *pindexFork, ChainstateManager& chainman, bool fInitialDownload)
+{
+    if (fInitialDownload) return;
+    {
+        LOCK(m_mutex);
+        m_has_block = false;
+        m_refresh = true;
+    }
+    m_cv.notify_one();
+}
+
+void NEVMBlockPrefetcher::ThreadFetch()
+{
+    while (true) {
+        {
+            WAIT_LOCK(m_mutex, lock);
+            // wake up for tip changes and template requests, and to keep an idle cached block fresh
+            m_cv.wait_for(lock, NEVM_PREFETCH_MAX_AGE, [this]() EXCLUSIVE_LOCKS_REQUIRED(m_mutex) { return m_stop || (m_active && m_refresh); });
+            if (m_stop) return;
+            if (!m_active) continue;
+            m_refresh = false;
+        }
+        uint256 hashTip;
+        {
+            LOCK(cs_main);
+            const CBlockIndex* tip = m_chainman.ActiveTip();
+            if (!tip || tip->nHeight + 1 < Params().GetConsensus().nNEVMStartBlock) continue;
+            hashTip = tip->GetBlockHash();
+        }
+        CNEVMBlock nevmBlock;
+        std::string stateStr;
+        GetMainSignals().NotifyGetNEVMBlock(nevmBlock, stateStr);
+        if (!stateStr.empty()) {
+            LogPrint(BCLog::SYS, "NEVMBlockPrefetcher: could not fetch NEVM block %s\n", stateStr);
+            continue;
+        }
+        {
+            LOCK(cs_main);
+            // Geth may already have built on a newer tip
+            if (m_chainman.ActiveTip()->GetBlockHash() != hashTip) continue;
+        }
+        LOCK(m_mutex);
+        // a tip change while fetching has already requested a newer block
+        if (m_refresh) continue;
+        m_block.nBlockHash = nevmBlock.nBlockHash;
+        m_block.nTxRoot = nevmBlock.nTxRoot;
+        m_block.nReceiptRoot = nevmBlock.nReceiptRoot;
+        m_block.vchNEVMBlockData = std::move(nevmBlock.vchNEVMBlockData);
+        m_has_block = true;
+        m_block_tip = hashTip;
+        m_block_time = std::chrono::steady_clock::now();
+    }
+}
+std::unique_ptr<BlockTemplateCache> g_block_template_cache;
+
+BlockTemplateCache::BlockTemplateCache(ChainstateManager& chainman, const CTxMemPool& mempool)
+    : m_chainman(chainman), m_mempool(mempool), m_allow_lag(!chainman.GetParams().MineBlocksOnDemand())
+{
+}
+
+BlockTemplateCache::~BlockTemplateCache()
+{
+    Stop();
+}
+
+void BlockTemplateCache::Start()
+{
+    assert(!m_thread.joinable());
+    m_thread = std::thread(&util::TraceThread, "blocktmpl", [this] { ThreadBuild(); });
+}
+
+void BlockTemplateCache::Stop()
+{
+    {
+        LOCK(m_mutex);
+        m_stop = true;
+    }
+    m_cv.notify_all();
+    if (m_thread.joinable()) m_thread.join();
+}
+
+std::unique_ptr<CBlockTemplate> BlockTemplateCache::GetBlockTemplate(const uint256& hashTip, unsigned int nTransactionsUpdated, const CScript& scriptPubKey)
+{
+    std::unique_ptr<CBlockTemplate> blocktemplate;
+    {
+        LOCK(m_mutex);
+        const auto now{std::chrono::steady_clock::now()};
+        m_last_request = now;
+        if (m_template && m_template->block.hashPrevBlock == hashTip && !DeferredCheckFailed(*m_template) &&
+            (m_template_tx_updated == nTransactionsUpdated || (m_allow_lag && now - m_last_build <= BLOCK_TEMPLATE_REFRESH_INTERVAL))) {
+            blocktemplate = std::make_unique<CBlockTemplate>(*m_template);
+        } else if (!m_active || !m_template || m_template->block.hashPrevBlock != hashTip) {
+            // build right away rather than after the refresh interval
+            m_tip_changed = true;
+        }
+        m_active = true;
+    }
+    if (!blocktemplate) {
+        m_cv.notify_one();
+        return nullptr;
+    }
+    // the template was built paying to a placeholder, nothing else depends on the first coinbase output script
+    CMutableTransaction coinbaseTx(*blocktemplate->block.vtx[0]);
+    coinbaseTx.vout[0].scriptPubKey = scriptPubKey;
+    blocktemplate->block.vtx[0] = MakeTransactionRef(std::move(coinbaseTx));
+    blocktemplate->vTxSigOpsCost[0] = WITNESS_SCALE_FACTOR * GetLegacySigOpCount(*blocktemplate->block.vtx[0]);
+    return blocktemplate;
+}
+
+void BlockTemplateCache::UpdatedBlockTip(const CBlockIndex *pindexNew, const CBlockIndex *pindexFork, ChainstateManager& chainman, bool fInitialDownload)
+{
+    if (fInitialDownload) return;
+    {
+        LOCK(m_mutex);
+        m_template.reset();
+        m_tip_changed = true;
+    }
+    m_cv.notify_one();
+}
+
+void BlockTemplateCache::MarkDirty()
+{
+    {
+        LOCK(m_mutex);
+        if (!m_active || m_dirty) return;
+        m_dirty = true;
+    }
+    m_cv.notify_one();
+}
+
+void BlockTemplateCache::TransactionAddedToMempool(const CTransactionRef& tx, uint64_t mempool_sequence)
+{
+    MarkDirty();
+}
+
+void BlockTemplateCache::TransactionRemovedFromMempool(const CTransactionRef& tx, MemPoolRemovalReason reason, uint64_t mempool_sequence)
+{
+    MarkDirty();
+}
+
+void BlockTemplateCache::ThreadBuild()
+{
+    while (true) {
+        {
+            WAIT_LOCK(m_mutex, lock);
+            m_cv.wait_for(lock, BLOCK_TEMPLATE_IDLE_TIMEOUT, [this]() EXCLUSIVE_LOCKS_REQUIRED(m_mutex) { return m_stop || (m_active && (m_tip_changed || m_dirty)); });
+            if (m_stop) return;
+            if (m_active && std::chrono::steady_clock::now() - m_last_request > BLOCK_TEMPLATE_IDLE_TIMEOUT) {
+                // the miners went away, don't keep building for nobody
+                m_active = false;
+                m_template.reset();
+            }
+            if (!m_active || (!m_tip_changed && !m_dirty)) continue;
+            if (!m_tip_changed) {
+                // fold a burst of mempool changes into one build, a new tip ends the wait
+                m_cv.wait_until(lock, m_last_build + BLOCK_TEMPLATE_REFRESH_INTERVAL, [this]() EXCLUSIVE_LOCKS_REQUIRED(m_mutex) { return m_stop || m_tip_changed; });
+                if (m_stop) return;
+            }
+            m_tip_changed = false;
+            m_dirty = false;
+            m_last_build = std::chrono::steady_clock::now();
+        }
+        // read before building so a change during the build makes the template count as older
+        const unsigned int nTransactionsUpdated{m_mempool.GetTransactionsUpdated()};
+        std::unique_ptr<CBlockTemplate> blocktemplate;
+        try {
+            blocktemplate = BlockAssembler{m_chainman.ActiveChainstate(), &m_mempool}.CreateNewBlock(CScript() << OP_TRUE);
+        } catch (const std::exception& e) {
+            // the requests build their own template and report the error
+            LogPrint(BCLog::SYS, "BlockTemplateCache: could not build block template: %s\n", e.what());
+            continue;
+        }
+        if (!blocktemplate) continue;
+        const bool fOnTip{WITH_LOCK(cs_main, return m_chainman.ActiveTip()->GetBlockHash() == blocktemplate->block.hashPrevBlock)};
+        LOCK(m_mutex);
+        // a tip change while building has already asked for a newer template
+        if (!fOnTip || m_tip_changed) continue;
+        m_template = std::move(blocktemplate);
+        m_template_tx_updated = nTransactionsUpdated;
+    }
+}
+std::unique_ptr<BlockTemplateValidator> g_block_template_validator;
+
+bool DeferredCheckFailed(const CBlockTemplate& blocktemplate)
+{
+    return blocktemplate.nDeferredCheck != 0 && g_block_template_validator &&
+           g_block_template_validator->GetResult(blocktemplate.nDeferredCheck) == BlockTemplateValidator::Result::INVALID;
+}
+
+BlockTemplateValidator::~BlockTemplateValidator()
+{
+    Stop();
+}
+
+void BlockTemplateValidator::Start()
+{
+    assert(!m_thread.joinable());
+    m_thread = std::thread(&util::TraceThread, "blockcheck", [this] { ThreadCheck(); });
+}
+
+void BlockTemplateValidator::Stop()
+{
+    {
+        LOCK(m_mutex);
+        m_stop = true;
+    }
+    m_cv.notify_all();
+    if (m_thread.joinable()) m_thread.join();
+}
+
+bool BlockTemplateValidator::IsTipChecked(const uint256& hashTip) const
+{
+    LOCK(m_mutex);
+    return !m_tip_checked.IsNull() && m_tip_checked == hashTip;
+}
+
+void BlockTemplateValidator::SetTipChecked(const uint256& hashTip)
+{
+    LOCK(m_mutex);
+    m_tip_checked = hashTip;
+}
+
+uint64_t BlockTemplateValidator::Queue(const CBlock& block)
+{
+    uint64_t nCheck;
+    {
+        LOCK(m_mutex);
+        nCheck = m_next_check++;
+        if (m_queue.size() >= MAX_QUEUED) {
+            // templates are refreshed faster than they are checked, the oldest one is likely gone already
+            SetResult(m_queue.front().first, Result::UNKNOWN);
+            m_queue.pop_front();
+        }
+        m_queue.emplace_back(nCheck, std::make_shared<const CBlock>(block));
+        SetResult(nCheck, Result::PENDING);
+    }
+    m_cv.notify_one();
+    return nCheck;
+}
+
+BlockTemplateValidator::Result BlockTemplateValidator::GetResult(uint64_t nCheck) const
+{
+    LOCK(m_mutex);
+    const auto it = m_results.find(nCheck);
+    return it == m_results.end() ? Result::UNKNOWN : it->second;
+}
+
+void BlockTemplateValidator::SetResult(uint64_t nCheck, Result result)
+{
+    AssertLockHeld(m_mutex);
+    m_results[nCheck] = result;
+    while (m_results.size() > MAX_RESULTS) {
+        m_results.erase(m_results.begin());
+    }
+}
+
+void BlockTemplateValidator::ThreadCheck()
+{
+    while (true) {
+        std::pair<uint64_t, std::shared_ptr<const CBlock>> check;
+        {
+            WAIT_LOCK(m_mutex, lock);
+            m_cv.wait(lock, [this]() EXCLUSIVE_LOCKS_REQUIRED(m_mutex) { return m_stop || !m_queue.empty(); });
+            if (m_stop) return;
+            check = std::move(m_queue.front());
+            m_queue.pop_front();
+        }
+        const auto& [nCheck, block] = check;
+        BlockValidationState state;
+        std::optional<bool> fValid;
+        {
+            LOCK(cs_main);
+            CBlockIndex* pindexPrev = m_chainman.ActiveChain().Tip();
+            // a template on an old tip is of no use to anyone
+            if (pindexPrev && pindexPrev->GetBlockHash() == block->hashPrevBlock) {
+                fValid = TestBlockValidity(state, m_chainman.GetParams(), m_chainman.ActiveChainstate(), *block, pindexPrev,
+                                           GetAdjustedTime, /*fCheckPOW=*/false, /*fCheckMerkleRoot=*/false);
+            }
+        }
+        LOCK(m_mutex);
+        if (!fValid) {
+            SetResult(nCheck, Result::UNKNOWN);
+            continue;
+        }
+        if (!*fValid) {
+            LogPrintf("BlockTemplateValidator: template on %s failed TestBlockValidity: %s\n", block->hashPrevBlock.ToString(), state.ToString());
+            if (m_tip_checked == block->hashPrevBlock) m_tip_checked.SetNull();
+        }
+        SetResult(nCheck, *fValid ? Result::VALID : Result::INVALID);
+    }
+}
 } // namespace node
@@ -9,10 +9,17 @@
 #include <policy/policy.h>
 #include <primitives/block.h>
 #include <txmempool.h>
+// SYSCOIN
+#include <sync.h>
+#include <validationinterface.h>
 
+#include <condition_variable>
+#include <deque>
+#include <map>
 #include <memory>
 #include <optional>
 #include <stdint.h>
+#include <thread>
 
 #include <boost/multi_index/identity.hpp>
 #include <boost/multi_index/indexed_by.hpp>
@@ -31,6 +38,16 @@ namespace Consensus { struct Params; };
 
 namespace node {
 static const bool DEFAULT_PRINTPRIORITY = false;
+// SYSCOIN
+static const bool DEFAULT_NEVM_PREFETCH = true;
+/** A prefetched NEVM block older than this is refreshed so new NEVM transactions get picked up */
+static constexpr std::chrono::seconds NEVM_PREFETCH_MAX_AGE{5};
+static const bool DEFAULT_BLOCK_TEMPLATE_CACHE = true;
+static const bool DEFAULT_BLOCK_TEMPLATE_FAST_CHECK = false;
+/** Mempool changes are folded into the cached block template at most this often */
+static constexpr std::chrono::milliseconds BLOCK_TEMPLATE_REFRESH_INTERVAL{1000};
+/** The cached block template stops being rebuilt when it has not been asked for in this long */
+static constexpr std::chrono::seconds BLOCK_TEMPLATE_IDLE_TIMEOUT{120};
 struct CBlockTemplate
 {
     CBlock block;
@@ -41,6 +58,21 @@ struct CBlockTemplate
     std::vector<unsigned char> vchCoinbaseCommitmentExtra; // coinbase opreturn commitment for quorums goes after any witness commitment
     std::vector<CTxOut> voutMasternodePayments; // masternode payment
     std::vector<CTxOut> voutSuperblockPayments; // superblock payment
+    // merkle branch of the coinbase for ComputeMerkleRootFromCoinbase, only filled in by users that vary the coinbase
+    std::vector<uint256> vCoinbaseMerkleBranch;
+    // background TestBlockValidity run of the template (see BlockTemplateValidator), 0 if it was checked before it was returned
+    uint64_t nDeferredCheck{0};
+};
+
+// SYSCOIN
+/** How long the phases of building a block template took */
+struct BlockTemplateTimings {
+    std::chrono::microseconds packages{0};
+    std::chrono::microseconds commitments{0};
+    std::chrono::microseconds payments{0};
+    std::chrono::microseconds nevm{0};
+    std::chrono::microseconds validity{0};
+    std::chrono::microseconds total{0};
 };
 
 // Container for tracking updates to ancestor feerate as we include (parent)
@@ -174,6 +206,9 @@ public:
 
     inline static std::optional<int64_t> m_last_block_num_txs{};
     inline static std::optional<int64_t> m_last_block_weight{};
+    // SYSCOIN
+    /** Phase timings of the last template built, by any caller */
+    static std::optional<BlockTemplateTimings> GetLastBlockTimings();
 
 private:
     const Options m_options;
@@ -217,6 +252,154 @@ void RegenerateCommitments(CBlock& block, ChainstateManager& chainman, const std
 
 /** Apply -blockmintxfee and -blockmaxweight options from ArgsManager to BlockAssembler options. */
 void ApplyArgsManOptions(const ArgsManager& gArgs, BlockAssembler::Options& options);
+
+// SYSCOIN
+/**
+ * Keeps a freshly built NEVM block ready for CreateNewBlock so template
+ * creation does not include a Geth round-trip. A new block is fetched in the
+ * background whenever the tip changes or the cached one gets too old. Nothing
+ * is fetched until the first template has been requested, so non-mining nodes
+ * don't put extra load on Geth.
+ */
+class NEVMBlockPrefetcher final : public CValidationInterface
+{
+public:
+    explicit NEVMBlockPrefetcher(ChainstateManager& chainman) : m_chainman(chainman) {}
+    ~NEVMBlockPrefetcher();
+
+    void Start();
+    void Stop();
+    /** Copy out the prefetched block if it was built on top of hashTip, otherwise ask for a new one */
+    bool GetNEVMBlock(const uint256& hashTip, CNEVMBlock& nevmBlock) EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+
+protected:
+    void UpdatedBlockTip(const CBlockIndex *pindexNew, const CBlockIndex *pindexFork, ChainstateManager& chainman, bool fInitialDownload) override EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+
+private:
+    void ThreadFetch() EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+
+    ChainstateManager& m_chainman;
+    Mutex m_mutex;
+    std::condition_variable m_cv;
+    CNEVMBlock m_block GUARDED_BY(m_mutex);
+    bool m_has_block GUARDED_BY(m_mutex){false};
+    //! SYS tip the cached block was built on
+    uint256 m_block_tip GUARDED_BY(m_mutex);
+    std::chrono::steady_clock::time_point m_block_time GUARDED_BY(m_mutex);
+    bool m_active GUARDED_BY(m_mutex){false};
+    bool m_refresh GUARDED_BY(m_mutex){false};
+    bool m_stop GUARDED_BY(m_mutex){false};
+    std::thread m_thread;
+};
+extern std::unique_ptr<NEVMBlockPrefetcher> g_nevm_prefetcher;
+
+/**
+ * Keeps a block template on top of the tip built in the background, so
+ * getblocktemplate and createauxblock don't run package selection, the
+ * payments, the quorum commitment and the NEVM fetch while the miner waits.
+ * The template is rebuilt right away when the tip changes and at most every
+ * BLOCK_TEMPLATE_REFRESH_INTERVAL while the mempool changes. Like the NEVM
+ * prefetcher nothing is built until a template has been requested, and
+ * building stops again once none was requested for BLOCK_TEMPLATE_IDLE_TIMEOUT.
+ */
+class BlockTemplateCache final : public CValidationInterface
+{
+public:
+    BlockTemplateCache(ChainstateManager& chainman, const CTxMemPool& mempool);
+    ~BlockTemplateCache();
+
+    void Start();
+    void Stop();
+    /**
+     * Copy out the cached template if it was built on hashTip, with its coinbase
+     * paying to scriptPubKey. It must also have been built since the mempool last
+     * changed (nTransactionsUpdated), except that on networks mining on demand it
+     * may lag behind the mempool by up to BLOCK_TEMPLATE_REFRESH_INTERVAL. Returns
+     * null otherwise and asks for a new template.
+     */
+    std::unique_ptr<CBlockTemplate> GetBlockTemplate(const uint256& hashTip, unsigned int nTransactionsUpdated, const CScript& scriptPubKey) EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+
+protected:
+    void UpdatedBlockTip(const CBlockIndex *pindexNew, const CBlockIndex *pindexFork, ChainstateManager& chainman, bool fInitialDownload) override EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+    void TransactionAddedToMempool(const CTransactionRef& tx, uint64_t mempool_sequence) override EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+    void TransactionRemovedFromMempool(const CTransactionRef& tx, MemPoolRemovalReason reason, uint64_t mempool_sequence) override EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+
+private:
+    void ThreadBuild() EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+    void MarkDirty() EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+
+    ChainstateManager& m_chainman;
+    const CTxMemPool& m_mempool;
+    //! whether a template may be served while the mempool changed after it was built
+    const bool m_allow_lag;
+    Mutex m_mutex;
+    std::condition_variable m_cv;
+    std::unique_ptr<CBlockTemplate> m_template GUARDED_BY(m_mutex);
+    //! mempool GetTransactionsUpdated() when m_template was started
+    unsigned int m_template_tx_updated GUARDED_BY(m_mutex){0};
+    std::chrono::steady_clock::time_point m_last_build GUARDED_BY(m_mutex);
+    std::chrono::steady_clock::time_point m_last_request GUARDED_BY(m_mutex);
+    bool m_active GUARDED_BY(m_mutex){false};
+    bool m_tip_changed GUARDED_BY(m_mutex){false};
+    bool m_dirty GUARDED_BY(m_mutex){false};
+    bool m_stop GUARDED_BY(m_mutex){false};
+    std::thread m_thread;
+};
+extern std::unique_ptr<BlockTemplateCache> g_block_template_cache;
+
+/**
+ * Runs TestBlockValidity off the request path for templates handed out without
+ * it (-blocktemplatefastcheck). The first template on a tip is still checked
+ * before it is returned, as the coinbase, the payments, the quorum commitment and
+ * the NEVM block only depend on the tip. Later templates on that tip only differ
+ * in mempool txs that were validated when they were accepted, so they are
+ * returned at once and checked here. A failed check makes the next template on
+ * the tip be checked before it is returned again.
+ */
+class BlockTemplateValidator
+{
+public:
+    enum class Result {
+        PENDING,
+        VALID,
+        INVALID,
+        //! dropped, stale or forgotten
+        UNKNOWN,
+    };
+
+    explicit BlockTemplateValidator(ChainstateManager& chainman) : m_chainman(chainman) {}
+    ~BlockTemplateValidator();
+
+    void Start();
+    void Stop();
+    /** Whether a template on hashTip passed TestBlockValidity before it was returned */
+    bool IsTipChecked(const uint256& hashTip) const EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+    void SetTipChecked(const uint256& hashTip) EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+    /** Queue a check of block and return its id for GetResult() */
+    uint64_t Queue(const CBlock& block) EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+    Result GetResult(uint64_t nCheck) const EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+
+private:
+    static constexpr size_t MAX_QUEUED{8};
+    static constexpr size_t MAX_RESULTS{64};
+
+    void ThreadCheck() EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+    void SetResult(uint64_t nCheck, Result result) EXCLUSIVE_LOCKS_REQUIRED(m_mutex);
+
+    ChainstateManager& m_chainman;
+    mutable Mutex m_mutex;
+    std::condition_variable m_cv;
+    uint256 m_tip_checked GUARDED_BY(m_mutex);
+    std::deque<std::pair<uint64_t, std::shared_ptr<const CBlock>>> m_queue GUARDED_BY(m_mutex);
+    std::map<uint64_t, Result> m_results GUARDED_BY(m_mutex);
+    uint64_t m_next_check GUARDED_BY(m_mutex){1};
+    bool m_stop GUARDED_BY(m_mutex){false};
+    std::thread m_thread;
+};
+extern std::unique_ptr<BlockTemplateValidator> g_block_template_validator;
+
+/** Whether the background check of blocktemplate found it invalid */
+bool DeferredCheckFailed(const CBlockTemplate& blocktemplate);
 } // namespace node
 
 #endif // SYSCOIN_NODE_MINER_H
@@ -44,6 +44,12 @@ TransactionError BroadcastTransaction(NodeContext& node, const CTransactionRef t
     uint256 wtxid = tx->GetWitnessHash();
     bool callback_set = false;
 
+    // SYSCOIN hash the PoDA blob before cs_main is taken
+    if (!PreValidateNEVMData(*tx)) {
+        err_string = "bad-txns-poda-invalid";
+        return TransactionError::MEMPOOL_REJECTED;
+    }
+
     {
         LOCK(cs_main);
 
@@ -5,13 +5,23 @@
 #include <node/txreconciliation.h>
 
 #include <common/system.h>
+#include <crypto/siphash.h>
 #include <logging.h>
+#include <node/minisketchwrapper.h>
 #include <util/check.h>
 
+#include <algorithm>
+#include <cmath>
+#include <map>
 #include <unordered_map>
 #include <variant>
 
 
+bool IsReconcilableInv(const CInv& inv)
+{
+    return inv.type == MSG_GOVERNANCE_OBJECT || inv.type == MSG_GOVERNANCE_OBJECT_VOTE;
+}
+
 namespace {
 
 /** Static salt component used to compute short txids for sketch construction, see BIP-330. */
@@ -36,9 +46,6 @@ class TxReconciliationState
 {
 public:
     /**
-     * TODO: This field is public to ignore -Wunused-private-field. Make private once used in
-     * the following commits.
-     *
      * Reconciliation protocol assumes using one role consistently: either a reconciliation
      * initiator (requesting sketches), or responder (sending sketches). This defines our role,
      * based on the direction of the p2p connection.
@@ -47,16 +54,54 @@ public:
     bool m_we_initiate;
 
     /**
-     * TODO: These fields are public to ignore -Wunused-private-field. Make private once used in
-     * the following commits.
-     *
      * These values are used to salt short IDs, which is necessary for transaction reconciliations.
      */
     uint64_t m_k0, m_k1;
 
+    // SYSCOIN
+    /** Inventory not announced to the peer yet, by short id. */
+    std::map<uint32_t, CInv> m_local_set;
+    /** As the responder, the set sketched for the ongoing reconciliation. */
+    std::map<uint32_t, CInv> m_sketched_set;
+    /** As the initiator, whether we wait for a sketch. As the responder, whether we wait for the outcome. */
+    bool m_in_flight{false};
+    std::chrono::microseconds m_next_request{0};
+
     TxReconciliationState(bool we_initiate, uint64_t k0, uint64_t k1) : m_we_initiate(we_initiate), m_k0(k0), m_k1(k1) {}
+
+    /** Short id of an inventory hash, never 0 as minisketch can't hold 0. */
+    uint32_t ComputeShortID(const uint256& hash) const
+    {
+        return 1 + uint32_t(SipHashUint256(m_k0, m_k1, hash) % 0xFFFFFFFF);
+    }
 };
 
+/** Sketch capacity for sets of the given sizes, the difference is expected to be size a - b + q * b */
+size_t EstimateSketchCapacity(size_t set_size1, size_t set_size2)
+{
+    const size_t diff{std::max(set_size1, set_size2) - std::min(set_size1, set_size2)};
+    return diff + size_t(std::ceil(INV_RECON_Q * std::min(set_size1, set_size2))) + 1;
+}
+
+Minisketch SketchSet(const std::map<uint32_t, CInv>& set, size_t capacity)
+{
+    Minisketch sketch{node::MakeMinisketch32(capacity)};
+    for (const auto& [short_id, _] : set) {
+        sketch.Add(short_id);
+    }
+    return sketch;
+}
+
+std::vector<CInv> SetInventory(const std::map<uint32_t, CInv>& set)
+{
+    std::vector<CInv> result;
+    result.reserve(set.size());
+    for (const auto& [_, inv] : set) {
+        result.emplace_back(inv);
+    }
+    return result;
+}
+
 } // namespace
 
 /** Actual implementation for TxReconciliationTracker's data structure. */
@@ -142,6 +187,125 @@ public:
         return (recon_state != m_states.end() &&
                 std::holds_alternative<TxReconciliationState>(recon_state->second));
     }
+
+    // SYSCOIN
+    bool AddToReconSet(NodeId peer_id, const CInv& inv) EXCLUSIVE_LOCKS_REQUIRED(!m_txreconciliation_mutex)
+    {
+        AssertLockNotHeld(m_txreconciliation_mutex);
+        LOCK(m_txreconciliation_mutex);
+        TxReconciliationState* state = GetRegisteredState(peer_id);
+        if (!state || state->m_local_set.size() >= MAX_INV_RECON_SET_SIZE) return false;
+        const auto [it, inserted] = state->m_local_set.try_emplace(state->ComputeShortID(inv.hash), inv);
+        return inserted || it->second.hash == inv.hash;
+    }
+
+    void TryRemovingFromReconSet(NodeId peer_id, const uint256& hash) EXCLUSIVE_LOCKS_REQUIRED(!m_txreconciliation_mutex)
+    {
+        AssertLockNotHeld(m_txreconciliation_mutex);
+        LOCK(m_txreconciliation_mutex);
+        TxReconciliationState* state = GetRegisteredState(peer_id);
+        if (!state) return;
+        auto it = state->m_local_set.find(state->ComputeShortID(hash));
+        if (it != state->m_local_set.end() && it->second.hash == hash) state->m_local_set.erase(it);
+    }
+
+    std::optional<uint16_t> InitiateReconciliation(NodeId peer_id, std::chrono::microseconds now) EXCLUSIVE_LOCKS_REQUIRED(!m_txreconciliation_mutex)
+    {
+        AssertLockNotHeld(m_txreconciliation_mutex);
+        LOCK(m_txreconciliation_mutex);
+        TxReconciliationState* state = GetRegisteredState(peer_id);
+        if (!state || !state->m_we_initiate || now < state->m_next_request) return std::nullopt;
+        // a peer that never answered is asked again after another interval
+        state->m_next_request = now + INV_RECON_REQUEST_INTERVAL;
+        state->m_in_flight = true;
+        return uint16_t(state->m_local_set.size());
+    }
+
+    std::optional<std::vector<uint8_t>> HandleReconciliationRequest(NodeId peer_id, uint16_t peer_set_size) EXCLUSIVE_LOCKS_REQUIRED(!m_txreconciliation_mutex)
+    {
+        AssertLockNotHeld(m_txreconciliation_mutex);
+        LOCK(m_txreconciliation_mutex);
+        TxReconciliationState* state = GetRegisteredState(peer_id);
+        if (!state || state->m_we_initiate) return std::nullopt;
+        // the outcome of the previous round never came, reconcile its items again
+        state->m_local_set.merge(state->m_sketched_set);
+        state->m_sketched_set.clear();
+        std::swap(state->m_sketched_set, state->m_local_set);
+        state->m_in_flight = true;
+        const size_t capacity{EstimateSketchCapacity(state->m_sketched_set.size(), peer_set_size)};
+        if (capacity > MAX_INV_RECON_SKETCH_CAPACITY) {
+            LogPrintLevel(BCLog::TXRECONCILIATION, BCLog::Level::Debug, "Governance set difference with peer=%d too large to sketch (capacity=%u)\n", peer_id, capacity);
+            return std::vector<uint8_t>{};
+        }
+        return SketchSet(state->m_sketched_set, capacity).Serialize();
+    }
+
+    std::optional<InvReconciliationResult> HandleSketch(NodeId peer_id, Span<const uint8_t> sketch_data) EXCLUSIVE_LOCKS_REQUIRED(!m_txreconciliation_mutex)
+    {
+        AssertLockNotHeld(m_txreconciliation_mutex);
+        LOCK(m_txreconciliation_mutex);
+        TxReconciliationState* state = GetRegisteredState(peer_id);
+        if (!state || !state->m_we_initiate || !state->m_in_flight) return std::nullopt;
+        state->m_in_flight = false;
+
+        InvReconciliationResult result;
+        // 32 bit elements take 4 bytes of sketch each
+        const size_t capacity{sketch_data.size() / 4};
+        if (capacity > 0 && capacity <= MAX_INV_RECON_SKETCH_CAPACITY && sketch_data.size() % 4 == 0) {
+            Minisketch their_sketch{node::MakeMinisketch32(capacity)};
+            their_sketch.Deserialize(sketch_data);
+            Minisketch our_sketch{SketchSet(state->m_local_set, capacity)};
+            if (const auto difference = our_sketch.Merge(their_sketch).Decode(capacity)) {
+                result.fSuccess = true;
+                for (const uint64_t element : *difference) {
+                    const uint32_t short_id{uint32_t(element)};
+                    auto it = state->m_local_set.find(short_id);
+                    if (it != state->m_local_set.end()) {
+                        result.vAnnounce.emplace_back(it->second);
+                    } else {
+                        result.vAsk.emplace_back(short_id);
+                    }
+                }
+            }
+        }
+        if (!result.fSuccess) {
+            LogPrintLevel(BCLog::TXRECONCILIATION, BCLog::Level::Debug, "Governance reconciliation with peer=%d failed, announcing %u items\n", peer_id, state->m_local_set.size());
+            result.vAnnounce = SetInventory(state->m_local_set);
+        }
+        // whatever remains was in both sets
+        state->m_local_set.clear();
+        return result;
+    }
+
+    std::optional<std::vector<CInv>> HandleReconciliationDiff(NodeId peer_id, bool success, const std::vector<uint32_t>& ask) EXCLUSIVE_LOCKS_REQUIRED(!m_txreconciliation_mutex)
+    {
+        AssertLockNotHeld(m_txreconciliation_mutex);
+        LOCK(m_txreconciliation_mutex);
+        TxReconciliationState* state = GetRegisteredState(peer_id);
+        if (!state || state->m_we_initiate || !state->m_in_flight) return std::nullopt;
+        state->m_in_flight = false;
+
+        std::vector<CInv> result;
+        if (!success) {
+            result = SetInventory(state->m_sketched_set);
+        } else {
+            for (const uint32_t short_id : ask) {
+                auto it = state->m_sketched_set.find(short_id);
+                if (it != state->m_sketched_set.end()) result.emplace_back(it->second);
+            }
+        }
+        state->m_sketched_set.clear();
+        return result;
+    }
+
+private:
+    TxReconciliationState* GetRegisteredState(NodeId peer_id) EXCLUSIVE_LOCKS_REQUIRED(m_txreconciliation_mutex)
+    {
+        AssertLockHeld(m_txreconciliation_mutex);
+        auto recon_state = m_states.find(peer_id);
+        if (recon_state == m_states.end()) return nullptr;
+        return std::get_if<TxReconciliationState>(&recon_state->second);
+    }
 };
 
 TxReconciliationTracker::TxReconciliationTracker(uint32_t recon_version) : m_impl{std::make_unique<TxReconciliationTracker::Impl>(recon_version)} {}
@@ -168,3 +332,34 @@ bool TxReconciliationTracker::IsPeerRegistered(NodeId peer_id) const
 {
     return m_impl->IsPeerRegistered(peer_id);
 }
+
+// SYSCOIN
+bool TxReconciliationTracker::AddToReconSet(NodeId peer_id, const CInv& inv)
+{
+    return m_impl->AddToReconSet(peer_id, inv);
+}
+
+void TxReconciliationTracker::TryRemovingFromReconSet(NodeId peer_id, const uint256& hash)
+{
+    m_impl->TryRemovingFromReconSet(peer_id, hash);
+}
+
+std::optional<uint16_t> TxReconciliationTracker::InitiateReconciliation(NodeId peer_id, std::chrono::microseconds now)
+{
+    return m_impl->InitiateReconciliation(peer_id, now);
+}
+
+std::optional<std::vector<uint8_t>> TxReconciliationTracker::HandleReconciliationRequest(NodeId peer_id, uint16_t peer_set_size)
+{
+    return m_impl->HandleReconciliationRequest(peer_id, peer_set_size);
+}
+
+std::optional<InvReconciliationResult> TxReconciliationTracker::HandleSketch(NodeId peer_id, Span<const uint8_t> sketch)
+{
+    return m_impl->HandleSketch(peer_id, sketch);
+}
+
+std::optional<std::vector<CInv>> TxReconciliationTracker::HandleReconciliationDiff(NodeId peer_id, bool success, const std::vector<uint32_t>& ask)
+{
+    return m_impl->HandleReconciliationDiff(peer_id, success, ask);
+}
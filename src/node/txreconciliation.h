@@ -6,13 +6,40 @@
 #define SYSCOIN_NODE_TXRECONCILIATION_H
 
 #include <net.h>
+#include <protocol.h>
+#include <span.h>
 #include <sync.h>
 
+#include <chrono>
 #include <memory>
+#include <optional>
 #include <tuple>
+#include <vector>
 
 /** Supported transaction reconciliation protocol version */
 static constexpr uint32_t TXRECONCILIATION_VERSION{1};
+// SYSCOIN
+/** How often an initiator reconciles governance inventory with each of its peers */
+static constexpr std::chrono::seconds INV_RECON_REQUEST_INTERVAL{8};
+/** Inventory kept for one peer before further items are flooded to it instead */
+static constexpr size_t MAX_INV_RECON_SET_SIZE{3000};
+/** Largest sketch sent, a bigger estimated difference makes both sides flood their sets */
+static constexpr size_t MAX_INV_RECON_SKETCH_CAPACITY{512};
+/** Share of the smaller set expected to differ on top of the difference in set sizes (see BIP-330) */
+static constexpr double INV_RECON_Q{0.25};
+
+/** Inventory announced through reconciliation to registered peers, governance objects and votes */
+bool IsReconcilableInv(const CInv& inv);
+
+/** What an initiator does with the sketch of a peer */
+struct InvReconciliationResult {
+    //! the difference decoded, otherwise both sides announce their whole set
+    bool fSuccess{false};
+    //! our inventory the peer is missing, announced with INV
+    std::vector<CInv> vAnnounce;
+    //! short ids the peer has and we don't, sent back in govrecondiff
+    std::vector<uint32_t> vAsk;
+};
 
 enum class ReconciliationRegisterResult {
     NOT_FOUND,
@@ -84,6 +111,43 @@ public:
      * Check if a peer is registered to reconcile transactions with us.
      */
     bool IsPeerRegistered(NodeId peer_id) const;
+
+    // SYSCOIN
+    /**
+     * Step 1. Keep inv for the next reconciliation with a registered peer instead of announcing it.
+     * Returns false if it has to be flooded, because the peer is not registered, its set is full
+     * or the short id collides with another item of the set.
+     */
+    bool AddToReconSet(NodeId peer_id, const CInv& inv);
+
+    /** The peer announced hash itself, there is no need to reconcile it anymore. */
+    void TryRemovingFromReconSet(NodeId peer_id, const uint256& hash);
+
+    /**
+     * Step 2. Returns the size of our set to send in reqgovrecon if it is time for us, as the
+     * initiator, to reconcile with the peer. The peer stays busy until its sketch arrived.
+     */
+    std::optional<uint16_t> InitiateReconciliation(NodeId peer_id, std::chrono::microseconds now);
+
+    /**
+     * Step 2. As the responder, sketch our set for the initiator (an empty sketch if the difference
+     * is too large). The set is put aside until the outcome arrives, new items go to the next round.
+     * Returns nullopt if the peer is not registered or does not initiate reconciliations with us.
+     */
+    std::optional<std::vector<uint8_t>> HandleReconciliationRequest(NodeId peer_id, uint16_t peer_set_size);
+
+    /**
+     * Step 3. As the initiator, combine the sketch of the peer with ours. Our set is cleared, what
+     * the peer misses has to be announced. Returns nullopt if no sketch was expected from the peer.
+     */
+    std::optional<InvReconciliationResult> HandleSketch(NodeId peer_id, Span<const uint8_t> sketch);
+
+    /**
+     * Step 4. As the responder, the inventory to announce once the initiator sent the outcome:
+     * the asked for items on success, the whole set put aside otherwise.
+     * Returns nullopt if no outcome was expected from the peer.
+     */
+    std::optional<std::vector<CInv>> HandleReconciliationDiff(NodeId peer_id, bool success, const std::vector<uint32_t>& ask);
 };
 
 #endif // SYSCOIN_NODE_TXRECONCILIATION_H
@@ -4,6 +4,10 @@
 
 #include <node/utxo_snapshot.h>
 
+#include <chain.h>
+#include <chainparams.h>
+#include <clientversion.h>
+#include <hash.h>
 #include <logging.h>
 #include <streams.h>
 #include <sync.h>
@@ -12,10 +16,19 @@
 #include <uint256.h>
 #include <util/fs.h>
 #include <validation.h>
+// SYSCOIN
+#include <evo/deterministicmns.h>
+#include <llmq/quorums_blockprocessor.h>
+#include <llmq/quorums_commitment.h>
+#include <services/assetconsensus.h>
 
+#include <algorithm>
 #include <cassert>
 #include <cstdio>
+#include <iterator>
+#include <map>
 #include <optional>
+#include <stdexcept>
 #include <string>
 
 namespace node {
@@ -92,4 +105,229 @@ std::optional<fs::path> FindSnapshotChainstateDir(const fs::path& data_dir)
     return std::nullopt;
 }
 
+// SYSCOIN
+namespace {
+/** First block whose masternode list goes into the auxiliary state, a full list is persisted for it */
+int GetAuxMNListStartHeight(const CBlockIndex& base)
+{
+    const auto& consensus = Params().GetConsensus();
+    // the quorums still signing at the base were built on lists of up to this many blocks before it
+    const int window = (consensus.llmqTypeChainLocks.signingActiveQuorumCount + 1) * consensus.llmqTypeChainLocks.dkgInterval;
+    int start = std::max(0, base.nHeight - window);
+    start -= start % CDeterministicMNManager::DISK_SNAPSHOT_PERIOD;
+    return std::max(start, consensus.DIP0003Height);
+}
+
+/** A list diff serialized with its updates ordered by internal id, so that the hash of the file doesn't depend on the order of a hash map */
+struct SortedListDiff {
+    const CDeterministicMNListDiff& diff;
+
+    template <typename Stream>
+    void Serialize(Stream& s) const
+    {
+        s << diff.addedMNs;
+        const std::map<uint64_t, CDeterministicMNStateDiff> updated(diff.updatedMNs.begin(), diff.updatedMNs.end());
+        WriteCompactSize(s, updated.size());
+        for (const auto& [internal_id, state_diff] : updated) {
+            WriteVarInt<Stream, VarIntMode::DEFAULT, uint64_t>(s, internal_id);
+            s << state_diff;
+        }
+        WriteCompactSize(s, diff.removedMns.size());
+        for (const auto& internal_id : diff.removedMns) {
+            WriteVarInt<Stream, VarIntMode::DEFAULT, uint64_t>(s, internal_id);
+        }
+    }
+};
+
+/** Write every record of a database in chunks of SNAPSHOT_AUX_CHUNK_SIZE, followed by an empty chunk */
+template <typename K, typename V>
+void WriteAuxRecords(HashedSourceWriter<CAutoFile>& writer, CDBWrapper& db, const std::function<void()>& interruption_point)
+{
+    std::unique_ptr<CDBIterator> pcursor(db.NewIterator());
+    std::vector<std::pair<K, V>> chunk;
+    chunk.reserve(SNAPSHOT_AUX_CHUNK_SIZE);
+    for (pcursor->SeekToFirst(); pcursor->Valid(); pcursor->Next()) {
+        K key;
+        V value;
+        if (pcursor->GetKey(key) && pcursor->GetValue(value)) {
+            chunk.emplace_back(std::move(key), std::move(value));
+        }
+        if (chunk.size() == SNAPSHOT_AUX_CHUNK_SIZE) {
+            interruption_point();
+            writer << chunk;
+            chunk.clear();
+        }
+    }
+    if (!chunk.empty()) {
+        writer << chunk;
+        chunk.clear();
+    }
+    writer << chunk;
+}
+
+/** Pass the chunks written by WriteAuxRecords to fn */
+template <typename K, typename V>
+void ReadAuxRecords(HashVerifier<CAutoFile>& verifier, const std::function<void(std::vector<std::pair<K, V>>&)>& fn)
+{
+    while (true) {
+        std::vector<std::pair<K, V>> chunk;
+        verifier >> chunk;
+        if (chunk.empty()) return;
+        fn(chunk);
+    }
+}
+} // namespace
+
+uint256 WriteSnapshotAuxState(CAutoFile& afile, const CBlockIndex& base, const std::function<void()>& interruption_point)
+{
+    AssertLockHeld(::cs_main);
+    HashedSourceWriter<CAutoFile> writer{afile};
+    writer << SnapshotAuxMetadata{base.GetBlockHash()};
+
+    // the masternode lists in the layout CDeterministicMNManager persists them in: in full at the first
+    // block and every DISK_SNAPSHOT_PERIOD blocks, as a diff to the list of the previous block otherwise
+    std::vector<CDeterministicMNList> vecLists;
+    std::vector<std::pair<uint256, CDeterministicMNListDiff>> vecDiffs;
+    if (deterministicMNManager && base.nHeight >= Params().GetConsensus().DIP0003Height) {
+        const int start_height = GetAuxMNListStartHeight(base);
+        CDeterministicMNList prevList;
+        for (int nHeight = start_height; nHeight <= base.nHeight; nHeight++) {
+            const CBlockIndex* pindex = base.GetAncestor(nHeight);
+            CDeterministicMNList list = deterministicMNManager->GetListForBlock(pindex);
+            if (nHeight == start_height || nHeight % CDeterministicMNManager::DISK_SNAPSHOT_PERIOD == 0) {
+                vecLists.push_back(list);
+            } else {
+                CDeterministicMNListDiff diff;
+                CDeterministicMNListNEVMAddressDiff diffNEVM;
+                prevList.BuildDiff(list, diff, diffNEVM);
+                vecDiffs.emplace_back(pindex->GetBlockHash(), std::move(diff));
+            }
+            prevList = std::move(list);
+        }
+    }
+    writer << vecLists;
+    WriteCompactSize(writer, vecDiffs.size());
+    for (const auto& [blockHash, diff] : vecDiffs) {
+        writer << blockHash << SortedListDiff{diff};
+    }
+    interruption_point();
+
+    if (llmq::quorumBlockProcessor) {
+        WriteAuxRecords<uint256, std::pair<llmq::CFinalCommitment, uint256>>(writer, llmq::quorumBlockProcessor->m_commitment_evoDb, interruption_point);
+    } else {
+        writer << std::vector<std::pair<uint256, std::pair<llmq::CFinalCommitment, uint256>>>{};
+    }
+    if (pnevmtxrootsdb && pnevmtxmintdb) {
+        WriteAuxRecords<uint256, NEVMTxRoot>(writer, *pnevmtxrootsdb, interruption_point);
+        WriteAuxRecords<uint256, bool>(writer, *pnevmtxmintdb, interruption_point);
+    } else {
+        writer << std::vector<std::pair<uint256, NEVMTxRoot>>{} << std::vector<std::pair<uint256, bool>>{};
+    }
+
+    LogPrintf("[snapshot] wrote auxiliary state of %s: %d masternode lists, %d list diffs\n",
+        base.GetBlockHash().ToString(), vecLists.size(), vecDiffs.size());
+    return writer.GetHash();
+}
+
+bool ReadSnapshotAuxState(const fs::path& path, const CBlockIndex& base, const uint256& expected_hash, bool import)
+{
+    CAutoFile afile{fsbridge::fopen(path, "rb"), CLIENT_VERSION};
+    if (afile.IsNull()) {
+        LogPrintf("[snapshot] failed to open auxiliary state file %s\n", fs::PathToString(path));
+        return false;
+    }
+    if (import && (!deterministicMNManager || !llmq::quorumBlockProcessor || !pnevmtxrootsdb || !pnevmtxmintdb)) {
+        LogPrintf("[snapshot] can't import auxiliary state, the Syscoin databases are not loaded\n");
+        return false;
+    }
+    HashVerifier<CAutoFile> verifier{afile};
+    uint256 hash;
+    size_t nCommitments{0}, nTxRoots{0}, nMints{0};
+    try {
+        SnapshotAuxMetadata metadata;
+        verifier >> metadata;
+        if (metadata.m_version != SNAPSHOT_AUX_VERSION) {
+            LogPrintf("[snapshot] auxiliary state version %d is not supported\n", metadata.m_version);
+            return false;
+        }
+        if (metadata.m_base_blockhash != base.GetBlockHash()) {
+            LogPrintf("[snapshot] auxiliary state is for block %s, not %s\n",
+                metadata.m_base_blockhash.ToString(), base.GetBlockHash().ToString());
+            return false;
+        }
+
+        // the lists and commitments are small, they are written at the end in one batch each
+        std::vector<CDeterministicMNList> vecLists;
+        verifier >> vecLists;
+        std::vector<std::pair<uint256, CDeterministicMNListDiff>> vecDiffs;
+        const uint64_t nDiffs = ReadCompactSize(verifier);
+        for (uint64_t i = 0; i < nDiffs; i++) {
+            auto& [blockHash, diff] = vecDiffs.emplace_back();
+            verifier >> blockHash >> diff;
+        }
+        std::vector<std::pair<uint256, std::pair<llmq::CFinalCommitment, uint256>>> vecCommitments;
+        ReadAuxRecords<uint256, std::pair<llmq::CFinalCommitment, uint256>>(verifier, [&](auto& chunk) {
+            std::move(chunk.begin(), chunk.end(), std::back_inserter(vecCommitments));
+        });
+        // the NEVM records are streamed through the write caches of their databases, which keeps the
+        // minted transactions filter up to date
+        ReadAuxRecords<uint256, NEVMTxRoot>(verifier, [&](auto& chunk) {
+            nTxRoots += chunk.size();
+            if (!import) return;
+            pnevmtxrootsdb->FlushDataToCache(NEVMTxRootMap(chunk.begin(), chunk.end()));
+            if (!pnevmtxrootsdb->FlushCacheToDisk()) {
+                throw std::runtime_error("failed to write NEVM tx roots");
+            }
+        });
+        ReadAuxRecords<uint256, bool>(verifier, [&](auto& chunk) {
+            nMints += chunk.size();
+            if (!import) return;
+            NEVMMintTxSet setMintTxs;
+            for (const auto& entry : chunk) {
+                setMintTxs.insert(entry.first);
+            }
+            pnevmtxmintdb->FlushDataToCache(setMintTxs);
+            if (!pnevmtxmintdb->FlushCacheToDisk()) {
+                throw std::runtime_error("failed to write NEVM minted transactions");
+            }
+        });
+        if (std::fgetc(afile.Get()) != EOF) {
+            LogPrintf("[snapshot] unexpected trailing data in auxiliary state file %s\n", fs::PathToString(path));
+            return false;
+        }
+        hash = verifier.GetHash();
+        if (hash != expected_hash) {
+            LogPrintf("[snapshot] bad auxiliary state hash: expected %s, got %s\n", expected_hash.ToString(), hash.ToString());
+            return false;
+        }
+        if (import) {
+            CDBBatch batchLists(*deterministicMNManager->m_evoDb);
+            for (const auto& list : vecLists) {
+                batchLists.Write(list.GetBlockHash(), list);
+            }
+            CDBBatch batchDiffs(*deterministicMNManager->m_evoDbDiffs);
+            for (const auto& [blockHash, diff] : vecDiffs) {
+                batchDiffs.Write(blockHash, SortedListDiff{diff});
+            }
+            CDBBatch batchCommitments(llmq::quorumBlockProcessor->m_commitment_evoDb);
+            for (const auto& [quorumHash, commitment] : vecCommitments) {
+                batchCommitments.Write(quorumHash, commitment);
+            }
+            if (!deterministicMNManager->m_evoDb->WriteBatch(batchLists, /*fSync=*/true) ||
+                !deterministicMNManager->m_evoDbDiffs->WriteBatch(batchDiffs, /*fSync=*/true) ||
+                !llmq::quorumBlockProcessor->m_commitment_evoDb.WriteBatch(batchCommitments, /*fSync=*/true)) {
+                throw std::runtime_error("failed to write masternode lists and quorum commitments");
+            }
+            llmq::quorumBlockProcessor->MinedCommitmentsChanged();
+        }
+        nCommitments = vecCommitments.size();
+        LogPrintf("[snapshot] %s auxiliary state of %s: %d masternode lists, %d list diffs, %d quorum commitments, %d NEVM tx roots, %d minted transactions\n",
+            import ? "imported" : "checked", base.GetBlockHash().ToString(), vecLists.size(), vecDiffs.size(), nCommitments, nTxRoots, nMints);
+    } catch (const std::exception& e) {
+        LogPrintf("[snapshot] failed to read auxiliary state file %s: %s\n", fs::PathToString(path), e.what());
+        return false;
+    }
+    return true;
+}
+
 } // namespace node
@@ -13,9 +13,12 @@
 #include <util/fs.h>
 
 #include <cstdint>
+#include <functional>
 #include <optional>
 #include <string_view>
 
+class CAutoFile;
+class CBlockIndex;
 class Chainstate;
 
 namespace node {
@@ -68,6 +71,49 @@ constexpr std::string_view SNAPSHOT_CHAINSTATE_SUFFIX = "_snapshot";
 //! Return a path to the snapshot-based chainstate dir, if one exists.
 std::optional<fs::path> FindSnapshotChainstateDir(const fs::path& data_dir);
 
+// SYSCOIN
+//! Suffix of the file written next to a snapshot with the Syscoin state as of its base block.
+constexpr std::string_view SNAPSHOT_AUX_SUFFIX = ".aux";
+
+//! Version of the auxiliary state file, bumped whenever one of its sections changes.
+static constexpr uint16_t SNAPSHOT_AUX_VERSION{1};
+
+//! Entries per chunk of the sections that are streamed from the databases.
+static constexpr size_t SNAPSHOT_AUX_CHUNK_SIZE{10000};
+
+//! Header of the auxiliary state file. It names the base block the state belongs to, because the
+//! coins snapshot and its auxiliary state are separate files.
+class SnapshotAuxMetadata
+{
+public:
+    uint16_t m_version{SNAPSHOT_AUX_VERSION};
+    uint256 m_base_blockhash;
+
+    SnapshotAuxMetadata() { }
+    explicit SnapshotAuxMetadata(const uint256& base_blockhash) : m_base_blockhash(base_blockhash) { }
+
+    SERIALIZE_METHODS(SnapshotAuxMetadata, obj) { READWRITE(obj.m_version, obj.m_base_blockhash); }
+};
+
+/**
+ * Write what a node needs besides the coins to validate the blocks after `base`. That is the
+ * masternode lists of the blocks the quorums active at the base were built on, all mined quorum
+ * commitments, the NEVM tx roots, and the minted bridge transactions. The caller holds cs_main
+ * after flushing the chainstate, so the state matches the coins of `base`.
+ *
+ * @returns the hash of the contents, which is committed as AssumeutxoData::hash_auxiliary
+ */
+uint256 WriteSnapshotAuxState(CAutoFile& afile, const CBlockIndex& base, const std::function<void()>& interruption_point)
+    EXCLUSIVE_LOCKS_REQUIRED(::cs_main);
+
+/**
+ * Read an auxiliary state file for `base` and check it against `expected_hash`. With `import`
+ * the contents are also written to the masternode, quorum and NEVM databases. Check the file
+ * without `import` first, so a corrupt file never leaves partial state behind, and import it
+ * once the snapshot chainstate is active.
+ */
+bool ReadSnapshotAuxState(const fs::path& path, const CBlockIndex& base, const uint256& expected_hash, bool import);
+
 } // namespace node
 
 #endif // SYSCOIN_NODE_UTXO_SNAPSHOT_H
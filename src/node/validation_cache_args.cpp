@@ -24,10 +24,14 @@ void ApplyArgsManOptions(const ArgsManager& argsman, ValidationCacheSizes& cache
         //    InitScriptExecutionCache create the minimum possible cache (2
         //    elements). Therefore, we can use 0 as a floor here.
         // 2. Multiply first, divide after to avoid integer truncation.
-        size_t clamped_size_each = std::max<int64_t>(*max_size, 0) * (1 << 20) / 2;
+        // SYSCOIN 3. A quarter goes to the BLS signature cache.
+        size_t clamped_size = std::max<int64_t>(*max_size, 0) * (1 << 20);
+        size_t bls_size = clamped_size / 4;
+        size_t clamped_size_each = (clamped_size - bls_size) / 2;
         cache_sizes = {
             .signature_cache_bytes = clamped_size_each,
             .script_execution_cache_bytes = clamped_size_each,
+            .bls_signature_cache_bytes = bls_size,
         };
     }
 }
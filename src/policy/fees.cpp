@@ -510,7 +510,10 @@ void TxConfirmStats::removeTx(unsigned int entryHeight, unsigned int nBestSeenHe
 bool CBlockPolicyEstimator::removeTx(uint256 hash, bool inBlock)
 {
     LOCK(m_cs_fee_estimator);
-    return _removeTx(hash, inBlock);
+    // SYSCOIN
+    if (!_removeTx(hash, inBlock)) return false;
+    InvalidateEstimates(/*fCountEvent=*/true);
+    return true;
 }
 
 bool CBlockPolicyEstimator::_removeTx(const uint256& hash, bool inBlock)
@@ -603,6 +606,8 @@ void CBlockPolicyEstimator::processTransaction(const CTxMemPoolEntry& entry, boo
     assert(bucketIndex == bucketIndex2);
     unsigned int bucketIndex3 = longStats->NewTx(txHeight, (double)feeRate.GetFeePerK());
     assert(bucketIndex == bucketIndex3);
+    // SYSCOIN
+    InvalidateEstimates(/*fCountEvent=*/true);
 }
 
 bool CBlockPolicyEstimator::processBlockTx(unsigned int nBlockHeight, const CTxMemPoolEntry* entry)
@@ -680,6 +685,8 @@ void CBlockPolicyEstimator::processBlock(unsigned int nBlockHeight,
 
     trackedTxs = 0;
     untrackedTxs = 0;
+    // SYSCOIN
+    InvalidateEstimates(/*fCountEvent=*/false);
 }
 
 CFeeRate CBlockPolicyEstimator::estimateFee(int confTarget) const
@@ -835,9 +842,38 @@ double CBlockPolicyEstimator::estimateConservativeFee(unsigned int doubleTarget,
  * estimates, however, required the 95% threshold at 2 * target be met for any
  * longer time horizons also.
  */
+// SYSCOIN
+void CBlockPolicyEstimator::InvalidateEstimates(bool fCountEvent)
+{
+    AssertLockHeld(m_cs_fee_estimator);
+    if (fCountEvent && ++m_estimate_cache_events < FEE_ESTIMATE_CACHE_EVENTS) return;
+    m_estimate_cache_events = 0;
+    LOCK(m_cs_estimate_cache);
+    m_estimate_cache.clear();
+}
+
 CFeeRate CBlockPolicyEstimator::estimateSmartFee(int confTarget, FeeCalculation *feeCalc, bool conservative) const
 {
+    {
+        LOCK(m_cs_estimate_cache);
+        const auto it{m_estimate_cache.find({confTarget, conservative})};
+        if (it != m_estimate_cache.end()) {
+            if (feeCalc) *feeCalc = it->second.second;
+            return it->second.first;
+        }
+    }
     LOCK(m_cs_fee_estimator);
+    FeeCalculation calc;
+    const CFeeRate feeRate{estimateSmartFeeLocked(confTarget, &calc, conservative)};
+    if (feeCalc) *feeCalc = calc;
+    LOCK(m_cs_estimate_cache);
+    m_estimate_cache.try_emplace({confTarget, conservative}, feeRate, calc);
+    return feeRate;
+}
+
+CFeeRate CBlockPolicyEstimator::estimateSmartFeeLocked(int confTarget, FeeCalculation *feeCalc, bool conservative) const
+{
+    AssertLockHeld(m_cs_fee_estimator);
 
     if (feeCalc) {
         feeCalc->desiredTarget = confTarget;
@@ -1007,6 +1043,8 @@ bool CBlockPolicyEstimator::Read(AutoFile& filein)
             nBestSeenHeight = nFileBestSeenHeight;
             historicalFirst = nFileHistoricalFirst;
             historicalBest = nFileHistoricalBest;
+            // SYSCOIN
+            InvalidateEstimates(/*fCountEvent=*/false);
         }
     }
     catch (const std::exception& e) {
@@ -1026,6 +1064,8 @@ void CBlockPolicyEstimator::FlushUnconfirmed()
         auto mi = mapMemPoolTxs.begin();
         _removeTx(mi->first, false); // this calls erase() on mapMemPoolTxs
     }
+    // SYSCOIN
+    InvalidateEstimates(/*fCountEvent=*/false);
     const auto endclear{SteadyClock::now()};
     LogPrint(BCLog::ESTIMATEFEE, "Recorded %u unconfirmed txs from mempool in %gs\n", num_entries, Ticks<SecondsDouble>(endclear - startclear));
 }
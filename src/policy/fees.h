@@ -34,6 +34,10 @@ static constexpr std::chrono::hours MAX_FILE_AGE{60};
 // Whether we allow importing a fee_estimates file older than MAX_FILE_AGE.
 static constexpr bool DEFAULT_ACCEPT_STALE_FEE_ESTIMATES{false};
 
+// SYSCOIN
+/** Cached estimateSmartFee results are computed again after a block or this many mempool transactions were added or removed */
+static constexpr unsigned int FEE_ESTIMATE_CACHE_EVENTS{100};
+
 class AutoFile;
 class CTxMemPoolEntry;
 class TxConfirmStats;
@@ -203,15 +207,15 @@ public:
     /** Process all the transactions that have been included in a block */
     void processBlock(unsigned int nBlockHeight,
                       std::vector<const CTxMemPoolEntry*>& entries)
-        EXCLUSIVE_LOCKS_REQUIRED(!m_cs_fee_estimator);
+        EXCLUSIVE_LOCKS_REQUIRED(!m_cs_fee_estimator, !m_cs_estimate_cache);
 
     /** Process a transaction accepted to the mempool*/
     void processTransaction(const CTxMemPoolEntry& entry, bool validFeeEstimate)
-        EXCLUSIVE_LOCKS_REQUIRED(!m_cs_fee_estimator);
+        EXCLUSIVE_LOCKS_REQUIRED(!m_cs_fee_estimator, !m_cs_estimate_cache);
 
     /** Remove a transaction from the mempool tracking stats*/
     bool removeTx(uint256 hash, bool inBlock)
-        EXCLUSIVE_LOCKS_REQUIRED(!m_cs_fee_estimator);
+        EXCLUSIVE_LOCKS_REQUIRED(!m_cs_fee_estimator, !m_cs_estimate_cache);
 
     /** DEPRECATED. Return a feerate estimate */
     CFeeRate estimateFee(int confTarget) const
@@ -223,7 +227,7 @@ public:
      *  valid over longer time horizons also.
      */
     CFeeRate estimateSmartFee(int confTarget, FeeCalculation *feeCalc, bool conservative) const
-        EXCLUSIVE_LOCKS_REQUIRED(!m_cs_fee_estimator);
+        EXCLUSIVE_LOCKS_REQUIRED(!m_cs_fee_estimator, !m_cs_estimate_cache);
 
     /** Return a specific fee estimate calculation with a given success
      * threshold and time horizon, and optionally return detailed data about
@@ -239,11 +243,11 @@ public:
 
     /** Read estimation data from a file */
     bool Read(AutoFile& filein)
-        EXCLUSIVE_LOCKS_REQUIRED(!m_cs_fee_estimator);
+        EXCLUSIVE_LOCKS_REQUIRED(!m_cs_fee_estimator, !m_cs_estimate_cache);
 
     /** Empty mempool transactions on shutdown to record failure to confirm for txs still in mempool */
     void FlushUnconfirmed()
-        EXCLUSIVE_LOCKS_REQUIRED(!m_cs_fee_estimator);
+        EXCLUSIVE_LOCKS_REQUIRED(!m_cs_fee_estimator, !m_cs_estimate_cache);
 
     /** Calculation of highest target that estimates are tracked for */
     unsigned int HighestTargetTracked(FeeEstimateHorizon horizon) const
@@ -251,7 +255,7 @@ public:
 
     /** Drop still unconfirmed transactions and record current estimations, if the fee estimation file is present. */
     void Flush()
-        EXCLUSIVE_LOCKS_REQUIRED(!m_cs_fee_estimator);
+        EXCLUSIVE_LOCKS_REQUIRED(!m_cs_fee_estimator, !m_cs_estimate_cache);
 
     /** Record current fee estimations. */
     void FlushFeeEstimates()
@@ -306,6 +310,17 @@ private:
     /** A non-thread-safe helper for the removeTx function */
     bool _removeTx(const uint256& hash, bool inBlock)
         EXCLUSIVE_LOCKS_REQUIRED(m_cs_fee_estimator);
+
+    // SYSCOIN
+    /** estimateSmartFee() results by (target, conservative), so frequent callers like wallet services only take m_cs_estimate_cache.
+     *  Lock order is m_cs_fee_estimator before m_cs_estimate_cache, results are stored before m_cs_fee_estimator is let go. */
+    mutable Mutex m_cs_estimate_cache;
+    mutable std::map<std::pair<int, bool>, std::pair<CFeeRate, FeeCalculation>> m_estimate_cache GUARDED_BY(m_cs_estimate_cache);
+    unsigned int m_estimate_cache_events GUARDED_BY(m_cs_fee_estimator){0};
+    /** Drop the cached estimates, after a block or every FEE_ESTIMATE_CACHE_EVENTS mempool events when fCountEvent */
+    void InvalidateEstimates(bool fCountEvent) EXCLUSIVE_LOCKS_REQUIRED(m_cs_fee_estimator, !m_cs_estimate_cache);
+    CFeeRate estimateSmartFeeLocked(int confTarget, FeeCalculation *feeCalc, bool conservative) const
+        EXCLUSIVE_LOCKS_REQUIRED(m_cs_fee_estimator);
 };
 
 class FeeFilterRounder
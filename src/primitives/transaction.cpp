@@ -71,9 +71,22 @@ CTxOut::CTxOut(const CAmount& nValueIn,  const CScript &scriptPubKeyIn)
 {
     nValue = nValueIn;
     scriptPubKey = scriptPubKeyIn;
-    vchNEVMData.clear();
+    vchNEVMData.reset();
     assetInfo.SetNull();
 }
+const std::vector<uint8_t>& CTxOut::GetNEVMData() const
+{
+    static const std::vector<uint8_t> vchEmpty;
+    return vchNEVMData ? *vchNEVMData : vchEmpty;
+}
+void CTxOut::SetNEVMData(std::vector<uint8_t>&& vchNEVMDataIn)
+{
+    if (vchNEVMDataIn.empty()) {
+        vchNEVMData.reset();
+    } else {
+        vchNEVMData = std::make_shared<const std::vector<uint8_t>>(std::move(vchNEVMDataIn));
+    }
+}
 std::string CTxOut::ToString() const
 {
     if(assetInfo.IsNull())
@@ -101,8 +114,17 @@ uint256 CTransaction::ComputeWitnessHash() const
     }
     return (CHashWriter{0} << *this).GetHash();
 }
-CTransaction::CTransaction(const CMutableTransaction& tx) : vin(tx.vin), vout(tx.vout), nVersion(tx.nVersion), nLockTime(tx.nLockTime), hash{ComputeHash()}, m_witness_hash{ComputeWitnessHash()} {}
-CTransaction::CTransaction(CMutableTransaction&& tx) : vin(std::move(tx.vin)), vout(std::move(tx.vout)), nVersion(tx.nVersion), nLockTime(tx.nLockTime), hash{ComputeHash()}, m_witness_hash{ComputeWitnessHash()} {}
+CTransaction::CTransaction(const CMutableTransaction& tx) : vin(tx.vin), vout(tx.vout), nVersion(tx.nVersion), nLockTime(tx.nLockTime), hash{ComputeHash()}, m_witness_hash{ComputeWitnessHash()}, m_mint{ComputeMint()} {}
+CTransaction::CTransaction(CMutableTransaction&& tx) : vin(std::move(tx.vin)), vout(std::move(tx.vout)), nVersion(tx.nVersion), nLockTime(tx.nLockTime), hash{ComputeHash()}, m_witness_hash{ComputeWitnessHash()}, m_mint{ComputeMint()} {}
+
+// SYSCOIN
+std::shared_ptr<const CMintSyscoin> CTransaction::ComputeMint() const
+{
+    if (!IsSyscoinMintTx(nVersion)) {
+        return nullptr;
+    }
+    return std::make_shared<const CMintSyscoin>(*this);
+}
 
 CAmount CTransaction::GetValueOut() const
 {
@@ -469,8 +491,47 @@ bool GetSyscoinData(const CMutableTransaction &mtx, std::vector<unsigned char> &
 	const CScript &scriptPubKey = mtx.vout[nOut].scriptPubKey;
 	return GetSyscoinData(scriptPubKey, vchData);
 }
+bool GetSyscoinData(const CTransaction &tx, Span<const unsigned char> &vchData, int& nOut)
+{
+	nOut = GetSyscoinDataOutput(tx);
+	if (nOut == -1) {
+		return false;
+    }
+	return GetSyscoinData(tx.vout[nOut].scriptPubKey, vchData);
+}
+bool GetSyscoinData(const CMutableTransaction &mtx, Span<const unsigned char> &vchData, int& nOut)
+{
+	nOut = GetSyscoinDataOutput(mtx);
+	if (nOut == -1) {
+		return false;
+    }
+	return GetSyscoinData(mtx.vout[nOut].scriptPubKey, vchData);
+}
 
-bool GetSyscoinData(const CScript &scriptPubKey, std::vector<unsigned char> &vchData)
+/** Like CScript::GetOp but returns the pushed data as a view into the script instead of a copy */
+static bool GetOpSpan(const CScript &script, CScript::const_iterator &pc, Span<const unsigned char> &vchData)
+{
+    const CScript::const_iterator pcOp = pc;
+    opcodetype opcode;
+    if (!script.GetOp(pc, opcode))
+        return false;
+    size_t nHeader;
+    if (opcode < OP_PUSHDATA1)
+        nHeader = 1;
+    else if (opcode == OP_PUSHDATA1)
+        nHeader = 2;
+    else if (opcode == OP_PUSHDATA2)
+        nHeader = 3;
+    else if (opcode == OP_PUSHDATA4)
+        nHeader = 5;
+    else
+        nHeader = pc - pcOp;
+    const size_t nOffset = (pcOp - script.begin()) + nHeader;
+    vchData = Span<const unsigned char>(script.data() + nOffset, (pc - script.begin()) - nOffset);
+    return true;
+}
+
+bool GetSyscoinData(const CScript &scriptPubKey, Span<const unsigned char> &vchData)
 {
 	CScript::const_iterator pc = scriptPubKey.begin();
 	opcodetype opcode;
@@ -479,21 +540,29 @@ bool GetSyscoinData(const CScript &scriptPubKey, std::vector<unsigned char> &vch
 	if (opcode != OP_RETURN) {
 		return false;
     }
-	if (!scriptPubKey.GetOp(pc, opcode, vchData))
+	if (!GetOpSpan(scriptPubKey, pc, vchData))
 		return false;
     // if witness script we get the next element which should be our MN data
-    if(!vchData.empty() && vchData[0] == 0xaa &&
+    if(vchData.size() >= 36 && vchData[0] == 0xaa &&
         vchData[1] == 0x21 &&
         vchData[2] == 0xa9 &&
-        vchData[3] == 0xed &&
-        vchData.size() >= 36) {
-        if (!scriptPubKey.GetOp(pc, opcode, vchData))
+        vchData[3] == 0xed) {
+        if (!GetOpSpan(scriptPubKey, pc, vchData))
 		    return false;
     }
     // shouldn't be another opcode after this
 	return !scriptPubKey.GetOp(pc, opcode);
 }
 
+bool GetSyscoinData(const CScript &scriptPubKey, std::vector<unsigned char> &vchData)
+{
+    Span<const unsigned char> vchView;
+    if (!GetSyscoinData(scriptPubKey, vchView))
+        return false;
+    vchData.assign(vchView.begin(), vchView.end());
+    return true;
+}
+
 CAssetAllocation::CAssetAllocation(const CTransaction &tx) {
     SetNull();
     UnserializeFromTx(tx);
@@ -518,9 +587,9 @@ CBurnSyscoin::CBurnSyscoin(const CMutableTransaction &mtx) {
     SetNull();
     UnserializeFromTx(mtx);
 }
-int CAssetAllocation::UnserializeFromData(const std::vector<unsigned char> &vchData) {
+int CAssetAllocation::UnserializeFromData(Span<const unsigned char> vchData) {
     try {
-        CDataStream dsAsset(vchData, SER_NETWORK, PROTOCOL_VERSION);
+        SpanReader dsAsset(SER_NETWORK, PROTOCOL_VERSION, vchData);
         Unserialize(dsAsset);
         return dsAsset.size();
     } catch (std::exception &e) {
@@ -529,7 +598,7 @@ int CAssetAllocation::UnserializeFromData(const std::vector<unsigned char> &vchD
 	return -1;
 }
 bool CAssetAllocation::UnserializeFromTx(const CTransaction &tx) {
-	std::vector<unsigned char> vchData;
+	Span<const unsigned char> vchData;
 	int nOut;
     if (!GetSyscoinData(tx, vchData, nOut))
     {
@@ -547,7 +616,7 @@ bool CAssetAllocation::UnserializeFromTx(const CTransaction &tx) {
     return true;
 }
 bool CAssetAllocation::UnserializeFromTx(const CMutableTransaction &mtx) {
-	std::vector<unsigned char> vchData;
+	Span<const unsigned char> vchData;
 	int nOut;
     if (!GetSyscoinData(mtx, vchData, nOut))
     {
@@ -563,9 +632,9 @@ bool CAssetAllocation::UnserializeFromTx(const CMutableTransaction &mtx) {
 	}
     return true;
 }
-int CMintSyscoin::UnserializeFromData(const std::vector<unsigned char> &vchData) {
+int CMintSyscoin::UnserializeFromData(Span<const unsigned char> vchData) {
     try {
-        CDataStream dsMS(vchData, SER_NETWORK, PROTOCOL_VERSION);
+        SpanReader dsMS(SER_NETWORK, PROTOCOL_VERSION, vchData);
         Unserialize(dsMS);
         return dsMS.size();
     } catch (std::exception &e) {
@@ -576,7 +645,7 @@ int CMintSyscoin::UnserializeFromData(const std::vector<unsigned char> &vchData)
 }
 
 bool CMintSyscoin::UnserializeFromTx(const CTransaction &tx) {
-    std::vector<unsigned char> vchData;
+    Span<const unsigned char> vchData;
     int nOut;
     if (!GetSyscoinData(tx, vchData, nOut))
     {
@@ -591,7 +660,7 @@ bool CMintSyscoin::UnserializeFromTx(const CTransaction &tx) {
     return true;
 }
 bool CMintSyscoin::UnserializeFromTx(const CMutableTransaction &mtx) {
-    std::vector<unsigned char> vchData;
+    Span<const unsigned char> vchData;
     int nOut;
     if (!GetSyscoinData(mtx, vchData, nOut))
     {
@@ -606,9 +675,9 @@ bool CMintSyscoin::UnserializeFromTx(const CMutableTransaction &mtx) {
     return true;
 }
 
-int CBurnSyscoin::UnserializeFromData(const std::vector<unsigned char> &vchData) {
+int CBurnSyscoin::UnserializeFromData(Span<const unsigned char> vchData) {
     try {
-        CDataStream dsMS(vchData, SER_NETWORK, PROTOCOL_VERSION);
+        SpanReader dsMS(SER_NETWORK, PROTOCOL_VERSION, vchData);
         Unserialize(dsMS);
         return dsMS.size();
     } catch (std::exception &e) {
@@ -618,7 +687,7 @@ int CBurnSyscoin::UnserializeFromData(const std::vector<unsigned char> &vchData)
 }
 
 bool CBurnSyscoin::UnserializeFromTx(const CTransaction &tx) {
-    std::vector<unsigned char> vchData;
+    Span<const unsigned char> vchData;
     int nOut;
     if (!GetSyscoinData(tx, vchData, nOut))
     {
@@ -633,7 +702,7 @@ bool CBurnSyscoin::UnserializeFromTx(const CTransaction &tx) {
     return true;
 }
 bool CBurnSyscoin::UnserializeFromTx(const CMutableTransaction &mtx) {
-    std::vector<unsigned char> vchData;
+    Span<const unsigned char> vchData;
     int nOut;
     if (!GetSyscoinData(mtx, vchData, nOut))
     {
@@ -708,8 +777,8 @@ bool CNEVMData::UnserializeFromTx(const CTransaction &tx, const int nVersion) {
 		SetNull();
 		return false;
 	}
-    if(!tx.vout[nOut].vchNEVMData.empty()) {
-        vchNEVMData = std::make_shared<const std::vector<uint8_t>>(tx.vout[nOut].vchNEVMData);
+    if(tx.vout[nOut].HasNEVMData()) {
+        vchNEVMData = tx.vout[nOut].vchNEVMData;
         if(vchNEVMData->size() > MAX_NEVM_DATA_BLOB) {
             SetNull();
             return false;
@@ -10,6 +10,7 @@
 #include <prevector.h>
 #include <script/script.h>
 #include <serialize.h>
+#include <span.h>
 #include <uint256.h>
 
 #include <cstddef>
@@ -453,7 +454,7 @@ public:
         if(fAllowPoDA) {
             std::vector<uint8_t> vchNEVMDataIn;
             s >> vchNEVMDataIn;
-            vchNEVMData = std::make_shared<const std::vector<uint8_t>>(vchNEVMDataIn);
+            vchNEVMData = std::make_shared<const std::vector<uint8_t>>(std::move(vchNEVMDataIn));
         }
     }
     inline void SetNull() { ClearData(); }
@@ -481,6 +482,31 @@ class MapPoDAPayloadMeta {
             READWRITE(obj.txid, obj.nSize, obj.nMedianTime);
         }
     };
+/** Serializes a shared PoDA payload like a plain byte vector, an empty payload is kept as nullptr */
+struct NEVMDataFormatter
+{
+    template<typename Stream>
+    void Ser(Stream& s, const std::shared_ptr<const std::vector<uint8_t>>& data)
+    {
+        if (data) {
+            s << *data;
+        } else {
+            WriteCompactSize(s, 0);
+        }
+    }
+
+    template<typename Stream>
+    void Unser(Stream& s, std::shared_ptr<const std::vector<uint8_t>>& data)
+    {
+        std::vector<uint8_t> vchData;
+        s >> vchData;
+        if (vchData.empty()) {
+            data.reset();
+        } else {
+            data = std::make_shared<const std::vector<uint8_t>>(std::move(vchData));
+        }
+    }
+};
 /** An output of a transaction.  It contains the public key that the next input
  * must be able to sign with to claim it.
  */
@@ -491,7 +517,8 @@ public:
     CScript scriptPubKey;
     // SYSCOIN
     CAssetCoinInfo assetInfo;
-    std::vector<uint8_t> vchNEVMData;
+    // PoDA payload, shared so outputs without one only pay for a pointer and CNEVMData can reference it without a copy
+    std::shared_ptr<const std::vector<uint8_t>> vchNEVMData;
     CTxOut()
     {
         SetNull();
@@ -499,25 +526,29 @@ public:
     // SYSCOIN
     CTxOut(const CAmount& nValueIn, const CScript &scriptPubKeyIn);
     CTxOut(const CAmount& nValueIn, const CScript &scriptPubKeyIn, const CAssetCoinInfo &assetInfoIn) : nValue(nValueIn), scriptPubKey(scriptPubKeyIn), assetInfo(assetInfoIn) {}
-    CTxOut(const CAmount& nValueIn, const CScript &scriptPubKeyIn, const std::vector<uint8_t> &vchNEVMDataIn)  : nValue(nValueIn), scriptPubKey(scriptPubKeyIn), vchNEVMData(vchNEVMDataIn) {}
+    CTxOut(const CAmount& nValueIn, const CScript &scriptPubKeyIn, const std::vector<uint8_t> &vchNEVMDataIn)  : nValue(nValueIn), scriptPubKey(scriptPubKeyIn) { SetNEVMData(std::vector<uint8_t>(vchNEVMDataIn)); }
     SERIALIZE_METHODS(CTxOut, obj)
     {
         READWRITE(obj.nValue, obj.scriptPubKey);
         if (obj.scriptPubKey.IsUnspendable() && IsSyscoinNEVMDataTx(s.GetTxVersion())) {
             if (!(s.GetType() & SER_NO_PODA) && s.GetType() & SER_NETWORK) {
-                READWRITE(obj.vchNEVMData);
+                READWRITE(Using<NEVMDataFormatter>(obj.vchNEVMData));
             } else if(s.GetType() == SER_SIZE) {
-                s.seek(obj.vchNEVMData.size() * NEVM_DATA_SCALE_FACTOR);
+                s.seek(obj.GetNEVMData().size() * NEVM_DATA_SCALE_FACTOR);
             }
         }
     }
+    // SYSCOIN
+    bool HasNEVMData() const { return vchNEVMData && !vchNEVMData->empty(); }
+    const std::vector<uint8_t>& GetNEVMData() const;
+    void SetNEVMData(std::vector<uint8_t>&& vchNEVMDataIn);
 
     void SetNull()
     {
         assetInfo.SetNull();
         nValue = -1;
         scriptPubKey.clear();
-        vchNEVMData.clear();
+        vchNEVMData.reset();
     }
 
     bool IsNull() const
@@ -530,7 +561,7 @@ public:
         return (a.nValue       == b.nValue &&
                 a.scriptPubKey == b.scriptPubKey &&
                 a.assetInfo    == b.assetInfo &&
-                a.vchNEVMData  == b.vchNEVMData);
+                a.GetNEVMData()  == b.GetNEVMData());
     }
 
     friend bool operator!=(const CTxOut& a, const CTxOut& b)
@@ -601,6 +632,9 @@ inline CAmount CalculateOutputValue(const TxType& tx)
 }
 
 
+// SYSCOIN
+class CMintSyscoin;
+
 /** The basic transaction that is broadcasted on the network and contained in
  * blocks.  A transaction can contain multiple inputs and outputs.
  */
@@ -624,9 +658,14 @@ private:
     /** Memory only. */
     const uint256 hash;
     const uint256 m_witness_hash;
+    // SYSCOIN
+    /** Memory only. Decoded payload of a mint transaction, null for other versions. */
+    const std::shared_ptr<const CMintSyscoin> m_mint;
 
     uint256 ComputeHash() const;
     uint256 ComputeWitnessHash() const;
+    // SYSCOIN
+    std::shared_ptr<const CMintSyscoin> ComputeMint() const;
 
 public:
     /** Convert a CMutableTransaction into a CTransaction. */
@@ -648,6 +687,9 @@ public:
 
     const uint256& GetHash() const { return hash; }
     const uint256& GetWitnessHash() const { return m_witness_hash; };
+    // SYSCOIN
+    /** The mint payload decoded once at construction, IsNull() if it is malformed. Only set for mint transactions. */
+    const std::shared_ptr<const CMintSyscoin>& GetMintSyscoin() const { return m_mint; }
 
     // Return sum of txouts.
     CAmount GetValueOut() const;
@@ -773,7 +815,7 @@ public:
     inline bool IsNull() const { return voutAssets.empty();}
     bool UnserializeFromTx(const CTransaction &tx);
     bool UnserializeFromTx(const CMutableTransaction &mtx);
-	int UnserializeFromData(const std::vector<unsigned char> &vchData);
+	int UnserializeFromData(Span<const unsigned char> vchData);
 	void SerializeData(std::vector<unsigned char>& vchData);
 };
 
@@ -806,7 +848,7 @@ public:
 
     inline void SetNull() { voutAssets.clear(); posTx = 0; nTxRoot.SetNull(); nReceiptRoot.SetNull(); vchTxParentNodes.clear(); vchTxPath.clear(); posReceipt = 0; vchReceiptParentNodes.clear(); nTxHash.SetNull(); nBlockHash.SetNull();  }
     inline bool IsNull() const { return (voutAssets.empty() && posTx == 0 && posReceipt == 0); }
-    int UnserializeFromData(const std::vector<unsigned char> &vchData);
+    int UnserializeFromData(Span<const unsigned char> vchData);
     bool UnserializeFromTx(const CTransaction &tx);
     bool UnserializeFromTx(const CMutableTransaction &mtx);
     void SerializeData(std::vector<unsigned char>& vchData);
@@ -829,7 +871,7 @@ public:
 
     inline void SetNull() { voutAssets.clear(); vchNEVMAddress.clear();  }
     inline bool IsNull() const { return (vchNEVMAddress.empty() && voutAssets.empty()); }
-    int UnserializeFromData(const std::vector<unsigned char> &vchData);
+    int UnserializeFromData(Span<const unsigned char> vchData);
     bool UnserializeFromTx(const CTransaction &tx);
     bool UnserializeFromTx(const CMutableTransaction &mtx);
     void SerializeData(std::vector<unsigned char>& vchData);
@@ -882,6 +924,10 @@ int GetSyscoinDataOutput(const CMutableTransaction& mtx);
 bool GetSyscoinData(const CTransaction &tx, std::vector<unsigned char> &vchData, int& nOut);
 bool GetSyscoinData(const CMutableTransaction &mtx, std::vector<unsigned char> &vchData, int& nOut);
 bool GetSyscoinData(const CScript &scriptPubKey, std::vector<unsigned char> &vchData);
+/** Views of the payload inside the script, valid as long as the script is */
+bool GetSyscoinData(const CTransaction &tx, Span<const unsigned char> &vchData, int& nOut);
+bool GetSyscoinData(const CMutableTransaction &mtx, Span<const unsigned char> &vchData, int& nOut);
+bool GetSyscoinData(const CScript &scriptPubKey, Span<const unsigned char> &vchData);
 typedef std::vector<std::vector<uint8_t> > NEVMDataVec;
 typedef std::unordered_map<uint256, NEVMTxRoot, StaticSaltedHasher> NEVMTxRootMap;
 typedef std::map<std::vector<uint8_t>, MapPoDAPayloadMeta > PoDAMAPMemory;
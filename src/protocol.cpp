@@ -70,6 +70,13 @@ const char *QSIGSHARE="qsigshare";
 const char *CLSIG="clsig";
 const char *GETCLSIG="getclsig";
 const char *MNAUTH="mnauth";
+const char *SENDBLOBS="sendblobs";
+const char *GETBLOBCHUNK="getblobchunk";
+const char *BLOBCHUNK="blobchunk";
+const char *TXSIZEHINTS="txsizehints";
+const char *REQGOVRECON="reqgovrecon";
+const char *GOVSKETCH="govsketch";
+const char *GOVRECONDIFF="govrecondiff";
 } // namespace NetMsgType
 
 /** All known message types. Keep this in the same order as the list of
@@ -127,6 +134,13 @@ const static std::vector<std::string> g_all_net_message_types{
     NetMsgType::CLSIG,
     NetMsgType::GETCLSIG,
     NetMsgType::MNAUTH,  
+    NetMsgType::SENDBLOBS,
+    NetMsgType::GETBLOBCHUNK,
+    NetMsgType::BLOBCHUNK,
+    NetMsgType::TXSIZEHINTS,
+    NetMsgType::REQGOVRECON,
+    NetMsgType::GOVSKETCH,
+    NetMsgType::GOVRECONDIFF,
     NetMsgType::GETCFILTERS,
     NetMsgType::CFILTER,
     NetMsgType::GETCFHEADERS,
@@ -282,6 +282,29 @@ extern const char *QSIGSHARE;
 extern const char *CLSIG;
 extern const char *GETCLSIG;
 extern const char *MNAUTH;
+/**
+ * Indicates that a node wants blob transactions in blocktxn without their PoDA
+ * blob and fetches missing blobs with getblobchunk. Sent between VERSION and VERACK.
+ */
+extern const char *SENDBLOBS;
+/** Requests chunks of PoDA blobs by version hash. */
+extern const char *GETBLOBCHUNK;
+/** One chunk of a PoDA blob, the answer to getblobchunk. */
+extern const char *BLOBCHUNK;
+/**
+ * Sizes of the PoDA blob transactions announced by the inv that follows, sent
+ * to sendblobs peers so they schedule the large downloads after the small ones.
+ */
+extern const char *TXSIZEHINTS;
+/**
+ * Asks a txreconciliation peer for a sketch of the governance inventory it has
+ * not announced to us yet, contains the size of our own set.
+ */
+extern const char *REQGOVRECON;
+/** Minisketch of the short ids of governance inventory, the answer to reqgovrecon. */
+extern const char *GOVSKETCH;
+/** Outcome of a governance reconciliation and the short ids the initiator is missing. */
+extern const char *GOVRECONDIFF;
 /**
  * Contains a 4-byte version number and an 8-byte salt.
  * The salt is used to compute short txids needed for efficient
@@ -4,6 +4,7 @@
 #include <evo/deterministicmns.h>
 #include <masternode/activemasternode.h>
 #include <qt/clientmodel.h>
+#include <qt/masternodetablemodel.h>
 #include <clientversion.h>
 #include <coins.h>
 #include <qt/guiutil.h>
@@ -17,6 +18,7 @@
 #include <univalue.h>
 
 #include <QMessageBox>
+#include <QSortFilterProxyModel>
 #include <QTimer>
 #include <QtGui/QClipboard>
 #include <interfaces/node.h>
@@ -38,41 +40,7 @@ MasternodeList::MasternodeList(QWidget* parent) :
 {
     ui->setupUi(this);
 
-    int columnAddressWidth = 200;
-    int columnStatusWidth = 80;
-    int columnPoSeScoreWidth = 80;
-    int columnRegisteredWidth = 80;
-    int columnLastPaidWidth = 80;
-    int columnNextPaymentWidth = 100;
-    int columnPayeeWidth = 130;
-    int columnOperatorRewardWidth = 130;
-    int columnCollateralWidth = 130;
-    int columnOwnerWidth = 130;
-    int columnVotingWidth = 130;
-
-    ui->tableWidgetMasternodesDIP3->setColumnWidth(0, columnAddressWidth);
-    ui->tableWidgetMasternodesDIP3->setColumnWidth(1, columnStatusWidth);
-    ui->tableWidgetMasternodesDIP3->setColumnWidth(2, columnPoSeScoreWidth);
-    ui->tableWidgetMasternodesDIP3->setColumnWidth(3, columnRegisteredWidth);
-    ui->tableWidgetMasternodesDIP3->setColumnWidth(4, columnLastPaidWidth);
-    ui->tableWidgetMasternodesDIP3->setColumnWidth(5, columnNextPaymentWidth);
-    ui->tableWidgetMasternodesDIP3->setColumnWidth(6, columnPayeeWidth);
-    ui->tableWidgetMasternodesDIP3->setColumnWidth(7, columnOperatorRewardWidth);
-    ui->tableWidgetMasternodesDIP3->setColumnWidth(8, columnCollateralWidth);
-    ui->tableWidgetMasternodesDIP3->setColumnWidth(9, columnOwnerWidth);
-    ui->tableWidgetMasternodesDIP3->setColumnWidth(10, columnVotingWidth);
-
-    int columnNEVMAddressWidth = 130;
-
-    ui->tableWidgetMasternodesDIP3->insertColumn(11);
-    ui->tableWidgetMasternodesDIP3->setHorizontalHeaderItem(11, new QTableWidgetItem(tr("NEVM Address")));
-    ui->tableWidgetMasternodesDIP3->setColumnWidth(11, columnNEVMAddressWidth);
-    
-    ui->tableWidgetMasternodesDIP3->insertColumn(12);
-    ui->tableWidgetMasternodesDIP3->setColumnHidden(12, true);
-    
-
-    ui->tableWidgetMasternodesDIP3->setContextMenuPolicy(Qt::CustomContextMenu);
+    ui->tableViewMasternodesDIP3->setContextMenuPolicy(Qt::CustomContextMenu);
 
     ui->filterLineEditDIP3->setPlaceholderText(tr("Filter by any property (e.g. address or protx hash)"));
     ui->checkBoxMyMasternodesOnly->setEnabled(false);
@@ -93,8 +61,8 @@ MasternodeList::MasternodeList(QWidget* parent) :
     contextMenuDIP3->addSeparator();
     contextMenuDIP3->addAction(copyProTxHashAction);
     contextMenuDIP3->addAction(copyCollateralOutpointAction);
-    connect(ui->tableWidgetMasternodesDIP3, &QWidget::customContextMenuRequested, this, &MasternodeList::showContextMenuDIP3);
-    connect(ui->tableWidgetMasternodesDIP3, &QTableView::doubleClicked, this, &MasternodeList::extraInfoDIP3_clicked);
+    connect(ui->tableViewMasternodesDIP3, &QWidget::customContextMenuRequested, this, &MasternodeList::showContextMenuDIP3);
+    connect(ui->tableViewMasternodesDIP3, &QTableView::doubleClicked, this, &MasternodeList::extraInfoDIP3_clicked);
     connect(copyProTxHashAction, &QAction::triggered, this, &MasternodeList::copyProTxHash_clicked);
     connect(copyCollateralOutpointAction, &QAction::triggered, this, &MasternodeList::copyCollateralOutpoint_clicked);
     connect(copyServiceAction, &QAction::triggered, this, &MasternodeList::copyService_clicked);
@@ -119,9 +87,43 @@ MasternodeList::~MasternodeList()
 void MasternodeList::setClientModel(ClientModel* model)
 {
     this->clientModel = model;
+    // the table model works with the client model on its own thread, it must not outlive it
+    if (masternodeModel) {
+        ui->tableViewMasternodesDIP3->setModel(nullptr);
+        delete proxyModel;
+        proxyModel = nullptr;
+        delete masternodeModel;
+        masternodeModel = nullptr;
+    }
     if (model) {
+        masternodeModel = new MasternodeTableModel(*model, this);
+        masternodeModel->setWalletModel(walletModel, ui->checkBoxMyMasternodesOnly->isChecked());
+        connect(masternodeModel, &MasternodeTableModel::listUpdated, this, &MasternodeList::updateCountLabel);
+
+        proxyModel = new QSortFilterProxyModel(this);
+        proxyModel->setSourceModel(masternodeModel);
+        proxyModel->setSortRole(MasternodeTableModel::SortRole);
+        proxyModel->setFilterKeyColumn(-1);
+        proxyModel->setFilterFixedString(strCurrentFilterDIP3);
+        ui->tableViewMasternodesDIP3->setModel(proxyModel);
+
+        ui->tableViewMasternodesDIP3->setColumnWidth(MasternodeTableModel::Service, 200);
+        ui->tableViewMasternodesDIP3->setColumnWidth(MasternodeTableModel::Status, 80);
+        ui->tableViewMasternodesDIP3->setColumnWidth(MasternodeTableModel::PoSeScore, 80);
+        ui->tableViewMasternodesDIP3->setColumnWidth(MasternodeTableModel::Registered, 80);
+        ui->tableViewMasternodesDIP3->setColumnWidth(MasternodeTableModel::LastPaid, 80);
+        ui->tableViewMasternodesDIP3->setColumnWidth(MasternodeTableModel::NextPayment, 100);
+        ui->tableViewMasternodesDIP3->setColumnWidth(MasternodeTableModel::Payee, 130);
+        ui->tableViewMasternodesDIP3->setColumnWidth(MasternodeTableModel::OperatorReward, 130);
+        ui->tableViewMasternodesDIP3->setColumnWidth(MasternodeTableModel::Collateral, 130);
+        ui->tableViewMasternodesDIP3->setColumnWidth(MasternodeTableModel::Owner, 130);
+        ui->tableViewMasternodesDIP3->setColumnWidth(MasternodeTableModel::Voting, 130);
+        ui->tableViewMasternodesDIP3->setColumnWidth(MasternodeTableModel::NEVMAddress, 130);
+        ui->tableViewMasternodesDIP3->setColumnHidden(MasternodeTableModel::ProTxHash, true);
+
         // try to update list when masternode count changes
         connect(clientModel, &ClientModel::masternodeListChanged, this, &MasternodeList::handleMasternodeListChanged);
+        mnListChanged = true;
     }
 }
 
@@ -129,40 +131,40 @@ void MasternodeList::setWalletModel(WalletModel* model)
 {
     this->walletModel = model;
     ui->checkBoxMyMasternodesOnly->setEnabled(model != nullptr);
+    if (masternodeModel) {
+        masternodeModel->setWalletModel(model, ui->checkBoxMyMasternodesOnly->isChecked());
+    }
 }
 
 void MasternodeList::showContextMenuDIP3(const QPoint& point)
 {
-    QTableWidgetItem* item = ui->tableWidgetMasternodesDIP3->itemAt(point);
-    if (item) contextMenuDIP3->exec(QCursor::pos());
+    if (ui->tableViewMasternodesDIP3->indexAt(point).isValid()) contextMenuDIP3->exec(QCursor::pos());
 }
 
 void MasternodeList::handleMasternodeListChanged()
 {
-    LOCK(cs_dip3list);
     mnListChanged = true;
 }
 
 void MasternodeList::updateDIP3ListScheduled()
 {
-    TRY_LOCK(cs_dip3list, fLockAcquired);
-    if (!fLockAcquired) return;
-
-    if (!clientModel || clientModel->node().shutdownRequested()) {
+    if (!clientModel || !masternodeModel || clientModel->node().shutdownRequested()) {
         return;
     }
 
-    // To prevent high cpu usage update only once in MASTERNODELIST_FILTER_COOLDOWN_SECONDS seconds
+    // To prevent high cpu usage filter only once in MASTERNODELIST_FILTER_COOLDOWN_SECONDS seconds
     // after filter was last changed unless we want to force the update.
     if (fFilterUpdatedDIP3) {
         int64_t nSecondsToWait = nTimeFilterUpdatedDIP3 - GetTime() + MASTERNODELIST_FILTER_COOLDOWN_SECONDS;
         ui->countLabelDIP3->setText(QString::fromStdString(strprintf("Please wait... %d", nSecondsToWait)));
 
         if (nSecondsToWait <= 0) {
-            updateDIP3List();
+            proxyModel->setFilterFixedString(strCurrentFilterDIP3);
             fFilterUpdatedDIP3 = false;
+            updateCountLabel();
         }
-    } else if (mnListChanged) {
+    }
+    if (mnListChanged) {
         int64_t nMnListUpdateSecods = clientModel->masternodeSync().isBlockchainSynced() ? MASTERNODELIST_UPDATE_SECONDS : MASTERNODELIST_UPDATE_SECONDS*10;
         int64_t nSecondsToWait = nTimeUpdatedDIP3 - GetTime() + nMnListUpdateSecods;
 
@@ -175,148 +177,19 @@ void MasternodeList::updateDIP3ListScheduled()
 
 void MasternodeList::updateDIP3List()
 {
-    if (!clientModel || clientModel->node().shutdownRequested()) {
+    if (!clientModel || !masternodeModel || clientModel->node().shutdownRequested()) {
         return;
     }
 
-    auto mnList = clientModel->getMasternodeList();
-    std::map<uint256, CTxDestination> mapCollateralDests;
-
-    {
-        // Get all UTXOs for each MN collateral in one go so that we can reduce locking overhead for cs_main
-        // We also do this outside of the below Qt list update loop to reduce cs_main locking time to a minimum
-        mnList.ForEachMN(false, [&](auto& dmn) {
-            CTxDestination collateralDest;
-            Coin coin;
-            if (clientModel->node().getUnspentOutput(dmn.collateralOutpoint, coin) && ExtractDestination(coin.out.scriptPubKey, collateralDest)) {
-                mapCollateralDests.emplace(dmn.proTxHash, collateralDest);
-            }
-        });
-    }
-
-    LOCK(cs_dip3list);
-
-    QString strToFilter;
-    ui->countLabelDIP3->setText("Updating...");
-    ui->tableWidgetMasternodesDIP3->setSortingEnabled(false);
-    ui->tableWidgetMasternodesDIP3->clearContents();
-    ui->tableWidgetMasternodesDIP3->setRowCount(0);
-
     nTimeUpdatedDIP3 = GetTime();
+    // the list is diffed and formatted on the model's thread, the rows follow once that is done
+    masternodeModel->refresh();
+}
 
-    auto projectedPayees = mnList.GetProjectedMNPayees();
-    std::map<uint256, int> nextPayments;
-    for (size_t i = 0; i < projectedPayees.size(); i++) {
-        const auto& dmn = projectedPayees[i];
-        nextPayments.emplace(dmn->proTxHash, mnList.GetHeight() + (int)i + 1);
-    }
-
-    std::set<COutPoint> setOutpts;
-    if (walletModel && ui->checkBoxMyMasternodesOnly->isChecked()) {
-        std::vector<COutPoint> vOutpts;
-        walletModel->wallet().listProTxCoins(vOutpts);
-        for (const auto& outpt : vOutpts) {
-            setOutpts.emplace(outpt);
-        }
-    }
-
-    mnList.ForEachMN(false, [&](auto& dmn) {
-        if (walletModel && ui->checkBoxMyMasternodesOnly->isChecked()) {
-            bool fMyMasternode = setOutpts.count(dmn.collateralOutpoint) ||
-                walletModel->wallet().isSpendable(CTxDestination(WitnessV0KeyHash(dmn.pdmnState->keyIDOwner))) ||
-                walletModel->wallet().isSpendable(CTxDestination(WitnessV0KeyHash(dmn.pdmnState->keyIDVoting))) ||
-                walletModel->wallet().isSpendable(dmn.pdmnState->scriptPayout) ||
-                walletModel->wallet().isSpendable(dmn.pdmnState->scriptOperatorPayout);
-            if (!fMyMasternode) return;
-        }
-        // populate list
-        // Address, Protocol, Status, Active Seconds, Last Seen, Pub Key
-        QTableWidgetItem* addressItem = new QTableWidgetItem(QString::fromStdString(dmn.pdmnState->addr.ToStringAddrPort()));
-        QTableWidgetItem* statusItem = new QTableWidgetItem(mnList.IsMNValid(dmn) ? tr("ENABLED") : (mnList.IsMNPoSeBanned(dmn) ? tr("POSE_BANNED") : tr("UNKNOWN")));
-        QTableWidgetItem* PoSeScoreItem = new QTableWidgetItem(QString::number(dmn.pdmnState->nPoSePenalty));
-        QTableWidgetItem* registeredItem = new QTableWidgetItem(QString::number(dmn.pdmnState->nRegisteredHeight));
-        QTableWidgetItem* lastPaidItem = new QTableWidgetItem(QString::number(dmn.pdmnState->nLastPaidHeight));
-        
-        QTableWidgetItem* nextPaymentItem = new QTableWidgetItem(nextPayments.count(dmn.proTxHash) ? QString::number(nextPayments[dmn.proTxHash]) : tr("UNKNOWN"));
-        // Add NEVM Address
-        QString nevmAddressStr = QString::fromStdString(HexStr(dmn.pdmnState->vchNEVMAddress));
-        QTableWidgetItem* nevmAddressItem = new QTableWidgetItem(nevmAddressStr);
-
-        CTxDestination payeeDest;
-        QString payeeStr = tr("UNKNOWN");
-        if (ExtractDestination(dmn.pdmnState->scriptPayout, payeeDest)) {
-            payeeStr = QString::fromStdString(EncodeDestination(payeeDest));
-        }
-        QTableWidgetItem* payeeItem = new QTableWidgetItem(payeeStr);
-
-        QString operatorRewardStr = tr("NONE");
-        if (dmn.nOperatorReward) {
-            operatorRewardStr = QString::number(dmn.nOperatorReward / 100.0, 'f', 2) + "% ";
-
-            if (dmn.pdmnState->scriptOperatorPayout != CScript()) {
-                CTxDestination operatorDest;
-                if (ExtractDestination(dmn.pdmnState->scriptOperatorPayout, operatorDest)) {
-                    operatorRewardStr += tr("to %1").arg(QString::fromStdString(EncodeDestination(operatorDest)));
-                } else {
-                    operatorRewardStr += tr("to UNKNOWN");
-                }
-            } else {
-                operatorRewardStr += tr("but not claimed");
-            }
-        }
-        QTableWidgetItem* operatorRewardItem = new QTableWidgetItem(operatorRewardStr);
-
-        QString collateralStr = tr("UNKNOWN");
-        auto collateralDestIt = mapCollateralDests.find(dmn.proTxHash);
-        if (collateralDestIt != mapCollateralDests.end()) {
-            collateralStr = QString::fromStdString(EncodeDestination(collateralDestIt->second));
-        }
-        QTableWidgetItem* collateralItem = new QTableWidgetItem(collateralStr);
-
-        QString ownerStr = QString::fromStdString(EncodeDestination(WitnessV0KeyHash(dmn.pdmnState->keyIDOwner)));
-        QTableWidgetItem* ownerItem = new QTableWidgetItem(ownerStr);
-
-        QString votingStr = QString::fromStdString(EncodeDestination(WitnessV0KeyHash(dmn.pdmnState->keyIDVoting)));
-        QTableWidgetItem* votingItem = new QTableWidgetItem(votingStr);
-
-        QTableWidgetItem* proTxHashItem = new QTableWidgetItem(QString::fromStdString(dmn.proTxHash.ToString()));
-
-        if (strCurrentFilterDIP3 != "") {
-            strToFilter = addressItem->text() + " " +
-                        statusItem->text() + " " +
-                        PoSeScoreItem->text() + " " +
-                        registeredItem->text() + " " +
-                        lastPaidItem->text() + " " +
-                        nextPaymentItem->text() + " " +
-                        payeeItem->text() + " " +
-                        operatorRewardItem->text() + " " +
-                        collateralItem->text() + " " +
-                        ownerItem->text() + " " +
-                        votingItem->text() + " " +
-                        nevmAddressItem->text() + " " +
-                        proTxHashItem->text();
-            if (!strToFilter.contains(strCurrentFilterDIP3)) return;
-        }
-
-        ui->tableWidgetMasternodesDIP3->insertRow(0);
-        ui->tableWidgetMasternodesDIP3->setItem(0, 0, addressItem);
-        ui->tableWidgetMasternodesDIP3->setItem(0, 1, statusItem);
-        ui->tableWidgetMasternodesDIP3->setItem(0, 2, PoSeScoreItem);
-        ui->tableWidgetMasternodesDIP3->setItem(0, 3, registeredItem);
-        ui->tableWidgetMasternodesDIP3->setItem(0, 4, lastPaidItem);
-        ui->tableWidgetMasternodesDIP3->setItem(0, 5, nextPaymentItem);
-        ui->tableWidgetMasternodesDIP3->setItem(0, 6, payeeItem);
-        ui->tableWidgetMasternodesDIP3->setItem(0, 7, operatorRewardItem);
-        ui->tableWidgetMasternodesDIP3->setItem(0, 8, collateralItem);
-        ui->tableWidgetMasternodesDIP3->setItem(0, 9, ownerItem);
-        ui->tableWidgetMasternodesDIP3->setItem(0, 10, votingItem);
-        ui->tableWidgetMasternodesDIP3->setItem(0, 11, nevmAddressItem);
-        ui->tableWidgetMasternodesDIP3->setItem(0, 12, proTxHashItem);
-        
-    });
-
-    ui->countLabelDIP3->setText(QString::number(ui->tableWidgetMasternodesDIP3->rowCount()));
-    ui->tableWidgetMasternodesDIP3->setSortingEnabled(true);
+void MasternodeList::updateCountLabel()
+{
+    if (!proxyModel || fFilterUpdatedDIP3) return;
+    ui->countLabelDIP3->setText(QString::number(proxyModel->rowCount()));
 }
 
 void MasternodeList::on_filterLineEditDIP3_textChanged(const QString& strFilterIn)
@@ -329,9 +202,10 @@ void MasternodeList::on_filterLineEditDIP3_textChanged(const QString& strFilterI
 
 void MasternodeList::on_checkBoxMyMasternodesOnly_stateChanged(int state)
 {
-    // no cooldown
-    nTimeFilterUpdatedDIP3 = GetTime() - MASTERNODELIST_FILTER_COOLDOWN_SECONDS;
-    fFilterUpdatedDIP3 = true;
+    // no cooldown, the rows are rebuilt in the background
+    if (masternodeModel) {
+        masternodeModel->setWalletModel(walletModel, state == Qt::Checked);
+    }
 }
 
 CDeterministicMNCPtr MasternodeList::GetSelectedDIP3MN()
@@ -340,19 +214,13 @@ CDeterministicMNCPtr MasternodeList::GetSelectedDIP3MN()
         return nullptr;
     }
 
-    std::string strProTxHash;
-    {
-        LOCK(cs_dip3list);
+    QItemSelectionModel* selectionModel = ui->tableViewMasternodesDIP3->selectionModel();
+    if (!selectionModel) return nullptr;
+    QModelIndexList selected = selectionModel->selectedRows();
 
-        QItemSelectionModel* selectionModel = ui->tableWidgetMasternodesDIP3->selectionModel();
-        QModelIndexList selected = selectionModel->selectedRows();
+    if (selected.count() == 0) return nullptr;
 
-        if (selected.count() == 0) return nullptr;
-
-        QModelIndex index = selected.at(0);
-        int nSelectedRow = index.row();
-        strProTxHash = ui->tableWidgetMasternodesDIP3->item(nSelectedRow, 12)->text().toStdString();
-    }
+    std::string strProTxHash = selected.at(0).data(MasternodeTableModel::ProTxHashRole).toString().toStdString();
 
     uint256 proTxHash;
     proTxHash.SetHex(strProTxHash);
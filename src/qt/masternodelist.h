@@ -2,7 +2,6 @@
 #define SYSCOIN_QT_MASTERNODELIST_H
 
 #include <primitives/transaction.h>
-#include <sync.h>
 
 #include <evo/deterministicmns.h>
 
@@ -21,10 +20,12 @@ class CDeterministicMN;
 using CDeterministicMNCPtr = std::shared_ptr<const CDeterministicMN>;
 
 class ClientModel;
+class MasternodeTableModel;
 class WalletModel;
 
 QT_BEGIN_NAMESPACE
 class QModelIndex;
+class QSortFilterProxyModel;
 QT_END_NAMESPACE
 
 /** Masternode Manager page widget */
@@ -49,9 +50,8 @@ private:
     Ui::MasternodeList* ui{nullptr};
     ClientModel* clientModel{nullptr};
     WalletModel* walletModel{nullptr};
-
-    // Protects tableWidgetMasternodesDIP3
-    RecursiveMutex cs_dip3list;
+    MasternodeTableModel* masternodeModel{nullptr};
+    QSortFilterProxyModel* proxyModel{nullptr};
 
     QString strCurrentFilterDIP3;
 
@@ -81,5 +81,6 @@ private Q_SLOTS:
 
     void handleMasternodeListChanged();
     void updateDIP3ListScheduled();
+    void updateCountLabel();
 };
 #endif // SYSCOIN_QT_MASTERNODELIST_H
@@ -0,0 +1,346 @@
+// Copyright (c) 2024 The Syscoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <qt/masternodetablemodel.h>
+
+#include <coins.h>
+#include <interfaces/node.h>
+#include <interfaces/wallet.h>
+#include <key_io.h>
+#include <qt/clientmodel.h>
+#include <qt/walletmodel.h>
+#include <util/strencodings.h>
+#include <util/threadnames.h>
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <set>
+
+#include <QThread>
+#include <QTimer>
+
+MasternodeTableModel::MasternodeTableModel(ClientModel& client_model, QObject* parent) :
+    QAbstractTableModel(parent),
+    m_client_model(client_model),
+    m_thread(new QThread(this)),
+    m_worker(new QObject)
+{
+    connect(m_thread, &QThread::finished, m_worker, &QObject::deleteLater);
+    m_worker->moveToThread(m_thread);
+    m_thread->start();
+    QTimer::singleShot(0, m_worker, []() {
+        util::ThreadRename("qt-mnlist");
+    });
+}
+
+MasternodeTableModel::~MasternodeTableModel()
+{
+    m_thread->quit();
+    m_thread->wait();
+}
+
+void MasternodeTableModel::setWalletModel(WalletModel* wallet_model, bool fMyMasternodesOnly)
+{
+    {
+        LOCK(m_wallet_mutex);
+        if (m_wallet_model == wallet_model && m_my_only == fMyMasternodesOnly) return;
+        m_wallet_model = wallet_model;
+        m_my_only = fMyMasternodesOnly;
+    }
+    if (wallet_model) {
+        // the wallet can go away without the page being told
+        connect(wallet_model, &QObject::destroyed, this, [this, wallet_model] {
+            LOCK(m_wallet_mutex);
+            if (m_wallet_model == wallet_model) m_wallet_model = nullptr;
+        });
+    }
+    m_reset = true;
+    refresh();
+}
+
+void MasternodeTableModel::refresh()
+{
+    // at most one refresh is queued, it picks up whatever changed in the meantime
+    if (m_refresh_pending) {
+        m_refresh_again = true;
+        return;
+    }
+    m_refresh_pending = true;
+    QMetaObject::invokeMethod(m_worker, [this] {
+        auto update = BuildUpdate();
+        QMetaObject::invokeMethod(this, [this, update] {
+            if (update) ApplyUpdate(*update);
+            m_refresh_pending = false;
+            if (m_refresh_again) {
+                m_refresh_again = false;
+                refresh();
+            }
+        }, Qt::QueuedConnection);
+    }, Qt::QueuedConnection);
+}
+
+std::shared_ptr<MasternodeListUpdate> MasternodeTableModel::BuildUpdate()
+{
+    const CDeterministicMNList newList = m_client_model.getMasternodeList();
+    const bool fReset = m_reset.exchange(false);
+    if (fReset) {
+        m_worker_list = CDeterministicMNList();
+        m_worker_shown.clear();
+    } else if (m_worker_list.GetBlockHash() == newList.GetBlockHash()) {
+        return nullptr;
+    }
+
+    CDeterministicMNListDiff diff;
+    CDeterministicMNListNEVMAddressDiff diffNEVM;
+    m_worker_list.BuildDiff(newList, diff, diffNEVM);
+
+    auto update = std::make_shared<MasternodeListUpdate>();
+    update->fReset = fReset;
+
+    const auto projectedPayees = newList.GetProjectedMNPayees();
+    update->nextPayments.reserve(projectedPayees.size());
+    for (size_t i = 0; i < projectedPayees.size(); i++) {
+        update->nextPayments.emplace(projectedPayees[i]->proTxHash, newList.GetHeight() + (int)i + 1);
+    }
+
+    // masternodes whose row has to be (re)built
+    std::vector<CDeterministicMNCPtr> changed;
+    changed.reserve(diff.addedMNs.size() + diff.updatedMNs.size());
+    for (const auto& dmn : diff.addedMNs) {
+        changed.emplace_back(dmn);
+    }
+    for (const auto& [internalId, stateDiff] : diff.updatedMNs) {
+        if (auto dmn = newList.GetMNByInternalId(internalId)) {
+            changed.emplace_back(std::move(dmn));
+        }
+    }
+    for (const auto internalId : diff.removedMns) {
+        const auto dmn = m_worker_list.GetMNByInternalId(internalId);
+        if (dmn && m_worker_shown.erase(dmn->proTxHash)) {
+            update->removed.emplace_back(dmn->proTxHash);
+        }
+    }
+
+    // the wallet is only held on to for the ownership checks, the formatting below goes without it
+    {
+        LOCK(m_wallet_mutex);
+        interfaces::Wallet* wallet = m_my_only && m_wallet_model ? &m_wallet_model->wallet() : nullptr;
+        if (wallet && !changed.empty()) {
+            std::vector<COutPoint> vOutpts;
+            wallet->listProTxCoins(vOutpts);
+            const std::set<COutPoint> setOutpts(vOutpts.begin(), vOutpts.end());
+            auto itMine = std::partition(changed.begin(), changed.end(), [&](const CDeterministicMNCPtr& dmn) {
+                return setOutpts.count(dmn->collateralOutpoint) ||
+                    wallet->isSpendable(CTxDestination(WitnessV0KeyHash(dmn->pdmnState->keyIDOwner))) ||
+                    wallet->isSpendable(CTxDestination(WitnessV0KeyHash(dmn->pdmnState->keyIDVoting))) ||
+                    wallet->isSpendable(dmn->pdmnState->scriptPayout) ||
+                    wallet->isSpendable(dmn->pdmnState->scriptOperatorPayout);
+            });
+            for (auto it = itMine; it != changed.end(); ++it) {
+                if (m_worker_shown.erase((*it)->proTxHash)) {
+                    update->removed.emplace_back((*it)->proTxHash);
+                }
+            }
+            changed.erase(itMine, changed.end());
+        }
+    }
+
+    update->upserts.reserve(changed.size());
+    for (const auto& dmnPtr : changed) {
+        const CDeterministicMN& dmn = *dmnPtr;
+        m_worker_shown.insert(dmn.proTxHash);
+
+        MasternodeRow& row = update->upserts.emplace_back();
+        row.proTxHash = dmn.proTxHash;
+        row.nPoSePenalty = dmn.pdmnState->nPoSePenalty;
+        row.nRegisteredHeight = dmn.pdmnState->nRegisteredHeight;
+        row.nLastPaidHeight = dmn.pdmnState->nLastPaidHeight;
+        row.text[Service] = QString::fromStdString(dmn.pdmnState->addr.ToStringAddrPort());
+        row.text[Status] = CDeterministicMNList::IsMNValid(dmn) ? tr("ENABLED") : (CDeterministicMNList::IsMNPoSeBanned(dmn) ? tr("POSE_BANNED") : tr("UNKNOWN"));
+        row.text[PoSeScore] = QString::number(row.nPoSePenalty);
+        row.text[Registered] = QString::number(row.nRegisteredHeight);
+        row.text[LastPaid] = QString::number(row.nLastPaidHeight);
+
+        CTxDestination payeeDest;
+        row.text[Payee] = tr("UNKNOWN");
+        if (ExtractDestination(dmn.pdmnState->scriptPayout, payeeDest)) {
+            row.text[Payee] = QString::fromStdString(EncodeDestination(payeeDest));
+        }
+
+        row.text[OperatorReward] = tr("NONE");
+        if (dmn.nOperatorReward) {
+            row.text[OperatorReward] = QString::number(dmn.nOperatorReward / 100.0, 'f', 2) + "% ";
+            if (dmn.pdmnState->scriptOperatorPayout != CScript()) {
+                CTxDestination operatorDest;
+                if (ExtractDestination(dmn.pdmnState->scriptOperatorPayout, operatorDest)) {
+                    row.text[OperatorReward] += tr("to %1").arg(QString::fromStdString(EncodeDestination(operatorDest)));
+                } else {
+                    row.text[OperatorReward] += tr("to UNKNOWN");
+                }
+            } else {
+                row.text[OperatorReward] += tr("but not claimed");
+            }
+        }
+
+        CTxDestination collateralDest;
+        Coin coin;
+        row.text[Collateral] = tr("UNKNOWN");
+        if (m_client_model.node().getUnspentOutput(dmn.collateralOutpoint, coin) && ExtractDestination(coin.out.scriptPubKey, collateralDest)) {
+            row.text[Collateral] = QString::fromStdString(EncodeDestination(collateralDest));
+        }
+
+        row.text[Owner] = QString::fromStdString(EncodeDestination(WitnessV0KeyHash(dmn.pdmnState->keyIDOwner)));
+        row.text[Voting] = QString::fromStdString(EncodeDestination(WitnessV0KeyHash(dmn.pdmnState->keyIDVoting)));
+        row.text[NEVMAddress] = QString::fromStdString(HexStr(dmn.pdmnState->vchNEVMAddress));
+        row.text[ProTxHash] = QString::fromStdString(dmn.proTxHash.ToString());
+    }
+
+    m_worker_list = newList;
+    return update;
+}
+
+void MasternodeTableModel::ApplyUpdate(const MasternodeListUpdate& update)
+{
+    if (update.fReset) {
+        beginResetModel();
+        m_rows = update.upserts;
+        for (auto& row : m_rows) {
+            const auto it = update.nextPayments.find(row.proTxHash);
+            row.nNextPayment = it != update.nextPayments.end() ? it->second : -1;
+        }
+        RebuildIndex();
+        endResetModel();
+        Q_EMIT listUpdated();
+        return;
+    }
+
+    if (!update.removed.empty()) {
+        std::vector<int> vRows;
+        vRows.reserve(update.removed.size());
+        for (const auto& proTxHash : update.removed) {
+            const auto it = m_row_index.find(proTxHash);
+            if (it != m_row_index.end()) vRows.push_back(it->second);
+        }
+        // remove contiguous runs from the back so the rows in front keep their position
+        std::sort(vRows.begin(), vRows.end(), std::greater<int>());
+        size_t i = 0;
+        while (i < vRows.size()) {
+            size_t j = i + 1;
+            while (j < vRows.size() && vRows[j] == vRows[j - 1] - 1) ++j;
+            const int first = vRows[j - 1], last = vRows[i];
+            beginRemoveRows(QModelIndex(), first, last);
+            m_rows.erase(m_rows.begin() + first, m_rows.begin() + last + 1);
+            endRemoveRows();
+            i = j;
+        }
+        RebuildIndex();
+    }
+
+    std::vector<MasternodeRow> vNewRows;
+    for (const auto& row : update.upserts) {
+        const auto it = m_row_index.find(row.proTxHash);
+        if (it == m_row_index.end()) {
+            vNewRows.push_back(row);
+            continue;
+        }
+        const int nRow = it->second;
+        const int nNextPayment = m_rows[nRow].nNextPayment;
+        m_rows[nRow] = row;
+        m_rows[nRow].nNextPayment = nNextPayment;
+        Q_EMIT dataChanged(index(nRow, 0), index(nRow, columns.size() - 1));
+    }
+    if (!vNewRows.empty()) {
+        const int first = m_rows.size();
+        beginInsertRows(QModelIndex(), first, first + (int)vNewRows.size() - 1);
+        for (auto& row : vNewRows) {
+            m_row_index.emplace(row.proTxHash, m_rows.size());
+            m_rows.push_back(std::move(row));
+        }
+        endInsertRows();
+    }
+
+    // the projected payments shift with every block, they are plain numbers so only the visible cells get formatted
+    int nFirstChanged = -1, nLastChanged = -1;
+    for (int nRow = 0; nRow < (int)m_rows.size(); ++nRow) {
+        auto& row = m_rows[nRow];
+        const auto it = update.nextPayments.find(row.proTxHash);
+        const int nNextPayment = it != update.nextPayments.end() ? it->second : -1;
+        if (row.nNextPayment == nNextPayment) continue;
+        row.nNextPayment = nNextPayment;
+        if (nFirstChanged == -1) nFirstChanged = nRow;
+        nLastChanged = nRow;
+    }
+    if (nFirstChanged != -1) {
+        Q_EMIT dataChanged(index(nFirstChanged, NextPayment), index(nLastChanged, NextPayment));
+    }
+    Q_EMIT listUpdated();
+}
+
+void MasternodeTableModel::RebuildIndex()
+{
+    m_row_index.clear();
+    m_row_index.reserve(m_rows.size());
+    for (int nRow = 0; nRow < (int)m_rows.size(); ++nRow) {
+        m_row_index.emplace(m_rows[nRow].proTxHash, nRow);
+    }
+}
+
+int MasternodeTableModel::rowCount(const QModelIndex& parent) const
+{
+    if (parent.isValid()) {
+        return 0;
+    }
+    return m_rows.size();
+}
+
+int MasternodeTableModel::columnCount(const QModelIndex& parent) const
+{
+    if (parent.isValid()) {
+        return 0;
+    }
+    return columns.length();
+}
+
+QVariant MasternodeTableModel::data(const QModelIndex& index, int role) const
+{
+    if (!index.isValid() || index.row() >= (int)m_rows.size()) {
+        return QVariant();
+    }
+    const MasternodeRow& row = m_rows[index.row()];
+    const auto column = static_cast<ColumnIndex>(index.column());
+    if (role == Qt::DisplayRole) {
+        if (column == NextPayment) {
+            return row.nNextPayment != -1 ? QString::number(row.nNextPayment) : tr("UNKNOWN");
+        }
+        return row.text.at(column);
+    } else if (role == SortRole) {
+        switch (column) {
+        case PoSeScore: return row.nPoSePenalty;
+        case Registered: return row.nRegisteredHeight;
+        case LastPaid: return row.nLastPaidHeight;
+        // unknown payments go last
+        case NextPayment: return row.nNextPayment != -1 ? row.nNextPayment : std::numeric_limits<int>::max();
+        default: return row.text.at(column);
+        }
+    } else if (role == ProTxHashRole) {
+        return row.text[ProTxHash];
+    }
+    return QVariant();
+}
+
+QVariant MasternodeTableModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if (orientation == Qt::Horizontal && role == Qt::DisplayRole && section < columns.size()) {
+        return columns[section];
+    }
+    return QVariant();
+}
+
+Qt::ItemFlags MasternodeTableModel::flags(const QModelIndex& index) const
+{
+    if (!index.isValid()) return Qt::NoItemFlags;
+
+    return Qt::ItemIsSelectable | Qt::ItemIsEnabled;
+}
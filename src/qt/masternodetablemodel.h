@@ -0,0 +1,160 @@
+// Copyright (c) 2024 The Syscoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef SYSCOIN_QT_MASTERNODETABLEMODEL_H
+#define SYSCOIN_QT_MASTERNODETABLEMODEL_H
+
+#include <evo/deterministicmns.h>
+#include <saltedhasher.h>
+#include <sync.h>
+#include <uint256.h>
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include <QAbstractTableModel>
+#include <QString>
+#include <QStringList>
+#include <QVariant>
+
+class ClientModel;
+class WalletModel;
+
+QT_BEGIN_NAMESPACE
+class QThread;
+QT_END_NAMESPACE
+
+/** One formatted row of the masternode list */
+struct MasternodeRow {
+    uint256 proTxHash;
+    //! display text per column, the next payment column is formatted on demand
+    std::array<QString, 13> text;
+    int nPoSePenalty{0};
+    int nRegisteredHeight{0};
+    int nLastPaidHeight{0};
+    //! projected payment height, -1 if unknown
+    int nNextPayment{-1};
+};
+
+/** Row changes between two masternode lists, as computed by the worker thread */
+struct MasternodeListUpdate {
+    //! replace all rows with upserts
+    bool fReset{false};
+    //! rows to add or replace, by protx hash
+    std::vector<MasternodeRow> upserts;
+    std::vector<uint256> removed;
+    //! projected payment height of every masternode of the new list
+    std::unordered_map<uint256, int, StaticSaltedHasher> nextPayments;
+};
+
+/**
+   Qt model of the deterministic masternode list shown on the masternodes page.
+
+   The list is fetched, diffed against the previous one with
+   CDeterministicMNList::BuildDiff and formatted on a worker thread. The GUI
+   thread only applies the resulting row inserts, updates and removals, so a
+   new block costs time in proportion to the masternodes it changed.
+ */
+class MasternodeTableModel : public QAbstractTableModel
+{
+    Q_OBJECT
+
+public:
+    explicit MasternodeTableModel(ClientModel& client_model, QObject* parent);
+    ~MasternodeTableModel();
+
+    enum ColumnIndex {
+        Service = 0,
+        Status,
+        PoSeScore,
+        Registered,
+        LastPaid,
+        NextPayment,
+        Payee,
+        OperatorReward,
+        Collateral,
+        Owner,
+        Voting,
+        NEVMAddress,
+        ProTxHash
+    };
+
+    enum {
+        //! numeric sort key of the numeric columns, the text otherwise
+        SortRole = Qt::UserRole,
+        ProTxHashRole,
+    };
+
+    /** Rows are limited to masternodes the wallet owns or operates, a null wallet model shows them all.
+        Blocks until a refresh still running on the worker thread is done with the old wallet. */
+    void setWalletModel(WalletModel* wallet_model, bool fMyMasternodesOnly);
+
+    /** Bring the rows up to date with the masternode list of the client model in the background */
+    void refresh();
+
+    /** @name Methods overridden from QAbstractTableModel
+        @{*/
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+    Qt::ItemFlags flags(const QModelIndex& index) const override;
+    /*@}*/
+
+Q_SIGNALS:
+    /** Emitted after an update from the worker thread was applied */
+    void listUpdated();
+
+private:
+    ClientModel& m_client_model;
+    QThread* m_thread;
+    //! context of the jobs run on m_thread
+    QObject* m_worker;
+
+    //! GUI thread state
+    std::vector<MasternodeRow> m_rows;
+    std::unordered_map<uint256, int, StaticSaltedHasher> m_row_index;
+    //! a refresh is queued or running on the worker thread
+    bool m_refresh_pending{false};
+    //! another refresh was asked for while one was pending
+    bool m_refresh_again{false};
+
+    //! wallet used for the ownership filter, read by the worker thread
+    Mutex m_wallet_mutex;
+    WalletModel* m_wallet_model GUARDED_BY(m_wallet_mutex){nullptr};
+    bool m_my_only GUARDED_BY(m_wallet_mutex){false};
+    //! the next refresh starts over from an empty list
+    std::atomic<bool> m_reset{true};
+
+    //! worker thread state: the list the rows were last built from and the masternodes shown of it
+    CDeterministicMNList m_worker_list;
+    std::unordered_set<uint256, StaticSaltedHasher> m_worker_shown;
+
+    const QStringList columns{
+        tr("Service"),
+        tr("Status"),
+        tr("PoSe Score"),
+        tr("Registered"),
+        tr("Last Paid"),
+        tr("Next Payment"),
+        tr("Payout Address"),
+        tr("Operator Reward"),
+        tr("Collateral Address"),
+        tr("Owner Address"),
+        tr("Voting Address"),
+        tr("NEVM Address"),
+        tr("ProTx Hash")};
+
+    /** Runs on the worker thread */
+    std::shared_ptr<MasternodeListUpdate> BuildUpdate() EXCLUSIVE_LOCKS_REQUIRED(!m_wallet_mutex);
+    /** Runs on the GUI thread */
+    void ApplyUpdate(const MasternodeListUpdate& update);
+    void RebuildIndex();
+};
+
+#endif // SYSCOIN_QT_MASTERNODETABLEMODEL_H
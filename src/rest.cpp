@@ -12,6 +12,7 @@
 #include <httpserver.h>
 #include <index/blockfilterindex.h>
 #include <index/txindex.h>
+#include <llmq/quorums_chainlocks.h>
 #include <node/blockstorage.h>
 #include <node/context.h>
 #include <primitives/block.h>
@@ -21,15 +22,20 @@
 #include <rpc/protocol.h>
 #include <rpc/server.h>
 #include <rpc/server_util.h>
+#include <services/nevmconsensus.h>
 #include <streams.h>
 #include <sync.h>
 #include <txmempool.h>
 #include <util/any.h>
 #include <util/check.h>
+#include <util/strencodings.h>
+#include <util/string.h>
 #include <validation.h>
 #include <version.h>
 
+#include <algorithm>
 #include <any>
+#include <optional>
 #include <string>
 
 #include <univalue.h>
@@ -155,6 +161,57 @@ RESTResponseFormat ParseDataFormat(std::string& param, const std::string& strReq
     return rf_names[0].rf;
 }
 
+// SYSCOIN
+RESTByteRange ParseByteRange(const std::string& header, uint64_t size, uint64_t& begin, uint64_t& end)
+{
+    const std::string_view unit{"bytes="};
+    if (header.compare(0, unit.size(), unit) != 0 || header.find(',') != std::string::npos) {
+        return RESTByteRange::FULL;
+    }
+    const std::string_view spec{TrimStringView(std::string_view{header}.substr(unit.size()))};
+    const auto dash{spec.find('-')};
+    if (dash == std::string_view::npos) {
+        return RESTByteRange::FULL;
+    }
+    const std::string_view first{TrimStringView(spec.substr(0, dash))};
+    const std::string_view last{TrimStringView(spec.substr(dash + 1))};
+    if (first.empty()) {
+        // suffix range, the last n bytes
+        const auto n{ToIntegral<uint64_t>(last)};
+        if (!n) return RESTByteRange::FULL;
+        if (*n == 0 || size == 0) return RESTByteRange::UNSATISFIABLE;
+        begin = size - std::min(*n, size);
+        end = size;
+        return RESTByteRange::PARTIAL;
+    }
+    const auto first_pos{ToIntegral<uint64_t>(first)};
+    if (!first_pos) return RESTByteRange::FULL;
+    std::optional<uint64_t> last_pos;
+    if (!last.empty()) {
+        last_pos = ToIntegral<uint64_t>(last);
+        if (!last_pos || *last_pos < *first_pos) return RESTByteRange::FULL;
+    }
+    if (*first_pos >= size) return RESTByteRange::UNSATISFIABLE;
+    begin = *first_pos;
+    end = last_pos ? std::min(*last_pos, size - 1) + 1 : size;
+    return RESTByteRange::PARTIAL;
+}
+
+/** Whether an If-None-Match header of the request matches etag, so the client copy is current */
+static bool ETagMatches(const HTTPRequest* req, const std::string& etag)
+{
+    const auto [present, value] = req->GetHeader("If-None-Match");
+    if (!present) return false;
+    for (const std::string& tag : SplitString(value, ',')) {
+        std::string_view candidate{TrimStringView(tag)};
+        if (candidate == "*") return true;
+        // weak comparison, as for GET requests
+        if (candidate.substr(0, 2) == "W/") candidate.remove_prefix(2);
+        if (candidate == etag) return true;
+    }
+    return false;
+}
+
 static std::string AvailableDataFormatsString()
 {
     std::string formats;
@@ -310,7 +367,7 @@ static bool rest_block(const std::any& context,
 
     }
 
-    if (!chainman.m_blockman.ReadBlockFromDisk(block, *pblockindex)) {
+    if (!chainman.m_blockman.ReadBlockFromDisk(block, *pblockindex, /*fFillNEVMData=*/false)) {
         return RESTERR(req, HTTP_NOT_FOUND, hashStr + " not found");
     }
 
@@ -1018,6 +1075,169 @@ static bool rest_blockhash_by_height(const std::any& context, HTTPRequest* req,
     }
 }
 
+// SYSCOIN
+static bool rest_nevm_blob(const std::any& context, HTTPRequest* req, const std::string& strURIPart)
+{
+    if (!CheckWarmup(req))
+        return false;
+    std::string hashStr;
+    const RESTResponseFormat rf = ParseDataFormat(hashStr, strURIPart);
+    if (hashStr.size() != 64 || !IsHex(hashStr)) {
+        return RESTERR(req, HTTP_BAD_REQUEST, "Invalid version hash: " + hashStr);
+    }
+    if (!pnevmdatablobdb) {
+        return RESTERR(req, HTTP_NOT_FOUND, "NEVM blob store not available");
+    }
+    const std::vector<uint8_t> vchVersionHash{ParseHex(hashStr)};
+    if (!pnevmdatablobdb->BlobExists(vchVersionHash)) {
+        return RESTERR(req, HTTP_NOT_FOUND, hashStr + " not found");
+    }
+    // the version hash commits to the blob, so the content behind it never changes
+    const std::string etag{"\"" + hashStr + "\""};
+    if (ETagMatches(req, etag)) {
+        req->WriteHeader("ETag", etag);
+        req->WriteReply(HTTP_NOT_MODIFIED);
+        return true;
+    }
+
+    switch (rf) {
+    case RESTResponseFormat::BINARY: {
+        const std::string range{req->GetHeader("Range").second};
+        // the reply is written from the blob store mapping, copied once into the output buffer
+        const bool found = pnevmdatablobdb->ReadBlob(vchVersionHash, [&](Span<const uint8_t> blob) {
+            req->WriteHeader("Accept-Ranges", "bytes");
+            req->WriteHeader("ETag", etag);
+            uint64_t begin{0}, end{0};
+            switch (ParseByteRange(range, blob.size(), begin, end)) {
+            case RESTByteRange::FULL:
+                req->WriteHeader("Content-Type", "application/octet-stream");
+                req->WriteReply(HTTP_OK, blob);
+                break;
+            case RESTByteRange::PARTIAL:
+                req->WriteHeader("Content-Type", "application/octet-stream");
+                req->WriteHeader("Content-Range", strprintf("bytes %u-%u/%u", begin, end - 1, blob.size()));
+                req->WriteReply(HTTP_PARTIAL_CONTENT, blob.subspan(begin, end - begin));
+                break;
+            case RESTByteRange::UNSATISFIABLE:
+                req->WriteHeader("Content-Range", strprintf("bytes */%u", blob.size()));
+                req->WriteReply(HTTP_RANGE_NOT_SATISFIABLE);
+                break;
+            }
+        });
+        if (!found) {
+            // the blob expired in between
+            return RESTERR(req, HTTP_NOT_FOUND, hashStr + " not found");
+        }
+        return true;
+    }
+
+    case RESTResponseFormat::HEX: {
+        std::string strHex;
+        if (!pnevmdatablobdb->ReadBlob(vchVersionHash, [&strHex](Span<const uint8_t> blob) { strHex = HexStr(blob) + "\n"; })) {
+            return RESTERR(req, HTTP_NOT_FOUND, hashStr + " not found");
+        }
+        req->WriteHeader("ETag", etag);
+        req->WriteHeader("Content-Type", "text/plain");
+        req->WriteReply(HTTP_OK, strHex);
+        return true;
+    }
+
+    default: {
+        return RESTERR(req, HTTP_NOT_FOUND, "output format not found (available: .bin, .hex)");
+    }
+    }
+}
+
+static bool rest_spv_proof(const std::any& context, HTTPRequest* req, const std::string& strURIPart)
+{
+    if (!CheckWarmup(req))
+        return false;
+    std::string hashStr;
+    const RESTResponseFormat rf = ParseDataFormat(hashStr, strURIPart);
+    uint256 txhash;
+    if (!ParseHashStr(hashStr, txhash))
+        return RESTERR(req, HTTP_BAD_REQUEST, "Invalid hash: " + hashStr);
+    if (rf != RESTResponseFormat::BINARY && rf != RESTResponseFormat::HEX) {
+        return RESTERR(req, HTTP_NOT_FOUND, "output format not found (available: .bin, .hex)");
+    }
+    ChainstateManager* maybe_chainman = GetChainman(context, req);
+    if (!maybe_chainman) return false;
+    ChainstateManager& chainman = *maybe_chainman;
+
+    const CBlockIndex* pblockindex{nullptr};
+    {
+        LOCK(cs_main);
+        if (const auto blockhash_str{req->GetQueryParameter("blockhash")}) {
+            uint256 blockhash;
+            if (!ParseHashStr(*blockhash_str, blockhash)) {
+                return RESTERR(req, HTTP_BAD_REQUEST, "Invalid hash: " + *blockhash_str);
+            }
+            pblockindex = chainman.m_blockman.LookupBlockIndex(blockhash);
+            if (!pblockindex) {
+                return RESTERR(req, HTTP_NOT_FOUND, *blockhash_str + " not found");
+            }
+        } else {
+            const Coin& coin = AccessByTxid(chainman.ActiveChainstate().CoinsTip(), txhash);
+            uint32_t nBlockHeight;
+            if (!coin.IsSpent()) {
+                pblockindex = chainman.ActiveChain()[coin.nHeight];
+            } else if (pblockindexdb && pblockindexdb->ReadBlockHeight(txhash, nBlockHeight)) {
+                pblockindex = chainman.ActiveChain()[nBlockHeight];
+            }
+        }
+        if (pblockindex && chainman.m_blockman.IsBlockPruned(pblockindex)) {
+            return RESTERR(req, HTTP_NOT_FOUND, pblockindex->GetBlockHash().GetHex() + " not available (pruned data)");
+        }
+    }
+    if (!pblockindex) {
+        return RESTERR(req, HTTP_NOT_FOUND, hashStr + " not yet in block");
+    }
+
+    const bool fChainLock{llmq::chainLocksHandler && llmq::chainLocksHandler->HasChainLock(pblockindex->nHeight, pblockindex->GetBlockHash())};
+    // a proof only changes with the block holding the transaction and its chainlock
+    const std::string etag{strprintf("\"%s-%d\"", pblockindex->GetBlockHash().GetHex(), fChainLock)};
+    if (ETagMatches(req, etag)) {
+        req->WriteHeader("ETag", etag);
+        req->WriteReply(HTTP_NOT_MODIFIED);
+        return true;
+    }
+
+    CBlock block;
+    if (!chainman.m_blockman.ReadBlockFromDisk(block, *pblockindex, /*fFillNEVMData=*/false)) {
+        return RESTERR(req, HTTP_NOT_FOUND, pblockindex->GetBlockHash().GetHex() + " not found");
+    }
+    CNEVMHeader evmBlock;
+    BlockValidationState state;
+    if (!GetNEVMData(state, block, evmBlock)) {
+        return RESTERR(req, HTTP_INTERNAL_SERVER_ERROR, state.ToString());
+    }
+    std::vector<uint256> vTxids;
+    vTxids.reserve(block.vtx.size());
+    std::optional<uint32_t> nIndex;
+    for (const auto& tx : block.vtx) {
+        if (tx->GetHash() == txhash) nIndex = static_cast<uint32_t>(vTxids.size());
+        vTxids.push_back(tx->GetHash());
+    }
+    if (!nIndex) {
+        return RESTERR(req, HTTP_NOT_FOUND, hashStr + " not in block " + pblockindex->GetBlockHash().GetHex());
+    }
+
+    // same fields as syscoingetspvproof, the txids in block order take the place of siblings
+    CDataStream ssProof(SER_NETWORK, PROTOCOL_VERSION | SERIALIZE_TRANSACTION_NO_WITNESS);
+    ssProof << static_cast<const CPureBlockHeader&>(block);
+    ssProof << *block.vtx[*nIndex];
+    ssProof << *nIndex << vTxids << evmBlock.nBlockHash << fChainLock;
+    req->WriteHeader("ETag", etag);
+    if (rf == RESTResponseFormat::BINARY) {
+        req->WriteHeader("Content-Type", "application/octet-stream");
+        req->WriteReply(HTTP_OK, MakeUCharSpan(ssProof));
+    } else {
+        req->WriteHeader("Content-Type", "text/plain");
+        req->WriteReply(HTTP_OK, HexStr(ssProof) + "\n");
+    }
+    return true;
+}
+
 static const struct {
     const char* prefix;
     bool (*handler)(const std::any& context, HTTPRequest* req, const std::string& strReq);
@@ -1034,6 +1254,9 @@ static const struct {
       {"/rest/deploymentinfo/", rest_deploymentinfo},
       {"/rest/deploymentinfo", rest_deploymentinfo},
       {"/rest/blockhashbyheight/", rest_blockhash_by_height},
+      // SYSCOIN
+      {"/rest/nevmblob/", rest_nevm_blob},
+      {"/rest/spvproof/", rest_spv_proof},
 };
 
 void StartREST(const std::any& context)
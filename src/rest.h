@@ -5,6 +5,7 @@
 #ifndef SYSCOIN_REST_H
 #define SYSCOIN_REST_H
 
+#include <cstdint>
 #include <string>
 
 enum class RESTResponseFormat {
@@ -25,4 +26,23 @@ enum class RESTResponseFormat {
  */
 RESTResponseFormat ParseDataFormat(std::string& param, const std::string& strReq);
 
+// SYSCOIN
+enum class RESTByteRange {
+    FULL,
+    PARTIAL,
+    UNSATISFIABLE,
+};
+
+/**
+ * Parse the value of an HTTP Range header against content of size bytes.
+ * Only a single range of the bytes unit is served, a header that is missing,
+ * malformed or asks for several ranges gets the full content.
+ *
+ * @param[in]   header  The Range header value, e.g. "bytes=0-1023".
+ * @param[in]   size    The size of the content.
+ * @param[out]  begin   First byte of the range, set if PARTIAL is returned.
+ * @param[out]  end     One past the last byte of the range, set if PARTIAL is returned.
+ */
+RESTByteRange ParseByteRange(const std::string& header, uint64_t size, uint64_t& begin, uint64_t& end);
+
 #endif // SYSCOIN_REST_H
@@ -7,6 +7,8 @@
 #include <arith_uint256.h>
 #include <auxpow.h>
 #include <chainparams.h>
+#include <consensus/merkle.h>
+#include <logging.h>
 #include <net.h>
 #include <rpc/blockchain.h>
 #include <rpc/protocol.h>
@@ -51,68 +53,135 @@ void auxMiningCheck(const node::JSONRPCRequest& request)
 
 }  // anonymous namespace
 
-const CBlock*
-AuxpowMiner::getCurrentBlock (ChainstateManager &chainman, const CTxMemPool& mempool,
-                              const CScript& scriptPubKey, uint256& target)
+bool
+AuxpowMiner::isBaseFresh (const CBlockIndex* tip, const CTxMemPool& mempool) const
 {
   AssertLockHeld(cs);
-  const CBlock* pblockCur = nullptr;
+  /* A template failing its background check is built again, and checked
+     before it is used as the tip is no longer marked as checked.  */
+  return baseTemplate != nullptr
+      && pindexPrev == tip
+      && !node::DeferredCheckFailed (*baseTemplate)
+      && (mempool.GetTransactionsUpdated () == txUpdatedLast
+          || GetTime () - startTime <= 60);
+}
+
+std::shared_ptr<const CBlockTemplate>
+AuxpowMiner::updateBaseTemplate (ChainstateManager &chainman, const CTxMemPool& mempool)
+{
+  LOCK (m_build_mutex);
 
+  const CBlockIndex* tip = WITH_LOCK (cs_main, return chainman.ActiveTip ());
   {
-    LOCK (cs_main);
-    CScriptID scriptID (scriptPubKey);
-    auto iter = curBlocks.find(scriptID);
-    if (iter != curBlocks.end())
-      pblockCur = iter->second;
-
-    if (pblockCur == nullptr
-        || pindexPrev != chainman.ActiveTip()
-        || (mempool.GetTransactionsUpdated () != txUpdatedLast
-            && GetTime () - startTime > 60))
-      {
-        if (pindexPrev != chainman.ActiveTip())
-          {
-            /* Clear old blocks since they're obsolete now.  */
-            blocks.clear ();
-            templates.clear ();
-            curBlocks.clear ();
-          }
-
-        /* Create new block with nonce = 0 and extraNonce = 1.  */
-        std::unique_ptr<CBlockTemplate> newBlock
-            = BlockAssembler (chainman.ActiveChainstate(), &mempool).CreateNewBlock (scriptPubKey);
-        if (newBlock == nullptr)
-          throw JSONRPCError (RPC_OUT_OF_MEMORY, "out of memory");
-
-        /* Update state only when CreateNewBlock succeeded.  */
-        txUpdatedLast = mempool.GetTransactionsUpdated ();
-        pindexPrev = chainman.ActiveTip();
-        startTime = GetTime ();
-
-        /* Finalise it by setting the version and building the merkle root.  */
-        IncrementExtraNonce (&newBlock->block, pindexPrev, extraNonce);
-        // SYSCOIN
-        const int32_t nChainId = chainman.GetConsensus ().nAuxpowChainId;
-        const int32_t nVersion = chainman.m_versionbitscache.ComputeBlockVersion(pindexPrev, chainman.GetConsensus ());
-        newBlock->block.SetBaseVersion(nVersion, nChainId);
-        newBlock->block.SetAuxpowVersion (true);
-        if(!fRegTest) {
-          newBlock->block.SetNEVMVersion();
-        }
+    /* Another worker may have built it while this one was waiting.  */
+    LOCK (cs);
+    if (isBaseFresh (tip, mempool))
+      return baseTemplate;
+  }
 
-        /* Save in our map of constructed blocks.  */
-        pblockCur = &newBlock->block;
-        curBlocks.try_emplace(scriptID, pblockCur);
-        blocks[pblockCur->GetHash ()] = pblockCur;
-        templates.push_back (std::move (newBlock));
+  const unsigned txUpdated = mempool.GetTransactionsUpdated ();
+  /* The coinbase script is filled in per block, so the placeholder doesn't
+     matter here.  */
+  const CScript scriptDummy = CScript () << OP_TRUE;
+  std::unique_ptr<CBlockTemplate> newBlock
+      = node::g_block_template_cache
+        ? node::g_block_template_cache->GetBlockTemplate (tip->GetBlockHash (), txUpdated, scriptDummy)
+        : nullptr;
+  if (newBlock == nullptr)
+    newBlock = BlockAssembler (chainman.ActiveChainstate(), &mempool).CreateNewBlock (scriptDummy);
+  if (newBlock == nullptr)
+    throw JSONRPCError (RPC_OUT_OF_MEMORY, "out of memory");
+
+  const CBlockIndex* pindexNew = WITH_LOCK (cs_main, return chainman.m_blockman.LookupBlockIndex (newBlock->block.hashPrevBlock));
+  CHECK_NONFATAL(pindexNew);
+  const int32_t nChainId = chainman.GetConsensus ().nAuxpowChainId;
+  const int32_t nVersion = chainman.m_versionbitscache.ComputeBlockVersion(pindexNew, chainman.GetConsensus ());
+  newBlock->block.SetBaseVersion(nVersion, nChainId);
+  newBlock->block.SetAuxpowVersion (true);
+  if(!fRegTest) {
+    newBlock->block.SetNEVMVersion();
+  }
+  /* Every block made from the base only changes the coinbase.  */
+  newBlock->vCoinbaseMerkleBranch = BlockCoinbaseMerkleBranch (newBlock->block);
+
+  /* Update state only when CreateNewBlock succeeded.  */
+  LOCK (cs);
+  if (pindexPrev != pindexNew)
+    {
+      /* Clear old blocks since they're obsolete now.  */
+      WITH_LOCK (m_blocks_mutex, blocks.clear ());
+      extraNonce = 0;
+    }
+  /* Blocks of the previous base stay in blocks, so they can still be
+     submitted until the tip changes.  */
+  curBlocks.clear ();
+  baseTemplate = std::move (newBlock);
+  txUpdatedLast = txUpdated;
+  pindexPrev = pindexNew;
+  startTime = GetTime ();
+  return baseTemplate;
+}
+
+std::shared_ptr<const CBlock>
+AuxpowMiner::getCurrentBlock (ChainstateManager &chainman, const CTxMemPool& mempool,
+                              const CScript& scriptPubKey, uint256& target,
+                              AuxBlockTimings* timings)
+{
+  const CScriptID scriptID (scriptPubKey);
+  const CBlockIndex* tip = WITH_LOCK (cs_main, return chainman.ActiveTip ());
+  std::shared_ptr<const CBlock> pblockCur;
+  std::shared_ptr<const CBlockTemplate> base;
+  {
+    LOCK (cs);
+    if (isBaseFresh (tip, mempool))
+      {
+        base = baseTemplate;
+        const auto iter = curBlocks.find (scriptID);
+        if (iter != curBlocks.end ())
+          pblockCur = iter->second;
       }
   }
 
-  /* At this point, pblockCur is always initialised:  If we make it here
-     without creating a new block above, it means that, in particular,
-     pindexPrev == chainman->ActiveTip().  But for that to happen, we must
-     already have created a pblockCur in a previous call, as pindexPrev is
-     initialised only when pblockCur is.  */
+  if (pblockCur == nullptr)
+    {
+      const auto time_base{SteadyClock::now ()};
+      if (base == nullptr)
+        {
+          base = updateBaseTemplate (chainman, mempool);
+          if (timings)
+            timings->base = std::chrono::duration_cast<std::chrono::microseconds> (SteadyClock::now () - time_base);
+        }
+      const auto time_coinbase{SteadyClock::now ()};
+
+      /* Only the coinbase differs between the coinbase scripts, so a copy
+         of the base with its own coinbase and merkle root is all it takes.
+         The root is recomputed from the cached coinbase branch.  */
+      const unsigned nExtraNonce = WITH_LOCK (cs, return ++extraNonce);
+      const int nHeight = WITH_LOCK (cs_main, return chainman.m_blockman.LookupBlockIndex (base->block.hashPrevBlock)->nHeight) + 1;
+      auto newBlock = std::make_shared<CBlock> (base->block);
+      CMutableTransaction txCoinbase (*newBlock->vtx[0]);
+      txCoinbase.vout[0].scriptPubKey = scriptPubKey;
+      txCoinbase.vin[0].scriptSig = (CScript () << nHeight << CScriptNum (nExtraNonce));
+      assert (txCoinbase.vin[0].scriptSig.size () <= 100);
+      newBlock->vtx[0] = MakeTransactionRef (std::move (txCoinbase));
+      newBlock->hashMerkleRoot = ComputeMerkleRootFromCoinbase (newBlock->vtx[0]->GetHash (), base->vCoinbaseMerkleBranch);
+      pblockCur = newBlock;
+      if (timings)
+        timings->coinbase = std::chrono::duration_cast<std::chrono::microseconds> (SteadyClock::now () - time_coinbase);
+
+      WITH_LOCK (m_blocks_mutex, blocks[pblockCur->GetHash ()] = pblockCur);
+      LOCK (cs);
+      /* A worker asking for the same script at the same time may have won,
+         keep its block so the script sees one block per base.  */
+      if (baseTemplate == base)
+        {
+          const auto inserted = curBlocks.try_emplace (scriptID, pblockCur);
+          pblockCur = inserted.first->second;
+        }
+    }
+
+  /* At this point, pblockCur is always initialised:  Either it was found
+     for the current base template or it was just made from one.  */
   CHECK_NONFATAL(pblockCur);
 
   arith_uint256 arithTarget;
@@ -125,14 +194,13 @@ AuxpowMiner::getCurrentBlock (ChainstateManager &chainman, const CTxMemPool& mem
   return pblockCur;
 }
 
-const CBlock*
+std::shared_ptr<const CBlock>
 AuxpowMiner::lookupSavedBlock (const std::string& hashHex) const
 {
-  AssertLockHeld(cs);
-
   uint256 hash;
   hash.SetHex (hashHex);
 
+  LOCK (m_blocks_mutex);
   const auto iter = blocks.find (hash);
   if (iter == blocks.end ())
     throw JSONRPCError (RPC_INVALID_PARAMETER, "block hash unknown");
@@ -161,12 +229,18 @@ AuxpowMiner::createAuxBlock (const node::JSONRPCRequest& request,
   auxMiningCheck (request);
   // SYSCOIN
   const node::NodeContext& node = request.nodeContext? *request.nodeContext: EnsureAnyNodeContext(request.context);
-  const CBlockIndex* pindexTip = WITH_LOCK(::cs_main, return node.chainman->ActiveChain().Tip(););
-  LOCK (cs);
-
   const auto& mempool = EnsureAnyMemPool (request.nodeContext? request.nodeContext: request.context);
   uint256 target;
-  const CBlock* pblock = getCurrentBlock (*node.chainman, mempool, scriptPubKey, target);
+  const auto time_start{SteadyClock::now ()};
+  AuxBlockTimings timings;
+  const std::shared_ptr<const CBlock> pblock = getCurrentBlock (*node.chainman, mempool, scriptPubKey, target, &timings);
+  timings.total = std::chrono::duration_cast<std::chrono::microseconds> (SteadyClock::now () - time_start);
+  WITH_LOCK (m_timings_mutex, lastTimings = timings);
+  LogPrint (BCLog::BENCHMARK, "createauxblock base: %.2fms, coinbase: %.2fms (total %.2fms)\n",
+            Ticks<MillisecondsDouble> (timings.base),
+            Ticks<MillisecondsDouble> (timings.coinbase),
+            Ticks<MillisecondsDouble> (timings.total));
+  const CBlockIndex* pindexTip = WITH_LOCK(::cs_main, return node.chainman->m_blockman.LookupBlockIndex(pblock->hashPrevBlock););
 
   // SYSCOIN
   int nActiveHeight = pindexTip->nHeight - 5;
@@ -182,7 +256,7 @@ AuxpowMiner::createAuxBlock (const node::JSONRPCRequest& request,
   // SYSCOIN
   result.pushKV ("coinbasescript", HexStr(createScriptPubKey(refIndex->GetBlockHash(), refIndex->nHeight)));
   result.pushKV ("bits", strprintf ("%08x", pblock->nBits));
-  result.pushKV ("height", static_cast<int64_t> (pindexPrev->nHeight + 1));
+  result.pushKV ("height", static_cast<int64_t> (pindexTip->nHeight + 1));
   result.pushKV ("_target", HexStr (target));
 
   return result;
@@ -193,15 +267,9 @@ AuxpowMiner::submitAuxBlock (const node::JSONRPCRequest& request,
                              const std::string& hashHex,
                              const std::string& auxpowHex) const
 {
-  auxMiningCheck (request);
   auto& chainman = EnsureAnyChainman (request.nodeContext? request.nodeContext: request.context);
 
-  std::shared_ptr<CBlock> shared_block;
-  {
-    LOCK (cs);
-    const CBlock* pblock = lookupSavedBlock (hashHex);
-    shared_block = std::make_shared<CBlock> (*pblock);
-  }
+  std::shared_ptr<CBlock> shared_block = std::make_shared<CBlock> (*lookupSavedBlock (hashHex));
 
   const std::vector<unsigned char> vchAuxPow = ParseHex (auxpowHex);
   CDataStream ss(vchAuxPow, SER_GETHASH, PROTOCOL_VERSION);
@@ -210,9 +278,37 @@ AuxpowMiner::submitAuxBlock (const node::JSONRPCRequest& request,
   shared_block->SetAuxpow (std::move (pow));
   CHECK_NONFATAL(shared_block->GetHash ().GetHex () == hashHex);
 
+  // SYSCOIN
+  /* Turn away stale and invalid work from parent chain miners before
+     anything takes cs_main:  the block has to build on the current tip, and
+     the parent PoW has to meet our target with valid merkle branches.  None
+     of this needs chain state, so concurrent submissions don't queue up
+     behind ProcessNewBlock to be rejected.  The tip is unknown until the
+     first block is connected, leave that case to ProcessNewBlock.  */
+  const uint256 hashBestBlock = WITH_LOCK (g_best_block_mutex, return g_best_block);
+  if (!hashBestBlock.IsNull () && shared_block->hashPrevBlock != hashBestBlock)
+    {
+      LogPrint (BCLog::RPC, "%s: block %s is stale, the tip is %s now\n",
+                __func__, hashHex, hashBestBlock.GetHex ());
+      return false;
+    }
+  if (!CheckProofOfWork (*shared_block, chainman.GetConsensus ()))
+    {
+      LogPrint (BCLog::RPC, "%s: block %s has an invalid auxpow\n", __func__, hashHex);
+      return false;
+    }
+
+  auxMiningCheck (request);
   return chainman.ProcessNewBlock(shared_block, true, true, nullptr);
 }
 
+std::optional<AuxBlockTimings>
+AuxpowMiner::getLastTimings () const
+{
+  LOCK (m_timings_mutex);
+  return lastTimings;
+}
+
 AuxpowMiner&
 AuxpowMiner::get ()
 {
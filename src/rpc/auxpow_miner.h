@@ -7,12 +7,15 @@
 
 #include <node/miner.h>
 #include <script/script.h>
+#include <sync.h>
 #include <txmempool.h>
 #include <uint256.h>
 #include <univalue.h>
 
+#include <chrono>
 #include <map>
 #include <memory>
+#include <optional>
 #include <string>
 #include <vector>
 #include <kernel/cs_main.h>
@@ -26,6 +29,16 @@ namespace auxpow_tests
 class AuxpowMinerForTest;
 }
 class ChainstateManager;
+// SYSCOIN
+/** How long a createauxblock call took, by phase */
+struct AuxBlockTimings
+{
+  /** Building the base template, zero if the current one was used.  */
+  std::chrono::microseconds base{0};
+  /** Making the block for the coinbase script, zero if it was cached.  */
+  std::chrono::microseconds coinbase{0};
+  std::chrono::microseconds total{0};
+};
 /**
  * This class holds "global" state used to construct blocks for the auxpow
  * mining RPCs and the map of already constructed blocks to look them up
@@ -39,37 +52,63 @@ class AuxpowMiner
 
 private:
 
-  /** The lock used for state in this object.  */
-  mutable RecursiveMutex cs;
-  /** All currently "active" block templates.  */
-  std::vector<std::unique_ptr<node::CBlockTemplate>> templates;
-  /** Maps block hashes to pointers in vTemplates.  Does not own the memory.  */
-  std::map<uint256, const CBlock*> blocks;
-  /** Maps coinbase script hashes to pointers in vTemplates.  Does not own the memory.  */
-  std::map<CScriptID, const CBlock*> curBlocks;
+  // SYSCOIN
+  /** Serialises building the base template, so concurrent workers wait for
+      one CreateNewBlock instead of each running their own.  */
+  Mutex m_build_mutex;
+
+  /** The lock used for state in this object.  It is only held for lookups
+      and updates, never while a block is built.  */
+  mutable Mutex cs;
+  /** Template shared by all coinbase scripts, built on pindexPrev.  */
+  std::shared_ptr<const node::CBlockTemplate> baseTemplate GUARDED_BY(cs);
+  /** Maps coinbase script hashes to the blocks made from baseTemplate.  */
+  std::map<CScriptID, std::shared_ptr<const CBlock>> curBlocks GUARDED_BY(cs);
 
   /** The current extra nonce for block creation.  */
-  unsigned extraNonce = 0;
+  unsigned extraNonce GUARDED_BY(cs) = 0;
+
+  /* Some data about when the current base template was constructed.  */
+  unsigned txUpdatedLast GUARDED_BY(cs) = 0;
+  const CBlockIndex* pindexPrev GUARDED_BY(cs) = nullptr;
+  uint64_t startTime GUARDED_BY(cs) = 0;
+
+  /** Lock of the lookup table for submitauxblock, taken apart from cs so
+      submissions don't wait behind block creation.  */
+  mutable Mutex m_blocks_mutex;
+  /** All blocks handed out on the current tip by their hash.  */
+  std::map<uint256, std::shared_ptr<const CBlock>> blocks GUARDED_BY(m_blocks_mutex);
+
+  mutable Mutex m_timings_mutex;
+  std::optional<AuxBlockTimings> lastTimings GUARDED_BY(m_timings_mutex);
 
-  /* Some data about when the current block (pblock) was constructed.  */
-  unsigned txUpdatedLast;
-  const CBlockIndex* pindexPrev = nullptr;
-  uint64_t startTime;
+  /** Whether the base template can still be handed out on tip.  */
+  bool isBaseFresh (const CBlockIndex* tip, const CTxMemPool& mempool) const EXCLUSIVE_LOCKS_REQUIRED(cs);
+
+  /**
+   * Builds a new base template unless another worker just did, and returns
+   * the base template to use.
+   */
+  std::shared_ptr<const node::CBlockTemplate> updateBaseTemplate (ChainstateManager &chainman, const CTxMemPool& mempool)
+      EXCLUSIVE_LOCKS_REQUIRED(!m_build_mutex, !cs, !m_blocks_mutex);
 
   /**
    * Constructs a new current block if necessary (checking the current state to
-   * see if "enough changed" for this), and returns a pointer to the block
-   * that should be returned to a miner for working on at the moment.  Also
-   * fills in the difficulty target value.
+   * see if "enough changed" for this), and returns the block that should be
+   * returned to a miner for working on at the moment.  Blocks for different
+   * coinbase scripts share one base template and only differ in the coinbase
+   * and the merkle root.  Also fills in the difficulty target value.
    */
-  const CBlock* getCurrentBlock (ChainstateManager &chainman, const CTxMemPool& mempool,
-                                 const CScript& scriptPubKey, uint256& target) EXCLUSIVE_LOCKS_REQUIRED(cs);
+  std::shared_ptr<const CBlock> getCurrentBlock (ChainstateManager &chainman, const CTxMemPool& mempool,
+                                                 const CScript& scriptPubKey, uint256& target,
+                                                 AuxBlockTimings* timings = nullptr)
+      EXCLUSIVE_LOCKS_REQUIRED(!m_build_mutex, !cs, !m_blocks_mutex);
 
   /**
    * Looks up a previously constructed block by its (hex-encoded) hash.  If the
    * block is found, it is returned.  Otherwise, a JSONRPCError is thrown.
    */
-  const CBlock* lookupSavedBlock (const std::string& hashHex) const EXCLUSIVE_LOCKS_REQUIRED(cs);
+  std::shared_ptr<const CBlock> lookupSavedBlock (const std::string& hashHex) const EXCLUSIVE_LOCKS_REQUIRED(!m_blocks_mutex);
 
   friend class auxpow_tests::AuxpowMinerForTest;
 
@@ -83,7 +122,8 @@ public:
    * necessary information for the miner to construct an auxpow for it.
    */
   UniValue createAuxBlock (const node::JSONRPCRequest& request,
-                           const CScript& scriptPubKey);
+                           const CScript& scriptPubKey)
+      EXCLUSIVE_LOCKS_REQUIRED(!m_build_mutex, !cs, !m_blocks_mutex, !m_timings_mutex);
 
   // SYSCOIN
   /**
@@ -98,7 +138,12 @@ public:
    */
   bool submitAuxBlock (const node::JSONRPCRequest& request,
                        const std::string& hashHex,
-                       const std::string& auxpowHex) const;
+                       const std::string& auxpowHex) const
+      EXCLUSIVE_LOCKS_REQUIRED(!m_blocks_mutex);
+
+  // SYSCOIN
+  /** Phase timings of the last createauxblock call, if there was one.  */
+  std::optional<AuxBlockTimings> getLastTimings () const EXCLUSIVE_LOCKS_REQUIRED(!m_timings_mutex);
 
   /**
    * Returns the singleton instance of AuxpowMiner that is used for RPCs.
@@ -19,16 +19,19 @@
 #include <deploymentstatus.h>
 #include <hash.h>
 #include <index/blockfilterindex.h>
+#include <index/blockstatsindex.h>
 #include <index/coinstatsindex.h>
 #include <kernel/coinstats.h>
 #include <logging/timer.h>
 #include <net.h>
 #include <net_processing.h>
+#include <node/blockstats.h>
 #include <node/blockstorage.h>
 #include <node/context.h>
 #include <node/transaction.h>
 #include <node/utxo_snapshot.h>
 #include <primitives/transaction.h>
+#include <rpc/jsonstream.h>
 #include <rpc/rawtransaction_util.h>
 #include <rpc/server.h>
 #include <rpc/server_util.h>
@@ -145,7 +148,7 @@ UniValue AuxpowToJSON(const CAuxPow& auxpow, Chainstate& chainstate)
 
     return result;
 }
-static const CBlockIndex* ParseHashOrHeight(const UniValue& param, ChainstateManager& chainman) {
+const CBlockIndex* ParseHashOrHeight(const UniValue& param, ChainstateManager& chainman) {
     LOCK(::cs_main);
     CChain& active_chain = chainman.ActiveChain();
 
@@ -204,14 +207,20 @@ UniValue blockheaderToJSON(const CBlockIndex* tip, const CBlockIndex* blockindex
     return result;
 }
 // SYSCOIN
-UniValue blockToJSON(BlockManager& blockman, const CBlock& block, const CBlockIndex* tip, const CBlockIndex* blockindex, TxVerbosity verbosity, Chainstate* chainstate)
+UniValue blockToJSON(BlockManager& blockman, const CBlock& block, const CBlockIndex* tip, const CBlockIndex* blockindex, TxVerbosity verbosity, Chainstate* chainstate, JSONStreamWriter* stream)
 {
     UniValue result = blockheaderToJSON(tip, blockindex);
 
     result.pushKV("strippedsize", (int)::GetSerializeSize(block, PROTOCOL_VERSION | SERIALIZE_TRANSACTION_NO_WITNESS));
     result.pushKV("size", (int)::GetSerializeSize(block, PROTOCOL_VERSION));
     result.pushKV("weight", (int)::GetBlockWeight(block));
-    UniValue txs(UniValue::VARR);
+    // SYSCOIN a streamed block gets its transactions written one at a time after the summary
+    if (stream) {
+        stream->BeginObject();
+        stream->Fields(result);
+        stream->Key("tx");
+    }
+    RPCResultWriter txs{stream, UniValue::VARR};
 
     switch (verbosity) {
         case TxVerbosity::SHOW_TXID:
@@ -232,13 +241,22 @@ UniValue blockToJSON(BlockManager& blockman, const CBlock& block, const CBlockIn
                 const CTxUndo* txundo = (have_undo && i > 0) ? &blockUndo.vtxundo.at(i - 1) : nullptr;
                 UniValue objTx(UniValue::VOBJ);
                 TxToUniv(*tx, /*block_hash=*/uint256(), /*entry=*/objTx, /*include_hex=*/true, RPCSerializationFlags(), txundo, verbosity);
-                txs.push_back(objTx);
+                txs.push_back(std::move(objTx));
             }
             break;
     }
 
-    result.pushKV("tx", txs);
     // SYSCOIN
+    if (stream) {
+        txs.Finish();
+        if (block.auxpow && chainstate) {
+            stream->Key("auxpow");
+            stream->Value(AuxpowToJSON(*block.auxpow, *chainstate));
+        }
+        stream->EndObject();
+        return NullUniValue;
+    }
+    result.pushKV("tx", txs.Finish());
     if (block.auxpow && chainstate)
         result.pushKV("auxpow", AuxpowToJSON(*block.auxpow, *chainstate));
     return result;
@@ -730,7 +748,8 @@ static CBlock GetBlockChecked(BlockManager& blockman, const CBlockIndex* pblocki
         }
     }
 
-    if (!blockman.ReadBlockFromDisk(block, *pblockindex)) {
+    // SYSCOIN the RPC serializations leave out the PoDA blobs (SER_NO_PODA)
+    if (!blockman.ReadBlockFromDisk(block, *pblockindex, /*fFillNEVMData=*/false)) {
         // Block not found on disk. This could be because we have the block
         // header in our index but not yet have the block or did not accept the
         // block. Or if the block was pruned right after we released the lock above.
@@ -915,7 +934,7 @@ static RPCHelpMan getblock()
         tx_verbosity = TxVerbosity::SHOW_DETAILS_AND_PREVOUT;
     }
     // SYSCOIN
-    return blockToJSON(chainman.m_blockman, block, tip, pblockindex, tx_verbosity, &chainman.ActiveChainstate());
+    return blockToJSON(chainman.m_blockman, block, tip, pblockindex, tx_verbosity, &chainman.ActiveChainstate(), request.stream);
 },
     };
 }
@@ -1850,68 +1869,165 @@ static RPCHelpMan getchaintxstats()
     };
 }
 
-template<typename T>
-static T CalculateTruncatedMedian(std::vector<T>& scores)
+// SYSCOIN
+//! Most blocks getblockstatsrange reports in one call
+static constexpr int MAX_BLOCKSTATS_RANGE{10000};
+
+/** The fields getblockstats reports, each entry of getblockstatsrange has the same ones */
+static std::vector<RPCResult> BlockStatsResultFields()
+{
+    return {
+        {RPCResult::Type::NUM, "avgfee", /*optional=*/true, "Average fee in the block"},
+        {RPCResult::Type::NUM, "avgfeerate", /*optional=*/true, "Average feerate (in satoshis per virtual byte)"},
+        {RPCResult::Type::NUM, "avgtxsize", /*optional=*/true, "Average transaction size"},
+        {RPCResult::Type::STR_HEX, "blockhash", /*optional=*/true, "The block hash (to check for potential reorgs)"},
+        {RPCResult::Type::ARR_FIXED, "feerate_percentiles", /*optional=*/true, "Feerates at the 10th, 25th, 50th, 75th, and 90th percentile weight unit (in satoshis per virtual byte)",
+        {
+            {RPCResult::Type::NUM, "10th_percentile_feerate", "The 10th percentile feerate"},
+            {RPCResult::Type::NUM, "25th_percentile_feerate", "The 25th percentile feerate"},
+            {RPCResult::Type::NUM, "50th_percentile_feerate", "The 50th percentile feerate"},
+            {RPCResult::Type::NUM, "75th_percentile_feerate", "The 75th percentile feerate"},
+            {RPCResult::Type::NUM, "90th_percentile_feerate", "The 90th percentile feerate"},
+        }},
+        {RPCResult::Type::NUM, "height", /*optional=*/true, "The height of the block"},
+        {RPCResult::Type::NUM, "ins", /*optional=*/true, "The number of inputs (excluding coinbase)"},
+        {RPCResult::Type::NUM, "maxfee", /*optional=*/true, "Maximum fee in the block"},
+        {RPCResult::Type::NUM, "maxfeerate", /*optional=*/true, "Maximum feerate (in satoshis per virtual byte)"},
+        {RPCResult::Type::NUM, "maxtxsize", /*optional=*/true, "Maximum transaction size"},
+        {RPCResult::Type::NUM, "medianfee", /*optional=*/true, "Truncated median fee in the block"},
+        {RPCResult::Type::NUM, "mediantime", /*optional=*/true, "The block median time past"},
+        {RPCResult::Type::NUM, "mediantxsize", /*optional=*/true, "Truncated median transaction size"},
+        {RPCResult::Type::NUM, "minfee", /*optional=*/true, "Minimum fee in the block"},
+        {RPCResult::Type::NUM, "minfeerate", /*optional=*/true, "Minimum feerate (in satoshis per virtual byte)"},
+        {RPCResult::Type::NUM, "mintxsize", /*optional=*/true, "Minimum transaction size"},
+        {RPCResult::Type::NUM, "outs", /*optional=*/true, "The number of outputs"},
+        {RPCResult::Type::NUM, "subsidy", /*optional=*/true, "The block subsidy"},
+        {RPCResult::Type::NUM, "swtotal_size", /*optional=*/true, "Total size of all segwit transactions"},
+        {RPCResult::Type::NUM, "swtotal_weight", /*optional=*/true, "Total weight of all segwit transactions"},
+        {RPCResult::Type::NUM, "swtxs", /*optional=*/true, "The number of segwit transactions"},
+        {RPCResult::Type::NUM, "time", /*optional=*/true, "The block time"},
+        {RPCResult::Type::NUM, "total_out", /*optional=*/true, "Total amount in all outputs (excluding coinbase and thus reward [ie subsidy + totalfee])"},
+        {RPCResult::Type::NUM, "total_size", /*optional=*/true, "Total size of all non-coinbase transactions"},
+        {RPCResult::Type::NUM, "total_weight", /*optional=*/true, "Total weight of all non-coinbase transactions"},
+        {RPCResult::Type::NUM, "totalfee", /*optional=*/true, "The fee total"},
+        {RPCResult::Type::NUM, "txs", /*optional=*/true, "The number of transactions (including coinbase)"},
+        {RPCResult::Type::NUM, "utxo_increase", /*optional=*/true, "The increase/decrease in the number of unspent outputs (not discounting op_return and similar)"},
+        {RPCResult::Type::NUM, "utxo_size_inc", /*optional=*/true, "The increase/decrease in size for the utxo index (not discounting op_return and similar)"},
+        {RPCResult::Type::NUM, "utxo_increase_actual", /*optional=*/true, "The increase/decrease in the number of unspent outputs, not counting unspendables"},
+        {RPCResult::Type::NUM, "utxo_size_inc_actual", /*optional=*/true, "The increase/decrease in size for the utxo index, not counting unspendables"},
+        {RPCResult::Type::NUM, "asset_txs", /*optional=*/true, "The number of asset allocation sends, burns and mints"},
+        {RPCResult::Type::NUM, "asset_outs", /*optional=*/true, "The number of outputs carrying an asset"},
+        {RPCResult::Type::NUM, "mint_txs", /*optional=*/true, "The number of asset mints"},
+        {RPCResult::Type::NUM, "mint_volume", /*optional=*/true, "Total asset amount minted"},
+        {RPCResult::Type::NUM, "asset_burn_txs", /*optional=*/true, "The number of asset allocation burns to NEVM or SYS"},
+        {RPCResult::Type::NUM, "asset_burn_volume", /*optional=*/true, "Total asset amount burned to NEVM or SYS"},
+        {RPCResult::Type::NUM, "sys_burn_txs", /*optional=*/true, "The number of SYS burns to SYSX allocations"},
+        {RPCResult::Type::NUM, "sys_burn_volume", /*optional=*/true, "Total SYS amount burned to SYSX allocations"},
+        {RPCResult::Type::NUM, "nevm_blobs", /*optional=*/true, "The number of PoDA blobs"},
+        {RPCResult::Type::NUM, "nevm_blob_size", /*optional=*/true, "Total size of the PoDA blobs (blobs pruned before the stats were computed count as 0)"},
+        {RPCResult::Type::NUM, "mn_txs", /*optional=*/true, "The number of masternode registration and update transactions"},
+        {RPCResult::Type::NUM, "quorum_commitments", /*optional=*/true, "The number of quorum commitments"},
+    };
+}
+
+/** Parse the selected statistics argument, empty for all */
+static std::set<std::string> ParseBlockStatsSelection(const UniValue& param)
 {
-    size_t size = scores.size();
-    if (size == 0) {
-        return 0;
+    std::set<std::string> stats;
+    if (!param.isNull()) {
+        const UniValue stats_univalue = param.get_array();
+        for (unsigned int i = 0; i < stats_univalue.size(); i++) {
+            const std::string stat = stats_univalue[i].get_str();
+            stats.insert(stat);
+        }
     }
+    return stats;
+}
 
-    std::sort(scores.begin(), scores.end());
-    if (size % 2 == 0) {
-        return (scores[size / 2 - 1] + scores[size / 2]) / 2;
-    } else {
-        return scores[size / 2];
+/** Statistics of a block, read from the block stats index when it has them */
+static node::BlockStats GetBlockStats(ChainstateManager& chainman, const CBlockIndex& pindex)
+{
+    if (g_block_stats_index) {
+        if (auto stats{g_block_stats_index->LookUpStats(pindex)}) return *stats;
     }
+    const CBlock& block = GetBlockChecked(chainman.m_blockman, &pindex);
+    const CBlockUndo& blockUndo = GetUndoChecked(chainman.m_blockman, &pindex);
+    return node::ComputeBlockStats(block, blockUndo, pindex);
 }
 
-void CalculatePercentilesByWeight(CAmount result[NUM_GETBLOCKSTATS_PERCENTILES], std::vector<std::pair<CAmount, int64_t>>& scores, int64_t total_weight)
+static UniValue BlockStatsToJSON(const node::BlockStats& stats, const CBlockIndex& pindex, const ChainstateManager& chainman, const std::set<std::string>& selected)
 {
-    if (scores.empty()) {
-        return;
+    UniValue feerates_res(UniValue::VARR);
+    for (int64_t i = 0; i < node::NUM_GETBLOCKSTATS_PERCENTILES; i++) {
+        feerates_res.push_back(stats.feerate_percentiles[i]);
     }
 
-    std::sort(scores.begin(), scores.end());
-
-    // 10th, 25th, 50th, 75th, and 90th percentile weight units.
-    const double weights[NUM_GETBLOCKSTATS_PERCENTILES] = {
-        total_weight / 10.0, total_weight / 4.0, total_weight / 2.0, (total_weight * 3.0) / 4.0, (total_weight * 9.0) / 10.0
-    };
-
-    int64_t next_percentile_index = 0;
-    int64_t cumulative_weight = 0;
-    for (const auto& element : scores) {
-        cumulative_weight += element.second;
-        while (next_percentile_index < NUM_GETBLOCKSTATS_PERCENTILES && cumulative_weight >= weights[next_percentile_index]) {
-            result[next_percentile_index] = element.first;
-            ++next_percentile_index;
-        }
+    UniValue ret_all(UniValue::VOBJ);
+    ret_all.pushKV("avgfee", (stats.txs > 1) ? stats.totalfee / (stats.txs - 1) : 0);
+    ret_all.pushKV("avgfeerate", stats.total_weight ? (stats.totalfee * WITNESS_SCALE_FACTOR) / stats.total_weight : 0); // Unit: sat/vbyte
+    ret_all.pushKV("avgtxsize", (stats.txs > 1) ? stats.total_size / (stats.txs - 1) : 0);
+    ret_all.pushKV("blockhash", pindex.GetBlockHash().GetHex());
+    ret_all.pushKV("feerate_percentiles", feerates_res);
+    ret_all.pushKV("height", (int64_t)pindex.nHeight);
+    ret_all.pushKV("ins", stats.ins);
+    ret_all.pushKV("maxfee", stats.maxfee);
+    ret_all.pushKV("maxfeerate", stats.maxfeerate);
+    ret_all.pushKV("maxtxsize", stats.maxtxsize);
+    ret_all.pushKV("medianfee", stats.medianfee);
+    ret_all.pushKV("mediantime", pindex.GetMedianTimePast());
+    ret_all.pushKV("mediantxsize", stats.mediantxsize);
+    ret_all.pushKV("minfee", stats.minfee);
+    ret_all.pushKV("minfeerate", stats.minfeerate);
+    ret_all.pushKV("mintxsize", stats.mintxsize);
+    ret_all.pushKV("outs", stats.outs);
+    ret_all.pushKV("subsidy", GetBlockSubsidy(pindex.nHeight, chainman.GetParams().GetConsensus()));
+    ret_all.pushKV("swtotal_size", stats.swtotal_size);
+    ret_all.pushKV("swtotal_weight", stats.swtotal_weight);
+    ret_all.pushKV("swtxs", stats.swtxs);
+    ret_all.pushKV("time", pindex.GetBlockTime());
+    ret_all.pushKV("total_out", stats.total_out);
+    ret_all.pushKV("total_size", stats.total_size);
+    ret_all.pushKV("total_weight", stats.total_weight);
+    ret_all.pushKV("totalfee", stats.totalfee);
+    ret_all.pushKV("txs", stats.txs);
+    ret_all.pushKV("utxo_increase", stats.outs - stats.ins);
+    ret_all.pushKV("utxo_size_inc", stats.utxo_size_inc);
+    ret_all.pushKV("utxo_increase_actual", stats.utxos - stats.ins);
+    ret_all.pushKV("utxo_size_inc_actual", stats.utxo_size_inc_actual);
+    ret_all.pushKV("asset_txs", stats.asset_txs);
+    ret_all.pushKV("asset_outs", stats.asset_outs);
+    ret_all.pushKV("mint_txs", stats.mint_txs);
+    ret_all.pushKV("mint_volume", stats.mint_volume);
+    ret_all.pushKV("asset_burn_txs", stats.asset_burn_txs);
+    ret_all.pushKV("asset_burn_volume", stats.asset_burn_volume);
+    ret_all.pushKV("sys_burn_txs", stats.sys_burn_txs);
+    ret_all.pushKV("sys_burn_volume", stats.sys_burn_volume);
+    ret_all.pushKV("nevm_blobs", stats.nevm_blobs);
+    ret_all.pushKV("nevm_blob_size", stats.nevm_blob_size);
+    ret_all.pushKV("mn_txs", stats.mn_txs);
+    ret_all.pushKV("quorum_commitments", stats.quorum_commitments);
+
+    if (selected.empty()) {
+        return ret_all;
     }
 
-    // Fill any remaining percentiles with the last value.
-    for (int64_t i = next_percentile_index; i < NUM_GETBLOCKSTATS_PERCENTILES; i++) {
-        result[i] = scores.back().first;
+    UniValue ret(UniValue::VOBJ);
+    for (const std::string& stat : selected) {
+        const UniValue& value = ret_all[stat];
+        if (value.isNull()) {
+            throw JSONRPCError(RPC_INVALID_PARAMETER, strprintf("Invalid selected statistic '%s'", stat));
+        }
+        ret.pushKV(stat, value);
     }
+    return ret;
 }
 
-
-template<typename T>
-static inline bool SetHasKeys(const std::set<T>& set) {return false;}
-template<typename T, typename Tk, typename... Args>
-static inline bool SetHasKeys(const std::set<T>& set, const Tk& key, const Args&... args)
-{
-    return (set.count(key) != 0) || SetHasKeys(set, args...);
-}
-
-// outpoint (needed for the utxo index) + nHeight + fCoinBase
-static constexpr size_t PER_UTXO_OVERHEAD = sizeof(COutPoint) + sizeof(uint32_t) + sizeof(bool);
-
 static RPCHelpMan getblockstats()
 {
     return RPCHelpMan{"getblockstats",
                 "\nCompute per block statistics for a given window. All amounts are in satoshis.\n"
-                "It won't work for some heights with pruning.\n",
+                "It won't work for some heights with pruning.\n"
+                "With -blockstatsindex the statistics of blocks of the active chain are read from the index.\n",
                 {
                     {"hash_or_height", RPCArg::Type::NUM, RPCArg::Optional::NO, "The block hash or height of the target block",
                      RPCArgOptions{
@@ -1925,48 +2041,7 @@ static RPCHelpMan getblockstats()
                         },
                         RPCArgOptions{.oneline_description="stats"}},
                 },
-                RPCResult{
-            RPCResult::Type::OBJ, "", "",
-            {
-                {RPCResult::Type::NUM, "avgfee", /*optional=*/true, "Average fee in the block"},
-                {RPCResult::Type::NUM, "avgfeerate", /*optional=*/true, "Average feerate (in satoshis per virtual byte)"},
-                {RPCResult::Type::NUM, "avgtxsize", /*optional=*/true, "Average transaction size"},
-                {RPCResult::Type::STR_HEX, "blockhash", /*optional=*/true, "The block hash (to check for potential reorgs)"},
-                {RPCResult::Type::ARR_FIXED, "feerate_percentiles", /*optional=*/true, "Feerates at the 10th, 25th, 50th, 75th, and 90th percentile weight unit (in satoshis per virtual byte)",
-                {
-                    {RPCResult::Type::NUM, "10th_percentile_feerate", "The 10th percentile feerate"},
-                    {RPCResult::Type::NUM, "25th_percentile_feerate", "The 25th percentile feerate"},
-                    {RPCResult::Type::NUM, "50th_percentile_feerate", "The 50th percentile feerate"},
-                    {RPCResult::Type::NUM, "75th_percentile_feerate", "The 75th percentile feerate"},
-                    {RPCResult::Type::NUM, "90th_percentile_feerate", "The 90th percentile feerate"},
-                }},
-                {RPCResult::Type::NUM, "height", /*optional=*/true, "The height of the block"},
-                {RPCResult::Type::NUM, "ins", /*optional=*/true, "The number of inputs (excluding coinbase)"},
-                {RPCResult::Type::NUM, "maxfee", /*optional=*/true, "Maximum fee in the block"},
-                {RPCResult::Type::NUM, "maxfeerate", /*optional=*/true, "Maximum feerate (in satoshis per virtual byte)"},
-                {RPCResult::Type::NUM, "maxtxsize", /*optional=*/true, "Maximum transaction size"},
-                {RPCResult::Type::NUM, "medianfee", /*optional=*/true, "Truncated median fee in the block"},
-                {RPCResult::Type::NUM, "mediantime", /*optional=*/true, "The block median time past"},
-                {RPCResult::Type::NUM, "mediantxsize", /*optional=*/true, "Truncated median transaction size"},
-                {RPCResult::Type::NUM, "minfee", /*optional=*/true, "Minimum fee in the block"},
-                {RPCResult::Type::NUM, "minfeerate", /*optional=*/true, "Minimum feerate (in satoshis per virtual byte)"},
-                {RPCResult::Type::NUM, "mintxsize", /*optional=*/true, "Minimum transaction size"},
-                {RPCResult::Type::NUM, "outs", /*optional=*/true, "The number of outputs"},
-                {RPCResult::Type::NUM, "subsidy", /*optional=*/true, "The block subsidy"},
-                {RPCResult::Type::NUM, "swtotal_size", /*optional=*/true, "Total size of all segwit transactions"},
-                {RPCResult::Type::NUM, "swtotal_weight", /*optional=*/true, "Total weight of all segwit transactions"},
-                {RPCResult::Type::NUM, "swtxs", /*optional=*/true, "The number of segwit transactions"},
-                {RPCResult::Type::NUM, "time", /*optional=*/true, "The block time"},
-                {RPCResult::Type::NUM, "total_out", /*optional=*/true, "Total amount in all outputs (excluding coinbase and thus reward [ie subsidy + totalfee])"},
-                {RPCResult::Type::NUM, "total_size", /*optional=*/true, "Total size of all non-coinbase transactions"},
-                {RPCResult::Type::NUM, "total_weight", /*optional=*/true, "Total weight of all non-coinbase transactions"},
-                {RPCResult::Type::NUM, "totalfee", /*optional=*/true, "The fee total"},
-                {RPCResult::Type::NUM, "txs", /*optional=*/true, "The number of transactions (including coinbase)"},
-                {RPCResult::Type::NUM, "utxo_increase", /*optional=*/true, "The increase/decrease in the number of unspent outputs (not discounting op_return and similar)"},
-                {RPCResult::Type::NUM, "utxo_size_inc", /*optional=*/true, "The increase/decrease in size for the utxo index (not discounting op_return and similar)"},
-                {RPCResult::Type::NUM, "utxo_increase_actual", /*optional=*/true, "The increase/decrease in the number of unspent outputs, not counting unspendables"},
-                {RPCResult::Type::NUM, "utxo_size_inc_actual", /*optional=*/true, "The increase/decrease in size for the utxo index, not counting unspendables"},
-            }},
+                RPCResult{RPCResult::Type::OBJ, "", "", BlockStatsResultFields()},
                 RPCExamples{
                     HelpExampleCli("getblockstats", R"('"00000000c937983704a73af28acdec37b049d214adbda81d7e2a3dd146f6ed09"' '["minfeerate","avgfeerate"]')") +
                     HelpExampleCli("getblockstats", R"(1000 '["minfeerate","avgfeerate"]')") +
@@ -1977,191 +2052,64 @@ static RPCHelpMan getblockstats()
 {
     ChainstateManager& chainman = EnsureAnyChainman(request.context);
     const CBlockIndex& pindex{*CHECK_NONFATAL(ParseHashOrHeight(request.params[0], chainman))};
+    const std::set<std::string> stats{ParseBlockStatsSelection(request.params[1])};
 
-    std::set<std::string> stats;
-    if (!request.params[1].isNull()) {
-        const UniValue stats_univalue = request.params[1].get_array();
-        for (unsigned int i = 0; i < stats_univalue.size(); i++) {
-            const std::string stat = stats_univalue[i].get_str();
-            stats.insert(stat);
-        }
-    }
-
-    const CBlock& block = GetBlockChecked(chainman.m_blockman, &pindex);
-    const CBlockUndo& blockUndo = GetUndoChecked(chainman.m_blockman, &pindex);
-
-    const bool do_all = stats.size() == 0; // Calculate everything if nothing selected (default)
-    const bool do_mediantxsize = do_all || stats.count("mediantxsize") != 0;
-    const bool do_medianfee = do_all || stats.count("medianfee") != 0;
-    const bool do_feerate_percentiles = do_all || stats.count("feerate_percentiles") != 0;
-    const bool loop_inputs = do_all || do_medianfee || do_feerate_percentiles ||
-        SetHasKeys(stats, "utxo_increase", "utxo_increase_actual", "utxo_size_inc", "utxo_size_inc_actual", "totalfee", "avgfee", "avgfeerate", "minfee", "maxfee", "minfeerate", "maxfeerate");
-    const bool loop_outputs = do_all || loop_inputs || stats.count("total_out");
-    const bool do_calculate_size = do_mediantxsize ||
-        SetHasKeys(stats, "total_size", "avgtxsize", "mintxsize", "maxtxsize", "swtotal_size");
-    const bool do_calculate_weight = do_all || SetHasKeys(stats, "total_weight", "avgfeerate", "swtotal_weight", "avgfeerate", "feerate_percentiles", "minfeerate", "maxfeerate");
-    const bool do_calculate_sw = do_all || SetHasKeys(stats, "swtxs", "swtotal_size", "swtotal_weight");
-
-    CAmount maxfee = 0;
-    CAmount maxfeerate = 0;
-    CAmount minfee = MAX_MONEY;
-    CAmount minfeerate = MAX_MONEY;
-    CAmount total_out = 0;
-    CAmount totalfee = 0;
-    int64_t inputs = 0;
-    int64_t maxtxsize = 0;
-    int64_t mintxsize = MAX_BLOCK_SERIALIZED_SIZE;
-    int64_t outputs = 0;
-    int64_t swtotal_size = 0;
-    int64_t swtotal_weight = 0;
-    int64_t swtxs = 0;
-    int64_t total_size = 0;
-    int64_t total_weight = 0;
-    int64_t utxos = 0;
-    int64_t utxo_size_inc = 0;
-    int64_t utxo_size_inc_actual = 0;
-    std::vector<CAmount> fee_array;
-    std::vector<std::pair<CAmount, int64_t>> feerate_array;
-    std::vector<int64_t> txsize_array;
-
-    for (size_t i = 0; i < block.vtx.size(); ++i) {
-        const auto& tx = block.vtx.at(i);
-        outputs += tx->vout.size();
-
-        CAmount tx_total_out = 0;
-        if (loop_outputs) {
-            tx_total_out = tx->GetValueOut();
-            for (const CTxOut& out : tx->vout) {
-                tx_total_out += out.nValue;
-                // SYSCOIN
-                size_t out_size = GetSerializeSize(out, PROTOCOL_VERSION, SER_SIZE, tx->nVersion) + PER_UTXO_OVERHEAD;
-                utxo_size_inc += out_size;
-
-                // The Genesis block and the repeated BIP30 block coinbases don't change the UTXO
-                // set counts, so they have to be excluded from the statistics
-                if (pindex.nHeight == 0 || (IsBIP30Repeat(pindex) && tx->IsCoinBase())) continue;
-                // Skip unspendable outputs since they are not included in the UTXO set
-                if (out.scriptPubKey.IsUnspendable()) continue;
-
-                ++utxos;
-                utxo_size_inc_actual += out_size;
-            }
-        }
-
-        if (tx->IsCoinBase()) {
-            continue;
-        }
-
-        inputs += tx->vin.size(); // Don't count coinbase's fake input
-        total_out += tx_total_out; // Don't count coinbase reward
-
-        int64_t tx_size = 0;
-        if (do_calculate_size) {
-
-            tx_size = tx->GetTotalSize();
-            if (do_mediantxsize) {
-                txsize_array.push_back(tx_size);
-            }
-            maxtxsize = std::max(maxtxsize, tx_size);
-            mintxsize = std::min(mintxsize, tx_size);
-            total_size += tx_size;
-        }
+    return BlockStatsToJSON(GetBlockStats(chainman, pindex), pindex, chainman, stats);
+},
+    };
+}
 
-        int64_t weight = 0;
-        if (do_calculate_weight) {
-            weight = GetTransactionWeight(*tx);
-            total_weight += weight;
-        }
+// SYSCOIN
+static RPCHelpMan getblockstatsrange()
+{
+    return RPCHelpMan{"getblockstatsrange",
+                "\nCompute per block statistics, as getblockstats does, of consecutive blocks of the active chain. All amounts are in satoshis.\n"
+                "With -blockstatsindex the statistics are read from the index, blocks it has not reached yet are computed.\n",
+                {
+                    {"start_height", RPCArg::Type::NUM, RPCArg::Optional::NO, "The height of the first block"},
+                    {"count", RPCArg::Type::NUM, RPCArg::Default{100}, strprintf("The number of blocks, at most %d, fewer if the tip is reached", MAX_BLOCKSTATS_RANGE)},
+                    {"stats", RPCArg::Type::ARR, RPCArg::DefaultHint{"all values"}, "Values to plot (see result of getblockstats)",
+                        {
+                            {"height", RPCArg::Type::STR, RPCArg::Optional::OMITTED, "Selected statistic"},
+                            {"time", RPCArg::Type::STR, RPCArg::Optional::OMITTED, "Selected statistic"},
+                        },
+                        RPCArgOptions{.oneline_description="stats"}},
+                },
+                RPCResult{RPCResult::Type::ARR, "", "Statistics of each block by increasing height",
+                {
+                    {RPCResult::Type::OBJ, "", "", BlockStatsResultFields()},
+                }},
+                RPCExamples{
+                    HelpExampleCli("getblockstatsrange", R"(1000 10 '["height","totalfee","asset_txs","nevm_blobs"]')") +
+                    HelpExampleRpc("getblockstatsrange", R"(1000, 10, ["height","totalfee","asset_txs","nevm_blobs"])")
+                },
+        [&](const RPCHelpMan& self, const node::JSONRPCRequest& request) -> UniValue
+{
+    ChainstateManager& chainman = EnsureAnyChainman(request.context);
+    const int start_height{request.params[0].getInt<int>()};
+    const int count{request.params[1].isNull() ? 100 : request.params[1].getInt<int>()};
+    if (count <= 0 || count > MAX_BLOCKSTATS_RANGE) {
+        throw JSONRPCError(RPC_INVALID_PARAMETER, strprintf("count must be between 1 and %d", MAX_BLOCKSTATS_RANGE));
+    }
+    const std::set<std::string> stats{ParseBlockStatsSelection(request.params[2])};
 
-        if (do_calculate_sw && tx->HasWitness()) {
-            ++swtxs;
-            swtotal_size += tx_size;
-            swtotal_weight += weight;
+    std::vector<const CBlockIndex*> vBlocks;
+    {
+        LOCK(cs_main);
+        const CChain& active_chain = chainman.ActiveChain();
+        if (start_height < 0 || start_height > active_chain.Height()) {
+            throw JSONRPCError(RPC_INVALID_PARAMETER, "Start height out of range");
         }
-
-        if (loop_inputs) {
-            CAmount tx_total_in = 0;
-            const auto& txundo = blockUndo.vtxundo.at(i - 1);
-            for (const Coin& coin: txundo.vprevout) {
-                const CTxOut& prevoutput = coin.out;
-
-                tx_total_in += prevoutput.nValue;
-                size_t prevout_size = GetSerializeSize(prevoutput, PROTOCOL_VERSION, SER_SIZE, tx->nVersion) + PER_UTXO_OVERHEAD;
-                utxo_size_inc -= prevout_size;
-                utxo_size_inc_actual -= prevout_size;
-            }
-
-            CAmount txfee = tx_total_in - tx_total_out;
-            CHECK_NONFATAL(MoneyRange(txfee));
-            if (do_medianfee) {
-                fee_array.push_back(txfee);
-            }
-            maxfee = std::max(maxfee, txfee);
-            minfee = std::min(minfee, txfee);
-            totalfee += txfee;
-
-            // New feerate uses satoshis per virtual byte instead of per serialized byte
-            CAmount feerate = weight ? (txfee * WITNESS_SCALE_FACTOR) / weight : 0;
-            if (do_feerate_percentiles) {
-                feerate_array.emplace_back(feerate, weight);
-            }
-            maxfeerate = std::max(maxfeerate, feerate);
-            minfeerate = std::min(minfeerate, feerate);
+        const int end_height{std::min(active_chain.Height(), start_height + count - 1)};
+        vBlocks.reserve(end_height - start_height + 1);
+        for (int height = start_height; height <= end_height; ++height) {
+            vBlocks.push_back(active_chain[height]);
         }
     }
 
-    CAmount feerate_percentiles[NUM_GETBLOCKSTATS_PERCENTILES] = { 0 };
-    CalculatePercentilesByWeight(feerate_percentiles, feerate_array, total_weight);
-
-    UniValue feerates_res(UniValue::VARR);
-    for (int64_t i = 0; i < NUM_GETBLOCKSTATS_PERCENTILES; i++) {
-        feerates_res.push_back(feerate_percentiles[i]);
-    }
-
-    UniValue ret_all(UniValue::VOBJ);
-    ret_all.pushKV("avgfee", (block.vtx.size() > 1) ? totalfee / (block.vtx.size() - 1) : 0);
-    ret_all.pushKV("avgfeerate", total_weight ? (totalfee * WITNESS_SCALE_FACTOR) / total_weight : 0); // Unit: sat/vbyte
-    ret_all.pushKV("avgtxsize", (block.vtx.size() > 1) ? total_size / (block.vtx.size() - 1) : 0);
-    ret_all.pushKV("blockhash", pindex.GetBlockHash().GetHex());
-    ret_all.pushKV("feerate_percentiles", feerates_res);
-    ret_all.pushKV("height", (int64_t)pindex.nHeight);
-    ret_all.pushKV("ins", inputs);
-    ret_all.pushKV("maxfee", maxfee);
-    ret_all.pushKV("maxfeerate", maxfeerate);
-    ret_all.pushKV("maxtxsize", maxtxsize);
-    ret_all.pushKV("medianfee", CalculateTruncatedMedian(fee_array));
-    ret_all.pushKV("mediantime", pindex.GetMedianTimePast());
-    ret_all.pushKV("mediantxsize", CalculateTruncatedMedian(txsize_array));
-    ret_all.pushKV("minfee", (minfee == MAX_MONEY) ? 0 : minfee);
-    ret_all.pushKV("minfeerate", (minfeerate == MAX_MONEY) ? 0 : minfeerate);
-    ret_all.pushKV("mintxsize", mintxsize == MAX_BLOCK_SERIALIZED_SIZE ? 0 : mintxsize);
-    ret_all.pushKV("outs", outputs);
-    ret_all.pushKV("subsidy", GetBlockSubsidy(pindex.nHeight, chainman.GetParams().GetConsensus()));
-    ret_all.pushKV("swtotal_size", swtotal_size);
-    ret_all.pushKV("swtotal_weight", swtotal_weight);
-    ret_all.pushKV("swtxs", swtxs);
-    ret_all.pushKV("time", pindex.GetBlockTime());
-    ret_all.pushKV("total_out", total_out);
-    ret_all.pushKV("total_size", total_size);
-    ret_all.pushKV("total_weight", total_weight);
-    ret_all.pushKV("totalfee", totalfee);
-    ret_all.pushKV("txs", (int64_t)block.vtx.size());
-    ret_all.pushKV("utxo_increase", outputs - inputs);
-    ret_all.pushKV("utxo_size_inc", utxo_size_inc);
-    ret_all.pushKV("utxo_increase_actual", utxos - inputs);
-    ret_all.pushKV("utxo_size_inc_actual", utxo_size_inc_actual);
-
-    if (do_all) {
-        return ret_all;
-    }
-
-    UniValue ret(UniValue::VOBJ);
-    for (const std::string& stat : stats) {
-        const UniValue& value = ret_all[stat];
-        if (value.isNull()) {
-            throw JSONRPCError(RPC_INVALID_PARAMETER, strprintf("Invalid selected statistic '%s'", stat));
-        }
-        ret.pushKV(stat, value);
+    UniValue ret(UniValue::VARR);
+    for (const CBlockIndex* pindex : vBlocks) {
+        ret.push_back(BlockStatsToJSON(GetBlockStats(chainman, *pindex), *pindex, chainman, stats));
     }
     return ret;
 },
@@ -2764,6 +2712,8 @@ static RPCHelpMan dumptxoutset()
                     {RPCResult::Type::NUM, "base_height", "the height of the base of the snapshot"},
                     {RPCResult::Type::STR, "path", "the absolute path that the snapshot was written to"},
                     {RPCResult::Type::STR, "pathjson", "the absolute path that the json snapshot was written to"},
+                    {RPCResult::Type::STR, "pathaux", "the absolute path that the auxiliary state (masternode lists, quorum commitments, NEVM tx roots and minted transactions) was written to"},
+                    {RPCResult::Type::STR_HEX, "auxstate_hash", "the hash of the auxiliary state contents"},
                     {RPCResult::Type::STR_HEX, "txoutset_hash", "the hash of the UTXO set contents"},
                     {RPCResult::Type::NUM, "nchaintx", "the number of transactions in the chain up to and including the base block"},
                 }
@@ -2782,6 +2732,8 @@ static RPCHelpMan dumptxoutset()
     const fs::path temppath = fsbridge::AbsPathJoin(args.GetDataDirNet(), fs::u8path(request.params[0].get_str() + ".incomplete"));
     // SYSCOIN
     const fs::path temppathjson = fsbridge::AbsPathJoin(args.GetDataDirNet(), fs::u8path(request.params[0].get_str() + ".incomplete.json"));
+    const fs::path pathaux = fsbridge::AbsPathJoin(args.GetDataDirNet(), fs::u8path(request.params[0].get_str() + std::string{node::SNAPSHOT_AUX_SUFFIX}));
+    const fs::path temppathaux = fsbridge::AbsPathJoin(args.GetDataDirNet(), fs::u8path(request.params[0].get_str() + ".incomplete" + std::string{node::SNAPSHOT_AUX_SUFFIX}));
 
     if (fs::exists(path)) {
         throw JSONRPCError(
@@ -2800,15 +2752,26 @@ static RPCHelpMan dumptxoutset()
             "Couldn't open file " + temppath.u8string() + " for writing.");
     }
     // SYSCOIN
+    CAutoFile auxfile{fsbridge::fopen(temppathaux, "wb"), CLIENT_VERSION};
+    if (auxfile.IsNull()) {
+        throw JSONRPCError(
+            RPC_INVALID_PARAMETER,
+            "Couldn't open file " + temppathaux.u8string() + " for writing.");
+    }
     NodeContext& node = EnsureAnyNodeContext(request.context);
     UniValue result = CreateUTXOSnapshot(
-        node, node.chainman->ActiveChainstate(), afile, path, temppath, filejson);
+        node, node.chainman->ActiveChainstate(), afile, path, temppath, filejson, &auxfile);
     fclose(filejson);
+    if (auxfile.fclose() != 0) {
+        throw JSONRPCError(RPC_INTERNAL_ERROR, "Couldn't write " + temppathaux.u8string());
+    }
     fs::rename(temppath, path);
     fs::rename(temppathjson, pathjson);
+    fs::rename(temppathaux, pathaux);
     result.pushKV("path", path.u8string());
     // SYSCOIN
     result.pushKV("pathjson", pathjson.u8string());
+    result.pushKV("pathaux", pathaux.u8string());
     return result;
 },
     };
@@ -2820,11 +2783,14 @@ UniValue CreateUTXOSnapshot(
     AutoFile& afile,
     const fs::path& path,
     const fs::path& temppath,
-    FILE* filejson)
+    FILE* filejson,
+    CAutoFile* auxfile)
 {
     std::unique_ptr<CCoinsViewCursor> pcursor;
     std::optional<CCoinsStats> maybe_stats;
     const CBlockIndex* tip;
+    // SYSCOIN
+    std::optional<uint256> hash_auxiliary;
 
     {
         // We need to lock cs_main to ensure that the coinsdb isn't written to
@@ -2850,6 +2816,10 @@ UniValue CreateUTXOSnapshot(
 
         pcursor = chainstate.CoinsDB().Cursor();
         tip = CHECK_NONFATAL(chainstate.m_blockman.LookupBlockIndex(maybe_stats->hashBlock));
+        // SYSCOIN written under the same lock, so the masternode and NEVM state is that of the coins
+        if (auxfile) {
+            hash_auxiliary = node::WriteSnapshotAuxState(*auxfile, *tip, node.rpc_interruption_point);
+        }
     }
 
     LOG_TIME_SECONDS(strprintf("writing UTXO snapshot at height %s (%s) to file %s (via %s)",
@@ -2888,6 +2858,10 @@ UniValue CreateUTXOSnapshot(
     result.pushKV("path", path.u8string());
     result.pushKV("txoutset_hash", maybe_stats->hashSerialized.ToString());
     result.pushKV("nchaintx", tip->nChainTx);
+    // SYSCOIN
+    if (hash_auxiliary) {
+        result.pushKV("auxstate_hash", hash_auxiliary->ToString());
+    }
     return result;
 }
 
@@ -2907,6 +2881,10 @@ static RPCHelpMan loadtxoutset()
         "third-party sources (HTTP, torrent, etc.) which is reasonable since their "
         "contents are always checked by hash.\n\n"
 
+        "Where the chain parameters commit to the Syscoin state of the snapshot (masternode lists, "
+        "quorum commitments, NEVM tx roots and minted transactions), the <path>.aux file written by "
+        "dumptxoutset is loaded and checked by hash as well.\n\n"
+
         "You can find more information on this process in the `assumeutxo` design "
         "document (<https://github.com/syscoin/syscoin/blob/master/doc/design/assumeutxo.md>).",
         {
@@ -2978,9 +2956,18 @@ static RPCHelpMan loadtxoutset()
             RPC_INTERNAL_ERROR,
             "Timed out waiting for base block header to appear in headers chain");
     }
+    // SYSCOIN the auxiliary state is checked before the snapshot is activated and imported after
+    const uint256 hash_auxiliary = chainman.GetParams().AssumeutxoForBlockhash(base_blockhash)->hash_auxiliary;
+    const fs::path pathaux = fs::PathFromString(fs::PathToString(path) + std::string{node::SNAPSHOT_AUX_SUFFIX});
+    if (!hash_auxiliary.IsNull() && !node::ReadSnapshotAuxState(pathaux, *snapshot_start_block, hash_auxiliary, /*import=*/false)) {
+        throw JSONRPCError(RPC_INTERNAL_ERROR, "Unable to load the auxiliary state " + fs::PathToString(pathaux) + " of the UTXO snapshot");
+    }
     if (!chainman.ActivateSnapshot(afile, metadata, false)) {
         throw JSONRPCError(RPC_INTERNAL_ERROR, "Unable to load UTXO snapshot " + fs::PathToString(path));
     }
+    if (!hash_auxiliary.IsNull() && !node::ReadSnapshotAuxState(pathaux, *snapshot_start_block, hash_auxiliary, /*import=*/true)) {
+        throw JSONRPCError(RPC_INTERNAL_ERROR, "UTXO snapshot activated but its auxiliary state " + fs::PathToString(pathaux) + " could not be imported");
+    }
     CBlockIndex* new_tip{WITH_LOCK(::cs_main, return chainman.ActiveTip())};
 
     UniValue result(UniValue::VOBJ);
@@ -3091,6 +3078,7 @@ void RegisterBlockchainRPCCommands(CRPCTable& t)
         {"blockchain", &getchainstates},
         // SYSCOIN
         {"blockchain", &getchainlocks},
+        {"blockchain", &getblockstatsrange},
         {"hidden", &invalidateblock},
         {"hidden", &reconsiderblock},
         {"hidden", &waitfornewblock},
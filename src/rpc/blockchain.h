@@ -19,13 +19,12 @@
 class CBlock;
 class CBlockIndex;
 class Chainstate;
+class JSONStreamWriter;
 class UniValue;
 namespace node {
 struct NodeContext;
 } // namespace node
 
-static constexpr int NUM_GETBLOCKSTATS_PERCENTILES = 5;
-
 /**
  * Get the difficulty of the net wrt to the given block index.
  *
@@ -38,13 +37,15 @@ double GetDifficulty(const CBlockIndex* blockindex);
 void RPCNotifyBlockChange(const CBlockIndex*);
 
 /** Block description to JSON */
-UniValue blockToJSON(node::BlockManager& blockman, const CBlock& block, const CBlockIndex* tip, const CBlockIndex* blockindex, TxVerbosity verbosity, Chainstate* chainstate = nullptr) LOCKS_EXCLUDED(cs_main);
+// SYSCOIN with a stream the block is written to it and null is returned
+UniValue blockToJSON(node::BlockManager& blockman, const CBlock& block, const CBlockIndex* tip, const CBlockIndex* blockindex, TxVerbosity verbosity, Chainstate* chainstate = nullptr, JSONStreamWriter* stream = nullptr) LOCKS_EXCLUDED(cs_main);
 
 /** Block header to JSON */
 UniValue blockheaderToJSON(const CBlockIndex* tip, const CBlockIndex* blockindex) LOCKS_EXCLUDED(cs_main);
 
-/** Used by getblockstats to get feerates at different percentiles by weight  */
-void CalculatePercentilesByWeight(CAmount result[NUM_GETBLOCKSTATS_PERCENTILES], std::vector<std::pair<CAmount, int64_t>>& scores, int64_t total_weight);
+// SYSCOIN
+/** Block of the active chain at a height, or any known block by hash. Throws if there is none. */
+const CBlockIndex* ParseHashOrHeight(const UniValue& param, ChainstateManager& chainman) LOCKS_EXCLUDED(cs_main);
 
 /**
  * Helper to create UTXO snapshots given a chainstate and a file handle.
@@ -57,6 +58,7 @@ UniValue CreateUTXOSnapshot(
     AutoFile& afile,
     const fs::path& path,
     const fs::path& tmppath,
-    FILE* filejson = nullptr);
+    FILE* filejson = nullptr,
+    CAutoFile* auxfile = nullptr);
 
 #endif // SYSCOIN_RPC_BLOCKCHAIN_H
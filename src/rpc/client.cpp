@@ -245,6 +245,9 @@ static const CRPCConvertParam vRPCConvertParams[] =
     { "verifychain", 1, "nblocks" },
     { "getblockstats", 0, "hash_or_height" },
     { "getblockstats", 1, "stats" },
+    { "getblockstatsrange", 0, "start_height" },
+    { "getblockstatsrange", 1, "count" },
+    { "getblockstatsrange", 2, "stats" },
     { "pruneblockchain", 0, "height" },
     { "keypoolrefill", 0, "newsize" },
     { "getrawmempool", 0, "verbose" },
@@ -300,6 +303,7 @@ static const CRPCConvertParam vRPCConvertParams[] =
     { "loadwallet", 1, "load_on_startup"},
     { "unloadwallet", 1, "load_on_startup"},
     { "getnodeaddresses", 0, "count"},
+    { "getnetmsgstats", 0, "count"},
     { "addpeeraddress", 1, "port"},
     { "addpeeraddress", 2, "tried"},
     { "sendmsgtopeer", 0, "peer_id" },
@@ -313,15 +317,37 @@ static const CRPCConvertParam vRPCConvertParams[] =
     { "listnevmblobdata", 1, "from" },
     { "listnevmblobdata", 2, "options" },
     { "getnevmblobdata", 1, "getdata" },
+    { "getassetoutputs", 0, "asset_guid" },
+    { "syscoincheckmints", 0, "nevm_txhashes" },
+    { "syscoingetspvproofs", 0, "txids" },
+    { "getassetoutputs", 2, "count" },
+    { "getaddresshistory", 1, "options" },
+    { "getaddresshistory", 1, "asset_guid" },
+    { "getaddresshistory", 1, "start_height" },
+    { "getaddresshistory", 1, "end_height" },
+    { "getaddresshistory", 1, "skip" },
+    { "getaddresshistory", 1, "count" },
+    { "getaddressutxos", 1, "options" },
+    { "getaddressutxos", 1, "asset_guid" },
+    { "getaddressutxos", 1, "start_height" },
+    { "getaddressutxos", 1, "end_height" },
+    { "getaddressutxos", 1, "skip" },
+    { "getaddressutxos", 1, "count" },
+    { "getassetsupplyinfo", 0, "asset_guid" },
+    { "getassetsupplyinfo", 1, "height" },
     { "syscoincreaterawnevmblob", 2, "conf_target" },
     { "syscoincreaterawnevmblob", 4, "fee_rate"},
     { "syscoincreatenevmblob", 1, "overwrite_existing" },
     { "syscoincreatenevmblob", 2, "conf_target" },
     { "syscoincreatenevmblob", 4, "fee_rate"},
+    { "syscoincreatenevmblobfile", 1, "overwrite_existing" },
+    { "syscoincreatenevmblobs", 0, "blobs" },
+    { "syscoincreatenevmblobs", 1, "overwrite_existing" },
     { "protx_list_wallet", 0, "detailed" },
     { "protx_list_wallet", 1, "height" },
     { "protx_list", 1, "detailed" },
     { "protx_list", 2, "height" },
+    { "protx_diff", 2, "verbose" },
     { "bls_generate", 0, "legacy" },
     { "bls_fromsecret", 1, "legacy" },
     { "protx_register", 1, "collateralIndex" },
@@ -336,6 +362,10 @@ static const CRPCConvertParam vRPCConvertParams[] =
     { "protx_register_prepare", 9, "legacy" },
     { "protx_update_service", 6, "legacy" },
     { "protx_update_registrar", 5, "legacy" },
+    { "protx_update_service_batch", 0, "targets" },
+    { "protx_update_service_batch", 2, "legacy" },
+    { "protx_update_registrar_batch", 0, "targets" },
+    { "protx_update_registrar_batch", 2, "legacy" },
     { "protx_revoke", 2, "reason" },
     { "protx_revoke", 4, "legacy" },
     { "quorum_list", 0, "count" },
@@ -353,6 +383,7 @@ static const CRPCConvertParam vRPCConvertParams[] =
     { "gobject_submit", 1, "revision" },
     { "gobject_submit", 2, "time" },
     { "gobject_list_prepared", 0, "count" },
+    { "gobject_vote_many_batch", 0, "votes" },
     { "masternode_winners", 0, "count" },
     { "masternode_payments", 1, "count" },
 };
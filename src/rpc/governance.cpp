@@ -12,6 +12,7 @@
 #include <masternode/masternodesync.h>
 #include <rpc/server.h>
 #include <rpc/blockchain.h>
+#include <rpc/jsonstream.h>
 #include <node/context.h>
 #include <timedata.h>
 #include <rpc/server_util.h>
@@ -220,9 +221,10 @@ static RPCHelpMan gobject_submit()
 
 
 UniValue ListObjects(ChainstateManager& chainman, const CDeterministicMNList& tip_mn_list, const std::string& strCachedSignal,
-                            const std::string& strType, int nStartTime)
+                            const std::string& strType, int nStartTime, JSONStreamWriter* stream)
 {
-    UniValue objResult(UniValue::VOBJ);
+    // SYSCOIN objects are streamed when the reply allows it
+    RPCResultWriter objResult{stream, UniValue::VOBJ};
 
     // GET MATCHING GOVERNANCE OBJECTS
     if (g_txindex) {
@@ -272,9 +274,9 @@ UniValue ListObjects(ChainstateManager& chainman, const CDeterministicMNList& ti
         bObj.pushKV("fCachedDelete",  govObj.IsSetCachedDelete());
         bObj.pushKV("fCachedEndorsed",  govObj.IsSetCachedEndorsed());
 
-        objResult.pushKV(govObj.GetHash().ToString(), bObj);
+        objResult.pushKV(govObj.GetHash().ToString(), std::move(bObj));
     }
-    return objResult;
+    return objResult.Finish();
 }
 
 static RPCHelpMan gobject_list()
@@ -307,7 +309,7 @@ static RPCHelpMan gobject_list()
     if (strType != "proposals" && strType != "triggers" && strType != "all")
         return "Invalid type, should be 'proposals', 'triggers' or 'all'";
     
-    return ListObjects(*node.chainman, deterministicMNManager->GetListAtChainTip(), strCachedSignal, strType, 0);
+    return ListObjects(*node.chainman, deterministicMNManager->GetListAtChainTip(), strCachedSignal, strType, 0, request.stream);
 },
     };
 } 
@@ -342,7 +344,7 @@ static RPCHelpMan gobject_diff()
     if (strType != "proposals" && strType != "triggers" && strType != "all")
         return "Invalid type, should be 'proposals', 'triggers' or 'all'";
 
-    return ListObjects(*node.chainman, deterministicMNManager->GetListAtChainTip(), strCachedSignal, strType, governance->GetLastDiffTime());
+    return ListObjects(*node.chainman, deterministicMNManager->GetListAtChainTip(), strCachedSignal, strType, governance->GetLastDiffTime(), request.stream);
 },
     };
 } 
@@ -675,7 +677,7 @@ static RPCHelpMan getgovernanceinfo()
     obj.pushKV("superblockmaturitywindow", Params().GetConsensus().nSuperblockMaturityWindow);
     obj.pushKV("lastsuperblock", nLastSuperblock);
     obj.pushKV("nextsuperblock", nNextSuperblock);
-    obj.pushKV("fundingthreshold", int(deterministicMNManager->GetListAtChainTip().GetValidMNsCount() / 10));
+    obj.pushKV("fundingthreshold", int(deterministicMNManager->GetListAtChainTipPtr()->GetValidMNsCount() / 10));
     obj.pushKV("governancebudget", ValueFromAmount(CSuperblock::GetPaymentsLimit(nLastSBIndex)));
     UniValue oLimits(UniValue::VARR);
     if(!ScanGovLimits(oLimits, nLastSBIndex)) {
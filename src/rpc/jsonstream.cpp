@@ -0,0 +1,112 @@
+// Copyright (c) 2024 The Syscoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <rpc/jsonstream.h>
+
+#include <util/check.h>
+
+JSONStreamWriter::JSONStreamWriter(Sink sink, size_t flush_size)
+    : m_sink{std::move(sink)}, m_flush_size{flush_size}
+{
+}
+
+void JSONStreamWriter::Separator()
+{
+    if (m_awaiting_value) {
+        // the key already placed the separator
+        m_awaiting_value = false;
+        return;
+    }
+    if (m_first.empty()) return;
+    if (!m_first.back()) m_buffer += ',';
+    m_first.back() = false;
+}
+
+void JSONStreamWriter::Completed()
+{
+    ++m_values;
+    if (m_buffer.size() >= m_flush_size) {
+        m_sink(m_buffer);
+        m_buffer.clear();
+        m_flushed = true;
+    }
+}
+
+void JSONStreamWriter::BeginObject()
+{
+    Separator();
+    m_buffer += '{';
+    m_first.push_back(true);
+}
+
+void JSONStreamWriter::EndObject()
+{
+    CHECK_NONFATAL(!m_first.empty() && !m_awaiting_value);
+    m_first.pop_back();
+    m_buffer += '}';
+    Completed();
+}
+
+void JSONStreamWriter::BeginArray()
+{
+    Separator();
+    m_buffer += '[';
+    m_first.push_back(true);
+}
+
+void JSONStreamWriter::EndArray()
+{
+    CHECK_NONFATAL(!m_first.empty() && !m_awaiting_value);
+    m_first.pop_back();
+    m_buffer += ']';
+    Completed();
+}
+
+void JSONStreamWriter::Key(std::string_view key)
+{
+    CHECK_NONFATAL(!m_awaiting_value);
+    Separator();
+    m_buffer += UniValue{std::string{key}}.write();
+    m_buffer += ':';
+    m_awaiting_value = true;
+}
+
+void JSONStreamWriter::Value(const UniValue& value)
+{
+    Separator();
+    m_buffer += value.write();
+    Completed();
+}
+
+void JSONStreamWriter::Fields(const UniValue& obj)
+{
+    const auto& keys = obj.getKeys();
+    const auto& values = obj.getValues();
+    for (size_t i = 0; i < keys.size(); ++i) {
+        Key(keys[i]);
+        Value(values[i]);
+    }
+}
+
+RPCResultWriter::RPCResultWriter(JSONStreamWriter* stream, UniValue::VType type)
+    : m_stream{stream}, m_value{type}
+{
+    if (!m_stream) return;
+    if (type == UniValue::VOBJ) {
+        m_stream->BeginObject();
+    } else {
+        m_stream->BeginArray();
+    }
+}
+
+UniValue RPCResultWriter::Finish()
+{
+    if (!m_stream) return std::move(m_value);
+    if (m_value.isObject()) {
+        m_stream->EndObject();
+    } else {
+        m_stream->EndArray();
+    }
+    return NullUniValue;
+}
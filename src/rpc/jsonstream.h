@@ -0,0 +1,107 @@
+// Copyright (c) 2024 The Syscoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef SYSCOIN_RPC_JSONSTREAM_H
+#define SYSCOIN_RPC_JSONSTREAM_H
+
+#include <span.h>
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <univalue.h>
+
+/** Size of the encoded JSON kept before it is handed to the sink */
+static constexpr size_t DEFAULT_JSON_STREAM_FLUSH_SIZE{1 << 20};
+
+/**
+ * Incremental JSON writer. Values are encoded as they are written and handed to
+ * the sink in chunks of about flush_size bytes, so a large RPC result never has to
+ * exist as one UniValue tree or one string. Nesting is only tracked to place the
+ * separators, callers are trusted to pair Begin and End calls and to write a key
+ * before every value inside an object.
+ */
+class JSONStreamWriter
+{
+public:
+    using Sink = std::function<void(Span<const char>)>;
+
+    explicit JSONStreamWriter(Sink sink, size_t flush_size = DEFAULT_JSON_STREAM_FLUSH_SIZE);
+
+    void BeginObject();
+    void EndObject();
+    void BeginArray();
+    void EndArray();
+    void Key(std::string_view key);
+    void Value(const UniValue& value);
+    /** Write all keys and values of obj into the object being written */
+    void Fields(const UniValue& obj);
+
+    /** Whether a key was written and its value was not */
+    bool AwaitingValue() const { return m_awaiting_value; }
+    /** Number of values completed so far, at any depth */
+    uint64_t ValueCount() const { return m_values; }
+    /** Whether part of the output already went to the sink */
+    bool Flushed() const { return m_flushed; }
+    /** Take the output not yet handed to the sink */
+    std::string TakeBuffer() { return std::exchange(m_buffer, {}); }
+
+private:
+    const Sink m_sink;
+    const size_t m_flush_size;
+    std::string m_buffer;
+    //! per open object or array, whether the next element is its first
+    std::vector<bool> m_first;
+    bool m_awaiting_value{false};
+    bool m_flushed{false};
+    uint64_t m_values{0};
+
+    void Separator();
+    void Completed();
+};
+
+/**
+ * An object or array result of an RPC, written to the stream of the request when
+ * the transport can stream it and built as a UniValue otherwise. Keys are expected
+ * to be unique, as with UniValue::pushKVEnd.
+ */
+class RPCResultWriter
+{
+public:
+    RPCResultWriter(JSONStreamWriter* stream, UniValue::VType type);
+
+    template <typename T>
+    void pushKV(std::string key, T&& value)
+    {
+        if (m_stream) {
+            m_stream->Key(key);
+            m_stream->Value(UniValue(std::forward<T>(value)));
+        } else {
+            m_value.pushKVEnd(std::move(key), UniValue(std::forward<T>(value)));
+        }
+    }
+
+    template <typename T>
+    void push_back(T&& value)
+    {
+        if (m_stream) {
+            m_stream->Value(UniValue(std::forward<T>(value)));
+        } else {
+            m_value.push_back(UniValue(std::forward<T>(value)));
+        }
+    }
+
+    /** Close the result. Returns it when it was built, null when it was streamed. */
+    UniValue Finish();
+
+private:
+    JSONStreamWriter* const m_stream;
+    UniValue m_value;
+};
+
+#endif // SYSCOIN_RPC_JSONSTREAM_H
@@ -6,6 +6,7 @@
 #include <masternode/masternodepayments.h>
 #include <rpc/server.h>
 #include <rpc/blockchain.h>
+#include <rpc/jsonstream.h>
 #include <node/context.h>
 #include <governance/governanceclasses.h>
 #include <node/blockstorage.h>
@@ -14,7 +15,9 @@
 #include <validation.h>
 #include <node/transaction.h>
 #include <rpc/server_util.h>
+#include <llmq/quorums.h>
 #include <llmq/quorums_chainlocks.h>
+#include <llmq/quorums_signing.h>
 #include <index/txindex.h>
 #include <llmq/quorums_utils.h>
 using node::GetTransaction;
@@ -270,6 +273,17 @@ static RPCHelpMan getevodbstats()
                 {RPCResult::Type::NUM, "cache_entries", "Number of list entries currently held in the in-memory write cache."},
                 {RPCResult::Type::NUM, "erase_cache_entries", "Number of list entries currently marked for deletion in the in-memory erase cache."},
                 {RPCResult::Type::STR, "db_path", "Filesystem path to the database directory."},
+                {RPCResult::Type::OBJ, "memory_usage", "Estimated memory used by masternode list and LLMQ caches, in bytes",
+                {
+                    {RPCResult::Type::NUM, "mnlists", "In-memory masternode lists, with nodes and masternodes shared between lists counted once"},
+                    {RPCResult::Type::NUM, "mnlists_count", "Number of in-memory masternode lists"},
+                    {RPCResult::Type::NUM, "snapshot_cache", "Write cache of the list snapshot database"},
+                    {RPCResult::Type::NUM, "diff_cache", "Write cache of the list diff database"},
+                    {RPCResult::Type::NUM, "quorum_vvec_cache", "Write cache of the quorum verification vector database"},
+                    {RPCResult::Type::NUM, "quorum_sk_cache", "Write cache of the quorum secret key share database"},
+                    {RPCResult::Type::NUM, "recovered_sigs_cache", "Lookup caches of the recovered signature database"},
+                    {RPCResult::Type::NUM, "total", "Sum of the above"},
+                }},
             }
         },
         RPCExamples{
@@ -294,6 +308,20 @@ static RPCHelpMan getevodbstats()
     result.pushKV("erase_cache_entries", (uint64_t)stats.eraseCacheEntries);
     result.pushKV("db_path", stats.dbPath);
 
+    const size_t vvecCacheUsage = llmq::quorumManager ? llmq::quorumManager->GetVvecCacheUsage() : 0;
+    const size_t skCacheUsage = llmq::quorumManager ? llmq::quorumManager->GetSkCacheUsage() : 0;
+    const size_t recSigsCacheUsage = llmq::quorumSigningManager ? llmq::quorumSigningManager->GetRecoveredSigsCacheUsage() : 0;
+    UniValue memoryUsage(UniValue::VOBJ);
+    memoryUsage.pushKV("mnlists", (uint64_t)stats.listsCacheUsage);
+    memoryUsage.pushKV("mnlists_count", (uint64_t)stats.listsCacheEntries);
+    memoryUsage.pushKV("snapshot_cache", (uint64_t)stats.snapshotCacheUsage);
+    memoryUsage.pushKV("diff_cache", (uint64_t)stats.diffCacheUsage);
+    memoryUsage.pushKV("quorum_vvec_cache", (uint64_t)vvecCacheUsage);
+    memoryUsage.pushKV("quorum_sk_cache", (uint64_t)skCacheUsage);
+    memoryUsage.pushKV("recovered_sigs_cache", (uint64_t)recSigsCacheUsage);
+    memoryUsage.pushKV("total", (uint64_t)(stats.listsCacheUsage + stats.snapshotCacheUsage + stats.diffCacheUsage + vvecCacheUsage + skCacheUsage + recSigsCacheUsage));
+    result.pushKV("memory_usage", memoryUsage);
+
     return result;
 },
     };
@@ -397,7 +425,7 @@ RPCHelpMan masternode_payments()
     while (vecPayments.size() < (size_t)std::abs(nCount) && pindex != nullptr) {
 
         CBlock block;
-        if (!node.chainman->m_blockman.ReadBlockFromDisk(block, *pindex)) {
+        if (!node.chainman->m_blockman.ReadBlockFromDisk(block, *pindex, /*fFillNEVMData=*/false)) {
             throw JSONRPCError(RPC_INTERNAL_ERROR, "Can't read block from disk");
         }
 
@@ -516,7 +544,8 @@ RPCHelpMan masternodelist()
         throw JSONRPCError(RPC_INVALID_PARAMETER, "Invalid mode");
     }
 
-    UniValue obj(UniValue::VOBJ);
+    // SYSCOIN entries are streamed when the reply allows it
+    RPCResultWriter obj{request.stream, UniValue::VOBJ};
     auto mnList = deterministicMNManager->GetListAtChainTip();
     auto dmnToStatus = [&](auto& dmn) {
         if (mnList.IsMNValid(dmn)) {
@@ -614,7 +643,7 @@ RPCHelpMan masternodelist()
             objMN.pushKV("nevmaddress", dmn.pdmnState->vchNEVMAddress.empty()? "" : "0x" + HexStr(dmn.pdmnState->vchNEVMAddress));
             objMN.pushKV("collateraladdress", collateralAddressStr);
             objMN.pushKV("pubkeyoperator", dmn.pdmnState->pubKeyOperator.ToString());
-            obj.pushKV(strOutpoint, objMN);
+            obj.pushKV(strOutpoint, std::move(objMN));
         } else if (strMode == "lastpaidblock") {
             if (strFilter !="" && strOutpoint.find(strFilter) == std::string::npos) return;
             obj.pushKV(strOutpoint, dmn.pdmnState->nLastPaidHeight);
@@ -645,7 +674,7 @@ RPCHelpMan masternodelist()
         }
     });
 
-    return obj;
+    return obj.Finish();
 },
     };
 } 
@@ -10,10 +10,11 @@
 #include <chainparams.h>
 #include <core_io.h>
 #include <kernel/mempool_entry.h>
+#include <node/context.h>
 #include <node/mempool_persist_args.h>
-#include <policy/rbf.h>
 #include <policy/settings.h>
 #include <primitives/transaction.h>
+#include <rpc/jsonstream.h>
 #include <rpc/server.h>
 #include <rpc/server_util.h>
 #include <rpc/util.h>
@@ -77,7 +78,7 @@ static RPCHelpMan sendrawtransaction()
                 if(nevmData.vchNEVMData && nevmData.vchNEVMData->size() > 0) {
                     auto nOut = GetSyscoinDataOutput(mtx);
                     if (nOut != -1) {
-                        mtx.vout[nOut].vchNEVMData = *nevmData.vchNEVMData;
+                        mtx.vout[nOut].vchNEVMData = nevmData.vchNEVMData;
                     }
                     // we stuffed the data in the data script but it was signed without so clear data so signed tx can succeed
                     std::vector<unsigned char> data;
@@ -296,33 +297,30 @@ static std::vector<RPCResult> MempoolEntryDescription()
     };
 }
 
-static void entryToJSON(const CTxMemPool& pool, UniValue& info, const CTxMemPoolEntry& e) EXCLUSIVE_LOCKS_REQUIRED(pool.cs)
+// SYSCOIN
+static void entryToJSON(UniValue& info, const MempoolEntrySnapshot& e)
 {
-    AssertLockHeld(pool.cs);
-
-    info.pushKV("vsize", (int)e.GetTxSize());
-    info.pushKV("weight", (int)e.GetTxWeight());
-    info.pushKV("time", count_seconds(e.GetTime()));
-    info.pushKV("height", (int)e.GetHeight());
-    info.pushKV("descendantcount", e.GetCountWithDescendants());
-    info.pushKV("descendantsize", e.GetSizeWithDescendants());
-    info.pushKV("ancestorcount", e.GetCountWithAncestors());
-    info.pushKV("ancestorsize", e.GetSizeWithAncestors());
-    info.pushKV("wtxid", pool.vTxHashes[e.vTxHashesIdx].first.ToString());
+    info.pushKV("vsize", (int)e.nVSize);
+    info.pushKV("weight", (int)e.nWeight);
+    info.pushKV("time", count_seconds(e.nTime));
+    info.pushKV("height", (int)e.nHeight);
+    info.pushKV("descendantcount", e.nCountWithDescendants);
+    info.pushKV("descendantsize", e.nSizeWithDescendants);
+    info.pushKV("ancestorcount", e.nCountWithAncestors);
+    info.pushKV("ancestorsize", e.nSizeWithAncestors);
+    info.pushKV("wtxid", e.wtxid.ToString());
 
     UniValue fees(UniValue::VOBJ);
-    fees.pushKV("base", ValueFromAmount(e.GetFee()));
-    fees.pushKV("modified", ValueFromAmount(e.GetModifiedFee()));
-    fees.pushKV("ancestor", ValueFromAmount(e.GetModFeesWithAncestors()));
-    fees.pushKV("descendant", ValueFromAmount(e.GetModFeesWithDescendants()));
+    fees.pushKV("base", ValueFromAmount(e.nFee));
+    fees.pushKV("modified", ValueFromAmount(e.nModifiedFee));
+    fees.pushKV("ancestor", ValueFromAmount(e.nModFeesWithAncestors));
+    fees.pushKV("descendant", ValueFromAmount(e.nModFeesWithDescendants));
     info.pushKV("fees", fees);
 
-    const CTransaction& tx = e.GetTx();
     std::set<std::string> setDepends;
-    for (const CTxIn& txin : tx.vin)
+    for (const uint256& parent : e.vDepends)
     {
-        if (pool.exists(GenTxid::Txid(txin.prevout.hash)))
-            setDepends.insert(txin.prevout.hash.ToString());
+        setDepends.insert(parent.ToString());
     }
 
     UniValue depends(UniValue::VARR);
@@ -334,56 +332,63 @@ static void entryToJSON(const CTxMemPool& pool, UniValue& info, const CTxMemPool
     info.pushKV("depends", depends);
 
     UniValue spent(UniValue::VARR);
-    const CTxMemPool::txiter& it = pool.mapTx.find(tx.GetHash());
-    const CTxMemPoolEntry::Children& children = it->GetMemPoolChildrenConst();
-    for (const CTxMemPoolEntry& child : children) {
-        spent.push_back(child.GetTx().GetHash().ToString());
+    for (const uint256& child : e.vSpentBy) {
+        spent.push_back(child.ToString());
     }
 
     info.pushKV("spentby", spent);
 
     // Add opt-in RBF status
-    bool rbfStatus = false;
-    RBFTransactionState rbfState = IsRBFOptIn(tx, pool);
-    if (rbfState == RBFTransactionState::UNKNOWN) {
-        throw JSONRPCError(RPC_MISC_ERROR, "Transaction is not in mempool");
-    } else if (rbfState == RBFTransactionState::REPLACEABLE_BIP125) {
-        rbfStatus = true;
-    }
+    info.pushKV("bip125-replaceable", e.fBIP125Replaceable);
+    info.pushKV("unbroadcast", e.fUnbroadcast);
+}
 
-    info.pushKV("bip125-replaceable", rbfStatus);
-    info.pushKV("unbroadcast", pool.IsUnbroadcastTx(tx.GetHash()));
+// SYSCOIN
+/** In mempool ancestors or descendants of entry, found by following the parent or child links of the snapshot */
+static std::vector<const MempoolEntrySnapshot*> SnapshotRelatives(const MempoolSnapshot& snapshot, const MempoolEntrySnapshot& entry, bool fAncestors)
+{
+    std::vector<const MempoolEntrySnapshot*> vRelatives;
+    std::set<uint256> setSeen;
+    std::vector<const MempoolEntrySnapshot*> vStack{&entry};
+    while (!vStack.empty()) {
+        const MempoolEntrySnapshot* e = vStack.back();
+        vStack.pop_back();
+        for (const uint256& txid : fAncestors ? e->vDepends : e->vSpentBy) {
+            if (!setSeen.insert(txid).second) continue;
+            if (const MempoolEntrySnapshot* relative = snapshot.Find(txid)) {
+                vRelatives.emplace_back(relative);
+                vStack.emplace_back(relative);
+            }
+        }
+    }
+    return vRelatives;
 }
 
-UniValue MempoolToJSON(const CTxMemPool& pool, bool verbose, bool include_mempool_sequence)
+UniValue MempoolToJSON(const CTxMemPool& pool, bool verbose, bool include_mempool_sequence, JSONStreamWriter* stream)
 {
     if (verbose) {
         if (include_mempool_sequence) {
             throw JSONRPCError(RPC_INVALID_PARAMETER, "Verbose results cannot contain mempool sequence values.");
         }
-        LOCK(pool.cs);
-        UniValue o(UniValue::VOBJ);
-        for (const CTxMemPoolEntry& e : pool.mapTx) {
-            const uint256& hash = e.GetTx().GetHash();
+        // SYSCOIN
+        const auto snapshot{pool.GetSnapshot()};
+        // Mempool has unique entries, the writer pushes with UniValue::pushKVEnd
+        // which is O(1) or streams each entry as it is converted.
+        RPCResultWriter o{stream, UniValue::VOBJ};
+        for (const MempoolEntrySnapshot& e : snapshot->vEntries) {
+            const uint256& hash = e.tx->GetHash();
             UniValue info(UniValue::VOBJ);
-            entryToJSON(pool, info, e);
-            // Mempool has unique entries so there is no advantage in using
-            // UniValue::pushKV, which checks if the key already exists in O(N).
-            // UniValue::pushKVEnd is used instead which currently is O(1).
-            o.pushKVEnd(hash.ToString(), info);
+            entryToJSON(info, e);
+            o.pushKV(hash.ToString(), std::move(info));
         }
-        return o;
+        return o.Finish();
     } else {
-        uint64_t mempool_sequence;
-        std::vector<uint256> vtxid;
-        {
-            LOCK(pool.cs);
-            pool.queryHashes(vtxid);
-            mempool_sequence = pool.GetSequence();
-        }
+        // SYSCOIN
+        const auto snapshot{pool.GetSnapshot()};
+        const uint64_t mempool_sequence{snapshot->nSequence};
         UniValue a(UniValue::VARR);
-        for (const uint256& hash : vtxid)
-            a.push_back(hash.ToString());
+        for (const MempoolEntrySnapshot& e : snapshot->vEntries)
+            a.push_back(e.tx->GetHash().ToString());
 
         if (!include_mempool_sequence) {
             return a;
@@ -441,7 +446,7 @@ static RPCHelpMan getrawmempool()
         include_mempool_sequence = request.params[1].get_bool();
     }
 
-    return MempoolToJSON(EnsureAnyMemPool(request.context), fVerbose, include_mempool_sequence);
+    return MempoolToJSON(EnsureAnyMemPool(request.context), fVerbose, include_mempool_sequence, request.stream);
 },
     };
 }
@@ -477,29 +482,28 @@ static RPCHelpMan getmempoolancestors()
     uint256 hash = ParseHashV(request.params[0], "parameter 1");
 
     const CTxMemPool& mempool = EnsureAnyMemPool(request.context);
-    LOCK(mempool.cs);
+    // SYSCOIN
+    const auto snapshot{mempool.GetSnapshot()};
 
-    CTxMemPool::txiter it = mempool.mapTx.find(hash);
-    if (it == mempool.mapTx.end()) {
+    const MempoolEntrySnapshot* entry = snapshot->Find(hash);
+    if (!entry) {
         throw JSONRPCError(RPC_INVALID_ADDRESS_OR_KEY, "Transaction not in mempool");
     }
 
-    auto ancestors{mempool.AssumeCalculateMemPoolAncestors(__func__, *it, CTxMemPool::Limits::NoLimits(), /*fSearchForParents=*/false)};
+    const auto ancestors{SnapshotRelatives(*snapshot, *entry, /*fAncestors=*/true)};
 
     if (!fVerbose) {
         UniValue o(UniValue::VARR);
-        for (CTxMemPool::txiter ancestorIt : ancestors) {
-            o.push_back(ancestorIt->GetTx().GetHash().ToString());
+        for (const MempoolEntrySnapshot* e : ancestors) {
+            o.push_back(e->tx->GetHash().ToString());
         }
         return o;
     } else {
         UniValue o(UniValue::VOBJ);
-        for (CTxMemPool::txiter ancestorIt : ancestors) {
-            const CTxMemPoolEntry &e = *ancestorIt;
-            const uint256& _hash = e.GetTx().GetHash();
+        for (const MempoolEntrySnapshot* e : ancestors) {
             UniValue info(UniValue::VOBJ);
-            entryToJSON(mempool, info, e);
-            o.pushKV(_hash.ToString(), info);
+            entryToJSON(info, *e);
+            o.pushKV(e->tx->GetHash().ToString(), info);
         }
         return o;
     }
@@ -538,33 +542,29 @@ static RPCHelpMan getmempooldescendants()
     uint256 hash = ParseHashV(request.params[0], "parameter 1");
 
     const CTxMemPool& mempool = EnsureAnyMemPool(request.context);
-    LOCK(mempool.cs);
+    // SYSCOIN
+    const auto snapshot{mempool.GetSnapshot()};
 
-    CTxMemPool::txiter it = mempool.mapTx.find(hash);
-    if (it == mempool.mapTx.end()) {
+    const MempoolEntrySnapshot* entry = snapshot->Find(hash);
+    if (!entry) {
         throw JSONRPCError(RPC_INVALID_ADDRESS_OR_KEY, "Transaction not in mempool");
     }
 
-    CTxMemPool::setEntries setDescendants;
-    mempool.CalculateDescendants(it, setDescendants);
-    // CTxMemPool::CalculateDescendants will include the given tx
-    setDescendants.erase(it);
+    const auto descendants{SnapshotRelatives(*snapshot, *entry, /*fAncestors=*/false)};
 
     if (!fVerbose) {
         UniValue o(UniValue::VARR);
-        for (CTxMemPool::txiter descendantIt : setDescendants) {
-            o.push_back(descendantIt->GetTx().GetHash().ToString());
+        for (const MempoolEntrySnapshot* e : descendants) {
+            o.push_back(e->tx->GetHash().ToString());
         }
 
         return o;
     } else {
         UniValue o(UniValue::VOBJ);
-        for (CTxMemPool::txiter descendantIt : setDescendants) {
-            const CTxMemPoolEntry &e = *descendantIt;
-            const uint256& _hash = e.GetTx().GetHash();
+        for (const MempoolEntrySnapshot* e : descendants) {
             UniValue info(UniValue::VOBJ);
-            entryToJSON(mempool, info, e);
-            o.pushKV(_hash.ToString(), info);
+            entryToJSON(info, *e);
+            o.pushKV(e->tx->GetHash().ToString(), info);
         }
         return o;
     }
@@ -590,16 +590,16 @@ static RPCHelpMan getmempoolentry()
     uint256 hash = ParseHashV(request.params[0], "parameter 1");
 
     const CTxMemPool& mempool = EnsureAnyMemPool(request.context);
-    LOCK(mempool.cs);
+    // SYSCOIN
+    const auto snapshot{mempool.GetSnapshot()};
 
-    CTxMemPool::txiter it = mempool.mapTx.find(hash);
-    if (it == mempool.mapTx.end()) {
+    const MempoolEntrySnapshot* entry = snapshot->Find(hash);
+    if (!entry) {
         throw JSONRPCError(RPC_INVALID_ADDRESS_OR_KEY, "Transaction not in mempool");
     }
 
-    const CTxMemPoolEntry &e = *it;
     UniValue info(UniValue::VOBJ);
-    entryToJSON(mempool, info, e);
+    entryToJSON(info, *entry);
     return info;
 },
     };
@@ -703,6 +703,9 @@ UniValue MempoolInfoToJSON(const CTxMemPool& pool)
     ret.pushKV("incrementalrelayfee", ValueFromAmount(pool.m_incremental_relay_feerate.GetFeePerK()));
     ret.pushKV("unbroadcastcount", uint64_t{pool.GetUnbroadcastTxs().size()});
     ret.pushKV("fullrbf", pool.m_full_rbf);
+    // SYSCOIN
+    ret.pushKV("podabytes", pool.GetTotalPoDABlobSize());
+    ret.pushKV("maxpodamempool", pool.m_max_poda_size_bytes);
     return ret;
 }
 
@@ -725,6 +728,8 @@ static RPCHelpMan getmempoolinfo()
                 {RPCResult::Type::NUM, "incrementalrelayfee", "minimum fee rate increment for mempool limiting or replacement in " + CURRENCY_UNIT + "/kvB"},
                 {RPCResult::Type::NUM, "unbroadcastcount", "Current number of transactions that haven't passed initial broadcast yet"},
                 {RPCResult::Type::BOOL, "fullrbf", "True if the mempool accepts RBF without replaceability signaling inspection"},
+                {RPCResult::Type::NUM, "podabytes", "Sum of the PoDA blob bytes carried by mempool transactions"},
+                {RPCResult::Type::NUM, "maxpodamempool", "Maximum PoDA blob bytes for the mempool"},
             }},
         RPCExamples{
             HelpExampleCli("getmempoolinfo", "")
@@ -737,6 +742,49 @@ static RPCHelpMan getmempoolinfo()
     };
 }
 
+// SYSCOIN
+static RPCHelpMan getmempoolfeehistogram()
+{
+    return RPCHelpMan{"getmempoolfeehistogram",
+        "Returns the mempool transactions bucketed by base feerate.\n"
+        "Both sides of a ZDAG double spend are counted, their size is also reported in zdag_vsize.",
+        {},
+        RPCResult{
+            RPCResult::Type::ARR, "", "",
+            {
+                {RPCResult::Type::OBJ, "", "",
+                {
+                    {RPCResult::Type::NUM, "feerate", "Lower bound of the bucket in " + CURRENCY_ATOM + "/vB, the last bucket is open ended"},
+                    {RPCResult::Type::NUM, "count", "Number of transactions in the bucket"},
+                    {RPCResult::Type::NUM, "vsize", "Sum of the virtual sizes of the transactions in the bucket"},
+                    {RPCResult::Type::STR_AMOUNT, "fees", "Sum of the base fees of the transactions in the bucket in " + CURRENCY_UNIT},
+                    {RPCResult::Type::NUM, "zdag_vsize", "Part of vsize spent by ZDAG transactions"},
+                }},
+            }},
+        RPCExamples{
+            HelpExampleCli("getmempoolfeehistogram", "")
+            + HelpExampleRpc("getmempoolfeehistogram", "")
+        },
+        [&](const RPCHelpMan& self, const node::JSONRPCRequest& request) -> UniValue
+{
+    const CTxMemPool& mempool = EnsureAnyMemPool(request.context);
+    UniValue ret(UniValue::VARR);
+    LOCK(mempool.cs);
+    const MempoolFeeHistogram& histogram = mempool.GetFeeHistogram();
+    for (size_t i = 0; i < histogram.size(); i++) {
+        UniValue bucket(UniValue::VOBJ);
+        bucket.pushKV("feerate", MEMPOOL_HISTOGRAM_FEERATES[i]);
+        bucket.pushKV("count", histogram[i].nCount);
+        bucket.pushKV("vsize", histogram[i].nVSize);
+        bucket.pushKV("fees", ValueFromAmount(histogram[i].nFees));
+        bucket.pushKV("zdag_vsize", histogram[i].nZDAGVSize);
+        ret.push_back(bucket);
+    }
+    return ret;
+},
+    };
+}
+
 static RPCHelpMan importmempool()
 {
     return RPCHelpMan{
@@ -822,8 +870,11 @@ static RPCHelpMan savemempool()
     }
 
     const fs::path& dump_path = MempoolPath(args);
+    // SYSCOIN a dump of the node's own mempool also starts its journal over
+    const NodeContext& node{EnsureAnyNodeContext(request.context)};
+    const bool dumped{node.mempool_journal ? node.mempool_journal->Compact() : DumpMempool(mempool, dump_path)};
 
-    if (!DumpMempool(mempool, dump_path)) {
+    if (!dumped) {
         throw JSONRPCError(RPC_MISC_ERROR, "Unable to dump mempool to disk");
     }
 
@@ -999,6 +1050,7 @@ void RegisterMempoolRPCCommands(CRPCTable& t)
         {"blockchain", &getmempoolentry},
         {"blockchain", &gettxspendingprevout},
         {"blockchain", &getmempoolinfo},
+        {"blockchain", &getmempoolfeehistogram},
         {"blockchain", &getrawmempool},
         {"blockchain", &importmempool},
         {"blockchain", &savemempool},
@@ -6,12 +6,13 @@
 #define SYSCOIN_RPC_MEMPOOL_H
 
 class CTxMemPool;
+class JSONStreamWriter;
 class UniValue;
 
 /** Mempool information to JSON */
 UniValue MempoolInfoToJSON(const CTxMemPool& pool);
 
-/** Mempool to JSON */
-UniValue MempoolToJSON(const CTxMemPool& pool, bool verbose = false, bool include_mempool_sequence = false);
+/** Mempool to JSON, SYSCOIN with a stream the verbose result is written to it and null is returned */
+UniValue MempoolToJSON(const CTxMemPool& pool, bool verbose = false, bool include_mempool_sequence = false, JSONStreamWriter* stream = nullptr);
 
 #endif // SYSCOIN_RPC_MEMPOOL_H
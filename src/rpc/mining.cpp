@@ -431,6 +431,22 @@ static RPCHelpMan getmininginfo()
                         {RPCResult::Type::NUM, "pooledtx", "The size of the mempool"},
                         {RPCResult::Type::STR, "chain", "current network name (main, test, regtest)"},
                         {RPCResult::Type::STR, "warnings", "any network and blockchain warnings"},
+                        // SYSCOIN
+                        {RPCResult::Type::OBJ, "templatetimings", /*optional=*/true, "Milliseconds the phases of the last assembled block took (only present if a block was ever assembled)",
+                        {
+                            {RPCResult::Type::NUM, "packages", "transaction selection"},
+                            {RPCResult::Type::NUM, "commitments", "finding the quorum commitment"},
+                            {RPCResult::Type::NUM, "payments", "masternode and superblock payments"},
+                            {RPCResult::Type::NUM, "nevm", "fetching the NEVM block"},
+                            {RPCResult::Type::NUM, "validity", "TestBlockValidity"},
+                            {RPCResult::Type::NUM, "total", "the whole template"},
+                        }},
+                        {RPCResult::Type::OBJ, "auxblocktimings", /*optional=*/true, "Milliseconds the phases of the last createauxblock took (only present if it was ever called)",
+                        {
+                            {RPCResult::Type::NUM, "base", "building the base template, 0 if the current one was used"},
+                            {RPCResult::Type::NUM, "coinbase", "making the block for the coinbase script, 0 if it was cached"},
+                            {RPCResult::Type::NUM, "total", "the whole call"},
+                        }},
                     }},
                 RPCExamples{
                     HelpExampleCli("getmininginfo", "")
@@ -453,6 +469,24 @@ static RPCHelpMan getmininginfo()
     obj.pushKV("pooledtx",         (uint64_t)mempool.size());
     obj.pushKV("chain", chainman.GetParams().GetChainTypeString());
     obj.pushKV("warnings",         GetWarnings(false).original);
+    // SYSCOIN
+    if (const auto timings{BlockAssembler::GetLastBlockTimings()}) {
+        UniValue template_timings(UniValue::VOBJ);
+        template_timings.pushKV("packages", Ticks<MillisecondsDouble>(timings->packages));
+        template_timings.pushKV("commitments", Ticks<MillisecondsDouble>(timings->commitments));
+        template_timings.pushKV("payments", Ticks<MillisecondsDouble>(timings->payments));
+        template_timings.pushKV("nevm", Ticks<MillisecondsDouble>(timings->nevm));
+        template_timings.pushKV("validity", Ticks<MillisecondsDouble>(timings->validity));
+        template_timings.pushKV("total", Ticks<MillisecondsDouble>(timings->total));
+        obj.pushKV("templatetimings", template_timings);
+    }
+    if (const auto timings{AuxpowMiner::get().getLastTimings()}) {
+        UniValue aux_timings(UniValue::VOBJ);
+        aux_timings.pushKV("base", Ticks<MillisecondsDouble>(timings->base));
+        aux_timings.pushKV("coinbase", Ticks<MillisecondsDouble>(timings->coinbase));
+        aux_timings.pushKV("total", Ticks<MillisecondsDouble>(timings->total));
+        obj.pushKV("auxblocktimings", aux_timings);
+    }
     return obj;
 },
     };
@@ -646,6 +680,7 @@ static RPCHelpMan getblocktemplate()
                 {RPCResult::Type::STR_HEX, "signet_challenge", /*optional=*/true, "Only on signet"},
                 {RPCResult::Type::STR_HEX, "default_witness_commitment", /*optional=*/true, "a valid witness commitment for the unmodified block template"},
                 // SYSCOIN
+                {RPCResult::Type::STR, "templatecheck", /*optional=*/true, "Only with -blocktemplatefastcheck when the template is checked in the background: \"pending\", \"valid\", \"invalid\" or \"unknown\". Work on an invalid template should be dropped"},
                 {RPCResult::Type::NUM, "version_coinbase", "The coinbase tx version"},
                 {RPCResult::Type::ARR, "masternode", "",
                 {
@@ -832,8 +867,10 @@ static RPCHelpMan getblocktemplate()
     static CBlockIndex* pindexPrev;
     static int64_t time_start;
     static std::unique_ptr<CBlockTemplate> pblocktemplate;
+    // SYSCOIN never hand out a template again once its background check failed
     if (pindexPrev != active_chain.Tip() ||
-        (mempool.GetTransactionsUpdated() != nTransactionsUpdatedLast && GetTime() - time_start > 5))
+        (mempool.GetTransactionsUpdated() != nTransactionsUpdatedLast && GetTime() - time_start > 5) ||
+        (pblocktemplate && node::DeferredCheckFailed(*pblocktemplate)))
     {
         // Clear pindexPrev so future calls make a new block, despite any failures from here on
         pindexPrev = nullptr;
@@ -845,7 +882,10 @@ static RPCHelpMan getblocktemplate()
 
         // Create new block
         CScript scriptDummy = CScript() << OP_TRUE;
-        pblocktemplate = BlockAssembler{active_chainstate, &mempool}.CreateNewBlock(scriptDummy);
+        // SYSCOIN take the template kept up to date in the background when there is one
+        pblocktemplate = node::g_block_template_cache ? node::g_block_template_cache->GetBlockTemplate(pindexPrevNew->GetBlockHash(), nTransactionsUpdatedLast, scriptDummy) : nullptr;
+        if (!pblocktemplate)
+            pblocktemplate = BlockAssembler{active_chainstate, &mempool}.CreateNewBlock(scriptDummy);
         if (!pblocktemplate)
             throw JSONRPCError(RPC_OUT_OF_MEMORY, "Out of memory");
 
@@ -997,6 +1037,15 @@ static RPCHelpMan getblocktemplate()
     if (consensusParams.signet_blocks) {
         result.pushKV("signet_challenge", HexStr(consensusParams.signet_challenge));
     }
+    // SYSCOIN
+    if (pblocktemplate->nDeferredCheck != 0 && node::g_block_template_validator) {
+        switch (node::g_block_template_validator->GetResult(pblocktemplate->nDeferredCheck)) {
+        case node::BlockTemplateValidator::Result::PENDING: result.pushKV("templatecheck", "pending"); break;
+        case node::BlockTemplateValidator::Result::VALID: result.pushKV("templatecheck", "valid"); break;
+        case node::BlockTemplateValidator::Result::INVALID: result.pushKV("templatecheck", "invalid"); break;
+        case node::BlockTemplateValidator::Result::UNKNOWN: result.pushKV("templatecheck", "unknown"); break;
+        } // no default case, so the compiler can warn about missing cases
+    }
 
     if (!pblocktemplate->vchCoinbaseCommitment.empty()) {
         result.pushKV("default_witness_commitment", HexStr(pblocktemplate->vchCoinbaseCommitment));
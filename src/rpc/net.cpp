@@ -176,6 +176,16 @@ static RPCHelpMan getpeerinfo()
                                                       "Only known message types can appear as keys in the object and all bytes received\n"
                                                       "of unknown message types are listed under '"+NET_MESSAGE_TYPE_OTHER+"'."}
                     }},
+                    {RPCResult::Type::NUM, "processtime", "The total time in microseconds spent processing messages from this peer"},
+                    {RPCResult::Type::OBJ_DYN, "processed_per_msg", "",
+                    {
+                        {RPCResult::Type::OBJ, "msg", "The messages processed and the time spent on them aggregated by message type\n"
+                                                      "Message types never processed are not listed, unknown ones are listed under '"+NET_MESSAGE_TYPE_OTHER+"'.",
+                        {
+                            {RPCResult::Type::NUM, "count", "The number of messages processed"},
+                            {RPCResult::Type::NUM, "time", "The time in microseconds spent processing them"},
+                        }},
+                    }},
                     {RPCResult::Type::STR, "connection_type", "Type of connection: \n" + Join(CONNECTION_TYPE_DOC, ",\n") + ".\n"
                                                               "Please note this output is unlikely to be stable in upcoming releases as we iterate to\n"
                                                               "best capture connection behaviors."},
@@ -293,6 +303,17 @@ static RPCHelpMan getpeerinfo()
                 recvPerMsgType.pushKV(i.first, i.second);
         }
         obj.pushKV("bytesrecv_per_msg", recvPerMsgType);
+        // SYSCOIN
+        obj.pushKV("processtime", count_microseconds(stats.m_process_time));
+        UniValue processedPerMsgType(UniValue::VOBJ);
+        for (const auto& [msg_type, cost] : stats.mapProcessCostPerMsgType) {
+            if (cost.count == 0 && cost.time == 0us) continue;
+            UniValue entry(UniValue::VOBJ);
+            entry.pushKV("count", cost.count);
+            entry.pushKV("time", count_microseconds(cost.time));
+            processedPerMsgType.pushKV(msg_type, entry);
+        }
+        obj.pushKV("processed_per_msg", processedPerMsgType);
         obj.pushKV("connection_type", ConnectionTypeAsString(stats.m_conn_type));
         obj.pushKV("transport_protocol_type", TransportTypeAsString(stats.m_transport_type));
         obj.pushKV("session_id", stats.m_session_id);
@@ -562,6 +583,14 @@ static RPCHelpMan getnettotals()
                            {RPCResult::Type::BOOL, "serve_historical_blocks", "True if serving historical blocks"},
                            {RPCResult::Type::NUM, "bytes_left_in_cycle", "Bytes left in current time cycle"},
                            {RPCResult::Type::NUM, "time_left_in_cycle", "Seconds left in current time cycle"},
+                           {RPCResult::Type::NUM, "blob_target", "PoDA blob target in bytes (-maxuploadtargetblobs)"},
+                           {RPCResult::Type::BOOL, "serve_optional_blobs", "True if serving the PoDA blobs peers can do without"},
+                           {RPCResult::Type::NUM, "blob_bytes_left_in_cycle", "PoDA blob bytes left in current time cycle"},
+                        }},
+                       {RPCResult::Type::OBJ, "payloadbytessent", "Bytes sent by payload type, part of totalbytessent",
+                       {
+                           {RPCResult::Type::NUM, "nevm_block", "NEVM block data of blocks"},
+                           {RPCResult::Type::NUM, "poda_blob", "PoDA blobs of blocks, transactions and blob chunks"},
                         }},
                     }
                 },
@@ -586,12 +615,116 @@ static RPCHelpMan getnettotals()
     outboundLimit.pushKV("serve_historical_blocks", !connman.OutboundTargetReached(true));
     outboundLimit.pushKV("bytes_left_in_cycle", connman.GetOutboundTargetBytesLeft());
     outboundLimit.pushKV("time_left_in_cycle", count_seconds(connman.GetMaxOutboundTimeLeftInCycle()));
+    // SYSCOIN
+    outboundLimit.pushKV("blob_target", connman.GetMaxOutboundBlobTarget());
+    outboundLimit.pushKV("serve_optional_blobs", !connman.OutboundBlobTargetReached());
+    outboundLimit.pushKV("blob_bytes_left_in_cycle", connman.GetOutboundBlobTargetBytesLeft());
     obj.pushKV("uploadtarget", outboundLimit);
+    UniValue payloadBytesSent(UniValue::VOBJ);
+    payloadBytesSent.pushKV("nevm_block", connman.GetTotalNEVMBlockBytesSent());
+    payloadBytesSent.pushKV("poda_blob", connman.GetTotalBlobBytesSent());
+    obj.pushKV("payloadbytessent", payloadBytesSent);
     return obj;
 },
     };
 }
 
+// SYSCOIN
+static RPCHelpMan getnetmsgstats()
+{
+    return RPCHelpMan{"getnetmsgstats",
+        "Returns the time the message handler spent on each message type, summed over the connected peers,\n"
+        "and the peers that cost the most processing time.",
+        {
+            {"count", RPCArg::Type::NUM, RPCArg::Default{10}, "The number of peers to list, 0 to list all of them"},
+        },
+        RPCResult{
+            RPCResult::Type::OBJ, "", "",
+            {
+                {RPCResult::Type::OBJ_DYN, "msgtypes", "The processed message types",
+                {
+                    {RPCResult::Type::OBJ, "msg", "",
+                    {
+                        {RPCResult::Type::NUM, "count", "The number of messages processed"},
+                        {RPCResult::Type::NUM, "time", "The time in microseconds spent processing them"},
+                    }},
+                }},
+                {RPCResult::Type::ARR, "peers", "The peers that took the most processing time, most expensive first",
+                {
+                    {RPCResult::Type::OBJ, "", "",
+                    {
+                        {RPCResult::Type::NUM, "id", "Peer index"},
+                        {RPCResult::Type::STR, "addr", "(host:port) The IP address and port of the peer"},
+                        {RPCResult::Type::NUM, "count", "The number of messages processed from the peer"},
+                        {RPCResult::Type::NUM, "time", "The time in microseconds spent processing them"},
+                        {RPCResult::Type::STR, "top_msgtype", "The message type that took the most time"},
+                    }},
+                }},
+            }
+        },
+        RPCExamples{
+            HelpExampleCli("getnetmsgstats", "")
+            + HelpExampleCli("getnetmsgstats", "0")
+            + HelpExampleRpc("getnetmsgstats", "5")
+        },
+        [&](const RPCHelpMan& self, const node::JSONRPCRequest& request) -> UniValue
+{
+    node::NodeContext& node = EnsureAnyNodeContext(request.context);
+    const CConnman& connman = EnsureConnman(node);
+    const int count{request.params[0].isNull() ? 10 : request.params[0].getInt<int>()};
+    if (count < 0) {
+        throw JSONRPCError(RPC_INVALID_PARAMETER, "Count must be non-negative");
+    }
+
+    std::vector<CNodeStats> vstats;
+    connman.GetNodeStats(vstats);
+    std::sort(vstats.begin(), vstats.end(), [](const CNodeStats& a, const CNodeStats& b) {
+        return a.m_process_time > b.m_process_time;
+    });
+
+    mapMsgTypeCost totals;
+    UniValue peers(UniValue::VARR);
+    for (const CNodeStats& stats : vstats) {
+        uint64_t nCount{0};
+        const std::string* top_msg_type{nullptr};
+        std::chrono::microseconds top_time{0};
+        for (const auto& [msg_type, cost] : stats.mapProcessCostPerMsgType) {
+            if (cost.count == 0 && cost.time == 0us) continue;
+            MsgTypeCost& total = totals[msg_type];
+            total.count += cost.count;
+            total.time += cost.time;
+            nCount += cost.count;
+            if (!top_msg_type || cost.time > top_time) {
+                top_msg_type = &msg_type;
+                top_time = cost.time;
+            }
+        }
+        if (count != 0 && peers.size() >= size_t(count)) continue;
+        UniValue obj(UniValue::VOBJ);
+        obj.pushKV("id", stats.nodeid);
+        obj.pushKV("addr", stats.m_addr_name);
+        obj.pushKV("count", nCount);
+        obj.pushKV("time", count_microseconds(stats.m_process_time));
+        obj.pushKV("top_msgtype", top_msg_type ? *top_msg_type : "");
+        peers.push_back(obj);
+    }
+
+    UniValue msgtypes(UniValue::VOBJ);
+    for (const auto& [msg_type, cost] : totals) {
+        UniValue entry(UniValue::VOBJ);
+        entry.pushKV("count", cost.count);
+        entry.pushKV("time", count_microseconds(cost.time));
+        msgtypes.pushKV(msg_type, entry);
+    }
+
+    UniValue ret(UniValue::VOBJ);
+    ret.pushKV("msgtypes", msgtypes);
+    ret.pushKV("peers", peers);
+    return ret;
+},
+    };
+}
+
 static UniValue GetNetworksInfo()
 {
     UniValue networks(UniValue::VARR);
@@ -1167,6 +1300,7 @@ void RegisterNetRPCCommands(CRPCTable& t)
         {"network", &disconnectnode},
         {"network", &getaddednodeinfo},
         {"network", &getnettotals},
+        {"network", &getnetmsgstats},
         {"network", &getnetworkinfo},
         {"network", &setban},
         {"network", &listbanned},
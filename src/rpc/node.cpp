@@ -5,7 +5,10 @@
 
 #include <chainparams.h>
 #include <httpserver.h>
+#include <index/addressindex.h>
+#include <index/assetindex.h>
 #include <index/blockfilterindex.h>
+#include <index/blockstatsindex.h>
 #include <index/coinstatsindex.h>
 #include <index/txindex.h>
 #include <interfaces/chain.h>
@@ -15,6 +18,7 @@
 #include <kernel/cs_main.h>
 #include <logging.h>
 #include <node/context.h>
+#include <node/memoryprofile.h>
 #include <rpc/server.h>
 #include <rpc/server_util.h>
 #include <rpc/util.h>
@@ -22,6 +26,7 @@
 #include <univalue.h>
 #include <util/any.h>
 #include <util/check.h>
+#include <util/executor.h>
 
 #include <stdint.h>
 #ifdef HAVE_MALLOC_INFO
@@ -32,6 +37,7 @@
 #include <masternode/masternodesync.h>
 #include <spork.h>
 #include <bls/bls.h>
+#include <llmq/quorums_chainlocks.h>
 #include <llmq/quorums_utils.h>
 #include <validation.h>
 using node::NodeContext;
@@ -259,6 +265,8 @@ static RPCHelpMan mockscheduler()
 
     const NodeContext& node_context{EnsureAnyNodeContext(request.context)};
     CHECK_NONFATAL(node_context.scheduler)->MockForward(std::chrono::seconds{delta_seconds});
+    // SYSCOIN
+    if (node_context.maintenance_scheduler) node_context.maintenance_scheduler->MockForward(std::chrono::seconds{delta_seconds});
     SyncWithValidationInterfaceQueue();
 
     return UniValue::VNULL;
@@ -308,7 +316,9 @@ static RPCHelpMan getmemoryinfo()
                 {
                     {"mode", RPCArg::Type::STR, RPCArg::Default{"stats"}, "determines what kind of information is returned.\n"
             "  - \"stats\" returns general statistics about memory usage in the daemon.\n"
-            "  - \"mallocinfo\" returns an XML string describing low-level heap state (only available if compiled with glibc)."},
+            "  - \"mallocinfo\" returns an XML string describing low-level heap state (only available if compiled with glibc).\n"
+            "  - \"subsystems\" returns the estimated heap memory of the major subsystems and the highest seen since startup.\n"
+            "    Peaks are only seen by measurements, which are taken by this call and every " + ToString(count_seconds(MEMORY_PROFILE_INTERVAL)) + " seconds with -memoryprofile."},
                 },
                 {
                     RPCResult{"mode \"stats\"",
@@ -328,6 +338,17 @@ static RPCHelpMan getmemoryinfo()
                     RPCResult{"mode \"mallocinfo\"",
                         RPCResult::Type::STR, "", "\"<malloc version=\"1\">...\""
                     },
+                    RPCResult{"mode \"subsystems\"",
+                        RPCResult::Type::OBJ_DYN, "", "Subsystems that are running, keyed by name (coinsviewcache, mempool, deterministicmns, governance, sigshares, nevmdata)",
+                        {
+                            {RPCResult::Type::OBJ, "name", "",
+                            {
+                                {RPCResult::Type::NUM, "usage", "Estimated heap memory in use, in bytes"},
+                                {RPCResult::Type::NUM, "peak", "Highest usage measured since startup, in bytes"},
+                                {RPCResult::Type::NUM, "limit", /*optional=*/true, "The configured bound of the usage (-dbcache share, -maxmempool), in bytes"},
+                            }},
+                        }
+                    },
                 },
                 RPCExamples{
                     HelpExampleCli("getmemoryinfo", "")
@@ -340,6 +361,16 @@ static RPCHelpMan getmemoryinfo()
         UniValue obj(UniValue::VOBJ);
         obj.pushKV("locked", RPCLockedMemoryInfo());
         return obj;
+    } else if (mode == "subsystems") {
+        UniValue obj(UniValue::VOBJ);
+        for (const node::SubsystemMemory& subsystem : node::SampleSubsystemMemory(EnsureAnyNodeContext(request.context))) {
+            UniValue entry(UniValue::VOBJ);
+            entry.pushKV("usage", uint64_t(subsystem.usage));
+            entry.pushKV("peak", uint64_t(subsystem.peak));
+            if (subsystem.limit) entry.pushKV("limit", uint64_t(*subsystem.limit));
+            obj.pushKV(subsystem.name, entry);
+        }
+        return obj;
     } else if (mode == "mallocinfo") {
 #ifdef HAVE_MALLOC_INFO
         return RPCMallocInfo();
@@ -353,6 +384,161 @@ static RPCHelpMan getmemoryinfo()
     };
 }
 
+// SYSCOIN
+static RPCHelpMan getstartupinfo()
+{
+    return RPCHelpMan{"getstartupinfo",
+                "Returns how long each phase of the node startup took, in the order they finished.\n"
+                "The cache loads run partly in parallel, so their durations can add up to more than \"load_caches\".\n",
+                {},
+                RPCResult{
+                    RPCResult::Type::ARR, "", "",
+                    {
+                        {RPCResult::Type::OBJ, "", "",
+                        {
+                            {RPCResult::Type::STR, "name", "The startup phase, \"total\" covers everything up to the end of the RPC warmup"},
+                            {RPCResult::Type::NUM, "duration_ms", "Time spent in the phase in milliseconds"},
+                        }},
+                    }
+                },
+                RPCExamples{
+                    HelpExampleCli("getstartupinfo", "")
+            + HelpExampleRpc("getstartupinfo", "")
+                },
+        [&](const RPCHelpMan& self, const node::JSONRPCRequest& request) -> UniValue
+{
+    const NodeContext& node = EnsureAnyNodeContext(request.context);
+    UniValue ret(UniValue::VARR);
+    // the timings are only written before the RPC warmup ends, so they can be read without a lock
+    for (const auto& [name, duration] : node.startup_timings) {
+        UniValue entry(UniValue::VOBJ);
+        entry.pushKV("name", name);
+        entry.pushKV("duration_ms", duration.count());
+        ret.push_back(entry);
+    }
+    return ret;
+},
+    };
+}
+
+static RPCHelpMan getexecutorinfo()
+{
+    return RPCHelpMan{"getexecutorinfo",
+                "Returns the load of the shared executor that runs the BLS and LLMQ work, per priority lane.\n",
+                {},
+                RPCResult{
+                    RPCResult::Type::OBJ, "", "",
+                    {
+                        {RPCResult::Type::NUM, "threads", "Number of worker threads"},
+                        {RPCResult::Type::NUM, "uptime_ms", "Time since the workers were started in milliseconds"},
+                        {RPCResult::Type::OBJ_DYN, "lanes", "The lanes by name, in priority order",
+                        {
+                            {RPCResult::Type::OBJ, "lane", "",
+                            {
+                                {RPCResult::Type::NUM, "submitted", "Tasks submitted"},
+                                {RPCResult::Type::NUM, "completed", "Tasks completed"},
+                                {RPCResult::Type::NUM, "queued", "Tasks waiting for a worker"},
+                                {RPCResult::Type::NUM, "running", "Tasks running"},
+                                {RPCResult::Type::NUM, "busy_ms", "Time spent running tasks, summed over the workers, in milliseconds"},
+                                {RPCResult::Type::NUM, "utilization", "Share of the worker time spent on the lane since the start"},
+                            }},
+                        }},
+                    }
+                },
+                RPCExamples{
+                    HelpExampleCli("getexecutorinfo", "")
+            + HelpExampleRpc("getexecutorinfo", "")
+                },
+        [&](const RPCHelpMan& self, const node::JSONRPCRequest& request) -> UniValue
+{
+    const Executor& executor = GetSharedExecutor();
+    const auto uptime{executor.Uptime()};
+    UniValue ret(UniValue::VOBJ);
+    ret.pushKV("threads", executor.ThreadCount());
+    ret.pushKV("uptime_ms", count_milliseconds(std::chrono::duration_cast<std::chrono::milliseconds>(uptime)));
+    UniValue lanes(UniValue::VOBJ);
+    for (const auto lane : {Executor::Lane::VALIDATION, Executor::Lane::LLMQ, Executor::Lane::BACKGROUND}) {
+        const Executor::LaneStats stats{executor.GetStats(lane)};
+        UniValue entry(UniValue::VOBJ);
+        entry.pushKV("submitted", stats.submitted);
+        entry.pushKV("completed", stats.completed);
+        entry.pushKV("queued", stats.queued);
+        entry.pushKV("running", stats.running);
+        entry.pushKV("busy_ms", count_milliseconds(std::chrono::duration_cast<std::chrono::milliseconds>(stats.busy)));
+        entry.pushKV("utilization", uptime.count() > 0 ? double(stats.busy.count()) / (double(uptime.count()) * executor.ThreadCount()) : 0.0);
+        lanes.pushKV(Executor::LaneName(lane), entry);
+    }
+    ret.pushKV("lanes", lanes);
+    return ret;
+},
+    };
+}
+
+static UniValue SchedulerToJSON(const CScheduler& scheduler)
+{
+    std::chrono::steady_clock::time_point first, last;
+    UniValue entry(UniValue::VOBJ);
+    entry.pushKV("queued", scheduler.getQueueInfo(first, last));
+    UniValue tasks(UniValue::VOBJ);
+    for (const auto& [name, stats] : scheduler.GetTaskStats()) {
+        UniValue task(UniValue::VOBJ);
+        task.pushKV("runs", stats.runs);
+        task.pushKV("total_ms", Ticks<MillisecondsDouble>(stats.total_run));
+        task.pushKV("max_ms", Ticks<MillisecondsDouble>(stats.max_run));
+        task.pushKV("avg_delay_ms", stats.runs ? Ticks<MillisecondsDouble>(stats.total_delay) / stats.runs : 0.0);
+        task.pushKV("max_delay_ms", Ticks<MillisecondsDouble>(stats.max_delay));
+        tasks.pushKV(name, task);
+    }
+    entry.pushKV("tasks", tasks);
+    return entry;
+}
+
+static RPCHelpMan getschedulerinfo()
+{
+    return RPCHelpMan{"getschedulerinfo",
+                "Returns how long the named tasks of each scheduler lane ran and how late they started.\n"
+                "A task that runs long delays the tasks behind it on the same lane.\n",
+                {},
+                RPCResult{
+                    RPCResult::Type::OBJ_DYN, "", "The lanes by name",
+                    {
+                        {RPCResult::Type::OBJ, "lane", "",
+                        {
+                            {RPCResult::Type::NUM, "queued", "Tasks waiting to run"},
+                            {RPCResult::Type::OBJ_DYN, "tasks", "The tasks by name",
+                            {
+                                {RPCResult::Type::OBJ, "task", "",
+                                {
+                                    {RPCResult::Type::NUM, "runs", "Times the task ran"},
+                                    {RPCResult::Type::NUM, "total_ms", "Time spent running the task in milliseconds"},
+                                    {RPCResult::Type::NUM, "max_ms", "Longest run in milliseconds"},
+                                    {RPCResult::Type::NUM, "avg_delay_ms", "Average time between when a run was due and when it started, in milliseconds"},
+                                    {RPCResult::Type::NUM, "max_delay_ms", "Longest delay in milliseconds"},
+                                }},
+                            }},
+                        }},
+                    }
+                },
+                RPCExamples{
+                    HelpExampleCli("getschedulerinfo", "")
+            + HelpExampleRpc("getschedulerinfo", "")
+                },
+        [&](const RPCHelpMan& self, const node::JSONRPCRequest& request) -> UniValue
+{
+    const NodeContext& node = EnsureAnyNodeContext(request.context);
+    UniValue ret(UniValue::VOBJ);
+    for (const CScheduler* scheduler : {node.scheduler.get(), node.maintenance_scheduler.get()}) {
+        if (scheduler) ret.pushKV(scheduler->GetName(), SchedulerToJSON(*scheduler));
+    }
+    if (llmq::chainLocksHandler) {
+        const CScheduler& scheduler{llmq::chainLocksHandler->GetScheduler()};
+        ret.pushKV(scheduler.GetName(), SchedulerToJSON(scheduler));
+    }
+    return ret;
+},
+    };
+}
+
 static void EnableOrDisableLogCategories(UniValue cats, bool enable) {
     cats = cats.get_array();
     for (unsigned int i = 0; i < cats.size(); ++i) {
@@ -552,6 +738,16 @@ static RPCHelpMan getindexinfo()
     if (g_coin_stats_index) {
         result.pushKVs(SummaryToJSON(g_coin_stats_index->GetSummary(), index_name));
     }
+    // SYSCOIN
+    if (g_asset_index) {
+        result.pushKVs(SummaryToJSON(g_asset_index->GetSummary(), index_name));
+    }
+    if (g_address_index) {
+        result.pushKVs(SummaryToJSON(g_address_index->GetSummary(), index_name));
+    }
+    if (g_block_stats_index) {
+        result.pushKVs(SummaryToJSON(g_block_stats_index->GetSummary(), index_name));
+    }
 
     ForEachBlockFilterIndex([&result, &index_name](const BlockFilterIndex& index) {
         result.pushKVs(SummaryToJSON(index.GetSummary(), index_name));
@@ -566,6 +762,9 @@ void RegisterNodeRPCCommands(CRPCTable& t)
 {
     static const CRPCCommand commands[]{
         {"control", &getmemoryinfo},
+        {"control", &getstartupinfo},
+        {"control", &getexecutorinfo},
+        {"control", &getschedulerinfo},
         {"control", &logging},
         {"util", &getindexinfo},
         {"hidden", &setmocktime},
@@ -10,11 +10,16 @@
 enum HTTPStatusCode
 {
     HTTP_OK                    = 200,
+    // SYSCOIN
+    HTTP_PARTIAL_CONTENT       = 206,
+    HTTP_NOT_MODIFIED          = 304,
     HTTP_BAD_REQUEST           = 400,
     HTTP_UNAUTHORIZED          = 401,
     HTTP_FORBIDDEN             = 403,
     HTTP_NOT_FOUND             = 404,
     HTTP_BAD_METHOD            = 405,
+    // SYSCOIN
+    HTTP_RANGE_NOT_SATISFIABLE = 416,
     HTTP_INTERNAL_SERVER_ERROR = 500,
     HTTP_SERVICE_UNAVAILABLE   = 503,
 };
@@ -24,6 +24,7 @@ void DeleteAuthCookie();
 /** Parse JSON-RPC batch reply into a vector */
 std::vector<UniValue> JSONRPCProcessBatchReply(const UniValue& in);
 // SYSCOIN
+class JSONStreamWriter;
 namespace node {
 struct NodeContext;
 class JSONRPCRequest
@@ -39,6 +40,8 @@ public:
     std::any context;
     // SYSCOIN
     NodeContext *nodeContext{nullptr};
+    //! set when the transport streams the reply, positioned where the result goes
+    JSONStreamWriter* stream{nullptr};
 
     void parse(const UniValue& valRequest);
 };
@@ -7,6 +7,7 @@
 #include <init.h>
 #include <rpc/server.h>
 #include <util/moneystr.h>
+#include <util/strencodings.h>
 #include <validation.h>
 
 #include <evo/deterministicmns.h>
@@ -16,6 +17,7 @@
 #include <masternode/masternodemeta.h>
 #include <rpc/util.h>
 #include <rpc/blockchain.h>
+#include <rpc/jsonstream.h>
 #include <node/context.h>
 #include <rpc/server_util.h>
 #include <llmq/quorums_utils.h>
@@ -71,7 +73,6 @@ static RPCHelpMan protx_list()
         type = request.params[0].get_str();
     }
 
-    UniValue ret(UniValue::VARR);
     if (g_txindex) {
         g_txindex->BlockUntilSyncedToCurrentChain();
     }
@@ -87,16 +88,15 @@ static RPCHelpMan protx_list()
             mnList = deterministicMNManager->GetListForBlock(node.chainman->ActiveChain()[height]);
         }
         bool onlyValid = type == "valid";
+        // SYSCOIN entries are streamed when the reply allows it
+        RPCResultWriter ret{request.stream, UniValue::VARR};
         mnList.ForEachMN(onlyValid, [&](const auto& dmn) {
             ret.push_back(BuildDMNListEntry(node, dmn, detailed));
         });
-
+        return ret.Finish();
     } else {
         throw JSONRPCError(RPC_INVALID_PARAMETER, "invalid type specified");
     }
-    
-
-    return ret;
 },
     };
 } 
@@ -131,6 +131,87 @@ static RPCHelpMan protx_info()
     };
 }
 
+// SYSCOIN
+static RPCHelpMan protx_diff()
+{
+    return RPCHelpMan{"protx_diff",
+        "\nCalculates the diff between the deterministic masternode lists of two blocks.\n"
+        "Diffs are cached, the diffs from recent tips to the current tip are built ahead.\n",
+        {
+            {"baseBlock", RPCArg::Type::STR, RPCArg::Optional::NO, "The hash or height of the block whose list the diff starts from."},
+            {"block", RPCArg::Type::STR, RPCArg::Optional::NO, "The hash or height of the block whose list the diff leads to."},
+            {"verbose", RPCArg::Type::BOOL, RPCArg::Default{false}, "If true, return the diff as a json object instead of the serialized CDeterministicMNListDiff."},
+        },
+        {
+            RPCResult{"for verbose = false", RPCResult::Type::STR_HEX, "", "The serialized diff"},
+            RPCResult{"for verbose = true", RPCResult::Type::OBJ, "", "",
+            {
+                {RPCResult::Type::STR_HEX, "baseBlockHash", "The block the diff starts from"},
+                {RPCResult::Type::STR_HEX, "blockHash", "The block the diff leads to"},
+                {RPCResult::Type::ARR, "addedMNs", "The masternodes added",
+                    {{RPCResult::Type::OBJ, "", "", {{RPCResult::Type::ELISION, "", "As in protx_info"}}}}},
+                {RPCResult::Type::OBJ_DYN, "updatedMNs", "The changed state fields by proTxHash",
+                    {{RPCResult::Type::OBJ, "proTxHash", "", {{RPCResult::Type::ELISION, "", ""}}}}},
+                {RPCResult::Type::ARR, "removedMNs", "The proTxHashes of the masternodes removed",
+                    {{RPCResult::Type::STR_HEX, "", ""}}},
+            }},
+        },
+        RPCExamples{
+                HelpExampleCli("protx_diff", "1000 2000")
+            + HelpExampleRpc("protx_diff", "1000, 2000")
+        },
+    [&](const RPCHelpMan& self, const node::JSONRPCRequest& request) -> UniValue
+{
+    const node::NodeContext& node = EnsureAnyNodeContext(request.context);
+    ChainstateManager& chainman = EnsureChainman(node);
+    // heights may come as strings from the command line
+    const auto parse_block = [&](const UniValue& param) {
+        if (param.isStr() && !param.get_str().empty() && param.get_str().size() < 16) {
+            if (const auto height = ToIntegral<int>(param.get_str())) {
+                return ParseHashOrHeight(UniValue(*height), chainman);
+            }
+        }
+        return ParseHashOrHeight(param, chainman);
+    };
+    const CBlockIndex* pindexBase = parse_block(request.params[0]);
+    const CBlockIndex* pindex = parse_block(request.params[1]);
+    const auto diffBytes = deterministicMNManager->GetListDiff(pindexBase, pindex);
+    if (request.params[2].isNull() || !request.params[2].get_bool()) {
+        return HexStr(*diffBytes);
+    }
+
+    CDeterministicMNListDiff diff;
+    CDataStream ss(*diffBytes, SER_NETWORK, PROTOCOL_VERSION);
+    ss >> diff;
+    const auto baseList = deterministicMNManager->GetListForBlock(pindexBase);
+    const auto list = deterministicMNManager->GetListForBlock(pindex);
+    UniValue ret(UniValue::VOBJ);
+    ret.pushKV("baseBlockHash", pindexBase->GetBlockHash().GetHex());
+    ret.pushKV("blockHash", pindex->GetBlockHash().GetHex());
+    UniValue added(UniValue::VARR);
+    for (const auto& dmn : diff.addedMNs) {
+        UniValue o(UniValue::VOBJ);
+        dmn->ToJson(*node.chain, o);
+        added.push_back(o);
+    }
+    ret.pushKV("addedMNs", added);
+    UniValue updated(UniValue::VOBJ);
+    for (const auto& [internalId, stateDiff] : diff.updatedMNs) {
+        const auto dmn = list.GetMNByInternalId(internalId);
+        if (dmn) updated.pushKV(dmn->proTxHash.GetHex(), stateDiff.ToJson());
+    }
+    ret.pushKV("updatedMNs", updated);
+    UniValue removed(UniValue::VARR);
+    for (const uint64_t internalId : diff.removedMns) {
+        const auto dmn = baseList.GetMNByInternalId(internalId);
+        if (dmn) removed.push_back(dmn->proTxHash.GetHex());
+    }
+    ret.pushKV("removedMNs", removed);
+    return ret;
+},
+    };
+}
+
 static RPCHelpMan bls_generate()
 {
      return RPCHelpMan{"bls_generate",
@@ -207,6 +288,7 @@ void RegisterEvoRPCCommands(CRPCTable &t)
         {"evo", &bls_fromsecret},
         {"evo", &protx_list},
         {"evo", &protx_info},
+        {"evo", &protx_diff},
     };
     for (const auto& c : commands) {
         t.appendCommand(c.name, &c);
@@ -420,7 +420,7 @@ static RPCHelpMan quorum_verify()
             throw JSONRPCError(RPC_INVALID_PARAMETER, "quorum not found");
         }
         uint256 signHash = llmq::BuildSignHash( quorum->qc->quorumHash, id, msgHash);
-        return sig.VerifyInsecure(quorum->qc->quorumPublicKey, signHash);
+        return sig.VerifyInsecure(quorum->preparedPublicKey, signHash);
     }
 },
     };
@@ -563,6 +563,100 @@ static RPCHelpMan quorum_dkgsimerror()
     };
 } 
 
+static RPCHelpMan quorum_sigsharestats()
+{
+    const std::vector<RPCResult> stage{
+        {RPCResult::Type::NUM, "runs", "Number of times the stage ran"},
+        {RPCResult::Type::NUM, "total_us", "Total time spent in the stage, in microseconds"},
+        {RPCResult::Type::NUM, "avg_us", "Average time per run, in microseconds"},
+        {RPCResult::Type::NUM, "max_us", "Longest run, in microseconds"},
+    };
+    const std::vector<RPCResult> histogram{
+        {RPCResult::Type::NUM, "count", "Number of samples"},
+        {RPCResult::Type::NUM, "avg", "Average of the samples"},
+        {RPCResult::Type::NUM, "p50", "Median, rounded up to the next power of two minus one"},
+        {RPCResult::Type::NUM, "p90", "90th percentile, rounded up to the next power of two minus one"},
+        {RPCResult::Type::NUM, "p99", "99th percentile, rounded up to the next power of two minus one"},
+        {RPCResult::Type::NUM, "max", "Largest sample"},
+    };
+    return RPCHelpMan{"quorum_sigsharestats",
+        "\nReturn the latency of the stages of the signature share worker and of signature recovery since startup.\n",
+        {},
+        RPCResult{
+            RPCResult::Type::OBJ, "", "",
+            {
+                {RPCResult::Type::OBJ, "collect", "Collecting pending shares to verify", stage},
+                {RPCResult::Type::OBJ, "prepare", "Looking up the public key shares of the collected shares", stage},
+                {RPCResult::Type::OBJ, "verify", "Batched verification on the BLS worker pool", stage},
+                {RPCResult::Type::OBJ, "process", "Storing verified shares and recovering signatures", stage},
+                {RPCResult::Type::OBJ, "sign", "Creating our own pending signature shares", stage},
+                {RPCResult::Type::OBJ, "send", "Sending announcements, requests and shares to peers", stage},
+                {RPCResult::Type::NUM, "verified_sig_shares", "Number of signature shares verified"},
+                {RPCResult::Type::NUM, "verify_batches", "Number of verification batches, one per sign hash"},
+                {RPCResult::Type::OBJ, "verify_batch_size", "Signature shares per verification batch", histogram},
+                {RPCResult::Type::OBJ, "session_recovery_ms", "From the first verified share of a session to its recovered signature, in milliseconds", histogram},
+                {RPCResult::Type::OBJ, "queue_wait_ms", "How long the oldest pending share of a peer waited for verification, in milliseconds", histogram},
+                {RPCResult::Type::NUM, "late_sig_shares", "Shares dropped on arrival because the signature was already recovered"},
+                {RPCResult::Type::OBJ, "recovered_sigs", "Verification of recovered signatures received from peers",
+                {
+                    {RPCResult::Type::OBJ, "queue_wait_ms", "How long the oldest pending signature of a peer waited for verification, in milliseconds", histogram},
+                    {RPCResult::Type::OBJ, "batch_size", "Signatures per verification batch", histogram},
+                }},
+            }
+        },
+        RPCExamples{
+                HelpExampleCli("quorum_sigsharestats", "")
+            + HelpExampleRpc("quorum_sigsharestats", "")
+        },
+    [&](const RPCHelpMan& self, const node::JSONRPCRequest& request) -> UniValue
+{
+    if (!llmq::quorumSigSharesManager) {
+        throw JSONRPCError(RPC_INTERNAL_ERROR, "Signature share manager not initialized");
+    }
+    const auto stats = llmq::quorumSigSharesManager->GetWorkStats();
+    auto stageToJson = [](const llmq::CSigSharesManager::StageStats& stage) {
+        UniValue obj(UniValue::VOBJ);
+        obj.pushKV("runs", stage.runs);
+        obj.pushKV("total_us", stage.totalMicros);
+        obj.pushKV("avg_us", stage.runs > 0 ? stage.totalMicros / stage.runs : 0);
+        obj.pushKV("max_us", stage.maxMicros);
+        return obj;
+    };
+    UniValue ret(UniValue::VOBJ);
+    ret.pushKV("collect", stageToJson(stats.collect));
+    ret.pushKV("prepare", stageToJson(stats.prepare));
+    ret.pushKV("verify", stageToJson(stats.verify));
+    ret.pushKV("process", stageToJson(stats.process));
+    ret.pushKV("sign", stageToJson(stats.sign));
+    ret.pushKV("send", stageToJson(stats.send));
+    ret.pushKV("verified_sig_shares", stats.verifiedSigShares);
+    ret.pushKV("verify_batches", stats.verifyBatches);
+    auto histogramToJson = [](const llmq::CLatencyHistogram& histogram) {
+        UniValue obj(UniValue::VOBJ);
+        obj.pushKV("count", histogram.count);
+        obj.pushKV("avg", histogram.Average());
+        obj.pushKV("p50", histogram.Percentile(50));
+        obj.pushKV("p90", histogram.Percentile(90));
+        obj.pushKV("p99", histogram.Percentile(99));
+        obj.pushKV("max", histogram.max);
+        return obj;
+    };
+    ret.pushKV("verify_batch_size", histogramToJson(stats.verifyBatchSize));
+    ret.pushKV("session_recovery_ms", histogramToJson(stats.sessionRecoveryMs));
+    ret.pushKV("queue_wait_ms", histogramToJson(stats.queueWaitMs));
+    ret.pushKV("late_sig_shares", stats.lateSigShares);
+    UniValue recoveredSigs(UniValue::VOBJ);
+    if (llmq::quorumSigningManager) {
+        const auto recSigStats = llmq::quorumSigningManager->GetRecoveredSigsStats();
+        recoveredSigs.pushKV("queue_wait_ms", histogramToJson(recSigStats.queueWaitMs));
+        recoveredSigs.pushKV("batch_size", histogramToJson(recSigStats.batchSize));
+    }
+    ret.pushKV("recovered_sigs", recoveredSigs);
+    return ret;
+},
+    };
+}
+
 
 static RPCHelpMan verifychainlock()
 {
@@ -647,32 +741,46 @@ static RPCHelpMan gettxchainlocks()
         throw JSONRPCError(RPC_INVALID_PARAMETER, "Up to 100 txids only");
     }
 
-    if (g_txindex) {
-        g_txindex->BlockUntilSyncedToCurrentChain();
-    }
-    LOCK(cs_main);
+    std::vector<uint256> vecTXIDs;
+    vecTXIDs.reserve(txids.size());
     for (size_t idx = 0;idx < txids.size();idx++) {
-        UniValue result(UniValue::VOBJ);
         const uint256 txid(ParseHashV(txids[idx], "txid"));
         if (txid == Params().GenesisBlock().hashMerkleRoot) {
             // Special exception for the genesis block coinbase transaction
             throw JSONRPCError(RPC_INVALID_ADDRESS_OR_KEY, "The genesis block coinbase is not considered an ordinary transaction and cannot be retrieved");
         }
+        vecTXIDs.emplace_back(txid);
+    }
 
+    if (g_txindex) {
+        g_txindex->BlockUntilSyncedToCurrentChain();
+    }
+    LOCK(cs_main);
+    // SYSCOIN resolve the heights of all txids in one pass over the block index db
+    std::unordered_map<uint256, uint32_t, StaticSaltedHasher> mapHeights;
+    pblockindexdb->ReadBlockHeights(vecTXIDs, mapHeights);
+    for (const uint256& txid : vecTXIDs) {
+        UniValue result(UniValue::VOBJ);
         uint256 hash_block;
         const CBlockIndex* pindex{nullptr};
         uint32_t nBlockHeight{0};
-        if(pblockindexdb->ReadBlockHeight(txid, nBlockHeight)) {	
-            pindex = chainman.ActiveChain()[nBlockHeight];	
+        auto it = mapHeights.find(txid);
+        if (it != mapHeights.end()) {
+            nBlockHeight = it->second;
+            pindex = chainman.ActiveChain()[nBlockHeight];
         }
-        const auto tx_ref = GetTransaction(pindex, node.mempool.get(), txid, hash_block, chainman.m_blockman);
-        if (tx_ref == nullptr) {
+        // the index is updated when blocks are connected and disconnected, so a tx it places in the active chain
+        // does not need to be read back from the block
+        if (pindex == nullptr && GetTransaction(nullptr, node.mempool.get(), txid, hash_block, chainman.m_blockman) == nullptr) {
             result.pushKV("height", 0);
             result.pushKV("chainlock", false);
             result.pushKV("mempool", false);
             result_arr.push_back(result);
             continue;
         }
+        if (pindex) {
+            hash_block = pindex->GetBlockHash();
+        }
         result.pushKV("height", nBlockHeight);
         result.pushKV("chainlock", pindex? llmq::chainLocksHandler->HasChainLock(nBlockHeight, hash_block): false);
         result.pushKV("mempool", pindex == nullptr);
@@ -786,6 +894,7 @@ void RegisterQuorumsRPCCommands(CRPCTable &t)
         {"evo", &quorum_getrecsig},
         {"evo", &quorum_isconflicting},
         {"evo", &quorum_sign},
+        {"evo", &quorum_sigsharestats},
         {"evo", &submitchainlock},
         {"evo", &verifychainlock},
         {"evo", &getbestchainlock},
@@ -17,8 +17,11 @@
 
 #include <boost/signals2/signal.hpp>
 
+#include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <chrono>
+#include <condition_variable>
 #include <memory>
 #include <mutex>
 #include <unordered_map>
@@ -380,12 +383,69 @@ static UniValue JSONRPCExecOne(node::JSONRPCRequest jreq, const UniValue& req)
     return rpc_result;
 }
 
-std::string JSONRPCExecBatch(const node::JSONRPCRequest& jreq, const UniValue& vReq)
+namespace {
+/** Batch elements shared by the threads running them. Elements are claimed in
+ * order, so a helper that starts after all of them were claimed leaves at once. */
+struct RPCBatch {
+    const node::JSONRPCRequest jreq;
+    //! only read for claimed elements, the caller waits for those
+    const UniValue& vReq;
+    std::vector<UniValue> results;
+    std::atomic<size_t> next{0};
+    Mutex m_mutex;
+    std::condition_variable m_cond;
+    size_t m_done GUARDED_BY(m_mutex){0};
+
+    RPCBatch(const node::JSONRPCRequest& jreq_in, const UniValue& vReq_in) : jreq{jreq_in}, vReq{vReq_in}, results(vReq_in.size()) {}
+
+    /** Run the next unclaimed element, returns false when none is left */
+    bool RunNext() EXCLUSIVE_LOCKS_REQUIRED(!m_mutex)
+    {
+        const size_t i{next++};
+        if (i >= results.size()) return false;
+        results[i] = JSONRPCExecOne(jreq, vReq[i]);
+        LOCK(m_mutex);
+        if (++m_done == results.size()) m_cond.notify_all();
+        return true;
+    }
+};
+} // namespace
+
+/** Whether the elements of a batch may run at the same time */
+static bool CanRunBatchInParallel(const node::JSONRPCRequest& jreq, const UniValue& vReq)
+{
+    // wallet calls may depend on each other, e.g. unlock, sign and lock again
+    if (jreq.URI.rfind("/wallet/", 0) == 0) return false;
+    for (unsigned int reqIdx = 0; reqIdx < vReq.size(); reqIdx++) {
+        if (!vReq[reqIdx].isObject()) continue;
+        const UniValue& method = vReq[reqIdx].find_value("method");
+        if (method.isStr() && tableRPC.isInCategory(method.get_str(), "wallet")) return false;
+    }
+    return true;
+}
+
+std::string JSONRPCExecBatch(const node::JSONRPCRequest& jreq, const UniValue& vReq, const RPCBatchSpawner& spawn, size_t max_helpers)
 {
     UniValue ret(UniValue::VARR);
-    for (unsigned int reqIdx = 0; reqIdx < vReq.size(); reqIdx++)
-        ret.push_back(JSONRPCExecOne(jreq, vReq[reqIdx]));
+    // SYSCOIN
+    if (!spawn || max_helpers == 0 || vReq.size() < 2 || !CanRunBatchInParallel(jreq, vReq)) {
+        for (unsigned int reqIdx = 0; reqIdx < vReq.size(); reqIdx++)
+            ret.push_back(JSONRPCExecOne(jreq, vReq[reqIdx]));
+        return ret.write() + "\n";
+    }
 
+    auto batch = std::make_shared<RPCBatch>(jreq, vReq);
+    const size_t helpers{std::min<size_t>(max_helpers, vReq.size() - 1)};
+    for (size_t i = 0; i < helpers; ++i) {
+        if (!spawn([batch] { while (batch->RunNext()) {} })) break;
+    }
+    // the caller runs elements too, so the batch finishes even when no helper gets a thread
+    while (batch->RunNext()) {}
+    {
+        WAIT_LOCK(batch->m_mutex, lock);
+        batch->m_cond.wait(lock, [&]() EXCLUSIVE_LOCKS_REQUIRED(batch->m_mutex) { return batch->m_done == batch->results.size(); });
+    }
+    for (UniValue& result : batch->results) ret.push_back(std::move(result));
     return ret.write() + "\n";
 }
 
@@ -544,6 +604,14 @@ static bool ExecuteCommand(const CRPCCommand& command, const node::JSONRPCReques
     }
 }
 
+// SYSCOIN
+bool CRPCTable::isInCategory(const std::string& name, std::string_view category) const
+{
+    const auto it = mapCommands.find(name);
+    if (it == mapCommands.end()) return false;
+    return std::any_of(it->second.begin(), it->second.end(), [&](const CRPCCommand* command) { return command->category == category; });
+}
+
 std::vector<std::string> CRPCTable::listCommands() const
 {
     std::vector<std::string> commandList;
@@ -13,6 +13,7 @@
 #include <map>
 #include <stdint.h>
 #include <string>
+#include <string_view>
 #include <univalue.h>
 
 
@@ -152,6 +153,10 @@ public:
     */
     std::vector<std::string> listCommands() const;
 
+    // SYSCOIN
+    /** Whether a command of that name is registered in category */
+    bool isInCategory(const std::string& name, std::string_view category) const;
+
     /**
      * Return all named arguments that need to be converted by the client from string to another JSON type
      */
@@ -179,7 +184,16 @@ extern CRPCTable tableRPC;
 void StartRPC();
 void InterruptRPC();
 void StopRPC();
-std::string JSONRPCExecBatch(const node::JSONRPCRequest& jreq, const UniValue& vReq);
+// SYSCOIN
+/** Queues a function to run on another thread, returns false when it could not be queued */
+using RPCBatchSpawner = std::function<bool(std::function<void()>)>;
+/**
+ * Execute a batch and return the encoded array of its replies, in request order.
+ * With a spawner, up to max_helpers other threads are asked to run batch elements
+ * alongside the calling thread. Batches with wallet calls or sent to a wallet
+ * endpoint always run in order on the calling thread.
+ */
+std::string JSONRPCExecBatch(const node::JSONRPCRequest& jreq, const UniValue& vReq, const RPCBatchSpawner& spawn = {}, size_t max_helpers = 0);
 
 // SYSCOIN Retrieves any serialization flags requested in command line argument
 // int RPCSerializationFlags();
@@ -9,6 +9,7 @@
 #include <script/interpreter.h>
 #include <key_io.h>
 #include <outputtype.h>
+#include <rpc/jsonstream.h>
 #include <rpc/util.h>
 #include <script/descriptor.h>
 #include <script/signingprovider.h>
@@ -619,9 +620,13 @@ UniValue RPCHelpMan::HandleRequest(const node::JSONRPCRequest& request) const
     }
     CHECK_NONFATAL(m_req == nullptr);
     m_req = &request;
+    // SYSCOIN
+    const uint64_t stream_values{request.stream ? request.stream->ValueCount() : 0};
     UniValue ret = m_fun(*this, request);
     m_req = nullptr;
-    if (gArgs.GetBoolArg("-rpcdoccheck", DEFAULT_RPC_DOC_CHECK)) {
+    // a streamed result is not returned and cannot be checked
+    const bool streamed{request.stream && request.stream->ValueCount() != stream_values};
+    if (!streamed && gArgs.GetBoolArg("-rpcdoccheck", DEFAULT_RPC_DOC_CHECK)) {
         UniValue mismatch{UniValue::VARR};
         for (const auto& res : m_results.m_results) {
             UniValue match{res.MatchesType(ret)};
@@ -30,12 +30,42 @@ struct SaltedHasherImpl<std::pair<N, uint256>>
     }
 };
 
+// SYSCOIN
+template<>
+struct SaltedHasherImpl<std::pair<uint256, uint256>>
+{
+    static std::size_t CalcHash(const std::pair<uint256, uint256>& v, uint64_t k0, uint64_t k1)
+    {
+        return CSipHasher(k0, k1).Write(v.first).Write(v.second).Finalize();
+    }
+};
+
+// SYSCOIN the sig share, recovered sig and BLS caches look up uint256 keys all the time
 template<>
 struct SaltedHasherImpl<uint256>
 {
     static std::size_t CalcHash(const uint256& v, uint64_t k0, uint64_t k1)
     {
-        return SipHashUint256(k0, k1, v);
+        return SipHash13Uint256(k0, k1, v);
+    }
+};
+
+template<>
+struct SaltedHasherImpl<uint160>
+{
+    static std::size_t CalcHash(const uint160& v, uint64_t k0, uint64_t k1)
+    {
+        return CSipHasher(k0, k1).Write(v).Finalize();
+    }
+};
+
+// SYSCOIN
+template<size_t N>
+struct SaltedHasherImpl<std::array<uint8_t, N>>
+{
+    static std::size_t CalcHash(const std::array<uint8_t, N>& v, uint64_t k0, uint64_t k1)
+    {
+        return CSipHasher(k0, k1).Write(v).Finalize();
     }
 };
 
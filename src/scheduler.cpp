@@ -4,14 +4,16 @@
 
 #include <scheduler.h>
 
+#include <logging.h>
 #include <sync.h>
 #include <util/time.h>
 
+#include <algorithm>
 #include <cassert>
 #include <functional>
 #include <utility>
 
-CScheduler::CScheduler() = default;
+CScheduler::CScheduler(std::string name) : m_name{std::move(name)} {}
 
 CScheduler::~CScheduler()
 {
@@ -50,14 +52,32 @@ void CScheduler::serviceQueue()
             if (shouldStop() || taskQueue.empty())
                 continue;
 
-            Function f = taskQueue.begin()->second;
+            const std::chrono::steady_clock::time_point due = taskQueue.begin()->first;
+            Task task = std::move(taskQueue.begin()->second);
             taskQueue.erase(taskQueue.begin());
 
+            const auto start = std::chrono::steady_clock::now();
             {
                 // Unlock before calling f, so it can reschedule itself or another task
                 // without deadlocking:
                 REVERSE_LOCK(lock);
-                f();
+                task.f();
+            }
+            // SYSCOIN account the run, a task that throws out of serviceQueue is not
+            if (!task.name.empty()) {
+                const auto run = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+                const auto delay = std::max(std::chrono::duration_cast<std::chrono::microseconds>(start - due), std::chrono::microseconds{0});
+                TaskStats& stats = m_task_stats[task.name];
+                ++stats.runs;
+                stats.total_run += run;
+                stats.max_run = std::max(stats.max_run, run);
+                stats.total_delay += delay;
+                stats.max_delay = std::max(stats.max_delay, delay);
+                if (run >= SLOW_TASK_THRESHOLD) {
+                    LogPrintf("%s: task %s ran for %dms, it started %dms late\n", m_name, task.name, Ticks<std::chrono::milliseconds>(run), Ticks<std::chrono::milliseconds>(delay));
+                } else {
+                    LogPrint(BCLog::BENCHMARK, "%s: task %s ran for %.2fms, it started %.2fms late\n", m_name, task.name, Ticks<MillisecondsDouble>(run), Ticks<MillisecondsDouble>(delay));
+                }
             }
         } catch (...) {
             --nThreadsServicingQueue;
@@ -68,11 +88,11 @@ void CScheduler::serviceQueue()
     newTaskScheduled.notify_one();
 }
 
-void CScheduler::schedule(CScheduler::Function f, std::chrono::steady_clock::time_point t)
+void CScheduler::schedule(CScheduler::Function f, std::chrono::steady_clock::time_point t, std::string name)
 {
     {
         LOCK(newTaskMutex);
-        taskQueue.insert(std::make_pair(t, f));
+        taskQueue.emplace(t, Task{std::move(f), std::move(name)});
     }
     newTaskScheduled.notify_one();
 }
@@ -85,7 +105,7 @@ void CScheduler::MockForward(std::chrono::seconds delta_seconds)
         LOCK(newTaskMutex);
 
         // use temp_queue to maintain updated schedule
-        std::multimap<std::chrono::steady_clock::time_point, Function> temp_queue;
+        std::multimap<std::chrono::steady_clock::time_point, Task> temp_queue;
 
         for (const auto& element : taskQueue) {
             temp_queue.emplace_hint(temp_queue.cend(), element.first - delta_seconds, element.second);
@@ -99,15 +119,15 @@ void CScheduler::MockForward(std::chrono::seconds delta_seconds)
     newTaskScheduled.notify_one();
 }
 
-static void Repeat(CScheduler& s, CScheduler::Function f, std::chrono::milliseconds delta)
+static void Repeat(CScheduler& s, CScheduler::Function f, std::chrono::milliseconds delta, const std::string& name)
 {
     f();
-    s.scheduleFromNow([=, &s] { Repeat(s, f, delta); }, delta);
+    s.scheduleFromNow([=, &s] { Repeat(s, f, delta, name); }, delta, name);
 }
 
-void CScheduler::scheduleEvery(CScheduler::Function f, std::chrono::milliseconds delta)
+void CScheduler::scheduleEvery(CScheduler::Function f, std::chrono::milliseconds delta, std::string name)
 {
-    scheduleFromNow([this, f, delta] { Repeat(*this, f, delta); }, delta);
+    scheduleFromNow([this, f, delta, name] { Repeat(*this, f, delta, name); }, delta, name);
 }
 
 size_t CScheduler::getQueueInfo(std::chrono::steady_clock::time_point& first,
@@ -128,6 +148,12 @@ bool CScheduler::AreThreadsServicingQueue() const
     return nThreadsServicingQueue;
 }
 
+std::map<std::string, CScheduler::TaskStats> CScheduler::GetTaskStats() const
+{
+    LOCK(newTaskMutex);
+    return m_task_stats;
+}
+
 
 void SingleThreadedSchedulerClient::MaybeScheduleProcessQueue()
 {
@@ -139,7 +165,7 @@ void SingleThreadedSchedulerClient::MaybeScheduleProcessQueue()
         if (m_are_callbacks_running) return;
         if (m_callbacks_pending.empty()) return;
     }
-    m_scheduler.schedule([this] { this->ProcessQueue(); }, std::chrono::steady_clock::now());
+    m_scheduler.schedule([this] { this->ProcessQueue(); }, std::chrono::steady_clock::now(), "callbacks");
 }
 
 void SingleThreadedSchedulerClient::ProcessQueue()
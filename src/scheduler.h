@@ -15,6 +15,7 @@
 #include <functional>
 #include <list>
 #include <map>
+#include <string>
 #include <thread>
 #include <utility>
 
@@ -38,20 +39,35 @@
 class CScheduler
 {
 public:
-    CScheduler();
+    // SYSCOIN a scheduler is a lane of its own, named after the thread servicing it
+    explicit CScheduler(std::string name = "scheduler");
     ~CScheduler();
 
     std::thread m_service_thread;
 
     typedef std::function<void()> Function;
 
-    /** Call func at/after time t */
-    void schedule(Function f, std::chrono::steady_clock::time_point t) EXCLUSIVE_LOCKS_REQUIRED(!newTaskMutex);
+    //! SYSCOIN how long the runs of one named task took, and how late they started
+    struct TaskStats {
+        uint64_t runs{0};
+        std::chrono::microseconds total_run{0};
+        std::chrono::microseconds max_run{0};
+        std::chrono::microseconds total_delay{0};
+        std::chrono::microseconds max_delay{0};
+    };
+
+    //! SYSCOIN runs taking longer than this are logged, they hold up everything else on the lane
+    static constexpr std::chrono::milliseconds SLOW_TASK_THRESHOLD{1000};
+
+    const std::string& GetName() const { return m_name; }
+
+    /** Call func at/after time t. Runs of tasks with a name are accounted in GetTaskStats(). */
+    void schedule(Function f, std::chrono::steady_clock::time_point t, std::string name = {}) EXCLUSIVE_LOCKS_REQUIRED(!newTaskMutex);
 
     /** Call f once after the delta has passed */
-    void scheduleFromNow(Function f, std::chrono::milliseconds delta) EXCLUSIVE_LOCKS_REQUIRED(!newTaskMutex)
+    void scheduleFromNow(Function f, std::chrono::milliseconds delta, std::string name = {}) EXCLUSIVE_LOCKS_REQUIRED(!newTaskMutex)
     {
-        schedule(std::move(f), std::chrono::steady_clock::now() + delta);
+        schedule(std::move(f), std::chrono::steady_clock::now() + delta, std::move(name));
     }
 
     /**
@@ -60,7 +76,7 @@ public:
      * The timing is not exact: Every time f is finished, it is rescheduled to run again after delta. If you need more
      * accurate scheduling, don't use this method.
      */
-    void scheduleEvery(Function f, std::chrono::milliseconds delta) EXCLUSIVE_LOCKS_REQUIRED(!newTaskMutex);
+    void scheduleEvery(Function f, std::chrono::milliseconds delta, std::string name = {}) EXCLUSIVE_LOCKS_REQUIRED(!newTaskMutex);
 
     /**
      * Mock the scheduler to fast forward in time.
@@ -100,10 +116,20 @@ public:
     /** Returns true if there are threads actively running in serviceQueue() */
     bool AreThreadsServicingQueue() const EXCLUSIVE_LOCKS_REQUIRED(!newTaskMutex);
 
+    /** SYSCOIN run time and scheduling delay of the named tasks that ran so far */
+    std::map<std::string, TaskStats> GetTaskStats() const EXCLUSIVE_LOCKS_REQUIRED(!newTaskMutex);
+
 private:
+    struct Task {
+        Function f;
+        std::string name;
+    };
+
+    const std::string m_name;
     mutable Mutex newTaskMutex;
     std::condition_variable newTaskScheduled;
-    std::multimap<std::chrono::steady_clock::time_point, Function> taskQueue GUARDED_BY(newTaskMutex);
+    std::multimap<std::chrono::steady_clock::time_point, Task> taskQueue GUARDED_BY(newTaskMutex);
+    std::map<std::string, TaskStats> m_task_stats GUARDED_BY(newTaskMutex);
     int nThreadsServicingQueue GUARDED_BY(newTaskMutex){0};
     bool stopRequested GUARDED_BY(newTaskMutex){false};
     bool stopWhenEmpty GUARDED_BY(newTaskMutex){false};
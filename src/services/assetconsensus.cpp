@@ -16,9 +16,74 @@
 #include <key_io.h>
 #include <logging.h>
 #include <core_io.h>
+#include <util/time.h>
+#include <util/trace.h>
 std::unique_ptr<CNEVMTxRootsDB> pnevmtxrootsdb;
 std::unique_ptr<CNEVMMintedTxDB> pnevmtxmintdb;
 const arith_uint256 nMax = arith_uint256(MAX_MONEY);
+/** Read a 32 byte big-endian EVM word into the uint256 it encodes */
+static uint256 ReadBE256(const unsigned char* p) {
+    uint256 value;
+    std::reverse_copy(p, p + 32, value.begin());
+    return value;
+}
+static bool CheckMintProofs(const CMintSyscoin &mintSyscoin, std::string &strError) {
+    const dev::RLP rlpReceiptParentNodes(&mintSyscoin.vchReceiptParentNodes);
+    const dev::RLP rlpReceiptValue(
+        dev::bytesConstRef(
+            mintSyscoin.vchReceiptParentNodes.data() + mintSyscoin.posReceipt,
+            mintSyscoin.vchReceiptParentNodes.size() - mintSyscoin.posReceipt
+        )
+    );
+    const dev::RLP rlpTxParentNodes(&mintSyscoin.vchTxParentNodes);
+    const dev::RLP rlpTxValue(
+        dev::bytesConstRef(
+            mintSyscoin.vchTxParentNodes.data() + mintSyscoin.posTx,
+            mintSyscoin.vchTxParentNodes.size() - mintSyscoin.posTx
+        )
+    );
+    const dev::bytesConstRef vchTxPathRef(mintSyscoin.vchTxPath.data(), mintSyscoin.vchTxPath.size());
+    // the roots are compared against node hashes in place
+    const dev::bytesConstRef txRootRef(mintSyscoin.nTxRoot.data(), mintSyscoin.nTxRoot.size());
+    const dev::bytesConstRef receiptRootRef(mintSyscoin.nReceiptRoot.data(), mintSyscoin.nReceiptRoot.size());
+    // verify receipt proof
+    if(!VerifyProof(vchTxPathRef, rlpReceiptValue.data(), rlpReceiptParentNodes, receiptRootRef)) {
+        strError = "mint-verify-receipt-proof";
+        return false;
+    }
+    // verify transaction proof
+    if(!VerifyProof(vchTxPathRef, rlpTxValue.data(), rlpTxParentNodes, txRootRef)) {
+        strError = "mint-verify-tx-proof";
+        return false;
+    }
+    return true;
+}
+/** Check the receipt and transaction Merkle Patricia proofs of a mint against its roots, strError is set on failure */
+static bool VerifyMintProofs(const CMintSyscoin &mintSyscoin, std::string &strError) {
+    const auto time_start{SteadyClock::now()};
+    const bool fValid = CheckMintProofs(mintSyscoin, strError);
+    TRACE4(asset, mint_proof_verified, mintSyscoin.nTxHash.data(), fValid, mintSyscoin.vchTxParentNodes.size() + mintSyscoin.vchReceiptParentNodes.size(),
+        Ticks<std::chrono::microseconds>(SteadyClock::now() - time_start));
+    return fValid;
+}
+bool CMintProofCheck::Verify(std::string &strError) const {
+    try {
+        if (!VerifyMintProofs(*mintSyscoin, strError)) {
+            LogPrint(BCLog::SYS, "CMintProofCheck: %s for NEVM tx %s\n", strError, mintSyscoin->nTxHash.GetHex());
+            return false;
+        }
+    } catch (const std::exception& e) {
+        // the same reason CheckSyscoinInputs rejects with when verifying inline
+        strError = e.what();
+        LogPrint(BCLog::SYS, "CMintProofCheck: %s for NEVM tx %s\n", strError, mintSyscoin->nTxHash.GetHex());
+        return false;
+    }
+    return true;
+}
+bool CMintProofCheck::operator()() const {
+    std::string strError;
+    return Verify(strError);
+}
 bool CheckSyscoinMintInternal(
     const CMintSyscoin &mintSyscoin,
     TxValidationState &state,
@@ -26,12 +91,13 @@ bool CheckSyscoinMintInternal(
     NEVMMintTxSet &setMintTxs,
     uint64_t &nAssetFromLog,
     CAmount &outputAmount,
-    std::string &witnessAddress) {
+    std::string &witnessAddress,
+    const bool fVerifyProofs,
+    const bool fCheckMinted) {
     NEVMTxRoot txRootDB;
     if (!pnevmtxrootsdb || !pnevmtxrootsdb->ReadTxRoots(mintSyscoin.nBlockHash, txRootDB)) {
         return FormatSyscoinErrorMessage(state, "mint-txroot-missing", fJustCheck);
     }
-    const dev::RLP rlpReceiptParentNodes(&mintSyscoin.vchReceiptParentNodes);
     const dev::RLP rlpReceiptValue(
         dev::bytesConstRef(
             mintSyscoin.vchReceiptParentNodes.data() + mintSyscoin.posReceipt,
@@ -64,13 +130,13 @@ bool CheckSyscoinMintInternal(
             continue;
         }
         const dev::Address addressLog = rlpLog[0].toHash<dev::Address>(dev::RLP::VeryStrict);
-        if (addressLog.asBytes() != vchManagerAddress) {
+        if (vchManagerAddress.size() != addressLog.size || memcmp(addressLog.data(), vchManagerAddress.data(), addressLog.size) != 0) {
             continue;
         }
 
         // Assuming rlpLog is the current event log
         const dev::RLP& rlpLogTopics = rlpLog[1];
-        if (rlpLogTopics[0].toBytes(dev::RLP::VeryStrict) != vchFreezeTopic) {
+        if (!rlpLogTopics[0].toBytesConstRef(dev::RLP::VeryStrict).contentsEqual(vchFreezeTopic)) {
             continue;
         }
         // Verify topics count
@@ -79,20 +145,18 @@ bool CheckSyscoinMintInternal(
         }
 
         // Parse indexed asset guid from topics:
-        dev::bytes vchAssetGuid = rlpLogTopics[1].toBytes(dev::RLP::VeryStrict);
+        const dev::bytesConstRef vchAssetGuid = rlpLogTopics[1].toBytesConstRef(dev::RLP::VeryStrict);
         // Take the last 8 bytes (assuming assetGuid fits in 64 bits), 24 because all topics are 32 bytes
         nAssetFromLog = ReadBE64(vchAssetGuid.data() + 24);
 
         // Now parse non-indexed parameters from data:
-        dev::bytes dataValue = rlpLog[2].toBytes(dev::RLP::VeryStrict);
+        const dev::bytesConstRef dataValue = rlpLog[2].toBytesConstRef(dev::RLP::VeryStrict);
         if (dataValue.size() < 96) {
             return FormatSyscoinErrorMessage(state, "mint-log-data-too-small", fJustCheck);
         }
 
         // satoshiValue (big-endian)
-        std::vector<unsigned char> vchValue(dataValue.data(), dataValue.data() + 32);
-        std::reverse(vchValue.begin(), vchValue.end());
-        const arith_uint256 valueArith = UintToArith256(uint256(vchValue));
+        const arith_uint256 valueArith = UintToArith256(ReadBE256(dataValue.data()));
         if (valueArith > nMax) {
             return FormatSyscoinErrorMessage(state, "mint-value-overflow", fJustCheck);
         }
@@ -102,20 +166,13 @@ bool CheckSyscoinMintInternal(
         }
 
         // offset to string (big-endian)
-        std::vector<unsigned char> vchOffset(dataValue.data() + 32, dataValue.data() + 64);
-        std::reverse(vchOffset.begin(), vchOffset.end());
-        const uint64_t offsetToString = UintToArith256(uint256(vchOffset)).GetLow64();
+        const uint64_t offsetToString = UintToArith256(ReadBE256(dataValue.data() + 32)).GetLow64();
 
         // string length (big-endian)
         if (offsetToString + 32 > dataValue.size()) {
             return FormatSyscoinErrorMessage(state, "mint-log-invalid-string-offset", fJustCheck);
         }
-        std::vector<unsigned char> vchLenString(
-            dataValue.data() + offsetToString,
-            dataValue.data() + offsetToString + 32
-        );
-        std::reverse(vchLenString.begin(), vchLenString.end());
-        const uint64_t lenString = UintToArith256(uint256(vchLenString)).GetLow64();
+        const uint64_t lenString = UintToArith256(ReadBE256(dataValue.data() + offsetToString)).GetLow64();
 
         // Parse the string
         if (offsetToString + 32 + lenString > dataValue.size()) {
@@ -139,11 +196,6 @@ bool CheckSyscoinMintInternal(
         return FormatSyscoinErrorMessage(state, "mint-missing-freeze-log", fJustCheck);
     }
     // check transaction spv proofs
-    dev::RLPStream sTxRoot, sReceiptRoot;
-    sTxRoot.append(dev::bytesConstRef(mintSyscoin.nTxRoot.data(), mintSyscoin.nTxRoot.size()));
-    sReceiptRoot.append(dev::bytesConstRef(mintSyscoin.nReceiptRoot.data(), mintSyscoin.nReceiptRoot.size()));
-    const dev::RLP rlpTxRoot(sTxRoot.out());
-    const dev::RLP rlpReceiptRoot(sReceiptRoot.out());
     if(mintSyscoin.nTxRoot != txRootDB.nTxRoot){
         return FormatSyscoinErrorMessage(state, "mint-mismatching-txroot", fJustCheck);
     }
@@ -152,27 +204,21 @@ bool CheckSyscoinMintInternal(
     }
     
     
-    const dev::RLP rlpTxParentNodes(&mintSyscoin.vchTxParentNodes);
     const dev::bytesConstRef vchTxValueRef(
         mintSyscoin.vchTxParentNodes.data() + mintSyscoin.posTx,
         mintSyscoin.vchTxParentNodes.size() - mintSyscoin.posTx
     );
     const dev::h256 txHash = dev::sha3(vchTxValueRef);
-    std::vector<unsigned char> vchTxHash(txHash.asBytes());
-    // we must reverse the endian-ness because we store uint256 in BE but Eth uses LE.
-    std::reverse(vchTxHash.begin(), vchTxHash.end());
+    // nTxHash holds the Eth hash bytes in their original order (it is displayed reversed like every uint256)
     // validate mintSyscoin.nTxHash is the hash of vchTxValue, this is not the TXID which would require deserializataion of the transaction object, for our purpose we only need
     // uniqueness per transaction that is immutable and we do not care specifically for the txid but only that the hash cannot be reproduced for double-spend
-    if(uint256S(HexStr(vchTxHash)) != mintSyscoin.nTxHash) {
+    if(memcmp(txHash.data(), mintSyscoin.nTxHash.begin(), 32) != 0) {
         return FormatSyscoinErrorMessage(state, "mint-verify-tx-hash", fJustCheck);
     }
-    dev::RLP rlpTxValue(vchTxValueRef);
-    
-    // Create a bytesConstRef for the path to avoid passing a pointer
-    dev::bytesConstRef vchTxPathRef(mintSyscoin.vchTxPath.data(), mintSyscoin.vchTxPath.size());
+    const dev::RLP rlpTxValue(vchTxValueRef);
     
     // ensure eth tx not already spent in a previous block
-    if(pnevmtxmintdb->ExistsTx(mintSyscoin.nTxHash)) {
+    if(fCheckMinted && pnevmtxmintdb->ExistsTx(mintSyscoin.nTxHash)) {
         return FormatSyscoinErrorMessage(state, "mint-exists", fJustCheck);
     } 
     // sanity check is set in mempool during m_test_accept and when miner validates block
@@ -190,13 +236,12 @@ bool CheckSyscoinMintInternal(
         }
     }
     
-    // verify receipt proof
-    if(!VerifyProof(vchTxPathRef, rlpReceiptValue, rlpReceiptParentNodes, rlpReceiptRoot)) {
-        return FormatSyscoinErrorMessage(state, "mint-verify-receipt-proof", fJustCheck);
-    }
-    // verify transaction proof
-    if(!VerifyProof(vchTxPathRef, rlpTxValue, rlpTxParentNodes, rlpTxRoot)) {
-        return FormatSyscoinErrorMessage(state, "mint-verify-tx-proof", fJustCheck);
+    // when deferred the caller queues a CMintProofCheck instead, nothing below depends on the proofs
+    if (fVerifyProofs) {
+        std::string strError;
+        if(!VerifyMintProofs(mintSyscoin, strError)) {
+            return FormatSyscoinErrorMessage(state, strError, fJustCheck);
+        }
     }
     if (!rlpTxValue.isList()) {
         return FormatSyscoinErrorMessage(state, "mint-tx-rlp-list", fJustCheck);
@@ -224,13 +269,12 @@ bool CheckSyscoinMintInternal(
         return FormatSyscoinErrorMessage(state, "mint-invalid-chainid", fJustCheck);
     }
     const size_t toFieldIndex = (txItemCount == 9) ? 3 : 5;
-    dev::bytes vchAddress = rlpTxValue[toFieldIndex].toBytes(dev::RLP::VeryStrict);
+    const dev::bytesConstRef vchAddress = rlpTxValue[toFieldIndex].toBytesConstRef(dev::RLP::VeryStrict);
     if (vchAddress.size() != 20) {
         return FormatSyscoinErrorMessage(state, "mint-invalid-address-length", fJustCheck);
     }
-    const dev::Address address160(vchAddress);
     // Verify "to" address is vault
-    if (Params().GetConsensus().vchSyscoinVaultManager != address160.asBytes()) {
+    if (!vchAddress.contentsEqual(vchManagerAddress)) {
         return FormatSyscoinErrorMessage(state, "mint-invalid-contract-manager", fJustCheck);
     }
     
@@ -244,20 +288,26 @@ bool CheckSyscoinMint(
     const bool &fJustCheck,
     NEVMMintTxSet &setMintTxs,
     CAssetsMap &mapAssetIn,
-    CAssetsMap &mapAssetOut
+    CAssetsMap &mapAssetOut,
+    std::vector<CMintProofCheck>* pvChecks,
+    const bool fCheckMinted
 ) {
     LogPrint(BCLog::SYS,"*** ASSET MINT blockHeight=%d tx=%s %s\n",
             nHeight, txHash.ToString(), fJustCheck ? "JUSTCHECK" : "BLOCK");
-    const CMintSyscoin mintSyscoin(tx);
-    if (mintSyscoin.IsNull()) {
+    const auto& mintSyscoinPtr = tx.GetMintSyscoin();
+    if (!mintSyscoinPtr || mintSyscoinPtr->IsNull()) {
         return FormatSyscoinErrorMessage(state, "mint-unserialize-failed", fJustCheck);
     }
+    const CMintSyscoin &mintSyscoin = *mintSyscoinPtr;
     std::string witnessAddress;
     uint64_t nAssetFromLog;
     CAmount outputAmount;
-    if(!CheckSyscoinMintInternal(mintSyscoin, state, fJustCheck, setMintTxs, nAssetFromLog, outputAmount, witnessAddress)) {
+    if(!CheckSyscoinMintInternal(mintSyscoin, state, fJustCheck, setMintTxs, nAssetFromLog, outputAmount, witnessAddress, pvChecks == nullptr, fCheckMinted)) {
         return false; // state filled in by CheckSyscoinMintInternal
     }
+    if (pvChecks) {
+        pvChecks->emplace_back(mintSyscoinPtr);
+    }
     bool bFoundDest = false;
     for (const auto &vout : tx.vout) {
         if (vout.scriptPubKey.IsUnspendable()) {
@@ -319,16 +369,16 @@ bool CheckSyscoinMint(
 }
 
 bool DisconnectMintAsset(const CTransaction &tx, NEVMMintTxSet &setMintTxs){
-    CMintSyscoin mintSyscoin(tx);
-    if(mintSyscoin.IsNull()) {
+    const auto& mintSyscoin = tx.GetMintSyscoin();
+    if(!mintSyscoin || mintSyscoin->IsNull()) {
         LogPrint(BCLog::SYS,"DisconnectMintAsset: Cannot unserialize data inside of this transaction relating to an assetallocationmint\n");
         return false;
     }
-    setMintTxs.insert(mintSyscoin.nTxHash);
+    setMintTxs.insert(mintSyscoin->nTxHash);
     return true;
 }
 
-bool CheckSyscoinInputs(const Consensus::Params& params, const CTransaction& tx, const uint256& txHash, TxValidationState& state, const uint32_t &nHeight, const bool &fJustCheck, NEVMMintTxSet &setMintTxs, CAssetsMap& mapAssetIn, CAssetsMap& mapAssetOut) {
+bool CheckSyscoinInputs(const Consensus::Params& params, const CTransaction& tx, const uint256& txHash, TxValidationState& state, const uint32_t &nHeight, const bool &fJustCheck, NEVMMintTxSet &setMintTxs, CAssetsMap& mapAssetIn, CAssetsMap& mapAssetOut, std::vector<CMintProofCheck>* pvChecks, const bool fCheckMinted) {
     bool good = true;
     if(nHeight < (uint32_t)params.nNexusStartBlock)
         return !tx.HasAssets();
@@ -336,7 +386,7 @@ bool CheckSyscoinInputs(const Consensus::Params& params, const CTransaction& tx,
         return false;
     try{
         if(IsSyscoinMintTx(tx.nVersion)) {
-            good = CheckSyscoinMint(tx, txHash, state, nHeight, fJustCheck, setMintTxs, mapAssetIn, mapAssetOut);
+            good = CheckSyscoinMint(tx, txHash, state, nHeight, fJustCheck, setMintTxs, mapAssetIn, mapAssetOut, pvChecks, fCheckMinted);
         }
         else if (IsAssetAllocationTx(tx.nVersion)) {
             good = CheckAssetAllocationInputs(tx, txHash, state, nHeight, fJustCheck, mapAssetIn, mapAssetOut);
@@ -438,6 +488,7 @@ void CNEVMTxRootsDB::FlushDataToCache(const NEVMTxRootMap &mapNEVMTxRoots) {
         if (!result.second) {
             result.first->second = entry.second;
         }
+        lruReadCache.erase(entry.first);
     }
 }
 bool CNEVMTxRootsDB::FlushCacheToDisk(std::size_t CHUNK_ITEMS)
@@ -480,8 +531,34 @@ bool CNEVMTxRootsDB::ReadTxRoots(const uint256& nBlockHash, NEVMTxRoot& txRoot)
         txRoot = it->second;
         return true;
     }
-    return Read(nBlockHash, txRoot);
+    if (lruReadCache.get(nBlockHash, txRoot)) {
+        return true;
+    }
+    if (!Read(nBlockHash, txRoot)) {
+        return false;
+    }
+    lruReadCache.insert(nBlockHash, txRoot);
+    return true;
 } 
+void CNEVMTxRootsDB::PrefetchTxRoots(const std::vector<uint256>& vecBlockHashes) {
+    LOCK(cs_cache);
+    std::vector<uint256> vecMissing;
+    for (const auto& hash : vecBlockHashes) {
+        if (mapCache.find(hash) == mapCache.end() && !lruReadCache.exists(hash)) {
+            vecMissing.emplace_back(hash);
+        }
+    }
+    if (vecMissing.empty()) {
+        return;
+    }
+    std::vector<std::optional<NEVMTxRoot>> vecRoots;
+    ReadMany(vecMissing, vecRoots);
+    for (size_t i = 0; i < vecMissing.size(); i++) {
+        if (vecRoots[i]) {
+            lruReadCache.insert(vecMissing[i], *vecRoots[i]);
+        }
+    }
+}
 bool CNEVMTxRootsDB::FlushErase(const std::vector<uint256> &vecBlockHashes) {
     LOCK(cs_cache);
     if(vecBlockHashes.empty())
@@ -489,6 +566,7 @@ bool CNEVMTxRootsDB::FlushErase(const std::vector<uint256> &vecBlockHashes) {
     CDBBatch batch(*this);
     for (const auto& hash: vecBlockHashes) {
         batch.Erase(hash);
+        lruReadCache.erase(hash);
         auto it = mapCache.find(hash);
         if (it != mapCache.end()) {
             mapCache.erase(hash);
@@ -498,11 +576,45 @@ bool CNEVMTxRootsDB::FlushErase(const std::vector<uint256> &vecBlockHashes) {
         LogPrint(BCLog::SYS, "Flushing, erasing %d nevm tx roots\n", vecBlockHashes.size());
     return WriteBatch(batch, true);
 }
+CNEVMMintedTxDB::CNEVMMintedTxDB(const DBParams& params) : CDBWrapper(params) {
+    LOCK(cs_cache);
+    RebuildFilter();
+}
+void CNEVMMintedTxDB::RebuildFilter() {
+    AssertLockHeld(cs_cache);
+    std::vector<uint256> vecTxHashes(mapCache.begin(), mapCache.end());
+    std::unique_ptr<CDBIterator> pcursor(NewIterator());
+    pcursor->SeekToFirst();
+    uint256 key;
+    while (pcursor->Valid()) {
+        if (pcursor->GetKey(key)) {
+            vecTxHashes.emplace_back(key);
+        }
+        pcursor->Next();
+    }
+    // room to grow before the next rebuild
+    nFilterCapacity = std::max<unsigned int>(NEVM_MINT_FILTER_MIN_ELEMENTS, vecTxHashes.size() * 2);
+    mintFilter = std::make_unique<CRollingBloomFilter>(nFilterCapacity, 0.0001);
+    for (const auto& txHash : vecTxHashes) {
+        mintFilter->insert(txHash);
+    }
+    nFilterInserted = vecTxHashes.size();
+    LogPrint(BCLog::SYS, "Built NEVM minted tx filter, %zu entries, capacity %u\n", vecTxHashes.size(), nFilterCapacity);
+}
 void CNEVMMintedTxDB::FlushDataToCache(const NEVMMintTxSet &mapNEVMTxRoots) {
     LOCK(cs_cache);
     for (auto const& key : mapNEVMTxRoots) {
         mapCache.insert(key);
+        lruExistsCache.erase(key);
     }
+    if (nFilterInserted + mapNEVMTxRoots.size() >= nFilterCapacity) {
+        RebuildFilter();
+        return;
+    }
+    for (auto const& key : mapNEVMTxRoots) {
+        mintFilter->insert(key);
+    }
+    nFilterInserted += mapNEVMTxRoots.size();
 }
 bool CNEVMMintedTxDB::FlushCacheToDisk(std::size_t CHUNK_ITEMS)
 {
@@ -544,18 +656,48 @@ bool CNEVMMintedTxDB::FlushErase(const NEVMMintTxSet &mapNEVMTxRoots) {
     CDBBatch batch(*this);
     for (const auto &key : mapNEVMTxRoots) {
         batch.Erase(key);
+        lruExistsCache.erase(key);
         auto it = mapCache.find(key);
         if(it != mapCache.end()){
             mapCache.erase(it);
         }
     }
+    // erased hashes stay in mintFilter, a false positive there only costs a disk lookup
     if(mapNEVMTxRoots.size() > 0)
         LogPrint(BCLog::SYS, "Flushing, erasing %d nevm tx mints\n", mapNEVMTxRoots.size());
     return WriteBatch(batch, true);
 }
 bool CNEVMMintedTxDB::ExistsTx(const uint256& nTxHash) {
     LOCK(cs_cache);
-    return (mapCache.find(nTxHash) != mapCache.end()) || Exists(nTxHash);
+    if (!mintFilter->contains(nTxHash)) {
+        return false;
+    }
+    if (mapCache.find(nTxHash) != mapCache.end()) {
+        return true;
+    }
+    bool fExists;
+    if (lruExistsCache.get(nTxHash, fExists)) {
+        return fExists;
+    }
+    fExists = Exists(nTxHash);
+    lruExistsCache.insert(nTxHash, fExists);
+    return fExists;
+}
+void CNEVMMintedTxDB::PrefetchTxs(const std::vector<uint256>& vecTxHashes) {
+    LOCK(cs_cache);
+    std::vector<uint256> vecMissing;
+    for (const auto& txHash : vecTxHashes) {
+        if (mintFilter->contains(txHash) && mapCache.find(txHash) == mapCache.end() && !lruExistsCache.exists(txHash)) {
+            vecMissing.emplace_back(txHash);
+        }
+    }
+    if (vecMissing.empty()) {
+        return;
+    }
+    const std::vector<bool> vecExists = ExistsMany(vecMissing);
+    for (size_t i = 0; i < vecMissing.size(); i++) {
+        lruExistsCache.insert(vecMissing[i], vecExists[i]);
+    }
 }
 std::string stringFromSyscoinTx(const int &nVersion) {
     switch (nVersion) {
@@ -5,33 +5,71 @@
 #ifndef SYSCOIN_SERVICES_ASSETCONSENSUS_H
 #define SYSCOIN_SERVICES_ASSETCONSENSUS_H
 #include <primitives/transaction.h>
+#include <common/bloom.h>
 #include <dbwrapper.h>
 #include <consensus/params.h>
 #include <util/hasher.h>
 #include <sync.h>
+#include <unordered_lru_cache.h>
 class TxValidationState;
 class CTxUndo;
 class CBlock;
+// NEVM blocks whose roots are kept in memory after being read from disk
+static constexpr size_t NEVM_TXROOTS_READ_CACHE_SIZE{1000};
 class CNEVMTxRootsDB : public CDBWrapper {
     NEVMTxRootMap mapCache;
+    // roots read back from disk, bridge bursts mint many times against the same NEVM block
+    unordered_lru_cache<uint256, NEVMTxRoot, StaticSaltedHasher, NEVM_TXROOTS_READ_CACHE_SIZE> lruReadCache GUARDED_BY(cs_cache);
     mutable Mutex cs_cache; // Mutex to protect cache operations (non-recursive for better performance)
 public:
     using CDBWrapper::CDBWrapper;
     bool FlushErase(const std::vector<uint256> &vecBlockHashes) EXCLUSIVE_LOCKS_REQUIRED(!cs_cache);
     bool ReadTxRoots(const uint256& nBlockHash, NEVMTxRoot& txRoot) EXCLUSIVE_LOCKS_REQUIRED(!cs_cache);
+    // read the roots of these NEVM blocks into the read cache in one pass, ahead of the ReadTxRoots() of a block's mints
+    void PrefetchTxRoots(const std::vector<uint256>& vecBlockHashes) EXCLUSIVE_LOCKS_REQUIRED(!cs_cache);
     bool FlushCacheToDisk(std::size_t CHUNK_ITEMS = 100000) EXCLUSIVE_LOCKS_REQUIRED(!cs_cache);
     void FlushDataToCache(const NEVMTxRootMap &mapNEVMTxRoots) EXCLUSIVE_LOCKS_REQUIRED(!cs_cache);
 };
 
+// Lower bound on the number of minted tx hashes the ExistsTx() filter is sized for
+static constexpr unsigned int NEVM_MINT_FILTER_MIN_ELEMENTS{100000};
+// minted tx hashes that passed the filter and were looked up on disk, with the result
+static constexpr size_t NEVM_MINT_READ_CACHE_SIZE{1000};
 class CNEVMMintedTxDB : public CDBWrapper {
     NEVMMintTxSet mapCache;
     mutable Mutex cs_cache; // Mutex to protect cache operations (non-recursive for better performance)
+    // every minted tx hash in mapCache or on disk so lookups of unseen hashes skip LevelDB,
+    // rebuilt before it holds nFilterCapacity insertions so the rolling filter never forgets one
+    std::unique_ptr<CRollingBloomFilter> mintFilter GUARDED_BY(cs_cache);
+    unsigned int nFilterCapacity GUARDED_BY(cs_cache){0};
+    unsigned int nFilterInserted GUARDED_BY(cs_cache){0};
+    unordered_lru_cache<uint256, bool, StaticSaltedHasher, NEVM_MINT_READ_CACHE_SIZE> lruExistsCache GUARDED_BY(cs_cache);
+    void RebuildFilter() EXCLUSIVE_LOCKS_REQUIRED(cs_cache);
 public:
-    using CDBWrapper::CDBWrapper;
+    explicit CNEVMMintedTxDB(const DBParams& params);
     bool FlushErase(const NEVMMintTxSet &setMintTxs) EXCLUSIVE_LOCKS_REQUIRED(!cs_cache);
     bool FlushCacheToDisk(std::size_t CHUNK_ITEMS = 256) EXCLUSIVE_LOCKS_REQUIRED(!cs_cache);
     void FlushDataToCache(const NEVMMintTxSet &mapNEVMTxRoots) EXCLUSIVE_LOCKS_REQUIRED(!cs_cache);
     bool ExistsTx(const uint256& nTxHash) EXCLUSIVE_LOCKS_REQUIRED(!cs_cache);
+    // look up the minted tx hashes the filter can't rule out in one pass, ahead of the ExistsTx() of a block's mints
+    void PrefetchTxs(const std::vector<uint256>& vecTxHashes) EXCLUSIVE_LOCKS_REQUIRED(!cs_cache);
+};
+
+/**
+ * Merkle Patricia proofs of a mint, verified on the check queue threads during ConnectBlock
+ * while everything that depends on chain state (roots lookup, double mint checks) stays serial.
+ */
+class CMintProofCheck
+{
+private:
+    std::shared_ptr<const CMintSyscoin> mintSyscoin;
+public:
+    CMintProofCheck() = default;
+    explicit CMintProofCheck(std::shared_ptr<const CMintSyscoin> mintSyscoinIn) :
+        mintSyscoin(std::move(mintSyscoinIn)) { }
+    bool operator()() const;
+    /** Verify the proofs, strError is set to the reject reason of the inline path on failure */
+    bool Verify(std::string &strError) const;
 };
 
 extern std::unique_ptr<CNEVMTxRootsDB> pnevmtxrootsdb;
@@ -44,14 +82,18 @@ bool CheckSyscoinMint(const CTransaction& tx,
     const bool &fJustCheck, 
     NEVMMintTxSet &setMintTxs, 
     CAssetsMap &mapAssetIn, 
-    CAssetsMap &mapAssetOut);
+    CAssetsMap &mapAssetOut,
+    std::vector<CMintProofCheck>* pvChecks = nullptr,
+    const bool fCheckMinted = true);
 bool CheckSyscoinMintInternal(const CMintSyscoin &mintSyscoin,
     TxValidationState &state,
     const bool &fJustCheck,
     NEVMMintTxSet &setMintTxs,
     uint64_t &nAssetFromLog,
     CAmount &outputAmount,
-    std::string &witnessAddress);
+    std::string &witnessAddress,
+    const bool fVerifyProofs = true,
+    const bool fCheckMinted = true);
 bool CheckSyscoinInputs(const Consensus::Params& params, 
     const CTransaction& tx, 
     const uint256& txHash, 
@@ -60,7 +102,9 @@ bool CheckSyscoinInputs(const Consensus::Params& params,
     const bool &fJustCheck, 
     NEVMMintTxSet &setMintTxs, 
     CAssetsMap& mapAssetIn, 
-    CAssetsMap& mapAssetOut);
+    CAssetsMap& mapAssetOut,
+    std::vector<CMintProofCheck>* pvChecks = nullptr,
+    const bool fCheckMinted = true);
 bool CheckAssetAllocationInputs(const CTransaction &tx, 
     const uint256& txHash, 
     TxValidationState &tstate, 
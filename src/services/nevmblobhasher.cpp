@@ -0,0 +1,169 @@
+// Copyright (c) 2024 The Syscoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <services/nevmblobhasher.h>
+
+#include <nevm/sha3.h>
+#include <primitives/block.h>
+#include <util/thread.h>
+
+#include <algorithm>
+
+std::unique_ptr<NEVMBlobHasher> g_nevm_blob_hasher;
+
+/** The PoDA payload of a data transaction, from the same output CNEVMData reads it from, nullptr if it was relayed without one */
+static const std::vector<uint8_t>* GetBlob(const CTransaction& tx)
+{
+    const int nOut = GetSyscoinDataOutput(tx);
+    if (nOut < 0 || !tx.vout[nOut].HasNEVMData()) return nullptr;
+    return tx.vout[nOut].vchNEVMData.get();
+}
+
+NEVMBlobHasher::~NEVMBlobHasher()
+{
+    Stop();
+}
+
+void NEVMBlobHasher::Start()
+{
+    assert(!m_thread.joinable());
+    m_thread = std::thread(&util::TraceThread, "nevmhash", [this] { ThreadHash(); });
+}
+
+void NEVMBlobHasher::Stop()
+{
+    {
+        LOCK(m_mutex);
+        m_stop = true;
+        m_queue.clear();
+    }
+    m_cv.notify_all();
+    if (m_thread.joinable()) m_thread.join();
+}
+
+void NEVMBlobHasher::SubmitLocked(const CTransactionRef& tx)
+{
+    AssertLockHeld(m_mutex);
+    if (m_stop || !tx->IsNEVMData() || !GetBlob(*tx)) return;
+    if (!m_entries.try_emplace(tx.get(), Entry{.tx = tx, .vchDigest = {}, .fDone = false}).second) return;
+    m_order.emplace_back(tx.get());
+    m_queue.emplace_back(tx.get());
+    while (m_entries.size() > MAX_NEVM_PREHASH_ENTRIES && !m_order.empty()) {
+        m_entries.erase(m_order.front());
+        m_order.pop_front();
+    }
+}
+
+void NEVMBlobHasher::Submit(const CTransactionRef& tx)
+{
+    {
+        LOCK(m_mutex);
+        SubmitLocked(tx);
+    }
+    m_cv.notify_one();
+}
+
+void NEVMBlobHasher::Submit(const CBlock& block)
+{
+    {
+        LOCK(m_mutex);
+        for (const auto& tx : block.vtx) {
+            SubmitLocked(tx);
+        }
+    }
+    m_cv.notify_one();
+}
+
+std::optional<std::vector<uint8_t>> NEVMBlobHasher::TakeDigest(const CTransaction& tx)
+{
+    LOCK(m_mutex);
+    auto it = m_entries.find(&tx);
+    if (it == m_entries.end()) return std::nullopt;
+    std::optional<std::vector<uint8_t>> digest;
+    if (it->second.fDone) {
+        digest = std::move(it->second.vchDigest);
+    }
+    // the caller hashes unfinished blobs itself, the worker result is dropped
+    m_entries.erase(it);
+    m_order.erase(std::find(m_order.begin(), m_order.end(), &tx));
+    return digest;
+}
+
+void NEVMBlobHasher::ThreadHash()
+{
+    while (true) {
+        std::vector<CTransactionRef> vecTx;
+        {
+            WAIT_LOCK(m_mutex, lock);
+            m_cv.wait(lock, [this]() EXCLUSIVE_LOCKS_REQUIRED(m_mutex) { return m_stop || !m_queue.empty(); });
+            if (m_stop) return;
+            // take as many blobs as the Keccak backend hashes interleaved
+            while (!m_queue.empty() && vecTx.size() < dev::sha3BatchWidth()) {
+                auto it = m_entries.find(m_queue.front());
+                if (it != m_entries.end() && !it->second.fDone) {
+                    vecTx.emplace_back(it->second.tx);
+                }
+                m_queue.pop_front();
+            }
+        }
+        if (vecTx.empty()) continue;
+        std::vector<dev::bytesConstRef> inputs;
+        for (const auto& tx : vecTx) {
+            const std::vector<uint8_t>* blob = GetBlob(*tx);
+            inputs.emplace_back(blob->data(), blob->size());
+        }
+        std::vector<dev::h256> hashes(vecTx.size());
+        dev::sha3Batch(inputs.data(), hashes.data(), inputs.size());
+        LOCK(m_mutex);
+        for (size_t i = 0; i < vecTx.size(); i++) {
+            auto it = m_entries.find(vecTx[i].get());
+            if (it != m_entries.end() && it->second.tx == vecTx[i]) {
+                it->second.vchDigest = hashes[i].asBytes();
+                it->second.fDone = true;
+            }
+        }
+    }
+}
+
+/** Version hashes are 32 byte Keccak digests, anything else can't have been verified */
+static std::optional<uint256> VersionHashKey(const std::vector<uint8_t>& vchVersionHash)
+{
+    if (vchVersionHash.size() != uint256::size()) return std::nullopt;
+    return uint256(vchVersionHash);
+}
+
+void NEVMBlobVerificationCache::Add(const std::vector<uint8_t>& vchVersionHash, const std::shared_ptr<const std::vector<uint8_t>>& blob)
+{
+    const auto key{VersionHashKey(vchVersionHash)};
+    if (!key || !blob) return;
+    LOCK(m_mutex);
+    auto [it, inserted] = m_blobs.try_emplace(*key, blob);
+    if (!inserted) {
+        it->second = blob;
+        return;
+    }
+    m_order.emplace_back(*key);
+    while (m_blobs.size() > MAX_NEVM_VERIFIED_BLOBS && !m_order.empty()) {
+        m_blobs.erase(m_order.front());
+        m_order.pop_front();
+    }
+}
+
+bool NEVMBlobVerificationCache::Contains(const std::vector<uint8_t>& vchVersionHash, const std::shared_ptr<const std::vector<uint8_t>>& blob) const
+{
+    const auto key{VersionHashKey(vchVersionHash)};
+    if (!key || !blob) return false;
+    LOCK(m_mutex);
+    auto it = m_blobs.find(*key);
+    if (it == m_blobs.end()) return false;
+    // while blob is alive the checked object can only be alive at the same address if it is blob
+    const auto verified{it->second.lock()};
+    return verified && verified.get() == blob.get();
+}
+
+size_t NEVMBlobVerificationCache::Size() const
+{
+    LOCK(m_mutex);
+    return m_blobs.size();
+}
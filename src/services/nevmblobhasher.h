@@ -0,0 +1,96 @@
+// Copyright (c) 2024 The Syscoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef SYSCOIN_SERVICES_NEVMBLOBHASHER_H
+#define SYSCOIN_SERVICES_NEVMBLOBHASHER_H
+
+#include <primitives/transaction.h>
+#include <saltedhasher.h>
+#include <sync.h>
+#include <threadsafety.h>
+#include <uint256.h>
+
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <memory>
+#include <optional>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+class CBlock;
+
+/** Default for -nevmprehash */
+static constexpr bool DEFAULT_NEVM_PREHASH{true};
+/** Blobs tracked at once, bounds how much received PoDA data is pinned waiting for validation */
+static constexpr size_t MAX_NEVM_PREHASH_ENTRIES{2 * MAX_DATA_BLOBS};
+/** Verified blobs remembered at once, entries only pin a weak reference so this bounds bookkeeping only */
+static constexpr size_t MAX_NEVM_VERIFIED_BLOBS{4096};
+
+/**
+ * Hashes the PoDA blobs of transactions and blocks as soon as net_processing
+ * has deserialized them, so the Keccak digest is computed while the message is
+ * still going through the checks that run before PoDA validation instead of
+ * after them. ProcessNEVMData() picks up finished digests and only hashes the
+ * blobs that are not done yet itself. Entries keep a reference to their
+ * transaction so they are keyed by the transaction object, whose blob cannot
+ * change, rather than by txid which does not commit to the blob.
+ */
+class NEVMBlobHasher
+{
+public:
+    ~NEVMBlobHasher();
+
+    void Start();
+    void Stop() EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+    void Submit(const CTransactionRef& tx) EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+    void Submit(const CBlock& block) EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+    /** Digest of the blob carried by tx if hashing it already finished, the entry is consumed */
+    std::optional<std::vector<uint8_t>> TakeDigest(const CTransaction& tx) EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+
+private:
+    struct Entry {
+        CTransactionRef tx;
+        std::vector<uint8_t> vchDigest;
+        bool fDone{false};
+    };
+    void SubmitLocked(const CTransactionRef& tx) EXCLUSIVE_LOCKS_REQUIRED(m_mutex);
+    void ThreadHash() EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+
+    Mutex m_mutex;
+    std::condition_variable m_cv;
+    std::map<const CTransaction*, Entry> m_entries GUARDED_BY(m_mutex);
+    //! insertion order for eviction
+    std::deque<const CTransaction*> m_order GUARDED_BY(m_mutex);
+    //! entries waiting for the worker, may reference entries already taken or evicted
+    std::deque<const CTransaction*> m_queue GUARDED_BY(m_mutex);
+    bool m_stop GUARDED_BY(m_mutex){false};
+    std::thread m_thread;
+};
+extern std::unique_ptr<NEVMBlobHasher> g_nevm_blob_hasher;
+
+/**
+ * PoDA blobs whose Keccak digest was already checked against their version hash, so
+ * validation under cs_main does not hash them again. Entries are found through a salted
+ * hash of the version hash but only count for the very blob object that was checked: they
+ * hold a weak reference to it and a hit requires the transaction to still share that
+ * object. A different blob relayed under the same version hash (the txid does not commit
+ * to the blob) therefore never matches, and a freed blob can't be mistaken for a new one.
+ */
+class NEVMBlobVerificationCache
+{
+public:
+    void Add(const std::vector<uint8_t>& vchVersionHash, const std::shared_ptr<const std::vector<uint8_t>>& blob) EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+    bool Contains(const std::vector<uint8_t>& vchVersionHash, const std::shared_ptr<const std::vector<uint8_t>>& blob) const EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+    size_t Size() const EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+
+private:
+    mutable Mutex m_mutex;
+    std::unordered_map<uint256, std::weak_ptr<const std::vector<uint8_t>>, StaticSaltedHasher> m_blobs GUARDED_BY(m_mutex);
+    //! insertion order for eviction
+    std::deque<uint256> m_order GUARDED_BY(m_mutex);
+};
+
+#endif // SYSCOIN_SERVICES_NEVMBLOBHASHER_H
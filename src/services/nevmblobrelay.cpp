@@ -0,0 +1,218 @@
+// Copyright (c) 2024 The Syscoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <services/nevmblobrelay.h>
+
+#include <hash.h>
+#include <nevm/sha3.h>
+
+#include <algorithm>
+
+uint256 NEVMBlobChunkId(const CNEVMBlobChunkRequest& req)
+{
+    return (HashWriter{} << req).GetHash();
+}
+
+std::optional<std::vector<uint8_t>> MissingNEVMData(const CTransaction& tx)
+{
+    if (!tx.IsNEVMData()) return std::nullopt;
+    const int nOut = GetSyscoinDataOutput(tx);
+    if (nOut == -1 || tx.vout[nOut].HasNEVMData()) return std::nullopt;
+    const CNEVMData nevmData(tx.vout[nOut].scriptPubKey);
+    if (nevmData.IsNull()) return std::nullopt;
+    return nevmData.vchVersionHash;
+}
+
+CTransactionRef StripNEVMData(const CTransactionRef& tx)
+{
+    if (!tx->IsNEVMData()) return tx;
+    const int nOut = GetSyscoinDataOutput(*tx);
+    if (nOut == -1 || !tx->vout[nOut].HasNEVMData()) return tx;
+    CMutableTransaction mtx(*tx);
+    mtx.vout[nOut].vchNEVMData.reset();
+    return MakeTransactionRef(std::move(mtx));
+}
+
+CTransactionRef AttachNEVMData(const CTransactionRef& tx, const std::shared_ptr<const std::vector<uint8_t>>& data)
+{
+    const int nOut = GetSyscoinDataOutput(*tx);
+    if (nOut == -1) return tx;
+    CMutableTransaction mtx(*tx);
+    mtx.vout[nOut].vchNEVMData = data;
+    return MakeTransactionRef(std::move(mtx));
+}
+
+uint64_t GetNEVMDataSize(const std::vector<CTransactionRef>& vtx)
+{
+    uint64_t nSize{0};
+    for (const auto& tx : vtx) {
+        if (!tx->IsNEVMData()) continue;
+        const int nOut = GetSyscoinDataOutput(*tx);
+        if (nOut != -1) nSize += tx->vout[nOut].GetNEVMData().size();
+    }
+    return nSize;
+}
+
+// optional blobs must expire before a chainlocked peer whose clock is ahead of ours rejects blocks carrying them
+static_assert(NEVM_DATA_EXPIRE_TIME <= NEVM_DATA_ENFORCE_TIME_NOT_HAVE_DATA - NEVM_DATA_SERVE_GRACE);
+
+NEVMDataServe GetNEVMDataServe(int64_t nMedianTime, int64_t nTimeNow)
+{
+    if (nMedianTime >= nTimeNow - NEVM_DATA_ENFORCE_TIME_HAVE_DATA - NEVM_DATA_SERVE_GRACE) return NEVMDataServe::REQUIRED;
+    if (nMedianTime < nTimeNow - NEVM_DATA_EXPIRE_TIME) return NEVMDataServe::EXPIRED;
+    return NEVMDataServe::OPTIONAL;
+}
+
+void NEVMBlobAssembler::AddRequest(const std::vector<uint8_t>& vchVersionHash, PendingBlob& blob, uint32_t nChunk, std::vector<CNEVMBlobChunkRequest>& vRequests)
+{
+    CNEVMBlobChunkRequest req{vchVersionHash, nChunk};
+    const uint256 id{NEVMBlobChunkId(req)};
+    if (!m_chunk_ids.try_emplace(id, req).second) return;
+    blob.vChunkIds.emplace_back(id);
+    vRequests.emplace_back(std::move(req));
+}
+
+bool NEVMBlobAssembler::AddBlock(const std::shared_ptr<CBlock>& block, NodeId from, std::chrono::microseconds now, std::vector<CNEVMBlobChunkRequest>& vRequests)
+{
+    const uint256 hash{block->GetHash()};
+    if (m_blocks.count(hash) || m_blocks.size() >= MAX_NEVM_BLOB_PENDING_BLOCKS) return false;
+    PendingBlock pending{block, from, now + NEVM_BLOB_FETCH_TIMEOUT, {}};
+    for (size_t i = 0; i < block->vtx.size(); i++) {
+        if (auto vchVersionHash = MissingNEVMData(*block->vtx[i])) {
+            pending.mapMissing[*vchVersionHash].emplace_back(i);
+        }
+    }
+    if (pending.mapMissing.empty() || pending.mapMissing.size() > (size_t)MAX_DATA_BLOBS) return false;
+    for (const auto& [vchVersionHash, _] : pending.mapMissing) {
+        auto [it, inserted] = m_blobs.try_emplace(vchVersionHash);
+        it->second.setBlocks.emplace(hash);
+        // the size is unknown until the first chunk arrives, the other chunks are requested then
+        if (inserted) AddRequest(vchVersionHash, it->second, 0, vRequests);
+    }
+    m_blocks.emplace(hash, std::move(pending));
+    return true;
+}
+
+NEVMBlobAssembler::ChunkResult NEVMBlobAssembler::ReceivedChunk(const CNEVMBlobChunk& chunk)
+{
+    ChunkResult result;
+    auto it = m_blobs.find(chunk.vchVersionHash);
+    // blobs that completed already or were never asked for, and peers that don't have the blob
+    if (it == m_blobs.end() || chunk.nBlobSize == 0) return result;
+    PendingBlob& blob = it->second;
+    const uint64_t nChunks{(uint64_t{chunk.nBlobSize} + NEVM_BLOB_CHUNK_SIZE - 1) / NEVM_BLOB_CHUNK_SIZE};
+    const uint64_t nOffset{uint64_t{chunk.nChunk} * NEVM_BLOB_CHUNK_SIZE};
+    if (chunk.nBlobSize > (uint32_t)MAX_NEVM_DATA_BLOB || chunk.nChunk >= nChunks ||
+        chunk.vchData.size() != std::min<uint64_t>(NEVM_BLOB_CHUNK_SIZE, chunk.nBlobSize - nOffset)) {
+        result.fInvalid = true;
+        return result;
+    }
+    if (blob.nSize == 0) {
+        blob.nSize = chunk.nBlobSize;
+        blob.vchData.resize(blob.nSize);
+        blob.vHave.assign(nChunks, false);
+        for (uint32_t i = 0; i < nChunks; i++) {
+            if (i != chunk.nChunk) AddRequest(chunk.vchVersionHash, blob, i, result.vRequests);
+        }
+    } else if (blob.nSize != chunk.nBlobSize) {
+        // can't tell which peer lied about the size, a wrong blob ends up downloading the block in full
+        return result;
+    }
+    if (blob.vHave[chunk.nChunk]) return result;
+    std::copy(chunk.vchData.begin(), chunk.vchData.end(), blob.vchData.begin() + nOffset);
+    blob.vHave[chunk.nChunk] = true;
+    if (++blob.nHave < blob.vHave.size()) return result;
+
+    const std::vector<uint8_t> vchVersionHash{chunk.vchVersionHash};
+    const std::set<uint256> setBlocks{std::move(blob.setBlocks)};
+    if (dev::sha3(blob.vchData).asBytes() != vchVersionHash) {
+        for (const uint256& hash : setBlocks) {
+            result.vFailed.emplace_back(hash, m_blocks.at(hash).from);
+            EraseBlock(hash);
+        }
+        EraseBlob(vchVersionHash);
+        return result;
+    }
+    const auto data{std::make_shared<const std::vector<uint8_t>>(std::move(blob.vchData))};
+    EraseBlob(vchVersionHash);
+    for (const uint256& hash : setBlocks) {
+        auto block_it = m_blocks.find(hash);
+        PendingBlock& pending = block_it->second;
+        for (const size_t i : pending.mapMissing.at(vchVersionHash)) {
+            pending.block->vtx[i] = AttachNEVMData(pending.block->vtx[i], data);
+        }
+        pending.mapMissing.erase(vchVersionHash);
+        if (pending.mapMissing.empty()) {
+            result.vComplete.emplace_back(pending.block, pending.from);
+            m_blocks.erase(block_it);
+        }
+    }
+    return result;
+}
+
+std::optional<CNEVMBlobChunkRequest> NEVMBlobAssembler::LookupChunk(const uint256& id) const
+{
+    auto it = m_chunk_ids.find(id);
+    if (it == m_chunk_ids.end()) return std::nullopt;
+    const PendingBlob& blob = m_blobs.at(it->second.vchVersionHash);
+    if (blob.nSize != 0 && blob.vHave[it->second.nChunk]) return std::nullopt;
+    return it->second;
+}
+
+std::vector<uint256> NEVMBlobAssembler::BlocksWaitingFor(const std::vector<uint8_t>& vchVersionHash) const
+{
+    auto it = m_blobs.find(vchVersionHash);
+    if (it == m_blobs.end()) return {};
+    return {it->second.setBlocks.begin(), it->second.setBlocks.end()};
+}
+
+std::vector<uint256> NEVMBlobAssembler::ExpireBlocks(NodeId from, std::chrono::microseconds now)
+{
+    std::vector<uint256> vExpired;
+    for (const auto& [hash, pending] : m_blocks) {
+        if (pending.from == from && pending.expiry <= now) vExpired.emplace_back(hash);
+    }
+    for (const uint256& hash : vExpired) {
+        EraseBlock(hash);
+    }
+    return vExpired;
+}
+
+void NEVMBlobAssembler::ForgetBlock(const uint256& hash)
+{
+    if (m_blocks.count(hash)) EraseBlock(hash);
+}
+
+void NEVMBlobAssembler::ForgetPeer(NodeId from)
+{
+    std::vector<uint256> vErase;
+    for (const auto& [hash, pending] : m_blocks) {
+        if (pending.from == from) vErase.emplace_back(hash);
+    }
+    for (const uint256& hash : vErase) {
+        EraseBlock(hash);
+    }
+}
+
+void NEVMBlobAssembler::EraseBlob(const std::vector<uint8_t>& vchVersionHash)
+{
+    auto it = m_blobs.find(vchVersionHash);
+    if (it == m_blobs.end()) return;
+    for (const uint256& id : it->second.vChunkIds) {
+        m_chunk_ids.erase(id);
+    }
+    m_blobs.erase(it);
+}
+
+void NEVMBlobAssembler::EraseBlock(const uint256& hash)
+{
+    auto it = m_blocks.find(hash);
+    for (const auto& [vchVersionHash, _] : it->second.mapMissing) {
+        auto blob_it = m_blobs.find(vchVersionHash);
+        if (blob_it == m_blobs.end()) continue;
+        blob_it->second.setBlocks.erase(hash);
+        if (blob_it->second.setBlocks.empty()) EraseBlob(vchVersionHash);
+    }
+    m_blocks.erase(it);
+}
@@ -0,0 +1,147 @@
+// Copyright (c) 2024 The Syscoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef SYSCOIN_SERVICES_NEVMBLOBRELAY_H
+#define SYSCOIN_SERVICES_NEVMBLOBRELAY_H
+
+#include <primitives/block.h>
+#include <primitives/transaction.h>
+#include <serialize.h>
+#include <uint256.h>
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <optional>
+#include <set>
+#include <utility>
+#include <vector>
+
+using NodeId = int64_t;
+
+/** PoDA blobs are fetched in chunks of this size, so the chunks of one blob can come from several peers */
+static constexpr uint32_t NEVM_BLOB_CHUNK_SIZE{256 * 1024};
+/** Most chunks asked for in one getblobchunk message, enough for all blobs of a block */
+static constexpr size_t MAX_NEVM_BLOB_CHUNK_REQUESTS{MAX_NEVM_DATA_BLOCK / NEVM_BLOB_CHUNK_SIZE};
+/** Blocks held back for their blobs at once, bounds the blob data pinned by unfinished downloads */
+static constexpr size_t MAX_NEVM_BLOB_PENDING_BLOCKS{4};
+/** How long a chunk request may go unanswered before the chunk is asked from another peer */
+static constexpr std::chrono::seconds NEVM_BLOB_CHUNK_TIMEOUT{2};
+/** How long a block waits for its blobs before it is downloaded in full instead */
+static constexpr std::chrono::seconds NEVM_BLOB_FETCH_TIMEOUT{10};
+/** How far the clock of a peer validating a block may be from ours when deciding it needs the PoDA blobs */
+static constexpr int64_t NEVM_DATA_SERVE_GRACE{60 * 60};
+
+/** Whether the PoDA blobs of a block or blob chunk are sent to a peer, by the median time they were confirmed at */
+enum class NEVMDataServe {
+    //! within NEVM_DATA_ENFORCE_TIME_HAVE_DATA (plus grace), peers reject blocks without them, always sent
+    REQUIRED,
+    //! peers may do without them, sent while the blob upload target is not reached
+    OPTIONAL,
+    //! past NEVM_DATA_EXPIRE_TIME, only the version hashes are sent
+    EXPIRED,
+};
+NEVMDataServe GetNEVMDataServe(int64_t nMedianTime, int64_t nTimeNow);
+
+/** One chunk of a PoDA blob asked for with getblobchunk */
+struct CNEVMBlobChunkRequest {
+    std::vector<uint8_t> vchVersionHash;
+    uint32_t nChunk{0};
+
+    SERIALIZE_METHODS(CNEVMBlobChunkRequest, obj) {
+        READWRITE(obj.vchVersionHash, obj.nChunk);
+    }
+};
+
+/** Answer to a chunk request (blobchunk), a peer that does not have the blob answers with nBlobSize 0 and no data */
+struct CNEVMBlobChunk {
+    std::vector<uint8_t> vchVersionHash;
+    uint32_t nChunk{0};
+    uint32_t nBlobSize{0};
+    std::vector<uint8_t> vchData;
+
+    SERIALIZE_METHODS(CNEVMBlobChunk, obj) {
+        READWRITE(obj.vchVersionHash, obj.nChunk, obj.nBlobSize, obj.vchData);
+    }
+};
+
+/** Id a chunk request is tracked under in TxRequestTracker */
+uint256 NEVMBlobChunkId(const CNEVMBlobChunkRequest& req);
+/** Version hash of the blob a PoDA transaction was relayed without, nullopt if it carries its blob or is no PoDA transaction */
+std::optional<std::vector<uint8_t>> MissingNEVMData(const CTransaction& tx);
+/** The transaction without its PoDA blob, as sent in blocktxn to peers that fetch blobs separately */
+CTransactionRef StripNEVMData(const CTransactionRef& tx);
+/** The transaction with data as its PoDA blob, the txid does not commit to the blob so it stays the same */
+CTransactionRef AttachNEVMData(const CTransactionRef& tx, const std::shared_ptr<const std::vector<uint8_t>>& data);
+/** Bytes of PoDA blob carried by the transactions, as counted against the blob upload target */
+uint64_t GetNEVMDataSize(const std::vector<CTransactionRef>& vtx);
+
+/**
+ * Reconstructed compact blocks whose PoDA blobs are still being downloaded. Peers that negotiated
+ * blob relay (sendblobs) answer getblocktxn with the blob transactions stripped of their blob, so the
+ * block propagates without waiting for up to MAX_NEVM_DATA_BLOCK of blob data. The blobs are then
+ * fetched in chunks, possibly from several peers, and the block is only handed to validation once
+ * every blob is complete and matches its version hash, a missing blob never gets a block marked invalid.
+ * Not thread safe, net_processing guards it with cs_main.
+ */
+class NEVMBlobAssembler
+{
+public:
+    struct ChunkResult {
+        //! the chunk contradicts itself (size, index and length don't fit), the sender is misbehaving
+        bool fInvalid{false};
+        //! chunks to request now that the size of the blob is known
+        std::vector<CNEVMBlobChunkRequest> vRequests;
+        //! blocks that have all their blobs now, with the peer they came from
+        std::vector<std::pair<std::shared_ptr<CBlock>, NodeId>> vComplete;
+        //! blocks to download in full because an assembled blob did not match its version hash
+        std::vector<std::pair<uint256, NodeId>> vFailed;
+    };
+
+    /**
+     * Hold block until the blobs missing from its PoDA transactions arrived. The chunks to
+     * request are added to vRequests. Returns false if the block is not held, because it
+     * misses no blob, misses more than MAX_DATA_BLOBS or too many blocks are held already.
+     */
+    bool AddBlock(const std::shared_ptr<CBlock>& block, NodeId from, std::chrono::microseconds now, std::vector<CNEVMBlobChunkRequest>& vRequests);
+    ChunkResult ReceivedChunk(const CNEVMBlobChunk& chunk);
+    /** Chunk a tracker id stands for, nullopt once it is not needed anymore */
+    std::optional<CNEVMBlobChunkRequest> LookupChunk(const uint256& id) const;
+    /** Hashes of the blocks waiting for a blob */
+    std::vector<uint256> BlocksWaitingFor(const std::vector<uint8_t>& vchVersionHash) const;
+    /** Drop the blocks from peer that waited longer than NEVM_BLOB_FETCH_TIMEOUT and return their hashes */
+    std::vector<uint256> ExpireBlocks(NodeId from, std::chrono::microseconds now);
+    void ForgetBlock(const uint256& hash);
+    void ForgetPeer(NodeId from);
+    bool HaveBlock(const uint256& hash) const { return m_blocks.count(hash) > 0; }
+    size_t Size() const { return m_blocks.size(); }
+
+private:
+    struct PendingBlock {
+        std::shared_ptr<CBlock> block;
+        NodeId from;
+        std::chrono::microseconds expiry;
+        //! missing blobs with the indexes of the transactions that carry them
+        std::map<std::vector<uint8_t>, std::vector<size_t>> mapMissing;
+    };
+    struct PendingBlob {
+        //! 0 until the first chunk told the size
+        uint32_t nSize{0};
+        std::vector<uint8_t> vchData;
+        std::vector<bool> vHave;
+        size_t nHave{0};
+        std::set<uint256> setBlocks;
+        std::vector<uint256> vChunkIds;
+    };
+    void AddRequest(const std::vector<uint8_t>& vchVersionHash, PendingBlob& blob, uint32_t nChunk, std::vector<CNEVMBlobChunkRequest>& vRequests);
+    void EraseBlob(const std::vector<uint8_t>& vchVersionHash);
+    void EraseBlock(const uint256& hash);
+
+    std::map<uint256, PendingBlock> m_blocks;
+    std::map<std::vector<uint8_t>, PendingBlob> m_blobs;
+    std::map<uint256, CNEVMBlobChunkRequest> m_chunk_ids;
+};
+
+#endif // SYSCOIN_SERVICES_NEVMBLOBRELAY_H
@@ -11,12 +11,44 @@
 #include <nevm/sha3.h>
 #include <messagesigner.h>
 #include <logging.h>
+#include <memusage.h>
 #include <util/rbf.h>
 #include <undo.h>
 #include <validationinterface.h>
 #include <timedata.h>
 #include <key_io.h>
 #include <logging.h>
+#include <util/fs_helpers.h>
+#ifndef WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+static constexpr uint8_t DB_BLOB_LOCATION{'l'};
+static constexpr uint8_t DB_BLOB_SEGMENT{'s'};
+// segment files are preallocated in chunks and rolled over at this size
+static constexpr size_t BLOB_SEGMENT_CHUNK_SIZE{0x1000000}; // 16 MiB
+static constexpr uint32_t MAX_BLOB_SEGMENT_SIZE{0x10000000}; // 256 MiB
+// a segment only collects blobs for this long so whole segments expire soon after their blobs
+static constexpr int64_t BLOB_SEGMENT_TIME_SPAN{NEVM_DATA_EXPIRE_TIME / 6};
+// nevm data db keys are serialized version hashes, these prefixes cannot collide with them
+static constexpr uint8_t DB_NEVM_EXPIRY{'e'};
+static constexpr uint8_t DB_NEVM_EXPIRY_INDEXED{'E'};
+
+/** Secondary (median time, version hash) key, big endian time so LevelDB keeps it time ordered */
+struct DBExpiryKey {
+    uint8_t prefix{DB_NEVM_EXPIRY};
+    uint64_t nMedianTime{0};
+    std::vector<uint8_t> vchVersionHash;
+
+    DBExpiryKey() = default;
+    DBExpiryKey(const int64_t nMedianTimeIn, const std::vector<uint8_t>& vchVersionHashIn) : nMedianTime(std::max<int64_t>(nMedianTimeIn, 0)), vchVersionHash(vchVersionHashIn) {}
+
+    SERIALIZE_METHODS(DBExpiryKey, obj) {
+        READWRITE(obj.prefix, Using<BigEndianFormatter<8>>(obj.nMedianTime), obj.vchVersionHash);
+    }
+};
 std::unique_ptr<CBlockIndexDB> pblockindexdb;
 std::unique_ptr<CNEVMDataDB> pnevmdatadb;
 std::unique_ptr<CNEVMDataBlobDB> pnevmdatablobdb;
@@ -34,27 +66,37 @@ bool DisconnectSyscoinTransaction(const CTransaction& tx, NEVMMintTxSet &setMint
 }
 
 void CNEVMDataDB::FlushDataToCache(const PoDAMAPMemory &mapPoDA) {
-    LOCK(cs_cache);
     if(mapPoDA.empty()) {
         return;
     }
-    CDBBatch batchblob(*pnevmdatablobdb);  
-    for (auto const& [key, val] : mapPoDA) {
-        if(!val.vchNEVMData) {
-            continue;
-        }
-        auto inserted = mapCache.try_emplace(key, val.txid, val.nSize, val.nMedianTime);
-        // for duplicate blobs, allow to update txid/mediantime
-        if(!inserted.second) {
-            inserted.first->second.nMedianTime = val.nMedianTime;
-            inserted.first->second.txid = val.txid;
+    // SYSCOIN blobs seen for the first time, announced once they are stored
+    std::vector<PoDAMAPMemory::const_iterator> vecAdded;
+    {
+        LOCK(cs_cache);
+        CDBBatch batchblob(*pnevmdatablobdb);
+        for (auto it = mapPoDA.begin(); it != mapPoDA.end(); ++it) {
+            const auto& [key, val] = *it;
+            if(!val.vchNEVMData) {
+                continue;
+            }
+            auto inserted = mapCache.try_emplace(key, val.txid, val.nSize, val.nMedianTime);
+            // for duplicate blobs, allow to update txid/mediantime
+            if(!inserted.second) {
+                inserted.first->second.nMedianTime = val.nMedianTime;
+                inserted.first->second.txid = val.txid;
+            } else {
+                vecAdded.push_back(it);
+            }
+            if(!pnevmdatablobdb->AppendBlob(batchblob, key, *val.vchNEVMData, val.nMedianTime)) {
+                LogPrintf("FlushDataToCache: could not store nevm blob %s\n", HexStr(key));
+            }
         }
-        if(!pnevmdatablobdb->Exists(key)) {
-            batchblob.Write(key, val.vchNEVMData);
+        if(batchblob.SizeEstimate() > 0) {
+            pnevmdatablobdb->CommitBlobs(batchblob);
         }
     }
-    if(batchblob.SizeEstimate() > 0) {
-        pnevmdatablobdb->WriteBatch(batchblob);
+    for (const auto& it : vecAdded) {
+        GetMainSignals().NotifyNEVMBlobAdded(it->first, it->second.txid, it->second.vchNEVMData);
     }
 }
 bool CNEVMDataDB::FlushCacheToDisk(const int64_t nMedianTime) {
@@ -76,18 +118,34 @@ bool CNEVMDataDB::FlushCacheToDisk(const int64_t nMedianTime) {
         CDBBatch batchblob(*pnevmdatablobdb);
         if (!PruneToBatch(batch, batchblob, nMedianTime)) {
             LogPrint(BCLog::SYS, "Error: Could not prune nevm blobs\n");
+            m_diskStats.reset();
             return false;
         }
         pnevmdatablobdb->WriteBatch(batchblob);
+        pnevmdatablobdb->PruneSegments(nMedianTime);
+    }
+    if (m_diskStats) {
+        // blobs stored again replace their disk copy
+        std::vector<std::vector<uint8_t>> vecKeys;
+        vecKeys.reserve(mapCache.size());
+        for (auto const& [key, val] : mapCache) {
+            vecKeys.push_back(key);
+            m_diskStats->Add(val);
+        }
+        RemoveFromDiskStats(vecKeys);
     }
     for (auto const& [key, val] : mapCache) {
         batch.Write(key, val);
+        batch.Write(DBExpiryKey(val.nMedianTime, key), uint8_t{0});
     }
     if(mapCache.size() > 0)
         LogPrint(BCLog::SYS, "Flushing cache to disk, storing %d nevm blobs\n", mapCache.size());
     bool res = WriteBatch(batch, true);
     if(res) {
         mapCache.clear();
+    } else {
+        // counted again from disk when next asked for
+        m_diskStats.reset();
     }
     return res;
 }
@@ -95,6 +153,9 @@ bool CNEVMDataDB::FlushErase(const NEVMDataVec &vecDataKeys) {
     LOCK(cs_cache);
     if(vecDataKeys.empty())
         return true;
+    if (m_diskStats) {
+        RemoveFromDiskStats(vecDataKeys);
+    }
     CDBBatch batch(*this);    
     for (const auto &key : vecDataKeys) {
         batch.Erase(key);
@@ -105,15 +166,228 @@ bool CNEVMDataDB::FlushErase(const NEVMDataVec &vecDataKeys) {
     }
     if(vecDataKeys.size() > 0)
         LogPrint(BCLog::SYS, "Flushing, erasing %d nevm blob keys\n", vecDataKeys.size());
-    return WriteBatch(batch, true) && pnevmdatablobdb->FlushErase(vecDataKeys);
+    if (!WriteBatch(batch, true)) {
+        m_diskStats.reset();
+        return false;
+    }
+    return pnevmdatablobdb->FlushErase(vecDataKeys);
 }
 bool CNEVMDataBlobDB::FlushErase(const NEVMDataVec &vecDataKeys) {
     CDBBatch batch(*this);    
     for (const auto &key : vecDataKeys) {
-        batch.Erase(key);
+        EraseBlob(batch, key);
     }
     return WriteBatch(batch, true);
 }
+CNEVMDataBlobDB::CNEVMDataBlobDB(const DBParams& params, const fs::path& segments_dir)
+    : CDBWrapper(params), m_inline(params.memory_only), m_seq(segments_dir, "blb", BLOB_SEGMENT_CHUNK_SIZE)
+{
+    if(m_inline) {
+        return;
+    }
+    fs::create_directories(segments_dir);
+    LOCK(cs_segments);
+    std::unique_ptr<CDBIterator> pcursor(NewIterator());
+    pcursor->Seek(std::make_pair(DB_BLOB_SEGMENT, 0));
+    std::pair<uint8_t, int> key;
+    int nLastFile = -1;
+    while (pcursor->Valid() && pcursor->GetKey(key) && key.first == DB_BLOB_SEGMENT) {
+        CNEVMBlobSegment segment;
+        if (pcursor->GetValue(segment)) {
+            m_segments.emplace(key.second, segment);
+            nLastFile = std::max(nLastFile, key.second);
+        }
+        pcursor->Next();
+    }
+    // never append to a segment of a previous run, its unflushed tail may not be referenced
+    m_write_pos = FlatFilePos(nLastFile + 1, 0);
+    LogPrint(BCLog::SYS, "NEVM blob store loaded %d segments\n", m_segments.size());
+}
+CNEVMDataBlobDB::~CNEVMDataBlobDB()
+{
+    LOCK(cs_segments);
+    while(!m_mappings.empty()) {
+        UnmapSegment(m_mappings.begin()->first);
+    }
+}
+bool CNEVMDataBlobDB::ReadLocation(const std::vector<uint8_t>& vchVersionHash, CNEVMBlobLocation& loc) const {
+    return !m_inline && Read(std::make_pair(DB_BLOB_LOCATION, vchVersionHash), loc);
+}
+bool CNEVMDataBlobDB::BlobExists(const std::vector<uint8_t>& vchVersionHash) const {
+    return Exists(vchVersionHash) || (!m_inline && Exists(std::make_pair(DB_BLOB_LOCATION, vchVersionHash)));
+}
+bool CNEVMDataBlobDB::AppendBlob(CDBBatch& batch, const std::vector<uint8_t>& vchVersionHash, const std::vector<uint8_t>& vchData, const int64_t nMedianTime) {
+    if(m_inline) {
+        if(!Exists(vchVersionHash)) {
+            batch.Write(vchVersionHash, vchData);
+        }
+        return true;
+    }
+    LOCK(cs_segments);
+    CNEVMBlobLocation loc;
+    if(ReadLocation(vchVersionHash, loc)) {
+        // same content already stored, only make sure its segment lives long enough
+        auto it = m_segments.find(loc.nFile);
+        if(it != m_segments.end() && nMedianTime > it->second.nMaxMedianTime) {
+            it->second.nMaxMedianTime = nMedianTime;
+            batch.Write(std::make_pair(DB_BLOB_SEGMENT, loc.nFile), it->second);
+        }
+        return true;
+    }
+    if(Exists(vchVersionHash)) {
+        return true;
+    }
+    if(m_write_pos.nPos > 0 && (m_write_pos.nPos + vchData.size() > MAX_BLOB_SEGMENT_SIZE || nMedianTime > m_write_first_time + BLOB_SEGMENT_TIME_SPAN)) {
+        m_seq.Flush(m_write_pos, true);
+        m_write_pos = FlatFilePos(m_write_pos.nFile + 1, 0);
+    }
+    if(m_write_pos.nPos == 0) {
+        m_write_first_time = nMedianTime;
+    }
+    bool out_of_space;
+    m_seq.Allocate(m_write_pos, vchData.size(), out_of_space);
+    if(out_of_space) {
+        return error("%s: out of disk space", __func__);
+    }
+    FILE* file = m_seq.Open(m_write_pos);
+    if(!file) {
+        return error("%s: could not open blob segment %d", __func__, m_write_pos.nFile);
+    }
+    const bool written = fwrite(vchData.data(), 1, vchData.size(), file) == vchData.size();
+    fclose(file);
+    if(!written) {
+        return error("%s: could not write blob segment %d", __func__, m_write_pos.nFile);
+    }
+    loc.nFile = m_write_pos.nFile;
+    loc.nPos = m_write_pos.nPos;
+    loc.nSize = vchData.size();
+    m_write_pos.nPos += vchData.size();
+    CNEVMBlobSegment& segment = m_segments[loc.nFile];
+    segment.nMaxMedianTime = std::max(segment.nMaxMedianTime, nMedianTime);
+    segment.nSize = m_write_pos.nPos;
+    batch.Write(std::make_pair(DB_BLOB_LOCATION, vchVersionHash), loc);
+    batch.Write(std::make_pair(DB_BLOB_SEGMENT, loc.nFile), segment);
+    return true;
+}
+bool CNEVMDataBlobDB::CommitBlobs(CDBBatch& batch) {
+    {
+        LOCK(cs_segments);
+        if(!m_inline && m_write_pos.nPos > 0 && !m_seq.Flush(m_write_pos)) {
+            return error("%s: could not flush blob segment %d", __func__, m_write_pos.nFile);
+        }
+    }
+    return WriteBatch(batch);
+}
+void CNEVMDataBlobDB::EraseBlob(CDBBatch& batch, const std::vector<uint8_t>& vchVersionHash) {
+    batch.Erase(vchVersionHash);
+    if(!m_inline) {
+        // the bytes stay in their segment until the whole segment expires
+        batch.Erase(std::make_pair(DB_BLOB_LOCATION, vchVersionHash));
+    }
+}
+const uint8_t* CNEVMDataBlobDB::MapSegment(int nFile, size_t nEnd) const {
+    AssertLockHeld(cs_segments);
+    auto it = m_mappings.find(nFile);
+    if(it != m_mappings.end() && it->second.nLen >= nEnd) {
+        return it->second.pData;
+    }
+#ifndef WIN32
+    // the segment being appended to grows, map it again to cover the new bytes
+    UnmapSegment(nFile);
+    const int fd = open(fs::PathToString(m_seq.FileName(FlatFilePos(nFile, 0))).c_str(), O_RDONLY);
+    if(fd == -1) {
+        return nullptr;
+    }
+    struct stat st;
+    if(fstat(fd, &st) != 0 || (size_t)st.st_size < nEnd || st.st_size == 0) {
+        close(fd);
+        return nullptr;
+    }
+    void* addr = mmap(nullptr, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if(addr == MAP_FAILED) {
+        return nullptr;
+    }
+    m_mappings[nFile] = SegmentMapping{static_cast<const uint8_t*>(addr), (size_t)st.st_size};
+    return static_cast<const uint8_t*>(addr);
+#else
+    return nullptr;
+#endif
+}
+void CNEVMDataBlobDB::UnmapSegment(int nFile) const {
+    AssertLockHeld(cs_segments);
+    auto it = m_mappings.find(nFile);
+    if(it == m_mappings.end()) {
+        return;
+    }
+#ifndef WIN32
+    munmap(const_cast<uint8_t*>(it->second.pData), it->second.nLen);
+#endif
+    m_mappings.erase(it);
+}
+bool CNEVMDataBlobDB::ReadBlob(const std::vector<uint8_t>& vchVersionHash, const std::function<void(Span<const uint8_t>)>& fn) const {
+    CNEVMBlobLocation loc;
+    if(!ReadLocation(vchVersionHash, loc)) {
+        // deserialized straight from the value leveldb returns instead of a copy of it
+        std::string buffer;
+        std::vector<uint8_t> vchData;
+        if(!Read(vchVersionHash, vchData, buffer)) {
+            return false;
+        }
+        fn(vchData);
+        return true;
+    }
+    LOCK(cs_segments);
+    if(const uint8_t* pData = MapSegment(loc.nFile, (size_t)loc.nPos + loc.nSize)) {
+        fn(Span<const uint8_t>(pData + loc.nPos, loc.nSize));
+        return true;
+    }
+    // no mmap on this platform, read the segment through the file
+    FILE* file = const_cast<FlatFileSeq&>(m_seq).Open(FlatFilePos(loc.nFile, loc.nPos), true);
+    if(!file) {
+        return false;
+    }
+    std::vector<uint8_t> vchData(loc.nSize);
+    const bool read = fread(vchData.data(), 1, vchData.size(), file) == vchData.size();
+    fclose(file);
+    if(read) {
+        fn(vchData);
+    }
+    return read;
+}
+bool CNEVMDataBlobDB::ReadBlob(const std::vector<uint8_t>& vchVersionHash, std::vector<uint8_t>& vchData) const {
+    return ReadBlob(vchVersionHash, [&vchData](Span<const uint8_t> data) {
+        vchData.assign(data.begin(), data.end());
+    });
+}
+bool CNEVMDataBlobDB::PruneSegments(const int64_t nMedianTime) {
+    if(m_inline) {
+        return true;
+    }
+    LOCK(cs_segments);
+    CDBBatch batch(*this);
+    std::vector<int> vecExpired;
+    for (const auto& [nFile, segment] : m_segments) {
+        if(nFile != m_write_pos.nFile && nMedianTime > (segment.nMaxMedianTime + NEVM_DATA_EXPIRE_TIME)) {
+            batch.Erase(std::make_pair(DB_BLOB_SEGMENT, nFile));
+            vecExpired.emplace_back(nFile);
+        }
+    }
+    if(vecExpired.empty()) {
+        return true;
+    }
+    if(!WriteBatch(batch, true)) {
+        return false;
+    }
+    for (const int nFile : vecExpired) {
+        UnmapSegment(nFile);
+        m_segments.erase(nFile);
+        std::error_code ec;
+        fs::remove(m_seq.FileName(FlatFilePos(nFile, 0)), ec);
+    }
+    LogPrint(BCLog::SYS, "PruneSegments removed %d expired nevm blob segments\n", vecExpired.size());
+    return true;
+}
 bool CNEVMDataDB::BlobExists(const std::vector<uint8_t>& vchVersionHash) {
     LOCK(cs_cache);
     return (mapCache.find(vchVersionHash) != mapCache.end()) || Exists(vchVersionHash);
@@ -134,6 +408,82 @@ const PoDAMAPMemory& CNEVMDataDB::GetCache() const {
     AssertLockHeld(cs_cache);
     return mapCache;
 }
+void NEVMDataStats::Add(const MapPoDAPayloadMeta& meta) {
+    ++nCount;
+    nTotalSize += meta.nSize;
+    ++mapMedianTimes[meta.nMedianTime];
+}
+void NEVMDataStats::Remove(const MapPoDAPayloadMeta& meta) {
+    auto it = mapMedianTimes.find(meta.nMedianTime);
+    if (it == mapMedianTimes.end() || nCount == 0) {
+        return;
+    }
+    if (--it->second == 0) {
+        mapMedianTimes.erase(it);
+    }
+    --nCount;
+    nTotalSize -= std::min<uint64_t>(nTotalSize, meta.nSize);
+}
+void CNEVMDataDB::RemoveFromDiskStats(const std::vector<std::vector<uint8_t>>& vecKeys) {
+    AssertLockHeld(cs_cache);
+    // a blob listed twice is still only stored once
+    std::vector<std::vector<uint8_t>> vecUnique{vecKeys};
+    std::sort(vecUnique.begin(), vecUnique.end());
+    vecUnique.erase(std::unique(vecUnique.begin(), vecUnique.end()), vecUnique.end());
+    std::vector<std::optional<MapPoDAPayloadMeta>> vecMeta;
+    ReadMany(vecUnique, vecMeta);
+    for (const auto& meta : vecMeta) {
+        if (meta) {
+            m_diskStats->Remove(*meta);
+        }
+    }
+}
+NEVMDataStats CNEVMDataDB::GetStats() {
+    LOCK(cs_cache);
+    if (!m_diskStats) {
+        NEVMDataStats diskStats;
+        std::unique_ptr<CDBIterator> pcursor(NewIterator());
+        pcursor->SeekToFirst();
+        std::vector<uint8_t> vchVersionHash;
+        MapPoDAPayloadMeta meta;
+        // the blob keys sort before the prefixed index keys, the first key that isn't one ends the scan
+        while (pcursor->Valid() && pcursor->GetKey(vchVersionHash)) {
+            if (pcursor->GetValue(meta)) {
+                diskStats.Add(meta);
+            }
+            pcursor->Next();
+        }
+        m_diskStats = std::move(diskStats);
+    }
+    NEVMDataStats stats{*m_diskStats};
+    // cached blobs stand in for their disk copy
+    std::vector<std::vector<uint8_t>> vecKeys;
+    vecKeys.reserve(mapCache.size());
+    for (const auto& [key, val] : mapCache) {
+        vecKeys.push_back(key);
+        stats.Add(val);
+    }
+    std::vector<std::optional<MapPoDAPayloadMeta>> vecMeta;
+    ReadMany(vecKeys, vecMeta);
+    for (const auto& meta : vecMeta) {
+        if (meta) {
+            stats.Remove(*meta);
+        }
+    }
+    stats.nPending = mapCache.size();
+    return stats;
+}
+size_t CNEVMDataDB::DynamicMemoryUsage() const {
+    LOCK(cs_cache);
+    size_t usage = memusage::DynamicUsage(mapCache);
+    for (const auto& [vchVersionHash, meta] : mapCache) {
+        usage += memusage::DynamicUsage(vchVersionHash) + memusage::DynamicUsage(meta.vchNEVMData);
+        if (meta.vchNEVMData) {
+            usage += memusage::DynamicUsage(*meta.vchNEVMData);
+        }
+    }
+    return usage;
+}
 bool CNEVMDataDB::PruneToBatch(
     CDBBatch& batch,
     CDBBatch& batchblob,
@@ -146,7 +496,7 @@ bool CNEVMDataDB::PruneToBatch(
         const int64_t entryTime = it->second.nMedianTime;
         bool isExpired = nMedianTime > (entryTime + NEVM_DATA_EXPIRE_TIME);
         if (isExpired) {
-            batchblob.Erase(it->first);
+            pnevmdatablobdb->EraseBlob(batchblob, it->first);
             it = mapCache.erase(it);
             ++nCount;
         } else {
@@ -154,6 +504,40 @@ bool CNEVMDataDB::PruneToBatch(
         }
     }
     
+    if(!Exists(DB_NEVM_EXPIRY_INDEXED)) {
+        return BuildExpiryIndex(batch, batchblob, nMedianTime, nCount);
+    }
+    // only walk the expired prefix of the time ordered index
+    std::unique_ptr<CDBIterator> pcursor(NewIterator());
+    pcursor->Seek(DBExpiryKey());
+    DBExpiryKey key;
+    MapPoDAPayloadMeta meta;
+    while (pcursor->Valid() && pcursor->GetKey(key) && key.prefix == DB_NEVM_EXPIRY) {
+        if(nMedianTime <= (static_cast<int64_t>(key.nMedianTime) + NEVM_DATA_EXPIRE_TIME)) {
+            break;
+        }
+        batch.Erase(key);
+        // the index entry is stale if the blob was erased or got re-stored with a newer median time
+        if(mapCache.find(key.vchVersionHash) == mapCache.end() && Read(key.vchVersionHash, meta) && static_cast<uint64_t>(std::max<int64_t>(meta.nMedianTime, 0)) == key.nMedianTime) {
+            if (m_diskStats) {
+                m_diskStats->Remove(meta);
+            }
+            batch.Erase(key.vchVersionHash);
+            pnevmdatablobdb->EraseBlob(batchblob, key.vchVersionHash);
+            ++nCount;
+        }
+        pcursor->Next();
+    }
+    if(nCount > 0)
+        LogPrint(BCLog::SYS, "PruneToBatch pruned %d nevm blobs\n", nCount);
+
+    return true;
+}
+
+bool CNEVMDataDB::BuildExpiryIndex(CDBBatch& batch, CDBBatch& batchblob, const int64_t nMedianTime, int& nCount)
+{
+    AssertLockHeld(cs_cache);
+    LogPrintf("Building nevm data expiry index...\n");
     std::unique_ptr<CDBIterator> pcursor(NewIterator());
     pcursor->SeekToFirst();
     std::vector<uint8_t> vchVersionHash;
@@ -167,9 +551,14 @@ bool CNEVMDataDB::PruneToBatch(
             if (pcursor->GetValue(meta)) {
                 bool isExpired = nMedianTime > (meta.nMedianTime + NEVM_DATA_EXPIRE_TIME);
                 if (isExpired) {
+                    if (m_diskStats) {
+                        m_diskStats->Remove(meta);
+                    }
                     batch.Erase(vchVersionHash);
-                    batchblob.Erase(vchVersionHash);
+                    pnevmdatablobdb->EraseBlob(batchblob, vchVersionHash);
                     ++nCount;
+                } else {
+                    batch.Write(DBExpiryKey(meta.nMedianTime, vchVersionHash), uint8_t{0});
                 }
             }
             pcursor->Next();
@@ -177,9 +566,9 @@ bool CNEVMDataDB::PruneToBatch(
             return error("%s() : deserialize error: %s", __func__, e.what());
         }
     }
+    batch.Write(DB_NEVM_EXPIRY_INDEXED, true);
     if(nCount > 0)
-        LogPrint(BCLog::SYS, "PruneToBatch pruned %d nevm blobs\n", nCount);
-
+        LogPrint(BCLog::SYS, "BuildExpiryIndex pruned %d nevm blobs\n", nCount);
     return true;
 }
 
@@ -189,7 +578,12 @@ bool CNEVMDataDB::PruneStandalone(const int64_t nMedianTime)
     CDBBatch batch(*this);
     CDBBatch batchblob(*pnevmdatablobdb);
     if (!PruneToBatch(batch, batchblob, nMedianTime)) {
+        m_diskStats.reset();
+        return false;
+    }
+    if (!WriteBatch(batch, true)) {
+        m_diskStats.reset();
         return false;
     }
-    return WriteBatch(batch, true) && pnevmdatablobdb->WriteBatch(batchblob);
+    return pnevmdatablobdb->WriteBatch(batchblob) && pnevmdatablobdb->PruneSegments(nMedianTime);
 }
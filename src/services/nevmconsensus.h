@@ -9,6 +9,11 @@
 #include <consensus/params.h>
 #include <util/hasher.h>
 #include <sync.h>
+#include <flatfile.h>
+#include <span.h>
+#include <functional>
+#include <map>
+#include <optional>
 class TxValidationState;
 class CCoinsViewCache;
 class CTxUndo;
@@ -21,26 +26,105 @@ namespace node {
     struct NodeContext;
 } // namespace node
     
+/** Totals of a set of blobs, blobs can be taken out again as the median times are counted one by one */
+struct NEVMDataStats {
+    uint64_t nCount{0};
+    uint64_t nTotalSize{0};
+    //! blobs per median time, a few dozen block times within the retention window
+    std::map<int64_t, uint64_t> mapMedianTimes;
+    //! blobs in the cache not yet flushed to disk, only set by CNEVMDataDB::GetStats()
+    uint64_t nPending{0};
+
+    void Add(const MapPoDAPayloadMeta& meta);
+    void Remove(const MapPoDAPayloadMeta& meta);
+    int64_t OldestMedianTime() const { return mapMedianTimes.empty() ? 0 : mapMedianTimes.begin()->first; }
+    int64_t NewestMedianTime() const { return mapMedianTimes.empty() ? 0 : mapMedianTimes.rbegin()->first; }
+};
 class CNEVMDataDB : public CDBWrapper {
 public:
     mutable Mutex cs_cache; // Mutex to protect cache operations
 private:
     PoDAMAPMemory mapCache GUARDED_BY(cs_cache);
+    //! totals of the blobs on disk, counted by the first GetStats() and kept up to date by every write after it
+    std::optional<NEVMDataStats> m_diskStats GUARDED_BY(cs_cache);
+    /** Take the disk copies of these blobs out of the disk totals */
+    void RemoveFromDiskStats(const std::vector<std::vector<uint8_t>>& vecKeys) EXCLUSIVE_LOCKS_REQUIRED(cs_cache);
+    /** One time scan of databases written before the expiry index existed */
+    bool BuildExpiryIndex(CDBBatch& batch, CDBBatch& batchblob, const int64_t nMedianTime, int& nCount) EXCLUSIVE_LOCKS_REQUIRED(cs_cache);
 public:
     using CDBWrapper::CDBWrapper;
     bool FlushErase(const NEVMDataVec &vecDataKeys) EXCLUSIVE_LOCKS_REQUIRED(!cs_cache);
     bool FlushCacheToDisk(const int64_t nMedianTime) EXCLUSIVE_LOCKS_REQUIRED(!cs_cache);
     void FlushDataToCache(const PoDAMAPMemory &mapPoDA) EXCLUSIVE_LOCKS_REQUIRED(!cs_cache);
     bool PruneStandalone(const int64_t nMedianTime) EXCLUSIVE_LOCKS_REQUIRED(!cs_cache);
+    /** Erase expired blobs, only the expired prefix of the (median time, version hash) index is visited */
     bool PruneToBatch(CDBBatch& batch,CDBBatch& batchblob,  const int64_t nMedianTime) EXCLUSIVE_LOCKS_REQUIRED(cs_cache);
     bool GetBlobMetaData(const std::vector<uint8_t>& vchVersionhash, MapPoDAPayloadMeta& meta) EXCLUSIVE_LOCKS_REQUIRED(!cs_cache);
     bool BlobExists(const std::vector<uint8_t>& vchVersionhash) EXCLUSIVE_LOCKS_REQUIRED(!cs_cache);
     const PoDAMAPMemory& GetCache() const EXCLUSIVE_LOCKS_REQUIRED(cs_cache);
+    /** Totals of all blobs, the cached ones included, without scanning the database after the first call */
+    NEVMDataStats GetStats() EXCLUSIVE_LOCKS_REQUIRED(!cs_cache);
+    /** Heap memory of the blobs waiting in the cache, payloads still shared with the mempool included */
+    size_t DynamicMemoryUsage() const EXCLUSIVE_LOCKS_REQUIRED(!cs_cache);
+};
+/** Where a PoDA blob lives inside the blob segment files */
+struct CNEVMBlobLocation {
+    int nFile{-1};
+    uint32_t nPos{0};
+    uint32_t nSize{0};
+    SERIALIZE_METHODS(CNEVMBlobLocation, obj) {
+        READWRITE(obj.nFile, obj.nPos, obj.nSize);
+    }
+};
+/** Per segment file bookkeeping, a segment can be deleted once its newest blob expired */
+struct CNEVMBlobSegment {
+    int64_t nMaxMedianTime{0};
+    uint32_t nSize{0};
+    SERIALIZE_METHODS(CNEVMBlobSegment, obj) {
+        READWRITE(obj.nMaxMedianTime, obj.nSize);
+    }
 };
+/**
+ * PoDA blob store. Blob bytes are appended to numbered segment files (blbNNNNN.dat) and only
+ * their location is kept in LevelDB, so blobs never go through LevelDB compaction. Since blobs
+ * are keyed by version hash (a commitment to the content) identical blobs are only stored once.
+ * Reads are served from a read-only mapping of the segment. Expired segments are deleted whole.
+ * Blobs written by older versions inline in LevelDB are still readable. A memory only database
+ * keeps storing blobs inline.
+ */
 class CNEVMDataBlobDB : public CDBWrapper {
+    private:
+        struct SegmentMapping {
+            const uint8_t* pData{nullptr};
+            size_t nLen{0};
+        };
+        mutable Mutex cs_segments;
+        const bool m_inline;
+        FlatFileSeq m_seq;
+        std::map<int, CNEVMBlobSegment> m_segments GUARDED_BY(cs_segments);
+        mutable std::map<int, SegmentMapping> m_mappings GUARDED_BY(cs_segments);
+        //! first unwritten position of the segment currently appended to
+        FlatFilePos m_write_pos GUARDED_BY(cs_segments);
+        //! median time of the first blob in the current segment, segments are rolled over to keep expiry granular
+        int64_t m_write_first_time GUARDED_BY(cs_segments){0};
+        bool ReadLocation(const std::vector<uint8_t>& vchVersionHash, CNEVMBlobLocation& loc) const;
+        const uint8_t* MapSegment(int nFile, size_t nEnd) const EXCLUSIVE_LOCKS_REQUIRED(cs_segments);
+        void UnmapSegment(int nFile) const EXCLUSIVE_LOCKS_REQUIRED(cs_segments);
     public:
-        using CDBWrapper::CDBWrapper;
+        CNEVMDataBlobDB(const DBParams& params, const fs::path& segments_dir);
+        ~CNEVMDataBlobDB();
         bool FlushErase(const NEVMDataVec &vecDataKeys);
+        bool BlobExists(const std::vector<uint8_t>& vchVersionHash) const;
+        /** Append a blob to the current segment and add its location to batch, duplicates only refresh the segment expiry */
+        bool AppendBlob(CDBBatch& batch, const std::vector<uint8_t>& vchVersionHash, const std::vector<uint8_t>& vchData, const int64_t nMedianTime) EXCLUSIVE_LOCKS_REQUIRED(!cs_segments);
+        /** Make appended blobs durable before writing batch, which references them */
+        bool CommitBlobs(CDBBatch& batch) EXCLUSIVE_LOCKS_REQUIRED(!cs_segments);
+        void EraseBlob(CDBBatch& batch, const std::vector<uint8_t>& vchVersionHash);
+        /** Call fn with the blob bytes without copying them out of the segment mapping */
+        bool ReadBlob(const std::vector<uint8_t>& vchVersionHash, const std::function<void(Span<const uint8_t>)>& fn) const EXCLUSIVE_LOCKS_REQUIRED(!cs_segments);
+        bool ReadBlob(const std::vector<uint8_t>& vchVersionHash, std::vector<uint8_t>& vchData) const EXCLUSIVE_LOCKS_REQUIRED(!cs_segments);
+        /** Delete segments whose newest blob is older than NEVM_DATA_EXPIRE_TIME */
+        bool PruneSegments(const int64_t nMedianTime) EXCLUSIVE_LOCKS_REQUIRED(!cs_segments);
     };
 extern std::unique_ptr<CNEVMDataDB> pnevmdatadb;
 extern std::unique_ptr<CNEVMDataBlobDB> pnevmdatablobdb;
@@ -11,6 +11,9 @@
 #include <thread>
 #include <policy/rbf.h>
 #include <policy/policy.h>
+#include <index/addressindex.h>
+#include <index/assetindex.h>
+#include <index/coinstatsindex.h>
 #include <index/txindex.h>
 #include <core_io.h>
 #include <rpc/blockchain.h>
@@ -25,39 +28,44 @@
 using node::GetTransaction;
 
 int CheckActorsInTransactionGraph(const CTxMemPool& mempool, const uint256& lookForTxHash) {
-    LOCK(cs_main);
-    LOCK(mempool.cs);
+    // neither cs_main nor the mempool lock are needed for the conflict lookups, the mempool
+    // lock is only held to walk the ancestors so polling does not stall block connection
+    const CTransactionRef txRef = mempool.get(lookForTxHash);
+    if (!txRef)
+        return ZDAG_NOT_FOUND;
+    if(!IsZdagTx(txRef->nVersion))
+        return ZDAG_WARNING_NOT_ZDAG_TX;
+    // the zdag tx should be under MTU of IP packet
+    if(txRef->GetTotalSize() > MAX_STANDARD_ZDAG_TX_SIZE)
+        return ZDAG_WARNING_SIZE_OVER_POLICY;
+    // check if any inputs are dbl spent, reject if so
+    if(mempool.existsConflicts(*txRef))
+        return ZDAG_MAJOR_CONFLICT;
+
+    std::vector<CTransactionRef> vecAncestors;
     {
+        LOCK(mempool.cs);
         CTxMemPool::setEntries setAncestors;
-        const CTransactionRef txRef = mempool.get(lookForTxHash);
-        if (!txRef)
-            return ZDAG_NOT_FOUND;
-        if(!IsZdagTx(txRef->nVersion))
-            return ZDAG_WARNING_NOT_ZDAG_TX;
-        // the zdag tx should be under MTU of IP packet
-        if(txRef->GetTotalSize() > MAX_STANDARD_ZDAG_TX_SIZE)
-            return ZDAG_WARNING_SIZE_OVER_POLICY;
-        // check if any inputs are dbl spent, reject if so
-        if(mempool.existsConflicts(*txRef))
-            return ZDAG_MAJOR_CONFLICT;        
-
         // check this transaction isn't RBF enabled
         RBFTransactionState rbfState = IsRBFOptIn(*txRef, mempool, setAncestors);
         if (rbfState == RBFTransactionState::UNKNOWN)
             return ZDAG_NOT_FOUND;
         else if (rbfState == RBFTransactionState::REPLACEABLE_BIP125)
             return ZDAG_WARNING_RBF;
+        vecAncestors.reserve(setAncestors.size());
         for (CTxMemPool::txiter it : setAncestors) {
-            const CTransactionRef& ancestorTxRef = it->GetSharedTx();
-            // should be under MTU of IP packet
-            if(ancestorTxRef->GetTotalSize() > MAX_STANDARD_ZDAG_TX_SIZE)
-                return ZDAG_WARNING_SIZE_OVER_POLICY;
-            // check if any ancestor inputs are dbl spent, reject if so
-            if(mempool.existsConflicts(*ancestorTxRef))
-                return ZDAG_MAJOR_CONFLICT;
-            if(!IsZdagTx(ancestorTxRef->nVersion))
-                return ZDAG_WARNING_NOT_ZDAG_TX;
-        }  
+            vecAncestors.emplace_back(it->GetSharedTx());
+        }
+    }
+    for (const CTransactionRef& ancestorTxRef : vecAncestors) {
+        // should be under MTU of IP packet
+        if(ancestorTxRef->GetTotalSize() > MAX_STANDARD_ZDAG_TX_SIZE)
+            return ZDAG_WARNING_SIZE_OVER_POLICY;
+        // check if any ancestor inputs are dbl spent, reject if so
+        if(mempool.existsConflicts(*ancestorTxRef))
+            return ZDAG_MAJOR_CONFLICT;
+        if(!IsZdagTx(ancestorTxRef->nVersion))
+            return ZDAG_WARNING_NOT_ZDAG_TX;
     }
     return ZDAG_STATUS_OK;
 }
@@ -234,6 +242,389 @@ static RPCHelpMan syscoincheckmint()
     };
 }
 
+static RPCHelpMan syscoincheckmints()
+{
+    return RPCHelpMan{"syscoincheckmints",
+    "\nLook up the Syscoin mint transactions of many NEVM tx hashes at once, see syscoincheckmint. Unknown hashes get an error entry instead of failing the call.\n",
+    {
+        {"nevm_txhashes", RPCArg::Type::ARR, RPCArg::Optional::NO, "NEVM Tx Hashes used to burn funds to move to Syscoin.",
+            {
+                {"nevm_txhash", RPCArg::Type::STR_HEX, RPCArg::Optional::OMITTED, "NEVM Tx Hash"},
+            },
+        },
+    },
+    RPCResult{
+        RPCResult::Type::ARR, "", "One entry per requested hash, in request order",
+        {
+            {RPCResult::Type::OBJ, "", "",
+            {
+                {RPCResult::Type::STR_HEX, "nevm_txhash", "The requested NEVM tx hash"},
+                {RPCResult::Type::STR_HEX, "txid", /*optional=*/true, "The transaction id of the mint"},
+                {RPCResult::Type::STR, "error", /*optional=*/true, "Why the mint could not be found"},
+            }},
+        }},
+    RPCExamples{
+        HelpExampleCli("syscoincheckmints", "'[\"d8ac75c7b4084c85a89d6e28219ff162661efb8b794d4b66e6e9ea52b4139b10\"]'")
+        + HelpExampleRpc("syscoincheckmints", "[\"d8ac75c7b4084c85a89d6e28219ff162661efb8b794d4b66e6e9ea52b4139b10\"]")
+    },
+    [&](const RPCHelpMan& self, const node::JSONRPCRequest& request) -> UniValue
+{
+    const UniValue& hashes = request.params[0].get_array();
+    if(!pnevmtxmintdb) {
+        throw JSONRPCError(RPC_INVALID_ADDRESS_OR_KEY, "Could not read Syscoin txid using mint transaction hash");
+    }
+    UniValue res(UniValue::VARR);
+    for (size_t i = 0; i < hashes.size(); i++) {
+        const std::string strTxHash = RemovePrefix(hashes[i].get_str(), "0x");  // strip 0x
+        const uint256 nTxHash = uint256S(strTxHash);
+        UniValue entry(UniValue::VOBJ);
+        entry.pushKV("nevm_txhash", strTxHash);
+        uint256 sysTxid;
+        if(pnevmtxmintdb->Read(nTxHash, sysTxid)) {
+            entry.pushKV("txid", sysTxid.GetHex());
+        } else {
+            entry.pushKV("error", "Could not read Syscoin txid using mint transaction hash");
+        }
+        res.push_back(entry);
+    }
+    return res;
+},
+    };
+}
+
+static RPCHelpMan getassetoutputs()
+{
+    return RPCHelpMan{"getassetoutputs",
+    "\nList unspent outputs of an asset from the asset index, optionally only those paying to an address. Requires -assetoutputindex.\n",
+    {
+        {"asset_guid", RPCArg::Type::NUM, RPCArg::Optional::NO, "The asset guid."},
+        {"address", RPCArg::Type::STR, RPCArg::Optional::OMITTED, "Only list outputs paying to this address."},
+        {"count", RPCArg::Type::NUM, RPCArg::Default{1000}, "The maximum number of outputs to return, 0 for all."},
+    },
+    RPCResult{
+        RPCResult::Type::ARR, "", "",
+        {
+            {RPCResult::Type::OBJ, "", "",
+            {
+                {RPCResult::Type::STR_HEX, "txid", "The transaction id"},
+                {RPCResult::Type::NUM, "vout", "The output number"},
+                {RPCResult::Type::STR, "address", /*optional=*/true, "The address the output pays to"},
+                {RPCResult::Type::STR_HEX, "scriptPubKey", "The output script"},
+                {RPCResult::Type::STR_AMOUNT, "asset_value", "The asset amount of the output"},
+            }},
+        }},
+    RPCExamples{
+        HelpExampleCli("getassetoutputs", "123456")
+        + HelpExampleCli("getassetoutputs", "123456 \"sys1qxyz\" 10")
+        + HelpExampleRpc("getassetoutputs", "123456")
+    },
+    [&](const RPCHelpMan& self, const node::JSONRPCRequest& request) -> UniValue
+{
+    if (!g_asset_index) {
+        throw JSONRPCError(RPC_MISC_ERROR, "Requires assetoutputindex. Start with -assetoutputindex");
+    }
+    const uint64_t nAsset = request.params[0].getInt<uint64_t>();
+    std::optional<CScript> scriptPubKey;
+    if (!request.params[1].isNull()) {
+        const CTxDestination dest = DecodeDestination(request.params[1].get_str());
+        if (!IsValidDestination(dest)) {
+            throw JSONRPCError(RPC_INVALID_ADDRESS_OR_KEY, "Invalid address");
+        }
+        scriptPubKey = GetScriptForDestination(dest);
+    }
+    const int64_t nCount = request.params[2].isNull() ? 1000 : request.params[2].getInt<int64_t>();
+    if (nCount < 0) {
+        throw JSONRPCError(RPC_INVALID_PARAMETER, "Negative count");
+    }
+    g_asset_index->BlockUntilSyncedToCurrentChain();
+    std::vector<AssetIndexOutput> vOutputs;
+    g_asset_index->FindAssetOutputs(nAsset, scriptPubKey ? &*scriptPubKey : nullptr, nCount, vOutputs);
+
+    UniValue ret(UniValue::VARR);
+    for (const auto& output : vOutputs) {
+        UniValue entry(UniValue::VOBJ);
+        entry.pushKV("txid", output.outpoint.hash.GetHex());
+        entry.pushKV("vout", (int)output.outpoint.n);
+        CTxDestination dest;
+        if (ExtractDestination(output.scriptPubKey, dest)) {
+            entry.pushKV("address", EncodeDestination(dest));
+        }
+        entry.pushKV("scriptPubKey", HexStr(output.scriptPubKey));
+        entry.pushKV("asset_value", ValueFromAmount(output.nAssetValue));
+        ret.push_back(entry);
+    }
+    return ret;
+},
+    };
+}
+
+static RPCHelpMan getassetsupplyinfo()
+{
+    return RPCHelpMan{"getassetsupplyinfo",
+    "\nReturn the running totals of an asset as of a block of the active chain from the coinstats index. Requires -coinstatsindex.\n",
+    {
+        {"asset_guid", RPCArg::Type::NUM, RPCArg::Optional::NO, "The asset guid."},
+        {"height", RPCArg::Type::NUM, RPCArg::DefaultHint{"the current best block"}, "The block height to report the totals at."},
+    },
+    RPCResult{
+        RPCResult::Type::OBJ, "", "",
+        {
+            {RPCResult::Type::NUM, "height", "The block height the totals are for"},
+            {RPCResult::Type::STR_HEX, "bestblock", "The hash of the block the totals are for"},
+            {RPCResult::Type::STR_AMOUNT, "supply", "The asset amount held by unspent outputs"},
+            {RPCResult::Type::STR_AMOUNT, "minted", "The asset amount created by mints and SYS to SYSX burns"},
+            {RPCResult::Type::STR_AMOUNT, "burned_to_nevm", "The asset amount burned to the NEVM"},
+            {RPCResult::Type::STR_AMOUNT, "burned_to_syscoin", "The SYSX amount burned back to SYS"},
+            {RPCResult::Type::NUM, "outputs", "The number of unspent outputs holding the asset"},
+        }},
+    RPCExamples{
+        HelpExampleCli("getassetsupplyinfo", "123456")
+        + HelpExampleCli("getassetsupplyinfo", "123456 1000")
+        + HelpExampleRpc("getassetsupplyinfo", "123456")
+    },
+    [&](const RPCHelpMan& self, const node::JSONRPCRequest& request) -> UniValue
+{
+    if (!g_coin_stats_index) {
+        throw JSONRPCError(RPC_MISC_ERROR, "Requires coinstatsindex. Start with -coinstatsindex");
+    }
+    const uint64_t nAsset = request.params[0].getInt<uint64_t>();
+    ChainstateManager& chainman = EnsureAnyChainman(request.context);
+    g_coin_stats_index->BlockUntilSyncedToCurrentChain();
+    const CBlockIndex* pindex;
+    {
+        LOCK(cs_main);
+        const CChain& active_chain = chainman.ActiveChain();
+        const int nHeight = request.params[1].isNull() ? active_chain.Height() : request.params[1].getInt<int>();
+        if (nHeight < 0 || nHeight > active_chain.Height()) {
+            throw JSONRPCError(RPC_INVALID_PARAMETER, "Block height out of range");
+        }
+        pindex = active_chain[nHeight];
+    }
+    const std::optional<AssetStats> stats = g_coin_stats_index->LookUpAssetStats(nAsset, *pindex);
+    if (!stats) {
+        throw JSONRPCError(RPC_INTERNAL_ERROR, "Asset totals are not available, the coinstats index may be syncing or was built without them");
+    }
+    UniValue ret(UniValue::VOBJ);
+    ret.pushKV("height", pindex->nHeight);
+    ret.pushKV("bestblock", pindex->GetBlockHash().GetHex());
+    ret.pushKV("supply", ValueFromAmount(stats->supply));
+    ret.pushKV("minted", ValueFromAmount(stats->minted));
+    ret.pushKV("burned_to_nevm", ValueFromAmount(stats->burned_to_nevm));
+    ret.pushKV("burned_to_syscoin", ValueFromAmount(stats->burned_to_syscoin));
+    ret.pushKV("outputs", stats->output_count);
+    return ret;
+},
+    };
+}
+
+static CScript AddressIndexScript(const UniValue& param)
+{
+    if (!g_address_index) {
+        throw JSONRPCError(RPC_MISC_ERROR, "Requires addressindex. Start with -addressindex");
+    }
+    const CTxDestination dest = DecodeDestination(param.get_str());
+    if (!IsValidDestination(dest)) {
+        throw JSONRPCError(RPC_INVALID_ADDRESS_OR_KEY, "Invalid address");
+    }
+    return GetScriptForDestination(dest);
+}
+
+static RPCArg AddressIndexQueryArg()
+{
+    return {"options", RPCArg::Type::OBJ_NAMED_PARAMS, RPCArg::Optional::OMITTED, "",
+        {
+            {"asset_guid", RPCArg::Type::NUM, RPCArg::DefaultHint{"all assets"}, "Only this asset, 0 for SYS."},
+            {"start_height", RPCArg::Type::NUM, RPCArg::Default{0}, "The lowest block height to include."},
+            {"end_height", RPCArg::Type::NUM, RPCArg::DefaultHint{"the tip"}, "The highest block height to include."},
+            {"skip", RPCArg::Type::NUM, RPCArg::Default{0}, "The number of results to skip."},
+            {"count", RPCArg::Type::NUM, RPCArg::Default{1000}, "The maximum number of results to return, 0 for all."},
+        }};
+}
+
+static AddressIndexQuery ParseAddressIndexQuery(const UniValue& options)
+{
+    AddressIndexQuery query;
+    query.nCount = 1000;
+    if (options.isNull()) return query;
+    RPCTypeCheckObj(options,
+        {
+            {"asset_guid", UniValueType(UniValue::VNUM)},
+            {"start_height", UniValueType(UniValue::VNUM)},
+            {"end_height", UniValueType(UniValue::VNUM)},
+            {"skip", UniValueType(UniValue::VNUM)},
+            {"count", UniValueType(UniValue::VNUM)},
+        },
+        /*fAllowNull=*/true, /*fStrict=*/true);
+    if (!options["asset_guid"].isNull()) query.nAsset = options["asset_guid"].getInt<uint64_t>();
+    if (!options["start_height"].isNull()) query.nStartHeight = options["start_height"].getInt<int>();
+    if (!options["end_height"].isNull()) query.nEndHeight = options["end_height"].getInt<int>();
+    if (query.nStartHeight < 0 || query.nEndHeight < query.nStartHeight) {
+        throw JSONRPCError(RPC_INVALID_PARAMETER, "Invalid height range");
+    }
+    const int64_t nSkip = options["skip"].isNull() ? 0 : options["skip"].getInt<int64_t>();
+    const int64_t nCount = options["count"].isNull() ? 1000 : options["count"].getInt<int64_t>();
+    if (nSkip < 0 || nCount < 0) {
+        throw JSONRPCError(RPC_INVALID_PARAMETER, "Negative skip or count");
+    }
+    query.nSkip = nSkip;
+    query.nCount = nCount;
+    return query;
+}
+
+static RPCHelpMan getaddressbalance()
+{
+    return RPCHelpMan{"getaddressbalance",
+    "\nReturn the confirmed SYS and asset balances of an address from the address index. Requires -addressindex.\n",
+    {
+        {"address", RPCArg::Type::STR, RPCArg::Optional::NO, "The address."},
+    },
+    RPCResult{
+        RPCResult::Type::OBJ, "", "",
+        {
+            {RPCResult::Type::STR_AMOUNT, "balance", "The SYS balance"},
+            {RPCResult::Type::STR_AMOUNT, "received", "The SYS received in total"},
+            {RPCResult::Type::ARR, "assets", "The asset balances",
+            {
+                {RPCResult::Type::OBJ, "", "",
+                {
+                    {RPCResult::Type::NUM, "asset_guid", "The asset guid"},
+                    {RPCResult::Type::STR_AMOUNT, "balance", "The asset balance"},
+                    {RPCResult::Type::STR_AMOUNT, "received", "The asset amount received in total"},
+                }},
+            }},
+        }},
+    RPCExamples{
+        HelpExampleCli("getaddressbalance", "\"sys1qxyz\"")
+        + HelpExampleRpc("getaddressbalance", "\"sys1qxyz\"")
+    },
+    [&](const RPCHelpMan& self, const node::JSONRPCRequest& request) -> UniValue
+{
+    const CScript scriptPubKey = AddressIndexScript(request.params[0]);
+    g_address_index->BlockUntilSyncedToCurrentChain();
+
+    CAmount nBalance{0}, nReceived{0};
+    UniValue assets(UniValue::VARR);
+    for (const auto& balance : g_address_index->GetBalances(scriptPubKey)) {
+        if (balance.nAsset == 0) {
+            nBalance = balance.nBalance;
+            nReceived = balance.nReceived;
+            continue;
+        }
+        UniValue entry(UniValue::VOBJ);
+        entry.pushKV("asset_guid", balance.nAsset);
+        entry.pushKV("balance", ValueFromAmount(balance.nBalance));
+        entry.pushKV("received", ValueFromAmount(balance.nReceived));
+        assets.push_back(entry);
+    }
+    UniValue ret(UniValue::VOBJ);
+    ret.pushKV("balance", ValueFromAmount(nBalance));
+    ret.pushKV("received", ValueFromAmount(nReceived));
+    ret.pushKV("assets", assets);
+    return ret;
+},
+    };
+}
+
+static RPCHelpMan getaddresshistory()
+{
+    return RPCHelpMan{"getaddresshistory",
+    "\nList the confirmed credits and debits of an address from the address index, ordered by asset, SYS first, then height. Requires -addressindex.\n"
+    "Every output is listed under SYS, asset outputs are listed under their asset as well.\n",
+    {
+        {"address", RPCArg::Type::STR, RPCArg::Optional::NO, "The address."},
+        AddressIndexQueryArg(),
+    },
+    RPCResult{
+        RPCResult::Type::ARR, "", "",
+        {
+            {RPCResult::Type::OBJ, "", "",
+            {
+                {RPCResult::Type::NUM, "asset_guid", "The asset guid, 0 for SYS"},
+                {RPCResult::Type::NUM, "height", "The block height"},
+                {RPCResult::Type::STR_HEX, "txid", "The transaction id"},
+                {RPCResult::Type::NUM, "index", "The output number of a credit, the input number of a debit"},
+                {RPCResult::Type::BOOL, "spending", "Whether this is a debit"},
+                {RPCResult::Type::STR_AMOUNT, "amount", "The amount, negative for a debit"},
+            }},
+        }},
+    RPCExamples{
+        HelpExampleCli("getaddresshistory", "\"sys1qxyz\"")
+        + HelpExampleCli("getaddresshistory", "\"sys1qxyz\" '{\"asset_guid\":0,\"start_height\":1000,\"count\":100}'")
+        + HelpExampleRpc("getaddresshistory", "\"sys1qxyz\"")
+    },
+    [&](const RPCHelpMan& self, const node::JSONRPCRequest& request) -> UniValue
+{
+    const CScript scriptPubKey = AddressIndexScript(request.params[0]);
+    const AddressIndexQuery query = ParseAddressIndexQuery(request.params[1]);
+    g_address_index->BlockUntilSyncedToCurrentChain();
+
+    UniValue ret(UniValue::VARR);
+    for (const auto& delta : g_address_index->GetHistory(scriptPubKey, query)) {
+        UniValue entry(UniValue::VOBJ);
+        entry.pushKV("asset_guid", delta.nAsset);
+        entry.pushKV("height", delta.nHeight);
+        entry.pushKV("txid", delta.txid.GetHex());
+        entry.pushKV("index", (int)delta.nIndex);
+        entry.pushKV("spending", delta.fSpending);
+        entry.pushKV("amount", ValueFromAmount(delta.nAmount));
+        ret.push_back(entry);
+    }
+    return ret;
+},
+    };
+}
+
+static RPCHelpMan getaddressutxos()
+{
+    return RPCHelpMan{"getaddressutxos",
+    "\nList the confirmed unspent outputs of an address from the address index, ordered by asset, SYS first, then height. Requires -addressindex.\n"
+    "Outputs that carry an asset are listed under the asset only.\n",
+    {
+        {"address", RPCArg::Type::STR, RPCArg::Optional::NO, "The address."},
+        AddressIndexQueryArg(),
+    },
+    RPCResult{
+        RPCResult::Type::ARR, "", "",
+        {
+            {RPCResult::Type::OBJ, "", "",
+            {
+                {RPCResult::Type::STR_HEX, "txid", "The transaction id"},
+                {RPCResult::Type::NUM, "vout", "The output number"},
+                {RPCResult::Type::NUM, "height", "The block height"},
+                {RPCResult::Type::STR_AMOUNT, "value", "The SYS value of the output"},
+                {RPCResult::Type::NUM, "asset_guid", /*optional=*/true, "The asset guid of an asset output"},
+                {RPCResult::Type::STR_AMOUNT, "asset_value", /*optional=*/true, "The asset amount of an asset output"},
+            }},
+        }},
+    RPCExamples{
+        HelpExampleCli("getaddressutxos", "\"sys1qxyz\"")
+        + HelpExampleCli("getaddressutxos", "\"sys1qxyz\" '{\"asset_guid\":123456}'")
+        + HelpExampleRpc("getaddressutxos", "\"sys1qxyz\"")
+    },
+    [&](const RPCHelpMan& self, const node::JSONRPCRequest& request) -> UniValue
+{
+    const CScript scriptPubKey = AddressIndexScript(request.params[0]);
+    const AddressIndexQuery query = ParseAddressIndexQuery(request.params[1]);
+    g_address_index->BlockUntilSyncedToCurrentChain();
+
+    UniValue ret(UniValue::VARR);
+    for (const auto& unspent : g_address_index->GetUnspent(scriptPubKey, query)) {
+        UniValue entry(UniValue::VOBJ);
+        entry.pushKV("txid", unspent.outpoint.hash.GetHex());
+        entry.pushKV("vout", (int)unspent.outpoint.n);
+        entry.pushKV("height", unspent.nHeight);
+        entry.pushKV("value", ValueFromAmount(unspent.nValue));
+        if (unspent.nAsset != 0) {
+            entry.pushKV("asset_guid", unspent.nAsset);
+            entry.pushKV("asset_value", ValueFromAmount(unspent.nAssetValue));
+        }
+        ret.push_back(entry);
+    }
+    return ret;
+},
+    };
+}
+
 // clang-format on
 void RegisterAssetRPCCommands(CRPCTable &t)
 {
@@ -242,6 +633,12 @@ void RegisterAssetRPCCommands(CRPCTable &t)
         {"syscoin", &syscoindecoderawtransaction},
         {"syscoin", &assetallocationverifyzdag},
         {"syscoin", &syscoincheckmint},
+        {"syscoin", &syscoincheckmints},
+        {"syscoin", &getassetoutputs},
+        {"syscoin", &getaddressbalance},
+        {"syscoin", &getaddresshistory},
+        {"syscoin", &getaddressutxos},
+        {"syscoin", &getassetsupplyinfo},
     };
     for (const auto& c : commands) {
         t.appendCommand(c.name, &c);
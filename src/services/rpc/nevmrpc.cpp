@@ -13,6 +13,7 @@
 #include <index/txindex.h>
 #include <core_io.h>
 #include <rpc/blockchain.h>
+#include <rpc/jsonstream.h>
 #include <node/context.h>
 #include <node/transaction.h>
 #include <rpc/server_util.h>
@@ -21,6 +22,7 @@
 #include <key_io.h>
 #include <common/args.h>
 #include <logging.h>
+#include <numeric>
 using node::GetTransaction;
 
 static RPCHelpMan getnevmblockchaininfo()
@@ -64,7 +66,7 @@ static RPCHelpMan getnevmblockchaininfo()
         if (chainman.m_blockman.IsBlockPruned(pblockindex)) {
             throw JSONRPCError(RPC_MISC_ERROR, tip->GetBlockHash().ToString() + " not available (pruned data)");
         }
-        if (!chainman.m_blockman.ReadBlockFromDisk(block, *pblockindex)) {
+        if (!chainman.m_blockman.ReadBlockFromDisk(block, *pblockindex, /*fFillNEVMData=*/false)) {
             throw JSONRPCError(RPC_MISC_ERROR, tip->GetBlockHash().ToString() + " not found");
         }
         if(!GetNEVMData(state, block, evmBlock)) {
@@ -189,11 +191,9 @@ static RPCHelpMan getnevmblobdata()
         }
     }
     if(bGetData) {
-        std::vector<uint8_t> vchData;
-        if (!pnevmdatablobdb->Read(vchVH, vchData)) {
+        if (!pnevmdatablobdb->ReadBlob(vchVH, [&oNEVM](Span<const uint8_t> data) { oNEVM.pushKVEnd("data", HexStr(data)); })) {
             throw JSONRPCError(RPC_INVALID_PARAMS, strprintf("Could not find data for versionhash %s", HexStr(vchVH)));
-        }       
-        oNEVM.pushKVEnd("data", HexStr(vchData));
+        }
     }
     return oNEVM;
 },
@@ -203,54 +203,78 @@ static RPCHelpMan getnevmblobdata()
 
 bool ScanBlobs(CNEVMDataDB& pnevmdatadb, const uint32_t count, const uint32_t from, const UniValue& oOptions, UniValue& oRes) {
     bool stats = false;
+    std::optional<std::vector<uint8_t>> vchCursor;
 
     if (!oOptions.isNull()) {
         const UniValue &statsObj = oOptions.find_value("stats");
         if (statsObj.isBool()) {
             stats = statsObj.get_bool();
         }
+        const UniValue &cursorObj = oOptions.find_value("cursor");
+        if (cursorObj.isStr()) {
+            vchCursor = ParseHex(cursorObj.get_str());
+        }
+    }
+
+    if (stats) {
+        // SYSCOIN kept up to date by the database, no scan
+        const NEVMDataStats blobStats{pnevmdatadb.GetStats()};
+        UniValue oStats(UniValue::VOBJ);
+        oStats.pushKV("total_blobs", blobStats.nCount);
+        oStats.pushKV("total_size", blobStats.nTotalSize);
+        oStats.pushKV("oldest_mpt", blobStats.OldestMedianTime());
+        oStats.pushKV("newest_mpt", blobStats.NewestMedianTime());
+        oStats.pushKV("pending_blobs", blobStats.nPending);
+        oRes.push_back(oStats);
+        return true;
     }
 
-    uint64_t totalSize = 0;
-    uint64_t totalBlobs = 0;
-    uint64_t oldest = UINT64_MAX;
-    uint64_t newest = 0;
     LOCK(pnevmdatadb.cs_cache);
     const PoDAMAPMemory &cache = pnevmdatadb.GetCache();
+    auto pushBlob = [&](const std::vector<uint8_t>& vchVersionHash, const MapPoDAPayloadMeta& meta) {
+        UniValue oBlob(UniValue::VOBJ);
+        oBlob.pushKV("versionhash", HexStr(vchVersionHash));
+        oBlob.pushKV("mtp", meta.nMedianTime);
+        oBlob.pushKV("datasize", meta.nSize);
+        oBlob.pushKV("txid", meta.txid.ToString());
+        oRes.push_back(oBlob);
+    };
 
-    if (stats) {
-        for (const auto& [key, val] : cache) {
-            totalSize += val.nSize;
-            totalBlobs++;
-            oldest = std::min(oldest, static_cast<uint64_t>(val.nMedianTime));
-            newest = std::max(newest, static_cast<uint64_t>(val.nMedianTime));         
-        }
-
+    // SYSCOIN the cached and the stored blobs are merged in version hash order, seeking to the cursor
+    // instead of skipping from the start
+    if (vchCursor) {
+        auto itCache = cache.upper_bound(*vchCursor);
         std::unique_ptr<CDBIterator> pcursor(pnevmdatadb.NewIterator());
-        pcursor->SeekToFirst();
-        std::vector<uint8_t> vchVersionHash;
-        while (pcursor->Valid()) {
-            vchVersionHash.clear();
-            if (pcursor->GetKey(vchVersionHash)) {
-                if(cache.find(vchVersionHash) == cache.end()) {
-                    MapPoDAPayloadMeta meta;
-                    if(pcursor->GetValue(meta)) {
-                        totalSize += meta.nSize;
-                        totalBlobs++;
-                        oldest = std::min(oldest, static_cast<uint64_t>(meta.nMedianTime));
-                        newest = std::max(newest, static_cast<uint64_t>(meta.nMedianTime));    
-                    }
+        pcursor->Seek(*vchCursor);
+        std::vector<uint8_t> vchDisk;
+        MapPoDAPayloadMeta metaDisk;
+        // the blob keys sort before the prefixed index keys, the first key that isn't one ends them
+        auto nextDisk = [&]() {
+            while (pcursor->Valid() && pcursor->GetKey(vchDisk)) {
+                if (vchDisk > *vchCursor && pcursor->GetValue(metaDisk)) {
+                    return true;
                 }
+                pcursor->Next();
+            }
+            return false;
+        };
+        bool fDisk = nextDisk();
+        while (oRes.size() < count) {
+            if (itCache != cache.end() && (!fDisk || itCache->first <= vchDisk)) {
+                if (fDisk && itCache->first == vchDisk) {
+                    pcursor->Next();
+                    fDisk = nextDisk();
+                }
+                pushBlob(itCache->first, itCache->second);
+                ++itCache;
+            } else if (fDisk) {
+                pushBlob(vchDisk, metaDisk);
+                pcursor->Next();
+                fDisk = nextDisk();
+            } else {
+                break;
             }
-            pcursor->Next();
         }
-
-        UniValue oStats(UniValue::VOBJ);
-        oStats.pushKV("total_blobs", totalBlobs);
-        oStats.pushKV("total_size", totalSize);
-        oStats.pushKV("oldest_mpt", oldest == UINT64_MAX ? 0 : oldest);
-        oStats.pushKV("newest_mpt", newest);
-        oRes.push_back(oStats);
         return true;
     }
 
@@ -303,6 +327,7 @@ static RPCHelpMan listnevmblobdata()
             {"options", RPCArg::Type::OBJ, RPCArg::Optional::OMITTED, "A json object with options to filter results.",
                 {
                     {"stats", RPCArg::Type::BOOL, RPCArg::Optional::OMITTED, "Return statistics for all blobs (ignores count/from)"},
+                    {"cursor", RPCArg::Type::STR_HEX, RPCArg::Optional::OMITTED, "Return the blobs after this version hash in version hash order (ignores from). Pass the largest versionhash of a page to get the next one, an empty string starts at the first blob"},
                 }
             }
         },
@@ -322,6 +347,7 @@ static RPCHelpMan listnevmblobdata()
                     {RPCResult::Type::NUM, "total_size", "Total size of all blobs in bytes"},
                     {RPCResult::Type::NUM, "oldest_mpt", "Median timestamp of the oldest blob"},
                     {RPCResult::Type::NUM, "newest_mpt", "Median timestamp of the newest blob"},
+                    {RPCResult::Type::NUM, "pending_blobs", "Number of blobs not yet flushed to disk"},
                 }},
             },
         },
@@ -329,6 +355,7 @@ static RPCHelpMan listnevmblobdata()
             HelpExampleCli("listnevmblobdata", "0")
             + HelpExampleCli("listnevmblobdata", "10 10")
             + HelpExampleCli("listnevmblobdata", "0 0 '{\"stats\":true}'")
+            + HelpExampleCli("listnevmblobdata", "10 0 '{\"cursor\":\"\"}'")
         },
         [&](const RPCHelpMan& self, const node::JSONRPCRequest& request) -> UniValue
 {
@@ -352,28 +379,110 @@ static RPCHelpMan listnevmblobdata()
     if (!ScanBlobs(*pnevmdatadb, count, from, options, oRes))
         throw JSONRPCError(RPC_MISC_ERROR, "Scan failed");
     // Extract into a sortable vector
-    std::vector<UniValue> blobVec;
-    for (size_t i = 0; i < oRes.size(); i++) {
-        blobVec.push_back(oRes[i]);
-    }
+    std::vector<UniValue> blobVec{oRes.getValues()};
 
     // Sort by mtp
     std::sort(blobVec.begin(), blobVec.end(), [](const UniValue &a, const UniValue &b) {
         return a["mtp"].getInt<int64_t>() < b["mtp"].getInt<int64_t>();
     });
 
-    // Reconstruct the sorted UniValue result
-    UniValue sortedRes(UniValue::VARR);
-    for (const auto& blob : blobVec) {
-        sortedRes.push_back(blob);
+    // SYSCOIN reconstruct the sorted result, streamed when the reply allows it
+    RPCResultWriter sortedRes{request.stream, UniValue::VARR};
+    for (auto& blob : blobVec) {
+        sortedRes.push_back(std::move(blob));
     }
 
-    return sortedRes;
+    return sortedRes.Finish();
 },
     };
 }
 
 
+/** Block index of the block holding txhash, nullptr if it is not found without the txindex */
+static const CBlockIndex* LookupSPVProofBlock(node::NodeContext& node, const uint256& txhash) EXCLUSIVE_LOCKS_REQUIRED(cs_main)
+{
+    const Coin& coin = AccessByTxid(node.chainman->ActiveChainstate().CoinsTip(), txhash);
+    if (!coin.IsSpent()) {
+        return node.chainman->ActiveChain()[coin.nHeight];
+    }
+    uint32_t nBlockHeight;
+    if(pblockindexdb != nullptr && pblockindexdb->ReadBlockHeight(txhash, nBlockHeight)) {
+        return node.chainman->ActiveChain()[nBlockHeight];
+    }
+    return nullptr;
+}
+
+/** A block read once for all the proofs of transactions it contains */
+struct SPVProofBlock {
+    CBlock block;
+    std::string strHeader;
+    uint256 nNEVMBlockHash;
+    bool fChainLock{false};
+};
+
+static void ReadSPVProofBlock(node::NodeContext& node, const CBlockIndex* pblockindex, SPVProofBlock& proofBlock)
+{
+    CDataStream ssBlock(SER_NETWORK, PROTOCOL_VERSION);
+    {
+        LOCK(cs_main);
+        if (node.chainman->m_blockman.IsBlockPruned(pblockindex)) {
+            throw JSONRPCError(RPC_MISC_ERROR, "Block not available (pruned data)");
+        }
+        ssBlock << pblockindex->GetBlockHeader(*node.chainman);
+    }
+
+    if (!node.chainman->m_blockman.ReadBlockFromDisk(proofBlock.block, *pblockindex, /*fFillNEVMData=*/false)) {
+        // Block not found on disk. This could be because we have the block
+        // header in our index but don't have the block (for example if a
+        // non-whitelisted node sends us an unrequested long chain of valid
+        // blocks, we add the headers to our index, but don't accept the
+        // block).
+        throw JSONRPCError(RPC_MISC_ERROR, "Block not found on disk");
+    }
+    const auto bytesVec = MakeUCharSpan(ssBlock);
+    // get first 80 bytes of header (non auxpow part)
+    proofBlock.strHeader = HexStr(std::vector<unsigned char>(bytesVec.begin(), bytesVec.begin()+80));
+    CNEVMHeader evmBlock;
+    BlockValidationState state;
+    if(!GetNEVMData(state, proofBlock.block, evmBlock)) {
+        throw JSONRPCError(RPC_MISC_ERROR, state.ToString());
+    }
+    std::reverse (evmBlock.nBlockHash.begin (), evmBlock.nBlockHash.end ()); // correct endian
+    proofBlock.nNEVMBlockHash = evmBlock.nBlockHash;
+    // SYSCOIN
+    if(llmq::chainLocksHandler)
+        proofBlock.fChainLock = llmq::chainLocksHandler->HasChainLock(pblockindex->nHeight, pblockindex->GetBlockHash());
+}
+
+static UniValue BuildSPVProof(const SPVProofBlock& proofBlock, const uint256& txhash)
+{
+    UniValue res(UniValue::VOBJ);
+    CTransactionRef tx;
+    UniValue siblings(UniValue::VARR);
+    // store the index of the transaction we are looking for within the block
+    int nIndex = 0;
+    for (unsigned int i = 0;i < proofBlock.block.vtx.size();i++) {
+        const uint256 &txHashFromBlock = proofBlock.block.vtx[i]->GetHash();
+        if(txhash == txHashFromBlock) {
+            nIndex = i;
+            tx = proofBlock.block.vtx[i];
+        }
+        siblings.push_back(txHashFromBlock.GetHex());
+    }
+    if(!tx)
+        throw JSONRPCError(RPC_INVALID_ADDRESS_OR_KEY, "Transaction not yet in block");
+    const std::string rawTx = EncodeHexTx(*tx, PROTOCOL_VERSION | SERIALIZE_TRANSACTION_NO_WITNESS);
+    res.pushKVEnd("transaction",rawTx);
+    res.pushKVEnd("blockhash", proofBlock.block.GetHash().GetHex());
+    res.pushKVEnd("header", proofBlock.strHeader);
+    res.pushKVEnd("siblings", siblings);
+    res.pushKVEnd("index", nIndex);
+    res.pushKVEnd("nevm_blockhash", proofBlock.nNEVMBlockHash.GetHex());
+    if(llmq::chainLocksHandler)
+        res.pushKVEnd("chainlock", proofBlock.fChainLock);
+    return res;
+}
+
 static RPCHelpMan syscoingetspvproof()
 {
     return RPCHelpMan{"syscoingetspvproof",
@@ -388,29 +497,18 @@ static RPCHelpMan syscoingetspvproof()
     [&](const RPCHelpMan& self, const node::JSONRPCRequest& request) -> UniValue
 {
     node::NodeContext& node = EnsureAnyNodeContext(request.context);
-    CBlockIndex* pblockindex = nullptr;
-    uint256 hashBlock;
+    const CBlockIndex* pblockindex = nullptr;
     uint256 txhash = ParseHashV(request.params[0], "parameter 1");
-    UniValue res(UniValue::VOBJ);
     {
         LOCK(cs_main);
         if (!request.params[1].isNull()) {
-            hashBlock = ParseHashV(request.params[1], "blockhash");
+            const uint256 hashBlock = ParseHashV(request.params[1], "blockhash");
             pblockindex = node.chainman->m_blockman.LookupBlockIndex(hashBlock);
             if (!pblockindex) {
                 throw JSONRPCError(RPC_INVALID_ADDRESS_OR_KEY, "Block not found");
             }
         } else {
-            const Coin& coin = AccessByTxid(node.chainman->ActiveChainstate().CoinsTip(), txhash);
-            if (!coin.IsSpent()) {
-                pblockindex = node.chainman->ActiveChain()[coin.nHeight];
-            }
-        }
-        if (pblockindex == nullptr) {
-            uint32_t nBlockHeight;
-            if(pblockindexdb != nullptr && pblockindexdb->ReadBlockHeight(txhash, nBlockHeight)) {
-                pblockindex = node.chainman->ActiveChain()[nBlockHeight];
-            }
+            pblockindex = LookupSPVProofBlock(node, txhash);
         }
     }
 
@@ -421,57 +519,81 @@ static RPCHelpMan syscoingetspvproof()
     if(!pblockindex) {
          throw JSONRPCError(RPC_INVALID_ADDRESS_OR_KEY, "Transaction not yet in block");
     }
-    CTransactionRef tx;
-    hashBlock.SetNull();
-    tx = GetTransaction(pblockindex, nullptr, txhash, hashBlock, node.chainman->m_blockman);
-    if(!tx || hashBlock.IsNull())
-        throw JSONRPCError(RPC_INVALID_ADDRESS_OR_KEY, "Transaction not yet in block");
+    SPVProofBlock proofBlock;
+    ReadSPVProofBlock(node, pblockindex, proofBlock);
+    return BuildSPVProof(proofBlock, txhash);
+},
+    };
+}
 
-    CBlock block;
+static RPCHelpMan syscoingetspvproofs()
+{
+    return RPCHelpMan{"syscoingetspvproofs",
+    "\nReturns SPV proofs of many transactions at once for use with inter-chain transfers. Blocks are looked up under a single lock and each block is read once for all the transactions it contains.\n",
+    {
+        {"txids", RPCArg::Type::ARR, RPCArg::Optional::NO, "The transactions to prove",
+            {
+                {"txid", RPCArg::Type::STR_HEX, RPCArg::Optional::OMITTED, "A transaction id"},
+            },
+        },
+    },
+    RPCResult{
+        RPCResult::Type::ARR, "", "One entry per requested txid, in request order",
+        {
+            {RPCResult::Type::OBJ, "", "",
+            {
+                {RPCResult::Type::STR_HEX, "txid", "The requested transaction id"},
+                {RPCResult::Type::ANY, "proof", /*optional=*/true, "The proof as returned by syscoingetspvproof"},
+                {RPCResult::Type::STR, "error", /*optional=*/true, "Why no proof could be built"},
+            }},
+        }},
+    RPCExamples{
+        HelpExampleCli("syscoingetspvproofs", "'[\"txid1\",\"txid2\"]'")
+        + HelpExampleRpc("syscoingetspvproofs", "[\"txid1\",\"txid2\"]")
+    },
+    [&](const RPCHelpMan& self, const node::JSONRPCRequest& request) -> UniValue
+{
+    node::NodeContext& node = EnsureAnyNodeContext(request.context);
+    const UniValue& txids = request.params[0].get_array();
+    std::vector<uint256> vecTxHash;
+    vecTxHash.reserve(txids.size());
+    for (size_t i = 0; i < txids.size(); i++) {
+        vecTxHash.emplace_back(ParseHashV(txids[i], "txid"));
+    }
+    std::vector<const CBlockIndex*> vecBlockIndex(vecTxHash.size(), nullptr);
     {
         LOCK(cs_main);
-        if (node.chainman->m_blockman.IsBlockPruned(pblockindex)) {
-            throw JSONRPCError(RPC_MISC_ERROR, "Block not available (pruned data)");
+        for (size_t i = 0; i < vecTxHash.size(); i++) {
+            vecBlockIndex[i] = LookupSPVProofBlock(node, vecTxHash[i]);
         }
     }
-
-    if (!node.chainman->m_blockman.ReadBlockFromDisk(block, *pblockindex)) {
-        // Block not found on disk. This could be because we have the block
-        // header in our index but don't have the block (for example if a
-        // non-whitelisted node sends us an unrequested long chain of valid
-        // blocks, we add the headers to our index, but don't accept the
-        // block).
-        throw JSONRPCError(RPC_MISC_ERROR, "Block not found on disk");
-    }
-    CDataStream ssBlock(SER_NETWORK, PROTOCOL_VERSION);
-    ssBlock << pblockindex->GetBlockHeader(*node.chainman);
-    const std::string rawTx = EncodeHexTx(*tx, PROTOCOL_VERSION | SERIALIZE_TRANSACTION_NO_WITNESS);
-    res.pushKVEnd("transaction",rawTx);
-    res.pushKVEnd("blockhash", hashBlock.GetHex());
-    const auto bytesVec = MakeUCharSpan(ssBlock);
-    // get first 80 bytes of header (non auxpow part)
-    res.pushKVEnd("header", HexStr(std::vector<unsigned char>(bytesVec.begin(), bytesVec.begin()+80)));
-    UniValue siblings(UniValue::VARR);
-    // store the index of the transaction we are looking for within the block
-    int nIndex = 0;
-    for (unsigned int i = 0;i < block.vtx.size();i++) {
-        const uint256 &txHashFromBlock = block.vtx[i]->GetHash();
-        if(txhash == txHashFromBlock)
-            nIndex = i;
-        siblings.push_back(txHashFromBlock.GetHex());
-    }
-    res.pushKVEnd("siblings", siblings);
-    res.pushKVEnd("index", nIndex);
-    CNEVMHeader evmBlock;
-    BlockValidationState state;
-    if(!GetNEVMData(state, block, evmBlock)) {
-        throw JSONRPCError(RPC_MISC_ERROR, state.ToString());
+    // build the proofs block by block so only one block is held in memory at a time
+    std::vector<size_t> vecOrder(vecTxHash.size());
+    std::iota(vecOrder.begin(), vecOrder.end(), 0);
+    std::stable_sort(vecOrder.begin(), vecOrder.end(), [&](size_t a, size_t b) { return vecBlockIndex[a] < vecBlockIndex[b]; });
+    std::vector<UniValue> vecEntries(vecTxHash.size());
+    const CBlockIndex* pblockindexRead = nullptr;
+    SPVProofBlock proofBlock;
+    for (const size_t i : vecOrder) {
+        UniValue& entry = vecEntries[i];
+        entry.setObject();
+        entry.pushKVEnd("txid", vecTxHash[i].GetHex());
+        try {
+            if(!vecBlockIndex[i])
+                throw JSONRPCError(RPC_INVALID_ADDRESS_OR_KEY, "Transaction not yet in block");
+            if(vecBlockIndex[i] != pblockindexRead) {
+                pblockindexRead = nullptr;
+                proofBlock = SPVProofBlock{};
+                ReadSPVProofBlock(node, vecBlockIndex[i], proofBlock);
+                pblockindexRead = vecBlockIndex[i];
+            }
+            entry.pushKVEnd("proof", BuildSPVProof(proofBlock, vecTxHash[i]));
+        } catch (const UniValue& objError) {
+            entry.pushKVEnd("error", objError.find_value("message").get_str());
+        }
     }
-    std::reverse (evmBlock.nBlockHash.begin (), evmBlock.nBlockHash.end ()); // correct endian
-    res.pushKVEnd("nevm_blockhash", evmBlock.nBlockHash.GetHex());
-    // SYSCOIN
-    if(llmq::chainLocksHandler)
-        res.pushKVEnd("chainlock", llmq::chainLocksHandler->HasChainLock(pblockindex->nHeight, hashBlock));
+    UniValue res(UniValue::VARR);
+    res.push_backV(std::move(vecEntries));
     return res;
 },
     };
@@ -542,6 +664,7 @@ void RegisterNEVMRPCCommands(CRPCTable &t)
 {
     static const CRPCCommand commands[]{
         {"syscoin", &syscoingetspvproof},
+        {"syscoin", &syscoingetspvproofs},
         {"syscoin", &listnevmblobdata},
         {"syscoin", &syscoinstopgeth},
         {"syscoin", &syscoinstartgeth},
@@ -16,7 +16,12 @@
 #include <wallet/rpc/spend.h>
 #include <rpc/server.h>
 #include <wallet/coincontrol.h>
+#include <wallet/fees.h>
+#include <wallet/spend.h>
+#include <policy/policy.h>
 #include <nevm/sha3.h>
+#include <streams.h>
+#include <util/fs.h>
 using namespace wallet;
 
 static RPCHelpMan signmessagebech32()
@@ -82,6 +87,50 @@ static RPCHelpMan signmessagebech32()
 } 
 
 
+// SYSCOIN
+/** Send the PoDA transaction of a blob. The output references the blob instead of holding a copy. */
+static UniValue SendNEVMBlob(CWallet& wallet, const std::vector<uint8_t>& vchVersionHash, std::shared_ptr<const std::vector<uint8_t>> blob)
+{
+    CNEVMData nevmData;
+    nevmData.vchVersionHash = vchVersionHash;
+    std::vector<unsigned char> data;
+    nevmData.SerializeData(data);
+
+    CScript scriptData;
+    scriptData << OP_RETURN << data;
+    CCoinControl coin_control;
+    coin_control.m_version = SYSCOIN_TX_VERSION_NEVM_DATA_SHA3;
+    coin_control.m_nevmdata = std::move(blob);
+    CTxDestination dest;
+    ExtractDestination(scriptData, dest);
+    std::vector<CRecipient> recipient{CRecipient{dest, 0, false}};
+    mapValue_t mapValue;
+    return SendMoney(wallet, coin_control, recipient, mapValue, true);
+}
+
+/** Hash a blob and send it, unless a blob with that version hash is stored already and fOverwrite is not set */
+static UniValue CreateNEVMBlob(CWallet& wallet, std::shared_ptr<const std::vector<uint8_t>> blob, bool fOverwrite)
+{
+    const std::vector<uint8_t> vchVersionHash = dev::sha3(*blob).asBytes();
+    if(pnevmdatadb->BlobExists(vchVersionHash) && !fOverwrite) {
+        UniValue resObj(UniValue::VOBJ);
+        resObj.pushKVEnd("versionhash", HexStr(vchVersionHash));
+        return resObj;
+    }
+    const size_t nSize = blob->size();
+    UniValue resObj = SendNEVMBlob(wallet, vchVersionHash, std::move(blob));
+    if(!resObj.isNull()) {
+        if(!resObj.find_value("txid").isNull()) {
+            resObj.pushKVEnd("versionhash", HexStr(vchVersionHash));
+            resObj.pushKVEnd("datasize", nSize);
+            return resObj;
+        } else {
+            throw JSONRPCError(RPC_DATABASE_ERROR, "Transaction not complete or could not find txid");
+        }
+    }
+    throw JSONRPCError(RPC_DATABASE_ERROR, "Transaction not complete or invalid");
+}
+
 static RPCHelpMan syscoincreaterawnevmblob()
 {
     return RPCHelpMan{"syscoincreaterawnevmblob",
@@ -108,25 +157,11 @@ static RPCHelpMan syscoincreaterawnevmblob()
     pwallet->BlockUntilSyncedToCurrentChain();
 
     EnsureWalletIsUnlocked(*pwallet);
-    CNEVMData nevmData;
-    std::vector<uint8_t> vchData = ParseHex(request.params[1].get_str());
-    if(vchData.empty()) {
+    auto vchData = std::make_shared<const std::vector<uint8_t>>(ParseHex(request.params[1].get_str()));
+    if(vchData->empty()) {
         throw JSONRPCError(RPC_INVALID_PARAMS, "Empty input, are you sure you passed in hex?");  
     }
-    nevmData.vchVersionHash = ParseHex(request.params[0].get_str());
-    std::vector<unsigned char> data;
-    nevmData.SerializeData(data);
-
-    CScript scriptData;
-    scriptData << OP_RETURN << data;
-    CCoinControl coin_control;
-    coin_control.m_version = SYSCOIN_TX_VERSION_NEVM_DATA_SHA3;
-    coin_control.m_nevmdata = vchData;
-    CTxDestination dest;
-    ExtractDestination(scriptData, dest);
-    std::vector<CRecipient> recipient{CRecipient{dest, 0, false}};
-    mapValue_t mapValue;
-    return SendMoney(*pwallet, coin_control, recipient, mapValue, true);
+    return SendNEVMBlob(*pwallet, ParseHex(request.params[0].get_str()), std::move(vchData));
 },
     };
 }
@@ -157,45 +192,217 @@ static RPCHelpMan syscoincreatenevmblob()
     pwallet->BlockUntilSyncedToCurrentChain();
 
     EnsureWalletIsUnlocked(*pwallet);
-    const std::vector<uint8_t> vchData = ParseHex(request.params[0].get_str());
-    if(vchData.empty()) {
+    auto vchData = std::make_shared<const std::vector<uint8_t>>(ParseHex(request.params[0].get_str()));
+    if(vchData->empty()) {
         throw JSONRPCError(RPC_INVALID_PARAMS, "Empty input, are you sure you passed in hex?");  
     }
     bool bOverwrite{false};
     if(request.params.size() > 1) {
         bOverwrite = request.params[1].get_bool();
     }
-    // process new vector in batch checking the blobs
-    BlockValidationState state;
-    const std::vector<uint8_t> vchVersionHash = dev::sha3(vchData).asBytes();
-    if(pnevmdatadb->BlobExists(vchVersionHash) && !bOverwrite) {
-        UniValue resObj(UniValue::VOBJ);
-        resObj.pushKVEnd("versionhash", HexStr(vchVersionHash));
-        return resObj;
+    return CreateNEVMBlob(*pwallet, std::move(vchData), bOverwrite);
+},
+    };
+}
+
+static RPCHelpMan syscoincreatenevmblobfile()
+{
+    return RPCHelpMan{"syscoincreatenevmblobfile",
+        "\nCreate NEVM blob data used by rollups from a file on the node.\n"
+        "The blob is read once into memory and is neither hex encoded nor copied on its way to the transaction.\n",
+        {
+            {"filename", RPCArg::Type::STR, RPCArg::Optional::NO, "The file holding the raw blob (absolute path recommended)"},
+            {"overwrite_existing", RPCArg::Type::BOOL, RPCArg::Default{true}, "true to overwrite an existing blob if it exists, false to return versionhash of data on duplicate."},
+        },
+        RPCResult{RPCResult::Type::ANY, "", ""},
+        RPCExamples{
+            HelpExampleCli("syscoincreatenevmblobfile", "\"/tmp/blob.bin\"")
+            + HelpExampleRpc("syscoincreatenevmblobfile", "\"/tmp/blob.bin\"")
+        },
+    [&](const RPCHelpMan& self, const node::JSONRPCRequest& request) -> UniValue
+{
+    std::shared_ptr<CWallet> const pwallet = GetWalletForJSONRPCRequest(request);
+    if (!pwallet) return NullUniValue;
+    // Make sure the results are valid at least up to the most recent block
+    // the user could have gotten from another RPC command prior to now
+    pwallet->BlockUntilSyncedToCurrentChain();
+
+    EnsureWalletIsUnlocked(*pwallet);
+    const fs::path path = fs::absolute(fs::u8path(request.params[0].get_str()));
+    std::error_code ec;
+    const uintmax_t nSize = fs::file_size(path, ec);
+    if (ec) {
+        throw JSONRPCError(RPC_INVALID_PARAMETER, strprintf("Cannot read blob file %s", fs::PathToString(path)));
+    }
+    if (nSize == 0 || nSize > MAX_NEVM_DATA_BLOB) {
+        throw JSONRPCError(RPC_INVALID_PARAMETER, strprintf("Blob file must hold 1 to %d bytes", MAX_NEVM_DATA_BLOB));
     }
+    std::vector<uint8_t> vchData(nSize);
+    AutoFile file{fsbridge::fopen(path, "rb")};
+    if (file.IsNull()) {
+        throw JSONRPCError(RPC_INVALID_PARAMETER, strprintf("Cannot open blob file %s", fs::PathToString(path)));
+    }
+    try {
+        file.read(MakeWritableByteSpan(vchData));
+    } catch (const std::ios_base::failure&) {
+        throw JSONRPCError(RPC_INVALID_PARAMETER, strprintf("Cannot read blob file %s", fs::PathToString(path)));
+    }
+    const bool bOverwrite{request.params[1].isNull() || request.params[1].get_bool()};
+    return CreateNEVMBlob(*pwallet, std::make_shared<const std::vector<uint8_t>>(std::move(vchData)), bOverwrite);
+},
+    };
+}
 
-    UniValue paramsSend(UniValue::VARR);
-    paramsSend.push_back(HexStr(vchVersionHash));
-    paramsSend.push_back(HexStr(vchData));
-    paramsSend.push_back(request.params[2]);
-    paramsSend.push_back(request.params[3]);
-    paramsSend.push_back(request.params[4]);
-    node::JSONRPCRequest requestSend;
-    requestSend.context = request.context;
-    requestSend.params = paramsSend;
-    requestSend.URI = request.URI;
-    UniValue resObj = syscoincreaterawnevmblob().HandleRequest(requestSend);
-    if(!resObj.isNull()) {
-        if(!resObj.find_value("txid").isNull()) {
-            UniValue resRet(UniValue::VOBJ);
-            resObj.pushKVEnd("versionhash", HexStr(vchVersionHash));
-            resObj.pushKVEnd("datasize", vchData.size());
-            return resObj;
+static RPCHelpMan syscoincreatenevmblobs()
+{
+    return RPCHelpMan{"syscoincreatenevmblobs",
+        "\nCreate several NEVM blobs used by rollups at once.\n"
+        "One funding transaction fans out an output per blob, every blob transaction spends only its own output,\n"
+        "so coin selection runs once for the batch and the blob transactions do not chain on each other's change.\n",
+        {
+            {"blobs", RPCArg::Type::ARR, RPCArg::Optional::NO, strprintf("Up to %d blobs", MAX_DATA_BLOBS),
+                {
+                    {"data", RPCArg::Type::STR_HEX, RPCArg::Optional::OMITTED, "blob in hex"},
+                },
+            },
+            {"overwrite_existing", RPCArg::Type::BOOL, RPCArg::Default{true}, "true to overwrite an existing blob if it exists, false to return versionhash of data on duplicate."},
+        },
+        RPCResult{
+            RPCResult::Type::OBJ, "", "",
+            {
+                {RPCResult::Type::STR_HEX, "fundingtxid", /*optional=*/true, "The transaction funding the blob transactions, if any had to be sent"},
+                {RPCResult::Type::ARR, "blobs", "The blobs in the order given",
+                {
+                    {RPCResult::Type::OBJ, "", "",
+                    {
+                        {RPCResult::Type::STR_HEX, "versionhash", "The version hash of the blob"},
+                        {RPCResult::Type::STR_HEX, "txid", /*optional=*/true, "The blob transaction, unset for a blob stored already"},
+                        {RPCResult::Type::NUM, "datasize", /*optional=*/true, "The size of the blob"},
+                        {RPCResult::Type::STR, "error", /*optional=*/true, "Why the blob transaction could not be sent"},
+                    }},
+                }},
+            }
+        },
+        RPCExamples{
+            HelpExampleCli("syscoincreatenevmblobs", "\"[\\\"data\\\",\\\"data\\\"]\"")
+            + HelpExampleRpc("syscoincreatenevmblobs", "[\"data\",\"data\"]")
+        },
+    [&](const RPCHelpMan& self, const node::JSONRPCRequest& request) -> UniValue
+{
+    std::shared_ptr<CWallet> const pwallet = GetWalletForJSONRPCRequest(request);
+    if (!pwallet) return NullUniValue;
+    // Make sure the results are valid at least up to the most recent block
+    // the user could have gotten from another RPC command prior to now
+    pwallet->BlockUntilSyncedToCurrentChain();
+
+    EnsureWalletIsUnlocked(*pwallet);
+    if (pwallet->IsWalletFlagSet(WALLET_FLAG_DISABLE_PRIVATE_KEYS)) {
+        throw JSONRPCError(RPC_WALLET_ERROR, "Error: Private keys are disabled for this wallet");
+    }
+    const UniValue& blobs = request.params[0].get_array();
+    if (blobs.empty() || blobs.size() > (size_t)MAX_DATA_BLOBS) {
+        throw JSONRPCError(RPC_INVALID_PARAMS, strprintf("Pass 1 to %d blobs", MAX_DATA_BLOBS));
+    }
+    const bool bOverwrite{request.params[1].isNull() || request.params[1].get_bool()};
+
+    struct PendingBlob {
+        std::vector<uint8_t> vchVersionHash;
+        std::shared_ptr<const std::vector<uint8_t>> blob;
+        CAmount nFunding{0};
+        std::optional<COutPoint> outpoint;
+    };
+    std::vector<PendingBlob> vecBlobs;
+    vecBlobs.reserve(blobs.size());
+    for (const UniValue& hex : blobs.getValues()) {
+        auto blob = std::make_shared<const std::vector<uint8_t>>(ParseHexV(hex, "data"));
+        if (blob->empty()) {
+            throw JSONRPCError(RPC_INVALID_PARAMS, "Empty input, are you sure you passed in hex?");
+        }
+        if (blob->size() > (size_t)MAX_NEVM_DATA_BLOB) {
+            throw JSONRPCError(RPC_INVALID_PARAMS, strprintf("Blobs are limited to %d bytes", MAX_NEVM_DATA_BLOB));
+        }
+        vecBlobs.push_back({.vchVersionHash = dev::sha3(*blob).asBytes(), .blob = std::move(blob), .nFunding = 0, .outpoint = std::nullopt});
+    }
+
+    // fund every blob transaction with twice its estimated fee, it returns what it does not pay as change
+    auto op_dest = pwallet->GetNewChangeDestination(pwallet->m_default_change_type.value_or(pwallet->m_default_address_type));
+    if (!op_dest) {
+        throw JSONRPCError(RPC_WALLET_KEYPOOL_RAN_OUT, util::ErrorString(op_dest).original);
+    }
+    const CScript scriptFunding = GetScriptForDestination(*op_dest);
+    const CFeeRate feeRate = GetMinimumFeeRate(*pwallet, CCoinControl{}, /*feeCalc=*/nullptr);
+    const CAmount nDust = GetDustThreshold(CTxOut(0, scriptFunding), pwallet->chain().relayDustFee());
+    std::vector<CRecipient> recipients;
+    for (auto& pending : vecBlobs) {
+        if (!bOverwrite && pnevmdatadb->BlobExists(pending.vchVersionHash)) continue;
+        // one input, change, the data output and its scaled payload
+        const size_t nSize = 300 + pending.blob->size() * NEVM_DATA_SCALE_FACTOR;
+        pending.nFunding = std::max(2 * feeRate.GetFee(nSize), 2 * nDust);
+        recipients.push_back(CRecipient{*op_dest, pending.nFunding, false});
+    }
+
+    UniValue resObj(UniValue::VOBJ);
+    if (!recipients.empty()) {
+        auto res = CreateTransaction(*pwallet, recipients, /*change_pos=*/-1, CCoinControl{}, true);
+        if (!res) {
+            throw JSONRPCError(RPC_WALLET_INSUFFICIENT_FUNDS, util::ErrorString(res).original);
+        }
+        const CTransactionRef& txFunding = res->tx;
+        pwallet->CommitTransaction(txFunding, /*mapValue=*/{}, /*orderForm=*/{});
+        resObj.pushKV("fundingtxid", txFunding->GetHash().GetHex());
+        // hand out the funding outputs, all of them have the funding script and differ by amount only
+        std::vector<bool> vecUsed(txFunding->vout.size(), false);
+        for (auto& pending : vecBlobs) {
+            if (pending.nFunding == 0) continue;
+            for (size_t i = 0; i < txFunding->vout.size(); ++i) {
+                const CTxOut& txout = txFunding->vout[i];
+                if (vecUsed[i] || txout.scriptPubKey != scriptFunding || txout.nValue != pending.nFunding) continue;
+                vecUsed[i] = true;
+                pending.outpoint = COutPoint(txFunding->GetHash(), i);
+                break;
+            }
+        }
+    }
+
+    UniValue arrBlobs(UniValue::VARR);
+    for (auto& pending : vecBlobs) {
+        UniValue blobObj(UniValue::VOBJ);
+        blobObj.pushKV("versionhash", HexStr(pending.vchVersionHash));
+        if (pending.nFunding == 0) {
+            arrBlobs.push_back(blobObj);
+            continue;
+        }
+        blobObj.pushKV("datasize", pending.blob->size());
+        if (!pending.outpoint) {
+            blobObj.pushKV("error", "Funding output not found");
+            arrBlobs.push_back(blobObj);
+            continue;
+        }
+        CNEVMData nevmData;
+        nevmData.vchVersionHash = pending.vchVersionHash;
+        std::vector<unsigned char> data;
+        nevmData.SerializeData(data);
+        CScript scriptData;
+        scriptData << OP_RETURN << data;
+        CTxDestination dest;
+        ExtractDestination(scriptData, dest);
+        CCoinControl coin_control;
+        coin_control.m_version = SYSCOIN_TX_VERSION_NEVM_DATA_SHA3;
+        coin_control.m_nevmdata = std::move(pending.blob);
+        coin_control.Select(*pending.outpoint);
+        coin_control.m_allow_other_inputs = false;
+        std::vector<CRecipient> recipient{CRecipient{dest, 0, false}};
+        auto res = CreateTransaction(*pwallet, recipient, /*change_pos=*/-1, coin_control, true);
+        if (!res) {
+            blobObj.pushKV("error", util::ErrorString(res).original);
         } else {
-            throw JSONRPCError(RPC_DATABASE_ERROR, "Transaction not complete or could not find txid");   
-        }  
+            pwallet->CommitTransaction(res->tx, /*mapValue=*/{}, /*orderForm=*/{});
+            blobObj.pushKV("txid", res->tx->GetHash().GetHex());
+        }
+        arrBlobs.push_back(blobObj);
     }
-    throw JSONRPCError(RPC_DATABASE_ERROR, "Transaction not complete or invalid");
+    resObj.pushKV("blobs", arrBlobs);
+    return resObj;
 },
     };
 }
@@ -387,6 +594,8 @@ Span<const CRPCCommand> wallet::GetNEVMWalletRPCCommands()
         {"syscoinwallet", &signmessagebech32},
         {"syscoinwallet", &syscoincreatenevmblob},
         {"syscoinwallet", &syscoincreaterawnevmblob},
+        {"syscoinwallet", &syscoincreatenevmblobfile},
+        {"syscoinwallet", &syscoincreatenevmblobs},
         /** Auxpow wallet functions */
         {"syscoinwallet", &getauxblock},
     };
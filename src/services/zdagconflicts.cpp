@@ -0,0 +1,50 @@
+// Copyright (c) 2024 The Syscoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <services/zdagconflicts.h>
+
+ZDAGConflictIndex g_zdag_conflicts;
+
+bool ZDAGConflictIndex::TryAdd(const COutPoint& prevout, const CTransactionRef& tx, const CTransactionRef& txConflicting)
+{
+    Shard& shard = GetShard(prevout);
+    LOCK(shard.m_mutex);
+    if (!shard.m_conflicts.try_emplace(prevout, tx, txConflicting).second) return false;
+    m_size.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+void ZDAGConflictIndex::Erase(const COutPoint& prevout)
+{
+    Shard& shard = GetShard(prevout);
+    LOCK(shard.m_mutex);
+    if (shard.m_conflicts.erase(prevout)) {
+        m_size.fetch_sub(1, std::memory_order_relaxed);
+    }
+}
+
+bool ZDAGConflictIndex::Exists(const COutPoint& prevout) const
+{
+    const Shard& shard = GetShard(prevout);
+    LOCK(shard.m_mutex);
+    return shard.m_conflicts.count(prevout) > 0;
+}
+
+bool ZDAGConflictIndex::Exists(const CTransaction& tx) const
+{
+    if (Empty()) return false;
+    for (const CTxIn& txin : tx.vin) {
+        if (Exists(txin.prevout)) return true;
+    }
+    return false;
+}
+
+std::optional<ZDAGConflictIndex::Conflict> ZDAGConflictIndex::Get(const COutPoint& prevout) const
+{
+    const Shard& shard = GetShard(prevout);
+    LOCK(shard.m_mutex);
+    auto it = shard.m_conflicts.find(prevout);
+    if (it == shard.m_conflicts.end()) return std::nullopt;
+    return it->second;
+}
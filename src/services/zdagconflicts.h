@@ -0,0 +1,58 @@
+// Copyright (c) 2024 The Syscoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef SYSCOIN_SERVICES_ZDAGCONFLICTS_H
+#define SYSCOIN_SERVICES_ZDAGCONFLICTS_H
+
+#include <primitives/transaction.h>
+#include <sync.h>
+#include <threadsafety.h>
+#include <util/hasher.h>
+
+#include <array>
+#include <atomic>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+
+/** Number of independently locked shards of the ZDAG conflict index */
+static constexpr size_t ZDAG_CONFLICT_SHARDS{16};
+
+/**
+ * Outpoints double spent by a ZDAG transaction while in the mempool, each
+ * with the two transactions spending it. Point of sale clients poll
+ * assetallocationverifyzdag at a high rate, so the index is not guarded by
+ * cs_main or the mempool lock but split into shards by outpoint, each with
+ * its own mutex. Lookups only contend with writers of the same shard and
+ * never wait for block connection.
+ */
+class ZDAGConflictIndex
+{
+public:
+    using Conflict = std::pair<CTransactionRef, CTransactionRef>;
+
+    /** Record the conflict of prevout if none is known yet, false if there already is one */
+    bool TryAdd(const COutPoint& prevout, const CTransactionRef& tx, const CTransactionRef& txConflicting);
+    void Erase(const COutPoint& prevout);
+    /** Whether any input of tx is double spent */
+    bool Exists(const CTransaction& tx) const;
+    bool Exists(const COutPoint& prevout) const;
+    std::optional<Conflict> Get(const COutPoint& prevout) const;
+    bool Empty() const { return m_size.load(std::memory_order_relaxed) == 0; }
+
+private:
+    struct Shard {
+        mutable Mutex m_mutex;
+        std::unordered_map<COutPoint, Conflict, SaltedOutpointHasher> m_conflicts GUARDED_BY(m_mutex);
+    };
+    const SaltedOutpointHasher m_hasher;
+    std::array<Shard, ZDAG_CONFLICT_SHARDS> m_shards;
+    std::atomic<size_t> m_size{0};
+
+    Shard& GetShard(const COutPoint& prevout) { return m_shards[m_hasher(prevout) % ZDAG_CONFLICT_SHARDS]; }
+    const Shard& GetShard(const COutPoint& prevout) const { return m_shards[m_hasher(prevout) % ZDAG_CONFLICT_SHARDS]; }
+};
+extern ZDAGConflictIndex g_zdag_conflicts;
+
+#endif // SYSCOIN_SERVICES_ZDAGCONFLICTS_H
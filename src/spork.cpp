@@ -26,19 +26,20 @@ std::unique_ptr<CSporkManager> sporkManager;
 
 const std::string SporkStore::SERIALIZATION_VERSION_STRING = "CSporkManager-Version-2";
 
+static std::optional<size_t> GetSporkDefIndex(int32_t nSporkID)
+{
+    for (size_t i = 0; i < sporkDefs.size(); i++) {
+        if (sporkDefs[i].sporkId == nSporkID) return i;
+    }
+    return std::nullopt;
+}
+
 std::optional<int64_t> CSporkManager::SporkValueIfActive(int32_t nSporkID) const
 {
     AssertLockHeld(cs);
 
     if (!mapSporksActive.count(nSporkID)) return std::nullopt;
 
-    {
-        LOCK(cs_mapSporksCachedValues);
-        if (auto it = mapSporksCachedValues.find(nSporkID); it != mapSporksCachedValues.end()) {
-            return {it->second};
-        }
-    }
-
     // calc how many values we have and how many signers vote for every value
     std::unordered_map<int64_t, int> mapValueCounts;
     for (const auto& [_, spork] : mapSporksActive.at(nSporkID)) {
@@ -46,10 +47,6 @@ std::optional<int64_t> CSporkManager::SporkValueIfActive(int32_t nSporkID) const
         if (mapValueCounts.at(spork.nValue) >= nMinSporkKeys) {
             // nMinSporkKeys is always more than the half of the max spork keys number,
             // so there is only one such value and we can stop here
-            {
-                LOCK(cs_mapSporksCachedValues);
-                mapSporksCachedValues[nSporkID] = spork.nValue;
-            }
             return {spork.nValue};
         }
     }
@@ -57,6 +54,24 @@ std::optional<int64_t> CSporkManager::SporkValueIfActive(int32_t nSporkID) const
     return std::nullopt;
 }
 
+void CSporkManager::UpdateSnapshot()
+{
+    AssertLockHeld(cs);
+
+    auto snapshot = std::make_unique<CSporkSnapshot>();
+    for (size_t i = 0; i < sporkDefs.size(); i++) {
+        snapshot->values[i] = SporkValueIfActive(sporkDefs[i].sporkId).value_or(sporkDefs[i].defaultValue);
+    }
+    for (const auto& [nSporkID, _] : mapSporksActive) {
+        if (GetSporkDefIndex(nSporkID)) continue;
+        if (auto opt_sporkValue = SporkValueIfActive(nSporkID)) {
+            snapshot->mapUnknownValues.emplace(nSporkID, *opt_sporkValue);
+        }
+    }
+    m_snapshot.store(snapshot.get(), std::memory_order_release);
+    vecSnapshots.emplace_back(std::move(snapshot));
+}
+
 void SporkStore::Clear()
 {
     LOCK(cs);
@@ -69,6 +84,7 @@ void SporkStore::Clear()
 CSporkManager::CSporkManager() :
     m_db{std::make_unique<db_type>("sporks.dat", "magicSporkCache")}
 {
+    WITH_LOCK(cs, UpdateSnapshot());
 }
 
 CSporkManager::~CSporkManager()
@@ -84,6 +100,8 @@ bool CSporkManager::LoadCache()
     if (is_valid) {
         CheckAndRemove();
     }
+    // loading may have replaced or cleared the spork messages
+    WITH_LOCK(cs, UpdateSnapshot());
     return is_valid;
 }
 
@@ -126,6 +144,8 @@ void CSporkManager::CheckAndRemove()
         }
         ++itByHash;
     }
+
+    UpdateSnapshot();
 }
 
 void CSporkManager::ProcessMessage(CNode* pfrom, const std::string& strCommand, CDataStream& vRecv, CConnman& connman, PeerManager& peerman)
@@ -205,9 +225,7 @@ void CSporkManager::ProcessSpork(CNode* pfrom, CDataStream& vRecv, PeerManager&
         LOCK(cs); // make sure to not lock this together with cs_main
         mapSporksByHash[hash] = spork;
         mapSporksActive[spork.nSporkID][keyIDSigner] = spork;
-        // Clear cached values on new spork being processed
-        WITH_LOCK(cs_mapSporksCachedActive, mapSporksCachedActive.erase(spork.nSporkID));
-        WITH_LOCK(cs_mapSporksCachedValues, mapSporksCachedValues.erase(spork.nSporkID));
+        UpdateSnapshot();
     }
     spork.Relay(peerman);
     {
@@ -249,9 +267,7 @@ bool CSporkManager::UpdateSpork(int32_t nSporkID, int64_t nValue, PeerManager& p
 
         mapSporksByHash[spork.GetHash()] = spork;
         mapSporksActive[nSporkID][*opt_keyIDSigner] = spork;
-        // Clear cached values on new spork being processed
-        WITH_LOCK(cs_mapSporksCachedActive, mapSporksCachedActive.erase(spork.nSporkID));
-        WITH_LOCK(cs_mapSporksCachedValues, mapSporksCachedValues.erase(spork.nSporkID));
+        UpdateSnapshot();
     }
 
     spork.Relay(peerman);
@@ -260,41 +276,40 @@ bool CSporkManager::UpdateSpork(int32_t nSporkID, int64_t nValue, PeerManager& p
 
 bool CSporkManager::IsSporkActive(int32_t nSporkID) const
 {
-    // If nSporkID is cached, and the cached value is true, then return early true
-    {
-        LOCK(cs_mapSporksCachedActive);
-        if (auto it = mapSporksCachedActive.find(nSporkID); it != mapSporksCachedActive.end() && it->second) {
-            return true;
-        }
+    const CSporkSnapshot& snapshot = *m_snapshot.load(std::memory_order_acquire);
+
+    // If the spork was seen active with this snapshot, then return early true
+    const auto opt_index = GetSporkDefIndex(nSporkID);
+    if (opt_index && snapshot.fActive[*opt_index].load(std::memory_order_relaxed)) {
+        return true;
     }
 
-    int64_t nSporkValue = GetSporkValue(nSporkID);
+    int64_t nSporkValue = GetSporkValue(snapshot, nSporkID);
     // Get time is somewhat costly it looks like
     bool ret = nSporkValue < TicksSinceEpoch<std::chrono::seconds>(GetAdjustedTime());
     // Only cache true values
-    if (ret) {
-        LOCK(cs_mapSporksCachedActive);
-        mapSporksCachedActive[nSporkID] = ret;
+    if (ret && opt_index) {
+        snapshot.fActive[*opt_index].store(true, std::memory_order_relaxed);
     }
     return ret;
 }
 
 int64_t CSporkManager::GetSporkValue(int32_t nSporkID) const
 {
-    LOCK(cs);
+    return GetSporkValue(*m_snapshot.load(std::memory_order_acquire), nSporkID);
+}
 
-    if (auto opt_sporkValue = SporkValueIfActive(nSporkID)) {
-        return *opt_sporkValue;
+int64_t CSporkManager::GetSporkValue(const CSporkSnapshot& snapshot, int32_t nSporkID)
+{
+    if (const auto opt_index = GetSporkDefIndex(nSporkID)) {
+        return snapshot.values[*opt_index];
     }
-
-
-    if (auto optSpork = ranges::find_if_opt(sporkDefs,
-                                            [&nSporkID](const auto& sporkDef){return sporkDef.sporkId == nSporkID;})) {
-        return optSpork->defaultValue;
-    } else {
-        LogPrint(BCLog::SPORK, "CSporkManager::GetSporkValue -- Unknown Spork ID %d\n", nSporkID);
-        return -1;
+    if (const auto it = snapshot.mapUnknownValues.find(nSporkID); it != snapshot.mapUnknownValues.end()) {
+        return it->second;
     }
+
+    LogPrint(BCLog::SPORK, "CSporkManager::GetSporkValue -- Unknown Spork ID %d\n", nSporkID);
+    return -1;
 }
 
 int32_t CSporkManager::GetSporkIDByName(std::string_view strName)
@@ -345,6 +360,7 @@ bool CSporkManager::SetMinSporkKeys(int minSporkKeys)
         return false;
     }
     nMinSporkKeys = minSporkKeys;
+    UpdateSnapshot();
     return true;
 }
 
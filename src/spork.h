@@ -15,6 +15,8 @@
 #include <uint256.h>
 
 #include <array>
+#include <atomic>
+#include <memory>
 #include <optional>
 #include <string_view>
 #include <unordered_map>
@@ -144,6 +146,22 @@ public:
     void Relay(PeerManager& peerman) const;
 };
 
+/**
+ * SYSCOIN The effective value of every spork, as agreed upon by the spork signers or the default. It is never
+ * modified once published: accepting a spork message that changes the agreed values publishes a new one, so
+ * reading a value is a single atomic load of the current snapshot.
+ */
+class CSporkSnapshot
+{
+public:
+    // value of each spork in sporkDefs, same order
+    std::array<int64_t, sporkDefs.size()> values{};
+    // agreed values of sporks this node has no definition for
+    std::unordered_map<int32_t, int64_t> mapUnknownValues;
+    // time based sporks only ever turn active, once one was seen active that is remembered
+    mutable std::array<std::atomic<bool>, sporkDefs.size()> fActive{};
+};
+
 class SporkStore
 {
 protected:
@@ -178,6 +196,51 @@ public:
         s >> mapSporksByHash >> mapSporksActive;
     }
 
+    // SYSCOIN records of the sporks cache, one per spork message
+    static constexpr uint8_t RECORD_VERSION{0};
+    static constexpr uint8_t RECORD_SPORK{1};
+    static constexpr uint8_t RECORD_ACTIVE_SPORK{2};
+
+    template<typename Writer>
+    void SerializeRecords(Writer& w) const EXCLUSIVE_LOCKS_REQUIRED(!cs)
+    {
+        LOCK(cs);
+        w.Write(RECORD_VERSION, SERIALIZATION_VERSION_STRING);
+        for (const auto& [hash, spork] : mapSporksByHash) {
+            w.Write(RECORD_SPORK, hash, spork);
+        }
+        for (const auto& [nSporkID, sporks] : mapSporksActive) {
+            for (const auto& [keyid, spork] : sporks) {
+                w.Write(RECORD_ACTIVE_SPORK, nSporkID, keyid, spork);
+            }
+        }
+    }
+
+    template<typename Stream>
+    bool UnserializeRecord(Stream& s) EXCLUSIVE_LOCKS_REQUIRED(!cs)
+    {
+        LOCK(cs);
+        uint8_t nType;
+        s >> nType;
+        if (nType == RECORD_VERSION) {
+            std::string strVersion;
+            s >> strVersion;
+            return strVersion == SERIALIZATION_VERSION_STRING;
+        } else if (nType == RECORD_SPORK) {
+            uint256 hash;
+            CSporkMessage spork;
+            s >> hash >> spork;
+            mapSporksByHash.emplace(hash, spork);
+        } else if (nType == RECORD_ACTIVE_SPORK) {
+            int32_t nSporkID;
+            CKeyID keyid;
+            CSporkMessage spork;
+            s >> nSporkID >> keyid >> spork;
+            mapSporksActive[nSporkID].emplace(keyid, spork);
+        }
+        return true;
+    }
+
     /**
      * Clear is used to clear all in-memory active spork messages. Since spork
      * public and private keys are set in init.cpp, we do not clear them here.
@@ -206,11 +269,10 @@ private:
     const std::unique_ptr<db_type> m_db;
     bool is_valid{false};
 
-    mutable Mutex cs_mapSporksCachedActive;
-    mutable std::unordered_map<int32_t, bool> mapSporksCachedActive GUARDED_BY(cs_mapSporksCachedActive);
-
-    mutable Mutex cs_mapSporksCachedValues;
-    mutable std::unordered_map<int32_t, int64_t> mapSporksCachedValues GUARDED_BY(cs_mapSporksCachedValues);
+    // SYSCOIN the current snapshot, never null. The ones it replaced are kept since readers may still use them,
+    // with sporks changing a few times a year that costs nothing.
+    std::atomic<const CSporkSnapshot*> m_snapshot{nullptr};
+    std::vector<std::unique_ptr<const CSporkSnapshot>> vecSnapshots GUARDED_BY(cs);
 
     std::set<CKeyID> setSporkPubKeyIDs GUARDED_BY(cs);
     int nMinSporkKeys GUARDED_BY(cs) {std::numeric_limits<int>::max()};
@@ -220,7 +282,15 @@ private:
      * SporkValueIfActive is used to get the value agreed upon by the majority
      * of signed spork messages for a given Spork ID.
      */
-    std::optional<int64_t> SporkValueIfActive(int32_t nSporkID) const EXCLUSIVE_LOCKS_REQUIRED(cs, !cs_mapSporksCachedValues);
+    std::optional<int64_t> SporkValueIfActive(int32_t nSporkID) const EXCLUSIVE_LOCKS_REQUIRED(cs);
+
+    /**
+     * UpdateSnapshot publishes the values agreed upon with the current spork messages, it must be
+     * called whenever mapSporksActive or the signer threshold changes.
+     */
+    void UpdateSnapshot() EXCLUSIVE_LOCKS_REQUIRED(cs);
+
+    static int64_t GetSporkValue(const CSporkSnapshot& snapshot, int32_t nSporkID);
 
 public:
     CSporkManager();
@@ -243,7 +313,7 @@ public:
     /**
      * ProcessMessage is used to call ProcessSpork and ProcessGetSporks. See below
      */
-    void ProcessMessage(CNode* pfrom, const std::string& strCommand, CDataStream& vRecv, CConnman& connman, PeerManager& peerman) EXCLUSIVE_LOCKS_REQUIRED(!cs_mapSporksCachedActive, !cs_mapSporksCachedValues);
+    void ProcessMessage(CNode* pfrom, const std::string& strCommand, CDataStream& vRecv, CConnman& connman, PeerManager& peerman) EXCLUSIVE_LOCKS_REQUIRED(!cs);
 
     /**
      * ProcessSpork is used to handle the 'spork' p2p message.
@@ -251,7 +321,7 @@ public:
      * For 'spork', it validates the spork and adds it to the internal spork storage and
      * performs any necessary processing.
      */
-    void ProcessSpork(CNode* pfrom, CDataStream& vRecv, PeerManager& peerman) EXCLUSIVE_LOCKS_REQUIRED(!cs, !cs_mapSporksCachedActive, !cs_mapSporksCachedValues);
+    void ProcessSpork(CNode* pfrom, CDataStream& vRecv, PeerManager& peerman) EXCLUSIVE_LOCKS_REQUIRED(!cs);
 
     /**
      * ProcessGetSporks is used to handle the 'getsporks' p2p message.
@@ -264,7 +334,7 @@ public:
      * UpdateSpork is used by the spork RPC command to set a new spork value, sign
      * and broadcast the spork message.
      */
-    bool UpdateSpork(int32_t nSporkID, int64_t nValue, PeerManager& peerman) EXCLUSIVE_LOCKS_REQUIRED(!cs, !cs_mapSporksCachedActive, !cs_mapSporksCachedValues);
+    bool UpdateSpork(int32_t nSporkID, int64_t nValue, PeerManager& peerman) EXCLUSIVE_LOCKS_REQUIRED(!cs);
 
     /**
      * IsSporkActive returns a bool for time-based sporks, and should be used
@@ -274,13 +344,13 @@ public:
      * instead, and therefore this method doesn't make sense and should not be
      * used.
      */
-    bool IsSporkActive(int32_t nSporkID) const EXCLUSIVE_LOCKS_REQUIRED(!cs_mapSporksCachedActive, !cs_mapSporksCachedValues);
+    bool IsSporkActive(int32_t nSporkID) const;
 
     /**
      * GetSporkValue returns the spork value given a Spork ID. If no active spork
      * message has yet been received by the node, it returns the default value.
      */
-    int64_t GetSporkValue(int32_t nSporkID) const EXCLUSIVE_LOCKS_REQUIRED(!cs, !cs_mapSporksCachedValues);
+    int64_t GetSporkValue(int32_t nSporkID) const;
 
     /**
      * GetSporkIDByName returns the internal Spork ID given the spork name.
@@ -32,7 +32,26 @@ inline void Xor(Span<std::byte> write, Span<const std::byte> key, size_t key_off
     }
     key_offset %= key.size();
 
-    for (size_t i = 0, j = key_offset; i != write.size(); i++) {
+    // SYSCOIN the 8 byte key of the databases is applied a word at a time, dbwrapper values holding
+    // PoDA blobs and masternode lists are large enough for the byte loop to show up in profiles
+    size_t i = 0;
+    if (key.size() == sizeof(uint64_t)) {
+        // the key rotated by the offset, so the word at any multiple of 8 past the start lines up with it
+        std::byte rotated[sizeof(uint64_t)];
+        for (size_t k = 0; k < sizeof(rotated); k++) {
+            rotated[k] = key[(key_offset + k) % key.size()];
+        }
+        uint64_t key_word;
+        memcpy(&key_word, rotated, sizeof(key_word));
+        for (; i + sizeof(uint64_t) <= write.size(); i += sizeof(uint64_t)) {
+            uint64_t word;
+            memcpy(&word, write.data() + i, sizeof(word));
+            word ^= key_word;
+            memcpy(write.data() + i, &word, sizeof(word));
+        }
+    }
+
+    for (size_t j = key_offset; i != write.size(); i++) {
         write[i] ^= key[j++];
 
         // This potentially acts on very many bytes of data, so it's
@@ -227,6 +246,14 @@ public:
         memcpy(dst.data(), m_data.data(), dst.size());
         m_data = m_data.subspan(dst.size());
     }
+    // SYSCOIN
+    void ignore(size_t num_ignore)
+    {
+        if (num_ignore > m_data.size()) {
+            throw std::ios_base::failure("SpanReader::ignore(): end of data");
+        }
+        m_data = m_data.subspan(num_ignore);
+    }
 };
 
 /** Double ended buffer combining vector and stream-like interfaces.
@@ -275,6 +302,8 @@ public:
     bool empty() const                               { return vch.size() == m_read_pos; }
     void resize(size_type n, value_type c = value_type{}) { vch.resize(n + m_read_pos, c); }
     void reserve(size_type n)                        { vch.reserve(n + m_read_pos); }
+    // SYSCOIN
+    size_type capacity() const                       { return vch.capacity(); }
     const_reference operator[](size_type pos) const  { return vch[pos + m_read_pos]; }
     reference operator[](size_type pos)              { return vch[pos + m_read_pos]; }
     void clear()                                     { vch.clear(); m_read_pos = 0; }
@@ -36,25 +36,414 @@
 #include <functional>
 #include <iosfwd>
 // SYSCOIN
+#include <addrman.h>
+#include <banman.h>
+#include <bls/bls.h>
+#include <consensus/tx_verify.h>
+#include <deploymentstatus.h>
+#include <evo/deterministicmns.h>
+#include <evo/specialtx.h>
+#include <llmq/quorums_commitment.h>
+#include <llmq/quorums_utils.h>
 #include <net.h>
 #include <net_processing.h>
-#include <banman.h>
+#include <netgroup.h>
+#include <script/script_error.h>
+#include <services/assetconsensus.h>
+#include <tinyformat.h>
+#include <txmempool.h>
+#include <undo.h>
+#include <util/strencodings.h>
+#include <util/system.h>
+#include <util/time.h>
+
+#include <algorithm>
+#include <atomic>
+#include <limits>
 #include <memory>
 #include <string>
+#include <thread>
+#include <vector>
+
+// SYSCOIN
+// Offline re-validation of the active chain, see -revalidate in the usage below.
+// Every block is read back with its undo data and checked again on its own: the
+// undo data holds the coins it spent, so blocks do not depend on each other and
+// the context-free and input checks run on all cores. The checks that need the
+// masternode list and quorum state go through cs_main one block at a time.
+
+/** Work done by one stage of the re-validation, summed over the worker threads */
+struct RevalidationStage {
+    const char* name;
+    const char* unit;
+    std::atomic<uint64_t> items{0};
+    std::atomic<int64_t> nanos{0};
+};
+
+struct RevalidationFailure {
+    int height;
+    uint256 hash;
+    std::string stage;
+    std::string reason;
+};
+
+static constexpr size_t MAX_REVALIDATION_FAILURES{100};
+
+class RevalidationTimer
+{
+    RevalidationStage& m_stage;
+    const SteadyClock::time_point m_start{SteadyClock::now()};
+    uint64_t m_items{0};
+
+public:
+    explicit RevalidationTimer(RevalidationStage& stage) : m_stage(stage) {}
+    ~RevalidationTimer()
+    {
+        m_stage.items += m_items;
+        m_stage.nanos += Ticks<std::chrono::nanoseconds>(SteadyClock::now() - m_start);
+    }
+    void Add(uint64_t items) { m_items += items; }
+};
+
+static int Revalidate(ChainstateManager& chainman, int start_height, int end_height, int num_threads)
+{
+    const Consensus::Params& consensus{chainman.GetConsensus()};
+    Chainstate& chainstate{chainman.ActiveChainstate()};
+    {
+        LOCK(::cs_main);
+        end_height = std::min(end_height, chainman.ActiveHeight());
+    }
+    if (start_height > end_height) {
+        std::cerr << "Nothing to re-validate, the active chain ends at height " << end_height << std::endl;
+        return 1;
+    }
+    // commitments and masternode payloads are (de)serialized with the BLS scheme picked for the tip
+    const bool legacy_bls{bls::bls_legacy_scheme.load()};
+
+    RevalidationStage read{"read", "blocks"};
+    RevalidationStage block_checks{"block", "txs"};
+    RevalidationStage nevm{"nevm", "blocks"};
+    RevalidationStage inputs{"inputs", "txs"};
+    RevalidationStage mints{"mints", "proofs"};
+    RevalidationStage scripts{"scripts", "inputs"};
+    RevalidationStage special{"special", "blocks"};
+    RevalidationStage* const stages[]{&read, &block_checks, &nevm, &inputs, &mints, &scripts, &special};
+
+    std::atomic<int> next_height{start_height};
+    std::atomic<int> blocks_done{0};
+    std::atomic<uint64_t> unverifiable{0};
+    std::atomic<uint64_t> num_failures{0};
+    Mutex failures_mutex;
+    std::vector<RevalidationFailure> failures;
+
+    const auto worker = [&] {
+        for (int height = next_height++; height <= end_height; height = next_height++) {
+            const CBlockIndex* pindex{WITH_LOCK(::cs_main, return chainman.ActiveChain()[height])};
+            const auto fail = [&](const char* stage, const std::string& reason) {
+                ++num_failures;
+                LOCK(failures_mutex);
+                if (failures.size() < MAX_REVALIDATION_FAILURES) {
+                    failures.push_back({height, pindex->GetBlockHash(), stage, reason});
+                }
+            };
+            const int done{++blocks_done};
+            if (done % 10000 == 0) {
+                LOCK(failures_mutex);
+                std::cout << "Checking block " << done << " of " << (end_height - start_height + 1) << std::endl;
+            }
+
+            CBlock block;
+            CBlockUndo block_undo;
+            {
+                RevalidationTimer timer{read};
+                // PoDA blobs are not committed to by the block, their payloads are not needed
+                if (!chainman.m_blockman.ReadBlockFromDisk(block, *pindex, /*fFillNEVMData=*/false)) {
+                    fail("read", "block not found on disk");
+                    continue;
+                }
+                if (height > 0 && !chainman.m_blockman.UndoReadFromDisk(block_undo, *pindex)) {
+                    fail("read", "undo data not found on disk");
+                    continue;
+                }
+                timer.Add(1);
+            }
+
+            {
+                RevalidationTimer timer{block_checks};
+                BlockValidationState state;
+                if (block.GetHash() != pindex->GetBlockHash()) {
+                    fail("block", "hash mismatch");
+                    continue;
+                }
+                if (!CheckBlock(block, state, consensus)) {
+                    fail("block", state.ToString());
+                    continue;
+                }
+                timer.Add(block.vtx.size());
+            }
+            if (height == 0) continue;
+
+            // the roots stored when the block was connected stand in for Geth: the commitment in
+            // the coinbase has to name them, which is what the mint proofs are then checked against
+            if (height >= consensus.nNEVMStartBlock) {
+                RevalidationTimer timer{nevm};
+                BlockValidationState state;
+                CNEVMHeader nevm_header;
+                NEVMTxRoot roots;
+                if (!GetNEVMData(state, block, nevm_header)) {
+                    fail("nevm", state.ToString());
+                } else if (!pnevmtxrootsdb->ReadTxRoots(nevm_header.nBlockHash, roots)) {
+                    fail("nevm", "no tx roots stored for NEVM block " + nevm_header.nBlockHash.GetHex());
+                } else if (roots.nTxRoot != nevm_header.nTxRoot || roots.nReceiptRoot != nevm_header.nReceiptRoot) {
+                    fail("nevm", "tx roots mismatch for NEVM block " + nevm_header.nBlockHash.GetHex());
+                } else {
+                    timer.Add(1);
+                }
+            }
+
+            // the coins spent by the block, intra-block spends included, come from its undo data
+            CCoinsView view_dummy;
+            CCoinsViewCache view{&view_dummy};
+            for (size_t i = 1; i < block.vtx.size(); ++i) {
+                const CTransaction& tx{*block.vtx[i]};
+                const CTxUndo& tx_undo{block_undo.vtxundo[i - 1]};
+                for (size_t j = 0; j < tx.vin.size(); ++j) {
+                    view.AddCoin(tx.vin[j].prevout, Coin{tx_undo.vprevout[j]}, /*possible_overwrite=*/true);
+                }
+            }
+            const unsigned int flags{GetBlockScriptFlags(*pindex, chainman)};
+
+            std::vector<CMintProofCheck> mint_checks;
+            {
+                RevalidationTimer timer{inputs};
+                const unsigned int lock_time_flags{DeploymentActiveAt(*pindex, chainman, Consensus::DEPLOYMENT_CSV) ? LOCKTIME_VERIFY_SEQUENCE : 0};
+                NEVMMintTxSet mint_txs;
+                CAmount fees{0};
+                int64_t sigops_cost{0};
+                std::vector<int> prev_heights;
+                std::string reason;
+                for (const auto& tx : block.vtx) {
+                    sigops_cost += GetTransactionSigOpCost(*tx, view, flags);
+                    if (tx->IsCoinBase()) continue;
+                    TxValidationState tx_state;
+                    CAmount tx_fee{0};
+                    CAssetsMap asset_in;
+                    CAssetsMap asset_out;
+                    // the minted tx database already holds the mints of this block
+                    if (!Consensus::CheckTxInputs(*tx, tx_state, view, height, tx_fee, asset_in, asset_out) ||
+                        !CheckSyscoinInputs(consensus, *tx, tx->GetHash(), tx_state, height, /*fJustCheck=*/true, mint_txs, asset_in, asset_out, &mint_checks, /*fCheckMinted=*/false)) {
+                        reason = tx->GetHash().ToString() + ": " + tx_state.ToString();
+                        break;
+                    }
+                    fees += tx_fee;
+                    prev_heights.resize(tx->vin.size());
+                    for (size_t j = 0; j < tx->vin.size(); ++j) {
+                        prev_heights[j] = view.AccessCoin(tx->vin[j].prevout).nHeight;
+                    }
+                    if (!SequenceLocks(*tx, lock_time_flags, prev_heights, *pindex)) {
+                        reason = tx->GetHash().ToString() + ": bad-txns-nonfinal";
+                        break;
+                    }
+                    timer.Add(1);
+                }
+                if (reason.empty() && !MoneyRange(fees)) reason = "bad-txns-accumulated-fee-outofrange";
+                if (reason.empty() && sigops_cost > MAX_BLOCK_SIGOPS_COST) reason = "bad-blk-sigops";
+                if (!reason.empty()) {
+                    fail("inputs", reason);
+                    continue;
+                }
+            }
+
+            {
+                RevalidationTimer timer{mints};
+                for (const CMintProofCheck& check : mint_checks) {
+                    if (!check()) {
+                        fail("mints", "bad-mint-proof");
+                        break;
+                    }
+                    timer.Add(1);
+                }
+            }
+
+            {
+                RevalidationTimer timer{scripts};
+                bool scripts_ok{true};
+                for (size_t i = 1; i < block.vtx.size() && scripts_ok; ++i) {
+                    const CTransaction& tx{*block.vtx[i]};
+                    const CTxUndo& tx_undo{block_undo.vtxundo[i - 1]};
+                    std::vector<CTxOut> spent_outputs;
+                    spent_outputs.reserve(tx_undo.vprevout.size());
+                    for (const Coin& coin : tx_undo.vprevout) {
+                        spent_outputs.emplace_back(coin.out);
+                    }
+                    PrecomputedTransactionData txdata;
+                    txdata.Init(tx, std::move(spent_outputs));
+                    for (size_t j = 0; j < tx.vin.size(); ++j) {
+                        CScriptCheck check{tx_undo.vprevout[j].out, tx, static_cast<unsigned int>(j), flags, /*cacheIn=*/false, &txdata};
+                        if (!check()) {
+                            fail("scripts", strprintf("%s input %u: %s", tx.GetHash().ToString(), j, ScriptErrorString(check.GetScriptError())));
+                            scripts_ok = false;
+                            break;
+                        }
+                        timer.Add(1);
+                    }
+                }
+            }
+
+            if (height >= consensus.DIP0003Height) {
+                RevalidationTimer timer{special};
+                if (llmq::CLLMQUtils::IsV19Active(pindex->pprev->nHeight) == legacy_bls) {
+                    ++unverifiable;
+                } else {
+                    LOCK(::cs_main);
+                    // masternode collaterals can be outputs of any earlier block, what is still unspent
+                    // comes from the UTXO set, the rest can not be looked up offline
+                    CCoinsViewCache special_view{&chainstate.CoinsDB()};
+                    for (size_t i = 1; i < block.vtx.size(); ++i) {
+                        const CTransaction& tx{*block.vtx[i]};
+                        for (size_t j = 0; j < tx.vin.size(); ++j) {
+                            special_view.AddCoin(tx.vin[j].prevout, Coin{block_undo.vtxundo[i - 1].vprevout[j]}, /*possible_overwrite=*/true);
+                        }
+                    }
+                    for (const auto& tx : block.vtx) {
+                        AddCoins(special_view, *tx, height, /*check=*/false);
+                    }
+
+                    std::string reason;
+                    bool missing_collateral{false};
+                    for (const auto& tx : block.vtx) {
+                        if (!IsMasternodeTx(tx->nVersion) || tx->nVersion == SYSCOIN_TX_VERSION_MN_QUORUM_COMMITMENT) continue;
+                        TxValidationState tx_state;
+                        if (!CheckSpecialTx(chainman.m_blockman, *tx, pindex->pprev, tx_state, special_view, /*fJustCheck=*/true, /*check_sigs=*/true)) {
+                            missing_collateral = tx_state.GetRejectReason() == "bad-protx-collateral";
+                            reason = tx->GetHash().ToString() + ": " + tx_state.ToString();
+                            break;
+                        }
+                    }
+
+                    llmq::CFinalCommitmentTxPayload qc_tx;
+                    BlockValidationState state;
+                    if (reason.empty() && block.vtx[0]->nVersion == SYSCOIN_TX_VERSION_MN_QUORUM_COMMITMENT &&
+                        (!GetTxPayload(*block.vtx[0], qc_tx) || qc_tx.nHeight != static_cast<uint32_t>(height))) {
+                        reason = "bad-qc-payload";
+                    }
+                    if (reason.empty() && !qc_tx.IsNull()) {
+                        const llmq::CFinalCommitment& qc{qc_tx.commitment};
+                        const CBlockIndex* base{chainman.m_blockman.LookupBlockIndex(qc.quorumHash)};
+                        if (qc.IsNull()) {
+                            if (!qc.VerifyNull()) reason = "bad-qc-invalid-null";
+                        } else if (!base || pindex->GetAncestor(base->nHeight) != base) {
+                            reason = "bad-qc-block-index";
+                        } else if (!qc.Verify(base, /*checkSigs=*/true)) {
+                            reason = "bad-qc-invalid";
+                        }
+                    }
+
+                    CDeterministicMNList new_list;
+                    CDeterministicMNList old_list;
+                    if (reason.empty() && !deterministicMNManager->BuildNewListFromBlock(block, pindex->pprev, state, special_view, new_list, old_list, qc_tx)) {
+                        missing_collateral = state.GetRejectReason() == "bad-protx-collateral";
+                        reason = state.ToString();
+                    }
+                    if (reason.empty()) {
+                        CDeterministicMNListDiff diff;
+                        CDeterministicMNListNEVMAddressDiff diff_nevm;
+                        new_list.BuildDiff(deterministicMNManager->GetListForBlock(pindex), diff, diff_nevm);
+                        if (diff.HasChanges()) reason = "masternode list differs from the stored one";
+                    }
+
+                    if (missing_collateral) {
+                        ++unverifiable;
+                    } else if (!reason.empty()) {
+                        fail("special", reason);
+                    } else {
+                        timer.Add(1);
+                    }
+                }
+            }
+        }
+    };
+
+    std::cout << "Re-validating blocks " << start_height << " to " << end_height << " on " << num_threads << " threads" << std::endl;
+    const auto start_time{SteadyClock::now()};
+    std::vector<std::thread> threads;
+    for (int i = 0; i < num_threads; ++i) {
+        threads.emplace_back(util::TraceThread, strprintf("reval.%i", i), worker);
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    const double wall_seconds{Ticks<SecondsDouble>(SteadyClock::now() - start_time)};
+
+    std::cout << strprintf("Checked %d blocks in %.1f s", blocks_done.load(), wall_seconds) << std::endl
+              << strprintf("%-8s %12s %-7s %12s %14s %14s", "stage", "items", "", "thread s", "per thread s", "per s") << std::endl;
+    for (const RevalidationStage* stage : stages) {
+        const double thread_seconds{stage->nanos.load() / 1e9};
+        std::cout << strprintf("%-8s %12u %-7s %12.2f %14.0f %14.0f", stage->name, stage->items.load(), stage->unit, thread_seconds,
+                               thread_seconds > 0 ? stage->items.load() / thread_seconds : 0.0,
+                               wall_seconds > 0 ? stage->items.load() / wall_seconds : 0.0) << std::endl;
+    }
+    if (unverifiable > 0) {
+        std::cout << unverifiable.load() << " blocks with masternode checks that can not be run offline (spent collateral or other BLS scheme)" << std::endl;
+    }
+    LOCK(failures_mutex);
+    std::sort(failures.begin(), failures.end(), [](const auto& a, const auto& b) { return a.height < b.height; });
+    for (const RevalidationFailure& failure : failures) {
+        std::cerr << strprintf("FAILED %d %s [%s] %s", failure.height, failure.hash.ToString(), failure.stage, failure.reason) << std::endl;
+    }
+    if (num_failures > 0) {
+        std::cerr << num_failures.load() << " failures" << (num_failures > failures.size() ? strprintf(", the first %u shown", failures.size()) : "") << std::endl;
+        return 1;
+    }
+    return 0;
+}
 
 int main(int argc, char* argv[])
 {
     // SETUP: Argument parsing and handling
-    if (argc != 2) {
+    // SYSCOIN
+    bool revalidate{false};
+    int revalidate_start{1};
+    int revalidate_end{std::numeric_limits<int>::max()};
+    int num_threads{std::max(GetNumCores(), 1)};
+    bool args_ok{argc >= 2};
+    for (int i = 1; i < argc - 1 && args_ok; ++i) {
+        const std::string arg{argv[i]};
+        if (arg == "-revalidate") {
+            revalidate = true;
+        } else if (arg.rfind("-revalidate=", 0) == 0) {
+            revalidate = true;
+            const std::string range{arg.substr(12)};
+            const size_t colon{range.find(':')};
+            const auto start{ToIntegral<int>(range.substr(0, colon))};
+            const auto end{colon == std::string::npos ? std::optional<int>{revalidate_end} : ToIntegral<int>(range.substr(colon + 1))};
+            args_ok = start && end && *start >= 0 && *end >= *start;
+            if (args_ok) {
+                revalidate_start = *start;
+                revalidate_end = *end;
+            }
+        } else if (arg.rfind("-par=", 0) == 0) {
+            const auto par{ToIntegral<int>(arg.substr(5))};
+            args_ok = par && *par > 0;
+            if (args_ok) num_threads = *par;
+        } else {
+            args_ok = false;
+        }
+    }
+    if (!args_ok) {
         std::cerr
-            << "Usage: " << argv[0] << " DATADIR" << std::endl
+            << "Usage: " << argv[0] << " [-revalidate[=START[:END]]] [-par=N] DATADIR" << std::endl
             << "Display DATADIR information, and process hex-encoded blocks on standard input." << std::endl
             << std::endl
+            << "With -revalidate, check the blocks of the active chain from START (default 1) to END" << std::endl
+            << "(default the tip) again from disk on N threads (default all cores), and report the" << std::endl
+            << "throughput of every stage and the blocks that fail." << std::endl
+            << std::endl
             << "IMPORTANT: THIS EXECUTABLE IS EXPERIMENTAL, FOR TESTING ONLY, AND EXPECTED TO" << std::endl
             << "           BREAK IN FUTURE VERSIONS. DO NOT USE ON YOUR ACTUAL DATADIR." << std::endl;
         return 1;
     }
-    std::filesystem::path abs_datadir = std::filesystem::absolute(argv[1]);
+    std::filesystem::path abs_datadir = std::filesystem::absolute(argv[argc - 1]);
     std::filesystem::create_directories(abs_datadir);
 
 
@@ -135,18 +524,22 @@ int main(int argc, char* argv[])
         .notifications = chainman_opts.notifications,
     };
     ChainstateManager chainman{kernel_context.interrupt, chainman_opts, blockman_opts};
-    // SYSCOIN
-    std::unique_ptr<CConnman> connman;
-    std::unique_ptr<PeerManager> peerman;
-    std::unique_ptr<BanMan> banman;
+    // SYSCOIN the LLMQ system is wired to the network objects, they are never started here
+    NetGroupManager netgroupman{{}};
+    AddrMan addrman{netgroupman, /*deterministic=*/false, /*consistency_check_ratio=*/0};
+    CConnman connman{GetRand<uint64_t>(), GetRand<uint64_t>(), addrman, netgroupman, *chainparams, /*network_active=*/false};
+    BanMan banman{fs::path{abs_datadir / "banlist"}, nullptr, DEFAULT_MISBEHAVING_BANTIME};
+    CTxMemPool mempool{CTxMemPool::Options{}};
+    auto peerman = PeerManager::make(connman, addrman, &banman, chainman, mempool, PeerManager::Options{});
+    int revalidate_result{0};
     node::CacheSizes cache_sizes;
     cache_sizes.block_tree_db = 2 << 20;
     cache_sizes.coins_db = 2 << 22;
     cache_sizes.coins = (450 << 20) - (2 << 20) - (2 << 22);
     node::ChainstateLoadOptions options;
-    options.connman = Assert(connman.get());
-    options.banman =  Assert(banman.get());
-    options.peerman = Assert(peerman.get());
+    options.connman = &connman;
+    options.banman = &banman;
+    options.peerman = peerman.get();
     options.check_interrupt = [] { return false; };
     auto [status, error] = node::LoadChainstate(chainman, cache_sizes, options);
     if (status != node::ChainstateLoadStatus::SUCCESS) {
@@ -186,6 +579,12 @@ int main(int argc, char* argv[])
         }
     }
 
+    // SYSCOIN
+    if (revalidate) {
+        revalidate_result = Revalidate(chainman, revalidate_start, revalidate_end, num_threads);
+        goto epilogue;
+    }
+
     for (std::string line; std::getline(std::cin, line);) {
         if (line.empty()) {
             std::cerr << "Empty line found" << std::endl;
@@ -322,4 +721,6 @@ epilogue:
         }
     }
     GetMainSignals().UnregisterBackgroundSignalScheduler();
+    // SYSCOIN
+    return revalidate_result;
 }
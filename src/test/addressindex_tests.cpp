@@ -0,0 +1,94 @@
+// Copyright (c) 2024 The Syscoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <addresstype.h>
+#include <index/addressindex.h>
+#include <interfaces/chain.h>
+#include <test/util/index.h>
+#include <test/util/setup_common.h>
+#include <validation.h>
+
+#include <boost/test/unit_test.hpp>
+
+BOOST_AUTO_TEST_SUITE(addressindex_tests)
+
+BOOST_FIXTURE_TEST_CASE(addressindex_initial_sync, TestChain100Setup)
+{
+    AddressIndex addressindex(interfaces::MakeChain(m_node), 1 << 20, true);
+    BOOST_REQUIRE(addressindex.Init());
+
+    // BlockUntilSyncedToCurrentChain should return false before addressindex is started.
+    BOOST_CHECK(!addressindex.BlockUntilSyncedToCurrentChain());
+
+    BOOST_REQUIRE(addressindex.StartBackgroundSync());
+
+    // Allow address index to catch up with the block index.
+    IndexWaitSynced(addressindex);
+
+    // The setup mined 100 blocks to a P2PK script.
+    const CScript p2pk_script = CScript() << ToByteVector(coinbaseKey.GetPubKey()) << OP_CHECKSIG;
+    AddressIndexQuery all;
+    const auto history = addressindex.GetHistory(p2pk_script, all);
+    BOOST_CHECK_EQUAL(history.size(), 100U);
+    CAmount nReceived{0};
+    for (const auto& delta : history) {
+        BOOST_CHECK(!delta.fSpending);
+        BOOST_CHECK_EQUAL(delta.nAsset, 0U);
+        nReceived += delta.nAmount;
+    }
+    BOOST_CHECK_EQUAL(history.front().nHeight, 1);
+    BOOST_CHECK_EQUAL(history.back().nHeight, 100);
+    BOOST_CHECK_EQUAL(addressindex.GetUnspent(p2pk_script, all).size(), 100U);
+    auto balances = addressindex.GetBalances(p2pk_script);
+    BOOST_REQUIRE_EQUAL(balances.size(), 1U);
+    BOOST_CHECK_EQUAL(balances[0].nBalance, nReceived);
+    BOOST_CHECK_EQUAL(balances[0].nReceived, nReceived);
+
+    // Pages and height ranges.
+    AddressIndexQuery page;
+    page.nStartHeight = 10;
+    page.nEndHeight = 20;
+    page.nSkip = 2;
+    page.nCount = 5;
+    const auto history_page = addressindex.GetHistory(p2pk_script, page);
+    BOOST_REQUIRE_EQUAL(history_page.size(), 5U);
+    BOOST_CHECK_EQUAL(history_page.front().nHeight, 12);
+    BOOST_CHECK_EQUAL(history_page.back().nHeight, 16);
+    page.nAsset = 1;
+    BOOST_CHECK(addressindex.GetHistory(p2pk_script, page).empty());
+
+    // The index follows new blocks, spends included.
+    const CScript p2pkh_script = GetScriptForDestination(PKHash(coinbaseKey.GetPubKey()));
+    const CAmount nSpendValue{m_coinbase_txns[0]->vout[0].nValue};
+    const CMutableTransaction spend = CreateValidMempoolTransaction(m_coinbase_txns[0], 0, 1, coinbaseKey, p2pkh_script, nSpendValue - 10000, /*submit=*/false);
+    const CBlock& block = CreateAndProcessBlock({spend}, p2pkh_script);
+    BOOST_CHECK(addressindex.BlockUntilSyncedToCurrentChain());
+    BOOST_CHECK_EQUAL(addressindex.GetSummary().best_block_hash, block.GetHash());
+
+    balances = addressindex.GetBalances(p2pk_script);
+    BOOST_REQUIRE_EQUAL(balances.size(), 1U);
+    BOOST_CHECK_EQUAL(balances[0].nBalance, nReceived - nSpendValue);
+    BOOST_CHECK_EQUAL(balances[0].nReceived, nReceived);
+    BOOST_CHECK_EQUAL(addressindex.GetUnspent(p2pk_script, all).size(), 99U);
+    const auto spent_history = addressindex.GetHistory(p2pk_script, all);
+    BOOST_REQUIRE_EQUAL(spent_history.size(), 101U);
+    BOOST_CHECK(spent_history.back().fSpending);
+    BOOST_CHECK_EQUAL(spent_history.back().nHeight, 101);
+    BOOST_CHECK_EQUAL(spent_history.back().nAmount, -nSpendValue);
+
+    const auto p2pkh_unspent = addressindex.GetUnspent(p2pkh_script, all);
+    BOOST_REQUIRE_EQUAL(p2pkh_unspent.size(), 2U);
+    balances = addressindex.GetBalances(p2pkh_script);
+    BOOST_REQUIRE_EQUAL(balances.size(), 1U);
+    BOOST_CHECK_EQUAL(balances[0].nBalance, p2pkh_unspent[0].nValue + p2pkh_unspent[1].nValue);
+
+    // It is not safe to stop and destroy the index until it finishes handling
+    // the last BlockConnected notification.
+    SyncWithValidationInterfaceQueue();
+
+    // shutdown sequence (c.f. Shutdown() in init.cpp)
+    addressindex.Stop();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
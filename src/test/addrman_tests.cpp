@@ -1117,4 +1117,39 @@ BOOST_AUTO_TEST_CASE(addrman_size)
     BOOST_CHECK_EQUAL(addrman->Size(/*net=*/std::nullopt, /*in_new=*/false), 1U);
 }
 
+// SYSCOIN
+BOOST_AUTO_TEST_CASE(addrinfo_arena)
+{
+    AddrInfoArena arena;
+    const auto make_info = [](uint16_t port) {
+        return AddrInfo{CAddress{ResolveService("250.1.1.1", port), NODE_NONE}, ResolveIP("250.1.1.1")};
+    };
+    BOOST_CHECK_EQUAL(arena.Insert(make_info(1)), 0);
+    BOOST_CHECK_EQUAL(arena.Insert(make_info(2)), 1);
+    BOOST_CHECK_EQUAL(arena.Insert(make_info(3)), 2);
+    BOOST_CHECK_EQUAL(arena.size(), 3U);
+
+    // freed ids are reused and skipped while iterating
+    arena.erase(1);
+    BOOST_CHECK_EQUAL(arena.size(), 2U);
+    BOOST_CHECK(arena.find(1) == arena.end());
+    BOOST_CHECK_EQUAL(arena.count(1), 0U);
+    BOOST_CHECK_THROW(arena.at(1), std::out_of_range);
+    std::vector<int> ids;
+    for (const auto& [id, info] : arena) ids.push_back(id);
+    BOOST_CHECK(ids == std::vector<int>({0, 2}));
+    BOOST_CHECK_EQUAL(arena.Insert(make_info(4)), 1);
+    BOOST_CHECK_EQUAL(arena.at(1).GetPort(), 4);
+    BOOST_CHECK_EQUAL(arena.find(2)->second.GetPort(), 3);
+
+    // operator[] creates entries past the end, the ids in between become free
+    arena[5] = make_info(5);
+    BOOST_CHECK_EQUAL(arena.size(), 4U);
+    BOOST_CHECK_EQUAL(arena.count(4), 0U);
+    arena[4] = make_info(6);
+    BOOST_CHECK_EQUAL(arena.Insert(make_info(7)), 3);
+    BOOST_CHECK_EQUAL(arena.Insert(make_info(8)), 6);
+    BOOST_CHECK_EQUAL(arena.size(), 7U);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
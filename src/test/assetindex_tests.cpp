@@ -0,0 +1,137 @@
+// Copyright (c) 2024 The Syscoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <addresstype.h>
+#include <chainparams.h>
+#include <index/assetindex.h>
+#include <interfaces/chain.h>
+#include <test/util/index.h>
+#include <test/util/setup_common.h>
+#include <test/util/transaction_utils.h>
+#include <txmempool.h>
+#include <validation.h>
+
+#include <boost/test/unit_test.hpp>
+
+namespace {
+
+CAmount SumAssetValue(const std::vector<AssetIndexOutput>& vOutputs)
+{
+    CAmount nTotal{0};
+    for (const auto& output : vOutputs) nTotal += output.nAssetValue;
+    return nTotal;
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(assetindex_tests)
+
+// assets can be created from the nexus start block on, which TestChainDIP3Setup is right below
+BOOST_FIXTURE_TEST_CASE(assetindex_transfers, TestChainDIP3Setup)
+{
+    AssetIndex assetindex(interfaces::MakeChain(m_node), 1 << 20, true);
+    BOOST_REQUIRE(assetindex.Init());
+    BOOST_REQUIRE(assetindex.StartBackgroundSync());
+    IndexWaitSynced(assetindex);
+
+    const uint64_t nAsset = Params().GetConsensus().nSYSXAsset;
+    const CScript coinbase_script = CScript() << ToByteVector(coinbaseKey.GetPubKey()) << OP_CHECKSIG;
+    const CScript script_a = GetScriptForDestination(PKHash(coinbaseKey.GetPubKey()));
+    const CScript script_b = GetScriptForDestination(WitnessV0KeyHash(coinbaseKey.GetPubKey()));
+    std::vector<AssetIndexOutput> vOutputs;
+
+    // nothing but SYS so far
+    assetindex.FindAssetOutputs(nAsset, nullptr, 0, vOutputs);
+    BOOST_CHECK(vOutputs.empty());
+
+    // burn SYS into SYSX paid to script_a
+    CMutableTransaction burn_tx;
+    burn_tx.nVersion = SYSCOIN_TX_VERSION_SYSCOIN_BURN_TO_ALLOCATION;
+    burn_tx.vout.emplace_back(10 * COIN, script_a);
+    AddAssetAllocationData(burn_tx, {CAssetOut(nAsset, {CAssetOutValue(0, 5 * COIN)})}, 5 * COIN);
+    BOOST_REQUIRE(AddSignedInput(burn_tx, coinbaseKey, *m_coinbase_txns[0], 0));
+    CBlock burn_block = CreateAndProcessBlock({burn_tx}, coinbase_script);
+    BOOST_REQUIRE_EQUAL(burn_block.vtx.size(), 2U);
+    BOOST_CHECK(assetindex.BlockUntilSyncedToCurrentChain());
+    const CTransactionRef burn_tx_ref = burn_block.vtx[1];
+
+    assetindex.FindAssetOutputs(nAsset, nullptr, 0, vOutputs);
+    BOOST_REQUIRE_EQUAL(vOutputs.size(), 1U);
+    BOOST_CHECK(vOutputs[0].outpoint == COutPoint(burn_tx_ref->GetHash(), 0));
+    BOOST_CHECK(vOutputs[0].scriptPubKey == script_a);
+    BOOST_CHECK_EQUAL(vOutputs[0].nAssetValue, 5 * COIN);
+
+    // send part of it to script_b and keep the change at script_a
+    CMutableTransaction send_tx;
+    send_tx.nVersion = SYSCOIN_TX_VERSION_ALLOCATION_SEND;
+    send_tx.vout.emplace_back(4 * COIN, script_b);
+    send_tx.vout.emplace_back(5 * COIN, script_a);
+    AddAssetAllocationData(send_tx, {CAssetOut(nAsset, {CAssetOutValue(0, 2 * COIN), CAssetOutValue(1, 3 * COIN)})}, 0);
+    BOOST_REQUIRE(AddSignedInput(send_tx, coinbaseKey, *burn_tx_ref, 0));
+    CBlock send_block = CreateAndProcessBlock({send_tx}, coinbase_script);
+    BOOST_REQUIRE_EQUAL(send_block.vtx.size(), 2U);
+    BOOST_CHECK(assetindex.BlockUntilSyncedToCurrentChain());
+    const uint256 send_txid = send_block.vtx[1]->GetHash();
+
+    // the spent burn output is gone and the total is unchanged
+    vOutputs.clear();
+    assetindex.FindAssetOutputs(nAsset, nullptr, 0, vOutputs);
+    BOOST_CHECK_EQUAL(vOutputs.size(), 2U);
+    BOOST_CHECK_EQUAL(SumAssetValue(vOutputs), 5 * COIN);
+    for (const auto& output : vOutputs) {
+        BOOST_CHECK(output.outpoint.hash == send_txid);
+    }
+
+    // look them up by script
+    vOutputs.clear();
+    assetindex.FindAssetOutputs(nAsset, &script_b, 0, vOutputs);
+    BOOST_REQUIRE_EQUAL(vOutputs.size(), 1U);
+    BOOST_CHECK(vOutputs[0].outpoint == COutPoint(send_txid, 0));
+    BOOST_CHECK_EQUAL(vOutputs[0].nAssetValue, 2 * COIN);
+    vOutputs.clear();
+    assetindex.FindAssetOutputs(nAsset, &script_a, 0, vOutputs);
+    BOOST_REQUIRE_EQUAL(vOutputs.size(), 1U);
+    BOOST_CHECK(vOutputs[0].outpoint == COutPoint(send_txid, 1));
+    BOOST_CHECK_EQUAL(vOutputs[0].nAssetValue, 3 * COIN);
+
+    // the limit stops the scan, other assets are not affected
+    vOutputs.clear();
+    assetindex.FindAssetOutputs(nAsset, nullptr, 1, vOutputs);
+    BOOST_CHECK_EQUAL(vOutputs.size(), 1U);
+    vOutputs.clear();
+    assetindex.FindAssetOutputs(nAsset + 1, nullptr, 0, vOutputs);
+    BOOST_CHECK(vOutputs.empty());
+
+    // reorg the send out, the burn output is unspent again
+    {
+        BlockValidationState state;
+        CBlockIndex* pindex = WITH_LOCK(::cs_main, return m_node.chainman->m_blockman.LookupBlockIndex(send_block.GetHash()));
+        BOOST_REQUIRE(m_node.chainman->ActiveChainstate().InvalidateBlock(state, pindex));
+        // keep the send from being mined again
+        LOCK2(::cs_main, m_node.mempool->cs);
+        m_node.mempool->removeRecursive(*send_block.vtx[1], MemPoolRemovalReason::CONFLICT);
+    }
+    // the index rewinds when the competing block connects
+    std::vector<CMutableTransaction> no_txns;
+    const CBlock& fork_block = CreateAndProcessBlock(no_txns, coinbase_script);
+    BOOST_CHECK(assetindex.BlockUntilSyncedToCurrentChain());
+    BOOST_CHECK_EQUAL(assetindex.GetSummary().best_block_hash, fork_block.GetHash());
+    vOutputs.clear();
+    assetindex.FindAssetOutputs(nAsset, nullptr, 0, vOutputs);
+    BOOST_REQUIRE_EQUAL(vOutputs.size(), 1U);
+    BOOST_CHECK(vOutputs[0].outpoint == COutPoint(burn_tx_ref->GetHash(), 0));
+    BOOST_CHECK_EQUAL(vOutputs[0].nAssetValue, 5 * COIN);
+    vOutputs.clear();
+    assetindex.FindAssetOutputs(nAsset, &script_b, 0, vOutputs);
+    BOOST_CHECK(vOutputs.empty());
+
+    // It is not safe to stop and destroy the index until it finishes handling
+    // the last BlockConnected notification.
+    SyncWithValidationInterfaceQueue();
+
+    // shutdown sequence (c.f. Shutdown() in init.cpp)
+    assetindex.Stop();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
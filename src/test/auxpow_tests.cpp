@@ -8,6 +8,7 @@
 #include <coins.h>
 #include <consensus/merkle.h>
 #include <validation.h>
+#include <node/blockstorage.h>
 #include <pow.h>
 #include <primitives/block.h>
 #include <rpc/auxpow_miner.h>
@@ -17,6 +18,7 @@
 #include <uint256.h>
 #include <univalue.h>
 
+#include <test/util/random.h>
 #include <test/util/setup_common.h>
 
 #include <boost/test/unit_test.hpp>
@@ -63,6 +65,7 @@ public:
   using CAuxPow::parentBlock;
 
   using CAuxPow::CheckMerkleBranch;
+  using CAuxPow::CheckMerkleBranches;
 
 };
 
@@ -512,6 +515,40 @@ BOOST_FIXTURE_TEST_CASE (auxpow_pow, BasicTestingSetup)
   BOOST_CHECK (!HasValidProofOfWork({block}, params));
 }
 
+BOOST_FIXTURE_TEST_CASE (auxpow_header_store, BasicTestingSetup)
+{
+  SelectParams (ChainType::REGTEST);
+  const Consensus::Params& params = Params ().GetConsensus ();
+
+  const arith_uint256 target = (~arith_uint256 (0) >> 1);
+  CBlockHeader block;
+  block.nBits = target.GetCompact ();
+  block.SetBaseVersion (2, params.nAuxpowChainId);
+  block.SetAuxpowVersion (true);
+
+  CAuxpowBuilder builder(5, 42);
+  const unsigned height = 3;
+  const int nonce = 7;
+  const int index = CAuxPow::getExpectedIndex (nonce, params.nAuxpowChainId, height);
+  const valtype auxRoot = builder.buildAuxpowChain (block.GetHash (), height, index);
+  builder.setCoinbase (CScript () << CAuxpowBuilder::buildCoinbaseData (true, auxRoot, height, nonce));
+  mineBlock (builder.parentBlock, true, block.nBits);
+  block.SetAuxpow (builder.getUnique ());
+  BOOST_CHECK (HasValidProofOfWork({block}, params));
+
+  kernel::BlockTreeDB db(DBParams{.path = "", .cache_bytes = 1 << 20, .memory_only = true});
+  CBlockHeader read;
+  BOOST_CHECK (!db.ReadAuxpowHeader (block.GetHash (), read));
+  BOOST_CHECK (db.WriteAuxpowHeader (block));
+  BOOST_CHECK (db.ReadAuxpowHeader (block.GetHash (), read));
+
+  /* The auxpow comes back complete, so the header still proves its work.  */
+  BOOST_CHECK (read.GetHash () == block.GetHash ());
+  BOOST_CHECK (read.IsAuxpow () && read.auxpow != nullptr);
+  BOOST_CHECK (read.auxpow->getParentBlockHash () == block.auxpow->getParentBlockHash ());
+  BOOST_CHECK (HasValidProofOfWork({read}, params));
+}
+
 /* ************************************************************************** */
 
 /**
@@ -523,13 +560,87 @@ class AuxpowMinerForTest : public AuxpowMiner
 
 public:
 
-  using AuxpowMiner::cs;
-
   using AuxpowMiner::getCurrentBlock;
   using AuxpowMiner::lookupSavedBlock;
 
 };
 
+// SYSCOIN
+BOOST_FIXTURE_TEST_CASE (auxpow_pow_batch, RegTestingSetup)
+{
+  /* RegTestingSetup runs the check queues, so a HEADERS sized batch is
+     checked in parallel and one bad header has to fail all of it.  */
+  const Consensus::Params& params = Params ().GetConsensus ();
+  const arith_uint256 target = (~arith_uint256 (0) >> 1);
+
+  std::vector<CBlockHeader> headers(100);
+  for (size_t i = 0; i < headers.size (); ++i)
+    {
+      headers[i].nVersion = 2;
+      headers[i].nTime = i;
+      headers[i].nBits = target.GetCompact ();
+      mineBlock (headers[i], true);
+    }
+  BOOST_CHECK (HasValidProofOfWork (headers, params));
+
+  mineBlock (headers[57], false);
+  BOOST_CHECK (!HasValidProofOfWork (headers, params));
+  mineBlock (headers[57], true);
+  headers.back ().SetAuxpowVersion (true);
+  mineBlock (headers.back (), true);
+  BOOST_CHECK (!HasValidProofOfWork (headers, params));
+}
+
+BOOST_FIXTURE_TEST_CASE (auxpow_merkle_branches, RegTestingSetup)
+{
+  /* Branches walked side by side have to give the roots of walking them
+     one at a time, whatever their lengths.  */
+  std::vector<std::vector<uint256>> branchData(20);
+  std::vector<uint256> hashes;
+  std::vector<int> indices;
+  for (size_t i = 0; i < branchData.size (); ++i)
+    {
+      for (size_t j = 0; j < i % 7; ++j)
+        branchData[i].push_back (InsecureRand256 ());
+      hashes.push_back (InsecureRand256 ());
+      indices.push_back (i == 3 ? -1 : InsecureRandBits (6));
+    }
+  std::vector<const std::vector<uint256>*> branches;
+  std::vector<uint256> expected;
+  for (size_t i = 0; i < branchData.size (); ++i)
+    {
+      branches.push_back (&branchData[i]);
+      expected.push_back (CAuxPowForTest::CheckMerkleBranch (hashes[i], branchData[i], indices[i]));
+    }
+  CAuxPowForTest::CheckMerkleBranches (hashes, branches, indices);
+  BOOST_CHECK (hashes == expected);
+
+  /* A batch of merge-mined headers is checked with the batched roots.  */
+  const Consensus::Params& params = Params ().GetConsensus ();
+  const arith_uint256 target = (~arith_uint256 (0) >> 1);
+  const unsigned height = 3;
+  const int nonce = 7;
+  const int index = CAuxPow::getExpectedIndex (nonce, params.nAuxpowChainId, height);
+  std::vector<CBlockHeader> headers(20);
+  for (size_t i = 0; i < headers.size (); ++i)
+    {
+      CBlockHeader& block = headers[i];
+      block.nTime = i;
+      block.nBits = target.GetCompact ();
+      block.SetBaseVersion (2, params.nAuxpowChainId);
+      block.SetAuxpowVersion (true);
+      CAuxpowBuilder builder(5, 42);
+      const valtype auxRoot = builder.buildAuxpowChain (block.GetHash (), height, index);
+      const valtype data = CAuxpowBuilder::buildCoinbaseData (true, auxRoot, height, nonce);
+      builder.setCoinbase (CScript () << data);
+      mineBlock (builder.parentBlock, true, block.nBits);
+      block.SetAuxpow (builder.getUnique ());
+    }
+  BOOST_CHECK (HasValidProofOfWork (headers, params));
+  tamperWith (headers[13].hashMerkleRoot);
+  BOOST_CHECK (!HasValidProofOfWork (headers, params));
+}
+
 BOOST_FIXTURE_TEST_CASE (auxpow_miner_blockRegeneration, TestChain100Setup)
 {
   CTxMemPool mempool{MemPoolOptionsForTest(m_node)};
@@ -539,8 +650,6 @@ BOOST_FIXTURE_TEST_CASE (auxpow_miner_blockRegeneration, TestChain100Setup)
       LOCK(cs_main);
       nMedianTime = m_node.chainman->ActiveTip()->GetMedianTimePast();
   }
-  LOCK (miner.cs);
-
   /* We use mocktime so that we can control GetTime() as it is used in the
      logic that determines whether or not to reconstruct a block.  The "base"
      time is set such that the blocks we have from the fixture are fresh.  */
@@ -550,7 +659,7 @@ BOOST_FIXTURE_TEST_CASE (auxpow_miner_blockRegeneration, TestChain100Setup)
   /* Construct a first block.  */
   CScript scriptPubKey;
   uint256 target;
-  const CBlock* pblock1 = miner.getCurrentBlock (*m_node.chainman, mempool, scriptPubKey, target);
+  const auto pblock1 = miner.getCurrentBlock (*m_node.chainman, mempool, scriptPubKey, target);
   BOOST_CHECK (pblock1 != nullptr);
   const uint256 hash1 = pblock1->GetHash ();
 
@@ -563,14 +672,14 @@ BOOST_FIXTURE_TEST_CASE (auxpow_miner_blockRegeneration, TestChain100Setup)
      time (even if we advance the clock, since there are no new
      transactions).  */
   SetMockTime (baseTime + 100);
-  const CBlock* pblock = miner.getCurrentBlock (*m_node.chainman, mempool, scriptPubKey, target);
+  auto pblock = miner.getCurrentBlock (*m_node.chainman, mempool, scriptPubKey, target);
   BOOST_CHECK (pblock == pblock1 && pblock->GetHash () == hash1);
 
   /* Mine a block, then we should get a new auxpow block constructed.  Note that
      it can be the same *pointer* if the memory was reused after clearing it,
      so we can only verify that the hash is different.  */
   CreateAndProcessBlock ({}, scriptPubKey);
-  const CBlock* pblock2 = miner.getCurrentBlock (*m_node.chainman, mempool, scriptPubKey, target);
+  const auto pblock2 = miner.getCurrentBlock (*m_node.chainman, mempool, scriptPubKey, target);
   BOOST_CHECK (pblock2 != nullptr);
   const uint256 hash2 = pblock2->GetHash ();
   BOOST_CHECK (hash2 != hash1);
@@ -593,7 +702,7 @@ BOOST_FIXTURE_TEST_CASE (auxpow_miner_blockRegeneration, TestChain100Setup)
      definitely get a different pointer, as there is no clearing.  The old
      blocks are freed only after a new tip is found.  */
   SetMockTime (baseTime + 161);
-  const CBlock* pblock3 = miner.getCurrentBlock (*m_node.chainman, mempool, scriptPubKey, target);
+  const auto pblock3 = miner.getCurrentBlock (*m_node.chainman, mempool, scriptPubKey, target);
   BOOST_CHECK (pblock3 != pblock2 && pblock3->GetHash () != hash2);
 }
 
@@ -601,15 +710,26 @@ BOOST_FIXTURE_TEST_CASE (auxpow_miner_createAndLookupBlock, TestChain100Setup)
 {
   CTxMemPool mempool{MemPoolOptionsForTest(m_node)};
   AuxpowMinerForTest miner;
-  LOCK (miner.cs);
 
   CScript scriptPubKey;
   uint256 target;
-  const CBlock* pblock = miner.getCurrentBlock (*m_node.chainman, mempool, scriptPubKey, target);
+  auto pblock = miner.getCurrentBlock (*m_node.chainman, mempool, scriptPubKey, target);
   BOOST_CHECK (pblock != nullptr);
 
   BOOST_CHECK (miner.lookupSavedBlock (pblock->GetHash ().GetHex ()) == pblock);
   BOOST_CHECK_THROW (miner.lookupSavedBlock ("foobar"), UniValue);
+
+  // SYSCOIN another coinbase script gets a block made from the same base
+  const CScript scriptPubKey2 = CScript () << OP_TRUE;
+  const auto pblock2 = miner.getCurrentBlock (*m_node.chainman, mempool, scriptPubKey2, target);
+  BOOST_CHECK (pblock2 != pblock && pblock2->GetHash () != pblock->GetHash ());
+  BOOST_CHECK (pblock2->hashPrevBlock == pblock->hashPrevBlock);
+  BOOST_CHECK_EQUAL (pblock2->vtx.size (), pblock->vtx.size ());
+  BOOST_CHECK (pblock2->vtx[0]->vout[0].scriptPubKey == scriptPubKey2);
+  BOOST_CHECK (pblock2->hashMerkleRoot == BlockMerkleRoot (*pblock2));
+  BOOST_CHECK (miner.getCurrentBlock (*m_node.chainman, mempool, scriptPubKey2, target) == pblock2);
+  BOOST_CHECK (miner.lookupSavedBlock (pblock->GetHash ().GetHex ()) == pblock);
+  BOOST_CHECK (miner.lookupSavedBlock (pblock2->GetHash ().GetHex ()) == pblock2);
 }
 
 /* ************************************************************************** */
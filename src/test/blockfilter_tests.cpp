@@ -179,9 +179,60 @@ BOOST_AUTO_TEST_CASE(blockfilters_json_test)
     }
 }
 
+// SYSCOIN
+BOOST_AUTO_TEST_CASE(blockfilter_extended_test)
+{
+    CScript script_1, script_2;
+    script_1 << OP_DUP << OP_HASH160 << std::vector<unsigned char>(20, 1) << OP_EQUALVERIFY << OP_CHECKSIG;
+    script_2 << OP_0 << std::vector<unsigned char>(20, 2);
+
+    CMutableTransaction tx_asset;
+    tx_asset.nVersion = SYSCOIN_TX_VERSION_ALLOCATION_SEND;
+    tx_asset.vout.emplace_back(100, script_1, CAssetCoinInfo(1234, 50));
+
+    CNEVMData nevmData;
+    nevmData.vchVersionHash = std::vector<uint8_t>(32, 7);
+    std::vector<unsigned char> vchData;
+    nevmData.SerializeData(vchData);
+    CMutableTransaction tx_nevm;
+    tx_nevm.nVersion = SYSCOIN_TX_VERSION_NEVM_DATA_SHA3;
+    tx_nevm.vout.emplace_back(0, CScript() << OP_RETURN << vchData);
+
+    CBlock block;
+    block.vtx.push_back(MakeTransactionRef(tx_asset));
+    block.vtx.push_back(MakeTransactionRef(tx_nevm));
+
+    CBlockUndo block_undo;
+    block_undo.vtxundo.emplace_back();
+    block_undo.vtxundo.back().vprevout.emplace_back(CTxOut(500, script_2, CAssetCoinInfo(5678, 10)), 1000, false);
+
+    const BlockFilter basic_filter(BlockFilterType::BASIC_FILTER, block, block_undo);
+    const BlockFilter extended_filter(BlockFilterType::EXTENDED_FILTER, block, block_undo);
+    for (const CScript& script : {script_1, script_2}) {
+        BOOST_CHECK(basic_filter.GetFilter().Match(GCSFilter::Element(script.begin(), script.end())));
+        BOOST_CHECK(extended_filter.GetFilter().Match(GCSFilter::Element(script.begin(), script.end())));
+    }
+    const GCSFilter& filter = extended_filter.GetFilter();
+    BOOST_CHECK(filter.Match(ExtendedFilterAssetElement(1234)));
+    BOOST_CHECK(filter.Match(ExtendedFilterAssetElement(5678)));
+    BOOST_CHECK(filter.Match(ExtendedFilterVersionHashElement(nevmData.vchVersionHash)));
+    BOOST_CHECK(!filter.Match(ExtendedFilterAssetElement(4321)));
+    BOOST_CHECK(!filter.Match(ExtendedFilterVersionHashElement(std::vector<uint8_t>(32, 8))));
+    BOOST_CHECK(!basic_filter.GetFilter().Match(ExtendedFilterAssetElement(1234)));
+
+    BlockFilter extended_filter2;
+    DataStream stream{};
+    stream << extended_filter;
+    stream >> extended_filter2;
+    BOOST_CHECK_EQUAL(extended_filter2.GetFilterType(), BlockFilterType::EXTENDED_FILTER);
+    BOOST_CHECK(extended_filter.GetEncodedFilter() == extended_filter2.GetEncodedFilter());
+}
+
 BOOST_AUTO_TEST_CASE(blockfilter_type_names)
 {
     BOOST_CHECK_EQUAL(BlockFilterTypeName(BlockFilterType::BASIC_FILTER), "basic");
+    // SYSCOIN
+    BOOST_CHECK_EQUAL(BlockFilterTypeName(BlockFilterType::EXTENDED_FILTER), "extended");
     BOOST_CHECK_EQUAL(BlockFilterTypeName(static_cast<BlockFilterType>(255)), "");
 
     BlockFilterType filter_type;
@@ -201,4 +201,47 @@ BOOST_AUTO_TEST_CASE(blockmanager_flush_block_file)
     BOOST_CHECK_EQUAL(read_block.nVersion, 2);
 }
 
+BOOST_AUTO_TEST_CASE(blockmanager_mmap_block_file)
+{
+    KernelNotifications notifications{m_node.exit_status};
+    node::BlockManager::Options blockman_opts{
+        .chainparams = Params(),
+        .blocks_dir = m_args.GetBlocksDirPath(),
+        .notifications = notifications,
+        .mmap_block_files = true,
+    };
+    BlockManager blockman{m_node.kernel->interrupt, blockman_opts};
+
+    CBlock block1;
+    block1.nVersion = 1;
+    CBlock block2;
+    block2.nVersion = 2;
+    const FlatFilePos pos1{blockman.SaveBlockToDisk(block1, /*nHeight=*/1, /*dbp=*/nullptr)};
+
+    // the raw block is borrowed from the mapped file and matches what a file read returns
+    node::RawBlock raw1;
+    BOOST_CHECK(blockman.ReadRawBlockFromDisk(raw1, pos1));
+    BOOST_CHECK(raw1.mapping);
+    std::vector<uint8_t> read1;
+    BOOST_CHECK(blockman.ReadRawBlockFromDisk(read1, pos1));
+    BOOST_CHECK(Span<const uint8_t>{read1} == raw1.data);
+
+    // a block written after the file was mapped is read too, the first one stays valid
+    const FlatFilePos pos2{blockman.SaveBlockToDisk(block2, /*nHeight=*/2, /*dbp=*/nullptr)};
+    node::RawBlock raw2;
+    BOOST_CHECK(blockman.ReadRawBlockFromDisk(raw2, pos2));
+    std::vector<uint8_t> read2;
+    BOOST_CHECK(blockman.ReadRawBlockFromDisk(read2, pos2));
+    BOOST_CHECK(Span<const uint8_t>{read2} == raw2.data);
+    BOOST_CHECK(Span<const uint8_t>{read1} == raw1.data);
+
+    // blocks are deserialized from the mapping, errors are expected because the block data is junk
+    CBlock read_block;
+    {
+        ASSERT_DEBUG_LOG("ReadBlockFromDisk: Errors in block header");
+        BOOST_CHECK(!blockman.ReadBlockFromDisk(read_block, pos2, /*fFillNEVMData=*/false));
+        BOOST_CHECK_EQUAL(read_block.nVersion, 2);
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,83 @@
+// Copyright (c) 2024 The Syscoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <addresstype.h>
+#include <chain.h>
+#include <index/blockstatsindex.h>
+#include <interfaces/chain.h>
+#include <node/blockstorage.h>
+#include <test/util/index.h>
+#include <test/util/setup_common.h>
+#include <undo.h>
+#include <validation.h>
+
+#include <boost/test/unit_test.hpp>
+
+BOOST_AUTO_TEST_SUITE(blockstatsindex_tests)
+
+BOOST_FIXTURE_TEST_CASE(blockstatsindex_initial_sync, TestChain100Setup)
+{
+    BlockStatsIndex blockstatsindex(interfaces::MakeChain(m_node), 1 << 20, true);
+    BOOST_REQUIRE(blockstatsindex.Init());
+
+    const CBlockIndex* tip = WITH_LOCK(cs_main, return m_node.chainman->ActiveChain().Tip());
+
+    // Stats should not be found before the index is started.
+    BOOST_CHECK(!blockstatsindex.LookUpStats(*tip));
+
+    // BlockUntilSyncedToCurrentChain should return false before blockstatsindex is started.
+    BOOST_CHECK(!blockstatsindex.BlockUntilSyncedToCurrentChain());
+
+    BOOST_REQUIRE(blockstatsindex.StartBackgroundSync());
+
+    // Allow the index to catch up with the block index.
+    IndexWaitSynced(blockstatsindex);
+
+    // The stored stats match the ones computed from the block and its undo data.
+    for (const CBlockIndex* pindex = tip; pindex->nHeight > 0; pindex = pindex->pprev) {
+        const auto stats{blockstatsindex.LookUpStats(*pindex)};
+        BOOST_REQUIRE(stats);
+        CBlock block;
+        CBlockUndo block_undo;
+        BOOST_REQUIRE(m_node.chainman->m_blockman.ReadBlockFromDisk(block, *pindex, /*fFillNEVMData=*/false));
+        BOOST_REQUIRE(m_node.chainman->m_blockman.UndoReadFromDisk(block_undo, *pindex));
+        const node::BlockStats computed{node::ComputeBlockStats(block, block_undo, *pindex)};
+        BOOST_CHECK_EQUAL(stats->txs, computed.txs);
+        BOOST_CHECK_EQUAL(stats->outs, computed.outs);
+        BOOST_CHECK_EQUAL(stats->utxo_size_inc, computed.utxo_size_inc);
+        BOOST_CHECK_EQUAL(stats->total_weight, computed.total_weight);
+    }
+
+    // A block with a spend of a coinbase output has its fee and input counted.
+    const CScript coinbase_script_pub_key = GetScriptForDestination(PKHash(coinbaseKey.GetPubKey()));
+    const CMutableTransaction spend{CreateValidMempoolTransaction(m_coinbase_txns[0], /*input_vout=*/0, /*input_height=*/0, coinbaseKey, coinbase_script_pub_key, m_coinbase_txns[0]->vout[0].nValue - 1000, /*submit=*/false)};
+    const CBlock& block = CreateAndProcessBlock({spend}, coinbase_script_pub_key);
+    BOOST_CHECK(blockstatsindex.BlockUntilSyncedToCurrentChain());
+    tip = WITH_LOCK(cs_main, return m_node.chainman->ActiveChain().Tip());
+    BOOST_CHECK_EQUAL(tip->GetBlockHash(), block.GetHash());
+    const auto stats{blockstatsindex.LookUpStats(*tip)};
+    BOOST_REQUIRE(stats);
+    BOOST_CHECK_EQUAL(stats->txs, 2);
+    BOOST_CHECK_EQUAL(stats->ins, 1);
+    BOOST_CHECK_EQUAL(stats->totalfee, 1000);
+    BOOST_CHECK_EQUAL(stats->minfee, 1000);
+    BOOST_CHECK_EQUAL(stats->asset_txs, 0);
+    BOOST_CHECK_EQUAL(stats->nevm_blobs, 0);
+
+    // Stats of a block that is no longer at its height are not returned.
+    const uint256 stale_hash{tip->pprev->GetBlockHash()};
+    CBlockIndex stale;
+    stale.nHeight = tip->nHeight;
+    stale.phashBlock = &stale_hash;
+    BOOST_CHECK(!blockstatsindex.LookUpStats(stale));
+
+    // It is not safe to stop and destroy the index until it finishes handling
+    // the last BlockConnected notification.
+    SyncWithValidationInterfaceQueue();
+
+    // shutdown sequence (c.f. Shutdown() in init.cpp)
+    blockstatsindex.Stop();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -4,6 +4,7 @@
 
 #include <bls/bls.h>
 #include <bls/bls_batchverifier.h>
+#include <bls/bls_worker.h>
 #include <clientversion.h>
 #include <random.h>
 #include <streams.h>
@@ -11,6 +12,10 @@
 #include <test/util/setup_common.h>
 #include <boost/test/unit_test.hpp>
 
+#include <atomic>
+#include <thread>
+#include <vector>
+
 BOOST_AUTO_TEST_SUITE(bls_tests)
 
 void FuncSign(const bool legacy_scheme)
@@ -32,6 +37,24 @@ void FuncSign(const bool legacy_scheme)
     BOOST_CHECK(!sig2.VerifyInsecure(sk2.GetPublicKey(), msgHash2));
     BOOST_CHECK(sig2.VerifyInsecure(sk2.GetPublicKey(), msgHash1));
 
+    // prepared keys give the same answers
+    const CBLSPreparedPublicKey pk1(sk1.GetPublicKey()), pk2(sk2.GetPublicKey());
+    BOOST_CHECK(pk1.IsValid() && pk2.IsValid());
+    BOOST_CHECK(!CBLSPreparedPublicKey(CBLSPublicKey()).IsValid());
+    BOOST_CHECK(sig1.VerifyInsecure(pk1, msgHash1));
+    BOOST_CHECK(!sig1.VerifyInsecure(pk1, msgHash2));
+    BOOST_CHECK(!sig2.VerifyInsecure(pk1, msgHash1));
+    BOOST_CHECK(sig2.VerifyInsecure(pk2, msgHash1));
+
+    auto sig3 = sk2.Sign(msgHash2, legacy_scheme);
+    CBLSSignature aggSig = sig1;
+    aggSig.AggregateInsecure(sig3);
+    std::vector<const CBLSPreparedPublicKey*> pks{&pk1, &pk2};
+    std::vector<uint256> hashes{msgHash1, msgHash2};
+    BOOST_CHECK(aggSig.VerifyInsecureAggregated(pks, hashes));
+    std::swap(hashes[0], hashes[1]);
+    BOOST_CHECK(!aggSig.VerifyInsecureAggregated(pks, hashes));
+
     return;
 }
 
@@ -227,6 +250,60 @@ void FuncSigAggSecure(const bool legacy_scheme)
     auto sec_agg_sig = CBLSSignature::AggregateSecure(vec_sigs, vec_pks, hash);
     BOOST_CHECK(sec_agg_sig.IsValid());
     BOOST_CHECK(sec_agg_sig.VerifySecureAggregated(vec_pks, hash));
+
+    // the secure aggregated key checks the same signature, also through the bucketed multiplication
+    auto sec_agg_pk = CBLSPublicKey::AggregateSecure(vec_pks);
+    BOOST_CHECK(sec_agg_pk.IsValid());
+    BOOST_CHECK(sec_agg_sig.VerifyInsecure(sec_agg_pk, hash));
+    BOOST_CHECK(!sec_agg_sig.VerifyInsecure(CBLSPublicKey::AggregateInsecure(vec_pks), hash));
+    for (int i = 0; i < count; i++) {
+        sk.MakeNewKey();
+        vec_pks.push_back(sk.GetPublicKey());
+        vec_sigs.push_back(sk.Sign(hash, legacy_scheme));
+    }
+    sec_agg_sig = CBLSSignature::AggregateSecure(vec_sigs, vec_pks, hash);
+    BOOST_CHECK(sec_agg_sig.VerifyInsecure(CBLSPublicKey::AggregateSecure(vec_pks), hash));
+}
+
+void FuncSigBatchRandomized(const bool legacy_scheme)
+{
+    bls::bls_legacy_scheme.store(legacy_scheme);
+
+    // two hashes each signed by several keys, consecutive like CBLSBatchVerifier passes them
+    std::vector<CBLSSignature> sigs;
+    std::vector<CBLSPublicKey> pks;
+    std::vector<uint256> hashes;
+    const uint256 hash1 = GetRandHash();
+    const uint256 hash2 = GetRandHash();
+    for (int i = 0; i < 20; i++) {
+        CBLSSecretKey sk;
+        sk.MakeNewKey();
+        const uint256& hash = i < 12 ? hash1 : hash2;
+        sigs.push_back(sk.Sign(hash, legacy_scheme));
+        pks.push_back(sk.GetPublicKey());
+        hashes.push_back(hash);
+    }
+    BOOST_CHECK(CBLSSignature::VerifyBatchRandomized(sigs, pks, hashes));
+    BOOST_CHECK(CBLSSignature::VerifyBatchRandomized(Span(sigs).first(1), Span(pks).first(1), Span(hashes).first(1)));
+
+    // shifting two signatures of the same hash by opposite amounts keeps their sum, which insecure aggregation
+    // can't tell apart from the valid batch
+    CBLSSecretKey skDelta;
+    skDelta.MakeNewKey();
+    const CBLSSignature delta = skDelta.Sign(hash1, legacy_scheme);
+    auto badSigs = sigs;
+    badSigs[0].AggregateInsecure(delta);
+    badSigs[1].SubInsecure(delta);
+    std::vector<CBLSPublicKey> aggPks{CBLSPublicKey::AggregateInsecure(Span(pks).first(12)), CBLSPublicKey::AggregateInsecure(Span(pks).subspan(12))};
+    std::vector<uint256> aggHashes{hash1, hash2};
+    BOOST_CHECK(CBLSSignature::AggregateInsecure(badSigs).VerifyInsecureAggregated(aggPks, aggHashes));
+    BOOST_CHECK(!CBLSSignature::VerifyBatchRandomized(badSigs, pks, hashes));
+
+    // a signature over the wrong hash
+    badSigs = sigs;
+    std::swap(badSigs[11], badSigs[12]);
+    std::swap(pks[11], pks[12]);
+    BOOST_CHECK(!CBLSSignature::VerifyBatchRandomized(badSigs, pks, hashes));
 }
 
 void FuncDHExchange(const bool legacy_scheme)
@@ -360,6 +437,13 @@ void FuncBatchVerifier(const bool legacy_scheme)
     // last message invalid from one source
     AddMessage(msgs, 1, 7, 1, false);
     Verify(msgs);
+
+    msgs.clear();
+    // a few invalid messages among many sources
+    for (uint32_t i = 0; i < 21; i++) {
+        AddMessage(msgs, i, i, i % 4, i != 5 && i != 6 && i != 17);
+    }
+    Verify(msgs);
 }
 
 void FuncThresholdSignature(const bool legacy_scheme)
@@ -409,7 +493,21 @@ void FuncThresholdSignature(const bool legacy_scheme)
         BOOST_CHECK_EQUAL(rec_share_sig.IsValid(), m_shares >= 2);
         BOOST_CHECK_EQUAL(rec_share_sig == thr_sig, m_shares >= m_threshold);
         BOOST_CHECK_EQUAL(rec_share_sig.VerifyInsecure(thr_pk, hash), m_shares >= m_threshold);
+
+        // recovering with precomputed coefficients gives the same signature
+        BLSLagrangeCoefficients coefficients;
+        BOOST_CHECK_EQUAL(CBLSSignature::BuildLagrangeCoefficients(v_share_ids, coefficients), m_shares >= 2);
+        if (m_shares >= 2) {
+            CBLSSignature rec_share_sig2;
+            BOOST_CHECK(rec_share_sig2.Recover(v_share_sigs, coefficients));
+            BOOST_CHECK(rec_share_sig2 == rec_share_sig);
+        }
     }
+
+    // duplicate ids have no coefficients
+    std::vector<CBLSId> dup_ids{v_size_ids[0], v_size_ids[1], v_size_ids[0]};
+    BLSLagrangeCoefficients coefficients;
+    BOOST_CHECK(!CBLSSignature::BuildLagrangeCoefficients(dup_ids, coefficients));
 }
 
 BOOST_AUTO_TEST_CASE(bls_sethexstr_tests)
@@ -454,6 +552,12 @@ BOOST_AUTO_TEST_CASE(bls_sig_agg_secure_tests)
     FuncSigAggSecure(false);
 }
 
+BOOST_AUTO_TEST_CASE(bls_sig_batch_randomized_tests)
+{
+    FuncSigBatchRandomized(true);
+    FuncSigBatchRandomized(false);
+}
+
 BOOST_AUTO_TEST_CASE(bls_dh_exchange_tests)
 {
     FuncDHExchange(true);
@@ -466,6 +570,143 @@ BOOST_AUTO_TEST_CASE(batch_verifier_tests)
     FuncBatchVerifier(false);
 }
 
+BOOST_AUTO_TEST_CASE(bls_worker_asyncrun_tests)
+{
+    CBLSWorker worker;
+
+    // not started yet, so the task runs on the calling thread
+    bool ran{false};
+    worker.AsyncRun([&ran] { ran = true; }).get();
+    BOOST_CHECK(ran);
+
+    // one batch per message hash verified on the pool, as the sig share worker does
+    worker.Start();
+    std::vector<CBLSSecretKey> sks(4);
+    for (auto& sk : sks) {
+        sk.MakeNewKey();
+    }
+    std::vector<CBLSBatchVerifier<int, int>> batches;
+    for (int i = 0; i < 8; i++) {
+        const uint256 msgHash = GetRandHash();
+        auto& batch = batches.emplace_back(false, true);
+        for (int j = 0; j < (int)sks.size(); j++) {
+            // source 3 signs the wrong message in batch 5
+            const CBLSSignature sig = sks[j].Sign(i == 5 && j == 3 ? GetRandHash() : msgHash, false);
+            batch.PushMessage(j, j, msgHash, sig, sks[j].GetPublicKey());
+        }
+    }
+    std::vector<std::future<void>> futures;
+    for (auto& batch : batches) {
+        futures.emplace_back(worker.AsyncRun([&batch] { batch.Verify(); }));
+    }
+    for (auto& f : futures) {
+        f.get();
+    }
+    for (int i = 0; i < (int)batches.size(); i++) {
+        BOOST_CHECK_EQUAL(batches[i].badSources.size(), i == 5 ? 1U : 0U);
+    }
+    BOOST_CHECK(batches[5].badSources.count(3));
+    worker.Stop();
+}
+
+BOOST_AUTO_TEST_CASE(bls_worker_stopped_verify_tests)
+{
+    CBLSWorker worker;
+    worker.Start();
+    worker.Stop();
+
+    // a stopped worker verifies on the calling thread, signatures queued after it stopped still get an answer
+    CBLSSecretKey sk;
+    sk.MakeNewKey();
+    std::vector<bool> valids;
+    std::vector<std::future<bool>> futures;
+    for (int i = 0; i < 20; i++) {
+        const uint256 msgHash = GetRandHash();
+        const bool valid{i % 3 != 0};
+        const CBLSSignature sig = sk.Sign(valid ? msgHash : GetRandHash(), bls::bls_legacy_scheme.load());
+        futures.emplace_back(worker.AsyncVerifySig(sig, sk.GetPublicKey(), msgHash));
+        valids.push_back(valid);
+    }
+    for (size_t i = 0; i < futures.size(); i++) {
+        BOOST_CHECK_EQUAL(futures[i].get(), valids[i]);
+    }
+    BOOST_CHECK(!worker.IsAsyncVerifyInProgress());
+}
+
+BOOST_AUTO_TEST_CASE(bls_worker_cache_seed_tests)
+{
+    CBLSWorker worker;
+    CBLSWorkerCache cache(worker);
+
+    CBLSSecretKey sk;
+    sk.MakeNewKey();
+    const uint256 cacheKey = GetRandHash();
+    cache.SetPubKeyShare(cacheKey, sk.GetPublicKey());
+    // a seeded share is returned without being built from the (here missing) vvec
+    BOOST_CHECK(cache.BuildPubKeyShare(cacheKey, nullptr, CBLSId(cacheKey)) == sk.GetPublicKey());
+
+    // seeding does not replace a share that is known already
+    CBLSSecretKey sk2;
+    sk2.MakeNewKey();
+    cache.SetPubKeyShare(cacheKey, sk2.GetPublicKey());
+    BOOST_CHECK(cache.BuildPubKeyShare(cacheKey, nullptr, CBLSId(cacheKey)) == sk.GetPublicKey());
+}
+
+BOOST_FIXTURE_TEST_CASE(bls_sig_cache_tests, BasicTestingSetup)
+{
+    for (const bool legacy_scheme : {true, false}) {
+        CBLSSecretKey sk;
+        sk.MakeNewKey();
+        const CBLSPublicKey pk{sk.GetPublicKey()};
+        const uint256 msgHash = GetRandHash();
+        const CBLSSignature sig{sk.Sign(msgHash, legacy_scheme)};
+
+        BOOST_CHECK(!IsBLSSignatureCached(sig, pk, msgHash, legacy_scheme));
+        BOOST_CHECK(sig.VerifyInsecure(pk, msgHash, legacy_scheme));
+        BOOST_CHECK(IsBLSSignatureCached(sig, pk, msgHash, legacy_scheme));
+        // a cached signature is only valid in the scheme it was verified in
+        BOOST_CHECK(!IsBLSSignatureCached(sig, pk, msgHash, !legacy_scheme));
+        BOOST_CHECK(sig.VerifyInsecure(pk, msgHash, legacy_scheme));
+
+        // invalid signatures are not cached
+        const uint256 otherHash = GetRandHash();
+        BOOST_CHECK(!sig.VerifyInsecure(pk, otherHash, legacy_scheme));
+        BOOST_CHECK(!IsBLSSignatureCached(sig, pk, otherHash, legacy_scheme));
+        BOOST_CHECK(!sig.VerifyInsecure(pk, otherHash, legacy_scheme));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(bls_worker_cache_bound_tests)
+{
+    CBLSWorker worker;
+    CBLSWorkerCache cache(worker);
+
+    CBLSSecretKey sk;
+    sk.MakeNewKey();
+    const CBLSPublicKey pk{sk.GetPublicKey()};
+    constexpr size_t capacity{BLS_WORKER_CACHE_SHARDS * BLS_WORKER_CACHE_SHARD_SIZE};
+    std::vector<uint256> keys;
+    for (size_t i = 0; i < 2 * capacity; ++i) {
+        keys.push_back(GetRandHash());
+        cache.SetPubKeyShare(keys.back(), pk);
+    }
+    // every shard dropped its least recently used entries
+    BOOST_CHECK_EQUAL(cache.PubKeyShareCount(), capacity);
+
+    // concurrent lookups of the shares seeded last all find them
+    std::atomic<int> found{0};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&] {
+            for (size_t i = keys.size() - BLS_WORKER_CACHE_SHARD_SIZE; i < keys.size(); ++i) {
+                if (cache.BuildPubKeyShare(keys[i], nullptr, CBLSId(keys[i])) == pk) ++found;
+            }
+        });
+    }
+    for (auto& thread : threads) thread.join();
+    BOOST_CHECK_EQUAL(found, 4 * int{BLS_WORKER_CACHE_SHARD_SIZE});
+}
+
 BOOST_AUTO_TEST_CASE(bls_threshold_signature_tests)
 {
     FuncThresholdSignature(true);
@@ -592,4 +833,44 @@ BOOST_AUTO_TEST_CASE(test_get_hash_consistency)
     BOOST_CHECK(hash1 == hash2);
 }
 
+// SYSCOIN lazy public keys decode one key once for all their copies
+BOOST_AUTO_TEST_CASE(bls_pubkey_cache_tests)
+{
+    for (const bool legacy : {true, false}) {
+        CBLSSecretKey sk;
+        sk.MakeNewKey();
+        const CBLSPublicKey pk{sk.GetPublicKey()};
+        CDataStream ds(SER_DISK, CLIENT_VERSION);
+        pk.Serialize(ds, legacy);
+
+        const BLSPublicKeyCacheStats before{GetBLSPublicKeyCacheStats()};
+        for (int i = 0; i < 3; ++i) {
+            CBLSLazyPublicKey lazy;
+            CDataStream copy{ds};
+            lazy.Unserialize(copy, legacy);
+            BOOST_CHECK(lazy.Get() == pk);
+        }
+        const BLSPublicKeyCacheStats after{GetBLSPublicKeyCacheStats()};
+        BOOST_CHECK_EQUAL(after.misses - before.misses, 1U);
+        BOOST_CHECK_EQUAL(after.hits - before.hits, 2U);
+        BOOST_CHECK_EQUAL(after.entries, before.entries + 1);
+    }
+
+    // bytes that are no point are not cached and stay invalid
+    std::array<uint8_t, CBLSPublicKey::SerSize> garbage;
+    garbage.fill(0xff);
+    CDataStream ds(SER_DISK, CLIENT_VERSION);
+    ds << garbage;
+    const BLSPublicKeyCacheStats before{GetBLSPublicKeyCacheStats()};
+    for (int i = 0; i < 2; ++i) {
+        CBLSLazyPublicKey lazy;
+        CDataStream copy{ds};
+        lazy.Unserialize(copy, false);
+        BOOST_CHECK(!lazy.Get().IsValid());
+    }
+    const BLSPublicKeyCacheStats after{GetBLSPublicKeyCacheStats()};
+    BOOST_CHECK_EQUAL(after.misses - before.misses, 2U);
+    BOOST_CHECK_EQUAL(after.entries, before.entries);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -14,7 +14,9 @@
 #include <undo.h>
 #include <util/strencodings.h>
 
+#include <atomic>
 #include <map>
+#include <thread>
 #include <vector>
 
 #include <boost/test/unit_test.hpp>
@@ -282,6 +284,10 @@ BOOST_AUTO_TEST_CASE(coins_cache_simulation_test)
 
     CCoinsViewDB db_base{{.path = "test", .cache_bytes = 1 << 23, .memory_only = true}, {}};
     SimulationTest(&db_base, true);
+
+    // SYSCOIN
+    CCoinsViewDB db_behind{{.path = "test", .cache_bytes = 1 << 23, .memory_only = true}, {.write_behind = true}};
+    SimulationTest(&db_behind, true);
 }
 
 // Store of all necessary tx and undo data for next test
@@ -1085,6 +1091,112 @@ BOOST_AUTO_TEST_CASE(ccoins_flush_behavior)
     }
 }
 
+// SYSCOIN
+BOOST_AUTO_TEST_CASE(ccoins_write_behind)
+{
+    CCoinsViewDB base{{.path = "test", .cache_bytes = 1 << 23, .memory_only = true}, {.write_behind = true}};
+    CCoinsViewCache cache{&base};
+    const uint256 block_hash{InsecureRand256()};
+    cache.SetBestBlock(block_hash);
+
+    std::vector<COutPoint> outpoints;
+    for (int i = 0; i < 100; ++i) {
+        outpoints.emplace_back(InsecureRand256(), 0);
+        cache.AddCoin(outpoints.back(), Coin{CTxOut{InsecureRandMoneyAmount(), CScript() << InsecureRand32()}, 1, false}, false);
+    }
+    BOOST_CHECK(cache.Flush());
+    BOOST_CHECK_EQUAL(cache.GetCacheSize(), 0U);
+
+    // whether or not the background write has landed yet, the flushed coins are visible through the cache
+    for (const auto& outpoint : outpoints) {
+        BOOST_CHECK(cache.HaveCoin(outpoint));
+    }
+    BOOST_CHECK(base.GetBestBlock() == block_hash);
+
+    // spend one and flush again, the new batch is written after the first one
+    BOOST_CHECK(cache.SpendCoin(outpoints[0]));
+    BOOST_CHECK(cache.Flush());
+    BOOST_CHECK(base.WaitForPendingWrite());
+    BOOST_CHECK(!base.HaveCoin(outpoints[0]));
+    for (size_t i = 1; i < outpoints.size(); ++i) {
+        BOOST_CHECK(base.HaveCoin(outpoints[i]));
+    }
+    BOOST_CHECK(base.GetBestBlock() == block_hash);
+    BOOST_CHECK(base.GetHeadBlocks().empty());
+}
+
+// SYSCOIN readers walking the database wait for background writes while new ones are started
+BOOST_AUTO_TEST_CASE(ccoins_write_behind_cursor)
+{
+    CCoinsViewDB base{{.path = "test", .cache_bytes = 1 << 23, .memory_only = true}, {.write_behind = true}};
+    CCoinsViewCache cache{&base};
+    cache.SetBestBlock(InsecureRand256());
+
+    std::atomic<bool> done{false};
+    std::atomic<bool> failed{false};
+    std::thread reader([&] {
+        while (!done) {
+            for (auto cursor = base.Cursor(); cursor->Valid(); cursor->Next()) {}
+            if (!base.WaitForPendingWrite()) failed = true;
+        }
+    });
+    for (int i = 0; i < 50; ++i) {
+        for (int j = 0; j < 20; ++j) {
+            cache.AddCoin(COutPoint{InsecureRand256(), 0}, Coin{CTxOut{InsecureRandMoneyAmount(), CScript() << InsecureRand32()}, 1, false}, false);
+        }
+        BOOST_CHECK(cache.Flush());
+    }
+    done = true;
+    reader.join();
+    BOOST_CHECK(!failed);
+
+    BOOST_CHECK(base.WaitForPendingWrite());
+    size_t count{0};
+    for (auto cursor = base.Cursor(); cursor->Valid(); cursor->Next()) ++count;
+    BOOST_CHECK_EQUAL(count, 50U * 20U);
+}
+
+BOOST_AUTO_TEST_CASE(ccoins_prefetch)
+{
+    CCoinsViewDB db{{.path = "test", .cache_bytes = 1 << 23, .memory_only = true}, {}};
+    CCoinsViewPrefetch prefetch{db, /*enabled=*/true};
+    CCoinsViewCache cache{&prefetch};
+    cache.SetBestBlock(InsecureRand256());
+
+    std::vector<COutPoint> outpoints;
+    for (int i = 0; i < 1000; ++i) {
+        outpoints.emplace_back(InsecureRand256(), 0);
+        cache.AddCoin(outpoints.back(), Coin{CTxOut{InsecureRandMoneyAmount(), CScript() << InsecureRand32()}, 1, false}, false);
+    }
+    BOOST_CHECK(cache.Flush());
+
+    // missing coins are not kept
+    std::vector<COutPoint> request{outpoints};
+    request.emplace_back(InsecureRand256(), 0);
+    prefetch.Prefetch(request);
+    prefetch.WaitForPrefetches();
+    BOOST_CHECK_EQUAL(prefetch.PrefetchedCount(), outpoints.size());
+
+    // a coin is handed out once, the cache keeps it afterwards
+    BOOST_CHECK(cache.HaveCoin(outpoints[0]));
+    BOOST_CHECK_EQUAL(prefetch.PrefetchedCount(), outpoints.size() - 1);
+    BOOST_CHECK(cache.SpendCoin(outpoints[0]));
+
+    // a flush drops the prefetched coins it changes
+    CCoinsMapMemoryResource resource;
+    CCoinsMap changes{0, CCoinsMap::hasher{}, CCoinsMap::key_equal{}, &resource};
+    changes.emplace(std::piecewise_construct, std::forward_as_tuple(outpoints[1]), std::forward_as_tuple(Coin{}, CCoinsCacheEntry::DIRTY));
+    BOOST_CHECK(prefetch.BatchWrite(changes, cache.GetBestBlock()));
+    Coin coin;
+    BOOST_CHECK(!prefetch.GetCoin(outpoints[1], coin));
+    BOOST_CHECK(cache.Flush());
+    BOOST_CHECK(!prefetch.HaveCoin(outpoints[0]));
+    for (size_t i = 2; i < outpoints.size(); ++i) {
+        BOOST_CHECK(prefetch.GetCoin(outpoints[i], coin));
+    }
+    BOOST_CHECK_EQUAL(prefetch.PrefetchedCount(), 0U);
+}
+
 BOOST_AUTO_TEST_CASE(coins_resource_is_used)
 {
     CCoinsMapMemoryResource resource;
@@ -1110,4 +1222,26 @@ BOOST_AUTO_TEST_CASE(coins_resource_is_used)
     PoolResourceTester::CheckAllDataAccountedFor(resource);
 }
 
+// SYSCOIN
+BOOST_AUTO_TEST_CASE(coin_memusage_syscoin_fields)
+{
+    // the flags of a cache entry fit in the tail padding of the coin
+    BOOST_CHECK_EQUAL(sizeof(CCoinsCacheEntry), sizeof(Coin));
+
+    CScript script = CScript() << OP_TRUE;
+    Coin plain{CTxOut{1, script}, 1, false};
+    Coin asset{CTxOut{1, script, CAssetCoinInfo{123, 10}}, 1, false};
+    // asset info is stored inline and adds no heap usage
+    BOOST_CHECK_EQUAL(plain.DynamicMemoryUsage(), asset.DynamicMemoryUsage());
+
+    Coin poda{CTxOut{1, script, std::vector<uint8_t>(1000)}, 1, false};
+    BOOST_CHECK_GE(poda.DynamicMemoryUsage(), plain.DynamicMemoryUsage() + 1000);
+
+    CCoinsView base;
+    CCoinsViewCache cache{&base};
+    const size_t usage_before = cache.DynamicMemoryUsage();
+    cache.AddCoin(COutPoint{InsecureRand256(), 0}, Coin{poda}, false);
+    BOOST_CHECK_GE(cache.DynamicMemoryUsage(), usage_before + poda.DynamicMemoryUsage());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -2,13 +2,16 @@
 // Distributed under the MIT software license, see the accompanying
 // file COPYING or http://www.opensource.org/licenses/mit-license.php.
 
+#include <addresstype.h>
 #include <chainparams.h>
 #include <index/coinstatsindex.h>
 #include <interfaces/chain.h>
 #include <kernel/coinstats.h>
 #include <test/util/index.h>
 #include <test/util/setup_common.h>
+#include <test/util/transaction_utils.h>
 #include <test/util/validation.h>
+#include <txmempool.h>
 #include <validation.h>
 
 #include <boost/test/unit_test.hpp>
@@ -64,6 +67,13 @@ BOOST_FIXTURE_TEST_CASE(coinstatsindex_initial_sync, TestChain100Setup)
 
     BOOST_CHECK(block_index != new_block_index);
 
+    // SYSCOIN an index synced from genesis has asset totals, zero for an unused asset
+    const std::optional<AssetStats> asset_stats{coin_stats_index.LookUpAssetStats(123456, *new_block_index)};
+    BOOST_REQUIRE(asset_stats);
+    BOOST_CHECK_EQUAL(asset_stats->supply, 0);
+    BOOST_CHECK_EQUAL(asset_stats->minted, 0);
+    BOOST_CHECK_EQUAL(asset_stats->output_count, 0);
+
     // It is not safe to stop and destroy the index until it finishes handling
     // the last BlockConnected notification. The BlockUntilSyncedToCurrentChain()
     // call above is sufficient to ensure this, but the
@@ -76,6 +86,87 @@ BOOST_FIXTURE_TEST_CASE(coinstatsindex_initial_sync, TestChain100Setup)
     coin_stats_index.Stop();
 }
 
+// SYSCOIN assets can be created from the nexus start block on, which TestChainDIP3Setup is right below
+BOOST_FIXTURE_TEST_CASE(coinstatsindex_asset_stats, TestChainDIP3Setup)
+{
+    CoinStatsIndex coin_stats_index{interfaces::MakeChain(m_node), 1 << 20, true};
+    BOOST_REQUIRE(coin_stats_index.Init());
+    BOOST_REQUIRE(coin_stats_index.StartBackgroundSync());
+    IndexWaitSynced(coin_stats_index);
+
+    const uint64_t nAsset = Params().GetConsensus().nSYSXAsset;
+    const CScript coinbase_script{CScript() << ToByteVector(coinbaseKey.GetPubKey()) << OP_CHECKSIG};
+    const CScript script_a{GetScriptForDestination(PKHash(coinbaseKey.GetPubKey()))};
+    const CScript script_b{GetScriptForDestination(WitnessV0KeyHash(coinbaseKey.GetPubKey()))};
+    const auto tip = [&]() { return WITH_LOCK(::cs_main, return m_node.chainman->ActiveChain().Tip()); };
+    const auto check_stats = [&](const CBlockIndex* pindex, CAmount supply, CAmount minted, CAmount burned_to_syscoin, int64_t output_count) {
+        BOOST_CHECK(coin_stats_index.BlockUntilSyncedToCurrentChain());
+        const std::optional<AssetStats> stats{coin_stats_index.LookUpAssetStats(nAsset, *pindex)};
+        BOOST_REQUIRE(stats);
+        BOOST_CHECK_EQUAL(stats->supply, supply);
+        BOOST_CHECK_EQUAL(stats->minted, minted);
+        BOOST_CHECK_EQUAL(stats->burned_to_nevm, 0);
+        BOOST_CHECK_EQUAL(stats->burned_to_syscoin, burned_to_syscoin);
+        BOOST_CHECK_EQUAL(stats->output_count, output_count);
+    };
+    const CBlockIndex* pindex_start{tip()};
+
+    // burn SYS into 5 SYSX
+    CMutableTransaction burn_tx;
+    burn_tx.nVersion = SYSCOIN_TX_VERSION_SYSCOIN_BURN_TO_ALLOCATION;
+    burn_tx.vout.emplace_back(10 * COIN, script_a);
+    AddAssetAllocationData(burn_tx, {CAssetOut(nAsset, {CAssetOutValue(0, 5 * COIN)})}, 5 * COIN);
+    BOOST_REQUIRE(AddSignedInput(burn_tx, coinbaseKey, *m_coinbase_txns[0], 0));
+    BOOST_REQUIRE_EQUAL(CreateAndProcessBlock({burn_tx}, coinbase_script).vtx.size(), 2U);
+    const CBlockIndex* pindex_burn{tip()};
+    check_stats(pindex_burn, 5 * COIN, 5 * COIN, 0, 1);
+
+    // split it over two outputs
+    CMutableTransaction send_tx;
+    send_tx.nVersion = SYSCOIN_TX_VERSION_ALLOCATION_SEND;
+    send_tx.vout.emplace_back(4 * COIN, script_b);
+    send_tx.vout.emplace_back(5 * COIN, script_a);
+    AddAssetAllocationData(send_tx, {CAssetOut(nAsset, {CAssetOutValue(0, 2 * COIN), CAssetOutValue(1, 3 * COIN)})});
+    BOOST_REQUIRE(AddSignedInput(send_tx, coinbaseKey, CTransaction(burn_tx), 0));
+    BOOST_REQUIRE_EQUAL(CreateAndProcessBlock({send_tx}, coinbase_script).vtx.size(), 2U);
+    const CBlockIndex* pindex_send{tip()};
+    check_stats(pindex_send, 5 * COIN, 5 * COIN, 0, 2);
+
+    // burn 1 SYSX back to SYS and keep 1 SYSX as change
+    CMutableTransaction unburn_tx;
+    unburn_tx.nVersion = SYSCOIN_TX_VERSION_ALLOCATION_BURN_TO_SYSCOIN;
+    unburn_tx.vout.emplace_back(1 * COIN, script_a);
+    unburn_tx.vout.emplace_back(2 * COIN, script_b);
+    AddAssetAllocationData(unburn_tx, {CAssetOut(nAsset, {CAssetOutValue(1, 1 * COIN), CAssetOutValue(2, 1 * COIN)})});
+    BOOST_REQUIRE(AddSignedInput(unburn_tx, coinbaseKey, CTransaction(send_tx), 0));
+    const CBlock unburn_block{CreateAndProcessBlock({unburn_tx}, coinbase_script)};
+    BOOST_REQUIRE_EQUAL(unburn_block.vtx.size(), 2U);
+    const CBlockIndex* pindex_unburn{tip()};
+    check_stats(pindex_unburn, 4 * COIN, 5 * COIN, 1 * COIN, 2);
+
+    // earlier blocks keep their totals, the blocks before the first burn have none
+    check_stats(pindex_send, 5 * COIN, 5 * COIN, 0, 2);
+    check_stats(pindex_start, 0, 0, 0, 0);
+
+    // reorg the burn to SYS out
+    {
+        BlockValidationState state;
+        BOOST_REQUIRE(m_node.chainman->ActiveChainstate().InvalidateBlock(state, WITH_LOCK(::cs_main, return m_node.chainman->m_blockman.LookupBlockIndex(unburn_block.GetHash()))));
+        LOCK2(::cs_main, m_node.mempool->cs);
+        m_node.mempool->removeRecursive(*unburn_block.vtx[1], MemPoolRemovalReason::CONFLICT);
+    }
+    std::vector<CMutableTransaction> no_txns;
+    CreateAndProcessBlock(no_txns, coinbase_script);
+    const CBlockIndex* pindex_fork{tip()};
+    BOOST_CHECK_EQUAL(pindex_fork->nHeight, pindex_unburn->nHeight);
+    check_stats(pindex_fork, 5 * COIN, 5 * COIN, 0, 2);
+    // the totals of the disconnected block are gone
+    BOOST_CHECK(!coin_stats_index.LookUpAssetStats(nAsset, *pindex_unburn));
+
+    SyncWithValidationInterfaceQueue();
+    coin_stats_index.Stop();
+}
+
 // Test shutdown between BlockConnected and ChainStateFlushed notifications,
 // make sure index is not corrupted and is able to reload.
 BOOST_FIXTURE_TEST_CASE(coinstatsindex_unclean_shutdown, TestChain100Setup)
@@ -838,6 +838,44 @@ BOOST_AUTO_TEST_CASE(chacha20_midblock)
     BOOST_CHECK(Span{block}.last(52) == Span{b3});
 }
 
+// SYSCOIN
+BOOST_AUTO_TEST_CASE(chacha20_poly1305_long_messages)
+{
+    // Long messages may take the vectorized paths, one block at a time they take the scalar ones.
+    for (int i = 0; i < 20; ++i) {
+        const auto key{g_insecure_rand_ctx.randbytes<std::byte>(32)};
+        const auto msg{g_insecure_rand_ctx.randbytes<std::byte>(InsecureRandRange(4096))};
+        // every third run makes the block counter wrap
+        const uint32_t seek = i % 3 ? InsecureRand32() : 0xffffffff - InsecureRandRange(64);
+        const ChaCha20::Nonce96 nonce{InsecureRand32(), g_insecure_rand_ctx.rand64()};
+
+        ChaCha20 whole{key}, blockwise{key};
+        whole.Seek(nonce, seek);
+        blockwise.Seek(nonce, seek);
+        std::vector<std::byte> out1(msg.size()), out2(msg.size());
+        whole.Crypt(msg, out1);
+        for (size_t pos = 0; pos < msg.size(); pos += ChaCha20Aligned::BLOCKLEN) {
+            const size_t len = std::min<size_t>(ChaCha20Aligned::BLOCKLEN, msg.size() - pos);
+            blockwise.Crypt(Span{msg}.subspan(pos, len), Span{out2}.subspan(pos, len));
+        }
+        BOOST_CHECK(out1 == out2);
+        whole.Keystream(out1);
+        for (size_t pos = 0; pos < msg.size(); pos += ChaCha20Aligned::BLOCKLEN) {
+            blockwise.Keystream(Span{out2}.subspan(pos, std::min<size_t>(ChaCha20Aligned::BLOCKLEN, msg.size() - pos)));
+        }
+        BOOST_CHECK(out1 == out2);
+
+        std::vector<std::byte> tag1(Poly1305::TAGLEN), tag2(Poly1305::TAGLEN);
+        Poly1305{key}.Update(msg).Finalize(tag1);
+        Poly1305 poly1305{key};
+        for (size_t pos = 0; pos < msg.size(); pos += POLY1305_BLOCK_SIZE) {
+            poly1305.Update(Span{msg}.subspan(pos, std::min<size_t>(POLY1305_BLOCK_SIZE, msg.size() - pos)));
+        }
+        poly1305.Finalize(tag2);
+        BOOST_CHECK(tag1 == tag2);
+    }
+}
+
 BOOST_AUTO_TEST_CASE(poly1305_testvector)
 {
     // RFC 7539, section 2.5.2.
@@ -398,4 +398,137 @@ BOOST_AUTO_TEST_CASE(unicodepath)
 }
 
 
+// SYSCOIN
+BOOST_AUTO_TEST_CASE(dbwrapper_shared)
+{
+    for (const bool obfuscate : {false, true}) {
+        CDBWrapper shared({.path = m_args.GetDataDirBase() / "shared", .cache_bytes = 1 << 20, .memory_only = true, .obfuscate = obfuscate});
+        auto dbw_a = std::make_unique<CDBWrapper>(DBParams{.path = m_args.GetDataDirBase() / "a", .cache_bytes = 1 << 20, .shared_db = &shared});
+        CDBWrapper dbw_b({.path = m_args.GetDataDirBase() / "b", .cache_bytes = 1 << 20, .shared_db = &shared});
+        BOOST_CHECK(obfuscate != is_null_key(dbwrapper_private::GetObfuscateKey(*dbw_a)));
+
+        // the same keys in both databases don't collide
+        for (uint8_t i = 0; i < 10; ++i) {
+            BOOST_CHECK(dbw_a->Write(i, uint256{i}));
+            BOOST_CHECK(dbw_b.Write(i, uint256{uint8_t(i + 100)}, /*fSync=*/true));
+        }
+        uint256 res;
+        BOOST_CHECK(dbw_a->Read(uint8_t{3}, res));
+        BOOST_CHECK(res == uint256{3});
+        BOOST_CHECK(dbw_b.Read(uint8_t{3}, res));
+        BOOST_CHECK(res == uint256{103});
+        BOOST_CHECK(dbw_a->Erase(uint8_t{3}));
+        BOOST_CHECK(!dbw_a->Exists(uint8_t{3}));
+        BOOST_CHECK(dbw_b.Exists(uint8_t{3}));
+
+        // iteration stays within the keys of one database
+        std::unique_ptr<CDBIterator> it(dbw_b.NewIterator());
+        uint8_t expected{0};
+        for (it->SeekToFirst(); it->Valid(); it->Next(), ++expected) {
+            uint8_t key;
+            BOOST_CHECK(it->GetKey(key));
+            BOOST_CHECK_EQUAL(key, expected);
+            BOOST_CHECK(it->GetValue(res));
+            BOOST_CHECK(res == uint256{uint8_t(expected + 100)});
+        }
+        BOOST_CHECK_EQUAL(expected, 10);
+        it.reset();
+
+        // synced writes are collected while deferred
+        shared.DeferSync();
+        BOOST_CHECK(dbw_a->Write(uint8_t{20}, uint256{20}, /*fSync=*/true));
+        BOOST_CHECK(dbw_a->Exists(uint8_t{20}));
+        BOOST_CHECK(shared.FlushDeferredSync());
+
+        // wiping one leaves the other untouched
+        dbw_a.reset();
+        dbw_a = std::make_unique<CDBWrapper>(DBParams{.path = m_args.GetDataDirBase() / "a", .cache_bytes = 1 << 20, .wipe_data = true, .shared_db = &shared});
+        BOOST_CHECK(dbw_a->IsEmpty());
+        BOOST_CHECK(!dbw_b.IsEmpty());
+        BOOST_CHECK(dbw_b.Read(uint8_t{9}, res));
+        BOOST_CHECK(res == uint256{109});
+        dbw_b.ResetDB();
+        BOOST_CHECK(dbw_b.IsEmpty());
+    }
+}
+
+BOOST_AUTO_TEST_CASE(dbwrapper_read_many)
+{
+    for (const bool obfuscate : {false, true}) {
+        CDBWrapper shared({.path = m_args.GetDataDirBase() / "read_many_shared", .cache_bytes = 1 << 20, .memory_only = true, .obfuscate = obfuscate});
+        CDBWrapper dbw_a({.path = m_args.GetDataDirBase() / "read_many_a", .cache_bytes = 1 << 20, .shared_db = &shared});
+        CDBWrapper dbw_b({.path = m_args.GetDataDirBase() / "read_many_b", .cache_bytes = 1 << 20, .shared_db = &shared});
+        CDBWrapper dbw({.path = m_args.GetDataDirBase() / "read_many", .cache_bytes = 1 << 20, .memory_only = true, .obfuscate = obfuscate});
+        // every third key is missing, and far enough apart to need seeks as well as steps
+        for (uint16_t i = 0; i < 300; ++i) {
+            if (i % 3 == 0) continue;
+            BOOST_CHECK(dbw.Write(i, uint256{uint8_t(i)}));
+            BOOST_CHECK(dbw_a.Write(i, uint256{uint8_t(i)}));
+            BOOST_CHECK(dbw_b.Write(i, uint256{uint8_t(i + 1)}));
+        }
+        // unsorted, with duplicates and keys past the last one
+        const std::vector<uint16_t> keys{299, 4, 3, 150, 4, 1, 500, 298, 0, 151, 152};
+        for (const CDBWrapper* db : {&dbw, &dbw_a}) {
+            std::vector<std::optional<uint256>> values;
+            BOOST_CHECK_EQUAL(db->ReadMany(keys, values), 7U);
+            BOOST_REQUIRE_EQUAL(values.size(), keys.size());
+            const std::vector<bool> exists{db->ExistsMany(keys)};
+            for (size_t i = 0; i < keys.size(); ++i) {
+                const bool present{keys[i] < 300 && keys[i] % 3 != 0};
+                BOOST_CHECK_EQUAL(values[i].has_value(), present);
+                BOOST_CHECK_EQUAL(exists[i], present);
+                if (present) BOOST_CHECK(*values[i] == uint256{uint8_t(keys[i])});
+            }
+        }
+        std::vector<std::optional<uint256>> values;
+        BOOST_CHECK_EQUAL(dbw.ReadMany(std::vector<uint16_t>{}, values), 0U);
+        BOOST_CHECK(values.empty());
+    }
+}
+
+BOOST_AUTO_TEST_CASE(dbwrapper_read_buffer)
+{
+    for (const bool obfuscate : {false, true}) {
+        CDBWrapper shared({.path = m_args.GetDataDirBase() / "read_buffer_shared", .cache_bytes = 1 << 20, .memory_only = true, .obfuscate = obfuscate});
+        CDBWrapper dbw_a({.path = m_args.GetDataDirBase() / "read_buffer_a", .cache_bytes = 1 << 20, .shared_db = &shared});
+        CDBWrapper dbw({.path = m_args.GetDataDirBase() / "read_buffer", .cache_bytes = 1 << 20, .memory_only = true, .obfuscate = obfuscate});
+        const std::vector<uint8_t> large(100000, 0x5a);
+        const std::vector<uint8_t> small{1, 2, 3};
+        for (CDBWrapper* db : {&dbw, &dbw_a}) {
+            BOOST_CHECK(db->Write(uint8_t{1}, large));
+            BOOST_CHECK(db->Write(uint8_t{2}, small));
+            BOOST_CHECK(db->Write(uint8_t{3}, uint256{1}));
+            // one buffer serves reads of values of any size, the earlier contents do not leak into later reads
+            std::string buffer;
+            std::vector<uint8_t> read_out;
+            BOOST_CHECK(db->Read(uint8_t{1}, read_out, buffer));
+            BOOST_CHECK(read_out == large);
+            BOOST_CHECK(db->Read(uint8_t{2}, read_out, buffer));
+            BOOST_CHECK(read_out == small);
+            uint256 hash_out;
+            BOOST_CHECK(db->Read(uint8_t{3}, hash_out, buffer));
+            BOOST_CHECK(hash_out == uint256{1});
+            BOOST_CHECK(!db->Read(uint8_t{4}, read_out, buffer));
+            // a value too short for the type read fails like Read() does
+            BOOST_CHECK(!db->Read(uint8_t{2}, hash_out, buffer));
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(dbwrapper_shared_block_cache)
+{
+    auto block_cache{MakeDBBlockCache(1 << 20)};
+    auto dbw_a = std::make_unique<CDBWrapper>(DBParams{.path = m_args.GetDataDirBase() / "cache_a", .cache_bytes = 1 << 20, .memory_only = true, .block_cache = block_cache});
+    CDBWrapper dbw_b({.path = m_args.GetDataDirBase() / "cache_b", .cache_bytes = 1 << 20, .memory_only = true, .block_cache = block_cache});
+    block_cache.reset();
+
+    BOOST_CHECK(dbw_a->Write(uint8_t{1}, uint256{1}));
+    BOOST_CHECK(dbw_b.Write(uint8_t{1}, uint256{2}));
+    // closing one database leaves the cache to the other
+    dbw_a.reset();
+    uint256 res;
+    BOOST_CHECK(dbw_b.Read(uint8_t{1}, res));
+    BOOST_CHECK(res == uint256{2});
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -305,6 +305,23 @@ void FuncDIP3Protx(TestChain100Setup& setup)
 
         nHeight++;
     }
+    {
+        // SYSCOIN lists loaded from disk share equal masternodes instead of holding copies
+        DataStream ss{};
+        ss << deterministicMNManager->GetListAtChainTip();
+        DataStream ss2{ss};
+        CDeterministicMNList list1, list2;
+        ss >> list1;
+        ss2 >> list2;
+        BOOST_CHECK(list1.GetAllMNsCount() >= dmnHashes.size());
+        for (const auto& proTxHash : dmnHashes) {
+            BOOST_CHECK(list1.GetMN(proTxHash) == list2.GetMN(proTxHash));
+        }
+        // the payee ordering is rebuilt on load and covers every valid masternode
+        const auto payees = list1.GetProjectedMNPayees();
+        BOOST_CHECK_EQUAL(payees.size(), list1.GetValidMNsCount());
+        BOOST_CHECK(payees.front() == list1.GetMNPayee());
+    }
     int DIP0003EnforcementHeightBackup = Params().GetConsensus().DIP0003EnforcementHeight;
     const_cast<Consensus::Params&>(Params().GetConsensus()).DIP0003EnforcementHeight = *setup.m_node.chain->getHeight() + 1;
     
@@ -358,6 +375,20 @@ void FuncDIP3Protx(TestChain100Setup& setup)
     nHeight++;
     auto dmn = deterministicMNManager->GetListAtChainTip().GetMN(dmnHashes[0]);
     assert(dmn != nullptr && dmn->pdmnState->addr.GetPort() == 1000);
+    // SYSCOIN the service index follows the update
+    {
+        const auto tipList = deterministicMNManager->GetListAtChainTip();
+        const auto dmnByService = tipList.GetMNByService(dmn->pdmnState->addr);
+        BOOST_CHECK(dmnByService && dmnByService->proTxHash == dmnHashes[0]);
+        const auto dmnByOperatorKey = tipList.GetMNByOperatorKey(operatorKeys[dmnHashes[0]].GetPublicKey());
+        BOOST_CHECK(dmnByOperatorKey && dmnByOperatorKey->proTxHash == dmnHashes[0]);
+
+        // a copy of a list shares all of its memory with it
+        std::unordered_set<const void*> seen;
+        BOOST_CHECK(tipList.DynamicMemoryUsage(seen) > 0);
+        const CDeterministicMNList tipListCopy{tipList};
+        BOOST_CHECK_EQUAL(tipListCopy.DynamicMemoryUsage(seen), 0U);
+    }
 
     // test ProUpRevTx
     tx = CreateProUpRevTx(setup.m_node, utxos, dmnHashes[0], operatorKeys[dmnHashes[0]], setup.coinbaseKey);
@@ -414,6 +445,14 @@ void FuncDIP3Protx(TestChain100Setup& setup)
     dmn = deterministicMNManager->GetListAtChainTip().GetMN(dmnHashes[0]);
     assert(dmn != nullptr && dmn->pdmnState->addr.GetPort() == 100);
     assert(dmn != nullptr && !dmn->pdmnState->IsBanned());
+    {
+        const auto tipList = deterministicMNManager->GetListAtChainTip();
+        const auto dmnByOperatorKey = tipList.GetMNByOperatorKey(newOperatorKey.GetPublicKey());
+        BOOST_CHECK(dmnByOperatorKey && dmnByOperatorKey->proTxHash == dmnHashes[0]);
+        BOOST_CHECK(!tipList.GetMNByOperatorKey(operatorKeys[dmnHashes[0]].GetPublicKey()));
+        const auto dmnByService = tipList.GetMNByService(dmn->pdmnState->addr);
+        BOOST_CHECK(dmnByService && dmnByService->proTxHash == dmnHashes[0]);
+    }
 
     // test that the revived MN gets payments again
     bool foundRevived = false;
@@ -688,4 +727,214 @@ BOOST_AUTO_TEST_CASE(verify_db_legacy)
     TestChainDIP3Setup setup;
     FuncVerifyDB(setup);
 }
+
+// SYSCOIN lists update the map nodes they own in place, the lists they were copied from must not change
+BOOST_FIXTURE_TEST_CASE(dmn_list_copy_on_write, BasicTestingSetup)
+{
+    const auto proTxHash = [](uint64_t i) { return ArithToUint256(arith_uint256{i + 1}); };
+    CDeterministicMNList base(uint256{1}, 1, 0);
+    for (uint64_t i = 0; i < 200; ++i) {
+        auto dmn = std::make_shared<CDeterministicMN>(i);
+        dmn->proTxHash = proTxHash(i);
+        dmn->collateralOutpoint = COutPoint(dmn->proTxHash, 0);
+        auto state = std::make_shared<CDeterministicMNState>();
+        state->keyIDOwner = CKeyID(uint160(std::vector<unsigned char>(20, (unsigned char)(i + 1))));
+        dmn->pdmnState = state;
+        base.AddMN(dmn);
+    }
+
+    CDeterministicMNList list = base;
+    for (uint64_t i = 0; i < 200; i += 2) {
+        // updated twice, the second update replaces an entry only this list holds
+        for (int penalty = 1; penalty <= 2; ++penalty) {
+            auto state = std::make_shared<CDeterministicMNState>(*list.GetMN(proTxHash(i))->pdmnState);
+            state->nPoSePenalty = penalty;
+            list.UpdateMN(proTxHash(i), state);
+        }
+    }
+    for (uint64_t i = 1; i < 200; i += 4) {
+        list.RemoveMN(proTxHash(i));
+    }
+    const CDeterministicMNList copy = list;
+    list.RemoveMN(proTxHash(0));
+
+    BOOST_CHECK_EQUAL(base.GetAllMNsCount(), 200);
+    BOOST_CHECK_EQUAL(copy.GetAllMNsCount(), 150);
+    BOOST_CHECK_EQUAL(list.GetAllMNsCount(), 149);
+    for (uint64_t i = 0; i < 200; ++i) {
+        BOOST_CHECK_EQUAL(base.GetMN(proTxHash(i))->pdmnState->nPoSePenalty, 0);
+        BOOST_CHECK(base.GetMNByCollateral(COutPoint(proTxHash(i), 0)));
+        const bool removed{i % 4 == 1};
+        BOOST_CHECK_EQUAL(copy.HasMN(proTxHash(i)), !removed);
+        BOOST_CHECK_EQUAL(copy.HasMNByCollateral(COutPoint(proTxHash(i), 0)), !removed);
+        if (!removed) {
+            BOOST_CHECK_EQUAL(copy.GetMN(proTxHash(i))->pdmnState->nPoSePenalty, i % 2 == 0 ? 2 : 0);
+        }
+    }
+    BOOST_CHECK(copy.HasMN(proTxHash(0)));
+    BOOST_CHECK(!list.HasMN(proTxHash(0)));
+}
+
+// SYSCOIN block indexes without blocks, enough for the masternode list database
+struct TestBlockIndexChain {
+    std::vector<uint256> hashes;
+    std::vector<CBlockIndex> blocks;
+
+    explicit TestBlockIndexChain(int nTipHeight) : hashes(nTipHeight + 1), blocks(nTipHeight + 1)
+    {
+        for (int i = 0; i <= nTipHeight; ++i) {
+            hashes[i] = ArithToUint256(arith_uint256{uint64_t(i) + 1} << 128);
+            blocks[i].phashBlock = &hashes[i];
+            blocks[i].nHeight = i;
+            blocks[i].pprev = i > 0 ? &blocks[i - 1] : nullptr;
+            blocks[i].BuildSkip();
+        }
+    }
+};
+
+/** Write the lists of the blocks from DIP3 activation to the tip, one masternode registered at every block and
+ *  others updated and removed. The caches are flushed at nFlushHeight as well as at the tip */
+static std::vector<CDeterministicMNList> WriteTestLists(CDeterministicMNManager& manager, const TestBlockIndexChain& chain, int nFlushHeight)
+{
+    const auto proTxHash = [](uint64_t i) { return ArithToUint256(arith_uint256{i + 1}); };
+    const int nDIP3Height{Params().GetConsensus().DIP0003Height};
+    std::vector<CDeterministicMNList> lists;
+    CDeterministicMNList list(chain.hashes[nDIP3Height - 1], nDIP3Height - 1, 0);
+    for (int i = nDIP3Height; i < (int)chain.blocks.size(); ++i) {
+        CDeterministicMNList newList = list;
+        newList.SetBlockHash(chain.hashes[i]);
+        newList.SetHeight(i);
+        auto dmn = std::make_shared<CDeterministicMN>(i);
+        dmn->proTxHash = proTxHash(i);
+        dmn->collateralOutpoint = COutPoint(dmn->proTxHash, 0);
+        auto state = std::make_shared<CDeterministicMNState>();
+        std::vector<unsigned char> owner(20);
+        WriteLE32(owner.data(), i);
+        state->keyIDOwner = CKeyID(uint160(owner));
+        dmn->pdmnState = state;
+        newList.AddMN(dmn);
+        if (i % 3 == 0 && newList.HasMN(proTxHash(i - 2))) {
+            auto newState = std::make_shared<CDeterministicMNState>(*newList.GetMN(proTxHash(i - 2))->pdmnState);
+            newState->nPoSePenalty = i % 100;
+            newList.UpdateMN(proTxHash(i - 2), newState);
+        }
+        if (i % 5 == 0 && newList.HasMN(proTxHash(i - 4))) {
+            newList.RemoveMN(proTxHash(i - 4));
+        }
+        CDeterministicMNListDiff diff;
+        CDeterministicMNListNEVMAddressDiff diffNEVM;
+        list.BuildDiff(newList, diff, diffNEVM);
+        BOOST_REQUIRE(manager.WriteList(&chain.blocks[i], newList, std::move(diff)));
+        if (i == nFlushHeight) {
+            BOOST_REQUIRE(manager.FlushCacheToDisk(/*bForceFlush=*/true));
+        }
+        lists.push_back(newList);
+        list = std::move(newList);
+    }
+    BOOST_REQUIRE(manager.FlushCacheToDisk(/*bForceFlush=*/true));
+    return lists;
+}
+
+/** Compare the masternodes themselves only if fFull, that is slow for the large lists */
+static void CheckListsEqual(const CDeterministicMNList& list, const CDeterministicMNList& expected, bool fFull)
+{
+    BOOST_CHECK(list.GetBlockHash() == expected.GetBlockHash());
+    BOOST_CHECK_EQUAL(list.GetTotalRegisteredCount(), expected.GetTotalRegisteredCount());
+    BOOST_REQUIRE_EQUAL(list.GetAllMNsCount(), expected.GetAllMNsCount());
+    if (!fFull) return;
+    expected.ForEachMN(/*onlyValid=*/false, [&](const CDeterministicMN& dmn) {
+        const auto other = list.GetMN(dmn.proTxHash);
+        BOOST_REQUIRE(other);
+        BOOST_CHECK(::SerializeHash(*other) == ::SerializeHash(dmn));
+    });
+}
+
+// SYSCOIN the database keeps the lists of the last snapshot periods across restarts, older lists are gone for good
+// and must not be made up from nothing
+BOOST_AUTO_TEST_CASE(dmn_list_db_reload)
+{
+    BasicTestingSetup setup{ChainType::REGTEST};
+    constexpr int PERIOD{CDeterministicMNManager::DISK_SNAPSHOT_PERIOD};
+    const int nDIP3Height{Params().GetConsensus().DIP0003Height};
+    const int nTipHeight{nDIP3Height + 8 * PERIOD};
+    const TestBlockIndexChain chain(nTipHeight);
+    DBParams params{.path = setup.m_path_root / "evodb_reload", .cache_bytes = 1 << 20, .wipe_data = true};
+    std::vector<CDeterministicMNList> lists;
+    {
+        CDeterministicMNManager manager(params);
+        // a flush in the middle of a period leaves diffs in the caches that start from a list already on disk
+        lists = WriteTestLists(manager, chain, /*nFlushHeight=*/nDIP3Height + 3 * PERIOD + PERIOD / 2);
+    }
+
+    params.wipe_data = false;
+    CDeterministicMNManager manager(params);
+    // the last wipe kept the three snapshots the caches held and everything after them, lists below are either
+    // read back correctly or missing
+    const int nOldestKept{nTipHeight - nTipHeight % PERIOD - 3 * PERIOD};
+    for (int i = nDIP3Height; i <= nTipHeight; ++i) {
+        CDeterministicMNList list;
+        try {
+            list = manager.GetListForBlock(&chain.blocks[i]);
+        } catch (const std::runtime_error&) {
+            BOOST_CHECK_LT(i, nOldestKept);
+            continue;
+        }
+        CheckListsEqual(list, lists[i - nDIP3Height], /*fFull=*/i % 64 == 0 || i == nTipHeight);
+    }
+}
+
+// SYSCOIN snapshots written as chains of deltas read back the same as full snapshots
+BOOST_AUTO_TEST_CASE(dmn_list_delta_snapshots_reload)
+{
+    BasicTestingSetup setup{ChainType::REGTEST};
+    constexpr int PERIOD{CDeterministicMNManager::DISK_SNAPSHOT_PERIOD};
+    const int nDIP3Height{Params().GetConsensus().DIP0003Height};
+    const int nTipHeight{nDIP3Height + 8 * PERIOD};
+    const TestBlockIndexChain chain(nTipHeight);
+    DBParams params{.path = setup.m_path_root / "evodb_full", .cache_bytes = 1 << 20, .wipe_data = true};
+    DBParams deltaParams{.path = setup.m_path_root / "evodb_deltas", .cache_bytes = 1 << 20, .wipe_data = true};
+    std::vector<CDeterministicMNList> lists;
+    {
+        CDeterministicMNManager manager(params, /*fDeltaSnapshots=*/false);
+        CDeterministicMNManager deltaManager(deltaParams, /*fDeltaSnapshots=*/true);
+        lists = WriteTestLists(manager, chain, /*nFlushHeight=*/-1);
+        BOOST_CHECK_EQUAL(WriteTestLists(deltaManager, chain, /*nFlushHeight=*/-1).size(), lists.size());
+    }
+
+    params.wipe_data = deltaParams.wipe_data = false;
+    CDeterministicMNManager manager(params, /*fDeltaSnapshots=*/false);
+    CDeterministicMNManager deltaManager(deltaParams, /*fDeltaSnapshots=*/true);
+    int nDeltas{0};
+    int nChainLength{0};
+    for (int i = nDIP3Height; i <= nTipHeight; ++i) {
+        const uint256& blockHash = chain.hashes[i];
+        if (i % PERIOD == 0) {
+            BOOST_CHECK(!manager.m_evoDbSnapshotDeltas->ExistsCache(blockHash));
+            if (deltaManager.m_evoDbSnapshotDeltas->ExistsCache(blockHash)) {
+                BOOST_CHECK(!deltaManager.m_evoDb->ExistsCache(blockHash));
+                ++nDeltas;
+                BOOST_CHECK_LE(++nChainLength, CDeterministicMNManager::MAX_SNAPSHOT_DELTAS);
+            } else {
+                nChainLength = 0;
+            }
+        }
+        std::optional<CDeterministicMNList> list, deltaList;
+        try {
+            list = manager.GetListForBlock(&chain.blocks[i]);
+        } catch (const std::runtime_error&) {
+        }
+        try {
+            deltaList = deltaManager.GetListForBlock(&chain.blocks[i]);
+        } catch (const std::runtime_error&) {
+        }
+        // older lists may be gone from either database, depending on when its caches were wiped
+        if (i >= nTipHeight - nTipHeight % PERIOD - 2 * PERIOD) {
+            BOOST_REQUIRE(list && deltaList);
+        }
+        const bool fFull{i % PERIOD == 0 || i % 64 == 0 || i == nTipHeight};
+        if (list) CheckListsEqual(*list, lists[i - nDIP3Height], fFull);
+        if (deltaList) CheckListsEqual(*deltaList, lists[i - nDIP3Height], fFull);
+    }
+    BOOST_CHECK_GT(nDeltas, 0);
+}
 BOOST_AUTO_TEST_SUITE_END()
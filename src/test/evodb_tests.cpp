@@ -73,6 +73,54 @@ BOOST_AUTO_TEST_CASE(TestCacheEviction) {
     BOOST_CHECK_EQUAL(fifoList.size(), 3);
 }
 
+BOOST_AUTO_TEST_CASE(TestCacheEvictionLRU) {
+    auto dbParams = DBParams{
+        .path = "testdb",
+        .cache_bytes = static_cast<size_t>(1 << 20),
+        .memory_only = true};
+    CEvoDB<int, int> evoDB(dbParams, 3);
+
+    evoDB.WriteCache(1, one);
+    evoDB.WriteCache(2, two);
+    evoDB.WriteCache(3, three);
+    int value;
+    // a read makes 1 the most recently used entry so 2 is evicted instead
+    BOOST_CHECK(evoDB.ReadCache(1, value));
+    evoDB.WriteCache(4, four);
+
+    BOOST_CHECK(evoDB.ReadCache(1, value));
+    BOOST_CHECK_EQUAL(value, one);
+    BOOST_CHECK(!evoDB.ReadCache(2, value));
+    BOOST_CHECK(evoDB.ReadCache(3, value));
+    BOOST_CHECK(evoDB.ReadCache(4, value));
+}
+
+BOOST_AUTO_TEST_CASE(TestCacheMemoryBudget) {
+    auto dbParams = DBParams{
+        .path = "testdb",
+        .cache_bytes = static_cast<size_t>(1 << 20),
+        .memory_only = true};
+    const std::vector<int> small(1, 1);
+    const std::vector<int> large(1000, 2);
+    // room for the large entry and a few small ones but not for two large entries
+    CEvoDB<int, std::vector<int>> evoDB(dbParams, 0, memusage::DynamicUsage(large) * 3 / 2);
+
+    evoDB.WriteCache(1, small);
+    evoDB.WriteCache(2, large);
+    BOOST_CHECK_EQUAL(evoDB.GetReadWriteCacheSize(), 2);
+    BOOST_CHECK(!evoDB.IsCacheFull());
+    evoDB.WriteCache(3, large);
+    // both older entries had to go to fit the second large one
+    BOOST_CHECK_EQUAL(evoDB.GetReadWriteCacheSize(), 1);
+    std::vector<int> value;
+    BOOST_CHECK(!evoDB.ReadCache(2, value));
+    BOOST_CHECK(evoDB.ReadCache(3, value));
+    BOOST_CHECK(value == large);
+
+    evoDB.EraseCache(3);
+    BOOST_CHECK_EQUAL(evoDB.GetCacheUsage(), 0);
+}
+
 BOOST_AUTO_TEST_CASE(TestEraseCache) {
     auto dbParams = DBParams{
         .path = "testdb",
@@ -102,23 +150,24 @@ BOOST_AUTO_TEST_CASE(TestEraseCache) {
     BOOST_CHECK(eraseCache.find(2) != eraseCache.end());
 
     int value;
-    // should flush to disk
+    // reads honour the pending erase without flushing
     BOOST_CHECK(!evoDB.ReadCache(2, value));
+    BOOST_CHECK(!evoDB.ExistsCache(2));
     BOOST_CHECK(evoDB.ReadCache(1, value));
     BOOST_CHECK_EQUAL(value, one);
 
     BOOST_CHECK(evoDB.ReadCache(3, value));
     BOOST_CHECK_EQUAL(value, three);
 
-    // Check internal structures that are empty after read flush (after erase)
+    // Check internal structures are untouched by the reads
     mapCache = evoDB.GetMapCache();
     fifoList = evoDB.GetFifoList();
     eraseCache = evoDB.GetEraseCacheCopy();
 
-    BOOST_CHECK_EQUAL(mapCache.size(), 0);
-    BOOST_CHECK_EQUAL(fifoList.size(), 0);
-    BOOST_CHECK_EQUAL(eraseCache.size(), 0);
-    BOOST_CHECK(eraseCache.find(2) == eraseCache.end());
+    BOOST_CHECK_EQUAL(mapCache.size(), 2);
+    BOOST_CHECK_EQUAL(fifoList.size(), 2);
+    BOOST_CHECK_EQUAL(eraseCache.size(), 1);
+    BOOST_CHECK(eraseCache.find(2) != eraseCache.end());
 }
 
 BOOST_AUTO_TEST_CASE(TestFlushCacheToDisk) {
@@ -154,6 +203,74 @@ BOOST_AUTO_TEST_CASE(TestFlushCacheToDisk) {
     BOOST_CHECK_EQUAL(eraseCache.size(), 0);
 }
 
+BOOST_AUTO_TEST_CASE(TestIsCached) {
+    auto dbParams = DBParams{
+        .path = "testdb",
+        .cache_bytes = static_cast<size_t>(1 << 20),
+        .memory_only = true};
+    CEvoDB<int, int> evoDB(dbParams, 3);
+
+    evoDB.WriteCache(1, one);
+    BOOST_CHECK(evoDB.IsCached(1));
+    BOOST_CHECK(!evoDB.IsCached(2));
+
+    // entries on disk exist but are no longer part of the next flush
+    BOOST_CHECK(evoDB.FlushCacheToDisk());
+    BOOST_CHECK(!evoDB.IsCached(1));
+    BOOST_CHECK(evoDB.ExistsCache(1));
+
+    evoDB.WriteCache(1, two);
+    BOOST_CHECK(evoDB.IsCached(1));
+    evoDB.EraseCache(1);
+    BOOST_CHECK(!evoDB.IsCached(1));
+}
+
+BOOST_AUTO_TEST_CASE(TestFlushCacheToDiskAsync) {
+    auto dbParams = DBParams{
+        .path = "testdb",
+        .cache_bytes = static_cast<size_t>(1 << 20),
+        .memory_only = true};
+    CEvoDB<int, int> evoDB(dbParams, 3);
+
+    evoDB.WriteCache(1, one);
+    evoDB.WriteCache(2, two);
+    BOOST_CHECK(evoDB.FlushCacheToDisk());
+
+    evoDB.EraseCache(1);
+    evoDB.WriteCache(3, three);
+    BOOST_CHECK(evoDB.FlushCacheToDiskAsync());
+    // the cache is handed off at once, reads see the in-flight buffer until it is written
+    BOOST_CHECK_EQUAL(evoDB.GetReadWriteCacheSize(), 0);
+    BOOST_CHECK_EQUAL(evoDB.GetEraseCacheSize(), 0);
+    evoDB.WriteCache(4, four);
+
+    int value;
+    BOOST_CHECK(!evoDB.ReadCache(1, value));
+    BOOST_CHECK(evoDB.ReadCache(2, value));
+    BOOST_CHECK_EQUAL(value, two);
+    BOOST_CHECK(evoDB.ReadCache(3, value));
+    BOOST_CHECK_EQUAL(value, three);
+    BOOST_CHECK(evoDB.ReadCache(4, value));
+    BOOST_CHECK_EQUAL(value, four);
+
+    evoDB.WaitForFlush();
+    BOOST_CHECK(!evoDB.Read(1, value));
+    BOOST_CHECK(evoDB.Read(3, value));
+    BOOST_CHECK_EQUAL(value, three);
+    BOOST_CHECK(!evoDB.Read(4, value));
+
+    // a wiping flush drops everything on disk that is not in the cache
+    BOOST_CHECK(evoDB.FlushCacheToDiskAsync(/*fWipe=*/true));
+    BOOST_CHECK(!evoDB.ReadCache(2, value));
+    BOOST_CHECK(evoDB.ReadCache(4, value));
+    BOOST_CHECK_EQUAL(value, four);
+    evoDB.WaitForFlush();
+    BOOST_CHECK(!evoDB.Read(2, value));
+    BOOST_CHECK(!evoDB.Read(3, value));
+    BOOST_CHECK(evoDB.Read(4, value));
+    BOOST_CHECK_EQUAL(value, four);
+}
+
 BOOST_AUTO_TEST_CASE(TestMaxCacheSize) {
     auto dbParams = DBParams{
         .path = "testdb",
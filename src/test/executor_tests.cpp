@@ -0,0 +1,66 @@
+// Copyright (c) 2024 The Syscoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <util/executor.h>
+#include <util/time.h>
+
+#include <test/util/setup_common.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <atomic>
+#include <future>
+
+BOOST_FIXTURE_TEST_SUITE(executor_tests, BasicTestingSetup)
+
+BOOST_AUTO_TEST_CASE(executor_lanes)
+{
+    Executor executor{3};
+    BOOST_CHECK_EQUAL(executor.ThreadCount(), 3);
+
+    // tasks submitting more tasks from the workers go through the worker deques and get stolen from there
+    std::atomic<int> done{0};
+    std::promise<void> all_done;
+    constexpr int PARENTS{100};
+    for (int i = 0; i < PARENTS; ++i) {
+        executor.Submit(Executor::Lane::LLMQ, [&](int) {
+            executor.Submit(Executor::Lane::BACKGROUND, [&](int) {
+                if (++done == 2 * PARENTS) all_done.set_value();
+            });
+            if (++done == 2 * PARENTS) all_done.set_value();
+        });
+    }
+    all_done.get_future().wait();
+
+    // the counters are updated after a task returns
+    for (int i = 0; i < 1000 && executor.GetStats(Executor::Lane::BACKGROUND).completed < PARENTS; ++i) {
+        UninterruptibleSleep(std::chrono::milliseconds{1});
+    }
+    const auto llmq{executor.GetStats(Executor::Lane::LLMQ)};
+    const auto background{executor.GetStats(Executor::Lane::BACKGROUND)};
+    BOOST_CHECK_EQUAL(llmq.submitted, uint64_t{PARENTS});
+    BOOST_CHECK_EQUAL(llmq.completed, uint64_t{PARENTS});
+    BOOST_CHECK_EQUAL(background.submitted, uint64_t{PARENTS});
+    BOOST_CHECK_EQUAL(background.completed, uint64_t{PARENTS});
+    BOOST_CHECK_EQUAL(background.queued, 0U);
+    BOOST_CHECK_EQUAL(executor.GetStats(Executor::Lane::VALIDATION).submitted, 0U);
+}
+
+BOOST_AUTO_TEST_CASE(executor_task_group)
+{
+    ExecutorTaskGroup group{Executor::Lane::LLMQ};
+    auto sum = group.push([](int, int a, int b) { return a + b; }, 2, 3);
+    BOOST_CHECK_EQUAL(sum.get(), 5);
+
+    // work pushed to a stopped group is dropped, its future is broken like the one of a cleared thread pool queue
+    group.Stop();
+    auto dropped = group.push([](int) { return true; });
+    BOOST_CHECK_THROW(dropped.get(), std::future_error);
+
+    group.Start();
+    auto again = group.push([](int) { return true; });
+    BOOST_CHECK(again.get());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,141 @@
+// Copyright (c) 2024 The Syscoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <flatdatabase.h>
+#include <test/util/setup_common.h>
+#include <util/fs.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <fstream>
+#include <map>
+
+namespace {
+/** A cache of numbered strings stored as one record per entry */
+struct TestStore
+{
+    static constexpr uint8_t RECORD_VERSION{0};
+    static constexpr uint8_t RECORD_ENTRY{1};
+
+    std::string strVersion{"TestStore-Version-1"};
+    std::map<int32_t, std::string> mapEntries;
+
+    template<typename Stream>
+    void Serialize(Stream& s) const { s << strVersion << mapEntries; }
+
+    template<typename Stream>
+    void Unserialize(Stream& s) { s >> strVersion >> mapEntries; }
+
+    template<typename Writer>
+    void SerializeRecords(Writer& w) const
+    {
+        w.Write(RECORD_VERSION, strVersion);
+        for (const auto& [n, str] : mapEntries) {
+            w.Write(RECORD_ENTRY, n, str);
+        }
+    }
+
+    template<typename Stream>
+    bool UnserializeRecord(Stream& s)
+    {
+        uint8_t nType;
+        s >> nType;
+        if (nType == RECORD_VERSION) {
+            std::string strVersionIn;
+            s >> strVersionIn;
+            return strVersionIn == strVersion;
+        }
+        int32_t n;
+        std::string str;
+        s >> n >> str;
+        mapEntries.emplace(n, str);
+        return true;
+    }
+
+    void Clear() { mapEntries.clear(); }
+    std::string ToString() const { return strprintf("Entries: %d", mapEntries.size()); }
+};
+
+TestStore MakeStore()
+{
+    TestStore store;
+    for (int32_t n = 0; n < 10; ++n) {
+        store.mapEntries.emplace(n, std::string(100, 'a' + n));
+    }
+    return store;
+}
+
+/** Offset of an entry record: header, version record, then entry records of equal size */
+size_t EntryRecordOffset(const TestStore& store, int32_t n)
+{
+    const std::string strMagic{"magicTestCache"};
+    const size_t nHeader{GetSerializeSize(strMagic, CLIENT_VERSION) + 4 + 1};
+    const size_t nVersionRecord{4 + 1 + GetSerializeSize(store.strVersion, CLIENT_VERSION) + 4};
+    const size_t nEntryRecord{4 + 1 + 4 + GetSerializeSize(store.mapEntries.at(0), CLIENT_VERSION) + 4};
+    return nHeader + nVersionRecord + n * nEntryRecord;
+}
+} // namespace
+
+BOOST_FIXTURE_TEST_SUITE(flatdatabase_tests, BasicTestingSetup)
+
+BOOST_AUTO_TEST_CASE(flatdb_records)
+{
+    const fs::path path{gArgs.GetDataDirNet() / "testcache.dat"};
+    CFlatDB<TestStore> flatdb("testcache.dat", "magicTestCache");
+    TestStore store{MakeStore()};
+    BOOST_REQUIRE(flatdb.Store(store));
+
+    TestStore loaded;
+    BOOST_REQUIRE(flatdb.Load(loaded));
+    BOOST_CHECK(loaded.mapEntries == store.mapEntries);
+
+    // a damaged record is skipped, the ones after it are still loaded
+    {
+        std::fstream file{path, std::ios::in | std::ios::out | std::ios::binary};
+        file.seekp(EntryRecordOffset(store, 3) + 20);
+        file.put('!');
+    }
+    BOOST_REQUIRE(flatdb.Load(loaded));
+    BOOST_CHECK_EQUAL(loaded.mapEntries.size(), 9U);
+    BOOST_CHECK(!loaded.mapEntries.count(3));
+    BOOST_CHECK(loaded.mapEntries.count(9));
+
+    // a truncated file keeps the records before the damage
+    fs::resize_file(path, EntryRecordOffset(store, 6) + 50);
+    BOOST_REQUIRE(flatdb.Load(loaded));
+    BOOST_CHECK_EQUAL(loaded.mapEntries.size(), 5U);
+    BOOST_CHECK(loaded.mapEntries.count(5));
+
+    // records of another version are not loaded
+    TestStore other{MakeStore()};
+    other.strVersion = "TestStore-Version-2";
+    BOOST_REQUIRE(flatdb.Store(other));
+    BOOST_REQUIRE(flatdb.Load(loaded));
+    BOOST_CHECK(loaded.mapEntries.empty());
+}
+
+BOOST_AUTO_TEST_CASE(flatdb_legacy)
+{
+    // files of older versions hold the object followed by the hash of the whole file
+    const TestStore store{MakeStore()};
+    CDataStream ssObj(SER_DISK, CLIENT_VERSION);
+    ssObj << std::string{"magicTestCache"} << Params().MessageStart() << store;
+    ssObj << Hash(ssObj);
+    {
+        CAutoFile file{fsbridge::fopen(gArgs.GetDataDirNet() / "legacycache.dat", "wb"), CLIENT_VERSION};
+        file.write(MakeByteSpan(ssObj));
+    }
+
+    CFlatDB<TestStore> flatdb("legacycache.dat", "magicTestCache");
+    TestStore loaded;
+    BOOST_REQUIRE(flatdb.Load(loaded));
+    BOOST_CHECK(loaded.mapEntries == store.mapEntries);
+
+    // a cache of another type is not overwritten
+    CFlatDB<TestStore> otherdb("legacycache.dat", "magicOtherCache");
+    BOOST_CHECK(!otherdb.Load(loaded));
+    BOOST_CHECK(!otherdb.Store(loaded));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
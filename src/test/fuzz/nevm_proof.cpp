@@ -0,0 +1,102 @@
+// Copyright (c) 2024 The Syscoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <nevm/nevm.h>
+#include <nevm/sha3.h>
+#include <test/fuzz/FuzzedDataProvider.h>
+#include <test/fuzz/fuzz.h>
+#include <util/strencodings.h>
+
+#include <cassert>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace {
+/** The hex string based verifier VerifyProof() replaced, kept as the reference it must agree with */
+int LegacyNibblesToTraverse(const std::string& encodedPartialPath, const std::string& path, int pathPtr)
+{
+    std::string partialPath;
+    uint8_t partialPathInt;
+    char pathPtrInt[2] = {encodedPartialPath[0], '\0'};
+    if (!ParseUInt8(pathPtrInt, &partialPathInt)) return -1;
+    if (partialPathInt == 0 || partialPathInt == 2) {
+        partialPath = encodedPartialPath.substr(2);
+    } else {
+        partialPath = encodedPartialPath.substr(1);
+    }
+    if (partialPath == path.substr(pathPtr, partialPath.size())) return partialPath.size();
+    return -1;
+}
+
+bool LegacyVerifyProof(dev::bytesConstRef path, const dev::RLP& value, const dev::RLP& parentNodes, const dev::RLP& root)
+{
+    const int len = parentNodes.itemCount();
+    dev::RLP nodeKey = root;
+    int pathPtr = 0;
+    const std::string pathString = dev::toHex(path);
+    for (int i = 0; i < len; i++) {
+        const dev::RLP currentNode = parentNodes[i];
+        if (!nodeKey.payload().contentsEqual(dev::sha3(currentNode.data()).ref().toVector())) return false;
+        if (pathPtr > (int)pathString.size()) return false;
+        switch (currentNode.itemCount()) {
+        case 17: {
+            if (pathPtr == (int)pathString.size()) return currentNode[16].payload().contentsEqual(value.data().toVector());
+            uint8_t pathInt;
+            const char pathPtrInt[2] = {pathString[pathPtr], '\0'};
+            if (!ParseUInt8FromHex(pathPtrInt, &pathInt)) return false;
+            nodeKey = currentNode[pathInt];
+            pathPtr += 1;
+            break;
+        }
+        case 2: {
+            const int nibbles = LegacyNibblesToTraverse(dev::toHex(currentNode[0].payload()), pathString, pathPtr);
+            if (nibbles <= -1) return false;
+            pathPtr += nibbles;
+            if (pathPtr == (int)pathString.size()) {
+                dev::bytes nodeVec(currentNode[1].toBytes());
+                if (!nodeVec.empty() && nodeVec[0] < 0x7f) {
+                    nodeVec = dev::bytes(nodeVec.begin() + 1, nodeVec.end());
+                }
+                return nodeVec == value.data().toBytes();
+            }
+            nodeKey = currentNode[1];
+            break;
+        }
+        default:
+            return false;
+        }
+    }
+    return false;
+}
+
+template <typename F>
+std::optional<bool> Run(F&& f)
+{
+    try {
+        return f();
+    } catch (const dev::Exception&) {
+        return std::nullopt;
+    }
+}
+} // namespace
+
+FUZZ_TARGET(nevm_proof)
+{
+    FuzzedDataProvider fuzzed_data_provider(buffer.data(), buffer.size());
+    const std::vector<uint8_t> path = fuzzed_data_provider.ConsumeBytes<uint8_t>(fuzzed_data_provider.ConsumeIntegralInRange<size_t>(0, 33));
+    const std::vector<uint8_t> value = fuzzed_data_provider.ConsumeBytes<uint8_t>(fuzzed_data_provider.ConsumeIntegralInRange<size_t>(0, 256));
+    const std::vector<uint8_t> root = fuzzed_data_provider.ConsumeBytes<uint8_t>(33);
+    const std::vector<uint8_t> parentNodes = fuzzed_data_provider.ConsumeRemainingBytes<uint8_t>();
+
+    const dev::bytesConstRef pathRef(path.data(), path.size());
+    const std::optional<bool> legacy = Run([&] {
+        return LegacyVerifyProof(pathRef, dev::RLP(&value), dev::RLP(&parentNodes), dev::RLP(&root));
+    });
+    const std::optional<bool> streaming = Run([&] {
+        return VerifyProof(pathRef, dev::RLP(&value), dev::RLP(&parentNodes), dev::RLP(&root));
+    });
+    assert(legacy == streaming);
+}
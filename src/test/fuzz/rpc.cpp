@@ -115,6 +115,7 @@ const std::vector<std::string> RPC_COMMANDS_SAFE_FOR_FUZZING{
     "bls_fromsecret",
     "protx_list",
     "protx_info",
+    "protx_diff",
     "quorum_list",
     "quorum_info",
     "quorum_dkgstatus",
@@ -126,12 +127,14 @@ const std::vector<std::string> RPC_COMMANDS_SAFE_FOR_FUZZING{
     "quorum_verify",
     "quorum_isconflicting",
     "quorum_sign",
+    "quorum_sigsharestats",
     "gobject_getcurrentvotes",
     "gobject_submit",
     "createauxblock",
     "submitauxblock",
     "syscoingettxroots",
     "syscoingetspvproof",
+    "syscoingetspvproofs",
     "syscoindecoderawtransaction",
     "getnevmblobdata",
     "listnevmblobdata",
@@ -139,6 +142,13 @@ const std::vector<std::string> RPC_COMMANDS_SAFE_FOR_FUZZING{
     "syscoinstopgeth",
     "syscoinstartgeth",
     "syscoincheckmint",
+    "syscoincheckmints",
+    "getassetoutputs",
+    "getblockstatsrange",
+    "getaddressbalance",
+    "getaddresshistory",
+    "getaddressutxos",
+    "getassetsupplyinfo",
     "analyzepsbt",
     "clearbanned",
     "combinepsbt",
@@ -178,14 +188,17 @@ const std::vector<std::string> RPC_COMMANDS_SAFE_FOR_FUZZING{
     "getconnectioncount",
     "getdeploymentinfo",
     "getdescriptorinfo",
+    "getexecutorinfo",
     "getdifficulty",
     "getindexinfo",
     "getmemoryinfo",
     "getmempoolancestors",
     "getmempooldescendants",
     "getmempoolentry",
+    "getmempoolfeehistogram",
     "getmempoolinfo",
     "getmininginfo",
+    "getnetmsgstats",
     "getnettotals",
     "getnetworkhashps",
     "getnetworkinfo",
@@ -196,6 +209,8 @@ const std::vector<std::string> RPC_COMMANDS_SAFE_FOR_FUZZING{
     "getrawmempool",
     "getrawtransaction",
     "getrpcinfo",
+    "getschedulerinfo",
+    "getstartupinfo",
     "gettxout",
     "gettxoutsetinfo",
     "gettxspendingprevout",
@@ -233,11 +248,15 @@ const std::vector<std::string> RPC_COMMANDS_SAFE_FOR_FUZZING{
     "waitforblockheight",
     "waitfornewblock",
     "syscoincreatenevmblob",
+    "syscoincreatenevmblobfile",
+    "syscoincreatenevmblobs",
     "syscoincreaterawnevmblob",
     "protx_update_service",
     "protx_register",
     "protx_register_prepare",
     "protx_update_registrar",
+    "protx_update_service_batch",
+    "protx_update_registrar_batch",
     "protx_list_wallet",
     "signmessagebech32",
     "getauxblock",
@@ -247,6 +266,7 @@ const std::vector<std::string> RPC_COMMANDS_SAFE_FOR_FUZZING{
     "protx_revoke",
     "gobject_vote_alias",
     "gobject_vote_many",
+    "gobject_vote_many_batch",
     "gobject_prepare",
     "gobject_list_prepared",
     "masternode_outputs"
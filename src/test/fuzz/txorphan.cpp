@@ -132,8 +132,10 @@ FUZZ_TARGET(txorphan, .init = initialize_orphanage)
                     // test mocktime and expiry
                     SetMockTime(ConsumeTime(fuzzed_data_provider));
                     auto limit = fuzzed_data_provider.ConsumeIntegral<unsigned int>();
-                    orphanage.LimitOrphans(limit);
+                    auto max_usage = fuzzed_data_provider.ConsumeIntegral<size_t>();
+                    orphanage.LimitOrphans(limit, max_usage);
                     Assert(orphanage.Size() <= limit);
+                    Assert(orphanage.TotalUsage() <= max_usage);
                 });
         }
     }
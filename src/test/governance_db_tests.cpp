@@ -0,0 +1,195 @@
+// Copyright (c) 2024 The Syscoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <governance/governancedb.h>
+#include <governance/governanceobject.h>
+#include <governance/governancevote.h>
+#include <governance/governancevotedb.h>
+#include <streams.h>
+
+#include <test/util/random.h>
+#include <test/util/setup_common.h>
+
+#include <algorithm>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+BOOST_FIXTURE_TEST_SUITE(governance_db_tests, BasicTestingSetup)
+
+static std::vector<uint256> StoredObjects(CGovernanceDB& db)
+{
+    std::vector<uint256> ret;
+    db.ForEachObject([&](CGovernanceObject&& govobj) { ret.emplace_back(govobj.GetHash()); });
+    return ret;
+}
+
+static std::vector<uint256> StoredVotes(CGovernanceDB& db)
+{
+    std::vector<uint256> ret;
+    db.ForEachVote([&](const CGovernanceVote& vote) { ret.emplace_back(vote.GetHash()); });
+    return ret;
+}
+
+static CGovernanceVote MakeVote(const COutPoint& outpoint, const uint256& nParentHash, vote_outcome_enum_t eOutcome, int64_t nTime)
+{
+    CGovernanceVote vote(outpoint, nParentHash, VOTE_SIGNAL_FUNDING, eOutcome);
+    vote.SetTime(nTime);
+    return vote;
+}
+
+BOOST_AUTO_TEST_CASE(governance_db_records)
+{
+    CGovernanceDB db(DBParams{.path = m_args.GetDataDirNet() / "governance", .cache_bytes = 1 << 20, .memory_only = true});
+
+    const CGovernanceObject govobj(uint256(), 1, 1000, InsecureRand256(), "");
+    const uint256 nHash = govobj.GetHash();
+    db.WriteObject(govobj);
+
+    const COutPoint outpoint(InsecureRand256(), 0);
+    const CGovernanceVote vote1 = MakeVote(outpoint, nHash, VOTE_OUTCOME_YES, 1000);
+    const CGovernanceVote vote2 = MakeVote(outpoint, nHash, VOTE_OUTCOME_NO, 2000);
+    const CGovernanceVote otherVote = MakeVote(COutPoint(InsecureRand256(), 1), InsecureRand256(), VOTE_OUTCOME_YES, 1000);
+    db.WriteVote(vote1);
+    db.WriteVote(otherVote);
+    // the newer vote of the same masternode replaces the older record
+    db.WriteVote(vote2, vote1.GetHash());
+
+    BOOST_CHECK(StoredObjects(db) == std::vector<uint256>{nHash});
+    auto votes = StoredVotes(db);
+    BOOST_CHECK_EQUAL(votes.size(), 2);
+    BOOST_CHECK(std::count(votes.begin(), votes.end(), vote2.GetHash()) == 1);
+    BOOST_CHECK(std::count(votes.begin(), votes.end(), otherVote.GetHash()) == 1);
+
+    // erasing an object drops its votes but not those of other objects
+    db.EraseObject(nHash);
+    BOOST_CHECK(StoredObjects(db).empty());
+    BOOST_CHECK(StoredVotes(db) == std::vector<uint256>{otherVote.GetHash()});
+
+    BOOST_CHECK(!db.HasMeta());
+    const uint256 metaIn = InsecureRand256();
+    BOOST_CHECK(db.WriteMeta(metaIn, /*fSync=*/false));
+    uint256 meta;
+    BOOST_CHECK(db.ReadMeta(meta) && meta == metaIn);
+
+    db.Wipe();
+    BOOST_CHECK(!db.HasMeta());
+    BOOST_CHECK(StoredVotes(db).empty());
+}
+
+BOOST_AUTO_TEST_CASE(governance_object_load_votes)
+{
+    CGovernanceObject govobj(uint256(), 1, 1000, InsecureRand256(), "");
+    const COutPoint outpoint(InsecureRand256(), 0);
+    const CGovernanceVote vote1 = MakeVote(outpoint, govobj.GetHash(), VOTE_OUTCOME_YES, 1000);
+    const CGovernanceVote vote2 = MakeVote(outpoint, govobj.GetHash(), VOTE_OUTCOME_NO, 2000);
+
+    BOOST_CHECK(!govobj.GetCurrentVoteHash(outpoint, VOTE_SIGNAL_FUNDING));
+    BOOST_CHECK(govobj.LoadVote(vote1));
+    BOOST_CHECK(govobj.GetCurrentVoteHash(outpoint, VOTE_SIGNAL_FUNDING) == vote1.GetHash());
+    BOOST_CHECK(govobj.LoadVote(vote2));
+    BOOST_CHECK(govobj.GetCurrentVoteHash(outpoint, VOTE_SIGNAL_FUNDING) == vote2.GetHash());
+
+    // replaying the older vote again does not bring it back
+    BOOST_CHECK(!govobj.LoadVote(vote1));
+    BOOST_CHECK(!govobj.GetVoteFile().HasVote(vote1.GetHash()));
+    BOOST_CHECK(govobj.GetVoteFile().HasVote(vote2.GetHash()));
+    BOOST_CHECK_EQUAL(govobj.GetVoteFile().GetVoteCount(), 1);
+    // the vote records are rebuilt from the replayed votes
+    BOOST_CHECK_EQUAL(govobj.CountMatchingVotes(VOTE_SIGNAL_FUNDING, VOTE_OUTCOME_NO), 1);
+    BOOST_CHECK_EQUAL(govobj.CountMatchingVotes(VOTE_SIGNAL_FUNDING, VOTE_OUTCOME_YES), 0);
+}
+
+BOOST_AUTO_TEST_CASE(governance_object_vote_tally)
+{
+    CGovernanceObject govobj(uint256(), 1, 1000, InsecureRand256(), "");
+    std::vector<COutPoint> outpoints;
+    for (int i = 0; i < 5; ++i) {
+        outpoints.emplace_back(InsecureRand256(), 0);
+        BOOST_CHECK(govobj.LoadVote(MakeVote(outpoints.back(), govobj.GetHash(), i < 3 ? VOTE_OUTCOME_YES : VOTE_OUTCOME_NO, 1000)));
+    }
+    BOOST_CHECK_EQUAL(govobj.GetYesCount(VOTE_SIGNAL_FUNDING), 3);
+    BOOST_CHECK_EQUAL(govobj.GetNoCount(VOTE_SIGNAL_FUNDING), 2);
+    BOOST_CHECK_EQUAL(govobj.GetAbsoluteYesCount(VOTE_SIGNAL_FUNDING), 1);
+    BOOST_CHECK_EQUAL(govobj.GetYesCount(VOTE_SIGNAL_VALID), 0);
+
+    // a newer vote of the same masternode moves it from one count to the other
+    BOOST_CHECK(govobj.LoadVote(MakeVote(outpoints[0], govobj.GetHash(), VOTE_OUTCOME_ABSTAIN, 2000)));
+    BOOST_CHECK_EQUAL(govobj.GetYesCount(VOTE_SIGNAL_FUNDING), 2);
+    BOOST_CHECK_EQUAL(govobj.GetAbstainCount(VOTE_SIGNAL_FUNDING), 1);
+    BOOST_CHECK_EQUAL(govobj.GetAbsoluteYesCount(VOTE_SIGNAL_FUNDING), 0);
+
+    // copies and the disk format carry the counts along with the vote records
+    const CGovernanceObject copy(govobj);
+    BOOST_CHECK_EQUAL(copy.GetNoCount(VOTE_SIGNAL_FUNDING), 2);
+    DataStream ss{SER_DISK};
+    ss << govobj;
+    CGovernanceObject read_back;
+    ss >> read_back;
+    BOOST_CHECK_EQUAL(read_back.GetYesCount(VOTE_SIGNAL_FUNDING), 2);
+    BOOST_CHECK_EQUAL(read_back.GetNoCount(VOTE_SIGNAL_FUNDING), 2);
+    BOOST_CHECK_EQUAL(read_back.GetAbstainCount(VOTE_SIGNAL_FUNDING), 1);
+}
+
+BOOST_AUTO_TEST_CASE(governance_vote_file_compact)
+{
+    const uint256 nParentHash = InsecureRand256();
+    std::vector<CGovernanceVote> votes;
+    for (int i = 0; i < 4; i++) {
+        votes.emplace_back(MakeVote(COutPoint(InsecureRand256(), i), nParentHash, VOTE_OUTCOME_YES, 1000 + i));
+        votes.back().SetSignature(std::vector<unsigned char>(96, i + 1));
+    }
+
+    CGovernanceObjectVoteFile fileVotes;
+    for (size_t i = 0; i < votes.size(); i++) {
+        // the last vote is kept without its signature
+        fileVotes.AddVote(votes[i], /*fKeepSignature=*/i + 1 < votes.size());
+    }
+    BOOST_CHECK_EQUAL(fileVotes.GetVoteCount(), votes.size());
+
+    // votes are rebuilt from the compact entries with the same hash and signature
+    CDataStream ss(SER_NETWORK, PROTOCOL_VERSION);
+    BOOST_CHECK(fileVotes.SerializeVoteToStream(votes[0].GetHash(), ss));
+    CGovernanceVote vote;
+    ss >> vote;
+    BOOST_CHECK(vote.GetHash() == votes[0].GetHash());
+    BOOST_CHECK(vote.GetSignature() == votes[0].GetSignature());
+    // a vote without its signature is known but can't be relayed from memory
+    BOOST_CHECK(fileVotes.HasVote(votes[3].GetHash()));
+    BOOST_CHECK(!fileVotes.SerializeVoteToStream(votes[3].GetHash(), ss));
+
+    // removing a vote from the middle keeps the index of the moved one intact
+    fileVotes.RemoveVotesFromMasternode(votes[1].GetMasternodeOutpoint());
+    BOOST_CHECK(!fileVotes.HasVote(votes[1].GetHash()));
+    BOOST_CHECK_EQUAL(fileVotes.GetVoteCount(), 3);
+    for (size_t i : {0, 2, 3}) {
+        BOOST_CHECK(fileVotes.HasVote(votes[i].GetHash()));
+    }
+    auto hashes = fileVotes.GetVoteHashes();
+    BOOST_CHECK(std::count(hashes.begin(), hashes.end(), votes[3].GetHash()) == 1);
+    fileVotes.RemoveVotesFromMasternode(votes[3].GetMasternodeOutpoint());
+    BOOST_CHECK(!fileVotes.HasVote(votes[3].GetHash()));
+    BOOST_CHECK(fileVotes.HasVote(votes[2].GetHash()));
+
+    // a newer vote of the same masternode and signal replaces the older one
+    CGovernanceVote newer = MakeVote(votes[0].GetMasternodeOutpoint(), nParentHash, VOTE_OUTCOME_NO, 5000);
+    fileVotes.AddVote(newer);
+    BOOST_CHECK(!fileVotes.HasVote(votes[0].GetHash()));
+    BOOST_CHECK(fileVotes.HasVote(newer.GetHash()));
+    BOOST_CHECK_EQUAL(fileVotes.GetVoteCount(), 2);
+
+    // the digest only depends on the set of votes
+    CGovernanceObjectVoteFile otherFile;
+    otherFile.AddVote(votes[2]);
+    BOOST_CHECK(otherFile.GetDigest() != fileVotes.GetDigest());
+    otherFile.AddVote(newer);
+    BOOST_CHECK(otherFile.GetDigest() == fileVotes.GetDigest());
+    otherFile.RemoveVotesFromMasternode(newer.GetMasternodeOutpoint());
+    otherFile.RemoveVotesFromMasternode(votes[2].GetMasternodeOutpoint());
+    BOOST_CHECK(otherFile.GetDigest().IsNull());
+    BOOST_CHECK(otherFile.GetVote(votes[2].GetHash()) == std::nullopt);
+    BOOST_CHECK(fileVotes.GetVote(votes[2].GetHash())->GetHash() == votes[2].GetHash());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
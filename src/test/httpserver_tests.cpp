@@ -2,6 +2,7 @@
 // Distributed under the MIT software license, see the accompanying
 // file COPYING or http://www.opensource.org/licenses/mit-license.php.
 
+#include <httprpc.h>
 #include <httpserver.h>
 #include <test/util/setup_common.h>
 
@@ -39,4 +40,22 @@ BOOST_AUTO_TEST_CASE(test_query_parameters)
     uri = "/rest/endpoint/someresource.json&p1=v1&p2=v2%";
     BOOST_CHECK_EXCEPTION(GetQueryParameterFromUri(uri.c_str(), "p1"), std::runtime_error, HasReason("URI parsing failed, it likely contained RFC 3986 invalid characters"));
 }
+
+// SYSCOIN
+BOOST_AUTO_TEST_CASE(test_find_rpc_methods)
+{
+    using V = std::vector<std::string_view>;
+    const auto check = [](std::string_view body, const V& expected) {
+        const V methods{FindRPCMethods(body)};
+        BOOST_CHECK_EQUAL_COLLECTIONS(methods.begin(), methods.end(), expected.begin(), expected.end());
+    };
+    check(R"({"jsonrpc":"1.0","id":1,"method":"getblocktemplate","params":[]})", V{"getblocktemplate"});
+    check("{ \"method\" :\n \"getblock\", \"params\": [\"method\"]}", V{"getblock"});
+    check(R"([{"method":"getbestblockhash"},{"id":"method","method":"getrawmempool"}])", V{"getbestblockhash", "getrawmempool"});
+    // "method" as a value, escaped quotes and truncated bodies are no method keys
+    check(R"({"params":["method", "x"], "id":"\"method\":\"stop\""})", V{});
+    check(R"({"method":12})", V{});
+    check(R"({"method":"getbl)", V{});
+    check("", V{});
+}
 BOOST_AUTO_TEST_SUITE_END()
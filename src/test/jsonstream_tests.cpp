@@ -0,0 +1,95 @@
+// Copyright (c) 2024 The Syscoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <rpc/jsonstream.h>
+#include <test/util/setup_common.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <string>
+
+BOOST_FIXTURE_TEST_SUITE(jsonstream_tests, BasicTestingSetup)
+
+static UniValue ExpectedReply()
+{
+    UniValue entry(UniValue::VOBJ);
+    entry.pushKV("name", "a \"quoted\" name");
+    entry.pushKV("values", UniValue(UniValue::VARR));
+    entry.pushKV("amount", 5);
+    UniValue result(UniValue::VOBJ);
+    for (int i = 0; i < 10; ++i) {
+        result.pushKV("entry" + std::to_string(i), entry);
+    }
+    UniValue reply(UniValue::VOBJ);
+    reply.pushKV("result", result);
+    reply.pushKV("error", NullUniValue);
+    reply.pushKV("id", 1);
+    return reply;
+}
+
+BOOST_AUTO_TEST_CASE(stream_matches_tree)
+{
+    const UniValue expected{ExpectedReply()};
+    const UniValue& entry = expected["result"]["entry0"];
+    for (const size_t flush_size : {size_t{1}, size_t{64}, DEFAULT_JSON_STREAM_FLUSH_SIZE}) {
+        std::string out;
+        size_t chunks{0};
+        JSONStreamWriter stream{[&](Span<const char> chunk) { out.append(chunk.begin(), chunk.end()); ++chunks; }, flush_size};
+        stream.BeginObject();
+        stream.Key("result");
+        BOOST_CHECK(stream.AwaitingValue());
+        {
+            RPCResultWriter result{&stream, UniValue::VOBJ};
+            for (int i = 0; i < 10; ++i) {
+                result.pushKV("entry" + std::to_string(i), entry);
+            }
+            BOOST_CHECK(result.Finish().isNull());
+        }
+        BOOST_CHECK(!stream.AwaitingValue());
+        stream.Key("error");
+        stream.Value(NullUniValue);
+        stream.Key("id");
+        stream.Value(1);
+        stream.EndObject();
+        out += stream.TakeBuffer();
+        BOOST_CHECK_EQUAL(out, expected.write());
+        BOOST_CHECK_EQUAL(stream.Flushed(), flush_size != DEFAULT_JSON_STREAM_FLUSH_SIZE);
+        BOOST_CHECK_EQUAL(chunks > 1, flush_size != DEFAULT_JSON_STREAM_FLUSH_SIZE);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(result_writer_without_stream)
+{
+    RPCResultWriter arr{nullptr, UniValue::VARR};
+    arr.push_back("a");
+    arr.push_back(2);
+    BOOST_CHECK_EQUAL(arr.Finish().write(), "[\"a\",2]");
+
+    RPCResultWriter obj{nullptr, UniValue::VOBJ};
+    obj.pushKV("a", 1);
+    obj.pushKV("b", UniValue(UniValue::VARR));
+    BOOST_CHECK_EQUAL(obj.Finish().write(), "{\"a\":1,\"b\":[]}");
+}
+
+BOOST_AUTO_TEST_CASE(stream_fields)
+{
+    UniValue obj(UniValue::VOBJ);
+    obj.pushKV("x", 1);
+    obj.pushKV("y", "z");
+    std::string out;
+    JSONStreamWriter stream{[&](Span<const char> chunk) { out.append(chunk.begin(), chunk.end()); }};
+    stream.BeginArray();
+    stream.BeginObject();
+    stream.Fields(obj);
+    stream.Key("tx");
+    stream.BeginArray();
+    stream.EndArray();
+    stream.EndObject();
+    stream.Value("tail");
+    stream.EndArray();
+    out += stream.TakeBuffer();
+    BOOST_CHECK_EQUAL(out, "[{\"x\":1,\"y\":\"z\",\"tx\":[]},\"tail\"]");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
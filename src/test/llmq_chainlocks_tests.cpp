@@ -0,0 +1,45 @@
+// Copyright (c) 2024 The Syscoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <llmq/quorums_chainlocks.h>
+#include <test/util/random.h>
+#include <test/util/setup_common.h>
+
+#include <boost/test/unit_test.hpp>
+
+BOOST_FIXTURE_TEST_SUITE(llmq_chainlocks_tests, BasicTestingSetup)
+
+BOOST_AUTO_TEST_CASE(timed_hash_set_expiry)
+{
+    using namespace llmq;
+    const int64_t nTimeout = 8000;
+    CTimedHashSet set(nTimeout);
+    const uint256 hash1 = InsecureRand256();
+    const uint256 hash2 = InsecureRand256();
+
+    const int64_t nStart = 1000000;
+    set.Insert(hash1, nStart);
+    BOOST_CHECK(set.Contains(hash1));
+    BOOST_CHECK(!set.Contains(hash2));
+    set.Insert(hash2, nStart + nTimeout / 2);
+    BOOST_CHECK_EQUAL(set.size(), 2U);
+
+    // entries are kept for at least the timeout
+    set.Expire(nStart + nTimeout);
+    BOOST_CHECK(set.Contains(hash1));
+    BOOST_CHECK(set.Contains(hash2));
+
+    // and dropped within one more slice of it
+    set.Expire(nStart + nTimeout + nTimeout / 8);
+    BOOST_CHECK(!set.Contains(hash1));
+    BOOST_CHECK(set.Contains(hash2));
+
+    // a jump past the whole window clears everything
+    set.Expire(nStart + 10 * nTimeout);
+    BOOST_CHECK_EQUAL(set.size(), 0U);
+    set.Insert(hash1, nStart + 10 * nTimeout);
+    BOOST_CHECK(set.Contains(hash1));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
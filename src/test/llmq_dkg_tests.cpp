@@ -2,9 +2,27 @@
 // Distributed under the MIT software license, see the accompanying
 // file COPYING or http://www.opensource.org/licenses/mit-license.php.
 
+#include <chainparams.h>
 #include <llmq/quorums_dkgsession.h>
+#include <llmq/quorums_dkgsessionhandler.h>
+#include <hash.h>
+#include <test/util/random.h>
+#include <test/util/setup_common.h>
 #include <boost/test/unit_test.hpp>
 
+namespace {
+struct TestDKGMessage {
+    uint256 quorumHash;
+    uint256 proTxHash;
+    std::vector<unsigned char> payload;
+
+    SERIALIZE_METHODS(TestDKGMessage, obj)
+    {
+        READWRITE(obj.quorumHash, obj.proTxHash, obj.payload);
+    }
+};
+} // namespace
+
 BOOST_AUTO_TEST_SUITE(llmq_dkg_tests)
 
 BOOST_AUTO_TEST_CASE(llmq_dkgerror)
@@ -20,6 +38,52 @@ BOOST_AUTO_TEST_CASE(llmq_dkgerror)
     BOOST_ASSERT(GetSimulatedErrorRate(llmq::DKGError::type::_COUNT) == 0.0);
 }
 
+BOOST_FIXTURE_TEST_CASE(llmq_dkg_pending_messages, TestingSetup)
+{
+    using namespace llmq;
+    const auto& params = Params().GetConsensus().llmqTypeChainLocks;
 
+    // an honest contribution fits the size the contribution queue allows
+    CDKGContribution qc;
+    qc.vvec = std::make_shared<std::vector<CBLSPublicKey>>(params.threshold);
+    qc.contributions = std::make_shared<CBLSIESMultiRecipientObjects<CBLSSecretKey>>();
+    qc.contributions->blobs.assign(params.size, CBLSIESMultiRecipientBlobs::Blob(32));
+    BOOST_CHECK_LE(::GetSerializeSize(qc, PROTOCOL_VERSION), MaxDKGMessageSize(params, QuorumPhase_Contribute));
+
+    CDKGPendingMessages pending(/*_maxMessagesPerNode=*/3, /*_maxMessageSize=*/200, /*_maxBytesPerNode=*/300, *m_node.peerman);
+    const uint256 quorumHash{InsecureRand256()};
+    const uint256 member{InsecureRand256()};
+    const auto push = [&](const uint256& proTxHash, size_t payload_size) {
+        CDataStream ds(SER_NETWORK, PROTOCOL_VERSION);
+        ds << TestDKGMessage{quorumHash, proTxHash, std::vector<unsigned char>(payload_size, 0x01)};
+        const uint256 hash{Hash(ds)};
+        pending.PushPendingMessage(nullptr, ds);
+        return hash;
+    };
+
+    // too large to queue at all
+    BOOST_CHECK(!pending.HasSeen(push(member, 200)));
+    const uint256 first{push(member, 80)};
+    BOOST_CHECK(pending.HasSeen(first));
+    // a duplicate does not count against the limits, the third message is over the byte budget
+    BOOST_CHECK(pending.HasSeen(push(member, 80)));
+    const uint256 other{push(InsecureRand256(), 80)};
+    BOOST_CHECK(pending.HasSeen(other));
+    BOOST_CHECK(!pending.HasSeen(push(member, 81)));
+
+    // the header decides before the payload is deserialized
+    size_t skipped{0};
+    const auto msgs = pending.PopAndDeserializeMessages<TestDKGMessage>(10, [&](NodeId, const CDKGPendingMessages::MessageHeader& header) {
+        BOOST_CHECK(header.quorumHash == quorumHash);
+        if (header.proTxHash == member) return false;
+        ++skipped;
+        return true;
+    });
+    BOOST_CHECK_EQUAL(skipped, 1U);
+    BOOST_REQUIRE_EQUAL(msgs.size(), 1U);
+    BOOST_REQUIRE(msgs[0].second);
+    BOOST_CHECK(msgs[0].second->proTxHash == member);
+    BOOST_CHECK_EQUAL(msgs[0].second->payload.size(), 80U);
+}
 
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,125 @@
+// Copyright (c) 2024 The Syscoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <llmq/quorums_signing_shares.h>
+#include <test/util/random.h>
+#include <test/util/setup_common.h>
+
+#include <boost/test/unit_test.hpp>
+
+BOOST_FIXTURE_TEST_SUITE(llmq_signing_shares_tests, BasicTestingSetup)
+
+BOOST_AUTO_TEST_CASE(sigsharemap_member_order)
+{
+    using namespace llmq;
+    SigShareMap<int64_t> map;
+    const uint256 signHash1 = InsecureRand256();
+    const uint256 signHash2 = InsecureRand256();
+
+    // members cross bitmap words and are added out of order
+    const std::vector<uint16_t> members{130, 3, 64, 0, 63, 399, 65};
+    for (const uint16_t member : members) {
+        BOOST_CHECK(map.Add(SigShareKey(signHash1, member), member * 10));
+    }
+    BOOST_CHECK(!map.Add(SigShareKey(signHash1, 3), 0));
+    BOOST_CHECK(map.Add(SigShareKey(signHash2, 3), 7));
+    BOOST_CHECK_EQUAL(map.Size(), members.size() + 1);
+    BOOST_CHECK_EQUAL(map.CountForSignHash(signHash1), members.size());
+
+    const auto* m = map.GetAllForSignHash(signHash1);
+    BOOST_REQUIRE(m);
+    std::vector<uint16_t> sorted{members};
+    std::sort(sorted.begin(), sorted.end());
+    size_t i = 0;
+    for (const auto& [member, v] : *m) {
+        BOOST_CHECK_EQUAL(member, sorted[i++]);
+        BOOST_CHECK_EQUAL(v, member * 10);
+    }
+    BOOST_CHECK(!m->count(1));
+    BOOST_CHECK(!map.Has(SigShareKey(signHash1, 1000)));
+
+    map.Erase(SigShareKey(signHash1, 64));
+    BOOST_CHECK(!map.Has(SigShareKey(signHash1, 64)));
+    BOOST_REQUIRE(map.Get(SigShareKey(signHash1, 65)));
+    BOOST_CHECK_EQUAL(*map.Get(SigShareKey(signHash1, 65)), 650);
+    map.GetOrAdd(SigShareKey(signHash1, 64)) = 1;
+    BOOST_CHECK_EQUAL(*map.Get(SigShareKey(signHash1, 64)), 1);
+
+    map.EraseIf([&](const SigShareKey& k, int64_t v) { return k.first == signHash1 && v >= 630; });
+    BOOST_CHECK_EQUAL(map.CountForSignHash(signHash1), 3);
+    BOOST_CHECK(map.Has(SigShareKey(signHash1, 0)));
+    BOOST_CHECK(!map.Has(SigShareKey(signHash1, 399)));
+
+    // an emptied session is reused from the pool without stale members
+    map.EraseAllForSignHash(signHash1);
+    BOOST_CHECK_EQUAL(map.CountForSignHash(signHash1), 0);
+    const uint256 signHash3 = InsecureRand256();
+    BOOST_CHECK(map.Add(SigShareKey(signHash3, 5), 5));
+    BOOST_CHECK_EQUAL(map.CountForSignHash(signHash3), 1);
+    BOOST_CHECK(!map.Has(SigShareKey(signHash3, 0)));
+
+    size_t count = 0;
+    map.ForEach([&](const SigShareKey&, int64_t) { count++; });
+    BOOST_CHECK_EQUAL(count, 2);
+    map.Erase(SigShareKey(signHash2, 3));
+    map.Erase(SigShareKey(signHash3, 5));
+    BOOST_CHECK(map.Empty());
+}
+
+BOOST_AUTO_TEST_CASE(sigshare_session_interning)
+{
+    using namespace llmq;
+    const uint256 quorumHash = InsecureRand256();
+    const uint256 id = InsecureRand256();
+    const uint256 msgHash = InsecureRand256();
+
+    const CSigShare sigShare(quorumHash, id, msgHash, 7, {});
+    BOOST_CHECK(sigShare.GetSignHash() == BuildSignHash(quorumHash, id, msgHash));
+    BOOST_CHECK(sigShare.GetKey() == SigShareKey(sigShare.GetSignHash(), 7));
+
+    // the wire format is unchanged and a received share references the session already known
+    DataStream ss{};
+    ss << sigShare;
+    DataStream expected{};
+    expected << quorumHash << uint16_t{7} << id << msgHash << sigShare.sigShare;
+    BOOST_CHECK(MakeUCharSpan(ss) == MakeUCharSpan(expected));
+    CSigShare received;
+    ss >> received;
+    BOOST_CHECK(received.GetSession() == sigShare.GetSession());
+    BOOST_CHECK_EQUAL(received.getQuorumMember(), 7);
+    BOOST_CHECK(received.getMsgHash() == msgHash);
+
+    const CSigShare other(sigShare.GetSession(), 8, {});
+    BOOST_CHECK(InternSigShareSession(quorumHash, id, msgHash) == other.GetSession());
+    BOOST_CHECK(InternSigShareSession(quorumHash, id, InsecureRand256()) != other.GetSession());
+}
+
+BOOST_AUTO_TEST_CASE(latency_histogram)
+{
+    llmq::CLatencyHistogram histogram;
+    BOOST_CHECK_EQUAL(histogram.Average(), 0);
+    BOOST_CHECK_EQUAL(histogram.Percentile(50), 0);
+
+    histogram.Add(0);
+    BOOST_CHECK_EQUAL(histogram.Percentile(50), 0);
+    BOOST_CHECK_EQUAL(histogram.Percentile(100), 0);
+
+    histogram = {};
+    for (uint64_t i = 1; i <= 100; i++) {
+        histogram.Add(i);
+    }
+    BOOST_CHECK_EQUAL(histogram.count, 100);
+    BOOST_CHECK_EQUAL(histogram.Average(), 50);
+    BOOST_CHECK_EQUAL(histogram.max, 100);
+    // percentiles are the upper bound of their power of two bucket, capped at the largest sample
+    BOOST_CHECK_EQUAL(histogram.Percentile(1), 1);
+    BOOST_CHECK_EQUAL(histogram.Percentile(50), 63);
+    BOOST_CHECK_EQUAL(histogram.Percentile(99), 100);
+
+    // values past the last bucket are only bounded by the maximum
+    histogram.Add(uint64_t{1} << 40);
+    BOOST_CHECK_EQUAL(histogram.Percentile(100), uint64_t{1} << 40);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
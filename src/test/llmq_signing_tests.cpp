@@ -0,0 +1,78 @@
+// Copyright (c) 2024 The Syscoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <llmq/quorums_signing.h>
+#include <test/util/random.h>
+#include <test/util/setup_common.h>
+#include <util/time.h>
+
+#include <boost/test/unit_test.hpp>
+
+using namespace llmq;
+
+BOOST_FIXTURE_TEST_SUITE(llmq_signing_tests, BasicTestingSetup)
+
+static CRecoveredSig MakeRecoveredSig()
+{
+    CBLSSecretKey sk;
+    sk.MakeNewKey();
+    const uint256 msgHash = InsecureRand256();
+    return CRecoveredSig(InsecureRand256(), InsecureRand256(), msgHash, sk.Sign(msgHash, false));
+}
+
+BOOST_AUTO_TEST_CASE(recovered_sigs_db_pending_writes)
+{
+    CRecoveredSigsDb db(/*fMemory=*/true, /*fWipe=*/true);
+    const CRecoveredSig recSig = MakeRecoveredSig();
+    const uint256 signHash = recSig.buildSignHash();
+
+    BOOST_CHECK(!db.HasRecoveredSigForId(recSig.getId()));
+    BOOST_CHECK(!db.HasRecoveredSigForHash(recSig.GetHash()));
+    BOOST_CHECK(!db.HasRecoveredSigForSession(signHash));
+
+    // readers see a written sig before and after it is flushed
+    db.WriteRecoveredSig(recSig);
+    for (int i = 0; i < 2; i++) {
+        BOOST_CHECK(db.HasRecoveredSig(recSig.getId(), recSig.getMsgHash()));
+        BOOST_CHECK(!db.HasRecoveredSig(recSig.getId(), InsecureRand256()));
+        BOOST_CHECK(db.HasRecoveredSigForId(recSig.getId()));
+        BOOST_CHECK(db.HasRecoveredSigForHash(recSig.GetHash()));
+        BOOST_CHECK(db.HasRecoveredSigForSession(signHash));
+        CRecoveredSig ret;
+        BOOST_CHECK(db.GetRecoveredSigByHash(recSig.GetHash(), ret));
+        BOOST_CHECK(ret.GetHash() == recSig.GetHash());
+        db.FlushPendingWrites();
+    }
+
+    // truncating a pending sig leaves only its hash key
+    const CRecoveredSig recSig2 = MakeRecoveredSig();
+    db.WriteRecoveredSig(recSig2);
+    db.TruncateRecoveredSig(recSig2.getId());
+    BOOST_CHECK(!db.HasRecoveredSigForId(recSig2.getId()));
+    BOOST_CHECK(db.HasRecoveredSigForHash(recSig2.GetHash()));
+}
+
+BOOST_AUTO_TEST_CASE(recovered_sigs_db_cleanup)
+{
+    CRecoveredSigsDb db(/*fMemory=*/true, /*fWipe=*/true);
+    const CRecoveredSig oldSig = MakeRecoveredSig();
+    const CRecoveredSig newSig = MakeRecoveredSig();
+
+    const auto now = GetTime<std::chrono::seconds>();
+    SetMockTime(now - std::chrono::hours{2});
+    db.WriteRecoveredSig(oldSig);
+    SetMockTime(now);
+    db.WriteRecoveredSig(newSig);
+
+    db.CleanupOldRecoveredSigs(/*maxAge=*/60 * 60);
+    BOOST_CHECK(!db.HasRecoveredSigForId(oldSig.getId()));
+    BOOST_CHECK(!db.HasRecoveredSigForHash(oldSig.GetHash()));
+    BOOST_CHECK(!db.HasRecoveredSigForSession(oldSig.buildSignHash()));
+    BOOST_CHECK(db.HasRecoveredSigForId(newSig.getId()));
+    BOOST_CHECK(db.HasRecoveredSigForHash(newSig.GetHash()));
+    BOOST_CHECK(db.HasRecoveredSigForSession(newSig.buildSignHash()));
+    SetMockTime(0s);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
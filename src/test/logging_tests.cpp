@@ -2,6 +2,8 @@
 // Distributed under the MIT software license, see the accompanying
 // file COPYING or http://www.opensource.org/licenses/mit-license.php.
 
+// SYSCOIN
+#include <batchedlogger.h>
 #include <init/common.h>
 #include <logging.h>
 #include <logging/timer.h>
@@ -9,8 +11,10 @@
 #include <util/string.h>
 
 #include <chrono>
+#include <cstdio>
 #include <fstream>
 #include <iostream>
+#include <thread>
 #include <unordered_map>
 #include <utility>
 #include <vector>
@@ -127,6 +131,104 @@ BOOST_FIXTURE_TEST_CASE(logging_LogPrintMacros, LogSetup)
     BOOST_CHECK_EQUAL_COLLECTIONS(log_lines.begin(), log_lines.end(), expected.begin(), expected.end());
 }
 
+// SYSCOIN
+BOOST_FIXTURE_TEST_CASE(logging_AsyncWriter, LogSetup)
+{
+    constexpr int THREADS{4}, MESSAGES{1000};
+    LogInstance().StartAsyncWriter(DEFAULT_LOGASYNC_BUFFER << 20);
+    BOOST_CHECK(LogInstance().IsAsync());
+    std::vector<std::thread> threads;
+    for (int t = 0; t < THREADS; ++t) {
+        threads.emplace_back([t] {
+            for (int i = 0; i < MESSAGES; ++i) {
+                LogPrintf("thread %d message %d\n", t, i);
+            }
+        });
+    }
+    for (auto& thread : threads) thread.join();
+    LogInstance().StopAsyncWriter();
+    BOOST_CHECK(!LogInstance().IsAsync());
+    BOOST_CHECK_EQUAL(LogInstance().DroppedMessages(), 0U);
+
+    // every message is written once, those of one thread in the order they were logged
+    std::ifstream file{tmp_log_path};
+    std::vector<int> next(THREADS, 0);
+    int lines{0};
+    for (std::string log; std::getline(file, log); ++lines) {
+        int t, i;
+        BOOST_REQUIRE_EQUAL(sscanf(log.c_str(), "thread %d message %d", &t, &i), 2);
+        BOOST_REQUIRE(t >= 0 && t < THREADS);
+        BOOST_CHECK_EQUAL(i, next[t]++);
+    }
+    BOOST_CHECK_EQUAL(lines, THREADS * MESSAGES);
+}
+
+BOOST_FIXTURE_TEST_CASE(logging_AsyncWriterDrops, LogSetup)
+{
+    const uint64_t dropped_before{LogInstance().DroppedMessages()};
+    // nothing fits into the queue
+    LogInstance().StartAsyncWriter(1);
+    LogPrintf("foo12: %s\n", "bar12");
+    LogPrintf("foo13: %s\n", "bar13");
+    LogInstance().StopAsyncWriter();
+    BOOST_CHECK_EQUAL(LogInstance().DroppedMessages() - dropped_before, 2U);
+    // once stopped the logging threads write on their own again
+    LogPrintf("foo14: %s\n", "bar14");
+
+    std::ifstream file{tmp_log_path};
+    std::vector<std::string> log_lines;
+    for (std::string log; std::getline(file, log);) {
+        log_lines.push_back(log);
+    }
+    std::vector<std::string> expected = {
+        "2 log messages dropped, the log writer could not keep up",
+        "foo14: bar14",
+    };
+    BOOST_CHECK_EQUAL_COLLECTIONS(log_lines.begin(), log_lines.end(), expected.begin(), expected.end());
+}
+
+BOOST_AUTO_TEST_CASE(logging_CompiledOut)
+{
+    BOOST_CHECK(!BCLog::IsCompiledOut(BCLog::NET, BCLog::Level::Debug));
+    BOOST_CHECK(!BCLog::IsCompiledOut(BCLog::NONE, BCLog::Level::Debug));
+    // warnings and errors are always logged
+    BOOST_CHECK(!BCLog::IsCompiledOut(BCLog::SYS, BCLog::Level::Warning));
+    BOOST_CHECK(!BCLog::IsCompiledOut(BCLog::LLMQ_SIGS, BCLog::Level::Error));
+    BOOST_CHECK_EQUAL(BCLog::IsCompiledOut(BCLog::SYS, BCLog::Level::Debug), BCLog::COMPILED_OUT_CATEGORIES != BCLog::NONE);
+    // a combined category is only left out if all of it is
+    BOOST_CHECK(!BCLog::IsCompiledOut(BCLog::DASH, BCLog::Level::Debug));
+}
+
+BOOST_FIXTURE_TEST_CASE(logging_LogBatch, LogSetup)
+{
+    int evaluated{0};
+    const auto arg = [&] { return ++evaluated; };
+    LogInstance().DisableCategory(BCLog::LLMQ_DKG);
+    {
+        CBatchedLogger logger(BCLog::LLMQ_DKG, BCLog::Level::Debug, "fn", "src", 1);
+        LogBatch(logger, "foo15: %d", arg());
+    }
+    BOOST_CHECK_EQUAL(evaluated, 0);
+    LogInstance().EnableCategory(BCLog::LLMQ_DKG);
+    {
+        CBatchedLogger logger(BCLog::LLMQ_DKG, BCLog::Level::Debug, "fn", "src", 1);
+        LogBatch(logger, "foo15: %d", arg());
+        LogBatch(logger, "foo16: %d", arg());
+    }
+    BOOST_CHECK_EQUAL(evaluated, 2);
+
+    std::ifstream file{tmp_log_path};
+    std::vector<std::string> log_lines;
+    for (std::string log; std::getline(file, log);) {
+        log_lines.push_back(log);
+    }
+    std::vector<std::string> expected = {
+        "[llmq-dkg:debug]     foo15: 1",
+        "    foo16: 2",
+    };
+    BOOST_CHECK_EQUAL_COLLECTIONS(log_lines.begin(), log_lines.end(), expected.begin(), expected.end());
+}
+
 BOOST_FIXTURE_TEST_CASE(logging_LogPrintMacros_CategoryName, LogSetup)
 {
     LogInstance().EnableCategory(BCLog::LogFlags::ALL);
@@ -4,8 +4,11 @@
 
 #include <common/system.h>
 #include <policy/policy.h>
+#include <services/zdagconflicts.h>
+#include <test/util/random.h>
 #include <test/util/txmempool.h>
 #include <txmempool.h>
+#include <util/rbf.h>
 #include <util/time.h>
 
 #include <test/util/setup_common.h>
@@ -579,6 +582,72 @@ BOOST_AUTO_TEST_CASE(MempoolSizeLimitTest)
     // ... unless it has gone all the way to 0 (after getting past 1000/2)
 }
 
+// SYSCOIN
+static CMutableTransaction MakePoDATx(uint8_t nTag, size_t nBlobSize)
+{
+    CMutableTransaction tx;
+    tx.nVersion = SYSCOIN_TX_VERSION_NEVM_DATA_SHA3;
+    tx.vin.resize(1);
+    tx.vin[0].scriptSig = CScript() << nTag;
+    tx.vout.resize(1);
+    CNEVMData nevmData;
+    nevmData.vchVersionHash.assign(32, nTag);
+    std::vector<unsigned char> vchData;
+    nevmData.SerializeData(vchData);
+    tx.vout[0].scriptPubKey = CScript() << OP_RETURN << vchData;
+    tx.vout[0].nValue = 0;
+    tx.vout[0].SetNEVMData(std::vector<uint8_t>(nBlobSize, nTag));
+    return tx;
+}
+
+BOOST_AUTO_TEST_CASE(MempoolPoDASizeLimitTest)
+{
+    auto& pool = static_cast<MemPoolTest&>(*Assert(m_node.mempool));
+    LOCK2(cs_main, pool.cs);
+    TestMemPoolEntryHelper entry;
+
+    // same fee, the larger blob pays less per blob byte
+    const CMutableTransaction tx1 = MakePoDATx(1, 1000);
+    pool.addUnchecked(entry.Fee(10000LL).FromTx(tx1));
+    const CMutableTransaction tx2 = MakePoDATx(2, 4000);
+    pool.addUnchecked(entry.Fee(10000LL).FromTx(tx2));
+    // a plain transaction carries no blob bytes
+    CMutableTransaction tx3 = CMutableTransaction();
+    tx3.vin.resize(1);
+    tx3.vin[0].scriptSig = CScript() << OP_3;
+    tx3.vout.resize(1);
+    tx3.vout[0].scriptPubKey = CScript() << OP_3 << OP_EQUAL;
+    tx3.vout[0].nValue = 10 * COIN;
+    pool.addUnchecked(entry.Fee(1LL).FromTx(tx3));
+    BOOST_CHECK_EQUAL(pool.GetTotalPoDABlobSize(), 5000U);
+
+    pool.TrimPoDAToSize(5000); // should do nothing
+    BOOST_CHECK_EQUAL(pool.size(), 3U);
+
+    pool.TrimPoDAToSize(4999); // should remove the lower blob feerate transaction only
+    BOOST_CHECK(pool.exists(GenTxid::Txid(tx1.GetHash())));
+    BOOST_CHECK(!pool.exists(GenTxid::Txid(tx2.GetHash())));
+    BOOST_CHECK(pool.exists(GenTxid::Txid(tx3.GetHash())));
+    BOOST_CHECK_EQUAL(pool.GetTotalPoDABlobSize(), 1000U);
+
+    // descendants of an evicted blob transaction go with it
+    CMutableTransaction tx4 = CMutableTransaction();
+    tx4.vin.resize(1);
+    tx4.vin[0].prevout = COutPoint(tx1.GetHash(), 0);
+    tx4.vin[0].scriptSig = CScript() << OP_4;
+    tx4.vout.resize(1);
+    tx4.vout[0].scriptPubKey = CScript() << OP_4 << OP_EQUAL;
+    tx4.vout[0].nValue = 0;
+    pool.addUnchecked(entry.Fee(10000LL).FromTx(tx4));
+    pool.TrimPoDAToSize(0);
+    BOOST_CHECK(!pool.exists(GenTxid::Txid(tx1.GetHash())));
+    BOOST_CHECK(!pool.exists(GenTxid::Txid(tx4.GetHash())));
+    BOOST_CHECK(pool.exists(GenTxid::Txid(tx3.GetHash())));
+    BOOST_CHECK_EQUAL(pool.GetTotalPoDABlobSize(), 0U);
+
+    pool.removeRecursive(CTransaction(tx3), REMOVAL_REASON_DUMMY);
+}
+
 inline CTransactionRef make_tx(std::vector<CAmount>&& output_values, std::vector<CTransactionRef>&& inputs=std::vector<CTransactionRef>(), std::vector<uint32_t>&& input_indices=std::vector<uint32_t>())
 {
     CMutableTransaction tx = CMutableTransaction();
@@ -595,6 +664,93 @@ inline CTransactionRef make_tx(std::vector<CAmount>&& output_values, std::vector
     return MakeTransactionRef(tx);
 }
 
+// SYSCOIN
+BOOST_AUTO_TEST_CASE(MempoolFeeHistogramTest)
+{
+    CTxMemPool& pool = *Assert(m_node.mempool);
+    LOCK2(cs_main, pool.cs);
+    TestMemPoolEntryHelper entry;
+
+    CTransactionRef tx1 = make_tx(/*output_values=*/{10 * COIN});
+    const CAmount nFee1{15 * GetVirtualTransactionSize(*tx1)};
+    pool.addUnchecked(entry.Fee(nFee1).FromTx(tx1));
+    CMutableTransaction mtx2 = CMutableTransaction(*make_tx(/*output_values=*/{5 * COIN}, /*inputs=*/{tx1}));
+    mtx2.nVersion = SYSCOIN_TX_VERSION_ALLOCATION_SEND;
+    const CTransactionRef tx2 = MakeTransactionRef(mtx2);
+    const CAmount nFee2{GetVirtualTransactionSize(*tx2) / 2};
+    pool.addUnchecked(entry.Fee(nFee2).FromTx(tx2));
+
+    // 15 sat/vB lands in the 14 sat/vB bucket, below 1 sat/vB in the first one
+    const auto bucket_index = [](CAmount nFeeRate) {
+        return size_t(std::find(MEMPOOL_HISTOGRAM_FEERATES.begin(), MEMPOOL_HISTOGRAM_FEERATES.end(), nFeeRate) - MEMPOOL_HISTOGRAM_FEERATES.begin());
+    };
+    const MempoolFeeHistogram& histogram = pool.GetFeeHistogram();
+    BOOST_CHECK_EQUAL(histogram[bucket_index(14)].nCount, 1U);
+    BOOST_CHECK_EQUAL(histogram[bucket_index(14)].nFees, nFee1);
+    BOOST_CHECK_EQUAL(histogram[bucket_index(14)].nZDAGVSize, 0U);
+    BOOST_CHECK_EQUAL(histogram[0].nCount, 1U);
+    BOOST_CHECK_EQUAL(histogram[0].nVSize, uint64_t(GetVirtualTransactionSize(*tx2)));
+    BOOST_CHECK_EQUAL(histogram[0].nZDAGVSize, uint64_t(GetVirtualTransactionSize(*tx2)));
+
+    // removing the parent takes the child along and empties the histogram
+    pool.removeRecursive(*tx1, REMOVAL_REASON_DUMMY);
+    for (const MempoolHistogramBucket& bucket : pool.GetFeeHistogram()) {
+        BOOST_CHECK_EQUAL(bucket.nCount, 0U);
+        BOOST_CHECK_EQUAL(bucket.nVSize, 0U);
+        BOOST_CHECK_EQUAL(bucket.nFees, 0);
+        BOOST_CHECK_EQUAL(bucket.nZDAGVSize, 0U);
+    }
+}
+
+// SYSCOIN
+BOOST_AUTO_TEST_CASE(MempoolSnapshotTest)
+{
+    CTxMemPool& pool = *Assert(m_node.mempool);
+    TestMemPoolEntryHelper entry;
+
+    CMutableTransaction mtx1 = CMutableTransaction(*make_tx(/*output_values=*/{10 * COIN}));
+    mtx1.vin.resize(1);
+    mtx1.vin[0].nSequence = MAX_BIP125_RBF_SEQUENCE;
+    const CTransactionRef tx1 = MakeTransactionRef(mtx1);
+    CTransactionRef tx2 = make_tx(/*output_values=*/{5 * COIN}, /*inputs=*/{tx1});
+    {
+        LOCK2(cs_main, pool.cs);
+        pool.addUnchecked(entry.Fee(10000LL).FromTx(tx1));
+        pool.addUnchecked(entry.Fee(20000LL).FromTx(tx2));
+    }
+
+    const auto snapshot{pool.GetSnapshot()};
+    BOOST_CHECK_EQUAL(snapshot->vEntries.size(), 2U);
+    // parents come first
+    BOOST_CHECK(snapshot->vEntries[0].tx == tx1);
+    const MempoolEntrySnapshot* entry2 = snapshot->Find(tx2->GetHash());
+    BOOST_REQUIRE(entry2);
+    BOOST_CHECK_EQUAL(entry2->vDepends.size(), 1U);
+    BOOST_CHECK(entry2->vDepends[0] == tx1->GetHash());
+    BOOST_CHECK_EQUAL(entry2->nCountWithAncestors, 2U);
+    BOOST_CHECK(snapshot->Find(tx1->GetHash())->vSpentBy == std::vector<uint256>{tx2->GetHash()});
+    // replaceable through its parent
+    BOOST_CHECK(entry2->fBIP125Replaceable);
+
+    // an unchanged mempool hands out the same snapshot
+    BOOST_CHECK(pool.GetSnapshot() == snapshot);
+
+    // a change publishes a new one and leaves the old one alone
+    pool.PrioritiseTransaction(tx2->GetHash(), 5000);
+    const auto snapshot2{pool.GetSnapshot()};
+    BOOST_CHECK(snapshot2 != snapshot);
+    BOOST_CHECK_EQUAL(entry2->nModifiedFee, 20000);
+    BOOST_CHECK_EQUAL(snapshot2->Find(tx2->GetHash())->nModifiedFee, 25000);
+    BOOST_CHECK_EQUAL(snapshot2->Find(tx1->GetHash())->nModFeesWithDescendants, 35000);
+
+    {
+        LOCK2(cs_main, pool.cs);
+        pool.removeRecursive(*tx1, REMOVAL_REASON_DUMMY);
+    }
+    pool.PrioritiseTransaction(tx2->GetHash(), -5000);
+    BOOST_CHECK(pool.GetSnapshot()->vEntries.empty());
+    BOOST_CHECK_EQUAL(snapshot2->vEntries.size(), 2U);
+}
 
 BOOST_AUTO_TEST_CASE(MempoolAncestryTests)
 {
@@ -800,4 +956,42 @@ BOOST_AUTO_TEST_CASE(MempoolAncestryTestsDiamond)
     BOOST_CHECK_EQUAL(descendants, 4ULL);
 }
 
+// SYSCOIN
+BOOST_AUTO_TEST_CASE(MempoolZDAGConflictTest)
+{
+    CTxMemPool& pool = *Assert(m_node.mempool);
+    CMutableTransaction txParent;
+    txParent.vin.resize(1);
+    txParent.vin[0].prevout = COutPoint(InsecureRand256(), 0);
+    txParent.vout.resize(1);
+    CMutableTransaction txSpend1, txSpend2;
+    txSpend1.vin.resize(1);
+    txSpend1.vin[0].prevout = COutPoint(txParent.GetHash(), 0);
+    txSpend2 = txSpend1;
+    txSpend2.nLockTime = 1;
+    const CTransactionRef tx1 = MakeTransactionRef(txSpend1);
+    const CTransactionRef tx2 = MakeTransactionRef(txSpend2);
+
+    BOOST_CHECK(g_zdag_conflicts.Empty());
+    BOOST_CHECK(!pool.existsConflicts(*tx1));
+    BOOST_CHECK(g_zdag_conflicts.TryAdd(txSpend1.vin[0].prevout, tx2, tx1));
+    // only the first conflict of an outpoint is recorded
+    BOOST_CHECK(!g_zdag_conflicts.TryAdd(txSpend1.vin[0].prevout, tx1, tx2));
+    BOOST_CHECK(pool.existsConflicts(*tx1));
+    BOOST_CHECK(pool.existsConflicts(*tx2));
+    BOOST_CHECK(!pool.existsConflicts(CTransaction(txParent)));
+    const auto conflict = g_zdag_conflicts.Get(txSpend1.vin[0].prevout);
+    BOOST_REQUIRE(conflict);
+    BOOST_CHECK(conflict->first == tx2);
+    BOOST_CHECK(conflict->second == tx1);
+
+    // confirming one of the spends drops the conflict
+    {
+        LOCK2(cs_main, pool.cs);
+        pool.removeZDAGConflicts(*tx1);
+    }
+    BOOST_CHECK(!pool.existsConflicts(*tx2));
+    BOOST_CHECK(g_zdag_conflicts.Empty());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -250,6 +250,29 @@ BOOST_AUTO_TEST_CASE(merkle_test)
 }
 
 
+// SYSCOIN
+BOOST_AUTO_TEST_CASE(merkle_test_coinbase_branch)
+{
+    for (int ntx = 1; ntx <= 40; ntx++) {
+        CBlock block;
+        block.vtx.resize(ntx);
+        for (int j = 0; j < ntx; j++) {
+            CMutableTransaction mtx;
+            mtx.nLockTime = j;
+            block.vtx[j] = MakeTransactionRef(std::move(mtx));
+        }
+        const std::vector<uint256> branch = BlockCoinbaseMerkleBranch(block);
+        BOOST_CHECK(branch == BlockMerkleBranch(block, 0));
+        BOOST_CHECK(ComputeMerkleRootFromCoinbase(block.vtx[0]->GetHash(), branch) == BlockMerkleRoot(block));
+
+        // the branch stays valid for another coinbase
+        CMutableTransaction coinbase;
+        coinbase.nLockTime = 1000 + ntx;
+        block.vtx[0] = MakeTransactionRef(std::move(coinbase));
+        BOOST_CHECK(ComputeMerkleRootFromCoinbase(block.vtx[0]->GetHash(), branch) == BlockMerkleRoot(block));
+    }
+}
+
 BOOST_AUTO_TEST_CASE(merkle_test_empty_block)
 {
     bool mutated = false;
@@ -0,0 +1,49 @@
+// Copyright (c) 2024 The Syscoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <node/messageworker.h>
+#include <test/util/setup_common.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <atomic>
+#include <future>
+#include <thread>
+#include <vector>
+
+BOOST_FIXTURE_TEST_SUITE(messageworker_tests, BasicTestingSetup)
+
+BOOST_AUTO_TEST_CASE(messageworker_order)
+{
+    node::MessageWorker worker{"testmsg"};
+    // not started, the caller runs the task itself
+    BOOST_CHECK(!worker.Push([] {}));
+
+    worker.Start();
+    std::promise<void> release;
+    std::shared_future<void> released{release.get_future()};
+    std::vector<int> order;
+    std::atomic<std::thread::id> worker_id;
+    // the first task blocks the worker until the others are queued
+    BOOST_CHECK(worker.Push([&] {
+        worker_id = std::this_thread::get_id();
+        released.wait();
+    }));
+    for (int i = 0; i < 10; i++) {
+        BOOST_CHECK(worker.Push([&order, i] { order.emplace_back(i); }));
+    }
+    BOOST_CHECK(worker.Size() >= 10);
+    release.set_value();
+    // stopping still runs everything that was queued, in order, then refuses new tasks
+    worker.Stop();
+    BOOST_CHECK(worker_id.load() != std::this_thread::get_id());
+    BOOST_CHECK_EQUAL(worker.Size(), 0U);
+    BOOST_REQUIRE_EQUAL(order.size(), 10U);
+    for (int i = 0; i < 10; i++) {
+        BOOST_CHECK_EQUAL(order[i], i);
+    }
+    BOOST_CHECK(!worker.Push([] {}));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
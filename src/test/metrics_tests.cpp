@@ -0,0 +1,91 @@
+// Copyright (c) 2024 The Syscoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <metrics.h>
+#include <test/util/setup_common.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <string>
+#include <thread>
+#include <vector>
+
+BOOST_FIXTURE_TEST_SUITE(metrics_tests, BasicTestingSetup)
+
+BOOST_AUTO_TEST_CASE(metrics_render)
+{
+    metrics::Registry registry;
+    metrics::Counter& counter{registry.GetCounter("test_requests_total", "Requests served")};
+    metrics::Gauge& gauge{registry.GetGauge("test_queue_depth", "Requests waiting")};
+    metrics::Histogram& histogram{registry.GetHistogram("test_latency_seconds", "Request latency", {0.1, 1})};
+    // registering again hands out the same metric
+    BOOST_CHECK_EQUAL(&registry.GetCounter("test_requests_total", "Requests served"), &counter);
+
+    counter.Inc();
+    counter.Inc(2);
+    gauge.Set(5);
+    gauge.Add(-2);
+    histogram.Observe(0.05);
+    histogram.Observe(0.1);
+    histogram.Observe(0.5);
+    histogram.ObserveDuration(std::chrono::seconds{2});
+    BOOST_CHECK_EQUAL(counter.Value(), 3U);
+    BOOST_CHECK_EQUAL(gauge.Value(), 3);
+    BOOST_CHECK_EQUAL(histogram.Count(), 4U);
+
+    // ordered by name, histogram buckets are cumulative and a bound includes the values equal to it
+    BOOST_CHECK_EQUAL(registry.Render(),
+        "# HELP test_latency_seconds Request latency\n"
+        "# TYPE test_latency_seconds histogram\n"
+        "test_latency_seconds_bucket{le=\"0.1\"} 2\n"
+        "test_latency_seconds_bucket{le=\"1\"} 3\n"
+        "test_latency_seconds_bucket{le=\"+Inf\"} 4\n"
+        "test_latency_seconds_sum 2.65\n"
+        "test_latency_seconds_count 4\n"
+        "# HELP test_queue_depth Requests waiting\n"
+        "# TYPE test_queue_depth gauge\n"
+        "test_queue_depth 3\n"
+        "# HELP test_requests_total Requests served\n"
+        "# TYPE test_requests_total counter\n"
+        "test_requests_total 3\n");
+}
+
+BOOST_AUTO_TEST_CASE(metrics_concurrent_updates)
+{
+    metrics::Registry registry;
+    constexpr int THREADS{4}, UPDATES{10000};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < THREADS; ++t) {
+        threads.emplace_back([&registry] {
+            metrics::Counter& counter{registry.GetCounter("test_updates_total", "Updates")};
+            metrics::Histogram& histogram{registry.GetHistogram("test_update_seconds", "Update latency")};
+            for (int i = 0; i < UPDATES; ++i) {
+                counter.Inc();
+                histogram.Observe(0.001);
+            }
+        });
+    }
+    for (auto& thread : threads) thread.join();
+    BOOST_CHECK_EQUAL(registry.GetCounter("test_updates_total", "Updates").Value(), uint64_t{THREADS * UPDATES});
+    BOOST_CHECK_EQUAL(registry.GetHistogram("test_update_seconds", "Update latency").Count(), uint64_t{THREADS * UPDATES});
+}
+
+BOOST_AUTO_TEST_CASE(metrics_callbacks)
+{
+    metrics::Registry registry;
+    int64_t value{7};
+    registry.AddCounterCallback("test_hits_total", "Hits", [&value] { return value; });
+    registry.AddGaugeCallback("test_entries", "Entries", [] { return int64_t{-1}; });
+    value = 9;
+    // the callbacks are read when rendering
+    BOOST_CHECK_EQUAL(registry.Render(),
+        "# HELP test_entries Entries\n"
+        "# TYPE test_entries gauge\n"
+        "test_entries -1\n"
+        "# HELP test_hits_total Hits\n"
+        "# TYPE test_hits_total counter\n"
+        "test_hits_total 9\n");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -655,4 +655,33 @@ BOOST_AUTO_TEST_CASE(CreateNewBlock_validity)
     TestPrioritisedMining(scriptPubKey, txFirst);
 }
 
+// SYSCOIN
+BOOST_AUTO_TEST_CASE(CreateNewBlock_deferred_validity)
+{
+    node::g_block_template_validator = std::make_unique<node::BlockTemplateValidator>(*m_node.chainman);
+    node::g_block_template_validator->Start();
+    const CScript scriptPubKey = CScript() << OP_TRUE;
+    CTxMemPool& tx_mempool{*m_node.mempool};
+
+    // The first template on a tip is checked before it is returned
+    const auto first = AssemblerForTest(tx_mempool).CreateNewBlock(scriptPubKey);
+    BOOST_REQUIRE(first);
+    BOOST_CHECK_EQUAL(first->nDeferredCheck, 0U);
+
+    // later ones are returned at once and checked in the background
+    const auto second = AssemblerForTest(tx_mempool).CreateNewBlock(scriptPubKey);
+    BOOST_REQUIRE(second);
+    BOOST_REQUIRE(second->nDeferredCheck != 0);
+    auto result{node::BlockTemplateValidator::Result::PENDING};
+    for (int i = 0; i < 1000 && result == node::BlockTemplateValidator::Result::PENDING; ++i) {
+        UninterruptibleSleep(std::chrono::milliseconds{10});
+        result = node::g_block_template_validator->GetResult(second->nDeferredCheck);
+    }
+    BOOST_CHECK(result == node::BlockTemplateValidator::Result::VALID);
+    BOOST_CHECK(!node::DeferredCheckFailed(*second));
+
+    node::g_block_template_validator->Stop();
+    node::g_block_template_validator.reset();
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -1573,4 +1573,186 @@ BOOST_AUTO_TEST_CASE(v2transport_test)
         BOOST_CHECK(!ret);
     }
 }
+
+// SYSCOIN
+BOOST_AUTO_TEST_CASE(send_queue_classes)
+{
+    in_addr ipv4Addr;
+    ipv4Addr.s_addr = 0xa0b0c001;
+    CNode node{/*id=*/0,
+               /*sock=*/nullptr,
+               CAddress{CService{ipv4Addr, 7777}, NODE_NETWORK},
+               /*nKeyedNetGroupIn=*/0,
+               /*nLocalHostNonceIn=*/0,
+               CAddress{},
+               /*pszDest=*/"",
+               ConnectionType::OUTBOUND_FULL_RELAY,
+               /*inbound_onion=*/false};
+    const auto make_msg = [](const std::string& msg_type, size_t size) {
+        CSerializedNetMsg msg;
+        msg.m_type = msg_type;
+        msg.data.resize(size);
+        return msg;
+    };
+    BOOST_CHECK(GetNetMsgClass(make_msg(NetMsgType::CLSIG, 100)) == NetMsgClass::PRIORITY);
+    BOOST_CHECK(GetNetMsgClass(make_msg(NetMsgType::HEADERS, 2000 * 81)) == NetMsgClass::PRIORITY);
+    BOOST_CHECK(GetNetMsgClass(make_msg(NetMsgType::TX, 250)) == NetMsgClass::NORMAL);
+    BOOST_CHECK(GetNetMsgClass(make_msg(NetMsgType::TX, BULK_NET_MSG_SIZE + 1)) == NetMsgClass::BULK);
+    BOOST_CHECK(GetNetMsgClass(make_msg(NetMsgType::BLOBCHUNK, 100)) == NetMsgClass::BULK);
+    BOOST_CHECK(GetNetMsgClass(make_msg(NetMsgType::PONG, 8)) == NetMsgClass::BULK);
+
+    LOCK(node.cs_vSend);
+    BOOST_CHECK(node.SendQueuesEmpty());
+    const auto push = [&](CSerializedNetMsg&& msg) EXCLUSIVE_LOCKS_REQUIRED(node.cs_vSend) {
+        node.vSendMsg[size_t(GetNetMsgClass(msg))].push_back(std::move(msg));
+    };
+    const auto pop = [&](uint64_t bulk_rate, std::chrono::microseconds now) EXCLUSIVE_LOCKS_REQUIRED(node.cs_vSend) {
+        auto* queue = node.NextSendQueue(bulk_rate, now);
+        if (!queue) return std::string{};
+        const std::string msg_type{queue->front().m_type};
+        if (queue == &node.vSendMsg[size_t(NetMsgClass::BULK)]) node.m_bulk_send_allowance -= queue->front().data.size();
+        queue->pop_front();
+        return msg_type;
+    };
+    // a chainlock queued behind a block goes out first, messages of one class keep their order
+    push(make_msg(NetMsgType::BLOCK, 5000));
+    push(make_msg(NetMsgType::TX, 250));
+    push(make_msg(NetMsgType::CLSIG, 100));
+    push(make_msg(NetMsgType::PONG, 8));
+    push(make_msg(NetMsgType::CMPCTBLOCK, 1000));
+    const std::chrono::microseconds now{std::chrono::seconds{1000}};
+    BOOST_CHECK_EQUAL(pop(0, now), NetMsgType::CLSIG);
+    BOOST_CHECK_EQUAL(pop(0, now), NetMsgType::CMPCTBLOCK);
+    BOOST_CHECK_EQUAL(pop(0, now), NetMsgType::TX);
+    BOOST_CHECK_EQUAL(pop(0, now), NetMsgType::BLOCK);
+    BOOST_CHECK_EQUAL(pop(0, now), NetMsgType::PONG);
+    BOOST_CHECK(node.SendQueuesEmpty());
+    BOOST_CHECK(node.NextSendQueue(0, now) == nullptr);
+
+    // at 1000 bytes per second the 5000 byte block holds back bulk messages for 4 more seconds, the others still go out
+    node.m_bulk_send_allowance = 0;
+    node.m_bulk_send_refill = std::chrono::microseconds{0};
+    push(make_msg(NetMsgType::BLOCK, 5000));
+    push(make_msg(NetMsgType::BLOCK, 5000));
+    BOOST_CHECK_EQUAL(pop(1000, now), NetMsgType::BLOCK);
+    BOOST_CHECK(node.NextSendQueue(1000, now) == nullptr);
+    push(make_msg(NetMsgType::QSIGSHARE, 100));
+    BOOST_CHECK_EQUAL(pop(1000, now), NetMsgType::QSIGSHARE);
+    BOOST_CHECK(node.NextSendQueue(1000, now + std::chrono::seconds{3}) == nullptr);
+    BOOST_CHECK_EQUAL(pop(1000, now + std::chrono::seconds{4}), NetMsgType::BLOCK);
+    BOOST_CHECK(node.SendQueuesEmpty());
+}
+
+// SYSCOIN
+BOOST_AUTO_TEST_CASE(recv_buffer_pool)
+{
+    NetRecvBufferPool pool;
+    CDataStream stream{SER_NETWORK, INIT_PROTO_VERSION};
+    // small messages and an empty pool leave the stream alone
+    BOOST_CHECK(!pool.Take(stream, 1000));
+    BOOST_CHECK(!pool.Take(stream, NetRecvBufferPool::MIN_BUFFER_SIZE));
+
+    const auto make_buffer = [](size_t size) {
+        CDataStream buffer{SER_NETWORK, PROTOCOL_VERSION};
+        buffer.resize(size);
+        return buffer;
+    };
+    pool.Give(make_buffer(1000));
+    BOOST_CHECK_EQUAL(pool.Size(), 0U);
+    pool.Give(make_buffer(2 * NetRecvBufferPool::MIN_BUFFER_SIZE));
+    pool.Give(make_buffer(8 * NetRecvBufferPool::MIN_BUFFER_SIZE));
+    BOOST_CHECK_EQUAL(pool.Size(), 2U);
+
+    // the smallest buffer that fits is handed out empty, with the version of the stream it goes into
+    BOOST_REQUIRE(pool.Take(stream, NetRecvBufferPool::MIN_BUFFER_SIZE + 1));
+    BOOST_CHECK(stream.empty());
+    BOOST_CHECK_EQUAL(stream.capacity(), 2 * NetRecvBufferPool::MIN_BUFFER_SIZE);
+    BOOST_CHECK_EQUAL(stream.GetVersion(), INIT_PROTO_VERSION);
+    BOOST_CHECK_EQUAL(pool.Size(), 1U);
+    CDataStream big{SER_NETWORK, INIT_PROTO_VERSION};
+    BOOST_CHECK(!pool.Take(big, 9 * NetRecvBufferPool::MIN_BUFFER_SIZE));
+    BOOST_CHECK(pool.Take(big, 3 * NetRecvBufferPool::MIN_BUFFER_SIZE));
+    BOOST_CHECK_EQUAL(pool.Size(), 0U);
+
+    // the pool keeps at most MAX_POOLED_BYTES, smaller buffers make room for bigger ones
+    for (int i = 0; i < 8; i++) {
+        pool.Give(make_buffer(NetRecvBufferPool::MAX_POOLED_BYTES / 8));
+    }
+    BOOST_CHECK_EQUAL(pool.Size(), 8U);
+    pool.Give(make_buffer(NetRecvBufferPool::MIN_BUFFER_SIZE));
+    BOOST_CHECK_EQUAL(pool.Size(), 8U);
+    pool.Give(make_buffer(NetRecvBufferPool::MAX_POOLED_BYTES / 2));
+    BOOST_CHECK_EQUAL(pool.Size(), 5U);
+    pool.Give(make_buffer(NetRecvBufferPool::MAX_POOLED_BYTES + 1));
+    BOOST_CHECK_EQUAL(pool.Size(), 5U);
+}
+
+// SYSCOIN
+BOOST_AUTO_TEST_CASE(masternode_quorum_member_refs)
+{
+    auto connman = std::make_unique<CConnman>(0x1337, 0x1337, *m_node.addrman, *m_node.netgroupman, Params());
+    const uint256 quorum1{uint256S("01")}, quorum2{uint256S("02")};
+    const uint256 shared{uint256S("aa")}, only1{uint256S("bb")}, only2{uint256S("cc")};
+    SetMockTime(GetTime<std::chrono::seconds>());
+
+    connman->SetMasternodeQuorumNodes(quorum1, {shared, only1});
+    connman->SetMasternodeQuorumNodes(quorum2, {shared, only2});
+    BOOST_CHECK(connman->IsMasternodeQuorumMember(shared));
+    BOOST_CHECK(!connman->IsMasternodeQuorumMember(uint256S("dd")));
+
+    // a member of another quorum stays referenced, the other one lingers
+    connman->RemoveMasternodeQuorumNodes(quorum1);
+    BOOST_CHECK(connman->IsMasternodeQuorumMember(shared));
+    BOOST_CHECK(connman->IsMasternodeQuorumMember(only1));
+    BOOST_CHECK_EQUAL(connman->GetLingeringQuorumMemberCount(), 1U);
+
+    // a new quorum with the lingering member takes the connection over
+    connman->SetMasternodeQuorumNodes(quorum1, {only1});
+    BOOST_CHECK_EQUAL(connman->GetLingeringQuorumMemberCount(), 0U);
+
+    // replacing the members of a quorum keeps the ones that stay
+    connman->SetMasternodeQuorumNodes(quorum2, {shared});
+    BOOST_CHECK_EQUAL(connman->GetLingeringQuorumMemberCount(), 1U);
+    connman->RemoveMasternodeQuorumNodes(quorum1);
+    connman->RemoveMasternodeQuorumNodes(quorum2);
+    BOOST_CHECK_EQUAL(connman->GetLingeringQuorumMemberCount(), 3U);
+    BOOST_CHECK(connman->IsMasternodeQuorumMember(only2));
+
+    // lingering members are drained once MASTERNODE_QUORUM_LINGER_TIME passed
+    SetMockTime(GetTime<std::chrono::seconds>() + MASTERNODE_QUORUM_LINGER_TIME);
+    BOOST_CHECK(!connman->IsMasternodeQuorumMember(only2));
+    BOOST_CHECK_EQUAL(connman->GetLingeringQuorumMemberCount(), 0U);
+    SetMockTime(0s);
+}
+
+BOOST_AUTO_TEST_CASE(outbound_blob_target)
+{
+    auto connman = std::make_unique<CConnman>(0x1337, 0x1337, *m_node.addrman, *m_node.netgroupman, Params());
+    SetMockTime(GetTime<std::chrono::seconds>());
+
+    // without a blob target optional blobs are served and only counted
+    connman->RecordPayloadBytesSent(/*nevm_block_bytes=*/1000, /*blob_bytes=*/5000);
+    BOOST_CHECK(!connman->OutboundBlobTargetReached());
+    BOOST_CHECK_EQUAL(connman->GetOutboundBlobTargetBytesLeft(), 0U);
+
+    CConnman::Options options;
+    options.nMaxOutboundBlobLimit = 10000;
+    connman->Init(options);
+    BOOST_CHECK_EQUAL(connman->GetMaxOutboundBlobTarget(), 10000U);
+    BOOST_CHECK_EQUAL(connman->GetOutboundBlobTargetBytesLeft(), 5000U);
+    connman->RecordPayloadBytesSent(/*nevm_block_bytes=*/0, /*blob_bytes=*/5000);
+    BOOST_CHECK(connman->OutboundBlobTargetReached());
+    BOOST_CHECK_EQUAL(connman->GetOutboundBlobTargetBytesLeft(), 0U);
+    BOOST_CHECK_EQUAL(connman->GetTotalNEVMBlockBytesSent(), 1000U);
+    BOOST_CHECK_EQUAL(connman->GetTotalBlobBytesSent(), 10000U);
+
+    // a new cycle starts over, the totals are kept
+    SetMockTime(GetTime<std::chrono::seconds>() + connman->GetMaxOutboundTimeframe() + 1s);
+    connman->RecordPayloadBytesSent(/*nevm_block_bytes=*/0, /*blob_bytes=*/100);
+    BOOST_CHECK(!connman->OutboundBlobTargetReached());
+    BOOST_CHECK_EQUAL(connman->GetOutboundBlobTargetBytesLeft(), 9900U);
+    BOOST_CHECK_EQUAL(connman->GetTotalBlobBytesSent(), 10100U);
+    SetMockTime(0s);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -16,9 +16,13 @@
 #include <key_io.h>
 #include <test/util/setup_common.h>
 #include <test/util/json.h>
+#include <test/util/random.h>
 #include <validation.h>
 #include <consensus/validation.h>
 #include <services/assetconsensus.h>
+#include <services/nevmconsensus.h>
+#include <services/nevmblobhasher.h>
+#include <services/nevmblobrelay.h>
 BOOST_FIXTURE_TEST_SUITE(nevm_tests, BasicTestingSetup)
 BOOST_AUTO_TEST_CASE(seniority_test)
 {
@@ -158,4 +162,426 @@ BOOST_AUTO_TEST_CASE(nevmspv_invalid)
         }
     }
 }
+BOOST_AUTO_TEST_CASE(nevm_mint_proof_check)
+{
+    // a mint proving the first transaction of test/data/nevmspv_valid.json, as its receipt too
+    const UniValue tests = read_json(json_tests::nevmspv_valid);
+    const UniValue* spv{nullptr};
+    for (unsigned int idx = 0; idx < tests.size() && !spv; idx++) {
+        if (tests[idx].size() == 4) spv = &tests[idx];
+    }
+    BOOST_REQUIRE(spv);
+    const std::vector<unsigned char> vchRoot = ParseHex((*spv)[0].get_str());
+    const std::vector<unsigned char> vchParentNodes = ParseHex((*spv)[1].get_str());
+    const std::vector<unsigned char> vchValue = ParseHex((*spv)[2].get_str());
+    const auto itValue = std::search(vchParentNodes.begin(), vchParentNodes.end(), vchValue.begin(), vchValue.end());
+    BOOST_REQUIRE(itValue != vchParentNodes.end());
+    const auto mint = std::make_shared<CMintSyscoin>();
+    mint->vchTxParentNodes = vchParentNodes;
+    mint->posTx = itValue - vchParentNodes.begin();
+    mint->vchTxPath = ParseHex((*spv)[3].get_str());
+    // the root without its RLP string prefix
+    mint->nTxRoot = uint256(Span{vchRoot}.subspan(1));
+    mint->vchReceiptParentNodes = mint->vchTxParentNodes;
+    mint->posReceipt = mint->posTx;
+    mint->nReceiptRoot = mint->nTxRoot;
+    const CMintProofCheck check(mint);
+
+    std::string strError;
+    BOOST_CHECK(check());
+    BOOST_CHECK(check.Verify(strError));
+
+    // the queued check rejects with the reasons of the inline path, the receipt proof is checked first
+    const uint256 nRoot = mint->nTxRoot;
+    mint->nReceiptRoot = uint256::ONEV;
+    BOOST_CHECK(!check());
+    BOOST_CHECK(!check.Verify(strError));
+    BOOST_CHECK_EQUAL(strError, "mint-verify-receipt-proof");
+    mint->nReceiptRoot = nRoot;
+    mint->nTxRoot = uint256::ONEV;
+    BOOST_CHECK(!check());
+    BOOST_CHECK(!check.Verify(strError));
+    BOOST_CHECK_EQUAL(strError, "mint-verify-tx-proof");
+}
+BOOST_AUTO_TEST_CASE(nevm_sha3_batch)
+{
+    BOOST_CHECK_EQUAL(dev::sha3(std::string("abc")).hex(), "4e03657aea45a94fc7d47ba826c8d667c0d1e6e33a64a036ec44f58fa12d6c45");
+    std::vector<std::vector<uint8_t>> inputs;
+    for (const size_t len : {0, 1, 135, 136, 137, 272, 1000, 5000, 136 * 100}) {
+        inputs.emplace_back(len);
+        for (size_t i = 0; i < len; i++) {
+            inputs.back()[i] = InsecureRandBits(8);
+        }
+    }
+    std::vector<dev::bytesConstRef> refs;
+    for (const auto& input : inputs) {
+        refs.emplace_back(&input);
+    }
+    for (const bool use_avx2 : {false, true}) {
+        dev::KeccakAutoDetect(use_avx2);
+        // every batch size so partially filled lanes are covered
+        for (size_t count = 1; count <= refs.size(); count++) {
+            std::vector<dev::h256> hashes(count);
+            dev::sha3Batch(refs.data(), hashes.data(), count);
+            for (size_t i = 0; i < count; i++) {
+                BOOST_CHECK(hashes[i] == dev::sha3(refs[i]));
+            }
+        }
+    }
+    dev::KeccakAutoDetect();
+}
+
+BOOST_AUTO_TEST_CASE(nevm_txout_shared_data)
+{
+    CMutableTransaction mtx;
+    mtx.nVersion = SYSCOIN_TX_VERSION_NEVM_DATA_SHA3;
+    // an input keeps the empty vin from reading as the extended serialization marker
+    mtx.vin.resize(1);
+    const std::vector<uint8_t> vchData(1000, 0x5a);
+    CNEVMData nevmDataIn;
+    nevmDataIn.vchVersionHash = dev::sha3(vchData).asBytes();
+    std::vector<uint8_t> vchPayload;
+    nevmDataIn.SerializeData(vchPayload);
+    mtx.vout.emplace_back(0, CScript() << OP_RETURN << vchPayload, vchData);
+    mtx.vout.emplace_back(0, CScript() << OP_RETURN);
+    BOOST_CHECK(mtx.vout[0].HasNEVMData());
+    BOOST_CHECK(!mtx.vout[1].HasNEVMData());
+    BOOST_CHECK(mtx.vout[1].GetNEVMData().empty());
+
+    CDataStream ss(SER_NETWORK, PROTOCOL_VERSION);
+    ss << mtx;
+    CMutableTransaction mtx2;
+    ss >> mtx2;
+    BOOST_CHECK(mtx2.vout[0].GetNEVMData() == vchData);
+    // an empty payload does not allocate
+    BOOST_CHECK(!mtx2.vout[1].vchNEVMData);
+
+    // copies share the payload
+    const CTransaction tx(mtx2);
+    BOOST_CHECK_EQUAL(tx.vout[0].vchNEVMData.get(), mtx2.vout[0].vchNEVMData.get());
+    const CNEVMData nevmData(tx);
+    BOOST_CHECK_EQUAL(nevmData.vchNEVMData.get(), tx.vout[0].vchNEVMData.get());
+}
+
+BOOST_AUTO_TEST_CASE(nevm_blob_prehash)
+{
+    CMutableTransaction mtx;
+    mtx.nVersion = SYSCOIN_TX_VERSION_NEVM_DATA_SHA3;
+    std::vector<uint8_t> vchData(5000);
+    for (auto& b : vchData) {
+        b = InsecureRandBits(8);
+    }
+    mtx.vout.emplace_back(0, CScript() << OP_RETURN, vchData);
+    const CTransactionRef tx = MakeTransactionRef(mtx);
+    const CTransactionRef txOther = MakeTransactionRef(mtx);
+
+    NEVMBlobHasher hasher;
+    hasher.Start();
+    const auto wait_digest = [&](const CTransactionRef& txIn) {
+        hasher.Submit(txIn);
+        std::optional<std::vector<uint8_t>> digest;
+        for (int i = 0; i < 1000 && !digest; i++) {
+            // nothing is returned until hashing finished, so resubmit until it did
+            digest = hasher.TakeDigest(*txIn);
+            if (!digest) {
+                hasher.Submit(txIn);
+                UninterruptibleSleep(std::chrono::milliseconds{1});
+            }
+        }
+        return digest;
+    };
+    std::optional<std::vector<uint8_t>> digest{wait_digest(tx)};
+    BOOST_REQUIRE(digest);
+    BOOST_CHECK(*digest == dev::sha3(vchData).asBytes());
+    // entries are consumed and bound to the transaction object, not its txid
+    BOOST_CHECK(!hasher.TakeDigest(*tx));
+    BOOST_CHECK(!hasher.TakeDigest(*txOther));
+
+    // only the payload of the data output is hashed, the output CNEVMData reads it from
+    CMutableTransaction mtxDecoy;
+    mtxDecoy.nVersion = SYSCOIN_TX_VERSION_NEVM_DATA_SHA3;
+    mtxDecoy.vout.emplace_back(0, CScript() << OP_TRUE, std::vector<uint8_t>(100, 1));
+    mtxDecoy.vout.emplace_back(0, CScript() << OP_RETURN, vchData);
+    digest = wait_digest(MakeTransactionRef(mtxDecoy));
+    BOOST_REQUIRE(digest);
+    BOOST_CHECK(*digest == dev::sha3(vchData).asBytes());
+    hasher.Stop();
+}
+
+BOOST_AUTO_TEST_CASE(nevm_blob_verification_cache)
+{
+    const std::vector<uint8_t> vchData(3000, 0x3c);
+    const std::vector<uint8_t> vchVersionHash{dev::sha3(vchData).asBytes()};
+    auto blob = std::make_shared<const std::vector<uint8_t>>(vchData);
+    const auto blobCopy = std::make_shared<const std::vector<uint8_t>>(vchData);
+
+    NEVMBlobVerificationCache cache;
+    BOOST_CHECK(!cache.Contains(vchVersionHash, blob));
+    cache.Add(vchVersionHash, blob);
+    BOOST_CHECK(cache.Contains(vchVersionHash, blob));
+    // only the checked object counts, not equal data under the same version hash
+    BOOST_CHECK(!cache.Contains(vchVersionHash, blobCopy));
+    BOOST_CHECK(!cache.Contains(std::vector<uint8_t>(32, 1), blob));
+    // a freed blob is forgotten
+    blob.reset();
+    BOOST_CHECK(!cache.Contains(vchVersionHash, blobCopy));
+    for (size_t i = 0; i < MAX_NEVM_VERIFIED_BLOBS + 1; i++) {
+        std::vector<uint8_t> vchKey(32);
+        WriteLE64(vchKey.data(), i);
+        cache.Add(vchKey, blobCopy);
+    }
+    BOOST_CHECK_EQUAL(cache.Size(), MAX_NEVM_VERIFIED_BLOBS);
+
+    auto make_tx = [](const std::vector<uint8_t>& vchHash, const std::vector<uint8_t>& vchBlob) {
+        CMutableTransaction mtx;
+        mtx.nVersion = SYSCOIN_TX_VERSION_NEVM_DATA_SHA3;
+        CNEVMData nevmDataIn;
+        nevmDataIn.vchVersionHash = vchHash;
+        std::vector<uint8_t> vchPayload;
+        nevmDataIn.SerializeData(vchPayload);
+        mtx.vout.emplace_back(0, CScript() << OP_RETURN << vchPayload, vchBlob);
+        return MakeTransactionRef(mtx);
+    };
+    BOOST_CHECK(PreValidateNEVMData(*make_tx(vchVersionHash, vchData)));
+    std::vector<uint8_t> vchBad{vchData};
+    vchBad[0] ^= 1;
+    BOOST_CHECK(!PreValidateNEVMData(*make_tx(vchVersionHash, vchBad)));
+    // no blob is left to the contextual checks
+    BOOST_CHECK(PreValidateNEVMData(*make_tx(vchVersionHash, {})));
+    BOOST_CHECK(PreValidateNEVMData(CTransaction(CMutableTransaction())));
+}
+
+BOOST_AUTO_TEST_CASE(nevm_blob_segment_store)
+{
+    const fs::path segments_dir = m_args.GetDataDirBase() / "nevmblobs";
+    CNEVMDataBlobDB blobdb(DBParams{.path = m_args.GetDataDirBase() / "nevmblobdata", .cache_bytes = 1 << 20}, segments_dir);
+    const std::vector<uint8_t> vh1(32, 1), vh2(32, 2), vh3(32, 3);
+    const std::vector<uint8_t> data1(1000, 0xaa), data2(2000, 0xbb);
+    const int64_t nTime = 1000000;
+    {
+        CDBBatch batch(blobdb);
+        BOOST_CHECK(blobdb.AppendBlob(batch, vh1, data1, nTime));
+        BOOST_CHECK(blobdb.AppendBlob(batch, vh2, data2, nTime));
+        BOOST_CHECK(blobdb.CommitBlobs(batch));
+    }
+    BOOST_CHECK(blobdb.BlobExists(vh1));
+    BOOST_CHECK(!blobdb.BlobExists(vh3));
+    std::vector<uint8_t> vchData;
+    BOOST_CHECK(blobdb.ReadBlob(vh2, vchData));
+    BOOST_CHECK(vchData == data2);
+    size_t nSize{0};
+    BOOST_CHECK(blobdb.ReadBlob(vh1, [&](Span<const uint8_t> data) { nSize = data.size(); BOOST_CHECK(std::equal(data.begin(), data.end(), data1.begin())); }));
+    BOOST_CHECK_EQUAL(nSize, data1.size());
+    const auto nSegmentSize = fs::file_size(segments_dir / "blb00000.dat");
+    // identical content is stored once
+    {
+        CDBBatch batch(blobdb);
+        BOOST_CHECK(blobdb.AppendBlob(batch, vh1, data1, nTime + 1));
+        BOOST_CHECK(blobdb.CommitBlobs(batch));
+    }
+    BOOST_CHECK_EQUAL(fs::file_size(segments_dir / "blb00000.dat"), nSegmentSize);
+    // a blob far enough in the future starts a new segment, after which the first one can expire
+    {
+        CDBBatch batch(blobdb);
+        BOOST_CHECK(blobdb.AppendBlob(batch, vh3, data1, nTime + NEVM_DATA_EXPIRE_TIME));
+        BOOST_CHECK(blobdb.CommitBlobs(batch));
+    }
+    BOOST_CHECK(fs::exists(segments_dir / "blb00001.dat"));
+    BOOST_CHECK(blobdb.PruneSegments(nTime + NEVM_DATA_EXPIRE_TIME));
+    BOOST_CHECK(fs::exists(segments_dir / "blb00000.dat"));
+    BOOST_CHECK(blobdb.PruneSegments(nTime + 2 + NEVM_DATA_EXPIRE_TIME));
+    BOOST_CHECK(!fs::exists(segments_dir / "blb00000.dat"));
+    BOOST_CHECK(blobdb.ReadBlob(vh3, vchData));
+    BOOST_CHECK(vchData == data1);
+    BOOST_CHECK(blobdb.FlushErase({vh3}));
+    BOOST_CHECK(!blobdb.BlobExists(vh3));
+}
+BOOST_FIXTURE_TEST_CASE(nevm_blob_stats, ChainTestingSetup)
+{
+    pnevmdatablobdb = std::make_unique<CNEVMDataBlobDB>(DBParams{.path = m_args.GetDataDirBase() / "nevmblobstats", .cache_bytes = 1 << 20, .memory_only = true}, m_args.GetDataDirBase() / "nevmblobstatsseg");
+    CNEVMDataDB datadb(DBParams{.path = m_args.GetDataDirBase() / "nevmdatastats", .cache_bytes = 1 << 20, .memory_only = true});
+    const std::vector<uint8_t> vh1(32, 1), vh2(32, 2);
+    const auto data = std::make_shared<const std::vector<uint8_t>>(100, 0xaa);
+    const int64_t nTime = 1000000;
+    auto makeMeta = [&](int64_t nMedianTime) {
+        MapPoDAPayloadMeta meta{InsecureRand256(), (uint32_t)data->size(), nMedianTime};
+        meta.vchNEVMData = data;
+        return meta;
+    };
+    datadb.FlushDataToCache({{vh1, makeMeta(nTime)}});
+    NEVMDataStats stats{datadb.GetStats()};
+    BOOST_CHECK_EQUAL(stats.nCount, 1U);
+    BOOST_CHECK_EQUAL(stats.nPending, 1U);
+    BOOST_CHECK(datadb.FlushCacheToDisk(nTime));
+    // the totals are kept up to date from here on
+    datadb.FlushDataToCache({{vh2, makeMeta(nTime + 10)}});
+    BOOST_CHECK(datadb.FlushCacheToDisk(nTime + 10));
+    stats = datadb.GetStats();
+    BOOST_CHECK_EQUAL(stats.nCount, 2U);
+    BOOST_CHECK_EQUAL(stats.nTotalSize, 2 * data->size());
+    BOOST_CHECK_EQUAL(stats.nPending, 0U);
+    BOOST_CHECK_EQUAL(stats.OldestMedianTime(), nTime);
+    BOOST_CHECK_EQUAL(stats.NewestMedianTime(), nTime + 10);
+    // storing a blob again moves it to its newer median time, cached or flushed
+    datadb.FlushDataToCache({{vh1, makeMeta(nTime + 20)}});
+    stats = datadb.GetStats();
+    BOOST_CHECK_EQUAL(stats.nCount, 2U);
+    BOOST_CHECK_EQUAL(stats.OldestMedianTime(), nTime + 10);
+    BOOST_CHECK(datadb.FlushCacheToDisk(nTime + 20));
+    stats = datadb.GetStats();
+    BOOST_CHECK_EQUAL(stats.nCount, 2U);
+    BOOST_CHECK_EQUAL(stats.NewestMedianTime(), nTime + 20);
+    // erased and pruned blobs are taken out
+    BOOST_CHECK(datadb.FlushErase({vh2, vh2}));
+    stats = datadb.GetStats();
+    BOOST_CHECK_EQUAL(stats.nCount, 1U);
+    BOOST_CHECK_EQUAL(stats.OldestMedianTime(), nTime + 20);
+    BOOST_CHECK(datadb.PruneStandalone(nTime + 21 + NEVM_DATA_EXPIRE_TIME));
+    stats = datadb.GetStats();
+    BOOST_CHECK_EQUAL(stats.nCount, 0U);
+    BOOST_CHECK_EQUAL(stats.nTotalSize, 0U);
+    BOOST_CHECK_EQUAL(stats.OldestMedianTime(), 0);
+}
+BOOST_AUTO_TEST_CASE(nevm_txroots_read_cache)
+{
+    CNEVMTxRootsDB txrootsdb(DBParams{.path = m_args.GetDataDirBase() / "nevmtxroots", .cache_bytes = 1 << 20, .memory_only = true});
+    const uint256 nBlockHash = InsecureRand256();
+    NEVMTxRoot txRoot;
+    txRoot.nTxRoot = InsecureRand256();
+    txRoot.nReceiptRoot = InsecureRand256();
+    txrootsdb.FlushDataToCache({{nBlockHash, txRoot}});
+    BOOST_CHECK(txrootsdb.FlushCacheToDisk());
+    // the first read goes to disk, the next ones are served from memory
+    for (int i = 0; i < 2; i++) {
+        NEVMTxRoot txRootRead;
+        BOOST_CHECK(txrootsdb.ReadTxRoots(nBlockHash, txRootRead));
+        BOOST_CHECK(txRootRead.nTxRoot == txRoot.nTxRoot);
+        BOOST_CHECK(txRootRead.nReceiptRoot == txRoot.nReceiptRoot);
+    }
+    // erasing on disconnect must not leave the roots behind in memory
+    BOOST_CHECK(txrootsdb.FlushErase({nBlockHash}));
+    NEVMTxRoot txRootRead;
+    BOOST_CHECK(!txrootsdb.ReadTxRoots(nBlockHash, txRootRead));
+}
+BOOST_AUTO_TEST_CASE(nevm_minted_tx_filter)
+{
+    const DBParams params{.path = m_args.GetDataDirBase() / "nevmminttx", .cache_bytes = 1 << 20};
+    const uint256 nTxHashCached = InsecureRand256();
+    const uint256 nTxHashFlushed = InsecureRand256();
+    {
+        CNEVMMintedTxDB mintdb(params);
+        BOOST_CHECK(!mintdb.ExistsTx(nTxHashFlushed));
+        mintdb.FlushDataToCache({nTxHashFlushed});
+        BOOST_CHECK(mintdb.FlushCacheToDisk());
+        mintdb.FlushDataToCache({nTxHashCached});
+        BOOST_CHECK(mintdb.ExistsTx(nTxHashCached));
+        BOOST_CHECK(mintdb.ExistsTx(nTxHashFlushed));
+    }
+    // the filter is rebuilt from disk on startup
+    CNEVMMintedTxDB mintdb(params);
+    BOOST_CHECK(mintdb.ExistsTx(nTxHashFlushed));
+    BOOST_CHECK(!mintdb.ExistsTx(nTxHashCached));
+    BOOST_CHECK(mintdb.FlushErase({nTxHashFlushed}));
+    BOOST_CHECK(!mintdb.ExistsTx(nTxHashFlushed));
+    // hashes inserted after an erase are found again
+    mintdb.FlushDataToCache({nTxHashFlushed});
+    BOOST_CHECK(mintdb.ExistsTx(nTxHashFlushed));
+}
+BOOST_AUTO_TEST_CASE(nevm_blob_relay)
+{
+    std::vector<uint8_t> vchData(2 * NEVM_BLOB_CHUNK_SIZE + 1000);
+    for (auto& b : vchData) {
+        b = InsecureRandBits(8);
+    }
+    CNEVMData nevmData;
+    nevmData.vchVersionHash = dev::sha3(vchData).asBytes();
+    std::vector<uint8_t> vchPayload;
+    nevmData.SerializeData(vchPayload);
+    CMutableTransaction mtx;
+    mtx.nVersion = SYSCOIN_TX_VERSION_NEVM_DATA_SHA3;
+    mtx.vout.emplace_back(0, CScript() << OP_RETURN << vchPayload, vchData);
+    const CTransactionRef tx = MakeTransactionRef(mtx);
+
+    // stripping keeps the txid and the version hash
+    const CTransactionRef txStripped = StripNEVMData(tx);
+    BOOST_CHECK(txStripped->GetHash() == tx->GetHash());
+    BOOST_CHECK(!MissingNEVMData(*tx));
+    BOOST_REQUIRE(MissingNEVMData(*txStripped));
+    BOOST_CHECK(*MissingNEVMData(*txStripped) == nevmData.vchVersionHash);
+
+    auto make_chunk = [&](uint32_t nChunk) {
+        const size_t nOffset = nChunk * NEVM_BLOB_CHUNK_SIZE;
+        const size_t nLen = std::min<size_t>(NEVM_BLOB_CHUNK_SIZE, vchData.size() - nOffset);
+        return CNEVMBlobChunk{nevmData.vchVersionHash, nChunk, (uint32_t)vchData.size(), {vchData.begin() + nOffset, vchData.begin() + nOffset + nLen}};
+    };
+
+    // completing a block fills in the blobs, so every case gets its own copy
+    auto make_block = [&]() {
+        auto block = std::make_shared<CBlock>();
+        block->vtx.emplace_back(txStripped);
+        return block;
+    };
+    auto block = make_block();
+    NEVMBlobAssembler assembler;
+    std::vector<CNEVMBlobChunkRequest> vRequests;
+    BOOST_REQUIRE(assembler.AddBlock(block, /*from=*/1, 0s, vRequests));
+    // the size is not known yet, only the first chunk is asked for
+    BOOST_REQUIRE_EQUAL(vRequests.size(), 1U);
+    BOOST_CHECK_EQUAL(vRequests[0].nChunk, 0U);
+    const uint256 id0{NEVMBlobChunkId(vRequests[0])};
+    BOOST_CHECK(assembler.LookupChunk(id0));
+
+    // a chunk that contradicts its own size
+    CNEVMBlobChunk bad{make_chunk(0)};
+    bad.vchData.pop_back();
+    BOOST_CHECK(assembler.ReceivedChunk(bad).fInvalid);
+
+    auto result = assembler.ReceivedChunk(make_chunk(0));
+    BOOST_CHECK(!result.fInvalid);
+    BOOST_CHECK_EQUAL(result.vRequests.size(), 2U);
+    BOOST_CHECK(result.vComplete.empty());
+    BOOST_CHECK(!assembler.LookupChunk(id0));
+    BOOST_CHECK(assembler.ReceivedChunk(make_chunk(2)).vComplete.empty());
+    result = assembler.ReceivedChunk(make_chunk(1));
+    BOOST_REQUIRE_EQUAL(result.vComplete.size(), 1U);
+    BOOST_CHECK_EQUAL(result.vComplete[0].second, 1);
+    BOOST_CHECK(result.vComplete[0].first->vtx[0]->vout[0].GetNEVMData() == vchData);
+    BOOST_CHECK(result.vComplete[0].first->vtx[0]->GetHash() == tx->GetHash());
+    BOOST_CHECK_EQUAL(assembler.Size(), 0U);
+
+    // a blob that does not match its version hash makes the block download in full
+    block = make_block();
+    BOOST_REQUIRE(assembler.AddBlock(block, /*from=*/2, 0s, vRequests));
+    for (uint32_t i = 0; i < 3; i++) {
+        CNEVMBlobChunk chunk{make_chunk(i)};
+        if (i == 1) chunk.vchData[0] ^= 1;
+        result = assembler.ReceivedChunk(chunk);
+    }
+    BOOST_CHECK(result.vComplete.empty());
+    BOOST_REQUIRE_EQUAL(result.vFailed.size(), 1U);
+    BOOST_CHECK(result.vFailed[0].first == block->GetHash());
+    BOOST_CHECK_EQUAL(assembler.Size(), 0U);
+
+    // blocks that wait too long are dropped, only for the peer they came from
+    BOOST_REQUIRE(assembler.AddBlock(make_block(), /*from=*/3, 0s, vRequests));
+    BOOST_CHECK(assembler.ExpireBlocks(/*from=*/4, NEVM_BLOB_FETCH_TIMEOUT).empty());
+    BOOST_CHECK(assembler.ExpireBlocks(/*from=*/3, NEVM_BLOB_FETCH_TIMEOUT - 1s).empty());
+    BOOST_CHECK_EQUAL(assembler.ExpireBlocks(/*from=*/3, NEVM_BLOB_FETCH_TIMEOUT).size(), 1U);
+    BOOST_CHECK(!assembler.HaveBlock(block->GetHash()));
+    // a block with all of its blobs is not held
+    auto blockFull = std::make_shared<CBlock>();
+    blockFull->vtx.emplace_back(tx);
+    BOOST_CHECK(!assembler.AddBlock(blockFull, /*from=*/1, 0s, vRequests));
+    BOOST_CHECK_EQUAL(GetNEVMDataSize({tx, txStripped, blockFull->vtx[0]}), 2 * vchData.size());
+}
+BOOST_AUTO_TEST_CASE(nevm_blob_serve)
+{
+    const int64_t nTimeNow{1700000000};
+    // peers that validate the block need the blobs, a peer's clock may be behind ours
+    BOOST_CHECK(GetNEVMDataServe(nTimeNow, nTimeNow) == NEVMDataServe::REQUIRED);
+    BOOST_CHECK(GetNEVMDataServe(nTimeNow - NEVM_DATA_ENFORCE_TIME_HAVE_DATA - NEVM_DATA_SERVE_GRACE, nTimeNow) == NEVMDataServe::REQUIRED);
+    BOOST_CHECK(GetNEVMDataServe(nTimeNow - NEVM_DATA_ENFORCE_TIME_HAVE_DATA - NEVM_DATA_SERVE_GRACE - 1, nTimeNow) == NEVMDataServe::OPTIONAL);
+    BOOST_CHECK(GetNEVMDataServe(nTimeNow - NEVM_DATA_EXPIRE_TIME, nTimeNow) == NEVMDataServe::OPTIONAL);
+    BOOST_CHECK(GetNEVMDataServe(nTimeNow - NEVM_DATA_EXPIRE_TIME - 1, nTimeNow) == NEVMDataServe::EXPIRED);
+}
 BOOST_AUTO_TEST_SUITE_END()
@@ -3,6 +3,9 @@
 // file COPYING or http://www.opensource.org/licenses/mit-license.php.
 
 #include <arith_uint256.h>
+#include <consensus/validation.h>
+#include <net_processing.h>
+#include <policy/policy.h>
 #include <pubkey.h>
 #include <script/sign.h>
 #include <script/signingprovider.h>
@@ -128,12 +131,57 @@ BOOST_AUTO_TEST_CASE(DoS_mapOrphans)
     }
 
     // Test LimitOrphanTxSize() function:
-    orphanage.LimitOrphans(40);
+    orphanage.LimitOrphans(40, DEFAULT_MAX_ORPHAN_USAGE);
     BOOST_CHECK(orphanage.CountOrphans() <= 40);
-    orphanage.LimitOrphans(10);
+    orphanage.LimitOrphans(10, DEFAULT_MAX_ORPHAN_USAGE);
     BOOST_CHECK(orphanage.CountOrphans() <= 10);
-    orphanage.LimitOrphans(0);
+    orphanage.LimitOrphans(0, DEFAULT_MAX_ORPHAN_USAGE);
     BOOST_CHECK(orphanage.CountOrphans() == 0);
 }
 
+// SYSCOIN
+static CTransactionRef MakeOrphanBlobTx(size_t blob_size)
+{
+    CMutableTransaction tx;
+    tx.nVersion = SYSCOIN_TX_VERSION_NEVM_DATA_SHA3;
+    tx.vin.resize(1);
+    tx.vin[0].prevout.hash = InsecureRand256();
+    tx.vout.resize(1);
+    tx.vout[0].scriptPubKey = CScript() << OP_RETURN << ToByteVector(InsecureRand256());
+    tx.vout[0].nValue = 0;
+    tx.vout[0].SetNEVMData(std::vector<uint8_t>(blob_size, 0x01));
+    return MakeTransactionRef(tx);
+}
+
+BOOST_AUTO_TEST_CASE(orphan_blob_usage)
+{
+    TxOrphanageTest orphanage;
+
+    // the blob counts at its full size, not at the scaled down size of the weight
+    const CTransactionRef blob_tx{MakeOrphanBlobTx(MAX_NEVM_DATA_BLOB)};
+    BOOST_CHECK(GetTransactionWeight(*blob_tx) < MAX_STANDARD_TX_WEIGHT);
+    BOOST_CHECK(orphanage.AddTx(blob_tx, /*peer=*/0));
+    BOOST_CHECK(orphanage.PeerUsage(/*peer=*/0) > size_t(MAX_NEVM_DATA_BLOB));
+    BOOST_CHECK_EQUAL(orphanage.TotalUsage(), orphanage.PeerUsage(/*peer=*/0));
+
+    // a peer over its own limit only loses its own orphans
+    const CTransactionRef small_tx{MakeOrphanBlobTx(100)};
+    BOOST_CHECK(orphanage.AddTx(small_tx, /*peer=*/1));
+    BOOST_CHECK(orphanage.AddTx(MakeOrphanBlobTx(MAX_NEVM_DATA_BLOB), /*peer=*/0));
+    BOOST_CHECK(orphanage.AddTx(MakeOrphanBlobTx(MAX_NEVM_DATA_BLOB), /*peer=*/0));
+    orphanage.LimitOrphans(DEFAULT_MAX_ORPHAN_TRANSACTIONS, DEFAULT_MAX_ORPHAN_USAGE);
+    BOOST_CHECK(orphanage.PeerUsage(/*peer=*/0) <= MAX_ORPHAN_USAGE_PER_PEER);
+    BOOST_CHECK_EQUAL(orphanage.CountOrphans(), 2U);
+    BOOST_CHECK(orphanage.HaveTx(GenTxid::Txid(small_tx->GetHash())));
+
+    // under memory pressure the heaviest peer is evicted first
+    orphanage.LimitOrphans(DEFAULT_MAX_ORPHAN_TRANSACTIONS, orphanage.TotalUsage() - 1);
+    BOOST_CHECK_EQUAL(orphanage.CountOrphans(), 1U);
+    BOOST_CHECK_EQUAL(orphanage.PeerUsage(/*peer=*/0), 0U);
+    BOOST_CHECK(orphanage.HaveTx(GenTxid::Txid(small_tx->GetHash())));
+
+    orphanage.EraseForPeer(/*peer=*/1);
+    BOOST_CHECK_EQUAL(orphanage.TotalUsage(), 0U);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -45,4 +45,38 @@ BOOST_AUTO_TEST_CASE(test_query_string)
     BOOST_CHECK_EQUAL(param, "/rest/endpoint/someresource");
     BOOST_CHECK_EQUAL(rf, RESTResponseFormat::UNDEF);
 }
+
+// SYSCOIN
+BOOST_AUTO_TEST_CASE(test_byte_range)
+{
+    uint64_t begin{0}, end{0};
+    // No or malformed range serves the full content
+    BOOST_CHECK(ParseByteRange("", 100, begin, end) == RESTByteRange::FULL);
+    BOOST_CHECK(ParseByteRange("items=0-9", 100, begin, end) == RESTByteRange::FULL);
+    BOOST_CHECK(ParseByteRange("bytes=9-0", 100, begin, end) == RESTByteRange::FULL);
+    BOOST_CHECK(ParseByteRange("bytes=a-9", 100, begin, end) == RESTByteRange::FULL);
+    BOOST_CHECK(ParseByteRange("bytes=-", 100, begin, end) == RESTByteRange::FULL);
+    // Several ranges are not served as multipart
+    BOOST_CHECK(ParseByteRange("bytes=0-9,20-29", 100, begin, end) == RESTByteRange::FULL);
+
+    BOOST_CHECK(ParseByteRange("bytes=10-19", 100, begin, end) == RESTByteRange::PARTIAL);
+    BOOST_CHECK_EQUAL(begin, 10U);
+    BOOST_CHECK_EQUAL(end, 20U);
+    // Open ended and past the end ranges stop at the end
+    BOOST_CHECK(ParseByteRange("bytes=90-", 100, begin, end) == RESTByteRange::PARTIAL);
+    BOOST_CHECK_EQUAL(begin, 90U);
+    BOOST_CHECK_EQUAL(end, 100U);
+    BOOST_CHECK(ParseByteRange("bytes=90-18446744073709551615", 100, begin, end) == RESTByteRange::PARTIAL);
+    BOOST_CHECK_EQUAL(end, 100U);
+    // Suffix ranges
+    BOOST_CHECK(ParseByteRange("bytes=-10", 100, begin, end) == RESTByteRange::PARTIAL);
+    BOOST_CHECK_EQUAL(begin, 90U);
+    BOOST_CHECK_EQUAL(end, 100U);
+    BOOST_CHECK(ParseByteRange("bytes=-1000", 100, begin, end) == RESTByteRange::PARTIAL);
+    BOOST_CHECK_EQUAL(begin, 0U);
+
+    BOOST_CHECK(ParseByteRange("bytes=100-", 100, begin, end) == RESTByteRange::UNSATISFIABLE);
+    BOOST_CHECK(ParseByteRange("bytes=-0", 100, begin, end) == RESTByteRange::UNSATISFIABLE);
+    BOOST_CHECK(ParseByteRange("bytes=-10", 0, begin, end) == RESTByteRange::UNSATISFIABLE);
+}
 BOOST_AUTO_TEST_SUITE_END()
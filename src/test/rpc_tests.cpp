@@ -4,6 +4,7 @@
 
 #include <core_io.h>
 #include <interfaces/chain.h>
+#include <node/blockstats.h>
 #include <node/context.h>
 #include <rpc/blockchain.h>
 #include <rpc/client.h>
@@ -14,9 +15,13 @@
 #include <util/time.h>
 
 #include <any>
+#include <thread>
 
 #include <boost/test/unit_test.hpp>
 
+using node::CalculatePercentilesByWeight;
+using node::NUM_GETBLOCKSTATS_PERCENTILES;
+
 static UniValue JSON(std::string_view json)
 {
     UniValue value;
@@ -636,4 +641,43 @@ BOOST_AUTO_TEST_CASE(help_example)
     BOOST_CHECK_NE(HelpExampleRpcNamed("foo", {{"arg", true}}), HelpExampleRpcNamed("foo", {{"arg", "true"}}));
 }
 
+// SYSCOIN
+BOOST_AUTO_TEST_CASE(rpc_batch_parallel)
+{
+    if (RPCIsInWarmup(nullptr)) SetRPCWarmupFinished();
+    UniValue batch(UniValue::VARR);
+    for (int i = 0; i < 20; ++i) {
+        UniValue call(UniValue::VOBJ);
+        call.pushKV("method", "echo");
+        UniValue params(UniValue::VARR);
+        params.push_back(i);
+        call.pushKV("params", params);
+        call.pushKV("id", i);
+        batch.push_back(call);
+    }
+    batch.push_back("not a request");
+    node::JSONRPCRequest request;
+    request.context = &m_node;
+    request.URI = "/";
+    const std::string sequential{JSONRPCExecBatch(request, batch)};
+
+    std::vector<std::thread> threads;
+    const auto spawn = [&threads](std::function<void()> work) {
+        threads.emplace_back(std::move(work));
+        return true;
+    };
+    BOOST_CHECK_EQUAL(JSONRPCExecBatch(request, batch, spawn, 4), sequential);
+    BOOST_CHECK_EQUAL(threads.size(), 4U);
+    for (std::thread& thread : threads) thread.join();
+    threads.clear();
+
+    // the batch still completes when no helper could be queued
+    BOOST_CHECK_EQUAL(JSONRPCExecBatch(request, batch, [](std::function<void()>) { return false; }, 4), sequential);
+
+    // batches sent to a wallet endpoint run in order
+    request.URI = "/wallet/w1";
+    BOOST_CHECK_EQUAL(JSONRPCExecBatch(request, batch, spawn, 4), sequential);
+    BOOST_CHECK(threads.empty());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -212,4 +212,33 @@ BOOST_AUTO_TEST_CASE(mockforward)
     BOOST_CHECK(delta > 2*60 && delta < 3*60);
 }
 
+// SYSCOIN
+BOOST_AUTO_TEST_CASE(task_stats)
+{
+    CScheduler scheduler{"test"};
+    BOOST_CHECK_EQUAL(scheduler.GetName(), "test");
+
+    // due 50ms ago and runs for 20ms
+    scheduler.schedule([] { UninterruptibleSleep(std::chrono::milliseconds{20}); }, std::chrono::steady_clock::now() - std::chrono::milliseconds{50}, "slow");
+    // unnamed tasks are not accounted
+    scheduler.scheduleFromNow([] {}, std::chrono::milliseconds{0});
+    // the repeats of a task are accounted under its name
+    int repeats{0};
+    scheduler.scheduleEvery([&] {
+        if (++repeats == 3) scheduler.stop();
+    }, std::chrono::milliseconds{1}, "repeat");
+
+    std::thread scheduler_thread([&] { scheduler.serviceQueue(); });
+    scheduler_thread.join();
+
+    const auto stats{scheduler.GetTaskStats()};
+    BOOST_CHECK_EQUAL(stats.size(), 2U);
+    const CScheduler::TaskStats& slow{stats.at("slow")};
+    BOOST_CHECK_EQUAL(slow.runs, 1U);
+    BOOST_CHECK(slow.max_run >= std::chrono::milliseconds{20});
+    BOOST_CHECK(slow.total_run == slow.max_run);
+    BOOST_CHECK(slow.max_delay >= std::chrono::milliseconds{50});
+    BOOST_CHECK_EQUAL(stats.at("repeat").runs, 3U);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
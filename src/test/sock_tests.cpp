@@ -169,6 +169,47 @@ BOOST_AUTO_TEST_CASE(recv_until_terminator_limit)
     receiver.join();
 }
 
+#ifdef USE_EPOLL
+// SYSCOIN
+BOOST_AUTO_TEST_CASE(epoll_wait_many)
+{
+    int s[2];
+    CreateSocketPair(s);
+    const auto sock0{std::make_shared<const Sock>(s[0])};
+    const auto sock1{std::make_shared<const Sock>(s[1])};
+
+    EpollSockWaiter waiter;
+    BOOST_REQUIRE(waiter.IsValid());
+    Sock::EventsPerSock events_per_sock{{sock0, Sock::Events{Sock::RECV}}, {sock1, Sock::Events{Sock::RECV | Sock::SEND}}};
+    BOOST_REQUIRE(waiter.WaitMany(0ms, events_per_sock));
+    BOOST_CHECK_EQUAL(waiter.Size(), 2U);
+    BOOST_CHECK_EQUAL(events_per_sock.at(sock0).occurred, 0);
+    BOOST_CHECK_EQUAL(events_per_sock.at(sock1).occurred, Sock::SEND);
+
+    // level-triggered like poll, undrained data is reported on every call
+    BOOST_REQUIRE_EQUAL(sock1->Send("a", 1, 0), 1);
+    for (int i = 0; i < 2; i++) {
+        BOOST_REQUIRE(waiter.WaitMany(1min, events_per_sock));
+        BOOST_CHECK_EQUAL(events_per_sock.at(sock0).occurred, Sock::RECV);
+    }
+
+    // changing the requested events of a registered socket
+    events_per_sock.at(sock0).requested = Sock::SEND;
+    BOOST_REQUIRE(waiter.WaitMany(0ms, events_per_sock));
+    BOOST_CHECK_EQUAL(events_per_sock.at(sock0).occurred, Sock::SEND);
+
+    // sockets left out are unregistered
+    events_per_sock.erase(sock1);
+    BOOST_REQUIRE(waiter.WaitMany(0ms, events_per_sock));
+    BOOST_CHECK_EQUAL(waiter.Size(), 1U);
+
+    // a socket that epoll can't wait on fails the call, the caller falls back to poll
+    const auto invalid{std::make_shared<const Sock>(INVALID_SOCKET)};
+    Sock::EventsPerSock invalid_events{{invalid, Sock::Events{Sock::RECV}}};
+    BOOST_CHECK(!waiter.WaitMany(0ms, invalid_events));
+}
+#endif // USE_EPOLL
+
 #endif /* WIN32 */
 
 BOOST_AUTO_TEST_SUITE_END()
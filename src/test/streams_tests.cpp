@@ -246,6 +246,25 @@ BOOST_AUTO_TEST_CASE(streams_serializedata_xor)
     }
 }
 
+// SYSCOIN
+BOOST_AUTO_TEST_CASE(streams_xor_word_key)
+{
+    // the word at a time path for 8 byte keys matches the byte loop for every offset and length
+    const auto key{g_insecure_rand_ctx.randbytes<std::byte>(8)};
+    for (size_t len : {0, 1, 7, 8, 9, 31, 64, 1000}) {
+        const auto data{g_insecure_rand_ctx.randbytes<std::byte>(len)};
+        for (size_t offset = 0; offset < 20; ++offset) {
+            auto expected{data};
+            for (size_t i = 0; i < expected.size(); ++i) {
+                expected[i] ^= key[(offset + i) % key.size()];
+            }
+            auto xored{data};
+            util::Xor(xored, key, offset);
+            BOOST_CHECK(xored == expected);
+        }
+    }
+}
+
 BOOST_AUTO_TEST_CASE(streams_buffered_file)
 {
     fs::path streams_test_filename = m_args.GetDataDirBase() / "streams_test_tmp";
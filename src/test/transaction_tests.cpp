@@ -12,6 +12,7 @@
 #include <consensus/tx_check.h>
 #include <consensus/validation.h>
 #include <core_io.h>
+#include <core_memusage.h>
 #include <key.h>
 #include <policy/policy.h>
 #include <policy/settings.h>
@@ -996,4 +997,52 @@ BOOST_AUTO_TEST_CASE(test_IsStandard)
     }
 }
 
+// SYSCOIN
+BOOST_AUTO_TEST_CASE(syscoin_data_view)
+{
+    // every push encoding, and the payload following a witness commitment
+    for (const size_t nSize : {0, 1, 75, 76, 255, 256, 65535, 65536}) {
+        std::vector<unsigned char> vchPayload(nSize);
+        for (size_t i = 0; i < nSize; i++) vchPayload[i] = InsecureRandBits(8);
+        std::vector<unsigned char> vchCommitment(36);
+        vchCommitment[0] = 0xaa;
+        vchCommitment[1] = 0x21;
+        vchCommitment[2] = 0xa9;
+        vchCommitment[3] = 0xed;
+        for (const CScript& script : {CScript() << OP_RETURN << vchPayload, CScript() << OP_RETURN << vchCommitment << vchPayload}) {
+            Span<const unsigned char> vchView;
+            BOOST_REQUIRE(GetSyscoinData(script, vchView));
+            BOOST_CHECK(std::equal(vchView.begin(), vchView.end(), vchPayload.begin(), vchPayload.end()));
+            std::vector<unsigned char> vchData;
+            BOOST_REQUIRE(GetSyscoinData(script, vchData));
+            BOOST_CHECK(vchData == vchPayload);
+        }
+    }
+    // trailing opcodes and non OP_RETURN scripts carry no payload
+    Span<const unsigned char> vchView;
+    BOOST_CHECK(!GetSyscoinData(CScript() << OP_RETURN << std::vector<unsigned char>(3) << OP_1, vchView));
+    BOOST_CHECK(!GetSyscoinData(CScript() << OP_TRUE << std::vector<unsigned char>(3), vchView));
+
+    // the mint payload is decoded once and shared by every copy of the transaction
+    CMutableTransaction mtx;
+    mtx.nVersion = SYSCOIN_TX_VERSION_ALLOCATION_MINT;
+    CMintSyscoin mint;
+    mint.voutAssets.emplace_back(123, std::vector<CAssetOutValue>{CAssetOutValue(0, 1)});
+    mint.nTxHash = InsecureRand256();
+    mint.vchTxParentNodes = {1, 2, 3};
+    std::vector<unsigned char> vchMint;
+    mint.SerializeData(vchMint);
+    mtx.vout.emplace_back(0, CScript() << OP_RETURN << vchMint);
+    const CTransaction tx(mtx);
+    BOOST_REQUIRE(tx.GetMintSyscoin());
+    BOOST_CHECK(!tx.GetMintSyscoin()->IsNull());
+    BOOST_CHECK(tx.GetMintSyscoin()->nTxHash == mint.nTxHash);
+    BOOST_CHECK(tx.GetMintSyscoin()->vchTxParentNodes == mint.vchTxParentNodes);
+    mtx.nVersion = CTransaction::CURRENT_VERSION;
+    BOOST_CHECK(!CTransaction(mtx).GetMintSyscoin());
+    // the memory usage of a mint includes its decoded payload
+    BOOST_CHECK_GE(RecursiveDynamicUsage(tx), RecursiveDynamicUsage(CTransaction(mtx)) + memusage::DynamicUsage(tx.GetMintSyscoin()) +
+        memusage::DynamicUsage(tx.GetMintSyscoin()->voutAssets) + memusage::DynamicUsage(tx.GetMintSyscoin()->vchTxParentNodes));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
\ No newline at end of file
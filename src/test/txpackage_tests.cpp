@@ -3,17 +3,27 @@
 // file COPYING or http://www.opensource.org/licenses/mit-license.php.
 
 #include <consensus/validation.h>
+#include <crypto/common.h>
+#include <hash.h>
 #include <key_io.h>
 #include <policy/packages.h>
 #include <policy/policy.h>
 #include <primitives/transaction.h>
 #include <script/script.h>
+// SYSCOIN
+#include <nevm/rlp.h>
+#include <nevm/sha3.h>
+#include <services/assetconsensus.h>
 #include <test/util/random.h>
 #include <test/util/setup_common.h>
+#include <test/util/transaction_utils.h>
 #include <validation.h>
 
 #include <boost/test/unit_test.hpp>
 
+// SYSCOIN
+extern NEVMMintTxSet setMintTxsMempool;
+
 BOOST_AUTO_TEST_SUITE(txpackage_tests)
 // A fee amount that is above 1sat/vB but below 5sat/vB for most transactions created within these
 // unit tests.
@@ -38,6 +48,70 @@ inline CTransactionRef create_placeholder_tx(size_t num_inputs, size_t num_outpu
     return MakeTransactionRef(mtx);
 }
 
+// SYSCOIN
+// Prove value as the only leaf of a trie, keyed like the first transaction of an NEVM block.
+static void CreateSingleLeafProof(const dev::bytes& value, std::vector<unsigned char>& vchParentNodes, uint16_t& pos, uint256& root)
+{
+    dev::RLPStream leaf(2);
+    // hex prefix flag of an even length leaf, then the path 0x80
+    leaf.append(dev::bytes{0x20, 0x80}).append(value);
+    dev::RLPStream parent_nodes(1);
+    parent_nodes.appendRaw(leaf.out());
+    vchParentNodes = parent_nodes.out();
+    pos = std::search(vchParentNodes.begin(), vchParentNodes.end(), value.begin(), value.end()) - vchParentNodes.begin();
+    const dev::h256 hash{dev::sha3(leaf.out())};
+    root = uint256{Span{hash.data(), hash.size}};
+}
+
+// Create a valid mint of amount SYSX to dest for the bridge transfer with the given NEVM nonce,
+// so two mints with the same nonce claim the same transfer. The roots of its NEVM block are
+// stored, output 1 is SYS change left for a child.
+static CMutableTransaction CreateMint(uint64_t nonce, CAmount amount, const CTxDestination& dest, const CKey& key,
+                                      const CTransactionRef& prev_tx, uint32_t prev_n, CAmount fee)
+{
+    const auto& consensus = Params().GetConsensus();
+    // a legacy transaction to the vault manager, signed for the NEVM chain
+    dev::RLPStream eth_tx(9);
+    eth_tx.append(dev::u256(nonce)).append(dev::u256(1)).append(dev::u256(21000)).append(consensus.vchSyscoinVaultManager)
+          .append(dev::u256(0)).append(dev::bytes{}).append(dev::u256(consensus.nNEVMChainID) * 2 + 35)
+          .append(dev::u256(1)).append(dev::u256(1));
+    // its freeze event: the amount then the witness address as an ABI encoded string
+    const std::string address{EncodeDestination(dest)};
+    dev::bytes data(96 + (address.size() + 31) / 32 * 32);
+    WriteBE64(data.data() + 24, amount);
+    data[63] = 64;
+    data[95] = address.size();
+    std::copy(address.begin(), address.end(), data.begin() + 96);
+    dev::bytes asset_guid(32);
+    WriteBE64(asset_guid.data() + 24, consensus.nSYSXAsset);
+    dev::RLPStream log(3);
+    log.append(consensus.vchSyscoinVaultManager).appendList(3).append(consensus.vchTokenFreezeMethod).append(asset_guid).append(dev::bytes(32));
+    log.append(data);
+    dev::RLPStream receipt(4);
+    receipt.append(dev::u256(1)).append(dev::u256(21000)).append(dev::bytes{}).appendList(1).appendRaw(log.out());
+
+    CMintSyscoin mint;
+    mint.voutAssets.emplace_back(consensus.nSYSXAsset, std::vector<CAssetOutValue>{CAssetOutValue(0, amount)});
+    mint.vchTxPath = {0x80};
+    CreateSingleLeafProof(eth_tx.out(), mint.vchTxParentNodes, mint.posTx, mint.nTxRoot);
+    CreateSingleLeafProof(receipt.out(), mint.vchReceiptParentNodes, mint.posReceipt, mint.nReceiptRoot);
+    const dev::h256 tx_hash{dev::sha3(eth_tx.out())};
+    mint.nTxHash = uint256{Span{tx_hash.data(), tx_hash.size}};
+    mint.nBlockHash = (HashWriter{} << nonce).GetHash();
+    pnevmtxrootsdb->FlushDataToCache(NEVMTxRootMap{{mint.nBlockHash, NEVMTxRoot{.nTxRoot = mint.nTxRoot, .nReceiptRoot = mint.nReceiptRoot}}});
+
+    CMutableTransaction mtx;
+    mtx.nVersion = SYSCOIN_TX_VERSION_ALLOCATION_MINT;
+    mtx.vout.emplace_back(CENT, GetScriptForDestination(dest));
+    mtx.vout.emplace_back(prev_tx->vout[prev_n].nValue - CENT - fee, GetScriptForDestination(dest));
+    std::vector<unsigned char> vchData;
+    mint.SerializeData(vchData);
+    mtx.vout.emplace_back(0, CScript() << OP_RETURN << vchData);
+    mtx.LoadAssets();
+    BOOST_REQUIRE(AddSignedInput(mtx, key, *prev_tx, prev_n));
+    return mtx;
+}
+
 BOOST_FIXTURE_TEST_CASE(package_sanitization_tests, TestChain100Setup)
 {
     // Packages can't have more than 25 transactions.
@@ -847,4 +921,104 @@ BOOST_FIXTURE_TEST_CASE(package_cpfp_tests, TestChain100Setup)
         BOOST_CHECK(!m_node.mempool->exists(GenTxid::Txid(tx_child_poor->GetHash())));
     }
 }
+
+// SYSCOIN
+BOOST_FIXTURE_TEST_CASE(package_mint_tests, TestChainDIP3Setup)
+{
+    MockMempoolMinFee(CFeeRate(5000));
+    LOCK(::cs_main);
+    size_t expected_pool_size = m_node.mempool->size();
+    const NEVMMintTxSet mints_before{setMintTxsMempool};
+    const CTxDestination dest{WitnessV0KeyHash(coinbaseKey.GetPubKey())};
+    const CScript spk{GetScriptForDestination(dest)};
+    const CAmount high_fee{CENT};
+    // mints carry their proofs, so this is above 1sat/vB but below 5sat/vB for them
+    const CAmount low_mint_fee{2000};
+
+    // Two mints of the same bridge transfer in one package, the second one is rejected for claiming
+    // it again whether the package is tested or submitted.
+    {
+        const auto tx_mint{MakeTransactionRef(CreateMint(1, COIN, dest, coinbaseKey, m_coinbase_txns[0], 0, high_fee))};
+        const auto tx_dup{MakeTransactionRef(CreateMint(1, COIN, dest, coinbaseKey, tx_mint, 1, high_fee))};
+        const Package package_dup{tx_mint, tx_dup};
+        const auto result_dup = ProcessNewPackage(m_node.chainman->ActiveChainstate(), *m_node.mempool,
+                                                  package_dup, /*test_accept=*/true);
+        BOOST_CHECK(result_dup.m_state.IsInvalid());
+        auto it_dup = result_dup.m_tx_results.find(tx_dup->GetWitnessHash());
+        BOOST_REQUIRE(it_dup != result_dup.m_tx_results.end());
+        BOOST_CHECK_EQUAL(it_dup->second.m_state.GetResult(), TxValidationResult::TX_MINT_DUPLICATE);
+        BOOST_CHECK_EQUAL(it_dup->second.m_state.GetRejectReason(), "mint-duplicate-transfer");
+        BOOST_CHECK(setMintTxsMempool == mints_before);
+    }
+    // The first mint is too cheap to go in on its own, so the package is validated as a whole. A
+    // rejected package leaves no bridge transfer claimed.
+    {
+        const auto tx_mint{MakeTransactionRef(CreateMint(1, COIN, dest, coinbaseKey, m_coinbase_txns[1], 0, low_mint_fee))};
+        const auto tx_dup{MakeTransactionRef(CreateMint(1, COIN, dest, coinbaseKey, tx_mint, 1, high_fee))};
+        const Package package_dup{tx_mint, tx_dup};
+        const auto result_dup = ProcessNewPackage(m_node.chainman->ActiveChainstate(), *m_node.mempool,
+                                                  package_dup, /*test_accept=*/false);
+        BOOST_CHECK(result_dup.m_state.IsInvalid());
+        auto it_dup = result_dup.m_tx_results.find(tx_dup->GetWitnessHash());
+        BOOST_REQUIRE(it_dup != result_dup.m_tx_results.end());
+        BOOST_CHECK_EQUAL(it_dup->second.m_state.GetResult(), TxValidationResult::TX_MINT_DUPLICATE);
+        BOOST_CHECK_EQUAL(it_dup->second.m_state.GetRejectReason(), "mint-duplicate-transfer");
+        BOOST_CHECK_EQUAL(m_node.mempool->size(), expected_pool_size);
+        BOOST_CHECK(setMintTxsMempool == mints_before);
+    }
+
+    // A package minting a bridge transfer that a mempool transaction already claims
+    {
+        const auto tx_pool{MakeTransactionRef(CreateMint(2, COIN, dest, coinbaseKey, m_coinbase_txns[2], 0, high_fee))};
+        const auto result_pool = m_node.chainman->ProcessTransaction(tx_pool);
+        BOOST_CHECK_MESSAGE(result_pool.m_result_type == MempoolAcceptResult::ResultType::VALID,
+                            "Mint unexpectedly failed: " << result_pool.m_state.GetRejectReason());
+        expected_pool_size += 1;
+        const uint256 nTxHash{tx_pool->GetMintSyscoin()->nTxHash};
+        BOOST_CHECK(setMintTxsMempool.count(nTxHash));
+
+        const auto tx_mint{MakeTransactionRef(CreateMint(2, COIN, dest, coinbaseKey, m_coinbase_txns[3], 0, high_fee))};
+        const auto tx_child{MakeTransactionRef(CreateValidMempoolTransaction(/*input_transaction=*/tx_mint, /*input_vout=*/1,
+                                                                             /*input_height=*/0, /*input_signing_key=*/coinbaseKey,
+                                                                             /*output_destination=*/spk,
+                                                                             /*output_amount=*/tx_mint->vout[1].nValue - high_fee,
+                                                                             /*submit=*/false))};
+        const Package package_pool{tx_mint, tx_child};
+        for (const bool test_accept : {true, false}) {
+            const auto result = ProcessNewPackage(m_node.chainman->ActiveChainstate(), *m_node.mempool,
+                                                  package_pool, test_accept);
+            BOOST_CHECK(result.m_state.IsInvalid());
+            auto it_mint = result.m_tx_results.find(tx_mint->GetWitnessHash());
+            BOOST_REQUIRE(it_mint != result.m_tx_results.end());
+            BOOST_CHECK_EQUAL(it_mint->second.m_state.GetRejectReason(), "mint-duplicate-transfer");
+            BOOST_CHECK_EQUAL(m_node.mempool->size(), expected_pool_size);
+            // the claim of the mempool transaction is kept
+            BOOST_CHECK(setMintTxsMempool.count(nTxHash));
+        }
+    }
+
+    // A low-fee mint fails on its own, then gets in with a high-fee child
+    {
+        const auto tx_mint{MakeTransactionRef(CreateMint(3, COIN, dest, coinbaseKey, m_coinbase_txns[4], 0, low_mint_fee))};
+        const auto tx_child{MakeTransactionRef(CreateValidMempoolTransaction(/*input_transaction=*/tx_mint, /*input_vout=*/1,
+                                                                             /*input_height=*/0, /*input_signing_key=*/coinbaseKey,
+                                                                             /*output_destination=*/spk,
+                                                                             /*output_amount=*/tx_mint->vout[1].nValue - high_fee,
+                                                                             /*submit=*/false))};
+        const uint256 nTxHash{tx_mint->GetMintSyscoin()->nTxHash};
+        const auto result_alone = m_node.chainman->ProcessTransaction(tx_mint);
+        BOOST_CHECK(result_alone.m_result_type == MempoolAcceptResult::ResultType::INVALID);
+        BOOST_CHECK_EQUAL(result_alone.m_state.GetResult(), TxValidationResult::TX_MEMPOOL_POLICY);
+        BOOST_CHECK(!setMintTxsMempool.count(nTxHash));
+
+        const Package package_cpfp{tx_mint, tx_child};
+        const auto result_cpfp = ProcessNewPackage(m_node.chainman->ActiveChainstate(), *m_node.mempool,
+                                                   package_cpfp, /*test_accept=*/false);
+        BOOST_CHECK_MESSAGE(result_cpfp.m_state.IsValid(),
+                            "Package validation unexpectedly failed: " << result_cpfp.m_state.GetRejectReason());
+        expected_pool_size += 2;
+        BOOST_CHECK_EQUAL(m_node.mempool->size(), expected_pool_size);
+        BOOST_CHECK(setMintTxsMempool.count(nTxHash));
+    }
+}
 BOOST_AUTO_TEST_SUITE_END()
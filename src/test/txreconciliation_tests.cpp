@@ -81,4 +81,71 @@ BOOST_AUTO_TEST_CASE(IsPeerRegisteredTest)
     BOOST_CHECK(!tracker.IsPeerRegistered(peer_id0));
 }
 
+// SYSCOIN
+BOOST_AUTO_TEST_CASE(GovernanceReconciliationTest)
+{
+    // node 0 connected out to node 1, so node 0 initiates
+    TxReconciliationTracker initiator(TXRECONCILIATION_VERSION);
+    TxReconciliationTracker responder(TXRECONCILIATION_VERSION);
+    const uint64_t initiator_salt{initiator.PreRegisterPeer(1)};
+    const uint64_t responder_salt{responder.PreRegisterPeer(0)};
+    BOOST_REQUIRE(initiator.RegisterPeer(1, false, 1, responder_salt) == ReconciliationRegisterResult::SUCCESS);
+    BOOST_REQUIRE(responder.RegisterPeer(0, true, 1, initiator_salt) == ReconciliationRegisterResult::SUCCESS);
+
+    const CInv only_initiator{MSG_GOVERNANCE_OBJECT_VOTE, uint256S("01")};
+    const CInv shared{MSG_GOVERNANCE_OBJECT_VOTE, uint256S("02")};
+    const CInv only_responder{MSG_GOVERNANCE_OBJECT, uint256S("03")};
+    BOOST_CHECK(IsReconcilableInv(shared));
+    BOOST_CHECK(!IsReconcilableInv(CInv{MSG_QUORUM_RECOVERED_SIG, uint256S("04")}));
+    // unregistered peers get their inventory flooded
+    BOOST_CHECK(!initiator.AddToReconSet(2, shared));
+
+    BOOST_CHECK(initiator.AddToReconSet(1, only_initiator));
+    BOOST_CHECK(initiator.AddToReconSet(1, shared));
+    BOOST_CHECK(responder.AddToReconSet(0, shared));
+    BOOST_CHECK(responder.AddToReconSet(0, only_responder));
+    BOOST_CHECK(responder.AddToReconSet(0, CInv{MSG_GOVERNANCE_OBJECT_VOTE, uint256S("05")}));
+    responder.TryRemovingFromReconSet(0, uint256S("05"));
+
+    // only the initiator asks and only the responder sketches
+    const std::chrono::microseconds now{1000000};
+    BOOST_CHECK(!responder.InitiateReconciliation(0, now));
+    BOOST_CHECK(!initiator.HandleReconciliationRequest(1, 0));
+    const auto set_size = initiator.InitiateReconciliation(1, now);
+    BOOST_REQUIRE(set_size);
+    BOOST_CHECK_EQUAL(*set_size, 2U);
+    BOOST_CHECK(!initiator.InitiateReconciliation(1, now));
+    const auto sketch = responder.HandleReconciliationRequest(0, *set_size);
+    BOOST_REQUIRE(sketch);
+    BOOST_CHECK(!responder.HandleSketch(0, *sketch));
+
+    // the shared item is announced by neither side
+    const auto result = initiator.HandleSketch(1, *sketch);
+    BOOST_REQUIRE(result);
+    BOOST_CHECK(result->fSuccess);
+    BOOST_REQUIRE_EQUAL(result->vAnnounce.size(), 1U);
+    BOOST_CHECK(result->vAnnounce[0].hash == only_initiator.hash);
+    BOOST_CHECK_EQUAL(result->vAsk.size(), 1U);
+    BOOST_CHECK(!initiator.HandleSketch(1, *sketch));
+    const auto announce = responder.HandleReconciliationDiff(0, result->fSuccess, result->vAsk);
+    BOOST_REQUIRE(announce);
+    BOOST_REQUIRE_EQUAL(announce->size(), 1U);
+    BOOST_CHECK((*announce)[0].hash == only_responder.hash);
+    BOOST_CHECK(!responder.HandleReconciliationDiff(0, true, {}));
+
+    // an empty sketch means the difference was too large, both sides announce everything
+    BOOST_CHECK(initiator.AddToReconSet(1, shared));
+    BOOST_CHECK(responder.AddToReconSet(0, only_responder));
+    BOOST_CHECK(!initiator.InitiateReconciliation(1, now + INV_RECON_REQUEST_INTERVAL / 2));
+    BOOST_REQUIRE(initiator.InitiateReconciliation(1, now + INV_RECON_REQUEST_INTERVAL));
+    BOOST_REQUIRE(responder.HandleReconciliationRequest(0, 1));
+    const auto failed = initiator.HandleSketch(1, std::vector<uint8_t>{});
+    BOOST_REQUIRE(failed);
+    BOOST_CHECK(!failed->fSuccess);
+    BOOST_CHECK_EQUAL(failed->vAnnounce.size(), 1U);
+    const auto flooded = responder.HandleReconciliationDiff(0, false, {});
+    BOOST_REQUIRE(flooded);
+    BOOST_CHECK_EQUAL(flooded->size(), 1U);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
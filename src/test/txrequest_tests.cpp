@@ -737,4 +737,36 @@ BOOST_AUTO_TEST_CASE(TxRequestTest)
     }
 }
 
+// SYSCOIN
+BOOST_AUTO_TEST_CASE(TxRequestSizeHintTest)
+{
+    TxRequestTracker txrequest(/*deterministic=*/true);
+    const auto now{std::chrono::microseconds{1}};
+    const GenTxid blob_tx{GenTxid::Wtxid(InsecureRand256())};
+    const GenTxid small_tx{GenTxid::Wtxid(InsecureRand256())};
+
+    // the blob transaction is announced first but requested after the small one
+    txrequest.ReceivedInv(/*peer=*/0, blob_tx, /*preferred=*/true, MIN_TIME, /*size_hint=*/MAX_NEVM_DATA_BLOB);
+    txrequest.ReceivedInv(/*peer=*/0, small_tx, /*preferred=*/true, MIN_TIME, /*size_hint=*/250);
+    const std::vector<GenTxid> requestable{txrequest.GetRequestable(/*peer=*/0, now)};
+    BOOST_REQUIRE_EQUAL(requestable.size(), 2U);
+    BOOST_CHECK(requestable[0].GetHash() == small_tx.GetHash());
+    BOOST_CHECK(requestable[1].GetHash() == blob_tx.GetHash());
+    txrequest.PostGetRequestableSanityCheck(now);
+
+    // only the blob transaction counts as a large request in flight
+    txrequest.RequestedTx(/*peer=*/0, small_tx.GetHash(), MAX_TIME);
+    BOOST_CHECK_EQUAL(txrequest.CountLargeInFlight(/*peer=*/0), 0U);
+    txrequest.RequestedTx(/*peer=*/0, blob_tx.GetHash(), MAX_TIME);
+    BOOST_CHECK_EQUAL(txrequest.CountInFlight(/*peer=*/0), 2U);
+    BOOST_CHECK_EQUAL(txrequest.CountLargeInFlight(/*peer=*/0), 1U);
+    txrequest.SanityCheck();
+
+    txrequest.ReceivedResponse(/*peer=*/0, blob_tx.GetHash());
+    BOOST_CHECK_EQUAL(txrequest.CountLargeInFlight(/*peer=*/0), 0U);
+    txrequest.SanityCheck();
+    txrequest.DisconnectedPeer(/*peer=*/0);
+    BOOST_CHECK_EQUAL(txrequest.Size(), 0U);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -4,6 +4,7 @@
 
 #include <arith_uint256.h>
 #include <streams.h>
+#include <test/util/random.h>
 #include <test/util/setup_common.h>
 #include <uint256.h>
 #include <version.h>
@@ -285,4 +286,23 @@ BOOST_AUTO_TEST_CASE( check_ONE )
     BOOST_CHECK_EQUAL(one, uint256::ONEV);
 }
 
+// SYSCOIN
+BOOST_AUTO_TEST_CASE( word_compare ) // Compare() and Equals() of whole words agree with memcmp
+{
+    for (int i = 0; i < 1000; ++i) {
+        uint256 a{InsecureRand256()};
+        uint256 b{a};
+        // differ in a single byte, in any word
+        b.data()[InsecureRandRange(32)] ^= uint8_t(1 + InsecureRandRange(255));
+        const int cmp{std::memcmp(a.data(), b.data(), 32)};
+        BOOST_CHECK_EQUAL(a.Compare(b) < 0, cmp < 0);
+        BOOST_CHECK_EQUAL(a.Compare(b) > 0, cmp > 0);
+        BOOST_CHECK_EQUAL(b.Compare(a) < 0, cmp > 0);
+        BOOST_CHECK(!a.Equals(b));
+        BOOST_CHECK(a != b);
+        BOOST_CHECK(a.Equals(a));
+        BOOST_CHECK_EQUAL(a.Compare(a), 0);
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
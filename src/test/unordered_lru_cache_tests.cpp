@@ -0,0 +1,59 @@
+// Copyright (c) 2024 The Syscoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <unordered_lru_cache.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <functional>
+
+BOOST_AUTO_TEST_SUITE(unordered_lru_cache_tests)
+
+BOOST_AUTO_TEST_CASE(lru_eviction)
+{
+    unordered_lru_cache<int, int, std::hash<int>, 3> cache;
+    cache.insert(1, 10);
+    cache.insert(2, 20);
+    cache.insert(3, 30);
+    BOOST_CHECK_EQUAL(cache.size(), 3U);
+
+    // touching 1 makes 2 the least recently used entry
+    int value{0};
+    BOOST_CHECK(cache.get(1, value));
+    BOOST_CHECK_EQUAL(value, 10);
+    cache.insert(4, 40);
+    BOOST_CHECK_EQUAL(cache.size(), 3U);
+    BOOST_CHECK(!cache.exists(2));
+    BOOST_CHECK(cache.exists(3));
+
+    // 3 was just touched by exists(), 1 goes next
+    cache.insert(5, 50);
+    BOOST_CHECK(!cache.exists(1));
+    BOOST_CHECK(cache.exists(4));
+
+    // overwriting keeps the size and touches the entry
+    cache.insert(3, 33);
+    cache.insert(6, 60);
+    BOOST_CHECK_EQUAL(cache.size(), 3U);
+    BOOST_CHECK(!cache.exists(5));
+    const int* p = cache.get(3);
+    BOOST_REQUIRE(p);
+    BOOST_CHECK_EQUAL(*p, 33);
+    BOOST_CHECK(cache.get(5) == nullptr);
+
+    cache.erase(3);
+    BOOST_CHECK_EQUAL(cache.size(), 2U);
+    BOOST_CHECK(!cache.exists(3));
+    cache.insert(7, 70);
+    cache.insert(8, 80);
+    BOOST_CHECK_EQUAL(cache.size(), 3U);
+    BOOST_CHECK(!cache.exists(4));
+
+    cache.clear();
+    BOOST_CHECK_EQUAL(cache.size(), 0U);
+    cache.insert(9, 90);
+    BOOST_CHECK(cache.exists(9));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
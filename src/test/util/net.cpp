@@ -75,7 +75,9 @@ void ConnmanTestMsg::NodeReceiveMsgBytes(CNode& node, Span<const uint8_t> msg_by
 void ConnmanTestMsg::FlushSendBuffer(CNode& node) const
 {
     LOCK(node.cs_vSend);
-    node.vSendMsg.clear();
+    for (auto& queue : node.vSendMsg) {
+        queue.clear();
+    }
     node.m_send_memusage = 0;
     while (true) {
         const auto& [to_send, _more, _msg_type] = node.m_transport->GetBytesToSend(false);
@@ -8,6 +8,7 @@
 
 #include <addrman.h>
 #include <banman.h>
+#include <bls/bls.h>
 #include <chainparams.h>
 #include <common/system.h>
 #include <common/url.h>
@@ -49,6 +50,7 @@
 #include <txdb.h>
 #include <txmempool.h>
 #include <util/chaintype.h>
+#include <util/executor.h>
 #include <util/strencodings.h>
 #include <util/string.h>
 #include <util/thread.h>
@@ -157,6 +159,7 @@ BasicTestingSetup::BasicTestingSetup(const ChainType chainType, const std::vecto
     ApplyArgsManOptions(*m_node.args, validation_cache_sizes);
     Assert(InitSignatureCache(validation_cache_sizes.signature_cache_bytes));
     Assert(InitScriptExecutionCache(validation_cache_sizes.script_execution_cache_bytes));
+    Assert(InitBLSSignatureCache(validation_cache_sizes.bls_signature_cache_bytes));
 
     m_node.chain = interfaces::MakeChain(m_node);
     static bool noui_connected = false;
@@ -177,9 +180,12 @@ BasicTestingSetup::~BasicTestingSetup()
     pnevmdatablobdb.reset();
     governance.reset();
     deterministicMNManager.reset();
+    psyscoinstatedb.reset();
     netfulfilledman.reset();
     sporkManager.reset();
     mmetaman.reset();
+    // like on shutdown, workers left running would hang a child forked by a later test when it exits
+    StopSharedExecutor();
     SetMockTime(0s); // Reset mocktime for following tests
     LogInstance().DisconnectTestLogger();
     fs::remove_all(m_path_root);
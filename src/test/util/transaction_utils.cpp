@@ -3,8 +3,11 @@
 // file COPYING or http://www.opensource.org/licenses/mit-license.php.
 
 #include <coins.h>
+#include <key.h>
+#include <script/sign.h>
 #include <script/signingprovider.h>
 #include <test/util/transaction_utils.h>
+#include <util/translation.h>
 
 CMutableTransaction BuildCreditingTransaction(const CScript& scriptPubKey, int nValue)
 {
@@ -69,3 +72,25 @@ std::vector<CMutableTransaction> SetupDummyInputs(FillableSigningProvider& keyst
 
     return dummyTransactions;
 }
+
+// SYSCOIN
+void AddAssetAllocationData(CMutableTransaction& mtx, std::vector<CAssetOut> voutAssets, CAmount nDataValue)
+{
+    CAssetAllocation allocation;
+    allocation.voutAssets = std::move(voutAssets);
+    std::vector<unsigned char> vchData;
+    allocation.SerializeData(vchData);
+    mtx.vout.emplace_back(nDataValue, CScript() << OP_RETURN << vchData);
+    mtx.LoadAssets();
+}
+
+bool AddSignedInput(CMutableTransaction& mtx, const CKey& key, const CTransaction& prevTx, uint32_t n)
+{
+    mtx.vin.assign(1, CTxIn(COutPoint(prevTx.GetHash(), n)));
+    FillableSigningProvider keystore;
+    keystore.AddKey(key);
+    std::map<COutPoint, Coin> coins;
+    coins.emplace(mtx.vin[0].prevout, Coin(prevTx.vout[n], 1, prevTx.IsCoinBase()));
+    std::map<int, bilingual_str> input_errors;
+    return SignTransaction(mtx, &keystore, coins, SIGHASH_ALL, input_errors);
+}
@@ -9,6 +9,7 @@
 
 #include <array>
 
+class CKey;
 class FillableSigningProvider;
 class CCoinsViewCache;
 
@@ -26,4 +27,12 @@ CMutableTransaction BuildSpendingTransaction(const CScript& scriptSig, const CSc
 // the second nValues[2] and nValues[3] outputs paid to a TxoutType::PUBKEYHASH.
 std::vector<CMutableTransaction> SetupDummyInputs(FillableSigningProvider& keystoreRet, CCoinsViewCache& coinsRet, const std::array<CAmount,4>& nValues);
 
+// SYSCOIN
+// Add the allocation as data output of mtx carrying nDataValue, and load it
+// into the outputs it assigns assets to.
+void AddAssetAllocationData(CMutableTransaction& mtx, std::vector<CAssetOut> voutAssets, CAmount nDataValue = 0);
+
+// Spend output n of prevTx as the only input of mtx, signed with key.
+bool AddSignedInput(CMutableTransaction& mtx, const CKey& key, const CTransaction& prevTx, uint32_t n);
+
 #endif // SYSCOIN_TEST_UTIL_TRANSACTION_UTILS_H
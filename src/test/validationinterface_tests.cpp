@@ -8,10 +8,15 @@
 #include <scheduler.h>
 #include <test/util/setup_common.h>
 #include <util/check.h>
+#include <util/time.h>
 #include <kernel/chain.h>
 #include <validationinterface.h>
 
 #include <atomic>
+#include <chrono>
+#include <future>
+#include <thread>
+#include <vector>
 
 BOOST_FIXTURE_TEST_SUITE(validationinterface_tests, ChainTestingSetup)
 
@@ -96,4 +101,42 @@ BOOST_AUTO_TEST_CASE(unregister_all_during_call)
     BOOST_CHECK(destroyed);
 }
 
+// SYSCOIN
+BOOST_AUTO_TEST_CASE(subscriber_queue)
+{
+    std::vector<int> order;
+    std::promise<void> release;
+    std::shared_future<void> released{release.get_future()};
+    std::atomic<bool> started{false};
+    std::atomic<int> pushed{0};
+    std::thread producer;
+    {
+        ValidationInterfaceQueue queue{"testqueue", /*max_backlog=*/2};
+        // the first function holds the thread, so two more fill the backlog
+        queue.Push([&order, &started, released] { started = true; released.wait(); order.push_back(0); });
+        while (!started) std::this_thread::yield();
+        producer = std::thread{[&] {
+            for (int i = 1; i <= 3; ++i) {
+                queue.Push([&order, i] { order.push_back(i); });
+                ++pushed;
+            }
+        }};
+        while (pushed < 2) std::this_thread::yield();
+        UninterruptibleSleep(std::chrono::milliseconds{50});
+        BOOST_CHECK_EQUAL(pushed.load(), 2);
+        BOOST_CHECK_EQUAL(queue.Pending(), 2U);
+        release.set_value();
+        producer.join();
+        // SyncWithValidationInterfaceQueue waits for the subscriber queues as well
+        SyncWithValidationInterfaceQueue();
+        BOOST_CHECK_EQUAL(queue.Pending(), 0U);
+        BOOST_CHECK_EQUAL(order.size(), 4U);
+
+        // a function may sync and push on its own thread without waiting on itself
+        queue.Push([&] { queue.Sync(); queue.Push([&order] { order.push_back(5); }); order.push_back(4); });
+    }
+    // destruction ran what was still pending
+    BOOST_CHECK(order == (std::vector<int>{0, 1, 2, 3, 4, 5}));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -12,11 +12,14 @@
 #include <random.h>
 #include <serialize.h>
 #include <uint256.h>
+#include <util/thread.h>
 #include <util/vector.h>
 
 #include <cassert>
 #include <cstdlib>
+#include <exception>
 #include <iterator>
+#include <tuple>
 #include <utility>
 
 static constexpr uint8_t DB_COIN{'C'};
@@ -51,8 +54,16 @@ CCoinsViewDB::CCoinsViewDB(DBParams db_params, CoinsViewOptions options) :
     m_options{std::move(options)},
     m_db{std::make_unique<CDBWrapper>(m_db_params)} { }
 
+CCoinsViewDB::~CCoinsViewDB()
+{
+    LOCK(m_writer_mutex);
+    if (m_writer.joinable()) m_writer.join();
+}
+
 void CCoinsViewDB::ResizeCache(size_t new_cache_size)
 {
+    // SYSCOIN the writer thread uses the current handle
+    WaitForPendingWrite();
     // We can't do this operation with an in-memory DB since we'll lose all the coins upon
     // reset.
     if (!m_db_params.memory_only) {
@@ -66,14 +77,71 @@ void CCoinsViewDB::ResizeCache(size_t new_cache_size)
 }
 
 bool CCoinsViewDB::GetCoin(const COutPoint &outpoint, Coin &coin) const {
+    // SYSCOIN coins still being written in the background are newer than what is on disk
+    {
+        LOCK(m_pending_mutex);
+        if (m_pending) {
+            const auto it = m_pending->coins.find(outpoint);
+            if (it != m_pending->coins.end()) {
+                if (it->second.coin.IsSpent()) return false;
+                coin = it->second.coin;
+                return true;
+            }
+        }
+    }
     return m_db->Read(CoinEntry(&outpoint), coin);
 }
 
+std::vector<std::optional<Coin>> CCoinsViewDB::GetCoins(const std::vector<COutPoint>& outpoints) const
+{
+    std::vector<std::optional<Coin>> coins(outpoints.size());
+    std::vector<size_t> missing;
+    missing.reserve(outpoints.size());
+    {
+        LOCK(m_pending_mutex);
+        for (size_t i = 0; i < outpoints.size(); i++) {
+            if (m_pending) {
+                const auto it = m_pending->coins.find(outpoints[i]);
+                if (it != m_pending->coins.end()) {
+                    if (!it->second.coin.IsSpent()) coins[i] = it->second.coin;
+                    continue;
+                }
+            }
+            missing.push_back(i);
+        }
+    }
+    if (missing.empty()) return coins;
+    std::vector<CoinEntry> keys;
+    keys.reserve(missing.size());
+    for (const size_t i : missing) {
+        keys.emplace_back(&outpoints[i]);
+    }
+    std::vector<std::optional<Coin>> read;
+    m_db->ReadMany(keys, read);
+    for (size_t j = 0; j < missing.size(); j++) {
+        coins[missing[j]] = std::move(read[j]);
+    }
+    return coins;
+}
+
 bool CCoinsViewDB::HaveCoin(const COutPoint &outpoint) const {
+    // SYSCOIN
+    {
+        LOCK(m_pending_mutex);
+        if (m_pending) {
+            const auto it = m_pending->coins.find(outpoint);
+            if (it != m_pending->coins.end()) return !it->second.coin.IsSpent();
+        }
+    }
     return m_db->Exists(CoinEntry(&outpoint));
 }
 
 uint256 CCoinsViewDB::GetBestBlock() const {
+    // SYSCOIN
+    {
+        LOCK(m_pending_mutex);
+        if (m_pending) return m_pending->hashBlock;
+    }
     uint256 hashBestChain;
     if (!m_db->Read(DB_BEST_BLOCK, hashBestChain))
         return uint256();
@@ -89,12 +157,157 @@ std::vector<uint256> CCoinsViewDB::GetHeadBlocks() const {
 }
 
 bool CCoinsViewDB::BatchWrite(CCoinsMap &mapCoins, const uint256 &hashBlock, bool erase) {
+    // SYSCOIN batches have to reach the disk in order, so a previous background write lands first
+    LOCK(m_writer_mutex);
+    if (!WaitForPendingWrite()) return false;
+    if (m_writer.joinable()) m_writer.join();
+    if (!m_options.write_behind || !erase) {
+        return WriteCoins(mapCoins, hashBlock, erase);
+    }
+
+    // Move the dirty coins out of the caller's cache so it can be refilled right away, and write them
+    // from a background thread. Until they are committed GetCoin() serves them from the pending map.
+    auto pending = std::make_unique<PendingWrite>();
+    pending->hashBlock = hashBlock;
+    for (CCoinsMap::iterator it = mapCoins.begin(); it != mapCoins.end(); it = mapCoins.erase(it)) {
+        if (it->second.flags & CCoinsCacheEntry::DIRTY) {
+            pending->coins.emplace(std::piecewise_construct, std::forward_as_tuple(it->first),
+                                   std::forward_as_tuple(std::move(it->second.coin), CCoinsCacheEntry::DIRTY));
+        }
+    }
+    PendingWrite* write = pending.get();
+    {
+        LOCK(m_pending_mutex);
+        m_pending = std::move(pending);
+        m_writing = true;
+    }
+    m_writer = std::thread(&util::TraceThread, "coinsflush", [this, write] {
+        bool ret{false};
+        try {
+            ret = WriteCoins(write->coins, write->hashBlock, /*erase=*/false);
+        } catch (const std::exception& e) {
+            LogPrintLevel(BCLog::COINDB, BCLog::Level::Error, "Background write to coin database failed: %s\n", e.what());
+        }
+        // free the committed coins outside of the lock
+        std::unique_ptr<PendingWrite> done;
+        {
+            LOCK(m_pending_mutex);
+            if (ret) {
+                done = std::move(m_pending);
+            } else {
+                m_write_failed = true;
+            }
+            m_writing = false;
+        }
+        m_pending_cv.notify_all();
+    });
+    return true;
+}
+
+CCoinsViewPrefetch::CCoinsViewPrefetch(CCoinsViewDB& db, bool enabled) : CCoinsViewBacked(&db), m_db(db), m_enabled(enabled) {}
+
+CCoinsViewPrefetch::~CCoinsViewPrefetch()
+{
+    m_tasks.Stop();
+}
+
+void CCoinsViewPrefetch::Prefetch(std::vector<COutPoint> outpoints)
+{
+    if (!m_enabled || outpoints.empty()) return;
+    LOCK(m_mutex);
+    std::erase_if(m_futures, [](const std::future<void>& f) { return f.wait_for(std::chrono::seconds::zero()) == std::future_status::ready; });
+    // what is left over belongs to blocks connected or given up on by now
+    if (m_coins.size() >= MAX_PREFETCHED_COINS) m_coins.clear();
+    for (size_t begin = 0; begin < outpoints.size(); begin += COINS_PREFETCH_CHUNK) {
+        const size_t end{std::min(begin + COINS_PREFETCH_CHUNK, outpoints.size())};
+        std::vector<COutPoint> chunk(outpoints.begin() + begin, outpoints.begin() + end);
+        m_futures.emplace_back(m_tasks.push([this, generation = m_generation, chunk = std::move(chunk)](int) {
+            Fetch(chunk, generation);
+        }));
+    }
+}
+
+void CCoinsViewPrefetch::Fetch(const std::vector<COutPoint>& outpoints, uint64_t generation) const
+{
+    if (WITH_LOCK(m_mutex, return generation != m_generation)) return;
+    std::vector<std::optional<Coin>> coins;
+    try {
+        coins = m_db.GetCoins(outpoints);
+    } catch (const std::exception& e) {
+        // the read is retried by GetCoin(), where errors are handled
+        LogPrint(BCLog::COINDB, "Prefetching coins failed: %s\n", e.what());
+        return;
+    }
+    LOCK(m_mutex);
+    if (generation != m_generation) return;
+    for (size_t i = 0; i < outpoints.size(); ++i) {
+        if (coins[i]) m_coins.try_emplace(outpoints[i], std::move(*coins[i]));
+    }
+}
+
+void CCoinsViewPrefetch::WaitForPrefetches()
+{
+    std::vector<std::future<void>> futures{WITH_LOCK(m_mutex, return std::move(m_futures))};
+    for (auto& f : futures) {
+        f.wait();
+    }
+}
+
+bool CCoinsViewPrefetch::GetCoin(const COutPoint& outpoint, Coin& coin) const
+{
+    if (m_enabled) {
+        LOCK(m_mutex);
+        const auto it{m_coins.find(outpoint)};
+        if (it != m_coins.end()) {
+            coin = std::move(it->second);
+            m_coins.erase(it);
+            return true;
+        }
+    }
+    return base->GetCoin(outpoint, coin);
+}
+
+bool CCoinsViewPrefetch::HaveCoin(const COutPoint& outpoint) const
+{
+    if (m_enabled && WITH_LOCK(m_mutex, return m_coins.count(outpoint) > 0)) return true;
+    return base->HaveCoin(outpoint);
+}
+
+bool CCoinsViewPrefetch::BatchWrite(CCoinsMap& mapCoins, const uint256& hashBlock, bool erase)
+{
+    // the map is emptied by the write, so the coins it changes are noted first
+    std::vector<COutPoint> written;
+    if (WITH_LOCK(m_mutex, return !m_coins.empty() || !m_futures.empty())) {
+        for (const auto& [outpoint, entry] : mapCoins) {
+            if (entry.flags & CCoinsCacheEntry::DIRTY) written.push_back(outpoint);
+        }
+    }
+    const bool ret{base->BatchWrite(mapCoins, hashBlock, erase)};
+    LOCK(m_mutex);
+    ++m_generation;
+    for (const auto& outpoint : written) {
+        m_coins.erase(outpoint);
+    }
+    return ret;
+}
+
+bool CCoinsViewDB::WaitForPendingWrite() const
+{
+    WAIT_LOCK(m_pending_mutex, lock);
+    m_pending_cv.wait(lock, [this]() EXCLUSIVE_LOCKS_REQUIRED(m_pending_mutex) { return !m_writing; });
+    return !m_write_failed;
+}
+
+bool CCoinsViewDB::WriteCoins(CCoinsMap& mapCoins, const uint256& hashBlock, bool erase)
+{
     CDBBatch batch(*m_db);
     size_t count = 0;
     size_t changed = 0;
     assert(!hashBlock.IsNull());
 
-    uint256 old_tip = GetBestBlock();
+    // SYSCOIN read the tip from disk, GetBestBlock() already reports a pending write
+    uint256 old_tip;
+    m_db->Read(DB_BEST_BLOCK, old_tip);
     if (old_tip.IsNull()) {
         // We may be in the middle of replaying.
         std::vector<uint256> old_heads = GetHeadBlocks();
@@ -179,6 +392,8 @@ private:
 
 std::unique_ptr<CCoinsViewCursor> CCoinsViewDB::Cursor() const
 {
+    // SYSCOIN the cursor walks the database, so everything has to be on disk
+    WaitForPendingWrite();
     auto i = std::make_unique<CCoinsViewDBCursor>(
         const_cast<CDBWrapper&>(*m_db).NewIterator(), GetBestBlock());
     /* It seems that there are no "const iterators" for LevelDB.  Since we
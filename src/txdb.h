@@ -10,12 +10,17 @@
 #include <dbwrapper.h>
 #include <kernel/cs_main.h>
 #include <sync.h>
+#include <util/executor.h>
 #include <util/fs.h>
 
+#include <condition_variable>
 #include <cstddef>
 #include <cstdint>
+#include <future>
 #include <memory>
 #include <optional>
+#include <thread>
+#include <unordered_map>
 #include <vector>
 
 class COutPoint;
@@ -39,6 +44,15 @@ static const int64_t nMaxTxIndexCache = 1024;
 static const int64_t max_filter_index_cache = 1024;
 //! Max memory allocated to coin DB specific cache (MiB)
 static const int64_t nMaxCoinsDBCache = 8;
+// SYSCOIN
+//! -dbwritebehind default
+static constexpr bool DEFAULT_DB_WRITE_BEHIND{true};
+//! -coinsprefetch default
+static constexpr bool DEFAULT_COINS_PREFETCH{true};
+//! Prefetched coins kept at most, beyond that the unused ones are dropped before the next block is prefetched
+static constexpr size_t MAX_PREFETCHED_COINS{100000};
+//! Outpoints read by one prefetch task
+static constexpr size_t COINS_PREFETCH_CHUNK{256};
 
 //! User-controlled performance and debug options.
 struct CoinsViewOptions {
@@ -47,6 +61,11 @@ struct CoinsViewOptions {
     //! If non-zero, randomly exit when the database is flushed with (1/ratio)
     //! probability.
     int simulate_crash_ratio = 0;
+    // SYSCOIN
+    //! Write flushed coins from a background thread, see CCoinsViewDB::BatchWrite.
+    bool write_behind = false;
+    //! Read the inputs of incoming blocks ahead of time, see CCoinsViewPrefetch.
+    bool prefetch = false;
 };
 
 /** CCoinsView backed by the coin database (chainstate/) */
@@ -56,15 +75,40 @@ protected:
     DBParams m_db_params;
     CoinsViewOptions m_options;
     std::unique_ptr<CDBWrapper> m_db;
+
+    // SYSCOIN
+    /** Coins handed to the writer thread, served to readers until they are on disk */
+    struct PendingWrite {
+        CCoinsMapMemoryResource resource;
+        CCoinsMap coins{0, CCoinsMap::hasher{}, CCoinsMap::key_equal{}, &resource};
+        uint256 hashBlock;
+    };
+    mutable Mutex m_pending_mutex;
+    mutable std::condition_variable m_pending_cv;
+    std::unique_ptr<PendingWrite> m_pending GUARDED_BY(m_pending_mutex);
+    //! Set while the writer thread commits m_pending
+    bool m_writing GUARDED_BY(m_pending_mutex){false};
+    //! Set when a background write failed, the pending coins are kept so reads stay correct
+    bool m_write_failed GUARDED_BY(m_pending_mutex){false};
+    //! Only started and joined by BatchWrite() and the destructor, readers wait for m_writing instead
+    Mutex m_writer_mutex;
+    std::thread m_writer GUARDED_BY(m_writer_mutex);
+
+    bool WriteCoins(CCoinsMap& mapCoins, const uint256& hashBlock, bool erase);
+
 public:
     explicit CCoinsViewDB(DBParams db_params, CoinsViewOptions options);
+    ~CCoinsViewDB() override;
 
     bool GetCoin(const COutPoint &outpoint, Coin &coin) const override;
     bool HaveCoin(const COutPoint &outpoint) const override;
+    // SYSCOIN
+    //! The coins of many outpoints read at once through CDBWrapper::ReadMany, empty for spent or missing coins
+    std::vector<std::optional<Coin>> GetCoins(const std::vector<COutPoint>& outpoints) const EXCLUSIVE_LOCKS_REQUIRED(!m_pending_mutex);
     uint256 GetBestBlock() const override;
     std::vector<uint256> GetHeadBlocks() const override;
-    bool BatchWrite(CCoinsMap &mapCoins, const uint256 &hashBlock, bool erase = true) override;
-    std::unique_ptr<CCoinsViewCursor> Cursor() const override;
+    bool BatchWrite(CCoinsMap &mapCoins, const uint256 &hashBlock, bool erase = true) override EXCLUSIVE_LOCKS_REQUIRED(!m_writer_mutex, !m_pending_mutex);
+    std::unique_ptr<CCoinsViewCursor> Cursor() const override EXCLUSIVE_LOCKS_REQUIRED(!m_pending_mutex);
 
     //! Whether an unsupported database format is used.
     bool NeedsUpgrade();
@@ -73,8 +117,50 @@ public:
     //! Dynamically alter the underlying leveldb cache size.
     void ResizeCache(size_t new_cache_size) EXCLUSIVE_LOCKS_REQUIRED(cs_main);
 
+    // SYSCOIN
+    //! Wait until a write handed to the background thread is committed, false if it failed.
+    bool WaitForPendingWrite() const EXCLUSIVE_LOCKS_REQUIRED(!m_pending_mutex);
+
     //! @returns filesystem path to on-disk storage or std::nullopt if in memory.
     std::optional<fs::path> StoragePath() { return m_db->StoragePath(); }
 };
 
+// SYSCOIN
+/**
+ * Sits between the coin database and the coins cache. Prefetch() reads the inputs of a block that is about to
+ * be connected on the shared executor, so the cache misses of ConnectBlock find them in memory rather than
+ * reading them from disk one by one. GetCoin() hands a prefetched coin out once, the cache above keeps it from
+ * then on. A flush drops the prefetched coins it writes as well as the reads that overlapped it, so the coins
+ * left always match the database.
+ */
+class CCoinsViewPrefetch final : public CCoinsViewBacked
+{
+private:
+    CCoinsViewDB& m_db;
+    const bool m_enabled;
+    ExecutorTaskGroup m_tasks{Executor::Lane::VALIDATION};
+
+    mutable Mutex m_mutex;
+    mutable std::unordered_map<COutPoint, Coin, SaltedOutpointHasher> m_coins GUARDED_BY(m_mutex);
+    //! bumped by every flush, the reads started before it are dropped
+    uint64_t m_generation GUARDED_BY(m_mutex){0};
+    std::vector<std::future<void>> m_futures GUARDED_BY(m_mutex);
+
+    void Fetch(const std::vector<COutPoint>& outpoints, uint64_t generation) const EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+
+public:
+    CCoinsViewPrefetch(CCoinsViewDB& db, bool enabled);
+    ~CCoinsViewPrefetch() override;
+
+    /** Read these coins from the database in the background */
+    void Prefetch(std::vector<COutPoint> outpoints) EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+    /** Wait until the queued reads are done, nothing may prefetch meanwhile */
+    void WaitForPrefetches() EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+    size_t PrefetchedCount() const EXCLUSIVE_LOCKS_REQUIRED(!m_mutex) { return WITH_LOCK(m_mutex, return m_coins.size()); }
+
+    bool GetCoin(const COutPoint& outpoint, Coin& coin) const override EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+    bool HaveCoin(const COutPoint& outpoint) const override EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+    bool BatchWrite(CCoinsMap& mapCoins, const uint256& hashBlock, bool erase = true) override EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+};
+
 #endif // SYSCOIN_TXDB_H
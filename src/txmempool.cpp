@@ -29,10 +29,12 @@
 #include <evo/specialtx.h>
 #include <evo/providertx.h>
 #include <evo/deterministicmns.h>   
+#include <services/zdagconflicts.h>
+#include <metrics.h>
 extern bool EraseNEVMData(const NEVMDataVec&);
 extern NEVMMintTxSet setMintTxsMempool;
-extern std::unordered_map<COutPoint, std::pair<CTransactionRef, CTransactionRef>, SaltedOutpointHasher> mapAssetAllocationConflicts;
 
+#include <algorithm>
 #include <cmath>
 #include <numeric>
 #include <optional>
@@ -56,28 +58,73 @@ bool TestLockPointValidity(CChain& active_chain, const LockPoints& lp)
     return true;
 }
 
+// SYSCOIN
+/** Bytes of the PoDA blob a transaction carries, 0 for other transactions and ones relayed without their blob */
+static uint32_t GetPoDABlobSize(const CTransaction& tx)
+{
+    if (!tx.IsNEVMData()) return 0;
+    const int nOut = GetSyscoinDataOutput(tx);
+    if (nOut == -1 || !tx.vout[nOut].HasNEVMData()) return 0;
+    return tx.vout[nOut].GetNEVMData().size();
+}
+/** Fixed size key of mapProTxNEVMAddresses, non empty NEVM addresses are checked to be 20 bytes before they get here */
+static uint160 NEVMAddressKey(const std::vector<unsigned char>& vchNEVMAddress)
+{
+    uint160 key;
+    std::copy_n(vchNEVMAddress.begin(), std::min<size_t>(vchNEVMAddress.size(), key.size()), key.begin());
+    return key;
+}
+
+// SYSCOIN
+void CTxMemPool::UpdateFeeHistogram(const CTxMemPoolEntry& entry, bool add)
+{
+    AssertLockHeld(cs);
+    const CAmount nFeeRate{entry.GetFee() / std::max<int32_t>(entry.GetTxSize(), 1)};
+    const auto it{std::upper_bound(MEMPOOL_HISTOGRAM_FEERATES.begin(), MEMPOOL_HISTOGRAM_FEERATES.end(), nFeeRate)};
+    MempoolHistogramBucket& bucket{m_fee_histogram[std::max<ptrdiff_t>(it - MEMPOOL_HISTOGRAM_FEERATES.begin() - 1, 0)]};
+    const uint64_t nZDAGVSize{IsZdagTx(entry.GetTx().nVersion) ? uint64_t(entry.GetTxSize()) : 0};
+    if (add) {
+        bucket.nCount++;
+        bucket.nVSize += entry.GetTxSize();
+        bucket.nFees += entry.GetFee();
+        bucket.nZDAGVSize += nZDAGVSize;
+    } else {
+        bucket.nCount--;
+        bucket.nVSize -= entry.GetTxSize();
+        bucket.nFees -= entry.GetFee();
+        bucket.nZDAGVSize -= nZDAGVSize;
+    }
+}
+
 void CTxMemPool::UpdateForDescendants(txiter updateIt, cacheMap& cachedDescendants,
                                       const std::set<uint256>& setExclude, std::set<uint256>& descendants_to_remove)
 {
-    CTxMemPoolEntry::Children stageEntries, descendants;
-    stageEntries = updateIt->GetMemPoolChildrenConst();
-
-    while (!stageEntries.empty()) {
-        const CTxMemPoolEntry& descendant = *stageEntries.begin();
-        descendants.insert(descendant);
-        stageEntries.erase(descendant);
-        const CTxMemPoolEntry::Children& children = descendant.GetMemPoolChildrenConst();
-        for (const CTxMemPoolEntry& childEntry : children) {
-            cacheMap::iterator cacheIt = cachedDescendants.find(mapTx.iterator_to(childEntry));
-            if (cacheIt != cachedDescendants.end()) {
-                // We've already calculated this one, just add the entries for this set
-                // but don't traverse again.
-                for (txiter cacheEntry : cacheIt->second) {
-                    descendants.insert(*cacheEntry);
+    // SYSCOIN visited means found, only entries found by walking the children are walked further
+    std::vector<txiter> descendants;
+    {
+        WITH_FRESH_EPOCH(m_epoch);
+        std::vector<txiter>& stage{m_epoch_stage};
+        stage.clear();
+        for (const CTxMemPoolEntry& child : updateIt->GetMemPoolChildrenConst()) {
+            const txiter childIt{mapTx.iterator_to(child)};
+            if (!visited(childIt)) stage.push_back(childIt);
+        }
+        for (size_t i = 0; i < stage.size(); ++i) {
+            descendants.push_back(stage[i]);
+            const CTxMemPoolEntry::Children& children = stage[i]->GetMemPoolChildrenConst();
+            for (const CTxMemPoolEntry& childEntry : children) {
+                const txiter childIt{mapTx.iterator_to(childEntry)};
+                cacheMap::iterator cacheIt = cachedDescendants.find(childIt);
+                if (cacheIt != cachedDescendants.end()) {
+                    // We've already calculated this one, just add the entries for this set
+                    // but don't traverse again.
+                    for (txiter cacheEntry : cacheIt->second) {
+                        if (!visited(cacheEntry)) descendants.push_back(cacheEntry);
+                    }
+                } else if (!visited(childIt)) {
+                    // Schedule for later processing
+                    stage.push_back(childIt);
                 }
-            } else if (!descendants.count(childEntry)) {
-                // Schedule for later processing
-                stageEntries.insert(childEntry);
             }
         }
     }
@@ -86,7 +133,8 @@ void CTxMemPool::UpdateForDescendants(txiter updateIt, cacheMap& cachedDescendan
     int32_t modifySize = 0;
     CAmount modifyFee = 0;
     int64_t modifyCount = 0;
-    for (const CTxMemPoolEntry& descendant : descendants) {
+    for (const txiter descendantIt : descendants) {
+        const CTxMemPoolEntry& descendant = *descendantIt;
         if (!setExclude.count(descendant.GetTx().GetHash())) {
             modifySize += descendant.GetTxSize();
             modifyFee += descendant.GetModifiedFee();
@@ -110,6 +158,8 @@ void CTxMemPool::UpdateForDescendants(txiter updateIt, cacheMap& cachedDescendan
 void CTxMemPool::UpdateTransactionsFromBlock(const std::vector<uint256>& vHashesToUpdate)
 {
     AssertLockHeld(cs);
+    // SYSCOIN
+    BumpSnapshotVersion();
     // For each entry in vHashesToUpdate, store the set of in-mempool, but not
     // in-vHashesToUpdate transactions, so that we don't have to recalculate
     // descendants when we come across a previously seen entry.
@@ -169,14 +219,17 @@ util::Result<CTxMemPool::setEntries> CTxMemPool::CalculateAncestorsAndCheckLimit
     const Limits& limits) const
 {
     int64_t totalSizeWithAncestors = entry_size;
-    setEntries ancestors;
-
-    while (!staged_ancestors.empty()) {
-        const CTxMemPoolEntry& stage = staged_ancestors.begin()->get();
-        txiter stageit = mapTx.iterator_to(stage);
+    // SYSCOIN visited means staged, the stage holds the ancestors walked so far followed by the ones still to walk
+    WITH_FRESH_EPOCH(m_epoch);
+    std::vector<txiter>& stage{m_epoch_stage};
+    stage.clear();
+    for (const CTxMemPoolEntry& parent : staged_ancestors) {
+        const txiter parent_it{mapTx.iterator_to(parent)};
+        if (!visited(parent_it)) stage.push_back(parent_it);
+    }
 
-        ancestors.insert(stageit);
-        staged_ancestors.erase(stage);
+    for (size_t i = 0; i < stage.size(); ++i) {
+        const txiter stageit{stage[i]};
         totalSizeWithAncestors += stageit->GetTxSize();
 
         if (stageit->GetSizeWithDescendants() + entry_size > limits.descendant_size_vbytes) {
@@ -192,16 +245,16 @@ util::Result<CTxMemPool::setEntries> CTxMemPool::CalculateAncestorsAndCheckLimit
             txiter parent_it = mapTx.iterator_to(parent);
 
             // If this is a new ancestor, add it.
-            if (ancestors.count(parent_it) == 0) {
-                staged_ancestors.insert(parent);
+            if (!visited(parent_it)) {
+                stage.push_back(parent_it);
             }
-            if (staged_ancestors.size() + ancestors.size() + entry_count > static_cast<uint64_t>(limits.ancestor_count)) {
+            if (stage.size() + entry_count > static_cast<uint64_t>(limits.ancestor_count)) {
                 return util::Error{Untranslated(strprintf("too many unconfirmed ancestors [limit: %u]", limits.ancestor_count))};
             }
         }
     }
 
-    return ancestors;
+    return setEntries(stage.begin(), stage.end());
 }
 
 bool CTxMemPool::CheckPackageLimits(const Package& package,
@@ -412,6 +465,7 @@ CTxMemPool::CTxMemPool(const Options& opts)
     : m_check_ratio{opts.check_ratio},
       minerPolicyEstimator{opts.estimator},
       m_max_size_bytes{opts.max_size_bytes},
+      m_max_poda_size_bytes{opts.max_poda_size_bytes},
       m_expiry{opts.expiry},
       m_incremental_relay_feerate{opts.incremental_relay_feerate},
       m_min_relay_feerate{opts.min_relay_feerate},
@@ -483,6 +537,14 @@ void CTxMemPool::addUnchecked(const CTxMemPoolEntry &entry, setEntries &setAnces
     nTransactionsUpdated++;
     totalTxSize += entry.GetTxSize();
     m_total_fee += entry.GetFee();
+    // SYSCOIN
+    UpdateFeeHistogram(entry, /*add=*/true);
+    BumpSnapshotVersion();
+    // SYSCOIN
+    if (const uint32_t nBlobSize{GetPoDABlobSize(tx)}) {
+        totalPoDABlobSize += nBlobSize;
+        setPoDAByFeeRate.emplace(CFeeRate(entry.GetFee(), nBlobSize), tx.GetHash());
+    }
     if (minerPolicyEstimator) {
         minerPolicyEstimator->processTransaction(entry, validFeeEstimate);
     }
@@ -515,7 +577,7 @@ void CTxMemPool::addUnchecked(const CTxMemPoolEntry &entry, setEntries &setAnces
             mapProTxRefs.emplace(proTx.proTxHash, tx_hash);
             mapProTxAddresses.emplace(proTx.addr, tx_hash);
             if(!proTx.vchNEVMAddress.empty()) {
-                mapProTxNEVMAddresses.emplace(proTx.vchNEVMAddress, tx_hash);
+                mapProTxNEVMAddresses.emplace(NEVMAddressKey(proTx.vchNEVMAddress), tx_hash);
             }
         }
     } else if (tx.nVersion == SYSCOIN_TX_VERSION_MN_UPDATE_REGISTRAR) {
@@ -523,7 +585,7 @@ void CTxMemPool::addUnchecked(const CTxMemPoolEntry &entry, setEntries &setAnces
         if(GetTxPayload(tx, proTx)) {
             mapProTxRefs.emplace(proTx.proTxHash, tx_hash);
             mapProTxBlsPubKeyHashes.emplace(proTx.pubKeyOperator.GetHash(), tx_hash);
-            auto dmn = deterministicMNManager->GetListAtChainTip().GetMN(proTx.proTxHash);
+            auto dmn = deterministicMNManager->GetListAtChainTipPtr()->GetMN(proTx.proTxHash);
             if(dmn) {
                 newit->validForProTxKey = ::SerializeHash(dmn->pdmnState->pubKeyOperator);
                 if (dmn->pdmnState->pubKeyOperator != proTx.pubKeyOperator) {
@@ -535,7 +597,7 @@ void CTxMemPool::addUnchecked(const CTxMemPoolEntry &entry, setEntries &setAnces
         CProUpRevTx proTx;
         if(GetTxPayload(tx, proTx)) {
             mapProTxRefs.emplace(proTx.proTxHash, tx_hash);
-            auto dmn = deterministicMNManager->GetListAtChainTip().GetMN(proTx.proTxHash);
+            auto dmn = deterministicMNManager->GetListAtChainTipPtr()->GetMN(proTx.proTxHash);
             if(dmn) {
                 newit->validForProTxKey = ::SerializeHash(dmn->pdmnState->pubKeyOperator);
                 if (dmn->pdmnState->pubKeyOperator.Get() != CBLSPublicKey()) {
@@ -550,6 +612,8 @@ void CTxMemPool::addUnchecked(const CTxMemPoolEntry &entry, setEntries &setAnces
         entry.GetTxSize(),
         entry.GetFee()
     );
+    // SYSCOIN
+    UpdateMetrics();
 }
 
 void CTxMemPool::removeUnchecked(txiter it, MemPoolRemovalReason reason)
@@ -591,7 +655,15 @@ void CTxMemPool::removeUnchecked(txiter it, MemPoolRemovalReason reason)
 
     totalTxSize -= it->GetTxSize();
     m_total_fee -= it->GetFee();
+    // SYSCOIN
+    UpdateFeeHistogram(*it, /*add=*/false);
+    BumpSnapshotVersion();
     cachedInnerUsage -= it->DynamicMemoryUsage();
+    // SYSCOIN
+    if (const uint32_t nBlobSize{GetPoDABlobSize(it->GetTx())}) {
+        totalPoDABlobSize -= nBlobSize;
+        setPoDAByFeeRate.erase(std::make_pair(CFeeRate(it->GetFee(), nBlobSize), hash));
+    }
     // SYSCOIN deal with pro tx stuff first
     auto eraseProTxRef = [&](const uint256& proTxHash, const uint256& txHash) {
         LOCK2(cs_main, cs);
@@ -623,7 +695,7 @@ void CTxMemPool::removeUnchecked(txiter it, MemPoolRemovalReason reason)
             eraseProTxRef(proTx.proTxHash, tx_hash);
             mapProTxAddresses.erase(proTx.addr);
             if(!proTx.vchNEVMAddress.empty()) {
-                mapProTxNEVMAddresses.erase(proTx.vchNEVMAddress);
+                mapProTxNEVMAddresses.erase(NEVMAddressKey(proTx.vchNEVMAddress));
             }
         }
     } else if (it->GetTx().nVersion == SYSCOIN_TX_VERSION_MN_UPDATE_REGISTRAR) {
@@ -640,9 +712,9 @@ void CTxMemPool::removeUnchecked(txiter it, MemPoolRemovalReason reason)
     }
     // remove nevm tx from mempool structure
     if(IsSyscoinMintTx(it->GetTx().nVersion)) {
-        CMintSyscoin mintSyscoin(it->GetTx());
-        if(!mintSyscoin.IsNull())
-            setMintTxsMempool.erase(mintSyscoin.nTxHash);
+        const auto& mintSyscoin = it->GetTx().GetMintSyscoin();
+        if(mintSyscoin && !mintSyscoin->IsNull())
+            setMintTxsMempool.erase(mintSyscoin->nTxHash);
     }
     // completely remove data if we are expiring due to timeout or trimming mempool, any other and it may be block related where we keep around until chainlock eventually prune them
     else if(it->GetTx().IsNEVMData() && (reason == MemPoolRemovalReason::EXPIRY || reason == MemPoolRemovalReason::SIZELIMIT)) {
@@ -655,6 +727,21 @@ void CTxMemPool::removeUnchecked(txiter it, MemPoolRemovalReason reason)
     mapTx.erase(it);
     nTransactionsUpdated++;
     if (minerPolicyEstimator) {minerPolicyEstimator->removeTx(hash, false);}
+    // SYSCOIN
+    UpdateMetrics();
+}
+
+// SYSCOIN
+void CTxMemPool::UpdateMetrics() const
+{
+    static metrics::Gauge& transactions{metrics::GetGauge("syscoin_mempool_transactions", "Transactions in the mempool")};
+    static metrics::Gauge& bytes{metrics::GetGauge("syscoin_mempool_bytes", "Virtual size of the mempool transactions")};
+    static metrics::Gauge& usage{metrics::GetGauge("syscoin_mempool_usage_bytes", "Memory used by the mempool entries")};
+    static metrics::Gauge& poda_bytes{metrics::GetGauge("syscoin_mempool_poda_bytes", "Size of the PoDA blobs of the mempool transactions")};
+    transactions.Set(mapTx.size());
+    bytes.Set(totalTxSize);
+    usage.Set(cachedInnerUsage);
+    poda_bytes.Set(totalPoDABlobSize);
 }
 
 // Calculates descendants of entry that are not already in setDescendants, and adds to
@@ -665,26 +752,27 @@ void CTxMemPool::removeUnchecked(txiter it, MemPoolRemovalReason reason)
 // can save time by not iterating over those entries.
 void CTxMemPool::CalculateDescendants(txiter entryit, setEntries& setDescendants) const
 {
-    setEntries stage;
-    if (setDescendants.count(entryit) == 0) {
-        stage.insert(entryit);
-    }
+    if (setDescendants.count(entryit)) return;
+    // SYSCOIN the epoch dedups the walk, setDescendants only has to be looked at when it was handed in non empty
+    const bool fCheckSet{!setDescendants.empty()};
+    WITH_FRESH_EPOCH(m_epoch);
+    std::vector<txiter>& stage{m_epoch_stage};
+    stage.clear();
+    visited(entryit);
+    stage.push_back(entryit);
     // Traverse down the children of entry, only adding children that are not
     // accounted for in setDescendants already (because those children have either
     // already been walked, or will be walked in this iteration).
-    while (!stage.empty()) {
-        txiter it = *stage.begin();
-        setDescendants.insert(it);
-        stage.erase(it);
-
-        const CTxMemPoolEntry::Children& children = it->GetMemPoolChildrenConst();
+    for (size_t i = 0; i < stage.size(); ++i) {
+        const CTxMemPoolEntry::Children& children = stage[i]->GetMemPoolChildrenConst();
         for (const CTxMemPoolEntry& child : children) {
             txiter childiter = mapTx.iterator_to(child);
-            if (!setDescendants.count(childiter)) {
-                stage.insert(childiter);
+            if (!visited(childiter) && (!fCheckSet || !setDescendants.count(childiter))) {
+                stage.push_back(childiter);
             }
         }
     }
+    setDescendants.insert(stage.begin(), stage.end());
 }
 
 void CTxMemPool::removeRecursive(const CTransaction &origTx, MemPoolRemovalReason reason)
@@ -739,13 +827,7 @@ void CTxMemPool::removeForReorg(CChain& chain, std::function<bool(txiter)> check
 // SYSCOIN
 bool CTxMemPool::existsConflicts(const CTransaction &tx) const
 {
-    AssertLockHeld(cs_main);
-    AssertLockHeld(cs);
-    for (const CTxIn &txin : tx.vin) {
-        if(mapAssetAllocationConflicts.find(txin.prevout) != mapAssetAllocationConflicts.end())
-            return true;
-    }
-    return false;
+    return g_zdag_conflicts.Exists(tx);
 }
 
 void CTxMemPool::removeConflicts(const CTransaction &tx)
@@ -785,8 +867,10 @@ void CTxMemPool::removeConflicts(const CTransaction &tx)
 }
 void CTxMemPool::removeProTxNEVMKeyConflicts(const CTransaction &tx, const std::vector<unsigned char> &vchNEVMAddress)
 {
-    if (!vchNEVMAddress.empty() && mapProTxNEVMAddresses.count(vchNEVMAddress)) {
-        uint256 conflictHash = mapProTxNEVMAddresses[vchNEVMAddress];
+    if (vchNEVMAddress.empty()) return;
+    auto it = mapProTxNEVMAddresses.find(NEVMAddressKey(vchNEVMAddress));
+    if (it != mapProTxNEVMAddresses.end()) {
+        const uint256 conflictHash = it->second;
         if (conflictHash != tx.GetHash() && mapTx.count(conflictHash)) {
             removeRecursive(mapTx.find(conflictHash)->GetTx(), MemPoolRemovalReason::CONFLICT);
         }
@@ -799,42 +883,47 @@ void CTxMemPool::removeZDAGConflicts(const CTransaction &tx)
     // Remove conflicting zdag transactions which depend on inputs of tx, recursively
     AssertLockHeld(cs_main);
     AssertLockHeld(cs);
+    if (g_zdag_conflicts.Empty())
+        return;
     for (const CTxIn &txin : tx.vin) {
-        auto it = mapAssetAllocationConflicts.find(txin.prevout);
+        const auto conflict = g_zdag_conflicts.Get(txin.prevout);
         // remove the two transactions linked to this prevout in event of a conflict
-        if (it != mapAssetAllocationConflicts.end()) {
-            if(it->second.first) {
-                ClearPrioritisation(it->second.first->GetHash());
-                removeRecursive(*it->second.first, MemPoolRemovalReason::CONFLICT);
-            }
-            if(it->second.second) {
-                ClearPrioritisation(it->second.second->GetHash());
-                removeRecursive(*it->second.second, MemPoolRemovalReason::CONFLICT);
+        if (conflict) {
+            for (const CTransactionRef& txConflict : {conflict->first, conflict->second}) {
+                if(!txConflict)
+                    continue;
+                // the spend that lost to tx in a block will never confirm
+                if(*txConflict != tx && exists(GenTxid::Txid(txConflict->GetHash())))
+                    GetMainSignals().NotifyZDAGStatus(txConflict->GetHash(), ZDAG_MAJOR_CONFLICT);
+                ClearPrioritisation(txConflict->GetHash());
+                removeRecursive(*txConflict, MemPoolRemovalReason::CONFLICT);
             }
-        } 
+            // the prevout is spent by tx now, no other transaction can conflict on it
+            g_zdag_conflicts.Erase(txin.prevout);
+        }
     }
 }
 
 // true if other tx (conflicting) was first in mempool and it was involved in asset double spend
 bool CTxMemPool::isSyscoinConflictIsFirstSeen(const CTransaction &tx) const {
     AssertLockHeld(cs);
-    if(mapAssetAllocationConflicts.empty())
+    if(g_zdag_conflicts.Empty())
         return true;
     for (const CTxIn &txin : tx.vin) {
-        auto it = mapAssetAllocationConflicts.find(txin.prevout);
-        // ensure that we check for mapAssetAllocationConflicts intersection of this input
+        const auto conflict = g_zdag_conflicts.Get(txin.prevout);
+        // ensure that we check for g_zdag_conflicts intersection of this input
         // the only time conflicts are allowed and would cause problems for zdag is when its double spent without RBF
         // we allow one double spend input to be propagated and here we ensure we are only dealing with skipping transactions based on time
         // if it is one of those transactions that propagated double spent input related to syscoin asset tx
-        if (it != mapAssetAllocationConflicts.end()) {
+        if (conflict) {
             txiter thisit, conflictit;
-            txiter firstit = mapTx.find(it->second.first->GetHash());
+            txiter firstit = mapTx.find(conflict->first->GetHash());
             thisit = mapTx.end();
             if(firstit != mapTx.end()){
                 if(firstit->GetTx() == tx)
                     thisit = firstit;
             }
-            txiter secondit = mapTx.find(it->second.second->GetHash());
+            txiter secondit = mapTx.find(conflict->second->GetHash());
             if(secondit != mapTx.end()){
                 if(secondit->GetTx() == tx) {
                     thisit = secondit;
@@ -938,7 +1027,8 @@ void CTxMemPool::removeProTxSpentCollateralConflicts(const CTransaction &tx)
             }
         }
     };
-    auto mnList = deterministicMNManager->GetListAtChainTip();
+    const auto mnListPtr = deterministicMNManager->GetListAtChainTipPtr();
+    const auto& mnList = *mnListPtr;
     for (const auto& in : tx.vin) {
         auto collateralIt = mapProTxCollaterals.find(in.prevout);
         if (collateralIt != mapProTxCollaterals.end()) {
@@ -1056,9 +1146,9 @@ void CTxMemPool::removeForBlock(const std::vector<CTransactionRef>& vtx, unsigne
             stage.insert(it);
             RemoveStaged(stage, true, MemPoolRemovalReason::BLOCK);
         }
-        removeConflicts(*tx);
-        // SYSCOIN
+        // SYSCOIN the losing ZDAG spend is still in the pool here, so its status can be published
         removeZDAGConflicts(*tx);
+        removeConflicts(*tx);
         removeProTxConflicts(*tx);
         ClearPrioritisation(tx->GetHash());
     }
@@ -1080,6 +1170,8 @@ void CTxMemPool::check(const CCoinsViewCache& active_coins_tip, int64_t spendhei
     CAmount check_total_fee{0};
     uint64_t innerUsage = 0;
     uint64_t prev_ancestor_count{0};
+    // SYSCOIN
+    uint64_t check_poda_blob_size{0};
 
     CCoinsViewCache mempoolDuplicate(const_cast<CCoinsViewCache*>(&active_coins_tip));
 
@@ -1088,17 +1180,14 @@ void CTxMemPool::check(const CCoinsViewCache& active_coins_tip, int64_t spendhei
         check_total_fee += it->GetFee();
         innerUsage += it->DynamicMemoryUsage();
         const CTransaction& tx = it->GetTx();
+        // SYSCOIN
+        check_poda_blob_size += GetPoDABlobSize(tx);
         innerUsage += memusage::DynamicUsage(it->GetMemPoolParentsConst()) + memusage::DynamicUsage(it->GetMemPoolChildrenConst());
         CTxMemPoolEntry::Parents setParentCheck;
         // SYSCOIN
         bool bFoundConflict = false;
         bool bAssetAllocationTX = IsAssetAllocationTx(tx.nVersion);
-        for (const CTxIn &txin : tx.vin) {
-            if(mapAssetAllocationConflicts.find(txin.prevout) != mapAssetAllocationConflicts.end()) {
-                bFoundConflict = true;
-                break;
-            }
-        }
+        bFoundConflict = g_zdag_conflicts.Exists(tx);
         for (const CTxIn &txin : tx.vin) {
             // Check that every mempool transaction's inputs refer to available coins, or other mempool tx's.
             indexed_transaction_set::const_iterator it2 = mapTx.find(txin.prevout.hash);
@@ -1118,11 +1207,11 @@ void CTxMemPool::check(const CCoinsViewCache& active_coins_tip, int64_t spendhei
             // SYSCOIN
             if(bFoundConflict) {
                 assert(*it3->first == txin.prevout);
-                auto itzdagconflict = mapAssetAllocationConflicts.find(txin.prevout);
+                const auto zdagconflict = g_zdag_conflicts.Get(txin.prevout);
                 // does dbl-spend conflict exist, we don't have enough info to check tx otherwise if no conflict
-                if(itzdagconflict != mapAssetAllocationConflicts.end()) {
+                if(zdagconflict) {
                     // the tx must be one of the dbl-spend conflicts
-                    assert((itzdagconflict->second.first && *itzdagconflict->second.first == tx) || (itzdagconflict->second.second && *itzdagconflict->second.second == tx));
+                    assert((zdagconflict->first && *zdagconflict->first == tx) || (zdagconflict->second && *zdagconflict->second == tx));
                 }
             } else {
                 assert(it3->first == &txin.prevout);
@@ -1196,7 +1285,18 @@ void CTxMemPool::check(const CCoinsViewCache& active_coins_tip, int64_t spendhei
 
     assert(totalTxSize == checkTotal);
     assert(m_total_fee == check_total_fee);
+    // SYSCOIN
+    uint64_t histogram_vsize{0};
+    CAmount histogram_fees{0};
+    for (const MempoolHistogramBucket& bucket : m_fee_histogram) {
+        histogram_vsize += bucket.nVSize;
+        histogram_fees += bucket.nFees;
+    }
+    assert(histogram_vsize == totalTxSize);
+    assert(histogram_fees == m_total_fee);
     assert(innerUsage == cachedInnerUsage);
+    // SYSCOIN
+    assert(check_poda_blob_size == totalPoDABlobSize);
 }
 
 bool CTxMemPool::CompareDepthAndScore(const uint256& hasha, const uint256& hashb, bool wtxid)
@@ -1262,6 +1362,68 @@ void CTxMemPool::queryHashes(std::vector<uint256>& vtxid) const
     }
 }
 
+// SYSCOIN
+std::shared_ptr<const MempoolSnapshot> CTxMemPool::BuildSnapshot() const
+{
+    AssertLockHeld(cs);
+    auto snapshot{std::make_shared<MempoolSnapshot>()};
+    snapshot->nVersion = m_snapshot_version.load();
+    snapshot->nSequence = m_sequence_number;
+    const auto iters{GetSortedDepthAndScore()};
+    snapshot->vEntries.reserve(iters.size());
+    snapshot->mapIndex.reserve(iters.size());
+    for (const auto& it : iters) {
+        const CTransaction& tx = it->GetTx();
+        MempoolEntrySnapshot& entry = snapshot->vEntries.emplace_back();
+        entry.tx = it->GetSharedTx();
+        entry.wtxid = tx.GetWitnessHash();
+        entry.nVSize = it->GetTxSize();
+        entry.nWeight = it->GetTxWeight();
+        entry.nTime = it->GetTime();
+        entry.nHeight = it->GetHeight();
+        entry.nFee = it->GetFee();
+        entry.nModifiedFee = it->GetModifiedFee();
+        entry.nCountWithDescendants = it->GetCountWithDescendants();
+        entry.nSizeWithDescendants = it->GetSizeWithDescendants();
+        entry.nModFeesWithDescendants = it->GetModFeesWithDescendants();
+        entry.nCountWithAncestors = it->GetCountWithAncestors();
+        entry.nSizeWithAncestors = it->GetSizeWithAncestors();
+        entry.nModFeesWithAncestors = it->GetModFeesWithAncestors();
+        // a replaceable ancestor makes the entry replaceable, parents are copied before their children
+        entry.fBIP125Replaceable = SignalsOptInRBF(tx);
+        for (const CTxMemPoolEntry& parent : it->GetMemPoolParentsConst()) {
+            entry.vDepends.emplace_back(parent.GetTx().GetHash());
+            if (const MempoolEntrySnapshot* parent_entry{snapshot->Find(entry.vDepends.back())}) {
+                entry.fBIP125Replaceable |= parent_entry->fBIP125Replaceable;
+            }
+        }
+        for (const CTxMemPoolEntry& child : it->GetMemPoolChildrenConst()) {
+            entry.vSpentBy.emplace_back(child.GetTx().GetHash());
+        }
+        entry.fUnbroadcast = m_unbroadcast_txids.count(tx.GetHash()) != 0;
+        snapshot->mapIndex.emplace(tx.GetHash(), snapshot->vEntries.size() - 1);
+    }
+    return snapshot;
+}
+
+std::shared_ptr<const MempoolSnapshot> CTxMemPool::GetSnapshot() const
+{
+    {
+        LOCK(m_snapshot_mutex);
+        if (m_snapshot && m_snapshot->nVersion == m_snapshot_version.load()) return m_snapshot;
+    }
+    LOCK(cs);
+    {
+        // another reader may have published the current snapshot while this one waited for cs
+        LOCK(m_snapshot_mutex);
+        if (m_snapshot && m_snapshot->nVersion == m_snapshot_version.load()) return m_snapshot;
+    }
+    auto snapshot{BuildSnapshot()};
+    LOCK(m_snapshot_mutex);
+    m_snapshot = snapshot;
+    return snapshot;
+}
+
 static TxMempoolInfo GetInfo(CTxMemPool::indexed_transaction_set::const_iterator it) {
     return TxMempoolInfo{it->GetSharedTx(), it->GetTime(), it->GetFee(), it->GetTxSize(), it->GetModifiedFee() - it->GetFee()};
 }
@@ -1351,7 +1513,7 @@ bool CTxMemPool::existsProviderTxConflict(const CTransaction &tx) const {
         }
         if(!proTx.vchNEVMAddress.empty()) {
             // Check NEVM address uniqueness
-            if (mapProTxNEVMAddresses.count(proTx.vchNEVMAddress)) {
+            if (mapProTxNEVMAddresses.count(NEVMAddressKey(proTx.vchNEVMAddress))) {
                 LogPrint(BCLog::MEMPOOL, "%s: ERROR: Duplicate NEVM address, tx: %s\n", __func__, tx_hash.ToString());
                 return true;
             }
@@ -1363,7 +1525,7 @@ bool CTxMemPool::existsProviderTxConflict(const CTransaction &tx) const {
             return true;
         }
     
-        auto dmn = deterministicMNManager->GetListAtChainTip().GetMN(proTx.proTxHash);
+        auto dmn = deterministicMNManager->GetListAtChainTipPtr()->GetMN(proTx.proTxHash);
         if (!dmn) {
             LogPrint(BCLog::MEMPOOL, "%s: ERROR: Masternode is not in the list, proTxHash: %s\n", __func__, proTx.proTxHash.ToString());
             return true;
@@ -1389,7 +1551,7 @@ bool CTxMemPool::existsProviderTxConflict(const CTransaction &tx) const {
         }
 
         // this method should only be called with validated ProTxs
-        auto dmn = deterministicMNManager->GetListAtChainTip().GetMN(proTx.proTxHash);
+        auto dmn = deterministicMNManager->GetListAtChainTipPtr()->GetMN(proTx.proTxHash);
         if (!dmn) {
             LogPrint(BCLog::MEMPOOL, "%s: ERROR: Masternode is not in the list, proTxHash: %s\n", __func__, proTx.proTxHash.ToString());
             return true; // i.e. failed to find validated ProTx == conflict
@@ -1437,6 +1599,8 @@ void CTxMemPool::PrioritiseTransaction(const uint256& hash, const CAmount& nFeeD
                 mapTx.modify(descendantIt, [=](CTxMemPoolEntry& e){ e.UpdateAncestorState(0, nFeeDelta, 0, 0); });
             }
             ++nTransactionsUpdated;
+            // SYSCOIN
+            BumpSnapshotVersion();
         }
         if (delta == 0) {
             mapDeltas.erase(hash);
@@ -1577,6 +1741,8 @@ void CTxMemPool::RemoveUnbroadcastTx(const uint256& txid, const bool unchecked)
 
     if (m_unbroadcast_txids.erase(txid))
     {
+        // SYSCOIN
+        BumpSnapshotVersion();
         LogPrint(BCLog::MEMPOOL, "Removed %i from set of unbroadcast txns%s\n", txid.GetHex(), (unchecked ? " before confirmation that txn was sent out" : ""));
     }
 }
@@ -1708,6 +1874,40 @@ void CTxMemPool::TrimToSize(size_t sizelimit, std::vector<COutPoint>* pvNoSpends
         LogPrint(BCLog::MEMPOOL, "Removed %u txn, rolling minimum fee bumped to %s\n", nTxnRemoved, maxFeeRateRemoved.ToString());
     }
 }
+// SYSCOIN
+void CTxMemPool::TrimPoDAToSize(size_t sizelimit, std::vector<COutPoint>* pvNoSpendsRemaining) {
+    AssertLockHeld(cs);
+
+    unsigned nTxnRemoved = 0;
+    const uint64_t nBlobBytesBefore = totalPoDABlobSize;
+    while (!setPoDAByFeeRate.empty() && totalPoDABlobSize > sizelimit) {
+        const txiter it = mapTx.find(setPoDAByFeeRate.begin()->second);
+        setEntries stage;
+        CalculateDescendants(it, stage);
+        nTxnRemoved += stage.size();
+
+        std::vector<CTransaction> txn;
+        if (pvNoSpendsRemaining) {
+            txn.reserve(stage.size());
+            for (txiter iter : stage)
+                txn.push_back(iter->GetTx());
+        }
+        // SIZELIMIT makes removeUnchecked erase the blobs from the NEVM data cache
+        RemoveStaged(stage, false, MemPoolRemovalReason::SIZELIMIT);
+        if (pvNoSpendsRemaining) {
+            for (const CTransaction& tx : txn) {
+                for (const CTxIn& txin : tx.vin) {
+                    if (exists(GenTxid::Txid(txin.prevout.hash))) continue;
+                    pvNoSpendsRemaining->push_back(txin.prevout);
+                }
+            }
+        }
+    }
+
+    if (nTxnRemoved > 0) {
+        LogPrint(BCLog::MEMPOOL, "Removed %u txn carrying %u PoDA blob bytes, blob data was over the %u byte limit\n", nTxnRemoved, nBlobBytesBefore - totalPoDABlobSize, sizelimit);
+    }
+}
 
 
 uint64_t CTxMemPool::CalculateDescendantMaximum(txiter entry) const {
@@ -28,6 +28,7 @@
 #include <boost/multi_index/ordered_index.hpp>
 #include <boost/multi_index/sequenced_index.hpp>
 #include <netaddress.h>     // SYSCOIN
+#include <saltedhasher.h>   // SYSCOIN
 #include <boost/multi_index/tag.hpp>
 #include <boost/multi_index_container.hpp>
 
@@ -38,18 +39,80 @@ class CBlockIndex;
 class CChain;
 class Chainstate;
 
+#include <array>
 #include <atomic>
 #include <map>
+#include <memory>
 #include <optional>
 #include <set>
 #include <string>
 #include <string_view>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
 /** Fake height value used in Coin to signify they are only in the memory pool (since 0.8) */
 static const uint32_t MEMPOOL_HEIGHT = 0x7FFFFFFF;
 
+// SYSCOIN
+/** Lower bounds in sat/vB of the buckets of the mempool feerate histogram, the last bucket is open ended */
+static constexpr std::array<CAmount, 46> MEMPOOL_HISTOGRAM_FEERATES{
+    0, 1, 2, 3, 4, 5, 6, 7, 8, 10, 12, 14, 17, 20, 25, 30, 40, 50, 60, 70, 80, 100, 120, 140, 170, 200, 250,
+    300, 400, 500, 600, 700, 800, 1000, 1200, 1400, 1700, 2000, 2500, 3000, 4000, 5000, 6000, 7000, 8000, 10000};
+
+/** One bucket of the mempool feerate histogram, by base fee so an entry always leaves the bucket it was added to */
+struct MempoolHistogramBucket {
+    uint64_t nCount{0};
+    uint64_t nVSize{0};
+    CAmount nFees{0};
+    //! part of nVSize spent by ZDAG transactions, a double spent one is counted along with its conflict since both stay in the mempool until one confirms
+    uint64_t nZDAGVSize{0};
+};
+using MempoolFeeHistogram = std::array<MempoolHistogramBucket, MEMPOOL_HISTOGRAM_FEERATES.size()>;
+
+/** Metadata of one mempool entry as of a MempoolSnapshot */
+struct MempoolEntrySnapshot {
+    CTransactionRef tx;
+    uint256 wtxid;
+    int32_t nVSize{0};
+    int32_t nWeight{0};
+    std::chrono::seconds nTime{0};
+    unsigned int nHeight{0};
+    CAmount nFee{0};
+    CAmount nModifiedFee{0};
+    uint64_t nCountWithDescendants{0};
+    int64_t nSizeWithDescendants{0};
+    CAmount nModFeesWithDescendants{0};
+    uint64_t nCountWithAncestors{0};
+    int64_t nSizeWithAncestors{0};
+    CAmount nModFeesWithAncestors{0};
+    //! in mempool parents and children
+    std::vector<uint256> vDepends;
+    std::vector<uint256> vSpentBy;
+    bool fBIP125Replaceable{false};
+    bool fUnbroadcast{false};
+};
+
+/**
+ * Immutable copy of the mempool entry metadata. Readers share it without holding the mempool
+ * lock, a changed mempool publishes a new copy instead of modifying this one.
+ */
+struct MempoolSnapshot {
+    //! CTxMemPool change counter the snapshot was taken at
+    uint64_t nVersion{0};
+    //! mempool sequence as reported by getrawmempool
+    uint64_t nSequence{0};
+    //! sorted by depth and score, parents come before their children
+    std::vector<MempoolEntrySnapshot> vEntries;
+    std::unordered_map<uint256, size_t, SaltedTxidHasher> mapIndex;
+
+    const MempoolEntrySnapshot* Find(const uint256& txid) const
+    {
+        auto it = mapIndex.find(txid);
+        return it == mapIndex.end() ? nullptr : &vEntries[it->second];
+    }
+};
+
 /**
  * Test whether the LockPoints height and time are still valid on the current chain
  */
@@ -313,6 +376,17 @@ protected:
 
     uint64_t totalTxSize GUARDED_BY(cs){0};      //!< sum of all mempool tx's virtual sizes. Differs from serialized tx size since witness data is discounted. Defined in BIP 141.
     CAmount m_total_fee GUARDED_BY(cs){0};       //!< sum of all mempool tx's fees (NOT modified fee)
+    // SYSCOIN
+    MempoolFeeHistogram m_fee_histogram GUARDED_BY(cs){}; //!< kept up to date by addUnchecked() and removeUnchecked()
+    void UpdateFeeHistogram(const CTxMemPoolEntry& entry, bool add) EXCLUSIVE_LOCKS_REQUIRED(cs);
+    //! bumped under cs by every change a MempoolSnapshot reflects, read without cs by GetSnapshot()
+    std::atomic<uint64_t> m_snapshot_version{1};
+    mutable Mutex m_snapshot_mutex;
+    mutable std::shared_ptr<const MempoolSnapshot> m_snapshot GUARDED_BY(m_snapshot_mutex);
+    void BumpSnapshotVersion() EXCLUSIVE_LOCKS_REQUIRED(cs) { ++m_snapshot_version; }
+    /** Publish the size of the mempool to the -metricsbind gauges */
+    void UpdateMetrics() const EXCLUSIVE_LOCKS_REQUIRED(cs);
+    std::shared_ptr<const MempoolSnapshot> BuildSnapshot() const EXCLUSIVE_LOCKS_REQUIRED(cs);
     uint64_t cachedInnerUsage GUARDED_BY(cs){0}; //!< sum of dynamic memory usage of all the map elements (NOT the maps themselves)
 
     mutable int64_t lastRollingFeeUpdate GUARDED_BY(cs){GetTime()};
@@ -328,6 +402,10 @@ protected:
     void trackPackageRemoved(const CFeeRate& rate) EXCLUSIVE_LOCKS_REQUIRED(cs);
 
     bool m_load_tried GUARDED_BY(cs){false};
+    // SYSCOIN
+    uint64_t totalPoDABlobSize GUARDED_BY(cs){0}; //!< sum of the PoDA blob bytes carried by mempool txs, counted against m_max_poda_size_bytes
+    //! PoDA txs by fee per blob byte, the front is evicted first when the blob budget is exceeded
+    std::set<std::pair<CFeeRate, uint256>> setPoDAByFeeRate GUARDED_BY(cs);
 
     CFeeRate GetMinFee(size_t sizelimit) const;
 
@@ -428,12 +506,13 @@ private:
      */
     std::set<uint256> m_unbroadcast_txids GUARDED_BY(cs);
     // SYSCOIN
-    std::multimap<uint256, uint256> mapProTxRefs; // proTxHash -> transaction (all TXs that refer to an existing proTx)
-    std::map<CService, uint256> mapProTxAddresses;
-    std::map<std::vector<unsigned char>, uint256> mapProTxNEVMAddresses;
-    std::map<CKeyID, uint256> mapProTxPubKeyIDs;
-    std::map<uint256, uint256> mapProTxBlsPubKeyHashes;
-    std::map<COutPoint, uint256> mapProTxCollaterals;
+    // conflict indexes are only ever looked up by key, so they are salted hash maps
+    std::unordered_multimap<uint256, uint256, StaticSaltedHasher> mapProTxRefs; // proTxHash -> transaction (all TXs that refer to an existing proTx)
+    std::unordered_map<CService, uint256, CServiceHash> mapProTxAddresses;
+    std::unordered_map<uint160, uint256, StaticSaltedHasher> mapProTxNEVMAddresses; // keyed by the 20 byte NEVM address
+    std::unordered_map<uint160, uint256, StaticSaltedHasher> mapProTxPubKeyIDs; // keyed by CKeyID
+    std::unordered_map<uint256, uint256, StaticSaltedHasher> mapProTxBlsPubKeyHashes;
+    std::unordered_map<COutPoint, uint256, SaltedOutpointHasher> mapProTxCollaterals;
 
 
     /**
@@ -451,7 +530,7 @@ private:
                                                               size_t entry_count,
                                                               CTxMemPoolEntry::Parents &staged_ancestors,
                                                               const Limits& limits
-                                                              ) const EXCLUSIVE_LOCKS_REQUIRED(cs);
+                                                              ) const EXCLUSIVE_LOCKS_REQUIRED(cs) LOCKS_EXCLUDED(m_epoch);
 
 public:
     indirectmap<COutPoint, const CTransaction*> mapNextTx GUARDED_BY(cs);
@@ -460,6 +539,8 @@ public:
     using Options = kernel::MemPoolOptions;
 
     const int64_t m_max_size_bytes;
+    // SYSCOIN
+    const int64_t m_max_poda_size_bytes;
     const std::chrono::seconds m_expiry;
     const CFeeRate m_incremental_relay_feerate;
     const CFeeRate m_min_relay_feerate;
@@ -504,7 +585,8 @@ public:
     void removeProTxSpentCollateralConflicts(const CTransaction &tx) EXCLUSIVE_LOCKS_REQUIRED(cs, cs_main);
     void removeProTxKeyChangedConflicts(const CTransaction &tx, const uint256& proTxHash, const uint256& newKeyHash) EXCLUSIVE_LOCKS_REQUIRED(cs, cs_main);
     void removeProTxConflicts(const CTransaction &tx) EXCLUSIVE_LOCKS_REQUIRED(cs, cs_main);
-    bool existsConflicts(const CTransaction& tx) const EXCLUSIVE_LOCKS_REQUIRED(cs, cs_main);
+    /** Whether any input of tx is double spent by a ZDAG transaction, takes no mempool lock */
+    bool existsConflicts(const CTransaction& tx) const;
     bool isSyscoinConflictIsFirstSeen(const CTransaction &tx) const EXCLUSIVE_LOCKS_REQUIRED(cs);
     void removeZDAGConflicts(const CTransaction& tx) EXCLUSIVE_LOCKS_REQUIRED(cs, cs_main);
     /** After reorg, filter the entries that would no longer be valid in the next block, and update
@@ -649,7 +731,7 @@ public:
     /** Populate setDescendants with all in-mempool descendants of hash.
      *  Assumes that setDescendants includes all in-mempool descendants of anything
      *  already in it.  */
-    void CalculateDescendants(txiter it, setEntries& setDescendants) const EXCLUSIVE_LOCKS_REQUIRED(cs);
+    void CalculateDescendants(txiter it, setEntries& setDescendants) const EXCLUSIVE_LOCKS_REQUIRED(cs) LOCKS_EXCLUDED(m_epoch);
 
     /** The minimum fee to get into the mempool, which may itself not be enough
      *  for larger-sized transactions.
@@ -666,6 +748,12 @@ public:
       *  which are not in mempool which no longer have any spends in this mempool.
       */
     void TrimToSize(size_t sizelimit, std::vector<COutPoint>* pvNoSpendsRemaining = nullptr) EXCLUSIVE_LOCKS_REQUIRED(cs);
+    // SYSCOIN
+    /** Remove PoDA transactions (and their descendants) with the lowest fee per blob byte until the
+      *  blob bytes in the mempool are <= sizelimit. The blobs of the removed transactions are erased
+      *  from the NEVM data cache as well. pvNoSpendsRemaining is populated as in TrimToSize.
+      */
+    void TrimPoDAToSize(size_t sizelimit, std::vector<COutPoint>* pvNoSpendsRemaining = nullptr) EXCLUSIVE_LOCKS_REQUIRED(cs);
 
     /** Expire all transaction (and their dependencies) in the mempool older than time. Return the number of removed transactions. */
     int Expire(std::chrono::seconds time) EXCLUSIVE_LOCKS_REQUIRED(cs);
@@ -707,6 +795,23 @@ public:
         AssertLockHeld(cs);
         return m_total_fee;
     }
+    // SYSCOIN
+    /**
+     * Copy of the entry metadata as of the last change to the mempool. It is only built by the
+     * first reader after a change, every other reader gets it without taking cs.
+     */
+    std::shared_ptr<const MempoolSnapshot> GetSnapshot() const LOCKS_EXCLUDED(m_snapshot_mutex);
+    const MempoolFeeHistogram& GetFeeHistogram() const EXCLUSIVE_LOCKS_REQUIRED(cs)
+    {
+        AssertLockHeld(cs);
+        return m_fee_histogram;
+    }
+    // SYSCOIN
+    uint64_t GetTotalPoDABlobSize() const EXCLUSIVE_LOCKS_REQUIRED(cs)
+    {
+        AssertLockHeld(cs);
+        return totalPoDABlobSize;
+    }
 
     bool exists(const GenTxid& gtxid) const
     {
@@ -739,7 +844,8 @@ public:
         LOCK(cs);
         // Sanity check the transaction is in the mempool & insert into
         // unbroadcast set.
-        if (exists(GenTxid::Txid(txid))) m_unbroadcast_txids.insert(txid);
+        // SYSCOIN
+        if (exists(GenTxid::Txid(txid)) && m_unbroadcast_txids.insert(txid).second) BumpSnapshotVersion();
     };
 
     /** Removes a transaction from the unbroadcast set */
@@ -769,6 +875,11 @@ public:
     }
 
 private:
+    // SYSCOIN
+    /** Work queue of the epoch based ancestor and descendant walks, kept to reuse its allocation.
+     *  Only used while m_epoch is held, so walks can't overlap. */
+    mutable std::vector<txiter> m_epoch_stage GUARDED_BY(cs);
+
     /** UpdateForDescendants is used by UpdateTransactionsFromBlock to update
      *  the descendants for a single transaction that has been added to the
      *  mempool but may have child transactions in the mempool, eg during a
@@ -798,7 +909,7 @@ private:
      *     removeRecursive them.
      */
     void UpdateForDescendants(txiter updateIt, cacheMap& cachedDescendants,
-                              const std::set<uint256>& setExclude, std::set<uint256>& descendants_to_remove) EXCLUSIVE_LOCKS_REQUIRED(cs);
+                              const std::set<uint256>& setExclude, std::set<uint256>& descendants_to_remove) EXCLUSIVE_LOCKS_REQUIRED(cs) LOCKS_EXCLUDED(m_epoch);
     /** Update ancestors of hash to add/remove it as a descendant transaction. */
     void UpdateAncestorsOf(bool add, txiter hash, setEntries &setAncestors) EXCLUSIVE_LOCKS_REQUIRED(cs);
     /** Set ancestor state for an entry */
@@ -7,6 +7,7 @@
 #include <consensus/validation.h>
 #include <logging.h>
 #include <policy/policy.h>
+#include <version.h>
 
 #include <cassert>
 
@@ -39,8 +40,17 @@ bool TxOrphanage::AddTx(const CTransactionRef& tx, NodeId peer)
         return false;
     }
 
-    auto ret = m_orphans.emplace(hash, OrphanTx{tx, peer, GetTime() + ORPHAN_TX_EXPIRE_TIME, m_orphan_list.size()});
+    // SYSCOIN the weight scales PoDA blobs down, they are held in memory at full size
+    const size_t usage{::GetSerializeSize(*tx, PROTOCOL_VERSION, SER_NETWORK)};
+    if (usage > MAX_ORPHAN_USAGE_PER_PEER) {
+        LogPrint(BCLog::TXPACKAGES, "ignoring large orphan tx (usage: %u, txid: %s, wtxid: %s)\n", usage, hash.ToString(), wtxid.ToString());
+        return false;
+    }
+
+    auto ret = m_orphans.emplace(hash, OrphanTx{tx, peer, GetTime() + ORPHAN_TX_EXPIRE_TIME, m_orphan_list.size(), usage});
     assert(ret.second);
+    m_total_usage += usage;
+    m_peer_usage[peer] += usage;
     m_orphan_list.push_back(ret.first);
     // Allow for lookups in the orphan pool by wtxid, as well as txid
     m_wtxid_to_orphan_it.emplace(tx->GetWitnessHash(), ret.first);
@@ -48,8 +58,8 @@ bool TxOrphanage::AddTx(const CTransactionRef& tx, NodeId peer)
         m_outpoint_to_orphan_it[txin.prevout].insert(ret.first);
     }
 
-    LogPrint(BCLog::TXPACKAGES, "stored orphan tx %s (wtxid=%s) (mapsz %u outsz %u)\n", hash.ToString(), wtxid.ToString(),
-             m_orphans.size(), m_outpoint_to_orphan_it.size());
+    LogPrint(BCLog::TXPACKAGES, "stored orphan tx %s (wtxid=%s) (mapsz %u outsz %u usage %u)\n", hash.ToString(), wtxid.ToString(),
+             m_orphans.size(), m_outpoint_to_orphan_it.size(), m_total_usage);
     return true;
 }
 
@@ -88,6 +98,12 @@ int TxOrphanage::EraseTxNoLock(const uint256& txid)
     LogPrint(BCLog::TXPACKAGES, "   removed orphan tx %s (wtxid=%s)\n", txid.ToString(), wtxid.ToString());
     m_orphan_list.pop_back();
     m_wtxid_to_orphan_it.erase(it->second.tx->GetWitnessHash());
+    // SYSCOIN
+    m_total_usage -= it->second.usage;
+    auto peer_usage_it = m_peer_usage.find(it->second.fromPeer);
+    assert(peer_usage_it != m_peer_usage.end() && peer_usage_it->second >= it->second.usage);
+    peer_usage_it->second -= it->second.usage;
+    if (peer_usage_it->second == 0) m_peer_usage.erase(peer_usage_it);
 
     m_orphans.erase(it);
     return 1;
@@ -112,7 +128,19 @@ void TxOrphanage::EraseForPeer(NodeId peer)
     if (nErased > 0) LogPrint(BCLog::TXPACKAGES, "Erased %d orphan tx from peer=%d\n", nErased, peer);
 }
 
-void TxOrphanage::LimitOrphans(unsigned int max_orphans)
+// SYSCOIN
+void TxOrphanage::EvictFromPeerNoLock(NodeId peer, FastRandomContext& rng)
+{
+    AssertLockHeld(m_mutex);
+    std::vector<uint256> peer_orphans;
+    for (const auto& it : m_orphan_list) {
+        if (it->second.fromPeer == peer) peer_orphans.push_back(it->first);
+    }
+    assert(!peer_orphans.empty());
+    EraseTxNoLock(peer_orphans[rng.randrange(peer_orphans.size())]);
+}
+
+void TxOrphanage::LimitOrphans(unsigned int max_orphans, size_t max_usage)
 {
     LOCK(m_mutex);
 
@@ -138,6 +166,21 @@ void TxOrphanage::LimitOrphans(unsigned int max_orphans)
         if (nErased > 0) LogPrint(BCLog::TXPACKAGES, "Erased %d orphan tx due to expiration\n", nErased);
     }
     FastRandomContext rng;
+    // SYSCOIN a peer filling the orphanage with blob transactions only pushes out its own orphans
+    for (auto it = m_peer_usage.begin(); it != m_peer_usage.end();) {
+        const NodeId peer{it->first};
+        ++it;
+        while (m_peer_usage.count(peer) && m_peer_usage.at(peer) > MAX_ORPHAN_USAGE_PER_PEER) {
+            EvictFromPeerNoLock(peer, rng);
+            ++nEvicted;
+        }
+    }
+    while (m_total_usage > max_usage) {
+        const auto heaviest = std::max_element(m_peer_usage.begin(), m_peer_usage.end(),
+            [](const auto& a, const auto& b) { return a.second < b.second; });
+        EvictFromPeerNoLock(heaviest->first, rng);
+        ++nEvicted;
+    }
     while (m_orphans.size() > max_orphans)
     {
         // Evict a random orphan:
@@ -169,6 +212,13 @@ void TxOrphanage::AddChildrenToWorkSet(const CTransaction& tx)
     }
 }
 
+size_t TxOrphanage::PeerUsage(NodeId peer)
+{
+    LOCK(m_mutex);
+    auto it = m_peer_usage.find(peer);
+    return it == m_peer_usage.end() ? 0 : it->second;
+}
+
 bool TxOrphanage::HaveTx(const GenTxid& gtxid) const
 {
     LOCK(m_mutex);
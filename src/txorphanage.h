@@ -8,11 +8,16 @@
 #include <net.h>
 #include <primitives/block.h>
 #include <primitives/transaction.h>
+#include <random.h>
 #include <sync.h>
 
 #include <map>
 #include <set>
 
+// SYSCOIN
+/** Maximum memory the orphans of a single peer may use, enough for one orphan carrying a full PoDA blob */
+static constexpr size_t MAX_ORPHAN_USAGE_PER_PEER{2 * MAX_NEVM_DATA_BLOB};
+
 /** A class to track orphan transactions (failed on TX_MISSING_INPUTS)
  * Since we cannot distinguish orphans from bad transactions with
  * non-existent inputs, we heavily limit the number of orphans
@@ -42,8 +47,10 @@ public:
     /** Erase all orphans included in or invalidated by a new block */
     void EraseForBlock(const CBlock& block) EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
 
-    /** Limit the orphanage to the given maximum */
-    void LimitOrphans(unsigned int max_orphans) EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+    /** Limit the orphanage to the given maximum count and, SYSCOIN counting the full size of the PoDA blobs
+     *  they carry, to the given maximum memory. Peers over MAX_ORPHAN_USAGE_PER_PEER, and under memory pressure
+     *  the peer using the most, have their own orphans evicted first. */
+    void LimitOrphans(unsigned int max_orphans, size_t max_usage) EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
 
     /** Add any orphans that list a particular tx as a parent into the from peer's work set */
     void AddChildrenToWorkSet(const CTransaction& tx) EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);;
@@ -58,6 +65,17 @@ public:
         return m_orphans.size();
     }
 
+    // SYSCOIN
+    /** Return the memory used by the orphans, PoDA blobs included */
+    size_t TotalUsage() EXCLUSIVE_LOCKS_REQUIRED(!m_mutex)
+    {
+        LOCK(m_mutex);
+        return m_total_usage;
+    }
+
+    /** Return the memory used by the orphans a peer provided */
+    size_t PeerUsage(NodeId peer) EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+
 protected:
     /** Guards orphan transactions */
     mutable Mutex m_mutex;
@@ -67,6 +85,8 @@ protected:
         NodeId fromPeer;
         int64_t nTimeExpire;
         size_t list_pos;
+        // SYSCOIN serialized size with the PoDA blobs at full size
+        size_t usage;
     };
 
     /** Map from txid to orphan transaction record. Limited by
@@ -98,6 +118,14 @@ protected:
      *  transactions using their witness ids. */
     std::map<uint256, OrphanMap::iterator> m_wtxid_to_orphan_it GUARDED_BY(m_mutex);
 
+    // SYSCOIN
+    /** Memory used by all orphans, and by the orphans of each peer that has any */
+    size_t m_total_usage GUARDED_BY(m_mutex){0};
+    std::map<NodeId, size_t> m_peer_usage GUARDED_BY(m_mutex);
+
+    /** Evict a random orphan provided by the given peer */
+    void EvictFromPeerNoLock(NodeId peer, FastRandomContext& rng) EXCLUSIVE_LOCKS_REQUIRED(m_mutex);
+
     /** Erase an orphan by txid */
     int EraseTxNoLock(const uint256& txid) EXCLUSIVE_LOCKS_REQUIRED(m_mutex);
 };
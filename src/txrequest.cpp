@@ -64,6 +64,8 @@ struct Announcement {
     // SYSCOIN
     /* The inventory type to track TX vs Other (MN inv) */
     const uint32_t m_type;
+    /** The announced size of the transaction, 0 if unknown. */
+    const uint32_t m_size_hint;
     /** For CANDIDATE_{DELAYED,BEST,READY} the reqtime; for REQUESTED the expiry. */
     std::chrono::microseconds m_time;
     /** What peer the request was from. */
@@ -104,12 +106,16 @@ struct Announcement {
         return GetState() == State::CANDIDATE_READY || GetState() == State::CANDIDATE_BEST;
     }
 
+    // SYSCOIN
+    /** Whether the announced transaction is large enough to be scheduled after the small ones. */
+    bool IsLarge() const { return m_size_hint >= TX_SIZE_HINT_LARGE; }
+
     /** Construct a new announcement from scratch, initially in CANDIDATE_DELAYED state. */
     Announcement(const GenTxid& gtxid, NodeId peer, bool preferred, std::chrono::microseconds reqtime,
-        SequenceNumber sequence) :
+        SequenceNumber sequence, uint32_t size_hint) :
         // SYSCOIN
-        m_txhash(gtxid.GetHash()), m_type(gtxid.GetType()), m_time(reqtime), m_peer(peer), m_sequence(sequence), m_preferred(preferred),
-        m_is_wtxid(gtxid.IsWtxid()), m_state(static_cast<uint8_t>(State::CANDIDATE_DELAYED)) {}
+        m_txhash(gtxid.GetHash()), m_type(gtxid.GetType()), m_size_hint(size_hint), m_time(reqtime), m_peer(peer), m_sequence(sequence),
+        m_preferred(preferred), m_is_wtxid(gtxid.IsWtxid()), m_state(static_cast<uint8_t>(State::CANDIDATE_DELAYED)) {}
 };
 
 //! Type alias for priorities.
@@ -241,6 +247,8 @@ struct PeerInfo {
     size_t m_total = 0; //!< Total number of announcements for this peer.
     size_t m_completed = 0; //!< Number of COMPLETED announcements for this peer.
     size_t m_requested = 0; //!< Number of REQUESTED announcements for this peer.
+    // SYSCOIN
+    size_t m_requested_large = 0; //!< Number of REQUESTED announcements with a large size hint for this peer.
 };
 
 /** Per-txhash statistics object. Only used for sanity checking. */
@@ -265,8 +273,8 @@ struct TxHashInfo
 /** Compare two PeerInfo objects. Only used for sanity checking. */
 bool operator==(const PeerInfo& a, const PeerInfo& b)
 {
-    return std::tie(a.m_total, a.m_completed, a.m_requested) ==
-           std::tie(b.m_total, b.m_completed, b.m_requested);
+    return std::tie(a.m_total, a.m_completed, a.m_requested, a.m_requested_large) ==
+           std::tie(b.m_total, b.m_completed, b.m_requested, b.m_requested_large);
 };
 
 /** (Re)compute the PeerInfo map from the index. Only used for sanity checking. */
@@ -278,6 +286,7 @@ std::unordered_map<NodeId, PeerInfo> RecomputePeerInfo(const Index& index)
         ++info.m_total;
         info.m_requested += (ann.GetState() == State::REQUESTED);
         info.m_completed += (ann.GetState() == State::COMPLETED);
+        info.m_requested_large += (ann.GetState() == State::REQUESTED && ann.IsLarge());
     }
     return ret;
 }
@@ -387,6 +396,7 @@ private:
         auto peerit = m_peerinfo.find(it->m_peer);
         peerit->second.m_completed -= it->GetState() == State::COMPLETED;
         peerit->second.m_requested -= it->GetState() == State::REQUESTED;
+        peerit->second.m_requested_large -= it->GetState() == State::REQUESTED && it->IsLarge();
         if (--peerit->second.m_total == 0) m_peerinfo.erase(peerit);
         return m_index.get<Tag>().erase(it);
     }
@@ -398,9 +408,11 @@ private:
         auto peerit = m_peerinfo.find(it->m_peer);
         peerit->second.m_completed -= it->GetState() == State::COMPLETED;
         peerit->second.m_requested -= it->GetState() == State::REQUESTED;
+        peerit->second.m_requested_large -= it->GetState() == State::REQUESTED && it->IsLarge();
         m_index.get<Tag>().modify(it, std::move(modifier));
         peerit->second.m_completed += it->GetState() == State::COMPLETED;
         peerit->second.m_requested += it->GetState() == State::REQUESTED;
+        peerit->second.m_requested_large += it->GetState() == State::REQUESTED && it->IsLarge();
     }
 
     //! Convert a CANDIDATE_DELAYED announcement into a CANDIDATE_READY. If this makes it the new best
@@ -583,7 +595,7 @@ public:
     }
 
     void ReceivedInv(NodeId peer, const GenTxid& gtxid, bool preferred,
-        std::chrono::microseconds reqtime)
+        std::chrono::microseconds reqtime, uint32_t size_hint)
     {
         // Bail out if we already have a CANDIDATE_BEST announcement for this (txhash, peer) combination. The case
         // where there is a non-CANDIDATE_BEST announcement already will be caught by the uniqueness property of the
@@ -593,7 +605,7 @@ public:
         // Try creating the announcement with CANDIDATE_DELAYED state (which will fail due to the uniqueness
         // of the ByPeer index if a non-CANDIDATE_BEST announcement already exists with the same txhash and peer).
         // Bail out in that case.
-        auto ret = m_index.get<ByPeer>().emplace(gtxid, peer, preferred, reqtime, m_current_sequence);
+        auto ret = m_index.get<ByPeer>().emplace(gtxid, peer, preferred, reqtime, m_current_sequence, size_hint);
         if (!ret.second) return;
 
         // Update accounting metadata.
@@ -617,9 +629,9 @@ public:
             ++it_peer;
         }
 
-        // Sort by sequence number.
+        // Sort by sequence number, SYSCOIN with the large announcements after the small ones.
         std::sort(selected.begin(), selected.end(), [](const Announcement* a, const Announcement* b) {
-            return a->m_sequence < b->m_sequence;
+            return std::make_pair(a->IsLarge(), a->m_sequence) < std::make_pair(b->IsLarge(), b->m_sequence);
         });
 
         // Convert to GenTxid and return.
@@ -693,6 +705,14 @@ public:
         return 0;
     }
 
+    // SYSCOIN
+    size_t CountLargeInFlight(NodeId peer) const
+    {
+        auto it = m_peerinfo.find(peer);
+        if (it != m_peerinfo.end()) return it->second.m_requested_large;
+        return 0;
+    }
+
     size_t CountCandidates(NodeId peer) const
     {
         auto it = m_peerinfo.find(peer);
@@ -726,6 +746,8 @@ TxRequestTracker::~TxRequestTracker() = default;
 void TxRequestTracker::ForgetTxHash(const uint256& txhash) { m_impl->ForgetTxHash(txhash); }
 void TxRequestTracker::DisconnectedPeer(NodeId peer) { m_impl->DisconnectedPeer(peer); }
 size_t TxRequestTracker::CountInFlight(NodeId peer) const { return m_impl->CountInFlight(peer); }
+// SYSCOIN
+size_t TxRequestTracker::CountLargeInFlight(NodeId peer) const { return m_impl->CountLargeInFlight(peer); }
 size_t TxRequestTracker::CountCandidates(NodeId peer) const { return m_impl->CountCandidates(peer); }
 size_t TxRequestTracker::Count(NodeId peer) const { return m_impl->Count(peer); }
 size_t TxRequestTracker::Size() const { return m_impl->Size(); }
@@ -737,9 +759,9 @@ void TxRequestTracker::PostGetRequestableSanityCheck(std::chrono::microseconds n
 }
 
 void TxRequestTracker::ReceivedInv(NodeId peer, const GenTxid& gtxid, bool preferred,
-    std::chrono::microseconds reqtime)
+    std::chrono::microseconds reqtime, uint32_t size_hint)
 {
-    m_impl->ReceivedInv(peer, gtxid, preferred, reqtime);
+    m_impl->ReceivedInv(peer, gtxid, preferred, reqtime, size_hint);
 }
 
 void TxRequestTracker::RequestedTx(NodeId peer, const uint256& txhash, std::chrono::microseconds expiry)
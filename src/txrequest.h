@@ -14,6 +14,10 @@
 
 #include <stdint.h>
 
+// SYSCOIN
+/** Announced size from which a transaction download is scheduled as large (PoDA blob transactions) */
+static constexpr uint32_t TX_SIZE_HINT_LARGE{100000};
+
 /** Data structure to keep track of, and schedule, transaction downloads from peers.
  *
  * === Specification ===
@@ -126,10 +130,11 @@ public:
      * is added for a wtxid H, while one for txid H from the same peer already exists, it will be ignored. This is
      * harmless as the txhashes being equal implies it is a non-segwit transaction, so it doesn't matter how it is
      * fetched. The new announcement is given the specified preferred and reqtime values, and takes its is_wtxid
-     * from the specified gtxid.
+     * from the specified gtxid. SYSCOIN size_hint is the announced size of the transaction, 0 when unknown, and
+     * marks announcements of at least TX_SIZE_HINT_LARGE bytes (PoDA blob transactions) as large.
      */
     void ReceivedInv(NodeId peer, const GenTxid& gtxid, bool preferred,
-        std::chrono::microseconds reqtime);
+        std::chrono::microseconds reqtime, uint32_t size_hint = 0);
 
     /** Deletes all announcements for a given peer.
      *
@@ -158,7 +163,8 @@ public:
      *    announcement order (even if multiple were added at the same time, or when the clock went backwards while
      *    they were being added). This is done to minimize disruption from dependent transactions being requested
      *    out of order: if multiple dependent transactions are announced simultaneously by one peer, and end up
-     *    being requested from them, the requests will happen in announcement order.
+     *    being requested from them, the requests will happen in announcement order. SYSCOIN large announcements
+     *    are returned after all small ones, so a blob transaction does not hold up the urgent ones behind it.
      */
     std::vector<GenTxid> GetRequestable(NodeId peer, std::chrono::microseconds now,
         std::vector<std::pair<NodeId, GenTxid>>* expired = nullptr);
@@ -186,6 +192,10 @@ public:
     /** Count how many REQUESTED announcements a peer has. */
     size_t CountInFlight(NodeId peer) const;
 
+    // SYSCOIN
+    /** Count how many REQUESTED announcements with a large size hint a peer has. */
+    size_t CountLargeInFlight(NodeId peer) const;
+
     /** Count how many CANDIDATE announcements a peer has. */
     size_t CountCandidates(NodeId peer) const;
 
@@ -14,6 +14,7 @@
 #include <cstring>
 #include <stdint.h>
 #include <string>
+#include <type_traits>
 // SYSCOIN
 #include <crypto/common.h>
 /** Template base class for fixed-sized opaque blobs. */
@@ -51,10 +52,41 @@ public:
         std::fill(m_data.begin(), m_data.end(), 0);
     }
 
-    constexpr int Compare(const base_blob& other) const { return std::memcmp(m_data.data(), other.m_data.data(), WIDTH); }
+    // SYSCOIN blobs of whole 64-bit words are compared a word at a time, big endian so the order is that of memcmp
+    constexpr int Compare(const base_blob& other) const
+    {
+        if constexpr (WIDTH % 8 == 0) {
+            if (!std::is_constant_evaluated()) {
+                for (int i = 0; i < WIDTH; i += 8) {
+                    const uint64_t a{ReadBE64(m_data.data() + i)}, b{ReadBE64(other.m_data.data() + i)};
+                    if (a != b) return a < b ? -1 : 1;
+                }
+                return 0;
+            }
+        }
+        return std::memcmp(m_data.data(), other.m_data.data(), WIDTH);
+    }
+
+    // SYSCOIN without a branch per word, which compilers turn into vector compares
+    constexpr bool Equals(const base_blob& other) const
+    {
+        if constexpr (WIDTH % 8 == 0) {
+            if (!std::is_constant_evaluated()) {
+                uint64_t diff{0};
+                for (int i = 0; i < WIDTH; i += 8) {
+                    uint64_t a, b;
+                    std::memcpy(&a, m_data.data() + i, 8);
+                    std::memcpy(&b, other.m_data.data() + i, 8);
+                    diff |= a ^ b;
+                }
+                return diff == 0;
+            }
+        }
+        return Compare(other) == 0;
+    }
 
-    friend constexpr bool operator==(const base_blob& a, const base_blob& b) { return a.Compare(b) == 0; }
-    friend constexpr bool operator!=(const base_blob& a, const base_blob& b) { return a.Compare(b) != 0; }
+    friend constexpr bool operator==(const base_blob& a, const base_blob& b) { return a.Equals(b); }
+    friend constexpr bool operator!=(const base_blob& a, const base_blob& b) { return !a.Equals(b); }
     friend constexpr bool operator<(const base_blob& a, const base_blob& b) { return a.Compare(b) < 0; }
 
     std::string GetHex() const;
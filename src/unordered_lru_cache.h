@@ -5,50 +5,67 @@
 #ifndef SYSCOIN_UNORDERED_LRU_CACHE_H
 #define SYSCOIN_UNORDERED_LRU_CACHE_H
 
-#include <algorithm>
+#include <memusage.h>
+
 #include <cassert>
 #include <cstdint>
+#include <list>
 #include <unordered_map>
-#include <vector>
+#include <utility>
 
-template<typename Key, typename Value, typename Hasher, size_t MaxSize = 0, size_t TruncateThreshold = 0>
+// SYSCOIN entries are kept on a list ordered by last access, most recent first. Touching an entry
+// moves it to the front and inserting past maxSize drops the back one, both in constant time
+template<typename Key, typename Value, typename Hasher, size_t MaxSize = 0>
 class unordered_lru_cache
 {
 private:
-    typedef std::unordered_map<Key, std::pair<Value, int64_t>, Hasher> MapType;
+    typedef std::list<Key> ListType;
+    typedef std::unordered_map<Key, std::pair<Value, typename ListType::iterator>, Hasher> MapType;
 
     MapType cacheMap;
+    ListType accessList;
     size_t maxSize;
-    size_t truncateThreshold;
-    int64_t accessCounter{0};
 
 public:
-    explicit unordered_lru_cache(size_t _maxSize = MaxSize, size_t _truncateThreshold = TruncateThreshold) :
-        maxSize(_maxSize),
-        truncateThreshold(_truncateThreshold == 0 ? _maxSize * 2 : _truncateThreshold)
+    explicit unordered_lru_cache(size_t _maxSize = MaxSize) :
+        maxSize(_maxSize)
     {
         // either specify maxSize through template arguments or the constructor and fail otherwise
         assert(_maxSize != 0);
     }
 
     size_t max_size() const { return maxSize; }
+    size_t size() const { return cacheMap.size(); }
+    size_t DynamicMemoryUsage() const { return memusage::DynamicUsage(cacheMap) + memusage::DynamicUsage(accessList); }
+
+    template<typename Callable>
+    void for_each(Callable&& func) const
+    {
+        for (const auto& [key, value] : cacheMap) {
+            func(key, value.first);
+        }
+    }
 
     template<typename Value2>
     void _emplace(const Key& key, Value2&& v)
     {
-        truncate_if_needed();
         auto it = cacheMap.find(key);
         if (it == cacheMap.end()) {
-            cacheMap.emplace(key, std::make_pair(std::forward<Value2>(v), accessCounter++));
+            accessList.push_front(key);
+            cacheMap.emplace(key, std::make_pair(std::forward<Value2>(v), accessList.begin()));
+            if (cacheMap.size() > maxSize) {
+                cacheMap.erase(accessList.back());
+                accessList.pop_back();
+            }
         } else {
             it->second.first = std::forward<Value2>(v);
-            it->second.second = accessCounter++;
+            touch(it);
         }
     }
 
     void emplace(const Key& key, Value&& v)
     {
-        _emplace(key, v);
+        _emplace(key, std::move(v));
     }
 
     void insert(const Key& key, const Value& v)
@@ -58,57 +75,48 @@ public:
 
     bool get(const Key& key, Value& value)
     {
-        auto it = cacheMap.find(key);
-        if (it != cacheMap.end()) {
-            it->second.second = accessCounter++;
-            value = it->second.first;
+        if (const Value* p = get(key)) {
+            value = *p;
             return true;
         }
         return false;
     }
 
-    bool exists(const Key& key)
+    /** Pointer to the cached value, or nullptr. Valid until the cache is modified. */
+    const Value* get(const Key& key)
     {
         auto it = cacheMap.find(key);
-        if (it != cacheMap.end()) {
-            it->second.second = accessCounter++;
-            return true;
+        if (it == cacheMap.end()) {
+            return nullptr;
         }
-        return false;
+        touch(it);
+        return &it->second.first;
+    }
+
+    bool exists(const Key& key)
+    {
+        return get(key) != nullptr;
     }
 
     void erase(const Key& key)
     {
-        cacheMap.erase(key);
+        auto it = cacheMap.find(key);
+        if (it != cacheMap.end()) {
+            accessList.erase(it->second.second);
+            cacheMap.erase(it);
+        }
     }
 
     void clear()
     {
         cacheMap.clear();
+        accessList.clear();
     }
 
 private:
-    void truncate_if_needed()
+    void touch(typename MapType::iterator it)
     {
-        typedef typename MapType::iterator Iterator;
-
-        if (cacheMap.size() <= truncateThreshold) {
-            return;
-        }
-
-        std::vector<Iterator> vec;
-        vec.reserve(cacheMap.size());
-        for (auto it = cacheMap.begin(); it != cacheMap.end(); ++it) {
-            vec.emplace_back(it);
-        }
-        // sort by last access time (descending order)
-        std::sort(vec.begin(), vec.end(), [](const Iterator& it1, const Iterator& it2) {
-            return it1->second.second > it2->second.second;
-        });
-
-        for (size_t i = maxSize; i < vec.size(); i++) {
-            cacheMap.erase(vec[i]);
-        }
+        accessList.splice(accessList.begin(), accessList, it->second.second);
     }
 };
 
@@ -0,0 +1,217 @@
+// Copyright (c) 2024 The Syscoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <util/executor.h>
+
+#include <tinyformat.h>
+#include <util/thread.h>
+
+#include <algorithm>
+#include <cassert>
+
+namespace {
+//! the executor and worker index of the current thread, if it is a worker
+thread_local const Executor* t_executor{nullptr};
+thread_local size_t t_worker{0};
+
+GlobalMutex g_shared_executor_mutex;
+std::unique_ptr<Executor> g_shared_executor GUARDED_BY(g_shared_executor_mutex);
+
+int DefaultExecutorThreads()
+{
+    // leave a core to the message handler and the validation threads
+    return std::clamp(static_cast<int>(std::thread::hardware_concurrency()) - 1, 2, 16);
+}
+} // namespace
+
+Executor::Executor(int threads) : m_start{std::chrono::steady_clock::now()}
+{
+    assert(threads > 0);
+    for (int n = 0; n < threads; ++n) {
+        m_workers.push_back(std::make_unique<Worker>());
+    }
+    for (size_t n = 0; n < m_workers.size(); ++n) {
+        m_threads.emplace_back(&util::TraceThread, strprintf("exec.%i", n), [this, n] { ThreadWorker(n); });
+    }
+}
+
+Executor::~Executor()
+{
+    WITH_LOCK(m_mutex, m_stop = true);
+    m_cv.notify_all();
+    for (std::thread& thread : m_threads) {
+        thread.join();
+    }
+}
+
+std::string Executor::LaneName(Lane lane)
+{
+    switch (lane) {
+    case Lane::VALIDATION: return "validation";
+    case Lane::LLMQ: return "llmq";
+    case Lane::BACKGROUND: return "background";
+    } // no default case, so the compiler can warn about missing cases
+    assert(false);
+}
+
+void Executor::Submit(Lane lane, std::function<void(int)> task)
+{
+    const size_t l{static_cast<size_t>(lane)};
+    ++m_counters[l].submitted;
+    ++m_counters[l].queued;
+    if (t_executor == this) {
+        Worker& worker = *m_workers[t_worker];
+        WITH_LOCK(worker.m_mutex, worker.m_lanes[l].push_back(std::move(task)));
+        ++m_pending;
+        // a worker about to sleep checks m_pending under m_mutex, so taking it here cannot lose the wakeup
+        { LOCK(m_mutex); }
+    } else {
+        LOCK(m_mutex);
+        m_injected[l].push_back(std::move(task));
+        ++m_pending;
+    }
+    m_cv.notify_one();
+}
+
+bool Executor::TakeTask(size_t self, std::function<void(int)>& task, Lane& lane)
+{
+    for (size_t l = 0; l < LANE_COUNT; ++l) {
+        {
+            // own work first, newest first as its data is likely still in cache
+            Worker& worker = *m_workers[self];
+            LOCK(worker.m_mutex);
+            auto& deque = worker.m_lanes[l];
+            if (!deque.empty()) {
+                task = std::move(deque.back());
+                deque.pop_back();
+                lane = static_cast<Lane>(l);
+                return true;
+            }
+        }
+        {
+            LOCK(m_mutex);
+            auto& deque = m_injected[l];
+            if (!deque.empty()) {
+                task = std::move(deque.front());
+                deque.pop_front();
+                lane = static_cast<Lane>(l);
+                return true;
+            }
+        }
+        // steal the oldest work of the others, starting with the next worker so they are not all robbing the first one
+        for (size_t n = 1; n < m_workers.size(); ++n) {
+            Worker& victim = *m_workers[(self + n) % m_workers.size()];
+            LOCK(victim.m_mutex);
+            auto& deque = victim.m_lanes[l];
+            if (!deque.empty()) {
+                task = std::move(deque.front());
+                deque.pop_front();
+                lane = static_cast<Lane>(l);
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+void Executor::ThreadWorker(size_t self)
+{
+    t_executor = this;
+    t_worker = self;
+    while (true) {
+        std::function<void(int)> task;
+        Lane lane;
+        if (!TakeTask(self, task, lane)) {
+            WAIT_LOCK(m_mutex, lock);
+            m_cv.wait(lock, [this]() EXCLUSIVE_LOCKS_REQUIRED(m_mutex) { return m_stop || m_pending > 0; });
+            if (m_stop) return;
+            continue;
+        }
+        --m_pending;
+        LaneCounters& counters = m_counters[static_cast<size_t>(lane)];
+        --counters.queued;
+        ++counters.running;
+        const auto start{std::chrono::steady_clock::now()};
+        task(self);
+        task = nullptr;
+        counters.busy_us += std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+        --counters.running;
+        ++counters.completed;
+    }
+}
+
+Executor::LaneStats Executor::GetStats(Lane lane) const
+{
+    const LaneCounters& counters = m_counters[static_cast<size_t>(lane)];
+    LaneStats stats;
+    stats.submitted = counters.submitted;
+    stats.completed = counters.completed;
+    stats.queued = counters.queued;
+    stats.running = counters.running;
+    stats.busy = std::chrono::microseconds{counters.busy_us.load()};
+    return stats;
+}
+
+std::chrono::microseconds Executor::Uptime() const
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - m_start);
+}
+
+Executor& GetSharedExecutor()
+{
+    LOCK(g_shared_executor_mutex);
+    if (!g_shared_executor) {
+        g_shared_executor = std::make_unique<Executor>(DefaultExecutorThreads());
+    }
+    return *g_shared_executor;
+}
+
+void StartSharedExecutor(int threads)
+{
+    LOCK(g_shared_executor_mutex);
+    if (!g_shared_executor) {
+        g_shared_executor = std::make_unique<Executor>(threads > 0 ? std::min(threads, MAX_EXECUTOR_THREADS) : DefaultExecutorThreads());
+    }
+}
+
+void StopSharedExecutor()
+{
+    std::unique_ptr<Executor> executor;
+    WITH_LOCK(g_shared_executor_mutex, executor = std::move(g_shared_executor));
+    // joined outside of the lock, a finishing task may still look the executor up
+    executor.reset();
+}
+
+void ExecutorTaskGroup::Start()
+{
+    LOCK(m_state->m_mutex);
+    m_state->m_stopped = false;
+}
+
+void ExecutorTaskGroup::Stop()
+{
+    WAIT_LOCK(m_state->m_mutex, lock);
+    m_state->m_stopped = true;
+    ++m_state->m_generation;
+    m_state->m_cv.wait(lock, [this]() EXCLUSIVE_LOCKS_REQUIRED(m_state->m_mutex) { return m_state->m_running == 0; });
+}
+
+void ExecutorTaskGroup::Submit(std::function<void(int)> task)
+{
+    const uint64_t generation{WITH_LOCK(m_state->m_mutex, return m_state->m_generation)};
+    GetSharedExecutor().Submit(m_lane, [state = m_state, generation, task = std::move(task)](int id) {
+        {
+            LOCK(state->m_mutex);
+            // dropped by Stop(), destroying the task breaks its promise like a cleared thread pool queue
+            if (state->m_stopped || state->m_generation != generation) return;
+            ++state->m_running;
+        }
+        task(id);
+        {
+            LOCK(state->m_mutex);
+            --state->m_running;
+        }
+        state->m_cv.notify_all();
+    });
+}
@@ -0,0 +1,160 @@
+// Copyright (c) 2024 The Syscoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef SYSCOIN_UTIL_EXECUTOR_H
+#define SYSCOIN_UTIL_EXECUTOR_H
+
+#include <sync.h>
+#include <threadsafety.h>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/** Worker threads of the shared executor, 0 to pick them from the number of cores */
+static constexpr int DEFAULT_EXECUTOR_THREADS{0};
+static constexpr int MAX_EXECUTOR_THREADS{64};
+
+/**
+ * A fixed set of worker threads that the compute heavy subsystems share, rather
+ * than each starting threads of its own. Every worker keeps a deque per lane:
+ * tasks submitted from a worker go on its own deque and are taken back newest
+ * first, idle workers steal the oldest ones of the other workers. Tasks
+ * submitted from other threads are queued per lane for any worker to take.
+ * Lanes are served in priority order, a worker only takes LLMQ work when there
+ * is no validation work anywhere and background work when there is neither.
+ *
+ * Tasks must not block on other tasks of the executor, every worker waiting on
+ * one would leave nothing to run them.
+ */
+class Executor
+{
+public:
+    enum class Lane : size_t {
+        VALIDATION,
+        LLMQ,
+        BACKGROUND,
+    };
+    static constexpr size_t LANE_COUNT{3};
+
+    struct LaneStats {
+        uint64_t submitted{0};
+        uint64_t completed{0};
+        uint64_t queued{0};
+        uint64_t running{0};
+        //! time spent running tasks of the lane, summed over the workers
+        std::chrono::microseconds busy{0};
+    };
+
+    explicit Executor(int threads);
+    ~Executor();
+
+    Executor(const Executor&) = delete;
+    Executor& operator=(const Executor&) = delete;
+
+    /** Queue a task, it is passed the index of the worker running it */
+    void Submit(Lane lane, std::function<void(int)> task) EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+
+    LaneStats GetStats(Lane lane) const;
+    int ThreadCount() const { return m_workers.size(); }
+    /** Time since the workers were started, to put the busy time of the lanes in relation */
+    std::chrono::microseconds Uptime() const;
+
+    static std::string LaneName(Lane lane);
+
+private:
+    struct Worker {
+        Mutex m_mutex;
+        std::array<std::deque<std::function<void(int)>>, LANE_COUNT> m_lanes GUARDED_BY(m_mutex);
+    };
+    struct LaneCounters {
+        std::atomic<uint64_t> submitted{0};
+        std::atomic<uint64_t> completed{0};
+        std::atomic<uint64_t> queued{0};
+        std::atomic<uint64_t> running{0};
+        std::atomic<int64_t> busy_us{0};
+    };
+
+    std::vector<std::unique_ptr<Worker>> m_workers;
+    std::vector<std::thread> m_threads;
+    std::array<LaneCounters, LANE_COUNT> m_counters;
+    const std::chrono::steady_clock::time_point m_start;
+
+    //! guards the queues of tasks submitted from outside the workers and the sleep of idle workers
+    Mutex m_mutex;
+    std::condition_variable m_cv;
+    std::array<std::deque<std::function<void(int)>>, LANE_COUNT> m_injected GUARDED_BY(m_mutex);
+    //! tasks queued anywhere, workers sleep while it is 0
+    std::atomic<uint64_t> m_pending{0};
+    bool m_stop GUARDED_BY(m_mutex){false};
+
+    bool TakeTask(size_t self, std::function<void(int)>& task, Lane& lane) EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+    void ThreadWorker(size_t self) EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+};
+
+/** The executor shared by the node, started with the default thread count when first used */
+Executor& GetSharedExecutor();
+/** Start the shared executor with threads workers (0 for the default), unless it runs already */
+void StartSharedExecutor(int threads);
+/** Join the workers of the shared executor, all users must have stopped their task groups */
+void StopSharedExecutor();
+
+/**
+ * The tasks of one subsystem on a lane of the shared executor. It takes the place
+ * of a thread pool of its own: push() has the interface of ctpl::thread_pool::push
+ * and Stop() drops the tasks that did not start yet and waits for the running
+ * ones, so the subsystem can be torn down afterwards.
+ */
+class ExecutorTaskGroup
+{
+public:
+    explicit ExecutorTaskGroup(Executor::Lane lane) : m_lane(lane) {}
+    ~ExecutorTaskGroup() { Stop(); }
+
+    ExecutorTaskGroup(const ExecutorTaskGroup&) = delete;
+    ExecutorTaskGroup& operator=(const ExecutorTaskGroup&) = delete;
+
+    /** Accept tasks again after Stop() */
+    void Start();
+    void Stop();
+
+    template <typename F, typename... Rest>
+    auto push(F&& f, Rest&&... rest) -> std::future<std::invoke_result_t<F, int, Rest...>>
+    {
+        using R = std::invoke_result_t<F, int, Rest...>;
+        auto task = std::make_shared<std::packaged_task<R(int)>>(
+            [f = std::forward<F>(f), ... rest = std::forward<Rest>(rest)](int id) mutable { return f(id, rest...); });
+        auto future = task->get_future();
+        Submit([task](int id) { (*task)(id); });
+        return future;
+    }
+
+private:
+    struct State {
+        Mutex m_mutex;
+        std::condition_variable m_cv;
+        //! bumped by Stop(), tasks queued before are dropped
+        uint64_t m_generation GUARDED_BY(m_mutex){0};
+        bool m_stopped GUARDED_BY(m_mutex){false};
+        int m_running GUARDED_BY(m_mutex){0};
+    };
+
+    const Executor::Lane m_lane;
+    const std::shared_ptr<State> m_state{std::make_shared<State>()};
+
+    void Submit(std::function<void(int)> task);
+};
+
+#endif // SYSCOIN_UTIL_EXECUTOR_H
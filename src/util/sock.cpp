@@ -11,6 +11,7 @@
 #include <util/threadinterrupt.h>
 #include <util/time.h>
 
+#include <algorithm>
 #include <memory>
 #include <stdexcept>
 #include <string>
@@ -245,6 +246,88 @@ bool Sock::WaitMany(std::chrono::milliseconds timeout, EventsPerSock& events_per
 #endif /* USE_POLL */
 }
 
+#ifdef USE_EPOLL
+EpollSockWaiter::EpollSockWaiter() : m_epoll_fd{epoll_create1(EPOLL_CLOEXEC)}
+{
+    if (m_epoll_fd == -1) {
+        LogPrintf("Unable to create epoll instance: %s\n", NetworkErrorString(WSAGetLastError()));
+    }
+}
+
+EpollSockWaiter::~EpollSockWaiter()
+{
+    if (m_epoll_fd != -1) close(m_epoll_fd);
+}
+
+bool EpollSockWaiter::Register(const std::shared_ptr<const Sock>& sock, Sock::Event requested)
+{
+    const SOCKET s{sock->Get()};
+    int op{EPOLL_CTL_ADD};
+    auto it = m_registered.find(s);
+    if (it != m_registered.end()) {
+        if (it->second.sock.lock() == sock) {
+            if (it->second.requested == requested) return true;
+            op = EPOLL_CTL_MOD;
+        } else if (!it->second.sock.expired()) {
+            // the old socket is still open, it must not keep the registration of the new one
+            epoll_ctl(m_epoll_fd, EPOLL_CTL_DEL, s, nullptr);
+        }
+        // closing the old socket removed it from the epoll instance already
+    }
+    epoll_event event{};
+    event.data.fd = s;
+    if (requested & Sock::RECV) event.events |= EPOLLIN;
+    if (requested & Sock::SEND) event.events |= EPOLLOUT;
+    if (epoll_ctl(m_epoll_fd, op, s, &event) != 0) {
+        m_registered.erase(s);
+        return false;
+    }
+    m_registered[s] = Registration{sock, requested};
+    return true;
+}
+
+bool EpollSockWaiter::WaitMany(std::chrono::milliseconds timeout, Sock::EventsPerSock& events_per_sock)
+{
+    if (m_epoll_fd == -1) return false;
+
+    std::unordered_map<SOCKET, Sock::Events*> events_by_socket;
+    events_by_socket.reserve(events_per_sock.size());
+    for (auto& [sock, events] : events_per_sock) {
+        events.occurred = 0;
+        if (!Register(sock, events.requested)) return false;
+        events_by_socket.emplace(sock->Get(), &events);
+    }
+    for (auto it = m_registered.begin(); it != m_registered.end();) {
+        if (events_by_socket.count(it->first)) {
+            ++it;
+            continue;
+        }
+        if (!it->second.sock.expired()) epoll_ctl(m_epoll_fd, EPOLL_CTL_DEL, it->first, nullptr);
+        it = m_registered.erase(it);
+    }
+
+    m_ready.resize(std::max<size_t>(events_by_socket.size(), 1));
+    const int num_ready{epoll_wait(m_epoll_fd, m_ready.data(), m_ready.size(), count_milliseconds(timeout))};
+    if (num_ready == -1) {
+        return WSAGetLastError() == WSAEINTR;
+    }
+    for (int i = 0; i < num_ready; ++i) {
+        auto it = events_by_socket.find(m_ready[i].data.fd);
+        if (it == events_by_socket.end()) continue;
+        if (m_ready[i].events & EPOLLIN) {
+            it->second->occurred |= Sock::RECV;
+        }
+        if (m_ready[i].events & EPOLLOUT) {
+            it->second->occurred |= Sock::SEND;
+        }
+        if (m_ready[i].events & (EPOLLERR | EPOLLHUP)) {
+            it->second->occurred |= Sock::ERR;
+        }
+    }
+    return true;
+}
+#endif // USE_EPOLL
+
 void Sock::SendComplete(const std::string& data,
                         std::chrono::milliseconds timeout,
                         CThreadInterrupt& interrupt) const
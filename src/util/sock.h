@@ -13,6 +13,11 @@
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include <vector>
+
+#ifdef USE_EPOLL
+#include <sys/epoll.h>
+#endif
 
 /**
  * Maximum time to wait for I/O readiness.
@@ -281,6 +286,51 @@ private:
     void Close();
 };
 
+#ifdef USE_EPOLL
+/**
+ * SYSCOIN Same as `Sock::WaitMany()`, but the sockets stay registered in an epoll instance between
+ * calls. The event loop waits on mostly the same sockets every time, so only the sockets that were
+ * added, dropped or wait for different events cost an `epoll_ctl(2)`, and `epoll_wait(2)` only
+ * reports the ready ones instead of the kernel scanning hundreds of sockets on every `poll(2)`.
+ * Level-triggered like `poll(2)`, a socket that is not drained is reported again. Not thread safe,
+ * meant for the one thread that runs an event loop.
+ */
+class EpollSockWaiter
+{
+public:
+    EpollSockWaiter();
+    ~EpollSockWaiter();
+    EpollSockWaiter(const EpollSockWaiter&) = delete;
+    EpollSockWaiter& operator=(const EpollSockWaiter&) = delete;
+
+    /** Whether the epoll instance could be created */
+    bool IsValid() const { return m_epoll_fd != -1; }
+
+    /**
+     * Wait for the requested events like `Sock::WaitMany()`. Sockets waited on in the previous call
+     * but not in this one are unregistered.
+     * @return false on failure, e.g. a socket that epoll can't wait on
+     */
+    [[nodiscard]] bool WaitMany(std::chrono::milliseconds timeout, Sock::EventsPerSock& events_per_sock);
+
+    /** Number of sockets registered */
+    size_t Size() const { return m_registered.size(); }
+
+private:
+    struct Registration {
+        //! tells a socket apart from a later one that got the same file descriptor number
+        std::weak_ptr<const Sock> sock;
+        Sock::Event requested;
+    };
+
+    bool Register(const std::shared_ptr<const Sock>& sock, Sock::Event requested);
+
+    int m_epoll_fd{-1};
+    std::unordered_map<SOCKET, Registration> m_registered;
+    std::vector<epoll_event> m_ready;
+};
+#endif // USE_EPOLL
+
 /** Return readable error string for a network error code */
 std::string NetworkErrorString(int err);
 
@@ -43,6 +43,7 @@
 #include <script/script.h>
 #include <script/sigcache.h>
 #include <signet.h>
+#include <span.h>
 #include <tinyformat.h>
 #include <txdb.h>
 #include <txmempool.h>
@@ -66,6 +67,7 @@
 #include <cassert>
 #include <chrono>
 #include <deque>
+#include <future>
 #include <numeric>
 #include <optional>
 #include <string>
@@ -77,6 +79,8 @@
 #include <evo/deterministicmns.h>
 #include <llmq/quorums_chainlocks.h>
 #include <services/nevmconsensus.h>
+#include <services/nevmblobhasher.h>
+#include <services/zdagconflicts.h>
 #include <llmq/quorums.h>
 #include <llmq/quorums_blockprocessor.h>
 #include <governance/governance.h>
@@ -86,6 +90,7 @@
 #include <nevm/sha3.h>
 #include <common/system.h> // runCommand
 #include <core_io.h>
+#include <metrics.h>
 #ifndef WIN32
 #include <sys/wait.h>
 #include <sys/types.h>
@@ -107,7 +112,6 @@ HANDLE hProcessGeth = NULL;
 #endif
 RecursiveMutex cs_geth;
 NEVMMintTxSet setMintTxsMempool;
-std::unordered_map<COutPoint, std::pair<CTransactionRef, CTransactionRef>, SaltedOutpointHasher> mapAssetAllocationConflicts;
 std::map<uint256, int64_t> mapRejectedBlocks GUARDED_BY(cs_main);
 
 using kernel::CCoinsStats;
@@ -150,6 +154,7 @@ uint256 g_best_block;
 // SYSCOIN
 std::atomic_bool fReindexGeth(false);
 unsigned int fRPCSerialVersion;
+std::unique_ptr<CDBWrapper> psyscoinstatedb;
 const CBlockIndex* Chainstate::FindForkInGlobalIndex(const CBlockLocator& locator) const
 {
     AssertLockHeld(cs_main);
@@ -297,8 +302,15 @@ bool CheckSequenceLocksAtTip(CBlockIndex* tip,
     return EvaluateSequenceLocks(index, {lock_points.height, lock_points.time});
 }
 
-// Returns the script flags which should be checked for a given block
-static unsigned int GetBlockScriptFlags(const CBlockIndex& block_index, const ChainstateManager& chainman);
+// SYSCOIN
+/** Bridge transfer claimed by a mint transaction, nullopt for other transactions */
+static std::optional<uint256> GetMintTxHash(const CTransaction& tx)
+{
+    if (!IsSyscoinMintTx(tx.nVersion)) return std::nullopt;
+    const auto& mintSyscoin = tx.GetMintSyscoin();
+    if (!mintSyscoin || mintSyscoin->IsNull()) return std::nullopt;
+    return mintSyscoin->nTxHash;
+}
 
 static void LimitMempoolSize(CTxMemPool& pool, CCoinsViewCache& coins_cache)
     EXCLUSIVE_LOCKS_REQUIRED(::cs_main, pool.cs)
@@ -312,6 +324,8 @@ static void LimitMempoolSize(CTxMemPool& pool, CCoinsViewCache& coins_cache)
 
     std::vector<COutPoint> vNoSpendsRemaining;
     pool.TrimToSize(pool.m_max_size_bytes, &vNoSpendsRemaining);
+    // SYSCOIN blob bytes are not part of DynamicMemoryUsage(), they have their own budget
+    pool.TrimPoDAToSize(pool.m_max_poda_size_bytes, &vNoSpendsRemaining);
     for (const COutPoint& removed : vNoSpendsRemaining)
         coins_cache.Uncache(removed);
 }
@@ -702,6 +716,20 @@ private:
     // limiting is performed, false otherwise.
     bool Finalize(const ATMPArgs& args, Workspace& ws) EXCLUSIVE_LOCKS_REQUIRED(cs_main, m_pool.cs);
 
+    // SYSCOIN
+    // Whether a mempool transaction or any of its in-mempool ancestors signals RBF or is double spent.
+    struct ZDAGAncestorFlags {
+        bool fSignalsRBF{false};
+        bool fConflict{false};
+    };
+    // Flags already worked out while publishing statuses, so the transactions of a chain submitted
+    // as a package look at every ancestor once instead of once per descendant.
+    using ZDAGFlagsCache = std::map<uint256, ZDAGAncestorFlags>;
+    ZDAGAncestorFlags GetZDAGAncestorFlags(CTxMemPool::txiter it, ZDAGFlagsCache& cache) EXCLUSIVE_LOCKS_REQUIRED(m_pool.cs);
+    // Publish the ZDAG status of an accepted transaction, and the status change of the
+    // mempool transactions it double spends along with their descendants.
+    void NotifyZDAGStatus(const Workspace& ws, ZDAGFlagsCache& cache) EXCLUSIVE_LOCKS_REQUIRED(cs_main, m_pool.cs);
+
     // Submit all transactions to the mempool and call ConsensusScriptChecks to add to the script
     // cache - should only be called after successful validation of all transactions in the package.
     // Does not call LimitMempoolSize(), so mempool max_size_bytes may be temporarily exceeded.
@@ -736,6 +764,12 @@ private:
 
     /** Whether the transaction(s) would replace any mempool transactions. If so, RBF rules apply. */
     bool m_rbf{false};
+    // SYSCOIN
+    /** Whether AcceptMultipleTransactions() is validating the transactions as one package */
+    bool m_multi_tx{false};
+    /** Bridge transfers claimed by the package being validated, they only go into setMintTxsMempool
+     *  once the whole package is submitted so a rejected package leaves nothing behind */
+    NEVMMintTxSet m_package_mints;
 };
 
 bool MemPoolAccept::PreChecks(ATMPArgs& args, Workspace& ws)
@@ -818,12 +852,11 @@ bool MemPoolAccept::PreChecks(ATMPArgs& args, Workspace& ws)
                     // neither are its ancestors, they will be locked in as soon as you have a ZDAG tx because ZDAG isn't compliant with RBF.
                     if(IsZTx){
                         // allow the first time this outpoint was found in conflict
-                        auto it = mapAssetAllocationConflicts.try_emplace(txin.prevout, ptx, MakeTransactionRef(*ptxConflicting));
                         // if was inserted (not found)
-                        if(it.second) {
-                            // if just testing, and this is the first conflict for this prevout then let it go through but just don't add it to the global mapAssetAllocationConflicts
+                        if(g_zdag_conflicts.TryAdd(txin.prevout, ptx, MakeTransactionRef(*ptxConflicting))) {
+                            // if just testing, and this is the first conflict for this prevout then let it go through but just don't add it to the global g_zdag_conflicts
                             if(args.m_test_accept) {
-                                mapAssetAllocationConflicts.erase(txin.prevout);
+                                g_zdag_conflicts.Erase(txin.prevout);
                             }
                             ws.m_conflictsAsset.insert(ptxConflicting->GetHash());
                             break;
@@ -895,7 +928,14 @@ bool MemPoolAccept::PreChecks(ATMPArgs& args, Workspace& ws)
 
     // SYSCOIN
     const auto& params = args.m_chainparams.GetConsensus();
-    if (!CheckSyscoinInputs(params, tx, hash, state, (uint32_t)m_active_chainstate.m_chain.Tip()->nHeight + 1, args.m_test_accept, setMintTxsMempool, mapAssetIn, mapAssetOut)) {
+    // the transactions of a package claim their bridge transfers in m_package_mints, which catches
+    // duplicates inside the package even when only testing, while the mempool is only looked at
+    if (m_multi_tx) {
+        if (const auto nMintTxHash{GetMintTxHash(tx)}; nMintTxHash && setMintTxsMempool.count(*nMintTxHash)) {
+            return state.Invalid(TxValidationResult::TX_MINT_DUPLICATE, "mint-duplicate-transfer");
+        }
+    }
+    if (!CheckSyscoinInputs(params, tx, hash, state, (uint32_t)m_active_chainstate.m_chain.Tip()->nHeight + 1, args.m_test_accept && !m_multi_tx, m_multi_tx ? m_package_mints : setMintTxsMempool, mapAssetIn, mapAssetOut)) {
         return false; // state filled in by CheckSyscoinInputs
     }      
     
@@ -1300,6 +1340,9 @@ bool MemPoolAccept::SubmitPackage(const ATMPArgs& args, std::vector<Workspace>&
             all_submitted = false;
             package_state.Invalid(PackageValidationResult::PCKG_MEMPOOL_ERROR,
                                   strprintf("BUG! Adding to mempool failed: %s", ws.m_ptx->GetHash().ToString()));
+        // SYSCOIN the bridge transfer is taken now that the transaction is in the mempool
+        } else if (const auto nMintTxHash{GetMintTxHash(*ws.m_ptx)}) {
+            setMintTxsMempool.insert(*nMintTxHash);
         }
     }
 
@@ -1309,6 +1352,8 @@ bool MemPoolAccept::SubmitPackage(const ATMPArgs& args, std::vector<Workspace>&
                    [](const auto& ws) { return ws.m_ptx->GetWitnessHash(); });
 
     // Add successful results. The returned results may change later if LimitMempoolSize() evicts them.
+    // SYSCOIN
+    ZDAGFlagsCache zdag_flags;
     for (Workspace& ws : workspaces) {
         const auto effective_feerate = args.m_package_feerates ? ws.m_package_feerate :
             CFeeRate{ws.m_modified_fees, static_cast<uint32_t>(ws.m_vsize)};
@@ -1318,14 +1363,69 @@ bool MemPoolAccept::SubmitPackage(const ATMPArgs& args, std::vector<Workspace>&
                         MempoolAcceptResult::Success(std::move(ws.m_replaced_transactions), ws.m_vsize,
                                          ws.m_base_fees, effective_feerate, effective_feerate_wtxids));
         GetMainSignals().TransactionAddedToMempool(ws.m_ptx, m_pool.GetAndIncrementSequence());
+        // SYSCOIN
+        NotifyZDAGStatus(ws, zdag_flags);
     }
     return all_submitted;
 }
 
+MemPoolAccept::ZDAGAncestorFlags MemPoolAccept::GetZDAGAncestorFlags(CTxMemPool::txiter it, ZDAGFlagsCache& cache)
+{
+    AssertLockHeld(m_pool.cs);
+    const uint256& hash{it->GetTx().GetHash()};
+    if (const auto cached{cache.find(hash)}; cached != cache.end()) return cached->second;
+    ZDAGAncestorFlags flags{SignalsOptInRBF(it->GetTx()), m_pool.existsConflicts(it->GetTx())};
+    for (const CTxMemPoolEntry& parent : it->GetMemPoolParentsConst()) {
+        const ZDAGAncestorFlags parent_flags{GetZDAGAncestorFlags(m_pool.mapTx.iterator_to(parent), cache)};
+        flags.fSignalsRBF |= parent_flags.fSignalsRBF;
+        flags.fConflict |= parent_flags.fConflict;
+    }
+    cache.emplace(hash, flags);
+    return flags;
+}
+
+void MemPoolAccept::NotifyZDAGStatus(const Workspace& ws, ZDAGFlagsCache& cache)
+{
+    AssertLockHeld(m_pool.cs);
+    if (!IsZdagTx(ws.m_ptx->nVersion)) return;
+    if (!ws.m_conflictsAsset.empty()) {
+        CTxMemPool::setEntries setFlagged;
+        for (const uint256& hash : ws.m_conflictsAsset) {
+            if (const auto it = m_pool.GetIter(hash)) m_pool.CalculateDescendants(*it, setFlagged);
+        }
+        if (const auto it = m_pool.GetIter(ws.m_hash)) m_pool.CalculateDescendants(*it, setFlagged);
+        for (CTxMemPool::txiter it : setFlagged) {
+            if (IsZdagTx(it->GetTx().nVersion)) {
+                GetMainSignals().NotifyZDAGStatus(it->GetTx().GetHash(), ZDAG_MAJOR_CONFLICT);
+            }
+        }
+        return;
+    }
+    const auto it{m_pool.GetIter(ws.m_hash)};
+    if (!it) return;
+    // the flags of the transaction itself also count its own double spends, only the ancestors' do here
+    ZDAGAncestorFlags flags{SignalsOptInRBF(*ws.m_ptx), false};
+    for (const CTxMemPoolEntry& parent : (*it)->GetMemPoolParentsConst()) {
+        const ZDAGAncestorFlags parent_flags{GetZDAGAncestorFlags(m_pool.mapTx.iterator_to(parent), cache)};
+        flags.fSignalsRBF |= parent_flags.fSignalsRBF;
+        flags.fConflict |= parent_flags.fConflict;
+    }
+    int status{ZDAG_STATUS_OK};
+    // spending an output of a double spent ancestor is as unsafe as the double spend itself
+    if (flags.fConflict) {
+        status = ZDAG_MAJOR_CONFLICT;
+    } else if (flags.fSignalsRBF) {
+        status = ZDAG_WARNING_RBF;
+    }
+    GetMainSignals().NotifyZDAGStatus(ws.m_hash, status);
+}
+
 MempoolAcceptResult MemPoolAccept::AcceptSingleTransaction(const CTransactionRef& ptx, ATMPArgs& args)
 {
     AssertLockHeld(cs_main);
     LOCK(m_pool.cs); // mempool "read lock" (held through GetMainSignals().TransactionAddedToMempool())
+    // SYSCOIN a package may have been validated by this instance already, AcceptPackage() goes on one transaction at a time
+    m_multi_tx = false;
 
     Workspace ws(ptx);
 
@@ -1350,6 +1450,9 @@ MempoolAcceptResult MemPoolAccept::AcceptSingleTransaction(const CTransactionRef
     if (!Finalize(args, ws)) return MempoolAcceptResult::Failure(ws.m_state);
 
     GetMainSignals().TransactionAddedToMempool(ptx, m_pool.GetAndIncrementSequence());
+    // SYSCOIN
+    ZDAGFlagsCache zdag_flags;
+    NotifyZDAGStatus(ws, zdag_flags);
 
     return MempoolAcceptResult::Success(std::move(ws.m_replaced_transactions), ws.m_vsize, ws.m_base_fees,
                                         effective_feerate, single_wtxid);
@@ -1371,6 +1474,10 @@ PackageMempoolAcceptResult MemPoolAccept::AcceptMultipleTransactions(const std::
 
     LOCK(m_pool.cs);
 
+    // SYSCOIN
+    m_multi_tx = true;
+    m_package_mints.clear();
+
     // Do all PreChecks first and fail fast to avoid running expensive script checks when unnecessary.
     for (Workspace& ws : workspaces) {
         if (!PreChecks(args, ws)) {
@@ -1464,6 +1571,10 @@ PackageMempoolAcceptResult MemPoolAccept::AcceptSubPackage(const std::vector<CTr
         PackageValidationState package_state_wrapped;
         if (single_res.m_result_type != MempoolAcceptResult::ResultType::VALID) {
             package_state_wrapped.Invalid(PackageValidationResult::PCKG_TX, "transaction failed");
+            // SYSCOIN release the bridge transfer so the transaction can still go in with the rest of the package
+            if (single_res.m_state.GetResult() != TxValidationResult::TX_MINT_DUPLICATE) {
+                if (const auto nMintTxHash{GetMintTxHash(*tx)}) setMintTxsMempool.erase(*nMintTxHash);
+            }
         }
         return PackageMempoolAcceptResult(package_state_wrapped, {{tx->GetWitnessHash(), single_res}});
     }();
@@ -1696,16 +1807,13 @@ MempoolAcceptResult AcceptToMemoryPool(Chainstate& active_chainstate, const CTra
         for (const COutPoint& hashTx : coins_to_uncache) {
             active_chainstate.CoinsTip().Uncache(hashTx);
             // SYSCOIN
-            mapAssetAllocationConflicts.erase(hashTx);
+            g_zdag_conflicts.Erase(hashTx);
         }
         // if we had duplicate mint's we don't want to remove the mint tx hash, but only if we had some other error not related to TX_MINT_DUPLICATE
         if(result.m_state.GetResult() != TxValidationResult::TX_MINT_DUPLICATE) {
             // remove nevm tx from mempool structure
-            if(IsSyscoinMintTx(tx->nVersion)) {
-                CMintSyscoin mintSyscoin(*tx);
-                if(!mintSyscoin.IsNull()) {
-                    setMintTxsMempool.erase(mintSyscoin.nTxHash);
-                }
+            if (const auto nMintTxHash{GetMintTxHash(*tx)}) {
+                setMintTxsMempool.erase(*nMintTxHash);
             }
         }
         TRACE2(mempool, rejected,
@@ -1713,6 +1821,12 @@ MempoolAcceptResult AcceptToMemoryPool(Chainstate& active_chainstate, const CTra
                 result.m_state.GetRejectReason().c_str()
         );
     }
+    // SYSCOIN
+    if (!test_accept) {
+        static metrics::Counter& accepted{metrics::GetCounter("syscoin_mempool_accepted_total", "Transactions accepted to the mempool")};
+        static metrics::Counter& rejected{metrics::GetCounter("syscoin_mempool_rejected_total", "Transactions rejected from the mempool")};
+        (result.m_result_type == MempoolAcceptResult::ResultType::VALID ? accepted : rejected).Inc();
+    }
     // After we've (potentially) uncached entries, ensure our coins cache is still within its size limits
     BlockValidationState state_dummy;
     active_chainstate.FlushStateToDisk(state_dummy, FlushStateMode::PERIODIC);
@@ -1755,7 +1869,8 @@ PackageMempoolAcceptResult ProcessNewPackage(Chainstate& active_chainstate, CTxM
 //
 // CBlock and CBlockIndex
 //
-bool CheckProofOfWork(const CBlockHeader& block, const Consensus::Params& params)
+// SYSCOIN roots, when given, were computed by CAuxPow::computeMerkleRoots for a batch of headers
+static bool CheckProofOfWork(const CBlockHeader& block, const Consensus::Params& params, const CAuxPow::MerkleRoots* roots)
 {
     /* Except for legacy blocks with full version 1, ensure that
        the chain ID is correct.  Legacy blocks are not allowed since
@@ -1799,13 +1914,39 @@ bool CheckProofOfWork(const CBlockHeader& block, const Consensus::Params& params
 
     if (!CheckProofOfWork(block.auxpow->getParentBlockHash(), block.nBits, params))
         return error("%s : AUX proof of work failed", __func__);
-    if (!block.auxpow->check(block.GetHash(), block.GetChainId(), params))
+    if (roots ? !block.auxpow->check(block.GetHash(), block.GetChainId(), params, *roots) :
+                !block.auxpow->check(block.GetHash(), block.GetChainId(), params))
         return error("%s : AUX POW is not valid", __func__);
 
 
     return true;
 }
 
+bool CheckProofOfWork(const CBlockHeader& block, const Consensus::Params& params)
+{
+    return CheckProofOfWork(block, params, nullptr);
+}
+
+/** Proof of work check of several headers, the merkle branches of their auxpows are hashed side by side */
+static bool CheckProofOfWork(Span<const CBlockHeader> headers, const Consensus::Params& params)
+{
+    std::vector<std::pair<const CAuxPow*, uint256>> auxpows;
+    for (const CBlockHeader& header : headers) {
+        if (header.auxpow && header.IsAuxpow()) auxpows.emplace_back(header.auxpow.get(), header.GetHash());
+    }
+    if (auxpows.size() < 2) {
+        return std::all_of(headers.begin(), headers.end(),
+                [&](const auto& header) { return CheckProofOfWork(header, params, nullptr); });
+    }
+    const std::vector<CAuxPow::MerkleRoots> roots{CAuxPow::computeMerkleRoots(auxpows)};
+    size_t nAuxpow{0};
+    for (const CBlockHeader& header : headers) {
+        const bool fAuxpow{header.auxpow && header.IsAuxpow()};
+        if (!CheckProofOfWork(header, params, fAuxpow ? &roots[nAuxpow++] : nullptr)) return false;
+    }
+    return true;
+}
+
 CAmount GetBlockSubsidyRegtest(int nHeight, const Consensus::Params& consensusParams)
 {
     int halvings = nHeight / consensusParams.nSubsidyHalvingInterval;
@@ -1853,8 +1994,10 @@ CAmount GetBlockSubsidy(unsigned int nHeight, const Consensus::Params& consensus
 
 }
 CoinsViews::CoinsViews(DBParams db_params, CoinsViewOptions options)
-    : m_dbview{std::move(db_params), std::move(options)},
-      m_catcherview(&m_dbview) {}
+    : m_dbview{std::move(db_params), options},
+      // SYSCOIN
+      m_prefetchview{m_dbview, options.prefetch},
+      m_catcherview(&m_prefetchview) {}
 
 void CoinsViews::InitCache()
 {
@@ -2213,7 +2356,7 @@ bool GetNEVMData(BlockValidationState& state, const CBlock& block, CNEVMHeader &
     }
     return true;
 }
-bool Chainstate::ConnectNEVMCommitment(BlockValidationState& state, NEVMTxRootMap &mapNEVMTxRoots, const CBlock& block, const uint256& nBlockHash, const uint32_t& nHeight, const bool fJustCheck, PoDAMAPMemory &mapPoDA, const CDeterministicMNListNEVMAddressDiff &diff) {
+bool Chainstate::ConnectNEVMCommitment(BlockValidationState& state, NEVMTxRootMap &mapNEVMTxRoots, const CBlock& block, const uint256& nBlockHash, const uint32_t& nHeight, const bool fJustCheck, PoDAMAPMemory &mapPoDA, const CDeterministicMNListNEVMAddressDiff &diff, const bool fAssumedValid) {
     CNEVMHeader nevmBlockHeader;
     if(!GetNEVMData(state, block, nevmBlockHeader)) {
         return false; //state filled by GetNEVMData
@@ -2226,13 +2369,29 @@ bool Chainstate::ConnectNEVMCommitment(BlockValidationState& state, NEVMTxRootMa
     for (auto const& [key, val] : mapPoDA) {
         NEVMDataVecOut.emplace_back(key);
     }
-    bool bSkipValidation = false;
+    // blocks under assumevalid do not wait on the Geth verdict, which lets the block connects be pipelined. The verdict
+    // still counts once it comes in, a rejection is rolled back by SettleNEVMPipeline.
+    const bool bSkipValidation = fAssumedValid && !fJustCheck;
     if(bSkipValidation) {
-        LogPrintf("ConnectNEVMCommitment: skipping validation result...\n");
+        LogPrint(BCLog::SYS, "ConnectNEVMCommitment: not waiting for the validation result...\n");
     }
     std::string stateStr;
-    if(fNEVMConnection) {
+    // the round trip to Geth, traced so it can be profiled on a running node
+    const auto NotifyConnect = [&]() {
+        TRACE5(nevm, connect_start, nBlockHash.data(), nHeight, NEVMDataVecOut.size(), fJustCheck, bSkipValidation);
+        const auto time_start{SteadyClock::now()};
         GetMainSignals().NotifyNEVMBlockConnect(nevmBlockHeader, block, stateStr, fJustCheck? uint256(): nBlockHash, NEVMDataVecOut, nHeight, bSkipValidation, diff);
+        const auto time_end{SteadyClock::now()};
+        LogPrint(BCLog::BENCHMARK, "    - NEVM connect: %.2fms\n", Ticks<MillisecondsDouble>(time_end - time_start));
+        TRACE4(nevm, connect_end, nBlockHash.data(), nHeight, stateStr.c_str(), Ticks<std::chrono::microseconds>(time_end - time_start));
+    };
+    if(fNEVMConnection) {
+        NotifyConnect();
+        if(stateStr == "nevm-pipeline-failed") {
+            // an earlier pipelined block was rejected by Geth, this block is not to blame so don't mark it invalid.
+            // ActivateBestChainStep rolls back to the rejected block and connects from there in lock-step.
+            return state.Error(stateStr);
+        }
         if(!stateStr.empty()) {
             state.Invalid(BlockValidationResult::BLOCK_INVALID_HEADER, stateStr);
             if(stateStr == "nevm-connect-response-invalid-data" || stateStr == "nevm-response-not-found") {
@@ -2254,7 +2413,7 @@ bool Chainstate::ConnectNEVMCommitment(BlockValidationState& state, NEVMTxRootMa
             if(!bResponse) {
                 if(RestartGethNode()) {
                     // try again after resetting connection
-                    GetMainSignals().NotifyNEVMBlockConnect(nevmBlockHeader, block, stateStr, fJustCheck? uint256(): nBlockHash, NEVMDataVecOut, nHeight, bSkipValidation, diff);
+                    NotifyConnect();
                     if(!stateStr.empty()) {
                         state.Invalid(BlockValidationResult::BLOCK_INVALID_HEADER, stateStr);
                         if(stateStr == "nevm-connect-response-invalid-data" || stateStr == "nevm-response-not-found") {
@@ -2281,14 +2440,22 @@ bool Chainstate::ConnectNEVMCommitment(BlockValidationState& state, NEVMTxRootMa
 
     return res;
 }
-bool DisconnectNEVMCommitment(BlockValidationState& state, std::vector<uint256> &vecNEVMBlocks, const CBlock& block, const uint256& nBlockHash, const CDeterministicMNListNEVMAddressDiff &diff) {
+bool DisconnectNEVMCommitment(BlockValidationState& state, std::vector<uint256> &vecNEVMBlocks, const CBlock& block, const uint256& nBlockHash, const CDeterministicMNListNEVMAddressDiff &diff, NEVMDisconnectVec* vecNEVMDisconnects) {
     CNEVMHeader evmBlock;
     if(!GetNEVMData(state, block, evmBlock)) {
         return false; // state filled by GetNEVMData
     }
-    if(fNEVMConnection) {
+    // Geth is rewound over the whole range once the caller is done disconnecting
+    if(vecNEVMDisconnects) {
+        vecNEVMDisconnects->emplace_back(nBlockHash, diff);
+    } else if(fNEVMConnection) {
         std::string stateStr;
+        TRACE1(nevm, disconnect_start, nBlockHash.data());
+        const auto time_start{SteadyClock::now()};
         GetMainSignals().NotifyNEVMBlockDisconnect(stateStr, nBlockHash, diff);
+        const auto time_end{SteadyClock::now()};
+        LogPrint(BCLog::BENCHMARK, "    - NEVM disconnect: %.2fms\n", Ticks<MillisecondsDouble>(time_end - time_start));
+        TRACE3(nevm, disconnect_end, nBlockHash.data(), stateStr.c_str(), Ticks<std::chrono::microseconds>(time_end - time_start));
         if(!stateStr.empty()) {
             state.Invalid(BlockValidationResult::BLOCK_INVALID_HEADER, stateStr);
         }
@@ -2307,16 +2474,17 @@ bool FillNEVMData(CBlock &block) {
             const auto nOut = GetSyscoinDataOutput(*tx);
             if (nOut != -1) {
                 // already has payload skip it
-                if(!tx->vout[nOut].vchNEVMData.empty()) {
+                if(tx->vout[nOut].HasNEVMData()) {
                     continue;
                 }
                 CNEVMData nevmData(tx->vout[nOut].scriptPubKey);
                 if (!nevmData.IsNull()) {
-                    if(pnevmdatablobdb->Exists(nevmData.vchVersionHash)) {
+                    if(pnevmdatablobdb->BlobExists(nevmData.vchVersionHash)) {
                         CMutableTransaction mutable_tx(*tx);
-                        // Directly modify the mutable vector
-                        if(pnevmdatablobdb->Read(nevmData.vchVersionHash, mutable_tx.vout[nOut].vchNEVMData)) {
-                            if(!mutable_tx.vout[nOut].vchNEVMData.empty()) {
+                        std::vector<uint8_t> vchData;
+                        if(pnevmdatablobdb->ReadBlob(nevmData.vchVersionHash, vchData)) {
+                            mutable_tx.vout[nOut].SetNEVMData(std::move(vchData));
+                            if(mutable_tx.vout[nOut].HasNEVMData()) {
                                 // Now create the immutable CTransaction and store its Ref
                                 block.vtx[i] = MakeTransactionRef(std::move(mutable_tx));
                             }
@@ -2340,21 +2508,43 @@ bool EraseNEVMData(const NEVMDataVec &NEVMDataVecOut) {
     }
     return true;
 }
+// SYSCOIN checks up to dev::sha3BatchWidth() blobs so they can be hashed interleaved
 class CBlobCheck
 {
 private:
-    const CNEVMData* nevmData;
+    std::array<const CNEVMData*, 4> nevmData;
+    size_t nCount{0};
 public:
     CBlobCheck() {}
     CBlobCheck(const CNEVMData* nevmDataIn) :
-        nevmData(nevmDataIn)  { };
+        nevmData{nevmDataIn}, nCount(1) { };
+
+    bool Add(const CNEVMData* nevmDataIn) {
+        if(nCount >= std::min(nevmData.size(), dev::sha3BatchWidth())) {
+            return false;
+        }
+        nevmData[nCount++] = nevmDataIn;
+        return true;
+    }
 
     bool operator()() noexcept {
-        return nevmData->vchVersionHash == dev::sha3(*nevmData->vchNEVMData).asBytes();
+        std::array<dev::bytesConstRef, 4> inputs;
+        std::array<dev::h256, 4> hashes;
+        for(size_t i = 0; i < nCount; i++) {
+            inputs[i] = dev::bytesConstRef(nevmData[i]->vchNEVMData->data(), nevmData[i]->vchNEVMData->size());
+        }
+        dev::sha3Batch(inputs.data(), hashes.data(), nCount);
+        for(size_t i = 0; i < nCount; i++) {
+            if(nevmData[i]->vchVersionHash != hashes[i].asBytes()) {
+                return false;
+            }
+        }
+        return true;
     }
 };
 static CCheckQueue<CBlobCheck> blobcheckqueue(MAX_DATA_BLOBS);
-bool ProcessNEVMDataHelper(const BlockManager& blockman, const std::vector<CNEVMData> &vecNevmDataPayload, const int64_t &nMedianTime, const int64_t &nTimeNow, PoDAMAPMemory &mapPoDA) {
+static NEVMBlobVerificationCache g_nevm_verified_blobs;
+bool ProcessNEVMDataHelper(const BlockManager& blockman, const std::vector<CNEVMData> &vecNevmDataPayload, const std::vector<std::optional<std::vector<uint8_t>>> &vecDigests, const int64_t &nMedianTime, const int64_t &nTimeNow, PoDAMAPMemory &mapPoDA) {
     int64_t nMedianTimeCL = 0;
     if(llmq::chainLocksHandler) {
         const CBlockIndex* CLIndex = llmq::chainLocksHandler->GetBestChainLockIndex();
@@ -2365,7 +2555,9 @@ bool ProcessNEVMDataHelper(const BlockManager& blockman, const std::vector<CNEVM
     // first sanity test times to ensure data should or shouldn't exist and save to another vector
     CCheckQueueControl<CBlobCheck> control(&blobcheckqueue);
     std::vector<CBlobCheck> vChecks;
-    for (const auto &nevmDataPayload : vecNevmDataPayload) {
+    size_t nSizeChecks{0};
+    for (size_t i = 0; i < vecNevmDataPayload.size(); i++) {
+        const auto &nevmDataPayload = vecNevmDataPayload[i];
         // if connecting block is over NEVM_DATA_ENFORCE_TIME_NOT_HAVE_DATA seconds old (median) and we have a chainlock less than NEVM_DATA_ENFORCE_TIME_HAVE_DATA seconds old (median)
         const bool enforceNotHaveData = nMedianTimeCL > 0 && nMedianTime < (nTimeNow - NEVM_DATA_ENFORCE_TIME_NOT_HAVE_DATA) && nMedianTimeCL >= (nTimeNow - NEVM_DATA_ENFORCE_TIME_HAVE_DATA);
         const bool enforceHaveData = nMedianTime >= (nTimeNow - NEVM_DATA_ENFORCE_TIME_HAVE_DATA);
@@ -2377,20 +2569,36 @@ bool ProcessNEVMDataHelper(const BlockManager& blockman, const std::vector<CNEVM
             return false;
         }
         if(nevmDataPayload.vchNEVMData && !nevmDataPayload.vchNEVMData->empty() && !pnevmdatadb->BlobExists(nevmDataPayload.vchVersionHash)){
-            vChecks.emplace_back(CBlobCheck(&nevmDataPayload));
+            // already checked by PreValidateNEVMData() before cs_main was taken
+            if(g_nevm_verified_blobs.Contains(nevmDataPayload.vchVersionHash, nevmDataPayload.vchNEVMData)) {
+                continue;
+            }
+            // already hashed by g_nevm_blob_hasher when the message was received
+            if(vecDigests[i]) {
+                if(*vecDigests[i] != nevmDataPayload.vchVersionHash) {
+                    LogPrint(BCLog::SYS, "ProcessNEVMDataHelper: Invalid blob\n");
+                    return false;
+                }
+                continue;
+            }
+            if(vChecks.empty() || !vChecks.back().Add(&nevmDataPayload)) {
+                vChecks.emplace_back(CBlobCheck(&nevmDataPayload));
+            }
+            nSizeChecks++;
         }
     }
     if(!vChecks.empty()) {
         // process new vector in batch checking the blobs
         BlockValidationState state;
         const auto time_1{SteadyClock::now()};
-        const auto nSizeChecks = vChecks.size();
         control.Add(std::move(vChecks));
-        if (!control.Wait()){
+        const bool fValid = control.Wait();
+        const auto time_2{SteadyClock::now()};
+        TRACE3(nevm, blobs_verified, nSizeChecks, fValid, Ticks<std::chrono::microseconds>(time_2 - time_1));
+        if (!fValid){
             LogPrint(BCLog::SYS, "ProcessNEVMDataHelper: Invalid blob(s)\n");
             return false;
         }
-        const auto time_2{SteadyClock::now()};
         LogPrint(BCLog::BENCHMARK, "ProcessNEVMDataHelper: verified %d blobs in %.2fms (%.2fms/blob)\n", nSizeChecks, Ticks<MillisecondsDouble>(time_2 - time_1), Ticks<MillisecondsDouble>(time_2 - time_1) / nSizeChecks);
     }
     for (const auto &nevmDataPayload : vecNevmDataPayload) {
@@ -2401,6 +2609,7 @@ bool ProcessNEVMDataHelper(const BlockManager& blockman, const std::vector<CNEVM
 // when we receive blocks/txs from peers we need to strip the OPRETURN NEVM DA payload and store separately
 bool ProcessNEVMData(const BlockManager& blockman, const CBlock &block, const int64_t &nMedianTime, const int64_t& nTimeNow, PoDAMAPMemory &mapPoDA) {
     std::vector<CNEVMData> vecNevmDataPayload;
+    std::vector<std::optional<std::vector<uint8_t>>> vecDigests;
     int nCountBlobs = 0;
     for (auto &tx : block.vtx) {
         if(tx->IsNEVMData()) {
@@ -2414,9 +2623,10 @@ bool ProcessNEVMData(const BlockManager& blockman, const CBlock &block, const in
                 return false;
             }
             vecNevmDataPayload.emplace_back(nevmDataPayload);
+            vecDigests.emplace_back(g_nevm_blob_hasher ? g_nevm_blob_hasher->TakeDigest(*tx) : std::nullopt);
         }
     }
-    if(!vecNevmDataPayload.empty() && !ProcessNEVMDataHelper(blockman, vecNevmDataPayload, nMedianTime, nTimeNow, mapPoDA)) {
+    if(!vecNevmDataPayload.empty() && !ProcessNEVMDataHelper(blockman, vecNevmDataPayload, vecDigests, nMedianTime, nTimeNow, mapPoDA)) {
         return false;
     }
     return true;
@@ -2430,15 +2640,38 @@ bool ProcessNEVMData(const BlockManager& blockman, const CTransaction& tx, const
         return false;
     }
     std::vector<CNEVMData> vecPayload{nevmDataPayload};
-    if(!ProcessNEVMDataHelper(blockman, vecPayload, nMedianTime, nTimeNow, mapPoDA)) {
+    std::vector<std::optional<std::vector<uint8_t>>> vecDigests{g_nevm_blob_hasher ? g_nevm_blob_hasher->TakeDigest(tx) : std::nullopt};
+    if(!ProcessNEVMDataHelper(blockman, vecPayload, vecDigests, nMedianTime, nTimeNow, mapPoDA)) {
+        return false;
+    }
+    return true;
+}
+bool PreValidateNEVMData(const CTransaction& tx) {
+    if(!tx.IsNEVMData()) {
+        return true;
+    }
+    const CNEVMData nevmDataPayload(tx);
+    if(nevmDataPayload.IsNull() || !nevmDataPayload.vchNEVMData || nevmDataPayload.vchNEVMData->empty()) {
+        return true;
+    }
+    if(g_nevm_verified_blobs.Contains(nevmDataPayload.vchVersionHash, nevmDataPayload.vchNEVMData)) {
+        return true;
+    }
+    std::optional<std::vector<uint8_t>> digest{g_nevm_blob_hasher ? g_nevm_blob_hasher->TakeDigest(tx) : std::nullopt};
+    if(!digest) {
+        digest = dev::sha3(*nevmDataPayload.vchNEVMData).asBytes();
+    }
+    if(*digest != nevmDataPayload.vchVersionHash) {
+        LogPrint(BCLog::SYS, "PreValidateNEVMData: Invalid blob for tx %s\n", tx.GetHash().ToString());
         return false;
     }
+    g_nevm_verified_blobs.Add(nevmDataPayload.vchVersionHash, nevmDataPayload.vchNEVMData);
     return true;
 }
 /** Undo the effects of this block (with given index) on the UTXO set represented by coins.
  *  When FAILED is returned, view is left in an indeterminate state. */
 // SYSCOIN
-DisconnectResult Chainstate::DisconnectBlock(const CBlock& block, const CBlockIndex* pindex, CCoinsViewCache& view, NEVMMintTxSet &setMintTxs, std::vector<uint256> &vecNEVMBlocks, std::vector<std::pair<uint256, uint32_t> > &vecTXIDPairs, bool bReverify, bool bReplay)
+DisconnectResult Chainstate::DisconnectBlock(const CBlock& block, const CBlockIndex* pindex, CCoinsViewCache& view, NEVMMintTxSet &setMintTxs, std::vector<uint256> &vecNEVMBlocks, std::vector<std::pair<uint256, uint32_t> > &vecTXIDPairs, bool bReverify, bool bReplay, NEVMDisconnectVec* vecNEVMDisconnects)
 {
     AssertLockHeld(::cs_main);
     // SYSCOIN
@@ -2516,7 +2749,7 @@ DisconnectResult Chainstate::DisconnectBlock(const CBlock& block, const CBlockIn
     }
     BlockValidationState state;
     bool bRegTestContext = !fRegTest || (fRegTest && fNEVMConnection);
-    if(bRegTestContext && bReverify && pindex->nHeight >= params.nNEVMStartBlock && !DisconnectNEVMCommitment(state, vecNEVMBlocks, block, block.GetHash(), diffNEVM)) {
+    if(bRegTestContext && bReverify && pindex->nHeight >= params.nNEVMStartBlock && !DisconnectNEVMCommitment(state, vecNEVMBlocks, block, block.GetHash(), diffNEVM, vecNEVMDisconnects)) {
         const std::string errStr = strprintf("DisconnectBlock(): NEVM block failed to disconnect: %s\n", state.ToString().c_str());
         error(errStr.c_str());
         return DISCONNECT_FAILED;
@@ -2527,17 +2760,43 @@ DisconnectResult Chainstate::DisconnectBlock(const CBlock& block, const CBlockIn
 }
 
 static CCheckQueue<CScriptCheck> scriptcheckqueue(128);
+// SYSCOIN mint proofs are far more expensive than a script check, hand them out in small batches
+static CCheckQueue<CMintProofCheck> mintcheckqueue(4);
+
+/** Headers handed to one CHeaderPoWCheck, their auxpow merkle branches fill the lanes of the 8-way SHA256D64 twice over */
+static constexpr size_t HEADER_POW_CHECK_BATCH{8};
+
+/** Context-free proof of work check of a few headers, the auxpow merkle branches and parent PoW for merge-mined ones */
+class CHeaderPoWCheck
+{
+private:
+    Span<const CBlockHeader> m_headers;
+    const Consensus::Params* m_params;
+
+public:
+    CHeaderPoWCheck(Span<const CBlockHeader> headers, const Consensus::Params& params) : m_headers(headers), m_params(&params) {}
+
+    bool operator()() const
+    {
+        return CheckProofOfWork(m_headers, *m_params);
+    }
+};
+static CCheckQueue<CHeaderPoWCheck> headercheckqueue(16);
 
 void StartScriptCheckWorkerThreads(int threads_num)
 {
     scriptcheckqueue.StartWorkerThreads(threads_num);
     blobcheckqueue.StartWorkerThreads(threads_num);
+    mintcheckqueue.StartWorkerThreads(threads_num);
+    headercheckqueue.StartWorkerThreads(threads_num);
 }
 
 void StopScriptCheckWorkerThreads()
 {
     scriptcheckqueue.StopWorkerThreads();
     blobcheckqueue.StopWorkerThreads();
+    mintcheckqueue.StopWorkerThreads();
+    headercheckqueue.StopWorkerThreads();
 }
 
 // SYSCOIN
@@ -2577,7 +2836,7 @@ public:
     }
 };
 
-static unsigned int GetBlockScriptFlags(const CBlockIndex& block_index, const ChainstateManager& chainman)
+unsigned int GetBlockScriptFlags(const CBlockIndex& block_index, const ChainstateManager& chainman)
 {
     const Consensus::Params& consensusparams = chainman.GetConsensus();
 
@@ -2628,6 +2887,9 @@ static SteadyClock::duration time_index{};
 static SteadyClock::duration time_total{};
 static int64_t num_blocks_total = 0;
 // SYSCOIN
+static SteadyClock::duration time_special{};
+static SteadyClock::duration time_nevm{};
+// SYSCOIN
 bool Chainstate::ConnectBlock(const CBlock& block, BlockValidationState& state, CBlockIndex* pindex,
                   CCoinsViewCache& view, bool fJustCheck, bool bReverify) {
     NEVMMintTxSet setMintTxs;
@@ -2724,6 +2986,17 @@ bool Chainstate::ConnectBlock(const CBlock& block, BlockValidationState& state,
             }
         }
     }
+    // SYSCOIN
+    const bool fAssumedValid = !fScriptChecks;
+    // the background chainstate replays blocks whose mints were already imported alongside the snapshot
+    bool fCheckMinted = true;
+    if (!m_from_snapshot_blockhash && m_chainman.IsSnapshotActive()) {
+        const std::optional<int> snapshot_height = m_chainman.GetSnapshotBaseHeight();
+        if (snapshot_height && pindex->nHeight <= *snapshot_height) {
+            const auto au_data = params.AssumeutxoForHeight(*snapshot_height);
+            fCheckMinted = !au_data || au_data->hash_auxiliary.IsNull();
+        }
+    }
 
     const auto time_1{SteadyClock::now()};
     time_check += time_1 - time_start;
@@ -2844,6 +3117,9 @@ bool Chainstate::ConnectBlock(const CBlock& block, BlockValidationState& state,
     // for as long as `control`.
     CCheckQueueControl<CScriptCheck> control(fScriptChecks && parallel_script_checks ? &scriptcheckqueue : nullptr);
     std::vector<PrecomputedTransactionData> txsdata(block.vtx.size());
+    // SYSCOIN
+    const bool parallel_mint_checks{mintcheckqueue.HasThreads()};
+    CCheckQueueControl<CMintProofCheck> mintcontrol(parallel_mint_checks ? &mintcheckqueue : nullptr);
 
     std::vector<int> prevheights;
     CAmount nFees = 0;
@@ -2861,11 +3137,51 @@ bool Chainstate::ConnectBlock(const CBlock& block, BlockValidationState& state,
                      pindex->GetBlockHash().ToString().c_str(), state.ToString().c_str());
         return state.Invalid(BlockValidationResult::BLOCK_CONSENSUS, state.ToString());
     }
+    const auto time_2_special{SteadyClock::now()};
+    time_special += time_2_special - time_2;
+    LogPrint(BCLog::BENCHMARK, "      - Special txs: %.2fms [%.2fs (%.2fms/blk)]\n",
+             Ticks<MillisecondsDouble>(time_2_special - time_2),
+             Ticks<SecondsDouble>(time_special),
+             Ticks<MillisecondsDouble>(time_special) / num_blocks_total);
+    // The PoDA blobs only need the block, not the UTXO set, so they are hashed and checked on their own thread
+    // while the inputs are connected below. Its arguments are read here, the thread touches nothing cs_main guards.
+    // The NEVM commitment is sent to Geth only once every other check passed, see below.
+    const bool PODAContext = pindex->nHeight >= params.GetConsensus().nPODAStartBlock;
+    const bool bRegTestContext = !fRegTest || (fRegTest && fNEVMConnection);
+    const bool fNEVMStage = bRegTestContext && bReverify && pindex->nHeight >= params.GetConsensus().nNEVMStartBlock;
+    SteadyClock::duration nevm_duration{};
+    // blocks rolled back by SettleNEVMPipeline are not pipelined again, so the Geth verdict lands on the right one
+    const bool fNEVMPipelined = fAssumedValid && pindex->nHeight > m_nevm_lockstep_height;
+    std::future<bool> poda_result;
+    if (PODAContext) {
+        const int64_t nMedianTime{pindex->GetMedianTimePast()};
+        const int64_t nTimeNow{TicksSinceEpoch<std::chrono::seconds>(m_chainman.m_options.adjusted_time_callback())};
+        poda_result = std::async(std::launch::async, [&, nMedianTime, nTimeNow] {
+            const auto poda_start{SteadyClock::now()};
+            const bool res{ProcessNEVMData(m_chainman.m_blockman, block, nMedianTime, nTimeNow, mapPoDA)};
+            nevm_duration = SteadyClock::now() - poda_start;
+            return res;
+        });
+    }
     if (fNexusContext && (!(block.vtx[0]->nVersion <= CTransaction::CURRENT_VERSION || 
         block.vtx[0]->nVersion == SYSCOIN_TX_VERSION_MN_QUORUM_COMMITMENT))) {
         return state.Invalid(BlockValidationResult::BLOCK_CONSENSUS, "bad-cb-version", 
                             strprintf("Coinbase transaction must be standard or explicitly allowed MN versions: %d", block.vtx[0]->nVersion));
     }
+    // SYSCOIN the mints look up their NEVM block roots and minted transfers one by one, read them in one pass first
+    {
+        std::vector<uint256> vecMintBlockHashes, vecMintTxHashes;
+        for (const auto& tx : block.vtx) {
+            if (!GetMintTxHash(*tx)) continue;
+            const auto& mintSyscoin = tx->GetMintSyscoin();
+            vecMintBlockHashes.emplace_back(mintSyscoin->nBlockHash);
+            vecMintTxHashes.emplace_back(mintSyscoin->nTxHash);
+        }
+        if (!vecMintTxHashes.empty()) {
+            if (pnevmtxrootsdb) pnevmtxrootsdb->PrefetchTxRoots(vecMintBlockHashes);
+            if (fCheckMinted && pnevmtxmintdb) pnevmtxmintdb->PrefetchTxs(vecMintTxHashes);
+        }
+    }
 
     for (unsigned int i = 0; i < block.vtx.size(); i++)
     {
@@ -2891,12 +3207,18 @@ bool Chainstate::ConnectBlock(const CBlock& block, BlockValidationState& state,
             // SYSCOIN
             TxValidationState tx_statesys;
             // just temp var not used in !fJustCheck mode
-            if (!CheckSyscoinInputs(params.GetConsensus(), tx, txHash, tx_statesys, (uint32_t)pindex->nHeight, fJustCheck, setMintTxs, mapAssetIn, mapAssetOut)){
+            std::vector<CMintProofCheck> vMintChecks;
+            // under assumevalid the mint proofs are collected but never run, like the script checks; the mint itself
+            // (its bridge id and asset amounts) is still checked and recorded
+            if (!CheckSyscoinInputs(params.GetConsensus(), tx, txHash, tx_statesys, (uint32_t)pindex->nHeight, fJustCheck, setMintTxs, mapAssetIn, mapAssetOut, parallel_mint_checks || fAssumedValid ? &vMintChecks : nullptr, fCheckMinted)){
                 // Any transaction validation failure in ConnectBlock is a block consensus failure
                 state.Invalid(BlockValidationResult::BLOCK_CONSENSUS,
                             tx_statesys.GetRejectReason(), tx_statesys.GetDebugMessage());
                 return error("%s: Consensus::CheckSyscoinInputs: %s, %s", __func__, tx.GetHash().ToString(), state.ToString());
             }
+            if (!fAssumedValid) {
+                mintcontrol.Add(std::move(vMintChecks));
+            }
             
             nFees += txfee;
             if (!MoneyRange(nFees)) {
@@ -2948,14 +3270,16 @@ bool Chainstate::ConnectBlock(const CBlock& block, BlockValidationState& state,
         }
         UpdateCoins(tx, view, i == 0 ? undoDummy : blockundo.vtxundo.back(), pindex->nHeight);
     }
-    bool PODAContext = pindex->nHeight >= params.GetConsensus().nPODAStartBlock;
-    if(PODAContext && !ProcessNEVMData(m_chainman.m_blockman, block, pindex->GetMedianTimePast(), TicksSinceEpoch<std::chrono::seconds>(m_chainman.m_options.adjusted_time_callback()), mapPoDA)) {
-        return state.Invalid(BlockValidationResult::BLOCK_CONSENSUS, "poda-validation-failed");
-    }
-
-    bool bRegTestContext = !fRegTest || (fRegTest && fNEVMConnection);
-    if (bRegTestContext && bReverify && pindex->nHeight >= params.GetConsensus().nNEVMStartBlock && !ConnectNEVMCommitment(state, mapNEVMTxRoots, block, blockHash, (uint32_t)pindex->nHeight, fJustCheck, mapPoDA, diff)) {
-        return false; // state filled by ConnectNEVMCommitment
+    // SYSCOIN
+    if (poda_result.valid()) {
+        const auto time_3_wait{SteadyClock::now()};
+        const bool fPoDAValid = poda_result.get();
+        LogPrint(BCLog::BENCHMARK, "      - PoDA blobs: %.2fms, waited %.2fms\n",
+                 Ticks<MillisecondsDouble>(nevm_duration),
+                 Ticks<MillisecondsDouble>(SteadyClock::now() - time_3_wait));
+        if (!fPoDAValid) {
+            return state.Invalid(BlockValidationResult::BLOCK_CONSENSUS, "poda-validation-failed");
+        }
     }
     const auto time_3{SteadyClock::now()};
     time_connect += time_3 - time_2;
@@ -2970,6 +3294,16 @@ bool Chainstate::ConnectBlock(const CBlock& block, BlockValidationState& state,
         LogPrintf("ERROR: %s: CheckQueue failed\n", __func__);
         return state.Invalid(BlockValidationResult::BLOCK_CONSENSUS, "block-validation-failed");
     }
+    // SYSCOIN
+    if (!mintcontrol.Wait()){
+        // the queue only reports that a proof failed, find it again to reject with the reason of the inline path
+        std::string strError{"block-validation-failed"};
+        for (const auto& tx : block.vtx) {
+            if (GetMintTxHash(*tx) && !CMintProofCheck(tx->GetMintSyscoin()).Verify(strError)) break;
+        }
+        LogPrintf("ERROR: %s: mint proof CheckQueue failed: %s\n", __func__, strError);
+        return state.Invalid(BlockValidationResult::BLOCK_CONSENSUS, strError);
+    }
     // SYSCOIN : MODIFIED TO CHECK MASTERNODE PAYMENTS AND SUPERBLOCKS
     if(fNexusContext) {
         const CAmount blockReward = GetBlockSubsidy(pindex->nHeight, params.GetConsensus());
@@ -2995,6 +3329,24 @@ bool Chainstate::ConnectBlock(const CBlock& block, BlockValidationState& state,
             return state.Invalid(BlockValidationResult::BLOCK_CHAINLOCK, "bad-chainlock");
         }
     }
+    // Geth only ever sees blocks that passed every other check, so an invalid block never has to be taken back
+    if (fNEVMStage) {
+        const auto nevm_start{SteadyClock::now()};
+        const bool fNEVMValid = ConnectNEVMCommitment(state, mapNEVMTxRoots, block, blockHash, (uint32_t)pindex->nHeight, fJustCheck, mapPoDA, diff, fNEVMPipelined);
+        nevm_duration += SteadyClock::now() - nevm_start;
+        if (!fNEVMValid) {
+            return false; // state filled by ConnectNEVMCommitment
+        }
+    }
+    if (PODAContext || fNEVMStage) {
+        time_nevm += nevm_duration;
+        static metrics::Histogram& nevm_seconds{metrics::GetHistogram("syscoin_nevm_commitment_seconds", "Time to check the PoDA blobs and NEVM commitment of a block")};
+        nevm_seconds.ObserveDuration(std::chrono::duration_cast<std::chrono::microseconds>(nevm_duration));
+        LogPrint(BCLog::BENCHMARK, "      - PoDA and NEVM commitment: %.2fms [%.2fs (%.2fms/blk)]\n",
+                 Ticks<MillisecondsDouble>(nevm_duration),
+                 Ticks<SecondsDouble>(time_nevm),
+                 Ticks<MillisecondsDouble>(time_nevm) / num_blocks_total);
+    }
     // END SYSCOIN
     const auto time_4{SteadyClock::now()};
     time_verify += time_4 - time_2;
@@ -3181,8 +3533,10 @@ bool Chainstate::FlushStateToDisk(
 
                 m_blockman.UnlinkPrunedFiles(setFilesToPrune);
             }
-            // SYSCOIN
-            if (pnevmdatadb && !pnevmdatadb->FlushCacheToDisk(m_chain.Tip()->GetMedianTimePast())) {
+            // SYSCOIN with -syscoinstatedb the databases below share one LevelDB and are synced once
+            if (psyscoinstatedb) psyscoinstatedb->DeferSync();
+            // a snapshot chainstate that has not been loaded yet has no tip, nothing is old enough to prune then
+            if (pnevmdatadb && !pnevmdatadb->FlushCacheToDisk(m_chain.Tip() ? m_chain.Tip()->GetMedianTimePast() : 0)) {
                 return FatalError(m_chainman.GetNotifications(), state, "Failed to commit PoDA");
             }
             if (pblockindexdb && !pblockindexdb->FlushCacheToDisk((uint32_t)m_chain.Height())) {
@@ -3206,6 +3560,9 @@ bool Chainstate::FlushStateToDisk(
             if (llmq::quorumManager && !llmq::quorumManager->FlushCacheToDisk(mode == FlushStateMode::ALWAYS)) {
                 return FatalError(m_chainman.GetNotifications(), state, "Failed to commit QM DB");
             }
+            if (psyscoinstatedb && !psyscoinstatedb->FlushDeferredSync()) {
+                return FatalError(m_chainman.GetNotifications(), state, "Failed to sync Syscoin state DB");
+            }
             
             m_last_write = nNow;
         }
@@ -3225,6 +3582,10 @@ bool Chainstate::FlushStateToDisk(
             // Flush the chainstate (which may refer to block index entries).
             if (!CoinsTip().Flush())
                 return FatalError(m_chainman.GetNotifications(), state, "Failed to write to coin database");
+            // SYSCOIN the coins may be written behind, the Syscoin databases above were committed at this
+            // tip first so the coins head never gets ahead of them. Forced flushes have to be durable.
+            if (mode == FlushStateMode::ALWAYS && !CoinsDB().WaitForPendingWrite())
+                return FatalError(m_chainman.GetNotifications(), state, "Failed to write to coin database");
 
             m_last_flush = nNow;
             full_flush_completed = true;
@@ -3362,7 +3723,7 @@ void Chainstate::UpdateTip(const CBlockIndex* pindexNew)
   * in any case).
   */
  // SYSCOIN
-bool Chainstate::DisconnectTip(BlockValidationState& state, DisconnectedBlockTransactions* disconnectpool, bool bReverify)
+bool Chainstate::DisconnectTip(BlockValidationState& state, DisconnectedBlockTransactions* disconnectpool, bool bReverify, NEVMDisconnectBatch* nevmBatch)
 {
     AssertLockHeld(cs_main);
     if (m_mempool) AssertLockHeld(m_mempool->cs);
@@ -3385,13 +3746,14 @@ bool Chainstate::DisconnectTip(BlockValidationState& state, DisconnectedBlockTra
     {
         CCoinsViewCache view(&CoinsTip());
         assert(view.GetBestBlock() == pindexDelete->GetBlockHash());
-        if (DisconnectBlock(block, pindexDelete, view, setMintTxs, vecNEVMBlocks, vecTXIDPairs, bReverify) != DISCONNECT_OK)
+        if (DisconnectBlock(block, pindexDelete, view, nevmBatch ? nevmBatch->setMintTxs : setMintTxs, nevmBatch ? nevmBatch->vecNEVMBlocks : vecNEVMBlocks,
+                nevmBatch ? nevmBatch->vecTXIDPairs : vecTXIDPairs, bReverify, false /*bReplay*/, nevmBatch ? &nevmBatch->vecDisconnects : nullptr) != DISCONNECT_OK)
             return error("DisconnectTip(): DisconnectBlock %s failed", pindexDelete->GetBlockHash().ToString());
         bool flushed = view.Flush();
         assert(flushed);
     }
     // SYSCOIN
-    if(pnevmtxmintdb != nullptr){
+    if(pnevmtxmintdb != nullptr && !nevmBatch){
         if(!pnevmtxmintdb->FlushErase(setMintTxs) || !pnevmtxrootsdb->FlushErase(vecNEVMBlocks) || !pblockindexdb->FlushErase(vecTXIDPairs)){
             return error("DisconnectTip(): Error flushing to asset dbs on disconnect %s", pindexDelete->GetBlockHash().ToString());
         }
@@ -3411,8 +3773,15 @@ bool Chainstate::DisconnectTip(BlockValidationState& state, DisconnectedBlockTra
     }
 
     // Write the chain state to disk, if necessary.
-    if (!FlushStateToDisk(state, FlushStateMode::IF_NEEDED)) {
-        return false;
+    // SYSCOIN a batched disconnect only writes once the cache is critical, and then the NEVM side of the blocks so far goes first
+    // so the coins on disk never run ahead of Geth and the NEVM databases. Otherwise the caller writes after FlushNEVMDisconnectBatch.
+    if (!nevmBatch || GetCoinsCacheSizeState() >= CoinsCacheSizeState::CRITICAL) {
+        if (nevmBatch && !FlushNEVMDisconnectBatch(*nevmBatch)) {
+            return error("DisconnectTip(): Error flushing NEVM disconnects at %s", pindexDelete->GetBlockHash().ToString());
+        }
+        if (!FlushStateToDisk(state, FlushStateMode::IF_NEEDED)) {
+            return false;
+        }
     }
 
     if (disconnectpool && m_mempool) {
@@ -3432,10 +3801,56 @@ bool Chainstate::DisconnectTip(BlockValidationState& state, DisconnectedBlockTra
     return true;
 }
 
+// SYSCOIN
+bool Chainstate::FlushNEVMDisconnectBatch(NEVMDisconnectBatch& nevmBatch)
+{
+    AssertLockHeld(cs_main);
+    if(!nevmBatch.vecDisconnects.empty() && fNEVMConnection && !nevmBatch.fSkipGeth) {
+        std::string stateStr;
+        const auto time_start{SteadyClock::now()};
+        GetMainSignals().NotifyNEVMBlocksDisconnect(stateStr, nevmBatch.vecDisconnects);
+        LogPrint(BCLog::BENCHMARK, "    - NEVM disconnect of %u blocks: %.2fms\n", nevmBatch.vecDisconnects.size(), Ticks<MillisecondsDouble>(SteadyClock::now() - time_start));
+        if(!stateStr.empty()) {
+            return error("FlushNEVMDisconnectBatch(): NEVM failed to disconnect %u blocks: %s", nevmBatch.vecDisconnects.size(), stateStr);
+        }
+    }
+    if(pnevmtxmintdb != nullptr){
+        if(!pnevmtxmintdb->FlushErase(nevmBatch.setMintTxs) || !pnevmtxrootsdb->FlushErase(nevmBatch.vecNEVMBlocks) || !pblockindexdb->FlushErase(nevmBatch.vecTXIDPairs)){
+            return error("FlushNEVMDisconnectBatch(): Error flushing to asset dbs on disconnect");
+        }
+    }
+    nevmBatch.setMintTxs.clear();
+    nevmBatch.vecNEVMBlocks.clear();
+    nevmBatch.vecTXIDPairs.clear();
+    nevmBatch.vecDisconnects.clear();
+    return true;
+}
+
 static SteadyClock::duration time_connect_total{};
 static SteadyClock::duration time_flush{};
 static SteadyClock::duration time_chainstate{};
 static SteadyClock::duration time_post_connect{};
+// SYSCOIN
+BlockConnectTimings GetBlockConnectTimings()
+{
+    AssertLockHeld(cs_main);
+    BlockConnectTimings timings;
+    timings.blocks = num_blocks_total;
+    timings.check = time_check;
+    timings.forks = time_forks;
+    timings.special = time_special;
+    timings.nevm = time_nevm;
+    timings.connect = time_connect;
+    timings.verify = time_verify;
+    timings.undo = time_undo;
+    timings.index = time_index;
+    timings.connect_total = time_connect_total;
+    timings.flush = time_flush;
+    timings.chainstate = time_chainstate;
+    timings.post_connect = time_post_connect;
+    timings.total = time_total;
+    return timings;
+}
 
 struct PerBlockConnectTrace {
     CBlockIndex* pindex = nullptr;
@@ -3581,6 +3996,13 @@ bool Chainstate::ConnectTip(BlockValidationState& state, CBlockIndex* pindexNew,
              Ticks<MillisecondsDouble>(time_6 - time_1),
              Ticks<SecondsDouble>(time_total),
              Ticks<MillisecondsDouble>(time_total) / num_blocks_total);
+    // SYSCOIN
+    static metrics::Counter& blocks_connected{metrics::GetCounter("syscoin_blocks_connected_total", "Blocks connected to a chainstate")};
+    static metrics::Histogram& connect_seconds{metrics::GetHistogram("syscoin_block_connect_seconds", "Time to connect a block, from loading it to updating the tip")};
+    static metrics::Gauge& chain_height{metrics::GetGauge("syscoin_chain_height", "Height of the active chain tip")};
+    blocks_connected.Inc();
+    connect_seconds.ObserveDuration(std::chrono::duration_cast<std::chrono::microseconds>(time_6 - time_1));
+    if (this == &m_chainman.ActiveChainstate()) chain_height.Set(pindexNew->nHeight);
 
     // If we are the background validation chainstate, check to see if we are done
     // validating the snapshot (i.e. our tip has reached the snapshot's base block).
@@ -3688,14 +4110,25 @@ bool Chainstate::ActivateBestChainStep(BlockValidationState& state, CBlockIndex*
     AssertLockHeld(cs_main);
     if (m_mempool) AssertLockHeld(m_mempool->cs);
 
+    bool fBlocksDisconnected = false;
+    DisconnectedBlockTransactions disconnectpool{MAX_DISCONNECTED_TX_POOL_SIZE * 1000};
+    // SYSCOIN Geth can only be rewound over blocks it acked, and a failed pipelined connect is rolled back before anything else
+    if (m_chain.FindFork(pindexMostWork) != m_chain.Tip()) {
+        CheckNEVMPipeline();
+    }
+    if (!SettleNEVMPipeline(state, disconnectpool, fBlocksDisconnected)) {
+        MaybeUpdateMempoolForReorg(disconnectpool, false);
+        return false;
+    }
+
     const CBlockIndex* pindexOldTip = m_chain.Tip();
     const CBlockIndex* pindexFork = m_chain.FindFork(pindexMostWork);
 
     // Disconnect active blocks which are no longer in the best chain.
-    bool fBlocksDisconnected = false;
-    DisconnectedBlockTransactions disconnectpool{MAX_DISCONNECTED_TX_POOL_SIZE * 1000};
+    // SYSCOIN one Geth rewind and one erase of the NEVM databases for all blocks disconnected here
+    NEVMDisconnectBatch nevmBatch;
     while (m_chain.Tip() && m_chain.Tip() != pindexFork) {
-        if (!DisconnectTip(state, &disconnectpool)) {
+        if (!DisconnectTip(state, &disconnectpool, true /*bReverify*/, &nevmBatch)) {
             // This is likely a fatal error, but keep the mempool consistent,
             // just in case. Only remove from the mempool in this case.
             MaybeUpdateMempoolForReorg(disconnectpool, false);
@@ -3707,6 +4140,12 @@ bool Chainstate::ActivateBestChainStep(BlockValidationState& state, CBlockIndex*
         }
         fBlocksDisconnected = true;
     }
+    // SYSCOIN
+    if (fBlocksDisconnected && (!FlushNEVMDisconnectBatch(nevmBatch) || !FlushStateToDisk(state, FlushStateMode::IF_NEEDED))) {
+        MaybeUpdateMempoolForReorg(disconnectpool, false);
+        FatalError(m_chainman.GetNotifications(), state, "Failed to disconnect block; see debug.log for details");
+        return false;
+    }
 
     // Build list of new blocks to connect (in descending height order).
     std::vector<CBlockIndex*> vpindexToConnect;
@@ -3737,6 +4176,12 @@ bool Chainstate::ActivateBestChainStep(BlockValidationState& state, CBlockIndex*
                     fInvalidFound = true;
                     fContinue = false;
                     break;
+                } else if (state.GetRejectReason() == "nevm-pipeline-failed") {
+                    // SYSCOIN the blocks connected so far are announced before the next step rolls them back
+                    CheckNEVMPipeline();
+                    state = BlockValidationState();
+                    fContinue = false;
+                    break;
                 } else {
                     // A system error occurred (disk space, database error, ...).
                     // Make the mempool consistent with the current tip, just in case
@@ -3755,6 +4200,12 @@ bool Chainstate::ActivateBestChainStep(BlockValidationState& state, CBlockIndex*
         }
     }
 
+    // SYSCOIN nothing more to connect for now, so a partially filled batch has to reach Geth and the pipelined
+    // connects must have been acked before the tip is announced
+    if (m_chain.Tip() == pindexMostWork) {
+        CheckNEVMPipeline();
+    }
+
     if (fBlocksDisconnected) {
         // If any blocks were disconnected, disconnectpool may be non empty.  Add
         // any disconnected transactions back to the mempool.
@@ -3767,6 +4218,58 @@ bool Chainstate::ActivateBestChainStep(BlockValidationState& state, CBlockIndex*
     return true;
 }
 
+// SYSCOIN
+void Chainstate::CheckNEVMPipeline()
+{
+    AssertLockHeld(cs_main);
+    if (!fNEVMConnection) {
+        return;
+    }
+    std::string stateStr;
+    uint256 nFailedBlockHash;
+    GetMainSignals().NotifyNEVMFlush(stateStr, nFailedBlockHash);
+    if (nFailedBlockHash.IsNull()) {
+        return;
+    }
+    LogPrintf("%s: Geth failed to connect block %s: %s\n", __func__, nFailedBlockHash.ToString(), stateStr);
+    m_nevm_failed_block = nFailedBlockHash;
+    // the block whose connect ran into the failure was sent as well, it is the one after the tip
+    m_nevm_lockstep_height = std::max(m_nevm_lockstep_height, m_chain.Height() + 1);
+}
+
+bool Chainstate::SettleNEVMPipeline(BlockValidationState& state, DisconnectedBlockTransactions& disconnectpool, bool& fBlocksDisconnected)
+{
+    AssertLockHeld(cs_main);
+    if (m_mempool) AssertLockHeld(m_mempool->cs);
+    if (m_nevm_failed_block.IsNull()) {
+        return true;
+    }
+    const CBlockIndex* pindexFailed = m_blockman.LookupBlockIndex(m_nevm_failed_block);
+    m_nevm_failed_block.SetNull();
+    if (!pindexFailed || !m_chain.Contains(pindexFailed)) {
+        // that block itself failed, nothing after it is in the chain
+        return true;
+    }
+    LogPrintf("%s: rolling back to height %d below block %s\n", __func__, pindexFailed->nHeight - 1, pindexFailed->GetBlockHash().ToString());
+    CBlockIndex* pindexOldTip = m_chain.Tip();
+    NEVMDisconnectBatch nevmBatch;
+    nevmBatch.fSkipGeth = true;
+    while (m_chain.Tip() != pindexFailed->pprev) {
+        if (!DisconnectTip(state, &disconnectpool, true /*bReverify*/, &nevmBatch)) {
+            return FatalError(m_chainman.GetNotifications(), state, "Failed to roll back the blocks Geth did not connect; see debug.log for details");
+        }
+        fBlocksDisconnected = true;
+    }
+    if (!FlushNEVMDisconnectBatch(nevmBatch) || !FlushStateToDisk(state, FlushStateMode::IF_NEEDED)) {
+        return FatalError(m_chainman.GetNotifications(), state, "Failed to roll back the blocks Geth did not connect; see debug.log for details");
+    }
+    // nothing is wrong with the old tip as far as we know, keep it up for connecting again
+    if (pindexOldTip->IsValid(BLOCK_VALID_TRANSACTIONS) && pindexOldTip->HaveNumChainTxs()) {
+        setBlockIndexCandidates.insert(pindexOldTip);
+    }
+    return true;
+}
+
 static SynchronizationState GetSynchronizationState(bool init)
 {
     if (!init) return SynchronizationState::POST_INIT;
@@ -3802,7 +4305,11 @@ static bool NotifyHeaderTip(ChainstateManager& chainman) LOCKS_EXCLUDED(cs_main)
 static void LimitValidationInterfaceQueue() LOCKS_EXCLUDED(cs_main) {
     AssertLockNotHeld(cs_main);
     if (GetMainSignals().CallbacksPending() > 10) {
-        SyncWithValidationInterfaceQueue();
+        // SYSCOIN only the shared queue, wallets keep up on their own queues and hold
+        // validation back through their bounded backlog alone
+        std::promise<void> promise;
+        CallFunctionInValidationInterfaceQueue([&promise] { promise.set_value(); });
+        promise.get_future().wait();
     }
 }
 
@@ -3857,7 +4364,8 @@ bool Chainstate::ActivateBestChain(BlockValidationState& state, std::shared_ptr<
                 }
 
                 // Whether we have anything to do at all.
-                if (pindexMostWork == nullptr || pindexMostWork == m_chain.Tip()) {
+                // SYSCOIN unless Geth failed a block that is to be rolled back
+                if (pindexMostWork == nullptr || (pindexMostWork == m_chain.Tip() && m_nevm_failed_block.IsNull())) {
                     break;
                 }
 
@@ -3889,7 +4397,8 @@ bool Chainstate::ActivateBestChain(BlockValidationState& state, std::shared_ptr<
                 if (m_disabled) {
                     break;
                 }
-            } while (!m_chain.Tip() || (starting_tip && CBlockIndexWorkComparator()(m_chain.Tip(), starting_tip)));
+            // SYSCOIN a block Geth failed to connect is rolled back before the tip is announced
+            } while (!m_chain.Tip() || (starting_tip && CBlockIndexWorkComparator()(m_chain.Tip(), starting_tip)) || !m_nevm_failed_block.IsNull());
             if (!blocks_connected) return true;
             const CBlockIndex* pindexFork = m_chain.FindFork(starting_tip);
             bool still_in_ibd = m_chainman.IsInitialBlockDownload();
@@ -4558,9 +5067,22 @@ std::vector<unsigned char> ChainstateManager::GenerateCoinbaseCommitment(CBlock&
 
 bool HasValidProofOfWork(const std::vector<CBlockHeader>& headers, const Consensus::Params& consensusParams)
 {
-    // SYSCOIN
-    return std::all_of(headers.cbegin(), headers.cend(),
-            [&](const auto& header) { return CheckProofOfWork(header, consensusParams);});
+    // SYSCOIN a HEADERS batch is checked on the check queue, auxpow headers cost a merkle branch and a parent hash each
+    if (headers.size() > 1 && headercheckqueue.HasThreads()) {
+        CCheckQueueControl<CHeaderPoWCheck> control(&headercheckqueue);
+        std::vector<CHeaderPoWCheck> vChecks;
+        const Span<const CBlockHeader> all{headers};
+        vChecks.reserve((headers.size() + HEADER_POW_CHECK_BATCH - 1) / HEADER_POW_CHECK_BATCH);
+        for (size_t i = 0; i < headers.size(); i += HEADER_POW_CHECK_BATCH) {
+            vChecks.emplace_back(all.subspan(i, std::min(HEADER_POW_CHECK_BATCH, headers.size() - i)), consensusParams);
+        }
+        control.Add(std::move(vChecks));
+        return control.Wait();
+    }
+    for (size_t i = 0; i < headers.size(); i += HEADER_POW_CHECK_BATCH) {
+        if (!CheckProofOfWork(Span<const CBlockHeader>{headers}.subspan(i, std::min(HEADER_POW_CHECK_BATCH, headers.size() - i)), consensusParams)) return false;
+    }
+    return true;
 }
 
 arith_uint256 CalculateHeadersWork(const std::vector<CBlockHeader>& headers)
@@ -4800,7 +5322,7 @@ static bool ContextualCheckBlock(const CBlock& block, BlockValidationState& stat
     }
     return true;
 }
-bool ChainstateManager::AcceptBlockHeader(const CBlockHeader& block, BlockValidationState& state, CBlockIndex** ppindex, bool min_pow_checked, bool bForBlock)
+bool ChainstateManager::AcceptBlockHeader(const CBlockHeader& block, BlockValidationState& state, CBlockIndex** ppindex, bool min_pow_checked, bool bForBlock, bool fCheckPOW)
 {
     AssertLockHeld(cs_main);
     // Check for duplicate
@@ -4827,7 +5349,7 @@ bool ChainstateManager::AcceptBlockHeader(const CBlockHeader& block, BlockValida
             return true;
         }
 
-        if (!CheckBlockHeader(block, state, GetConsensus())) {
+        if (!CheckBlockHeader(block, state, GetConsensus(), fCheckPOW)) {
             LogPrint(BCLog::VALIDATION, "%s: Consensus::CheckBlockHeader: %s, %s\n", __func__, hash.ToString(), state.ToString());
             return false;
         }
@@ -4941,7 +5463,7 @@ bool ChainstateManager::AcceptBlockHeader(const CBlockHeader& block, BlockValida
 }
 
 // Exposed wrapper for AcceptBlockHeader
-bool ChainstateManager::ProcessNewBlockHeaders(const std::vector<CBlockHeader>& headers, bool min_pow_checked, BlockValidationState& state, const CBlockIndex** ppindex)
+bool ChainstateManager::ProcessNewBlockHeaders(const std::vector<CBlockHeader>& headers, bool min_pow_checked, BlockValidationState& state, const CBlockIndex** ppindex, bool pow_checked)
 {
     AssertLockNotHeld(cs_main);
     {
@@ -4949,7 +5471,7 @@ bool ChainstateManager::ProcessNewBlockHeaders(const std::vector<CBlockHeader>&
         for (const CBlockHeader& header : headers) {
             CBlockIndex *pindex = nullptr; // Use a temp pindex instead of ppindex to avoid a const_cast
             // SYSCOIN
-            bool accepted{AcceptBlockHeader(header, state, &pindex, min_pow_checked, false)};
+            bool accepted{AcceptBlockHeader(header, state, &pindex, min_pow_checked, false, !pow_checked)};
             CheckBlockIndex();
 
             if (!accepted) {
@@ -5125,6 +5647,10 @@ bool ChainstateManager::ProcessNewBlock(const std::shared_ptr<const CBlock>& blo
             GetMainSignals().BlockChecked(*block, state);
             return error("%s: AcceptBlock FAILED (%s)", __func__, state.ToString());
         }
+        // SYSCOIN the inputs of a block that connects next are read while the chain gets to it
+        if (pindex && pindex->pprev == ActiveChain().Tip()) {
+            ActiveChainstate().PrefetchCoins(*block);
+        }
     }
 
     NotifyHeaderTip(*this);
@@ -5641,11 +6167,28 @@ bool Chainstate::LoadGenesisBlock()
 void ChainstateManager::LoadExternalBlockFile(
     CAutoFile& file_in,
     FlatFilePos* dbp,
-    std::multimap<uint256, FlatFilePos>* blocks_with_unknown_parent)
+    std::multimap<uint256, FlatFilePos>* blocks_with_unknown_parent,
+    node::PrefetchedBlocks* prefetched)
 {
     // Either both should be specified (-reindex), or neither (-loadblock).
     assert(!dbp == !blocks_with_unknown_parent);
 
+    // SYSCOIN a block of the file read ahead is taken over, its PoDA blobs are merged back in like ReadBlockFromDisk does
+    const auto read_block = [&](CBlock& block, const FlatFilePos& pos) {
+        if (prefetched && dbp && pos.nFile == dbp->nFile) {
+            auto it = prefetched->find(pos.nPos);
+            if (it != prefetched->end()) {
+                block = std::move(*it->second);
+                prefetched->erase(it);
+                if (!FillNEVMData(block)) {
+                    return error("%s: FillNEVMData() failed for %s", __func__, block.GetHash().GetHex());
+                }
+                return true;
+            }
+        }
+        return m_blockman.ReadBlockFromDisk(block, pos);
+    };
+
     const auto start{SteadyClock::now()};
     const CChainParams& params{GetParams()};
 
@@ -5715,7 +6258,7 @@ void ChainstateManager::LoadExternalBlockFile(
                         bool fReadBlockOk = false;
                         if (dbp) {
                             // Use ReadBlockFromDisk when dbp is provided (e.g., for specific block lookups)
-                            if (m_blockman.ReadBlockFromDisk(*pblock, *dbp)) {
+                            if (read_block(*pblock, *dbp)) {
                                 fReadBlockOk = true;
                             } else {
                                 LogPrint(BCLog::REINDEX, "Failed to read block %s using ReadBlockFromDisk\n", hash.ToString());
@@ -5803,7 +6346,7 @@ void ChainstateManager::LoadExternalBlockFile(
                     while (range.first != range.second) {
                         std::multimap<uint256, FlatFilePos>::iterator it = range.first;
                         std::shared_ptr<CBlock> pblockrecursive = std::make_shared<CBlock>();
-                        if (m_blockman.ReadBlockFromDisk(*pblockrecursive, it->second)) {
+                        if (read_block(*pblockrecursive, it->second)) {
                             LogPrint(BCLog::REINDEX, "%s: Processing out of order child %s of %s\n", __func__, pblockrecursive->GetHash().ToString(),
                                     head.ToString());
                             LOCK(cs_main);
@@ -6112,6 +6655,25 @@ std::string Chainstate::ToString()
                      tip ? tip->nHeight : -1, tip ? tip->GetBlockHash().ToString() : "null");
 }
 
+void Chainstate::PrefetchCoins(const CBlock& block)
+{
+    AssertLockHeld(::cs_main);
+    if (!m_coins_views || !m_coins_views->m_cacheview) return;
+    const CCoinsViewCache& coins_tip{CoinsTip()};
+    std::unordered_set<uint256, SaltedTxidHasher> block_txids;
+    std::vector<COutPoint> outpoints;
+    for (const auto& tx : block.vtx) {
+        block_txids.insert(tx->GetHash());
+        if (tx->IsCoinBase()) continue;
+        for (const CTxIn& txin : tx->vin) {
+            // coins created in the block itself are not on disk yet
+            if (block_txids.count(txin.prevout.hash) || coins_tip.HaveCoinInCache(txin.prevout)) continue;
+            outpoints.push_back(txin.prevout);
+        }
+    }
+    m_coins_views->m_prefetchview.Prefetch(std::move(outpoints));
+}
+
 bool Chainstate::ResizeCoinsCaches(size_t coinstip_size, size_t coinsdb_size)
 {
     if (coinstip_size == m_coinstip_cache_size_bytes &&
@@ -6122,6 +6684,8 @@ bool Chainstate::ResizeCoinsCaches(size_t coinstip_size, size_t coinsdb_size)
     size_t old_coinstip_size = m_coinstip_cache_size_bytes;
     m_coinstip_cache_size_bytes = coinstip_size;
     m_coinsdb_cache_size_bytes = coinsdb_size;
+    // SYSCOIN the prefetch reads go to the database that is replaced
+    m_coins_views->m_prefetchview.WaitForPrefetches();
     CoinsDB().ResizeCache(coinsdb_size);
 
     LogPrintf("[%s] resized coinsdb cache to %.1f MiB\n",
@@ -6771,6 +7335,32 @@ bool CBlockIndexDB::ReadBlockHeight(const uint256& txid, uint32_t& nHeight) {
     }
     return false;
 }
+void CBlockIndexDB::ReadBlockHeights(const std::vector<uint256>& vecTXIDs, std::unordered_map<uint256, uint32_t, StaticSaltedHasher>& mapHeights) {
+    std::vector<uint256> vecMissing;
+    for (const auto& txid : vecTXIDs) {
+        auto it = mapCache.find(txid);
+        if (it != mapCache.end()) {
+            mapHeights.try_emplace(txid, it->second);
+        } else {
+            vecMissing.emplace_back(txid);
+        }
+    }
+    if (vecMissing.empty()) {
+        return;
+    }
+    // sorted like the serialized keys so the cursor only moves forward through the table
+    std::sort(vecMissing.begin(), vecMissing.end());
+    vecMissing.erase(std::unique(vecMissing.begin(), vecMissing.end()), vecMissing.end());
+    std::unique_ptr<CDBIterator> pcursor(NewIterator());
+    uint256 nKey;
+    uint32_t nValue;
+    for (const auto& txid : vecMissing) {
+        pcursor->Seek(txid);
+        if (pcursor->Valid() && pcursor->GetKey(nKey) && nKey == txid && pcursor->GetValue(nValue)) {
+            mapHeights.try_emplace(txid, nValue);
+        }
+    }
+}
 bool CBlockIndexDB::FlushErase(const std::vector<std::pair<uint256,uint32_t> > &vecTXIDPairs) {
     if(vecTXIDPairs.empty())
         return true;
@@ -356,8 +356,15 @@ static_assert(std::is_nothrow_destructible_v<CScriptCheck>);
 /** Functions for validating blocks and updating the block tree */
 
 /** Context-independent validity checks */
+// SYSCOIN
+/** Context-free check of the proof of work of a header, the chain ID and auxpow merkle branches included. Takes no locks. */
+bool CheckProofOfWork(const CBlockHeader& block, const Consensus::Params& params);
 bool CheckBlock(const CBlock& block, BlockValidationState& state, const Consensus::Params& consensusParams, bool fCheckPOW = true, bool fCheckMerkleRoot = true);
 
+// SYSCOIN
+/** Returns the script flags which should be checked for a given block */
+unsigned int GetBlockScriptFlags(const CBlockIndex& block_index, const ChainstateManager& chainman);
+
 /** Check a block is completely valid from start to finish (only works on top of our current best block) */
 bool TestBlockValidity(BlockValidationState& state,
                        const CChainParams& chainparams,
@@ -405,6 +412,18 @@ enum DisconnectResult
     DISCONNECT_UNCLEAN, // Rolled back, but UTXO set was inconsistent with block.
     DISCONNECT_FAILED   // Something else went wrong.
 };
+// SYSCOIN
+typedef std::vector<std::pair<uint256, CDeterministicMNListNEVMAddressDiff> > NEVMDisconnectVec;
+/** NEVM side of the blocks a reorg disconnects. Geth is rewound and the NEVM databases are erased once for the whole range. */
+struct NEVMDisconnectBatch {
+    NEVMMintTxSet setMintTxs;
+    std::vector<uint256> vecNEVMBlocks;
+    std::vector<std::pair<uint256, uint32_t> > vecTXIDPairs;
+    //! Geth rewind, tip first
+    NEVMDisconnectVec vecDisconnects;
+    //! the blocks never made it into Geth, only the NEVM databases are rewound
+    bool fSkipGeth{false};
+};
 
 class ConnectTrace;
 
@@ -432,6 +451,10 @@ public:
     //! All unspent coins reside in this store.
     CCoinsViewDB m_dbview GUARDED_BY(cs_main);
 
+    // SYSCOIN
+    //! This view holds the inputs of the next block read ahead of time from the database.
+    CCoinsViewPrefetch m_prefetchview GUARDED_BY(cs_main);
+
     //! This view wraps access to the leveldb instance and handles read errors gracefully.
     CCoinsViewErrorCatcher m_catcherview GUARDED_BY(cs_main);
 
@@ -623,6 +646,10 @@ public:
     bool ResizeCoinsCaches(size_t coinstip_size, size_t coinsdb_size)
         EXCLUSIVE_LOCKS_REQUIRED(::cs_main);
 
+    // SYSCOIN
+    //! Read the inputs of a block that is about to be connected which the coins cache is missing.
+    void PrefetchCoins(const CBlock& block) EXCLUSIVE_LOCKS_REQUIRED(::cs_main);
+
     /**
      * Update the on-disk chain state.
      * The caches and indexes are flushed depending on the mode we're called with
@@ -675,7 +702,7 @@ public:
 
     // Block (dis)connection on a given view:
     // SYSCOIN
-    DisconnectResult DisconnectBlock(const CBlock& block, const CBlockIndex* pindex, CCoinsViewCache& view, NEVMMintTxSet &setMintTxs, std::vector<uint256> &vecNEVMBlocks, std::vector<std::pair<uint256,uint32_t> >& vecTXIDPairs, bool bReverify = true, bool bReplay = false) EXCLUSIVE_LOCKS_REQUIRED(::cs_main);
+    DisconnectResult DisconnectBlock(const CBlock& block, const CBlockIndex* pindex, CCoinsViewCache& view, NEVMMintTxSet &setMintTxs, std::vector<uint256> &vecNEVMBlocks, std::vector<std::pair<uint256,uint32_t> >& vecTXIDPairs, bool bReverify = true, bool bReplay = false, NEVMDisconnectVec* vecNEVMDisconnects = nullptr) EXCLUSIVE_LOCKS_REQUIRED(::cs_main);
     bool ConnectBlock(const CBlock& block, BlockValidationState& state, CBlockIndex* pindex,
                     CCoinsViewCache& view, bool fJustCheck = false, bool bReverify = true) EXCLUSIVE_LOCKS_REQUIRED(::cs_main);
 
@@ -683,7 +710,10 @@ public:
                     CCoinsViewCache& view, bool fJustCheck, NEVMMintTxSet &setMintTxs, NEVMTxRootMap &mapNEVMTxRoots, PoDAMAPMemory &mapPoDA, std::vector<std::pair<uint256, uint32_t> > &vecTXIDPairs, bool bReverify = true) EXCLUSIVE_LOCKS_REQUIRED(cs_main);
 
     // SYSCOIN Apply the effects of a block disconnection on the UTXO set.
-    bool DisconnectTip(BlockValidationState& state, DisconnectedBlockTransactions* disconnectpool, bool bReverify = true) EXCLUSIVE_LOCKS_REQUIRED(cs_main, m_mempool->cs);
+    // With nevmBatch the NEVM side is left in nevmBatch for FlushNEVMDisconnectBatch.
+    bool DisconnectTip(BlockValidationState& state, DisconnectedBlockTransactions* disconnectpool, bool bReverify = true, NEVMDisconnectBatch* nevmBatch = nullptr) EXCLUSIVE_LOCKS_REQUIRED(cs_main, m_mempool->cs);
+    /** Rewind Geth and erase the NEVM databases for the blocks collected by DisconnectTip, then clear nevmBatch */
+    bool FlushNEVMDisconnectBatch(NEVMDisconnectBatch& nevmBatch) EXCLUSIVE_LOCKS_REQUIRED(cs_main);
 
     // Manual block validity manipulation:
     /** Mark a block as precious and reorganize.
@@ -753,6 +783,17 @@ public:
 
 private:
     bool ActivateBestChainStep(BlockValidationState& state, CBlockIndex* pindexMostWork, const std::shared_ptr<const CBlock>& pblock, bool& fInvalidFound, ConnectTrace& connectTrace) EXCLUSIVE_LOCKS_REQUIRED(cs_main, m_mempool->cs);
+    // SYSCOIN
+    /** Send the queued NEVM block connects and wait for Geth to ack them, the block it failed to connect is kept for SettleNEVMPipeline */
+    void CheckNEVMPipeline() EXCLUSIVE_LOCKS_REQUIRED(cs_main);
+    /**
+     * If Geth failed to connect a pipelined NEVM block, that block and the ones after it are missing on the
+     * Geth side: disconnect them without telling Geth and have them connected in lock-step again, so the
+     * Geth verdict lands on the block that actually failed.
+     *
+     * @returns false on a system error
+     */
+    bool SettleNEVMPipeline(BlockValidationState& state, DisconnectedBlockTransactions& disconnectpool, bool& fBlocksDisconnected) EXCLUSIVE_LOCKS_REQUIRED(cs_main, m_mempool->cs);
     bool ConnectTip(BlockValidationState& state, CBlockIndex* pindexNew, const std::shared_ptr<const CBlock>& pblock, ConnectTrace& connectTrace, DisconnectedBlockTransactions& disconnectpool) EXCLUSIVE_LOCKS_REQUIRED(cs_main, m_mempool->cs);
 
     void InvalidBlockFound(CBlockIndex* pindex, const BlockValidationState& state) EXCLUSIVE_LOCKS_REQUIRED(cs_main);
@@ -785,7 +826,12 @@ private:
     void UpdateTip(const CBlockIndex* pindexNew)
         EXCLUSIVE_LOCKS_REQUIRED(::cs_main);
     // SYSCOIN
-    bool ConnectNEVMCommitment(BlockValidationState& state, NEVMTxRootMap &mapNEVMTxRoots, const CBlock& block, const uint256& nBlockHash, const uint32_t& nHeight, const bool fJustCheck, PoDAMAPMemory &mapPoDA, const CDeterministicMNListNEVMAddressDiff &diff) EXCLUSIVE_LOCKS_REQUIRED(cs_main);
+    bool ConnectNEVMCommitment(BlockValidationState& state, NEVMTxRootMap &mapNEVMTxRoots, const CBlock& block, const uint256& nBlockHash, const uint32_t& nHeight, const bool fJustCheck, PoDAMAPMemory &mapPoDA, const CDeterministicMNListNEVMAddressDiff &diff, const bool fAssumedValid = false) EXCLUSIVE_LOCKS_REQUIRED(cs_main);
+
+    //! blocks up to this height wait for the Geth verdict even under assumevalid, set by CheckNEVMPipeline
+    int m_nevm_lockstep_height GUARDED_BY(::cs_main){-1};
+    //! the block Geth failed to connect, the next step rolls back to it before anything else
+    uint256 m_nevm_failed_block GUARDED_BY(::cs_main);
 
     SteadyClock::time_point m_last_write{};
     SteadyClock::time_point m_last_flush{};
@@ -906,7 +952,8 @@ private:
         BlockValidationState& state,
         CBlockIndex** ppindex,
         bool min_pow_checked,
-        bool bForBlock = true) EXCLUSIVE_LOCKS_REQUIRED(cs_main);
+        bool bForBlock = true,
+        bool fCheckPOW = true) EXCLUSIVE_LOCKS_REQUIRED(cs_main);
     friend Chainstate;
 
     /** Most recent headers presync progress update, for rate-limiting. */
@@ -1137,11 +1184,15 @@ public:
      * @param[in,out] blocks_with_unknown_parent    (optional) Map of disk positions for blocks with
      *                                              unknown parent, key is parent block hash
      *                                              (only used for reindex)
+     * @param[in,out] prefetched                    (optional) SYSCOIN blocks of the file read and checked
+     *                                              ahead, taken from it instead of being read again
+     *                                              (only used for reindex)
      * */
     void LoadExternalBlockFile(
         CAutoFile& file_in,
         FlatFilePos* dbp = nullptr,
-        std::multimap<uint256, FlatFilePos>* blocks_with_unknown_parent = nullptr);
+        std::multimap<uint256, FlatFilePos>* blocks_with_unknown_parent = nullptr,
+        node::PrefetchedBlocks* prefetched = nullptr);
 
     /**
      * Process an incoming block. This only returns after the best known valid
@@ -1179,8 +1230,9 @@ public:
      * @param[in]  min_pow_checked  True if proof-of-work anti-DoS checks have been done by caller for headers chain
      * @param[out] state This may be set to an Error state if any error occurred processing them
      * @param[out] ppindex If set, the pointer will be set to point to the last new block index object for the given headers
+     * @param[in]  pow_checked  True if the caller checked the proof of work of every header already (HasValidProofOfWork)
      */
-    bool ProcessNewBlockHeaders(const std::vector<CBlockHeader>& block, bool min_pow_checked, BlockValidationState& state, const CBlockIndex** ppindex = nullptr) LOCKS_EXCLUDED(cs_main);
+    bool ProcessNewBlockHeaders(const std::vector<CBlockHeader>& block, bool min_pow_checked, BlockValidationState& state, const CBlockIndex** ppindex = nullptr, bool pow_checked = false) LOCKS_EXCLUDED(cs_main);
 
     /**
      * Sufficiently validate a block for disk storage (and store on disk).
@@ -1290,6 +1342,8 @@ class CBlockIndexDB : public CDBWrapper {
 public:
     using CDBWrapper::CDBWrapper;
     bool ReadBlockHeight(const uint256& txid, uint32_t& nHeight);
+    /** Heights of all known txids of vecTXIDs, the ones not cached are read in key order with a single iterator */
+    void ReadBlockHeights(const std::vector<uint256>& vecTXIDs, std::unordered_map<uint256, uint32_t, StaticSaltedHasher>& mapHeights);
     bool Prune(const uint32_t &nHeight, CDBBatch &batch);
     bool FlushErase(const std::vector<std::pair<uint256,uint32_t> > &vecTXIDPairs);
     bool FlushErase(const std::vector<std::pair<uint256,uint32_t> > &vecTXIDPairs, CDBBatch &batch);
@@ -1298,14 +1352,46 @@ public:
 };
 extern std::unique_ptr<CBlockIndexDB> pblockindexdb;
 // SYSCOIN
+//! -syscoinstatedb default
+static constexpr bool DEFAULT_SYSCOIN_STATE_DB{false};
+/** Shared LevelDB instance of the Syscoin state databases when -syscoinstatedb is set */
+extern std::unique_ptr<CDBWrapper> psyscoinstatedb;
+// SYSCOIN
 static const unsigned int DEFAULT_RPC_SERIALIZE_VERSION = 1;
 int RPCSerializationFlags();
-bool DisconnectNEVMCommitment(BlockValidationState& state, std::vector<uint256> &vecNEVMBlocks, const CBlock& block, const CDeterministicMNListNEVMAddressDiff &diff) EXCLUSIVE_LOCKS_REQUIRED(cs_main);
+bool DisconnectNEVMCommitment(BlockValidationState& state, std::vector<uint256> &vecNEVMBlocks, const CBlock& block, const uint256& nBlockHash, const CDeterministicMNListNEVMAddressDiff &diff, NEVMDisconnectVec* vecNEVMDisconnects = nullptr) EXCLUSIVE_LOCKS_REQUIRED(cs_main);
 bool GetNEVMData(BlockValidationState& state, const CBlock& block, CNEVMHeader &evmBlock);
 bool FillNEVMData(CBlock &block);
 bool EraseNEVMData(const NEVMDataVec &NEVMDataVecOut);
 bool ProcessNEVMData(const node::BlockManager& blockman, const CBlock &block, const int64_t &nMedianTime, const int64_t& nTimeNow, PoDAMAPMemory &mapPoDA);
 bool ProcessNEVMData(const node::BlockManager& blockman, const CTransaction &tx, const int64_t &nMedianTime, const int64_t& nTimeNow, PoDAMAPMemory &mapPoDA);
+/**
+ * Stateless check that the PoDA blob of tx hashes to its version hash, meant to run before
+ * cs_main is taken. A match is remembered so ProcessNEVMData() under cs_main (for the mempool
+ * and for blocks carrying the same transaction object) skips hashing the blob. Returns false
+ * only if the blob does not match, payloads that can't be parsed are left to ProcessNEVMData().
+ */
+bool PreValidateNEVMData(const CTransaction &tx);
+/** Time spent in the stages of connecting blocks, summed over the blocks connected since startup */
+struct BlockConnectTimings {
+    int64_t blocks{0};
+    //! ConnectBlock(): sanity checks, script flags, special txs, PoDA and NEVM commitment, inputs, scripts, undo data, index
+    SteadyClock::duration check{};
+    SteadyClock::duration forks{};
+    SteadyClock::duration special{};
+    SteadyClock::duration nevm{};
+    SteadyClock::duration connect{};
+    SteadyClock::duration verify{};
+    SteadyClock::duration undo{};
+    SteadyClock::duration index{};
+    //! ConnectTip(): the ConnectBlock() call as a whole, flushing the view, writing the chainstate, the rest
+    SteadyClock::duration connect_total{};
+    SteadyClock::duration flush{};
+    SteadyClock::duration chainstate{};
+    SteadyClock::duration post_connect{};
+    SteadyClock::duration total{};
+};
+BlockConnectTimings GetBlockConnectTimings() EXCLUSIVE_LOCKS_REQUIRED(cs_main);
 /**
  * Return true if hash can be found in chainActive at nBlockHeight height.
  * Fills hashRet with found hash, if no nBlockHeight is specified - ::ChainActive().Height() is used.
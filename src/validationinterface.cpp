@@ -19,6 +19,10 @@
 #include <utility>
 // SYSCOIN
 #include <node/blockstorage.h>
+#include <util/thread.h>
+
+#include <set>
+#include <vector>
 
 std::string RemovalReasonToString(const MemPoolRemovalReason& r) noexcept;
 
@@ -166,6 +170,10 @@ void CallFunctionInValidationInterfaceQueue(std::function<void()> func)
     g_signals.m_internals->m_schedulerClient.AddToProcessQueue(std::move(func));
 }
 
+// SYSCOIN live subscriber queues, waited for by SyncWithValidationInterfaceQueue()
+static GlobalMutex g_subscriber_queues_mutex;
+static std::set<ValidationInterfaceQueue*> g_subscriber_queues GUARDED_BY(g_subscriber_queues_mutex);
+
 void SyncWithValidationInterfaceQueue()
 {
     AssertLockNotHeld(cs_main);
@@ -175,6 +183,91 @@ void SyncWithValidationInterfaceQueue()
         promise.set_value();
     });
     promise.get_future().wait();
+    // SYSCOIN then until the subscriber queues run what the validation queue handed them.
+    // The markers are pushed under the registry lock so no queue goes away in between;
+    // a queue being destroyed still runs its pending markers before its thread exits.
+    std::vector<std::future<void>> markers;
+    {
+        LOCK(g_subscriber_queues_mutex);
+        for (ValidationInterfaceQueue* queue : g_subscriber_queues) {
+            markers.push_back(queue->PushMarker());
+        }
+    }
+    for (auto& marker : markers) {
+        if (marker.valid()) marker.wait();
+    }
+}
+
+ValidationInterfaceQueue::ValidationInterfaceQueue(std::string thread_name, size_t max_backlog)
+    : m_max_backlog{std::max<size_t>(max_backlog, 1)}
+{
+    m_thread = std::thread(&util::TraceThread, std::move(thread_name), [this] { ThreadMain(); });
+    LOCK(g_subscriber_queues_mutex);
+    g_subscriber_queues.insert(this);
+}
+
+ValidationInterfaceQueue::~ValidationInterfaceQueue()
+{
+    WITH_LOCK(g_subscriber_queues_mutex, g_subscriber_queues.erase(this));
+    WITH_LOCK(m_mutex, m_stop = true);
+    m_cond.notify_all();
+    // the queue is owned by its subscriber and the work pushed only refers to it,
+    // so it is never destroyed from its own thread
+    assert(m_thread.get_id() != std::this_thread::get_id());
+    m_thread.join();
+}
+
+void ValidationInterfaceQueue::Push(std::function<void()> func)
+{
+    WAIT_LOCK(m_mutex, lock);
+    // the thread itself never waits on its own backlog
+    if (std::this_thread::get_id() != m_thread.get_id()) {
+        m_cond.wait(lock, [&]() EXCLUSIVE_LOCKS_REQUIRED(m_mutex) { return m_queue.size() < m_max_backlog || m_stop; });
+    }
+    m_queue.push_back(std::move(func));
+    m_cond.notify_all();
+}
+
+std::future<void> ValidationInterfaceQueue::PushMarker()
+{
+    if (std::this_thread::get_id() == m_thread.get_id()) return {};
+    auto promise = std::make_shared<std::promise<void>>();
+    std::future<void> marker = promise->get_future();
+    {
+        LOCK(m_mutex);
+        m_queue.push_back([promise] { promise->set_value(); });
+    }
+    m_cond.notify_all();
+    return marker;
+}
+
+void ValidationInterfaceQueue::Sync()
+{
+    std::future<void> marker = PushMarker();
+    if (marker.valid()) marker.wait();
+}
+
+size_t ValidationInterfaceQueue::Pending() const
+{
+    LOCK(m_mutex);
+    return m_queue.size();
+}
+
+void ValidationInterfaceQueue::ThreadMain()
+{
+    WAIT_LOCK(m_mutex, lock);
+    while (true) {
+        m_cond.wait(lock, [&]() EXCLUSIVE_LOCKS_REQUIRED(m_mutex) { return !m_queue.empty() || m_stop; });
+        // pending work is run even when stopping
+        if (m_queue.empty()) break;
+        std::function<void()> func = std::move(m_queue.front());
+        m_queue.pop_front();
+        m_cond.notify_all();
+        REVERSE_LOCK(lock);
+        func();
+        // release what the work captured before taking the lock back
+        func = nullptr;
+    }
 }
 
 // Use a macro instead of a function for conditional logging to prevent
@@ -273,18 +366,43 @@ void CMainSignals::NotifyGovernanceVote(const uint256& vote) {
 void CMainSignals::NotifyGovernanceObject(const uint256& object) {
     m_internals->Iterate([&](CValidationInterface& callbacks) { callbacks.NotifyGovernanceObject(object); });
 }
+void CMainSignals::NotifyZDAGStatus(const uint256& txid, int status) {
+    // queued like TransactionAddedToMempool so subscribers see the status after the acceptance
+    auto event = [txid, status, this] {
+        m_internals->Iterate([&](CValidationInterface& callbacks) { callbacks.NotifyZDAGStatus(txid, status); });
+    };
+    ENQUEUE_AND_LOG_EVENT(event, "%s: txid=%s status=%d", __func__, txid.ToString(), status);
+}
 void CMainSignals::NotifyMasternodeListChanged(bool undo, const CDeterministicMNList& oldMNList, const CDeterministicMNListDiff& diff) {
     m_internals->Iterate([&](CValidationInterface& callbacks) { callbacks.NotifyMasternodeListChanged(undo, oldMNList, diff); });
 }
+void CMainSignals::NotifyChainLock(const CBlockIndex* pindex, const std::shared_ptr<const llmq::CChainLockSig>& clsig) {
+    auto event = [pindex, clsig, this] {
+        m_internals->Iterate([&](CValidationInterface& callbacks) { callbacks.NotifyChainLock(pindex, clsig); });
+    };
+    ENQUEUE_AND_LOG_EVENT(event, "%s: block hash=%s", __func__, pindex->GetBlockHash().ToString());
+}
+void CMainSignals::NotifyNEVMBlobAdded(const std::vector<uint8_t>& vchVersionHash, const uint256& txid, const std::shared_ptr<const std::vector<uint8_t>>& vchNEVMData) {
+    auto event = [vchVersionHash, txid, vchNEVMData, this] {
+        m_internals->Iterate([&](CValidationInterface& callbacks) { callbacks.NotifyNEVMBlobAdded(vchVersionHash, txid, vchNEVMData); });
+    };
+    ENQUEUE_AND_LOG_EVENT(event, "%s: txid=%s", __func__, txid.ToString());
+}
 void CMainSignals::NotifyNEVMComms(const std::string& commMessage, bool &bResponse) {
     m_internals->Iterate([&](CValidationInterface& callbacks) { callbacks.NotifyNEVMComms(commMessage, bResponse); });
 }
 void CMainSignals::NotifyNEVMBlockConnect(const CNEVMHeader &evmBlock, const CBlock& block, std::string &state, const uint256& nBlockHash, NEVMDataVec &NEVMDataVecOut, const uint32_t& nHeight, bool bSkipValidation, const CDeterministicMNListNEVMAddressDiff &diff) {
     m_internals->Iterate([&](CValidationInterface& callbacks) { callbacks.NotifyNEVMBlockConnect(evmBlock, block, state, nBlockHash, NEVMDataVecOut, nHeight, bSkipValidation, diff); });
 }
+void CMainSignals::NotifyNEVMFlush(std::string &state, uint256 &nFailedBlockHash) {
+    m_internals->Iterate([&](CValidationInterface& callbacks) { callbacks.NotifyNEVMFlush(state, nFailedBlockHash); });
+}
 void CMainSignals::NotifyNEVMBlockDisconnect(std::string &state, const uint256& nBlockHash, const CDeterministicMNListNEVMAddressDiff &diff) {
     m_internals->Iterate([&](CValidationInterface& callbacks) { callbacks.NotifyNEVMBlockDisconnect(state, nBlockHash, diff); });
 }
+void CMainSignals::NotifyNEVMBlocksDisconnect(std::string &state, const NEVMDisconnectVec &vecBlocks) {
+    m_internals->Iterate([&](CValidationInterface& callbacks) { callbacks.NotifyNEVMBlocksDisconnect(state, vecBlocks); });
+}
 void CMainSignals::NotifyGetNEVMBlockInfo(uint64_t &nHeight, std::string &state) {
     m_internals->Iterate([&](CValidationInterface& callbacks) { callbacks.NotifyGetNEVMBlockInfo(nHeight, state);});
 }
@@ -11,8 +11,13 @@
 #include <primitives/transaction.h> // CTransaction(Ref)
 #include <sync.h>
 
+#include <condition_variable>
+#include <deque>
 #include <functional>
+#include <future>
 #include <memory>
+#include <string>
+#include <thread>
 
 class BlockValidationState;
 class CBlock;
@@ -27,6 +32,11 @@ class CDeterministicMNListDiff;
 class CNEVMBlock;
 class CNEVMHeader;
 class CDeterministicMNListNEVMAddressDiff;
+// SYSCOIN Syscoin block hash and masternode NEVM address diff of each block of a batched disconnect, tip first
+typedef std::vector<std::pair<uint256, CDeterministicMNListNEVMAddressDiff> > NEVMDisconnectVec;
+namespace llmq {
+class CChainLockSig;
+} // namespace llmq
 enum class MemPoolRemovalReason;
 
 /** Register subscriber */
@@ -66,6 +76,47 @@ void CallFunctionInValidationInterfaceQueue(std::function<void ()> func);
  */
 void SyncWithValidationInterfaceQueue() LOCKS_EXCLUDED(cs_main);
 
+// SYSCOIN
+/** Default number of notifications a ValidationInterfaceQueue holds before its producer waits */
+static constexpr size_t DEFAULT_VALIDATION_QUEUE_BACKLOG{1000};
+
+/**
+ * A notification queue and thread of its own for a subscriber whose callbacks are
+ * slow, such as a wallet. The subscriber's CValidationInterface callbacks only push
+ * their work here, so they return quickly and the shared validation queue can move
+ * on to the other subscribers. Work runs in the order it was pushed. Push waits while
+ * max_backlog functions are pending, which bounds the memory a stuck subscriber can
+ * hold and slows the shared queue down to the subscriber's pace only then.
+ *
+ * SyncWithValidationInterfaceQueue() also waits for every live queue, so callers
+ * relying on it keep seeing the subscriber up to date. Destruction runs whatever
+ * is still pending before joining the thread.
+ */
+class ValidationInterfaceQueue
+{
+public:
+    explicit ValidationInterfaceQueue(std::string thread_name, size_t max_backlog = DEFAULT_VALIDATION_QUEUE_BACKLOG);
+    ~ValidationInterfaceQueue();
+
+    void Push(std::function<void()> func) EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+    /** Wait until everything pushed before the call has run. Returns right away on the queue's own thread. */
+    void Sync() EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+    size_t Pending() const EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+
+private:
+    const size_t m_max_backlog;
+    mutable Mutex m_mutex;
+    std::condition_variable m_cond;
+    std::deque<std::function<void()>> m_queue GUARDED_BY(m_mutex);
+    bool m_stop GUARDED_BY(m_mutex){false};
+    std::thread m_thread;
+
+    void ThreadMain() EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+    /** Push a marker regardless of the backlog and return the future it sets, an invalid one on the queue's own thread */
+    std::future<void> PushMarker() EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+    friend void ::SyncWithValidationInterfaceQueue();
+};
+
 /**
  * Implement this to subscribe to events generated in validation
  *
@@ -187,9 +238,19 @@ protected:
     virtual void NotifyHeaderTip(const CBlockIndex *pindexNew) {}
     virtual void NotifyGovernanceVote(const uint256& vote) {}
     virtual void NotifyGovernanceObject(const uint256 &object) {}
+    /** Notifies listeners of the ZDAG status (ZDAG_STATUS_OK, ZDAG_WARNING_RBF, ZDAG_MAJOR_CONFLICT, ...) of a mempool transaction when it is accepted or changes */
+    virtual void NotifyZDAGStatus(const uint256& txid, int status) {}
     virtual void NotifyMasternodeListChanged(bool undo, const CDeterministicMNList& oldMNList, const CDeterministicMNListDiff& diff) {}
+    /** Notifies listeners of a new best chainlock, pindex is the block it locks. Called on a background thread. */
+    virtual void NotifyChainLock(const CBlockIndex* pindex, const std::shared_ptr<const llmq::CChainLockSig>& clsig) {}
+    /** Notifies listeners of a PoDA blob stored for the first time. Called on a background thread. */
+    virtual void NotifyNEVMBlobAdded(const std::vector<uint8_t>& vchVersionHash, const uint256& txid, const std::shared_ptr<const std::vector<uint8_t>>& vchNEVMData) {}
     virtual void NotifyNEVMBlockConnect(const CNEVMHeader &evmBlock, const CBlock& block, std::string &state, const uint256& nBlockHash, NEVMDataVec &NEVMDataVecOut, const uint32_t& nHeight, bool bSkipValidation, const CDeterministicMNListNEVMAddressDiff &diff) {}
+    /** Sends the queued block connects and waits for Geth to ack all of them. If Geth failed one, nFailedBlockHash is set to the lowest such block and state to the reason */
+    virtual void NotifyNEVMFlush(std::string &state, uint256 &nFailedBlockHash) {}
     virtual void NotifyNEVMBlockDisconnect(std::string &state, const uint256& nBlockHash, const CDeterministicMNListNEVMAddressDiff &diff) {}
+    /** Rewinds the NEVM chain over all blocks of vecBlocks in one go, used for the disconnects of a reorg */
+    virtual void NotifyNEVMBlocksDisconnect(std::string &state, const NEVMDisconnectVec &vecBlocks) {}
     virtual void NotifyGetNEVMBlockInfo(uint64_t &nHeight, std::string &state) {}
     virtual void NotifyGetNEVMBlock(CNEVMBlock &evmBlock, std::string &state) {}
     virtual void NotifyNEVMComms(const std::string& commMessage, bool &bResponse) {}
@@ -229,9 +290,14 @@ public:
     void NewPoWValidBlock(const CBlockIndex *, const std::shared_ptr<const CBlock>&);
     void NotifyGovernanceVote(const uint256& vote);
     void NotifyGovernanceObject(const uint256& object);
+    void NotifyZDAGStatus(const uint256& txid, int status);
     void NotifyMasternodeListChanged(bool undo, const CDeterministicMNList& oldMNList, const CDeterministicMNListDiff& diff);
+    void NotifyChainLock(const CBlockIndex* pindex, const std::shared_ptr<const llmq::CChainLockSig>& clsig);
+    void NotifyNEVMBlobAdded(const std::vector<uint8_t>& vchVersionHash, const uint256& txid, const std::shared_ptr<const std::vector<uint8_t>>& vchNEVMData);
     void NotifyNEVMBlockConnect(const CNEVMHeader &evmBlock, const CBlock& block, std::string &state, const uint256& nBlockHash, NEVMDataVec &NEVMDataVecOut, const uint32_t& nHeight, bool bSkipValidation, const CDeterministicMNListNEVMAddressDiff &diff);
+    void NotifyNEVMFlush(std::string &state, uint256 &nFailedBlockHash);
     void NotifyNEVMBlockDisconnect(std::string &state, const uint256& nBlockHash, const CDeterministicMNListNEVMAddressDiff &diff);
+    void NotifyNEVMBlocksDisconnect(std::string &state, const NEVMDisconnectVec &vecBlocks);
     void NotifyGetNEVMBlockInfo(uint64_t &nHeight, std::string &state);
     void NotifyGetNEVMBlock(CNEVMBlock &evmBlock, std::string &state);
     void NotifyNEVMComms(const std::string& commMessage, bool &bResponse);
@@ -14,6 +14,7 @@
 
 #include <algorithm>
 #include <map>
+#include <memory>
 #include <optional>
 #include <set>
 
@@ -62,8 +63,8 @@ public:
     // SYSCOIN
     //! Custom transaction version
     int m_version = CTransaction::CURRENT_VERSION;
-    //! Custom poda data
-    std::vector<uint8_t> m_nevmdata;
+    //! Custom poda data, shared with the outputs built from it
+    std::shared_ptr<const std::vector<uint8_t>> m_nevmdata;
     CCoinControl();
 
     /**
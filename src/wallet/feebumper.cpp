@@ -263,7 +263,7 @@ Result CreateRateBumpTransaction(CWallet& wallet, const uint256& txid, const CCo
             new_coin_control.destChange = dest;
         } else {
             // SYSCOIN
-            if(new_coin_control.m_nevmdata.empty() && !output.vchNEVMData.empty()) {
+            if(!new_coin_control.m_nevmdata && output.HasNEVMData()) {
                 new_coin_control.m_nevmdata = output.vchNEVMData;
             }
             CRecipient recipient = {dest, output.nValue, false};
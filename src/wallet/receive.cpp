@@ -296,6 +296,11 @@ Balance GetBalance(const CWallet& wallet, const int min_depth, bool avoid_reuse)
     isminefilter reuse_filter = avoid_reuse ? ISMINE_NO : ISMINE_USED;
     {
         LOCK(wallet.cs_wallet);
+        // SYSCOIN
+        if (min_depth == 0) {
+            const auto it = wallet.m_balance_cache.find({0, avoid_reuse});
+            if (it != wallet.m_balance_cache.end()) return it->second;
+        }
         std::set<uint256> trusted_parents;
         for (const auto& entry : wallet.mapWallet)
         {
@@ -315,10 +320,83 @@ Balance GetBalance(const CWallet& wallet, const int min_depth, bool avoid_reuse)
             ret.m_mine_immature += CachedTxGetImmatureCredit(wallet, wtx, ISMINE_SPENDABLE);
             ret.m_watchonly_immature += CachedTxGetImmatureCredit(wallet, wtx, ISMINE_WATCH_ONLY);
         }
+        // SYSCOIN
+        if (min_depth == 0) wallet.m_balance_cache.emplace(std::make_pair(uint64_t{0}, avoid_reuse), ret);
     }
     return ret;
 }
 
+// SYSCOIN
+static Balance ComputeAssetBalance(const CWallet& wallet, uint64_t nAsset, int min_depth, bool avoid_reuse, std::set<uint256>& trusted_parents) EXCLUSIVE_LOCKS_REQUIRED(wallet.cs_wallet)
+{
+    Balance ret;
+    const auto it = wallet.m_asset_txs.find(nAsset);
+    if (it == wallet.m_asset_txs.end()) return ret;
+    const bool allow_used_addresses{!avoid_reuse || !wallet.IsWalletFlagSet(WALLET_FLAG_AVOID_REUSE)};
+    for (const uint256& txid : it->second) {
+        const CWalletTx* wtx = wallet.GetWalletTx(txid);
+        if (!wtx) continue;
+        CAmount nMine{0}, nWatchOnly{0};
+        for (unsigned int i = 0; i < wtx->tx->vout.size(); i++) {
+            const CTxOut& txout = wtx->tx->vout[i];
+            if (txout.assetInfo.nAsset != nAsset) continue;
+            if (wallet.IsSpent(COutPoint(txid, i)) || (!allow_used_addresses && wallet.IsSpentKey(txout.scriptPubKey))) continue;
+            const isminetype mine = wallet.IsMine(txout);
+            if (mine & ISMINE_SPENDABLE) {
+                nMine += txout.assetInfo.nValue;
+            } else if (mine & ISMINE_WATCH_ONLY) {
+                nWatchOnly += txout.assetInfo.nValue;
+            }
+        }
+        if (wallet.IsTxImmatureCoinBase(*wtx)) {
+            if (wallet.IsTxInMainChain(*wtx)) {
+                ret.m_mine_immature += nMine;
+                ret.m_watchonly_immature += nWatchOnly;
+            }
+            continue;
+        }
+        const bool is_trusted{CachedTxIsTrusted(wallet, *wtx, trusted_parents)};
+        const int tx_depth{wallet.GetTxDepthInMainChain(*wtx)};
+        if (is_trusted && tx_depth >= min_depth) {
+            ret.m_mine_trusted += nMine;
+            ret.m_watchonly_trusted += nWatchOnly;
+        }
+        if (!is_trusted && tx_depth == 0 && wtx->InMempool()) {
+            ret.m_mine_untrusted_pending += nMine;
+            ret.m_watchonly_untrusted_pending += nWatchOnly;
+        }
+    }
+    return ret;
+}
+
+static Balance CachedAssetBalance(const CWallet& wallet, uint64_t nAsset, int min_depth, bool avoid_reuse, std::set<uint256>& trusted_parents) EXCLUSIVE_LOCKS_REQUIRED(wallet.cs_wallet)
+{
+    if (min_depth != 0) return ComputeAssetBalance(wallet, nAsset, min_depth, avoid_reuse, trusted_parents);
+    const auto key = std::make_pair(nAsset, avoid_reuse);
+    const auto it = wallet.m_balance_cache.find(key);
+    if (it != wallet.m_balance_cache.end()) return it->second;
+    return wallet.m_balance_cache.emplace(key, ComputeAssetBalance(wallet, nAsset, min_depth, avoid_reuse, trusted_parents)).first->second;
+}
+
+Balance GetAssetBalance(const CWallet& wallet, uint64_t nAsset, int min_depth, bool avoid_reuse)
+{
+    if (nAsset == 0) return GetBalance(wallet, min_depth, avoid_reuse);
+    LOCK(wallet.cs_wallet);
+    std::set<uint256> trusted_parents;
+    return CachedAssetBalance(wallet, nAsset, min_depth, avoid_reuse, trusted_parents);
+}
+
+std::map<uint64_t, Balance> GetAssetBalances(const CWallet& wallet, int min_depth, bool avoid_reuse)
+{
+    std::map<uint64_t, Balance> balances;
+    LOCK(wallet.cs_wallet);
+    std::set<uint256> trusted_parents;
+    for (const auto& [nAsset, txids] : wallet.m_asset_txs) {
+        balances.emplace(nAsset, CachedAssetBalance(wallet, nAsset, min_depth, avoid_reuse, trusted_parents));
+    }
+    return balances;
+}
+
 std::map<CTxDestination, CAmount> GetAddressBalances(const CWallet& wallet)
 {
     std::map<CTxDestination, CAmount> balances;
@@ -449,6 +449,15 @@ RPCHelpMan getbalances()
                     {RPCResult::Type::STR_AMOUNT, "untrusted_pending", "untrusted pending balance (outputs created by others that are in the mempool)"},
                     {RPCResult::Type::STR_AMOUNT, "immature", "balance from immature coinbase outputs"},
                 }},
+                {RPCResult::Type::OBJ_DYN, "assets", /*optional=*/true, "balances of the assets the wallet can sign for, by asset guid (not present if it holds none)",
+                {
+                    {RPCResult::Type::OBJ, "guid", "",
+                    {
+                        {RPCResult::Type::STR_AMOUNT, "trusted", "trusted balance (outputs created by the wallet or confirmed outputs)"},
+                        {RPCResult::Type::STR_AMOUNT, "untrusted_pending", "untrusted pending balance (outputs created by others that are in the mempool)"},
+                        {RPCResult::Type::STR_AMOUNT, "immature", "balance from immature coinbase outputs"},
+                    }},
+                }},
                 RESULT_LAST_PROCESSED_BLOCK,
             }
             },
@@ -490,6 +499,17 @@ RPCHelpMan getbalances()
         balances_watchonly.pushKV("immature", ValueFromAmount(bal.m_watchonly_immature));
         balances.pushKV("watchonly", balances_watchonly);
     }
+    // SYSCOIN
+    UniValue balances_assets{UniValue::VOBJ};
+    for (const auto& [nAsset, asset_bal] : GetAssetBalances(wallet)) {
+        if (asset_bal.m_mine_trusted == 0 && asset_bal.m_mine_untrusted_pending == 0 && asset_bal.m_mine_immature == 0) continue;
+        UniValue balances_asset{UniValue::VOBJ};
+        balances_asset.pushKV("trusted", ValueFromAmount(asset_bal.m_mine_trusted));
+        balances_asset.pushKV("untrusted_pending", ValueFromAmount(asset_bal.m_mine_untrusted_pending));
+        balances_asset.pushKV("immature", ValueFromAmount(asset_bal.m_mine_immature));
+        balances_assets.pushKV(ToString(nAsset), balances_asset);
+    }
+    if (!balances_assets.empty()) balances.pushKV("assets", balances_assets);
 
     AppendLastProcessedBlock(balances, wallet);
     return balances;
@@ -520,7 +540,8 @@ RPCHelpMan listunspent()
                             {"maximumAmount", RPCArg::Type::AMOUNT, RPCArg::DefaultHint{"unlimited"}, "Maximum value of each UTXO in " + CURRENCY_UNIT + ""},
                             {"maximumCount", RPCArg::Type::NUM, RPCArg::DefaultHint{"unlimited"}, "Maximum number of UTXOs"},
                             {"minimumSumAmount", RPCArg::Type::AMOUNT, RPCArg::DefaultHint{"unlimited"}, "Minimum sum value of all UTXOs in " + CURRENCY_UNIT + ""},
-                            {"include_immature_coinbase", RPCArg::Type::BOOL, RPCArg::Default{false}, "Include immature coinbase UTXOs"}
+                            {"include_immature_coinbase", RPCArg::Type::BOOL, RPCArg::Default{false}, "Include immature coinbase UTXOs"},
+                            {"assetGuid", RPCArg::Type::NUM, RPCArg::DefaultHint{"all"}, "Only return UTXOs of this asset guid"}
                         },
                         RPCArgOptions{.oneline_description="query_options"}},
                 },
@@ -610,7 +631,8 @@ RPCHelpMan listunspent()
                 {"maximumAmount", UniValueType()},
                 {"minimumSumAmount", UniValueType()},
                 {"maximumCount", UniValueType(UniValue::VNUM)},
-                {"include_immature_coinbase", UniValueType(UniValue::VBOOL)}
+                {"include_immature_coinbase", UniValueType(UniValue::VBOOL)},
+                {"assetGuid", UniValueType(UniValue::VNUM)}
             },
             true, true);
 
@@ -629,6 +651,10 @@ RPCHelpMan listunspent()
         if (options.exists("include_immature_coinbase")) {
             filter_coins.include_immature_coinbase = options["include_immature_coinbase"].get_bool();
         }
+        // SYSCOIN
+        if (options.exists("assetGuid")) {
+            filter_coins.asset = options["assetGuid"].getInt<uint64_t>();
+        }
     }
 
     // Make sure the results are valid at least up to the most recent block
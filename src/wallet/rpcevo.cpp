@@ -11,6 +11,7 @@
 #include <validation.h>
 
 #include <wallet/coincontrol.h>
+#include <wallet/fees.h>
 #include <wallet/spend.h>
 #include <wallet/rpc/util.h>
 
@@ -33,6 +34,11 @@
 #include <llmq/quorums_utils.h>
 #include <common/args.h>
 #include <index/txindex.h>
+#include <policy/policy.h>
+
+#include <functional>
+#include <optional>
+#include <set>
 using namespace wallet;
 static CKeyID ParsePubKeyIDFromAddress(const std::string& strAddress, const std::string& paramName)
 {
@@ -63,13 +69,32 @@ static CBLSSecretKey ParseBLSSecretKey(const std::string& hexKey, const std::str
     return secKey;
 }
 
+// SYSCOIN
+/** Select every available coin of the wallet paying to fundDest */
+static void SelectCoinsAtDestination(wallet::CWallet& pwallet, CCoinControl& coinControl, const CTxDestination& fundDest) EXCLUSIVE_LOCKS_REQUIRED(pwallet.cs_wallet)
+{
+    std::vector<COutput> vecOutputs;
+    vecOutputs = AvailableCoins(pwallet).All();
+
+    for (const auto& out : vecOutputs) {
+        CTxDestination txDest;
+        if (ExtractDestination(out.txout.scriptPubKey, txDest) && txDest == fundDest) {
+            coinControl.Select(COutPoint(out.outpoint.hash, out.outpoint.n));
+        }
+    }
+}
+
+// Funds tx from the coins at fundDest, or from fundOutpoint alone when it is given.
+// Batches pass the outpoint, they are synced and hold cs_wallet already.
 template<typename SpecialTxPayload>
-static void FundSpecialTx(wallet::CWallet& pwallet, CMutableTransaction& tx, const SpecialTxPayload& payload, const CTxDestination& fundDest)
+static void FundSpecialTx(wallet::CWallet& pwallet, CMutableTransaction& tx, const SpecialTxPayload& payload, const CTxDestination& fundDest, const std::optional<COutPoint>& fundOutpoint = std::nullopt)
 {
 
     // Make sure the results are valid at least up to the most recent block
     // the user could have gotten from another RPC command prior to now
-    pwallet.BlockUntilSyncedToCurrentChain();
+    if (!fundOutpoint) {
+        pwallet.BlockUntilSyncedToCurrentChain();
+    }
     {
         LOCK(pwallet.cs_wallet);
 
@@ -90,14 +115,11 @@ static void FundSpecialTx(wallet::CWallet& pwallet, CMutableTransaction& tx, con
         CCoinControl coinControl;
         coinControl.destChange = fundDest;
 
-        std::vector<COutput> vecOutputs;
-        vecOutputs = AvailableCoins(pwallet).All();
-
-        for (const auto& out : vecOutputs) {
-            CTxDestination txDest;
-            if (ExtractDestination(out.txout.scriptPubKey, txDest) && txDest == fundDest) {
-                coinControl.Select(COutPoint(out.outpoint.hash, out.outpoint.n));
-            }
+        if (fundOutpoint) {
+            coinControl.Select(*fundOutpoint);
+            coinControl.m_allow_other_inputs = false;
+        } else {
+            SelectCoinsAtDestination(pwallet, coinControl, fundDest);
         }
 
         if (!coinControl.HasSelected()) {
@@ -187,6 +209,114 @@ static UniValue SignAndSendSpecialTx(const node::JSONRPCRequest& request, const
 }
 
 
+// SYSCOIN
+/** A special tx of a batch. build fills the tx, funds it from the given outpoint alone and signs its payload. */
+struct BatchSpecialTx {
+    uint256 proTxHash;
+    std::function<CMutableTransaction(const COutPoint& fundOutpoint)> build;
+};
+
+//! the funding tx and the special txs spending it have to fit the descendant limit of the mempool
+static constexpr size_t MAX_SPECIAL_TX_BATCH{DEFAULT_DESCENDANT_LIMIT - 1};
+//! virtual size every special tx of a batch is funded for, a ProUpServTx or ProUpRegTx with one input and change is below it
+static constexpr int64_t SPECIAL_TX_BATCH_VSIZE{500};
+
+/**
+ * Fund and send the special txs of a batch. One funding tx takes the coins at fundDest
+ * and pays an output back to it per special tx, then each special tx spends its own
+ * output so the txs of the batch never select the same coins. Failures of single txs
+ * are reported in the result, the rest of the batch is still sent.
+ */
+static UniValue SendSpecialTxBatch(wallet::CWallet& pwallet, const CTxDestination& fundDest, const std::vector<BatchSpecialTx>& batch) EXCLUSIVE_LOCKS_REQUIRED(pwallet.cs_wallet)
+{
+    const CScript scriptFunding = GetScriptForDestination(fundDest);
+    const CFeeRate feeRate = GetMinimumFeeRate(pwallet, CCoinControl{}, /*feeCalc=*/nullptr);
+    const CAmount nDust = GetDustThreshold(CTxOut(0, scriptFunding), pwallet.chain().relayDustFee());
+    // twice the estimated fee, each special tx returns what it does not pay as change
+    const CAmount nFunding = std::max(2 * feeRate.GetFee(SPECIAL_TX_BATCH_VSIZE), 2 * nDust);
+
+    CCoinControl coinControl;
+    coinControl.destChange = fundDest;
+    SelectCoinsAtDestination(pwallet, coinControl, fundDest);
+    if (!coinControl.HasSelected()) {
+        throw JSONRPCError(RPC_INTERNAL_ERROR, "No funds at specified address");
+    }
+    const std::vector<CRecipient> recipients(batch.size(), CRecipient{fundDest, nFunding, false});
+    auto res = CreateTransaction(pwallet, recipients, /*change_pos=*/-1, coinControl);
+    if (!res) {
+        throw JSONRPCError(RPC_WALLET_INSUFFICIENT_FUNDS, util::ErrorString(res).original);
+    }
+    const CTransactionRef txFunding = res->tx;
+    pwallet.CommitTransaction(txFunding, /*mapValue=*/{}, /*orderForm=*/{});
+
+    // the change pays to fundDest as well, any output of the funding amount will do
+    std::vector<COutPoint> vecFunding;
+    for (size_t i = 0; i < txFunding->vout.size(); ++i) {
+        const CTxOut& txout = txFunding->vout[i];
+        if (txout.scriptPubKey == scriptFunding && txout.nValue == nFunding) {
+            vecFunding.emplace_back(txFunding->GetHash(), i);
+        }
+    }
+    CHECK_NONFATAL(vecFunding.size() >= batch.size());
+
+    UniValue arrTxs(UniValue::VARR);
+    for (size_t i = 0; i < batch.size(); ++i) {
+        UniValue txObj(UniValue::VOBJ);
+        txObj.pushKV("proTxHash", batch[i].proTxHash.GetHex());
+        try {
+            CMutableTransaction tx = batch[i].build(vecFunding[i]);
+            if (!pwallet.SignTransaction(tx)) {
+                throw JSONRPCError(RPC_WALLET_ERROR, "Signing transaction failed");
+            }
+            CTransactionRef txRef(MakeTransactionRef(std::move(tx)));
+            const CAmount max_raw_tx_fee = node::DEFAULT_MAX_RAW_TX_FEE_RATE.GetFee(GetVirtualTransactionSize(*txRef));
+            std::string err_string;
+            if (!pwallet.chain().broadcastTransaction(txRef, max_raw_tx_fee, true, err_string)) {
+                throw JSONRPCError(RPC_WALLET_ERROR, err_string);
+            }
+            txObj.pushKV("txid", txRef->GetHash().GetHex());
+        } catch (const UniValue& objError) {
+            txObj.pushKV("error", objError.find_value("message"));
+        } catch (const std::exception& e) {
+            txObj.pushKV("error", e.what());
+        }
+        arrTxs.push_back(txObj);
+    }
+
+    UniValue resObj(UniValue::VOBJ);
+    resObj.pushKV("fundingtxid", txFunding->GetHash().GetHex());
+    resObj.pushKV("transactions", arrTxs);
+    return resObj;
+}
+
+/** Targets of a batch RPC, checked for their count and for masternodes listed twice */
+static const std::vector<UniValue>& ParseSpecialTxBatchTargets(const UniValue& targets)
+{
+    const auto& values = targets.get_array().getValues();
+    if (values.empty() || values.size() > MAX_SPECIAL_TX_BATCH) {
+        throw JSONRPCError(RPC_INVALID_PARAMETER, strprintf("Pass 1 to %d targets", MAX_SPECIAL_TX_BATCH));
+    }
+    std::set<std::string> setProTxHashes;
+    for (const UniValue& target : values) {
+        if (!target.isObject()) {
+            throw JSONRPCError(RPC_INVALID_PARAMETER, "Every target must be an object");
+        }
+        if (!setProTxHashes.insert(target.find_value("proTxHash").getValStr()).second) {
+            throw JSONRPCError(RPC_INVALID_PARAMETER, strprintf("Masternode %s is listed more than once", target.find_value("proTxHash").getValStr()));
+        }
+    }
+    return values;
+}
+
+static CTxDestination ParseSpecialTxBatchFeeSource(const UniValue& feeSourceAddress)
+{
+    CTxDestination feeSource = DecodeDestination(feeSourceAddress.get_str());
+    if (!IsValidDestination(feeSource)) {
+        throw JSONRPCError(RPC_INVALID_ADDRESS_OR_KEY, std::string("Invalid Syscoin address: ") + feeSourceAddress.get_str());
+    }
+    return feeSource;
+}
+
 // handles register, register_prepare and register_fund
 static RPCHelpMan protx_register()
 {
@@ -706,6 +836,63 @@ static RPCHelpMan protx_register_submit()
     };
 } 
 
+// SYSCOIN
+/** Fill ptx and keyOperator from the protx_update_service arguments, checked against mnList. Returns the masternode. */
+static CDeterministicMNCPtr ParseProUpServTx(const CDeterministicMNList& mnList, const UniValue& proTxHash, const UniValue& ipAndPort, const UniValue& operatorKey,
+                                             const UniValue& nevmAddress, const UniValue& operatorPayoutAddress, CProUpServTx& ptx, CBLSSecretKey& keyOperator)
+{
+    ptx.proTxHash = ParseHashV(proTxHash, "proTxHash");
+    std::optional<CService> addr = Lookup(ipAndPort.get_str().c_str(), Params().GetDefaultPort(), false);
+    if (!addr.has_value()) {
+        throw std::runtime_error(strprintf("Invalid network address %s", ipAndPort.get_str()));
+    }
+    ptx.addr = addr.value();
+
+    keyOperator = ParseBLSSecretKey(operatorKey.get_str(), "operatorKey");
+    auto dmn = mnList.GetMN(ptx.proTxHash);
+    if (!dmn) {
+        throw std::runtime_error(strprintf("Masternode with proTxHash %s not found", ptx.proTxHash.ToString()));
+    }
+    if (keyOperator.GetPublicKey() != dmn->pdmnState->pubKeyOperator.Get()) {
+        throw JSONRPCError(RPC_INVALID_PARAMETER, strprintf("The operator key does not belong to the registered public key"));
+    }
+
+    if (!nevmAddress.isNull()) {
+        std::string nevmAddressStr = nevmAddress.get_str();
+        if(nevmAddressStr.size() > 0) {
+            // Check if the string starts with "0x" and remove it
+            if (nevmAddressStr.rfind("0x", 0) == 0) {
+                nevmAddressStr = nevmAddressStr.substr(2);
+            } else {
+                throw JSONRPCError(RPC_INVALID_ADDRESS_OR_KEY, std::string("Invalid NEVM address (should start with 0x): ") + nevmAddress.get_str());
+            }
+        
+            // Ethereum address must be exactly 20 bytes (40 hex characters)
+            if (nevmAddressStr.length() != 40 || !IsHex(nevmAddressStr)) {
+                throw JSONRPCError(RPC_INVALID_ADDRESS_OR_KEY, std::string("Invalid NEVM address (must be 20 bytes / 40 hex chars): ") + nevmAddress.get_str());
+            }
+        
+            // Parse the hex address into bytes
+            ptx.vchNEVMAddress = ParseHex(nevmAddressStr);
+        }
+    }
+    // param operatorPayoutAddress
+    if (!operatorPayoutAddress.isNull()) {
+        if (operatorPayoutAddress.get_str().empty()) {
+            ptx.scriptOperatorPayout = dmn->pdmnState->scriptOperatorPayout;
+        } else {
+            CTxDestination payoutDest = DecodeDestination(operatorPayoutAddress.get_str());
+            if (!IsValidDestination(payoutDest)) {
+                throw JSONRPCError(RPC_INVALID_ADDRESS_OR_KEY, strprintf("Invalid operator payout address: %s", operatorPayoutAddress.get_str()));
+            }
+            ptx.scriptOperatorPayout = GetScriptForDestination(payoutDest);
+        }
+    } else {
+        ptx.scriptOperatorPayout = dmn->pdmnState->scriptOperatorPayout;
+    }
+    return dmn;
+}
+
 static RPCHelpMan protx_update_service()
 {
     return RPCHelpMan{"protx_update_service",
@@ -757,60 +944,13 @@ static RPCHelpMan protx_update_service()
     } else {
         ptx.nVersion = CProUpServTx::GetVersion(v19active);
     }
-    ptx.proTxHash = ParseHashV(request.params[0], "proTxHash");
-    std::optional<CService> addr = Lookup(request.params[1].get_str().c_str(), Params().GetDefaultPort(), false);
-    if (!addr.has_value()) {
-        throw std::runtime_error(strprintf("Invalid network address %s", request.params[1].get_str()));
-    }
-    ptx.addr = addr.value();
-
-    CBLSSecretKey keyOperator = ParseBLSSecretKey(request.params[2].get_str(), "operatorKey");
+    CBLSSecretKey keyOperator;
     auto mnList = deterministicMNManager->GetListAtChainTip();
-    auto dmn = mnList.GetMN(ptx.proTxHash);
-    if (!dmn) {
-        throw std::runtime_error(strprintf("Masternode with proTxHash %s not found", ptx.proTxHash.ToString()));
-    }
-    if (keyOperator.GetPublicKey() != dmn->pdmnState->pubKeyOperator.Get()) {
-        throw JSONRPCError(RPC_INVALID_PARAMETER, strprintf("The operator key does not belong to the registered public key"));
-    }
+    auto dmn = ParseProUpServTx(mnList, request.params[0], request.params[1], request.params[2], request.params[3], request.params[4], ptx, keyOperator);
 
     CMutableTransaction tx;
     tx.nVersion = SYSCOIN_TX_VERSION_MN_UPDATE_SERVICE;
 
-    if (!request.params[3].isNull()) {
-        std::string nevmAddressStr = request.params[3].get_str();
-        if(nevmAddressStr.size() > 0) {
-            // Check if the string starts with "0x" and remove it
-            if (nevmAddressStr.rfind("0x", 0) == 0) {
-                nevmAddressStr = nevmAddressStr.substr(2);
-            } else {
-                throw JSONRPCError(RPC_INVALID_ADDRESS_OR_KEY, std::string("Invalid NEVM address (should start with 0x): ") + request.params[3].get_str());
-            }
-        
-            // Ethereum address must be exactly 20 bytes (40 hex characters)
-            if (nevmAddressStr.length() != 40 || !IsHex(nevmAddressStr)) {
-                throw JSONRPCError(RPC_INVALID_ADDRESS_OR_KEY, std::string("Invalid NEVM address (must be 20 bytes / 40 hex chars): ") + request.params[3].get_str());
-            }
-        
-            // Parse the hex address into bytes
-            ptx.vchNEVMAddress = ParseHex(nevmAddressStr);
-        }
-    }
-    // param operatorPayoutAddress
-    if (!request.params[4].isNull()) {
-        if (request.params[4].get_str().empty()) {
-            ptx.scriptOperatorPayout = dmn->pdmnState->scriptOperatorPayout;
-        } else {
-            CTxDestination payoutDest = DecodeDestination(request.params[4].get_str());
-            if (!IsValidDestination(payoutDest)) {
-                throw JSONRPCError(RPC_INVALID_ADDRESS_OR_KEY, strprintf("Invalid operator payout address: %s", request.params[4].get_str()));
-            }
-            ptx.scriptOperatorPayout = GetScriptForDestination(payoutDest);
-        }
-    } else {
-        ptx.scriptOperatorPayout = dmn->pdmnState->scriptOperatorPayout;
-    }
-
     CTxDestination feeSource;
 
     // param feeSourceAddress
@@ -838,6 +978,38 @@ static RPCHelpMan protx_update_service()
     };
 }
 
+// SYSCOIN
+/** Fill ptx and payoutDest from the protx_update_registrar arguments, checked against mnList. Returns the masternode. */
+static CDeterministicMNCPtr ParseProUpRegTx(const CDeterministicMNList& mnList, const UniValue& proTxHash, const UniValue& operatorPubKey, const UniValue& votingAddress,
+                                            const UniValue& payoutAddress, bool specific_legacy_bls_scheme, CProUpRegTx& ptx, CTxDestination& payoutDest)
+{
+    ptx.proTxHash = ParseHashV(proTxHash, "proTxHash");
+    auto dmn = mnList.GetMN(ptx.proTxHash);
+    if (!dmn) {
+        throw JSONRPCError(RPC_INVALID_PARAMETER, strprintf("masternode %s not found", ptx.proTxHash.ToString()));
+    }
+    ptx.pubKeyOperator = dmn->pdmnState->pubKeyOperator;
+    ptx.keyIDVoting = dmn->pdmnState->keyIDVoting;
+    ptx.scriptPayout = dmn->pdmnState->scriptPayout;
+
+    if (operatorPubKey.get_str() != "") {
+        ptx.pubKeyOperator.Set(ParseBLSPubKey(operatorPubKey.get_str(), "operator BLS address", specific_legacy_bls_scheme), specific_legacy_bls_scheme);
+    }
+    if (votingAddress.get_str() != "") {
+        ptx.keyIDVoting = ParsePubKeyIDFromAddress(votingAddress.get_str(), "voting address");
+    }
+
+    ExtractDestination(ptx.scriptPayout, payoutDest);
+    if (payoutAddress.get_str() != "") {
+        payoutDest = DecodeDestination(payoutAddress.get_str());
+        if (!IsValidDestination(payoutDest)) {
+            throw JSONRPCError(RPC_INVALID_ADDRESS_OR_KEY, strprintf("invalid payout address: %s", payoutAddress.get_str()));
+        }
+        ptx.scriptPayout = GetScriptForDestination(payoutDest);
+    }
+    return dmn;
+}
+
     static RPCHelpMan protx_update_registrar()
     {
             return RPCHelpMan{"protx_update_registrar",
@@ -888,34 +1060,10 @@ static RPCHelpMan protx_update_service()
         } else {
             ptx.nVersion = CProUpRegTx::GetVersion(v19active);
         }
-        ptx.proTxHash = ParseHashV(request.params[0], "proTxHash");
         auto mnList = deterministicMNManager->GetListAtChainTip();
-        auto dmn = mnList.GetMN(ptx.proTxHash);
-        if (!dmn) {
-            throw JSONRPCError(RPC_INVALID_PARAMETER, strprintf("masternode %s not found", ptx.proTxHash.ToString()));
-        }
-        ptx.pubKeyOperator = dmn->pdmnState->pubKeyOperator;
-        ptx.keyIDVoting = dmn->pdmnState->keyIDVoting;
-        ptx.scriptPayout = dmn->pdmnState->scriptPayout;
-
-        if (request.params[1].get_str() != "") {
-            ptx.pubKeyOperator.Set(ParseBLSPubKey(request.params[1].get_str(), "operator BLS address", specific_legacy_bls_scheme), specific_legacy_bls_scheme);
-        }
-        if (request.params[2].get_str() != "") {
-            ptx.keyIDVoting = ParsePubKeyIDFromAddress(request.params[2].get_str(), "voting address");
-        }
-
         CTxDestination payoutDest;
-        ExtractDestination(ptx.scriptPayout, payoutDest);
-        if (request.params[3].get_str() != "") {
-            payoutDest = DecodeDestination(request.params[3].get_str());
-            if (!IsValidDestination(payoutDest)) {
-                throw JSONRPCError(RPC_INVALID_ADDRESS_OR_KEY, strprintf("invalid payout address: %s", request.params[3].get_str()));
-            }
-            ptx.scriptPayout = GetScriptForDestination(payoutDest);
-        }
-        
-        
+        auto dmn = ParseProUpRegTx(mnList, request.params[0], request.params[1], request.params[2], request.params[3], specific_legacy_bls_scheme, ptx, payoutDest);
+
 
         CKey keyOwner;
         {
@@ -948,6 +1096,215 @@ static RPCHelpMan protx_update_service()
     }  
 
 
+// SYSCOIN
+static RPCHelpMan protx_update_service_batch()
+{
+    return RPCHelpMan{"protx_update_service_batch",
+        "\nCreates and sends a ProUpServTx for each of several masternodes, like protx_update_service.\n"
+        "The coins at feeSourceAddress are selected once: a funding transaction pays one output back to it\n"
+        "per masternode, and every ProUpServTx is funded from its own output. Failures are reported per masternode.\n",
+        {
+            {"targets", RPCArg::Type::ARR, RPCArg::Optional::NO, strprintf("The masternodes to update, at most %d.", MAX_SPECIAL_TX_BATCH),
+                {
+                    {"", RPCArg::Type::OBJ, RPCArg::Optional::OMITTED, "",
+                        {
+                            {"proTxHash", RPCArg::Type::STR_HEX, RPCArg::Optional::NO, "The hash of the initial ProRegTx."},
+                            {"ipAndPort", RPCArg::Type::STR, RPCArg::Optional::NO, "IP and port in the form \"IP:PORT\"."},
+                            {"operatorKey", RPCArg::Type::STR_HEX, RPCArg::Optional::NO, "The operator BLS private key associated with the\n"
+                                "registered operator public key."},
+                            {"nevmAddress", RPCArg::Type::STR, RPCArg::Optional::NO, "The NEVM address to associate with NEVM registry.\n"
+                                "If set to an empty string, any existing NEVM registry entry will be removed."},
+                            {"operatorPayoutAddress", RPCArg::Type::STR, RPCArg::Default{""}, "The address used for operator reward payments.\n"
+                                "If set to an empty string, the currently active payout address is reused."},
+                        },
+                    },
+                },
+            },
+            {"feeSourceAddress", RPCArg::Type::STR, RPCArg::Optional::NO, "The wallet will only use coins from this address to fund the ProTxs.\n"
+                "The private key belonging to this address must be known in your wallet."},
+            {"legacy", RPCArg::Type::BOOL, RPCArg::Optional::OMITTED, "Use Legacy BLS scheme (false by default)"},
+        },
+        RPCResult{
+            RPCResult::Type::OBJ, "", "",
+            {
+                {RPCResult::Type::STR_HEX, "fundingtxid", "The transaction funding the ProTxs"},
+                {RPCResult::Type::ARR, "transactions", "",
+                {
+                    {RPCResult::Type::OBJ, "", "",
+                    {
+                        {RPCResult::Type::STR_HEX, "proTxHash", "The masternode"},
+                        {RPCResult::Type::STR_HEX, "txid", /*optional=*/true, "The ProUpServTx, if it was sent"},
+                        {RPCResult::Type::STR, "error", /*optional=*/true, "Why the ProUpServTx was not sent"},
+                    }},
+                }},
+            }
+        },
+        RPCExamples{
+            HelpExampleCli("protx_update_service_batch", "'[{\"proTxHash\":\"<proTxHash>\",\"ipAndPort\":\"173.249.49.9:18369\",\"operatorKey\":\"<operatorKey>\",\"nevmAddress\":\"\"}]' tsys1qxh8am0c9w0q9kv7h7f9q2c4jrfjg63yawrgm0r")
+            + HelpExampleRpc("protx_update_service_batch", "[{\"proTxHash\":\"<proTxHash>\",\"ipAndPort\":\"173.249.49.9:18369\",\"operatorKey\":\"<operatorKey>\",\"nevmAddress\":\"\"}], \"tsys1qxh8am0c9w0q9kv7h7f9q2c4jrfjg63yawrgm0r\"")
+        },
+    [&](const RPCHelpMan& self, const node::JSONRPCRequest& request) -> UniValue
+{
+    std::shared_ptr<wallet::CWallet> const pwallet = GetWalletForJSONRPCRequest(request);
+    if (!pwallet) return NullUniValue;
+
+    EnsureWalletIsUnlocked(*pwallet);
+
+    pwallet->BlockUntilSyncedToCurrentChain();
+
+    bool v19active;
+    {
+        LOCK(cs_main);
+        v19active = llmq::CLLMQUtils::IsV19Active(*pwallet->chain().getHeight());
+    }
+    bool specific_legacy_bls_scheme{!v19active};
+    if (!request.params[2].isNull()) {
+        specific_legacy_bls_scheme = request.params[2].get_bool();
+    }
+    const CTxDestination feeSource = ParseSpecialTxBatchFeeSource(request.params[1]);
+
+    // every target is checked against the same list before anything is funded
+    auto mnList = deterministicMNManager->GetListAtChainTip();
+    std::vector<BatchSpecialTx> batch;
+    for (const UniValue& target : ParseSpecialTxBatchTargets(request.params[0])) {
+        CProUpServTx ptx;
+        if (specific_legacy_bls_scheme) {
+            ptx.nVersion = CProUpServTx::LEGACY_BLS_VERSION;
+        } else {
+            ptx.nVersion = CProUpServTx::GetVersion(v19active);
+        }
+        CBLSSecretKey keyOperator;
+        ParseProUpServTx(mnList, target.find_value("proTxHash"), target.find_value("ipAndPort"), target.find_value("operatorKey"),
+                         target.find_value("nevmAddress"), target.find_value("operatorPayoutAddress"), ptx, keyOperator);
+        batch.push_back({ptx.proTxHash, [&pwallet, &feeSource, ptx, keyOperator, specific_legacy_bls_scheme](const COutPoint& fundOutpoint) mutable {
+            CMutableTransaction tx;
+            tx.nVersion = SYSCOIN_TX_VERSION_MN_UPDATE_SERVICE;
+            FundSpecialTx(*pwallet, tx, ptx, feeSource, fundOutpoint);
+            SignSpecialTxPayloadByHash(tx, ptx, keyOperator, specific_legacy_bls_scheme);
+            SetTxPayload(tx, ptx);
+            return tx;
+        }});
+    }
+
+    LOCK(pwallet->cs_wallet);
+    return SendSpecialTxBatch(*pwallet, feeSource, batch);
+},
+    };
+}
+
+static RPCHelpMan protx_update_registrar_batch()
+{
+    return RPCHelpMan{"protx_update_registrar_batch",
+        "\nCreates and sends a ProUpRegTx for each of several masternodes, like protx_update_registrar.\n"
+        "The owner keys are read from the wallet once for the whole batch and the coins at feeSourceAddress\n"
+        "are selected once: a funding transaction pays one output back to it per masternode, and every\n"
+        "ProUpRegTx is funded from its own output. Failures are reported per masternode.\n",
+        {
+            {"targets", RPCArg::Type::ARR, RPCArg::Optional::NO, strprintf("The masternodes to update, at most %d.", MAX_SPECIAL_TX_BATCH),
+                {
+                    {"", RPCArg::Type::OBJ, RPCArg::Optional::OMITTED, "",
+                        {
+                            {"proTxHash", RPCArg::Type::STR_HEX, RPCArg::Optional::NO, "The hash of the initial ProRegTx."},
+                            {"operatorPubKey", RPCArg::Type::STR_HEX, RPCArg::Default{""}, "The operator BLS public key.\n"
+                                "If set to an empty string, the currently active operator BLS public key is reused."},
+                            {"votingAddress", RPCArg::Type::STR, RPCArg::Default{""}, "The voting key address.\n"
+                                "If set to an empty string, the currently active voting key address is reused."},
+                            {"payoutAddress", RPCArg::Type::STR, RPCArg::Default{""}, "The Syscoin address to use for masternode reward payments.\n"
+                                "If set to an empty string, the currently active payout address is reused."},
+                        },
+                    },
+                },
+            },
+            {"feeSourceAddress", RPCArg::Type::STR, RPCArg::Optional::NO, "The wallet will only use coins from this address to fund the ProTxs.\n"
+                "The private key belonging to this address must be known in your wallet."},
+            {"legacy", RPCArg::Type::BOOL, RPCArg::Optional::OMITTED, "Use Legacy BLS scheme (false by default)"},
+        },
+        RPCResult{
+            RPCResult::Type::OBJ, "", "",
+            {
+                {RPCResult::Type::STR_HEX, "fundingtxid", "The transaction funding the ProTxs"},
+                {RPCResult::Type::ARR, "transactions", "",
+                {
+                    {RPCResult::Type::OBJ, "", "",
+                    {
+                        {RPCResult::Type::STR_HEX, "proTxHash", "The masternode"},
+                        {RPCResult::Type::STR_HEX, "txid", /*optional=*/true, "The ProUpRegTx, if it was sent"},
+                        {RPCResult::Type::STR, "error", /*optional=*/true, "Why the ProUpRegTx was not sent"},
+                    }},
+                }},
+            }
+        },
+        RPCExamples{
+            HelpExampleCli("protx_update_registrar_batch", "'[{\"proTxHash\":\"<proTxHash>\",\"payoutAddress\":\"tsys1qxh8am0c9w0q9kv7h7f9q2c4jrfjg63yawrgm0r\"}]' tsys1qxh8am0c9w0q9kv7h7f9q2c4jrfjg63yawrgm0r")
+            + HelpExampleRpc("protx_update_registrar_batch", "[{\"proTxHash\":\"<proTxHash>\",\"payoutAddress\":\"tsys1qxh8am0c9w0q9kv7h7f9q2c4jrfjg63yawrgm0r\"}], \"tsys1qxh8am0c9w0q9kv7h7f9q2c4jrfjg63yawrgm0r\"")
+        },
+    [&](const RPCHelpMan& self, const node::JSONRPCRequest& request) -> UniValue
+{
+    std::shared_ptr<wallet::CWallet> const pwallet = GetWalletForJSONRPCRequest(request);
+    if (!pwallet) return NullUniValue;
+
+    // Make sure the results are valid at least up to the most recent block
+    // the user could have gotten from another RPC command prior to now
+    pwallet->BlockUntilSyncedToCurrentChain();
+    EnsureWalletIsUnlocked(*pwallet);
+    bool v19active;
+    {
+        LOCK(cs_main);
+        v19active = llmq::CLLMQUtils::IsV19Active(*pwallet->chain().getHeight());
+    }
+    bool specific_legacy_bls_scheme{!v19active};
+    if (!request.params[2].isNull()) {
+        specific_legacy_bls_scheme = request.params[2].get_bool();
+    }
+    const CTxDestination feeSource = ParseSpecialTxBatchFeeSource(request.params[1]);
+
+    const auto optionalStr = [](const UniValue& value) { return value.isNull() ? UniValue{""} : value; };
+    auto mnList = deterministicMNManager->GetListAtChainTip();
+    std::vector<std::pair<CProUpRegTx, CKeyID>> vecTargets;
+    for (const UniValue& target : ParseSpecialTxBatchTargets(request.params[0])) {
+        CProUpRegTx ptx;
+        if (specific_legacy_bls_scheme) {
+            ptx.nVersion = CProUpRegTx::LEGACY_BLS_VERSION;
+        } else {
+            ptx.nVersion = CProUpRegTx::GetVersion(v19active);
+        }
+        CTxDestination payoutDest;
+        auto dmn = ParseProUpRegTx(mnList, target.find_value("proTxHash"), optionalStr(target.find_value("operatorPubKey")), optionalStr(target.find_value("votingAddress")),
+                                   optionalStr(target.find_value("payoutAddress")), specific_legacy_bls_scheme, ptx, payoutDest);
+        // make sure we get anough fees added
+        ptx.vchSig.resize(65);
+        vecTargets.emplace_back(ptx, dmn->pdmnState->keyIDOwner);
+    }
+
+    LegacyScriptPubKeyMan& spk_man = EnsureLegacyScriptPubKeyMan(*pwallet, true);
+    LOCK2(pwallet->cs_wallet, spk_man.cs_KeyStore);
+    // masternodes of one owner share the owner key, it is read once
+    std::map<CKeyID, CKey> mapOwnerKeys;
+    for (const auto& [ptx, keyIDOwner] : vecTargets) {
+        if (mapOwnerKeys.count(keyIDOwner)) continue;
+        CKey keyOwner;
+        if (!spk_man.GetKey(keyIDOwner, keyOwner)) {
+            throw std::runtime_error(strprintf("Private key for owner address %s not found in your wallet", EncodeDestination(WitnessV0KeyHash(keyIDOwner))));
+        }
+        mapOwnerKeys.emplace(keyIDOwner, keyOwner);
+    }
+
+    std::vector<BatchSpecialTx> batch;
+    for (const auto& [ptx, keyIDOwner] : vecTargets) {
+        batch.push_back({ptx.proTxHash, [&pwallet, &feeSource, ptx = ptx, &keyOwner = mapOwnerKeys.at(keyIDOwner)](const COutPoint& fundOutpoint) mutable {
+            CMutableTransaction tx;
+            tx.nVersion = SYSCOIN_TX_VERSION_MN_UPDATE_REGISTRAR;
+            FundSpecialTx(*pwallet, tx, ptx, feeSource, fundOutpoint);
+            SignSpecialTxPayloadByHash(tx, ptx, keyOwner);
+            SetTxPayload(tx, ptx);
+            return tx;
+        }});
+    }
+    return SendSpecialTxBatch(*pwallet, feeSource, batch);
+},
+    };
+}
+
 static RPCHelpMan protx_revoke()
 {
         return RPCHelpMan{"protx_revoke",
@@ -1219,6 +1576,8 @@ Span<const CRPCCommand> wallet::GetEvoWalletRPCCommands()
         {"evowallet", &protx_register_submit},
         {"evowallet", &protx_update_service},
         {"evowallet", &protx_update_registrar},
+        {"evowallet", &protx_update_service_batch},
+        {"evowallet", &protx_update_registrar_batch},
         {"evowallet", &protx_revoke},
     };
     return commands;
@@ -79,6 +79,32 @@ UniValue VoteWithMasternodes(const std::map<uint256, CKey>& keys,
     return returnObj;
 }
 
+// SYSCOIN
+/** Voting keys of the valid masternodes of the tip list whose voting key is in the wallet, by proTxHash.
+ *  The key store is locked once and every voting key is looked up once, however many masternodes share it. */
+static std::map<uint256, CKey> GetWalletVotingKeys(CWallet& wallet)
+{
+    std::map<uint256, CKey> votingKeys;
+    auto mnList = deterministicMNManager->GetListAtChainTip();
+    LegacyScriptPubKeyMan& spk_man = EnsureLegacyScriptPubKeyMan(wallet);
+    LOCK2(wallet.cs_wallet, spk_man.cs_KeyStore);
+    EnsureWalletIsUnlocked(wallet);
+    std::map<CKeyID, std::optional<CKey>> keyCache;
+    mnList.ForEachMN(true, [&](const auto& dmn) {
+        auto [it, inserted] = keyCache.try_emplace(dmn.pdmnState->keyIDVoting);
+        if (inserted) {
+            CKey key;
+            if (spk_man.GetKey(dmn.pdmnState->keyIDVoting, key)) {
+                it->second = key;
+            }
+        }
+        if (it->second) {
+            votingKeys.emplace(dmn.proTxHash, *it->second);
+        }
+    });
+    return votingKeys;
+}
+
 static RPCHelpMan gobject_list_prepared()
 {
     return RPCHelpMan{"gobject_list_prepared",
@@ -281,27 +307,98 @@ static RPCHelpMan gobject_vote_many()
 
     EnsureWalletIsUnlocked(*pwallet);
 
-    std::map<uint256, CKey> votingKeys;
     // Make sure the results are valid at least up to the most recent block
     // the user could have gotten from another RPC command prior to now
     pwallet->BlockUntilSyncedToCurrentChain();
-    auto mnList = deterministicMNManager->GetListAtChainTip();
-    mnList.ForEachMN(true, [&](const auto& dmn) {
-        LegacyScriptPubKeyMan& spk_man = EnsureLegacyScriptPubKeyMan(*pwallet);
-        LOCK2(pwallet->cs_wallet, spk_man.cs_KeyStore);
+    const std::map<uint256, CKey> votingKeys = GetWalletVotingKeys(*pwallet);
 
-        EnsureWalletIsUnlocked(*pwallet);
+    return VoteWithMasternodes(votingKeys, hash, eVoteSignal, eVoteOutcome, *node.connman, *node.peerman);
+},
+    };
+} 
 
-        CKey key;
-        if (spk_man.GetKey(dmn.pdmnState->keyIDVoting, key)) {
-            votingKeys.emplace(dmn.proTxHash, key);
+// SYSCOIN
+static RPCHelpMan gobject_vote_many_batch()
+{
+    return RPCHelpMan{"gobject_vote_many_batch",
+        "\nCast several votes by all masternodes for which the voting key is present in the local wallet.\n"
+        "The voting keys are looked up once for the whole batch instead of once per vote.\n",
+        {
+            {"votes", RPCArg::Type::ARR, RPCArg::Optional::NO, "The votes to cast.",
+                {
+                    {"", RPCArg::Type::OBJ, RPCArg::Optional::OMITTED, "",
+                        {
+                            {"governanceHash", RPCArg::Type::STR_HEX, RPCArg::Optional::NO, "Hash of the governance object."},
+                            {"vote", RPCArg::Type::STR, RPCArg::Optional::NO, "Vote, possible values: [funding|valid|delete|endorsed]."},
+                            {"voteOutcome", RPCArg::Type::STR, RPCArg::Optional::NO, "Vote outcome, possible values: [yes|no|abstain]."},
+                        },
+                    },
+                },
+            },
+        },
+        RPCResult{RPCResult::Type::ANY, "", "The result of every vote, by governance object hash"},
+        RPCExamples{
+                HelpExampleCli("gobject_vote_many_batch", "'[{\"governanceHash\":\"<hash>\",\"vote\":\"funding\",\"voteOutcome\":\"yes\"}]'")
+            + HelpExampleRpc("gobject_vote_many_batch", "[{\"governanceHash\":\"<hash>\",\"vote\":\"funding\",\"voteOutcome\":\"yes\"}]")
+        },
+    [&](const RPCHelpMan& self, const node::JSONRPCRequest& request) -> UniValue
+{
+    std::shared_ptr<wallet::CWallet> const pwallet = GetWalletForJSONRPCRequest(request);
+    if (!pwallet) return NullUniValue;
+
+    node::NodeContext& node =  request.nodeContext? *request.nodeContext: EnsureAnyNodeContext(request.context);
+    if(!node.connman)
+        throw JSONRPCError(RPC_CLIENT_P2P_DISABLED, "Error: Peer-to-peer functionality missing or disabled");
+
+    struct BatchVote {
+        uint256 hash;
+        vote_signal_enum_t eVoteSignal;
+        vote_outcome_enum_t eVoteOutcome;
+    };
+    std::vector<BatchVote> votes;
+    for (const UniValue& voteObj : request.params[0].get_array().getValues()) {
+        RPCTypeCheckObj(voteObj,
+            {
+                {"governanceHash", UniValueType(UniValue::VSTR)},
+                {"vote", UniValueType(UniValue::VSTR)},
+                {"voteOutcome", UniValueType(UniValue::VSTR)},
+            });
+        BatchVote vote;
+        vote.hash = ParseHashO(voteObj, "governanceHash");
+        vote.eVoteSignal = CGovernanceVoting::ConvertVoteSignal(voteObj.find_value("vote").get_str());
+        if (vote.eVoteSignal == VOTE_SIGNAL_NONE) {
+            throw JSONRPCError(RPC_INVALID_PARAMETER,
+                               "Invalid vote signal. Please using one of the following: "
+                               "(funding|valid|delete|endorsed)");
         }
-    });
+        vote.eVoteOutcome = CGovernanceVoting::ConvertVoteOutcome(voteObj.find_value("voteOutcome").get_str());
+        if (vote.eVoteOutcome == VOTE_OUTCOME_NONE) {
+            throw JSONRPCError(RPC_INVALID_PARAMETER, "Invalid vote outcome. Please use one of the following: 'yes', 'no' or 'abstain'");
+        }
+        votes.push_back(vote);
+    }
 
-    return VoteWithMasternodes(votingKeys, hash, eVoteSignal, eVoteOutcome, *node.connman, *node.peerman);
+    EnsureWalletIsUnlocked(*pwallet);
+
+    // Make sure the results are valid at least up to the most recent block
+    // the user could have gotten from another RPC command prior to now
+    pwallet->BlockUntilSyncedToCurrentChain();
+    const std::map<uint256, CKey> votingKeys = GetWalletVotingKeys(*pwallet);
+
+    UniValue resultsObj(UniValue::VOBJ);
+    for (const auto& vote : votes) {
+        try {
+            resultsObj.pushKV(vote.hash.ToString(), VoteWithMasternodes(votingKeys, vote.hash, vote.eVoteSignal, vote.eVoteOutcome, *node.connman, *node.peerman));
+        } catch (const UniValue& objError) {
+            UniValue errorObj(UniValue::VOBJ);
+            errorObj.pushKV("errorMessage", objError.find_value("message"));
+            resultsObj.pushKV(vote.hash.ToString(), errorObj);
+        }
+    }
+    return resultsObj;
 },
     };
-} 
+}
 
 static RPCHelpMan gobject_vote_alias()
 {
@@ -379,6 +476,7 @@ Span<const CRPCCommand> wallet::GetGovernanceWalletRPCCommands()
     static const CRPCCommand commands[]{
         {"governancewallet", &gobject_vote_alias},
         {"governancewallet", &gobject_vote_many},
+        {"governancewallet", &gobject_vote_many_batch},
         {"governancewallet", &gobject_prepare},
         {"governancewallet", &gobject_list_prepared},
     };
@@ -12,6 +12,7 @@
 #include <script/script.h>
 #include <script/signingprovider.h>
 #include <util/error.h>
+#include <util/hasher.h>
 #include <util/message.h>
 #include <util/result.h>
 #include <util/time.h>
@@ -555,7 +556,8 @@ public:
 class DescriptorScriptPubKeyMan : public ScriptPubKeyMan
 {
 private:
-    using ScriptPubKeyMap = std::map<CScript, int32_t>; // Map of scripts to descriptor range index
+    // SYSCOIN salted hash map, IsMine looks up every output script of synced transactions here
+    using ScriptPubKeyMap = std::unordered_map<CScript, int32_t, SaltedSipHasher>; // Map of scripts to descriptor range index
     using PubKeyMap = std::map<CPubKey, int32_t>; // Map of pubkeys involved in scripts to descriptor range index
     using CryptedKeyMap = std::map<CKeyID, std::pair<CPubKey, std::vector<unsigned char>>>;
     using KeyMap = std::map<CKeyID, CKey>;
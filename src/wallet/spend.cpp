@@ -318,11 +318,29 @@ CoinsResult AvailableCoins(const CWallet& wallet,
     const bool can_grind_r = wallet.CanGrindR();
     std::vector<COutPoint> outpoints;
 
+    // SYSCOIN with an asset filter only the transactions holding outputs of that asset are walked
+    std::vector<const CWalletTx*> wtxs;
+    if (params.asset) {
+        const auto it = wallet.m_asset_txs.find(*params.asset);
+        if (it != wallet.m_asset_txs.end()) {
+            wtxs.reserve(it->second.size());
+            for (const uint256& txid : it->second) {
+                const auto mit = wallet.mapWallet.find(txid);
+                if (mit != wallet.mapWallet.end()) wtxs.push_back(&mit->second);
+            }
+        }
+    } else {
+        wtxs.reserve(wallet.mapWallet.size());
+        for (const auto& entry : wallet.mapWallet) {
+            wtxs.push_back(&entry.second);
+        }
+    }
+
     std::set<uint256> trusted_parents;
-    for (const auto& entry : wallet.mapWallet)
+    for (const CWalletTx* pwtx : wtxs)
     {
-        const uint256& wtxid = entry.first;
-        const CWalletTx& wtx = entry.second;
+        const CWalletTx& wtx = *pwtx;
+        const uint256& wtxid = wtx.GetHash();
 
         if (wallet.IsTxImmatureCoinBase(wtx) && !params.include_immature_coinbase)
             continue;
@@ -383,6 +401,10 @@ CoinsResult AvailableCoins(const CWallet& wallet,
             const CTxOut& output = wtx.tx->vout[i];
             const COutPoint outpoint(wtxid, i);
 
+            // SYSCOIN
+            if (params.asset && (output.assetInfo.IsNull() || output.assetInfo.nAsset != *params.asset))
+                continue;
+
             if (output.nValue < params.min_amount || output.nValue > params.max_amount)
                 continue;
 
@@ -1083,7 +1105,7 @@ static util::Result<CreatedTransactionResult> CreateTransactionInternal(
         const auto &destination = GetScriptForDestination(recipient.dest);
         CTxOut txout(recipient.nAmount, destination);
         // add poda data to opreturn output
-        if(!coin_control.m_nevmdata.empty() && destination.IsUnspendable()) {
+        if(coin_control.m_nevmdata && !coin_control.m_nevmdata->empty() && destination.IsUnspendable()) {
             txout.vchNEVMData = coin_control.m_nevmdata;
         }
 
@@ -1335,7 +1357,7 @@ bool FundTransaction(CWallet& wallet, CMutableTransaction& tx, CAmount& nFeeRet,
     for (size_t idx = 0; idx < tx.vout.size(); idx++) {
         const CTxOut& txOut = tx.vout[idx];
         // SYSCOIN
-        if(coinControl.m_nevmdata.empty() && !txOut.vchNEVMData.empty()) {
+        if(!coinControl.m_nevmdata && txOut.HasNEVMData()) {
             coinControl.m_nevmdata = txOut.vchNEVMData;
         }
         CTxDestination dest;
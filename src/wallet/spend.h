@@ -78,6 +78,8 @@ struct CoinFilterParams {
     bool include_immature_coinbase{false};
     // By default, skip locked UTXOs
     bool skip_locked{true};
+    // SYSCOIN only return outputs of this asset guid
+    std::optional<uint64_t> asset;
 };
 
 /**
@@ -988,5 +988,140 @@ BOOST_FIXTURE_TEST_CASE(wallet_sync_tx_invalid_state_test, TestingSetup)
                           HasReason("DB error adding transaction to wallet, write failed"));
 }
 
+// SYSCOIN
+BOOST_FIXTURE_TEST_CASE(wallet_asset_coins_test, TestingSetup)
+{
+    CWallet wallet(m_node.chain.get(), "", CreateMockableWalletDatabase());
+    {
+        LOCK(wallet.cs_wallet);
+        wallet.SetWalletFlag(WALLET_FLAG_DESCRIPTORS);
+        wallet.SetupDescriptorScriptPubKeyMans();
+    }
+    const CScript script{GetScriptForDestination(*Assert(wallet.GetNewDestination(OutputType::BECH32, "")))};
+
+    CMutableTransaction mtx;
+    mtx.nVersion = SYSCOIN_TX_VERSION_ALLOCATION_SEND;
+    mtx.vin.emplace_back(g_insecure_rand_ctx.rand256(), 0);
+    mtx.vout.emplace_back(COIN, script, CAssetCoinInfo(1, 10 * COIN));
+    mtx.vout.emplace_back(COIN, script, CAssetCoinInfo(2, 20 * COIN));
+    mtx.vout.emplace_back(COIN, script);
+    const uint256 asset_txid = wallet.AddToWallet(MakeTransactionRef(mtx), TxStateInMempool{})->GetHash();
+
+    CMutableTransaction mtx_sys;
+    mtx_sys.vin.emplace_back(g_insecure_rand_ctx.rand256(), 0);
+    mtx_sys.vout.emplace_back(COIN, script);
+    wallet.AddToWallet(MakeTransactionRef(mtx_sys), TxStateInMempool{});
+
+    LOCK(wallet.cs_wallet);
+    BOOST_CHECK_EQUAL(wallet.m_asset_txs.size(), 2U);
+    BOOST_CHECK_EQUAL(wallet.m_asset_txs.at(1).count(asset_txid), 1U);
+
+    CCoinControl coin_control;
+    coin_control.m_include_unsafe_inputs = true;
+    BOOST_CHECK_EQUAL(AvailableCoins(wallet, &coin_control).Size(), 4U);
+    CoinFilterParams filter;
+    filter.asset = 1;
+    const CoinsResult asset_coins{AvailableCoins(wallet, &coin_control, std::nullopt, filter)};
+    BOOST_CHECK_EQUAL(asset_coins.Size(), 1U);
+    BOOST_CHECK(asset_coins.All().at(0).outpoint == COutPoint(asset_txid, 0));
+    filter.asset = 3;
+    BOOST_CHECK_EQUAL(AvailableCoins(wallet, &coin_control, std::nullopt, filter).Size(), 0U);
+
+    // zapped transactions leave the buckets
+    std::vector<uint256> vHashIn{asset_txid}, vHashOut;
+    BOOST_CHECK_EQUAL(wallet.ZapSelectTx(vHashIn, vHashOut), DBErrors::LOAD_OK);
+    BOOST_CHECK(wallet.m_asset_txs.empty());
+}
+
+BOOST_FIXTURE_TEST_CASE(wallet_asset_balance_cache_test, TestingSetup)
+{
+    CWallet wallet(m_node.chain.get(), "", CreateMockableWalletDatabase());
+    {
+        LOCK(wallet.cs_wallet);
+        wallet.SetWalletFlag(WALLET_FLAG_DESCRIPTORS);
+        wallet.SetupDescriptorScriptPubKeyMans();
+    }
+    const CScript script{GetScriptForDestination(*Assert(wallet.GetNewDestination(OutputType::BECH32, "")))};
+
+    CMutableTransaction mtx;
+    mtx.nVersion = SYSCOIN_TX_VERSION_ALLOCATION_SEND;
+    mtx.vin.emplace_back(g_insecure_rand_ctx.rand256(), 0);
+    mtx.vout.emplace_back(COIN, script, CAssetCoinInfo(1, 10 * COIN));
+    mtx.vout.emplace_back(COIN, script, CAssetCoinInfo(2, 20 * COIN));
+    const uint256 asset_txid = wallet.AddToWallet(MakeTransactionRef(mtx), TxStateInMempool{})->GetHash();
+
+    // received from others, so pending until confirmed
+    auto balances = GetAssetBalances(wallet);
+    BOOST_REQUIRE_EQUAL(balances.size(), 2U);
+    BOOST_CHECK_EQUAL(balances.at(1).m_mine_untrusted_pending, 10 * COIN);
+    BOOST_CHECK_EQUAL(balances.at(2).m_mine_untrusted_pending, 20 * COIN);
+    BOOST_CHECK_EQUAL(balances.at(1).m_mine_trusted, 0);
+    BOOST_CHECK_EQUAL(GetBalance(wallet).m_mine_untrusted_pending, 2 * COIN);
+    {
+        LOCK(wallet.cs_wallet);
+        BOOST_CHECK_EQUAL(wallet.m_balance_cache.size(), 3U);
+    }
+
+    // spending asset 1 drops its entry and the SYS ones only
+    CMutableTransaction mtx_spend;
+    mtx_spend.nVersion = SYSCOIN_TX_VERSION_ALLOCATION_SEND;
+    mtx_spend.vin.emplace_back(asset_txid, 0);
+    mtx_spend.vout.emplace_back(COIN / 2, CScript() << OP_TRUE, CAssetCoinInfo(1, 10 * COIN));
+    wallet.AddToWallet(MakeTransactionRef(mtx_spend), TxStateInMempool{});
+    {
+        LOCK(wallet.cs_wallet);
+        BOOST_CHECK_EQUAL(wallet.m_balance_cache.size(), 1U);
+        BOOST_CHECK_EQUAL(wallet.m_balance_cache.count({2, true}), 1U);
+    }
+    BOOST_CHECK_EQUAL(GetAssetBalance(wallet, 1).m_mine_untrusted_pending, 0);
+    BOOST_CHECK_EQUAL(GetAssetBalance(wallet, 2).m_mine_untrusted_pending, 20 * COIN);
+    BOOST_CHECK_EQUAL(GetAssetBalance(wallet, 3).m_mine_untrusted_pending, 0);
+
+    // a deeper depth is not cached, no asset output is confirmed yet
+    BOOST_CHECK_EQUAL(GetAssetBalance(wallet, 2, /*min_depth=*/1).m_mine_trusted, 0);
+}
+
+BOOST_FIXTURE_TEST_CASE(wallet_ismine_memo_test, TestingSetup)
+{
+    CWallet wallet(m_node.chain.get(), "", CreateMockableWalletDatabase());
+    {
+        LOCK(wallet.cs_wallet);
+        wallet.SetWalletFlag(WALLET_FLAG_DESCRIPTORS);
+        wallet.SetupDescriptorScriptPubKeyMans();
+    }
+    const CScript script{GetScriptForDestination(*Assert(wallet.GetNewDestination(OutputType::BECH32, "")))};
+    const CScript foreign_script{CScript() << OP_TRUE};
+
+    // an asset tx repeating the wallet's script over its outputs
+    CMutableTransaction mtx;
+    mtx.nVersion = SYSCOIN_TX_VERSION_ALLOCATION_SEND;
+    mtx.vin.emplace_back(g_insecure_rand_ctx.rand256(), 0);
+    for (int i = 0; i < 4; ++i) {
+        mtx.vout.emplace_back(COIN, script, CAssetCoinInfo(1, COIN));
+        mtx.vout.emplace_back(COIN, foreign_script, CAssetCoinInfo(1, COIN));
+    }
+    wallet.transactionAddedToMempool(MakeTransactionRef(mtx));
+    LOCK(wallet.cs_wallet);
+    BOOST_REQUIRE(wallet.GetWalletTx(mtx.GetHash()));
+
+    // only scripts that are mine are remembered
+    BOOST_CHECK_EQUAL(wallet.m_ismine_memo.size(), 1U);
+    BOOST_CHECK_EQUAL(wallet.m_ismine_memo.count(script), 1U);
+    BOOST_CHECK_EQUAL(wallet.IsMine(foreign_script), ISMINE_NO);
+    BOOST_CHECK_EQUAL(wallet.m_ismine_memo.size(), 1U);
+    BOOST_CHECK_EQUAL(CachedTxGetCredit(wallet, *wallet.GetWalletTx(mtx.GetHash()), ISMINE_SPENDABLE), 4 * COIN);
+
+    // a connected block drops the memo
+    CBlock block;
+    const uint256 block_hash{block.GetHash()};
+    interfaces::BlockInfo info{block_hash};
+    info.data = &block;
+    info.height = 1;
+    wallet.blockConnected(ChainstateRole::NORMAL, info);
+    BOOST_CHECK(wallet.m_ismine_memo.empty());
+    BOOST_CHECK_EQUAL(wallet.IsMine(script), ISMINE_SPENDABLE);
+    BOOST_CHECK_EQUAL(wallet.m_ismine_memo.size(), 1U);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 } // namespace wallet
@@ -5,6 +5,7 @@
 #include <wallet/test/util.h>
 #include <wallet/wallet.h>
 #include <test/util/logging.h>
+#include <test/util/random.h>
 #include <test/util/setup_common.h>
 
 #include <boost/test/unit_test.hpp>
@@ -209,5 +210,71 @@ BOOST_FIXTURE_TEST_CASE(wallet_load_ckey, TestingSetup)
     }
 }
 
+// SYSCOIN
+BOOST_FIXTURE_TEST_CASE(wallet_load_tx_records, TestingSetup)
+{
+    // enough records for the decoding to be split over threads
+    constexpr int TX_COUNT{600};
+    MockableData records;
+    //! asset and order position of every tx
+    std::map<uint256, std::pair<uint64_t, int64_t>> loaded_txs;
+    {
+        std::shared_ptr<CWallet> wallet(new CWallet(m_node.chain.get(), "", CreateMockableWalletDatabase()));
+        LOCK(wallet->cs_wallet);
+        wallet->SetWalletFlag(WALLET_FLAG_DESCRIPTORS);
+        wallet->SetupDescriptorScriptPubKeyMans();
+        const CScript script{GetScriptForDestination(*Assert(wallet->GetNewDestination(OutputType::BECH32, "")))};
+        for (int i = 0; i < TX_COUNT; ++i) {
+            CMutableTransaction mtx;
+            mtx.vin.emplace_back(InsecureRand256(), 0);
+            uint64_t nAsset{0};
+            if (i % 2) {
+                nAsset = 1 + i % 7;
+                mtx.nVersion = SYSCOIN_TX_VERSION_ALLOCATION_SEND;
+                mtx.vout.emplace_back(COIN, script, CAssetCoinInfo(nAsset, i * COIN));
+                CAssetAllocation allocation;
+                allocation.voutAssets.emplace_back(nAsset, std::vector<CAssetOutValue>{CAssetOutValue(0, i * COIN)});
+                std::vector<unsigned char> data;
+                allocation.SerializeData(data);
+                mtx.vout.emplace_back(0, CScript() << OP_RETURN << data);
+            } else {
+                mtx.vout.emplace_back(COIN, script);
+            }
+            const CWalletTx* wtx = Assert(wallet->AddToWallet(MakeTransactionRef(mtx), TxStateInactive{}));
+            loaded_txs.emplace(wtx->GetHash(), std::make_pair(nAsset, wtx->nOrderPos));
+        }
+        records = GetMockableDatabase(*wallet).m_records;
+    }
+
+    {
+        // every tx comes back, asset outputs with their allocation and in their order
+        std::shared_ptr<CWallet> wallet(new CWallet(m_node.chain.get(), "", CreateMockableWalletDatabase(records)));
+        BOOST_CHECK_EQUAL(wallet->LoadWallet(), DBErrors::LOAD_OK);
+        LOCK(wallet->cs_wallet);
+        BOOST_CHECK_EQUAL(wallet->mapWallet.size(), loaded_txs.size());
+        for (const auto& [txid, tx_info] : loaded_txs) {
+            const CWalletTx* wtx = wallet->GetWalletTx(txid);
+            BOOST_REQUIRE(wtx);
+            BOOST_CHECK_EQUAL(wtx->tx->vout[0].assetInfo.nAsset, tx_info.first);
+            BOOST_CHECK_EQUAL(wtx->nOrderPos, tx_info.second);
+        }
+        BOOST_CHECK_EQUAL(wallet->m_asset_txs.size(), 7U);
+    }
+
+    {
+        // a record that does not decode fails the load
+        auto it = std::find_if(records.begin(), records.end(), [](const auto& record) {
+            DataStream key{record.first};
+            std::string type;
+            key >> type;
+            return type == DBKeys::TX;
+        });
+        BOOST_REQUIRE(it != records.end());
+        it->second.resize(10);
+        std::shared_ptr<CWallet> wallet(new CWallet(m_node.chain.get(), "", CreateMockableWalletDatabase(records)));
+        BOOST_CHECK_EQUAL(wallet->LoadWallet(), DBErrors::CORRUPT);
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 } // namespace wallet
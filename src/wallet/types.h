@@ -13,6 +13,8 @@
 #ifndef SYSCOIN_WALLET_TYPES_H
 #define SYSCOIN_WALLET_TYPES_H
 
+#include <consensus/amount.h>
+
 #include <type_traits>
 
 namespace wallet {
@@ -62,6 +64,15 @@ enum class AddressPurpose {
     SEND,
     REFUND, //!< Never set in current code may be present in older wallet databases
 };
+
+struct Balance {
+    CAmount m_mine_trusted{0};           //!< Trusted, at depth=GetBalance.min_depth or more
+    CAmount m_mine_untrusted_pending{0}; //!< Untrusted, but in mempool (pending)
+    CAmount m_mine_immature{0};          //!< Immature coinbases in the main chain
+    CAmount m_watchonly_trusted{0};
+    CAmount m_watchonly_untrusted_pending{0};
+    CAmount m_watchonly_immature{0};
+};
 } // namespace wallet
 
 #endif // SYSCOIN_WALLET_TYPES_H
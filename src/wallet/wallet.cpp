@@ -58,6 +58,7 @@
 #include <util/moneystr.h>
 #include <util/result.h>
 #include <util/string.h>
+#include <util/threadnames.h>
 #include <util/time.h>
 #include <util/translation.h>
 #include <wallet/coincontrol.h>
@@ -74,7 +75,9 @@
 #include <algorithm>
 #include <cassert>
 #include <condition_variable>
+#include <deque>
 #include <exception>
+#include <limits>
 #include <optional>
 // SYSCOIN
 #include <evo/deterministicmns.h>
@@ -358,6 +361,105 @@ private:
         }
     }
 };
+
+// SYSCOIN
+/**
+ * Reads the blocks a rescan is about to inspect on worker threads, so reading and
+ * deserializing them overlaps with applying the blocks before them. The rescan still
+ * takes and applies the blocks one by one in chain order, requests are only a hint:
+ * a block that was not requested, or was replaced by a reorg, is read by the rescan.
+ */
+class RescanBlockPrefetcher
+{
+public:
+    RescanBlockPrefetcher(interfaces::Chain& chain, int threads) : m_chain(chain)
+    {
+        for (int i = 0; i < threads; ++i) {
+            m_threads.emplace_back([this, i] {
+                util::ThreadRename(strprintf("rescanread.%i", i));
+                ThreadRead();
+            });
+        }
+    }
+
+    ~RescanBlockPrefetcher()
+    {
+        WITH_LOCK(m_mutex, m_stop = true);
+        m_cv.notify_all();
+        for (auto& thread : m_threads) thread.join();
+    }
+
+    /** Number of blocks requested and not taken yet */
+    size_t Pending() const EXCLUSIVE_LOCKS_REQUIRED(!m_mutex)
+    {
+        LOCK(m_mutex);
+        return m_blocks.size();
+    }
+
+    void Request(int height, const uint256& hash) EXCLUSIVE_LOCKS_REQUIRED(!m_mutex)
+    {
+        {
+            LOCK(m_mutex);
+            m_blocks.emplace(height, Entry{.hash = hash, .block = {}, .done = false});
+            m_queue.push_back(height);
+        }
+        m_cv.notify_one();
+    }
+
+    /** Move the block at height into block if it was requested with hash, waiting for its read. Drops the blocks below height. */
+    bool Take(int height, const uint256& hash, CBlock& block) EXCLUSIVE_LOCKS_REQUIRED(!m_mutex)
+    {
+        WAIT_LOCK(m_mutex, lock);
+        m_blocks.erase(m_blocks.begin(), m_blocks.lower_bound(height));
+        const auto it = m_blocks.find(height);
+        if (it == m_blocks.end() || it->second.hash != hash) return false;
+        m_cv.wait(lock, [&]() EXCLUSIVE_LOCKS_REQUIRED(m_mutex) { return it->second.done; });
+        block = std::move(it->second.block);
+        m_blocks.erase(it);
+        return true;
+    }
+
+private:
+    struct Entry {
+        uint256 hash;
+        CBlock block;
+        bool done{false};
+    };
+    interfaces::Chain& m_chain;
+    mutable Mutex m_mutex;
+    std::condition_variable m_cv;
+    //! requested blocks by height, the rescan takes them in order
+    std::map<int, Entry> m_blocks GUARDED_BY(m_mutex);
+    std::deque<int> m_queue GUARDED_BY(m_mutex);
+    bool m_stop GUARDED_BY(m_mutex){false};
+    std::vector<std::thread> m_threads;
+
+    void ThreadRead() EXCLUSIVE_LOCKS_REQUIRED(!m_mutex)
+    {
+        WAIT_LOCK(m_mutex, lock);
+        while (true) {
+            m_cv.wait(lock, [&]() EXCLUSIVE_LOCKS_REQUIRED(m_mutex) { return m_stop || !m_queue.empty(); });
+            if (m_stop) return;
+            const int height = m_queue.front();
+            m_queue.pop_front();
+            const auto it = m_blocks.find(height);
+            // taken over by the rescan already
+            if (it == m_blocks.end()) continue;
+            const uint256 hash = it->second.hash;
+            CBlock block;
+            {
+                REVERSE_LOCK(lock);
+                m_chain.findBlock(hash, FoundBlock().data(block));
+            }
+            // the entry may be gone while the lock was released
+            const auto it_done = m_blocks.find(height);
+            if (it_done == m_blocks.end() || it_done->second.hash != hash) continue;
+            it_done->second.block = std::move(block);
+            it_done->second.done = true;
+            m_cv.notify_all();
+        }
+    }
+};
 } // namespace
 
 std::shared_ptr<CWallet> LoadWallet(WalletContext& context, const std::string& name, std::optional<bool> load_on_start, const DatabaseOptions& options, DatabaseStatus& status, bilingual_str& error, std::vector<bilingual_str>& warnings)
@@ -790,6 +892,54 @@ void CWallet::AddToSpends(const CWalletTx& wtx, WalletBatch* batch)
         AddToSpends(txin.prevout, wtx.GetHash(), batch);
 }
 
+// SYSCOIN
+void CWallet::AddToAssetTxs(const CWalletTx& wtx)
+{
+    for (const CTxOut& txout : wtx.tx->vout) {
+        if (!txout.assetInfo.IsNull()) {
+            m_asset_txs[txout.assetInfo.nAsset].insert(wtx.GetHash());
+        }
+    }
+}
+
+void CWallet::RemoveFromAssetTxs(const CWalletTx& wtx)
+{
+    for (const CTxOut& txout : wtx.tx->vout) {
+        if (txout.assetInfo.IsNull()) continue;
+        auto it = m_asset_txs.find(txout.assetInfo.nAsset);
+        if (it == m_asset_txs.end()) continue;
+        it->second.erase(wtx.GetHash());
+        if (it->second.empty()) m_asset_txs.erase(it);
+    }
+}
+
+void CWallet::MarkBalancesDirty(const CWalletTx& wtx)
+{
+    MarkSYSBalancesDirty();
+    const auto mark_asset_dirty = [&](const CTxOut& txout) {
+        if (txout.assetInfo.IsNull()) return;
+        m_balance_cache.erase({txout.assetInfo.nAsset, false});
+        m_balance_cache.erase({txout.assetInfo.nAsset, true});
+    };
+    for (const CTxOut& txout : wtx.tx->vout) {
+        mark_asset_dirty(txout);
+    }
+    // the state of a spend decides whether the coins it spends count
+    if (m_balance_cache.empty()) return;
+    for (const CTxIn& txin : wtx.tx->vin) {
+        const auto it = mapWallet.find(txin.prevout.hash);
+        if (it != mapWallet.end() && txin.prevout.n < it->second.tx->vout.size()) {
+            mark_asset_dirty(it->second.tx->vout[txin.prevout.n]);
+        }
+    }
+}
+
+void CWallet::MarkSYSBalancesDirty()
+{
+    m_balance_cache.erase({0, false});
+    m_balance_cache.erase({0, true});
+}
+
 bool CWallet::EncryptWallet(const SecureString& strWalletPassphrase)
 {
     if (IsCrypted())
@@ -968,6 +1118,8 @@ void CWallet::MarkDirty()
         LOCK(cs_wallet);
         for (std::pair<const uint256, CWalletTx>& item : mapWallet)
             item.second.MarkDirty();
+        // SYSCOIN
+        m_balance_cache.clear();
     }
 }
 
@@ -989,6 +1141,8 @@ bool CWallet::MarkReplaced(const uint256& originalHash, const uint256& newHash)
 
     // Refresh mempool status without waiting for transactionRemovedFromMempool or transactionAddedToMempool
     RefreshMempoolStatus(wtx, chain());
+    // SYSCOIN
+    MarkBalancesDirty(wtx);
 
     WalletBatch batch(GetDatabase());
 
@@ -1085,6 +1239,7 @@ CWalletTx* CWallet::AddToWallet(CTransactionRef tx, const TxState& state, const
         wtx.nTimeSmart = ComputeTimeSmart(wtx, rescanning_old_block);
         AddToSpends(wtx, &batch);
         // SYSCOIN
+        AddToAssetTxs(wtx);
         auto mnList = deterministicMNManager->GetListAtChainTip();
         for(unsigned int i = 0; i < wtx.tx->vout.size(); ++i) {
             if (IsMine(wtx.tx->vout[i]) && !IsSpent(COutPoint(hash, i))) {
@@ -1127,6 +1282,8 @@ CWalletTx* CWallet::AddToWallet(CTransactionRef tx, const TxState& state, const
             desc_tx->m_state = inactive_state;
             // Break caches since we have changed the state
             desc_tx->MarkDirty();
+            // SYSCOIN
+            MarkBalancesDirty(*desc_tx);
             batch.WriteTx(*desc_tx);
             MarkInputsDirty(desc_tx->tx);
             for (unsigned int i = 0; i < desc_tx->tx->vout.size(); ++i) {
@@ -1152,6 +1309,8 @@ CWalletTx* CWallet::AddToWallet(CTransactionRef tx, const TxState& state, const
 
     // Break debit/credit balance caches:
     wtx.MarkDirty();
+    // SYSCOIN
+    MarkBalancesDirty(wtx);
 
     // Notify UI of new or updated transaction
     NotifyTransactionChanged(hash, fInsertedNew ? CT_NEW : CT_UPDATED);
@@ -1219,6 +1378,8 @@ bool CWallet::LoadToWallet(const uint256& hash, const UpdateWalletTxFn& fill_wtx
         wtx.m_it_wtxOrdered = wtxOrdered.insert(std::make_pair(wtx.nOrderPos, &wtx));
     }
     AddToSpends(wtx);
+    // SYSCOIN
+    AddToAssetTxs(wtx);
     for (const CTxIn& txin : wtx.tx->vin) {
         auto it = mapWallet.find(txin.prevout.hash);
         if (it != mapWallet.end()) {
@@ -1252,7 +1413,27 @@ bool CWallet::AddToWalletIfInvolvingMe(const CTransactionRef& ptx, const SyncTxS
 
         bool fExisted = mapWallet.count(tx.GetHash()) != 0;
         if (fExisted && !fUpdate) return false;
-        if (fExisted || IsMine(tx) || IsFromMe(tx))
+        // SYSCOIN find the outputs that are mine in one pass, a script repeated over
+        // the outputs of an asset tx is looked up once
+        std::vector<bool> vecOutputMine(tx.vout.size(), false);
+        bool fAnyOutputMine{false};
+        {
+            std::map<CScript, bool> mapAssetScriptMine;
+            for (size_t i = 0; i < tx.vout.size(); ++i) {
+                const CScript& script = tx.vout[i].scriptPubKey;
+                if (tx.HasAssets()) {
+                    auto [it, inserted] = mapAssetScriptMine.try_emplace(script, false);
+                    if (inserted) {
+                        it->second = IsMine(script) != ISMINE_NO;
+                    }
+                    vecOutputMine[i] = it->second;
+                } else {
+                    vecOutputMine[i] = IsMine(script) != ISMINE_NO;
+                }
+                fAnyOutputMine |= vecOutputMine[i];
+            }
+        }
+        if (fExisted || fAnyOutputMine || IsFromMe(tx))
         {
             /* Check if any keys in the wallet keypool that were supposed to be unused
              * have appeared in a new transaction. If so, remove those keys from the keypool.
@@ -1260,10 +1441,18 @@ bool CWallet::AddToWalletIfInvolvingMe(const CTransactionRef& ptx, const SyncTxS
              * the mostly recently created transactions from newer versions of the wallet.
              */
 
+            // SYSCOIN descriptors only provide for their own scripts, so outputs found not
+            // to be mine are skipped until marking an address used tops up the descriptors
+            const bool fDescriptors{IsWalletFlagSet(WALLET_FLAG_DESCRIPTORS)};
+            bool fToppedUp{false};
             // loop though all outputs
-            for (const CTxOut& txout: tx.vout) {
+            for (size_t i = 0; i < tx.vout.size(); ++i) {
+                const CTxOut& txout = tx.vout[i];
+                if (fDescriptors && !fToppedUp && !vecOutputMine[i]) continue;
                 for (const auto& spk_man : GetScriptPubKeyMans(txout.scriptPubKey)) {
-                    for (auto &dest : spk_man->MarkUnusedAddresses(txout.scriptPubKey)) {
+                    const auto used_dests = spk_man->MarkUnusedAddresses(txout.scriptPubKey);
+                    fToppedUp |= !used_dests.empty();
+                    for (auto dest : used_dests) {
                         // If internal flag is not defined try to infer it from the ScriptPubKeyMan
                         if (!dest.internal.has_value()) {
                             dest.internal = IsInternalScriptPubKeyMan(spk_man);
@@ -1310,6 +1499,8 @@ void CWallet::MarkInputsDirty(const CTransactionRef& tx)
         auto it = mapWallet.find(txin.prevout.hash);
         if (it != mapWallet.end()) {
             it->second.MarkDirty();
+            // SYSCOIN
+            MarkBalancesDirty(it->second);
         }
     }
 }
@@ -1399,6 +1590,8 @@ void CWallet::RecursiveUpdateTxState(const uint256& tx_hash, const TryUpdatingSt
         TxUpdate update_state = try_updating_state(wtx);
         if (update_state != TxUpdate::UNCHANGED) {
             wtx.MarkDirty();
+            // SYSCOIN
+            MarkBalancesDirty(wtx);
             batch.WriteTx(wtx);
             // Iterate over all its outputs, and update those tx states as well (if applicable)
             for (unsigned int i = 0; i < wtx.tx->vout.size(); ++i) {
@@ -1439,6 +1632,8 @@ void CWallet::transactionAddedToMempool(const CTransactionRef& tx) {
     auto it = mapWallet.find(tx->GetHash());
     if (it != mapWallet.end()) {
         RefreshMempoolStatus(it->second, chain());
+        // SYSCOIN
+        MarkBalancesDirty(it->second);
     }
 }
 
@@ -1447,6 +1642,8 @@ void CWallet::transactionRemovedFromMempool(const CTransactionRef& tx, MemPoolRe
     auto it = mapWallet.find(tx->GetHash());
     if (it != mapWallet.end()) {
         RefreshMempoolStatus(it->second, chain());
+        // SYSCOIN
+        MarkBalancesDirty(it->second);
     }
     // Handle transactions that were removed from the mempool because they
     // conflict with transactions in a newly connected block.
@@ -1489,6 +1686,9 @@ void CWallet::blockConnected(ChainstateRole role, const interfaces::BlockInfo& b
 
     m_last_block_processed_height = block.height;
     m_last_block_processed = block.hash;
+    // SYSCOIN coinbases mature with the tip
+    MarkSYSBalancesDirty();
+    m_ismine_memo.clear();
 
     // No need to scan block if it was created before the wallet birthday.
     // Uses chain max time and twice the grace period to adjust time for block time variability.
@@ -1512,6 +1712,9 @@ void CWallet::blockDisconnected(const interfaces::BlockInfo& block)
     // future with a stickier abandoned state or even removing abandontransaction call.
     m_last_block_processed_height = block.height - 1;
     m_last_block_processed = *Assert(block.prev_hash);
+    // SYSCOIN
+    MarkSYSBalancesDirty();
+    m_ismine_memo.clear();
 
     int disconnect_height = block.height;
 
@@ -1593,10 +1796,22 @@ isminetype CWallet::IsMine(const CTxDestination& dest) const
 isminetype CWallet::IsMine(const CScript& script) const
 {
     AssertLockHeld(cs_wallet);
+    // SYSCOIN
+    const auto it = m_ismine_memo.find(script);
+    if (it != m_ismine_memo.end()) {
+        return it->second;
+    }
     isminetype result = ISMINE_NO;
     for (const auto& spk_man_pair : m_spk_managers) {
         result = std::max(result, spk_man_pair.second->IsMine(script));
     }
+    // scripts that are not mine can become mine with the next top up, only the others are kept
+    if (result != ISMINE_NO && IsWalletFlagSet(WALLET_FLAG_DESCRIPTORS)) {
+        if (m_ismine_memo.size() >= MAX_ISMINE_MEMO) {
+            m_ismine_memo.clear();
+        }
+        m_ismine_memo.emplace(script, result);
+    }
     return result;
 }
 
@@ -1667,6 +1882,8 @@ void CWallet::SetWalletFlag(uint64_t flags)
 {
     LOCK(cs_wallet);
     m_wallet_flags |= flags;
+    // SYSCOIN avoid_reuse changes what the balances count
+    m_balance_cache.clear();
     if (!WalletBatch(GetDatabase()).WriteWalletFlags(m_wallet_flags))
         throw std::runtime_error(std::string(__func__) + ": writing wallet flags failed");
 }
@@ -1681,6 +1898,8 @@ void CWallet::UnsetWalletFlagWithDB(WalletBatch& batch, uint64_t flag)
 {
     LOCK(cs_wallet);
     m_wallet_flags &= ~flag;
+    // SYSCOIN
+    m_balance_cache.clear();
     if (!batch.WriteWalletFlags(m_wallet_flags))
         throw std::runtime_error(std::string(__func__) + ": writing wallet flags failed");
 }
@@ -1852,6 +2071,11 @@ CWallet::ScanResult CWallet::ScanForWalletTransactions(const uint256& start_bloc
 
     WalletLogPrintf("Rescan started from block %s... (%s)\n", start_block.ToString(),
                     fast_rescan_filter ? "fast variant using block filters" : "slow variant inspecting all blocks");
+    // SYSCOIN
+    std::optional<RescanBlockPrefetcher> prefetcher;
+    if (m_rescan_threads > 0) prefetcher.emplace(chain(), m_rescan_threads);
+    const size_t nPrefetchWindow = m_rescan_threads * RESCAN_BLOCKS_PER_THREAD;
+    int prefetch_height = start_height;
 
     fAbortRescan = false;
     ShowProgress(strprintf("%s " + _("Rescanning…").translated, GetDisplayName()), 0); // show rescan progress in GUI as dialog or on splashscreen, if rescan required on startup (e.g. due to corruption)
@@ -1878,6 +2102,20 @@ CWallet::ScanResult CWallet::ScanForWalletTransactions(const uint256& start_bloc
             WalletLogPrintf("Still rescanning. At block %d. Progress=%f\n", block_height, progress_current);
         }
 
+        // SYSCOIN request the blocks ahead, skipping those the filter rules out with what it knows now
+        if (prefetcher) {
+            if (prefetch_height < block_height) prefetch_height = block_height;
+            const int prefetch_end = max_height ? *max_height : std::numeric_limits<int>::max();
+            while (prefetch_height <= prefetch_end && prefetcher->Pending() < nPrefetchWindow) {
+                uint256 prefetch_hash;
+                if (!chain().findAncestorByHeight(tip_hash, prefetch_height, FoundBlock().hash(prefetch_hash))) break;
+                if (!fast_rescan_filter || fast_rescan_filter->MatchesBlock(prefetch_hash).value_or(true)) {
+                    prefetcher->Request(prefetch_height, prefetch_hash);
+                }
+                ++prefetch_height;
+            }
+        }
+
         bool fetch_block{true};
         if (fast_rescan_filter) {
             fast_rescan_filter->UpdateIfNeeded();
@@ -1905,7 +2143,10 @@ CWallet::ScanResult CWallet::ScanForWalletTransactions(const uint256& start_bloc
         if (fetch_block) {
             // Read block data
             CBlock block;
-            chain().findBlock(block_hash, FoundBlock().data(block));
+            // SYSCOIN
+            if (!prefetcher || !prefetcher->Take(block_height, block_hash, block)) {
+                chain().findBlock(block_hash, FoundBlock().data(block));
+            }
 
             if (!block.IsNull()) {
                 LOCK(cs_wallet);
@@ -2315,6 +2556,8 @@ void CWallet::CommitTransaction(CTransactionRef tx, mapValue_t mapValue, std::ve
     for (const CTxIn& txin : tx->vin) {
         CWalletTx &coin = mapWallet.at(txin.prevout.hash);
         coin.MarkDirty();
+        // SYSCOIN
+        MarkBalancesDirty(coin);
         NotifyTransactionChanged(coin.GetHash(), CT_UPDATED);
     }
 
@@ -2382,6 +2625,9 @@ DBErrors CWallet::ZapSelectTx(std::vector<uint256>& vHashIn, std::vector<uint256
         wtxOrdered.erase(it->second.m_it_wtxOrdered);
         for (const auto& txin : it->second.tx->vin)
             mapTxSpends.erase(txin.prevout);
+        // SYSCOIN
+        RemoveFromAssetTxs(it->second);
+        MarkBalancesDirty(it->second);
         mapWallet.erase(it);
         NotifyTransactionChanged(hash, CT_DELETED);
     }
@@ -2539,6 +2785,8 @@ std::optional<int64_t> CWallet::GetOldestKeyPoolTime() const
 }
 
 void CWallet::MarkDestinationsDirty(const std::set<CTxDestination>& destinations) {
+    // SYSCOIN used destinations change what the avoid_reuse balances count, of every asset
+    if (!destinations.empty()) m_balance_cache.clear();
     for (auto& entry : mapWallet) {
         CWalletTx& wtx = entry.second;
         if (wtx.m_is_cache_empty) continue;
@@ -2931,6 +3179,8 @@ std::shared_ptr<CWallet> CWallet::Create(WalletContext& context, const std::stri
     std::shared_ptr<CWallet> walletInstance(new CWallet(chain, name, std::move(database)), ReleaseWallet);
     walletInstance->m_keypool_size = std::max(args.GetIntArg("-keypool", DEFAULT_KEYPOOL_SIZE), int64_t{1});
     walletInstance->m_notify_tx_changed_script = args.GetArg("-walletnotify", "");
+    // SYSCOIN
+    walletInstance->m_rescan_threads = std::clamp<int>(args.GetIntArg("-rescanthreads", DEFAULT_RESCAN_THREADS), 0, MAX_RESCAN_THREADS);
 
     // Load wallet
     bool rescan_required = false;
@@ -3807,6 +4057,8 @@ ScriptPubKeyMan* CWallet::AddWalletDescriptor(WalletDescriptor& desc, const Flat
     if (spk_man) {
         WalletLogPrintf("Update existing descriptor: %s\n", desc.descriptor->ToString());
         spk_man->UpdateWalletDescriptor(desc);
+        // SYSCOIN the scripts of the old range may be gone
+        m_ismine_memo.clear();
     } else {
         auto new_spk_man = std::unique_ptr<DescriptorScriptPubKeyMan>(new DescriptorScriptPubKeyMan(*this, desc, m_keypool_size));
         spk_man = new_spk_man.get();
@@ -3975,6 +4227,8 @@ bool CWallet::ApplyMigrationData(MigrationData& data, bilingual_str& error)
 
     // Remove the LegacyScriptPubKeyMan from memory
     m_spk_managers.erase(legacy_spkm->GetID());
+    // SYSCOIN
+    m_ismine_memo.clear();
     m_external_spk_managers.clear();
     m_internal_spk_managers.clear();
 
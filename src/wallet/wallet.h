@@ -128,6 +128,12 @@ constexpr CAmount HIGH_APS_FEE{COIN / 10000};
 static const CAmount WALLET_INCREMENTAL_RELAY_FEE = 5000;
 //! Default for -spendzeroconfchange
 static const bool DEFAULT_SPEND_ZEROCONF_CHANGE = true;
+// SYSCOIN
+//! Default for -rescanthreads, 0 reads the blocks of a rescan on the scanning thread
+static constexpr int DEFAULT_RESCAN_THREADS{2};
+static constexpr int MAX_RESCAN_THREADS{16};
+//! Blocks read ahead of a rescan per read thread
+static constexpr int RESCAN_BLOCKS_PER_THREAD{4};
 //! Default for -walletrejectlongchains
 static const bool DEFAULT_WALLET_REJECT_LONG_CHAINS{true};
 //! -txconfirmtarget default
@@ -481,6 +487,25 @@ public:
     typedef std::multimap<int64_t, CWalletTx*> TxItems;
     TxItems wtxOrdered;
 
+    // SYSCOIN
+    /** Wallet transactions with outputs of each asset guid, so coins of an
+     * asset are found without walking all of mapWallet. */
+    std::unordered_map<uint64_t, std::set<uint256>> m_asset_txs GUARDED_BY(cs_wallet);
+    void AddToAssetTxs(const CWalletTx& wtx) EXCLUSIVE_LOCKS_REQUIRED(cs_wallet);
+    void RemoveFromAssetTxs(const CWalletTx& wtx) EXCLUSIVE_LOCKS_REQUIRED(cs_wallet);
+    /** Balances for min_depth 0 by asset guid, 0 for SYS, and avoid_reuse. An asset's
+     * entries are dropped when a wallet transaction with outputs of the asset changes. The
+     * SYS entries are dropped on any change and on every block as coinbases mature. */
+    mutable std::map<std::pair<uint64_t, bool>, Balance> m_balance_cache GUARDED_BY(cs_wallet);
+    /** Scripts of descriptor wallets found to be mine since the last block, so asset outputs
+     * repeating a script skip the ScriptPubKeyMan lookups. Descriptor scripts are only
+     * removed when a descriptor is replaced, which drops the memo as well. */
+    mutable std::unordered_map<CScript, isminetype, SaltedSipHasher> m_ismine_memo GUARDED_BY(cs_wallet);
+    static constexpr size_t MAX_ISMINE_MEMO{4096};
+    /** Drop the cached balances a change of wtx can affect */
+    void MarkBalancesDirty(const CWalletTx& wtx) EXCLUSIVE_LOCKS_REQUIRED(cs_wallet);
+    void MarkSYSBalancesDirty() EXCLUSIVE_LOCKS_REQUIRED(cs_wallet);
+
     int64_t nOrderPosNext GUARDED_BY(cs_wallet) = 0;
 
     std::map<CTxDestination, CAddressBookData> m_address_book GUARDED_BY(cs_wallet);
@@ -692,6 +717,8 @@ public:
     /** Allow Coin Selection to pick unconfirmed UTXOs that were sent from our own wallet if it
      * cannot fund the transaction otherwise. */
     bool m_spend_zero_conf_change{DEFAULT_SPEND_ZEROCONF_CHANGE};
+    // SYSCOIN threads reading blocks ahead of a rescan
+    int m_rescan_threads{DEFAULT_RESCAN_THREADS};
     bool m_signal_rbf{DEFAULT_WALLET_RBF};
     bool m_allow_fallback_fee{true}; //!< will be false if -fallbackfee=0
     CFeeRate m_min_fee{DEFAULT_TRANSACTION_MINFEE}; //!< Override with -mintxfee
@@ -24,9 +24,14 @@
 #endif
 #include <wallet/wallet.h>
 
+#include <algorithm>
 #include <atomic>
+#include <exception>
+#include <memory>
 #include <optional>
 #include <string>
+#include <thread>
+#include <vector>
 // SYSCOIN
 #include <governance/governancecommon.h>
 
@@ -1020,6 +1025,49 @@ static DBErrors LoadAddressBookRecords(CWallet* pwallet, DatabaseBatch& batch) E
     return result;
 }
 
+// SYSCOIN
+//! tx records read from the database before they are decoded together
+static constexpr size_t TX_RECORD_DECODE_BATCH{4096};
+//! batches smaller than this are decoded on the loading thread
+static constexpr size_t TX_RECORD_DECODE_MIN_PARALLEL{256};
+static constexpr unsigned int MAX_TX_RECORD_DECODE_THREADS{8};
+
+namespace {
+/** A tx record of the database, its CWalletTx decoded ahead of LoadToWallet */
+struct DecodedTxRecord {
+    uint256 hash;
+    CDataStream value;
+    std::unique_ptr<CWalletTx> wtx;
+    std::exception_ptr error;
+};
+
+/** Decode the CWalletTx of every record, large batches are split over several threads */
+void DecodeTxRecords(std::vector<DecodedTxRecord>& records)
+{
+    const auto decode = [&records](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            DecodedTxRecord& record = records[i];
+            try {
+                record.wtx = std::make_unique<CWalletTx>(nullptr, TxStateInactive{});
+                record.value >> *record.wtx;
+            } catch (...) {
+                record.error = std::current_exception();
+            }
+        }
+    };
+    const unsigned int nThreads{records.size() < TX_RECORD_DECODE_MIN_PARALLEL ? 1 : std::clamp(std::thread::hardware_concurrency(), 1U, MAX_TX_RECORD_DECODE_THREADS)};
+    const size_t nPerThread{(records.size() + nThreads - 1) / nThreads};
+    std::vector<std::thread> threads;
+    for (size_t begin = nPerThread; begin < records.size(); begin += nPerThread) {
+        threads.emplace_back(decode, begin, std::min(begin + nPerThread, records.size()));
+    }
+    decode(0, std::min(nPerThread, records.size()));
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+} // namespace
+
 static DBErrors LoadTxRecords(CWallet* pwallet, DatabaseBatch& batch, std::vector<uint256>& upgraded_txs, bool& any_unordered) EXCLUSIVE_LOCKS_REQUIRED(pwallet->cs_wallet)
 {
     AssertLockHeld(pwallet->cs_wallet);
@@ -1027,56 +1075,82 @@ static DBErrors LoadTxRecords(CWallet* pwallet, DatabaseBatch& batch, std::vecto
 
     // Load tx record
     any_unordered = false;
-    LoadResult tx_res = LoadRecords(pwallet, batch, DBKeys::TX,
-        [&any_unordered, &upgraded_txs] (CWallet* pwallet, DataStream& key, CDataStream& value, std::string& err) EXCLUSIVE_LOCKS_REQUIRED(pwallet->cs_wallet) {
-        DBErrors result = DBErrors::LOAD_OK;
-        uint256 hash;
-        key >> hash;
-        // LoadToWallet call below creates a new CWalletTx that fill_wtx
-        // callback fills with transaction metadata.
-        auto fill_wtx = [&](CWalletTx& wtx, bool new_tx) {
-            if(!new_tx) {
-                // There's some corruption here since the tx we just tried to load was already in the wallet.
-                err = "Error: Corrupt transaction found. This can be fixed by removing transactions from wallet and rescanning.";
-                result = DBErrors::CORRUPT;
-                return false;
-            }
-            value >> wtx;
-            if (wtx.GetHash() != hash)
-                return false;
-
-            // Undo serialize changes in 31600
-            if (31404 <= wtx.fTimeReceivedIsTxTime && wtx.fTimeReceivedIsTxTime <= 31703)
-            {
-                if (!value.empty())
-                {
-                    uint8_t fTmp;
-                    uint8_t fUnused;
-                    std::string unused_string;
-                    value >> fTmp >> fUnused >> unused_string;
-                    pwallet->WalletLogPrintf("LoadWallet() upgrading tx ver=%d %d %s\n",
-                                       wtx.fTimeReceivedIsTxTime, fTmp, hash.ToString());
-                    wtx.fTimeReceivedIsTxTime = fTmp;
+    // SYSCOIN records are decoded a batch at a time, on several threads when the batch is
+    // large, and handed to LoadToWallet in database order
+    std::vector<DecodedTxRecord> records;
+    DBErrors tx_result = DBErrors::LOAD_OK;
+    const auto load_records = [&]() EXCLUSIVE_LOCKS_REQUIRED(pwallet->cs_wallet) {
+        DecodeTxRecords(records);
+        for (DecodedTxRecord& record : records) {
+            DBErrors result = DBErrors::LOAD_OK;
+            std::string err;
+            const uint256& hash = record.hash;
+            CDataStream& value = record.value;
+            // LoadToWallet call below creates a new CWalletTx that fill_wtx
+            // callback fills with transaction metadata.
+            auto fill_wtx = [&](CWalletTx& wtx, bool new_tx) {
+                if(!new_tx) {
+                    // There's some corruption here since the tx we just tried to load was already in the wallet.
+                    err = "Error: Corrupt transaction found. This can be fixed by removing transactions from wallet and rescanning.";
+                    result = DBErrors::CORRUPT;
+                    return false;
+                }
+                if (record.error) {
+                    std::rethrow_exception(record.error);
                 }
-                else
+                wtx.CopyFrom(*record.wtx);
+                if (wtx.GetHash() != hash)
+                    return false;
+
+                // Undo serialize changes in 31600
+                if (31404 <= wtx.fTimeReceivedIsTxTime && wtx.fTimeReceivedIsTxTime <= 31703)
                 {
-                    pwallet->WalletLogPrintf("LoadWallet() repairing tx ver=%d %s\n", wtx.fTimeReceivedIsTxTime, hash.ToString());
-                    wtx.fTimeReceivedIsTxTime = 0;
+                    if (!value.empty())
+                    {
+                        uint8_t fTmp;
+                        uint8_t fUnused;
+                        std::string unused_string;
+                        value >> fTmp >> fUnused >> unused_string;
+                        pwallet->WalletLogPrintf("LoadWallet() upgrading tx ver=%d %d %s\n",
+                                           wtx.fTimeReceivedIsTxTime, fTmp, hash.ToString());
+                        wtx.fTimeReceivedIsTxTime = fTmp;
+                    }
+                    else
+                    {
+                        pwallet->WalletLogPrintf("LoadWallet() repairing tx ver=%d %s\n", wtx.fTimeReceivedIsTxTime, hash.ToString());
+                        wtx.fTimeReceivedIsTxTime = 0;
+                    }
+                    upgraded_txs.push_back(hash);
                 }
-                upgraded_txs.push_back(hash);
-            }
 
-            if (wtx.nOrderPos == -1)
-                any_unordered = true;
+                if (wtx.nOrderPos == -1)
+                    any_unordered = true;
 
-            return true;
-        };
-        if (!pwallet->LoadToWallet(hash, fill_wtx)) {
-            // Use std::max as fill_wtx may have already set result to CORRUPT
-            result = std::max(result, DBErrors::NEED_RESCAN);
+                return true;
+            };
+            if (!pwallet->LoadToWallet(hash, fill_wtx)) {
+                // Use std::max as fill_wtx may have already set result to CORRUPT
+                result = std::max(result, DBErrors::NEED_RESCAN);
+            }
+            if (result != DBErrors::LOAD_OK) {
+                pwallet->WalletLogPrintf("%s\n", err);
+            }
+            tx_result = std::max(tx_result, result);
         }
-        return result;
+        records.clear();
+    };
+    LoadResult tx_res = LoadRecords(pwallet, batch, DBKeys::TX,
+        [&records, &load_records] (CWallet* pwallet, DataStream& key, CDataStream& value, std::string& err) EXCLUSIVE_LOCKS_REQUIRED(pwallet->cs_wallet) {
+        uint256 hash;
+        key >> hash;
+        records.push_back({hash, value, nullptr, nullptr});
+        if (records.size() >= TX_RECORD_DECODE_BATCH) {
+            load_records();
+        }
+        return DBErrors::LOAD_OK;
     });
+    load_records();
+    result = std::max(result, tx_result);
     result = std::max(result, tx_res.m_result);
     // SYSCOIN Load gobject
     LoadResult gobject_res = LoadRecords(pwallet, batch, DBKeys::GOBJECT,
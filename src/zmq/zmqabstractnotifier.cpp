@@ -22,10 +22,34 @@ bool CZMQAbstractNotifier::NotifyGovernanceVote(const uint256& /*vote*/)
 {
     return true;
 }
+bool CZMQAbstractNotifier::NotifyZDAGStatus(const uint256& /*txid*/, int /*status*/)
+{
+    return true;
+}
+bool CZMQAbstractNotifier::NotifyChainLock(const CBlockIndex* /*pindex*/, const llmq::CChainLockSig& /*clsig*/)
+{
+    return true;
+}
+bool CZMQAbstractNotifier::NotifyMasternodeListDiff(bool /*undo*/, const CDeterministicMNList& /*oldMNList*/, const CDeterministicMNListDiff& /*diff*/)
+{
+    return true;
+}
+bool CZMQAbstractNotifier::NotifyNEVMBlob(const std::vector<uint8_t>& /*vchVersionHash*/, const uint256& /*txid*/, const std::vector<uint8_t>& /*vchNEVMData*/)
+{
+    return true;
+}
 bool CZMQAbstractNotifier::NotifyNEVMComms(const std::string& commMessage, bool &bResponse) 
 {
     return true;
 }
+bool CZMQAbstractNotifier::NotifyNEVMFlush(std::string &state, uint256 &nFailedBlockHash)
+{
+    return true;
+}
+bool CZMQAbstractNotifier::NotifyBatchFlush(bool /*fForce*/)
+{
+    return true;
+}
 bool CZMQAbstractNotifier::NotifyNEVMBlockConnect(const CNEVMHeader &evmBlock, const CBlock& block, std::string &state, const uint256& nBlockHash, NEVMDataVec &NEVMDataVecOut, const uint32_t& nHeight, bool bSkipValidation, const CDeterministicMNListNEVMAddressDiff &diff)
 {
     return true;
@@ -34,6 +58,10 @@ bool CZMQAbstractNotifier::NotifyNEVMBlockDisconnect(std::string &state, const u
 {
     return true;
 }
+bool CZMQAbstractNotifier::NotifyNEVMBlocksDisconnect(std::string &state, const NEVMDisconnectVec &vecBlocks)
+{
+    return true;
+}
 bool CZMQAbstractNotifier::NotifyGetNEVMBlockInfo(uint64_t &nHeight, std::string &state)
 {
     return true;
@@ -9,6 +9,7 @@
 #include <functional>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 class CBlockIndex;
 class CTransaction;
@@ -20,13 +21,34 @@ class CBlock;
 class uint256;
 class CNEVMData;
 class CDeterministicMNListNEVMAddressDiff;
+class CDeterministicMNList;
+class CDeterministicMNListDiff;
+namespace llmq {
+class CChainLockSig;
+} // namespace llmq
 typedef std::vector<std::vector<uint8_t> > NEVMDataVec;
+typedef std::vector<std::pair<uint256, CDeterministicMNListNEVMAddressDiff> > NEVMDisconnectVec;
 using CZMQNotifierFactory = std::function<std::unique_ptr<CZMQAbstractNotifier>()>;
 
 class CZMQAbstractNotifier
 {
 public:
     static const int DEFAULT_ZMQ_SNDHWM {1000};
+    // SYSCOIN number of NEVM block connect messages allowed in flight before waiting for an ack
+    static const int DEFAULT_NEVM_PIPELINE_WINDOW {1};
+    static const int MAX_NEVM_PIPELINE_WINDOW {1000};
+    // SYSCOIN number of assumed-valid block connects sent to Geth as one message
+    static const int DEFAULT_NEVM_BATCH_SIZE {1};
+    static const int MAX_NEVM_BATCH_SIZE {1000};
+    // a batch is sent early once its payload reaches this size
+    static const size_t MAX_NEVM_BATCH_BYTES {128 * 1024 * 1024};
+    // SYSCOIN send the block disconnects of a reorg to Geth as one rewind message
+    static const bool DEFAULT_NEVM_DISCONNECT_BATCH {false};
+    // SYSCOIN number of rawtx, rawmempooltx and sequence messages published as one batch, 1 disables batching
+    static const int DEFAULT_ZMQ_BATCH_SIZE {1};
+    static const int MAX_ZMQ_BATCH_SIZE {10000};
+    // longest time in milliseconds a message is held back for a batch
+    static const int DEFAULT_ZMQ_BATCH_INTERVAL {50};
 
     CZMQAbstractNotifier() : outbound_message_high_water_mark(DEFAULT_ZMQ_SNDHWM) {}
     virtual ~CZMQAbstractNotifier();
@@ -69,11 +91,20 @@ public:
     virtual bool NotifyTransactionMempool(const CTransaction &transaction);
     virtual bool NotifyGovernanceVote(const uint256& vote);
     virtual bool NotifyGovernanceObject(const uint256& object);
+    virtual bool NotifyZDAGStatus(const uint256& txid, int status);
+    virtual bool NotifyChainLock(const CBlockIndex *pindex, const llmq::CChainLockSig& clsig);
+    virtual bool NotifyMasternodeListDiff(bool undo, const CDeterministicMNList& oldMNList, const CDeterministicMNListDiff& diff);
+    virtual bool NotifyNEVMBlob(const std::vector<uint8_t>& vchVersionHash, const uint256& txid, const std::vector<uint8_t>& vchNEVMData);
     virtual bool NotifyNEVMBlockConnect(const CNEVMHeader &evmBlock, const CBlock& block, std::string &state, const uint256& nBlockHash, NEVMDataVec &NEVMDataVecOut, const uint32_t& nHeight, bool bSkipValidation, const CDeterministicMNListNEVMAddressDiff &diff);
     virtual bool NotifyNEVMBlockDisconnect(std::string &state, const uint256& nBlockHash, const CDeterministicMNListNEVMAddressDiff &diff);
+    virtual bool NotifyNEVMBlocksDisconnect(std::string &state, const NEVMDisconnectVec &vecBlocks);
     virtual bool NotifyGetNEVMBlockInfo(uint64_t &nHeight, std::string &state);
     virtual bool NotifyGetNEVMBlock(CNEVMBlock &evmBlock, std::string &state);
     virtual bool NotifyNEVMComms(const std::string& commMessage, bool &bResponse);
+    // Sends any block connects still queued for a batch, then waits for all pipelined acks and hands out the block Geth failed to connect, if any
+    virtual bool NotifyNEVMFlush(std::string &state, uint256 &nFailedBlockHash);
+    // Publishes any messages still queued for a batch
+    virtual bool NotifyBatchFlush(bool fForce);
 
 protected:
     void* psocket{nullptr};
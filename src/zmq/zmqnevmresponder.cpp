@@ -0,0 +1,278 @@
+// Copyright (c) 2024 The Syscoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <zmq/zmqnevmresponder.h>
+
+#include <crypto/common.h>
+#include <hash.h>
+#include <logging.h>
+#include <primitives/transaction.h>
+#include <random.h>
+#include <streams.h>
+#include <uint256.h>
+#include <util/thread.h>
+#include <util/time.h>
+#include <version.h>
+#include <zmq/zmqutil.h>
+
+#include <zmq.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cerrno>
+#include <deque>
+#include <utility>
+
+namespace {
+// the NEVM commands of zmqpublishnotifier.cpp
+const std::string MSG_NEVMBLOCKCONNECT{"nevmconnect"};
+const std::string MSG_NEVMBLOCKCONNECTBATCH{"nevmconnectbatch"};
+const std::string MSG_NEVMBLOCKCONNECTSHM{"nevmconnectshm"};
+const std::string MSG_NEVMBLOCKCONNECTBATCHSHM{"nevmconnectbatchshm"};
+const std::string MSG_NEVMCOMMS{"nevmcomms"};
+const std::string MSG_NEVMBLOCKDISCONNECT{"nevmdisconnect"};
+const std::string MSG_NEVMBLOCKDISCONNECTBATCH{"nevmdisconnectbatch"};
+const std::string MSG_NEVMBLOCK{"nevmblock"};
+const std::string MSG_NEVMBLOCKINFO{"nevmblockinfo"};
+
+bool ReceiveFrames(void* socket, std::vector<std::string>& frames)
+{
+    int64_t more{0};
+    size_t more_size = sizeof(more);
+    do {
+        zmq_msg_t part;
+        zmq_msg_init(&part);
+        if (zmq_msg_recv(&part, socket, 0) == -1) {
+            zmq_msg_close(&part);
+            return false;
+        }
+        frames.emplace_back(static_cast<const char*>(zmq_msg_data(&part)), zmq_msg_size(&part));
+        zmq_msg_close(&part);
+        if (zmq_getsockopt(socket, ZMQ_RCVMORE, &more, &more_size) != 0) {
+            return false;
+        }
+    } while (more);
+    return true;
+}
+
+bool SendFrames(void* socket, const std::vector<std::string>& frames)
+{
+    for (size_t i = 0; i < frames.size(); ++i) {
+        if (zmq_send(socket, frames[i].data(), frames[i].size(), i + 1 < frames.size() ? ZMQ_SNDMORE : 0) == -1) {
+            return false;
+        }
+    }
+    return true;
+}
+} // namespace
+
+CZMQNEVMResponder::~CZMQNEVMResponder()
+{
+    Stop();
+}
+
+bool CZMQNEVMResponder::Start(const std::string& address)
+{
+    assert(!m_context);
+    m_context = zmq_ctx_new();
+    if (!m_context) {
+        zmqError("Unable to initialize mock NEVM context");
+        return false;
+    }
+    m_socket = zmq_socket(m_context, ZMQ_ROUTER);
+    if (!m_socket) {
+        zmqError("Failed to create mock NEVM socket");
+        Stop();
+        return false;
+    }
+    const int linger{0};
+    zmq_setsockopt(m_socket, ZMQ_LINGER, &linger, sizeof(linger));
+    if (zmq_bind(m_socket, address.c_str()) != 0) {
+        zmqError("Failed to bind mock NEVM address");
+        Stop();
+        return false;
+    }
+    char endpoint[256];
+    size_t endpoint_size{sizeof(endpoint)};
+    if (zmq_getsockopt(m_socket, ZMQ_LAST_ENDPOINT, endpoint, &endpoint_size) == 0) {
+        m_endpoint = endpoint;
+    } else {
+        m_endpoint = address;
+    }
+    LogPrint(BCLog::ZMQ, "Mock NEVM responder bound on address %s (latency %dus, jitter %dus, block time %dus, reject %d/1000, reject request %d, drop %d/1000)\n",
+        m_endpoint, count_microseconds(m_options.latency), count_microseconds(m_options.jitter), count_microseconds(m_options.block_time), m_options.reject_permille, m_options.reject_request, m_options.drop_permille);
+    m_stop = false;
+    m_thread = std::thread(&util::TraceThread, "nevmmock", [this] { ThreadServe(); });
+    return true;
+}
+
+void CZMQNEVMResponder::Stop()
+{
+    m_stop = true;
+    if (m_thread.joinable()) m_thread.join();
+    if (m_socket) {
+        zmq_close(m_socket);
+        m_socket = nullptr;
+    }
+    if (m_context) {
+        zmq_ctx_term(m_context);
+        m_context = nullptr;
+    }
+}
+
+CZMQNEVMResponder::Stats CZMQNEVMResponder::GetStats() const
+{
+    return WITH_LOCK(m_mutex, return m_stats);
+}
+
+void CZMQNEVMResponder::ThreadServe()
+{
+    FastRandomContext rng;
+    zmq_pollitem_t item{m_socket, 0, ZMQ_POLLIN, 0};
+    // answers waiting for their time, in request order
+    std::deque<std::pair<SteadyClock::time_point, std::vector<std::string>>> pending;
+    SteadyClock::time_point busy_until, last_due;
+    while (!m_stop) {
+        auto now{SteadyClock::now()};
+        while (!pending.empty() && pending.front().first <= now) {
+            if (!SendFrames(m_socket, pending.front().second)) {
+                zmqError("Mock NEVM responder failed to reply");
+            }
+            pending.pop_front();
+        }
+        // wake up now and then to see if we are stopped
+        int timeout_ms{100};
+        if (!pending.empty()) {
+            const auto wait{pending.front().first - now};
+            // zmq_poll only waits whole milliseconds
+            if (wait < 1ms) {
+                UninterruptibleSleep(std::chrono::duration_cast<std::chrono::microseconds>(wait));
+                continue;
+            }
+            timeout_ms = std::min<int64_t>(Ticks<std::chrono::milliseconds>(wait), timeout_ms);
+        }
+        const int rc = zmq_poll(&item, 1, timeout_ms);
+        if (rc == -1 && zmq_errno() != EINTR) {
+            zmqError("Mock NEVM responder failed to poll");
+            return;
+        }
+        if (rc <= 0) continue;
+        std::vector<std::string> frames;
+        if (!ReceiveFrames(m_socket, frames)) continue;
+        // the routing identity and the empty delimiter come first, REQ adds it and DEALER sends it explicitly
+        if (frames.size() < 3 || !frames[1].empty()) continue;
+        std::vector<std::string> reply;
+        const uint32_t blocks{Serve({frames.begin() + 2, frames.end()}, reply, rng)};
+        if (reply.empty()) continue;
+        now = SteadyClock::now();
+        busy_until = std::max(busy_until, now) + m_options.block_time * blocks;
+        auto due{busy_until + m_options.latency};
+        if (m_options.jitter.count() > 0) {
+            due += std::chrono::microseconds{rng.randrange(m_options.jitter.count() + 1)};
+        }
+        // jitter must not reorder the answers, the notifiers rely on them coming in request order
+        last_due = std::max(last_due, due);
+        reply.insert(reply.begin(), {frames[0], ""});
+        pending.emplace_back(last_due, std::move(reply));
+    }
+}
+
+uint32_t CZMQNEVMResponder::Serve(const std::vector<std::string>& parts, std::vector<std::string>& reply, FastRandomContext& rng)
+{
+    LOCK(m_mutex);
+    ++m_stats.requests;
+    for (const std::string& part : parts) {
+        m_stats.bytes_received += part.size();
+    }
+    const std::string& command = parts[0];
+    if (command == MSG_NEVMCOMMS) {
+        std::string message;
+        if (parts.size() == 2) {
+            try {
+                SpanReader{SER_NETWORK, PROTOCOL_VERSION, MakeUCharSpan(parts[1])} >> message;
+            } catch (const std::ios_base::failure&) {
+            }
+        }
+        // the notifier does not wait for an answer to a disconnect
+        if (message != "disconnect") {
+            reply = {command, "ack"};
+        }
+        return 0;
+    }
+    if (m_options.drop_permille > 0 && rng.randrange(1000) < (uint64_t)m_options.drop_permille) {
+        ++m_stats.dropped;
+        return 0;
+    }
+    if (command == MSG_NEVMBLOCKCONNECT || command == MSG_NEVMBLOCKCONNECTSHM ||
+        command == MSG_NEVMBLOCKCONNECTBATCH || command == MSG_NEVMBLOCKCONNECTBATCHSHM) {
+        // parts: command, [LE 4 byte block count], data, [LE 4 byte sequence number]
+        const bool batch{command == MSG_NEVMBLOCKCONNECTBATCH || command == MSG_NEVMBLOCKCONNECTBATCHSHM};
+        const size_t base_parts{batch ? 3U : 2U};
+        if (parts.size() != base_parts && parts.size() != base_parts + 1) {
+            reply = {command, "mock-invalid-parts"};
+            return 0;
+        }
+        uint32_t count{1};
+        if (batch) {
+            if (parts[1].size() != sizeof(uint32_t)) {
+                reply = {command, "mock-invalid-count"};
+                return 0;
+            }
+            count = ReadLE32(reinterpret_cast<const unsigned char*>(parts[1].data()));
+        }
+        // only pipelined connects carry a sequence number, a lock-step connect is sent after syscoind caught the rejection
+        const bool pipelined{parts.size() == base_parts + 1};
+        if (!pipelined) m_rejected_tip = false;
+        ++m_connect_requests;
+        const bool rejected{m_rejected_tip || m_connect_requests == m_options.reject_request ||
+            (m_options.reject_permille > 0 && rng.randrange(1000) < (uint64_t)m_options.reject_permille)};
+        m_rejected_tip = rejected && pipelined;
+        if (rejected) {
+            ++m_stats.rejected;
+            reply = {command, "mock-rejected"};
+        } else {
+            m_stats.blocks_connected += count;
+            reply = {command, "connected"};
+        }
+        // pipelined connects are matched against the sequence number they were sent with
+        if (pipelined) {
+            reply.push_back(parts.back());
+        }
+        return rejected ? 0 : count;
+    } else if (command == MSG_NEVMBLOCKDISCONNECT) {
+        ++m_stats.blocks_disconnected;
+        reply = {command, "disconnected"};
+    } else if (command == MSG_NEVMBLOCKDISCONNECTBATCH) {
+        // parts: command, data starting with the compact size block count
+        uint64_t count{0};
+        if (parts.size() == 2) {
+            try {
+                SpanReader reader{SER_NETWORK, PROTOCOL_VERSION, MakeUCharSpan(parts[1])};
+                count = ReadCompactSize(reader);
+            } catch (const std::ios_base::failure&) {
+            }
+        }
+        if (count == 0) {
+            reply = {command, "mock-invalid-count"};
+        } else {
+            m_stats.blocks_disconnected += count;
+            reply = {command, "disconnected"};
+        }
+    } else if (command == MSG_NEVMBLOCKINFO) {
+        reply = {command, std::to_string(m_stats.blocks_connected - std::min(m_stats.blocks_connected, m_stats.blocks_disconnected))};
+    } else if (command == MSG_NEVMBLOCK) {
+        // any block passes the checks of the notifier as long as none of its fields is empty
+        CNEVMBlock evmBlock;
+        evmBlock.nBlockHash = (HashWriter{} << m_stats.requests).GetHash();
+        evmBlock.nTxRoot = (HashWriter{} << evmBlock.nBlockHash).GetHash();
+        evmBlock.nReceiptRoot = (HashWriter{} << evmBlock.nTxRoot).GetHash();
+        evmBlock.vchNEVMBlockData.assign(evmBlock.nBlockHash.begin(), evmBlock.nBlockHash.end());
+        CDataStream ss(SER_NETWORK, PROTOCOL_VERSION);
+        ss << evmBlock;
+        reply = {command, ss.str()};
+    } else {
+        reply = {command, "mock-unknown-command"};
+    }
+    return 0;
+}
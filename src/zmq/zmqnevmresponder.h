@@ -0,0 +1,98 @@
+// Copyright (c) 2024 The Syscoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef SYSCOIN_ZMQ_ZMQNEVMRESPONDER_H
+#define SYSCOIN_ZMQ_ZMQNEVMRESPONDER_H
+
+#include <sync.h>
+#include <threadsafety.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+class FastRandomContext;
+
+/**
+ * In-process stand-in for the Geth side of -zmqpubnevm, so benchmarks and
+ * tests can measure what syscoind spends on a block without a sentry node.
+ *
+ * It binds a ROUTER socket that answers the REQ and DEALER sockets of the NEVM
+ * notifiers like Geth would: every block connect is acked in request order,
+ * echoing the sequence number of pipelined connects, block info reports the
+ * number of blocks connected so far and block requests get a made up NEVM
+ * block. Requests are served one at a time after the configured latency, so
+ * a pipelined notifier can overlap its own work with the wait. Like Geth it
+ * does not build on a rejected block: the pipelined connects that were
+ * already in flight behind it are rejected too, until syscoind falls back to
+ * a lock-step connect.
+ */
+class CZMQNEVMResponder
+{
+public:
+    struct Options {
+        //! round trip time added to every answer
+        std::chrono::microseconds latency{0};
+        //! up to this much is added to the latency of each request at random
+        std::chrono::microseconds jitter{0};
+        //! per mille of block connects answered with an error instead of "connected"
+        int reject_permille{0};
+        //! the block connect request with this number, counting from 1, is answered with an error (0 for none)
+        uint64_t reject_request{0};
+        //! per mille of requests left unanswered, the notifier runs into its receive timeout
+        int drop_permille{0};
+        //! time spent connecting each block, blocks are connected one after another
+        std::chrono::microseconds block_time{0};
+    };
+
+    struct Stats {
+        uint64_t requests{0};
+        //! blocks covered by the block connects, a batch counts all of its blocks
+        uint64_t blocks_connected{0};
+        uint64_t blocks_disconnected{0};
+        uint64_t rejected{0};
+        uint64_t dropped{0};
+        uint64_t bytes_received{0};
+    };
+
+    explicit CZMQNEVMResponder(const Options& options) : m_options(options) {}
+    ~CZMQNEVMResponder();
+
+    CZMQNEVMResponder(const CZMQNEVMResponder&) = delete;
+    CZMQNEVMResponder& operator=(const CZMQNEVMResponder&) = delete;
+
+    /** Bind address (the -zmqpubnevm address of the notifiers) and start answering */
+    bool Start(const std::string& address);
+    void Stop();
+    /** The bound endpoint, with the port picked for a tcp://host:* address */
+    const std::string& Endpoint() const { return m_endpoint; }
+
+    Stats GetStats() const;
+
+private:
+    const Options m_options;
+    void* m_context{nullptr};
+    void* m_socket{nullptr};
+    std::string m_endpoint;
+    std::thread m_thread;
+    std::atomic<bool> m_stop{false};
+
+    mutable Mutex m_mutex;
+    Stats m_stats GUARDED_BY(m_mutex);
+    uint64_t m_connect_requests GUARDED_BY(m_mutex){0};
+    //! a block connect was rejected and no lock-step connect came in since
+    bool m_rejected_tip GUARDED_BY(m_mutex){false};
+
+    void ThreadServe();
+    /**
+     * Answer one request, parts start with the command after the routing frames.
+     * Returns the number of blocks connected, an empty reply drops the request.
+     */
+    uint32_t Serve(const std::vector<std::string>& parts, std::vector<std::string>& reply, FastRandomContext& rng);
+};
+
+#endif // SYSCOIN_ZMQ_ZMQNEVMRESPONDER_H
@@ -23,6 +23,11 @@
 #include <vector>
 // SYSCOIN
 std::string fNEVMSub;
+int nNEVMPipelineWindow{CZMQAbstractNotifier::DEFAULT_NEVM_PIPELINE_WINDOW};
+int nNEVMBatchSize{CZMQAbstractNotifier::DEFAULT_NEVM_BATCH_SIZE};
+bool fNEVMDisconnectBatch{CZMQAbstractNotifier::DEFAULT_NEVM_DISCONNECT_BATCH};
+int nZMQBatchSize{CZMQAbstractNotifier::DEFAULT_ZMQ_BATCH_SIZE};
+int nZMQBatchInterval{CZMQAbstractNotifier::DEFAULT_ZMQ_BATCH_INTERVAL};
 CZMQNotificationInterface::CZMQNotificationInterface()
 {
 }
@@ -54,7 +59,11 @@ std::unique_ptr<CZMQNotificationInterface> CZMQNotificationInterface::Create(std
     factories["pubrawmempooltx"] = CZMQAbstractNotifier::Create<CZMQPublishRawMempoolTransactionNotifier>;
     factories["pubhashgovernancevote"] = CZMQAbstractNotifier::Create<CZMQPublishHashGovernanceVoteNotifier>;
     factories["pubhashgovernanceobject"] = CZMQAbstractNotifier::Create<CZMQPublishHashGovernanceObjectNotifier>;
+    factories["pubzdagstatus"] = CZMQAbstractNotifier::Create<CZMQPublishZDAGStatusNotifier>;
     factories["pubsequence"] = CZMQAbstractNotifier::Create<CZMQPublishSequenceNotifier>;
+    factories["pubrawchainlocksig"] = CZMQAbstractNotifier::Create<CZMQPublishRawChainLockSigNotifier>;
+    factories["pubrawmnlistdiff"] = CZMQAbstractNotifier::Create<CZMQPublishRawMNListDiffNotifier>;
+    factories["pubrawnevmblob"] = CZMQAbstractNotifier::Create<CZMQPublishRawNEVMBlobNotifier>;
     std::list<std::unique_ptr<CZMQAbstractNotifier>> notifiers;
     if(!fNEVMSub.empty()) {
         std::string pubCmd = "pubnevmblockinfo";
@@ -174,6 +183,8 @@ void CZMQNotificationInterface::Shutdown()
     LogPrint(BCLog::ZMQ, "Shutdown notification interface\n");
     if (pcontext)
     {
+        // SYSCOIN batched messages are published before the sockets close
+        FlushBatches(/*fForce=*/true);
         for (auto& notifier : notifiers) {
             LogPrint(BCLog::ZMQ, "Shutdown notifier %s at %s, subscriber: %s\n", notifier->GetType(), notifier->GetAddress(), notifier->GetAddressSub());
             notifier->Shutdown();
@@ -221,6 +232,12 @@ void TryForEach(std::list<std::unique_ptr<CZMQAbstractNotifier>>& notifiers, con
 }
 } // anonymous namespace
 // SYSCOIN
+void CZMQNotificationInterface::FlushBatches(bool fForce)
+{
+    TryForEachAndRemoveFailed(notifiers, [fForce](CZMQAbstractNotifier* notifier) {
+        return notifier->NotifyBatchFlush(fForce);
+    });
+}
 void CZMQNotificationInterface::NotifyNEVMComms(const std::string& commMessage, bool &bResponse)
 {
     TryForEach(notifiers, [&commMessage, &bResponse](CZMQAbstractNotifier* notifier) {
@@ -233,12 +250,24 @@ void CZMQNotificationInterface::NotifyNEVMBlockConnect(const CNEVMHeader &evmBlo
         return notifier->NotifyNEVMBlockConnect(evmBlock, block, state, nBlockHash, NEVMDataVecOut, nHeight, bSkipValidation, diff);
     });
 }
+void CZMQNotificationInterface::NotifyNEVMFlush(std::string &state, uint256 &nFailedBlockHash)
+{
+    TryForEach(notifiers, [&state, &nFailedBlockHash](CZMQAbstractNotifier* notifier) {
+        return notifier->NotifyNEVMFlush(state, nFailedBlockHash);
+    });
+}
 void CZMQNotificationInterface::NotifyNEVMBlockDisconnect(std::string &state, const uint256& nBlockHash, const CDeterministicMNListNEVMAddressDiff &diff)
 {
     TryForEach(notifiers, [&nBlockHash, &state, &diff](CZMQAbstractNotifier* notifier) {
         return notifier->NotifyNEVMBlockDisconnect(state, nBlockHash, diff);
     });
 }
+void CZMQNotificationInterface::NotifyNEVMBlocksDisconnect(std::string &state, const NEVMDisconnectVec &vecBlocks)
+{
+    TryForEach(notifiers, [&vecBlocks, &state](CZMQAbstractNotifier* notifier) {
+        return notifier->NotifyNEVMBlocksDisconnect(state, vecBlocks);
+    });
+}
 void CZMQNotificationInterface::NotifyGetNEVMBlockInfo(uint64_t &nHeight, std::string &state)
 {
     TryForEach(notifiers, [&nHeight, &state](CZMQAbstractNotifier* notifier) {
@@ -327,4 +356,32 @@ void CZMQNotificationInterface::NotifyGovernanceObject(const uint256 &object)
         return notifier->NotifyGovernanceObject(object);
     });
 }
+
+void CZMQNotificationInterface::NotifyZDAGStatus(const uint256 &txid, int status)
+{
+    TryForEachAndRemoveFailed(notifiers, [&txid, status](CZMQAbstractNotifier* notifier) {
+        return notifier->NotifyZDAGStatus(txid, status);
+    });
+}
+void CZMQNotificationInterface::NotifyChainLock(const CBlockIndex* pindex, const std::shared_ptr<const llmq::CChainLockSig>& clsig)
+{
+    TryForEachAndRemoveFailed(notifiers, [pindex, &clsig](CZMQAbstractNotifier* notifier) {
+        return notifier->NotifyChainLock(pindex, *clsig);
+    });
+}
+
+void CZMQNotificationInterface::NotifyMasternodeListChanged(bool undo, const CDeterministicMNList& oldMNList, const CDeterministicMNListDiff& diff)
+{
+    TryForEachAndRemoveFailed(notifiers, [undo, &oldMNList, &diff](CZMQAbstractNotifier* notifier) {
+        return notifier->NotifyMasternodeListDiff(undo, oldMNList, diff);
+    });
+}
+
+void CZMQNotificationInterface::NotifyNEVMBlobAdded(const std::vector<uint8_t>& vchVersionHash, const uint256& txid, const std::shared_ptr<const std::vector<uint8_t>>& vchNEVMData)
+{
+    if (!vchNEVMData) return;
+    TryForEachAndRemoveFailed(notifiers, [&vchVersionHash, &txid, &vchNEVMData](CZMQAbstractNotifier* notifier) {
+        return notifier->NotifyNEVMBlob(vchVersionHash, txid, *vchNEVMData);
+    });
+}
 std::unique_ptr<CZMQNotificationInterface> g_zmq_notification_interface;
@@ -29,6 +29,8 @@ public:
     virtual ~CZMQNotificationInterface();
 
     std::list<const CZMQAbstractNotifier*> GetActiveNotifiers() const;
+    // SYSCOIN publish batches held back longer than -zmqpubbatchinterval, or all of them if fForce
+    void FlushBatches(bool fForce = false);
 
     static std::unique_ptr<CZMQNotificationInterface> Create(std::function<bool(CBlock&, const CBlockIndex&)> get_block_by_index);
 
@@ -45,8 +47,14 @@ protected:
     // SYSCOIN
     void NotifyGovernanceVote(const uint256& vote) override;
     void NotifyGovernanceObject(const uint256& object) override;
+    void NotifyZDAGStatus(const uint256& txid, int status) override;
+    void NotifyChainLock(const CBlockIndex* pindex, const std::shared_ptr<const llmq::CChainLockSig>& clsig) override;
+    void NotifyMasternodeListChanged(bool undo, const CDeterministicMNList& oldMNList, const CDeterministicMNListDiff& diff) override;
+    void NotifyNEVMBlobAdded(const std::vector<uint8_t>& vchVersionHash, const uint256& txid, const std::shared_ptr<const std::vector<uint8_t>>& vchNEVMData) override;
     void NotifyNEVMBlockConnect(const CNEVMHeader &evmBlock, const CBlock& block, std::string &state, const uint256& nBlockHash, NEVMDataVec &NEVMDataVecOut, const uint32_t& nHeight, bool bSkipValidation, const CDeterministicMNListNEVMAddressDiff &diff) override;
+    void NotifyNEVMFlush(std::string &state, uint256 &nFailedBlockHash) override;
     void NotifyNEVMBlockDisconnect(std::string &state, const uint256& nBlockHash, const CDeterministicMNListNEVMAddressDiff &diff) override;
+    void NotifyNEVMBlocksDisconnect(std::string &state, const NEVMDisconnectVec &vecBlocks) override;
     void NotifyGetNEVMBlockInfo(uint64_t &nHeight, std::string& state) override;
     void NotifyGetNEVMBlock(CNEVMBlock &evmBlock, std::string& state) override;
     void NotifyNEVMComms(const std::string& commMessage, bool &bResponse) override;
@@ -60,6 +68,11 @@ private:
 };
 // SYSCOIN
 extern std::string fNEVMSub;
+extern int nNEVMPipelineWindow;
+extern int nNEVMBatchSize;
+extern bool fNEVMDisconnectBatch;
+extern int nZMQBatchSize;
+extern int nZMQBatchInterval;
 extern std::unique_ptr<CZMQNotificationInterface> g_zmq_notification_interface;
 
 #endif // SYSCOIN_ZMQ_ZMQNOTIFICATIONINTERFACE_H
@@ -20,6 +20,8 @@
 #include <sync.h>
 #include <uint256.h>
 #include <version.h>
+#include <zmq/zmqnotificationinterface.h>
+#include <zmq/zmqsharedmemory.h>
 #include <zmq/zmqutil.h>
 
 #include <zmq.h>
@@ -29,12 +31,17 @@
 #include <cstddef>
 #include <cstdint>
 #include <cstring>
+#include <deque>
 #include <map>
 #include <optional>
+#include <set>
 #include <string>
+#include <string_view>
 #include <utility>
 #include <vector>
 #include <evo/deterministicmns.h>
+#include <llmq/quorums_chainlocks.h>
+#include <util/strencodings.h>
 namespace Consensus {
 struct Params;
 }
@@ -48,15 +55,65 @@ static const char *MSG_RAWBLOCK  = "rawblock";
 static const char *MSG_RAWTX     = "rawtx";
 // SYSCOIN
 static const char *MSG_NEVMBLOCKCONNECT  = "nevmconnect";
+static const char *MSG_NEVMBLOCKCONNECTBATCH  = "nevmconnectbatch";
+// same as above but the NEVM block data is replaced by its offset and length in the shared memory ring
+static const char *MSG_NEVMBLOCKCONNECTSHM  = "nevmconnectshm";
+static const char *MSG_NEVMBLOCKCONNECTBATCHSHM  = "nevmconnectbatchshm";
 static const char *MSG_NEVMCOMMS  = "nevmcomms";
 static const char *MSG_NEVMBLOCKDISCONNECT  = "nevmdisconnect";
+static const char *MSG_NEVMBLOCKDISCONNECTBATCH  = "nevmdisconnectbatch";
 static const char *MSG_NEVMBLOCK  = "nevmblock";
 static const char *MSG_NEVMBLOCKINFO  = "nevmblockinfo";
 static const char *MSG_RAWMEMPOOLTX  = "rawmempooltx";
 static const char *MSG_HASHGVOTE     = "hashgovernancevote";
 static const char *MSG_HASHGOBJ      = "hashgovernanceobject";
+static const char *MSG_ZDAGSTATUS    = "zdagstatus";
 static const char *MSG_SEQUENCE  = "sequence";
+static const char *MSG_RAWCHAINLOCKSIG = "rawchainlocksig";
+static const char *MSG_RAWMNLISTDIFF = "rawmnlistdiff";
+static const char *MSG_RAWNEVMBLOB = "rawnevmblob";
+// prefix of the topics batched messages are published under
+static const char *MSG_BATCH_PREFIX  = "batch";
+// SYSCOIN with batching the publish sockets are XPUB sockets, so the subscriptions
+// they pass up tell which topics have subscribers
+static Mutex cs_zmq_batch;
+static std::map<void*, std::set<std::string>> mapZMQSubscriptions GUARDED_BY(cs_zmq_batch);
 RecursiveMutex cs_nevm;
+// SYSCOIN block connect messages sent to Geth whose acknowledgement has not been read yet,
+// in send order. Geth answers strictly in request order so acks are matched against the front.
+struct NEVMInFlightConnect {
+    uint32_t nSeq;
+    uint32_t nHeight;
+    uint256 nBlockHash;
+    // number of blocks covered by this ack, more than one for batches
+    uint32_t nCount;
+    const char *command;
+    // shared memory ring position that may be reused once this is acked
+    uint64_t nShmEnd;
+};
+static std::deque<NEVMInFlightConnect> dequeNEVMInFlight GUARDED_BY(cs_nevm);
+static uint32_t nNEVMConnectSeq GUARDED_BY(cs_nevm) {0};
+// lowest block Geth failed to connect while its ack was still in flight. Geth does not build on it, so it and
+// everything sent after it is missing on the Geth side until validation rolls back to it through NotifyNEVMFlush.
+static std::optional<NEVMInFlightConnect> optNEVMFirstFailed GUARDED_BY(cs_nevm);
+// what Geth answered for it, or why there was no answer
+static std::string strNEVMFirstFailedReason GUARDED_BY(cs_nevm);
+// consecutive block connect payloads not yet sent, concatenated in height order
+static CDataStream ssNEVMBatch GUARDED_BY(cs_nevm) {SER_NETWORK, PROTOCOL_VERSION};
+static uint32_t nNEVMBatchCount GUARDED_BY(cs_nevm) {0};
+static uint32_t nNEVMBatchFirstHeight GUARDED_BY(cs_nevm) {0};
+static uint256 nNEVMBatchFirstBlockHash GUARDED_BY(cs_nevm);
+static bool IsNEVMPipelined()
+{
+    return nNEVMPipelineWindow > 1;
+}
+static void SetNEVMFirstFailed(const NEVMInFlightConnect& inflight, const std::string& reason) EXCLUSIVE_LOCKS_REQUIRED(cs_nevm)
+{
+    if(!optNEVMFirstFailed || inflight.nHeight < optNEVMFirstFailed->nHeight) {
+        optNEVMFirstFailed = inflight;
+        strNEVMFirstFailedReason = reason;
+    }
+}
 // Internal function to send multipart message
 static int zmq_send_multipart(void *sock, const void* data, size_t size, ...)
 {
@@ -99,6 +156,50 @@ static int zmq_send_multipart(void *sock, const void* data, size_t size, ...)
     va_end(args);
     return 0;
 }
+// Internal function to send a multipart message with any number of parts
+static int zmq_send_parts(void *sock, const std::vector<Span<const unsigned char>>& parts)
+{
+    for (size_t i = 0; i < parts.size(); ++i) {
+        zmq_msg_t msg;
+        if (zmq_msg_init_size(&msg, parts[i].size()) != 0) {
+            zmqError("Unable to initialize ZMQ msg");
+            return -1;
+        }
+        if (!parts[i].empty()) memcpy(zmq_msg_data(&msg), parts[i].data(), parts[i].size());
+        if (zmq_msg_send(&msg, sock, i + 1 < parts.size() ? ZMQ_SNDMORE : 0) == -1) {
+            zmqError("Unable to send ZMQ msg");
+            zmq_msg_close(&msg);
+            return -1;
+        }
+        zmq_msg_close(&msg);
+    }
+    return 0;
+}
+// Internal function to read the subscriptions an XPUB socket received so far
+static void PollZMQSubscriptions(void *sock) EXCLUSIVE_LOCKS_REQUIRED(cs_zmq_batch)
+{
+    std::set<std::string>& subscriptions = mapZMQSubscriptions[sock];
+    while (true) {
+        zmq_msg_t msg;
+        zmq_msg_init(&msg);
+        if (zmq_msg_recv(&msg, sock, ZMQ_DONTWAIT) == -1) {
+            zmq_msg_close(&msg);
+            break;
+        }
+        const unsigned char* data = static_cast<const unsigned char*>(zmq_msg_data(&msg));
+        const size_t size = zmq_msg_size(&msg);
+        // a subscribe (1) or unsubscribe (0) byte followed by the topic prefix
+        if (size >= 1) {
+            std::string topic(reinterpret_cast<const char*>(data + 1), size - 1);
+            if (data[0] == 1) {
+                subscriptions.insert(std::move(topic));
+            } else if (data[0] == 0) {
+                subscriptions.erase(topic);
+            }
+        }
+        zmq_msg_close(&msg);
+    }
+}
 static bool IsZMQAddressIPV6(const std::string &zmq_address)
 {
     const std::string tcp_prefix = "tcp://";
@@ -147,7 +248,8 @@ bool CZMQAbstractPublishNotifier::Initialize(void *pcontext, void *pcontextsub)
     if (i==mapPublishNotifiers.end())
     {
         if(!addresssub.empty()) {
-            psocketsub = zmq_socket(pcontextsub, ZMQ_REQ);
+            // a DEALER socket lets several requests be queued on the REP side when pipelining
+            psocketsub = zmq_socket(pcontextsub, IsNEVMPipelined() ? ZMQ_DEALER : ZMQ_REQ);
             if (!psocketsub)
             {
                 zmqError("Failed to create socket");
@@ -167,9 +269,10 @@ bool CZMQAbstractPublishNotifier::Initialize(void *pcontext, void *pcontextsub)
                 zmq_close(psocketsub);
                 return false;
             }
-            LogPrint(BCLog::ZMQ, "REQ subscribed on address %s\n", addresssub);
+            LogPrint(BCLog::ZMQ, "%s subscribed on address %s (window %d)\n", IsNEVMPipelined() ? "DEALER" : "REQ", addresssub, nNEVMPipelineWindow);
         } else {
-            psocket = zmq_socket(pcontext, ZMQ_PUB);
+            // SYSCOIN
+            psocket = zmq_socket(pcontext, nZMQBatchSize > 1 ? ZMQ_XPUB : ZMQ_PUB);
             if (!psocket)
             {
                 zmqError("Failed to create socket");
@@ -230,6 +333,14 @@ void CZMQAbstractPublishNotifier::Shutdown()
 {
     // Early return if Initialize was not called
     if (!psocket && !psocketsub) return;
+    // SYSCOIN don't drop batched block connects Geth has not seen yet
+    if (psocketsub) {
+        LOCK(cs_nevm);
+        std::string state;
+        if (!FlushNEVMPipeline(state)) {
+            LogPrint(BCLog::SYS, "Shutdown: %s\n", state);
+        }
+    }
 
     int count = mapPublishNotifiers.count(address);
 
@@ -250,6 +361,8 @@ void CZMQAbstractPublishNotifier::Shutdown()
     {
         LogPrint(BCLog::ZMQ, "Close socket at address %s\n", address);
         if(psocket) {
+            // SYSCOIN
+            WITH_LOCK(cs_zmq_batch, mapZMQSubscriptions.erase(psocket));
             int linger = 0;
             zmq_setsockopt(psocket, ZMQ_LINGER, &linger, sizeof(linger));
             zmq_close(psocket);
@@ -282,11 +395,89 @@ bool CZMQAbstractPublishNotifier::SendZmqMessage(const char *command, const void
 
     return true;
 }
+// SYSCOIN
+bool CZMQAbstractPublishNotifier::SendZmqMessageBatched(const char *command, const void* data, size_t size)
+{
+    if (nZMQBatchSize <= 1) {
+        return SendZmqMessage(command, data, size);
+    }
+    assert(psocket);
+    LOCK(cs_zmq_batch);
+    PollZMQSubscriptions(psocket);
+    const std::string_view topic{command};
+    const std::string batch_topic{std::string{MSG_BATCH_PREFIX} + command};
+    bool fSingle{false}, fBatched{false};
+    for (const std::string& subscription : mapZMQSubscriptions[psocket]) {
+        fSingle |= topic.substr(0, subscription.size()) == subscription;
+        // subscribers of every topic do not ask for batches
+        fBatched |= !subscription.empty() && batch_topic.compare(0, subscription.size(), subscription) == 0;
+    }
+    // a batch covers a contiguous sequence range of one command
+    if (!vBatch.empty() && (!fBatched || batchCommand != command)) {
+        if (!SendZmqBatch()) return false;
+    }
+    if (!fBatched) {
+        return SendZmqMessage(command, data, size);
+    }
+    const uint32_t nMsgSequence{nSequence};
+    if (fSingle) {
+        if (!SendZmqMessage(command, data, size)) return false;
+    } else {
+        nSequence++;
+    }
+    if (vBatch.empty()) {
+        batchCommand = command;
+        nBatchFirstSequence = nMsgSequence;
+        batchStart = SteadyClock::now();
+    }
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    vBatch.emplace_back(bytes, bytes + size);
+    if (vBatch.size() >= (size_t)nZMQBatchSize || SteadyClock::now() - batchStart >= std::chrono::milliseconds{nZMQBatchInterval}) {
+        return SendZmqBatch();
+    }
+    return true;
+}
+
+bool CZMQAbstractPublishNotifier::SendZmqBatch()
+{
+    AssertLockHeld(cs_zmq_batch);
+    assert(psocket && !vBatch.empty());
+    const std::string batch_topic{std::string{MSG_BATCH_PREFIX} + batchCommand};
+    unsigned char msgseq[2 * sizeof(uint32_t)];
+    WriteLE32(msgseq, nBatchFirstSequence);
+    WriteLE32(msgseq + sizeof(uint32_t), nBatchFirstSequence + vBatch.size() - 1);
+    std::vector<Span<const unsigned char>> parts;
+    parts.reserve(vBatch.size() + 2);
+    parts.emplace_back(MakeUCharSpan(batch_topic));
+    for (const auto& data : vBatch) {
+        parts.emplace_back(data);
+    }
+    parts.emplace_back(msgseq);
+    LogPrint(BCLog::ZMQ, "Publish %s of %d messages to %s\n", batch_topic, vBatch.size(), this->address);
+    const int rc = zmq_send_parts(psocket, parts);
+    vBatch.clear();
+    return rc != -1;
+}
+
+bool CZMQAbstractPublishNotifier::NotifyBatchFlush(bool fForce)
+{
+    LOCK(cs_zmq_batch);
+    if (vBatch.empty() || (!fForce && SteadyClock::now() - batchStart < std::chrono::milliseconds{nZMQBatchInterval})) {
+        return true;
+    }
+    return SendZmqBatch();
+}
+
 bool CZMQAbstractPublishNotifier::SendZmqMessageNEVM(const char *command, const void* data, size_t size)
 {
     assert(psocketsub);
-
-    int rc = zmq_send_multipart(psocketsub, command, strlen(command), data, size, nullptr);
+    int rc;
+    // DEALER sockets must add the empty delimiter frame REQ would add for us
+    if (IsNEVMPipelined()) {
+        rc = zmq_send_multipart(psocketsub, "", (size_t)0, command, strlen(command), data, size, nullptr);
+    } else {
+        rc = zmq_send_multipart(psocketsub, command, strlen(command), data, size, nullptr);
+    }
     if (rc == -1)
         return false;
 
@@ -302,6 +493,142 @@ bool CZMQAbstractPublishNotifier::ReceiveZmqMessage(std::vector<std::string>& pa
     int rc = zmq_receive_multipart(psocketsub, parts);
     if (rc == -1)
         return false;
+    if (IsNEVMPipelined()) {
+        // strip the empty delimiter frame added by the REP side
+        if (parts.empty() || !parts.front().empty()) {
+            return false;
+        }
+        parts.erase(parts.begin());
+    }
+    return true;
+}
+bool CZMQAbstractPublishNotifier::ReceiveNEVMConnectAck(std::string &state)
+{
+    AssertLockHeld(cs_nevm);
+    assert(!dequeNEVMInFlight.empty());
+    const NEVMInFlightConnect inflight = dequeNEVMInFlight.front();
+    dequeNEVMInFlight.pop_front();
+    std::vector<std::string> parts;
+    // parts: command, result and optionally the echoed LE 4 byte sequence number. Without a matching ack there is
+    // no telling whether Geth connected the block, so it counts as failed.
+    if(!ReceiveZmqMessage(parts)) {
+        state = "nevm-response-not-found";
+    } else if(parts.size() != 2 && parts.size() != 3) {
+        state = "nevm-response-invalid-parts";
+    } else if(parts[0] != inflight.command) {
+        state = "nevm-response-wrong-command";
+    } else if(parts.size() == 3 && (parts[2].size() != sizeof(uint32_t) || ReadLE32((const unsigned char*)parts[2].data()) != inflight.nSeq)) {
+        state = "nevm-response-wrong-sequence";
+    } else {
+        // Geth answered, so it is done reading the block data from the shared memory ring
+        g_nevm_shm.Release(inflight.nShmEnd);
+        if(parts[1] != "connected") {
+            LogPrint(BCLog::SYS, "NotifyNEVMBlockConnect: pipelined block %s at height %d (%d blocks) rejected: %s\n", inflight.nBlockHash.GetHex(), inflight.nHeight, inflight.nCount, parts[1]);
+            SetNEVMFirstFailed(inflight, parts[1]);
+        }
+        return true;
+    }
+    LogPrint(BCLog::SYS, "NotifyNEVMBlockConnect: no ack for pipelined block %s at height %d (%d blocks): %s\n", inflight.nBlockHash.GetHex(), inflight.nHeight, inflight.nCount, state);
+    SetNEVMFirstFailed(inflight, state);
+    return false;
+}
+bool CZMQAbstractPublishNotifier::PushNEVMConnect(const char *command, Span<const std::byte> data, const unsigned char* msgcount, uint32_t nHeight, const uint256& nBlockHash, uint32_t nCount, std::string &state)
+{
+    AssertLockHeld(cs_nevm);
+    assert(psocketsub);
+    const uint32_t nSeq = nNEVMConnectSeq++;
+    unsigned char msgseq[sizeof(uint32_t)];
+    WriteLE32(msgseq, nSeq);
+    int rc;
+    // parts: [delimiter], command, [LE 4 byte block count], data, [LE 4 byte sequence number]
+    if(IsNEVMPipelined()) {
+        if(msgcount) {
+            rc = zmq_send_multipart(psocketsub, "", (size_t)0, command, strlen(command), msgcount, (size_t)sizeof(uint32_t), data.data(), data.size(), msgseq, (size_t)sizeof(uint32_t), nullptr);
+        } else {
+            rc = zmq_send_multipart(psocketsub, "", (size_t)0, command, strlen(command), data.data(), data.size(), msgseq, (size_t)sizeof(uint32_t), nullptr);
+        }
+    } else {
+        if(msgcount) {
+            rc = zmq_send_multipart(psocketsub, command, strlen(command), msgcount, (size_t)sizeof(uint32_t), data.data(), data.size(), nullptr);
+        } else {
+            rc = zmq_send_multipart(psocketsub, command, strlen(command), data.data(), data.size(), nullptr);
+        }
+    }
+    if(rc == -1) {
+        SetNEVMFirstFailed({nSeq, nHeight, nBlockHash, nCount, command, g_nevm_shm.Head()}, "nevm-connect-not-sent");
+        state = "nevm-pipeline-failed";
+        return false;
+    }
+    dequeNEVMInFlight.push_back({nSeq, nHeight, nBlockHash, nCount, command, g_nevm_shm.Head()});
+    while(dequeNEVMInFlight.size() >= (size_t)nNEVMPipelineWindow) {
+        if(!ReceiveNEVMConnectAck(state)) {
+            // the remaining acks cannot be matched reliably anymore
+            dequeNEVMInFlight.clear();
+            break;
+        }
+    }
+    // stop sending as soon as Geth fell behind, nothing sent from here on could be connected
+    if(optNEVMFirstFailed) {
+        state = "nevm-pipeline-failed";
+        return false;
+    }
+    return true;
+}
+bool CZMQAbstractPublishNotifier::SendNEVMBatch(std::string &state)
+{
+    AssertLockHeld(cs_nevm);
+    if(nNEVMBatchCount == 0) {
+        return true;
+    }
+    // the queued blocks come after the failed one and are rolled back with it
+    if(optNEVMFirstFailed) {
+        ssNEVMBatch.clear();
+        nNEVMBatchCount = 0;
+        state = "nevm-pipeline-failed";
+        return false;
+    }
+    LogPrint(BCLog::ZMQ, "zmq: Publish nevm block connect batch of %d blocks from height %d, subscriber %s\n", nNEVMBatchCount, nNEVMBatchFirstHeight, this->addresssub);
+    unsigned char msgcount[sizeof(uint32_t)];
+    WriteLE32(msgcount, nNEVMBatchCount);
+    const bool ret = PushNEVMConnect(g_nevm_shm.IsOpen() ? MSG_NEVMBLOCKCONNECTBATCHSHM : MSG_NEVMBLOCKCONNECTBATCH, ssNEVMBatch, msgcount, nNEVMBatchFirstHeight, nNEVMBatchFirstBlockHash, nNEVMBatchCount, state);
+    ssNEVMBatch.clear();
+    nNEVMBatchCount = 0;
+    return ret;
+}
+bool CZMQAbstractPublishNotifier::WriteNEVMShm(Span<const unsigned char> data, uint64_t &nOffset, std::string &state)
+{
+    AssertLockHeld(cs_nevm);
+    auto offset = g_nevm_shm.Write(data);
+    if(!offset) {
+        // wait for Geth to ack everything outstanding, after that the whole ring is free
+        if(!FlushNEVMPipeline(state)) {
+            return false;
+        }
+        g_nevm_shm.Release(g_nevm_shm.Head());
+        offset = g_nevm_shm.Write(data);
+        if(!offset) {
+            state = "nevm-shm-full";
+            return false;
+        }
+    }
+    nOffset = *offset;
+    return true;
+}
+bool CZMQAbstractPublishNotifier::FlushNEVMPipeline(std::string &state)
+{
+    AssertLockHeld(cs_nevm);
+    SendNEVMBatch(state);
+    while(!dequeNEVMInFlight.empty()) {
+        if(!ReceiveNEVMConnectAck(state)) {
+            // the remaining acks cannot be matched reliably anymore
+            dequeNEVMInFlight.clear();
+        }
+    }
+    // the failure sticks until validation has rolled back to the failed block
+    if(optNEVMFirstFailed) {
+        state = "nevm-pipeline-failed";
+        return false;
+    }
     return true;
 }
 bool CZMQPublishNEVMCommsNotifier::NotifyNEVMComms(const std::string &commMessage, bool &bResponse) {
@@ -312,6 +639,10 @@ bool CZMQAbstractPublishNotifier::NotifyNEVMCommsCommon(const std::string &commM
 {
     LOCK(cs_nevm);
     bResponse = false;
+    std::string flushState;
+    if(!FlushNEVMPipeline(flushState)) {
+        LogPrint(BCLog::SYS, "NotifyNEVMComms: %s\n", flushState);
+    }
     if(psocketsub) {
         int timeout = 150000;
         int rc = zmq_setsockopt(psocketsub, ZMQ_RCVTIMEO, &timeout, sizeof(timeout));
@@ -357,6 +688,11 @@ bool CZMQPublishNEVMBlockConnectNotifier::NotifyNEVMBlockConnect(const CNEVMHead
 {
     LOCK(cs_nevm);
     state = "";
+    // Geth would not build on top of the failed block
+    if(optNEVMFirstFailed) {
+        state = "nevm-pipeline-failed";
+        return false;
+    }
     if(bFirstTime) {
         bFirstTime = false;
         bool bResponse = false;
@@ -380,35 +716,83 @@ bool CZMQPublishNEVMBlockConnectNotifier::NotifyNEVMBlockConnect(const CNEVMHead
     uint256 hash = evmBlock.nBlockHash;
     LogPrint(BCLog::ZMQ, "zmq: Publish nevm block connect %s to %s, subscriber %s\n", hash.GetHex(), this->address, this->addresssub);
     CDataStream ss(SER_NETWORK, PROTOCOL_VERSION);
-    ss << evmBlock << block.vchNEVMBlockData << nSYSBlockHash << NEVMDataVecOut << diff;
-    if(!SendZmqMessageNEVM(MSG_NEVMBLOCKCONNECT, &(*ss.begin()), ss.size())) {
+    const char *command = MSG_NEVMBLOCKCONNECT;
+    if(g_nevm_shm.IsOpen()) {
+        uint64_t nOffset;
+        if(!WriteNEVMShm(block.vchNEVMBlockData, nOffset, state)) {
+            return false;
+        }
+        ss << evmBlock << nOffset << (uint64_t)block.vchNEVMBlockData.size() << nSYSBlockHash << NEVMDataVecOut << diff;
+        command = MSG_NEVMBLOCKCONNECTSHM;
+    } else {
+        ss << evmBlock << block.vchNEVMBlockData << nSYSBlockHash << NEVMDataVecOut << diff;
+    }
+    // assumed-valid blocks do not wait for their ack before the next block is sent, a rejection is still caught
+    // when the ack comes in and validation then rolls back to the rejected block
+    if(bSkipValidation && nNEVMBatchSize > 1) {
+        if(nNEVMBatchCount == 0) {
+            nNEVMBatchFirstHeight = nHeight;
+            nNEVMBatchFirstBlockHash = nSYSBlockHash;
+        }
+        ssNEVMBatch.write(MakeByteSpan(ss));
+        nNEVMBatchCount++;
+        if(nNEVMBatchCount < (uint32_t)nNEVMBatchSize && ssNEVMBatch.size() < MAX_NEVM_BATCH_BYTES) {
+            return true;
+        }
+        return SendNEVMBatch(state);
+    }
+    if(IsNEVMPipelined() && bSkipValidation) {
+        return PushNEVMConnect(command, ss, nullptr, nHeight, nSYSBlockHash, 1, state);
+    }
+    if(!FlushNEVMPipeline(state)) {
+        return false;
+    }
+    if(!SendZmqMessageNEVM(command, &(*ss.begin()), ss.size())) {
         state = "nevm-connect-not-sent";
         return false;
     }
     if(ReceiveZmqMessage(parts)) {
+        // nothing else is outstanding and Geth answers in order, so the whole ring can be reused
+        g_nevm_shm.Release(g_nevm_shm.Head());
         if(parts.size() != 2) {
             state = "nevm-response-invalid-parts";
             return false;
         }
-        if(parts[0] != MSG_NEVMBLOCKCONNECT) {
+        if(parts[0] != command) {
             state = "nevm-response-wrong-command";
             return false;
         }
-        if(!bSkipValidation && parts[1] != "connected") {
+        if(parts[1] != "connected") {
             LogPrint(BCLog::SYS, "NotifyNEVMBlockConnect: %s\n", parts[1]);
             state = "nevm-connect-response-invalid-data";
             return false;
         }
-    } else if (!bSkipValidation) {
+    } else {
         state = "nevm-response-not-found";
         return false;
     }
 
     return true;
 }
-bool CZMQPublishNEVMBlockDisconnectNotifier::NotifyNEVMBlockDisconnect(std::string &state, const uint256& nSYSBlockHash, const CDeterministicMNListNEVMAddressDiff &diff)
+bool CZMQPublishNEVMBlockConnectNotifier::NotifyNEVMFlush(std::string &state, uint256 &nFailedBlockHash)
 {
     LOCK(cs_nevm);
+    if(!psocketsub || FlushNEVMPipeline(state)) {
+        return true;
+    }
+    // report the block that actually failed, not the one whose connect ran into it
+    if(optNEVMFirstFailed) {
+        LogPrintf("NotifyNEVMFlush: Geth failed to connect block %s at height %d (%d blocks): %s\n", optNEVMFirstFailed->nBlockHash.GetHex(), optNEVMFirstFailed->nHeight, optNEVMFirstFailed->nCount, strNEVMFirstFailedReason);
+        state = strNEVMFirstFailedReason;
+        nFailedBlockHash = optNEVMFirstFailed->nBlockHash;
+        // validation rolls back now, Geth is in sync again once it did
+        optNEVMFirstFailed.reset();
+    }
+    return false;
+}
+bool CZMQPublishNEVMBlockDisconnectNotifier::PrepareNEVMDisconnect(std::string &state)
+{
+    AssertLockHeld(cs_nevm);
     if(bFirstTime) {
         bFirstTime = false;
         bool bResponse = false;
@@ -428,11 +812,13 @@ bool CZMQPublishNEVMBlockDisconnectNotifier::NotifyNEVMBlockDisconnect(std::stri
             return false;
         }
     }
+    return FlushNEVMPipeline(state);
+}
+bool CZMQPublishNEVMBlockDisconnectNotifier::SendNEVMDisconnect(const char *command, Span<const std::byte> data, std::string &state)
+{
+    AssertLockHeld(cs_nevm);
     std::vector<std::string> parts;
-    LogPrint(BCLog::ZMQ, "zmq: Publish nevm block disconnect %s to %s, subscriber %s\n", nSYSBlockHash.GetHex(), this->address, this->addresssub);
-    CDataStream ss(SER_NETWORK, PROTOCOL_VERSION);
-    ss << nSYSBlockHash << diff;
-    if(!SendZmqMessageNEVM(MSG_NEVMBLOCKDISCONNECT, &(*ss.begin()), ss.size())) {
+    if(!SendZmqMessageNEVM(command, data.data(), data.size())) {
         state = "nevm-disconnect-not-sent";
         return false;
     }
@@ -441,7 +827,7 @@ bool CZMQPublishNEVMBlockDisconnectNotifier::NotifyNEVMBlockDisconnect(std::stri
             state = "nevm-response-invalid-parts";
             return false;   
         }
-        if(parts[0] != MSG_NEVMBLOCKDISCONNECT) {
+        if(parts[0] != command) {
             state = "nevm-response-wrong-command";
             return false;
         }
@@ -456,6 +842,44 @@ bool CZMQPublishNEVMBlockDisconnectNotifier::NotifyNEVMBlockDisconnect(std::stri
     }
     return true;
 }
+bool CZMQPublishNEVMBlockDisconnectNotifier::NotifyNEVMBlockDisconnect(std::string &state, const uint256& nSYSBlockHash, const CDeterministicMNListNEVMAddressDiff &diff)
+{
+    LOCK(cs_nevm);
+    if(!PrepareNEVMDisconnect(state)) {
+        return false;
+    }
+    LogPrint(BCLog::ZMQ, "zmq: Publish nevm block disconnect %s to %s, subscriber %s\n", nSYSBlockHash.GetHex(), this->address, this->addresssub);
+    CDataStream ss(SER_NETWORK, PROTOCOL_VERSION);
+    ss << nSYSBlockHash << diff;
+    return SendNEVMDisconnect(MSG_NEVMBLOCKDISCONNECT, ss, state);
+}
+bool CZMQPublishNEVMBlockDisconnectNotifier::NotifyNEVMBlocksDisconnect(std::string &state, const NEVMDisconnectVec &vecBlocks)
+{
+    LOCK(cs_nevm);
+    if(vecBlocks.empty()) {
+        return true;
+    }
+    if(!PrepareNEVMDisconnect(state)) {
+        return false;
+    }
+    CDataStream ss(SER_NETWORK, PROTOCOL_VERSION);
+    // Geth that does not know the rewind message still gets the blocks one by one, just without the setup per block
+    if(!fNEVMDisconnectBatch) {
+        for(const auto& [nSYSBlockHash, diff] : vecBlocks) {
+            LogPrint(BCLog::ZMQ, "zmq: Publish nevm block disconnect %s to %s, subscriber %s\n", nSYSBlockHash.GetHex(), this->address, this->addresssub);
+            ss.clear();
+            ss << nSYSBlockHash << diff;
+            if(!SendNEVMDisconnect(MSG_NEVMBLOCKDISCONNECT, ss, state)) {
+                return false;
+            }
+        }
+        return true;
+    }
+    LogPrint(BCLog::ZMQ, "zmq: Publish nevm rewind of %d blocks down to %s to %s, subscriber %s\n", vecBlocks.size(), vecBlocks.back().first.GetHex(), this->address, this->addresssub);
+    // data: compact size block count, then block hash and address diff of every block in disconnect order
+    ss << vecBlocks;
+    return SendNEVMDisconnect(MSG_NEVMBLOCKDISCONNECTBATCH, ss, state);
+}
 bool CZMQPublishNEVMBlockInfoNotifier::NotifyGetNEVMBlockInfo(uint64_t &nHeight, std::string &state)
 {
     LOCK(cs_nevm);
@@ -468,6 +892,9 @@ bool CZMQPublishNEVMBlockInfoNotifier::NotifyGetNEVMBlockInfo(uint64_t &nHeight,
             return false;
         }
     }
+    if(!FlushNEVMPipeline(state)) {
+        return false;
+    }
     LogPrint(BCLog::ZMQ, "zmq: Publish nevm block info to %s, subscriber %s\n", this->address, this->addresssub);
     if(!SendZmqMessageNEVM(MSG_NEVMBLOCKINFO, MSG_NEVMBLOCKINFO, strlen(MSG_NEVMBLOCKINFO))) {
         state = "nevm-header-not-sent";
@@ -507,6 +934,9 @@ bool CZMQPublishNEVMBlockNotifier::NotifyGetNEVMBlock(CNEVMBlock &evmBlock, std:
             return false;
         }
     }
+    if(!FlushNEVMPipeline(state)) {
+        return false;
+    }
     LogPrint(BCLog::ZMQ, "zmq: Publish nevm block to %s, subscriber %s\n", this->address, this->addresssub);
     if(!SendZmqMessageNEVM(MSG_NEVMBLOCK, MSG_NEVMBLOCK, strlen(MSG_NEVMBLOCK))) {
         state = "nevm-header-not-sent";
@@ -597,7 +1027,7 @@ bool CZMQPublishRawTransactionNotifier::NotifyTransaction(const CTransaction &tr
     // SYSCOIN
     CDataStream ss(SER_NETWORK | SER_NO_PODA, PROTOCOL_VERSION | RPCSerializationFlags());
     ss << transaction;
-    return SendZmqMessage(MSG_RAWTX, &(*ss.begin()), ss.size());
+    return SendZmqMessageBatched(MSG_RAWTX, &(*ss.begin()), ss.size());
 }
 // SYSCOIN
 bool CZMQPublishHashGovernanceVoteNotifier::NotifyGovernanceVote(const uint256& hash)
@@ -618,6 +1048,16 @@ bool CZMQPublishHashGovernanceObjectNotifier::NotifyGovernanceObject(const uint2
     return SendZmqMessage(MSG_HASHGOBJ, data, 32);
 }
 
+bool CZMQPublishZDAGStatusNotifier::NotifyZDAGStatus(const uint256& txid, int status)
+{
+    LogPrint(BCLog::ZMQ, "zmq: Publish zdagstatus %s %d\n", txid.GetHex(), status);
+    uint8_t data[36];
+    for (unsigned int i = 0; i < 32; i++)
+        data[31 - i] = txid.begin()[i];
+    WriteLE32(data + 32, static_cast<uint32_t>(status));
+    return SendZmqMessage(MSG_ZDAGSTATUS, data, sizeof(data));
+}
+
 bool CZMQPublishRawMempoolTransactionNotifier::NotifyTransactionMempool(const CTransaction &transaction)
 {
     uint256 hash = transaction.GetHash();
@@ -625,7 +1065,36 @@ bool CZMQPublishRawMempoolTransactionNotifier::NotifyTransactionMempool(const CT
     // SYSCOIN
     CDataStream ss(SER_NETWORK | SER_NO_PODA, PROTOCOL_VERSION | RPCSerializationFlags());
     ss << transaction;
-    return SendZmqMessage(MSG_RAWMEMPOOLTX, &(*ss.begin()), ss.size());
+    return SendZmqMessageBatched(MSG_RAWMEMPOOLTX, &(*ss.begin()), ss.size());
+}
+
+bool CZMQPublishRawChainLockSigNotifier::NotifyChainLock(const CBlockIndex *pindex, const llmq::CChainLockSig& clsig)
+{
+    LogPrint(BCLog::ZMQ, "Publish rawchainlocksig %s at height %d to %s\n", pindex->GetBlockHash().GetHex(), pindex->nHeight, this->address);
+    CDataStream ss(SER_NETWORK, PROTOCOL_VERSION);
+    ss << clsig;
+    return SendZmqMessage(MSG_RAWCHAINLOCKSIG, &(*ss.begin()), ss.size());
+}
+
+bool CZMQPublishRawMNListDiffNotifier::NotifyMasternodeListDiff(bool undo, const CDeterministicMNList& oldMNList, const CDeterministicMNListDiff& diff)
+{
+    LogPrint(BCLog::ZMQ, "Publish rawmnlistdiff on %s (undo %d) to %s\n", oldMNList.GetBlockHash().GetHex(), undo, this->address);
+    // <block hash of the list the diff applies to><undo flag><diff>
+    CDataStream ss(SER_NETWORK, PROTOCOL_VERSION);
+    ss << oldMNList.GetBlockHash() << undo << diff;
+    return SendZmqMessage(MSG_RAWMNLISTDIFF, &(*ss.begin()), ss.size());
+}
+
+bool CZMQPublishRawNEVMBlobNotifier::NotifyNEVMBlob(const std::vector<uint8_t>& vchVersionHash, const uint256& txid, const std::vector<uint8_t>& vchNEVMData)
+{
+    LogPrint(BCLog::ZMQ, "Publish rawnevmblob %s of %d bytes to %s\n", HexStr(vchVersionHash), vchNEVMData.size(), this->address);
+    // <32-byte version hash><32-byte txid><blob>
+    std::vector<unsigned char> data;
+    data.reserve(vchVersionHash.size() + txid.size() + vchNEVMData.size());
+    data.insert(data.end(), vchVersionHash.begin(), vchVersionHash.end());
+    data.insert(data.end(), txid.begin(), txid.end());
+    data.insert(data.end(), vchNEVMData.begin(), vchNEVMData.end());
+    return SendZmqMessage(MSG_RAWNEVMBLOB, data.data(), data.size());
 }
 
 // Helper function to send a 'sequence' topic message with the following structure:
@@ -638,7 +1107,7 @@ static bool SendSequenceMsg(CZMQAbstractPublishNotifier& notifier, uint256 hash,
     }
     data[sizeof(hash)] = label;
     if (sequence) WriteLE64(data + sizeof(hash) + sizeof(label), *sequence);
-    return notifier.SendZmqMessage(MSG_SEQUENCE, data, sequence ? sizeof(data) : sizeof(hash) + sizeof(label));
+    return notifier.SendZmqMessageBatched(MSG_SEQUENCE, data, sequence ? sizeof(data) : sizeof(hash) + sizeof(label));
 }
 
 bool CZMQPublishSequenceNotifier::NotifyBlockConnect(const CBlockIndex *pindex)
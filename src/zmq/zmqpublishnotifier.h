@@ -7,9 +7,13 @@
 
 #include <zmq/zmqabstractnotifier.h>
 
+#include <span.h>
+#include <util/time.h>
+
 #include <cstddef>
 #include <cstdint>
 #include <functional>
+#include <vector>
 
 class CBlock;
 class CBlockIndex;
@@ -25,6 +29,13 @@ class CZMQAbstractPublishNotifier : public CZMQAbstractNotifier
 {
 private:
     uint32_t nSequence {0U}; //!< upcounting per message sequence number
+    // SYSCOIN messages held back for the next batch, they all have the same command
+    const char *batchCommand{nullptr};
+    std::vector<std::vector<unsigned char>> vBatch;
+    uint32_t nBatchFirstSequence{0};
+    SteadyClock::time_point batchStart;
+
+    bool SendZmqBatch();
 
 public:
 
@@ -36,8 +47,27 @@ public:
     */
     bool SendZmqMessage(const char *command, const void* data, size_t size);
     // SYSCOIN
+    /* like SendZmqMessage, but with -zmqpubbatch the message is also queued for
+       subscribers of the "batch" + command topic, which get up to that many
+       messages in one multipart message:
+          * "batch" + command
+          * data of each message
+          * LE 4byte sequence number of the first and of the last message
+    */
+    bool SendZmqMessageBatched(const char *command, const void* data, size_t size);
+    bool NotifyBatchFlush(bool fForce) override;
     bool SendZmqMessageNEVM(const char *command, const void* data, size_t size);
     bool NotifyNEVMCommsCommon(const std::string& commMessage, bool &bResponse);
+    /* read the ack of the oldest in-flight block connect */
+    bool ReceiveNEVMConnectAck(std::string &state);
+    /* send a block connect (or batch of them) and wait for acks until the in-flight window has room again */
+    bool PushNEVMConnect(const char *command, Span<const std::byte> data, const unsigned char* msgcount, uint32_t nHeight, const uint256& nBlockHash, uint32_t nCount, std::string &state);
+    /* copy NEVM block data into the shared memory ring, draining acks first if it is full */
+    bool WriteNEVMShm(Span<const unsigned char> data, uint64_t &nOffset, std::string &state);
+    /* send all block connects queued for the current batch as a single message */
+    bool SendNEVMBatch(std::string &state);
+    /* wait for all in-flight block connect acks, fails if any of them was rejected */
+    bool FlushNEVMPipeline(std::string &state);
     /* receive zmq message
        parts:
           * command
@@ -68,11 +98,18 @@ class CZMQPublishNEVMBlockConnectNotifier : public CZMQAbstractPublishNotifier
 {
 public:
     bool NotifyNEVMBlockConnect(const CNEVMHeader &evmBlock, const CBlock& block, std::string &state, const uint256& nBlockHash, NEVMDataVec &NEVMDataVecOut, const uint32_t& nHeight, bool bSkipValidation, const CDeterministicMNListNEVMAddressDiff &diff) override;
+    bool NotifyNEVMFlush(std::string &state, uint256 &nFailedBlockHash) override;
 };
 class CZMQPublishNEVMBlockDisconnectNotifier : public CZMQAbstractPublishNotifier
 {
 public:
     bool NotifyNEVMBlockDisconnect(std::string &state, const uint256& nBlockHash, const CDeterministicMNListNEVMAddressDiff &diff) override;
+    bool NotifyNEVMBlocksDisconnect(std::string &state, const NEVMDisconnectVec &vecBlocks) override;
+private:
+    /* check Geth is there, set the disconnect timeout and drain the connect pipeline */
+    bool PrepareNEVMDisconnect(std::string &state);
+    /* send a (batched) disconnect and wait for Geth to confirm it */
+    bool SendNEVMDisconnect(const char *command, Span<const std::byte> data, std::string &state);
 };
 class CZMQPublishHashBlockNotifier : public CZMQAbstractPublishNotifier
 {
@@ -120,6 +157,30 @@ public:
     bool NotifyGovernanceObject(const uint256 &object) override;
 };
 
+class CZMQPublishZDAGStatusNotifier : public CZMQAbstractPublishNotifier
+{
+public:
+    bool NotifyZDAGStatus(const uint256 &txid, int status) override;
+};
+
+class CZMQPublishRawChainLockSigNotifier : public CZMQAbstractPublishNotifier
+{
+public:
+    bool NotifyChainLock(const CBlockIndex *pindex, const llmq::CChainLockSig& clsig) override;
+};
+
+class CZMQPublishRawMNListDiffNotifier : public CZMQAbstractPublishNotifier
+{
+public:
+    bool NotifyMasternodeListDiff(bool undo, const CDeterministicMNList& oldMNList, const CDeterministicMNListDiff& diff) override;
+};
+
+class CZMQPublishRawNEVMBlobNotifier : public CZMQAbstractPublishNotifier
+{
+public:
+    bool NotifyNEVMBlob(const std::vector<uint8_t>& vchVersionHash, const uint256& txid, const std::vector<uint8_t>& vchNEVMData) override;
+};
+
 class CZMQPublishSequenceNotifier : public CZMQAbstractPublishNotifier
 {
 public:
@@ -0,0 +1,90 @@
+// Copyright (c) 2023 The Syscoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <zmq/zmqsharedmemory.h>
+
+#include <logging.h>
+#include <util/syserror.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+#ifndef WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+CZMQSharedRing g_nevm_shm;
+
+CZMQSharedRing::~CZMQSharedRing()
+{
+    Close();
+}
+
+bool CZMQSharedRing::Open(const fs::path& path, size_t size)
+{
+#ifndef WIN32
+    Close();
+    m_fd = open(fs::PathToString(path).c_str(), O_RDWR | O_CREAT, 0600);
+    if (m_fd == -1) {
+        LogPrintf("%s: unable to open %s: %s\n", __func__, fs::PathToString(path), SysErrorString(errno));
+        return false;
+    }
+    if (ftruncate(m_fd, size) != 0) {
+        LogPrintf("%s: unable to resize %s: %s\n", __func__, fs::PathToString(path), SysErrorString(errno));
+        Close();
+        return false;
+    }
+    void* addr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, 0);
+    if (addr == MAP_FAILED) {
+        LogPrintf("%s: unable to map %s: %s\n", __func__, fs::PathToString(path), SysErrorString(errno));
+        Close();
+        return false;
+    }
+    m_data = static_cast<unsigned char*>(addr);
+    m_size = size;
+    m_head = m_tail = 0;
+    LogPrint(BCLog::ZMQ, "NEVM shared memory ring of %d bytes mapped at %s\n", size, fs::PathToString(path));
+    return true;
+#else
+    LogPrintf("%s: shared memory transport is not supported on this platform\n", __func__);
+    return false;
+#endif
+}
+
+void CZMQSharedRing::Close()
+{
+#ifndef WIN32
+    if (m_data) {
+        munmap(m_data, m_size);
+        m_data = nullptr;
+    }
+    if (m_fd != -1) {
+        close(m_fd);
+        m_fd = -1;
+    }
+#endif
+    m_size = 0;
+    m_head = m_tail = 0;
+}
+
+std::optional<uint64_t> CZMQSharedRing::Write(Span<const unsigned char> data)
+{
+    if (!m_data || data.size() > m_size) return std::nullopt;
+    uint64_t pos = m_head;
+    const size_t offset = pos % m_size;
+    // skip the remainder of the buffer rather than splitting the payload
+    if (offset + data.size() > m_size) pos += m_size - offset;
+    if (pos + data.size() - m_tail > m_size) return std::nullopt;
+    std::memcpy(m_data + (pos % m_size), data.data(), data.size());
+    m_head = pos + data.size();
+    return pos % m_size;
+}
+
+void CZMQSharedRing::Release(uint64_t pos)
+{
+    m_tail = std::clamp(pos, m_tail, m_head);
+}
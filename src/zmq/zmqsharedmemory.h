@@ -0,0 +1,57 @@
+// Copyright (c) 2023 The Syscoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef SYSCOIN_ZMQ_ZMQSHAREDMEMORY_H
+#define SYSCOIN_ZMQ_ZMQSHAREDMEMORY_H
+
+#include <span.h>
+#include <util/fs.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+/**
+ * Memory-mapped ring buffer shared with a co-located Geth process.
+ *
+ * NEVM payloads are copied once into the mapping and only their offset and
+ * length travel over ZMQ. Positions are tracked as monotonically increasing
+ * byte counts; a region is reclaimed once Geth has acked every message up to
+ * it. Payloads never wrap, the unused tail of the buffer is skipped instead.
+ */
+class CZMQSharedRing
+{
+public:
+    //! Smallest ring that still fits a maximum sized NEVM block twice
+    static constexpr size_t MIN_SIZE{64 << 20};
+    static constexpr size_t DEFAULT_SIZE{256 << 20};
+
+    CZMQSharedRing() = default;
+    ~CZMQSharedRing();
+    CZMQSharedRing(const CZMQSharedRing&) = delete;
+    CZMQSharedRing& operator=(const CZMQSharedRing&) = delete;
+
+    /** Create (or truncate) the backing file and map it, fails on platforms without mmap */
+    bool Open(const fs::path& path, size_t size);
+    void Close();
+    bool IsOpen() const { return m_data != nullptr; }
+
+    /** Copy data into the ring, returns its offset in the mapping or nullopt if there is no room */
+    std::optional<uint64_t> Write(Span<const unsigned char> data);
+    /** Position just past the last written byte, used to later release everything written so far */
+    uint64_t Head() const { return m_head; }
+    /** Mark everything before pos as consumed by the reader */
+    void Release(uint64_t pos);
+
+private:
+    int m_fd{-1};
+    unsigned char* m_data{nullptr};
+    size_t m_size{0};
+    uint64_t m_head{0};
+    uint64_t m_tail{0};
+};
+
+extern CZMQSharedRing g_nevm_shm;
+
+#endif // SYSCOIN_ZMQ_ZMQSHAREDMEMORY_H
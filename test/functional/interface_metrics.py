@@ -0,0 +1,76 @@
+#!/usr/bin/env python3
+# Copyright (c) 2024 The Syscoin Core developers
+# Distributed under the MIT software license, see the accompanying
+# file COPYING or http://www.opensource.org/licenses/mit-license.php.
+"""Test the Prometheus metrics served on -metricsbind."""
+
+from test_framework.blocktools import COINBASE_MATURITY
+from test_framework.test_framework import SyscoinTestFramework
+from test_framework.util import assert_equal, p2p_port
+from test_framework.wallet import MiniWallet
+
+import http.client
+
+
+class MetricsTest(SyscoinTestFramework):
+    def set_test_params(self):
+        self.num_nodes = 2
+        self.setup_clean_chain = True
+        self.supports_cli = False
+
+    def setup_network(self):
+        self.metrics_port = p2p_port(self.num_nodes)
+        self.extra_args = [[f"-metricsbind=127.0.0.1:{self.metrics_port}"], []]
+        self.setup_nodes()
+        self.connect_nodes(0, 1)
+
+    def fetch(self, method='GET', path='/metrics'):
+        conn = http.client.HTTPConnection('127.0.0.1', self.metrics_port)
+        conn.request(method, path)
+        response = conn.getresponse()
+        body = response.read().decode()
+        conn.close()
+        return response, body
+
+    def metrics(self):
+        response, body = self.fetch()
+        assert_equal(response.status, 200)
+        assert response.getheader('Content-Type').startswith('text/plain')
+        values = {}
+        for line in body.splitlines():
+            if line.startswith('#'):
+                continue
+            name, value = line.rsplit(' ', 1)
+            values[name] = float(value)
+        return values
+
+    def run_test(self):
+        node = self.nodes[0]
+        self.log.info("Block connects, the chain height and the network counters are reported")
+        self.generate(node, 5)
+        values = self.metrics()
+        assert_equal(values['syscoin_chain_height'], node.getblockcount())
+        assert values['syscoin_blocks_connected_total'] >= 5
+        assert_equal(values['syscoin_block_connect_seconds_count'], values['syscoin_blocks_connected_total'])
+        assert values['syscoin_net_bytes_received_total'] > 0
+        assert values['syscoin_net_bytes_sent_total'] > 0
+        assert_equal(values['syscoin_net_peers'], len(node.getpeerinfo()))
+
+        self.log.info("The mempool gauges follow the mempool")
+        wallet = MiniWallet(node)
+        self.generate(wallet, COINBASE_MATURITY + 1)
+        wallet.send_self_transfer(from_node=node)
+        info = node.getmempoolinfo()
+        values = self.metrics()
+        assert_equal(values['syscoin_mempool_transactions'], info['size'])
+        assert_equal(values['syscoin_mempool_bytes'], info['bytes'])
+
+        self.log.info("Only GET /metrics is served")
+        response, _ = self.fetch(path='/')
+        assert_equal(response.status, 404)
+        response, _ = self.fetch(method='POST')
+        assert_equal(response.status, 501)
+
+
+if __name__ == '__main__':
+    MetricsTest().main()
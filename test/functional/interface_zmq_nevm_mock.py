@@ -0,0 +1,86 @@
+#!/usr/bin/env python3
+# Copyright (c) 2024 The Syscoin Core developers
+# Distributed under the MIT software license, see the accompanying
+# file COPYING or http://www.opensource.org/licenses/mit-license.php.
+"""Test the in-process mock Geth node of -zmqpubnevmmock."""
+
+from test_framework.address import (
+    ADDRESS_BCRT1_P2WSH_OP_TRUE,
+    ADDRESS_BCRT1_UNSPENDABLE,
+)
+from test_framework.test_framework import SyscoinTestFramework
+from test_framework.util import (
+    assert_equal,
+    force_finish_mnsync,
+)
+
+
+class ZMQNEVMMockTest(SyscoinTestFramework):
+    def set_test_params(self):
+        self.num_nodes = 1
+        self.extra_args = [["-nevmstartheight=205", "-zmqpubnevm=tcp://127.0.0.1:29460", "-zmqpubnevmmock"]]
+
+    def skip_test_if_missing_module(self):
+        self.skip_if_no_syscoind_zmq()
+
+    def run_test(self):
+        node = self.nodes[0]
+        force_finish_mnsync(node)
+
+        self.log.info("Connect NEVM blocks to the mock Geth node one at a time")
+        self.generatetoaddress(node, 10, ADDRESS_BCRT1_UNSPENDABLE)
+        assert_equal(node.getblockcount(), 210)
+        besthash = node.getbestblockhash()
+
+        self.log.info("Disconnect and reconnect a NEVM block")
+        blockhash = node.getblockhash(206)
+        node.invalidateblock(blockhash)
+        assert_equal(node.getblockcount(), 205)
+        node.reconsiderblock(blockhash)
+        assert_equal(node.getbestblockhash(), besthash)
+
+        self.log.info("Replay the chain into a pipelined mock Geth node with latency and jitter")
+        self.restart_node(0, self.extra_args[0] + [
+            "-reindex",
+            "-zmqpubnevmwindow=8",
+            "-zmqpubnevmbatch=4",
+            "-zmqpubnevmmocklatency=2000",
+            "-zmqpubnevmmockjitter=1000",
+            "-zmqpubnevmmockblocktime=100",
+        ])
+        self.wait_until(lambda: node.getblockcount() == 210)
+        assert_equal(node.getbestblockhash(), besthash)
+        force_finish_mnsync(node)
+        self.generatetoaddress(node, 2, ADDRESS_BCRT1_UNSPENDABLE)
+        assert_equal(node.getblockcount(), 212)
+
+        self.log.info("Rewind the mock Geth node over a reorg with a single batched disconnect")
+        self.restart_node(0, self.extra_args[0] + ["-zmqpubnevmdisconnectbatch"])
+        force_finish_mnsync(node)
+        besthash = node.getbestblockhash()
+        blockhash = node.getblockhash(209)
+        node.invalidateblock(blockhash)
+        self.generatetoaddress(node, 2, ADDRESS_BCRT1_P2WSH_OP_TRUE, sync_fun=self.no_op)
+        assert_equal(node.getblockcount(), 210)
+        with node.assert_debug_log(["NEVM disconnect of 2 blocks"]):
+            node.reconsiderblock(blockhash)
+        assert_equal(node.getbestblockhash(), besthash)
+
+        self.log.info("Roll back to a pipelined block the mock Geth node rejects and reconnect from there in lock-step")
+        # blocks are only assumed valid, and so pipelined, with more than two weeks of work on top of them
+        self.generatetoaddress(node, 1000, ADDRESS_BCRT1_UNSPENDABLE)
+        besthash = node.getbestblockhash()
+        with node.assert_debug_log(["rejected: mock-rejected", "Geth failed to connect block", "rolling back to height"], timeout=120):
+            self.restart_node(0, self.extra_args[0] + [
+                "-reindex",
+                "-assumevalid=" + besthash,
+                "-zmqpubnevmwindow=8",
+                "-zmqpubnevmmocklatency=2000",
+                "-zmqpubnevmmockrejectat=20",
+            ])
+            self.wait_until(lambda: node.getbestblockhash() == besthash, timeout=120)
+        assert_equal(node.getblockcount(), 1212)
+
+
+if __name__ == '__main__':
+    ZMQNEVMMockTest().main()
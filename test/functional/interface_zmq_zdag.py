@@ -0,0 +1,137 @@
+#!/usr/bin/env python3
+# Copyright (c) 2024 The Syscoin Core developers
+# Distributed under the MIT software license, see the accompanying
+# file COPYING or http://www.opensource.org/licenses/mit-license.php.
+"""Test the ZDAG status notifications of -zmqpubzdagstatus."""
+
+from decimal import Decimal
+import struct
+
+from test_framework.asset_helpers import (
+    create_transaction_with_selector,
+    SYSCOIN_TX_VERSION_ALLOCATION_SEND,
+    SYSCOIN_TX_VERSION_SYSCOIN_BURN_TO_ALLOCATION,
+)
+from test_framework.test_framework import SyscoinTestFramework
+from test_framework.util import (
+    assert_equal,
+    p2p_port,
+)
+
+# Test may be skipped and not have zmq installed
+try:
+    import zmq
+except ImportError:
+    pass
+
+SYSX_GUID = 123456
+# the values assetallocationverifyzdag returns
+ZDAG_STATUS_OK = 0
+ZDAG_WARNING_RBF = 1
+ZDAG_MAJOR_CONFLICT = 4
+
+
+class ZMQZDAGStatusTest(SyscoinTestFramework):
+    def add_options(self, parser):
+        self.add_wallet_options(parser)
+
+    def set_test_params(self):
+        self.setup_clean_chain = True
+        self.num_nodes = 1
+        self.address = f"tcp://127.0.0.1:{p2p_port(self.num_nodes + 1)}"
+        # block notifications on the same socket tell when the subscription is in place
+        self.extra_args = [["-dip3params=0:0", f"-zmqpubhashblock={self.address}", f"-zmqpubzdagstatus={self.address}"]]
+
+    def skip_test_if_missing_module(self):
+        self.skip_if_no_py3_zmq()
+        self.skip_if_no_syscoind_zmq()
+        self.skip_if_no_wallet()
+        self.skip_if_no_bdb()
+
+    def run_test(self):
+        self.ctx = zmq.Context()
+        try:
+            self.socket = self.ctx.socket(zmq.SUB)
+            self.socket.setsockopt(zmq.SUBSCRIBE, b"hashblock")
+            self.socket.setsockopt(zmq.SUBSCRIBE, b"zdagstatus")
+            self.socket.connect(self.address)
+            self.sync_up()
+            self.zdag_sequence = 0
+            self.test_zdag_status()
+        finally:
+            # Destroy the ZMQ context.
+            self.log.debug("Destroying ZMQ context")
+            self.ctx.destroy(linger=None)
+
+    def sync_up(self):
+        self.socket.set(zmq.RCVTIMEO, 1000)
+        while True:
+            self.generate(self.nodes[0], 1)
+            try:
+                self.socket.recv_multipart()
+                break
+            except zmq.error.Again:
+                self.log.debug("Didn't receive sync-up notification, trying again.")
+        self.socket.set(zmq.RCVTIMEO, 60000)
+
+    def receive_zdag_status(self):
+        """Return the txid and status of the next zdagstatus message, skipping block notifications"""
+        while True:
+            topic, body, seq = self.socket.recv_multipart()
+            if topic == b"zdagstatus":
+                break
+        # the transaction hash in Little Endian followed by the status as a 4 byte LE int
+        assert_equal(len(body), 36)
+        assert_equal(struct.unpack('<I', seq)[0], self.zdag_sequence)
+        self.zdag_sequence += 1
+        return body[:32][::-1].hex(), struct.unpack('<i', body[32:])[0]
+
+    def allocation_send(self, replaceable):
+        return create_transaction_with_selector(
+            node=self.nodes[0],
+            tx_type=SYSCOIN_TX_VERSION_ALLOCATION_SEND,
+            asset_amounts=[(SYSX_GUID, Decimal('1'), self.nodes[0].getnewaddress())],
+            replaceable=replaceable,
+        )
+
+    def test_zdag_status(self):
+        node = self.nodes[0]
+        self.generate(node, 110)
+        tx_hex = create_transaction_with_selector(
+            node=node,
+            tx_type=SYSCOIN_TX_VERSION_SYSCOIN_BURN_TO_ALLOCATION,
+            sys_amount=Decimal('20'),
+            asset_amounts=[(SYSX_GUID, Decimal('20'), node.getnewaddress())],
+        )
+        node.sendrawtransaction(tx_hex)
+        self.generate(node, 1)
+
+        self.log.info("A ZDAG transaction that does not signal RBF is OK")
+        txid = node.sendrawtransaction(self.allocation_send(replaceable=False))
+        assert_equal(self.receive_zdag_status(), (txid, ZDAG_STATUS_OK))
+        self.generate(node, 1)
+
+        self.log.info("A ZDAG transaction that signals RBF is a warning")
+        txid = node.sendrawtransaction(self.allocation_send(replaceable=True))
+        assert_equal(self.receive_zdag_status(), (txid, ZDAG_WARNING_RBF))
+        self.generate(node, 1)
+
+        self.log.info("Both spends of a double spend are a major conflict")
+        # built from the same wallet state, both spend the same outputs
+        tx_first = self.allocation_send(replaceable=False)
+        tx_second = self.allocation_send(replaceable=False)
+        txid_first = node.sendrawtransaction(tx_first)
+        assert_equal(self.receive_zdag_status(), (txid_first, ZDAG_STATUS_OK))
+        txid_second = node.sendrawtransaction(tx_second)
+        statuses = {self.receive_zdag_status(), self.receive_zdag_status()}
+        assert_equal(statuses, {(txid_first, ZDAG_MAJOR_CONFLICT), (txid_second, ZDAG_MAJOR_CONFLICT)})
+
+        self.log.info("The spend that loses to the one in a block is a major conflict")
+        blockhash = self.generate(node, 1)[0]
+        assert txid_first in node.getblock(blockhash)["tx"]
+        assert_equal(self.receive_zdag_status(), (txid_second, ZDAG_MAJOR_CONFLICT))
+        assert_equal(node.getrawmempool(), [])
+
+
+if __name__ == '__main__':
+    ZMQZDAGStatusTest().main()
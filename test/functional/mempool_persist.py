@@ -33,6 +33,8 @@ Test is as follows:
     mempool.
   - Verify that savemempool throws when the RPC is called if
     node1 can't write to disk.
+  - Kill node0 after sending a transaction past the last dump. Verify
+    the mempool journal brings it back on restart.
 
 """
 from decimal import Decimal
@@ -198,6 +200,7 @@ class MempoolPersistTest(SyscoinTestFramework):
 
         self.test_importmempool_union()
         self.test_persist_unbroadcast()
+        self.test_persist_journal()
 
     def test_persist_unbroadcast(self):
         node0 = self.nodes[0]
@@ -221,6 +224,18 @@ class MempoolPersistTest(SyscoinTestFramework):
         node0.mockscheduler(16 * 60)  # 15 min + 1 for buffer
         self.wait_until(lambda: len(conn.get_invs()) == 1)
 
+    def test_persist_journal(self):
+        self.log.debug("Kill node0 without a clean shutdown. Verify the journal brings back a transaction sent after the last dump")
+        node0 = self.nodes[0]
+        node0.savemempool()
+        txid = self.mini_wallet.send_self_transfer(from_node=node0)["txid"]
+        node0.syncwithvalidationinterfacequeue()  # the journal is appended to from the scheduler thread
+        node0.process.kill()
+        self.wait_until(lambda: node0.is_node_stopped(expected_ret_code=-9))
+        self.start_node(0)
+        self.wait_until(lambda: node0.getmempoolinfo()["loaded"])
+        assert txid in node0.getrawmempool()
+
     def test_importmempool_union(self):
         self.log.debug("Submit different transactions to node0 and node1's mempools")
         self.start_node(0)
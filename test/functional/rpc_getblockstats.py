@@ -182,5 +182,18 @@ class GetblockstatsTest(SyscoinTestFramework):
         assert_equal(tip_stats["utxo_increase_actual"], 4)
         assert_equal(tip_stats["utxo_size_inc_actual"], 300)
 
+        self.log.info("Test getblockstatsrange with and without -blockstatsindex")
+        range_stats = self.nodes[0].getblockstatsrange(self.start_height, self.max_stat_pos + 1)
+        assert_equal(range_stats, self.expected_stats)
+        assert_equal(self.nodes[0].getblockstatsrange(self.start_height, 1000, ['height'])[-1], {'height': tip})
+        assert_raises_rpc_error(-8, 'Start height out of range', self.nodes[0].getblockstatsrange, tip + 1)
+        assert_raises_rpc_error(-8, 'count must be between 1 and 10000', self.nodes[0].getblockstatsrange, 0, 0)
+
+        self.restart_node(0, extra_args=['-blockstatsindex'])
+        self.wait_until(lambda: self.nodes[0].getindexinfo('blockstatsindex')['blockstatsindex']['synced'])
+        assert_equal(self.nodes[0].getblockstatsrange(self.start_height, self.max_stat_pos + 1), self.expected_stats)
+        for i in range(self.max_stat_pos + 1):
+            assert_equal(self.nodes[0].getblockstats(hash_or_height=self.start_height + i), self.expected_stats[i])
+
 if __name__ == '__main__':
     GetblockstatsTest().main()
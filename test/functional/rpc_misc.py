@@ -52,6 +52,13 @@ class RpcMiscTest(SyscoinTestFramework):
             self.log.info('getmemoryinfo(mode="mallocinfo") not available')
             assert_raises_rpc_error(-8, 'mallocinfo mode not available', node.getmemoryinfo, mode="mallocinfo")
 
+        self.log.info('test getmemoryinfo(mode="subsystems")')
+        subsystems = node.getmemoryinfo(mode="subsystems")
+        for name in ["coinsviewcache", "mempool", "deterministicmns", "governance", "nevmdata"]:
+            assert_greater_than_or_equal(subsystems[name]['peak'], subsystems[name]['usage'])
+        assert_greater_than(subsystems['mempool']['limit'], 0)
+        assert_greater_than(subsystems['coinsviewcache']['limit'], 0)
+
         assert_raises_rpc_error(-8, "unknown mode foobar", node.getmemoryinfo, mode="foobar")
 
         self.log.info("test logging rpc and help")
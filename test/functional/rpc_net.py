@@ -141,6 +141,9 @@ class NetTest(SyscoinTestFramework):
                 "network": "not_publicly_routable",
                 "permissions": [],
                 "presynced_headers": -1,
+                # SYSCOIN
+                "processed_per_msg": {},
+                "processtime": 0,
                 "relaytxes": False,
                 "services": "0000000000000000",
                 "servicesnames": [],
@@ -175,6 +178,18 @@ class NetTest(SyscoinTestFramework):
             peer_after = lambda: next(p for p in self.nodes[0].getpeerinfo() if p['id'] == peer_before['id'])
             self.wait_until(lambda: peer_after()['bytesrecv_per_msg'].get('pong', 0) >= peer_before['bytesrecv_per_msg'].get('pong', 0) + 32, timeout=1)
             self.wait_until(lambda: peer_after()['bytessent_per_msg'].get('ping', 0) >= peer_before['bytessent_per_msg'].get('ping', 0) + 32, timeout=1)
+            # SYSCOIN the pong was processed and accounted
+            self.wait_until(lambda: peer_after()['processed_per_msg'].get('pong', {}).get('count', 0) > peer_before['processed_per_msg'].get('pong', {}).get('count', 0), timeout=1)
+
+        # SYSCOIN
+        self.log.info("Test getnetmsgstats")
+        stats = self.nodes[0].getnetmsgstats()
+        assert_greater_than(stats['msgtypes']['pong']['count'], 0)
+        assert_equal(len(stats['peers']), 2)
+        assert stats['peers'][0]['time'] >= stats['peers'][1]['time']
+        assert_equal(sum(p['count'] for p in stats['peers']), sum(m['count'] for m in stats['msgtypes'].values()))
+        assert_equal(len(self.nodes[0].getnetmsgstats(1)['peers']), 1)
+        assert_raises_rpc_error(-8, "Count must be non-negative", self.nodes[0].getnetmsgstats, -1)
 
     def test_getnetworkinfo(self):
         self.log.info("Test getnetworkinfo")
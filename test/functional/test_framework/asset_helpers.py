@@ -165,7 +165,7 @@ def create_allocation_data(tx_type,
     raw_data = obj.serialize()
     return raw_data.hex()
 
-def attach_allocation_data_to_tx(node, inputs, outputs):
+def attach_allocation_data_to_tx(node, inputs, outputs, replaceable=True):
     """
     Create raw tx with allocation data, then modify it with Syscoin RPC if needed
     """
@@ -181,6 +181,7 @@ def attach_allocation_data_to_tx(node, inputs, outputs):
     rawtx = node.createrawtransaction(
         inputs=cleaned_inputs,
         outputs=outputs,
+        replaceable=replaceable,
     )
     # Sign the transaction
     sign_res = node.signrawtransactionwithwallet(rawtx)
@@ -305,7 +306,7 @@ class CoinSelector:
 
 def create_transaction_with_selector(node, tx_type, sys_amount=Decimal('0'), sys_destination=None,
                               asset_amounts=None, fees=None, nevm_address=None,
-                              spv_proof=None):
+                              spv_proof=None, replaceable=True):
     """
     Create a transaction with the specified type using CoinSelector for input selection
     
@@ -319,6 +320,7 @@ def create_transaction_with_selector(node, tx_type, sys_amount=Decimal('0'), sys
         destinations: Dict of {guid: address} for asset send operations
         nevm_address: NEVM address for BURN_TO_NEVM operations
         spv_proof: SPV proof for mint operations
+        replaceable: Whether the transaction signals BIP125 replaceability
         
     Returns:
         Hex string of the signed transaction
@@ -442,7 +444,7 @@ def create_transaction_with_selector(node, tx_type, sys_amount=Decimal('0'), sys
     outputs.append({"data_version": tx_type})
     
     # Create and sign the transaction
-    tx_hex = attach_allocation_data_to_tx(node, inputs, outputs)
+    tx_hex = attach_allocation_data_to_tx(node, inputs, outputs, replaceable)
     return tx_hex
 
 def verify_tx_outputs(node, txid, tx_type, asset_details=None):
@@ -147,6 +147,7 @@ MESSAGEMAP = {
     b"govsync": None,
     b"qfcommit": None,
     b"qsendrecsigs": msg_qsendrecsigs,
+    b"sendblobs": None,
     b"spork": None,
 }
 
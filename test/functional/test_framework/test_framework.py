@@ -865,7 +865,7 @@ class SyscoinTestFramework(metaclass=SyscoinTestMetaClass):
 
             os.rmdir(cache_path('wallets'))  # Remove empty wallets dir
             for entry in os.listdir(cache_path()):
-                if entry not in ['chainstate', 'blocks', 'indexes', 'nevmminttx', 'nevmtxroots', 'geth', 'dbblockindex', 'llmq', 'evodb_dmn', 'evodb_qc', 'evodb_qc', 'evodb_qvvecs', 'evodb_qsk', 'evodb_sb', 'nevmdata', 'nevmblobdata']:  # Only keep chainstate and blocks folder
+                if entry not in ['chainstate', 'blocks', 'indexes', 'nevmminttx', 'nevmtxroots', 'geth', 'dbblockindex', 'llmq', 'evodb_dmn', 'evodb_dmn_diffs', 'evodb_qc', 'evodb_qc', 'evodb_qvvecs', 'evodb_qsk', 'evodb_sb', 'nevmdata', 'nevmblobdata']:  # Only keep chainstate and blocks folder
                     os.remove(cache_path(entry))
 
         for i in range(self.num_nodes):
@@ -188,6 +188,8 @@ BASE_SCRIPTS = [
     'wallet_fast_rescan.py --descriptors',
     'interface_zmq.py',
     'interface_zmq_nevm.py',
+    'interface_zmq_nevm_mock.py',
+    'interface_zmq_zdag.py',
     'feature_assets.py',
     'rpc_invalid_address_message.py',
     'rpc_validateaddress.py',
@@ -222,6 +224,7 @@ BASE_SCRIPTS = [
     'wallet_conflicts.py --legacy-wallet',
     'wallet_conflicts.py --descriptors',
     'interface_http.py',
+    'interface_metrics.py',
     'interface_rpc.py',
     'interface_usdt_coinselection.py',
     'interface_usdt_mempool.py',